@@ -0,0 +1,231 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+// C++ counterparts of the paths measured through the Python bindings by python/metavision_bindings_benchmark.py.
+// Both sides run the same cases on the same buffer sizes, so that the overhead of the bindings is the ratio of their
+// throughputs.
+//
+// The buffer sizes are read from the environment variable METAVISION_BENCHMARK_BUFFER_SIZES, as a comma separated
+// list of integers. The cases reading a RAW file use the one given by the environment variable
+// METAVISION_BENCHMARK_RAW_FILE, and are skipped when it is not set.
+
+#include <cstdint>
+#include <cstdlib>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <opencv2/core.hpp>
+
+#include "metavision/hal/device/device.h"
+#include "metavision/hal/device/device_discovery.h"
+#include "metavision/hal/facilities/i_decoder.h"
+#include "metavision/hal/facilities/i_event_decoder.h"
+#include "metavision/hal/facilities/i_events_stream.h"
+#include "metavision/hal/utils/raw_file_config.h"
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/core/algorithms/periodic_frame_generation_algorithm.h"
+#include "metavision/sdk/core/algorithms/polarity_filter_algorithm.h"
+#include "metavision/sdk/core/algorithms/shared_cd_events_buffer_producer_algorithm.h"
+#include "synthetic_event_stream.h"
+
+using namespace Metavision;
+using namespace Metavision::Benchmarks;
+
+namespace {
+
+/// Registers the buffer sizes to run a benchmark with, in events (or RAW events for the cases reading a RAW file)
+void apply_buffer_size_arguments(benchmark::internal::Benchmark *b) {
+    b->ArgName("buffer_size");
+    for (const auto size : get_env_int_list("METAVISION_BENCHMARK_BUFFER_SIZES", {1024, 16384, 262144})) {
+        b->Arg(size);
+    }
+}
+
+SyntheticStreamConfig get_buffer_stream_config(const benchmark::State &state) {
+    SyntheticStreamConfig config;
+    config.n_events = state.range(0);
+    return config;
+}
+
+/// Opens the RAW file of the benchmarks, read by buffers of the size of the benchmark and looping on its end
+std::unique_ptr<Device> open_benchmark_raw_file(benchmark::State &state) {
+    const char *raw_file = std::getenv("METAVISION_BENCHMARK_RAW_FILE");
+    if (!raw_file) {
+        state.SkipWithError("METAVISION_BENCHMARK_RAW_FILE is not set");
+        return nullptr;
+    }
+
+    RawFileConfig config;
+    config.n_events_to_read_ = static_cast<uint32_t>(state.range(0));
+    config.loop_             = true;
+    std::unique_ptr<Device> device;
+    try {
+        device = DeviceDiscovery::open_raw_file(raw_file, config);
+    } catch (...) {}
+    if (!device || !device->get_facility<I_EventsStream>() || !device->get_facility<I_Decoder>() ||
+        !device->get_facility<I_EventDecoder<EventCD>>()) {
+        state.SkipWithError("Failed to open the RAW file");
+        return nullptr;
+    }
+    return device;
+}
+
+/// Reads the first buffer of the RAW file, decoded again and again by the decoding cases
+std::vector<I_EventsStream::RawData> read_first_buffer(benchmark::State &state, Device &device) {
+    auto *events_stream = device.get_facility<I_EventsStream>();
+    events_stream->start();
+    long n_bytes = 0;
+    if (events_stream->wait_next_buffer() < 0) {
+        state.SkipWithError("Failed to read the RAW file");
+        return {};
+    }
+    auto *data = events_stream->get_latest_raw_data(n_bytes);
+    std::vector<I_EventsStream::RawData> buffer(data, data + n_bytes);
+    events_stream->stop();
+    return buffer;
+}
+
+// Counterpart of I_EventsStream.get_latest_raw_data, which wraps the buffer in a numpy array
+void BM_EventsStream_get_latest_raw_data(benchmark::State &state) {
+    auto device = open_benchmark_raw_file(state);
+    if (!device) {
+        return;
+    }
+    auto *events_stream = device->get_facility<I_EventsStream>();
+    events_stream->start();
+
+    int64_t n_bytes_read = 0;
+    for (auto _ : state) {
+        if (events_stream->wait_next_buffer() < 0) {
+            state.SkipWithError("Failed to read the RAW file");
+            break;
+        }
+        long n_bytes = 0;
+        benchmark::DoNotOptimize(events_stream->get_latest_raw_data(n_bytes));
+        n_bytes_read += n_bytes;
+    }
+    events_stream->stop();
+
+    state.SetBytesProcessed(n_bytes_read);
+}
+BENCHMARK(BM_EventsStream_get_latest_raw_data)->Apply(apply_buffer_size_arguments);
+
+// Counterpart of the callbacks of I_EventDecoder_EventCD, which hand the decoded events to Python
+void BM_EventCDDecoder_callback(benchmark::State &state) {
+    auto device = open_benchmark_raw_file(state);
+    if (!device) {
+        return;
+    }
+    auto raw_data = read_first_buffer(state, *device);
+    if (raw_data.empty()) {
+        return;
+    }
+
+    int64_t n_decoded = 0;
+    auto *cd_decoder  = device->get_facility<I_EventDecoder<EventCD>>();
+    cd_decoder->add_event_buffer_callback([&n_decoded](const EventCD *begin, const EventCD *end) {
+        n_decoded += std::distance(begin, end);
+        benchmark::DoNotOptimize(begin);
+    });
+
+    auto *decoder = device->get_facility<I_Decoder>();
+    for (auto _ : state) {
+        decoder->decode(raw_data.data(), raw_data.data() + raw_data.size());
+    }
+
+    state.SetItemsProcessed(n_decoded);
+    state.SetBytesProcessed(state.iterations() * raw_data.size());
+}
+BENCHMARK(BM_EventCDDecoder_callback)->Apply(apply_buffer_size_arguments);
+
+// Counterpart of SharedCdEventsBufferProducer fed by the decoder through get_process_events_callback, the buffers
+// holding as many events as the buffers of the benchmark
+void BM_SharedCdEventsBufferProducer(benchmark::State &state) {
+    auto device = open_benchmark_raw_file(state);
+    if (!device) {
+        return;
+    }
+    auto raw_data = read_first_buffer(state, *device);
+    if (raw_data.empty()) {
+        return;
+    }
+
+    SharedEventsBufferProducerParameters params;
+    params.buffers_events_count_  = static_cast<uint32_t>(state.range(0));
+    params.buffers_time_slice_us_ = 0;
+    params.bounded_memory_pool_   = false;
+    int64_t n_produced            = 0;
+    SharedCdEventsBufferProducerAlgorithm producer(
+        params, [&n_produced](timestamp, const SharedCdEventsBufferProducerAlgorithm::SharedEventsBuffer &buffer) {
+            n_produced += buffer->size();
+            benchmark::DoNotOptimize(buffer->data());
+        });
+
+    auto *cd_decoder = device->get_facility<I_EventDecoder<EventCD>>();
+    cd_decoder->add_event_buffer_callback(
+        [&producer](const EventCD *begin, const EventCD *end) { producer.process_events(begin, end); });
+
+    auto *decoder = device->get_facility<I_Decoder>();
+    for (auto _ : state) {
+        decoder->decode(raw_data.data(), raw_data.data() + raw_data.size());
+    }
+
+    state.SetItemsProcessed(n_produced);
+}
+BENCHMARK(BM_SharedCdEventsBufferProducer)->Apply(apply_buffer_size_arguments);
+
+// Counterpart of PolarityFilterAlgorithm.process_events, as an example of the process_events wrappers of the
+// algorithms
+void BM_PolarityFilterAlgorithm_process_events(benchmark::State &state) {
+    const auto events = make_synthetic_cd_events(get_buffer_stream_config(state));
+    std::vector<EventCD> output;
+    output.reserve(events.size());
+
+    PolarityFilterAlgorithm algo(1);
+    for (auto _ : state) {
+        output.clear();
+        algo.process_events(events.cbegin(), events.cend(), std::back_inserter(output));
+        benchmark::DoNotOptimize(output.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * events.size());
+}
+BENCHMARK(BM_PolarityFilterAlgorithm_process_events)->Apply(apply_buffer_size_arguments);
+
+// Counterpart of PeriodicFrameGenerationAlgorithm.process_events, whose frames are handed to a Python callback
+void BM_PeriodicFrameGenerationAlgorithm_process_events(benchmark::State &state) {
+    const auto config = get_buffer_stream_config(state);
+    auto events       = make_synthetic_cd_events(config);
+
+    PeriodicFrameGenerationAlgorithm algo(config.width, config.height, 10000, 100.);
+    int64_t n_frames = 0;
+    algo.set_output_callback([&n_frames](timestamp, cv::Mat &frame) {
+        ++n_frames;
+        benchmark::DoNotOptimize(frame.data);
+    });
+
+    for (auto _ : state) {
+        algo.process_events(events.cbegin(), events.cend());
+        state.PauseTiming();
+        shift_to_next_period(events);
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(state.iterations() * events.size());
+    state.counters["frames"] = benchmark::Counter(n_frames, benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_PeriodicFrameGenerationAlgorithm_process_events)->Apply(apply_buffer_size_arguments);
+
+} // namespace
+
+BENCHMARK_MAIN();
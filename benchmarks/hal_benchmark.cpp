@@ -0,0 +1,305 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <benchmark/benchmark.h>
+
+#include "metavision/hal/decoders/evt2_decoder.h"
+#include "metavision/hal/decoders/evt3_decoder.h"
+#include "metavision/hal/decoders/detail/evt2_raw_format.h"
+#include "metavision/hal/decoders/detail/evt3_raw_format.h"
+#include "metavision/hal/facilities/i_decoder.h"
+#include "metavision/hal/facilities/i_event_decoder.h"
+#include "metavision/hal/utils/parallel_decoder.h"
+#include "synthetic_event_stream.h"
+#include "synthetic_raw_stream.h"
+
+using namespace Metavision;
+using namespace Metavision::Benchmarks;
+
+namespace {
+
+uint16_t make_evt3_word(Evt3::EventTypes type, uint16_t payload) {
+    return static_cast<uint16_t>((static_cast<uint16_t>(type) << Evt3::TypeShift) | payload);
+}
+
+// Events of a same row, polarity and timestamp that are close enough are encoded as vectors, as the sensor would do
+std::vector<uint16_t> encode_evt3(const std::vector<EventCD> &events) {
+    std::vector<uint16_t> words;
+    words.reserve(2 * events.size());
+
+    bool has_time            = false;
+    timestamp last_time_high = 0;
+    timestamp last_t         = 0;
+    int last_y               = -1;
+    for (size_t i = 0; i < events.size();) {
+        const auto &ev            = events[i];
+        const timestamp time_high = ev.t >> Evt3::TimeLowBits;
+        if (!has_time || time_high != last_time_high) {
+            words.push_back(make_evt3_word(Evt3::EventTypes::EVT_TIME_HIGH, time_high & Evt3::TimeMask));
+            last_time_high = time_high;
+            has_time       = false;
+        }
+        if (!has_time || ev.t != last_t) {
+            words.push_back(make_evt3_word(Evt3::EventTypes::EVT_TIME_LOW, ev.t & Evt3::TimeMask));
+            has_time = true;
+            last_t   = ev.t;
+            last_y   = -1;
+        }
+        if (ev.y != last_y) {
+            words.push_back(make_evt3_word(Evt3::EventTypes::CD_Y, ev.y));
+            last_y = ev.y;
+        }
+
+        uint16_t mask = 0;
+        size_t j      = i;
+        for (; j < events.size() && events[j].t == ev.t && events[j].y == ev.y && events[j].p == ev.p &&
+               events[j].x < ev.x + 12;
+             ++j) {
+            mask |= 1 << (events[j].x - ev.x);
+        }
+        if (j == i + 1) {
+            words.push_back(make_evt3_word(Evt3::EventTypes::X_POS, (ev.p << Evt3::PolarityShift) | ev.x));
+        } else {
+            words.push_back(make_evt3_word(Evt3::EventTypes::X_BASE, (ev.p << Evt3::PolarityShift) | ev.x));
+            words.push_back(make_evt3_word(Evt3::EventTypes::VECT_12, mask));
+        }
+        i = j;
+    }
+    return words;
+}
+
+template<typename Word>
+void decode_all(const std::vector<Word> &words, I_Decoder &decoder) {
+    auto begin = reinterpret_cast<I_Decoder::RawData *>(const_cast<Word *>(words.data()));
+    decoder.decode(begin, begin + words.size() * sizeof(Word));
+}
+
+template<typename Decoder, typename Word>
+void run_decoder_benchmark(benchmark::State &state, const std::vector<Word> &words, size_t n_events) {
+    auto cd_decoder  = std::make_shared<I_EventDecoder<EventCD>>();
+    size_t n_decoded = 0;
+    cd_decoder->add_event_buffer_callback([&n_decoded](const EventCD *begin, const EventCD *end) {
+        n_decoded += std::distance(begin, end);
+        benchmark::DoNotOptimize(begin);
+    });
+    Decoder decoder(false, cd_decoder);
+
+    for (auto _ : state) {
+        decode_all(words, decoder);
+    }
+
+    state.SetItemsProcessed(state.iterations() * n_events);
+    state.SetBytesProcessed(state.iterations() * words.size() * sizeof(Word));
+    state.counters["decoded_ratio"] = static_cast<double>(n_decoded) / (state.iterations() * n_events);
+}
+
+void BM_EVT2Decoder_decode(benchmark::State &state) {
+    const auto events = make_synthetic_cd_events(get_stream_config(state));
+    run_decoder_benchmark<EVT2Decoder>(state, encode_evt2(events), events.size());
+}
+BENCHMARK(BM_EVT2Decoder_decode)->Apply(apply_stream_arguments);
+
+// Per-event consumer, either called with the buffers of the decoder or inlined in its loop by decode_into
+struct PixelCounter {
+    void operator()(const EventCD &ev) {
+        ++counts[ev.x & 0xFF];
+    }
+    void operator()(const EventCD *begin, const EventCD *end) {
+        for (auto it = begin; it != end; ++it) {
+            (*this)(*it);
+        }
+    }
+    std::array<uint32_t, 256> counts{};
+};
+
+void BM_EVT2Decoder_decode_per_event_callback(benchmark::State &state) {
+    const auto events = make_synthetic_cd_events(get_stream_config(state));
+    auto words        = encode_evt2(events);
+    auto cd_decoder   = std::make_shared<I_EventDecoder<EventCD>>();
+    PixelCounter counter;
+    cd_decoder->add_event_buffer_callback(
+        [&counter](const EventCD *begin, const EventCD *end) { counter(begin, end); });
+    EVT2Decoder decoder(false, cd_decoder);
+
+    for (auto _ : state) {
+        decode_all(words, decoder);
+    }
+    benchmark::DoNotOptimize(counter.counts);
+
+    state.SetItemsProcessed(state.iterations() * events.size());
+    state.SetBytesProcessed(state.iterations() * words.size() * sizeof(words[0]));
+}
+BENCHMARK(BM_EVT2Decoder_decode_per_event_callback)->Apply(apply_stream_arguments);
+
+void BM_EVT2Decoder_decode_into_per_event_sink(benchmark::State &state) {
+    const auto events = make_synthetic_cd_events(get_stream_config(state));
+    const auto words  = encode_evt2(events);
+    PixelCounter counter;
+    EVT2Decoder decoder(false);
+
+    const auto *begin = reinterpret_cast<const I_Decoder::RawData *>(words.data());
+    for (auto _ : state) {
+        decoder.decode_into(begin, begin + words.size() * sizeof(words[0]), counter);
+    }
+    benchmark::DoNotOptimize(counter.counts);
+
+    state.SetItemsProcessed(state.iterations() * events.size());
+    state.SetBytesProcessed(state.iterations() * words.size() * sizeof(words[0]));
+}
+BENCHMARK(BM_EVT2Decoder_decode_into_per_event_sink)->Apply(apply_stream_arguments);
+
+void BM_EVT3Decoder_decode(benchmark::State &state) {
+    const auto events = make_synthetic_cd_events(get_stream_config(state));
+    run_decoder_benchmark<EVT3Decoder>(state, encode_evt3(events), events.size());
+}
+BENCHMARK(BM_EVT3Decoder_decode)->Apply(apply_stream_arguments);
+
+// Scan for the next resync point of data that contains none, as when skipping a corrupted part of a stream
+template<typename Decoder, typename Word>
+void run_resync_scan_benchmark(benchmark::State &state, Word word) {
+    const std::vector<Word> words((64 << 20) / sizeof(Word), word);
+    auto begin = reinterpret_cast<const I_Decoder::RawData *>(words.data());
+    auto end   = begin + words.size() * sizeof(Word);
+    Decoder decoder(false);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(decoder.find_resync_point(begin, end));
+    }
+
+    state.SetBytesProcessed(state.iterations() * words.size() * sizeof(Word));
+}
+
+void BM_EVT2Decoder_find_resync_point(benchmark::State &state) {
+    run_resync_scan_benchmark<EVT2Decoder>(state, static_cast<uint32_t>(Evt2::EventTypes::CD_HIGH) << Evt2::TypeShift);
+}
+BENCHMARK(BM_EVT2Decoder_find_resync_point)->Unit(benchmark::kMillisecond);
+
+void BM_EVT3Decoder_find_resync_point(benchmark::State &state) {
+    run_resync_scan_benchmark<EVT3Decoder>(state, make_evt3_word(Evt3::EventTypes::X_POS, 0));
+}
+BENCHMARK(BM_EVT3Decoder_find_resync_point)->Unit(benchmark::kMillisecond);
+
+void BM_ParallelDecoder_decode_EVT2(benchmark::State &state) {
+    auto config       = get_stream_config(state);
+    config.n_events   = 1 << 23;
+    const auto events = make_synthetic_cd_events(config);
+    auto words        = encode_evt2(events);
+
+    auto cd_decoder = std::make_shared<I_EventDecoder<EventCD>>();
+    cd_decoder->add_event_buffer_callback(
+        [](const EventCD *begin, const EventCD *end) { benchmark::DoNotOptimize(begin); });
+    for (auto _ : state) {
+        ParallelDecoder decoder(
+            [](bool time_shifting_enabled, const std::shared_ptr<I_EventDecoder<EventCD>> &event_cd_decoder,
+               const std::shared_ptr<I_EventDecoder<EventExtTrigger>> &event_ext_trigger_decoder) {
+                return std::unique_ptr<I_Decoder>(
+                    new EVT2Decoder(time_shifting_enabled, event_cd_decoder, event_ext_trigger_decoder));
+            },
+            false, cd_decoder, nullptr, static_cast<uint32_t>(state.range(2)));
+        auto begin = reinterpret_cast<I_Decoder::RawData *>(words.data());
+        decoder.decode(begin, begin + words.size() * sizeof(uint32_t));
+    }
+
+    state.SetItemsProcessed(state.iterations() * events.size());
+    state.SetBytesProcessed(state.iterations() * words.size() * sizeof(uint32_t));
+}
+BENCHMARK(BM_ParallelDecoder_decode_EVT2)
+    ->ArgNames({"rate_mev_s", "density_percent", "n_threads"})
+    ->ArgsProduct({{10}, {10}, {1, 2, 4, 8}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+// Decoder of a stream of EventCD structures, to measure the cost of the forwarding alone
+class EventCDForwardingDecoder : public I_Decoder {
+public:
+    EventCDForwardingDecoder(const std::shared_ptr<I_EventDecoder<EventCD>> &event_cd_decoder, size_t buffer_size) :
+        I_Decoder(false, event_cd_decoder) {
+        set_cd_event_buffer_size(buffer_size);
+    }
+
+    timestamp get_last_timestamp() const override {
+        return last_timestamp_;
+    }
+
+    bool get_timestamp_shift(timestamp &) const override {
+        return false;
+    }
+
+    uint8_t get_raw_event_size_bytes() const override {
+        return sizeof(EventCD);
+    }
+
+private:
+    void decode_impl(RawData *raw_data_begin, RawData *raw_data_end) override {
+        auto &forwarder = cd_event_forwarder();
+        for (auto ev = reinterpret_cast<const EventCD *>(raw_data_begin),
+                  ev_end = reinterpret_cast<const EventCD *>(raw_data_end);
+             ev != ev_end; ++ev) {
+            forwarder.forward(ev->x, ev->y, ev->p, ev->t);
+        }
+        if (raw_data_begin != raw_data_end) {
+            last_timestamp_ = reinterpret_cast<const EventCD *>(raw_data_end)[-1].t;
+        }
+    }
+
+    timestamp last_timestamp_{0};
+};
+
+enum class ForwardingMode { BufferCallback, VectorCallback, SoACallback };
+
+void run_forwarder_benchmark(benchmark::State &state, ForwardingMode mode) {
+    const auto events = make_synthetic_cd_events(SyntheticStreamConfig());
+
+    auto cd_decoder = std::make_shared<I_EventDecoder<EventCD>>();
+    switch (mode) {
+    case ForwardingMode::BufferCallback:
+        cd_decoder->add_event_buffer_callback(
+            [](const EventCD *begin, const EventCD *end) { benchmark::DoNotOptimize(begin); });
+        break;
+    case ForwardingMode::VectorCallback:
+        cd_decoder->set_event_vector_callback([](std::vector<EventCD> &&events) { benchmark::DoNotOptimize(events); });
+        break;
+    case ForwardingMode::SoACallback:
+        cd_decoder->add_event_soa_buffer_callback(
+            [](const EventCDBufferSoA &buffer) { benchmark::DoNotOptimize(buffer); });
+        break;
+    }
+    EventCDForwardingDecoder decoder(cd_decoder, state.range(0));
+
+    for (auto _ : state) {
+        decode_all(events, decoder);
+    }
+
+    state.SetItemsProcessed(state.iterations() * events.size());
+}
+
+void BM_DecodedEventForwarder_buffer_callback(benchmark::State &state) {
+    run_forwarder_benchmark(state, ForwardingMode::BufferCallback);
+}
+BENCHMARK(BM_DecodedEventForwarder_buffer_callback)->ArgName("buffer_size")->RangeMultiplier(8)->Range(320, 320 << 9);
+
+void BM_DecodedEventForwarder_vector_callback(benchmark::State &state) {
+    run_forwarder_benchmark(state, ForwardingMode::VectorCallback);
+}
+BENCHMARK(BM_DecodedEventForwarder_vector_callback)->ArgName("buffer_size")->RangeMultiplier(8)->Range(320, 320 << 9);
+
+void BM_DecodedEventForwarder_soa_callback(benchmark::State &state) {
+    run_forwarder_benchmark(state, ForwardingMode::SoACallback);
+}
+BENCHMARK(BM_DecodedEventForwarder_soa_callback)->ArgName("buffer_size")->RangeMultiplier(8)->Range(320, 320 << 9);
+
+} // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,267 @@
+# Copyright (c) Prophesee S.A.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+# Unless required by applicable law or agreed to in writing, software distributed under the License is distributed
+# on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and limitations under the License.
+
+"""
+Benchmark of the overhead of the Python bindings.
+
+Times, on a range of buffer sizes, the paths of the Python bindings handing data over to Python (decoder callbacks,
+I_EventsStream.get_latest_raw_data, process_events of the algorithms, SharedCdEventsBufferProducer and frame
+generation), and compares their throughputs with the ones of the same paths in C++, measured by the
+metavision_bindings_reference_benchmarks executable.
+"""
+
+import argparse
+import json
+import os
+import subprocess
+import time
+
+import numpy as np
+
+import metavision_hal
+import metavision_sdk_base
+import metavision_sdk_core
+
+
+DEFAULT_BUFFER_SIZES = "1024,16384,262144"
+
+
+def parse_args():
+    """Parse command line arguments."""
+    parser = argparse.ArgumentParser(description='Metavision Python bindings benchmark.',
+                                     formatter_class=argparse.ArgumentDefaultsHelpFormatter)
+    parser.add_argument('-i', '--input-raw-file', dest='raw_file',
+                        default=os.environ.get('METAVISION_BENCHMARK_RAW_FILE'),
+                        help="Path to the RAW file read by the HAL cases, which are skipped if not set. "
+                        "Defaults to the environment variable METAVISION_BENCHMARK_RAW_FILE")
+    parser.add_argument('-s', '--buffer-sizes', dest='buffer_sizes',
+                        default=os.environ.get('METAVISION_BENCHMARK_BUFFER_SIZES', DEFAULT_BUFFER_SIZES),
+                        help="Comma separated list of the sizes of the buffers, in events (or RAW events for the "
+                        "HAL cases). Defaults to the environment variable METAVISION_BENCHMARK_BUFFER_SIZES")
+    parser.add_argument('--min-time', dest='min_time', type=float, default=0.5,
+                        help="Minimum duration of the measure of each case, in seconds")
+    parser.add_argument('--cpp-benchmark', dest='cpp_benchmark', default=None,
+                        help="Path to the metavision_bindings_reference_benchmarks executable, to compare with the "
+                        "throughputs of the C++ paths")
+    parser.add_argument('-o', '--output-json', dest='output_json', default=None,
+                        help="Path to a JSON file where to write the results")
+    args = parser.parse_args()
+    args.buffer_sizes = [int(size) for size in args.buffer_sizes.split(',') if int(size) > 0]
+    return args
+
+
+def make_synthetic_cd_events(n_events, width=640, height=480, rate_mev_s=10, density_percent=10, seed=42):
+    """Generates a stream of CD events, as the synthetic streams of the C++ benchmarks
+
+    The events are uniformly distributed over a random subset of the pixels of the sensor, with timestamps increasing
+    at the configured rate.
+    """
+    rng = np.random.default_rng(seed)
+    pixels = rng.permutation(width * height)[:max(1, width * height * density_percent // 100)]
+    positions = pixels[rng.integers(0, len(pixels), n_events)]
+
+    events = np.zeros(n_events, dtype=metavision_sdk_base.EventCD)
+    events['x'] = positions % width
+    events['y'] = positions // width
+    events['p'] = rng.integers(0, 2, n_events)
+    events['t'] = np.arange(n_events) // rate_mev_s
+    events.sort(order=['t', 'y', 'p', 'x'])
+    return events
+
+
+def measure(step, min_time):
+    """Calls step until min_time is elapsed, and returns the number of items it processed per second
+
+    The step returns the number of items it processed and the duration to account for, so that it can exclude
+    its setup from the measure.
+    """
+    n_items, elapsed = 0, 0.
+    while elapsed < min_time:
+        items, duration = step()
+        n_items += items
+        elapsed += duration
+    return n_items / elapsed
+
+
+def timed(function, *args):
+    start = time.perf_counter()
+    function(*args)
+    return time.perf_counter() - start
+
+
+def open_raw_file(raw_file, buffer_size):
+    config = metavision_hal.RawFileConfig()
+    config.n_events_to_read = buffer_size
+    config.loop = True
+    device = metavision_hal.DeviceDiscovery.open_raw_file(raw_file, config)
+    if device is None:
+        raise OSError(f"Failed to open RAW file {raw_file}")
+    return device
+
+
+def read_first_buffer(device):
+    """Reads the first buffer of the RAW file, decoded again and again by the decoding cases"""
+    events_stream = device.get_i_events_stream()
+    events_stream.start()
+    if events_stream.wait_next_buffer() < 0:
+        raise OSError("Failed to read the RAW file")
+    raw_data = events_stream.get_latest_raw_data().copy()
+    events_stream.stop()
+    return raw_data
+
+
+def bench_get_latest_raw_data(args, buffer_size):
+    device = open_raw_file(args.raw_file, buffer_size)
+    events_stream = device.get_i_events_stream()
+    events_stream.start()
+
+    def step():
+        start = time.perf_counter()
+        if events_stream.wait_next_buffer() < 0:
+            raise OSError("Failed to read the RAW file")
+        n_bytes = events_stream.get_latest_raw_data().size
+        return n_bytes, time.perf_counter() - start
+
+    rate = measure(step, args.min_time)
+    events_stream.stop()
+    return rate
+
+
+def bench_decoder_callback(set_callback):
+    """Times the decoding of a buffer, whose events are handed to Python with set_callback"""
+    def bench(args, buffer_size):
+        device = open_raw_file(args.raw_file, buffer_size)
+        raw_data = read_first_buffer(device)
+        n_decoded = [0]
+
+        def callback(events):
+            n_decoded[0] += len(events)
+        set_callback(device.get_i_event_cd_decoder(), callback)
+
+        decoder = device.get_i_decoder()
+
+        def step():
+            n_decoded[0] = 0
+            duration = timed(decoder.decode, raw_data)
+            return n_decoded[0], duration
+
+        return measure(step, args.min_time)
+    return bench
+
+
+def bench_shared_cd_events_buffer_producer(args, buffer_size):
+    device = open_raw_file(args.raw_file, buffer_size)
+    raw_data = read_first_buffer(device)
+    n_produced = [0]
+
+    def callback(ts, events):
+        n_produced[0] += len(events)
+    producer = metavision_sdk_core.SharedCdEventsBufferProducer(callback, event_count=buffer_size, time_slice_us=0)
+    device.get_i_event_cd_decoder().set_add_decoded_native_vevent_callback(producer.get_process_events_callback())
+
+    decoder = device.get_i_decoder()
+
+    def step():
+        n_produced[0] = 0
+        duration = timed(decoder.decode, raw_data)
+        return n_produced[0], duration
+
+    return measure(step, args.min_time)
+
+
+def bench_polarity_filter(args, buffer_size):
+    events = make_synthetic_cd_events(buffer_size)
+    algo = metavision_sdk_core.PolarityFilterAlgorithm(1)
+    output = algo.get_empty_output_buffer()
+
+    def step():
+        return len(events), timed(algo.process_events, events, output)
+
+    return measure(step, args.min_time)
+
+
+def bench_periodic_frame_generation(args, buffer_size):
+    events = make_synthetic_cd_events(buffer_size)
+    period = int(events['t'][-1]) - int(events['t'][0]) + 1
+    algo = metavision_sdk_core.PeriodicFrameGenerationAlgorithm(640, 480, 10000, 100.)
+    algo.set_output_callback(lambda ts, frame: None)
+
+    def step():
+        duration = timed(algo.process_events, events)
+        # The same events are processed again, with timestamps following the ones processed
+        events['t'] += period
+        return len(events), duration
+
+    return measure(step, args.min_time)
+
+
+# Cases as (name, function, C++ counterpart, counter compared, whether a RAW file is needed)
+CASES = [
+    ("I_EventsStream.get_latest_raw_data", bench_get_latest_raw_data,
+     "BM_EventsStream_get_latest_raw_data", "bytes_per_second", True),
+    ("I_EventDecoder_EventCD.add_event_buffer_callback",
+     bench_decoder_callback(lambda decoder, callback: decoder.add_event_buffer_callback(callback)),
+     "BM_EventCDDecoder_callback", "items_per_second", True),
+    ("I_EventDecoder_EventCD.set_add_decoded_raw_vevent_callback",
+     bench_decoder_callback(lambda decoder, callback: decoder.set_add_decoded_raw_vevent_callback(callback)),
+     "BM_EventCDDecoder_callback", "items_per_second", True),
+    ("I_EventDecoder_EventCD.set_event_vector_callback",
+     bench_decoder_callback(lambda decoder, callback: decoder.set_event_vector_callback(callback)),
+     "BM_EventCDDecoder_callback", "items_per_second", True),
+    ("SharedCdEventsBufferProducer", bench_shared_cd_events_buffer_producer,
+     "BM_SharedCdEventsBufferProducer", "items_per_second", True),
+    ("PolarityFilterAlgorithm.process_events", bench_polarity_filter,
+     "BM_PolarityFilterAlgorithm_process_events", "items_per_second", False),
+    ("PeriodicFrameGenerationAlgorithm.process_events", bench_periodic_frame_generation,
+     "BM_PeriodicFrameGenerationAlgorithm_process_events", "items_per_second", False),
+]
+
+
+def run_cpp_benchmark(args):
+    """Runs the C++ counterparts of the cases, and returns their results indexed by benchmark name"""
+    env = dict(os.environ)
+    env['METAVISION_BENCHMARK_BUFFER_SIZES'] = ','.join(str(size) for size in args.buffer_sizes)
+    if args.raw_file:
+        env['METAVISION_BENCHMARK_RAW_FILE'] = args.raw_file
+    output = subprocess.run([args.cpp_benchmark, '--benchmark_format=json'], env=env, check=True,
+                            stdout=subprocess.PIPE).stdout
+    return {result['name']: result for result in json.loads(output)['benchmarks']
+            if not result.get('error_occurred', False)}
+
+
+def main():
+    """ Main """
+    args = parse_args()
+
+    cpp_results = run_cpp_benchmark(args) if args.cpp_benchmark else {}
+
+    results = []
+    print("{:<60} {:>12} {:>16} {:>16} {:>8}".format("Case", "Buffer size", "Python (/s)", "C++ (/s)", "Ratio"))
+    for name, bench, cpp_name, counter, needs_raw_file in CASES:
+        if needs_raw_file and not args.raw_file:
+            print(f"{name}: skipped, no RAW file given")
+            continue
+        for buffer_size in args.buffer_sizes:
+            python_rate = bench(args, buffer_size)
+            cpp_result = cpp_results.get(f"{cpp_name}/buffer_size:{buffer_size}", {})
+            cpp_rate = cpp_result.get(counter)
+            ratio = python_rate / cpp_rate if cpp_rate else None
+            results.append({"name": name, "buffer_size": buffer_size, "counter": counter,
+                            "python": python_rate, "cpp": cpp_rate, "ratio": ratio})
+            print("{:<60} {:>12} {:>16.4g} {:>16} {:>8}".format(
+                name, buffer_size, python_rate, "-" if cpp_rate is None else "{:.4g}".format(cpp_rate),
+                "-" if ratio is None else "{:.3f}".format(ratio)))
+
+    if args.output_json:
+        with open(args.output_json, 'w') as f:
+            json.dump({"results": results}, f, indent=2)
+
+
+if __name__ == "__main__":
+    main()
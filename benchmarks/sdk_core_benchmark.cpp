@@ -0,0 +1,444 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <atomic>
+#include <iterator>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <boost/any.hpp>
+#include <benchmark/benchmark.h>
+#include <opencv2/core.hpp>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/base/utils/lock_free_object_pool.h"
+#include "metavision/sdk/base/utils/object_pool.h"
+#include "metavision/sdk/core/algorithms/flip_x_algorithm.h"
+#include "metavision/sdk/core/algorithms/flip_y_algorithm.h"
+#include "metavision/sdk/core/algorithms/fused_algorithm.h"
+#include "metavision/sdk/core/algorithms/periodic_frame_generation_algorithm.h"
+#include "metavision/sdk/core/algorithms/polarity_filter_algorithm.h"
+#include "metavision/sdk/core/algorithms/roi_filter_algorithm.h"
+#include "metavision/sdk/core/algorithms/time_surface_producer_algorithm.h"
+#include "metavision/sdk/core/pipeline/base_stage.h"
+#include "metavision/sdk/core/pipeline/pipeline.h"
+#include "metavision/sdk/core/pipeline/stage.h"
+#include "metavision/sdk/core/pipeline/typed_stage.h"
+#include "metavision/sdk/core/utils/timing_profiler.h"
+#include "synthetic_event_stream.h"
+
+using namespace Metavision;
+using namespace Metavision::Benchmarks;
+
+namespace {
+
+template<typename Algorithm>
+void run_filter_benchmark(benchmark::State &state, Algorithm &algo) {
+    const auto events = make_synthetic_cd_events(get_stream_config(state));
+    std::vector<EventCD> output;
+    output.reserve(events.size());
+
+    for (auto _ : state) {
+        output.clear();
+        algo.process_events(events.cbegin(), events.cend(), std::back_inserter(output));
+        benchmark::DoNotOptimize(output.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * events.size());
+    state.counters["output_ratio"] = static_cast<double>(output.size()) / events.size();
+}
+
+template<typename Algorithm>
+void run_soa_filter_benchmark(benchmark::State &state, Algorithm &algo) {
+    const auto events = make_synthetic_cd_events(get_stream_config(state));
+    EventCDBufferSoA input, output;
+    input.assign(events.cbegin(), events.cend());
+
+    for (auto _ : state) {
+        algo.process_events(input, output);
+        benchmark::DoNotOptimize(output.x());
+    }
+
+    state.SetItemsProcessed(state.iterations() * events.size());
+    state.counters["output_ratio"] = static_cast<double>(output.size()) / events.size();
+}
+
+void BM_RoiFilterAlgorithm(benchmark::State &state) {
+    const SyntheticStreamConfig config;
+    RoiFilterAlgorithm algo(config.width / 4, config.height / 4, 3 * config.width / 4, 3 * config.height / 4);
+    run_filter_benchmark(state, algo);
+}
+BENCHMARK(BM_RoiFilterAlgorithm)->Apply(apply_stream_arguments);
+
+void BM_RoiFilterAlgorithm_soa(benchmark::State &state) {
+    const SyntheticStreamConfig config;
+    RoiFilterAlgorithm algo(config.width / 4, config.height / 4, 3 * config.width / 4, 3 * config.height / 4);
+    run_soa_filter_benchmark(state, algo);
+}
+BENCHMARK(BM_RoiFilterAlgorithm_soa)->Apply(apply_stream_arguments);
+
+void BM_PolarityFilterAlgorithm(benchmark::State &state) {
+    PolarityFilterAlgorithm algo(1);
+    run_filter_benchmark(state, algo);
+}
+BENCHMARK(BM_PolarityFilterAlgorithm)->Apply(apply_stream_arguments);
+
+void BM_PolarityFilterAlgorithm_soa(benchmark::State &state) {
+    PolarityFilterAlgorithm algo(1);
+    run_soa_filter_benchmark(state, algo);
+}
+BENCHMARK(BM_PolarityFilterAlgorithm_soa)->Apply(apply_stream_arguments);
+
+void BM_FlipXAlgorithm(benchmark::State &state) {
+    FlipXAlgorithm algo(SyntheticStreamConfig().width - 1);
+    run_filter_benchmark(state, algo);
+}
+BENCHMARK(BM_FlipXAlgorithm)->Apply(apply_stream_arguments);
+
+void BM_FlipXAlgorithm_soa(benchmark::State &state) {
+    FlipXAlgorithm algo(SyntheticStreamConfig().width - 1);
+    run_soa_filter_benchmark(state, algo);
+}
+BENCHMARK(BM_FlipXAlgorithm_soa)->Apply(apply_stream_arguments);
+
+void BM_FlipYAlgorithm(benchmark::State &state) {
+    FlipYAlgorithm algo(SyntheticStreamConfig().height - 1);
+    run_filter_benchmark(state, algo);
+}
+BENCHMARK(BM_FlipYAlgorithm)->Apply(apply_stream_arguments);
+
+void BM_FlipYAlgorithm_soa(benchmark::State &state) {
+    FlipYAlgorithm algo(SyntheticStreamConfig().height - 1);
+    run_soa_filter_benchmark(state, algo);
+}
+BENCHMARK(BM_FlipYAlgorithm_soa)->Apply(apply_stream_arguments);
+
+// ROI filter, polarity filter and flip X, applied one after the other as chained stages would
+void BM_ChainedFilters(benchmark::State &state) {
+    const SyntheticStreamConfig config;
+    const auto events = make_synthetic_cd_events(get_stream_config(state));
+    RoiFilterAlgorithm roi(config.width / 4, config.height / 4, 3 * config.width / 4, 3 * config.height / 4);
+    PolarityFilterAlgorithm polarity(1);
+    FlipXAlgorithm flip_x(config.width - 1);
+    std::vector<EventCD> roi_output, polarity_output, output;
+    roi_output.reserve(events.size());
+    polarity_output.reserve(events.size());
+    output.reserve(events.size());
+
+    for (auto _ : state) {
+        roi_output.clear();
+        polarity_output.clear();
+        output.clear();
+        roi.process_events(events.cbegin(), events.cend(), std::back_inserter(roi_output));
+        polarity.process_events(roi_output.cbegin(), roi_output.cend(), std::back_inserter(polarity_output));
+        flip_x.process_events(polarity_output.cbegin(), polarity_output.cend(), std::back_inserter(output));
+        benchmark::DoNotOptimize(output.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * events.size());
+    state.counters["output_ratio"] = static_cast<double>(output.size()) / events.size();
+}
+BENCHMARK(BM_ChainedFilters)->Apply(apply_stream_arguments);
+
+void BM_FusedFilters(benchmark::State &state) {
+    const SyntheticStreamConfig config;
+    auto algo = make_fused_algorithm(
+        RoiFilterAlgorithm(config.width / 4, config.height / 4, 3 * config.width / 4, 3 * config.height / 4),
+        PolarityFilterAlgorithm(1), FlipXAlgorithm(config.width - 1));
+    run_filter_benchmark(state, *algo);
+}
+BENCHMARK(BM_FusedFilters)->Apply(apply_stream_arguments);
+
+// The frames are generated from process_async, called by process_events every 1/fps of events time
+void BM_PeriodicFrameGenerationAlgorithm(benchmark::State &state) {
+    const auto config = get_stream_config(state);
+    auto events       = make_synthetic_cd_events(config);
+
+    PeriodicFrameGenerationAlgorithm algo(config.width, config.height, 10000, 100.);
+    size_t n_frames = 0;
+    algo.set_output_callback([&n_frames](timestamp, cv::Mat &frame) {
+        ++n_frames;
+        benchmark::DoNotOptimize(frame.data);
+    });
+
+    for (auto _ : state) {
+        algo.process_events(events.cbegin(), events.cend());
+        state.PauseTiming();
+        shift_to_next_period(events);
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(state.iterations() * events.size());
+    state.counters["frames"] = benchmark::Counter(n_frames, benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_PeriodicFrameGenerationAlgorithm)->Apply(apply_stream_arguments);
+
+template<int CHANNELS>
+void BM_TimeSurfaceProducerAlgorithm(benchmark::State &state) {
+    const auto config = get_stream_config(state);
+    auto events       = make_synthetic_cd_events(config);
+
+    TimeSurfaceProducerAlgorithm<CHANNELS> algo(config.width, config.height);
+    algo.set_processing_n_us(10000);
+    size_t n_time_surfaces = 0;
+    algo.set_output_callback([&n_time_surfaces](timestamp, const MostRecentTimestampBuffer &time_surface) {
+        ++n_time_surfaces;
+        benchmark::DoNotOptimize(time_surface.ptr());
+    });
+
+    for (auto _ : state) {
+        algo.process_events(events.cbegin(), events.cend());
+        state.PauseTiming();
+        shift_to_next_period(events);
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(state.iterations() * events.size());
+    state.counters["time_surfaces"] = benchmark::Counter(n_time_surfaces, benchmark::Counter::kIsRate);
+}
+BENCHMARK_TEMPLATE(BM_TimeSurfaceProducerAlgorithm, 1)->Apply(apply_stream_arguments);
+BENCHMARK_TEMPLATE(BM_TimeSurfaceProducerAlgorithm, 2)->Apply(apply_stream_arguments);
+
+using EventBuffer    = std::vector<EventCD>;
+using EventBufferPtr = SharedObjectPool<EventBuffer>::ptr_type;
+
+// Stage producing the same buffer a given number of times from its own thread
+struct BufferProducingStage : public BaseStage {
+    BufferProducingStage(const EventBufferPtr &buffer, size_t n_buffers) {
+        set_starting_callback([this, buffer, n_buffers] {
+            thread_ = std::thread([this, buffer, n_buffers] {
+                for (size_t i = 0; i < n_buffers && !stopped_; ++i) {
+                    produce(buffer);
+                }
+                if (!stopped_) {
+                    complete();
+                }
+            });
+        });
+        set_stopping_callback([this] {
+            stopped_ = true;
+            if (thread_.joinable()) {
+                thread_.join();
+            }
+        });
+    }
+
+    std::thread thread_;
+    std::atomic<bool> stopped_{false};
+};
+
+// Stage forwarding the data it receives to the next stages
+struct ForwardingStage : public BaseStage {
+    ForwardingStage() {
+        set_consuming_callback([this](const boost::any &data) { produce(data); });
+    }
+};
+
+// Measures the cost of scheduling the tasks of a chain of stages forwarding buffers of events, independently of any
+// processing
+void BM_Pipeline_TaskScheduler(benchmark::State &state) {
+    const size_t n_buffers = 10000;
+    const auto n_stages    = state.range(0);
+    auto pool              = SharedObjectPool<EventBuffer>::make_bounded();
+    auto buffer            = pool.acquire();
+    buffer->resize(state.range(1));
+
+    size_t n_consumed = 0;
+    for (auto _ : state) {
+        Pipeline p(true);
+        BaseStage *prev_stage = &p.add_stage(std::make_unique<BufferProducingStage>(buffer, n_buffers));
+        for (int64_t i = 1; i < n_stages; ++i) {
+            prev_stage = &p.add_stage(std::make_unique<ForwardingStage>(), *prev_stage);
+        }
+        auto &last_stage = p.add_stage(std::make_unique<Stage>(), *prev_stage);
+        last_stage.set_consuming_callback([&n_consumed](const boost::any &) { ++n_consumed; });
+        p.run();
+    }
+
+    state.SetItemsProcessed(state.iterations() * n_buffers * n_stages);
+    state.counters["consumed_ratio"] = static_cast<double>(n_consumed) / (state.iterations() * n_buffers);
+}
+BENCHMARK(BM_Pipeline_TaskScheduler)
+    ->ArgNames({"n_stages", "buffer_size"})
+    ->ArgsProduct({{1, 2, 4}, {0, 4096}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+// Typed stage producing the same buffer a given number of times from its own thread
+struct TypedBufferProducingStage : public TypedStage<EventBufferPtr, EventBufferPtr> {
+    TypedBufferProducingStage(const EventBufferPtr &buffer, size_t n_buffers) {
+        set_starting_callback([this, buffer, n_buffers] {
+            thread_ = std::thread([this, buffer, n_buffers] {
+                for (size_t i = 0; i < n_buffers && !stopped_; ++i) {
+                    produce(buffer);
+                }
+                if (!stopped_) {
+                    complete();
+                }
+            });
+        });
+        set_stopping_callback([this] {
+            stopped_ = true;
+            if (thread_.joinable()) {
+                thread_.join();
+            }
+        });
+    }
+
+    std::thread thread_;
+    std::atomic<bool> stopped_{false};
+};
+
+struct TypedForwardingStage : public TypedStage<EventBufferPtr, EventBufferPtr> {
+    template<typename PrevStage>
+    explicit TypedForwardingStage(PrevStage &prev_stage) : TypedStage(prev_stage) {
+        set_consuming_callback([this](EventBufferPtr &&buffer) { produce(std::move(buffer)); });
+    }
+};
+
+// Same as BM_Pipeline_TaskScheduler, with the buffers passed through the channels of typed stages instead of
+// boost::any
+void BM_Pipeline_TypedStages(benchmark::State &state) {
+    const size_t n_buffers = 10000;
+    const auto n_stages    = state.range(0);
+    auto pool              = SharedObjectPool<EventBuffer>::make_bounded();
+    auto buffer            = pool.acquire();
+    buffer->resize(state.range(1));
+
+    size_t n_consumed = 0;
+    for (auto _ : state) {
+        Pipeline p(true);
+        std::vector<TypedStage<EventBufferPtr, EventBufferPtr> *> stages;
+        stages.push_back(&p.add_stage(std::make_unique<TypedBufferProducingStage>(buffer, n_buffers)));
+        for (int64_t i = 1; i < n_stages; ++i) {
+            stages.push_back(&p.add_stage(std::make_unique<TypedForwardingStage>(*stages.back())));
+        }
+        auto &last_stage = p.add_stage(std::make_unique<TypedStage<EventBufferPtr, EventBufferPtr>>(*stages.back()));
+        last_stage.set_consuming_callback([&n_consumed](EventBufferPtr &&) { ++n_consumed; });
+        p.run();
+    }
+
+    state.SetItemsProcessed(state.iterations() * n_buffers * n_stages);
+    state.counters["consumed_ratio"] = static_cast<double>(n_consumed) / (state.iterations() * n_buffers);
+}
+BENCHMARK(BM_Pipeline_TypedStages)
+    ->ArgNames({"n_stages", "buffer_size"})
+    ->ArgsProduct({{1, 2, 4}, {0, 4096}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+template<typename Pool>
+void run_object_pool_benchmark(benchmark::State &state, Pool &pool) {
+    const size_t n_objects = state.range(0);
+    std::vector<typename Pool::ptr_type> objects;
+    objects.reserve(n_objects);
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < n_objects; ++i) {
+            objects.emplace_back(pool.acquire());
+        }
+        benchmark::DoNotOptimize(objects.data());
+        objects.clear();
+    }
+
+    state.SetItemsProcessed(state.iterations() * n_objects);
+}
+
+void BM_ObjectPool_acquire_release(benchmark::State &state) {
+    auto pool = ObjectPool<EventBuffer>::make_bounded(state.range(0));
+    run_object_pool_benchmark(state, pool);
+}
+BENCHMARK(BM_ObjectPool_acquire_release)->ArgName("n_objects")->Arg(1)->Arg(64);
+
+void BM_SharedObjectPool_acquire_release(benchmark::State &state) {
+    auto pool = SharedObjectPool<EventBuffer>::make_bounded(state.range(0));
+    run_object_pool_benchmark(state, pool);
+}
+BENCHMARK(BM_SharedObjectPool_acquire_release)->ArgName("n_objects")->Arg(1)->Arg(64);
+
+void BM_LockFreeObjectPool_acquire_release(benchmark::State &state) {
+    auto pool = LockFreeObjectPool<EventBuffer>::make_bounded(state.range(0));
+    run_object_pool_benchmark(state, pool);
+}
+BENCHMARK(BM_LockFreeObjectPool_acquire_release)->ArgName("n_objects")->Arg(1)->Arg(64);
+
+void BM_SharedLockFreeObjectPool_acquire_release(benchmark::State &state) {
+    auto pool = SharedLockFreeObjectPool<EventBuffer>::make_bounded(state.range(0));
+    run_object_pool_benchmark(state, pool);
+}
+BENCHMARK(BM_SharedLockFreeObjectPool_acquire_release)->ArgName("n_objects")->Arg(1)->Arg(64);
+
+// Objects are released from another thread than the one acquiring them, as in a producer/consumer pipeline
+void BM_SharedObjectPool_acquire_release_across_threads(benchmark::State &state) {
+    auto pool = SharedObjectPool<EventBuffer>::make_unbounded(64);
+
+    for (auto _ : state) {
+        std::vector<EventBufferPtr> objects;
+        for (size_t i = 0; i < 64; ++i) {
+            objects.emplace_back(pool.acquire());
+        }
+        std::thread([&objects] { objects.clear(); }).join();
+    }
+
+    state.SetItemsProcessed(state.iterations() * 64);
+}
+BENCHMARK(BM_SharedObjectPool_acquire_release_across_threads)->UseRealTime();
+
+// Several threads sharing a pool, as the decoding threads of several cameras
+template<typename Pool>
+void run_contended_object_pool_benchmark(benchmark::State &state, Pool &pool) {
+    for (auto _ : state) {
+        for (size_t i = 0; i < 64; ++i) {
+            auto object = pool.acquire();
+            benchmark::DoNotOptimize(object.get());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * 64);
+}
+
+SharedObjectPool<EventBuffer> contended_object_pool = SharedObjectPool<EventBuffer>::make_bounded(4);
+void BM_SharedObjectPool_contended(benchmark::State &state) {
+    run_contended_object_pool_benchmark(state, contended_object_pool);
+}
+BENCHMARK(BM_SharedObjectPool_contended)->ThreadRange(1, 4)->UseRealTime();
+
+SharedLockFreeObjectPool<EventBuffer> contended_lock_free_object_pool =
+    SharedLockFreeObjectPool<EventBuffer>::make_bounded(4);
+void BM_SharedLockFreeObjectPool_contended(benchmark::State &state) {
+    run_contended_object_pool_benchmark(state, contended_lock_free_object_pool);
+}
+BENCHMARK(BM_SharedLockFreeObjectPool_contended)->ThreadRange(1, 4)->UseRealTime();
+
+void BM_TimingProfiler_thread_safe(benchmark::State &state) {
+    static TimingProfiler<true> profiler;
+    profiler.set_printing_callback([](const detail::OperationStoragePolicyInsertionOrder &) {});
+    for (auto _ : state) {
+        TimingProfiler<true>::TimedOperation t("Processing", &profiler);
+    }
+}
+BENCHMARK(BM_TimingProfiler_thread_safe)->ThreadRange(1, 4)->UseRealTime();
+
+using HistogramTimingProfiler =
+    TimingProfiler<true, detail::ConcurrencyPolicyLockFree, detail::OperationStoragePolicyHistogram>;
+
+void BM_TimingProfiler_histogram_interned(benchmark::State &state) {
+    static HistogramTimingProfiler profiler;
+    profiler.set_printing_callback([](const detail::OperationStoragePolicyHistogram &) {});
+    const auto op_id = profiler.intern("Processing");
+    for (auto _ : state) {
+        HistogramTimingProfiler::TimedOperation t(op_id, &profiler);
+    }
+}
+BENCHMARK(BM_TimingProfiler_histogram_interned)->ThreadRange(1, 4)->UseRealTime();
+
+} // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,458 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+// Benchmarks of the storage backends reading and writing RAW files, to choose their settings for a given storage.
+//
+// The cases are run in each of the directories given by the environment variable METAVISION_BENCHMARK_IO_DIRS, as a
+// comma separated list, typically one per file system or device to compare (the temporary directory of the system by
+// default). The file system and device of each directory are reported in the context of the results, and the cases
+// are suffixed by the index of their directory.
+//
+// The reading cases read a synthetic RAW file of METAVISION_BENCHMARK_IO_FILE_SIZE_MB megabytes (256 by default)
+// through each reading backend, for the numbers of RAW events per read and of read buffers given by
+// METAVISION_BENCHMARK_IO_READ_SIZES and METAVISION_BENCHMARK_IO_READ_BUFFERS. The file is evicted from the page cache
+// before each run so that the device is measured, unless METAVISION_BENCHMARK_IO_CACHED is set. The latency counters
+// are the times the consumer waited for each buffer.
+//
+// The writing cases record the same amount of data through each writer, with buffers of the sizes in bytes given by
+// METAVISION_BENCHMARK_IO_WRITE_SIZES. The files are synchronized with the device before the end of each run, and the
+// latency counters are the times spent by the consumer to hand each buffer over to the writer. The striped writer
+// stripes the recording across all the directories.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <benchmark/benchmark.h>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#ifdef __linux__
+#include <sys/sysmacros.h>
+#include <sys/vfs.h>
+#endif
+
+#include "metavision/hal/facilities/i_events_stream.h"
+#include "metavision/hal/facilities/i_hw_identification.h"
+#include "metavision/hal/facilities/i_plugin_software_info.h"
+#include "metavision/hal/utils/async_raw_file_writer.h"
+#include "metavision/hal/utils/compressed_raw_file.h"
+#include "metavision/hal/utils/compressed_raw_file_stream.h"
+#include "metavision/hal/utils/file_data_transfer.h"
+#include "metavision/hal/utils/hal_software_info.h"
+#include "metavision/hal/utils/memory_mapped_file_stream.h"
+#include "metavision/hal/utils/memory_raw_stream.h"
+#include "metavision/hal/utils/raw_file_config.h"
+#include "metavision/hal/utils/raw_file_header.h"
+#include "metavision/hal/utils/read_ahead_file_stream.h"
+#include "metavision/hal/utils/striped_raw_file_writer.h"
+#include "metavision/sdk/base/utils/mapped_file_writer.h"
+#include "synthetic_event_stream.h"
+#include "synthetic_raw_stream.h"
+
+using namespace Metavision;
+using namespace Metavision::Benchmarks;
+
+namespace {
+
+constexpr uint32_t RawEventSize = sizeof(uint32_t); // EVT2
+
+enum class ReadBackend { Stream, MemoryMapping, ReadAhead, Compressed };
+enum class Writer { Stream, Async, AsyncDirectIO, Mapped, Striped };
+
+// Identification of the recordings, only used for their header
+struct BenchmarkHWIdentification : public I_HW_Identification {
+    BenchmarkHWIdentification() :
+        I_HW_Identification(std::make_shared<I_PluginSoftwareInfo>("benchmark", get_hal_software_info())) {}
+
+    std::string get_serial() const override {
+        return std::string();
+    }
+
+    long get_system_id() const override {
+        return 0;
+    }
+
+    SensorInfo get_sensor_info() const override {
+        return SensorInfo();
+    }
+
+    long get_system_version() const override {
+        return 0;
+    }
+
+    std::vector<std::string> get_available_raw_format() const override {
+        return {"EVT2"};
+    }
+
+    std::string get_integrator() const override {
+        return "Prophesee";
+    }
+
+    std::string get_connection_type() const override {
+        return std::string();
+    }
+};
+
+std::vector<std::string> get_io_dirs() {
+    std::vector<std::string> dirs;
+    const char *value = std::getenv("METAVISION_BENCHMARK_IO_DIRS");
+    std::istringstream iss(value ? value : "");
+    std::string dir;
+    while (std::getline(iss, dir, ',')) {
+        if (!dir.empty()) {
+            dirs.push_back(dir);
+        }
+    }
+    if (dirs.empty()) {
+        const char *tmpdir = std::getenv("TMPDIR");
+        dirs.push_back(tmpdir ? tmpdir : "/tmp");
+    }
+    return dirs;
+}
+
+uint64_t get_file_size() {
+    return static_cast<uint64_t>(get_env_int_list("METAVISION_BENCHMARK_IO_FILE_SIZE_MB", {256}).front()) << 20;
+}
+
+// Describes the file system and the device of a directory, as reported in the context of the results
+std::string describe_storage(const std::string &dir) {
+    std::string file_system = "unknown file system", device = "unknown device";
+#ifdef __linux__
+    struct statfs fs_stat;
+    if (statfs(dir.c_str(), &fs_stat) == 0) {
+        static const std::map<long, std::string> names{
+            {0xEF53, "ext4"}, {0x58465342, "xfs"}, {0x9123683E, "btrfs"}, {0x01021994, "tmpfs"},
+            {0x6969, "nfs"},  {0xFF534D42, "cifs"}, {0x794C7630, "overlay"}, {0x2FC12FC1, "zfs"},
+            {0x65735546, "fuse"}, {0x4D44, "vfat"}, {0x5346544E, "ntfs"}, {0xF2F52010, "f2fs"}};
+        const auto it = names.find(static_cast<long>(fs_stat.f_type));
+        std::ostringstream oss;
+        if (it != names.end()) {
+            oss << it->second;
+        } else {
+            oss << "file system 0x" << std::hex << fs_stat.f_type;
+        }
+        file_system = oss.str();
+    }
+    struct stat dir_stat;
+    if (stat(dir.c_str(), &dir_stat) == 0) {
+        const std::string dev = std::to_string(major(dir_stat.st_dev)) + ":" + std::to_string(minor(dir_stat.st_dev));
+        device                = "device " + dev;
+        std::ifstream uevent("/sys/dev/block/" + dev + "/uevent");
+        std::string line;
+        while (std::getline(uevent, line)) {
+            if (line.compare(0, 8, "DEVNAME=") == 0) {
+                device = "/dev/" + line.substr(8) + " (" + dev + ")";
+            }
+        }
+    }
+#endif
+    return dir + ", " + file_system + ", " + device;
+}
+
+// Writes the data of a file to the device, and evicts it from the page cache so that the next read hits the device
+void sync_file(const std::string &path, bool evict) {
+#ifndef _WIN32
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return;
+    }
+    fsync(fd);
+#if defined(__linux__)
+    if (evict) {
+        posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    }
+#endif
+    close(fd);
+#endif
+}
+
+std::string get_header(RawCompression compression) {
+    auto header = BenchmarkHWIdentification().get_header();
+    set_raw_file_compression(header, compression, 1024 * 1024);
+    std::ostringstream oss;
+    oss << header;
+    return oss.str();
+}
+
+// A few MB of EVT2 data, repeated to make the files, so that their compression ratio is the one of actual recordings
+const std::vector<uint32_t> &get_synthetic_chunk() {
+    static const std::vector<uint32_t> chunk = encode_evt2(make_synthetic_cd_events(SyntheticStreamConfig()));
+    return chunk;
+}
+
+// Buffers made of the synthetic chunk repeated up to the size of the files
+std::vector<MemoryRawStream::Buffer> get_synthetic_buffers() {
+    const auto &chunk         = get_synthetic_chunk();
+    const uint64_t chunk_size = chunk.size() * sizeof(uint32_t);
+    std::vector<MemoryRawStream::Buffer> buffers;
+    for (uint64_t size = 0, file_size = get_file_size(); size < file_size; size += chunk_size) {
+        buffers.push_back({chunk.data(), static_cast<size_t>(std::min(chunk_size, file_size - size))});
+    }
+    return buffers;
+}
+
+// Writes the files read by the reading cases in a directory, once
+const std::string &get_read_file(const std::string &dir, bool compressed) {
+    static std::map<std::pair<std::string, bool>, std::string> files;
+    auto &path = files[std::make_pair(dir, compressed)];
+    if (!path.empty()) {
+        return path;
+    }
+
+    path = dir + (compressed ? "/metavision_io_benchmark_lz4.raw" : "/metavision_io_benchmark.raw");
+    if (compressed) {
+        AsyncRawFileWriterConfig config;
+        config.compression_ = RawCompression::LZ4;
+        AsyncRawFileWriter writer(path, get_header(RawCompression::LZ4), config);
+        for (const auto &buffer : get_synthetic_buffers()) {
+            auto data = reinterpret_cast<DataTransfer::Data *>(const_cast<void *>(buffer.data));
+            writer.write(DataTransfer::BufferSlice::from_external_memory(data, data + buffer.size, [] {}));
+        }
+    } else {
+        std::ofstream ofs(path, std::ios::binary);
+        ofs << get_header(RawCompression::None);
+        for (const auto &buffer : get_synthetic_buffers()) {
+            ofs.write(static_cast<const char *>(buffer.data), buffer.size);
+        }
+    }
+    return path;
+}
+
+// Accumulates the latencies of the buffers of a case, reported as counters
+class LatencyStats {
+public:
+    void add(std::chrono::steady_clock::duration duration) {
+        latencies_us_.push_back(std::chrono::duration<double, std::micro>(duration).count());
+    }
+
+    void report(benchmark::State &state, const std::string &prefix) {
+        if (latencies_us_.empty()) {
+            return;
+        }
+        std::sort(latencies_us_.begin(), latencies_us_.end());
+        double sum = 0;
+        for (const double latency : latencies_us_) {
+            sum += latency;
+        }
+        state.counters[prefix + "_mean_us"] = sum / latencies_us_.size();
+        state.counters[prefix + "_p99_us"]  = latencies_us_[latencies_us_.size() * 99 / 100];
+        state.counters[prefix + "_max_us"]  = latencies_us_.back();
+    }
+
+private:
+    std::vector<double> latencies_us_;
+};
+
+std::unique_ptr<std::istream> open_read_stream(ReadBackend backend, const std::string &path, uint32_t n_read_buffers) {
+    switch (backend) {
+    case ReadBackend::MemoryMapping:
+        return std::make_unique<MemoryMappedFileStream>(path);
+    case ReadBackend::ReadAhead:
+        // One buffer is always held by the consumer
+        return std::make_unique<ReadAheadFileStream>(path, std::max<uint32_t>(1, n_read_buffers - 1));
+    case ReadBackend::Compressed:
+        return std::make_unique<CompressedRawFileStream>(path);
+    default:
+        return std::make_unique<std::ifstream>(path, std::ios::binary);
+    }
+}
+
+void run_read_benchmark(benchmark::State &state, ReadBackend backend, const std::string &dir) {
+    const bool evict       = std::getenv("METAVISION_BENCHMARK_IO_CACHED") == nullptr;
+    const std::string path = get_read_file(dir, backend == ReadBackend::Compressed);
+
+    RawFileConfig config;
+    config.n_events_to_read_ = static_cast<uint32_t>(state.range(0));
+    config.n_read_buffers_   = static_cast<uint32_t>(state.range(1));
+
+    LatencyStats stats;
+    int64_t n_bytes_read = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        sync_file(path, evict);
+        state.ResumeTiming();
+
+        auto stream = open_read_stream(backend, path, config.n_read_buffers_);
+        RawFileHeader header(*stream);
+        I_EventsStream events_stream(std::make_unique<FileDataTransfer>(std::move(stream), RawEventSize, config),
+                                     std::make_shared<BenchmarkHWIdentification>());
+        events_stream.start();
+        while (true) {
+            const auto wait_start = std::chrono::steady_clock::now();
+            if (events_stream.wait_next_buffer() <= 0) {
+                break;
+            }
+            stats.add(std::chrono::steady_clock::now() - wait_start);
+            long n_bytes = 0;
+            benchmark::DoNotOptimize(events_stream.get_latest_raw_data(n_bytes));
+            n_bytes_read += n_bytes;
+        }
+        events_stream.stop();
+    }
+
+    state.SetBytesProcessed(n_bytes_read);
+    stats.report(state, "wait");
+}
+
+// Starts the recording of a stream, and returns the files written
+std::vector<std::string> start_recording(I_EventsStream &events_stream, Writer writer,
+                                         const std::vector<std::string> &dirs, const std::string &path) {
+    switch (writer) {
+    case Writer::Async:
+    case Writer::AsyncDirectIO: {
+        AsyncRawFileWriterConfig config;
+        config.use_direct_io_ = writer == Writer::AsyncDirectIO;
+        events_stream.log_raw_data_async(path, config);
+        return {path};
+    }
+    case Writer::Mapped: {
+        MappedFileWriterConfig config;
+        config.capacity_ = get_file_size() + (1 << 20);
+        events_stream.log_raw_data_mapped(path, config);
+        return {path};
+    }
+    case Writer::Striped: {
+        StripedRawFileWriterConfig config;
+        config.directories_             = dirs;
+        const std::string manifest_path = path + StripedRawFileWriter::ManifestExtension;
+        events_stream.log_raw_data_striped(manifest_path, config);
+        auto files = StripedRawFileWriter::read_manifest(manifest_path).stripe_files;
+        files.push_back(manifest_path);
+        return files;
+    }
+    default:
+        events_stream.log_raw_data(path);
+        return {path};
+    }
+}
+
+void run_write_benchmark(benchmark::State &state, Writer writer, const std::vector<std::string> &dirs) {
+    const std::string path = dirs.front() + "/metavision_io_benchmark_record.raw";
+    const auto buffers     = get_synthetic_buffers();
+
+    RawFileConfig config;
+    config.n_events_to_read_ = static_cast<uint32_t>(state.range(0) / RawEventSize);
+
+    LatencyStats stats;
+    int64_t n_bytes_written = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        I_EventsStream events_stream(
+            std::make_unique<FileDataTransfer>(std::make_unique<MemoryRawStream>(buffers), RawEventSize, config),
+            std::make_shared<BenchmarkHWIdentification>());
+        state.ResumeTiming();
+
+        const auto files = start_recording(events_stream, writer, dirs, path);
+        events_stream.start();
+        while (events_stream.wait_next_buffer() > 0) {
+            // The buffer is handed over to the writer by get_latest_raw_data
+            long n_bytes          = 0;
+            const auto hand_start = std::chrono::steady_clock::now();
+            benchmark::DoNotOptimize(events_stream.get_latest_raw_data(n_bytes));
+            stats.add(std::chrono::steady_clock::now() - hand_start);
+            n_bytes_written += n_bytes;
+        }
+        // Stopping the stream closes the files, they are then written to the device
+        events_stream.stop();
+        for (const auto &file : files) {
+            sync_file(file, false);
+        }
+
+        state.PauseTiming();
+        for (const auto &file : files) {
+            std::remove(file.c_str());
+        }
+        state.ResumeTiming();
+    }
+
+    state.SetBytesProcessed(n_bytes_written);
+    stats.report(state, "hand_over");
+}
+
+void apply_read_arguments(benchmark::internal::Benchmark *b) {
+    b->ArgNames({"n_events_to_read", "n_read_buffers"});
+    b->ArgsProduct({get_env_int_list("METAVISION_BENCHMARK_IO_READ_SIZES", {16384, 262144, 1048576}),
+                    get_env_int_list("METAVISION_BENCHMARK_IO_READ_BUFFERS", {2, 4, 8})});
+    b->Unit(benchmark::kMillisecond)->UseRealTime();
+}
+
+void apply_write_arguments(benchmark::internal::Benchmark *b) {
+    b->ArgName("buffer_size");
+    for (const auto size : get_env_int_list("METAVISION_BENCHMARK_IO_WRITE_SIZES", {65536, 1048576})) {
+        b->Arg(size);
+    }
+    b->Unit(benchmark::kMillisecond)->UseRealTime();
+}
+
+void register_benchmarks() {
+    const std::vector<std::pair<std::string, ReadBackend>> backends{{"Stream", ReadBackend::Stream},
+                                                                    {"MemoryMapping", ReadBackend::MemoryMapping},
+                                                                    {"ReadAhead", ReadBackend::ReadAhead},
+                                                                    {"Compressed", ReadBackend::Compressed}};
+    const std::vector<std::pair<std::string, Writer>> writers{{"Stream", Writer::Stream},
+                                                              {"Async", Writer::Async},
+                                                              {"AsyncDirectIO", Writer::AsyncDirectIO},
+                                                              {"Mapped", Writer::Mapped}};
+
+    const auto dirs = get_io_dirs();
+    for (size_t i = 0; i < dirs.size(); ++i) {
+        const std::string suffix = "/dir:" + std::to_string(i);
+        benchmark::AddCustomContext("dir:" + std::to_string(i), describe_storage(dirs[i]));
+        for (const auto &backend : backends) {
+            const auto dir = dirs[i];
+            benchmark::RegisterBenchmark(
+                ("BM_Read_" + backend.first + suffix).c_str(),
+                [backend, dir](benchmark::State &state) { run_read_benchmark(state, backend.second, dir); })
+                ->Apply(apply_read_arguments);
+        }
+        for (const auto &writer : writers) {
+            const std::vector<std::string> writer_dirs{dirs[i]};
+            benchmark::RegisterBenchmark(("BM_Write_" + writer.first + suffix).c_str(),
+                                         [writer, writer_dirs](benchmark::State &state) {
+                                             run_write_benchmark(state, writer.second, writer_dirs);
+                                         })
+                ->Apply(apply_write_arguments);
+        }
+    }
+    benchmark::RegisterBenchmark("BM_Write_Striped/all_dirs", [dirs](benchmark::State &state) {
+        run_write_benchmark(state, Writer::Striped, dirs);
+    })->Apply(apply_write_arguments);
+}
+
+void remove_read_files() {
+    for (const auto &dir : get_io_dirs()) {
+        std::remove((dir + "/metavision_io_benchmark.raw").c_str());
+        std::remove((dir + "/metavision_io_benchmark_lz4.raw").c_str());
+    }
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    register_benchmarks();
+    benchmark::RunSpecifiedBenchmarks();
+    remove_read_files();
+    return 0;
+}
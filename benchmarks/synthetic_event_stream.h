@@ -0,0 +1,143 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_BENCHMARKS_SYNTHETIC_EVENT_STREAM_H
+#define METAVISION_BENCHMARKS_SYNTHETIC_EVENT_STREAM_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+#include <benchmark/benchmark.h>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/base/utils/timestamp.h"
+
+namespace Metavision {
+namespace Benchmarks {
+
+/// @brief Parameters of a synthetic stream of CD events
+struct SyntheticStreamConfig {
+    /// Sensor's width
+    int width = 640;
+
+    /// Sensor's height
+    int height = 480;
+
+    /// Event rate, in Mev/s
+    int64_t rate_mev_s = 10;
+
+    /// Percentage of the pixels of the sensor that generate events
+    int64_t density_percent = 10;
+
+    /// Number of events in the stream
+    size_t n_events = 1 << 20;
+
+    /// Seed of the random generator, so that all the runs process the same stream
+    uint32_t seed = 42;
+};
+
+/// @brief Reads a comma separated list of integers from an environment variable
+/// @param name Name of the environment variable
+/// @param defaults Values used when the variable is not set or invalid
+inline std::vector<int64_t> get_env_int_list(const char *name, const std::vector<int64_t> &defaults) {
+    const char *value = std::getenv(name);
+    if (!value) {
+        return defaults;
+    }
+
+    std::vector<int64_t> values;
+    std::istringstream iss(value);
+    std::string token;
+    while (std::getline(iss, token, ',')) {
+        try {
+            const int64_t v = std::stoll(token);
+            if (v > 0) {
+                values.push_back(v);
+            }
+        } catch (...) {}
+    }
+    return values.empty() ? defaults : values;
+}
+
+/// @brief Registers the rates and densities to run a benchmark with
+///
+/// The rates (in Mev/s) and densities (in percentage of active pixels) are read from the environment variables
+/// METAVISION_BENCHMARK_RATES and METAVISION_BENCHMARK_DENSITIES, as comma separated lists of integers.
+/// The benchmark function can then get the corresponding configuration with @ref get_stream_config.
+inline void apply_stream_arguments(benchmark::internal::Benchmark *b) {
+    b->ArgNames({"rate_mev_s", "density_percent"});
+    b->ArgsProduct({get_env_int_list("METAVISION_BENCHMARK_RATES", {1, 10, 100}),
+                    get_env_int_list("METAVISION_BENCHMARK_DENSITIES", {1, 10, 100})});
+}
+
+/// @brief Gets the configuration of the stream of a benchmark registered with @ref apply_stream_arguments
+inline SyntheticStreamConfig get_stream_config(const benchmark::State &state) {
+    SyntheticStreamConfig config;
+    config.rate_mev_s      = state.range(0);
+    config.density_percent = std::min<int64_t>(100, state.range(1));
+    return config;
+}
+
+/// @brief Generates a stream of CD events
+///
+/// The events are uniformly distributed over a random subset of the pixels of the sensor, with timestamps increasing
+/// at the configured rate. Events sharing a timestamp are sorted by row, polarity and column, as a sensor would
+/// output them.
+inline std::vector<EventCD> make_synthetic_cd_events(const SyntheticStreamConfig &config) {
+    std::mt19937 gen(config.seed);
+
+    std::vector<uint32_t> pixels(config.width * config.height);
+    std::iota(pixels.begin(), pixels.end(), 0);
+    std::shuffle(pixels.begin(), pixels.end(), gen);
+    pixels.resize(std::max<size_t>(1, pixels.size() * config.density_percent / 100));
+
+    std::uniform_int_distribution<size_t> pixel_dist(0, pixels.size() - 1);
+    std::bernoulli_distribution polarity_dist;
+
+    std::vector<EventCD> events;
+    events.reserve(config.n_events);
+    for (size_t i = 0; i < config.n_events; ++i) {
+        const uint32_t pixel = pixels[pixel_dist(gen)];
+        events.emplace_back(pixel % config.width, pixel / config.width, polarity_dist(gen) ? 1 : 0,
+                            static_cast<timestamp>(i / config.rate_mev_s));
+    }
+
+    auto by_position = [](const EventCD &ev1, const EventCD &ev2) {
+        return std::tie(ev1.t, ev1.y, ev1.p, ev1.x) < std::tie(ev2.t, ev2.y, ev2.p, ev2.x);
+    };
+    std::sort(events.begin(), events.end(), by_position);
+
+    return events;
+}
+
+/// @brief Shifts the timestamps of the events by the duration of the stream
+///
+/// This is used to feed the same events several times to algorithms that expect increasing timestamps.
+inline void shift_to_next_period(std::vector<EventCD> &events) {
+    if (events.empty()) {
+        return;
+    }
+    const timestamp period = events.back().t - events.front().t + 1;
+    for (auto &ev : events) {
+        ev.t += period;
+    }
+}
+
+} // namespace Benchmarks
+} // namespace Metavision
+
+#endif // METAVISION_BENCHMARKS_SYNTHETIC_EVENT_STREAM_H
@@ -0,0 +1,50 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_BENCHMARKS_SYNTHETIC_RAW_STREAM_H
+#define METAVISION_BENCHMARKS_SYNTHETIC_RAW_STREAM_H
+
+#include <cstdint>
+#include <vector>
+
+#include "metavision/hal/decoders/detail/evt2_raw_format.h"
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/base/utils/timestamp.h"
+
+namespace Metavision {
+namespace Benchmarks {
+
+/// @brief Encodes CD events in the EVT2 format, as a sensor would output them
+inline std::vector<uint32_t> encode_evt2(const std::vector<EventCD> &events) {
+    std::vector<uint32_t> words;
+    words.reserve(events.size() + events.size() / 8 + 1);
+
+    bool has_time_high       = false;
+    timestamp last_time_high = 0;
+    for (const auto &ev : events) {
+        const timestamp time_high = ev.t >> Evt2::TimestampLsbBits;
+        if (!has_time_high || time_high != last_time_high) {
+            words.push_back((static_cast<uint32_t>(Evt2::EventTypes::EVT_TIME_HIGH) << Evt2::TypeShift) |
+                            static_cast<uint32_t>(time_high & Evt2::TsMsbMask));
+            has_time_high  = true;
+            last_time_high = time_high;
+        }
+        words.push_back(
+            (static_cast<uint32_t>(ev.p ? Evt2::EventTypes::CD_HIGH : Evt2::EventTypes::CD_LOW) << Evt2::TypeShift) |
+            (static_cast<uint32_t>(ev.t & Evt2::TsLsbMask) << Evt2::TimestampShift) | (ev.x << Evt2::XShift) | ev.y);
+    }
+    return words;
+}
+
+} // namespace Benchmarks
+} // namespace Metavision
+
+#endif // METAVISION_BENCHMARKS_SYNTHETIC_RAW_STREAM_H
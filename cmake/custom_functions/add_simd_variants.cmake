@@ -0,0 +1,106 @@
+# Copyright (c) Prophesee S.A.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+# Unless required by applicable law or agreed to in writing, software distributed under the License is distributed
+# on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and limitations under the License.
+
+include(CMakeParseArguments)
+
+# Function to compile SIMD variants of sources of a target, selected at runtime with Metavision::select_simd_variant
+#
+# When METAVISION_SIMD_DISPATCH is enabled, each source is compiled once more for each level supported by the target
+# architecture (AVX2 and AVX512 on x86, NEON on ARM), with the instruction set of the level enabled and MV_SIMD_VARIANT
+# defined as the namespace of the variant (avx2, avx512 or neon). The sources of the target are then compiled with
+# METAVISION_SIMD_<LEVEL> defined for each level whose variants were compiled.
+#
+# The variants are linked into the same binary as the scalar code, so they must not define anything the scalar code
+# could also define: every definition of a source, including its inline functions and templates, must be inside the
+# MV_SIMD_VARIANT namespace (or an anonymous namespace within it), and the source must not instantiate inline code
+# shared with other translation units (e.g. std::vector members or inline functions of other headers). The linker keeps
+# a single copy of such code, which may be the one compiled with the instruction set of a variant, and would then crash
+# on CPUs lacking it. Shared helpers must be passed to or called from the dispatching code instead.
+#
+# Parameters
+#   TARGET  - Target to add the variants to
+#   SOURCES - Sources to compile for each level. They must also be added to the target, for the scalar variant
+#   LEVELS  - Levels to compile the sources for, among AVX2, AVX512 and NEON
+#
+# Usage:
+#   add_simd_variants(TARGET metavision_sdk_core SOURCES ${CMAKE_CURRENT_SOURCE_DIR}/kernels.cpp LEVELS AVX2 NEON)
+function(add_simd_variants)
+    cmake_parse_arguments(PARSED_ARGS "" "TARGET" "SOURCES;LEVELS" ${ARGN})
+
+    # Check validity of input args
+    foreach(mandatory_arg TARGET SOURCES LEVELS)
+        if(NOT PARSED_ARGS_${mandatory_arg})
+            message(SEND_ERROR "Error when calling function add_simd_variants : missing mandatory argument ${mandatory_arg}")
+            return()
+        endif(NOT PARSED_ARGS_${mandatory_arg})
+    endforeach(mandatory_arg)
+
+    if (NOT METAVISION_SIMD_DISPATCH)
+        return()
+    endif (NOT METAVISION_SIMD_DISPATCH)
+
+    if (CMAKE_SYSTEM_PROCESSOR MATCHES "^(x86_64|AMD64|amd64|i[3-6]86|x86)$")
+        set(arch x86)
+    elseif (CMAKE_SYSTEM_PROCESSOR MATCHES "^(aarch64|arm64|ARM64)$")
+        set(arch arm64)
+    elseif (CMAKE_SYSTEM_PROCESSOR MATCHES "^arm")
+        set(arch arm)
+    else ()
+        return()
+    endif ()
+
+    foreach(level IN LISTS PARSED_ARGS_LEVELS)
+        if (arch STREQUAL "x86" AND level STREQUAL "AVX2")
+            if (MSVC)
+                set(flags "/arch:AVX2")
+            else (MSVC)
+                set(flags "-mavx2 -mfma -mbmi2")
+            endif (MSVC)
+        elseif (arch STREQUAL "x86" AND level STREQUAL "AVX512")
+            if (MSVC)
+                set(flags "/arch:AVX512")
+            else (MSVC)
+                set(flags "-mavx2 -mfma -mbmi2 -mavx512f -mavx512bw -mavx512vl")
+            endif (MSVC)
+        elseif (arch STREQUAL "arm64" AND level STREQUAL "NEON")
+            # Advanced SIMD is part of the baseline of ARMv8-A
+            set(flags "")
+        elseif (arch STREQUAL "arm" AND level STREQUAL "NEON")
+            set(flags "-mfpu=neon")
+        elseif (level MATCHES "^(AVX2|AVX512|NEON)$")
+            # Level of another architecture
+            continue()
+        else ()
+            message(SEND_ERROR "Error when calling function add_simd_variants : unknown level ${level}")
+            return()
+        endif ()
+
+        string(TOLOWER ${level} variant)
+        foreach(source IN LISTS PARSED_ARGS_SOURCES)
+            get_filename_component(source_path "${source}" ABSOLUTE)
+            get_filename_component(source_name "${source}" NAME_WE)
+            set(variant_source "${CMAKE_CURRENT_BINARY_DIR}/simd_variants/${source_name}_${variant}.cpp")
+
+            # The file is only rewritten when its content changes, to avoid useless rebuilds
+            set(variant_content "#define MV_SIMD_VARIANT ${variant}\n#include \"${source_path}\"\n")
+            set(previous_content "")
+            if (EXISTS "${variant_source}")
+                file(READ "${variant_source}" previous_content)
+            endif (EXISTS "${variant_source}")
+            if (NOT previous_content STREQUAL variant_content)
+                file(WRITE "${variant_source}" "${variant_content}")
+            endif (NOT previous_content STREQUAL variant_content)
+
+            set_source_files_properties("${variant_source}" PROPERTIES COMPILE_FLAGS "${flags}")
+            target_sources(${PARSED_ARGS_TARGET} PRIVATE "${variant_source}")
+        endforeach(source)
+
+        target_compile_definitions(${PARSED_ARGS_TARGET} PRIVATE METAVISION_SIMD_${level})
+    endforeach(level)
+endfunction(add_simd_variants)
@@ -19,6 +19,14 @@
 #include <fstream>
 #include <sstream>
 #include <array>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <thread>
+#include <vector>
 #ifdef __linux__
 #include <regex>
 #endif
@@ -31,6 +39,15 @@
 #include <metavision/hal/facilities/i_hw_identification.h>
 #include <metavision/hal/facilities/i_ll_biases.h>
 #include <metavision/hal/facilities/i_geometry.h>
+#include <metavision/hal/facilities/i_decoder.h>
+#include <metavision/hal/facilities/i_device_control.h>
+#include <metavision/hal/facilities/i_erc.h>
+#include <metavision/hal/facilities/i_event_decoder.h>
+#include <metavision/hal/facilities/i_events_stream.h>
+#include <metavision/hal/decoders/evt2_decoder.h>
+#include <metavision/hal/decoders/evt3_decoder.h>
+#include <metavision/hal/decoders/detail/evt2_raw_format.h>
+#include <metavision/hal/decoders/detail/evt3_raw_format.h>
 #include <metavision/hal/device/device.h>
 #include <metavision/hal/device/device_discovery.h>
 #include <metavision/hal/utils/hal_exception.h>
@@ -435,11 +452,368 @@ void do_platform_diagnosis() {
 #endif
 }
 
+// Self-test of the capacity of the platform, see do_self_test
+namespace {
+
+using SelfTestClock  = std::chrono::steady_clock;
+using RawBuffer      = std::vector<Metavision::I_Decoder::RawData>;
+using CDDecoderPtr   = std::shared_ptr<Metavision::I_EventDecoder<Metavision::EventCD>>;
+using DecoderFactory = std::function<std::unique_ptr<Metavision::I_Decoder>(const CDDecoderPtr &)>;
+
+// Size of the synthetic RAW data decoded by each thread of the decoding benchmark
+constexpr size_t synthetic_data_size = 4 * 1024 * 1024;
+
+std::string format_double(double value, int precision = 1) {
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(precision) << value;
+    return oss.str();
+}
+
+void print_field(const std::string &label, const std::string &value) {
+    MV_LOG_INFO() << Metavision::Log::no_space << std::left << std::setw(label_size) << label << value << std::right;
+}
+
+template<typename Word>
+void push_word(RawBuffer &data, Word word) {
+    const auto *bytes = reinterpret_cast<const Metavision::I_Decoder::RawData *>(&word);
+    data.insert(data.end(), bytes, bytes + sizeof(Word));
+}
+
+// Generates EVT2 data of dense CD events, 10 events per microsecond
+RawBuffer make_evt2_data(size_t size_bytes) {
+    using namespace Metavision::Evt2;
+    RawBuffer data;
+    data.reserve(size_bytes + 2 * sizeof(RawWord));
+    int64_t last_time_high = -1;
+    for (uint64_t i = 0; data.size() < size_bytes; ++i) {
+        const uint64_t t = i / 10;
+        if (static_cast<int64_t>(t >> TimestampLsbBits) != last_time_high) {
+            last_time_high = t >> TimestampLsbBits;
+            push_word(data, static_cast<RawWord>((static_cast<RawWord>(EventTypes::EVT_TIME_HIGH) << TypeShift) |
+                                                 (last_time_high & TsMsbMask)));
+        }
+        const auto type = (i & 1) ? EventTypes::CD_HIGH : EventTypes::CD_LOW;
+        const RawWord x = (i * 7) % 1280, y = (i * 13) % 720;
+        push_word(data, static_cast<RawWord>((static_cast<RawWord>(type) << TypeShift) |
+                                             ((t & TsLsbMask) << TimestampShift) | (x << XShift) | y));
+    }
+    return data;
+}
+
+// Generates EVT3 data mixing single and vectorized CD events, 17 events per microsecond
+RawBuffer make_evt3_data(size_t size_bytes) {
+    using namespace Metavision::Evt3;
+    auto make_word = [](EventTypes type, uint32_t payload) {
+        return static_cast<RawWord>((static_cast<uint32_t>(type) << TypeShift) | payload);
+    };
+    RawBuffer data;
+    data.reserve(size_bytes + 8 * sizeof(RawWord));
+    int64_t last_time_high = -1;
+    for (uint64_t t = 0; data.size() < size_bytes; ++t) {
+        if (static_cast<int64_t>(t >> TimeLowBits) != last_time_high) {
+            last_time_high = t >> TimeLowBits;
+            push_word(data, make_word(EventTypes::EVT_TIME_HIGH, last_time_high & TimeMask));
+        }
+        const uint32_t x = (t * 7) % 1260, y = (t * 13) % 720, polarity = t & 1;
+        push_word(data, make_word(EventTypes::EVT_TIME_LOW, t & TimeMask));
+        push_word(data, make_word(EventTypes::CD_Y, y));
+        push_word(data, make_word(EventTypes::X_POS, (polarity << PolarityShift) | x));
+        push_word(data, make_word(EventTypes::X_BASE, (polarity << PolarityShift) | x));
+        push_word(data, make_word(EventTypes::VECT_12, Vect12Mask));
+        push_word(data, make_word(EventTypes::VECT_8, 0x0F));
+    }
+    return data;
+}
+
+struct DecodeRate {
+    double events_per_sec = 0.;
+    double bytes_per_sec  = 0.;
+};
+
+// Decodes the data over and over, from as many threads as requested, each with its own decoder and copy of the data
+DecodeRate measure_decode_rate(const DecoderFactory &make_decoder, const RawBuffer &data, double duration_s,
+                               unsigned int n_threads) {
+    std::vector<uint64_t> events(n_threads, 0), bytes(n_threads, 0);
+    std::vector<double> elapsed(n_threads, 0.);
+    std::vector<std::thread> threads;
+    std::atomic<bool> go{false};
+    for (unsigned int i = 0; i < n_threads; ++i) {
+        threads.emplace_back([&, i]() {
+            RawBuffer local_data(data);
+            uint64_t n_events = 0;
+            auto cd_decoder   = std::make_shared<Metavision::I_EventDecoder<Metavision::EventCD>>();
+            cd_decoder->add_event_buffer_callback(
+                [&n_events](const Metavision::EventCD *begin, const Metavision::EventCD *end) {
+                    n_events += end - begin;
+                });
+            while (!go) {
+                std::this_thread::yield();
+            }
+            const auto start    = SelfTestClock::now();
+            const auto deadline = start + std::chrono::duration_cast<SelfTestClock::duration>(
+                                              std::chrono::duration<double>(duration_s));
+            uint64_t n_bytes = 0;
+            do {
+                // A new decoder per pass, so that each pass starts from the beginning of the time of the data
+                auto decoder = make_decoder(cd_decoder);
+                decoder->decode(local_data.data(), local_data.data() + local_data.size());
+                n_bytes += local_data.size();
+            } while (SelfTestClock::now() < deadline);
+            elapsed[i] = std::chrono::duration<double>(SelfTestClock::now() - start).count();
+            events[i]  = n_events;
+            bytes[i]   = n_bytes;
+        });
+    }
+    go = true;
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    DecodeRate rate;
+    const double max_elapsed = *std::max_element(elapsed.begin(), elapsed.end());
+    if (max_elapsed > 0.) {
+        rate.events_per_sec = std::accumulate(events.begin(), events.end(), 0.) / max_elapsed;
+        rate.bytes_per_sec  = std::accumulate(bytes.begin(), bytes.end(), 0.) / max_elapsed;
+    }
+    return rate;
+}
+
+struct FormatCapacity {
+    std::string name;
+    uint8_t raw_event_size_bytes;
+    DecodeRate single_core;
+    DecodeRate all_cores;
+};
+
+std::vector<FormatCapacity> run_decode_self_test(double duration_s) {
+    struct SyntheticFormat {
+        std::string name;
+        uint8_t raw_event_size_bytes;
+        RawBuffer data;
+        DecoderFactory make_decoder;
+    };
+    std::vector<SyntheticFormat> formats;
+    formats.push_back({"EVT2", sizeof(Metavision::Evt2::RawWord), make_evt2_data(synthetic_data_size),
+                       [](const CDDecoderPtr &cd_decoder) {
+                           return std::unique_ptr<Metavision::I_Decoder>(
+                               new Metavision::EVT2Decoder(false, cd_decoder));
+                       }});
+    formats.push_back({"EVT3", sizeof(Metavision::Evt3::RawWord), make_evt3_data(synthetic_data_size),
+                       [](const CDDecoderPtr &cd_decoder) {
+                           return std::unique_ptr<Metavision::I_Decoder>(
+                               new Metavision::EVT3Decoder(false, cd_decoder));
+                       }});
+
+    const unsigned int n_cores = std::max(1u, std::thread::hardware_concurrency());
+    print_section("SELF-TEST - DECODING (SYNTHETIC DATA)");
+    print_field("Cores:", std::to_string(n_cores));
+
+    std::vector<FormatCapacity> capacities;
+    for (const auto &format : formats) {
+        FormatCapacity capacity{format.name, format.raw_event_size_bytes, {}, {}};
+        capacity.single_core = measure_decode_rate(format.make_decoder, format.data, duration_s, 1);
+        print_field(format.name + " (1 core):", format_double(capacity.single_core.events_per_sec / 1e6) +
+                                                    " Mev/s, " +
+                                                    format_double(capacity.single_core.bytes_per_sec / 1e6) + " MB/s");
+        capacity.all_cores = capacity.single_core;
+        if (n_cores > 1) {
+            capacity.all_cores = measure_decode_rate(format.make_decoder, format.data, duration_s, n_cores);
+            print_field(format.name + " (" + std::to_string(n_cores) + " cores):",
+                        format_double(capacity.all_cores.events_per_sec / 1e6) + " Mev/s, " +
+                            format_double(capacity.all_cores.events_per_sec / 1e6 / n_cores) + " Mev/s per core");
+        }
+        capacities.push_back(capacity);
+    }
+    return capacities;
+}
+
+// Decoding capacity of one core for the format of a device, identified by the size of its RAW events. The lowest
+// capacity measured is used for the formats that were not benchmarked.
+double get_single_core_decode_capacity(const std::vector<FormatCapacity> &capacities, uint8_t raw_event_size_bytes) {
+    double lowest = std::numeric_limits<double>::max();
+    for (const auto &capacity : capacities) {
+        if (capacity.raw_event_size_bytes == raw_event_size_bytes) {
+            return capacity.single_core.events_per_sec;
+        }
+        lowest = std::min(lowest, capacity.single_core.events_per_sec);
+    }
+    return lowest;
+}
+
+double get_percentile(std::vector<double> &values, double percentile) {
+    if (values.empty()) {
+        return 0.;
+    }
+    const size_t index = std::min(values.size() - 1, static_cast<size_t>(percentile * values.size()));
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+// Streams from the device for the given duration, decoding the data as the SDK would, and checks that the target rate
+// could be sustained without drops
+bool run_stream_self_test(Metavision::Device &device, const std::string &source, bool is_file, double duration_s,
+                          double target_rate, const std::vector<FormatCapacity> &capacities) {
+    print_section("SELF-TEST - STREAMING " + source);
+
+    auto *events_stream  = device.get_facility<Metavision::I_EventsStream>();
+    auto *decoder        = device.get_facility<Metavision::I_Decoder>();
+    auto *cd_decoder     = device.get_facility<Metavision::I_EventDecoder<Metavision::EventCD>>();
+    auto *device_control = device.get_facility<Metavision::I_DeviceControl>();
+    if (!events_stream || !decoder) {
+        MV_LOG_WARNING() << "The device can not stream events";
+        return false;
+    }
+
+    if (target_rate <= 0.) {
+        // The set point of the ERC is the highest rate the sensor will output
+        auto *erc = device.get_facility<Metavision::I_Erc>();
+        if (erc && erc->is_enabled()) {
+            target_rate = erc->get_cd_event_rate();
+        }
+    }
+
+    uint64_t n_events = 0;
+    size_t callback_id = 0;
+    if (cd_decoder) {
+        callback_id = cd_decoder->add_event_buffer_callback(
+            [&n_events](const Metavision::EventCD *begin, const Metavision::EventCD *end) { n_events += end - begin; });
+    }
+
+    // Peak bandwidth is measured over windows of this duration
+    static constexpr auto window = std::chrono::milliseconds(100);
+    uint64_t n_bytes = 0, n_buffers = 0, window_bytes = 0, peak_window_bytes = 0;
+    size_t peak_backlog = 0;
+    SelfTestClock::duration decode_time{0};
+    std::vector<double> handoff_latencies_us;
+
+    events_stream->start();
+    if (device_control) {
+        device_control->start();
+    }
+    const auto start    = SelfTestClock::now();
+    const auto deadline = start + std::chrono::duration_cast<SelfTestClock::duration>(
+                                      std::chrono::duration<double>(duration_s));
+    auto window_start = start;
+    auto now          = start;
+    while (now < deadline) {
+        const short ret = events_stream->poll_buffer();
+        if (ret < 0) {
+            break;
+        }
+        if (ret == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            now = SelfTestClock::now();
+            continue;
+        }
+
+        peak_backlog = std::max(peak_backlog, events_stream->get_backlog());
+        long n_rawbytes = 0;
+        auto *raw_data  = events_stream->get_latest_raw_data(n_rawbytes);
+        now             = SelfTestClock::now();
+        handoff_latencies_us.push_back(
+            std::chrono::duration<double, std::micro>(now - events_stream->get_latest_raw_data_arrival_time())
+                .count());
+
+        decoder->decode(raw_data, raw_data + n_rawbytes);
+        const auto decoded = SelfTestClock::now();
+        decode_time += decoded - now;
+        now = decoded;
+
+        ++n_buffers;
+        n_bytes += n_rawbytes;
+        window_bytes += n_rawbytes;
+        if (now - window_start >= window) {
+            peak_window_bytes = std::max(peak_window_bytes, window_bytes);
+            window_bytes      = 0;
+            window_start      = now;
+        }
+    }
+    const double elapsed_s = std::chrono::duration<double>(now - start).count();
+    if (device_control) {
+        device_control->stop();
+    }
+    events_stream->stop();
+    if (cd_decoder) {
+        cd_decoder->remove_callback(callback_id);
+    }
+
+    const auto statistics = events_stream->get_buffering_statistics();
+    const double window_s = std::chrono::duration<double>(window).count();
+    const double decode_s = std::chrono::duration<double>(decode_time).count();
+    print_field("Duration:", format_double(elapsed_s, 2) + " s");
+    print_field("Buffers:", std::to_string(n_buffers));
+    print_field("Sustained bandwidth:", format_double(elapsed_s > 0. ? n_bytes / elapsed_s / 1e6 : 0.) + " MB/s");
+    print_field("Peak bandwidth:", format_double(peak_window_bytes / window_s / 1e6) + " MB/s");
+    print_field("Event rate:", format_double(elapsed_s > 0. ? n_events / elapsed_s / 1e6 : 0., 2) + " Mev/s");
+    print_field("Decoding load:", format_double(elapsed_s > 0. ? 100. * decode_s / elapsed_s : 0.) + " %");
+    print_field("Handoff latency (p50):", format_double(get_percentile(handoff_latencies_us, 0.5)) + " us");
+    print_field("Handoff latency (p99):", format_double(get_percentile(handoff_latencies_us, 0.99)) + " us");
+    print_field("Handoff latency (max):", format_double(get_percentile(handoff_latencies_us, 1.)) + " us");
+    print_field("Peak backlog:", std::to_string(peak_backlog) + " buffers");
+    print_field("Peak buffers in use:", std::to_string(statistics.peak_depth));
+    print_field("Near drops:", std::to_string(statistics.near_drops));
+    print_field("Drops:", std::to_string(statistics.drops));
+
+    bool sustained = statistics.drops == 0;
+    if (target_rate > 0.) {
+        const double decode_capacity =
+            get_single_core_decode_capacity(capacities, decoder->get_raw_event_size_bytes());
+        print_field("Target event rate:", format_double(target_rate / 1e6, 2) + " Mev/s");
+        print_field("Decoding capacity:", format_double(decode_capacity / 1e6, 2) + " Mev/s");
+        sustained = sustained && decode_capacity >= target_rate;
+        if (is_file && n_events > 0) {
+            // The file is read as fast as possible, so that the event rate measured is the capacity of the storage
+            sustained = sustained && n_events / elapsed_s >= target_rate;
+        }
+        print_field("Target rate sustained:", sustained ? "YES" : "NO");
+    } else {
+        MV_LOG_INFO() << "The maximum event rate of the source is unknown, use --self-test-rate to set it";
+        print_field("Streamed without drops:", sustained ? "YES" : "NO");
+    }
+    return sustained;
+}
+
+} // namespace
+
+bool do_self_test(double duration_s, double target_rate, const std::vector<std::string> &input_files) {
+    print_title("SELF-TEST");
+    const auto capacities = run_decode_self_test(duration_s);
+
+    bool success = true;
+    for (const auto &serial : Metavision::DeviceDiscovery::list()) {
+        std::unique_ptr<Metavision::Device> device;
+        try {
+            device = Metavision::DeviceDiscovery::open(serial);
+        } catch (const Metavision::HalException &e) { MV_LOG_ERROR() << e.what(); }
+        if (device) {
+            success &= run_stream_self_test(*device, serial, false, duration_s, target_rate, capacities);
+        } else {
+            success = false;
+        }
+    }
+    for (const auto &input_file : input_files) {
+        std::unique_ptr<Metavision::Device> device;
+        try {
+            device = Metavision::DeviceDiscovery::open_raw_file(input_file);
+        } catch (const Metavision::HalException &e) { MV_LOG_ERROR() << e.what(); }
+        if (device) {
+            success &= run_stream_self_test(*device, input_file, true, duration_s, target_rate, capacities);
+        } else {
+            success = false;
+        }
+    }
+    return success;
+}
+
 int main(int argc, char *argv[]) {
     bool display_short_info    = false;
     bool display_systems_info  = false;
     bool display_software_info = false;
     bool display_platform_info = false;
+    bool run_self_test         = false;
+    double self_test_duration  = 5.;
+    double self_test_rate      = 0.;
+    std::vector<std::string> self_test_inputs;
     std::string output_file;
 
     const std::string program_desc("Metavision diagnosis tool.\n"
@@ -455,6 +829,10 @@ int main(int argc, char *argv[]) {
         ("software",  po::bool_switch(&display_software_info)->default_value(false), "Display installed software diagnosis.")
         ("platform",  po::bool_switch(&display_platform_info)->default_value(false), "Display platform diagnosis.")
         ("log,l",     po::value<std::string>(&output_file), "Log diagnosis into a file.")
+        ("self-test", po::bool_switch(&run_self_test)->default_value(false), "Run a self-test measuring the decoding throughput, the bandwidth, the buffer handoff latency and the drops of the connected cameras.")
+        ("self-test-duration", po::value<double>(&self_test_duration)->default_value(5.), "Duration in seconds of each measurement of the self-test.")
+        ("self-test-rate", po::value<double>(&self_test_rate)->default_value(0.), "Maximum event rate of the sensors, in Mev/s, that the self-test checks can be sustained. If 0, the set point of the ERC is used when it is enabled.")
+        ("self-test-input", po::value<std::vector<std::string>>(&self_test_inputs)->multitoken(), "RAW files also streamed by the self-test, to measure the bandwidth of the storage.")
         ;
     // clang-format on
     po::variables_map vm;
@@ -489,7 +867,8 @@ int main(int argc, char *argv[]) {
         do_short_diagnosis();
     }
 
-    bool display_all = !(display_short_info | display_systems_info | display_software_info | display_platform_info);
+    bool display_all =
+        !(display_short_info | display_systems_info | display_software_info | display_platform_info | run_self_test);
 
     display_systems_info |= display_all;
     display_software_info |= display_all;
@@ -507,7 +886,16 @@ int main(int argc, char *argv[]) {
         do_systems_diagnosis();
     }
 
+    bool self_test_passed = true;
+    if (run_self_test) {
+        if (self_test_duration <= 0.) {
+            MV_LOG_ERROR() << "Argument --self-test-duration must be positive";
+            return 1;
+        }
+        self_test_passed = do_self_test(self_test_duration, self_test_rate * 1e6, self_test_inputs);
+    }
+
     MV_LOG_INFO();
 
-    return 0;
+    return self_test_passed ? 0 : 1;
 }
@@ -0,0 +1,325 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <boost/program_options.hpp>
+
+#include <metavision/sdk/base/utils/log.h>
+#include <metavision/sdk/base/events/event_cd.h>
+#include <metavision/sdk/base/events/event_ext_trigger.h>
+#include <metavision/hal/utils/hal_exception.h>
+#include <metavision/hal/facilities/i_decoder.h>
+#include <metavision/hal/facilities/i_event_decoder.h>
+#include <metavision/hal/facilities/i_events_stream.h>
+#include <metavision/hal/facilities/i_geometry.h>
+#include <metavision/hal/device/device.h>
+#include <metavision/hal/device/device_discovery.h>
+#include <metavision/hal/utils/raw_file_config.h>
+
+namespace po = boost::program_options;
+
+namespace {
+
+// Statistics of a RAW file
+struct RawFileStatistics {
+    std::string path;
+    std::string error;
+    int width  = 0;
+    int height = 0;
+    uint64_t cd_count      = 0;
+    uint64_t trigger_count = 0;
+    Metavision::timestamp first_ts = -1;
+    Metavision::timestamp last_ts  = -1;
+    // Number of time windows per range of event rate, the range of index i being [2^(i-1), 2^i) ev/s (0 ev/s for 0)
+    std::vector<uint64_t> rate_histogram;
+    // Pixels with the most events, with their count
+    std::vector<std::pair<std::pair<int, int>, uint64_t>> hotspots;
+};
+
+// Accumulates the statistics of the CD events of a file
+class CDStatisticsAccumulator {
+public:
+    CDStatisticsAccumulator(RawFileStatistics &stats, Metavision::timestamp rate_window_us) :
+        stats_(stats), rate_window_us_(rate_window_us), pixel_counts_(stats.width * stats.height, 0) {}
+
+    void add_events(const Metavision::EventCD *begin, const Metavision::EventCD *end) {
+        if (begin == end) {
+            return;
+        }
+        if (stats_.first_ts < 0) {
+            stats_.first_ts = begin->t;
+            window_end_ts_  = begin->t + rate_window_us_;
+        }
+        stats_.cd_count += std::distance(begin, end);
+        stats_.last_ts = std::max(stats_.last_ts, (end - 1)->t);
+
+        for (auto ev = begin; ev != end; ++ev) {
+            while (ev->t >= window_end_ts_) {
+                close_window();
+            }
+            ++window_count_;
+            if (ev->x < stats_.width && ev->y < stats_.height) {
+                ++pixel_counts_[ev->y * stats_.width + ev->x];
+            }
+        }
+    }
+
+    void finish(size_t n_hotspots) {
+        if (stats_.first_ts >= 0) {
+            close_window();
+        }
+
+        std::vector<uint32_t> indexes(pixel_counts_.size());
+        for (uint32_t i = 0; i < indexes.size(); ++i) {
+            indexes[i] = i;
+        }
+        n_hotspots = std::min(n_hotspots, indexes.size());
+        std::partial_sort(indexes.begin(), indexes.begin() + n_hotspots, indexes.end(),
+                          [this](uint32_t a, uint32_t b) { return pixel_counts_[a] > pixel_counts_[b]; });
+        for (size_t i = 0; i < n_hotspots && pixel_counts_[indexes[i]] > 0; ++i) {
+            stats_.hotspots.emplace_back(std::make_pair(indexes[i] % stats_.width, indexes[i] / stats_.width),
+                                         pixel_counts_[indexes[i]]);
+        }
+    }
+
+private:
+    void close_window() {
+        const uint64_t rate = window_count_ * 1000000 / rate_window_us_;
+        size_t bin          = 0;
+        while ((uint64_t(1) << bin) <= rate) {
+            ++bin;
+        }
+        if (stats_.rate_histogram.size() <= bin) {
+            stats_.rate_histogram.resize(bin + 1, 0);
+        }
+        ++stats_.rate_histogram[bin];
+        window_count_ = 0;
+        window_end_ts_ += rate_window_us_;
+    }
+
+    RawFileStatistics &stats_;
+    const Metavision::timestamp rate_window_us_;
+    Metavision::timestamp window_end_ts_ = 0;
+    uint64_t window_count_               = 0;
+    std::vector<uint64_t> pixel_counts_;
+};
+
+// Decodes a whole RAW file and computes its statistics
+void analyze_raw_file(RawFileStatistics &stats, Metavision::timestamp rate_window_us, size_t n_hotspots) {
+    Metavision::RawFileConfig file_config;
+    file_config.do_time_shifting_ = false;
+    auto device                   = Metavision::DeviceDiscovery::open_raw_file(stats.path, file_config);
+
+    auto *i_decoder         = device->get_facility<Metavision::I_Decoder>();
+    auto *i_events_stream   = device->get_facility<Metavision::I_EventsStream>();
+    auto *i_cd_decoder      = device->get_facility<Metavision::I_EventDecoder<Metavision::EventCD>>();
+    auto *i_trigger_decoder = device->get_facility<Metavision::I_EventDecoder<Metavision::EventExtTrigger>>();
+    auto *i_geometry        = device->get_facility<Metavision::I_Geometry>();
+    if (!i_decoder || !i_events_stream) {
+        throw std::runtime_error("The file can not be decoded");
+    }
+    if (i_geometry) {
+        stats.width  = i_geometry->get_width();
+        stats.height = i_geometry->get_height();
+    }
+
+    CDStatisticsAccumulator cd_accumulator(stats, rate_window_us);
+    if (i_cd_decoder) {
+        i_cd_decoder->add_event_buffer_callback(
+            [&cd_accumulator](const Metavision::EventCD *begin, const Metavision::EventCD *end) {
+                cd_accumulator.add_events(begin, end);
+            });
+    }
+    if (i_trigger_decoder) {
+        i_trigger_decoder->add_event_buffer_callback(
+            [&stats](const Metavision::EventExtTrigger *begin, const Metavision::EventExtTrigger *end) {
+                stats.trigger_count += std::distance(begin, end);
+            });
+    }
+
+    i_events_stream->start();
+    while (i_events_stream->wait_next_buffer() >= 0) {
+        long n_rawbytes = 0;
+        auto *raw_data  = i_events_stream->get_latest_raw_data(n_rawbytes);
+        i_decoder->decode(raw_data, raw_data + n_rawbytes);
+    }
+    i_events_stream->stop();
+
+    cd_accumulator.finish(n_hotspots);
+}
+
+std::string to_json_string(const std::string &str) {
+    std::ostringstream oss;
+    oss << '"';
+    for (const char c : str) {
+        switch (c) {
+        case '"':
+            oss << "\\\"";
+            break;
+        case '\\':
+            oss << "\\\\";
+            break;
+        case '\n':
+            oss << "\\n";
+            break;
+        case '\t':
+            oss << "\\t";
+            break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                oss << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec;
+            } else {
+                oss << c;
+            }
+        }
+    }
+    oss << '"';
+    return oss.str();
+}
+
+void write_json(std::ostream &os, const RawFileStatistics &stats) {
+    os << "  {\n    \"file\": " << to_json_string(stats.path);
+    if (!stats.error.empty()) {
+        os << ",\n    \"error\": " << to_json_string(stats.error) << "\n  }";
+        return;
+    }
+    os << ",\n    \"width\": " << stats.width << ",\n    \"height\": " << stats.height;
+    os << ",\n    \"cd_events\": " << stats.cd_count << ",\n    \"trigger_events\": " << stats.trigger_count;
+    if (stats.first_ts >= 0) {
+        os << ",\n    \"first_ts\": " << stats.first_ts << ",\n    \"last_ts\": " << stats.last_ts;
+    } else {
+        os << ",\n    \"first_ts\": null,\n    \"last_ts\": null";
+    }
+
+    os << ",\n    \"rate_histogram\": [";
+    for (size_t i = 0; i < stats.rate_histogram.size(); ++i) {
+        const uint64_t min_rate = i == 0 ? 0 : (uint64_t(1) << (i - 1));
+        const uint64_t max_rate = i == 0 ? 1 : (uint64_t(1) << i);
+        os << (i == 0 ? "" : ",") << "\n      {\"min_ev_per_s\": " << min_rate << ", \"max_ev_per_s\": " << max_rate
+           << ", \"windows\": " << stats.rate_histogram[i] << "}";
+    }
+    os << (stats.rate_histogram.empty() ? "]" : "\n    ]");
+
+    os << ",\n    \"hotspots\": [";
+    for (size_t i = 0; i < stats.hotspots.size(); ++i) {
+        os << (i == 0 ? "" : ",") << "\n      {\"x\": " << stats.hotspots[i].first.first
+           << ", \"y\": " << stats.hotspots[i].first.second << ", \"events\": " << stats.hotspots[i].second << "}";
+    }
+    os << (stats.hotspots.empty() ? "]" : "\n    ]") << "\n  }";
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    std::vector<std::string> in_raw_file_paths;
+    std::string out_json_path;
+    unsigned int n_threads;
+    uint32_t rate_window_us;
+    size_t n_hotspots;
+
+    const std::string program_desc(
+        "Application computing statistics of RAW files with Metavision HAL, and writing them as JSON.\n"
+        "The files are decoded concurrently, each by one thread. For each file, it gives the number of events, the "
+        "timestamps of the first and last CD events, the histogram of the event rate over time windows, and the pixels "
+        "with the most events.\n");
+
+    po::options_description options_desc("Options");
+    // clang-format off
+    options_desc.add_options()
+        ("help,h", "Produce help message.")
+        ("input-raw-files,i", po::value<std::vector<std::string>>(&in_raw_file_paths)->multitoken()->required(),
+                              "Paths to the input RAW files.")
+        ("output-json-file,o", po::value<std::string>(&out_json_path), "Path to the output JSON file. If not "
+                                                                       "specified, the JSON is written on the "
+                                                                       "standard output.")
+        ("threads,j",         po::value<unsigned int>(&n_threads)->default_value(std::thread::hardware_concurrency()),
+                              "Number of files decoded concurrently.")
+        ("rate-window,w",     po::value<uint32_t>(&rate_window_us)->default_value(10000),
+                              "Duration of the time windows over which the event rate is computed, in us.")
+        ("hotspots,n",        po::value<size_t>(&n_hotspots)->default_value(10),
+                              "Number of pixels with the most events given for each file.")
+        ;
+    // clang-format on
+
+    po::positional_options_description positional_desc;
+    positional_desc.add("input-raw-files", -1);
+
+    po::variables_map vm;
+    po::store(po::command_line_parser(argc, argv).options(options_desc).positional(positional_desc).run(), vm);
+    if (vm.count("help")) {
+        MV_LOG_INFO() << program_desc;
+        MV_LOG_INFO() << options_desc;
+        return 0;
+    }
+    try {
+        po::notify(vm);
+    } catch (po::error &e) {
+        MV_LOG_ERROR() << program_desc;
+        MV_LOG_ERROR() << options_desc;
+        MV_LOG_ERROR() << "Parsing error:" << e.what();
+        return 1;
+    }
+
+    if (rate_window_us == 0) {
+        MV_LOG_ERROR() << "The duration of the rate windows must be positive";
+        return 1;
+    }
+
+    // Each thread analyzes the next file not taken yet
+    std::vector<RawFileStatistics> stats(in_raw_file_paths.size());
+    std::atomic<size_t> next_file{0};
+    auto worker = [&]() {
+        for (size_t i = next_file++; i < stats.size(); i = next_file++) {
+            stats[i].path = in_raw_file_paths[i];
+            try {
+                analyze_raw_file(stats[i], rate_window_us, n_hotspots);
+            } catch (const std::exception &e) {
+                stats[i].error = e.what();
+                MV_LOG_WARNING() << "Failed to analyze RAW file" << stats[i].path << ":" << e.what();
+            }
+        }
+    };
+    std::vector<std::thread> threads;
+    for (unsigned int i = 0; i < std::max(1u, std::min<unsigned int>(n_threads, stats.size())); ++i) {
+        threads.emplace_back(worker);
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    std::ofstream ofs;
+    if (!out_json_path.empty()) {
+        ofs.open(out_json_path);
+        if (!ofs) {
+            MV_LOG_ERROR() << "Unable to write in" << out_json_path;
+            return 1;
+        }
+    }
+    std::ostream &os = out_json_path.empty() ? std::cout : ofs;
+    os << "[";
+    for (size_t i = 0; i < stats.size(); ++i) {
+        os << (i == 0 ? "\n" : ",\n");
+        write_json(os, stats[i]);
+    }
+    os << "\n]\n";
+
+    return 0;
+}
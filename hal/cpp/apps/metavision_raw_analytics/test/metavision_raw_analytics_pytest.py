@@ -0,0 +1,142 @@
+#!/usr/bin/env python
+
+# Copyright (c) Prophesee S.A.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+# Unless required by applicable law or agreed to in writing, software distributed under the License is distributed
+# on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and limitations under the License.
+
+import pytest
+import os
+import re
+import json
+from metavision_utils import os_tools, pytest_tools
+
+
+def analyze(input_raws, options=""):
+    """Runs metavision_raw_analytics on input files and returns the statistics written in its JSON output
+    """
+
+    tmp_dir = os_tools.TemporaryDirectoryHandler()
+    output_json = os.path.join(tmp_dir.temporary_directory(), "stats.json")
+
+    cmd = "./metavision_raw_analytics {} -o {} {}".format(" ".join(["\"{}\"".format(f) for f in input_raws]),
+                                                          output_json, options)
+    output, error_code = pytest_tools.run_cmd_setting_mv_log_file(cmd)
+
+    # Check app exited without error
+    assert error_code == 0, "******\nError while executing cmd '{}':{}\n******".format(cmd, output)
+
+    # Check output file has been written
+    assert os.path.exists(output_json)
+    with open(output_json) as f:
+        return json.load(f)
+
+
+def get_raw_info_cd_count(input_raw):
+    """Gets the number of CD events of a file given by metavision_raw_info
+    """
+
+    cmd = "./metavision_raw_info -i \"{}\"".format(input_raw)
+    output, error_code = pytest_tools.run_cmd_setting_mv_log_file(cmd)
+    assert error_code == 0
+    match = re.search(r"^CD\s+([0-9]+)\s", output, re.MULTILINE)
+    assert match
+    return int(match.group(1))
+
+
+def pytestcase_test_metavision_raw_analytics_show_help():
+    '''
+    Checks output of metavision_raw_analytics when displaying help message
+    '''
+
+    cmd = "./metavision_raw_analytics --help"
+    output, error_code = pytest_tools.run_cmd_setting_mv_log_file(cmd)
+
+    # Check app exited without error
+    assert error_code == 0, "******\nError while executing cmd '{}':{}\n******".format(cmd, output)
+
+    # Check that the options shows in the output
+    assert "Options:" in output, "******\nMissing options display in output :{}\n******".format(output)
+
+
+def pytestcase_test_metavision_raw_analytics_missing_input_args():
+    '''
+    Checks that metavision_raw_analytics returns an error when not passing required input args
+    '''
+
+    cmd = "./metavision_raw_analytics"
+    output, error_code = pytest_tools.run_cmd_setting_mv_log_file(cmd)
+
+    # Check app exited with error
+    assert error_code != 0
+
+    # And now check that the error came from the fact that the input file arg is missing
+    assert re.search("Parsing error: the option (.+) is required but missing", output)
+
+
+def pytestcase_test_metavision_raw_analytics_non_existing_input_file(dataset_dir):
+    '''
+    Checks that metavision_raw_analytics reports the error of a file that doesn't exist, and still analyzes the others
+    '''
+
+    tmp_dir = os_tools.TemporaryDirectoryHandler()
+    input_rawfile = os.path.join(tmp_dir.temporary_directory(), "data_in.raw")
+    filename_full = os.path.join(dataset_dir, "gen31_timer.raw")
+
+    stats = analyze([input_rawfile, filename_full])
+    assert len(stats) == 2
+    assert stats[0]["file"] == input_rawfile
+    assert "error" in stats[0]
+    assert stats[1]["file"] == filename_full
+    assert "error" not in stats[1]
+    assert stats[1]["cd_events"] > 0
+
+
+def pytestcase_test_metavision_raw_analytics_on_gen31_recording(dataset_dir):
+    '''
+    Checks the statistics given by metavision_raw_analytics on dataset gen31_timer.raw
+    '''
+
+    filename_full = os.path.join(dataset_dir, "gen31_timer.raw")
+    assert os.path.exists(filename_full)
+
+    rate_window_us = 100000
+    stats = analyze([filename_full], "--rate-window {} --hotspots 5".format(rate_window_us))
+    assert len(stats) == 1
+    file_stats = stats[0]
+
+    # Same number of events as given by metavision_raw_info
+    assert file_stats["width"] == 640
+    assert file_stats["height"] == 480
+    assert file_stats["cd_events"] == get_raw_info_cd_count(filename_full)
+    assert file_stats["trigger_events"] == 0
+
+    # Every window between the first and last events is counted once in the rate histogram
+    n_windows = (file_stats["last_ts"] - file_stats["first_ts"]) // rate_window_us + 1
+    assert sum(bin["windows"] for bin in file_stats["rate_histogram"]) == n_windows
+    for bin in file_stats["rate_histogram"]:
+        assert bin["max_ev_per_s"] == max(1, 2 * bin["min_ev_per_s"])
+
+    # The hotspots are the pixels with the most events, in decreasing order
+    hotspots = file_stats["hotspots"]
+    assert len(hotspots) == 5
+    assert all(0 <= h["x"] < 640 and 0 <= h["y"] < 480 for h in hotspots)
+    assert all(hotspots[i]["events"] >= hotspots[i + 1]["events"] for i in range(len(hotspots) - 1))
+
+
+def pytestcase_test_metavision_raw_analytics_concurrent_files(dataset_dir):
+    '''
+    Checks that metavision_raw_analytics gives the same statistics when analyzing files concurrently
+    '''
+
+    filenames_full = [os.path.join(dataset_dir, f) for f in ["gen31_timer.raw", "gen4_evt2_hand.raw",
+                                                              "gen4_evt3_hand.raw"]]
+
+    sequential_stats = analyze(filenames_full, "-j 1")
+    concurrent_stats = analyze(filenames_full, "-j 3")
+    assert [s["file"] for s in concurrent_stats] == filenames_full
+    assert concurrent_stats == sequential_stats
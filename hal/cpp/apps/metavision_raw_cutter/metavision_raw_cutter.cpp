@@ -9,8 +9,12 @@
  * See the License for the specific language governing permissions and limitations under the License.                 *
  **********************************************************************************************************************/
 
-#include <string>
+#include <algorithm>
 #include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
 #include <boost/program_options.hpp>
 
 #include <metavision/sdk/base/utils/log.h>
@@ -19,19 +23,83 @@
 #include <metavision/hal/device/device.h>
 #include <metavision/hal/device/device_discovery.h>
 #include <metavision/hal/facilities/i_events_stream.h>
+#include <metavision/hal/facilities/i_hw_identification.h>
+#include <metavision/hal/utils/async_raw_file_writer.h>
 #include <metavision/hal/utils/raw_file_config.h>
 
 namespace po = boost::program_options;
 
+namespace {
+
+// Segment of the input file to extract to an output file
+struct Segment {
+    Metavision::timestamp start_ts;
+    Metavision::timestamp end_ts;
+    std::string path;
+    std::unique_ptr<Metavision::AsyncRawFileWriter> writer;
+    bool started = false;
+};
+
+// Returns the path of the output file of the segment @p index, suffixed by the index if there are several segments
+std::string get_segment_path(const std::string &out_raw_file_path, size_t index, size_t n_segments) {
+    if (n_segments == 1) {
+        return out_raw_file_path;
+    }
+    const auto dot = out_raw_file_path.find_last_of('.');
+    const auto sep = out_raw_file_path.find_last_of("/\\");
+    const auto ext = (dot != std::string::npos && (sep == std::string::npos || dot > sep)) ? dot : std::string::npos;
+    return out_raw_file_path.substr(0, ext) + "_" + std::to_string(index) +
+           (ext == std::string::npos ? ".raw" : out_raw_file_path.substr(ext));
+}
+
+// Reads the segments of a CSV file, one per line as "start,end[,output path]" with times in seconds. Empty lines and
+// lines starting with '#' are ignored. Returns false if a line can not be parsed
+bool read_segments_file(const std::string &path, std::vector<double> &starts, std::vector<double> &ends,
+                        std::vector<std::string> &paths) {
+    std::ifstream file(path);
+    if (!file) {
+        MV_LOG_ERROR() << "Unable to open segments file" << path;
+        return false;
+    }
+    std::string line;
+    for (size_t line_number = 1; std::getline(file, line); ++line_number) {
+        if (line.empty() || line[0] == '#' || line.find_first_not_of(" \t\r") == std::string::npos) {
+            continue;
+        }
+        std::istringstream line_stream(line);
+        std::string start, end, output;
+        std::getline(line_stream, start, ',');
+        std::getline(line_stream, end, ',');
+        std::getline(line_stream, output);
+        output.erase(0, output.find_first_not_of(" \t"));
+        output.erase(output.find_last_not_of(" \t\r") + 1);
+        try {
+            starts.push_back(std::stod(start));
+            ends.push_back(std::stod(end));
+        } catch (std::exception &) {
+            MV_LOG_ERROR() << "Invalid segment at line" << line_number << "of" << path << ":" << line;
+            return false;
+        }
+        paths.push_back(output);
+    }
+    return true;
+}
+
+} // namespace
+
 int main(int argc, char *argv[]) {
     std::string in_raw_file_path;
     std::string out_raw_file_path;
-    double start, end;
+    std::string segments_file_path;
+    std::vector<double> starts, ends;
+    bool use_index = false;
 
     const std::string program_desc(
         "Sample code that demonstrates how to use Metavision HAL API to cut a RAW file.\n"
         "Cuts a RAW file between <start> and <end> seconds where <start> and <end> are "
-        "offsets from the beginning of the RAW file and can be expressed as floating point numbers.\n");
+        "offsets from the beginning of the RAW file and can be expressed as floating point numbers.\n"
+        "Several segments can be extracted in a single pass over the input file, by passing several <start> and <end> "
+        "values or a CSV file of segments. The output files are then suffixed by the index of the segments.\n");
 
     po::options_description options_desc("Options");
     // clang-format off
@@ -39,8 +107,14 @@ int main(int argc, char *argv[]) {
         ("help,h", "Produce help message.")
         ("input-raw-file,i",    po::value<std::string>(&in_raw_file_path)->required(), "Path to input RAW file.")
         ("output-raw-file,o",   po::value<std::string>(&out_raw_file_path)->required(), "Path to output RAW file.")
-        ("start,s",   po::value<double>(&start)->required(), "The start of the required sequence in seconds.")
-        ("end,e",     po::value<double>(&end)->required(), "The end of the required sequence in seconds.")
+        ("start,s",   po::value<std::vector<double>>(&starts)->multitoken(), "The start of the required sequence in seconds. Several values can be given, one per segment.")
+        ("end,e",     po::value<std::vector<double>>(&ends)->multitoken(), "The end of the required sequence in seconds. Several values can be given, one per segment.")
+        ("segments-file,l", po::value<std::string>(&segments_file_path), "Path to a CSV file listing segments to extract, one per line as \"start,end[,output path]\" with times in seconds. If no output path is given, the one of the output RAW file suffixed by the index of the segment is used.")
+        ("use-index,x", po::bool_switch(&use_index), "Seek directly close to the start using the index of the input "
+                                                     "file, built and saved next to it if it has none. The cut may "
+                                                     "then start a few events away from where it would otherwise. "
+                                                     "With several segments, the gaps between them are skipped the "
+                                                     "same way.")
         ;
     // clang-format on
 
@@ -60,20 +134,47 @@ int main(int argc, char *argv[]) {
         return 1;
     }
 
-    if (end <= start) {
-        MV_LOG_ERROR() << "end time" << end << "is less than or equal to start" << start;
+    std::vector<std::string> paths(starts.size());
+    if (starts.size() != ends.size()) {
+        MV_LOG_ERROR() << "The number of start times" << starts.size() << "differs from the number of end times"
+                       << ends.size();
+        return 1;
+    }
+    if (!segments_file_path.empty() && !read_segments_file(segments_file_path, starts, ends, paths)) {
+        return 1;
+    }
+    if (starts.empty()) {
+        MV_LOG_ERROR() << program_desc;
+        MV_LOG_ERROR() << options_desc;
+        MV_LOG_ERROR() << "Parsing error: no segment to extract, provide --start and --end or --segments-file";
         return 1;
     }
 
-    // convert start and end to microseconds
-    Metavision::timestamp start_ts = static_cast<Metavision::timestamp>(start * 1000000);
-    Metavision::timestamp end_ts   = static_cast<Metavision::timestamp>(end * 1000000);
+    std::vector<Segment> segments(starts.size());
+    for (size_t i = 0; i < segments.size(); ++i) {
+        if (ends[i] <= starts[i]) {
+            MV_LOG_ERROR() << "end time" << ends[i] << "is less than or equal to start" << starts[i];
+            return 1;
+        }
+        // convert start and end to microseconds
+        segments[i].start_ts = static_cast<Metavision::timestamp>(starts[i] * 1000000);
+        segments[i].end_ts   = static_cast<Metavision::timestamp>(ends[i] * 1000000);
+        segments[i].path = paths[i].empty() ? get_segment_path(out_raw_file_path, i, segments.size()) : paths[i];
+    }
+    // The segments are started in the order of their start times
+    std::vector<Segment *> pending_segments;
+    for (auto &segment : segments) {
+        pending_segments.push_back(&segment);
+    }
+    std::stable_sort(pending_segments.begin(), pending_segments.end(),
+                     [](const Segment *lhs, const Segment *rhs) { return lhs->start_ts < rhs->start_ts; });
 
     // Start processing
     std::unique_ptr<Metavision::Device> device;
     Metavision::RawFileConfig file_config;
-    file_config.n_events_to_read_ = 1024; // Small amount of events per read to have a sufficient time precision and
-                                          // decode efficiency to match the request
+    file_config.n_us_to_read_ = 1000; // Reads of 1ms of data, to have a sufficient time precision to match the request
+                                      // whatever the event rate
+    file_config.build_index_  = use_index;
 
     try {
         device = Metavision::DeviceDiscovery::open_raw_file(in_raw_file_path, file_config);
@@ -85,21 +186,55 @@ int main(int argc, char *argv[]) {
     // Get the decoder and event stream
     Metavision::I_Decoder *i_decoder           = device->get_facility<Metavision::I_Decoder>();
     Metavision::I_EventsStream *i_eventsstream = device->get_facility<Metavision::I_EventsStream>();
+    auto header = device->get_facility<Metavision::I_HW_Identification>()->get_header();
+    header.add_date();
+    std::ostringstream header_stream;
+    header_stream << header;
     i_eventsstream->start();
 
-    bool recording                = false;
+    // The buffers are shared by the output files of the segments being extracted, each of them written by its own
+    // thread
+    std::vector<Segment *> active_segments;
+    size_t n_started_segments     = 0;
+    const Segment *seek_target    = nullptr;
     Metavision::timestamp last_ts = 0;
     while (true) {
-        if (!recording) {
-            if (last_ts >= start_ts) {
-                i_eventsstream->log_raw_data(out_raw_file_path);
-                recording = true;
+        for (; n_started_segments < pending_segments.size() &&
+               last_ts >= pending_segments[n_started_segments]->start_ts;
+             ++n_started_segments) {
+            Segment *segment = pending_segments[n_started_segments];
+            try {
+                segment->writer = std::make_unique<Metavision::AsyncRawFileWriter>(segment->path, header_stream.str());
+            } catch (Metavision::HalException &e) {
+                MV_LOG_ERROR() << "Error exception:" << e.what();
+                return 1;
+            }
+            segment->started = true;
+            active_segments.push_back(segment);
+        }
+        for (auto it = active_segments.begin(); it != active_segments.end();) {
+            if (last_ts >= (*it)->end_ts) {
+                (*it)->writer.reset();
+                MV_LOG_INFO() << "Output saved in file" << (*it)->path;
+                it = active_segments.erase(it);
+            } else {
+                ++it;
             }
-        } else {
-            if (last_ts >= end_ts) {
-                i_eventsstream->stop_log_raw_data();
+        }
+
+        if (active_segments.empty()) {
+            if (n_started_segments == pending_segments.size()) {
                 break;
             }
+            // Skips the data up to the next segment
+            const Segment *next_segment = pending_segments[n_started_segments];
+            if (use_index && seek_target != next_segment && last_ts < next_segment->start_ts) {
+                if (!i_eventsstream->seek(next_segment->start_ts, *i_decoder)) {
+                    MV_LOG_WARNING() << "The input file can not be indexed, decoding it from the beginning";
+                    use_index = false;
+                }
+                seek_target = next_segment;
+            }
         }
 
         if (i_eventsstream->wait_next_buffer() < 0) {
@@ -114,14 +249,27 @@ int main(int argc, char *argv[]) {
         // Decode the raw buffer
         i_decoder->decode(ev_buffer, ev_buffer + n_rawbytes);
 
+        if (!active_segments.empty()) {
+            auto data = std::make_shared<std::vector<uint8_t>>(ev_buffer, ev_buffer + n_rawbytes);
+            const Metavision::DataTransfer::BufferSlice slice(data->data(), data->data() + data->size(), data);
+            for (auto segment : active_segments) {
+                segment->writer->write(slice);
+            }
+        }
+
         // Update last timestamp
         last_ts = i_decoder->get_last_timestamp();
     }
 
-    if (!recording) {
-        MV_LOG_WARNING() << "No file saved because the start time provided is after the end of the input file";
-    } else {
-        MV_LOG_INFO() << "Output saved in file" << out_raw_file_path;
+    for (auto segment : active_segments) {
+        segment->writer.reset();
+        MV_LOG_INFO() << "Output saved in file" << segment->path;
+    }
+    for (auto &segment : segments) {
+        if (!segment.started) {
+            MV_LOG_WARNING() << "No file saved for" << segment.path
+                             << "because the start time provided is after the end of the input file";
+        }
     }
 
     return 0;
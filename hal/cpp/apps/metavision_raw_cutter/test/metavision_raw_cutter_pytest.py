@@ -422,3 +422,50 @@ Type of event       Number of events    First timestamp     Last timestamp
 CD                  12759106            6464                11006525            1.2 Mev/s
 """
     cut_and_check_infos(filename_full, start, end, expected_output_info)
+
+
+def pytestcase_test_metavision_raw_cutter_on_gen4_evt3_recording_several_segments(dataset_dir):
+    '''
+    Checks that metavision_raw_cutter extracts several segments of gen4_evt3_hand.raw in a single pass, with the same
+    output as when extracting them one by one
+    '''
+
+    filename = "gen4_evt3_hand.raw"
+    filename_full = os.path.join(dataset_dir, filename)
+    assert os.path.exists(filename_full)
+
+    segments = [(8, 9), (3, 7), (4, 15)]
+
+    # Create temporary directory, where we'll put the outputs and the segments file
+    tmp_dir = os_tools.TemporaryDirectoryHandler()
+    segments_file_path = os.path.join(tmp_dir.temporary_directory(), "segments.csv")
+    with open(segments_file_path, "w") as segments_file:
+        segments_file.write("# start,end\n")
+        for start, end in segments:
+            segments_file.write("{},{}\n".format(start, end))
+    output_file_path = os.path.join(tmp_dir.temporary_directory(), "raw_cut.raw")
+
+    cmd = "./metavision_raw_cutter -i \"{}\" --segments-file {} -o {}".format(filename_full, segments_file_path,
+                                                                              output_file_path)
+    output, error_code = pytest_tools.run_cmd_setting_mv_log_file(cmd)
+
+    # Check app exited without error
+    assert error_code == 0, "******\nError while executing cmd '{}':{}\n******".format(cmd, output)
+
+    for index, (start, end) in enumerate(segments):
+        # Check output file has been written, and has the same content as when cutting the segment alone
+        segment_file_path = os.path.join(tmp_dir.temporary_directory(), "raw_cut_{}.raw".format(index))
+        assert os.path.exists(segment_file_path)
+        single_file_path = os.path.join(tmp_dir.temporary_directory(), "raw_cut_single_{}.raw".format(index))
+        cmd = "./metavision_raw_cutter -i \"{}\" --start {} --end {} -o {}".format(filename_full, start, end,
+                                                                                   single_file_path)
+        output, error_code = pytest_tools.run_cmd_setting_mv_log_file(cmd)
+        assert error_code == 0, "******\nError while executing cmd '{}':{}\n******".format(cmd, output)
+
+        infos = []
+        for path in (segment_file_path, single_file_path):
+            cmd = "./metavision_raw_info -i {}".format(path)
+            info, error_code = pytest_tools.run_cmd_setting_mv_log_file(cmd)
+            assert error_code == 0
+            infos.append(info.replace(path, "").replace(os.path.basename(path), ""))
+        assert infos[0] == infos[1]
@@ -0,0 +1,153 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <boost/program_options.hpp>
+
+#include <metavision/sdk/base/utils/log.h>
+#include <metavision/hal/utils/hal_exception.h>
+#include <metavision/hal/utils/network_raw_stream.h>
+#include <metavision/hal/facilities/i_device_control.h>
+#include <metavision/hal/facilities/i_events_stream.h>
+#include <metavision/hal/facilities/i_hw_identification.h>
+#include <metavision/hal/device/device.h>
+#include <metavision/hal/device/device_discovery.h>
+
+namespace po = boost::program_options;
+
+namespace {
+std::atomic<bool> stop_requested{false};
+
+void request_stop(int) {
+    stop_requested = true;
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+    std::string serial;
+    std::string in_raw_file_path;
+    uint16_t port;
+    size_t n_clients_to_wait;
+    size_t max_queued_mb;
+
+    const std::string program_desc(
+        "Application streaming the RAW data of a camera or of a RAW file over TCP with Metavision HAL.\n"
+        "Any number of clients can connect, and read the stream as a device opened with the serial "
+        "tcp://<host>:<port>. Each client gets the data sent after it connected. A client too slow to receive the data "
+        "is disconnected.\n");
+
+    po::options_description options_desc("Options");
+    // clang-format off
+    options_desc.add_options()
+        ("help,h", "Produce help message.")
+        ("serial,s",          po::value<std::string>(&serial),"Serial ID of the camera to stream.")
+        ("input-raw-file,i",  po::value<std::string>(&in_raw_file_path), "Path to the RAW file to stream. If neither "
+                                                                         "a serial nor a file is given, the first "
+                                                                         "available camera is streamed.")
+        ("port,p",            po::value<uint16_t>(&port)->default_value(8554), "Port to listen on.")
+        ("lz4",               "Compress the data with LZ4 before sending it.")
+        ("wait-clients,w",    po::value<size_t>(&n_clients_to_wait)->default_value(0),
+                              "Number of clients to wait for before starting to stream.")
+        ("max-queued-mb",     po::value<size_t>(&max_queued_mb)->default_value(64),
+                              "Size of the data waiting to be sent to a client beyond which it is disconnected, in MB.")
+        ;
+    // clang-format on
+
+    po::variables_map vm;
+    try {
+        po::store(po::command_line_parser(argc, argv).options(options_desc).run(), vm);
+        po::notify(vm);
+    } catch (po::error &e) {
+        MV_LOG_ERROR() << program_desc;
+        MV_LOG_ERROR() << options_desc;
+        MV_LOG_ERROR() << "Parsing error:" << e.what();
+        return 1;
+    }
+
+    if (vm.count("help")) {
+        MV_LOG_INFO() << program_desc;
+        MV_LOG_INFO() << options_desc;
+        return 0;
+    }
+
+    std::unique_ptr<Metavision::Device> device;
+    try {
+        if (in_raw_file_path.empty()) {
+            device = Metavision::DeviceDiscovery::open(serial);
+        } else {
+            device = Metavision::DeviceDiscovery::open_raw_file(in_raw_file_path);
+        }
+    } catch (Metavision::HalException &e) { MV_LOG_ERROR() << "Error:" << e.what(); }
+    if (!device) {
+        MV_LOG_ERROR() << "Unable to open the" << (in_raw_file_path.empty() ? "camera" : "RAW file");
+        return 1;
+    }
+
+    auto *i_hw_identification = device->get_facility<Metavision::I_HW_Identification>();
+    auto *i_events_stream     = device->get_facility<Metavision::I_EventsStream>();
+    auto *i_device_control    = device->get_facility<Metavision::I_DeviceControl>();
+    if (!i_hw_identification || !i_events_stream) {
+        MV_LOG_ERROR() << "The device does not provide RAW data";
+        return 1;
+    }
+
+    auto header = i_hw_identification->get_header();
+    header.add_date();
+    std::ostringstream header_stream;
+    header_stream << header;
+
+    Metavision::NetworkRawStreamServerConfig config;
+    config.compression_      = vm.count("lz4") ? Metavision::RawCompression::LZ4 : Metavision::RawCompression::None;
+    config.max_queued_bytes_ = max_queued_mb * 1024 * 1024;
+    std::unique_ptr<Metavision::NetworkRawStreamServer> server;
+    try {
+        server.reset(new Metavision::NetworkRawStreamServer(port, header_stream.str(), config));
+    } catch (Metavision::HalException &e) {
+        MV_LOG_ERROR() << "Error:" << e.what();
+        return 1;
+    }
+
+    std::signal(SIGINT, request_stop);
+    std::signal(SIGTERM, request_stop);
+
+    MV_LOG_INFO() << "Listening on port" << server->get_port();
+    while (!stop_requested && server->get_n_clients() < n_clients_to_wait) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+
+    i_events_stream->start();
+    if (i_device_control) {
+        i_device_control->start();
+    }
+
+    // The buffers are sent as they are, the server compressing and queuing them for each client
+    while (!stop_requested && i_events_stream->wait_next_buffer() >= 0) {
+        long n_rawbytes = 0;
+        auto *raw_data  = i_events_stream->get_latest_raw_data(n_rawbytes);
+        server->send(raw_data, n_rawbytes);
+    }
+
+    if (i_device_control) {
+        i_device_control->stop();
+    }
+    i_events_stream->stop();
+
+    // The data still queued is sent before the connections are closed
+    server.reset();
+    return 0;
+}
@@ -0,0 +1,221 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <boost/program_options.hpp>
+
+#include <metavision/sdk/base/utils/log.h>
+#include <metavision/hal/decoders/evt2_decoder.h>
+#include <metavision/hal/decoders/evt3_decoder.h>
+#include <metavision/hal/utils/async_raw_file_writer.h>
+#include <metavision/hal/utils/compressed_raw_file_stream.h>
+#include <metavision/hal/utils/hal_exception.h>
+#include <metavision/hal/utils/parallel_decoder.h>
+#include <metavision/hal/utils/raw_event_encoder.h>
+#include <metavision/hal/utils/raw_file_header.h>
+
+namespace po = boost::program_options;
+
+namespace {
+
+// Size of the blocks of data read from the input file, decoded in parallel then encoded at once
+constexpr size_t ReadBlockSize = 32 * 1024 * 1024;
+
+// Returns the factory of the decoders of the format of the RAW file, or an empty function if it is not one of the
+// formats that can be transcoded
+Metavision::ParallelDecoder::DecoderFactory get_decoder_factory(const Metavision::RawFileHeader &header) {
+    const std::string evt    = header.get_field("evt");
+    const std::string format = header.get_field("format");
+    if (evt == "2.0" || format.compare(0, 4, "EVT2") == 0) {
+        return [](bool time_shifting_enabled, const auto &cd_decoder, const auto &ext_trigger_decoder) {
+            return std::make_unique<Metavision::EVT2Decoder>(time_shifting_enabled, cd_decoder, ext_trigger_decoder);
+        };
+    }
+    if (evt == "3.0" || format.compare(0, 4, "EVT3") == 0) {
+        return [](bool time_shifting_enabled, const auto &cd_decoder, const auto &ext_trigger_decoder) {
+            return std::make_unique<Metavision::EVT3Decoder>(time_shifting_enabled, cd_decoder, ext_trigger_decoder);
+        };
+    }
+    return Metavision::ParallelDecoder::DecoderFactory();
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    std::string in_raw_file_path;
+    std::string out_raw_file_path;
+    std::string out_format;
+    std::string compression_name;
+    size_t compression_chunk_size;
+    uint32_t n_threads;
+
+    const std::string program_desc(
+        "Application converting a RAW file to another encoding of the events (e.g. EVT2 to EVT3) and/or to the "
+        "compressed RAW file container.\n"
+        "The input file is decoded by several threads and the events are encoded again in the output format.\n");
+
+    po::options_description options_desc("Options");
+    // clang-format off
+    options_desc.add_options()
+        ("help,h", "Produce help message.")
+        ("input-raw-file,i",  po::value<std::string>(&in_raw_file_path)->required(), "Path to input RAW file, compressed or not.")
+        ("output-raw-file,o", po::value<std::string>(&out_raw_file_path)->required(), "Path to output RAW file.")
+        ("format,f",          po::value<std::string>(&out_format)->default_value("EVT3"), "Encoding of the events in the output file, among EVT2 and EVT3.")
+        ("compression,c",     po::value<std::string>(&compression_name)->default_value("none"), "Compression of the output file, among none and lz4.")
+        ("compression-chunk-size", po::value<size_t>(&compression_chunk_size)->default_value(1024 * 1024), "Size in bytes of the uncompressed data of the chunks of a compressed output file.")
+        ("threads,j",         po::value<uint32_t>(&n_threads)->default_value(0), "Number of threads decoding (and decompressing) the input file, 0 to use one per core.")
+        ;
+    // clang-format on
+
+    po::variables_map vm;
+    po::store(po::command_line_parser(argc, argv).options(options_desc).run(), vm);
+    if (vm.count("help")) {
+        MV_LOG_INFO() << program_desc;
+        MV_LOG_INFO() << options_desc;
+        return 0;
+    }
+    try {
+        po::notify(vm);
+    } catch (po::error &e) {
+        MV_LOG_ERROR() << program_desc;
+        MV_LOG_ERROR() << options_desc;
+        MV_LOG_ERROR() << "Parsing error:" << e.what();
+        return 1;
+    }
+
+    Metavision::AsyncRawFileWriterConfig writer_config;
+    if (compression_name == "lz4") {
+        writer_config.compression_ = Metavision::RawCompression::LZ4;
+    } else if (compression_name != "none") {
+        MV_LOG_ERROR() << "Unknown compression" << compression_name;
+        return 1;
+    }
+    writer_config.compression_chunk_size_ = compression_chunk_size;
+
+    std::unique_ptr<Metavision::RawEventEncoder> encoder;
+    std::unique_ptr<std::istream> input;
+    try {
+        encoder = Metavision::RawEventEncoder::create(out_format);
+        if (Metavision::CompressedRawFileStream::is_compressed(in_raw_file_path)) {
+            input = std::make_unique<Metavision::CompressedRawFileStream>(in_raw_file_path, n_threads);
+        } else {
+            input = std::make_unique<std::ifstream>(in_raw_file_path, std::ios::binary);
+        }
+    } catch (Metavision::HalException &e) {
+        MV_LOG_ERROR() << "Error exception:" << e.what();
+        return 1;
+    }
+    if (!*input) {
+        MV_LOG_ERROR() << "Unable to open input file" << in_raw_file_path;
+        return 1;
+    }
+
+    // The header of the output file is the one of the input file, with the new format and compression
+    Metavision::RawFileHeader header(*input);
+    auto decoder_factory = get_decoder_factory(header);
+    if (!decoder_factory) {
+        MV_LOG_ERROR() << "Unsupported format of input file" << in_raw_file_path
+                       << ", only EVT2 and EVT3 files can be transcoded";
+        return 1;
+    }
+    encoder->set_header_format(header);
+    Metavision::set_raw_file_compression(header, writer_config.compression_, writer_config.compression_chunk_size_);
+    std::ostringstream header_stream;
+    header_stream << header;
+
+    std::unique_ptr<Metavision::AsyncRawFileWriter> writer;
+    try {
+        writer = std::make_unique<Metavision::AsyncRawFileWriter>(out_raw_file_path, header_stream.str(),
+                                                                  writer_config);
+    } catch (Metavision::HalException &e) {
+        MV_LOG_ERROR() << "Error exception:" << e.what();
+        return 1;
+    }
+
+    std::vector<Metavision::EventCD> cds;
+    std::vector<Metavision::EventExtTrigger> triggers;
+    auto cd_decoder = std::make_shared<Metavision::I_EventDecoder<Metavision::EventCD>>();
+    cd_decoder->add_event_buffer_callback([&cds](const Metavision::EventCD *begin, const Metavision::EventCD *end) {
+        cds.insert(cds.end(), begin, end);
+    });
+    auto trigger_decoder = std::make_shared<Metavision::I_EventDecoder<Metavision::EventExtTrigger>>();
+    trigger_decoder->add_event_buffer_callback(
+        [&triggers](const Metavision::EventExtTrigger *begin, const Metavision::EventExtTrigger *end) {
+            triggers.insert(triggers.end(), begin, end);
+        });
+    Metavision::ParallelDecoder decoder(decoder_factory, false, cd_decoder, trigger_decoder, n_threads);
+    const auto probe_decoder = decoder_factory(false, nullptr, nullptr);
+    const size_t raw_event_size = probe_decoder->get_raw_event_size_bytes();
+    MV_LOG_INFO() << "Transcoding to" << encoder->get_format() << "with" << decoder.get_n_threads()
+                  << "decoding threads...";
+
+    const auto start_time = std::chrono::high_resolution_clock::now();
+    std::vector<uint8_t> data;
+    size_t n_pending = 0; // Bytes of the previous block that follow its last resync point
+    uint64_t n_read_bytes = 0, n_written_bytes = 0, n_events = 0;
+    while (true) {
+        data.resize(n_pending + ReadBlockSize);
+        input->read(reinterpret_cast<char *>(data.data() + n_pending), ReadBlockSize);
+        const size_t n_read = static_cast<size_t>(input->gcount());
+        const bool eof      = n_read < ReadBlockSize;
+        const size_t size   = n_pending + n_read;
+        n_read_bytes += n_read;
+
+        // The parallel decoder drops the data preceding the first resync point of each call: the block is decoded up to
+        // its last resync point, and the rest is decoded with the next one
+        uint8_t *begin = data.data(), *end = data.data() + size, *cut = end;
+        if (!eof) {
+            cut = const_cast<uint8_t *>(
+                probe_decoder->find_resync_point(begin + (size * 3 / 4) / raw_event_size * raw_event_size, end));
+            if (cut == end) {
+                cut = const_cast<uint8_t *>(probe_decoder->find_resync_point(begin + raw_event_size, end));
+            }
+            if (cut == end) {
+                // No resync point in the block, its data is decoded with the next one
+                cut = begin;
+            }
+        }
+
+        decoder.decode(begin, cut);
+        auto output = std::make_shared<std::vector<uint8_t>>();
+        encoder->encode(cds.data(), cds.data() + cds.size(), triggers.data(), triggers.data() + triggers.size(),
+                        *output);
+        n_events += cds.size() + triggers.size();
+        cds.clear();
+        triggers.clear();
+        if (!output->empty()) {
+            n_written_bytes += output->size();
+            writer->write(
+                Metavision::DataTransfer::BufferSlice(output->data(), output->data() + output->size(), output));
+        }
+
+        n_pending = end - cut;
+        std::copy(cut, end, data.begin());
+        if (eof) {
+            break;
+        }
+    }
+    writer.reset();
+
+    const double duration_s =
+        std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start_time).count();
+    MV_LOG_INFO() << "Transcoded" << n_events << "events from" << n_read_bytes / 1e6 << "MB to" << n_written_bytes / 1e6
+                  << "MB of" << encoder->get_format() << "events in" << duration_s << "s ("
+                  << n_read_bytes / 1e6 / duration_s << "MB/s)";
+    MV_LOG_INFO() << "Output saved in file" << out_raw_file_path;
+
+    return 0;
+}
@@ -0,0 +1,115 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+#include <boost/program_options.hpp>
+
+#include <metavision/sdk/base/utils/log.h>
+#include <metavision/hal/utils/hal_exception.h>
+#include <metavision/hal/utils/raw_file_checksums.h>
+
+namespace po = boost::program_options;
+
+int main(int argc, char *argv[]) {
+    std::vector<std::string> in_raw_file_paths;
+    unsigned int n_threads;
+    uint64_t chunk_size;
+    bool compute = false;
+
+    const std::string program_desc(
+        "Application checking RAW files against the CRC32C checksums of their chunks, stored in the sidecar files "
+        "written along with the recordings (<file>.crc).\n"
+        "The chunks of each file are read and checked in parallel, without decoding, so that corruptions are found at "
+        "the speed of the disk. The corrupted chunks are listed with their offsets, and the application returns 1 if "
+        "any file is corrupted or can not be checked.\n");
+
+    po::options_description options_desc("Options");
+    // clang-format off
+    options_desc.add_options()
+        ("help,h", "Produce help message.")
+        ("input-raw-files,i", po::value<std::vector<std::string>>(&in_raw_file_paths)->multitoken()->required(),
+                              "Paths to the input RAW files.")
+        ("threads,j",         po::value<unsigned int>(&n_threads)->default_value(std::thread::hardware_concurrency()),
+                              "Number of chunks read and checked concurrently.")
+        ("compute,c",         po::bool_switch(&compute),
+                              "Compute the checksums of the files instead of checking them, and write their sidecar "
+                              "files.")
+        ("chunk-size",        po::value<uint64_t>(&chunk_size)->default_value(4 * 1024 * 1024),
+                              "Size of the chunks, in bytes, when computing the checksums.")
+        ;
+    // clang-format on
+
+    po::positional_options_description positional_desc;
+    positional_desc.add("input-raw-files", -1);
+
+    po::variables_map vm;
+    po::store(po::command_line_parser(argc, argv).options(options_desc).positional(positional_desc).run(), vm);
+    if (vm.count("help")) {
+        MV_LOG_INFO() << program_desc;
+        MV_LOG_INFO() << options_desc;
+        return 0;
+    }
+    try {
+        po::notify(vm);
+    } catch (po::error &e) {
+        MV_LOG_ERROR() << program_desc;
+        MV_LOG_ERROR() << options_desc;
+        MV_LOG_ERROR() << "Parsing error:" << e.what();
+        return 1;
+    }
+
+    bool all_valid = true;
+    for (const auto &raw_file : in_raw_file_paths) {
+        const std::string sidecar_path = Metavision::RawFileChecksums::get_sidecar_path(raw_file);
+        try {
+            if (compute) {
+                if (!Metavision::RawFileChecksums::compute(raw_file, chunk_size).save(sidecar_path)) {
+                    MV_LOG_ERROR() << Metavision::Log::no_space << raw_file << ": unable to write the checksums in "
+                                   << sidecar_path;
+                    all_valid = false;
+                }
+                continue;
+            }
+
+            Metavision::RawFileChecksums checksums;
+            if (!checksums.load(sidecar_path)) {
+                MV_LOG_ERROR() << Metavision::Log::no_space << raw_file << ": no valid checksums in " << sidecar_path;
+                all_valid = false;
+                continue;
+            }
+
+            using Seconds                = std::chrono::duration<double>;
+            const auto start             = std::chrono::steady_clock::now();
+            const auto corrupted_chunks  = checksums.verify(raw_file, n_threads);
+            const double duration_s      = Seconds(std::chrono::steady_clock::now() - start).count();
+            const double throughput_mb_s = duration_s > 0 ? checksums.get_raw_file_size() / duration_s / 1e6 : 0;
+            if (corrupted_chunks.empty()) {
+                MV_LOG_INFO() << Metavision::Log::no_space << raw_file << ": OK (" << throughput_mb_s << " MB/s)";
+                continue;
+            }
+            all_valid = false;
+            MV_LOG_ERROR() << Metavision::Log::no_space << raw_file << ": " << corrupted_chunks.size()
+                           << " corrupted chunk(s) of " << checksums.get_chunk_size() << " bytes";
+            for (const auto chunk : corrupted_chunks) {
+                MV_LOG_ERROR() << "  chunk" << chunk << "at offset" << chunk * checksums.get_chunk_size();
+            }
+        } catch (const Metavision::HalException &e) {
+            MV_LOG_ERROR() << Metavision::Log::no_space << raw_file << ": " << e.what();
+            all_valid = false;
+        }
+    }
+
+    return all_valid ? 0 : 1;
+}
@@ -0,0 +1,302 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+// Application measuring the latency of the acquisition chain, by looping the trigger out of a camera to its trigger in
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <iomanip>
+#include <mutex>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <boost/program_options.hpp>
+
+#include <metavision/sdk/base/events/event_ext_trigger.h>
+#include <metavision/sdk/base/utils/log.h>
+#include <metavision/hal/device/device.h>
+#include <metavision/hal/device/device_discovery.h>
+#include <metavision/hal/facilities/i_decoder.h>
+#include <metavision/hal/facilities/i_device_control.h>
+#include <metavision/hal/facilities/i_event_decoder.h>
+#include <metavision/hal/facilities/i_events_stream.h>
+#include <metavision/hal/facilities/i_trigger_in.h>
+#include <metavision/hal/facilities/i_trigger_out.h>
+#include <metavision/hal/utils/hal_exception.h>
+
+namespace po = boost::program_options;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Latencies of one round trip, in us
+struct RoundTrip {
+    double command_to_arrival;  // Sensor, transfer to the host
+    double arrival_to_callback; // Queue of buffers, decoding and forwarding of the events
+    double total;
+};
+
+std::string format_us(double value) {
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(1) << value << " us";
+    return oss.str();
+}
+
+double get_percentile(std::vector<double> values, double percentile) {
+    const size_t index = std::min(values.size() - 1, static_cast<size_t>(percentile * values.size()));
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+void print_distribution(const std::string &name, const std::vector<double> &values) {
+    const double mean = std::accumulate(values.begin(), values.end(), 0.) / values.size();
+    MV_LOG_INFO() << Metavision::Log::no_space << name << ": min " << format_us(get_percentile(values, 0.))
+                  << ", p50 " << format_us(get_percentile(values, 0.5)) << ", p90 "
+                  << format_us(get_percentile(values, 0.9)) << ", p99 " << format_us(get_percentile(values, 0.99))
+                  << ", max " << format_us(get_percentile(values, 1.)) << ", mean " << format_us(mean);
+}
+
+void print_histogram(const std::vector<double> &values, double bin_width_us, size_t n_bins) {
+    const auto minmax = std::minmax_element(values.begin(), values.end());
+    const double min  = *minmax.first;
+    if (bin_width_us <= 0.) {
+        bin_width_us = std::max(1., std::ceil((*minmax.second - min) / n_bins));
+    }
+    const double origin = std::floor(min / bin_width_us) * bin_width_us;
+
+    std::vector<size_t> counts(static_cast<size_t>((*minmax.second - origin) / bin_width_us) + 1, 0);
+    for (const double value : values) {
+        ++counts[static_cast<size_t>((value - origin) / bin_width_us)];
+    }
+
+    static constexpr size_t bar_width = 50;
+    const size_t max_count            = *std::max_element(counts.begin(), counts.end());
+    for (size_t i = 0; i < counts.size(); ++i) {
+        std::ostringstream oss;
+        oss << "[" << std::setw(9) << std::fixed << std::setprecision(0) << origin + i * bin_width_us << ", "
+            << std::setw(9) << origin + (i + 1) * bin_width_us << ") us | " << std::left
+            << std::setw(bar_width) << std::string(counts[i] * bar_width / max_count, '#') << " " << counts[i];
+        MV_LOG_INFO() << oss.str();
+    }
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    std::string serial;
+    int channel;
+    unsigned int n_samples;
+    uint32_t period_us;
+    unsigned int gap_ms;
+    unsigned int timeout_ms;
+    double bin_width_us;
+
+    const std::string program_desc(
+        "Application measuring the latency of the acquisition chain of a camera, from the command of its trigger out "
+        "to the callback of the application receiving the trigger event, through the sensor, the data transfer, the "
+        "events stream and the decoder.\n"
+        "The trigger out is looped to a trigger in of the camera, either internally (the loopback channel of the "
+        "camera, used by default) or by wiring the trigger out to a trigger in. For each sample, the trigger out is "
+        "enabled, which raises its signal right away, and disabled as soon as the rising edge is received by the "
+        "application. The distribution of the round trip latency is then reported with a histogram, to tune the "
+        "transfer sizes, the batches of events and the threading policies of a platform.\n");
+
+    po::options_description options_desc("Options");
+    // clang-format off
+    options_desc.add_options()
+        ("help,h", "Produce help message.")
+        ("serial,s",           po::value<std::string>(&serial),
+                               "Serial ID of the camera. If not provided, the first available camera is used.")
+        ("trigger-in-channel", po::value<int>(&channel)->default_value(-1),
+                               "Channel of the trigger in receiving the trigger out. If negative, the loopback "
+                               "channel of the camera is used.")
+        ("samples,n",          po::value<unsigned int>(&n_samples)->default_value(500),
+                               "Number of round trips to measure.")
+        ("period",             po::value<uint32_t>(&period_us)->default_value(100000),
+                               "Period of the trigger out signal, in us. It must be larger than twice the latency "
+                               "measured, so that a single rising edge is generated for each sample.")
+        ("gap",                po::value<unsigned int>(&gap_ms)->default_value(10),
+                               "Delay between two samples, in ms.")
+        ("timeout",            po::value<unsigned int>(&timeout_ms)->default_value(1000),
+                               "Maximum time to wait for the trigger event of a sample, in ms.")
+        ("bin-width",          po::value<double>(&bin_width_us)->default_value(0.),
+                               "Width of the bins of the histogram, in us. If 0, the range of the latencies is "
+                               "divided in 20 bins.")
+        ;
+    // clang-format on
+
+    po::variables_map vm;
+    try {
+        po::store(po::command_line_parser(argc, argv).options(options_desc).run(), vm);
+        po::notify(vm);
+    } catch (po::error &e) {
+        MV_LOG_ERROR() << program_desc;
+        MV_LOG_ERROR() << options_desc;
+        MV_LOG_ERROR() << "Parsing error:" << e.what();
+        return 1;
+    }
+
+    if (vm.count("help")) {
+        MV_LOG_INFO() << program_desc;
+        MV_LOG_INFO() << options_desc;
+        return 0;
+    }
+
+    if (n_samples == 0) {
+        MV_LOG_ERROR() << "At least one sample must be measured";
+        return 1;
+    }
+
+    std::unique_ptr<Metavision::Device> device;
+    try {
+        device = Metavision::DeviceDiscovery::open(serial);
+    } catch (Metavision::HalException &e) { MV_LOG_ERROR() << e.what(); }
+    if (!device) {
+        MV_LOG_ERROR() << "Camera opening failed.";
+        return 1;
+    }
+
+    auto *i_events_stream   = device->get_facility<Metavision::I_EventsStream>();
+    auto *i_decoder         = device->get_facility<Metavision::I_Decoder>();
+    auto *i_trigger_decoder = device->get_facility<Metavision::I_EventDecoder<Metavision::EventExtTrigger>>();
+    auto *i_device_control  = device->get_facility<Metavision::I_DeviceControl>();
+    auto *i_trigger_out     = device->get_facility<Metavision::I_TriggerOut>();
+    auto *i_trigger_in      = device->get_facility<Metavision::I_TriggerIn>();
+    if (!i_events_stream || !i_decoder || !i_trigger_decoder || !i_device_control) {
+        MV_LOG_ERROR() << "The camera can not stream trigger events.";
+        return 1;
+    }
+    if (!i_trigger_out || !i_trigger_in) {
+        MV_LOG_ERROR() << "The camera has no trigger out or no trigger in.";
+        return 1;
+    }
+
+    // The loopback channel depends on the generation of the sensor, as in metavision_hal_viewer
+    if (channel < 0) {
+        channel = i_trigger_in->enable(6) ? 6 : 3;
+    }
+    if (!i_trigger_in->is_enabled(channel) && !i_trigger_in->enable(channel)) {
+        MV_LOG_ERROR() << "Failed to enable the trigger in channel" << channel;
+        return 1;
+    }
+    i_trigger_out->disable();
+    i_trigger_out->set_period(period_us);
+    i_trigger_out->set_duty_cycle(0.5);
+
+    // State of the sample being measured, shared between the main thread and the decoding thread
+    std::mutex mutex;
+    std::condition_variable received_cond;
+    bool pending = false, received = false;
+    Clock::time_point buffer_arrival, callback_time;
+    // Only accessed by the decoding thread, which calls the callbacks of the decoder
+    Clock::time_point current_buffer_arrival;
+
+    i_trigger_decoder->add_event_buffer_callback(
+        [&](const Metavision::EventExtTrigger *begin, const Metavision::EventExtTrigger *end) {
+            const auto now = Clock::now();
+            for (auto ev = begin; ev != end; ++ev) {
+                if (ev->id != channel || ev->p != 1) {
+                    continue;
+                }
+                std::lock_guard<std::mutex> lock(mutex);
+                if (pending && !received) {
+                    received       = true;
+                    buffer_arrival = current_buffer_arrival;
+                    callback_time  = now;
+                    received_cond.notify_one();
+                }
+            }
+        });
+
+    i_events_stream->start();
+    i_device_control->start();
+
+    std::atomic<bool> stop_decoding{false};
+    std::thread decoding_thread([&]() {
+        while (!stop_decoding) {
+            if (i_events_stream->wait_next_buffer() < 0) {
+                break;
+            }
+            long n_bytes;
+            auto *raw_data         = i_events_stream->get_latest_raw_data(n_bytes);
+            current_buffer_arrival = i_events_stream->get_latest_raw_data_arrival_time();
+            i_decoder->decode(raw_data, raw_data + n_bytes);
+        }
+    });
+
+    std::vector<RoundTrip> round_trips;
+    unsigned int n_timeouts = 0;
+    for (unsigned int i = 0; i < n_samples; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(gap_ms));
+
+        std::unique_lock<std::mutex> lock(mutex);
+        pending  = true;
+        received = false;
+        lock.unlock();
+        const auto command_time = Clock::now();
+        i_trigger_out->enable();
+        lock.lock();
+        const bool got_edge =
+            received_cond.wait_for(lock, std::chrono::milliseconds(timeout_ms), [&received]() { return received; });
+        pending = false;
+        lock.unlock();
+        i_trigger_out->disable();
+
+        if (!got_edge) {
+            ++n_timeouts;
+            continue;
+        }
+        using us = std::chrono::duration<double, std::micro>;
+        RoundTrip round_trip;
+        round_trip.command_to_arrival  = us(buffer_arrival - command_time).count();
+        round_trip.arrival_to_callback = us(callback_time - buffer_arrival).count();
+        round_trip.total               = us(callback_time - command_time).count();
+        round_trips.push_back(round_trip);
+    }
+
+    stop_decoding = true;
+    i_device_control->stop();
+    i_events_stream->stop();
+    decoding_thread.join();
+
+    MV_LOG_INFO() << Metavision::Log::no_space << "Samples: " << round_trips.size() << ", timeouts: " << n_timeouts
+                  << ", trigger in channel: " << channel;
+    if (round_trips.empty()) {
+        MV_LOG_ERROR() << "No trigger event received, check that the trigger out is looped to the trigger in channel"
+                       << channel;
+        return 1;
+    }
+
+    std::vector<double> command_to_arrival, arrival_to_callback, total;
+    for (const auto &round_trip : round_trips) {
+        command_to_arrival.push_back(round_trip.command_to_arrival);
+        arrival_to_callback.push_back(round_trip.arrival_to_callback);
+        total.push_back(round_trip.total);
+    }
+    print_distribution("Command to buffer arrival", command_to_arrival);
+    print_distribution("Buffer arrival to callback", arrival_to_callback);
+    print_distribution("Round trip", total);
+    MV_LOG_INFO();
+    print_histogram(total, bin_width_us, 20);
+
+    if (n_timeouts > 0) {
+        MV_LOG_WARNING() << n_timeouts << "samples timed out, the period of the trigger out may be too short";
+    }
+
+    return 0;
+}
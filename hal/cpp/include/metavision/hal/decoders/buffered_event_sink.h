@@ -0,0 +1,100 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_BUFFERED_EVENT_SINK_H
+#define METAVISION_HAL_BUFFERED_EVENT_SINK_H
+
+#include <array>
+#include <cstddef>
+#include <utility>
+
+namespace Metavision {
+
+/// @brief Sink of decoded events calling a handler with batches of events, see @ref EVT2Decoder::decode_into
+///
+/// The events are copied in a buffer of fixed size, the handler being called as `handler(begin, end)` when an event
+/// does not fit in it anymore and when flushed. The type of the handler being known at compile time, it can be
+/// inlined as well. The decoder reserves space for whole blocks of events at once (see @ref reserve), which are then
+/// written without checking the space left for each event.
+/// @tparam Event Type of the events buffered
+/// @tparam Handler Type of the handler of the batches of events
+/// @tparam BufferSize Number of events of a batch
+template<typename Event, typename Handler, size_t BufferSize = 320>
+class BufferedEventSink {
+public:
+    /// @brief Constructor
+    /// @param handler Handler called with the batches of events
+    explicit BufferedEventSink(Handler handler) : handler_(std::move(handler)) {}
+
+    /// @brief Adds an event to the buffer, calling the handler first if it is full
+    void operator()(const Event &ev) {
+        if (size_ == BufferSize) {
+            flush();
+        }
+        buffer_[size_++] = ev;
+    }
+
+    /// @brief Flushes the buffer if it can not hold @p n more events
+    /// @param n Number of events added next with @ref push_unsafe or @ref push_unsafe_if, at most BufferSize
+    void reserve(size_t n) {
+        if (size_ + n > BufferSize) {
+            flush();
+        }
+    }
+
+    /// @brief Adds an event to the buffer, which must have room for it (see @ref reserve)
+    void push_unsafe(const Event &ev) {
+        buffer_[size_++] = ev;
+    }
+
+    /// @brief Adds an event to the buffer if a condition is met, without branching
+    ///
+    /// The event is written in any case, and overwritten by the next one if the condition is false. The buffer must
+    /// have room for it (see @ref reserve).
+    void push_unsafe_if(bool condition, const Event &ev) {
+        buffer_[size_] = ev;
+        size_ += condition;
+    }
+
+    /// @brief Calls the handler with the events buffered, if any
+    ///
+    /// Must be called once the data has been decoded, e.g. after each call to @ref EVT2Decoder::decode_into when the
+    /// events must not be delayed.
+    void flush() {
+        if (size_ != 0) {
+            handler_(buffer_.data(), buffer_.data() + size_);
+            size_ = 0;
+        }
+    }
+
+    /// @brief Gets the handler of the batches of events
+    Handler &get_handler() {
+        return handler_;
+    }
+
+private:
+    Handler handler_;
+    std::array<Event, BufferSize> buffer_;
+    size_t size_ = 0;
+};
+
+/// @brief Makes a @ref BufferedEventSink, deducing the type of the handler
+/// @tparam Event Type of the events buffered
+/// @tparam BufferSize Number of events of a batch
+/// @param handler Handler called with the batches of events
+template<typename Event, size_t BufferSize = 320, typename Handler>
+BufferedEventSink<Event, Handler, BufferSize> make_buffered_event_sink(Handler handler) {
+    return BufferedEventSink<Event, Handler, BufferSize>(std::move(handler));
+}
+
+} // namespace Metavision
+
+#endif // METAVISION_HAL_BUFFERED_EVENT_SINK_H
@@ -0,0 +1,206 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_EVT2_DECODER_IMPL_H
+#define METAVISION_HAL_EVT2_DECODER_IMPL_H
+
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+namespace Metavision {
+namespace Evt2 {
+namespace detail {
+
+constexpr size_t WordSize  = sizeof(RawWord);
+constexpr size_t BlockSize = 8; // Number of words checked and decoded at once in the CD fast path
+
+// Input buffers are not guaranteed to be aligned on the size of a word
+inline RawWord load_word(const uint8_t *data) {
+    RawWord word;
+    std::memcpy(&word, data, WordSize);
+    return word;
+}
+
+// Checks whether a sink can be called with an event of a given type
+template<typename Sink, typename Event, typename = void>
+struct accepts_event : std::false_type {};
+
+template<typename Sink, typename Event>
+struct accepts_event<Sink, Event, decltype(std::declval<Sink &>()(std::declval<const Event &>()), void())>
+    : std::true_type {};
+
+// Checks whether a sink reserves space for blocks of events, as BufferedEventSink does
+template<typename Sink, typename = void>
+struct reserves_events : std::false_type {};
+
+template<typename Sink>
+struct reserves_events<Sink, decltype(std::declval<Sink &>().reserve(size_t()), void())> : std::true_type {};
+
+// Gives the events of a type to a sink, with the interface of I_Decoder::DecodedEventForwarder used by the decoding
+// loop. The events of the blocks reserved are written without check into the sinks that reserve space, the others are
+// called with each event
+template<typename Event, typename Sink>
+struct SinkForwarder {
+    using Reserves = reserves_events<Sink>;
+
+    Sink &sink;
+
+    void reserve(int size) {
+        reserve_block(Reserves(), size);
+    }
+
+    template<typename... Args>
+    void forward(Args &&...args) {
+        sink(Event(std::forward<Args>(args)...));
+    }
+
+    template<typename... Args>
+    void forward_unsafe(Args &&...args) {
+        forward_unsafe_if(true, std::forward<Args>(args)...);
+    }
+
+    template<typename... Args>
+    void forward_unsafe_if(bool condition, Args &&...args) {
+        write_unsafe_if(Reserves(), condition, Event(std::forward<Args>(args)...));
+    }
+
+private:
+    void reserve_block(std::true_type, int size) {
+        sink.reserve(static_cast<size_t>(size));
+    }
+
+    void reserve_block(std::false_type, int) {}
+
+    void write_unsafe_if(std::true_type, bool condition, const Event &ev) {
+        sink.push_unsafe_if(condition, ev);
+    }
+
+    void write_unsafe_if(std::false_type, bool condition, const Event &ev) {
+        if (condition) {
+            sink(ev);
+        }
+    }
+};
+
+// Drops the events of a type the sink can not be called with
+template<typename Sink>
+struct NullForwarder {
+    Sink &sink;
+
+    template<typename... Args>
+    void forward(Args &&...) {}
+};
+
+} // namespace detail
+} // namespace Evt2
+
+template<typename Sink>
+long EVT2Decoder::decode_into(const RawData *raw_data_begin, const RawData *raw_data_end, Sink &sink) {
+    constexpr bool DecodeExtTrigger = Evt2::detail::accepts_event<Sink, EventExtTrigger>::value;
+    static_assert(Evt2::detail::accepts_event<Sink, EventCD>::value,
+                  "The sink must be callable with a const EventCD &, see EVT2Decoder::decode_into");
+
+    const RawData *const raw_data_end_decodable_range =
+        raw_data_begin + Evt2::detail::WordSize * ((raw_data_end - raw_data_begin) / Evt2::detail::WordSize);
+    using TriggerForwarder = std::conditional_t<DecodeExtTrigger, Evt2::detail::SinkForwarder<EventExtTrigger, Sink>,
+                                                Evt2::detail::NullForwarder<Sink>>;
+    Evt2::detail::SinkForwarder<EventCD, Sink> cd_forwarder{sink};
+    TriggerForwarder trigger_forwarder{sink};
+    decode_events(raw_data_begin, raw_data_end_decodable_range, &cd_forwarder,
+                  DecodeExtTrigger ? &trigger_forwarder : nullptr);
+    return static_cast<long>(raw_data_end_decodable_range - raw_data_begin);
+}
+
+template<typename CDForwarder, typename TriggerForwarder>
+void EVT2Decoder::decode_events(const RawData *cur, const RawData *end, CDForwarder *cd_forwarder,
+                                TriggerForwarder *trigger_forwarder) {
+    using namespace Evt2::detail;
+
+    if (!time_.is_time_base_set()) {
+        // The time of the events is unknown until the first time high
+        for (; cur != end && Evt2::get_type(load_word(cur)) != Evt2::EventTypes::EVT_TIME_HIGH; cur += WordSize) {}
+        if (cur == end) {
+            return;
+        }
+    }
+
+    DecodingFilter *filter = cd_event_filter();
+    Evt2::RawWord block[BlockSize];
+    while (cur != end) {
+        // Fast path: in dense streams, most of the words are CD events
+        if (cd_forwarder && static_cast<size_t>(end - cur) >= BlockSize * WordSize && load_cd_block(cur, block)) {
+            const timestamp base = time_.get_time_base();
+            cd_forwarder->reserve(BlockSize);
+            if (filter) {
+                // The events rejected are written but overwritten by the next ones, without branching
+                for (size_t i = 0; i < BlockSize; ++i) {
+                    const Evt2::RawWord word = block[i];
+                    const unsigned short x   = static_cast<unsigned short>((word >> Evt2::XShift) & Evt2::CoordMask);
+                    const unsigned short y   = static_cast<unsigned short>(word & Evt2::CoordMask);
+                    const short p            = static_cast<short>((word >> Evt2::TypeShift) & 1);
+                    cd_forwarder->forward_unsafe_if(filter->is_accepted(x, y, p) && filter->decimate(), x, y, p,
+                                                    base + ((word >> Evt2::TimestampShift) & Evt2::TsLsbMask));
+                }
+            } else {
+                for (size_t i = 0; i < BlockSize; ++i) {
+                    const Evt2::RawWord word = block[i];
+                    cd_forwarder->forward_unsafe(static_cast<unsigned short>((word >> Evt2::XShift) & Evt2::CoordMask),
+                                                 static_cast<unsigned short>(word & Evt2::CoordMask),
+                                                 static_cast<short>((word >> Evt2::TypeShift) & 1),
+                                                 base + ((word >> Evt2::TimestampShift) & Evt2::TsLsbMask));
+                }
+            }
+            last_timestamp_ = base + ((block[BlockSize - 1] >> Evt2::TimestampShift) & Evt2::TsLsbMask);
+            cur += BlockSize * WordSize;
+            continue;
+        }
+
+        const Evt2::RawWord word = load_word(cur);
+        cur += WordSize;
+        switch (Evt2::get_type(word)) {
+        case Evt2::EventTypes::CD_LOW:
+        case Evt2::EventTypes::CD_HIGH:
+            last_timestamp_ = time_.get_time((word >> Evt2::TimestampShift) & Evt2::TsLsbMask);
+            if (cd_forwarder) {
+                const unsigned short x = static_cast<unsigned short>((word >> Evt2::XShift) & Evt2::CoordMask);
+                const unsigned short y = static_cast<unsigned short>(word & Evt2::CoordMask);
+                const short p          = static_cast<short>((word >> Evt2::TypeShift) & 1);
+                if (!filter || (filter->is_accepted(x, y, p) && filter->decimate())) {
+                    cd_forwarder->forward(x, y, p, last_timestamp_);
+                }
+            }
+            break;
+        case Evt2::EventTypes::EVT_TIME_HIGH: {
+            const timestamp previous_time_base = time_.get_time_base();
+            time_.add_time_high(word & Evt2::TsMsbMask);
+            last_timestamp_ = time_.get_time_base();
+            auto &counters  = statistics_counters();
+            ++counters.time_high_words;
+            counters.out_of_order_timestamps += last_timestamp_ < previous_time_base;
+            break;
+        }
+        case Evt2::EventTypes::EXT_TRIGGER:
+            last_timestamp_ = time_.get_time((word >> Evt2::TimestampShift) & Evt2::TsLsbMask);
+            if (trigger_forwarder) {
+                trigger_forwarder->forward(static_cast<short>(word & 1), last_timestamp_,
+                                           static_cast<short>((word >> Evt2::TriggerIdShift) & Evt2::TriggerMask));
+            }
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+} // namespace Metavision
+
+#endif // METAVISION_HAL_EVT2_DECODER_IMPL_H
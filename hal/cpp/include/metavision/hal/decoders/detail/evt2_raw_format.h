@@ -0,0 +1,53 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_EVT2_RAW_FORMAT_H
+#define METAVISION_HAL_EVT2_RAW_FORMAT_H
+
+#include <cstdint>
+
+namespace Metavision {
+namespace Evt2 {
+
+// EVT2 is a 32 bits data format, the event type being encoded in the 4 most significant bits of each word
+enum class EventTypes : uint8_t {
+    CD_LOW        = 0x00, // CD event, decrease in illumination (polarity '0')
+    CD_HIGH       = 0x01, // CD event, increase in illumination (polarity '1')
+    EVT_TIME_HIGH = 0x08, // Encodes the higher portion of the timebase (range 33 to 6)
+    EXT_TRIGGER   = 0x0A, // External trigger output
+};
+
+using RawWord = uint32_t;
+
+// Layout of the words, from the least significant bit
+//   CD_LOW / CD_HIGH : y (11 bits), x (11 bits), timestamp (6 bits), type (4 bits)
+//   EVT_TIME_HIGH    : timestamp (28 bits), type (4 bits)
+//   EXT_TRIGGER      : value (1 bit), unused (7 bits), id (5 bits), unused (9 bits), timestamp (6 bits), type (4 bits)
+constexpr int TypeShift       = 28;
+constexpr int XShift          = 11;
+constexpr int TimestampShift  = 22;
+constexpr int TriggerIdShift  = 8;
+constexpr RawWord CoordMask   = 0x7FF;
+constexpr RawWord TsLsbMask   = 0x3F;
+constexpr RawWord TsMsbMask   = 0xFFFFFFF;
+constexpr RawWord TriggerMask = 0x1F;
+
+// Number of bits of the timestamp encoded in a CD or trigger word
+constexpr int TimestampLsbBits = 6;
+
+inline EventTypes get_type(RawWord word) {
+    return static_cast<EventTypes>(word >> TypeShift);
+}
+
+} // namespace Evt2
+} // namespace Metavision
+
+#endif // METAVISION_HAL_EVT2_RAW_FORMAT_H
@@ -0,0 +1,61 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_EVT3_RAW_FORMAT_H
+#define METAVISION_HAL_EVT3_RAW_FORMAT_H
+
+#include <cstdint>
+
+namespace Metavision {
+namespace Evt3 {
+
+// EVT3 is a 16 bits vectorized data format, the event type being encoded in the 4 most significant bits of each word.
+// It avoids transmitting redundant time, y and x values: words update a decoding state (time, y, x base, polarity)
+// and events are emitted by X_POS, VECT_12 and VECT_8 words.
+enum class EventTypes : uint8_t {
+    CD_Y          = 0x0, // Identifies a CD event and its y coordinate
+    EM_Y          = 0x1, // Identifies a EM event and its y coordinate
+    X_POS         = 0x2, // Single event at x with polarity, also sets the x base (X_BASE.x = X_POS.x)
+    X_BASE        = 0x3, // Sets the x base and polarity of the subsequent vector events
+    VECT_12       = 0x4, // Validity of the 12 events following the x base, which is then incremented by 12
+    VECT_8        = 0x5, // Validity of the 8 events following the x base, which is then incremented by 8
+    EVT_TIME_LOW  = 0x6, // Encodes the lower 12 bits of the timebase (range 11 to 0)
+    EVT_TIME_HIGH = 0x8, // Encodes the higher 12 bits of the timebase (range 23 to 12)
+    EXT_TRIGGER   = 0xA, // External trigger output
+};
+
+using RawWord = uint16_t;
+
+// Layout of the words, from the least significant bit
+//   CD_Y / EM_Y                  : y (11 bits), system type (1 bit), type (4 bits)
+//   X_POS / X_BASE               : x (11 bits), polarity (1 bit), type (4 bits)
+//   VECT_12                      : validity (12 bits), type (4 bits)
+//   VECT_8                       : validity (8 bits), unused (4 bits), type (4 bits)
+//   EVT_TIME_LOW / EVT_TIME_HIGH : time (12 bits), type (4 bits)
+//   EXT_TRIGGER                  : value (1 bit), unused (7 bits), id (4 bits), type (4 bits)
+constexpr int TypeShift         = 12;
+constexpr int PolarityShift     = 11;
+constexpr int TriggerIdShift    = 8;
+constexpr RawWord CoordMask     = 0x7FF;
+constexpr RawWord Vect12Mask    = 0xFFF;
+constexpr RawWord Vect8Mask     = 0xFF;
+constexpr RawWord TimeMask      = 0xFFF;
+constexpr RawWord TriggerIdMask = 0xF;
+constexpr int TimeLowBits       = 12;
+
+inline EventTypes get_type(RawWord word) {
+    return static_cast<EventTypes>(word >> TypeShift);
+}
+
+} // namespace Evt3
+} // namespace Metavision
+
+#endif // METAVISION_HAL_EVT3_RAW_FORMAT_H
@@ -0,0 +1,102 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_EVT2_DECODER_H
+#define METAVISION_HAL_EVT2_DECODER_H
+
+#include <memory>
+
+#include "metavision/hal/facilities/i_decoder.h"
+#include "metavision/hal/decoders/buffered_event_sink.h"
+#include "metavision/hal/decoders/detail/evt2_raw_format.h"
+#include "metavision/hal/utils/timestamp_unwrapper.h"
+
+namespace Metavision {
+
+/// @brief Decoder of the EVT2 format
+///
+/// Blocks of consecutive CD events are decoded 8 words at a time, using AVX2 or NEON when the library is compiled for
+/// them. The filter of the CD events is applied to the blocks without branching.
+/// Events received before the first EVT_TIME_HIGH word are dropped, as their timestamp can not be known.
+/// Every EVT_TIME_HIGH word is a resync point.
+class EVT2Decoder : public I_Decoder {
+public:
+    /// @brief Constructor
+    /// @param time_shifting_enabled If true, the timestamp of the decoded events will be shifted by the value of the
+    /// first EVT_TIME_HIGH of the stream
+    /// @param event_cd_decoder Optional decoder of CD events
+    /// @param event_ext_trigger_decoder Optional decoder of trigger events
+    EVT2Decoder(
+        bool time_shifting_enabled,
+        const std::shared_ptr<I_EventDecoder<EventCD>> &event_cd_decoder = std::shared_ptr<I_EventDecoder<EventCD>>(),
+        const std::shared_ptr<I_EventDecoder<EventExtTrigger>> &event_ext_trigger_decoder =
+            std::shared_ptr<I_EventDecoder<EventExtTrigger>>());
+
+    timestamp get_last_timestamp() const override final;
+
+    bool get_timestamp_shift(timestamp &timestamp_shift) const override final;
+
+    uint8_t get_raw_event_size_bytes() const override final;
+
+    const RawData *find_resync_point(const RawData *raw_data_begin, const RawData *raw_data_end) const override final;
+
+    const RawData *find_time_base(const RawData *raw_data_begin, const RawData *raw_data_end,
+                                  timestamp &time_base) const override final;
+
+    timestamp get_time_base_period() const override final;
+
+    /// @brief Decodes raw data directly into a sink whose type is known at compile time
+    ///
+    /// Unlike @ref decode, the events are not buffered and dispatched to the callbacks of the
+    /// @ref I_EventDecoder instances through function pointers: the sink is called with each event decoded, and can be
+    /// inlined in the decoding loop. This is meant for the offline tools that have a single consumer of the events.
+    /// The filter of the CD events (see @ref set_cd_event_filter) is applied, but the time callbacks are not called
+    /// and the statistics are not published. Batches of events can be processed with a @ref BufferedEventSink.
+    /// @warning The same decoder must not be used with both @ref decode and this method, as the incomplete raw event
+    /// carried over by @ref decode is not decoded here
+    /// @tparam Sink Type of the consumer of the events, called as `sink(const EventCD &)` with each CD event and, if it
+    /// can be called so, as `sink(const EventExtTrigger &)` with each trigger event
+    /// @param raw_data_begin Pointer on first event
+    /// @param raw_data_end Pointer after the last event
+    /// @param sink Consumer of the events
+    /// @return Number of bytes consumed, i.e. the size of the whole raw events of the input. The incomplete raw event
+    /// at its end, if any, must be passed first to the next call
+    template<typename Sink>
+    long decode_into(const RawData *raw_data_begin, const RawData *raw_data_end, Sink &sink);
+
+private:
+    void decode_impl(RawData *raw_data_begin, RawData *raw_data_end) override final;
+
+    // Decodes the words of [cur, end), giving the events to the forwarders of their type. A null forwarder drops the
+    // events of its type. The forwarders have the interface of DecodedEventForwarder, so that decode_impl and
+    // decode_into share the same loop, the calls being resolved at compile time
+    template<typename CDForwarder, typename TriggerForwarder>
+    void decode_events(const RawData *cur, const RawData *end, CDForwarder *cd_forwarder,
+                       TriggerForwarder *trigger_forwarder);
+    // Copies Evt2::detail::BlockSize words from data to words and returns true if they are all CD events. Defined with
+    // the SIMD instructions the library is built for, out of this header, so that it is the same for all the callers
+    static bool load_cd_block(const RawData *data, Evt2::RawWord *words);
+    bool reset_last_timestamp_impl(const timestamp &t) override final;
+    bool reset_timestamp_shift_impl(const timestamp &shift) override final;
+    bool is_cd_event_filter_supported_impl() const override final;
+
+    const bool decode_cd_;
+    const bool decode_ext_trigger_;
+
+    TimestampUnwrapper<28, Evt2::TimestampLsbBits> time_;
+    timestamp last_timestamp_{0};
+};
+
+} // namespace Metavision
+
+#include "detail/evt2_decoder_impl.h"
+
+#endif // METAVISION_HAL_EVT2_DECODER_H
@@ -0,0 +1,79 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_EVT3_DECODER_H
+#define METAVISION_HAL_EVT3_DECODER_H
+
+#include <memory>
+
+#include "metavision/hal/facilities/i_decoder.h"
+#include "metavision/hal/decoders/detail/evt3_raw_format.h"
+#include "metavision/hal/utils/timestamp_unwrapper.h"
+
+namespace Metavision {
+
+/// @brief Decoder of the EVT3 format
+///
+/// The VECT_12 and VECT_8 words are expanded by iterating over their set bits only, so that the cost of a vector
+/// depends on the number of events it holds rather than on its width.
+/// The filter of the CD events is applied to the vectors as a whole, masking out the pixels rejected.
+/// Events received before the first EVT_TIME_HIGH word are dropped, as their timestamp can not be known.
+/// Resync points are the EVT_TIME_HIGH words followed by a Y address before any X address, so that no event depends on
+/// an address sent before them.
+class EVT3Decoder : public I_Decoder {
+public:
+    /// @brief Constructor
+    /// @param time_shifting_enabled If true, the timestamp of the decoded events will be shifted by the value of the
+    /// first EVT_TIME_HIGH of the stream
+    /// @param event_cd_decoder Optional decoder of CD events
+    /// @param event_ext_trigger_decoder Optional decoder of trigger events
+    EVT3Decoder(
+        bool time_shifting_enabled,
+        const std::shared_ptr<I_EventDecoder<EventCD>> &event_cd_decoder = std::shared_ptr<I_EventDecoder<EventCD>>(),
+        const std::shared_ptr<I_EventDecoder<EventExtTrigger>> &event_ext_trigger_decoder =
+            std::shared_ptr<I_EventDecoder<EventExtTrigger>>());
+
+    timestamp get_last_timestamp() const override final;
+
+    bool get_timestamp_shift(timestamp &timestamp_shift) const override final;
+
+    uint8_t get_raw_event_size_bytes() const override final;
+
+    const RawData *find_resync_point(const RawData *raw_data_begin, const RawData *raw_data_end) const override final;
+
+    const RawData *find_time_base(const RawData *raw_data_begin, const RawData *raw_data_end,
+                                  timestamp &time_base) const override final;
+
+    timestamp get_time_base_period() const override final;
+
+private:
+    void decode_impl(RawData *raw_data_begin, RawData *raw_data_end) override final;
+    bool reset_last_timestamp_impl(const timestamp &t) override final;
+    bool reset_timestamp_shift_impl(const timestamp &shift) override final;
+    bool is_cd_event_filter_supported_impl() const override final;
+    void decode_vector(uint32_t valid, int width);
+
+    const bool decode_cd_;
+    const bool decode_ext_trigger_;
+
+    TimestampUnwrapper<12, Evt3::TimeLowBits> time_base_;
+    timestamp time_{0}; // Shifted time of the last time low or time high
+
+    // Decoding state updated by the words that do not carry events
+    bool is_cd_{false};
+    uint16_t y_{0};
+    uint16_t x_base_{0};
+    short polarity_{0};
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_HAL_EVT3_DECODER_H
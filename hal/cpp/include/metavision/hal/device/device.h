@@ -17,6 +17,7 @@
 #include <unordered_map>
 #include <typeinfo>
 #include <functional>
+#include <vector>
 
 #include "metavision/hal/facilities/i_registrable_facility.h"
 #include "metavision/hal/facilities/detail/facility_wrapper.h"
@@ -31,9 +32,10 @@ public:
     FacilityType *get_facility() {
         static_assert(std::is_base_of<I_RegistrableFacility<FacilityType>, FacilityType>::value,
                       "Unable to get facility of unregistrable facility type.");
-        auto it = facilities_.find(std::hash<std::string>{}(FacilityType::class_registration_info().name()));
-        if (it != facilities_.end()) {
-            return static_cast<FacilityType *>(it->second->facility().get());
+        // The index of the facility type is computed once, the facilities being stored in an array indexed by it
+        const size_t index = FacilityType::class_registration_index();
+        if (index < facilities_.size() && facilities_[index]) {
+            return static_cast<FacilityType *>(facilities_[index]->facility().get());
         }
         return nullptr;
     }
@@ -63,7 +65,7 @@ private:
         }
     }
 
-    std::unordered_map<size_t, std::unique_ptr<FacilityWrapper>> facilities_;
+    std::vector<std::unique_ptr<FacilityWrapper>> facilities_; // Indexed by get_facility_index
 
     friend class DeviceBuilder;
 };
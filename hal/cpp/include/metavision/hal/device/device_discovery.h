@@ -12,10 +12,13 @@
 #ifndef METAVISION_HAL_DEVICE_DISCOVERY_H
 #define METAVISION_HAL_DEVICE_DISCOVERY_H
 
+#include <cstdint>
 #include <list>
 #include <memory>
 #include <string>
+#include <vector>
 
+#include "metavision/hal/utils/memory_raw_stream.h"
 #include "metavision/hal/utils/raw_file_config.h"
 
 namespace Metavision {
@@ -104,7 +107,10 @@ public:
 
     /// @brief Builds a new Device
     /// @param serial Serial number of the camera to open. If it is an empty string, the first available camera will be
-    /// opened
+    /// opened. If it is "shm://<name>", the RAW data published by another process in the shared memory ring <name> is
+    /// read instead (see @ref open_shared_memory). If it is "tcp://<host>:<port>", the RAW data streamed by a server
+    /// is read instead (see @ref open_network_stream). If it is "synthetic:<configuration>", it is given as is to the
+    /// plugins, which can generate events as configured instead of reading a camera (e.g. the sample plugin)
     /// @param config Configuration used to build the camera
     /// @return A new Device
     static std::unique_ptr<Device> open(const std::string &serial, DeviceConfig &config);
@@ -115,11 +121,29 @@ public:
     static std::unique_ptr<Device> open_raw_file(const std::string &raw_file);
 
     /// @brief Builds a new Device from file
+    ///
+    /// The file can also be stored remotely, given by an URL "http://..." or "s3://..." (see
+    /// @ref RangedReadBackend::open). It is then streamed with several ranges fetched in parallel (at least 8, see
+    /// @ref RawFileConfig::n_reads_in_flight_, @ref RawFileConfig::n_read_buffers_ being raised accordingly), and its
+    /// index is loaded from its sidecar, if it is stored along with it. If it is the manifest of a recording striped
+    /// across several files (see @ref StripedRawFileWriter), the stripes are read in turn as a single stream.
     /// @param raw_file Path to the file to open
     /// @param file_config Configuration describing how to read the file (see @ref RawFileConfig)
     /// @return A new Device
     static std::unique_ptr<Device> open_raw_file(const std::string &raw_file, RawFileConfig &file_config);
 
+    /// @brief Builds a new Device reading several RAW files in order, as a single continuous stream
+    ///
+    /// The files are typically the parts of a recording split by time or size: they are chained without restarting the
+    /// decoding, and the next file is prefetched while a file is read (see @ref RawFilePlaylistStream). Seeking in the
+    /// playlist is not supported.
+    /// @param raw_files Paths to the files to open, in order
+    /// @param file_config Configuration describing how to read the files (see @ref RawFileConfig)
+    /// @return A new Device
+    /// @throw HalException if the files can not be read or if their headers differ
+    static std::unique_ptr<Device> open_raw_files(const std::vector<std::string> &raw_files,
+                                                  RawFileConfig &file_config);
+
     /// @brief Builds a new Device from a standard input stream
     /// @param stream The input stream to read from. The device takes ownership of the input stream to ensure its
     /// validity during the lifetime of the device object.
@@ -127,6 +151,40 @@ public:
     /// @return A new Device
     static std::unique_ptr<Device> open_stream(std::unique_ptr<std::istream> stream, RawFileConfig &stream_config);
 
+    /// @brief Builds a new Device reading the RAW data published by another process in shared memory
+    ///
+    /// The device gets the data published after it is opened, and stops when the publisher closes the ring (see
+    /// @ref I_EventsStream::publish_raw_data).
+    /// @param name Name of the shared memory ring to read
+    /// @param stream_config Configuration describing how to read the data (see @ref RawFileConfig)
+    /// @return A new Device
+    /// @throw HalException if the ring could not be opened
+    static std::unique_ptr<Device> open_shared_memory(const std::string &name, RawFileConfig &stream_config);
+
+    /// @brief Builds a new Device reading RAW data already in memory, e.g. received over a message bus
+    ///
+    /// The data is read without copy, the buffers being transferred as slices (see @ref MemoryRawStream). It must
+    /// start with the header of the RAW data, as a RAW file.
+    /// @param buffers Buffers holding the RAW data, read one after the other
+    /// @param stream_config Configuration describing how to read the data (see @ref RawFileConfig)
+    /// @param owner Object owning the memory, kept alive as long as the device and the data it transferred, or nullptr
+    /// if the memory is guaranteed to outlive them
+    /// @return A new Device
+    static std::unique_ptr<Device> open_memory(const std::vector<MemoryRawStream::Buffer> &buffers,
+                                               RawFileConfig &stream_config,
+                                               const std::shared_ptr<const void> &owner = nullptr);
+
+    /// @brief Builds a new Device reading the RAW data streamed over the network by a @ref NetworkRawStreamServer
+    ///
+    /// The device gets the data sent after it connected, and stops when the server closes the connection.
+    /// @param host Name or address of the host of the server
+    /// @param port Port the server listens on
+    /// @param stream_config Configuration describing how to read the data (see @ref RawFileConfig)
+    /// @return A new Device
+    /// @throw HalException if the connection to the server failed
+    static std::unique_ptr<Device> open_network_stream(const std::string &host, uint16_t port,
+                                                       RawFileConfig &stream_config);
+
     /// @note type_ListSerial is deprecated since version 2.2.0 and will be removed in later
     /// releases. Please use SerialList instead.
     using type_ListSerial [[deprecated("type_ListSerial is deprecated since version 2.2.0 and will be removed in later "
@@ -0,0 +1,31 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_DETAIL_FACILITY_INDEX_H
+#define METAVISION_HAL_DETAIL_FACILITY_INDEX_H
+
+#include <cstddef>
+#include <typeinfo>
+
+namespace Metavision {
+
+/// @brief Gets the index of a facility type, used to store the facilities of a device in an array
+///
+/// The indices are small integers, assigned in the order in which the facility types are first seen. The types are
+/// identified by their name, so that a facility type has the same index in all the shared libraries using it (HAL and
+/// its plugins).
+/// @param registration_info Registration information of the facility type
+/// @return The index of the facility type
+size_t get_facility_index(const std::type_info &registration_info);
+
+} // namespace Metavision
+
+#endif // METAVISION_HAL_DETAIL_FACILITY_INDEX_H
@@ -12,18 +12,35 @@
 #ifndef METAVISION_HAL_I_DECODER_IMPL_H
 #define METAVISION_HAL_I_DECODER_IMPL_H
 
+#include <algorithm>
+
 namespace Metavision {
 
+namespace detail {
+// Only the CD events are filtered
+template<typename Event>
+inline Event *apply_decoding_filter(DecodingFilter &, Event *, Event *end) {
+    return end;
+}
+
+inline EventCD *apply_decoding_filter(DecodingFilter &filter, EventCD *begin, EventCD *end) {
+    return filter.apply(begin, end);
+}
+} // namespace detail
+
 template<typename Event, int BUFFER_SIZE>
-I_Decoder::DecodedEventForwarder<Event, BUFFER_SIZE>::DecodedEventForwarder(I_EventDecoder<Event> *i_event_decoder) :
-    i_event_decoder_(i_event_decoder) {
-    current_ev_ = &ev_buf_[0];
-    ev_end_     = current_ev_ + BUFFER_SIZE;
+I_Decoder::DecodedEventForwarder<Event, BUFFER_SIZE>::DecodedEventForwarder(I_EventDecoder<Event> *i_event_decoder,
+                                                                           size_t buffer_size) :
+    i_event_decoder_(i_event_decoder), buffer_size_(std::max(buffer_size, static_cast<size_t>(BUFFER_SIZE))) {
+    reset_buffer();
 }
 
 template<typename Event, int BUFFER_SIZE>
 template<typename... Args>
 void I_Decoder::DecodedEventForwarder<Event, BUFFER_SIZE>::forward(Args &&...args) {
+    if (before_forward_) {
+        before_forward_();
+    }
     *current_ev_ = Event(std::forward<Args>(args)...);
     if (++current_ev_ >= ev_end_) {
         add_events();
@@ -37,9 +54,16 @@ void I_Decoder::DecodedEventForwarder<Event, BUFFER_SIZE>::forward_unsafe(Args &
     ++current_ev_;
 }
 
+template<typename Event, int BUFFER_SIZE>
+template<typename... Args>
+void I_Decoder::DecodedEventForwarder<Event, BUFFER_SIZE>::forward_unsafe_if(bool condition, Args &&...args) {
+    *current_ev_ = Event(std::forward<Args>(args)...);
+    current_ev_ += condition;
+}
+
 template<typename Event, int BUFFER_SIZE>
 void I_Decoder::DecodedEventForwarder<Event, BUFFER_SIZE>::flush() {
-    if (current_ev_ > ev_buf_) {
+    if (current_ev_ > ev_buf_.data()) {
         add_events();
     }
 }
@@ -54,20 +78,90 @@ void I_Decoder::DecodedEventForwarder<Event, BUFFER_SIZE>::reserve(int size) {
     }
 }
 
+template<typename Event, int BUFFER_SIZE>
+void I_Decoder::DecodedEventForwarder<Event, BUFFER_SIZE>::set_buffer_size(size_t size) {
+    flush();
+    buffer_size_ = std::max(size, static_cast<size_t>(BUFFER_SIZE));
+    reset_buffer();
+}
+
+template<typename Event, int BUFFER_SIZE>
+size_t I_Decoder::DecodedEventForwarder<Event, BUFFER_SIZE>::get_buffer_size() const {
+    return buffer_size_;
+}
+
+template<typename Event, int BUFFER_SIZE>
+void I_Decoder::DecodedEventForwarder<Event, BUFFER_SIZE>::set_filter(DecodingFilter *filter) {
+    flush();
+    filter_ = filter;
+}
+
+template<typename Event, int BUFFER_SIZE>
+void I_Decoder::DecodedEventForwarder<Event, BUFFER_SIZE>::set_before_forward_callback(
+    const std::function<void()> &cb) {
+    before_forward_ = cb;
+}
+
+template<typename Event, int BUFFER_SIZE>
+void I_Decoder::DecodedEventForwarder<Event, BUFFER_SIZE>::set_before_add_events_callback(
+    const std::function<void()> &cb) {
+    before_add_events_ = cb;
+}
+
+template<typename Event, int BUFFER_SIZE>
+uint64_t I_Decoder::DecodedEventForwarder<Event, BUFFER_SIZE>::get_forwarded_count() const {
+    return forwarded_count_;
+}
+
 template<typename Event, int BUFFER_SIZE>
 void I_Decoder::DecodedEventForwarder<Event, BUFFER_SIZE>::add_events() {
-    i_event_decoder_->add_event_buffer(ev_buf_, current_ev_);
-    current_ev_ = &ev_buf_[0];
+    if (before_add_events_) {
+        before_add_events_();
+    }
+    if (filter_) {
+        current_ev_ = detail::apply_decoding_filter(*filter_, ev_buf_.data(), current_ev_);
+        if (current_ev_ == ev_buf_.data()) {
+            return;
+        }
+    }
+    forwarded_count_ += current_ev_ - ev_buf_.data();
+    if (i_event_decoder_->has_event_vector_callback()) {
+        if (current_ev_ == ev_buf_.data()) {
+            return;
+        }
+        // The buffer is handed off and replaced by a new one
+        ev_buf_.resize(current_ev_ - ev_buf_.data());
+        i_event_decoder_->add_event_vector(std::move(ev_buf_));
+        ev_buf_ = i_event_decoder_->allocate_event_vector();
+    } else {
+        i_event_decoder_->add_event_buffer(ev_buf_.data(), current_ev_);
+    }
+    reset_buffer();
+}
+
+template<typename Event, int BUFFER_SIZE>
+void I_Decoder::DecodedEventForwarder<Event, BUFFER_SIZE>::reset_buffer() {
+    ev_buf_.resize(buffer_size_);
+    current_ev_ = ev_buf_.data();
+    ev_end_     = current_ev_ + buffer_size_;
 }
 
 inline I_Decoder::DecodedEventForwarder<EventCD> &I_Decoder::cd_event_forwarder() {
     return *cd_event_forwarder_;
 }
 
-inline I_Decoder::DecodedEventForwarder<EventExtTrigger, 1> &I_Decoder::trigger_event_forwarder() {
+inline I_Decoder::DecodedEventForwarder<EventExtTrigger> &I_Decoder::trigger_event_forwarder() {
     return *trigger_event_forwarder_;
 }
 
+inline DecodingFilter *I_Decoder::cd_event_filter() {
+    return cd_event_filter_.get();
+}
+
+inline I_Decoder::Statistics &I_Decoder::statistics_counters() {
+    return statistics_counters_;
+}
+
 } // namespace Metavision
 
 #endif // METAVISION_HAL_I_DECODER_IMPL_H
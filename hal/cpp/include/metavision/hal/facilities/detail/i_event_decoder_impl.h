@@ -22,29 +22,74 @@ namespace Metavision {
 
 template<typename Event>
 size_t I_EventDecoder<Event>::add_event_buffer_callback(const EventBufferCallback_t &cb) {
-    cbs_map_[next_cb_idx_] = cb;
-    return next_cb_idx_++;
+    const size_t idx = next_cb_idx_++;
+    cbs_.add(idx, cb);
+    return idx;
+}
+
+template<typename Event>
+size_t I_EventDecoder<Event>::add_event_soa_buffer_callback(const EventSoABufferCallback_t &cb) {
+    const size_t idx = next_cb_idx_++;
+    soa_cbs_.add(idx, cb);
+    soa_dispatch_.store(&I_EventDecoder::dispatch_soa, std::memory_order_release);
+    return idx;
 }
 
 template<typename Event>
 bool I_EventDecoder<Event>::remove_callback(size_t callback_id) {
-    auto it = cbs_map_.find(callback_id);
-    if (it != cbs_map_.end()) {
-        cbs_map_.erase(it);
-        return true;
-    }
-    return false;
+    return cbs_.remove(callback_id) || soa_cbs_.remove(callback_id);
+}
+
+template<typename Event>
+void I_EventDecoder<Event>::set_event_vector_callback(const EventVectorCallback_t &cb,
+                                                      const EventVectorAllocator_t &allocator) {
+    vector_cb_        = cb;
+    vector_allocator_ = allocator;
 }
 
 /// @cond DEV
 template<typename Event>
 void I_EventDecoder<Event>::add_event_buffer(EventIterator_t begin, EventIterator_t end) {
-    for (auto it = cbs_map_.begin(), it_end = cbs_map_.end(); it != it_end; ++it) {
-        it->second(begin, end);
+    cbs_(begin, end);
+    if (const SoADispatch_t soa_dispatch = soa_dispatch_.load(std::memory_order_acquire)) {
+        soa_dispatch(*this, begin, end);
+    }
+}
+
+template<typename Event>
+void I_EventDecoder<Event>::add_event_vector(EventVector_t &&events) {
+    add_event_buffer(events.data(), events.data() + events.size());
+    if (vector_cb_) {
+        vector_cb_(std::move(events));
     }
 }
+
+template<typename Event>
+bool I_EventDecoder<Event>::has_event_vector_callback() const {
+    return static_cast<bool>(vector_cb_);
+}
+
+template<typename Event>
+typename I_EventDecoder<Event>::EventVector_t I_EventDecoder<Event>::allocate_event_vector() {
+    return vector_allocator_ ? vector_allocator_() : EventVector_t();
+}
 /// @endcond
 
+template<typename Event>
+void I_EventDecoder<Event>::dispatch_soa(I_EventDecoder &decoder, EventIterator_t begin, EventIterator_t end) {
+    const auto cbs = decoder.soa_cbs_.get();
+    if (cbs->empty()) {
+        return;
+    }
+    if (!decoder.soa_buffer_) {
+        decoder.soa_buffer_ = std::make_shared<EventBufferSoA_t>();
+    }
+    decoder.soa_buffer_->assign(begin, end);
+    for (size_t i = 0, n = cbs->size(); i < n; ++i) {
+        (*cbs)[i](*decoder.soa_buffer_);
+    }
+}
+
 template<typename Event>
 void I_EventDecoder<Event>::set_add_decoded_event_callback(AddEventCallback_t cb, bool add) {
     static bool warning_already_logged = false;
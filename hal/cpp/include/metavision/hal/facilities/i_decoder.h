@@ -12,14 +12,21 @@
 #ifndef METAVISION_HAL_I_DECODER_H
 #define METAVISION_HAL_I_DECODER_H
 
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <limits>
 #include <vector>
 #include <memory>
-#include <map>
+#include <mutex>
 
+#include "metavision/sdk/base/utils/callback_list.h"
 #include "metavision/sdk/base/utils/timestamp.h"
 #include "metavision/hal/facilities/i_event_decoder.h"
 #include "metavision/hal/facilities/i_registrable_facility.h"
+#include "metavision/hal/utils/decoding_filter.h"
 #include "metavision/sdk/base/events/event_cd.h"
 #include "metavision/sdk/base/events/event_ext_trigger.h"
 
@@ -55,17 +62,32 @@ public:
     /// @param raw_data_end Pointer after the last event
     void decode(RawData *raw_data_begin, RawData *raw_data_end);
 
+    /// @brief Number of raw events decoded between two checks of the last timestamp by @ref decode_until
+    static constexpr long DecodeUntilStepEvents = 128;
+
+    /// @brief Decodes raw data until the timestamp of the last decoded event reaches a limit
+    ///
+    /// The data is decoded by steps of @ref DecodeUntilStepEvents raw events, and the decoding stops after the first
+    /// step at the end of which the last timestamp (see @ref get_last_timestamp) is at or after @p ts_limit. As with
+    /// @ref decode, the decoded events are forwarded and the time callbacks are called once for the whole call.
+    /// @warning The data that is not consumed must be passed first to the next call to @ref decode or
+    /// @ref decode_until
+    /// @param raw_data_begin Pointer on first event
+    /// @param raw_data_end Pointer after the last event
+    /// @param ts_limit Timestamp up to which the data is decoded
+    /// @return Number of bytes consumed, which is at least one step of raw events if there are that many
+    long decode_until(RawData *raw_data_begin, RawData *raw_data_end, timestamp ts_limit);
+
     /// @brief Adds a function that will be called from time to time, giving current timestamp
     /// @param cb Callback to add
     /// @return ID of the added callback
-    /// @note This method is not thread safe. You should add/remove the various callback before starting the streaming
-    /// @note It's not allowed to add/remove a callback from the callback itself
+    /// @note Callbacks can be added or removed from any thread while data is being decoded
     size_t add_time_callback(const TimeCallback_t &cb);
 
     /// @brief Removes a previously registered time callback
     /// @param callback_id Callback ID
     /// @return true if the callback has been unregistered correctly, false otherwise.
-    /// @note This method is not thread safe. You should add/remove the various callback before starting the streaming
+    /// @note Callbacks can be added or removed from any thread while data is being decoded
     bool remove_time_callback(size_t callback_id);
 
     /// @brief Gets the timestamp of the last event
@@ -86,6 +108,154 @@ public:
     /// @brief Gets size of a raw event in bytes
     virtual uint8_t get_raw_event_size_bytes() const = 0;
 
+    /// @brief Sets the number of CD events buffered before being forwarded to the @ref I_EventDecoder<EventCD>
+    ///
+    /// Bigger buffers reduce the number of calls to the callbacks of the event decoder, at the expense of latency.
+    /// @param size Number of events, which can not be lower than the default size (320 events)
+    /// @throw HalException with error InvalidArgument if the size is too low
+    /// @note This method is not thread safe. It must not be called while data is being decoded
+    void set_cd_event_buffer_size(size_t size);
+
+    /// @brief Gets the number of CD events buffered before being forwarded to the @ref I_EventDecoder<EventCD>
+    /// @return Number of events, or 0 if the decoder has no @ref I_EventDecoder<EventCD>
+    size_t get_cd_event_buffer_size() const;
+
+    /// @brief Sets whether the CD and trigger events are forwarded in the order of the stream
+    ///
+    /// The CD and trigger events are buffered separately, and the buffers are forwarded when they are full and at the
+    /// end of each call to @ref decode. By default, the buffers of the 2 types are hence not forwarded in the order of
+    /// the stream. If the order is preserved, the CD events buffered are forwarded before each trigger event is
+    /// buffered, and the trigger events buffered before each buffer of CD events is forwarded: the consumers then
+    /// receive all the events in the order of the stream, at the expense of smaller buffers when the trigger events
+    /// are frequent.
+    /// @param preserved If true, the order of the events is preserved
+    /// @note This method is not thread safe. It must not be called while data is being decoded
+    void set_event_order_preserved(bool preserved);
+
+    /// @brief Returns true if the CD and trigger events are forwarded in the order of the stream
+    bool is_event_order_preserved() const;
+
+    /// @brief Sets a filter of the CD events, applied while decoding
+    ///
+    /// The events rejected by the filter are not forwarded to the @ref I_EventDecoder<EventCD>. The decoders of the
+    /// formats supported by Metavision HAL discard them while decoding the raw data, skipping whole vectors of events
+    /// when possible, the others remove them from the buffers of decoded events before forwarding them.
+    /// @param filter Filter to apply, which is copied
+    /// @note This method is not thread safe. It must not be called while data is being decoded
+    void set_cd_event_filter(const DecodingFilter &filter);
+
+    /// @brief Removes the filter of the CD events, all the events being forwarded again
+    /// @note This method is not thread safe. It must not be called while data is being decoded
+    void clear_cd_event_filter();
+
+    /// @brief Gets the filter of the CD events
+    /// @return The filter, or nullptr if the events are not filtered
+    const DecodingFilter *get_cd_event_filter() const;
+
+    /// @brief Counters of the decoding, to diagnose the content of a stream, see @ref enable_statistics
+    struct Statistics {
+        /// Number of bytes of raw data decoded
+        uint64_t bytes_decoded = 0;
+
+        /// Number of CD events forwarded to the @ref I_EventDecoder<EventCD>, once filtered
+        uint64_t cd_events = 0;
+
+        /// Number of trigger events forwarded to the @ref I_EventDecoder<EventExtTrigger>
+        uint64_t ext_trigger_events = 0;
+
+        /// Number of words setting the time base of the stream, which are also its resync points
+        uint64_t time_high_words = 0;
+
+        /// Number of words encoding several CD events at once, such as the vectors of EVT3
+        uint64_t vector_words = 0;
+
+        /// Number of CD events encoded by the vector words, before filtering. A low number of events per vector word
+        /// makes the decoding of a stream slower
+        uint64_t vector_events = 0;
+
+        /// Number of times the time decoded went back, without the counter of the sensor having wrapped around
+        uint64_t out_of_order_timestamps = 0;
+
+        /// Number of times the end of the data given to @ref decode was an incomplete raw event, carried over to the
+        /// next call
+        uint64_t partial_word_carries = 0;
+    };
+
+    /// @brief Enables the counting of the statistics of the decoding
+    ///
+    /// The counters are plain members updated by the thread decoding the data, and published once at the end of each
+    /// call to @ref decode when the statistics are enabled, so that they do not slow down the decoding. They are not
+    /// reset when disabled.
+    /// @param enable If true, the statistics are published
+    void enable_statistics(bool enable);
+
+    /// @brief Returns true if the statistics of the decoding are enabled
+    bool is_statistics_enabled() const;
+
+    /// @brief Gets a snapshot of the statistics of the decoding, as of the end of the last call to @ref decode
+    /// @return The statistics, all 0 if they were never enabled
+    /// @note This method can be called from any thread
+    Statistics get_statistics() const;
+
+    /// @brief Finds the first resync point of a buffer
+    ///
+    /// A resync point is a raw event from which the data can be decoded without knowing the data preceding it, except
+    /// for the timestamp of the last decoded event (see @ref reset_last_timestamp). Chunks of a stream starting at
+    /// resync points can hence be decoded independently, for instance concurrently.
+    /// The raw event at a resync point is expected to set the time base of the decoder.
+    /// @param raw_data_begin Pointer on first event
+    /// @param raw_data_end Pointer after the last event
+    /// @return Pointer on the first resync point of the buffer, or @p raw_data_end if there is none or if the format
+    /// does not support resynchronization
+    virtual const RawData *find_resync_point(const RawData *raw_data_begin, const RawData *raw_data_end) const;
+
+    /// @brief Finds the first raw event of a buffer that sets the time base of the decoder, e.g. a time high
+    ///
+    /// Together with @ref get_time_base_period, it allows checking that the time bases of a stream are consistent,
+    /// which is used to detect corrupted data and resume the decoding after it (see @ref ResyncDecoder).
+    /// @param raw_data_begin Pointer on first event
+    /// @param raw_data_end Pointer after the last event
+    /// @param time_base Time base set by the event, in us and modulo @ref get_time_base_period
+    /// @return Pointer on the first event setting the time base, or @p raw_data_end if there is none or if the format
+    /// does not support resynchronization
+    virtual const RawData *find_time_base(const RawData *raw_data_begin, const RawData *raw_data_end,
+                                          timestamp &time_base) const;
+
+    /// @brief Gets the period after which the time bases encoded in the raw events loop, in us
+    /// @return The period of the time bases, or 0 if the format does not support resynchronization
+    virtual timestamp get_time_base_period() const;
+
+    /// @brief Resets the state of the decoder so that the decoding resumes from a resync point
+    ///
+    /// The data passed to the next call to @ref decode must start at a resync point, see @ref find_resync_point.
+    /// Incomplete raw data kept from previous calls to @ref decode is discarded.
+    /// @param t Timestamp of the last event decoded before the resync point, in the time reference of the decoded
+    /// events. It is used to keep counting the loops of the timestamps.
+    /// @return true if the decoder has been reset, false if it does not support resynchronization
+    bool reset_last_timestamp(const timestamp &t);
+
+    /// @brief Sets the timestamp shift of the decoder, before resuming the decoding from a resync point
+    ///
+    /// When time shifting is enabled, the shift is normally the first time base of the stream, which a decoder resuming
+    /// from a resync point (for instance after seeking in a file, see @ref I_EventsStream::seek) has not decoded.
+    /// It must be called before @ref reset_last_timestamp, and has no effect if time shifting is disabled.
+    /// @param shift Timestamp shift, i.e. the first time base of the stream
+    /// @return true if the shift has been set, false if the decoder does not support resynchronization
+    bool reset_timestamp_shift(const timestamp &shift);
+
+    /// @brief Resets the state of the decoder so that the decoding resumes from the beginning of the stream, with
+    /// timestamps following the last one decoded
+    ///
+    /// This is used when a stream goes back to its beginning, e.g. a RAW file replayed in a loop (see
+    /// @ref RawFileConfig::loop_): the timestamps decoded after the call are shifted so that the first time base of the
+    /// stream comes right after @ref get_last_timestamp, instead of going back in time.
+    /// The data passed to the next call to @ref decode must be @p raw_data_begin, the beginning of the stream.
+    /// @param raw_data_begin Pointer on the first event of the stream
+    /// @param raw_data_end Pointer after the last event available
+    /// @return true if the decoder has been reset, false if it does not support resynchronization or if there is no
+    /// time base in the data given (see @ref find_time_base)
+    bool restart_stream(const RawData *raw_data_begin, const RawData *raw_data_end);
+
 protected:
     /// @cond DEV
 
@@ -94,10 +264,19 @@ protected:
     /// For performance reasons, it is not recommended to call @ref I_EventDecoder::add_event_buffer event by event.
     /// The decoder implementation is free to use this helper class or not, but some buffering should be put in place
     /// for better performance.
+    /// The size of the buffer is @p BUFFER_SIZE by default, and can be increased at runtime to reduce the number of
+    /// calls to the callbacks of the @ref I_EventDecoder. If the @ref I_EventDecoder has a callback taking the
+    /// ownership of the buffers (see @ref I_EventDecoder::set_event_vector_callback), the events are decoded directly
+    /// into vectors that are moved to it.
     template<typename Event, int BUFFER_SIZE = 320>
     struct DecodedEventForwarder {
+        /// @brief Minimal size of the buffer, which is also the maximal size that can be passed to @ref reserve
+        static constexpr int MinimalBufferSize = BUFFER_SIZE;
+
         /// @brief Constructor
-        DecodedEventForwarder(I_EventDecoder<Event> *i_event_decoder);
+        /// @param i_event_decoder Decoder to forward the events to
+        /// @param buffer_size Number of events in the buffer, at least BUFFER_SIZE
+        DecodedEventForwarder(I_EventDecoder<Event> *i_event_decoder, size_t buffer_size = BUFFER_SIZE);
 
         /// @brief Forwards events
         /// Forwards the event to I_EventDecoder<Event>, with a sanity check on the internal buffer that stores the
@@ -116,16 +295,52 @@ protected:
         /// @brief Flushes stored events, forwarding them all to I_EventDecoder<Event>
         void flush();
 
+        /// @brief Forwards events if a condition is met
+        /// Same as forward_unsafe(), except that the event is only kept if @p condition is true. The event is written
+        /// in any case, which avoids branching on the condition
+        /// @param condition If false, the event is overwritten by the next one
+        /// @param args Input argument to the constructor of a Event
+        template<typename... Args>
+        void forward_unsafe_if(bool condition, Args &&...args);
+
         /// @brief Reserves space in array
         /// Checks if the space asked is available, if not it flushes the events and reset the buffer
         /// After calling this method, you can use forward_unsafe(), instead of operator()
         /// @param size Size to reserve. It has to be <= BUFFER_SIZE
         void reserve(int size);
 
+        /// @brief Flushes stored events and changes the size of the buffer
+        /// @param size Number of events in the buffer, at least BUFFER_SIZE
+        void set_buffer_size(size_t size);
+
+        /// @brief Gets the number of events in the buffer
+        size_t get_buffer_size() const;
+
+        /// @brief Sets a function called before each event is forwarded with forward()
+        /// @param cb Function to call, or an empty function to call none
+        void set_before_forward_callback(const std::function<void()> &cb);
+
+        /// @brief Sets a function called before the buffer is forwarded to I_EventDecoder<Event>
+        /// @param cb Function to call, or an empty function to call none
+        void set_before_add_events_callback(const std::function<void()> &cb);
+
+        /// @brief Sets a filter removing events from the buffer before forwarding them
+        /// @param filter Filter, or nullptr to forward all the events
+        void set_filter(DecodingFilter *filter);
+
+        /// @brief Gets the number of events forwarded to I_EventDecoder<Event> since the creation of the forwarder
+        uint64_t get_forwarded_count() const;
+
     private:
         void add_events();
+        void reset_buffer();
         I_EventDecoder<Event> *i_event_decoder_;
-        Event ev_buf_[BUFFER_SIZE];
+        DecodingFilter *filter_{nullptr};
+        std::function<void()> before_forward_;
+        std::function<void()> before_add_events_;
+        std::vector<Event> ev_buf_;
+        size_t buffer_size_;
+        uint64_t forwarded_count_{0};
         Event *current_ev_;
         const Event *ev_end_;
     };
@@ -134,11 +349,29 @@ protected:
     DecodedEventForwarder<EventCD> &cd_event_forwarder();
 
     /// @brief Gets the reference to the forwarder of trigger events
-    DecodedEventForwarder<EventExtTrigger, 1> &trigger_event_forwarder();
+    DecodedEventForwarder<EventExtTrigger> &trigger_event_forwarder();
+
+    /// @brief Gets the filter of the CD events, for the implementations that apply it while decoding
+    /// @return The filter, or nullptr if the events are not filtered
+    DecodingFilter *cd_event_filter();
+
+    /// @brief Gets the counters of the decoding, for the implementations to update the ones specific to their format
+    ///
+    /// The counters belong to the thread decoding the data and can be updated whether the statistics are enabled or
+    /// not. The number of bytes decoded, of events forwarded and of partial words carried are counted by this class.
+    Statistics &statistics_counters();
 
     /// @endcond
 
 private:
+    RawData *decode_up_to(RawData *raw_data_begin, RawData *raw_data_end, timestamp ts_limit);
+
+    /// @brief Completes the raw event carried over from the previous call with the beginning of the input, and decodes
+    /// it when complete
+    /// @return Pointer after the raw data of the input used
+    RawData *decode_incomplete_raw_data(RawData *raw_data_begin, RawData *raw_data_end, long raw_event_size);
+    void publish_statistics();
+
     /// @brief The implementation of the raw data decoding. Identifies the events in the buffer
     /// and dispatches it to the instance of @ref I_EventDecoder corresponding
     /// to each event type.
@@ -150,17 +383,49 @@ private:
     /// @param raw_data_end Pointer after the last event
     virtual void decode_impl(RawData *raw_data_begin, RawData *raw_data_end) = 0;
 
+    /// @brief The implementation of the reset of the decoder state, see @ref reset_last_timestamp
+    ///
+    /// The default implementation does not support resynchronization and returns false.
+    /// @param t Timestamp of the last event decoded before the resync point
+    /// @return true if the decoder has been reset, false otherwise
+    virtual bool reset_last_timestamp_impl(const timestamp &t);
+
+    /// @brief The implementation of the reset of the timestamp shift, see @ref reset_timestamp_shift
+    ///
+    /// The default implementation does not support resynchronization and returns false.
+    /// @param shift Timestamp shift, only given when time shifting is enabled or when restarting the stream (see
+    /// @ref restart_stream)
+    /// @return true if the shift has been set, false otherwise
+    virtual bool reset_timestamp_shift_impl(const timestamp &shift);
+
+    /// @brief Returns true if the implementation applies the filter of the CD events while decoding, see
+    /// @ref cd_event_filter
+    ///
+    /// The default implementation returns false, the filter being then applied to the buffers of decoded events.
+    virtual bool is_cd_event_filter_supported_impl() const;
+
     const bool is_time_shifting_enabled_;
-    std::vector<RawData> incomplete_raw_data_;
+    bool is_event_order_preserved_{false};
+    // Beginning of a raw event at the end of the data given to the last call to decode, no raw event being larger
+    // than the range of @ref get_raw_event_size_bytes. It is aligned as heap memory is, the raw events completed in it
+    // being given to @ref decode_impl, whose implementations may read them as words
+    alignas(alignof(std::max_align_t)) std::array<RawData, std::numeric_limits<uint8_t>::max()> incomplete_raw_data_;
+    uint8_t incomplete_raw_data_size_{0};
+
+    Statistics statistics_counters_;
+    std::atomic<bool> statistics_enabled_{false};
+    mutable std::mutex statistics_mutex_;
+    Statistics published_statistics_;
 
-    std::map<size_t, TimeCallback_t> time_cbs_map_;
-    size_t next_cb_idx_{0};
+    CallbackList<TimeCallback_t> time_cbs_;
+    std::atomic<size_t> next_cb_idx_{0};
 
     std::shared_ptr<I_EventDecoder<EventCD>> cd_event_decoder_;
     std::unique_ptr<DecodedEventForwarder<EventCD>> cd_event_forwarder_;
+    std::unique_ptr<DecodingFilter> cd_event_filter_;
 
     std::shared_ptr<I_EventDecoder<EventExtTrigger>> ext_trigger_event_decoder_;
-    std::unique_ptr<DecodedEventForwarder<EventExtTrigger, 1>> trigger_event_forwarder_;
+    std::unique_ptr<DecodedEventForwarder<EventExtTrigger>> trigger_event_forwarder_;
 };
 
 } // namespace Metavision
@@ -12,10 +12,14 @@
 #ifndef METAVISION_HAL_I_EVENT_DECODER_H
 #define METAVISION_HAL_I_EVENT_DECODER_H
 
+#include <atomic>
 #include <functional>
-#include <map>
+#include <memory>
+#include <vector>
 
+#include "metavision/sdk/base/utils/callback_list.h"
 #include "metavision/sdk/base/utils/timestamp.h"
+#include "metavision/sdk/base/events/event_cd_buffer_soa.h"
 #include "metavision/hal/facilities/i_registrable_facility.h"
 
 namespace Metavision {
@@ -25,25 +29,55 @@ namespace Metavision {
 template<typename Event>
 class I_EventDecoder : public I_RegistrableFacility<I_EventDecoder<Event>> {
 public:
-    using EventIterator_t       = const Event *;
-    using EventBufferCallback_t = std::function<void(EventIterator_t begin, EventIterator_t end)>;
-    using Event_t               = Event;
+    using EventIterator_t          = const Event *;
+    using EventBufferCallback_t    = std::function<void(EventIterator_t begin, EventIterator_t end)>;
+    using Event_t                  = Event;
+    using EventVector_t            = std::vector<Event>;
+    using EventVectorCallback_t    = std::function<void(EventVector_t &&events)>;
+    using EventVectorAllocator_t   = std::function<EventVector_t()>;
+    using EventBufferSoA_t         = EventBufferSoA<Event>;
+    using EventSoABufferCallback_t = std::function<void(const EventBufferSoA_t &buffer)>;
 
     /// @brief Sets the functions to call to each batch of decoded events
     /// @param cb Callback to add
     /// @return ID of the added callback
-    /// @note This method is not thread safe. You should add/remove the various callback before starting the streaming
-    /// @note It's not allowed to add/remove a callback from the callback itself
+    /// @note Callbacks can be added or removed from any thread while events are being decoded, a batch being
+    /// dispatched to the callbacks registered when the dispatch started
     size_t add_event_buffer_callback(const EventBufferCallback_t &cb);
 
+    /// @brief Adds a function to call to each batch of decoded events, stored as a structure of arrays
+    ///
+    /// The batches are transposed right after being decoded, while they are still in cache, so that vectorized
+    /// consumers don't have to convert them from arrays of events.
+    /// @note Only available for the events with a structure of arrays layout, see @ref EventCDBufferSoA
+    /// @param cb Callback to add
+    /// @return ID of the added callback
+    /// @note Callbacks can be added or removed from any thread while events are being decoded
+    size_t add_event_soa_buffer_callback(const EventSoABufferCallback_t &cb);
+
     /// @brief Removes a previously registered callback
     /// @param callback_id Callback ID
     /// @return true if the callback has been unregistered correctly, false otherwise.
-    /// @sa @ref add_event_buffer_callback
+    /// @sa @ref add_event_buffer_callback, @ref add_event_soa_buffer_callback
     bool remove_callback(size_t callback_id);
 
+    /// @brief Sets the function that takes the ownership of the buffers of decoded events
+    ///
+    /// When set, the decoder writes the events directly into vectors that are then moved to this callback, after the
+    /// callbacks added with @ref add_event_buffer_callback have been called. This avoids copying the events for
+    /// consumers that keep them.
+    /// @param cb Callback taking the ownership of the buffers, or an empty function to unset it
+    /// @param allocator Optional function providing the vectors to decode the events into, e.g. from a pool. If not
+    /// set, new vectors are allocated
+    /// @note This method is not thread safe. You should set the callback before starting the streaming
+    void set_event_vector_callback(const EventVectorCallback_t &cb,
+                                   const EventVectorAllocator_t &allocator = EventVectorAllocator_t());
+
     /// @cond DEV
     void add_event_buffer(EventIterator_t begin, EventIterator_t end);
+    void add_event_vector(EventVector_t &&events);
+    bool has_event_vector_callback() const;
+    EventVector_t allocate_event_vector();
     /// @endcond
 
     /// @note This alias is deprecated since version 2.2.0 and will be removed in next releases
@@ -79,8 +113,19 @@ public:
     // clang-format on
 
 private:
-    std::map<size_t, EventBufferCallback_t> cbs_map_;
-    size_t next_cb_idx_{0};
+    using SoADispatch_t = void (*)(I_EventDecoder &decoder, EventIterator_t begin, EventIterator_t end);
+
+    // Transposes the events and calls the SoA callbacks, from the decoding thread
+    static void dispatch_soa(I_EventDecoder &decoder, EventIterator_t begin, EventIterator_t end);
+
+    CallbackList<EventBufferCallback_t> cbs_;
+    std::atomic<size_t> next_cb_idx_{0};
+    EventVectorCallback_t vector_cb_;
+    EventVectorAllocator_t vector_allocator_;
+    CallbackList<EventSoABufferCallback_t> soa_cbs_;
+    std::shared_ptr<EventBufferSoA_t> soa_buffer_;
+    // Only set when a SoA callback is added, so that this class can be used for events without SoA layout
+    std::atomic<SoADispatch_t> soa_dispatch_{nullptr};
 };
 
 } // namespace Metavision
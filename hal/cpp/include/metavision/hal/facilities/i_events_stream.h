@@ -12,19 +12,34 @@
 #ifndef METAVISION_HAL_I_EVENTS_STREAM_H
 #define METAVISION_HAL_I_EVENTS_STREAM_H
 
+#include <chrono>
+#include <atomic>
 #include <string>
 #include <fstream>
 #include <memory>
 #include <mutex>
 #include <condition_variable>
+#include <functional>
 #include <queue>
+#include <vector>
+
+#include "metavision/sdk/base/utils/mapped_file_writer.h"
+#include "metavision/sdk/base/utils/spsc_queue.h"
 
 #include "metavision/hal/facilities/i_registrable_facility.h"
+#include "metavision/hal/utils/async_raw_file_writer.h"
 #include "metavision/hal/utils/raw_file_header.h"
+#include "metavision/hal/utils/raw_file_index.h"
+#include "metavision/hal/utils/raw_flight_recorder.h"
+#include "metavision/hal/utils/rotating_raw_file_writer.h"
+#include "metavision/hal/utils/striped_raw_file_writer.h"
 #include "metavision/hal/utils/data_transfer.h"
+#include "metavision/hal/utils/shared_memory_ring.h"
 
 namespace Metavision {
 
+class AdaptiveReadSize;
+class I_Decoder;
 class I_HW_Identification;
 
 /// @brief Class for getting buffers from cameras or files.
@@ -32,6 +47,21 @@ class I_EventsStream : public I_RegistrableFacility<I_EventsStream> {
 public:
     using RawData = DataTransfer::Data;
 
+    /// @brief Configuration of the coalescing of the wakeups of the consumer, see @ref set_wakeup_coalescing
+    struct WakeupCoalescingConfig {
+        /// Number of bytes available from which the consumer is woken up. 0 disables the coalescing.
+        /// @warning The buffers available are held until delivered, this should be lower than the number of bytes the
+        ///          buffers of a bounded pool of the data transfer can hold, otherwise each wakeup waits for
+        ///          @ref max_latency
+        size_t min_bytes = 0;
+
+        /// Maximum time the data waits for the consumer to be woken up, from the arrival of the oldest buffer
+        std::chrono::microseconds max_latency{10000};
+
+        /// If true, the buffers available are merged by @ref get_latest_raw_data into one buffer, decoded in one call
+        bool merge_buffers = true;
+    };
+
     /// @brief Constructor
     /// @param data_transfer Data transfer class owned by the events stream and used to transfer data
     /// @param hw_identification Hardware identification associated to this events stream
@@ -47,6 +77,95 @@ public:
     /// @brief Stops streaming events
     void stop();
 
+    /// @brief Pauses the stream without stopping it
+    ///
+    /// The data transfer thread and its buffers are kept, so that resuming the stream is almost immediate. Data from
+    /// live sources is dropped while paused, while files are not read anymore until resumed. The buffers already
+    /// available when the stream is paused are still delivered.
+    /// @sa @ref DataTransfer::pause
+    void pause();
+
+    /// @brief Resumes the stream paused with @ref pause
+    void resume();
+
+    /// @brief Returns true if the stream is paused
+    bool is_paused() const;
+
+    /// @brief Enables the lock-free handoff of buffers between the data transfer thread and the consumer
+    ///
+    /// Instead of a mutex protected queue, buffers are passed through a bounded single producer / single consumer
+    /// ring. The data transfer thread never takes a lock unless the consumer is parked in @ref wait_next_buffer.
+    /// When the ring is full, the data transfer thread waits for the consumer to free some space.
+    /// @param capacity Number of buffers the ring can hold (rounded up to the next power of two). If 0, the
+    ///        default mutex protected queue is used
+    /// @param spin_count Number of times @ref wait_next_buffer polls the ring before parking the calling thread
+    /// @warning Must be called while the stream is stopped, otherwise an exception is thrown. In this mode,
+    ///          @ref poll_buffer, @ref wait_next_buffer and @ref get_latest_raw_data must all be called from one single
+    ///          thread
+    void set_lock_free_handoff(size_t capacity, uint32_t spin_count = 0);
+
+    /// @brief Delivers only one buffer in @p n to the consumer of the stream, all the buffers being still recorded
+    ///
+    /// The buffers are then logged (see @ref log_raw_data_async) and given to the flight recorder (see
+    /// @ref record_flight) by the data transfer thread as soon as they are transferred, instead of when
+    /// @ref get_latest_raw_data returns them. The consumer is only woken up for the buffers delivered, so that a
+    /// recording can run at full rate while only a fraction of the data is decoded, e.g. for a live preview. As the
+    /// buffers delivered do not follow each other, the decoding of each of them should resume from a resync point (see
+    /// @ref I_Decoder::find_resync_point).
+    /// @param n One buffer in @p n is delivered. 1 delivers all the buffers (default), 0 delivers none, the stream
+    ///        being then only recorded
+    /// @warning Must be called while the stream is stopped, otherwise an exception is thrown. When subsampling, a log
+    ///          started with @ref log_raw_data is written by the data transfer thread, which may make a live source
+    ///          drop data if the disk is slow: prefer @ref log_raw_data_async
+    void set_delivery_subsampling(uint32_t n);
+
+    /// @brief Gets the subsampling of the buffers delivered to the consumer of the stream
+    /// @return One buffer in this number is delivered, see @ref set_delivery_subsampling
+    uint32_t get_delivery_subsampling() const;
+
+    /// @brief Wakes up the consumer of the stream only when enough data is available, or the data has waited long
+    /// enough
+    ///
+    /// A live source with a low event rate transfers many tiny buffers, each of them waking up the consumer parked in
+    /// @ref wait_next_buffer to decode it. When coalescing, @ref wait_next_buffer only returns once
+    /// @ref WakeupCoalescingConfig::min_bytes bytes are available, or once the oldest buffer available has waited for
+    /// @ref WakeupCoalescingConfig::max_latency, and @ref poll_buffer only reports data available in these cases. The
+    /// consumer is then woken up at most twice per batch of buffers: when the first one arrives, to wait for its
+    /// deadline, and when the batch is complete. The buffers of the batch are then merged by
+    /// @ref get_latest_raw_data, unless @ref WakeupCoalescingConfig::merge_buffers is false, so that they are decoded
+    /// in one call. When the stream stops, the buffers available are delivered right away.
+    /// @param config Configuration of the coalescing, disabled by default
+    /// @warning Must be called while the stream is stopped, otherwise an exception is thrown. The coalescing is not
+    ///          available with the lock-free handoff (see @ref set_lock_free_handoff), nor does it delay the handlers
+    ///          given to @ref async_wait_next_buffer, which are called as soon as a buffer is available
+    void set_wakeup_coalescing(const WakeupCoalescingConfig &config);
+
+    /// @brief Gets the configuration of the coalescing of the wakeups of the consumer
+    /// @return The configuration, see @ref set_wakeup_coalescing
+    WakeupCoalescingConfig get_wakeup_coalescing() const;
+
+    /// @brief Lets the pool of buffers of the data transfer grow when the consumer of the stream is late
+    ///
+    /// See @ref DataTransfer::set_elastic_buffering. Buffers are then allocated, up to a memory ceiling, instead of
+    /// stalling the data transfer thread, which may make a live source drop data.
+    /// @param config Configuration of the elastic buffering
+    void set_elastic_buffering(const DataTransfer::ElasticBufferingConfig &config);
+
+    /// @brief Gets the statistics of the buffers used by the data transfer
+    /// @return The statistics, see @ref DataTransfer::get_buffering_statistics
+    DataTransfer::BufferingStatistics get_buffering_statistics() const;
+
+    /// @brief Gets the number of buffers transferred and not retrieved yet with @ref get_latest_raw_data
+    /// @return The number of buffers waiting to be decoded
+    /// @note This method can be called from any thread
+    size_t get_backlog();
+
+    /// @brief Sets the threading policy of the thread transferring the data of the stream
+    ///
+    /// The policy is applied the next time the stream is started.
+    /// @param policy The threading policy
+    void set_thread_policy(const ThreadPolicy &policy);
+
     /// @brief Returns a value that informs if some events are available in the buffer from the camera or the file
     /// @return Value that informs if some events are available in the buffer
     ///         -  1 if there are events available
@@ -61,6 +180,20 @@ public:
     ///         - -1 if an error occurred or no more events will ever be available (like when reaching end of file)
     short wait_next_buffer();
 
+    /// @brief Handler called once the next buffer is available or the stream is stopped, with the value that
+    /// @ref wait_next_buffer would have returned
+    using NextBufferHandler = std::function<void(short)>;
+
+    /// @brief Waits asynchronously for the next buffer, without blocking the calling thread
+    ///
+    /// If a buffer is already available or the stream is stopped, the handler is called right away by the calling
+    /// thread. Otherwise, it is called by the data transfer thread as soon as a buffer arrives or the stream stops, and
+    /// must therefore return quickly, typically by posting the work to an executor or resuming a coroutine. This
+    /// allows a single thread to serve many streams without dedicating a blocking thread to each of them.
+    /// @param handler Handler to call, at most one handler being pending at a time
+    /// @throw HalException if a handler is already pending
+    void async_wait_next_buffer(NextBufferHandler handler);
+
     /// @brief Gets latest raw data from the event buffer
     ///
     /// Gets raw data from the event buffer received since the last time this function was called.
@@ -69,6 +202,15 @@ public:
     /// @note This function must be called to write the buffer of events in the log file defined in @ref log_raw_data
     RawData *get_latest_raw_data(long &n_rawbytes);
 
+    /// @brief Gets the time at which the data returned by the last call to @ref get_latest_raw_data arrived on the host
+    ///
+    /// The arrival time is stamped by the @ref DataTransfer when it receives the data, so that the latency of the
+    /// processing of the data can be measured from their arrival, including the time spent waiting in the queue of
+    /// buffers.
+    /// @return The arrival time of the latest raw data, or a default constructed time point if no data has been
+    /// returned
+    std::chrono::steady_clock::time_point get_latest_raw_data_arrival_time() const;
+
     /// @brief Enables the logging of the stream of events in the input file @a f
     ///
     /// This methods first writes the header retrieved through @ref I_HW_Identification.
@@ -80,33 +222,238 @@ public:
     /// @warning The writing of each buffer of event will have to be triggered by calls to @ref get_latest_raw_data
     bool log_raw_data(const std::string &f);
 
+    /// @brief Enables the logging of the stream of events in the input file @a f from a dedicated thread
+    ///
+    /// Same as @ref log_raw_data, except that @ref get_latest_raw_data only queues the buffers, which are then written
+    /// by an @ref AsyncRawFileWriter. A slow disk thus no longer slows down the thread consuming the events.
+    /// The data can be compressed by the writing thread (see @ref AsyncRawFileWriterConfig::compression_), in which
+    /// case the compression is recorded in the header of the file and it is decompressed transparently when opened
+    /// (see @ref DeviceDiscovery::open_raw_file).
+    /// @param f The file to log into
+    /// @param config Configuration of the writer
+    /// @return true if the file could be opened for writing, false otherwise or if the file name @a f is the same as
+    /// the one read from
+    /// @warning The buffers logged are referenced until the writing thread handles them, which holds memory from the
+    /// data transfer buffers pool. Use @ref get_log_raw_data_bytes_behind to monitor it.
+    bool log_raw_data_async(const std::string &f,
+                            const AsyncRawFileWriterConfig &config = AsyncRawFileWriterConfig());
+
+    /// @brief Enables the logging of the stream of events in a sequence of files, a new file being started according
+    /// to the size or duration of the current one, or when @ref rotate_log_raw_data is called
+    ///
+    /// Same as @ref log_raw_data_async, except that the buffers are given to a @ref RotatingRawFileWriter. The next
+    /// file is opened and its header written in advance, so that switching to it never stalls
+    /// @ref get_latest_raw_data, and each buffer is written to exactly one of the files.
+    /// @param config Configuration of the files and of the rotation policy
+    /// @return true if the first file could be opened for writing, false otherwise or if it is the file read from
+    bool log_raw_data_rotating(const RawFileRotationConfig &config);
+
+    /// @brief Starts a new file with the next buffer, when logging with @ref log_raw_data_rotating
+    /// @return false if not logging with @ref log_raw_data_rotating
+    bool rotate_log_raw_data();
+
+    /// @brief Gets the paths of the files written so far when logging with @ref log_raw_data_rotating
+    /// @return The paths of the files, the current one last, or an empty vector if not logging with
+    /// @ref log_raw_data_rotating
+    std::vector<std::string> get_log_raw_data_files();
+
+    /// @brief Enables the logging of the stream of events striped across several files, typically on different disks
+    ///
+    /// Same as @ref log_raw_data_async, except that the buffers are given to a @ref StripedRawFileWriter, which writes
+    /// each stripe file from its own thread. The recording is read back as a single stream by opening its manifest
+    /// (see @ref DeviceDiscovery::open_raw_file).
+    /// @param manifest_path Path of the manifest of the recording, the stripe files being named after it
+    /// @param config Configuration of the stripes
+    /// @return true if the manifest and the stripe files could be opened for writing, false otherwise or if the
+    /// manifest is the file read from
+    bool log_raw_data_striped(const std::string &manifest_path, const StripedRawFileWriterConfig &config);
+
+    /// @brief Enables the logging of the stream of events in the input file @a f, preallocated and written through a
+    /// memory mapping
+    ///
+    /// Same as @ref log_raw_data, except that the buffers are given to a @ref MappedFileWriter: the space of the file
+    /// is allocated when it is opened, and @ref get_latest_raw_data copies each buffer straight into the mapping,
+    /// without system call nor buffering layer. This suits recordings of known maximum duration, the capacity of the
+    /// file being then the maximum duration times the maximum data rate. The data beyond the capacity is dropped, see
+    /// @ref get_log_raw_data_dropped_bytes.
+    /// @param f The file to log into
+    /// @param config Configuration of the writer, whose capacity must hold the header of the file
+    /// @return true if the file could be created, preallocated and mapped, false otherwise or if the file name @a f is
+    /// the same as the one read from
+    bool log_raw_data_mapped(const std::string &f, const MappedFileWriterConfig &config);
+
+    /// @brief Gets the number of bytes dropped when logging with @ref log_raw_data_mapped, because the capacity of
+    /// the file was reached
+    /// @return The number of bytes dropped, 0 if not logging with @ref log_raw_data_mapped
+    uint64_t get_log_raw_data_dropped_bytes();
+
+    /// @brief Gets the number of buffers waiting to be written when logging with @ref log_raw_data_async,
+    /// @ref log_raw_data_rotating or @ref log_raw_data_striped
+    /// @return The number of buffers waiting to be written, 0 if not logging asynchronously
+    size_t get_log_raw_data_queue_depth();
+
+    /// @brief Gets the number of bytes waiting to be written when logging with @ref log_raw_data_async,
+    /// @ref log_raw_data_rotating or @ref log_raw_data_striped
+    /// @return The number of bytes waiting to be written, 0 if not logging asynchronously
+    size_t get_log_raw_data_bytes_behind();
+
     /// @brief Stops logging RAW data
     ///
     /// Does nothing if no recording has been started
     void stop_log_raw_data();
 
+    /// @brief Keeps the last seconds of RAW data of the stream in memory, to write them to a file around triggers
+    ///
+    /// The buffers returned by @ref get_latest_raw_data are given to a @ref RawFlightRecorder, which writes them to
+    /// files with the header retrieved through @ref I_HW_Identification when a dump is triggered. Continuous recording
+    /// is hence not needed to capture the data around interesting moments.
+    /// @param config Configuration of the recorder
+    /// @return The recorder, which can be triggered by the caller or fed with the decoded events to trigger itself
+    /// @warning The buffers held by the recorder come from the data transfer pool, which must be able to provide
+    /// enough buffers meanwhile, see @ref set_elastic_buffering
+    std::shared_ptr<RawFlightRecorder> record_flight(const RawFlightRecorderConfig &config = RawFlightRecorderConfig());
+
+    /// @brief Stops keeping the RAW data in memory, the dump in progress if any being completed with the data already
+    /// received
+    ///
+    /// Does nothing if no flight recorder has been started
+    void stop_record_flight();
+
+    /// @brief Publishes the RAW data of the stream to other processes, through a ring of buffers in shared memory
+    ///
+    /// The header retrieved through @ref I_HW_Identification is published with the data, so that the other processes
+    /// can read it as a device (see @ref DeviceDiscovery::open_shared_memory). The buffers are published as soon as
+    /// they are transferred, independently of the calls to @ref get_latest_raw_data. The data is copied once in the
+    /// ring, whatever the number of readers, and a reader too slow to release its slots loses data instead of slowing
+    /// down the stream (see @ref SharedMemoryRing::get_n_dropped_buffers).
+    /// @param name Name of the ring, which must be a valid file name
+    /// @param config Configuration of the ring
+    /// @return The ring the data is published in
+    /// @throw HalException if the ring could not be created
+    std::shared_ptr<SharedMemoryRing> publish_raw_data(const std::string &name,
+                                                       const SharedMemoryRingConfig &config = SharedMemoryRingConfig());
+
+    /// @brief Stops publishing RAW data, closing the ring for its readers
+    ///
+    /// Does nothing if no publication has been started
+    void stop_publish_raw_data();
+
+    /// @brief Sets the index of the RAW file read, used by @ref seek
+    /// @param index The index of the file
+    /// @note This function is directly called when opening a RAW file that has an index, see
+    /// @ref RawFileConfig::build_index_
+    void set_raw_file_index(const std::shared_ptr<const RawFileIndex> &index);
+
+    /// @brief Gets the index of the RAW file read
+    /// @return The index of the file, or nullptr if the file has no index or the data is not read from a file
+    std::shared_ptr<const RawFileIndex> get_raw_file_index() const;
+
+    /// @brief Moves the reading of a RAW file to get all the events from a timestamp, without decoding what precedes
+    ///
+    /// The reading resumes at the last entry of the index of the file preceding the timestamp (see
+    /// @ref RawFileIndex::find), and the decoder is reset to decode from there. At most one period of the index of
+    /// events preceding the timestamp are hence still decoded. The data not yet returned by @ref get_latest_raw_data is
+    /// dropped. If the stream is started, it keeps streaming from the new position.
+    /// @param t Timestamp to reach, in the time reference of the events decoded by @p decoder
+    /// @param decoder Decoder of the data of the stream
+    /// @return true if the reading has been moved, false if the file has no index or the decoder does not support
+    /// resynchronization
+    /// @warning Must be called from the thread calling @ref get_latest_raw_data and decoding the data
+    bool seek(timestamp t, I_Decoder &decoder);
+
+    /// @brief Adapts the size of the reads of a RAW file to the rate of its events, using the timestamps decoded by
+    /// @p decoder
+    ///
+    /// The data returned by @ref get_latest_raw_data and the timestamp @p decoder reaches after decoding it give the
+    /// rate of the events, from which the size of the next reads is computed (see @ref AdaptiveReadSize).
+    /// @param decoder Decoder of the data of the stream
+    /// @return true if the size of the reads is adapted, false if the data is not read from a file or the file was not
+    /// opened with @ref RawFileConfig::n_us_to_read_
+    /// @note This function is directly called when opening a RAW file with @ref RawFileConfig::n_us_to_read_ set
+    bool adapt_read_size(I_Decoder &decoder);
+
+    /// @brief Keeps the timestamps decoded by @p decoder increasing when a RAW file read in a loop goes back to its
+    /// beginning
+    ///
+    /// When @ref get_latest_raw_data returns the first data of the file after a loop, the decoder is reset to decode
+    /// it with timestamps following the last one decoded (see @ref I_Decoder::restart_stream), so that the replay goes
+    /// on seamlessly.
+    /// @param decoder Decoder of the data of the stream, it must outlive the stream
+    /// @return true if the decoder follows the loops, false if the data is not read from a file or the file was not
+    /// opened with @ref RawFileConfig::loop_
+    /// @note This function is directly called when opening a RAW file with @ref RawFileConfig::loop_ set
+    /// @warning The whole data returned by @ref get_latest_raw_data must be decoded by @p decoder before the next call
+    bool follow_loops(I_Decoder &decoder);
+
     /// @brief Sets name of the file read to avoid writing in the same file when calling log_raw_data
     /// @param filename Name of the file from which the events are read
     /// @note This function is directly called when opening a RAW file
     void set_underlying_filename(const std::string &filename);
 
 private:
+    // Takes the handler registered by async_wait_next_buffer, new_buffer_safety_ being locked
+    NextBufferHandler take_pending_handler();
+
+    // Gives a buffer to the log and the flight recorder, if any
+    void record_raw_data(const DataTransfer::BufferSlice &buffer);
+
+    // Returns true if the buffers available must be delivered to the consumer, new_buffer_safety_ being locked
+    bool is_delivery_due(const std::chrono::steady_clock::time_point &now) const;
+
     std::shared_ptr<I_HW_Identification> hw_identification_;
 
     // Name of the file read if one
     std::string underlying_filename_;
+    std::shared_ptr<const RawFileIndex> raw_file_index_;
+
+    // Set when the size of the reads is adapted to the rate of the events, see adapt_read_size
+    std::shared_ptr<AdaptiveReadSize> adaptive_read_size_;
+
+    // Set when the decoder is reset each time a RAW file read in a loop goes back to its beginning, see follow_loops
+    I_Decoder *loop_decoder_{nullptr};
 
     std::unique_ptr<std::ofstream> log_raw_data_;
+    std::unique_ptr<AsyncRawFileWriter> async_log_raw_data_;
+    std::unique_ptr<RotatingRawFileWriter> rotating_log_raw_data_;
+    std::unique_ptr<StripedRawFileWriter> striped_log_raw_data_;
+    std::unique_ptr<MappedFileWriter> mapped_log_raw_data_;
     std::mutex log_raw_safety_;
+    std::shared_ptr<RawFlightRecorder> flight_recorder_;
+
+    std::shared_ptr<SharedMemoryRing> raw_data_publisher_;
+    std::mutex publish_safety_;
 
     std::unique_ptr<DataTransfer> data_transfer_;
     std::mutex new_buffer_safety_;
     std::condition_variable new_buffer_cond_;
-    std::queue<DataTransfer::BufferPtr> available_buffers_;
-    DataTransfer::BufferPtr returned_buffer_;
+    std::queue<DataTransfer::BufferSlice> available_buffers_;
+    DataTransfer::BufferSlice returned_buffer_;
+
+    // Coalescing of the wakeups of the consumer, see set_wakeup_coalescing. The buffers to merge are taken from the
+    // queue under the lock, and copied in a buffer of the pool outside of it
+    WakeupCoalescingConfig coalescing_;
+    size_t available_bytes_ = 0;
+    std::vector<DataTransfer::BufferSlice> buffers_to_merge_;
+    DataTransfer::BufferPool merge_pool_;
+
+    // Lock-free handoff mode, see set_lock_free_handoff
+    std::unique_ptr<SPSCQueue<DataTransfer::BufferSlice>> ring_;
+    uint32_t spin_count_ = 0;
+    std::atomic<bool> consumer_waiting_{false};
+
+    // Subsampling of the buffers delivered, see set_delivery_subsampling. The counters are only used by the data
+    // transfer thread
+    std::atomic<uint32_t> delivery_subsampling_{1};
+    uint64_t n_transferred_buffers_ = 0;
+    bool skipped_discontinuity_     = false;
+
+    // Handler registered by async_wait_next_buffer, protected by new_buffer_safety_
+    NextBufferHandler pending_handler_;
+    std::atomic<bool> handler_pending_{false};
 
     std::mutex start_stop_safety_;
-    bool stop_;
+    bool started_ = false;
+    std::atomic<bool> stop_;
 };
 
 } // namespace Metavision
@@ -14,6 +14,10 @@
 
 #include <string>
 #include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "metavision/hal/facilities/i_registrable_facility.h"
 
@@ -53,6 +57,57 @@ public:
     /// @param bitfield Bit field of the register to read
     /// @return Value read
     virtual uint32_t read_register(const std::string &address, const std::string &bitfield) = 0;
+
+    /// @brief Writes several registers, in order
+    ///
+    /// The default implementation writes the registers one by one. Facilities accessing the device through a
+    /// transport with a significant latency should override it to coalesce the writes in a single transaction.
+    /// @param writes Addresses of the registers to write and values to write
+    virtual void write_registers(const std::vector<std::pair<uint32_t, uint32_t>> &writes);
+
+    /// @brief Reads several registers
+    ///
+    /// The default implementation reads the registers one by one.
+    /// @param addresses Addresses of the registers to read
+    /// @return Values read, in the order of @p addresses
+    virtual std::vector<uint32_t> read_registers(const std::vector<uint32_t> &addresses);
+
+    /// @brief Writes several bit fields of a register, read-modify-write
+    ///
+    /// The default implementation writes the bit fields one by one. Facilities knowing the layout of the register
+    /// should override it to read the register once, update all the bit fields and write it once.
+    /// @param address Address of the register to write
+    /// @param bitfields Bit fields of the register to write and values to write
+    virtual void write_register_bitfields(const std::string &address,
+                                          const std::vector<std::pair<std::string, uint32_t>> &bitfields);
+
+    /// @brief Writes several registers given by name, in order
+    ///
+    /// The names are translated into addresses with @ref get_register_address, so that the registers are written
+    /// with @ref write_registers when all the addresses are known, and one by one by name otherwise.
+    /// @param writes Names of the registers to write and values to write
+    void write_registers_by_name(const std::vector<std::pair<std::string, uint32_t>> &writes);
+
+    /// @brief Gets the address of a register from its name
+    ///
+    /// The addresses found by @ref lookup_register_address are cached, so that a name is looked up only once.
+    /// @param name Name of the register
+    /// @param address Address of the register, if it is known
+    /// @return true if the address of the register is known
+    bool get_register_address(const std::string &name, uint32_t &address);
+
+protected:
+    /// @brief Looks up the address of a register from its name
+    ///
+    /// The default implementation knows no address, the registers being then accessed by name.
+    /// @param name Name of the register
+    /// @param address Address of the register, if it is known
+    /// @return true if the address of the register is known
+    virtual bool lookup_register_address(const std::string &name, uint32_t &address);
+
+private:
+    std::mutex address_cache_mutex_;
+    std::unordered_map<std::string, uint32_t> address_cache_;
 };
 
 } // namespace Metavision
@@ -36,6 +36,14 @@ public:
     /// @brief Gets all biases values
     /// @return A map containing the biases values
     virtual std::map<std::string, int> get_all_biases() = 0;
+
+    /// @brief Sets several biases values
+    ///
+    /// The default implementation sets the biases one by one. Facilities accessing the device through a transport
+    /// with a significant latency should override it to program all the biases in a single transaction.
+    /// @param biases Names of the biases to set and values to set them to
+    /// @return true if all the biases were set
+    virtual bool set_biases(const std::map<std::string, int> &biases);
 };
 
 } // namespace Metavision
@@ -15,6 +15,7 @@
 #include <memory>
 
 #include "metavision/hal/facilities/i_facility.h"
+#include "metavision/hal/facilities/detail/facility_index.h"
 
 namespace Metavision {
 
@@ -27,6 +28,14 @@ struct I_RegistrableFacility : public I_Facility, public std::enable_shared_from
     static const std::type_info &class_registration_info() {
         return typeid(SelfType);
     }
+
+    /// @brief Gets the index of the facility type, see @ref get_facility_index
+    ///
+    /// The index is looked up once per facility type.
+    static size_t class_registration_index() {
+        static const size_t index = get_facility_index(class_registration_info());
+        return index;
+    }
 };
 
 } // namespace Metavision
@@ -14,6 +14,7 @@
 
 #include <cstdint>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "metavision/hal/utils/device_roi.h"
@@ -83,6 +84,67 @@ public:
     /// @param vroi Vector of ROI to transform to bitword register format
     /// @return The ROIs in bitword register format
     virtual std::vector<uint32_t> create_ROIs(const std::vector<DeviceRoi> &vroi) = 0;
+
+    /// @brief Statistics of the updates of the ROIs
+    ///
+    /// The durations are the ones of the updates done with @ref update_ROIs, from the geometry of the ROIs to the
+    /// programmed sensor.
+    struct UpdateStatistics {
+        /// Number of updates
+        uint64_t num_updates = 0;
+
+        /// Number of words of the bitword programmed by the updates
+        uint64_t num_words_written = 0;
+
+        /// Duration of the last update (in us)
+        uint64_t last_duration_us = 0;
+
+        /// Maximum duration of an update (in us)
+        uint64_t max_duration_us = 0;
+
+        /// Sum of the durations of the updates (in us)
+        uint64_t total_duration_us = 0;
+    };
+
+    /// @brief Updates the ROIs, programming only the words of their bitword that changed
+    ///
+    /// The bitword is compared to the last one programmed with @ref set_ROI, @ref set_ROIs(const
+    /// std::vector<DeviceRoi> &, bool), @ref set_ROIs_from_file or an update, so that steering the ROIs at a high rate
+    /// only sends the few words that changed. The first update, or the first one after @ref invalidate_ROIs_update,
+    /// programs the whole bitword. The ROI is enabled by the update.
+    /// @param vroi A vector of ROIs
+    /// @return The number of words programmed
+    size_t update_ROIs(const std::vector<DeviceRoi> &vroi);
+
+    /// @brief Updates the ROIs from bitword (register format), programming only the words that changed
+    /// @param vroiparams ROI to set
+    /// @return The number of words programmed
+    /// @sa update_ROIs
+    size_t update_ROIs_from_bitword(const std::vector<uint32_t> &vroiparams);
+
+    /// @brief Forgets the bitword last programmed, so that the next update programs the whole bitword
+    ///
+    /// This must be called when the ROIs are programmed without going through this class, for instance with
+    /// @ref set_ROIs(const std::vector<bool> &, const std::vector<bool> &, bool) or by writing the registers.
+    void invalidate_ROIs_update();
+
+    /// @brief Gets the statistics of the updates of the ROIs
+    /// @return The statistics of the updates
+    const UpdateStatistics &get_update_statistics() const;
+
+protected:
+    /// @brief Programs the words of the bitword that changed and enables the ROI
+    ///
+    /// The default implementation programs the whole bitword with @ref set_ROIs_from_bitword. Facilities able to
+    /// write the words of the bitword separately should override it to write only the changed words.
+    /// @param changed_words Indexes and values of the words that changed, in increasing order of index
+    /// @param vroiparams The whole bitword
+    virtual void set_ROIs_words(const std::vector<std::pair<size_t, uint32_t>> &changed_words,
+                                const std::vector<uint32_t> &vroiparams);
+
+private:
+    std::vector<uint32_t> programmed_vroiparams_;
+    UpdateStatistics update_statistics_;
 };
 
 } // namespace Metavision
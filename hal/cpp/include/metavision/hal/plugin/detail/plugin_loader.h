@@ -9,6 +9,8 @@
  * See the License for the specific language governing permissions and limitations under the License.                 *
  **********************************************************************************************************************/
 
+#include <functional>
+#include <memory>
 #include <vector>
 #include <string>
 
@@ -18,8 +20,29 @@
 namespace Metavision {
 
 class Plugin;
+
+/// @brief Loads the plugins found in a list of folders
+///
+/// What is known of a plugin without loading its library (see @ref PluginDescription) is cached in a manifest, and
+/// the libraries of the plugins described by the manifest are only loaded when they are first accessed through a
+/// @ref PluginList. The entries of the manifest are invalidated when the size or modification time of their library
+/// change.
 class PluginLoader {
 public:
+    /// @brief Description of a plugin, known without loading its library once it is in the manifest
+    struct PluginDescription {
+        std::string name;
+        std::string integrator_name;
+        size_t camera_discovery_count = 0;
+        size_t file_discovery_count   = 0;
+    };
+
+    /// @brief Function telling whether a plugin is to be listed
+    using PluginFilter = std::function<bool(const PluginDescription &)>;
+
+    /// @brief Entry point of a plugin linked in the application, with the signature of @ref initialize_plugin
+    using StaticPluginEntry = void (*)(void *plugin_ptr);
+
     PluginLoader();
     ~PluginLoader();
 
@@ -27,26 +50,49 @@ public:
     void insert_folder(const std::string &folder);
     void insert_folders(const std::vector<std::string> &folders);
 
+    /// @brief Sets the path of the manifest read and updated by @ref load_plugins, an empty path disabling it
+    void set_manifest_path(const std::string &path);
+
+    /// @brief Finds the plugins in the folders, loading only the libraries not described by the manifest
     void load_plugins();
 
+    /// @brief Inserts a plugin linked in the application, initialized by calling its entry point instead of loading a
+    /// library
+    ///
+    /// The static plugins are not described by the manifest, and are kept when the folders are cleared. A plugin with
+    /// the name of a static plugin already inserted is ignored.
+    void insert_static_plugin(const std::string &name, StaticPluginEntry entry);
+
     class PluginList;
     PluginList get_plugin_list();
 
+    /// @brief Gets the list of the plugins accepted by a filter, without loading the others
+    PluginList get_plugin_list(const PluginFilter &filter);
+
+    /// @brief Gets the descriptions of the plugins, without loading them
+    std::vector<PluginDescription> get_plugin_descriptions() const;
+
 private:
     struct PluginInfo;
     struct Library;
+    struct ManifestEntry;
 
     void insert_plugin(const std::string &name, const std::string &library_path);
     void insert_plugin(const PluginInfo &info);
+    void read_manifest();
+    void write_manifest() const;
 
     std::vector<std::string> folders_;
     std::vector<std::unique_ptr<Library>> libraries_;
+    std::string manifest_path_;
+    std::vector<ManifestEntry> manifest_;
+    bool manifest_changed_ = false;
 
     static std::unique_ptr<Plugin> make_plugin(const std::string &plugin_name);
 
 public:
     class PluginList {
-        using container = typename std::vector<std::unique_ptr<Library>>;
+        using container = typename std::vector<Library *>;
 
     public:
         class iterator {
@@ -68,14 +114,14 @@ public:
             typename container::iterator it_;
         };
 
-        PluginList(std::vector<std::unique_ptr<Library>> &);
+        PluginList(container &&libraries);
         iterator begin();
         iterator end();
         size_t size() const;
         bool empty() const;
 
     private:
-        container &libraries_;
+        container libraries_;
     };
 }; // namespace Metavision
 
@@ -0,0 +1,67 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_STATIC_PLUGIN_H
+#define METAVISION_HAL_STATIC_PLUGIN_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Metavision {
+
+/// @brief Entry point of a plugin linked in the application, with the signature of @ref initialize_plugin
+using StaticPluginEntry = void (*)(void *plugin_ptr);
+
+/// @brief Registers a plugin linked statically in the application
+///
+/// The plugin is listed by @ref DeviceDiscovery along with the ones loaded from the plugin folders, its entry point
+/// being called instead of loading a library. As an entry point can not be named initialize_plugin when several
+/// plugins are linked in the same application, each static plugin provides its own.
+///
+/// Linking a plugin in the application saves loading its library when discovering the devices, and lets link time
+/// optimization work across the HAL headers and the plugin (e.g. to inline the decoders in the data path).
+/// @param name Name of the plugin, as the name of its library would give it
+/// @param entry Function initializing the plugin (see @ref plugin_cast)
+/// @note A plugin registered with the name of another static plugin is ignored
+void register_static_plugin(const std::string &name, StaticPluginEntry entry);
+
+/// @brief Gets the plugins registered with @ref register_static_plugin, in their order of registration
+std::vector<std::pair<std::string, StaticPluginEntry>> get_static_plugins();
+
+/// @brief Enables or disables the loading of the plugins from the plugin folders (i.e. MV_HAL_PLUGIN_PATH and the
+/// installation folder)
+///
+/// When disabled, only the static plugins are listed and no folder is scanned, which makes the first discovery of the
+/// devices faster on systems using a known plugin. This should be set before the first discovery: the plugins already
+/// loaded stay listed.
+/// @param enabled Whether the plugins are also loaded from the plugin folders, which is the default
+void set_dynamic_plugin_loading(bool enabled);
+
+/// @brief Tells whether the plugins are loaded from the plugin folders (see @ref set_dynamic_plugin_loading)
+bool is_dynamic_plugin_loading_enabled();
+
+} // namespace Metavision
+
+/// @brief Registers a plugin linked statically in the application when the program starts
+///
+/// To be used once in a source file of the plugin. This file must be linked in the application, which a linker drops
+/// when it is in a static library and nothing else refers to it: build the plugin as an object library, or link it
+/// with --whole-archive. Otherwise call @ref Metavision::register_static_plugin from the application.
+/// @param identifier Identifier of the plugin, unique in the application
+/// @param name Name of the plugin, as a string
+/// @param entry Function initializing the plugin
+#define METAVISION_HAL_REGISTER_STATIC_PLUGIN(identifier, name, entry)                                              \
+    namespace {                                                                                                     \
+    const bool metavision_hal_static_plugin_##identifier = (Metavision::register_static_plugin(name, entry), true); \
+    }
+
+#endif // METAVISION_HAL_STATIC_PLUGIN_H
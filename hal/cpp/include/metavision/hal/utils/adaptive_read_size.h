@@ -0,0 +1,74 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_ADAPTIVE_READ_SIZE_H
+#define METAVISION_HAL_ADAPTIVE_READ_SIZE_H
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+#include "metavision/sdk/base/utils/timestamp.h"
+
+namespace Metavision {
+
+/// @brief Adapts the size of the reads of a RAW file so that each read holds about the same duration of data
+///
+/// The rate of the data, in bytes per microsecond, is estimated from the size of the buffers handed to the decoder
+/// (@ref add_data) and from the timestamp the decoder has reached after decoding them (@ref add_time). The size of the
+/// next reads is then the duration targeted times this rate, within bounds.
+///
+/// @ref add_data and @ref add_time are called from the thread decoding the data, @ref get_read_size from the thread
+/// reading the file.
+class AdaptiveReadSize {
+public:
+    /// @brief Constructor
+    /// @param target_duration_us Duration of the data to read at each read, in us
+    /// @param raw_event_size_bytes Size of a RAW event in bytes, the read size being a multiple of it
+    /// @param min_read_size_bytes Minimal size of a read in bytes, which is also the size of the first reads
+    /// @param max_read_size_bytes Maximal size of a read in bytes
+    AdaptiveReadSize(uint32_t target_duration_us, uint32_t raw_event_size_bytes, uint32_t min_read_size_bytes,
+                     uint32_t max_read_size_bytes);
+
+    /// @brief Notifies that data is handed to the decoder
+    /// @param n_bytes Size of the data in bytes
+    void add_data(uint64_t n_bytes);
+
+    /// @brief Notifies the timestamp reached by the decoder, after decoding the data notified so far
+    /// @param t Timestamp reached
+    void add_time(timestamp t);
+
+    /// @brief Forgets the rate estimated so far, to be called when the data does not follow the previous one anymore
+    /// (e.g. after seeking in the file)
+    void reset();
+
+    /// @brief Gets the size of the next read in bytes
+    uint32_t get_read_size() const;
+
+    /// @brief Gets the duration of the data targeted by each read, in us
+    uint32_t get_target_duration_us() const;
+
+private:
+    const uint32_t target_duration_us_;
+    const uint32_t raw_event_size_bytes_;
+    const uint32_t min_read_size_bytes_;
+    const uint32_t max_read_size_bytes_;
+
+    std::mutex mutex_;
+    uint64_t pending_bytes_ = 0;   ///< Bytes handed to the decoder since the last timestamp
+    timestamp last_time_    = -1;  ///< Last timestamp notified, or -1 if none since the last reset
+    double bytes_per_us_    = -1.; ///< Estimated rate, or a negative value if not estimated yet
+    std::atomic<uint32_t> read_size_bytes_;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_HAL_ADAPTIVE_READ_SIZE_H
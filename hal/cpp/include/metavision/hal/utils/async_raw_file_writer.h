@@ -0,0 +1,145 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_ASYNC_RAW_FILE_WRITER_H
+#define METAVISION_HAL_ASYNC_RAW_FILE_WRITER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "metavision/hal/utils/compressed_raw_file.h"
+#include "metavision/hal/utils/data_transfer.h"
+#include "metavision/hal/utils/raw_file_checksums.h"
+#include "metavision/sdk/base/utils/thread_policy.h"
+
+namespace Metavision {
+
+/// @brief Configuration of an @ref AsyncRawFileWriter
+struct AsyncRawFileWriterConfig {
+    /// Size in bytes of the writes issued to the file (rounded up to a multiple of @ref AsyncRawFileWriter::Alignment)
+    size_t batch_size_ = 4 * 1024 * 1024;
+
+    /// Maximum time in milliseconds buffers may wait before being written, even if less than @ref batch_size_
+    /// bytes are pending
+    uint32_t flush_period_ms_ = 100;
+
+    /// Bypass the system page cache (O_DIRECT). Only available on Linux, ignored elsewhere or if the file system
+    /// does not support it
+    bool use_direct_io_ = false;
+
+    /// Threading policy of the writing thread
+    ThreadPolicy thread_policy_;
+
+    /// Compression of the data written after the header (see @ref RawCompression). The data is then written in
+    /// chunks that are compressed by the writing thread. A chunk is only written once it is full, regardless of
+    /// @ref flush_period_ms_
+    RawCompression compression_ = RawCompression::None;
+
+    /// Size in bytes of the uncompressed data of the chunks, when @ref compression_ is enabled. Larger chunks
+    /// compress better, smaller ones allow seeking and decompressing in parallel with a finer granularity
+    size_t compression_chunk_size_ = 1024 * 1024;
+
+    /// Size in bytes of the chunks of the file whose CRC32C is computed by the writing thread, and stored in a sidecar
+    /// file when the file is closed (see @ref RawFileChecksums). 0 disables the checksums
+    uint64_t checksum_chunk_size_ = 0;
+};
+
+/// @brief Writes RAW data to a file from a dedicated thread
+///
+/// Buffers given to @ref write are not copied: a reference on them is kept until the writing thread handles them, which
+/// makes @ref write cheap enough to be called from the decoding thread. The writing thread coalesces the buffers into
+/// large writes of @ref AsyncRawFileWriterConfig::batch_size_ bytes, aligned in memory and in the file on
+/// @ref Alignment bytes. When compression is enabled, the data is compressed by the writing thread before being
+/// coalesced.
+class AsyncRawFileWriter {
+public:
+    /// Alignment in bytes of the memory and file offsets of the writes
+    static constexpr size_t Alignment = 4096;
+
+    /// @brief Opens the file and starts the writing thread
+    /// @param filename Path of the file to write, truncated if it exists
+    /// @param header Bytes written at the beginning of the file (e.g. the RAW file header)
+    /// @param config Configuration of the writer
+    /// @throw HalException if the file could not be opened
+    AsyncRawFileWriter(const std::string &filename, const std::string &header,
+                       const AsyncRawFileWriterConfig &config = AsyncRawFileWriterConfig());
+
+    /// @brief Writes all the pending buffers, then closes the file, and saves its checksums if enabled
+    ~AsyncRawFileWriter();
+
+    /// @brief Queues a buffer for writing
+    /// @param slice Buffer to write, a reference on it is kept until it has been handled by the writing thread
+    void write(const DataTransfer::BufferSlice &slice);
+
+    /// @brief Gets the number of buffers queued and not processed yet by the writing thread
+    size_t get_queue_depth() const;
+
+    /// @brief Gets the number of bytes queued and not processed yet by the writing thread
+    ///
+    /// A steadily growing value means the file system can not keep up with the data rate
+    size_t get_bytes_behind() const;
+
+    /// @brief Gets the number of bytes written to the file so far, header included
+    uint64_t get_bytes_written() const;
+
+    /// @brief Returns true if a write to the file failed. Data given to @ref write afterwards is discarded
+    bool has_failed() const;
+
+private:
+    void run();
+    void append(const uint8_t *data, size_t size);
+    void append_to_chunk(const uint8_t *data, size_t size);
+    void write_chunk();
+    void flush_staging();
+    void write_staging(size_t size);
+    void close_file();
+
+    AsyncRawFileWriterConfig config_;
+    std::string filename_;
+    int fd_         = -1;
+    bool direct_io_ = false;
+
+    // Aligned buffer in which data is coalesced before being written
+    std::vector<uint8_t> staging_storage_;
+    uint8_t *staging_     = nullptr;
+    size_t staging_bytes_ = 0;
+
+    // Uncompressed data of the chunk being filled, and its compressed version, when compression is enabled
+    std::vector<uint8_t> chunk_;
+    std::vector<uint8_t> compressed_chunk_;
+
+    // Checksums of the data written, when enabled
+    std::unique_ptr<RawFileChecksums> checksums_;
+
+    std::mutex queue_mutex_;
+    std::condition_variable queue_cond_;
+    std::deque<DataTransfer::BufferSlice> queue_;
+    bool closing_ = false;
+
+    std::atomic<size_t> pending_slices_{0};
+    std::atomic<size_t> pending_bytes_{0};
+    std::atomic<uint64_t> bytes_written_{0};
+    std::atomic<bool> failed_{false};
+
+    std::thread writer_thread_;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_HAL_ASYNC_RAW_FILE_WRITER_H
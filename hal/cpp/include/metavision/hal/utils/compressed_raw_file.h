@@ -0,0 +1,76 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_COMPRESSED_RAW_FILE_H
+#define METAVISION_HAL_COMPRESSED_RAW_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Metavision {
+
+class RawFileHeader;
+
+/// @brief Compression of the data of a RAW file
+///
+/// A compressed RAW file starts with the usual RAW file header, in which the compression is recorded (see
+/// @ref set_raw_file_compression). The data that follows is split into independent chunks, each made of a
+/// @ref CompressedRawChunkHeader followed by the compressed bytes of the chunk. Since any chunk can be decompressed
+/// without the others, the chunks can be located by reading their headers only and decompressed in parallel.
+enum class RawCompression {
+    /// The data is stored as is
+    None,
+    /// The chunks are compressed in the LZ4 block format
+    LZ4
+};
+
+/// @brief Header preceding each chunk of a compressed RAW file
+struct CompressedRawChunkHeader {
+    /// Size in bytes of the chunk in the file, header excluded. If equal to @ref raw_size_, the chunk is stored
+    /// uncompressed
+    uint32_t compressed_size_;
+
+    /// Size in bytes of the data of the chunk once decompressed
+    uint32_t raw_size_;
+};
+
+/// @brief Records the compression of the data in the header of a RAW file
+/// @param header Header of the RAW file
+/// @param compression Compression of the data
+/// @param chunk_size Maximum size in bytes of the uncompressed data of a chunk
+void set_raw_file_compression(RawFileHeader &header, RawCompression compression, size_t chunk_size);
+
+/// @brief Gets the compression of the data recorded in the header of a RAW file
+/// @param header Header of the RAW file
+/// @return The compression of the data, @ref RawCompression::None if the data is not compressed
+RawCompression get_raw_file_compression(const RawFileHeader &header);
+
+/// @brief Compresses a chunk of data
+/// @param data Data to compress
+/// @param size Size in bytes of the data, must be less than 4 GB
+/// @param compression Compression to use
+/// @param output Vector receiving the chunk, header included, ready to be written to the file
+void compress_raw_chunk(const uint8_t *data, size_t size, RawCompression compression, std::vector<uint8_t> &output);
+
+/// @brief Decompresses a chunk of data
+/// @param header Header of the chunk
+/// @param data Data of the chunk, header excluded (@ref CompressedRawChunkHeader::compressed_size_ bytes)
+/// @param compression Compression of the chunk
+/// @param output Buffer receiving the @ref CompressedRawChunkHeader::raw_size_ bytes of decompressed data
+/// @return false if the data is corrupted
+bool decompress_raw_chunk(const CompressedRawChunkHeader &header, const uint8_t *data, RawCompression compression,
+                          uint8_t *output);
+
+} // namespace Metavision
+
+#endif // METAVISION_HAL_COMPRESSED_RAW_FILE_H
@@ -0,0 +1,58 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_COMPRESSED_RAW_FILE_STREAM_H
+#define METAVISION_HAL_COMPRESSED_RAW_FILE_STREAM_H
+
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <string>
+
+#include "metavision/hal/utils/compressed_raw_file.h"
+
+namespace Metavision {
+
+/// @brief Standard input stream reading a compressed RAW file as if it was not compressed
+///
+/// The stream gives the header of the file followed by the decompressed data, so that it can be read by any plugin
+/// (see @ref DeviceDiscovery::open_stream). The chunks of the file are decompressed ahead of the reading position by
+/// several threads. Seeking in the stream only decompresses the chunk containing the new position.
+class CompressedRawFileStream : public std::istream {
+public:
+    /// @brief Opens the compressed RAW file @p filename
+    /// @param filename Path to the file to read
+    /// @param n_threads Maximum number of chunks decompressed concurrently. If 0, the number of cores is used
+    /// @throw HalException if the file could not be opened or is not compressed
+    CompressedRawFileStream(const std::string &filename, uint32_t n_threads = 0);
+
+    /// @brief Destructor
+    ~CompressedRawFileStream();
+
+    /// @brief Returns true if the file @p filename is a compressed RAW file
+    /// @param filename Path to the file
+    static bool is_compressed(const std::string &filename);
+
+    /// @brief Returns the number of chunks of the file
+    size_t get_n_chunks() const;
+
+    /// @brief Returns the size in bytes of the stream, i.e. of the header and the decompressed data
+    uint64_t get_size() const;
+
+private:
+    class ChunkBuffer;
+
+    std::unique_ptr<ChunkBuffer> buffer_;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_HAL_COMPRESSED_RAW_FILE_STREAM_H
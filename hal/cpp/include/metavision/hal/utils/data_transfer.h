@@ -12,13 +12,20 @@
 #ifndef METAVISION_HAL_DATA_TRANSFER_H
 #define METAVISION_HAL_DATA_TRANSFER_H
 
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
 #include <thread>
 #include <vector>
 #include <unordered_map>
 #include <atomic>
 #include <functional>
+#include <memory>
 
+#include "metavision/hal/utils/raw_buffer_allocator.h"
+#include "metavision/sdk/base/utils/memory_placement.h"
 #include "metavision/sdk/base/utils/object_pool.h"
+#include "metavision/sdk/base/utils/thread_policy.h"
 
 namespace Metavision {
 
@@ -33,8 +40,14 @@ public:
     /// Alias for the type of the data transferred
     using Data = uint8_t;
 
+    /// Alignment in bytes of the data of the buffers
+    static constexpr size_t BufferAlignment = 64;
+
     /// Alias for the type of the internal buffer of data
-    using Buffer = std::vector<Data>;
+    ///
+    /// Its data is aligned on @ref BufferAlignment bytes, and is left uninitialized when it is resized, so that the
+    /// implementations can resize it before filling it without paying for zeroing it.
+    using Buffer = std::vector<Data, RawBufferAllocator<Data, BufferAlignment>>;
 
     /// Alias for the object handling the buffers pool
     using BufferPool = SharedObjectPool<Buffer>;
@@ -42,6 +55,107 @@ public:
     /// Alias for the ptr type returned by the buffer pool
     using BufferPtr = BufferPool::ptr_type;
 
+    /// @brief Contiguous chunk of transferred data
+    ///
+    /// A slice either refers to the content of a @ref Buffer taken from the pool, or to memory owned by the
+    /// implementation (e.g. a memory mapped file). In both cases, the data pointed to by the slice remains valid as
+    /// long as the slice (or one of its copies) is alive.
+    class BufferSlice {
+    public:
+        /// @brief Builds an empty slice
+        BufferSlice() = default;
+
+        /// @brief Builds a slice referring to the whole content of a buffer taken from the pool
+        ///
+        /// The arrival time of the slice is the time of its construction.
+        /// @param buffer The buffer to refer to. The buffer is returned to the pool when the last slice referring to it
+        /// is destroyed
+        BufferSlice(const BufferPtr &buffer);
+
+        /// @brief Builds a slice referring to memory owned by another object
+        ///
+        /// The arrival time of the slice is the time of its construction.
+        /// @param begin Pointer to the first byte of the slice
+        /// @param end Pointer after the last byte of the slice
+        /// @param owner Object owning the memory, kept alive as long as the slice is
+        BufferSlice(Data *begin, Data *end, const std::shared_ptr<const void> &owner);
+
+        /// @brief Builds a slice referring to memory owned by the implementation, released by a hook
+        ///
+        /// This lets an implementation transfer memory it does not allocate itself (e.g. a USB or DMA buffer) without
+        /// copying it, see @ref transfer_slice. The arrival time of the slice is the time of its construction.
+        /// @param begin Pointer to the first byte of the slice
+        /// @param end Pointer after the last byte of the slice
+        /// @param release Function called when the last slice referring to the memory is destroyed, from the thread
+        /// destroying it, to give the memory back to its owner
+        /// @return The slice
+        static BufferSlice from_external_memory(Data *begin, Data *end, const std::function<void()> &release);
+
+        /// @brief Returns a pointer to the first byte of the slice
+        Data *data() const;
+
+        /// @brief Returns the number of bytes in the slice
+        size_t size() const;
+
+        /// @brief Returns true if the slice does not refer to any data
+        bool empty() const;
+
+        /// @brief Returns the time at which the data of the slice arrived on the host
+        ///
+        /// This is the time at which the slice was built from the data transferred, i.e. when @ref transfer_data
+        /// received the buffer, or when the implementation built the slice given to @ref transfer_slice.
+        std::chrono::steady_clock::time_point arrival_time() const;
+
+        /// @brief Sets the time at which the data of the slice arrived on the host
+        /// @param arrival_time The arrival time
+        void set_arrival_time(const std::chrono::steady_clock::time_point &arrival_time);
+
+        /// @brief Returns true if the data of the slice does not follow the data of the previous slice transferred
+        ///
+        /// This is the case of the first slice transferred after the transfers went back to the beginning of their
+        /// source, see @ref mark_discontinuity. The state of a decoder must then be reset before decoding the slice.
+        bool is_discontinuous() const;
+
+        /// @brief Sets whether the data of the slice does not follow the data of the previous slice transferred
+        /// @param discontinuous true if the data is discontinuous
+        void set_discontinuous(bool discontinuous);
+
+        /// @brief Releases the reference held on the underlying memory
+        void reset();
+
+    private:
+        std::shared_ptr<const void> owner_;
+        Data *data_{nullptr};
+        size_t size_{0};
+        std::chrono::steady_clock::time_point arrival_time_;
+        bool discontinuous_{false};
+    };
+
+    /// @brief Configuration of the elastic buffering, see @ref set_elastic_buffering
+    struct ElasticBufferingConfig {
+        /// Maximum memory of the buffers allocated on top of a bounded pool, in bytes. 0 disables the elastic buffering
+        size_t max_extra_bytes = 0;
+
+        /// Duration without shortage of buffers after which the buffers allocated on top of the pool are freed
+        std::chrono::milliseconds shrink_delay{1000};
+    };
+
+    /// @brief Statistics of the buffers taken from a bounded pool, see @ref get_buffering_statistics
+    struct BufferingStatistics {
+        /// Maximum number of buffers held at the same time by the transfers and their clients
+        size_t peak_depth = 0;
+
+        /// Number of buffers currently allocated on top of the pool
+        size_t extra_buffers = 0;
+
+        /// Number of times the pool was empty, and a buffer was allocated on top of it
+        uint64_t near_drops = 0;
+
+        /// Number of times the pool was empty and no buffer could be allocated on top of it, the transfers waiting for
+        /// a buffer to be released. Live sources may lose data when this happens.
+        uint64_t drops = 0;
+    };
+
     /// Alias for a callback called when the data transfer starts or stops transferring data
     enum class Status { Started = 0, Stopped = 1 };
     using StatusChangeCallback_t = std::function<void(Status)>;
@@ -49,11 +163,17 @@ public:
     /// Alias for a callback to process transferred buffer of data
     using NewBufferCallback_t = std::function<void(const BufferPtr &)>;
 
+    /// Alias for a callback to process transferred slices of data
+    using NewSliceCallback_t = std::function<void(const BufferSlice &)>;
+
     /// @brief Builds a DataTransfer object
     /// @param raw_event_size_bytes The size of a RAW event in bytes
     DataTransfer(uint32_t raw_event_size_bytes);
 
     /// @brief Builds a DataTransfer object
+    ///
+    /// The buffers of the pool can be allocated on a given NUMA node and backed by huge pages, with
+    /// @ref set_memory_placement.
     /// @param raw_event_size_bytes The size of a RAW event in bytes
     /// @param buffer_pool A user defined buffer pool to use instead of the default one (unbounded, @ref ObjectPool)
     DataTransfer(uint32_t raw_event_size_bytes, const BufferPool &buffer_pool);
@@ -69,6 +189,55 @@ public:
     /// @brief Stops the transfers
     void stop();
 
+    /// @brief Pauses the transfers without stopping them
+    ///
+    /// The transfer thread, the source and the pool of buffers are kept as they are, only the data is not transferred
+    /// to the callbacks anymore: live sources keep running and the data they transfer while paused is dropped, its
+    /// buffers going straight back to the pool, while sources that can hold their data (e.g. files) wait to be resumed.
+    /// Resuming is thus almost immediate, contrary to restarting the transfers. Starting the transfers resumes them.
+    void pause();
+
+    /// @brief Resumes the transfers paused with @ref pause
+    void resume();
+
+    /// @brief Returns true if the transfers are paused
+    bool is_paused() const;
+
+    /// @brief Moves the position from which the data is transferred, for sources that support it (e.g. files)
+    /// @param position Position, in bytes from the beginning of the source
+    /// @return true if the position has been changed, false if the source does not support it
+    /// @throw HalException with error OperationNotPermitted if the transfers are running
+    bool seek(uint64_t position);
+
+    /// @brief Lets a bounded pool of buffers grow when the clients of the transfers hold all its buffers
+    ///
+    /// Instead of waiting for a buffer to be released, the transfers then use buffers allocated on top of the pool, up
+    /// to a memory ceiling. These buffers are reused while the clients are late, and freed once the pool has not been
+    /// short of buffers for a while. This lets the transfers ride through short stalls of the clients. It has no
+    /// effect on unbounded pools, which never wait.
+    /// @param config Configuration of the elastic buffering
+    void set_elastic_buffering(const ElasticBufferingConfig &config);
+
+    /// @brief Allocates the memory of the buffers transferred on a given NUMA node and backs it by huge pages
+    ///
+    /// The placement is applied to the buffers of the pool, and to the buffers allocated later when the pool is
+    /// unbounded or when the elastic buffering is enabled (see @ref set_elastic_buffering).
+    /// @param placement The placement to apply
+    /// @param buffer_bytes Size in bytes of the memory reserved in each buffer
+    /// @return true if the placement was applied to the buffers of the pool, false otherwise (see @ref place_memory)
+    /// @throw HalException with error OperationNotPermitted if the transfers are running
+    bool set_memory_placement(const MemoryPlacement &placement, size_t buffer_bytes);
+
+    /// @brief Gets the statistics of the buffers taken from the pool, if it is bounded
+    /// @return The statistics since the construction of the object
+    BufferingStatistics get_buffering_statistics() const;
+
+    /// @brief Sets the threading policy of the thread running the transfers
+    ///
+    /// The policy is applied the next time the transfers are started.
+    /// @param policy The threading policy
+    void set_thread_policy(const ThreadPolicy &policy);
+
     /// @brief Adds a callback called when the data transfer starts or stops transferring data
     /// @warning This method is not thread safe. You should add/remove the various callback before starting the
     /// transfers
@@ -85,6 +254,18 @@ public:
     /// @return The id of the callback. This id is unique.
     size_t add_new_buffer_callback(NewBufferCallback_t cb);
 
+    /// @brief Adds a callback to process transferred slices of data
+    ///
+    /// Contrary to @ref add_new_buffer_callback, the callback is given a view on the data that may not be held by a
+    /// buffer of the pool, which allows implementations such as memory mapped file readers to transfer data without
+    /// copying it.
+    /// @warning This method is not thread safe. You should add/remove the various callback before starting the
+    /// transfers
+    /// @warning It's not allowed to add/remove a callback from the callback itself
+    /// @param cb The cb to call when a new slice is transferred
+    /// @return The id of the callback. This id is unique.
+    size_t add_new_slice_callback(NewSliceCallback_t cb);
+
     /// @brief Removes the callback with input id
     /// @param cb_id The id of the callback to remove
     /// @note This method is not thread safe. You should add/remove the various callback before starting the transfers
@@ -106,6 +287,27 @@ protected:
     /// @return A buffer taken from the buffer pool
     BufferPtr transfer_data(const BufferPtr &buffer);
 
+    /// @brief The implementation can call this method to transfer data it owns, without copying it in a buffer
+    ///
+    /// The slice is forwarded as is to the callbacks added with @ref add_new_slice_callback. Callbacks added with
+    /// @ref add_new_buffer_callback are given a copy of the data in a buffer taken from the pool.
+    ///
+    /// This is how memory written by the device (e.g. libusb or DMA buffers mapped by the driver) is transferred
+    /// without copy, wrapping it with @ref BufferSlice::from_external_memory. The memory is then handed back to the
+    /// driver by the release hook, which may be called from any thread, and after the transfers are stopped or this
+    /// object is destroyed. As the clients may hold slices for a while, an implementation running out of free memory
+    /// should rather copy the data to a buffer taken from the pool and transfer it with @ref transfer_data.
+    /// @warning The same constraints as for @ref transfer_data apply to the content of the slice
+    /// @param slice The slice of RAW data to transfer
+    void transfer_slice(const BufferSlice &slice);
+
+    /// @brief The implementation can call this method when the next data transferred does not follow the data already
+    /// transferred, e.g. when going back to the beginning of a file
+    ///
+    /// The next slice given to the callbacks added with @ref add_new_slice_callback is flagged as discontinuous (see
+    /// @ref BufferSlice::is_discontinuous).
+    void mark_discontinuity();
+
     /// @brief Requests a new buffer from the pool
     /// @return A buffer taken from the object pool
     BufferPtr get_buffer();
@@ -145,12 +347,41 @@ private:
     /// to do so in the scope of the run_impl method to avoid concurrent calls
     virtual void stop_impl();
 
+    /// @brief Tells whether the source can hold its data while the transfers are paused, see @ref pause
+    ///
+    /// If true, @ref transfer_data and @ref transfer_slice wait for the transfers to be resumed or stopped while they
+    /// are paused, instead of dropping the data. The default implementation returns false, as live sources can not be
+    /// held.
+    /// @return true if the data transferred must not be dropped while paused
+    virtual bool hold_data_while_paused() const;
+
+    /// @brief Seek implementation, see @ref seek
+    ///
+    /// This method is only called while the transfers are stopped. The default implementation does not support seeking
+    /// and returns false.
+    /// @param position Position, in bytes from the beginning of the source
+    /// @return true if the position has been changed, false otherwise
+    virtual bool seek_impl(uint64_t position);
+
+    // Returns true if the data must be transferred, waiting to be resumed if the source holds its data while paused
+    bool wait_while_paused();
+
+    struct ElasticBuffers;
+
     std::thread run_transfers_thread_;
+    ThreadPolicy thread_policy_;
     BufferPool buffer_pool_;
+    size_t buffer_pool_size_; // Number of buffers of the pool, if it is bounded
+    std::shared_ptr<ElasticBuffers> elastic_buffers_;
     std::unordered_map<uint32_t, StatusChangeCallback_t> status_change_cbs_;
     std::unordered_map<uint32_t, NewBufferCallback_t> new_buffer_cbs_;
+    std::unordered_map<uint32_t, NewSliceCallback_t> new_slice_cbs_;
     const uint32_t raw_event_size_bytes_;
     std::atomic<bool> stop_{false};
+    std::atomic<bool> paused_{false};
+    bool discontinuity_pending_{false}; // Only accessed from the transfer thread
+    std::mutex pause_mutex_;
+    std::condition_variable pause_cond_;
     uint32_t cb_index_{0};
 };
 
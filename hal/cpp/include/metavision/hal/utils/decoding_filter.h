@@ -0,0 +1,144 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_DECODING_FILTER_H
+#define METAVISION_HAL_DECODING_FILTER_H
+
+#include <cstdint>
+#include <vector>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/hal/utils/device_roi.h"
+
+namespace Metavision {
+
+/// @brief Filter of the CD events applied by an @ref I_Decoder while decoding, so that the events rejected are never
+/// forwarded, see @ref I_Decoder::set_cd_event_filter
+///
+/// An event is accepted if its pixel is in one of the regions of interest and is not masked (e.g. a hot pixel), if its
+/// polarity is accepted, and then if it is not removed by the decimation, which keeps one accepted event out of a given
+/// number. The regions and the masked pixels are rasterized into a bit mask of the sensor, so that each event is
+/// accepted with one bit test, and the decoders can look up the pixels of a whole row segment at once.
+/// By default, all the events of the sensor are accepted.
+class DecodingFilter {
+public:
+    /// @brief Constructor, accepting all the events of the sensor
+    /// @param width Width of the sensor
+    /// @param height Height of the sensor
+    /// @throw HalException with error InvalidArgument if the size of the sensor is not positive
+    DecodingFilter(int width, int height);
+
+    /// @brief Sets the regions of interest, replacing the previous ones
+    /// @param rois Regions of interest, clipped to the sensor. If empty, the whole sensor is accepted
+    void set_rois(const std::vector<DeviceRoi> &rois);
+
+    /// @brief Sets the pixels whose events are rejected, e.g. the hot pixels of the sensor, replacing the previous ones
+    /// @param mask Bit mask of the pixels rejected, the pixel (x, y) being rejected if the bit (y * width + x) % 64 of
+    /// the word (y * width + x) / 64 is set. If empty, no pixel is rejected
+    /// @throw HalException with error InvalidArgument if the mask is not empty and has less than
+    /// (width * height + 63) / 64 words
+    void set_masked_pixels(const std::vector<std::uint64_t> &mask);
+
+    /// @brief Sets the polarities accepted
+    /// @param negative If true, the events of polarity 0 are accepted
+    /// @param positive If true, the events of polarity 1 are accepted
+    void set_polarities(bool negative, bool positive);
+
+    /// @brief Sets the decimation of the events
+    /// @param factor The filter keeps one accepted event out of @p factor, 1 keeping all of them
+    /// @throw HalException with error InvalidArgument if the factor is 0
+    void set_decimation(std::uint32_t factor);
+
+    /// @brief Gets the width of the sensor
+    int get_width() const {
+        return width_;
+    }
+
+    /// @brief Gets the height of the sensor
+    int get_height() const {
+        return height_;
+    }
+
+    /// @brief Returns true if the events are decimated, i.e. if @ref decimate has to be called for each event
+    bool is_decimating() const {
+        return decimation_factor_ > 1;
+    }
+
+    /// @brief Returns true if some pixels of a row are accepted
+    bool is_row_accepted(int y) const {
+        return static_cast<unsigned int>(y) < static_cast<unsigned int>(height_) && rows_[y];
+    }
+
+    /// @brief Returns true if a polarity is accepted
+    bool is_polarity_accepted(int p) const {
+        return polarities_[p & 1];
+    }
+
+    /// @brief Returns true if the events of a pixel with a polarity are accepted, regardless of the decimation
+    bool is_accepted(int x, int y, int p) const {
+        if (static_cast<unsigned int>(x) >= static_cast<unsigned int>(width_) || !is_row_accepted(y)) {
+            return false;
+        }
+        return is_polarity_accepted(p) && ((mask_[static_cast<size_t>(y) * row_words_ + (x >> 6)] >> (x & 63)) & 1);
+    }
+
+    /// @brief Gets whether the pixels of a segment of a row are accepted, regardless of the polarity and decimation
+    /// @param x Abscissa of the first pixel of the segment
+    /// @param y Ordinate of the row
+    /// @param n Number of pixels of the segment, at most 32
+    /// @return Bit mask of the pixels accepted, the bit i being set if the pixel (x + i, y) is accepted
+    std::uint32_t get_row_mask(int x, int y, int n) const {
+        if (static_cast<unsigned int>(x) >= static_cast<unsigned int>(width_) || !is_row_accepted(y)) {
+            return 0;
+        }
+        // The rows have an extra word, so that the one after the first pixel can always be read
+        const std::uint64_t *row = mask_.data() + static_cast<size_t>(y) * row_words_ + (x >> 6);
+        const int shift          = x & 63;
+        const std::uint64_t bits = shift ? (row[0] >> shift) | (row[1] << (64 - shift)) : row[0];
+        return static_cast<std::uint32_t>(bits) & (n >= 32 ? ~0u : (1u << n) - 1);
+    }
+
+    /// @brief Applies the decimation to an accepted event
+    /// @return true if the event is kept
+    bool decimate() {
+        const bool kept = decimation_count_ == 0;
+        if (++decimation_count_ == decimation_factor_) {
+            decimation_count_ = 0;
+        }
+        return kept;
+    }
+
+    /// @brief Removes the events rejected by the filter from a buffer
+    /// @param begin Pointer to the first event of the buffer
+    /// @param end Pointer after the last event of the buffer
+    /// @return Pointer after the last event kept, which are moved to the beginning of the buffer
+    EventCD *apply(EventCD *begin, EventCD *end);
+
+private:
+    // Rasterizes the regions of interest, without the masked pixels
+    void update_mask();
+
+    int width_, height_;
+    size_t row_words_;
+    std::vector<DeviceRoi> rois_;
+    std::vector<std::uint64_t> masked_pixels_;
+    // One bit per pixel, each row being stored in its own words
+    std::vector<std::uint64_t> mask_;
+    // Whether each row has pixels accepted
+    std::vector<std::uint8_t> rows_;
+    bool polarities_[2]{true, true};
+    std::uint32_t decimation_factor_{1};
+    std::uint32_t decimation_count_{0};
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_HAL_DECODING_FILTER_H
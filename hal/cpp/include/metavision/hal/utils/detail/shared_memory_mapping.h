@@ -0,0 +1,82 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_DETAIL_SHARED_MEMORY_MAPPING_H
+#define METAVISION_HAL_DETAIL_SHARED_MEMORY_MAPPING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Metavision {
+namespace detail {
+
+/// @brief Named shared memory object, mapped in the memory of the process
+///
+/// The object is removed when its creator unmaps it, the processes that opened it keeping their mapping.
+class SharedMemoryMapping {
+public:
+    /// @brief Creates a new shared memory object, zero-initialized
+    ///
+    /// If an object of the same name already exists, nothing is mapped and @ref exists returns true.
+    /// @param name Name of the object, which must be a valid file name
+    /// @param size Size of the object in bytes
+    /// @throw HalException if the object could not be created
+    SharedMemoryMapping(const std::string &name, size_t size);
+
+    /// @brief Opens an existing shared memory object
+    /// @param name Name of the object
+    /// @throw HalException if the object does not exist or could not be mapped
+    SharedMemoryMapping(const std::string &name);
+
+    ~SharedMemoryMapping();
+
+    SharedMemoryMapping(const SharedMemoryMapping &) = delete;
+    SharedMemoryMapping &operator=(const SharedMemoryMapping &) = delete;
+
+    /// @brief Removes the name of a shared memory object left by a process that did not exit cleanly
+    static void remove(const std::string &name);
+
+    /// @brief Tells whether the object could not be created because it already exists
+    bool exists() const;
+
+    /// @brief Gets the address of the mapped memory
+    uint8_t *data() const;
+
+    /// @brief Gets the size of the mapped memory
+    size_t size() const;
+
+private:
+#ifdef _WIN32
+    void map();
+
+    void *mapping_{nullptr};
+#else
+    void map(int fd);
+#endif
+
+    const std::string os_name_;
+    uint8_t *data_{nullptr};
+    size_t size_{0};
+    const bool owner_;
+    bool exists_{false};
+};
+
+/// @brief Gets the ID of the current process
+int64_t get_current_process_id();
+
+/// @brief Tells whether a process is still running
+bool is_process_alive(int64_t pid);
+
+} // namespace detail
+} // namespace Metavision
+
+#endif // METAVISION_HAL_DETAIL_SHARED_MEMORY_MAPPING_H
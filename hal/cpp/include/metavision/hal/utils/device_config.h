@@ -14,6 +14,9 @@
 
 #include <string>
 
+#include "metavision/sdk/base/utils/thread_policy.h"
+#include "metavision/hal/utils/performance_profile.h"
+
 namespace Metavision {
 
 /// @brief Device's configuration's options
@@ -21,6 +24,15 @@ class DeviceConfig {
 public:
     /// Switch the event format if supported
     std::string event_format_;
+
+    /// Threading policy of the thread transferring the data from the device
+    ThreadPolicy thread_policy_;
+
+    /// Trade-off between the latency and the efficiency of the transfer and the decoding of the data (see
+    /// @ref PerformanceProfile). Unless balanced, the profile overrides the sizes of the reads of files
+    /// (@ref RawFileConfig::n_events_to_read_ and @ref RawFileConfig::n_read_buffers_) and sets the facilities of the
+    /// device when it is opened (see @ref apply_performance_profile)
+    PerformanceProfile performance_profile_ = PerformanceProfile::Balanced;
 };
 } // namespace Metavision
 
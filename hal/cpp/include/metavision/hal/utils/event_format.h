@@ -0,0 +1,200 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_EVENT_FORMAT_H
+#define METAVISION_HAL_EVENT_FORMAT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/base/utils/timestamp.h"
+
+namespace Metavision {
+
+/// @brief Field of a raw event word, made of @p Bits consecutive bits starting at bit @p Offset
+template<int Offset, int Bits>
+struct EventFormatField {
+    static_assert(Offset >= 0 && Bits > 0 && Offset + Bits <= 64, "The field must fit in 64 bits");
+
+    static constexpr int offset = Offset;
+    static constexpr int bits   = Bits;
+
+    /// Mask of the value of the field, once shifted to the least significant bits
+    static constexpr uint64_t mask = Bits == 64 ? ~uint64_t(0) : (uint64_t(1) << Bits) - 1;
+
+    /// @brief Gets the value of the field in a word
+    template<typename Word>
+    static constexpr uint64_t get(Word word) {
+        return (static_cast<uint64_t>(word) >> Offset) & mask;
+    }
+
+    /// @brief Gets a value placed at the position of the field, truncated to its number of bits
+    static constexpr uint64_t put(uint64_t value) {
+        return (value & mask) << Offset;
+    }
+};
+
+/// @brief Descriptor of a fixed-width format of CD events, each event being a word holding its timestamp, coordinates
+/// and polarity in bitfields
+///
+/// From the layout of the fields, it generates the functions encoding and decoding an event, and unpacking buffers of
+/// words into arrays of @ref EventCD, vectorized with AVX2 or NEON for 64-bit words, or into arrays of fields, in a
+/// loop vectorized by the compiler. A decoder of a new fixed-width format then only needs to describe its layout, and
+/// to handle the words that are not CD events, if any.
+/// @tparam Word Unsigned integer type of a raw event
+/// @tparam TimeField Field of the timestamp
+/// @tparam XField Field of the x coordinate
+/// @tparam YField Field of the y coordinate
+/// @tparam PolarityField Field of the polarity
+template<typename Word, typename TimeField, typename XField, typename YField, typename PolarityField>
+struct CDEventFormat {
+    static_assert(std::is_unsigned<Word>::value, "The words of the format must be unsigned integers");
+    static_assert(TimeField::offset + TimeField::bits <= int(8 * sizeof(Word)) &&
+                      XField::offset + XField::bits <= int(8 * sizeof(Word)) &&
+                      YField::offset + YField::bits <= int(8 * sizeof(Word)) &&
+                      PolarityField::offset + PolarityField::bits <= int(8 * sizeof(Word)),
+                  "The fields must fit in a word");
+    static_assert((TimeField::put(~uint64_t(0)) & XField::put(~uint64_t(0))) == 0 &&
+                      (TimeField::put(~uint64_t(0)) & YField::put(~uint64_t(0))) == 0 &&
+                      (TimeField::put(~uint64_t(0)) & PolarityField::put(~uint64_t(0))) == 0 &&
+                      (XField::put(~uint64_t(0)) & YField::put(~uint64_t(0))) == 0 &&
+                      (XField::put(~uint64_t(0)) & PolarityField::put(~uint64_t(0))) == 0 &&
+                      (YField::put(~uint64_t(0)) & PolarityField::put(~uint64_t(0))) == 0,
+                  "The fields must not overlap");
+    static_assert(TimeField::bits < 64 && XField::bits <= 16 && YField::bits <= 16 && PolarityField::bits < 16,
+                  "The fields must fit in the fields of an EventCD");
+
+    using WordType = Word;
+    using Time     = TimeField;
+    using X        = XField;
+    using Y        = YField;
+    using Polarity = PolarityField;
+
+    /// @brief Encodes an event, the values being truncated to the number of bits of their fields
+    static constexpr Word encode(unsigned short x, unsigned short y, short p, timestamp t) {
+        return static_cast<Word>(TimeField::put(static_cast<uint64_t>(t)) | XField::put(x) | YField::put(y) |
+                                 PolarityField::put(static_cast<uint64_t>(p)));
+    }
+
+    /// @brief Gets the timestamp of a word, shifted by @p t_shift
+    static constexpr timestamp get_time(Word word, timestamp t_shift = 0) {
+        return static_cast<timestamp>(TimeField::get(word)) - t_shift;
+    }
+
+    /// @brief Decodes an event
+    /// @param word Raw event
+    /// @param t_shift Time shift subtracted from the timestamp of the event
+    static EventCD decode(Word word, timestamp t_shift = 0) {
+        return EventCD(static_cast<unsigned short>(XField::get(word)), static_cast<unsigned short>(YField::get(word)),
+                       static_cast<short>(PolarityField::get(word)), get_time(word, t_shift));
+    }
+
+    /// @brief Unpacks raw events into an array of events
+    /// @param in Raw events
+    /// @param n Number of raw events
+    /// @param t_shift Time shift subtracted from the timestamps of the events
+    /// @param out Array of at least @p n events
+    static void unpack(const Word *in, size_t n, timestamp t_shift, EventCD *out) {
+        const size_t n_vectorized =
+            unpack_vectorized(in, n, t_shift, out, std::integral_constant<bool, sizeof(Word) == 8>());
+        for (size_t i = n_vectorized; i < n; ++i) {
+            out[i] = decode(in[i], t_shift);
+        }
+    }
+
+    /// @brief Unpacks raw events into arrays of their fields
+    /// @param in Raw events
+    /// @param n Number of raw events
+    /// @param t_shift Time shift subtracted from the timestamps of the events
+    /// @param x Array of at least @p n x coordinates
+    /// @param y Array of at least @p n y coordinates
+    /// @param p Array of at least @p n polarities
+    /// @param t Array of at least @p n timestamps
+    static void unpack(const Word *in, size_t n, timestamp t_shift, unsigned short *x, unsigned short *y, short *p,
+                       timestamp *t) {
+        for (size_t i = 0; i < n; ++i) {
+            const Word word = in[i];
+            x[i]            = static_cast<unsigned short>(XField::get(word));
+            y[i]            = static_cast<unsigned short>(YField::get(word));
+            p[i]            = static_cast<short>(PolarityField::get(word));
+            t[i]            = get_time(word, t_shift);
+        }
+    }
+
+private:
+    static size_t unpack_vectorized(const Word *, size_t, timestamp, EventCD *, std::false_type) {
+        return 0;
+    }
+
+    // The low 64 bits of an EventCD hold x, y and p, and the high ones its timestamp
+    static size_t unpack_vectorized(const Word *in, size_t n, timestamp t_shift, EventCD *out, std::true_type) {
+        static_assert(sizeof(EventCD) == 16, "The vectorized unpacking relies on the layout of EventCD");
+        size_t i = 0;
+#if defined(__AVX2__)
+        const __m256i shift  = _mm256_set1_epi64x(t_shift);
+        const __m256i t_mask = _mm256_set1_epi64x(static_cast<int64_t>(TimeField::mask));
+        const __m256i x_mask = _mm256_set1_epi64x(static_cast<int64_t>(XField::mask));
+        const __m256i y_mask = _mm256_set1_epi64x(static_cast<int64_t>(YField::mask));
+        const __m256i p_mask = _mm256_set1_epi64x(static_cast<int64_t>(PolarityField::mask));
+        for (; i + 4 <= n; i += 4) {
+            const __m256i w = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i));
+            const __m256i t =
+                _mm256_sub_epi64(_mm256_and_si256(_mm256_srli_epi64(w, TimeField::offset), t_mask), shift);
+            const __m256i x = _mm256_and_si256(_mm256_srli_epi64(w, XField::offset), x_mask);
+            const __m256i y = _mm256_and_si256(_mm256_srli_epi64(w, YField::offset), y_mask);
+            const __m256i p = _mm256_and_si256(_mm256_srli_epi64(w, PolarityField::offset), p_mask);
+            const __m256i xyp =
+                _mm256_or_si256(x, _mm256_or_si256(_mm256_slli_epi64(y, 16), _mm256_slli_epi64(p, 32)));
+            // (xyp0, t0, xyp2, t2) and (xyp1, t1, xyp3, t3), reordered into the events 0, 1 and 2, 3
+            const __m256i even = _mm256_unpacklo_epi64(xyp, t);
+            const __m256i odd  = _mm256_unpackhi_epi64(xyp, t);
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), _mm256_permute2x128_si256(even, odd, 0x20));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i + 2), _mm256_permute2x128_si256(even, odd, 0x31));
+        }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+        const int64x2_t shift   = vdupq_n_s64(t_shift);
+        const uint64x2_t t_mask = vdupq_n_u64(TimeField::mask);
+        const uint64x2_t x_mask = vdupq_n_u64(XField::mask);
+        const uint64x2_t y_mask = vdupq_n_u64(YField::mask);
+        const uint64x2_t p_mask = vdupq_n_u64(PolarityField::mask);
+        // Shifting left by a negative count shifts right, which also handles the fields at offset 0
+        const int64x2_t t_offset = vdupq_n_s64(-TimeField::offset);
+        const int64x2_t x_offset = vdupq_n_s64(-XField::offset);
+        const int64x2_t y_offset = vdupq_n_s64(-YField::offset);
+        const int64x2_t p_offset = vdupq_n_s64(-PolarityField::offset);
+        for (; i + 2 <= n; i += 2) {
+            const uint64x2_t w = vld1q_u64(reinterpret_cast<const uint64_t *>(in + i));
+            const uint64x2_t x = vandq_u64(vshlq_u64(w, x_offset), x_mask);
+            const uint64x2_t y = vandq_u64(vshlq_u64(w, y_offset), y_mask);
+            const uint64x2_t p = vandq_u64(vshlq_u64(w, p_offset), p_mask);
+            uint64x2x2_t events;
+            events.val[0] = vorrq_u64(x, vorrq_u64(vshlq_n_u64(y, 16), vshlq_n_u64(p, 32)));
+            events.val[1] = vreinterpretq_u64_s64(
+                vsubq_s64(vreinterpretq_s64_u64(vandq_u64(vshlq_u64(w, t_offset), t_mask)), shift));
+            vst2q_u64(reinterpret_cast<uint64_t *>(out + i), events);
+        }
+#else
+        (void)in, (void)n, (void)t_shift, (void)out;
+#endif
+        return i;
+    }
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_HAL_EVENT_FORMAT_H
@@ -0,0 +1,78 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_EVENTS_STREAM_AWAITABLE_H
+#define METAVISION_HAL_EVENTS_STREAM_AWAITABLE_H
+
+#include "metavision/hal/facilities/i_events_stream.h"
+
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+#include <coroutine>
+#define METAVISION_HAL_HAS_COROUTINES 1
+#endif
+#endif
+
+#ifdef METAVISION_HAL_HAS_COROUTINES
+
+namespace Metavision {
+
+/// @brief Awaitable waiting for the next buffer of an events stream, built on
+/// @ref I_EventsStream::async_wait_next_buffer
+///
+/// The awaiting coroutine is resumed by the data transfer thread once a buffer is available, the result of the
+/// co_await being the value @ref I_EventsStream::wait_next_buffer would have returned. Only available when compiling
+/// with C++20 coroutines.
+///
+/// @code
+/// while (co_await next_buffer(stream) > 0) {
+///     long n_bytes;
+///     auto data = stream.get_latest_raw_data(n_bytes);
+///     decoder.decode(data, data + n_bytes);
+/// }
+/// @endcode
+class NextBufferAwaitable {
+public:
+    explicit NextBufferAwaitable(I_EventsStream &stream) : stream_(stream) {}
+
+    bool await_ready() {
+        status_ = stream_.poll_buffer();
+        return status_ != 0;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle) {
+        // The coroutine is already suspended here, so it may be resumed before this function returns
+        stream_.async_wait_next_buffer([this, handle](short status) {
+            status_ = status;
+            handle.resume();
+        });
+    }
+
+    short await_resume() const {
+        return status_;
+    }
+
+private:
+    I_EventsStream &stream_;
+    short status_ = 0;
+};
+
+/// @brief Returns an awaitable waiting for the next buffer of an events stream
+/// @param stream Events stream to wait for
+inline NextBufferAwaitable next_buffer(I_EventsStream &stream) {
+    return NextBufferAwaitable(stream);
+}
+
+} // namespace Metavision
+
+#endif // METAVISION_HAL_HAS_COROUTINES
+
+#endif // METAVISION_HAL_EVENTS_STREAM_AWAITABLE_H
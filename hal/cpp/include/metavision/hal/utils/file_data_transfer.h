@@ -17,15 +17,35 @@
 #include <atomic>
 #include <mutex>
 
+#include "metavision/hal/utils/adaptive_read_size.h"
 #include "metavision/hal/utils/data_transfer.h"
 #include "metavision/hal/utils/raw_file_config.h"
 
 namespace Metavision {
 
+class MemoryMappedFileStream;
+class MemoryRawStream;
+class NetworkRawStream;
+class ReadAheadFileStream;
+class SharedMemoryRawStream;
+
 /// @brief Standard stream reader
 class FileDataTransfer : public DataTransfer {
 public:
     /// @brief Reads the input standard @a stream batch by batch according to the input configuration
+    ///
+    /// If @a stream is a @ref MemoryMappedFileStream, the data is not copied: slices of the mapped file are
+    /// transferred instead (see @ref DataTransfer::transfer_slice).
+    /// If @a stream is a @ref MemoryRawStream, slices of the buffers of the caller are transferred without copy.
+    /// If @a stream is a @ref ReadAheadFileStream, several reads are kept in flight at once, within the limit of the
+    /// number of buffers available (see @ref RawFileConfig::n_read_buffers_).
+    /// If @a stream is a @ref SharedMemoryRawStream, the buffers of the shared memory ring are transferred without
+    /// copy, until the ring is closed by its publisher.
+    /// If @a stream is a @ref NetworkRawStream, each chunk of data is received directly in a buffer of the pool, until
+    /// the connection is closed by the server.
+    /// If @ref RawFileConfig::loop_ is set, the stream is rewound to its current position (i.e. after the header) each
+    /// time its end is reached, and the first slice transferred after it is flagged as discontinuous (see
+    /// @ref DataTransfer::BufferSlice::is_discontinuous).
     /// @param stream The stream to read from
     /// @param raw_event_size_bytes The size of a RAW event in bytes
     /// @param config The configuration to use to read the stream
@@ -34,9 +54,28 @@ public:
     /// @brief Stops ongoing transfers
     ~FileDataTransfer();
 
+    /// @brief Gets the policy adapting the size of the reads to the rate of the events
+    /// @return The policy, or nullptr if the size of the reads is fixed (see @ref RawFileConfig::n_us_to_read_)
+    const std::shared_ptr<AdaptiveReadSize> &get_adaptive_read_size() const;
+
+    /// @brief Tells whether the stream goes back to its beginning when reaching its end
+    /// @return true if @ref RawFileConfig::loop_ is set and the stream can be rewound
+    bool is_looping() const;
+
 private:
+    uint32_t get_read_size() const;
+    void run_once();
+    bool rewind();
+
     void start_impl(BufferPtr buffer) override final;
     void run_impl() override final;
+    bool seek_impl(uint64_t position) override final;
+    bool hold_data_while_paused() const override final;
+    void run_memory_mapped();
+    void run_memory_buffers();
+    void run_read_ahead();
+    void run_shared_memory();
+    void run_network();
 
     /// Buffer
     BufferPtr data_read_;
@@ -44,7 +83,32 @@ private:
     /// Bytes batch size to read from stream at each read iteration
     uint32_t read_bytes_size_{0};
 
+    /// Adapts the bytes batch size to the rate of the events, if set
+    std::shared_ptr<AdaptiveReadSize> adaptive_read_size_;
+
+    /// Number of buffers in the pool
+    uint32_t n_read_buffers_{0};
+
+    /// Set if the stream is rewound to data_begin_ when reaching its end
+    bool loop_{false};
+    std::streampos data_begin_;
+
     std::unique_ptr<std::istream> stream_to_read_;
+
+    /// Set if the stream to read is memory mapped
+    MemoryMappedFileStream *mapped_stream_{nullptr};
+
+    /// Set if the stream to read is already in memory
+    MemoryRawStream *memory_stream_{nullptr};
+
+    /// Set if the stream to read supports read-ahead
+    ReadAheadFileStream *read_ahead_stream_{nullptr};
+
+    /// Set if the stream to read is published by another process in shared memory
+    SharedMemoryRawStream *shared_memory_stream_{nullptr};
+
+    /// Set if the stream to read is received from the network
+    NetworkRawStream *network_stream_{nullptr};
 };
 } // namespace Metavision
 
@@ -39,6 +39,9 @@ enum Enum : HalErrorCodeType {
 
     /// Errors related to calling deprecated function that have no equivalent in current API
     DeprecatedFunctionCalled = CameraError | 0x03000,
+
+    /// Errors related to an operation that is not permitted in the current state
+    OperationNotPermitted = CameraError | 0x04000,
 };
 }
 
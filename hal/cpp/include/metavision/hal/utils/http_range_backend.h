@@ -0,0 +1,69 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_HTTP_RANGE_BACKEND_H
+#define METAVISION_HAL_HTTP_RANGE_BACKEND_H
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "metavision/hal/utils/ranged_read_backend.h"
+
+namespace Metavision {
+
+/// @brief Backend reading a file served over HTTP, such as an object of an object storage, with range requests
+///
+/// Each read is a GET request for a range of bytes, sent over one of a pool of persistent connections, so that the
+/// reads kept in flight by a @ref ReadAheadFileStream are fetched in parallel.
+///
+/// S3 URLs "s3://<bucket>/<key>" are read from the endpoint given by the environment variable AWS_ENDPOINT_URL, the
+/// bucket being the first element of the path (e.g. "http://localhost:9000" for a local MinIO server), or else from
+/// "http://<bucket>.s3.amazonaws.com". The requests are not signed: the objects must be readable anonymously.
+/// @note HTTPS is not supported
+class HttpRangeBackend : public RangedReadBackend {
+public:
+    /// @brief Connects to the server and gets the size of the file
+    /// @param url URL of the file: "http://<host>[:<port>]/<path>" or "s3://<bucket>/<key>"
+    /// @throw HalException if the URL is not supported, the server can not be reached, the file does not exist or the
+    /// server does not support range requests
+    HttpRangeBackend(const std::string &url);
+
+    /// @brief Closes the connections
+    ~HttpRangeBackend() override;
+
+    const std::string &get_location() const override;
+    bool is_open() const override;
+    uint64_t get_size() const override;
+    int64_t read_at(uint8_t *data, uint64_t offset, size_t size) override;
+
+private:
+    struct Connection;
+    struct Response;
+
+    std::unique_ptr<Connection> take_connection();
+    void give_back_connection(std::unique_ptr<Connection> connection);
+    bool fetch(uint64_t offset, size_t size, uint8_t *data, Response &response);
+
+    const std::string url_;
+    std::string host_;
+    std::string port_;
+    std::string path_;
+    uint64_t size_ = 0;
+
+    std::mutex connections_mutex_;
+    std::vector<std::unique_ptr<Connection>> idle_connections_;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_HAL_HTTP_RANGE_BACKEND_H
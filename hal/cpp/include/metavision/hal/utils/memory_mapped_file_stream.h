@@ -0,0 +1,71 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_MEMORY_MAPPED_FILE_STREAM_H
+#define METAVISION_HAL_MEMORY_MAPPED_FILE_STREAM_H
+
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <streambuf>
+#include <string>
+
+namespace Metavision {
+
+/// @brief Standard input stream reading from a memory mapped file
+///
+/// The stream can be used as any other input stream (for example to parse the header of a RAW file), and additionally
+/// gives direct access to the mapped memory so that readers can consume the file content without copying it.
+///
+/// The file is mapped privately (copy on write): the mapped memory can be modified without altering the file.
+class MemoryMappedFileStream : public std::istream {
+public:
+    /// @brief Maps the whole content of the file @p filename in memory
+    /// @param filename Path to the file to map
+    /// @throw HalException if the file could not be opened or mapped
+    MemoryMappedFileStream(const std::string &filename);
+
+    /// @brief Destructor
+    ///
+    /// The mapping is released when the last reference on it (see @ref get_mapping) is destroyed
+    ~MemoryMappedFileStream();
+
+    /// @brief Returns a pointer to the beginning of the mapped file
+    uint8_t *data() const;
+
+    /// @brief Returns the size in bytes of the mapped file
+    size_t size() const;
+
+    /// @brief Returns the object owning the mapping
+    ///
+    /// The mapping remains valid as long as one copy of the returned pointer is alive, even after the stream has been
+    /// destroyed
+    std::shared_ptr<const void> get_mapping() const;
+
+private:
+    class Mapping;
+
+    class MappedBuffer : public std::streambuf {
+    public:
+        MappedBuffer(char *begin, char *end);
+
+    protected:
+        pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override;
+        pos_type seekpos(pos_type pos, std::ios_base::openmode which) override;
+    };
+
+    std::shared_ptr<Mapping> mapping_;
+    std::unique_ptr<MappedBuffer> buffer_;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_HAL_MEMORY_MAPPED_FILE_STREAM_H
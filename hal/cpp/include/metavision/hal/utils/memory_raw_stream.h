@@ -0,0 +1,73 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_MEMORY_RAW_STREAM_H
+#define METAVISION_HAL_MEMORY_RAW_STREAM_H
+
+#include <cstddef>
+#include <istream>
+#include <memory>
+#include <vector>
+
+namespace Metavision {
+
+/// @brief Standard input stream reading RAW data already in memory, e.g. received over a message bus
+///
+/// The data is either a contiguous buffer, or a list of buffers read one after the other (scatter-gather). The stream
+/// can be used as any other input stream (for example to parse the header of the RAW data), and the buffers are
+/// transferred without copy by a @ref FileDataTransfer, as slices aliasing the memory of the caller.
+///
+/// The memory is never modified. It must remain valid as long as the stream, the device opened from it, and the slices
+/// transferred are alive, which is ensured by passing the object owning the memory to the constructor.
+class MemoryRawStream : public std::istream {
+public:
+    /// @brief Contiguous buffer of RAW data
+    struct Buffer {
+        const void *data;
+        size_t size;
+    };
+
+    /// @brief Reads a contiguous buffer
+    /// @param data Pointer to the first byte of the buffer
+    /// @param size Size of the buffer in bytes
+    /// @param owner Object owning the memory, kept alive as long as the stream and the slices transferred, or nullptr
+    /// if the memory is guaranteed to outlive them
+    MemoryRawStream(const void *data, size_t size, const std::shared_ptr<const void> &owner = nullptr);
+
+    /// @brief Reads a list of buffers, one after the other
+    /// @param buffers Buffers to read, in order
+    /// @param owner Object owning the memory, kept alive as long as the stream and the slices transferred, or nullptr
+    /// if the memory is guaranteed to outlive them
+    MemoryRawStream(const std::vector<Buffer> &buffers, const std::shared_ptr<const void> &owner = nullptr);
+
+    /// @brief Destructor
+    ~MemoryRawStream();
+
+    /// @brief Returns the buffers read
+    const std::vector<Buffer> &get_buffers() const;
+
+    /// @brief Returns the total size in bytes of the buffers
+    size_t size() const;
+
+    /// @brief Returns the object owning the memory, which may be nullptr
+    const std::shared_ptr<const void> &get_owner() const;
+
+private:
+    class BuffersStreamBuf;
+
+    std::vector<Buffer> buffers_;
+    std::shared_ptr<const void> owner_;
+    std::unique_ptr<BuffersStreamBuf> streambuf_;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_HAL_MEMORY_RAW_STREAM_H
@@ -0,0 +1,120 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_NETWORK_RAW_STREAM_H
+#define METAVISION_HAL_NETWORK_RAW_STREAM_H
+
+#include <chrono>
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "metavision/hal/utils/compressed_raw_file.h"
+#include "metavision/hal/utils/data_transfer.h"
+
+namespace Metavision {
+
+/// @brief Configuration of a @ref NetworkRawStreamServer
+struct NetworkRawStreamServerConfig {
+    /// Compression of the data sent, done once whatever the number of clients
+    RawCompression compression_ = RawCompression::None;
+
+    /// Maximum number of bytes waiting to be sent to a client. A client that falls further behind is disconnected,
+    /// so that it neither slows down the others nor holds an unbounded amount of memory
+    size_t max_queued_bytes_ = 64 * 1024 * 1024;
+
+    /// Maximum number of buffers sent to a client in a single system call
+    uint32_t max_batch_buffers_ = 64;
+};
+
+/// @brief Server streaming RAW data over TCP to any number of clients
+///
+/// Each client first receives the header of the RAW data, then the buffers sent after it connected (see @ref send).
+/// The buffers are sent as the chunks of a compressed RAW file (see @ref CompressedRawChunkHeader), possibly stored
+/// uncompressed, and are read back by a @ref NetworkRawStream.
+/// The buffers are queued for each client, and sent by a thread per client in batches, so that a slow client does not
+/// delay the others.
+class NetworkRawStreamServer {
+public:
+    /// @brief Starts listening for clients on @p port, on all the network interfaces
+    /// @param port Port to listen on, 0 to let the system choose one (see @ref get_port)
+    /// @param header Header of the RAW data sent
+    /// @param config Configuration of the server
+    /// @throw HalException if the port could not be listened on
+    NetworkRawStreamServer(uint16_t port, const std::string &header,
+                           const NetworkRawStreamServerConfig &config = NetworkRawStreamServerConfig());
+
+    /// @brief Destructor
+    ///
+    /// Sends the buffers still queued, then closes the connections, which ends the streams of the clients.
+    ~NetworkRawStreamServer();
+
+    /// @brief Gets the port the server listens on
+    uint16_t get_port() const;
+
+    /// @brief Gets the number of clients currently connected
+    size_t get_n_clients() const;
+
+    /// @brief Sends a buffer of RAW data to all the clients connected
+    /// @param data Pointer to the data
+    /// @param size Number of bytes to send
+    void send(const uint8_t *data, size_t size);
+
+private:
+    class Private;
+    std::unique_ptr<Private> pimpl_;
+};
+
+/// @brief Standard input stream reading the RAW data sent by a @ref NetworkRawStreamServer
+///
+/// The stream first returns the header of the RAW data, then the data sent by the server, decompressed if needed, and
+/// ends when the server closes the connection. It can hence be read as a RAW file (see
+/// @ref DeviceDiscovery::open_stream), and additionally gives access to the chunks of data so that readers can receive
+/// them directly in their own buffers.
+class NetworkRawStream : public std::istream {
+public:
+    /// @brief Connects to a server
+    /// @param host Name or address of the host of the server
+    /// @param port Port the server listens on
+    /// @throw HalException if the connection failed, or the server does not send RAW data
+    NetworkRawStream(const std::string &host, uint16_t port);
+
+    /// @brief Destructor, closing the connection
+    ~NetworkRawStream();
+
+    /// @brief Waits until data is received or the connection is closed
+    /// @param timeout Maximum duration to wait for
+    /// @return true if @ref read_chunk can be called without waiting for the server
+    bool wait_for_data(std::chrono::milliseconds timeout);
+
+    /// @brief Receives the next chunk of data
+    ///
+    /// The chunk is received, and decompressed if needed, directly in @p buffer.
+    /// @param buffer Buffer receiving the data of the chunk, resized to its size
+    /// @return false if the connection has been closed or the data is corrupted
+    bool read_chunk(DataTransfer::Buffer &buffer);
+
+    /// @brief Gets the data already received but not read from the stream yet
+    ///
+    /// The data is consumed from the stream: the next data must be read with @ref read_chunk.
+    /// @param buffer Buffer receiving the data, resized to its size which may be 0
+    void take_pending_data(DataTransfer::Buffer &buffer);
+
+private:
+    class SocketBuffer;
+    std::unique_ptr<SocketBuffer> buffer_;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_HAL_NETWORK_RAW_STREAM_H
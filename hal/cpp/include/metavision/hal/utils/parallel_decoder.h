@@ -0,0 +1,107 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_PARALLEL_DECODER_H
+#define METAVISION_HAL_PARALLEL_DECODER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/base/events/event_ext_trigger.h"
+#include "metavision/hal/facilities/i_decoder.h"
+#include "metavision/hal/facilities/i_event_decoder.h"
+
+namespace Metavision {
+
+/// @brief Decodes RAW data by splitting it into chunks that are decoded concurrently
+///
+/// The chunks start at the resync points of the format (see @ref I_Decoder::find_resync_point) and each of them is
+/// decoded on a worker thread by its own instance of @ref I_Decoder. The decoded events are then shifted to the time
+/// reference of the stream and forwarded in order, so that the output is the same as decoding the data with a single
+/// decoder.
+/// This is meant for offline processing of recordings: the whole content of a file (e.g. memory mapped) can be passed
+/// at once to @ref decode.
+/// If the format does not support resynchronization, the data is decoded sequentially.
+class ParallelDecoder {
+public:
+    /// @brief Function creating a decoder of the format of the data, with the same parameters as the constructor of
+    /// @ref I_Decoder
+    using DecoderFactory = std::function<std::unique_ptr<I_Decoder>(
+        bool time_shifting_enabled, const std::shared_ptr<I_EventDecoder<EventCD>> &event_cd_decoder,
+        const std::shared_ptr<I_EventDecoder<EventExtTrigger>> &event_ext_trigger_decoder)>;
+
+    /// @brief Default size of the chunks, in bytes
+    static constexpr size_t DefaultChunkSize = 4 * 1024 * 1024;
+
+    /// @brief Constructor
+    /// @param decoder_factory Function creating the decoders of the chunks
+    /// @param time_shifting_enabled If true, the timestamp of the decoded events will be shifted by the value of first
+    /// event
+    /// @param event_cd_decoder Optional decoder of CD events
+    /// @param event_ext_trigger_decoder Optional decoder of trigger events
+    /// @param n_threads Number of worker threads. If 0, the number of cores is used
+    /// @param chunk_size Approximate size of the chunks, in bytes
+    ParallelDecoder(
+        const DecoderFactory &decoder_factory, bool time_shifting_enabled,
+        const std::shared_ptr<I_EventDecoder<EventCD>> &event_cd_decoder = std::shared_ptr<I_EventDecoder<EventCD>>(),
+        const std::shared_ptr<I_EventDecoder<EventExtTrigger>> &event_ext_trigger_decoder =
+            std::shared_ptr<I_EventDecoder<EventExtTrigger>>(),
+        uint32_t n_threads = 0, size_t chunk_size = DefaultChunkSize);
+
+    /// @brief Destructor
+    ~ParallelDecoder();
+
+    /// @brief Decodes raw data and forwards the events to the event decoders, in the order of the stream
+    ///
+    /// The data preceding the first resync point of the buffer is dropped, the same way as decoders drop the events
+    /// preceding the first time reference of a stream. Successive calls continue the timeline of the previous ones.
+    /// @param raw_data_begin Pointer on first event
+    /// @param raw_data_end Pointer after the last event
+    void decode(I_Decoder::RawData *raw_data_begin, I_Decoder::RawData *raw_data_end);
+
+    /// @brief Gets the timestamp of the last decoded event
+    /// @return Timestamp of the last event
+    timestamp get_last_timestamp() const;
+
+    /// @brief Returns true if the data is decoded concurrently, false if the format does not support it
+    bool is_parallel() const;
+
+    /// @brief Gets the number of worker threads
+    uint32_t get_n_threads() const;
+
+private:
+    struct DecodedChunk;
+
+    void forward(DecodedChunk &chunk);
+
+    const DecoderFactory decoder_factory_;
+    const bool time_shifting_enabled_;
+    std::shared_ptr<I_EventDecoder<EventCD>> cd_event_decoder_;
+    std::shared_ptr<I_EventDecoder<EventExtTrigger>> ext_trigger_event_decoder_;
+    const uint32_t n_threads_;
+    size_t chunk_size_;
+
+    // Decoder used to find the chunk boundaries and to compute the time offset of the chunks
+    std::unique_ptr<I_Decoder> probe_decoder_;
+    // Decoder used when the format does not support resynchronization
+    std::unique_ptr<I_Decoder> sequential_decoder_;
+
+    bool time_reference_set_{false};
+    timestamp time_shift_{0};
+    timestamp last_timestamp_{0};
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_HAL_PARALLEL_DECODER_H
@@ -0,0 +1,76 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_PERFORMANCE_PROFILE_H
+#define METAVISION_HAL_PERFORMANCE_PROFILE_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Metavision {
+
+class Device;
+
+/// @brief Trade-off between the latency of the events and the efficiency of their transfer, decoding and dispatch
+///
+/// A profile sets all the sizes of the batches of data and the wait strategies at once (see
+/// @ref PerformanceSettings), so that a deployment can pick a point on the trade-off without knowing them.
+enum class PerformanceProfile {
+    /// Small batches, the consumer of the data spinning rather than sleeping while waiting for the next one
+    LowLatency,
+    /// Default settings
+    Balanced,
+    /// Large batches, the consumer of the data sleeping while waiting for the next one, to save CPU and power
+    HighThroughput
+};
+
+/// @brief Settings of the batches and the wait strategies of a @ref PerformanceProfile
+struct PerformanceSettings {
+    /// Number of RAW events read at once from files (see @ref RawFileConfig::n_events_to_read_)
+    uint32_t n_events_to_read;
+
+    /// Minimum number of buffers used to read files (see @ref RawFileConfig::n_read_buffers_)
+    uint32_t n_read_buffers;
+
+    /// Number of CD events decoded before being forwarded (see @ref I_Decoder::set_cd_event_buffer_size)
+    size_t cd_event_buffer_size;
+
+    /// Number of buffers of the lock-free handoff between the data transfer and its consumer, or 0 to use the mutex
+    /// protected queue (see @ref I_EventsStream::set_lock_free_handoff)
+    size_t handoff_capacity;
+
+    /// Number of times the consumer polls the lock-free handoff before sleeping, 0 to sleep right away
+    uint32_t handoff_spin_count;
+
+    /// Duration of the batches of events decoded when replaying a file at the pace of its recording, in us
+    uint32_t replay_batch_duration_us;
+
+    /// Duration of the buffers of events produced for the processing pipelines, in us
+    uint32_t buffer_time_slice_us;
+};
+
+/// @brief Gets the settings of a performance profile
+/// @param profile Performance profile
+/// @return The settings of the profile, the ones of @ref PerformanceProfile::Balanced being the default settings
+PerformanceSettings get_performance_settings(PerformanceProfile profile);
+
+/// @brief Applies the settings of a performance profile to the facilities of a device
+///
+/// The sizes of the decoded batches and the handoff of the buffers of the events stream are set. The sizes of the
+/// reads of files are set when opening them (see @ref DeviceConfig::performance_profile_).
+/// @param device Device to configure, whose events stream must be stopped
+/// @param profile Performance profile
+/// @throw HalException with error OperationNotPermitted if the events stream is running
+void apply_performance_profile(Device &device, PerformanceProfile profile);
+
+} // namespace Metavision
+
+#endif // METAVISION_HAL_PERFORMANCE_PROFILE_H
@@ -0,0 +1,89 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_RANGED_READ_BACKEND_H
+#define METAVISION_HAL_RANGED_READ_BACKEND_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace Metavision {
+
+/// @brief Storage holding a RAW file, read by ranges of bytes at given offsets
+///
+/// A backend abstracts where the file lives (local disk, object storage...) from the @ref ReadAheadFileStream reading
+/// it, which keeps several ranged reads in flight at once ahead of the decoding position.
+class RangedReadBackend {
+public:
+    /// @brief Destructor
+    virtual ~RangedReadBackend() = default;
+
+    /// @brief Returns the location of the file, as given to @ref open
+    virtual const std::string &get_location() const = 0;
+
+    /// @brief Tells whether the file could be opened
+    virtual bool is_open() const = 0;
+
+    /// @brief Returns the size in bytes of the file, or 0 if it is not known
+    virtual uint64_t get_size() const = 0;
+
+    /// @brief Reads @p size bytes at @p offset into @p data
+    ///
+    /// This method is called concurrently by the reading threads of the @ref ReadAheadFileStream.
+    /// @param data Buffer in which to read the data, of at least @p size bytes
+    /// @param offset Offset in bytes in the file of the data to read
+    /// @param size Number of bytes to read
+    /// @return The number of bytes read, lower than @p size at the end of the file, or -1 if an error occurred
+    virtual int64_t read_at(uint8_t *data, uint64_t offset, size_t size) = 0;
+
+    /// @brief Tells whether a location is a remote file, i.e. an URL starting with "http://" or "s3://"
+    static bool is_remote(const std::string &location);
+
+    /// @brief Opens the backend reading a file
+    /// @param location Path of a local file, or URL of a remote file: "http://<host>[:<port>]/<path>" or
+    /// "s3://<bucket>/<key>" (see @ref HttpRangeBackend)
+    /// @return The backend, whose state tells whether a local file could be opened (see @ref is_open)
+    /// @throw HalException if a remote file can not be reached
+    static std::unique_ptr<RangedReadBackend> open(const std::string &location);
+};
+
+/// @brief Backend reading a file from local storage, with positional reads
+class LocalFileBackend : public RangedReadBackend {
+public:
+    /// @brief Opens the file @p filename
+    /// @param filename Path to the file to read
+    LocalFileBackend(const std::string &filename);
+
+    /// @brief Closes the file
+    ~LocalFileBackend() override;
+
+    const std::string &get_location() const override;
+    bool is_open() const override;
+    uint64_t get_size() const override;
+    int64_t read_at(uint8_t *data, uint64_t offset, size_t size) override;
+
+private:
+    const std::string filename_;
+    uint64_t file_size_ = 0;
+
+    // Native handle used for positional reads
+#ifdef _WIN32
+    void *file_ = nullptr;
+#else
+    int fd_ = -1;
+#endif
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_HAL_RANGED_READ_BACKEND_H
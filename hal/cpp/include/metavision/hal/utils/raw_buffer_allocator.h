@@ -0,0 +1,104 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_RAW_BUFFER_ALLOCATOR_H
+#define METAVISION_HAL_RAW_BUFFER_ALLOCATOR_H
+
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <utility>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+namespace Metavision {
+
+/// @brief Allocator of buffers of raw data, aligned in memory and not initialized when resized
+///
+/// Used with a std::vector, it makes resize() leave the new elements uninitialized instead of zeroing them, which
+/// avoids touching the memory of a buffer before it is filled with data, and aligns the data on @p Alignment bytes
+/// (e.g. for SIMD loads in the decoders, or page aligned I/O).
+/// @tparam T Type of the elements, which must be trivial for the default initialization to leave them uninitialized
+/// @tparam Alignment Alignment in bytes of the allocated memory, a power of 2
+template<typename T, size_t Alignment = 64>
+class RawBufferAllocator {
+public:
+    static_assert(Alignment >= alignof(T) && (Alignment & (Alignment - 1)) == 0,
+                  "The alignment must be a power of 2, at least the alignment of the type.");
+
+    using value_type = T;
+
+    template<typename U>
+    struct rebind {
+        using other = RawBufferAllocator<U, Alignment>;
+    };
+
+    RawBufferAllocator() = default;
+
+    template<typename U>
+    RawBufferAllocator(const RawBufferAllocator<U, Alignment> &) {}
+
+    T *allocate(size_t n) {
+        if (n > std::numeric_limits<size_t>::max() / sizeof(T)) {
+            throw std::bad_alloc();
+        }
+        // The size is rounded up to a multiple of the alignment, as required by aligned_alloc
+        const size_t size = ((n * sizeof(T) + Alignment - 1) / Alignment) * Alignment;
+        void *p           = nullptr;
+#ifdef _WIN32
+        p = _aligned_malloc(size, Alignment);
+#else
+        if (posix_memalign(&p, Alignment, size) != 0) {
+            p = nullptr;
+        }
+#endif
+        if (!p) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T *>(p);
+    }
+
+    void deallocate(T *p, size_t) noexcept {
+#ifdef _WIN32
+        _aligned_free(p);
+#else
+        free(p);
+#endif
+    }
+
+    /// @brief Default initializes an element, which leaves a trivial type uninitialized
+    template<typename U>
+    void construct(U *p) noexcept(std::is_nothrow_default_constructible<U>::value) {
+        ::new (static_cast<void *>(p)) U;
+    }
+
+    template<typename U, typename... Args>
+    void construct(U *p, Args &&...args) {
+        ::new (static_cast<void *>(p)) U(std::forward<Args>(args)...);
+    }
+};
+
+template<typename T, typename U, size_t Alignment>
+bool operator==(const RawBufferAllocator<T, Alignment> &, const RawBufferAllocator<U, Alignment> &) {
+    return true;
+}
+
+template<typename T, typename U, size_t Alignment>
+bool operator!=(const RawBufferAllocator<T, Alignment> &, const RawBufferAllocator<U, Alignment> &) {
+    return false;
+}
+
+} // namespace Metavision
+
+#endif // METAVISION_HAL_RAW_BUFFER_ALLOCATOR_H
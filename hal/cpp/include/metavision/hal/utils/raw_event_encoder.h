@@ -0,0 +1,84 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_RAW_EVENT_ENCODER_H
+#define METAVISION_HAL_RAW_EVENT_ENCODER_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/base/events/event_ext_trigger.h"
+#include "metavision/sdk/base/utils/timestamp.h"
+
+namespace Metavision {
+
+class RawFileHeader;
+
+/// @brief Encodes events into RAW data, the reverse operation of an @ref I_Decoder
+///
+/// The data is encoded as a sensor would do, so that it can be decoded by the decoders of the format, sequentially
+/// or concurrently with a @ref ParallelDecoder. The encoder keeps the time base of the stream between successive calls
+/// to @ref encode, which must be given events of increasing timestamps.
+class RawEventEncoder {
+public:
+    /// @brief Creates the encoder of a format
+    /// @param format Name of the format, either "EVT2" or "EVT3"
+    /// @return The encoder of the format
+    /// @throw HalException with error InvalidArgument if the format is not supported
+    static std::unique_ptr<RawEventEncoder> create(const std::string &format);
+
+    /// @brief Destructor
+    virtual ~RawEventEncoder();
+
+    /// @brief Gets the name of the format of the encoded data
+    virtual std::string get_format() const = 0;
+
+    /// @brief Gets the size of a raw event in bytes
+    virtual uint8_t get_raw_event_size_bytes() const = 0;
+
+    /// @brief Records the format of the encoded data in the header of a RAW file
+    ///
+    /// The format is set in the "format" field if the header has one, keeping its other properties (e.g. the size of
+    /// the sensor), and in the legacy "evt" field otherwise.
+    /// @param header Header of the RAW file
+    void set_header_format(RawFileHeader &header) const;
+
+    /// @brief Encodes CD and trigger events, merged by timestamp, and appends the encoded data to a buffer
+    ///
+    /// The CD events precede the trigger events of the same timestamp.
+    /// @param cd_begin Pointer on the first CD event
+    /// @param cd_end Pointer after the last CD event
+    /// @param trigger_begin Pointer on the first trigger event
+    /// @param trigger_end Pointer after the last trigger event
+    /// @param output Buffer to which the encoded data is appended
+    void encode(const EventCD *cd_begin, const EventCD *cd_end, const EventExtTrigger *trigger_begin,
+                const EventExtTrigger *trigger_end, std::vector<uint8_t> &output);
+
+    /// @brief Forgets the time base of the stream, the next encoded data being the beginning of a new stream
+    void reset();
+
+protected:
+    /// @brief Encodes CD events of increasing timestamps
+    virtual void encode_cd(const EventCD *begin, const EventCD *end, std::vector<uint8_t> &output) = 0;
+
+    /// @brief Encodes a trigger event, not older than the events already encoded
+    virtual void encode_trigger(const EventExtTrigger &ev, std::vector<uint8_t> &output) = 0;
+
+    /// @brief The implementation of @ref reset
+    virtual void reset_impl() = 0;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_HAL_RAW_EVENT_ENCODER_H
@@ -0,0 +1,103 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_RAW_FILE_CHECKSUMS_H
+#define METAVISION_HAL_RAW_FILE_CHECKSUMS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Metavision {
+
+/// @brief Computes the CRC32C (Castagnoli) checksum of a buffer
+///
+/// The CRC32 instructions of the CPU are used when the code is compiled for them (SSE 4.2 on x86, the CRC extension on
+/// ARMv8), a table based implementation otherwise.
+/// @param data Pointer to the first byte of the buffer
+/// @param size Size of the buffer, in bytes
+/// @param crc Checksum of the preceding data, to compute the checksum of data given in several parts
+/// @return The checksum of the preceding data followed by the buffer
+uint32_t crc32c(const void *data, size_t size, uint32_t crc = 0);
+
+/// @brief Checksums of the chunks of a RAW file, to detect its corruption without decoding it
+///
+/// The file is split in chunks of @ref get_chunk_size bytes, header included, the last one being possibly smaller, and
+/// the CRC32C of each chunk is kept. The checksums are computed while the file is written (see
+/// @ref AsyncRawFileWriterConfig::checksum_chunk_size_) and stored in a sidecar file (see @ref get_sidecar_path), so
+/// that the file can be checked at the speed of the disk with @ref verify.
+class RawFileChecksums {
+public:
+    /// @brief Default size of the chunks, in bytes
+    static constexpr uint64_t DefaultChunkSize = 4 * 1024 * 1024;
+
+    /// @brief Builds empty checksums
+    /// @param chunk_size Size of the chunks, in bytes
+    explicit RawFileChecksums(uint64_t chunk_size = DefaultChunkSize);
+
+    /// @brief Computes the checksums of an existing file
+    /// @param raw_file Path of the file
+    /// @param chunk_size Size of the chunks, in bytes
+    /// @return The checksums
+    /// @throw HalException if the file can not be read
+    static RawFileChecksums compute(const std::string &raw_file, uint64_t chunk_size = DefaultChunkSize);
+
+    /// @brief Gets the path of the sidecar file in which the checksums of a RAW file are stored
+    /// @param raw_file Path of the RAW file
+    /// @return The path of the checksums
+    static std::string get_sidecar_path(const std::string &raw_file);
+
+    /// @brief Adds data following the one already added, updating the checksums of the chunks
+    /// @param data Pointer to the first byte of the data
+    /// @param size Size of the data, in bytes
+    void add_data(const void *data, size_t size);
+
+    /// @brief Loads checksums from a file
+    /// @param path Path of the checksums
+    /// @return true if the checksums have been loaded, false if the file could not be read or is not valid
+    bool load(const std::string &path);
+
+    /// @brief Saves the checksums to a file
+    /// @param path Path of the checksums
+    /// @return true if the checksums have been saved, false otherwise
+    bool save(const std::string &path) const;
+
+    /// @brief Checks a file against the checksums, reading its chunks in parallel
+    /// @param raw_file Path of the file
+    /// @param n_threads Number of threads reading the chunks, 0 for the number of cores
+    /// @return The indices of the chunks whose content differs, in increasing order. The chunks that are missing
+    /// because the file is truncated are included, and so is the last chunk if the file is longer than expected
+    /// @throw HalException if the file can not be read
+    std::vector<size_t> verify(const std::string &raw_file, unsigned int n_threads = 0) const;
+
+    /// @brief Gets the size of the chunks, in bytes
+    uint64_t get_chunk_size() const;
+
+    /// @brief Gets the number of bytes of data the checksums have been computed on
+    uint64_t get_raw_file_size() const;
+
+    /// @brief Gets the checksums of the chunks, the last one being the one of the chunk being filled, if any
+    std::vector<uint32_t> get_checksums() const;
+
+private:
+    uint64_t chunk_size_;
+    uint64_t raw_file_size_ = 0;
+    std::vector<uint32_t> checksums_; // Checksums of the complete chunks
+
+    // Checksum and size of the chunk being filled
+    uint32_t current_crc_  = 0;
+    uint64_t current_size_ = 0;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_HAL_RAW_FILE_CHECKSUMS_H
@@ -16,6 +16,7 @@
 #include <cstdint>
 
 #include "metavision/hal/utils/device_config.h"
+#include "metavision/sdk/base/utils/memory_placement.h"
 
 namespace Metavision {
 
@@ -27,6 +28,13 @@ public:
     /// @warning sizeof(RAW_event) is defined by the events format contained in the RAW file read.
     uint32_t n_events_to_read_ = 1000000;
 
+    /// Duration of data to read at each read, in us. If not 0, the size of the reads is adapted to the rate of the
+    /// events, estimated from the timestamps decoded, so that each buffer holds about this duration of data whether
+    /// the scene is quiet or busy. @ref n_events_to_read_ is then the maximum number of RAW events read at once.
+    /// This mode is only available when opening a file (see @ref DeviceDiscovery::open_raw_file) with a plugin reading
+    /// it through a @ref FileDataTransfer.
+    uint32_t n_us_to_read_ = 0;
+
     /// The maximum number of buffers to allocate and use for reading. Each buffer contains at most @ref
     /// n_events_to_read_ RAW events. The maximum memory allocated to read the RAW file will be read_buffers_count_ *
     /// n_events_to_read_ * sizeof(RAW_event). One can use this parameters to have a finer control on offline memory
@@ -35,6 +43,44 @@ public:
 
     /// Take the first timer high of the file as origin of time
     bool do_time_shifting_ = true;
+
+    /// Map the RAW file in memory instead of reading it through a standard file stream.
+    /// When enabled, the buffers given to the decoder point directly into the mapped file (no copy is done) and
+    /// @ref n_read_buffers_ is not used. This mode is only available when opening a file from its path
+    /// (see @ref DeviceDiscovery::open_raw_file); it silently falls back to standard reading if the file can not be
+    /// mapped.
+    /// @warning The buffers are not guaranteed to be aligned on the size of a RAW event
+    bool use_memory_mapping_ = false;
+
+    /// Number of reads kept in flight at once when reading the RAW file, to saturate fast storage devices or hide the
+    /// latency of remote storages. A value of 0 or 1 reads the file sequentially, except for remote files. At most
+    /// @ref n_read_buffers_ - 1 reads are in flight, so @ref n_read_buffers_ should be increased accordingly. This mode
+    /// is only available when opening a file from its path (see @ref DeviceDiscovery::open_raw_file) and is not used
+    /// with @ref use_memory_mapping_
+    uint32_t n_reads_in_flight_ = 0;
+
+    /// Build the index of the timestamps of the RAW file if it has none, to seek in it (see @ref I_EventsStream::seek).
+    /// The index is stored in a sidecar file next to the RAW file (see @ref RawFileIndex::get_sidecar_path), which is
+    /// loaded, when up to date, whenever the file is opened from its path (see @ref DeviceDiscovery::open_raw_file).
+    /// Building it requires decoding the whole file once, when opening it.
+    bool build_index_ = false;
+
+    /// Maximum number of chunks of a compressed RAW file (see @ref RawCompression) decompressed concurrently, ahead of
+    /// the reading position. If 0, the number of cores is used. The compression is detected from the header of the
+    /// file, this setting is not used for uncompressed files.
+    uint32_t n_decompression_threads_ = 0;
+
+    /// Placement of the memory of the buffers in which the RAW file is read, e.g. on the NUMA node of the thread
+    /// decoding them (see @ref DataTransfer::set_memory_placement). The default placement leaves the memory as
+    /// allocated by the system. This setting is not used with @ref use_memory_mapping_, the data being then read from
+    /// the mapping.
+    MemoryPlacement memory_placement_;
+
+    /// Go back to the beginning of the data of the RAW file when reaching its end, instead of ending the stream.
+    /// The file is not reopened: the stream is rewound right after its header, and the decoding resumes with timestamps
+    /// following the last one decoded (see @ref I_EventsStream::follow_loops), so that the replay goes on seamlessly.
+    /// This setting is not used for streams that can not be rewound (e.g. shared memory or network streams).
+    bool loop_ = false;
 };
 
 } // namespace Metavision
@@ -0,0 +1,109 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_RAW_FILE_INDEX_H
+#define METAVISION_HAL_RAW_FILE_INDEX_H
+
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+
+#include "metavision/sdk/base/utils/timestamp.h"
+
+namespace Metavision {
+
+class I_Decoder;
+
+/// @brief Index of the timestamps of a RAW file, mapping them to the byte offsets of resync points
+///
+/// An entry is recorded at most every @ref get_period microseconds of data, at a resync point of the format (see
+/// @ref I_Decoder::find_resync_point), along with the timestamp needed to reset a decoder there (see
+/// @ref I_Decoder::reset_last_timestamp). Finding the position to decode from to reach a timestamp is then a binary
+/// search, see @ref find and @ref I_EventsStream::seek.
+/// The timestamps of the index are not shifted, i.e. they are the ones of a decoder with time shifting disabled.
+class RawFileIndex {
+public:
+    /// @brief Entry of the index
+    struct Entry {
+        /// Timestamp of the last event preceding the resync point, or for the first entry, the time base set by the
+        /// resync point
+        timestamp timestamp_;
+
+        /// Offset of the resync point, in bytes from the beginning of the file
+        uint64_t offset_;
+    };
+
+    /// @brief Default period of the entries, in us
+    static constexpr timestamp DefaultPeriod = 50000;
+
+    /// @brief Builds an empty index
+    RawFileIndex() = default;
+
+    /// @brief Builds the index of a stream of RAW data by decoding it entirely
+    /// @param stream Stream of RAW data, positioned at the beginning of the data (i.e. after the header)
+    /// @param decoder Decoder of the format of the data, with time shifting disabled, that has not decoded any data
+    /// @param period Minimal time between two entries, in us
+    /// @return The index, which is empty if the format does not support resynchronization
+    static RawFileIndex build(std::istream &stream, I_Decoder &decoder, timestamp period = DefaultPeriod);
+
+    /// @brief Gets the path of the sidecar file in which the index of a RAW file is stored
+    /// @param raw_file Path of the RAW file
+    /// @return The path of the index
+    static std::string get_sidecar_path(const std::string &raw_file);
+
+    /// @brief Loads an index from a file
+    /// @param path Path of the index
+    /// @return true if the index has been loaded, false if the file could not be read or is not a valid index
+    bool load(const std::string &path);
+
+    /// @brief Loads an index from a stream, e.g. reading a sidecar file stored remotely
+    /// @param stream Stream of the index, positioned at its beginning
+    /// @return true if the index has been loaded, false if the stream could not be read or is not a valid index
+    bool load(std::istream &stream);
+
+    /// @brief Saves the index to a file
+    /// @param path Path of the index
+    /// @return true if the index has been saved, false otherwise
+    bool save(const std::string &path) const;
+
+    /// @brief Finds the entry from which to decode to get all the events from a timestamp
+    ///
+    /// This is the last entry preceding the timestamp, or the first one if the timestamp is before it.
+    /// @param t Timestamp to reach, not shifted
+    /// @return The entry found
+    /// @warning The index must not be empty
+    const Entry &find(timestamp t) const;
+
+    /// @brief Returns true if the index has no entry
+    bool empty() const;
+
+    /// @brief Gets the entries of the index, ordered by timestamp
+    const std::vector<Entry> &get_entries() const;
+
+    /// @brief Gets the timestamp of the first time base of the data, used as time shift by decoders
+    timestamp get_first_timestamp() const;
+
+    /// @brief Gets the minimal time between two entries, in us
+    timestamp get_period() const;
+
+    /// @brief Gets the size of the RAW file indexed, in bytes, which is used to check that an index is up to date
+    uint64_t get_raw_file_size() const;
+
+private:
+    std::vector<Entry> entries_;
+    timestamp period_{DefaultPeriod};
+    uint64_t raw_file_size_{0};
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_HAL_RAW_FILE_INDEX_H
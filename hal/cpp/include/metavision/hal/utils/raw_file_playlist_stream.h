@@ -0,0 +1,74 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_RAW_FILE_PLAYLIST_STREAM_H
+#define METAVISION_HAL_RAW_FILE_PLAYLIST_STREAM_H
+
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Metavision {
+
+/// @brief Input stream chaining several RAW files, e.g. the parts of a recording split by time or size, into one
+/// continuous stream of RAW data
+///
+/// The stream holds the header of the first file, followed by the data of all the files in order, without their
+/// headers. Since the data of the files is not altered, the decoder keeps its state from one file to the next, and the
+/// timestamps are continuous when the files are consecutive parts of a recording.
+///
+/// The headers of all the files are checked when the stream is built. While a file is read, the first bytes of the
+/// next one are prefetched in the background, so that the transition between files does not stall the reading.
+class RawFilePlaylistStream : public std::istream {
+public:
+    /// @brief Builds the stream reading the files in order
+    /// @param raw_files Paths of the RAW files
+    /// @param prefetch_size Number of bytes of the next file read in the background while a file is read
+    /// @throw HalException if no file is given, if a file can not be read or is compressed, or if the header of a file
+    /// differs from the one of the first file (except for its date)
+    RawFilePlaylistStream(const std::vector<std::string> &raw_files, size_t prefetch_size = 4 * 1024 * 1024);
+
+    /// @brief Builds the stream reading a recording striped across several files by a @ref StripedRawFileWriter
+    ///
+    /// The stripes are read in turn from each of the files, the next stripe, hence the next file, being prefetched
+    /// while a stripe is read.
+    /// @param manifest_path Path of the manifest of the striped recording
+    /// @param prefetch_size Number of bytes of the next stripe read in the background while a stripe is read
+    /// @return The stream holding the header of the first stripe file followed by the data of the recording
+    /// @throw HalException if the manifest or a stripe file can not be read, or if the headers of the stripe files
+    /// differ
+    static std::unique_ptr<RawFilePlaylistStream> open_stripes(const std::string &manifest_path,
+                                                               size_t prefetch_size = 4 * 1024 * 1024);
+
+    /// @brief Destructor
+    ~RawFilePlaylistStream();
+
+    /// @brief Returns the paths of the RAW files read, or of the stripe files for a striped recording
+    const std::vector<std::string> &get_raw_files() const;
+
+    /// @brief Returns the size in bytes of the stream, i.e. of the header of the first file and of the data of all the
+    /// files
+    uint64_t size() const;
+
+private:
+    class PlaylistStreamBuf;
+
+    RawFilePlaylistStream(const std::vector<std::string> &raw_files, std::unique_ptr<PlaylistStreamBuf> streambuf);
+
+    std::vector<std::string> raw_files_;
+    std::unique_ptr<PlaylistStreamBuf> streambuf_;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_HAL_RAW_FILE_PLAYLIST_STREAM_H
@@ -0,0 +1,145 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_RAW_FLIGHT_RECORDER_H
+#define METAVISION_HAL_RAW_FLIGHT_RECORDER_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "metavision/hal/utils/async_raw_file_writer.h"
+#include "metavision/hal/utils/data_transfer.h"
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/base/events/event_ext_trigger.h"
+
+namespace Metavision {
+
+/// @brief Configuration of a @ref RawFlightRecorder
+struct RawFlightRecorderConfig {
+    /// Duration of the data kept in memory, and written to a file before the time of a trigger
+    uint32_t pre_trigger_ms_ = 5000;
+    /// Duration of the data written to a file after the time of a trigger
+    uint32_t post_trigger_ms_ = 2000;
+    /// Maximum number of bytes of data kept in memory, the oldest data being dropped beyond, whatever its age
+    size_t max_bytes_ = 512 * 1024 * 1024;
+    /// Path of the files written for the triggers without file name, to which "_<index of the dump>.raw" is appended
+    std::string dump_basename_ = "flight_recording";
+    /// Channel of the external triggers whose rising edges trigger a dump (see
+    /// @ref RawFlightRecorder::add_ext_triggers), or -1 for any channel
+    int ext_trigger_channel_ = -1;
+    /// Rate of CD events, in events per second, above which a dump is triggered (see
+    /// @ref RawFlightRecorder::add_cd_events). 0 disables this trigger
+    double event_rate_threshold_ = 0;
+    /// Duration in us of the time windows, in the time of the events, in which the rate of the CD events is measured
+    uint32_t event_rate_window_us_ = 10000;
+    /// Configuration of the writers of the files
+    AsyncRawFileWriterConfig writer_config_;
+};
+
+/// @brief Keeps the last seconds of RAW data in memory, and writes them to a file around the time of triggers
+///
+/// The buffers given to @ref add_data are not copied: a reference on them is kept as long as they are younger than
+/// @ref RawFlightRecorderConfig::pre_trigger_ms_, according to their arrival time on the host. When a dump is
+/// triggered, the buffers held are written to a new RAW file, followed by the buffers added until
+/// @ref RawFlightRecorderConfig::post_trigger_ms_ after the trigger, by an @ref AsyncRawFileWriter.
+///
+/// A dump is triggered by calling @ref trigger, or from the events decoded from the data: a rising edge of an external
+/// trigger, or a rate of CD events above a threshold. A trigger during a dump extends it instead of starting another
+/// one.
+///
+/// All the functions can be called from any thread.
+/// @warning The buffers come from the pool of the data transfer, which must be able to provide enough buffers for the
+/// data held, see @ref DataTransfer::set_elastic_buffering
+class RawFlightRecorder {
+public:
+    /// @brief Constructor
+    /// @param header Bytes written at the beginning of each file (e.g. the RAW file header)
+    /// @param config Configuration of the recorder
+    RawFlightRecorder(const std::string &header, const RawFlightRecorderConfig &config = RawFlightRecorderConfig());
+
+    /// @brief Destructor, writing the data of the dump in progress if any, up to the last buffer added
+    ~RawFlightRecorder();
+
+    /// @brief Adds a buffer of data, which is kept in memory and written to the file of the dump in progress if any
+    /// @param slice Buffer of data
+    void add_data(const DataTransfer::BufferSlice &slice);
+
+    /// @brief Triggers a dump to a file
+    /// @param filename Path of the file to write
+    /// @return true if a dump has been started, false if the dump in progress has been extended instead, or if the
+    /// file could not be opened
+    bool trigger(const std::string &filename);
+
+    /// @brief Triggers a dump to a file named after @ref RawFlightRecorderConfig::dump_basename_
+    /// @return The path of the file written, or an empty string if the dump in progress has been extended instead, or
+    /// if the file could not be opened
+    std::string trigger();
+
+    /// @brief Triggers a dump on each rising edge of the external trigger channel of the configuration
+    ///
+    /// This function is meant to be called with the events decoded from the data added, e.g. from a callback of the
+    /// decoder of external triggers.
+    /// @param begin Pointer to the first event
+    /// @param end Pointer after the last event
+    void add_ext_triggers(const EventExtTrigger *begin, const EventExtTrigger *end);
+
+    /// @brief Triggers a dump when the rate of the CD events exceeds the threshold of the configuration
+    ///
+    /// This function is meant to be called with the events decoded from the data added, e.g. from a callback of the
+    /// decoder of CD events. It does nothing if @ref RawFlightRecorderConfig::event_rate_threshold_ is 0.
+    /// @param begin Pointer to the first event
+    /// @param end Pointer after the last event
+    void add_cd_events(const EventCD *begin, const EventCD *end);
+
+    /// @brief Returns true if a dump is in progress
+    bool is_dumping() const;
+
+    /// @brief Gets the number of dumps started so far
+    uint32_t get_num_dumps() const;
+
+    /// @brief Gets the number of bytes of data held in memory
+    size_t get_buffered_bytes() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    bool start_dump(const std::string &filename);
+    void finish_dump();
+
+    const std::string header_;
+    const RawFlightRecorderConfig config_;
+
+    mutable std::mutex mutex_;
+    std::deque<DataTransfer::BufferSlice> slices_;
+    size_t buffered_bytes_ = 0;
+    Clock::time_point last_arrival_time_;
+
+    std::unique_ptr<AsyncRawFileWriter> writer_;
+    Clock::time_point dump_end_time_;
+    uint32_t num_dumps_ = 0;
+    // Closes the file of the last dump, so that the pending data is not written by the thread adding data
+    std::thread closing_thread_;
+
+    // Measure of the rate of the CD events
+    bool rate_window_started_    = false;
+    timestamp rate_window_start_ = 0;
+    size_t rate_window_count_    = 0;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_HAL_RAW_FLIGHT_RECORDER_H
@@ -0,0 +1,101 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_READ_AHEAD_FILE_STREAM_H
+#define METAVISION_HAL_READ_AHEAD_FILE_STREAM_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "metavision/hal/utils/data_transfer.h"
+#include "metavision/hal/utils/ranged_read_backend.h"
+
+namespace Metavision {
+
+/// @brief Input file stream able to keep several reads of the file in flight at once
+///
+/// The stream can be used as any other file stream (for example to parse the header of a RAW file). Additionally,
+/// reads at given offsets can be submitted with @ref submit: they are executed concurrently by a pool of reading
+/// threads and their results are retrieved in submission order with @ref wait_next. Keeping several reads
+/// outstanding is needed to saturate fast storage devices (e.g. NVMe drives or arrays), and to hide the latency of
+/// remote storages (see @ref RangedReadBackend).
+class ReadAheadFileStream : public std::istream {
+public:
+    /// @brief Opens the local file @p filename
+    /// @param filename Path to the file to read
+    /// @param n_reads_in_flight Maximum number of reads executed concurrently
+    /// @note As for std::ifstream, the state of the stream tells whether the file could be opened
+    ReadAheadFileStream(const std::string &filename, uint32_t n_reads_in_flight);
+
+    /// @brief Reads the file of a storage backend
+    /// @param backend Backend reading the file
+    /// @param n_reads_in_flight Maximum number of reads executed concurrently
+    /// @note The state of the stream tells whether the backend could open the file
+    ReadAheadFileStream(std::unique_ptr<RangedReadBackend> backend, uint32_t n_reads_in_flight);
+
+    /// @brief Waits for the submitted reads to be done, then closes the file
+    ~ReadAheadFileStream();
+
+    /// @brief Returns the maximum number of reads executed concurrently
+    uint32_t get_n_reads_in_flight() const;
+
+    /// @brief Returns the size in bytes of the file, or 0 if it is not known
+    uint64_t get_file_size() const;
+
+    /// @brief Returns the backend reading the file
+    RangedReadBackend &get_backend() const;
+
+    /// @brief Submits a read of @p size bytes at @p offset into @p buffer
+    ///
+    /// This method does not block: the read is done by one of the reading threads.
+    /// @param buffer Buffer in which to read the data, resized to the number of bytes actually read. It must not be
+    /// accessed until it is returned by @ref wait_next
+    /// @param offset Offset in bytes in the file of the data to read
+    /// @param size Number of bytes to read
+    void submit(const DataTransfer::BufferPtr &buffer, uint64_t offset, size_t size);
+
+    /// @brief Returns the number of reads submitted and not retrieved yet with @ref wait_next
+    size_t get_n_pending_reads() const;
+
+    /// @brief Waits for the oldest submitted read to be done and returns its buffer
+    /// @return The buffer given to @ref submit, resized to the number of bytes read (0 at the end of the file or if an
+    /// error occurred). nullptr if no read is pending
+    DataTransfer::BufferPtr wait_next();
+
+private:
+    struct Read;
+    class BackendStreamBuf;
+
+    void run_reading_thread();
+
+    std::unique_ptr<RangedReadBackend> backend_;
+    std::unique_ptr<BackendStreamBuf> streambuf_;
+    const uint32_t n_reads_in_flight_;
+
+    mutable std::mutex reads_mutex_;
+    std::condition_variable reads_cond_;
+    std::deque<std::shared_ptr<Read>> pending_reads_;  // in submission order, owned by the consumer
+    std::deque<std::shared_ptr<Read>> reads_to_start_; // waiting for a reading thread
+    bool stop_reading_threads_ = false;
+    std::vector<std::thread> reading_threads_;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_HAL_READ_AHEAD_FILE_STREAM_H
@@ -0,0 +1,90 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_RESYNC_DECODER_H
+#define METAVISION_HAL_RESYNC_DECODER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "metavision/sdk/base/utils/timestamp.h"
+#include "metavision/hal/facilities/i_decoder.h"
+
+namespace Metavision {
+
+/// @brief Configuration of a @ref ResyncDecoder
+struct ResyncDecoderConfig {
+    /// @brief Largest forward jump between two consecutive time bases of a valid stream, in us
+    timestamp max_time_jump_ = 100000;
+
+    /// @brief Number of consistent time bases that must follow a resync point for the decoding to resume from it
+    uint32_t n_confirmations_ = 4;
+};
+
+/// @brief Decodes RAW data, skipping the corrupted or truncated parts of the stream
+///
+/// The time bases of the stream (see @ref I_Decoder::find_time_base) are checked before the data reaches the decoder:
+/// each of them must follow the previous one by at most @ref ResyncDecoderConfig::max_time_jump_. When one does not,
+/// the data is considered corrupted from there and is skipped. It is scanned forward, at every byte offset since the
+/// corruption can shift the alignment of the raw events, for a resync point (see @ref I_Decoder::find_resync_point)
+/// followed by consistent time bases. The decoder is then reset and the decoding resumes from that point, so that the
+/// corruption does not derail the time tracking of the decoder for the rest of the stream.
+/// The events decoded before a corruption is detected are forwarded as is.
+/// If the format does not support resynchronization, the data is decoded without being checked.
+class ResyncDecoder {
+public:
+    /// @brief Constructor
+    /// @param decoder Decoder of the format of the data, it must outlive this object
+    /// @param config Configuration of the checks of the stream
+    ResyncDecoder(I_Decoder &decoder, const ResyncDecoderConfig &config = ResyncDecoderConfig());
+
+    /// @brief Checks and decodes raw data, successive calls being expected to pass consecutive buffers of a stream
+    ///
+    /// While resynchronizing, the data is buffered until a resync point is confirmed, or dropped.
+    /// @param raw_data_begin Pointer on first event
+    /// @param raw_data_end Pointer after the last event
+    void decode(I_Decoder::RawData *raw_data_begin, I_Decoder::RawData *raw_data_end);
+
+    /// @brief Returns true if a corruption has been detected and no resync point has been confirmed since
+    bool is_resyncing() const;
+
+    /// @brief Gets the number of corruptions detected in the stream
+    size_t get_corruption_count() const;
+
+    /// @brief Gets the number of bytes skipped because they were corrupted
+    uint64_t get_skipped_bytes() const;
+
+private:
+    void decode_checked(I_Decoder::RawData *raw_data_begin, I_Decoder::RawData *raw_data_end);
+    bool resync();
+    bool is_consistent(timestamp previous_time_base, timestamp time_base) const;
+
+    I_Decoder &decoder_;
+    const ResyncDecoderConfig config_;
+    const size_t raw_event_size_;
+    const timestamp time_base_period_;
+
+    bool has_time_base_{false};
+    timestamp time_base_{0};
+    // Number of bytes passed to the decoder, modulo the size of a raw event
+    size_t raw_event_offset_{0};
+
+    bool resyncing_{false};
+    std::vector<I_Decoder::RawData> resync_data_;
+
+    size_t corruption_count_{0};
+    uint64_t skipped_bytes_{0};
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_HAL_RESYNC_DECODER_H
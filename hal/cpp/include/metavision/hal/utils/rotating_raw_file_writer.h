@@ -0,0 +1,124 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_ROTATING_RAW_FILE_WRITER_H
+#define METAVISION_HAL_ROTATING_RAW_FILE_WRITER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "metavision/hal/utils/async_raw_file_writer.h"
+#include "metavision/hal/utils/data_transfer.h"
+
+namespace Metavision {
+
+/// @brief Configuration of a @ref RotatingRawFileWriter
+struct RawFileRotationConfig {
+    /// Path of the files, to which "_<index of the file>.raw" is appended, the index being written on 4 digits
+    std::string basename_ = "recording";
+    /// Number of bytes of data, header excluded, above which the next buffer is written to a new file. Buffers are
+    /// never split, so a file can exceed this size by less than a buffer. 0 disables this policy
+    uint64_t max_file_size_ = 0;
+    /// Duration in milliseconds, according to the host clock, above which the next buffer is written to a new file.
+    /// 0 disables this policy
+    uint32_t max_file_duration_ms_ = 0;
+    /// Configuration of the writers of the files
+    AsyncRawFileWriterConfig writer_config_;
+};
+
+/// @brief Writes RAW data to a sequence of files, switching to the next one without stalling nor losing data
+///
+/// Each file is written by an @ref AsyncRawFileWriter. The next file of the sequence is opened and its header
+/// written in advance by a background thread, so that switching to it in @ref write is a mere swap of writers. The
+/// writer of the previous file is then closed by the background thread as well, which writes its pending buffers.
+/// Switching files happens between two buffers: each buffer given to @ref write is written once, in a single file.
+///
+/// If the next file is not ready yet when a switch is due (e.g. because it could not be opened), the buffers keep on
+/// being written to the current file.
+///
+/// @ref write must be called from a single thread, the other functions can be called from any thread.
+class RotatingRawFileWriter {
+public:
+    /// @brief Builds the header of a file
+    /// @param index Index of the file in the sequence
+    using HeaderBuilder = std::function<std::string(size_t index)>;
+
+    /// @brief Opens the first file, and starts preparing the next one
+    /// @param header_builder Builds the bytes written at the beginning of each file (e.g. the RAW file header). It is
+    /// called from the background thread for all the files but the first one
+    /// @param config Configuration of the writer
+    /// @throw HalException if the first file could not be opened
+    RotatingRawFileWriter(const HeaderBuilder &header_builder,
+                          const RawFileRotationConfig &config = RawFileRotationConfig());
+
+    /// @brief Writes all the pending buffers, then closes the current file. The file prepared in advance is removed
+    ~RotatingRawFileWriter();
+
+    /// @brief Queues a buffer for writing, after switching to the next file if the rotation policy or
+    /// @ref request_rotation requires it
+    /// @param slice Buffer to write, a reference on it is kept until it has been written
+    void write(const DataTransfer::BufferSlice &slice);
+
+    /// @brief Requests to switch to the next file before writing the next buffer, whatever the rotation policy
+    void request_rotation();
+
+    /// @brief Gets the paths of the files written so far, the current one last
+    std::vector<std::string> get_filenames() const;
+
+    /// @brief Gets the number of buffers queued and not written yet to the current file
+    size_t get_queue_depth() const;
+
+    /// @brief Gets the number of bytes queued and not written yet to the current file
+    size_t get_bytes_behind() const;
+
+    /// @brief Gets the path of the file of index @p index in the sequence of files written with @p config
+    static std::string get_filename(const RawFileRotationConfig &config, size_t index);
+
+private:
+    bool rotation_due(size_t size) const;
+    void run();
+
+    HeaderBuilder header_builder_;
+    RawFileRotationConfig config_;
+
+    // Only modified by the thread calling write, with mutex_ locked
+    std::unique_ptr<AsyncRawFileWriter> current_;
+    // Only accessed from the thread calling write
+    uint64_t current_bytes_ = 0;
+    std::chrono::steady_clock::time_point current_start_;
+
+    std::atomic<bool> rotation_requested_{false};
+
+    mutable std::mutex mutex_;
+    std::condition_variable cond_;
+    // File opened in advance, and writers of the previous files to close, handled by the background thread
+    std::unique_ptr<AsyncRawFileWriter> next_;
+    std::vector<std::unique_ptr<AsyncRawFileWriter>> retired_;
+    std::vector<std::string> filenames_;
+    size_t next_index_ = 1;
+    bool next_failed_  = false;
+    bool stopping_     = false;
+
+    std::thread thread_;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_HAL_ROTATING_RAW_FILE_WRITER_H
@@ -0,0 +1,178 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_SHARED_MEMORY_BUFFER_POOL_H
+#define METAVISION_HAL_SHARED_MEMORY_BUFFER_POOL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "metavision/hal/utils/data_transfer.h"
+
+namespace Metavision {
+
+namespace detail {
+class SharedMemoryMapping;
+} // namespace detail
+
+/// @brief Configuration of a @ref SharedMemoryBufferPool
+struct SharedMemoryBufferPoolConfig {
+    /// Number of slabs of the pool
+    uint32_t n_slabs_ = 64;
+
+    /// Size of a slab in bytes, a multiple of 64
+    uint64_t slab_size_bytes_ = 4 * 1024 * 1024;
+};
+
+/// @brief Pool of buffers in shared memory, to hand data (e.g. decoded events) over to other processes without copy
+///
+/// A process writes data in a slab of the pool (see @ref write) and sends the @ref Handle of the slab, a few bytes, to
+/// other processes, which map the same memory (see @ref get_slice). The slabs are reference counted across processes:
+/// each handle sent to a process carries one reference (see @ref add_reference), that the receiving process releases
+/// when it is done with the data. A slab is reused once its last reference has been released. When no slab is free,
+/// the data is dropped instead of waiting for the consumers (see @ref get_n_dropped_buffers).
+/// @warning The references held by a process that exits without releasing them are not reclaimed: their slabs are
+/// lost until the pool is created again
+class SharedMemoryBufferPool : public std::enable_shared_from_this<SharedMemoryBufferPool> {
+public:
+    /// @brief Reference on a slab of a pool, to be sent to another process
+    struct Handle {
+        uint32_t slab       = 0; ///< Index of the slab
+        uint32_t generation = 0; ///< Number of times the slab has been acquired, 0 for an invalid handle
+        uint64_t size       = 0; ///< Number of bytes of data in the slab
+
+        /// @brief Tells whether the handle refers to a slab
+        bool valid() const {
+            return generation != 0;
+        }
+    };
+
+    /// @brief Creates a pool
+    ///
+    /// A pool left with the same name by a process that did not exit cleanly is replaced.
+    /// @param name Name of the pool, which must be a valid file name
+    /// @param config Configuration of the pool
+    /// @return The pool
+    /// @throw HalException if the configuration is invalid or the shared memory could not be created
+    static std::shared_ptr<SharedMemoryBufferPool>
+        create(const std::string &name, const SharedMemoryBufferPoolConfig &config = SharedMemoryBufferPoolConfig());
+
+    /// @brief Opens a pool created by another process
+    /// @param name Name of the pool
+    /// @return The pool
+    /// @throw HalException if the pool does not exist
+    static std::shared_ptr<SharedMemoryBufferPool> open(const std::string &name);
+
+    /// @brief Destructor
+    ///
+    /// The name of the pool is removed when its creator destroys it, the processes that opened it keeping their
+    /// mapping of the memory.
+    ~SharedMemoryBufferPool();
+
+    /// @brief Gets the name of the pool
+    const std::string &get_name() const;
+
+    /// @brief Gets the number of slabs of the pool
+    size_t get_n_slabs() const;
+
+    /// @brief Gets the size of a slab in bytes
+    size_t get_slab_size() const;
+
+    /// @brief Gets the number of slabs not referenced by any process
+    size_t get_n_free_slabs() const;
+
+    /// @brief Gets the number of buffers dropped since the creation of the pool, because no slab was free
+    uint64_t get_n_dropped_buffers() const;
+
+    /// @brief Acquires a free slab, to write data in it (see @ref get_data)
+    /// @return A handle holding one reference on the slab, owned by the caller, whose size is the size of the slab, or
+    /// an invalid handle if no slab is free
+    Handle acquire();
+
+    /// @brief Copies data in a free slab
+    /// @param data Pointer to the data
+    /// @param size Number of bytes to copy, at most the size of a slab
+    /// @return A handle holding one reference on the slab, owned by the caller, or an invalid handle if no slab is free
+    /// @throw HalException if the data is larger than a slab
+    Handle write(const void *data, size_t size);
+
+    /// @brief Copies a range of elements (e.g. decoded events) in as many free slabs as needed, an element never being
+    /// split over two slabs
+    /// @param begin Pointer to the first element
+    /// @param end Pointer after the last element
+    /// @return The handles of the slabs written, each holding one reference owned by the caller. If no slab is free,
+    /// the remaining elements are dropped and only the handles of the first ones are returned
+    /// @throw HalException if an element is larger than a slab
+    template<typename T>
+    std::vector<Handle> write_range(const T *begin, const T *end);
+
+    /// @brief Gets the address of the data of a slab
+    /// @param handle Handle of the slab, which must hold a reference
+    /// @throw HalException if the handle does not refer to a slab currently acquired
+    uint8_t *get_data(const Handle &handle) const;
+
+    /// @brief Adds a reference to a slab, e.g. before sending its handle to another process
+    /// @param handle Handle of the slab, which must hold a reference
+    /// @throw HalException if the handle does not refer to a slab currently acquired
+    void add_reference(const Handle &handle);
+
+    /// @brief Releases a reference to a slab, the slab being reused once its last reference has been released
+    /// @param handle Handle of the slab
+    /// @throw HalException if the handle does not refer to a slab currently acquired
+    void release(const Handle &handle);
+
+    /// @brief Gets the data of a slab, taking over the reference carried by its handle
+    /// @param handle Handle of the slab
+    /// @return A slice of @p handle.size bytes, the reference being released once the slice and all its copies have
+    /// been destroyed
+    /// @throw HalException if the handle does not refer to a slab currently acquired
+    DataTransfer::BufferSlice get_slice(const Handle &handle);
+
+private:
+    struct Header;
+    struct Slab;
+
+    SharedMemoryBufferPool(const std::string &name, std::unique_ptr<detail::SharedMemoryMapping> mapping);
+
+    Slab &get_slab(const Handle &handle) const;
+
+    const std::string name_;
+    std::unique_ptr<detail::SharedMemoryMapping> mapping_;
+    Header *header_;
+    Slab *slabs_;
+};
+
+template<typename T>
+std::vector<SharedMemoryBufferPool::Handle> SharedMemoryBufferPool::write_range(const T *begin, const T *end) {
+    static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable elements can be shared");
+    // An element larger than a slab is rejected by write
+    const size_t n_per_slab = std::max<size_t>(1, get_slab_size() / sizeof(T));
+    std::vector<Handle> handles;
+    while (begin != end) {
+        const size_t n      = std::min<size_t>(end - begin, n_per_slab);
+        const Handle handle = write(begin, n * sizeof(T));
+        if (!handle.valid()) {
+            break;
+        }
+        handles.push_back(handle);
+        begin += n;
+    }
+    return handles;
+}
+
+} // namespace Metavision
+
+#endif // METAVISION_HAL_SHARED_MEMORY_BUFFER_POOL_H
@@ -0,0 +1,72 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_SHARED_MEMORY_RAW_STREAM_H
+#define METAVISION_HAL_SHARED_MEMORY_RAW_STREAM_H
+
+#include <istream>
+#include <memory>
+#include <streambuf>
+#include <string>
+
+#include "metavision/hal/utils/data_transfer.h"
+#include "metavision/hal/utils/shared_memory_ring.h"
+
+namespace Metavision {
+
+/// @brief Standard input stream reading the RAW data published by another process in a @ref SharedMemoryRing
+///
+/// The stream first returns the header of the RAW data, then the buffers published, and ends when the ring is closed
+/// by its publisher. It can hence be read as a RAW file (see @ref DeviceDiscovery::open_stream), and additionally
+/// gives direct access to the ring so that readers can consume its buffers without copying them.
+class SharedMemoryRawStream : public std::istream {
+public:
+    /// @brief Opens the ring @p name as one of its readers
+    /// @param name Name of the ring
+    /// @throw HalException if the ring could not be opened
+    SharedMemoryRawStream(const std::string &name);
+
+    /// @brief Destructor
+    ~SharedMemoryRawStream();
+
+    /// @brief Gets the ring read by the stream
+    const std::shared_ptr<SharedMemoryRing> &get_ring() const;
+
+    /// @brief Gets the data already fetched from the ring but not read from the stream yet
+    ///
+    /// The data is consumed from the stream: it must be read from the returned slice, and the next buffers from the
+    /// ring itself.
+    /// @return A slice referring to the data, which may be empty
+    DataTransfer::BufferSlice take_pending_slice();
+
+private:
+    class RingBuffer : public std::streambuf {
+    public:
+        RingBuffer(const std::shared_ptr<SharedMemoryRing> &ring);
+
+        DataTransfer::BufferSlice take_pending_slice();
+
+    protected:
+        int_type underflow() override;
+
+    private:
+        std::shared_ptr<SharedMemoryRing> ring_;
+        std::string header_;
+        DataTransfer::BufferSlice slice_;
+    };
+
+    std::shared_ptr<SharedMemoryRing> ring_;
+    std::unique_ptr<RingBuffer> buffer_;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_HAL_SHARED_MEMORY_RAW_STREAM_H
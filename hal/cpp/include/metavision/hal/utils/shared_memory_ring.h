@@ -0,0 +1,134 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_SHARED_MEMORY_RING_H
+#define METAVISION_HAL_SHARED_MEMORY_RING_H
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "metavision/hal/utils/data_transfer.h"
+
+namespace Metavision {
+
+namespace detail {
+class SharedMemoryMapping;
+} // namespace detail
+
+/// @brief Configuration of a @ref SharedMemoryRing
+struct SharedMemoryRingConfig {
+    /// Number of slots of the ring
+    uint32_t n_slots_ = 32;
+
+    /// Size of a slot in bytes, a multiple of 8. The buffers larger than a slot are split over several slots
+    uint32_t slot_size_bytes_ = 512 * 1024;
+};
+
+/// @brief Ring of buffers of RAW data in shared memory, published by one process and read by others
+///
+/// The publisher (see @ref create) copies each buffer in the next slot of the ring, marking it as used by the readers
+/// registered at the time (see @ref open). The readers get the data of the slots without copy and release a slot when
+/// the last slice referring to it is destroyed. A slot is reused once all its readers have released it: if the next
+/// slot is still in use, the buffer is dropped instead, so that the publisher is never slowed down by its readers
+/// (see @ref get_n_dropped_buffers). The slots held by readers whose process died are reclaimed by the publisher.
+///
+/// The ring also holds the header of the RAW data, so that a reader can build a device from it, see
+/// @ref SharedMemoryRawStream.
+class SharedMemoryRing : public std::enable_shared_from_this<SharedMemoryRing> {
+public:
+    /// Maximum number of readers of a ring
+    static constexpr size_t MaxReaders = 64;
+
+    /// @brief Creates a ring, as its publisher
+    ///
+    /// A ring left with the same name by a publisher that did not exit cleanly is replaced.
+    /// @param name Name of the ring, which must be a valid file name
+    /// @param header Header of the RAW data published
+    /// @param config Configuration of the ring
+    /// @return The ring
+    /// @throw HalException if the configuration is invalid or the shared memory could not be created
+    static std::shared_ptr<SharedMemoryRing> create(const std::string &name, const std::string &header,
+                                                    const SharedMemoryRingConfig &config = SharedMemoryRingConfig());
+
+    /// @brief Opens a ring created by another process, as one of its readers
+    ///
+    /// The reader gets the buffers published after it is opened.
+    /// @param name Name of the ring
+    /// @return The ring
+    /// @throw HalException if the ring does not exist or already has @ref MaxReaders readers
+    static std::shared_ptr<SharedMemoryRing> open(const std::string &name);
+
+    /// @brief Destructor
+    ///
+    /// The publisher closes the ring (see @ref close), a reader unregisters from it.
+    ~SharedMemoryRing();
+
+    /// @brief Gets the name of the ring
+    const std::string &get_name() const;
+
+    /// @brief Gets the header of the RAW data published
+    std::string get_header() const;
+
+    /// @brief Publishes a buffer of data
+    /// @param data Pointer to the data
+    /// @param size Number of bytes to publish
+    /// @return false if some of the data was dropped, because a slot was still used by a reader
+    /// @warning Must only be called by the publisher
+    bool publish(const uint8_t *data, size_t size);
+
+    /// @brief Tells the readers that no more data will be published
+    /// @warning Must only be called by the publisher
+    void close();
+
+    /// @brief Gets the number of slots of data dropped since the creation of the ring
+    uint64_t get_n_dropped_buffers() const;
+
+    /// @brief Gets the number of readers currently registered
+    size_t get_n_readers() const;
+
+    /// @brief Waits for the next buffer published
+    /// @param timeout Maximum duration to wait for
+    /// @return A slice referring to the data of the buffer, which remains valid as long as the slice or one of its
+    /// copies is alive, or an empty slice if no buffer was published before the timeout or the ring is closed
+    /// @warning Must only be called by a reader, from a single thread
+    DataTransfer::BufferSlice wait_next(std::chrono::milliseconds timeout);
+
+    /// @brief Tells whether the ring has been closed by its publisher and all its data has been read
+    bool is_closed() const;
+
+private:
+    struct Header;
+    struct Slot;
+
+    SharedMemoryRing(const std::string &name, std::unique_ptr<detail::SharedMemoryMapping> mapping,
+                     bool is_publisher);
+
+    uint8_t *get_slot_data(uint64_t index) const;
+    bool reclaim(Slot &slot);
+    void remove_reader(size_t reader);
+
+    const std::string name_;
+    std::unique_ptr<detail::SharedMemoryMapping> mapping_;
+    Header *header_;
+    Slot *slots_;
+    const bool is_publisher_;
+
+    // Reader state
+    size_t reader_{0};
+    uint64_t next_seq_{0};
+    bool closed_{false};
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_HAL_SHARED_MEMORY_RING_H
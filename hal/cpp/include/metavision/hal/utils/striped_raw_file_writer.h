@@ -0,0 +1,110 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_STRIPED_RAW_FILE_WRITER_H
+#define METAVISION_HAL_STRIPED_RAW_FILE_WRITER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "metavision/hal/utils/async_raw_file_writer.h"
+#include "metavision/hal/utils/data_transfer.h"
+
+namespace Metavision {
+
+/// @brief Configuration of a @ref StripedRawFileWriter
+struct StripedRawFileWriterConfig {
+    /// Directories in which the stripe files are written, typically on different disks. Relative directories are
+    /// relative to the directory of the manifest
+    std::vector<std::string> directories_;
+    /// Number of bytes of data written to a stripe file before moving on to the next one
+    size_t stripe_size_ = 4 * 1024 * 1024;
+    /// Configuration of the writers of the stripe files. Compression is not supported
+    AsyncRawFileWriterConfig writer_config_;
+};
+
+/// @brief Writes RAW data striped across several files, typically on different disks, to sustain higher data rates
+/// than a single disk
+///
+/// The data is split in stripes of @ref StripedRawFileWriterConfig::stripe_size_ bytes, written in turn to each of the
+/// stripe files by its own @ref AsyncRawFileWriter, hence its own thread. The buffers are not copied: a buffer
+/// overlapping several stripes is split in slices referring to it.
+///
+/// Each stripe file starts with the header, and a manifest is written with the stripe size and the paths of the
+/// stripe files, so that the recording can be read back as one stream (see @ref RawFilePlaylistStream::open_stripes).
+/// The manifest is a text file with the extension @ref ManifestExtension, holding a line "% stripe_size <size>"
+/// followed by the paths of the stripe files, one per line, relative to the directory of the manifest if they are
+/// relative.
+///
+/// @ref write must be called from a single thread.
+class StripedRawFileWriter {
+public:
+    /// Extension of the manifests of the striped recordings
+    static constexpr const char *ManifestExtension = ".stripes";
+
+    /// @brief Description of a striped recording, as read from its manifest
+    struct Manifest {
+        /// Number of bytes of data in a stripe
+        uint64_t stripe_size = 0;
+        /// Paths of the stripe files, in the order the stripes are written
+        std::vector<std::string> stripe_files;
+    };
+
+    /// @brief Writes the manifest, opens the stripe files and writes their header
+    /// @param manifest_path Path of the manifest, the stripe files being named after it
+    /// @param header Bytes written at the beginning of each stripe file (e.g. the RAW file header)
+    /// @param config Configuration of the writer
+    /// @throw HalException if no directory is given, if the stripe size is null, if compression is requested, or if
+    /// a file could not be opened
+    StripedRawFileWriter(const std::string &manifest_path, const std::string &header,
+                         const StripedRawFileWriterConfig &config);
+
+    /// @brief Writes all the pending buffers, then closes the stripe files
+    ~StripedRawFileWriter();
+
+    /// @brief Queues a buffer for writing, split across the stripe files
+    /// @param slice Buffer to write, a reference on it is kept until it has been written
+    void write(const DataTransfer::BufferSlice &slice);
+
+    /// @brief Gets the paths of the stripe files
+    const std::vector<std::string> &get_stripe_files() const;
+
+    /// @brief Gets the number of buffers queued and not written yet, for all the stripe files
+    size_t get_queue_depth() const;
+
+    /// @brief Gets the number of bytes queued and not written yet, for all the stripe files
+    size_t get_bytes_behind() const;
+
+    /// @brief Returns true if @p path is the path of a manifest of a striped recording, according to its extension
+    static bool is_manifest(const std::string &path);
+
+    /// @brief Reads the manifest of a striped recording
+    /// @param manifest_path Path of the manifest
+    /// @return The manifest, with the paths of the stripe files resolved relative to the directory of the manifest
+    /// @throw HalException if the manifest can not be read or is invalid
+    static Manifest read_manifest(const std::string &manifest_path);
+
+private:
+    size_t stripe_size_;
+    std::vector<std::string> stripe_files_;
+    std::vector<std::unique_ptr<AsyncRawFileWriter>> writers_;
+
+    // Index of the stripe file being written, and number of bytes written to the current stripe
+    size_t current_writer_   = 0;
+    size_t current_position_ = 0;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_HAL_STRIPED_RAW_FILE_WRITER_H
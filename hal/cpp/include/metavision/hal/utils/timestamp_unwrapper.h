@@ -0,0 +1,118 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_TIMESTAMP_UNWRAPPER_H
+#define METAVISION_HAL_TIMESTAMP_UNWRAPPER_H
+
+#include <cstdint>
+
+#include "metavision/sdk/base/utils/timestamp.h"
+
+namespace Metavision {
+
+/// @brief Reconstructs the timestamps of a stream whose time is split between "time high" words, carrying the most
+/// significant bits of the time, and the least significant bits carried by the events
+///
+/// It tracks the time base given by the time high words, unwraps it when the time high counter wraps around, and
+/// applies the time shift of the decoder. The time base returned by @ref get_time_base is unwrapped and shifted, so
+/// that the timestamp of an event is obtained with a single addition in the inner loop of a decoder, and is the same
+/// for a whole block of events decoded at once.
+/// @tparam TimeHighBits Number of bits of the time high counter
+/// @tparam TimeLowBits Number of bits of the time carried by the events
+template<int TimeHighBits, int TimeLowBits>
+class TimestampUnwrapper {
+public:
+    /// Maximum time base before the time high counter wraps around
+    static constexpr timestamp MaxTimeBase = ((timestamp(1) << TimeHighBits) - 1) << TimeLowBits;
+
+    /// Duration of a loop of the time high counter
+    static constexpr timestamp TimeLoop = MaxTimeBase + (timestamp(1) << TimeLowBits);
+
+    /// Margin below a full loop under which a time base going backward is considered as a wrap around
+    static constexpr timestamp LoopThreshold = timestamp(10) << TimeLowBits;
+
+    /// @brief Constructor
+    /// @param time_shifting_enabled If true, the timestamps are shifted by the value of the first time high
+    explicit TimestampUnwrapper(bool time_shifting_enabled) : time_shifting_enabled_(time_shifting_enabled) {}
+
+    /// @brief Tells whether the time base is known, i.e. a time high has been received or the time has been reset
+    bool is_time_base_set() const {
+        return time_base_set_;
+    }
+
+    /// @brief Updates the time base with a time high word
+    ///
+    /// The first time high sets the time shift if time shifting is enabled.
+    /// @param time_high Value of the time high counter
+    void add_time_high(uint32_t time_high) {
+        timestamp new_time_base = (timestamp(time_high) << TimeLowBits) + n_loops_ * TimeLoop;
+        if (!time_base_set_) {
+            time_shift_    = time_shifting_enabled_ ? new_time_base : 0;
+            time_base_     = new_time_base;
+            time_base_set_ = true;
+        }
+
+        // The time went in the past because the counter wrapped around. This is true only if the previous time base
+        // is ahead, as MaxTimeBase - LoopThreshold is positive
+        const timestamp looped = (time_base_ - new_time_base >= MaxTimeBase - LoopThreshold);
+        n_loops_ += looped;
+        time_base_         = new_time_base + looped * TimeLoop;
+        shifted_time_base_ = time_base_ - time_shift_;
+    }
+
+    /// @brief Gets the time base of the last time high, unwrapped and shifted
+    timestamp get_time_base() const {
+        return shifted_time_base_;
+    }
+
+    /// @brief Gets the timestamp of an event, unwrapped and shifted
+    /// @param time_low Least significant bits of the time, carried by the event
+    timestamp get_time(uint32_t time_low) const {
+        return shifted_time_base_ + time_low;
+    }
+
+    /// @brief Gets the time shift
+    /// @param time_shift Time shift, set if it is known
+    /// @return true if the time shift is known, false otherwise
+    bool get_time_shift(timestamp &time_shift) const {
+        time_shift = time_shift_;
+        return time_base_set_;
+    }
+
+    /// @brief Sets the time shift, for instance to decode a chunk of a stream whose beginning is not decoded
+    /// @param time_shift Time shift
+    void set_time_shift(timestamp time_shift) {
+        time_shift_        = time_shift;
+        shifted_time_base_ = time_base_ - time_shift_;
+    }
+
+    /// @brief Resets the time base to the time high preceding a timestamp, e.g. after a seek in the stream
+    /// @param t Timestamp, shifted, to resume from
+    void reset(timestamp t) {
+        const timestamp time_base = t + time_shift_;
+        n_loops_                  = time_base / TimeLoop;
+        time_base_                = (time_base >> TimeLowBits) << TimeLowBits;
+        shifted_time_base_        = time_base_ - time_shift_;
+        time_base_set_            = true;
+    }
+
+private:
+    const bool time_shifting_enabled_;
+    bool time_base_set_{false};
+    timestamp n_loops_{0};
+    timestamp time_base_{0};
+    timestamp time_shift_{0};
+    timestamp shifted_time_base_{0};
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_HAL_TIMESTAMP_UNWRAPPER_H
@@ -35,7 +35,7 @@ public:
     /// @brief Discovers a device and initializes a corresponding @ref DeviceBuilder
     /// @param device_builder Device builder to configure so that it can build a @ref Device from the parameters
     /// @param serial Serial number of the camera to open. If it is an empty string, the first available camera will be
-    /// opened
+    /// opened. If it starts with "synthetic:", a synthetic source is opened (see @ref SampleSyntheticConfig)
     /// @param config Configuration of camera creation
     /// @return true if a device builder could be discovered from the parameters
     bool discover(Metavision::DeviceBuilder &device_builder, const std::string &serial,
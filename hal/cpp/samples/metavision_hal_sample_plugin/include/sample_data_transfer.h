@@ -17,9 +17,15 @@
 #include <metavision/sdk/base/utils/timestamp.h>
 #include <metavision/hal/utils/data_transfer.h>
 
+#include "sample_synthetic_config.h"
+
 /// @brief Class for getting buffers from cameras or files.
 ///
 /// This class is the implementation of HAL's facility @ref Metavision::DataTransfer
+///
+/// It demonstrates how to transfer the memory in which a device writes its data (e.g. libusb or DMA buffers mapped by
+/// the driver) without copying it: each region filled is wrapped in a slice, which hands the region back to the driver
+/// once the clients are done with it.
 class SampleDataTransfer : public Metavision::DataTransfer {
 public:
     /// @brief Constructor
@@ -27,18 +33,37 @@ public:
     /// @param raw_event_size_bytes The size of a RAW event in bytes
     SampleDataTransfer(uint32_t raw_event_size_bytes);
 
+    /// @brief Constructor of the transfers of a synthetic source
+    ///
+    /// @param raw_event_size_bytes The size of a RAW event in bytes
+    /// @param config Configuration of the events generated
+    SampleDataTransfer(uint32_t raw_event_size_bytes, const SampleSyntheticConfig &config);
+
     /// @brief Destructor
     ~SampleDataTransfer() override;
 
+    /// Number of regions of memory the sample device writes its data to
+    static constexpr size_t NUM_DEVICE_REGIONS = 16;
+
 private:
     void start_impl(BufferPtr buffer) override final;
     void run_impl() override final;
 
+    void fill(Data *begin, Data *end);
+
     Metavision::timestamp current_time_;
     BufferPtr buffer_;
+    size_t buffer_size_;
+    bool realtime_ = true;
 
     struct PatternGenerator;
     std::unique_ptr<PatternGenerator> gen_;
+
+    struct SyntheticGenerator;
+    std::unique_ptr<SyntheticGenerator> synthetic_gen_;
+
+    struct DeviceRegions;
+    std::shared_ptr<DeviceRegions> regions_;
 };
 
 #endif // METAVISION_HAL_SAMPLE_DATA_TRANSFER_H
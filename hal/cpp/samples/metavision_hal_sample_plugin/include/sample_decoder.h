@@ -27,8 +27,12 @@ public:
     ///
     /// @param time_shifting_enabled If true, the timestamp of the decoded events will be shifted of the value of the
     /// time of the first event
-    SampleDecoder(bool do_time_shift,
-                  const std::shared_ptr<Metavision::I_EventDecoder<Metavision::EventCD>> &cd_event_decoder);
+    /// @param cd_event_decoder Decoder of CD events
+    /// @param trigger_event_decoder Optional decoder of trigger events
+    SampleDecoder(
+        bool do_time_shift, const std::shared_ptr<Metavision::I_EventDecoder<Metavision::EventCD>> &cd_event_decoder,
+        const std::shared_ptr<Metavision::I_EventDecoder<Metavision::EventExtTrigger>> &trigger_event_decoder =
+            std::shared_ptr<Metavision::I_EventDecoder<Metavision::EventExtTrigger>>());
 
     /// @brief Gets the timestamp of the last event
     ///
@@ -60,6 +64,7 @@ private:
     Metavision::timestamp last_timestamp_{0};
     Metavision::timestamp time_shift_{0};
     bool time_shift_set_{false};
+    bool decode_triggers_;
 };
 
 #endif // METAVISION_HAL_SAMPLE_DECODER_H
@@ -15,6 +15,8 @@
 #include <cstdint>
 #include <metavision/sdk/base/utils/timestamp.h>
 #include <metavision/sdk/base/events/event_cd.h>
+#include <metavision/sdk/base/events/event_ext_trigger.h>
+#include <metavision/hal/utils/event_format.h>
 
 /// This sample encoding format is the following :
 /// timestamp : 44 bits
@@ -23,34 +25,41 @@
 /// polarity  : 1 bit
 ///
 /// for a total of 64 bits
+///
+/// A trigger event is encoded with y = TRIGGER_Y, which is out of the sensor, and its channel as x
 using SampleEventsFormat = std::uint64_t;
 
-constexpr int TS_BITS = 44;
-constexpr int X_BITS  = 10;
-constexpr int Y_BITS  = 9;
-constexpr int P_BITS  = 1;
-
-// Define the masks used to encode and decode
-constexpr uint64_t TS_MASK = 0xFFFFFFFFFFF;
-constexpr uint64_t X_MASK  = 0x3FF00000000000;
-constexpr uint64_t Y_MASK  = 0x7FC0000000000000;
-constexpr uint64_t P_MASK  = 0x8000000000000000;
+// The layout of the format, from which the encoding and decoding functions are generated
+using SampleFormat =
+    Metavision::CDEventFormat<SampleEventsFormat, Metavision::EventFormatField<0, 44>,
+                              Metavision::EventFormatField<44, 10>, Metavision::EventFormatField<54, 9>,
+                              Metavision::EventFormatField<63, 1>>;
 
-constexpr uint64_t X_MASK_SHIFTED = (0x3FF); // = X_MASK >> TS_BITS
-constexpr uint64_t Y_MASK_SHIFTED = (0x1FF); // = Y_MASK >> (TS_BITS + Y_BITS)
-constexpr uint64_t P_MASK_SHIFTED = (0x1);   // P_MASK >> (TS_BITS + Y_BITS + X_MASK)
+constexpr unsigned short TRIGGER_Y = 0x1FF;
 
 inline void encode_sample_format(SampleEventsFormat &encoded_ev, unsigned short x, unsigned short y, short p,
                                  Metavision::timestamp t) {
-    encoded_ev = (t & TS_MASK) | ((x & X_MASK_SHIFTED) << TS_BITS) | ((y & Y_MASK_SHIFTED) << (TS_BITS + X_BITS)) |
-                 ((p & P_MASK_SHIFTED) << (TS_BITS + X_BITS + Y_BITS));
+    encoded_ev = SampleFormat::encode(x, y, p, t);
+}
+
+inline void encode_sample_trigger(SampleEventsFormat &encoded_ev, unsigned short channel, short p,
+                                  Metavision::timestamp t) {
+    encode_sample_format(encoded_ev, channel, TRIGGER_Y, p, t);
+}
+
+inline bool is_sample_trigger(SampleEventsFormat in) {
+    return SampleFormat::Y::get(in) == TRIGGER_Y;
+}
+
+inline void decode_sample_trigger(SampleEventsFormat in, Metavision::EventExtTrigger &ev,
+                                  Metavision::timestamp t_shift = 0) {
+    ev.t  = SampleFormat::get_time(in, t_shift);
+    ev.id = static_cast<short>(SampleFormat::X::get(in));
+    ev.p  = static_cast<short>(SampleFormat::Polarity::get(in));
 }
 
 inline void decode_sample_format(SampleEventsFormat in, Metavision::EventCD &ev, Metavision::timestamp t_shift = 0) {
-    ev.t = (in & TS_MASK) - t_shift;
-    ev.x = static_cast<unsigned short>((in & X_MASK) >> TS_BITS);
-    ev.y = static_cast<unsigned short>((in & Y_MASK) >> (TS_BITS + X_BITS));
-    ev.p = static_cast<short>((in & P_MASK) >> (TS_BITS + X_BITS + Y_BITS));
+    ev = SampleFormat::decode(in, t_shift);
 }
 
 #endif // METAVISION_HAL_SAMPLE_EVENTS_FORMAT_H
@@ -0,0 +1,84 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_SAMPLE_SYNTHETIC_CONFIG_H
+#define METAVISION_HAL_SAMPLE_SYNTHETIC_CONFIG_H
+
+#include <cstdint>
+#include <string>
+
+#include <metavision/sdk/base/utils/timestamp.h>
+
+/// @brief Configuration of the synthetic source of the sample plugin, used to load test the pipelines without camera
+///
+/// A synthetic source is opened with @ref Metavision::DeviceDiscovery::open, with a serial of the form
+/// "synthetic:<key>=<value>,<key>=<value>,...", for example "synthetic:rate=50M,distribution=hotspots". The keys are
+/// the names of the fields of this structure, without the trailing underscore. The event rates accept a k, M or G
+/// suffix.
+struct SampleSyntheticConfig {
+    /// @brief Spatial distribution of the events
+    enum class Distribution {
+        Uniform,  ///< Uniformly distributed over the sensor ("uniform")
+        Hotspots, ///< Concentrated around a few pixels ("hotspots")
+        Edge      ///< Along a vertical edge moving back and forth across the sensor ("edge")
+    };
+
+    /// Rate of the events, in events per second
+    double rate_ = 1e6;
+
+    /// Spatial distribution of the events
+    Distribution distribution_ = Distribution::Uniform;
+
+    /// Number of hotspots, for the @ref Distribution::Hotspots distribution
+    int hotspots_ = 4;
+
+    /// Half size in pixels of the square around each hotspot, for the @ref Distribution::Hotspots distribution
+    int hotspot_radius_ = 10;
+
+    /// Speed of the edge in pixels per second, for the @ref Distribution::Edge distribution
+    double edge_speed_ = 1000.;
+
+    /// Period of the bursts in us, 0 to disable the bursts
+    Metavision::timestamp burst_period_us_ = 0;
+
+    /// Duration of each burst in us, at the beginning of each period
+    Metavision::timestamp burst_duration_us_ = 0;
+
+    /// Rate of the events during the bursts, in events per second
+    double burst_rate_ = 0.;
+
+    /// Period of the trigger signal in us, whose rising and falling edges are injected as trigger events, 0 to inject
+    /// none
+    Metavision::timestamp trigger_period_us_ = 0;
+
+    /// Channel of the trigger events
+    int trigger_channel_ = 0;
+
+    /// If true, the data is produced at the pace of its timestamps, otherwise as fast as possible
+    bool realtime_ = true;
+
+    /// Seed of the generation of the events
+    uint32_t seed_ = 0;
+
+    /// @brief Prefix of the serials of the synthetic sources
+    static constexpr auto SERIAL_PREFIX = "synthetic:";
+
+    /// @brief Tells if a serial refers to a synthetic source
+    static bool is_synthetic_serial(const std::string &serial);
+
+    /// @brief Parses the configuration of a synthetic source from its serial
+    /// @param serial Serial of the source, starting with @ref SERIAL_PREFIX
+    /// @return The configuration, with the default values of the fields not in the serial
+    /// @throw HalException with error InvalidArgument if the serial can not be parsed
+    static SampleSyntheticConfig parse(const std::string &serial);
+};
+
+#endif // METAVISION_HAL_SAMPLE_SYNTHETIC_CONFIG_H
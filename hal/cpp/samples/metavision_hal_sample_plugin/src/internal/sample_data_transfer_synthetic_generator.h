@@ -0,0 +1,117 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_SAMPLE_DATA_TRANSFER_SYNTHETIC_GENERATOR_H
+#define METAVISION_HAL_SAMPLE_DATA_TRANSFER_SYNTHETIC_GENERATOR_H
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "sample_data_transfer.h"
+#include "sample_events_format.h"
+#include "sample_geometry.h"
+#include "sample_synthetic_config.h"
+
+// Generates events at a target rate, with the spatial distribution, bursts and triggers of a synthetic source
+struct SampleDataTransfer::SyntheticGenerator {
+    SyntheticGenerator(const SampleSyntheticConfig &config) :
+        config_(config),
+        state_(config.seed_ + 0x9E3779B97F4A7C15ull),
+        dt_us_(1e6 / config.rate_),
+        burst_dt_us_(config.burst_rate_ > 0. ? 1e6 / config.burst_rate_ : dt_us_),
+        next_burst_change_us_(config.burst_period_us_ > 0 ? 0 : -1),
+        next_trigger_us_(config.trigger_period_us_ > 0 ? 0 : -1) {
+        const int radius = std::min(config_.hotspot_radius_, SampleGeometry::HEIGHT_ / 2 - 1);
+        for (int i = 0; i < config_.hotspots_; ++i) {
+            hotspots_x_.push_back(radius + uniform(SampleGeometry::WIDTH_ - 2 * radius));
+            hotspots_y_.push_back(radius + uniform(SampleGeometry::HEIGHT_ - 2 * radius));
+        }
+    }
+
+    // Fills a buffer with the next events, and sets the current time to the timestamp of the last one
+    void operator()(SampleEventsFormat *begin, SampleEventsFormat *end, Metavision::timestamp &current_time) {
+        for (auto ev = begin; ev != end; ++ev) {
+            const auto t = static_cast<Metavision::timestamp>(time_us_);
+            if (t >= next_burst_change_us_ && next_burst_change_us_ >= 0) {
+                in_burst_ = !in_burst_;
+                next_burst_change_us_ += in_burst_ ? config_.burst_duration_us_ :
+                                                     config_.burst_period_us_ - config_.burst_duration_us_;
+            }
+            if (t >= next_trigger_us_ && next_trigger_us_ >= 0) {
+                // Rising edge at the beginning of each period, falling edge in the middle
+                encode_sample_trigger(*ev, config_.trigger_channel_, trigger_p_, next_trigger_us_);
+                current_time = next_trigger_us_;
+                next_trigger_us_ += trigger_p_ ? config_.trigger_period_us_ - config_.trigger_period_us_ / 2 :
+                                                 config_.trigger_period_us_ / 2;
+                trigger_p_ = 1 - trigger_p_;
+                continue;
+            }
+
+            short x, y, p;
+            switch (config_.distribution_) {
+            case SampleSyntheticConfig::Distribution::Uniform:
+                x = uniform(SampleGeometry::WIDTH_);
+                y = uniform(SampleGeometry::HEIGHT_);
+                p = uniform(2);
+                break;
+            case SampleSyntheticConfig::Distribution::Hotspots: {
+                const int hotspot = uniform(config_.hotspots_);
+                const int size    = 2 * config_.hotspot_radius_ + 1;
+                x = clamp(hotspots_x_[hotspot] + uniform(size) - config_.hotspot_radius_, SampleGeometry::WIDTH_);
+                y = clamp(hotspots_y_[hotspot] + uniform(size) - config_.hotspot_radius_, SampleGeometry::HEIGHT_);
+                p = uniform(2);
+                break;
+            }
+            case SampleSyntheticConfig::Distribution::Edge:
+            default: {
+                // The edge goes back and forth across the sensor, the polarity telling its direction
+                const int span     = 2 * (SampleGeometry::WIDTH_ - 1);
+                const int position = static_cast<int>(config_.edge_speed_ * time_us_ * 1e-6) % span;
+                const bool forward = position < SampleGeometry::WIDTH_ - 1;
+                x = clamp((forward ? position : span - position) + uniform(3) - 1, SampleGeometry::WIDTH_);
+                y = uniform(SampleGeometry::HEIGHT_);
+                p = forward ? 1 : 0;
+                break;
+            }
+            }
+            encode_sample_format(*ev, x, y, p, t);
+            current_time = t;
+            time_us_ += in_burst_ ? burst_dt_us_ : dt_us_;
+        }
+    }
+
+private:
+    // Returns a random integer in [0, n), with a xorshift64* generator
+    int uniform(int n) {
+        state_ ^= state_ >> 12;
+        state_ ^= state_ << 25;
+        state_ ^= state_ >> 27;
+        const uint64_t r = (state_ * 0x2545F4914F6CDD1Dull) >> 32;
+        return static_cast<int>((r * static_cast<uint64_t>(n)) >> 32);
+    }
+
+    static short clamp(int v, int size) {
+        return static_cast<short>(std::min(std::max(v, 0), size - 1));
+    }
+
+    const SampleSyntheticConfig config_;
+    uint64_t state_;
+    const double dt_us_, burst_dt_us_;
+    double time_us_ = 0.;
+    bool in_burst_  = false;
+    Metavision::timestamp next_burst_change_us_;
+    Metavision::timestamp next_trigger_us_;
+    short trigger_p_ = 1;
+    std::vector<int> hotspots_x_, hotspots_y_;
+};
+
+#endif // METAVISION_HAL_SAMPLE_DATA_TRANSFER_SYNTHETIC_GENERATOR_H
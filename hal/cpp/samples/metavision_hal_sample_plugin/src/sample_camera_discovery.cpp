@@ -21,6 +21,7 @@
 #include "sample_decoder.h"
 #include "sample_data_transfer.h"
 #include "sample_device_control.h"
+#include "sample_synthetic_config.h"
 
 Metavision::CameraDiscovery::SerialList SampleCameraDiscovery::list() {
     SerialList ret;
@@ -42,7 +43,8 @@ Metavision::CameraDiscovery::SystemList SampleCameraDiscovery::list_available_so
 
 bool SampleCameraDiscovery::discover(Metavision::DeviceBuilder &device_builder, const std::string &serial,
                                      const Metavision::DeviceConfig &config) {
-    if (!(serial.empty() || serial == SampleHWIdentification::SAMPLE_SERIAL)) {
+    const bool synthetic = SampleSyntheticConfig::is_synthetic_serial(serial);
+    if (!(serial.empty() || serial == SampleHWIdentification::SAMPLE_SERIAL || synthetic)) {
         return false;
     }
 
@@ -54,9 +56,21 @@ bool SampleCameraDiscovery::discover(Metavision::DeviceBuilder &device_builder,
 
     auto cd_event_decoder =
         device_builder.add_facility(std::make_unique<Metavision::I_EventDecoder<Metavision::EventCD>>());
-    auto decoder = device_builder.add_facility(std::make_unique<SampleDecoder>(false, cd_event_decoder));
-    device_builder.add_facility(std::make_unique<Metavision::I_EventsStream>(
-        std::make_unique<SampleDataTransfer>(decoder->get_raw_event_size_bytes()), hw_identification));
+    auto trigger_event_decoder =
+        device_builder.add_facility(std::make_unique<Metavision::I_EventDecoder<Metavision::EventExtTrigger>>());
+    auto decoder = device_builder.add_facility(
+        std::make_unique<SampleDecoder>(false, cd_event_decoder, trigger_event_decoder));
+
+    // A synthetic source generates events as configured by its serial, instead of the fixed pattern of the sample
+    std::unique_ptr<SampleDataTransfer> data_transfer;
+    if (synthetic) {
+        data_transfer = std::make_unique<SampleDataTransfer>(decoder->get_raw_event_size_bytes(),
+                                                             SampleSyntheticConfig::parse(serial));
+    } else {
+        data_transfer = std::make_unique<SampleDataTransfer>(decoder->get_raw_event_size_bytes());
+    }
+    device_builder.add_facility(
+        std::make_unique<Metavision::I_EventsStream>(std::move(data_transfer), hw_identification));
 
     return true;
 }
@@ -9,17 +9,81 @@
  * See the License for the specific language governing permissions and limitations under the License.                 *
  **********************************************************************************************************************/
 
+#include <algorithm>
+#include <mutex>
+#include <vector>
 #include <metavision/sdk/base/utils/get_time.h>
 
 #include "sample_data_transfer.h"
 #include "internal/sample_data_transfer_pattern_generator.h"
+#include "internal/sample_data_transfer_synthetic_generator.h"
 
 constexpr short SampleDataTransfer::PatternGenerator::SIZE_SQUARE;
 constexpr short SampleDataTransfer::PatternGenerator::N_RANDOM;
 constexpr Metavision::timestamp SampleDataTransfer::PatternGenerator::STEP_RANDOM;
+constexpr size_t SampleDataTransfer::NUM_DEVICE_REGIONS;
+
+namespace {
+constexpr size_t SIZE_FAKE_EVENTS = 340 * sizeof(SampleEventsFormat);
+
+// The buffers of a synthetic source hold about 1 ms of events, so that high rates are not slowed down by the overhead
+// of each buffer
+size_t get_synthetic_buffer_size(const SampleSyntheticConfig &config) {
+    const double max_rate = std::max(config.rate_, config.burst_rate_);
+    const size_t num_events =
+        std::min<size_t>(std::max<size_t>(static_cast<size_t>(max_rate * 1e-3), 340), 64 * 1024);
+    return num_events * sizeof(SampleEventsFormat);
+}
+} // namespace
+
+// Stands for the memory the driver of a device maps for the transfers (e.g. libusb or DMA buffers): the device writes
+// its data into a free region, which is handed back to the driver once the data it holds has been processed.
+//
+// The regions are shared with the slices transferred, which may be released by the clients after the data transfer is
+// destroyed.
+struct SampleDataTransfer::DeviceRegions {
+    DeviceRegions(size_t num_regions, size_t region_size) : regions(num_regions) {
+        for (size_t i = 0; i < num_regions; ++i) {
+            regions[i].resize(region_size);
+            free_regions.push_back(i);
+        }
+    }
+
+    // Gets the index of a free region, or -1 if all of them are held by the clients
+    int acquire() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (free_regions.empty()) {
+            return -1;
+        }
+        const int index = static_cast<int>(free_regions.back());
+        free_regions.pop_back();
+        return index;
+    }
+
+    void release(size_t index) {
+        std::lock_guard<std::mutex> lock(mutex);
+        free_regions.push_back(index);
+    }
+
+    std::vector<Buffer> regions;
+    std::vector<size_t> free_regions;
+    std::mutex mutex;
+};
 
 SampleDataTransfer::SampleDataTransfer(uint32_t raw_event_size_bytes) :
-    DataTransfer(raw_event_size_bytes), current_time_(0), gen_(new SampleDataTransfer::PatternGenerator()) {}
+    DataTransfer(raw_event_size_bytes),
+    current_time_(0),
+    buffer_size_(SIZE_FAKE_EVENTS),
+    gen_(new SampleDataTransfer::PatternGenerator()),
+    regions_(std::make_shared<DeviceRegions>(NUM_DEVICE_REGIONS, buffer_size_)) {}
+
+SampleDataTransfer::SampleDataTransfer(uint32_t raw_event_size_bytes, const SampleSyntheticConfig &config) :
+    DataTransfer(raw_event_size_bytes),
+    current_time_(0),
+    buffer_size_(get_synthetic_buffer_size(config)),
+    realtime_(config.realtime_),
+    synthetic_gen_(new SampleDataTransfer::SyntheticGenerator(config)),
+    regions_(std::make_shared<DeviceRegions>(NUM_DEVICE_REGIONS, buffer_size_)) {}
 
 SampleDataTransfer::~SampleDataTransfer() = default;
 
@@ -32,7 +96,6 @@ void SampleDataTransfer::run_impl() {
     // In this sample we just generate some fake events, but you'll have to replace
     // the following code with your implementation (for example, getting data from
     // the USB)
-    static constexpr size_t SIZE_FAKE_EVENTS = 340 * sizeof(SampleEventsFormat);
 
     // To generate real time events, we need to time how long it takes to fill the
     // events, and sleep for the necessary time
@@ -40,19 +103,41 @@ void SampleDataTransfer::run_impl() {
     uint64_t first_ts_clock_         = Metavision::get_system_time_us();
     auto start                       = std::chrono::system_clock::now();
     while (!should_stop()) {
-        // Fill fake_events
-        buffer_->resize(SIZE_FAKE_EVENTS);
-        for (auto it = buffer_->begin(); it < buffer_->end(); it += sizeof(SampleEventsFormat)) {
-            (*gen_)(reinterpret_cast<SampleEventsFormat &>(*it), current_time_);
+        const int index = regions_->acquire();
+        if (index >= 0) {
+            // The device writes into a region of the driver, which is made available to the events stream without
+            // copy. The region goes back to the driver when the last slice referring to it is released, possibly from
+            // another thread
+            Data *begin = regions_->regions[index].data();
+            Data *end   = begin + buffer_size_;
+            fill(begin, end);
+            auto regions = regions_;
+            transfer_slice(BufferSlice::from_external_memory(begin, end, [regions, index]() {
+                regions->release(static_cast<size_t>(index));
+            }));
+        } else {
+            // The clients hold all the regions: rather than stalling the device, its data is copied to a buffer of the
+            // pool, so that the region can be reused right away
+            buffer_->resize(buffer_size_);
+            fill(buffer_->data(), buffer_->data() + buffer_->size());
+            buffer_ = transfer_data(buffer_);
         }
 
-        // Makes the buffer available to the events stream
-        auto next_buffer      = transfer_data(buffer_);
-        next_buffer           = buffer_;
         uint64_t cur_ts_clock = Metavision::get_system_time_us();
         uint64_t expected_ts  = first_ts_clock_ + (current_time_ - time_start);
-        if (expected_ts > cur_ts_clock) {
+        if (realtime_ && expected_ts > cur_ts_clock) {
             std::this_thread::sleep_for(std::chrono::microseconds(expected_ts - cur_ts_clock));
         }
     }
 }
+
+void SampleDataTransfer::fill(Data *begin, Data *end) {
+    if (synthetic_gen_) {
+        (*synthetic_gen_)(reinterpret_cast<SampleEventsFormat *>(begin), reinterpret_cast<SampleEventsFormat *>(end),
+                          current_time_);
+        return;
+    }
+    for (auto it = begin; it < end; it += sizeof(SampleEventsFormat)) {
+        (*gen_)(reinterpret_cast<SampleEventsFormat &>(*it), current_time_);
+    }
+}
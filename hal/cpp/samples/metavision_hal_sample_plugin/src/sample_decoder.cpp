@@ -14,9 +14,16 @@
 #include "sample_decoder.h"
 #include "sample_events_format.h"
 
-SampleDecoder::SampleDecoder(bool do_time_shift,
-                             const std::shared_ptr<Metavision::I_EventDecoder<Metavision::EventCD>> &cd_event_decoder) :
-    I_Decoder(do_time_shift, cd_event_decoder) {}
+namespace {
+// Maximal number of CD events unpacked at once, which must not exceed the size of the buffer of the forwarder
+constexpr size_t BlockSize = 64;
+} // namespace
+
+SampleDecoder::SampleDecoder(
+    bool do_time_shift, const std::shared_ptr<Metavision::I_EventDecoder<Metavision::EventCD>> &cd_event_decoder,
+    const std::shared_ptr<Metavision::I_EventDecoder<Metavision::EventExtTrigger>> &trigger_event_decoder) :
+    I_Decoder(do_time_shift, cd_event_decoder, trigger_event_decoder),
+    decode_triggers_(trigger_event_decoder != nullptr) {}
 
 void SampleDecoder::decode_impl(RawData *ev, RawData *evend) {
     if (ev == evend) {
@@ -24,27 +31,45 @@ void SampleDecoder::decode_impl(RawData *ev, RawData *evend) {
     }
 
     // Note: Input guarantees std::distance(ev, evend) % sizeof(SampleEventsFormat) = 0
-    SampleEventsFormat *current_ev = reinterpret_cast<SampleEventsFormat *>(ev);
-    SampleEventsFormat *ev_end     = reinterpret_cast<SampleEventsFormat *>(evend);
-    Metavision::EventCD event_decoded(0, 0, 0, last_timestamp_);
+    const SampleEventsFormat *current_ev = reinterpret_cast<const SampleEventsFormat *>(ev);
+    const SampleEventsFormat *ev_end     = reinterpret_cast<const SampleEventsFormat *>(evend);
+    Metavision::EventExtTrigger trigger_decoded(0, last_timestamp_, 0);
+    Metavision::EventCD block[BlockSize];
     auto &cd_forwarder = cd_event_forwarder();
 
     // If the time shift is enabled, check if we set it. If not, set it
     if (is_time_shifting_enabled()) {
         if (!time_shift_set_) {
-            time_shift_     = (*current_ev) & TS_MASK;
+            time_shift_     = SampleFormat::get_time(*current_ev);
             time_shift_set_ = true;
         }
     }
 
     // Remark : we have the guarantee that the input buffer length is a multiple of sizeof(SampleEventsFormat),
-    // so we can use != in the exit condition of the for loop below
-    for (; current_ev != ev_end; ++current_ev) {
-        decode_sample_format(*current_ev, event_decoded, time_shift_);
-        cd_forwarder.forward(event_decoded);
-    }
+    // so we can use != in the exit condition of the loop below
+    while (current_ev != ev_end) {
+        // The CD events up to the next trigger are unpacked at once, by blocks
+        const size_t max_run = std::min<size_t>(BlockSize, ev_end - current_ev);
+        size_t run           = 0;
+        for (; run < max_run && !is_sample_trigger(current_ev[run]); ++run) {}
+        if (run > 0) {
+            SampleFormat::unpack(current_ev, run, time_shift_, block);
+            cd_forwarder.reserve(static_cast<int>(run));
+            for (size_t i = 0; i < run; ++i) {
+                cd_forwarder.forward_unsafe(block[i]);
+            }
+            last_timestamp_ = block[run - 1].t;
+            current_ev += run;
+            continue;
+        }
 
-    last_timestamp_ = event_decoded.t;
+        if (decode_triggers_) {
+            decode_sample_trigger(*current_ev, trigger_decoded, time_shift_);
+            trigger_event_forwarder().forward(trigger_decoded);
+        }
+        last_timestamp_ = SampleFormat::get_time(*current_ev, time_shift_);
+        ++current_ev;
+    }
 }
 
 Metavision::timestamp SampleDecoder::get_last_timestamp() const {
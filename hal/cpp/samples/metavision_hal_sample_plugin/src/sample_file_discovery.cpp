@@ -30,8 +30,10 @@ bool SampleFileDiscovery::discover(Metavision::DeviceBuilder &device_builder, st
 
     auto cd_event_decoder =
         device_builder.add_facility(std::make_unique<Metavision::I_EventDecoder<Metavision::EventCD>>());
-    auto decoder =
-        device_builder.add_facility(std::make_unique<SampleDecoder>(stream_config.do_time_shifting_, cd_event_decoder));
+    auto trigger_event_decoder =
+        device_builder.add_facility(std::make_unique<Metavision::I_EventDecoder<Metavision::EventExtTrigger>>());
+    auto decoder = device_builder.add_facility(
+        std::make_unique<SampleDecoder>(stream_config.do_time_shifting_, cd_event_decoder, trigger_event_decoder));
     device_builder.add_facility(std::make_unique<Metavision::I_EventsStream>(
         std::make_unique<Metavision::FileDataTransfer>(std::move(stream), decoder->get_raw_event_size_bytes(),
                                                        stream_config),
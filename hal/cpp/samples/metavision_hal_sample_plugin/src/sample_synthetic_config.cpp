@@ -0,0 +1,132 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <sstream>
+#include <stdexcept>
+#include <metavision/hal/utils/hal_exception.h>
+
+#include "sample_synthetic_config.h"
+
+namespace {
+
+[[noreturn]] void throw_invalid(const std::string &serial, const std::string &reason) {
+    throw Metavision::HalException(Metavision::HalErrorCode::InvalidArgument,
+                                   "Invalid synthetic source '" + serial + "': " + reason);
+}
+
+double parse_number(const std::string &serial, const std::string &key, const std::string &value) {
+    size_t pos    = 0;
+    double number = 0.;
+    try {
+        number = std::stod(value, &pos);
+    } catch (const std::exception &) { throw_invalid(serial, "invalid value for " + key); }
+
+    const std::string suffix = value.substr(pos);
+    if (suffix == "k") {
+        number *= 1e3;
+    } else if (suffix == "M") {
+        number *= 1e6;
+    } else if (suffix == "G") {
+        number *= 1e9;
+    } else if (!suffix.empty()) {
+        throw_invalid(serial, "invalid value for " + key);
+    }
+    return number;
+}
+
+} // namespace
+
+constexpr const char *const SampleSyntheticConfig::SERIAL_PREFIX;
+
+bool SampleSyntheticConfig::is_synthetic_serial(const std::string &serial) {
+    const std::string prefix(SERIAL_PREFIX);
+    return serial.compare(0, prefix.size(), prefix) == 0;
+}
+
+SampleSyntheticConfig SampleSyntheticConfig::parse(const std::string &serial) {
+    if (!is_synthetic_serial(serial)) {
+        throw_invalid(serial, "expected " + std::string(SERIAL_PREFIX) + "<key>=<value>,...");
+    }
+
+    SampleSyntheticConfig config;
+    std::istringstream fields(serial.substr(std::string(SERIAL_PREFIX).size()));
+    std::string field;
+    while (std::getline(fields, field, ',')) {
+        if (field.empty()) {
+            continue;
+        }
+        const size_t equal_pos = field.find('=');
+        if (equal_pos == std::string::npos) {
+            throw_invalid(serial, "expected <key>=<value>, got '" + field + "'");
+        }
+        const std::string key   = field.substr(0, equal_pos);
+        const std::string value = field.substr(equal_pos + 1);
+
+        if (key == "distribution") {
+            if (value == "uniform") {
+                config.distribution_ = Distribution::Uniform;
+            } else if (value == "hotspots") {
+                config.distribution_ = Distribution::Hotspots;
+            } else if (value == "edge") {
+                config.distribution_ = Distribution::Edge;
+            } else {
+                throw_invalid(serial, "unknown distribution '" + value + "'");
+            }
+            continue;
+        }
+
+        const double number = parse_number(serial, key, value);
+        if (key == "rate") {
+            config.rate_ = number;
+        } else if (key == "hotspots") {
+            config.hotspots_ = static_cast<int>(number);
+        } else if (key == "hotspot_radius") {
+            config.hotspot_radius_ = static_cast<int>(number);
+        } else if (key == "edge_speed") {
+            config.edge_speed_ = number;
+        } else if (key == "burst_period_us") {
+            config.burst_period_us_ = static_cast<Metavision::timestamp>(number);
+        } else if (key == "burst_duration_us") {
+            config.burst_duration_us_ = static_cast<Metavision::timestamp>(number);
+        } else if (key == "burst_rate") {
+            config.burst_rate_ = number;
+        } else if (key == "trigger_period_us") {
+            config.trigger_period_us_ = static_cast<Metavision::timestamp>(number);
+        } else if (key == "trigger_channel") {
+            config.trigger_channel_ = static_cast<int>(number);
+        } else if (key == "realtime") {
+            config.realtime_ = number != 0.;
+        } else if (key == "seed") {
+            config.seed_ = static_cast<uint32_t>(number);
+        } else {
+            throw_invalid(serial, "unknown key '" + key + "'");
+        }
+    }
+
+    if (config.rate_ <= 0.) {
+        throw_invalid(serial, "the rate must be positive");
+    }
+    if (config.hotspots_ < 1 || config.hotspot_radius_ < 0) {
+        throw_invalid(serial, "invalid hotspots");
+    }
+    if (config.burst_period_us_ < 0 || config.trigger_period_us_ < 0) {
+        throw_invalid(serial, "the periods can not be negative");
+    }
+    if (config.burst_period_us_ > 0 &&
+        (config.burst_duration_us_ <= 0 || config.burst_duration_us_ > config.burst_period_us_ ||
+         config.burst_rate_ <= 0.)) {
+        throw_invalid(serial, "the bursts need a duration within their period and a positive rate");
+    }
+    if (config.trigger_channel_ < 0 || config.trigger_channel_ > 1023) {
+        throw_invalid(serial, "the trigger channel must be in [0, 1023]");
+    }
+    return config;
+}
@@ -11,6 +11,11 @@
 
 #include <memory>
 #include <atomic>
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <vector>
 
 #include "metavision/utils/gtest/gtest_with_tmp_dir.h"
 #include "metavision/hal/device/device.h"
@@ -23,14 +28,63 @@
 #include "metavision/hal/facilities/i_device_control.h"
 #include "metavision/hal/facilities/i_ll_biases.h"
 #include "metavision/hal/facilities/i_roi.h"
+#include "metavision/hal/utils/hal_exception.h"
 #include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/base/events/event_ext_trigger.h"
+#include "sample_data_transfer.h"
+#include "sample_decoder.h"
+#include "sample_events_format.h"
 #include "sample_hw_identification.h"
 #include "sample_geometry.h"
+#include "sample_synthetic_config.h"
 
 using namespace Metavision;
 
 class HalSamplePlugin_GTest : public GTestWithTmpDir {
 public:
+    // Decodes the events of a synthetic source until a given time
+    void decode_synthetic_events(const SampleSyntheticConfig &config, timestamp duration,
+                                 std::vector<EventCD> &cd_events, std::vector<EventExtTrigger> &trigger_events) {
+        auto cd_decoder      = std::make_shared<I_EventDecoder<EventCD>>();
+        auto trigger_decoder = std::make_shared<I_EventDecoder<EventExtTrigger>>();
+        cd_decoder->add_event_buffer_callback(
+            [&](const EventCD *begin, const EventCD *end) { cd_events.insert(cd_events.end(), begin, end); });
+        trigger_decoder->add_event_buffer_callback([&](const EventExtTrigger *begin, const EventExtTrigger *end) {
+            trigger_events.insert(trigger_events.end(), begin, end);
+        });
+        SampleDecoder decoder(false, cd_decoder, trigger_decoder);
+
+        SampleDataTransfer transfer(decoder.get_raw_event_size_bytes(), config);
+        std::mutex mutex;
+        std::condition_variable cond;
+        std::vector<DataTransfer::BufferSlice> slices;
+        transfer.add_new_slice_callback([&](const DataTransfer::BufferSlice &slice) {
+            std::lock_guard<std::mutex> lock(mutex);
+            slices.push_back(slice);
+            cond.notify_all();
+        });
+
+        transfer.start();
+        while (decoder.get_last_timestamp() < duration) {
+            DataTransfer::BufferSlice slice;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                cond.wait(lock, [&]() { return !slices.empty(); });
+                slice = slices.front();
+                slices.erase(slices.begin());
+            }
+            decoder.decode(slice.data(), slice.data() + slice.size());
+        }
+        transfer.stop();
+
+        cd_events.erase(std::find_if(cd_events.begin(), cd_events.end(),
+                                     [duration](const EventCD &ev) { return ev.t >= duration; }),
+                        cd_events.end());
+        trigger_events.erase(std::find_if(trigger_events.begin(), trigger_events.end(),
+                                          [duration](const EventExtTrigger &ev) { return ev.t >= duration; }),
+                             trigger_events.end());
+    }
+
     // Check facilities that should be present both online and offline
     void check_common_facilities(Metavision::Device *device, bool offline) {
         // I_HW_Identification
@@ -172,3 +226,176 @@ TEST_F(HalSamplePlugin_GTest, record_and_read_back) {
     ASSERT_EQ(number_cd_expected, n_cd_events_decoded);
     ASSERT_EQ(last_time, i_decoder->get_last_timestamp());
 }
+
+TEST_F(HalSamplePlugin_GTest, live_transfers_device_regions_without_copy) {
+    // GIVEN the data transfer of the sample live source
+    SampleDataTransfer transfer(sizeof(SampleEventsFormat));
+    const size_t num_regions = SampleDataTransfer::NUM_DEVICE_REGIONS;
+    std::mutex mutex;
+    std::condition_variable cond;
+    std::vector<DataTransfer::BufferSlice> held_slices;
+    std::set<DataTransfer::Data *> device_regions;
+    size_t num_reused_regions = 0;
+    bool hold                 = true;
+    transfer.add_new_slice_callback([&](const DataTransfer::BufferSlice &slice) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (hold) {
+            held_slices.push_back(slice);
+        } else if (device_regions.count(slice.data())) {
+            ++num_reused_regions;
+        }
+        cond.notify_all();
+    });
+
+    // WHEN the clients hold more slices than the device has regions
+    transfer.start();
+    std::unique_lock<std::mutex> lock(mutex);
+    cond.wait(lock, [&]() { return held_slices.size() >= num_regions + 5; });
+
+    // THEN all the regions are transferred, and the transfers go on with copies of the data instead of stalling
+    std::set<DataTransfer::Data *> slices_data;
+    for (const auto &slice : held_slices) {
+        EXPECT_EQ(340 * sizeof(SampleEventsFormat), slice.size());
+        slices_data.insert(slice.data());
+    }
+    EXPECT_EQ(held_slices.size(), slices_data.size());
+    for (size_t i = 0; i < num_regions; ++i) {
+        device_regions.insert(held_slices[i].data());
+    }
+
+    // WHEN the clients release the slices
+    held_slices.clear();
+    hold = false;
+
+    // THEN the regions are handed back to the device and transferred again
+    cond.wait(lock, [&]() { return num_reused_regions >= 10; });
+    lock.unlock();
+    transfer.stop();
+}
+
+TEST_F(HalSamplePlugin_GTest, parse_synthetic_config) {
+    // WHEN parsing the serial of a synthetic source
+    auto config = SampleSyntheticConfig::parse(
+        "synthetic:rate=20M,distribution=edge,burst_period_us=10000,burst_duration_us=1000,burst_rate=0.5G,"
+        "trigger_period_us=500,trigger_channel=3,realtime=0,seed=7");
+
+    // THEN the fields are set
+    EXPECT_DOUBLE_EQ(20e6, config.rate_);
+    EXPECT_EQ(SampleSyntheticConfig::Distribution::Edge, config.distribution_);
+    EXPECT_EQ(10000, config.burst_period_us_);
+    EXPECT_EQ(1000, config.burst_duration_us_);
+    EXPECT_DOUBLE_EQ(500e6, config.burst_rate_);
+    EXPECT_EQ(500, config.trigger_period_us_);
+    EXPECT_EQ(3, config.trigger_channel_);
+    EXPECT_FALSE(config.realtime_);
+    EXPECT_EQ(7u, config.seed_);
+
+    // THEN invalid serials are rejected
+    EXPECT_NO_THROW(SampleSyntheticConfig::parse("synthetic:"));
+    EXPECT_THROW(SampleSyntheticConfig::parse("synthetic:rate"), HalException);
+    EXPECT_THROW(SampleSyntheticConfig::parse("synthetic:rate=fast"), HalException);
+    EXPECT_THROW(SampleSyntheticConfig::parse("synthetic:rate=0"), HalException);
+    EXPECT_THROW(SampleSyntheticConfig::parse("synthetic:distribution=gaussian"), HalException);
+    EXPECT_THROW(SampleSyntheticConfig::parse("synthetic:unknown=1"), HalException);
+    EXPECT_THROW(SampleSyntheticConfig::parse("synthetic:burst_period_us=1000"), HalException);
+    EXPECT_THROW(SampleSyntheticConfig::parse("000000"), HalException);
+}
+
+TEST_F(HalSamplePlugin_GTest, synthetic_source_rate_and_triggers) {
+    // GIVEN a synthetic source with a target rate and triggers
+    SampleSyntheticConfig config;
+    config.rate_              = 5e6;
+    config.trigger_period_us_ = 1000;
+    config.trigger_channel_   = 2;
+    config.realtime_          = false;
+
+    // WHEN decoding 100 ms of its events
+    std::vector<EventCD> cd_events;
+    std::vector<EventExtTrigger> trigger_events;
+    decode_synthetic_events(config, 100000, cd_events, trigger_events);
+
+    // THEN the events have the target rate, and are spread over the sensor
+    EXPECT_NEAR(500000, cd_events.size(), 1000);
+    std::set<int> pixels;
+    for (size_t i = 0; i < cd_events.size(); ++i) {
+        ASSERT_LT(cd_events[i].x, SampleGeometry::WIDTH_);
+        ASSERT_LT(cd_events[i].y, SampleGeometry::HEIGHT_);
+        if (i > 0) {
+            ASSERT_LE(cd_events[i - 1].t, cd_events[i].t);
+        }
+        pixels.insert(cd_events[i].y * SampleGeometry::WIDTH_ + cd_events[i].x);
+    }
+    EXPECT_LT(SampleGeometry::WIDTH_ * SampleGeometry::HEIGHT_ / 2, pixels.size());
+
+    // THEN the edges of the trigger signal are injected
+    ASSERT_EQ(200, trigger_events.size());
+    for (size_t i = 0; i < trigger_events.size(); ++i) {
+        EXPECT_EQ(static_cast<timestamp>(i * 500), trigger_events[i].t);
+        EXPECT_EQ(i % 2 == 0 ? 1 : 0, trigger_events[i].p);
+        EXPECT_EQ(2, trigger_events[i].id);
+    }
+}
+
+TEST_F(HalSamplePlugin_GTest, synthetic_source_hotspots_and_bursts) {
+    // GIVEN a synthetic source with hotspots and bursts
+    SampleSyntheticConfig config;
+    config.rate_              = 1e6;
+    config.distribution_      = SampleSyntheticConfig::Distribution::Hotspots;
+    config.hotspots_          = 2;
+    config.hotspot_radius_    = 3;
+    config.burst_period_us_   = 10000;
+    config.burst_duration_us_ = 1000;
+    config.burst_rate_        = 20e6;
+    config.realtime_          = false;
+
+    // WHEN decoding 100 ms of its events
+    std::vector<EventCD> cd_events;
+    std::vector<EventExtTrigger> trigger_events;
+    decode_synthetic_events(config, 100000, cd_events, trigger_events);
+
+    // THEN the events are around the hotspots
+    std::set<int> pixels;
+    for (const auto &ev : cd_events) {
+        pixels.insert(ev.y * SampleGeometry::WIDTH_ + ev.x);
+    }
+    EXPECT_GE(2 * 7 * 7, pixels.size());
+    EXPECT_TRUE(trigger_events.empty());
+
+    // THEN the rate is higher during the bursts
+    size_t num_burst_events = 0;
+    for (const auto &ev : cd_events) {
+        num_burst_events += (ev.t % 10000 < 1000) ? 1 : 0;
+    }
+    EXPECT_NEAR(10 * 20000, num_burst_events, 500);
+    EXPECT_NEAR(10 * 9000, cd_events.size() - num_burst_events, 500);
+}
+
+TEST_F(HalSamplePlugin_GTest, open_synthetic_source) {
+    // GIVEN the sample plugin library
+    // WHEN we open a synthetic source
+    std::unique_ptr<Metavision::Device> device;
+    ASSERT_NO_THROW(device = DeviceDiscovery::open("synthetic:rate=2M,realtime=0,trigger_period_us=1000"));
+
+    // THEN a device generating the configured events is built
+    ASSERT_NE(nullptr, device);
+    check_common_facilities(device.get(), false);
+    auto *i_events_stream   = device->get_facility<I_EventsStream>();
+    auto *i_decoder         = device->get_facility<I_Decoder>();
+    auto *i_trigger_decoder = device->get_facility<I_EventDecoder<EventExtTrigger>>();
+    ASSERT_NE(nullptr, i_trigger_decoder);
+
+    size_t n_triggers = 0;
+    i_trigger_decoder->add_event_buffer_callback(
+        [&n_triggers](const EventExtTrigger *begin, const EventExtTrigger *end) {
+            n_triggers += std::distance(begin, end);
+        });
+    i_events_stream->start();
+    while (i_decoder->get_last_timestamp() < 10000) {
+        ASSERT_LE(0, i_events_stream->wait_next_buffer());
+        long n_bytes;
+        uint8_t *raw_data = i_events_stream->get_latest_raw_data(n_bytes);
+        i_decoder->decode(raw_data, raw_data + n_bytes);
+    }
+    i_events_stream->stop();
+    EXPECT_LE(20, n_triggers);
+}
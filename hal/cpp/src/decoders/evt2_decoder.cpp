@@ -0,0 +1,146 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "metavision/hal/decoders/evt2_decoder.h"
+
+namespace Metavision {
+
+using namespace Evt2::detail;
+
+namespace {
+
+// Returns the first EVT_TIME_HIGH word of [cur, end), or end if there is none. Time highs being sparse, whole blocks of
+// words are skipped at once when none of their types matches
+inline const uint8_t *find_time_high(const uint8_t *cur, const uint8_t *end) {
+    constexpr uint32_t TimeHigh = static_cast<uint32_t>(Evt2::EventTypes::EVT_TIME_HIGH);
+#if defined(__AVX2__)
+    const __m256i time_high = _mm256_set1_epi32(TimeHigh);
+    for (; static_cast<size_t>(end - cur) >= BlockSize * WordSize; cur += BlockSize * WordSize) {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(cur));
+        if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(_mm256_srli_epi32(block, Evt2::TypeShift), time_high)) != 0) {
+            break;
+        }
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    const uint32x4_t time_high = vdupq_n_u32(TimeHigh);
+    for (; static_cast<size_t>(end - cur) >= 4 * WordSize; cur += 4 * WordSize) {
+        const uint32x4_t block = vreinterpretq_u32_u8(vld1q_u8(cur));
+        if (vmaxvq_u32(vceqq_u32(vshrq_n_u32(block, Evt2::TypeShift), time_high)) != 0) {
+            break;
+        }
+    }
+#elif defined(__SSE2__)
+    const __m128i time_high = _mm_set1_epi32(TimeHigh);
+    for (; static_cast<size_t>(end - cur) >= 4 * WordSize; cur += 4 * WordSize) {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(cur));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_srli_epi32(block, Evt2::TypeShift), time_high)) != 0) {
+            break;
+        }
+    }
+#endif
+    for (; static_cast<size_t>(end - cur) >= WordSize; cur += WordSize) {
+        if (Evt2::get_type(load_word(cur)) == Evt2::EventTypes::EVT_TIME_HIGH) {
+            return cur;
+        }
+    }
+    return end;
+}
+
+} // namespace
+
+EVT2Decoder::EVT2Decoder(bool time_shifting_enabled, const std::shared_ptr<I_EventDecoder<EventCD>> &event_cd_decoder,
+                         const std::shared_ptr<I_EventDecoder<EventExtTrigger>> &event_ext_trigger_decoder) :
+    I_Decoder(time_shifting_enabled, event_cd_decoder, event_ext_trigger_decoder),
+    decode_cd_(event_cd_decoder != nullptr),
+    decode_ext_trigger_(event_ext_trigger_decoder != nullptr),
+    time_(time_shifting_enabled) {}
+
+void EVT2Decoder::decode_impl(RawData *raw_data_begin, RawData *raw_data_end) {
+    decode_events(raw_data_begin, raw_data_end, decode_cd_ ? &cd_event_forwarder() : nullptr,
+                  decode_ext_trigger_ ? &trigger_event_forwarder() : nullptr);
+}
+
+bool EVT2Decoder::load_cd_block(const RawData *data, Evt2::RawWord *words) {
+    constexpr uint32_t NotCDMask = 0xE0000000;
+#if defined(__AVX2__)
+    const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(words), block);
+    return _mm256_testz_si256(block, _mm256_set1_epi32(NotCDMask));
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    const uint32x4_t low  = vreinterpretq_u32_u8(vld1q_u8(data));
+    const uint32x4_t high = vreinterpretq_u32_u8(vld1q_u8(data + 4 * WordSize));
+    vst1q_u32(words, low);
+    vst1q_u32(words + 4, high);
+    return vmaxvq_u32(vandq_u32(vorrq_u32(low, high), vdupq_n_u32(NotCDMask))) == 0;
+#else
+    std::memcpy(words, data, BlockSize * WordSize);
+    uint32_t types = 0;
+    for (size_t i = 0; i < BlockSize; ++i) {
+        types |= words[i];
+    }
+    return (types & NotCDMask) == 0;
+#endif
+}
+
+bool EVT2Decoder::reset_last_timestamp_impl(const timestamp &t) {
+    time_.reset(t);
+    last_timestamp_ = t;
+    return true;
+}
+
+bool EVT2Decoder::reset_timestamp_shift_impl(const timestamp &shift) {
+    time_.set_time_shift(shift);
+    return true;
+}
+
+bool EVT2Decoder::is_cd_event_filter_supported_impl() const {
+    return true;
+}
+
+const I_Decoder::RawData *EVT2Decoder::find_resync_point(const RawData *raw_data_begin,
+                                                        const RawData *raw_data_end) const {
+    return find_time_high(raw_data_begin, raw_data_end);
+}
+
+const I_Decoder::RawData *EVT2Decoder::find_time_base(const RawData *raw_data_begin, const RawData *raw_data_end,
+                                                     timestamp &time_base) const {
+    const RawData *time_high = find_time_high(raw_data_begin, raw_data_end);
+    if (time_high != raw_data_end) {
+        time_base = static_cast<timestamp>(load_word(time_high) & Evt2::TsMsbMask) << Evt2::TimestampLsbBits;
+    }
+    return time_high;
+}
+
+timestamp EVT2Decoder::get_time_base_period() const {
+    return timestamp(1) << (Evt2::TypeShift + Evt2::TimestampLsbBits);
+}
+
+timestamp EVT2Decoder::get_last_timestamp() const {
+    return last_timestamp_;
+}
+
+bool EVT2Decoder::get_timestamp_shift(timestamp &timestamp_shift) const {
+    return time_.get_time_shift(timestamp_shift);
+}
+
+uint8_t EVT2Decoder::get_raw_event_size_bytes() const {
+    return WordSize;
+}
+
+} // namespace Metavision
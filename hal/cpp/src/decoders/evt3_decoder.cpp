@@ -0,0 +1,272 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <cstring>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "metavision/hal/decoders/evt3_decoder.h"
+
+namespace Metavision {
+
+namespace {
+
+constexpr size_t WordSize = sizeof(Evt3::RawWord);
+
+// Input buffers are not guaranteed to be aligned on the size of a word
+inline Evt3::RawWord load_word(const uint8_t *data) {
+    Evt3::RawWord word;
+    std::memcpy(&word, data, WordSize);
+    return word;
+}
+
+inline int count_trailing_zeros(uint32_t value) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, value);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctz(value);
+#endif
+}
+
+inline int count_set_bits(uint32_t value) {
+#ifdef _MSC_VER
+    return static_cast<int>(__popcnt(value));
+#else
+    return __builtin_popcount(value);
+#endif
+}
+
+// Returns the first EVT_TIME_HIGH word of [cur, end), or end if there is none. Time highs being sparse, whole blocks of
+// words are skipped at once when none of their types matches
+inline const uint8_t *find_time_high(const uint8_t *cur, const uint8_t *end) {
+    constexpr uint16_t TimeHigh = static_cast<uint16_t>(Evt3::EventTypes::EVT_TIME_HIGH);
+#if defined(__AVX2__)
+    const __m256i time_high = _mm256_set1_epi16(TimeHigh);
+    for (; static_cast<size_t>(end - cur) >= sizeof(__m256i); cur += sizeof(__m256i)) {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(cur));
+        if (_mm256_movemask_epi8(_mm256_cmpeq_epi16(_mm256_srli_epi16(block, Evt3::TypeShift), time_high)) != 0) {
+            break;
+        }
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    const uint16x8_t time_high = vdupq_n_u16(TimeHigh);
+    for (; static_cast<size_t>(end - cur) >= sizeof(uint16x8_t); cur += sizeof(uint16x8_t)) {
+        const uint16x8_t block = vreinterpretq_u16_u8(vld1q_u8(cur));
+        if (vmaxvq_u16(vceqq_u16(vshrq_n_u16(block, Evt3::TypeShift), time_high)) != 0) {
+            break;
+        }
+    }
+#elif defined(__SSE2__)
+    const __m128i time_high = _mm_set1_epi16(TimeHigh);
+    for (; static_cast<size_t>(end - cur) >= sizeof(__m128i); cur += sizeof(__m128i)) {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(cur));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_srli_epi16(block, Evt3::TypeShift), time_high)) != 0) {
+            break;
+        }
+    }
+#endif
+    for (; static_cast<size_t>(end - cur) >= WordSize; cur += WordSize) {
+        if (Evt3::get_type(load_word(cur)) == Evt3::EventTypes::EVT_TIME_HIGH) {
+            return cur;
+        }
+    }
+    return end;
+}
+
+} // namespace
+
+EVT3Decoder::EVT3Decoder(bool time_shifting_enabled, const std::shared_ptr<I_EventDecoder<EventCD>> &event_cd_decoder,
+                         const std::shared_ptr<I_EventDecoder<EventExtTrigger>> &event_ext_trigger_decoder) :
+    I_Decoder(time_shifting_enabled, event_cd_decoder, event_ext_trigger_decoder),
+    decode_cd_(event_cd_decoder != nullptr),
+    decode_ext_trigger_(event_ext_trigger_decoder != nullptr),
+    time_base_(time_shifting_enabled) {}
+
+void EVT3Decoder::decode_impl(RawData *raw_data_begin, RawData *raw_data_end) {
+    const uint8_t *cur = raw_data_begin;
+    const uint8_t *end = raw_data_end;
+
+    if (!time_base_.is_time_base_set()) {
+        // The time of the events is unknown until the first time high
+        for (; cur != end && Evt3::get_type(load_word(cur)) != Evt3::EventTypes::EVT_TIME_HIGH; cur += WordSize) {}
+        if (cur == end) {
+            return;
+        }
+    }
+
+    for (; cur != end; cur += WordSize) {
+        const Evt3::RawWord word = load_word(cur);
+        switch (Evt3::get_type(word)) {
+        case Evt3::EventTypes::CD_Y:
+            is_cd_ = true;
+            y_     = word & Evt3::CoordMask;
+            break;
+        case Evt3::EventTypes::EM_Y:
+            is_cd_ = false;
+            break;
+        case Evt3::EventTypes::X_POS:
+            x_base_ = word & Evt3::CoordMask;
+            if (is_cd_ && decode_cd_) {
+                const short p          = static_cast<short>((word >> Evt3::PolarityShift) & 1);
+                DecodingFilter *filter = cd_event_filter();
+                if (!filter || (filter->is_accepted(x_base_, y_, p) && filter->decimate())) {
+                    cd_event_forwarder().forward(x_base_, y_, p, time_);
+                }
+            }
+            break;
+        case Evt3::EventTypes::X_BASE:
+            x_base_   = word & Evt3::CoordMask;
+            polarity_ = (word >> Evt3::PolarityShift) & 1;
+            break;
+        case Evt3::EventTypes::VECT_12:
+            decode_vector(word & Evt3::Vect12Mask, 12);
+            break;
+        case Evt3::EventTypes::VECT_8:
+            decode_vector(word & Evt3::Vect8Mask, 8);
+            break;
+        case Evt3::EventTypes::EVT_TIME_LOW: {
+            const timestamp previous_time = time_;
+            time_                         = time_base_.get_time(word & Evt3::TimeMask);
+            statistics_counters().out_of_order_timestamps += time_ < previous_time;
+            break;
+        }
+        case Evt3::EventTypes::EVT_TIME_HIGH: {
+            const timestamp previous_time_base = time_base_.get_time_base();
+            time_base_.add_time_high(word & Evt3::TimeMask);
+            time_          = time_base_.get_time_base();
+            auto &counters = statistics_counters();
+            ++counters.time_high_words;
+            counters.out_of_order_timestamps += time_ < previous_time_base;
+            break;
+        }
+        case Evt3::EventTypes::EXT_TRIGGER:
+            if (decode_ext_trigger_) {
+                trigger_event_forwarder().forward(static_cast<short>(word & 1), time_,
+                                                  static_cast<short>((word >> Evt3::TriggerIdShift) &
+                                                                     Evt3::TriggerIdMask));
+            }
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+void EVT3Decoder::decode_vector(uint32_t valid, int width) {
+    auto &counters = statistics_counters();
+    ++counters.vector_words;
+    counters.vector_events += count_set_bits(valid);
+
+    DecodingFilter *filter = cd_event_filter();
+    if (filter && valid) {
+        // The pixels rejected are masked out of the vector, which is skipped altogether if its row or polarity is
+        valid = filter->is_polarity_accepted(polarity_) ? valid & filter->get_row_mask(x_base_, y_, width) : 0;
+    }
+    if (valid && is_cd_ && decode_cd_) {
+        auto &cd_forwarder = cd_event_forwarder();
+        const timestamp t  = time_;
+        cd_forwarder.reserve(width);
+        // Only the set bits are visited: the cost depends on the number of events, not on the vector width
+        if (filter && filter->is_decimating()) {
+            do {
+                cd_forwarder.forward_unsafe_if(filter->decimate(),
+                                               static_cast<unsigned short>(x_base_ + count_trailing_zeros(valid)), y_,
+                                               polarity_, t);
+                valid &= valid - 1;
+            } while (valid);
+        } else {
+            do {
+                cd_forwarder.forward_unsafe(static_cast<unsigned short>(x_base_ + count_trailing_zeros(valid)), y_,
+                                            polarity_, t);
+                valid &= valid - 1;
+            } while (valid);
+        }
+    }
+    x_base_ += width;
+}
+
+bool EVT3Decoder::is_cd_event_filter_supported_impl() const {
+    return true;
+}
+
+bool EVT3Decoder::reset_last_timestamp_impl(const timestamp &t) {
+    time_base_.reset(t);
+    time_ = t;
+    // The addresses are sent again after a resync point
+    is_cd_ = false;
+    return true;
+}
+
+bool EVT3Decoder::reset_timestamp_shift_impl(const timestamp &shift) {
+    timestamp previous_shift;
+    time_base_.get_time_shift(previous_shift);
+    time_ += previous_shift - shift;
+    time_base_.set_time_shift(shift);
+    return true;
+}
+
+const I_Decoder::RawData *EVT3Decoder::find_resync_point(const RawData *raw_data_begin,
+                                                        const RawData *raw_data_end) const {
+    const RawData *cur = find_time_high(raw_data_begin, raw_data_end);
+    while (cur != raw_data_end) {
+        // The time high is a resync point only if the next address word is a Y address
+        const RawData *next = cur + WordSize;
+        for (; static_cast<size_t>(raw_data_end - next) >= WordSize; next += WordSize) {
+            const auto type = Evt3::get_type(load_word(next));
+            if (type == Evt3::EventTypes::CD_Y || type == Evt3::EventTypes::EM_Y) {
+                return cur;
+            }
+            if (type == Evt3::EventTypes::X_POS || type == Evt3::EventTypes::X_BASE ||
+                type == Evt3::EventTypes::VECT_12 || type == Evt3::EventTypes::VECT_8) {
+                break;
+            }
+        }
+        cur = find_time_high(next, raw_data_end);
+    }
+    return raw_data_end;
+}
+
+const I_Decoder::RawData *EVT3Decoder::find_time_base(const RawData *raw_data_begin, const RawData *raw_data_end,
+                                                     timestamp &time_base) const {
+    const RawData *time_high = find_time_high(raw_data_begin, raw_data_end);
+    if (time_high != raw_data_end) {
+        time_base = static_cast<timestamp>(load_word(time_high) & Evt3::TimeMask) << Evt3::TimeLowBits;
+    }
+    return time_high;
+}
+
+timestamp EVT3Decoder::get_time_base_period() const {
+    return timestamp(1) << (2 * Evt3::TimeLowBits);
+}
+
+timestamp EVT3Decoder::get_last_timestamp() const {
+    return time_;
+}
+
+bool EVT3Decoder::get_timestamp_shift(timestamp &timestamp_shift) const {
+    return time_base_.get_time_shift(timestamp_shift);
+}
+
+uint8_t EVT3Decoder::get_raw_event_size_bytes() const {
+    return WordSize;
+}
+
+} // namespace Metavision
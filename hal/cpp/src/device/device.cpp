@@ -15,8 +15,11 @@
 namespace Metavision {
 
 void Device::register_facility(std::unique_ptr<FacilityWrapper> p) {
-    auto h         = std::hash<std::string>{}(p->facility()->registration_info().name());
-    facilities_[h] = std::move(p);
+    const size_t index = get_facility_index(p->facility()->registration_info());
+    if (index >= facilities_.size()) {
+        facilities_.resize(index + 1);
+    }
+    facilities_[index] = std::move(p);
 }
 
 } // namespace Metavision
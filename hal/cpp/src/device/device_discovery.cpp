@@ -16,6 +16,10 @@
 #include <map>
 #include <vector>
 #include <algorithm>
+#include <fstream>
+#include <future>
+#include <mutex>
+#include <utility>
 #include <dirent.h>
 #ifdef _WIN32
 #include <windows.h>
@@ -27,6 +31,14 @@
 #include "metavision/hal/device/device.h"
 #include "metavision/hal/utils/device_builder.h"
 #include "metavision/hal/utils/raw_file_header.h"
+#include "metavision/hal/utils/raw_file_index.h"
+#include "metavision/hal/utils/raw_file_playlist_stream.h"
+#include "metavision/hal/utils/compressed_raw_file_stream.h"
+#include "metavision/hal/utils/network_raw_stream.h"
+#include "metavision/hal/utils/performance_profile.h"
+#include "metavision/hal/utils/shared_memory_raw_stream.h"
+#include "metavision/hal/utils/striped_raw_file_writer.h"
+#include "metavision/hal/facilities/i_decoder.h"
 #include "metavision/hal/facilities/i_events_stream.h"
 #include "metavision/hal/facilities/i_hal_software_info.h"
 #include "metavision/hal/facilities/i_plugin_software_info.h"
@@ -39,9 +51,14 @@
 #include "metavision/hal/utils/hal_error_code.h"
 #include "metavision/hal/utils/hal_exception.h"
 #include "metavision/hal/utils/hal_log.h"
+#include "metavision/hal/utils/memory_mapped_file_stream.h"
+#include "metavision/hal/utils/memory_raw_stream.h"
+#include "metavision/hal/utils/ranged_read_backend.h"
+#include "metavision/hal/utils/read_ahead_file_stream.h"
 #include "metavision/hal/utils/resources_folder.h"
 #include "metavision/hal/plugin/plugin.h"
 #include "metavision/hal/plugin/detail/plugin_loader.h"
+#include "metavision/hal/plugin/static_plugin.h"
 
 namespace {
 
@@ -54,22 +71,70 @@ enum CameraType {
 std::string CameraTypeLabels[] = {"remote", "local", "any"};
 
 Metavision::PluginLoader plugin_loader;
+std::mutex plugin_loader_mutex;
 
-Metavision::PluginLoader::PluginList get_plugins() {
-    static bool loaded            = false;
-    static char *last_plugin_path = nullptr;
+// Number of ranges of a remote RAW file fetched in parallel, unless more are configured
+constexpr uint32_t DefaultRemoteReadsInFlight = 8;
+
+// Plugin and file discovery that last opened a stream, indexed by the integrator and plugin names of its header
+struct FileDiscoveryCacheEntry {
+    std::string integrator_name;
+    std::string plugin_name;
+    std::string file_discovery_name;
+};
+std::map<std::pair<std::string, std::string>, FileDiscoveryCacheEntry> file_discovery_cache;
+std::mutex file_discovery_cache_mutex;
+
+// Gets the path of the manifest of the plugins, which can be set (or disabled, if empty) with MV_HAL_PLUGIN_MANIFEST
+std::string get_plugin_manifest_path() {
+    if (const char *path = getenv("MV_HAL_PLUGIN_MANIFEST")) {
+        return path;
+    }
+#ifdef _WIN32
+    const char *cache_folder = getenv("LOCALAPPDATA");
+    return cache_folder ? std::string(cache_folder) + "\\metavision_hal_plugins_manifest" : "";
+#else
+    if (const char *cache_folder = getenv("XDG_CACHE_HOME")) {
+        return std::string(cache_folder) + "/metavision_hal_plugins_manifest";
+    }
+    const char *home_folder = getenv("HOME");
+    return home_folder ? std::string(home_folder) + "/.cache/metavision_hal_plugins_manifest" : "";
+#endif
+}
+
+// Gets the plugins accepted by a filter, only the libraries of the plugins that are not in the manifest of the plugins
+// being loaded
+Metavision::PluginLoader::PluginList get_plugins(const Metavision::PluginLoader::PluginFilter &filter =
+                                                     [](const Metavision::PluginLoader::PluginDescription &) {
+                                                         return true;
+                                                     }) {
+    static bool loaded                  = false;
+    static std::string last_plugin_path = "";
+
+    // The plugins can be listed from several threads, for instance when listing local and remote cameras concurrently
+    std::lock_guard<std::mutex> lock(plugin_loader_mutex);
 
     MV_HAL_LOG_TRACE() << "Loading plugins";
 
+    // The plugins linked in the application are listed whether the plugin folders are scanned or not
+    for (const auto &static_plugin : Metavision::get_static_plugins()) {
+        plugin_loader.insert_static_plugin(static_plugin.first, static_plugin.second);
+    }
+    if (!Metavision::is_dynamic_plugin_loading_enabled()) {
+        MV_HAL_LOG_TRACE() << "  Loading of the plugins from the plugin folders is disabled";
+        return plugin_loader.get_plugin_list(filter);
+    }
+
     char *plugin_path = getenv("MV_HAL_PLUGIN_PATH");
-    if (loaded && (!plugin_path || strcmp(plugin_path, last_plugin_path) == 0)) {
+    if (loaded && (!plugin_path || last_plugin_path == plugin_path)) {
         MV_HAL_LOG_TRACE()
             << "  MV_HAL_PLUGIN_PATH did not change and plugins are already loaded, no need to reload plugins";
-        return plugin_loader.get_plugin_list();
+        return plugin_loader.get_plugin_list(filter);
     }
-    last_plugin_path = plugin_path;
+    last_plugin_path = plugin_path ? plugin_path : "";
 
     plugin_loader.clear_folders();
+    plugin_loader.set_manifest_path(get_plugin_manifest_path());
     MV_HAL_LOG_TRACE() << "  Setting up search paths";
     if (plugin_path) {
         std::string plugin_folders(plugin_path);
@@ -108,21 +173,21 @@ Metavision::PluginLoader::PluginList get_plugins() {
     bool has_camera_discovery = false;
     bool has_file_discovery   = false;
     plugin_loader.load_plugins();
-    auto plugin_list = plugin_loader.get_plugin_list();
-    for (auto &plugin : plugin_list) {
-        if (plugin.get_camera_discovery_list().size() != 0) {
+    auto plugin_descriptions = plugin_loader.get_plugin_descriptions();
+    for (auto &plugin : plugin_descriptions) {
+        if (plugin.camera_discovery_count != 0) {
             has_camera_discovery = true;
         }
-        if (plugin.get_file_discovery_list().size() != 0) {
+        if (plugin.file_discovery_count != 0) {
             has_file_discovery = true;
         }
-        MV_HAL_LOG_TRACE() << Metavision::Log::no_space << "    [" << plugin.get_plugin_name() << "] ("
-                           << plugin.get_integrator_name() << ") " << plugin.get_camera_discovery_list().size()
-                           << " camera discoveries " << plugin.get_file_discovery_list().size() << " file discoveries";
+        MV_HAL_LOG_TRACE() << Metavision::Log::no_space << "    [" << plugin.name << "] (" << plugin.integrator_name
+                           << ") " << plugin.camera_discovery_count << " camera discoveries "
+                           << plugin.file_discovery_count << " file discoveries";
     }
 
     if (!has_camera_discovery || !has_file_discovery) {
-        if (plugin_list.empty()) {
+        if (plugin_descriptions.empty()) {
             MV_HAL_LOG_WARNING() << "    no plugin found";
         } else if (!has_camera_discovery && !has_file_discovery) {
             MV_HAL_LOG_WARNING() << "    no plugin provides either camera or file discovery functionnality";
@@ -134,11 +199,52 @@ Metavision::PluginLoader::PluginList get_plugins() {
             MV_HAL_LOG_WARNING() << "    no plugin provides either camera or file discovery functionnality";
         }
     } else {
-        MV_HAL_LOG_TRACE() << "  Found" << plugin_list.size() << "plugins";
+        MV_HAL_LOG_TRACE() << "  Found" << plugin_descriptions.size() << "plugins";
     }
     loaded = true;
 
-    return plugin_loader.get_plugin_list();
+    return plugin_loader.get_plugin_list(filter);
+}
+
+// Lists of the cameras found by the camera discoveries of a plugin
+template<typename ListType>
+struct PluginCameraLists {
+    Metavision::Plugin *plugin;
+    std::vector<std::pair<std::string, ListType>> lists; // Name of each camera discovery, and the cameras it found
+};
+
+// Lists the cameras of the given type found by each plugin, calling the camera discoveries of the different plugins
+// concurrently
+template<typename ListType, typename ListFunction>
+std::vector<PluginCameraLists<ListType>> list_cameras_of_plugins(CameraType flag, ListFunction list_function) {
+    // The libraries of the plugins are loaded one after the other, only their discoveries run concurrently
+    std::vector<Metavision::Plugin *> plugins;
+    for (auto &plugin : get_plugins([](const Metavision::PluginLoader::PluginDescription &description) {
+             return description.camera_discovery_count != 0;
+         })) {
+        plugins.push_back(&plugin);
+    }
+
+    std::vector<std::future<PluginCameraLists<ListType>>> futures;
+    for (auto *plugin : plugins) {
+        futures.push_back(std::async(std::launch::async, [plugin, flag, &list_function]() {
+            PluginCameraLists<ListType> plugin_lists{plugin, {}};
+            for (auto &camera_discovery : plugin->get_camera_discovery_list()) {
+                // Checks local or remote camera
+                if ((flag & (camera_discovery.is_for_local_camera() ? 2 : 1)) == 0) {
+                    continue;
+                }
+                plugin_lists.lists.emplace_back(camera_discovery.get_name(), list_function(camera_discovery));
+            }
+            return plugin_lists;
+        }));
+    }
+
+    std::vector<PluginCameraLists<ListType>> plugins_lists;
+    for (auto &future : futures) {
+        plugins_lists.push_back(future.get());
+    }
+    return plugins_lists;
 }
 
 std::string get_full_serial(const std::string &integrator, const std::string &plugin, const std::string &serial) {
@@ -168,6 +274,68 @@ void log_plugin_error(const Metavision::Plugin &plugin, const std::string &disco
     common_log_plugin_error(plugin, discovery_name);
     MV_HAL_LOG_ERROR() << "Failed with non Metavision HAL default exception:";
 }
+
+// Loads the index of a RAW file from its sidecar if it is up to date, otherwise builds it if requested
+std::shared_ptr<const Metavision::RawFileIndex> get_raw_file_index(const std::string &raw_file,
+                                                                   const Metavision::RawFileConfig &file_config) {
+    // The index of a remote file is only loaded from its sidecar, if it has been uploaded along with it: building it
+    // would require downloading the whole file
+    if (Metavision::RangedReadBackend::is_remote(raw_file)) {
+        const std::string index_url = Metavision::RawFileIndex::get_sidecar_path(raw_file);
+        try {
+            const uint64_t raw_file_size = Metavision::RangedReadBackend::open(raw_file)->get_size();
+            Metavision::ReadAheadFileStream index_stream(Metavision::RangedReadBackend::open(index_url), 1);
+            auto index = std::make_shared<Metavision::RawFileIndex>();
+            if (index->load(index_stream) && index->get_raw_file_size() == raw_file_size) {
+                return index;
+            }
+        } catch (const Metavision::HalException &) {}
+        MV_HAL_LOG_INFO() << "No index found for remote RAW file" << raw_file << ", seeking is not available";
+        return nullptr;
+    }
+
+    // The offsets of the index of a compressed file are the ones of the decompressed data
+    std::unique_ptr<std::istream> ifs;
+    if (Metavision::StripedRawFileWriter::is_manifest(raw_file)) {
+        ifs = Metavision::RawFilePlaylistStream::open_stripes(raw_file);
+    } else if (Metavision::CompressedRawFileStream::is_compressed(raw_file)) {
+        ifs = std::make_unique<Metavision::CompressedRawFileStream>(raw_file, file_config.n_decompression_threads_);
+    } else {
+        ifs = std::make_unique<std::ifstream>(raw_file, std::ios::in | std::ios::binary);
+    }
+    ifs->seekg(0, std::ios::end);
+    const auto raw_file_size     = static_cast<uint64_t>(ifs->tellg());
+    const std::string index_path = Metavision::RawFileIndex::get_sidecar_path(raw_file);
+    auto index                   = std::make_shared<Metavision::RawFileIndex>();
+    if (index->load(index_path) && index->get_raw_file_size() == raw_file_size) {
+        return index;
+    }
+    if (!file_config.build_index_) {
+        return nullptr;
+    }
+
+    // The index is built with a decoder of its own, which does not shift the timestamps
+    Metavision::RawFileConfig index_config = file_config;
+    index_config.do_time_shifting_         = false;
+    index_config.build_index_              = false;
+    auto device                            = Metavision::DeviceDiscovery::open_raw_file(raw_file, index_config);
+    auto *decoder                          = device->get_facility<Metavision::I_Decoder>();
+    if (!decoder) {
+        return nullptr;
+    }
+
+    ifs->seekg(0);
+    Metavision::RawFileHeader header(*ifs);
+    *index = Metavision::RawFileIndex::build(*ifs, *decoder);
+    if (index->empty()) {
+        MV_HAL_LOG_WARNING() << "The format of RAW file" << raw_file << "does not support indexing";
+        return nullptr;
+    }
+    if (!index->save(index_path)) {
+        MV_HAL_LOG_WARNING() << "Unable to save the index of RAW file" << raw_file << "in" << index_path;
+    }
+    return index;
+}
 } // anonymous namespace
 
 namespace Metavision {
@@ -196,23 +364,15 @@ DeviceDiscovery::SerialList list_serial_camera(CameraType flag = ANY) {
 
     MV_HAL_LOG_TRACE() << "Listing cameras of" << CameraTypeLabels[flag - 1] << "type";
 
-    for (auto &plugin : get_plugins()) {
+    auto plugins_lists = list_cameras_of_plugins<CameraDiscovery::SerialList>(
+        flag, [](CameraDiscovery &camera_discovery) { return camera_discovery.list(); });
+    for (auto &plugin_lists : plugins_lists) {
+        auto &plugin = *plugin_lists.plugin;
         MV_HAL_LOG_TRACE() << Log::no_space << "  Plugin [" << plugin.get_plugin_name() << "] ("
                            << plugin.get_integrator_name() << ")";
-        if (plugin.get_camera_discovery_list().empty() && plugin.get_file_discovery_list().empty())
-            continue;
-        for (auto &camera_discovery : plugin.get_camera_discovery_list()) {
-            if (camera_discovery.is_for_local_camera()) {
-                // Check local camera
-                if ((flag & 2) == 0)
-                    continue;
-            } else {
-                // Check remote camera
-                if ((flag & 1) == 0)
-                    continue;
-            }
-            auto list_serial = camera_discovery.list();
-            auto log = MV_HAL_LOG_TRACE() << Log::no_endline << "    Camera discovery" << camera_discovery.get_name();
+        for (auto &discovery_list : plugin_lists.lists) {
+            auto &list_serial = discovery_list.second;
+            auto log = MV_HAL_LOG_TRACE() << Log::no_endline << "    Camera discovery" << discovery_list.first;
             if (list_serial.empty()) {
                 log << "does not recognize any device" << std::endl;
             } else {
@@ -233,23 +393,15 @@ DeviceDiscovery::SystemList list_systems_camera(CameraType flag = ANY) {
 
     MV_HAL_LOG_TRACE() << "Listing cameras of" << CameraTypeLabels[flag - 1] << "type";
 
-    for (auto &plugin : get_plugins()) {
+    auto plugins_lists = list_cameras_of_plugins<CameraDiscovery::SystemList>(
+        flag, [](CameraDiscovery &camera_discovery) { return camera_discovery.list_available_sources(); });
+    for (auto &plugin_lists : plugins_lists) {
+        auto &plugin = *plugin_lists.plugin;
         MV_HAL_LOG_TRACE() << Log::no_space << "  Plugin [" << plugin.get_plugin_name() << "] ("
                            << plugin.get_integrator_name() << ")";
-        bool has_serial = false;
-        for (auto &camera_discovery : plugin.get_camera_discovery_list()) {
-            if (camera_discovery.is_for_local_camera()) {
-                // Check local camera
-                if ((flag & 2) == 0)
-                    continue;
-            } else {
-                // Check remote camera
-                if ((flag & 1) == 0)
-                    continue;
-            }
-
-            CameraDiscovery::SystemList list_systems = camera_discovery.list_available_sources();
-            auto log = MV_HAL_LOG_TRACE() << Log::no_endline << "    Camera discovery" << camera_discovery.get_name();
+        for (auto &discovery_list : plugin_lists.lists) {
+            auto &list_systems = discovery_list.second;
+            auto log = MV_HAL_LOG_TRACE() << Log::no_endline << "    Camera discovery" << discovery_list.first;
             if (list_systems.empty()) {
                 log << "does not recognize any device" << std::endl;
             } else {
@@ -302,16 +454,49 @@ std::unique_ptr<Device> DeviceDiscovery::open(const std::string &serial) {
 std::unique_ptr<Device> DeviceDiscovery::open(const std::string &input_serial, DeviceConfig &config) {
     MV_HAL_LOG_TRACE() << "Opening camera with serial:" << input_serial;
 
+    static const std::string shared_memory_prefix = "shm://";
+    static const std::string network_prefix       = "tcp://";
+    const bool is_shared_memory = input_serial.compare(0, shared_memory_prefix.size(), shared_memory_prefix) == 0;
+    const bool is_network       = input_serial.compare(0, network_prefix.size(), network_prefix) == 0;
+    if (is_shared_memory || is_network) {
+        RawFileConfig stream_config;
+        stream_config.performance_profile_ = config.performance_profile_;
+        std::unique_ptr<Device> device;
+        if (is_shared_memory) {
+            device = open_shared_memory(input_serial.substr(shared_memory_prefix.size()), stream_config);
+        } else {
+            const std::string address = input_serial.substr(network_prefix.size());
+            const size_t port_pos     = address.rfind(':');
+            if (port_pos == std::string::npos) {
+                throw HalException(HalErrorCode::InvalidArgument,
+                                   "Invalid serial '" + input_serial + "', expected tcp://<host>:<port>");
+            }
+            int port = 0;
+            try {
+                port = std::stoi(address.substr(port_pos + 1));
+            } catch (const std::exception &) { port = -1; }
+            if (port <= 0 || port > 65535) {
+                throw HalException(HalErrorCode::InvalidArgument, "Invalid port in serial '" + input_serial + "'");
+            }
+            device = open_network_stream(address.substr(0, port_pos), static_cast<uint16_t>(port), stream_config);
+        }
+        if (auto events_stream = device ? device->get_facility<I_EventsStream>() : nullptr) {
+            events_stream->set_thread_policy(config.thread_policy_);
+        }
+        return device;
+    }
+
     std::unique_ptr<Device> device;
-    std::string integrator_name;
-    std::string plugin_name;
 
     // split name plugin_name:intergrator:serial
-    size_t pos             = 0;
-    std::string tmp_serial = input_serial;
-    std::string delimiter  = ":";
+    // The serials of synthetic sources hold their configuration, and are given as is to the camera discoveries
+    static const std::string synthetic_prefix = "synthetic:";
+    const bool is_synthetic = input_serial.compare(0, synthetic_prefix.size(), synthetic_prefix) == 0;
+    size_t pos              = 0;
+    std::string tmp_serial  = input_serial;
+    std::string delimiter   = ":";
     std::vector<std::string> fields;
-    while ((pos = tmp_serial.find(delimiter)) != std::string::npos) {
+    while (!is_synthetic && (pos = tmp_serial.find(delimiter)) != std::string::npos) {
         auto field = tmp_serial.substr(0, pos);
         fields.push_back(field);
         tmp_serial.erase(0, pos + delimiter.length());
@@ -330,25 +515,22 @@ std::unique_ptr<Device> DeviceDiscovery::open(const std::string &input_serial, D
         input_plugin_name     = fields[1];
     }
 
-    for (auto &plugin : get_plugins()) {
-        if (device) {
-            break;
-        }
-
-        plugin_name     = plugin.get_plugin_name();
-        integrator_name = plugin.get_integrator_name();
+    // Only the libraries of the plugins matching the serial are loaded
+    auto plugins = get_plugins([&](const PluginLoader::PluginDescription &description) {
+        const std::string &plugin_name     = description.name;
+        const std::string &integrator_name = description.integrator_name;
         if ((!input_integrator_name.empty() && input_integrator_name != integrator_name) ||
-            (!input_plugin_name.empty() && input_plugin_name != plugin_name)) {
+            (!input_plugin_name.empty() && input_plugin_name != plugin_name) ||
+            (!input_common_name.empty() && input_common_name != integrator_name && input_common_name != plugin_name)) {
             MV_HAL_LOG_TRACE() << Log::no_space << "  Plugin [" << plugin_name << "] (" << integrator_name
                                << ") does not match the serial";
-            continue;
+            return false;
         }
-        if (!input_common_name.empty()) {
-            if (input_common_name != integrator_name && input_common_name != plugin_name) {
-                MV_HAL_LOG_TRACE() << Log::no_space << "  Plugin [" << plugin_name << "] (" << integrator_name
-                                   << ") does not match the serial";
-                continue;
-            }
+        return description.camera_discovery_count != 0;
+    });
+    for (auto &plugin : plugins) {
+        if (device) {
+            break;
         }
 
         MV_HAL_LOG_TRACE() << Log::no_space << "  Plugin [" << plugin.get_plugin_name() << "] ("
@@ -379,6 +561,15 @@ std::unique_ptr<Device> DeviceDiscovery::open(const std::string &input_serial, D
         }
     }
 
+    if (device) {
+        if (auto events_stream = device->get_facility<I_EventsStream>()) {
+            events_stream->set_thread_policy(config.thread_policy_);
+        }
+        if (config.performance_profile_ != PerformanceProfile::Balanced) {
+            apply_performance_profile(*device, config.performance_profile_);
+        }
+    }
+
     return device;
 }
 
@@ -388,7 +579,36 @@ std::unique_ptr<Device> DeviceDiscovery::open_raw_file(const std::string &raw_fi
 }
 
 std::unique_ptr<Device> DeviceDiscovery::open_raw_file(const std::string &raw_file, RawFileConfig &file_config) {
-    auto ifs = std::make_unique<std::ifstream>(raw_file, std::ios::in | std::ios::binary);
+    std::unique_ptr<std::istream> ifs;
+    if (RangedReadBackend::is_remote(raw_file)) {
+        // The latency of remote storages is hidden by fetching several ranges in parallel, ahead of the decoding
+        if (file_config.n_reads_in_flight_ <= 1) {
+            file_config.n_reads_in_flight_ = DefaultRemoteReadsInFlight;
+        }
+        file_config.n_read_buffers_ = std::max(file_config.n_read_buffers_, file_config.n_reads_in_flight_ + 1);
+        ifs = std::make_unique<ReadAheadFileStream>(RangedReadBackend::open(raw_file), file_config.n_reads_in_flight_);
+    } else if (StripedRawFileWriter::is_manifest(raw_file)) {
+        // The stripes are read from their files in turn, the next one being prefetched
+        ifs = RawFilePlaylistStream::open_stripes(raw_file);
+    } else if (CompressedRawFileStream::is_compressed(raw_file)) {
+        // Compressed data can be neither mapped nor read ahead, the decompression reads the chunks ahead instead
+        ifs = std::make_unique<CompressedRawFileStream>(raw_file, file_config.n_decompression_threads_);
+    }
+    if (!ifs && file_config.use_memory_mapping_) {
+        try {
+            ifs = std::make_unique<MemoryMappedFileStream>(raw_file);
+        } catch (const HalException &e) {
+            MV_HAL_LOG_WARNING() << "Unable to map RAW file '" + raw_file + "' in memory, falling back to standard "
+                                    "reading:"
+                                 << e.what();
+        }
+    }
+    if (!ifs && file_config.n_reads_in_flight_ > 1) {
+        ifs = std::make_unique<ReadAheadFileStream>(raw_file, file_config.n_reads_in_flight_);
+    }
+    if (!ifs) {
+        ifs = std::make_unique<std::ifstream>(raw_file, std::ios::in | std::ios::binary);
+    }
     if (!ifs->good()) {
         throw HalException(HalErrorCode::FailedInitialization, "Unable to open RAW file '" + raw_file + "'");
     }
@@ -399,6 +619,12 @@ std::unique_ptr<Device> DeviceDiscovery::open_raw_file(const std::string &raw_fi
         auto *event_stream = device->get_facility<I_EventsStream>();
         if (event_stream) {
             event_stream->set_underlying_filename(raw_file);
+            event_stream->set_raw_file_index(get_raw_file_index(raw_file, file_config));
+            auto *decoder = device->get_facility<I_Decoder>();
+            if (file_config.n_us_to_read_ > 0 && (!decoder || !event_stream->adapt_read_size(*decoder))) {
+                MV_HAL_LOG_WARNING() << "The size of the reads of RAW file '" + raw_file +
+                                            "' can not be adapted to the rate of its events, using a fixed size";
+            }
         }
 
     } catch (const HalException &e) {
@@ -409,6 +635,54 @@ std::unique_ptr<Device> DeviceDiscovery::open_raw_file(const std::string &raw_fi
     return device;
 }
 
+std::unique_ptr<Device> DeviceDiscovery::open_raw_files(const std::vector<std::string> &raw_files,
+                                                        RawFileConfig &file_config) {
+    if (raw_files.empty()) {
+        throw HalException(HalErrorCode::InvalidArgument, "No RAW file to open.");
+    }
+    if (raw_files.size() == 1) {
+        return open_raw_file(raw_files.front(), file_config);
+    }
+
+    std::unique_ptr<Device> device;
+    try {
+        device = open_stream(std::make_unique<RawFilePlaylistStream>(raw_files), file_config);
+        auto *event_stream = device->get_facility<I_EventsStream>();
+        auto *decoder      = device->get_facility<I_Decoder>();
+        if (event_stream && file_config.n_us_to_read_ > 0 && (!decoder || !event_stream->adapt_read_size(*decoder))) {
+            MV_HAL_LOG_WARNING() << "The size of the reads of the RAW files can not be adapted to the rate of their "
+                                    "events, using a fixed size";
+        }
+    } catch (const HalException &e) {
+        MV_HAL_LOG_ERROR() << Log::no_space << "While opening the playlist of RAW files starting with '"
+                           << raw_files.front() << "':" << std::endl;
+        throw e;
+    }
+
+    return device;
+}
+
+std::unique_ptr<Device> DeviceDiscovery::open_shared_memory(const std::string &name, RawFileConfig &stream_config) {
+    std::unique_ptr<std::istream> stream = std::make_unique<SharedMemoryRawStream>(name);
+    if (!stream->good()) {
+        throw HalException(HalErrorCode::FailedInitialization, "Unable to read shared memory ring '" + name + "'");
+    }
+    return open_stream(std::move(stream), stream_config);
+}
+
+std::unique_ptr<Device> DeviceDiscovery::open_memory(const std::vector<MemoryRawStream::Buffer> &buffers,
+                                                     RawFileConfig &stream_config,
+                                                     const std::shared_ptr<const void> &owner) {
+    std::unique_ptr<std::istream> stream = std::make_unique<MemoryRawStream>(buffers, owner);
+    return open_stream(std::move(stream), stream_config);
+}
+
+std::unique_ptr<Device> DeviceDiscovery::open_network_stream(const std::string &host, uint16_t port,
+                                                             RawFileConfig &stream_config) {
+    std::unique_ptr<std::istream> stream = std::make_unique<NetworkRawStream>(host, port);
+    return open_stream(std::move(stream), stream_config);
+}
+
 std::unique_ptr<Device> DeviceDiscovery::open_stream(std::unique_ptr<std::istream> stream,
                                                      RawFileConfig &stream_config) {
     if (!stream) {
@@ -416,74 +690,145 @@ std::unique_ptr<Device> DeviceDiscovery::open_stream(std::unique_ptr<std::istrea
                            "Failed to read from input stream: invalid pointer (nullptr)");
     }
 
+    if (stream_config.performance_profile_ != PerformanceProfile::Balanced) {
+        const PerformanceSettings settings = get_performance_settings(stream_config.performance_profile_);
+        stream_config.n_events_to_read_    = settings.n_events_to_read;
+        stream_config.n_read_buffers_      = std::max(stream_config.n_read_buffers_, settings.n_read_buffers);
+    }
+
     std::unique_ptr<Device> device;
 
     RawFileHeader header(*stream);
 
     std::string input_integrator_name = header.get_integrator_name();
     std::string input_plugin_name     = header.get_plugin_name();
-    std::string plugin_name, integrator_name;
 
     MV_HAL_LOG_TRACE() << Log::no_space << "Opening camera from stream, identified as ["
                        << (input_plugin_name.empty() ? "Unknown" : input_plugin_name) << "] ("
                        << (input_integrator_name.empty() ? "Unknown" : input_integrator_name) << ")";
 
-    for (auto &plugin : get_plugins()) {
-        if (device) {
-            break;
+    // Tries to open the stream with a file discovery, returns false if the stream was lost in the attempt
+    auto try_file_discovery = [&](Plugin &plugin, FileDiscovery &file_discovery) {
+        MV_HAL_LOG_TRACE() << "    File discovery" << file_discovery.get_name();
+        try {
+            DeviceBuilder device_builder(
+                std::make_unique<I_HALSoftwareInfo>(plugin.get_hal_info()),
+                std::make_unique<I_PluginSoftwareInfo>(plugin.get_plugin_name(), plugin.get_plugin_info()));
+            if (file_discovery.discover(device_builder, stream, header, stream_config)) {
+                MV_HAL_LOG_TRACE() << "      -> Can open the file";
+                device = device_builder();
+            } else {
+                MV_HAL_LOG_TRACE() << "      -> Cannot open the file";
+                if (!stream) {
+                    // We can get here if the implementation takes ownership of the stream but the output device is
+                    // null. The requirements (see documentation of the 'open' method in the FileDiscovery) have
+                    // not been fulfilled.
+                    log_plugin_error(plugin, file_discovery.get_name());
+                    MV_HAL_LOG_ERROR() << "\nThe plugin was expected to be able to read from the input stream, but a "
+                                          "null device was constructed.";
+                    return false;
+                }
+            }
+        } catch (HalException &e) {
+            log_plugin_error(plugin, file_discovery.get_name(), e);
+        } catch (const std::exception &e) { log_plugin_error(plugin, file_discovery.get_name(), e); } catch (...) {
+            log_plugin_error(plugin, file_discovery.get_name());
         }
-
-        plugin_name     = plugin.get_plugin_name();
-        integrator_name = plugin.get_integrator_name();
-        if (input_integrator_name.empty() && input_plugin_name.empty()) {
-            if (integrator_name != "Prophesee") {
-                // for backward compatibility with our old RAW files where these
-                // fields were not yet added in the header
-                continue;
+        return true;
+    };
+
+    // The file discovery that opened the last stream with the same header is tried first, so that opening many files
+    // from the same source neither goes through the other plugins nor loads their libraries
+    const auto cache_key = std::make_pair(input_integrator_name, input_plugin_name);
+    FileDiscoveryCacheEntry cached;
+    bool has_cached = false;
+    {
+        std::lock_guard<std::mutex> lock(file_discovery_cache_mutex);
+        auto it = file_discovery_cache.find(cache_key);
+        if (it != file_discovery_cache.end()) {
+            cached     = it->second;
+            has_cached = true;
+        }
+    }
+    auto is_cached = [&](const Plugin &plugin, const FileDiscovery &file_discovery) {
+        return has_cached && plugin.get_plugin_name() == cached.plugin_name &&
+               plugin.get_integrator_name() == cached.integrator_name &&
+               file_discovery.get_name() == cached.file_discovery_name;
+    };
+    if (has_cached) {
+        auto plugins = get_plugins([&](const PluginLoader::PluginDescription &description) {
+            return description.name == cached.plugin_name && description.integrator_name == cached.integrator_name;
+        });
+        for (auto &plugin : plugins) {
+            for (auto &file_discovery : plugin.get_file_discovery_list()) {
+                if (!device && is_cached(plugin, file_discovery)) {
+                    MV_HAL_LOG_TRACE() << Log::no_space << "  Plugin [" << plugin.get_plugin_name() << "] ("
+                                       << plugin.get_integrator_name() << ") opened the last stream with this header";
+                    if (!try_file_discovery(plugin, file_discovery)) {
+                        return nullptr;
+                    }
+                }
             }
-        } else if ((!input_integrator_name.empty() && input_integrator_name != integrator_name) ||
-                   (!input_plugin_name.empty() && input_plugin_name != plugin_name)) {
-            MV_HAL_LOG_TRACE() << Log::no_space << "  Plugin [" << plugin_name << "] (" << integrator_name
-                               << ") does not match the header";
-            continue;
         }
+    }
 
-        MV_HAL_LOG_TRACE() << Log::no_space << "  Plugin [" << plugin.get_plugin_name() << "] ("
-                           << plugin.get_integrator_name() << ") matches the header";
-        for (auto &file_discovery : plugin.get_file_discovery_list()) {
+    // Otherwise, only the libraries of the plugins matching the header are loaded
+    if (!device) {
+        auto plugins = get_plugins([&](const PluginLoader::PluginDescription &description) {
+            const std::string &plugin_name     = description.name;
+            const std::string &integrator_name = description.integrator_name;
+            if (input_integrator_name.empty() && input_plugin_name.empty()) {
+                if (integrator_name != "Prophesee") {
+                    // for backward compatibility with our old RAW files where these
+                    // fields were not yet added in the header
+                    return false;
+                }
+            } else if ((!input_integrator_name.empty() && input_integrator_name != integrator_name) ||
+                       (!input_plugin_name.empty() && input_plugin_name != plugin_name)) {
+                MV_HAL_LOG_TRACE() << Log::no_space << "  Plugin [" << plugin_name << "] (" << integrator_name
+                                   << ") does not match the header";
+                return false;
+            }
+            return description.file_discovery_count != 0;
+        });
+        for (auto &plugin : plugins) {
             if (device) {
                 break;
             }
-            MV_HAL_LOG_TRACE() << "    File discovery" << file_discovery.get_name();
-            try {
-                DeviceBuilder device_builder(
-                    std::make_unique<I_HALSoftwareInfo>(plugin.get_hal_info()),
-                    std::make_unique<I_PluginSoftwareInfo>(plugin.get_plugin_name(), plugin.get_plugin_info()));
-                if (file_discovery.discover(device_builder, stream, header, stream_config)) {
-                    MV_HAL_LOG_TRACE() << "      -> Can open the file";
-                    device = device_builder();
-                } else {
-                    MV_HAL_LOG_TRACE() << "      -> Cannot open the file";
-                    if (!stream) {
-                        // We can get here if the implementation takes ownership of the stream but the output device is
-                        // null. The requirements (see documentation of the 'open' method in the FileDiscovery) have
-                        // not been fulfilled.
-                        log_plugin_error(plugin, file_discovery.get_name());
-                        MV_HAL_LOG_ERROR()
-                            << "\nThe plugin was expected to be able to read from the input stream, but a "
-                               "null device was constructed.";
-                        return nullptr;
-                    }
+
+            MV_HAL_LOG_TRACE() << Log::no_space << "  Plugin [" << plugin.get_plugin_name() << "] ("
+                               << plugin.get_integrator_name() << ") matches the header";
+            for (auto &file_discovery : plugin.get_file_discovery_list()) {
+                if (device) {
+                    break;
+                }
+                if (is_cached(plugin, file_discovery)) {
+                    // The cached file discovery has already failed to open the stream
+                    continue;
+                }
+                if (!try_file_discovery(plugin, file_discovery)) {
+                    return nullptr;
+                }
+                if (device) {
+                    std::lock_guard<std::mutex> lock(file_discovery_cache_mutex);
+                    file_discovery_cache[cache_key] = {plugin.get_integrator_name(), plugin.get_plugin_name(),
+                                                       file_discovery.get_name()};
                 }
-            } catch (HalException &e) {
-                log_plugin_error(plugin, file_discovery.get_name(), e);
-            } catch (const std::exception &e) { log_plugin_error(plugin, file_discovery.get_name(), e); } catch (...) {
-                log_plugin_error(plugin, file_discovery.get_name());
             }
         }
     }
 
     if (device) {
+        if (stream_config.loop_) {
+            auto *event_stream = device->get_facility<I_EventsStream>();
+            auto *decoder      = device->get_facility<I_Decoder>();
+            if (!event_stream || !decoder || !event_stream->follow_loops(*decoder)) {
+                MV_HAL_LOG_WARNING() << "The timestamps of the stream can not be kept increasing across its loops";
+            }
+        }
+        if (stream_config.performance_profile_ != PerformanceProfile::Balanced) {
+            apply_performance_profile(*device, stream_config.performance_profile_);
+        }
         return device;
     }
 
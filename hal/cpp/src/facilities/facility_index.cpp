@@ -0,0 +1,28 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "metavision/hal/facilities/detail/facility_index.h"
+
+namespace Metavision {
+
+size_t get_facility_index(const std::type_info &registration_info) {
+    static std::mutex mutex;
+    static std::unordered_map<std::string, size_t> indices;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    return indices.emplace(registration_info.name(), indices.size()).first->second;
+}
+
+} // namespace Metavision
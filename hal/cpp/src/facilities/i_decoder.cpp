@@ -9,7 +9,14 @@
  * See the License for the specific language governing permissions and limitations under the License.                 *
  **********************************************************************************************************************/
 
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <string>
+
 #include "metavision/hal/facilities/i_decoder.h"
+#include "metavision/hal/utils/hal_exception.h"
+#include "metavision/sdk/base/utils/trace.h"
 
 namespace Metavision {
 
@@ -22,7 +29,7 @@ I_Decoder::I_Decoder(bool time_shifting_enabled, const std::shared_ptr<I_EventDe
         cd_event_forwarder_.reset(new DecodedEventForwarder<EventCD>(cd_event_decoder_.get()));
     }
     if (ext_trigger_event_decoder_) {
-        trigger_event_forwarder_.reset(new DecodedEventForwarder<EventExtTrigger, 1>(ext_trigger_event_decoder_.get()));
+        trigger_event_forwarder_.reset(new DecodedEventForwarder<EventExtTrigger>(ext_trigger_event_decoder_.get()));
     }
 }
 
@@ -31,41 +38,64 @@ bool I_Decoder::is_time_shifting_enabled() const {
 }
 
 void I_Decoder::decode(RawData *raw_data_begin, RawData *raw_data_end) {
-    RawData *cur_raw_data = raw_data_begin;
+    decode_up_to(raw_data_begin, raw_data_end, std::numeric_limits<timestamp>::max());
+}
 
-    // We first decode incomplete data from previous decode call
-    if (!incomplete_raw_data_.empty()) {
-        // Computes how many raw data from this input need to be copied to get a complete raw event and append
-        // them to the incomplete raw data..
-        const auto raw_data_to_insert_count = get_raw_event_size_bytes() - incomplete_raw_data_.size();
+long I_Decoder::decode_until(RawData *raw_data_begin, RawData *raw_data_end, timestamp ts_limit) {
+    return std::distance(raw_data_begin, decode_up_to(raw_data_begin, raw_data_end, ts_limit));
+}
 
-        // Check that the input buffer has enough data to complete the raw event
-        if (raw_data_to_insert_count > std::distance(cur_raw_data, raw_data_end)) {
-            incomplete_raw_data_.insert(incomplete_raw_data_.end(), cur_raw_data, raw_data_end);
-            return;
-        }
+I_Decoder::RawData *I_Decoder::decode_up_to(RawData *raw_data_begin, RawData *raw_data_end, timestamp ts_limit) {
+    MV_TRACE_SCOPE("I_Decoder::decode");
+    RawData *cur_raw_data = raw_data_begin;
 
-        // The necessary amount of data is present in the input, decode the now complete raw event
-        incomplete_raw_data_.insert(incomplete_raw_data_.end(), cur_raw_data, cur_raw_data + raw_data_to_insert_count);
-        decode_impl(incomplete_raw_data_.data(), incomplete_raw_data_.data() + incomplete_raw_data_.size());
-        incomplete_raw_data_.clear();
+    // The size of the raw events is queried once per call, it does not change during the decoding
+    const long raw_event_size = get_raw_event_size_bytes();
 
-        cur_raw_data += raw_data_to_insert_count;
+    // We first complete and decode the raw event carried over from the previous call, if any
+    if (incomplete_raw_data_size_ != 0) {
+        cur_raw_data = decode_incomplete_raw_data(cur_raw_data, raw_data_end, raw_event_size);
+        if (incomplete_raw_data_size_ != 0) {
+            // The input was too short to complete the raw event
+            statistics_counters_.bytes_decoded += std::distance(raw_data_begin, raw_data_end);
+            ++statistics_counters_.partial_word_carries;
+            if (statistics_enabled_.load(std::memory_order_relaxed)) {
+                publish_statistics();
+            }
+            return raw_data_end;
+        }
     }
 
     // Computes a valid end iterator from the input data so that the data size to decode is a multiple of raw event size
-    const auto raw_data_end_decodable_range =
-        cur_raw_data +
-        get_raw_event_size_bytes() * (std::distance(cur_raw_data, raw_data_end) / get_raw_event_size_bytes());
+    RawData *const raw_data_end_decodable_range =
+        cur_raw_data + raw_event_size * (std::distance(cur_raw_data, raw_data_end) / raw_event_size);
 
-    // Decode the data
-    decode_impl(cur_raw_data, raw_data_end_decodable_range);
+    // Decode the data, in one go unless the decoding has to stop at a timestamp
+    if (ts_limit == std::numeric_limits<timestamp>::max()) {
+        decode_impl(cur_raw_data, raw_data_end_decodable_range);
+        cur_raw_data = raw_data_end_decodable_range;
+    } else {
+        const long step_bytes = DecodeUntilStepEvents * raw_event_size;
+        while (cur_raw_data != raw_data_end_decodable_range) {
+            RawData *step_end =
+                cur_raw_data + std::min<long>(step_bytes, std::distance(cur_raw_data, raw_data_end_decodable_range));
+            decode_impl(cur_raw_data, step_end);
+            cur_raw_data = step_end;
+            if (get_last_timestamp() >= ts_limit) {
+                break;
+            }
+        }
+    }
 
-    if (raw_data_end_decodable_range != raw_data_end) {
+    if (cur_raw_data == raw_data_end_decodable_range && raw_data_end_decodable_range != raw_data_end) {
         // If the decodable range was not the same as the input (i.e. not a multiple of event bytes size) then we
-        // keep the remaining truncated data in memory. They are inserted in the incomplete data.
-        incomplete_raw_data_.insert(incomplete_raw_data_.end(), raw_data_end_decodable_range, raw_data_end);
+        // keep the remaining truncated data, to be completed by the next call
+        incomplete_raw_data_size_ = static_cast<uint8_t>(std::distance(raw_data_end_decodable_range, raw_data_end));
+        std::copy(raw_data_end_decodable_range, raw_data_end, incomplete_raw_data_.begin());
+        cur_raw_data = raw_data_end;
+        ++statistics_counters_.partial_word_carries;
     }
+    statistics_counters_.bytes_decoded += std::distance(raw_data_begin, cur_raw_data);
 
     // Flush the decoders and call time callbacks
     if (cd_event_forwarder_) {
@@ -74,24 +104,167 @@ void I_Decoder::decode(RawData *raw_data_begin, RawData *raw_data_end) {
     if (trigger_event_forwarder_) {
         trigger_event_forwarder_->flush();
     }
-    timestamp last_ts = get_last_timestamp();
-    for (auto it = time_cbs_map_.begin(), it_end = time_cbs_map_.end(); it != it_end; ++it) {
-        it->second(last_ts);
+    time_cbs_(get_last_timestamp());
+
+    if (statistics_enabled_.load(std::memory_order_relaxed)) {
+        publish_statistics();
     }
+
+    return cur_raw_data;
 }
 
-size_t I_Decoder::add_time_callback(const TimeCallback_t &cb) {
-    time_cbs_map_[next_cb_idx_] = cb;
-    return next_cb_idx_++;
+I_Decoder::RawData *I_Decoder::decode_incomplete_raw_data(RawData *raw_data_begin, RawData *raw_data_end,
+                                                         long raw_event_size) {
+    // Computes how many raw data from this input need to be copied to get a complete raw event, and appends at most
+    // this many to the incomplete raw data
+    const long raw_data_to_insert_count =
+        std::min<long>(raw_event_size - incomplete_raw_data_size_, std::distance(raw_data_begin, raw_data_end));
+    std::copy(raw_data_begin, raw_data_begin + raw_data_to_insert_count,
+              incomplete_raw_data_.begin() + incomplete_raw_data_size_);
+    incomplete_raw_data_size_ += static_cast<uint8_t>(raw_data_to_insert_count);
+
+    // Decode the raw event if it is now complete
+    if (incomplete_raw_data_size_ == raw_event_size) {
+        decode_impl(incomplete_raw_data_.data(), incomplete_raw_data_.data() + raw_event_size);
+        incomplete_raw_data_size_ = 0;
+    }
+    return raw_data_begin + raw_data_to_insert_count;
 }
 
-bool I_Decoder::remove_time_callback(size_t callback_id) {
-    auto it = time_cbs_map_.find(callback_id);
-    if (it != time_cbs_map_.end()) {
-        time_cbs_map_.erase(it);
-        return true;
+void I_Decoder::publish_statistics() {
+    statistics_counters_.cd_events          = cd_event_forwarder_ ? cd_event_forwarder_->get_forwarded_count() : 0;
+    statistics_counters_.ext_trigger_events =
+        trigger_event_forwarder_ ? trigger_event_forwarder_->get_forwarded_count() : 0;
+    std::lock_guard<std::mutex> lock(statistics_mutex_);
+    published_statistics_ = statistics_counters_;
+}
+
+void I_Decoder::enable_statistics(bool enable) {
+    statistics_enabled_ = enable;
+}
+
+bool I_Decoder::is_statistics_enabled() const {
+    return statistics_enabled_;
+}
+
+I_Decoder::Statistics I_Decoder::get_statistics() const {
+    std::lock_guard<std::mutex> lock(statistics_mutex_);
+    return published_statistics_;
+}
+
+void I_Decoder::set_cd_event_buffer_size(size_t size) {
+    if (size < static_cast<size_t>(DecodedEventForwarder<EventCD>::MinimalBufferSize)) {
+        throw HalException(HalErrorCode::InvalidArgument,
+                           "CD event buffer size must be at least " +
+                               std::to_string(DecodedEventForwarder<EventCD>::MinimalBufferSize) + " events.");
+    }
+    if (cd_event_forwarder_) {
+        cd_event_forwarder_->set_buffer_size(size);
+    }
+}
+
+size_t I_Decoder::get_cd_event_buffer_size() const {
+    return cd_event_forwarder_ ? cd_event_forwarder_->get_buffer_size() : 0;
+}
+
+void I_Decoder::set_event_order_preserved(bool preserved) {
+    is_event_order_preserved_ = preserved;
+    if (!cd_event_forwarder_ || !trigger_event_forwarder_) {
+        return;
+    }
+    if (!preserved) {
+        cd_event_forwarder_->set_before_add_events_callback(nullptr);
+        trigger_event_forwarder_->set_before_forward_callback(nullptr);
+        return;
+    }
+
+    // The trigger events buffered always precede the CD events buffered, so that forwarding the former first keeps
+    // the order of the stream
+    trigger_event_forwarder_->flush();
+    cd_event_forwarder_->flush();
+    cd_event_forwarder_->set_before_add_events_callback([this]() { trigger_event_forwarder_->flush(); });
+    trigger_event_forwarder_->set_before_forward_callback([this]() { cd_event_forwarder_->flush(); });
+}
+
+bool I_Decoder::is_event_order_preserved() const {
+    return is_event_order_preserved_;
+}
+
+void I_Decoder::set_cd_event_filter(const DecodingFilter &filter) {
+    cd_event_filter_.reset(new DecodingFilter(filter));
+    if (cd_event_forwarder_) {
+        cd_event_forwarder_->set_filter(is_cd_event_filter_supported_impl() ? nullptr : cd_event_filter_.get());
+    }
+}
+
+void I_Decoder::clear_cd_event_filter() {
+    if (cd_event_forwarder_) {
+        cd_event_forwarder_->set_filter(nullptr);
+    }
+    cd_event_filter_.reset();
+}
+
+const DecodingFilter *I_Decoder::get_cd_event_filter() const {
+    return cd_event_filter_.get();
+}
+
+bool I_Decoder::is_cd_event_filter_supported_impl() const {
+    return false;
+}
+
+const I_Decoder::RawData *I_Decoder::find_resync_point(const RawData *raw_data_begin,
+                                                      const RawData *raw_data_end) const {
+    return raw_data_end;
+}
+
+const I_Decoder::RawData *I_Decoder::find_time_base(const RawData *raw_data_begin, const RawData *raw_data_end,
+                                                   timestamp &time_base) const {
+    return raw_data_end;
+}
+
+timestamp I_Decoder::get_time_base_period() const {
+    return 0;
+}
+
+bool I_Decoder::reset_last_timestamp(const timestamp &t) {
+    if (!reset_last_timestamp_impl(t)) {
+        return false;
+    }
+    incomplete_raw_data_size_ = 0;
+    return true;
+}
+
+bool I_Decoder::reset_last_timestamp_impl(const timestamp &t) {
+    return false;
+}
+
+bool I_Decoder::reset_timestamp_shift(const timestamp &shift) {
+    return reset_timestamp_shift_impl(is_time_shifting_enabled() ? shift : 0);
+}
+
+bool I_Decoder::restart_stream(const RawData *raw_data_begin, const RawData *raw_data_end) {
+    timestamp time_base;
+    if (find_time_base(raw_data_begin, raw_data_end, time_base) == raw_data_end) {
+        return false;
     }
+    // The shift applies whether time shifting is enabled or not: the first time base is decoded right after the last
+    // timestamp
+    const timestamp last_timestamp = get_last_timestamp();
+    return reset_timestamp_shift_impl(time_base - (last_timestamp + 1)) && reset_last_timestamp(last_timestamp);
+}
+
+bool I_Decoder::reset_timestamp_shift_impl(const timestamp &shift) {
     return false;
 }
 
+size_t I_Decoder::add_time_callback(const TimeCallback_t &cb) {
+    const size_t idx = next_cb_idx_++;
+    time_cbs_.add(idx, cb);
+    return idx;
+}
+
+bool I_Decoder::remove_time_callback(size_t callback_id) {
+    return time_cbs_.remove(callback_id);
+}
+
 } // namespace Metavision
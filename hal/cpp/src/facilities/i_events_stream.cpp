@@ -10,34 +10,112 @@
  **********************************************************************************************************************/
 
 #include <memory>
+#include <sstream>
+#include <thread>
+#include <utility>
 
+#include "metavision/hal/facilities/i_decoder.h"
 #include "metavision/hal/facilities/i_events_stream.h"
 #include "metavision/hal/facilities/i_hw_identification.h"
+#include "metavision/hal/utils/adaptive_read_size.h"
+#include "metavision/hal/utils/file_data_transfer.h"
 #include "metavision/hal/utils/hal_error_code.h"
 #include "metavision/hal/utils/hal_exception.h"
 #include "metavision/hal/utils/hal_log.h"
+#include "metavision/sdk/base/utils/trace.h"
 
 namespace Metavision {
 
 I_EventsStream::I_EventsStream(std::unique_ptr<DataTransfer> data_transfer,
                                const std::shared_ptr<I_HW_Identification> &hw_identification) :
-    data_transfer_(std::move(data_transfer)), hw_identification_(hw_identification), stop_(true) {
+    data_transfer_(std::move(data_transfer)),
+    hw_identification_(hw_identification),
+    merge_pool_(DataTransfer::BufferPool::make_unbounded(2)),
+    stop_(true) {
     if (!hw_identification_) {
         throw(HalException(HalErrorCode::FailedInitialization, "HW identification facility is null."));
     }
-    data_transfer_->add_new_buffer_callback([this](const DataTransfer::BufferPtr &buffer) {
-        std::lock_guard<std::mutex> lock(new_buffer_safety_);
-        if (!stop_) {
-            available_buffers_.push(buffer);
-            new_buffer_cond_.notify_all();
+    data_transfer_->add_new_slice_callback([this](const DataTransfer::BufferSlice &transferred_buffer) {
+        {
+            std::lock_guard<std::mutex> lock(publish_safety_);
+            if (raw_data_publisher_) {
+                raw_data_publisher_->publish(transferred_buffer.data(), transferred_buffer.size());
+            }
+        }
+
+        // When the buffers are subsampled, all of them are recorded here and only some are given to the consumer
+        DataTransfer::BufferSlice buffer = transferred_buffer;
+        if (delivery_subsampling_ != 1) {
+            record_raw_data(buffer);
+            const bool delivered = delivery_subsampling_ != 0 && n_transferred_buffers_++ % delivery_subsampling_ == 0;
+            if (!delivered) {
+                // The decoder of the consumer must still follow the loops of a file
+                skipped_discontinuity_ = skipped_discontinuity_ || buffer.is_discontinuous();
+                return;
+            }
+            if (skipped_discontinuity_) {
+                buffer.set_discontinuous(true);
+                skipped_discontinuity_ = false;
+            }
+        }
+
+        if (ring_) {
+            while (!ring_->try_push(buffer)) {
+                if (stop_) {
+                    return;
+                }
+                std::this_thread::yield();
+            }
+            MV_TRACE_COUNTER("I_EventsStream queue depth", ring_->size());
+            // Pairs with the fence in wait_next_buffer: either the consumer sees the new buffer before parking, or we
+            // see it is parked and wake it up
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (consumer_waiting_.load(std::memory_order_relaxed) || handler_pending_.load(std::memory_order_relaxed)) {
+                NextBufferHandler handler;
+                {
+                    std::lock_guard<std::mutex> lock(new_buffer_safety_);
+                    new_buffer_cond_.notify_one();
+                    handler = take_pending_handler();
+                }
+                if (handler) {
+                    handler(1);
+                }
+            }
+            return;
+        }
+
+        NextBufferHandler handler;
+        {
+            std::lock_guard<std::mutex> lock(new_buffer_safety_);
+            if (!stop_) {
+                available_buffers_.push(buffer);
+                available_bytes_ += buffer.size();
+                MV_TRACE_COUNTER("I_EventsStream queue depth", available_buffers_.size());
+                // When coalescing, the consumer is woken up by the first buffer to wait for its deadline, then only
+                // once the buffers are due
+                if (available_buffers_.size() == 1 || is_delivery_due(buffer.arrival_time())) {
+                    new_buffer_cond_.notify_all();
+                }
+                handler = take_pending_handler();
+            }
+        }
+        if (handler) {
+            handler(1);
         }
     });
 
     data_transfer_->add_status_changed_callback([this](DataTransfer::Status status) {
         if (status == DataTransfer::Status::Stopped) {
-            std::lock_guard<std::mutex> lock(new_buffer_safety_);
-            stop_ = true;
-            new_buffer_cond_.notify_all();
+            NextBufferHandler handler;
+            {
+                std::lock_guard<std::mutex> lock(new_buffer_safety_);
+                stop_ = true;
+                new_buffer_cond_.notify_all();
+                handler = take_pending_handler();
+            }
+            if (handler) {
+                handler(-1);
+            }
         }
     });
 }
@@ -45,33 +123,214 @@ I_EventsStream::I_EventsStream(std::unique_ptr<DataTransfer> data_transfer,
 I_EventsStream::~I_EventsStream() {
     stop();
     data_transfer_.reset(nullptr);
+    stop_publish_raw_data();
 }
 
 void I_EventsStream::start() {
     std::lock_guard<std::mutex> lock(start_stop_safety_);
     {
         std::lock_guard<std::mutex> lock(new_buffer_safety_);
+        if (ring_) {
+            // Buffers left from a previous run, only ever consumed by the thread starting the stream
+            ring_->clear();
+        }
         stop_ = false;
     }
+    started_ = true;
     data_transfer_->start();
 }
 
 void I_EventsStream::stop() {
+    NextBufferHandler handler;
+    {
+        std::lock_guard<std::mutex> lock(start_stop_safety_);
+        {
+            std::lock_guard<std::mutex> lock(new_buffer_safety_);
+            if (!ring_) {
+                // In lock-free mode, the ring and the returned buffer belong to the consumer thread and are released by
+                // it
+                available_buffers_ = {};
+                available_bytes_   = 0;
+                returned_buffer_.reset();
+            }
+            stop_ = true;
+            new_buffer_cond_.notify_all();
+            handler = take_pending_handler();
+            stop_log_raw_data();
+        }
+        data_transfer_->stop();
+        started_ = false;
+    }
+    // Called without any lock held, so that the handler can use the stream
+    if (handler) {
+        handler(-1);
+    }
+}
+
+void I_EventsStream::pause() {
+    std::lock_guard<std::mutex> lock(start_stop_safety_);
+    data_transfer_->pause();
+}
+
+void I_EventsStream::resume() {
+    std::lock_guard<std::mutex> lock(start_stop_safety_);
+    data_transfer_->resume();
+}
+
+bool I_EventsStream::is_paused() const {
+    return data_transfer_->is_paused();
+}
+
+void I_EventsStream::set_lock_free_handoff(size_t capacity, uint32_t spin_count) {
+    std::lock_guard<std::mutex> lock(start_stop_safety_);
+    if (started_) {
+        throw HalException(HalErrorCode::OperationNotPermitted,
+                           "Buffer handoff mode can not be changed while the events stream is running.");
+    }
+    if (capacity && coalescing_.min_bytes) {
+        throw HalException(HalErrorCode::OperationNotPermitted,
+                           "The lock-free handoff is not available when coalescing the wakeups of the consumer.");
+    }
+    std::lock_guard<std::mutex> buffer_lock(new_buffer_safety_);
+    available_buffers_ = {};
+    available_bytes_   = 0;
+    returned_buffer_.reset();
+    ring_.reset(capacity ? new SPSCQueue<DataTransfer::BufferSlice>(capacity) : nullptr);
+    spin_count_ = spin_count;
+}
+
+void I_EventsStream::set_delivery_subsampling(uint32_t n) {
+    std::lock_guard<std::mutex> lock(start_stop_safety_);
+    if (started_) {
+        throw HalException(HalErrorCode::OperationNotPermitted,
+                           "Buffer delivery subsampling can not be changed while the events stream is running.");
+    }
+    delivery_subsampling_  = n;
+    n_transferred_buffers_ = 0;
+    skipped_discontinuity_ = false;
+}
+
+uint32_t I_EventsStream::get_delivery_subsampling() const {
+    return delivery_subsampling_;
+}
+
+void I_EventsStream::set_wakeup_coalescing(const WakeupCoalescingConfig &config) {
+    std::lock_guard<std::mutex> lock(start_stop_safety_);
+    if (started_) {
+        throw HalException(HalErrorCode::OperationNotPermitted,
+                           "Wakeup coalescing can not be changed while the events stream is running.");
+    }
+    if (ring_ && config.min_bytes) {
+        throw HalException(HalErrorCode::OperationNotPermitted,
+                           "Wakeup coalescing is not available with the lock-free handoff.");
+    }
+    std::lock_guard<std::mutex> buffer_lock(new_buffer_safety_);
+    coalescing_ = config;
+}
+
+I_EventsStream::WakeupCoalescingConfig I_EventsStream::get_wakeup_coalescing() const {
+    return coalescing_;
+}
+
+void I_EventsStream::set_elastic_buffering(const DataTransfer::ElasticBufferingConfig &config) {
+    data_transfer_->set_elastic_buffering(config);
+}
+
+DataTransfer::BufferingStatistics I_EventsStream::get_buffering_statistics() const {
+    return data_transfer_->get_buffering_statistics();
+}
+
+size_t I_EventsStream::get_backlog() {
+    // The ring is only replaced under this lock, while the stream is stopped
+    std::lock_guard<std::mutex> lock(new_buffer_safety_);
+    return ring_ ? ring_->size() : available_buffers_.size();
+}
+
+void I_EventsStream::set_raw_file_index(const std::shared_ptr<const RawFileIndex> &index) {
+    raw_file_index_ = index;
+}
+
+bool I_EventsStream::adapt_read_size(I_Decoder &decoder) {
+    auto file_data_transfer = dynamic_cast<FileDataTransfer *>(data_transfer_.get());
+    if (!file_data_transfer || !file_data_transfer->get_adaptive_read_size()) {
+        return false;
+    }
+
+    // The callback owns the policy, so that it remains valid whatever the order in which the facilities are destroyed
+    adaptive_read_size_ = file_data_transfer->get_adaptive_read_size();
+    decoder.add_time_callback(
+        [adaptive_read_size = adaptive_read_size_](timestamp t) { adaptive_read_size->add_time(t); });
+    return true;
+}
+
+bool I_EventsStream::follow_loops(I_Decoder &decoder) {
+    auto file_data_transfer = dynamic_cast<FileDataTransfer *>(data_transfer_.get());
+    if (!file_data_transfer || !file_data_transfer->is_looping()) {
+        return false;
+    }
+    loop_decoder_ = &decoder;
+    return true;
+}
+
+std::shared_ptr<const RawFileIndex> I_EventsStream::get_raw_file_index() const {
+    return raw_file_index_;
+}
+
+bool I_EventsStream::seek(timestamp t, I_Decoder &decoder) {
+    if (!raw_file_index_ || raw_file_index_->empty()) {
+        return false;
+    }
+    const timestamp shift = decoder.is_time_shifting_enabled() ? raw_file_index_->get_first_timestamp() : 0;
+    const auto &entry     = raw_file_index_->find(t + shift);
+
     std::lock_guard<std::mutex> lock(start_stop_safety_);
     {
-        std::lock_guard<std::mutex> lock(new_buffer_safety_);
-        available_buffers_ = {};
-        returned_buffer_.reset();
+        std::lock_guard<std::mutex> buffer_lock(new_buffer_safety_);
         stop_ = true;
         new_buffer_cond_.notify_all();
-        stop_log_raw_data();
     }
     data_transfer_->stop();
+
+    // Contrary to stop, the logging of the data goes on
+    const bool seeked = data_transfer_->seek(entry.offset_) && decoder.reset_timestamp_shift(shift) &&
+                        decoder.reset_last_timestamp(entry.timestamp_ - shift);
+    if (adaptive_read_size_) {
+        adaptive_read_size_->reset();
+    }
+    {
+        std::lock_guard<std::mutex> buffer_lock(new_buffer_safety_);
+        available_buffers_ = {};
+        available_bytes_   = 0;
+        returned_buffer_.reset();
+        if (ring_) {
+            ring_->clear();
+        }
+        stop_ = !started_;
+    }
+    if (started_) {
+        data_transfer_->start();
+    }
+    return seeked;
+}
+
+void I_EventsStream::set_thread_policy(const ThreadPolicy &policy) {
+    std::lock_guard<std::mutex> lock(start_stop_safety_);
+    data_transfer_->set_thread_policy(policy);
 }
 
 short I_EventsStream::poll_buffer() {
+    if (ring_) {
+        if (ring_->front()) {
+            return 1;
+        }
+        if (!stop_) {
+            return 0;
+        }
+        return ring_->front() ? 1 : -1;
+    }
+
     std::lock_guard<std::mutex> lock(new_buffer_safety_);
-    if (!available_buffers_.empty()) {
+    if (!available_buffers_.empty() && (stop_ || is_delivery_due(std::chrono::steady_clock::now()))) {
         return 1;
     }
 
@@ -79,36 +338,186 @@ short I_EventsStream::poll_buffer() {
 }
 
 short I_EventsStream::wait_next_buffer() {
+    MV_TRACE_SCOPE("I_EventsStream::wait_next_buffer");
+    if (ring_) {
+        for (uint32_t i = 0; i < spin_count_; ++i) {
+            if (ring_->front() || stop_) {
+                return ring_->front() ? 1 : -1;
+            }
+        }
+
+        std::unique_lock<std::mutex> lock(new_buffer_safety_);
+        consumer_waiting_.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        new_buffer_cond_.wait(lock, [this]() { return ring_->front() || stop_; });
+        consumer_waiting_.store(false, std::memory_order_relaxed);
+
+        return ring_->front() ? 1 : -1;
+    }
+
     std::unique_lock<std::mutex> lock(new_buffer_safety_);
-    new_buffer_cond_.wait(lock, [this]() { return !available_buffers_.empty() || stop_; });
+    while (!stop_) {
+        if (available_buffers_.empty()) {
+            new_buffer_cond_.wait(lock);
+        } else if (is_delivery_due(std::chrono::steady_clock::now())) {
+            break;
+        } else {
+            new_buffer_cond_.wait_until(lock, available_buffers_.front().arrival_time() + coalescing_.max_latency);
+        }
+    }
 
     return available_buffers_.empty() ? -1 : 1;
 }
 
+bool I_EventsStream::is_delivery_due(const std::chrono::steady_clock::time_point &now) const {
+    return coalescing_.min_bytes == 0 || available_bytes_ >= coalescing_.min_bytes ||
+           now >= available_buffers_.front().arrival_time() + coalescing_.max_latency;
+}
+
+void I_EventsStream::async_wait_next_buffer(NextBufferHandler handler) {
+    short status = 0;
+    {
+        std::lock_guard<std::mutex> lock(new_buffer_safety_);
+        if (pending_handler_) {
+            throw HalException(HalErrorCode::OperationNotPermitted,
+                               "A handler is already waiting for the next buffer of the events stream.");
+        }
+        if (ring_) {
+            // Same handshake as wait_next_buffer: either the data transfer thread sees the pending handler after
+            // pushing, or we see the buffer it pushed. Whichever takes the handler under the lock calls it.
+            pending_handler_ = std::move(handler);
+            handler_pending_.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (ring_->front() || stop_) {
+                status  = ring_->front() ? 1 : -1;
+                handler = take_pending_handler();
+            }
+        } else if (!available_buffers_.empty() || stop_) {
+            status = available_buffers_.empty() ? -1 : 1;
+        } else {
+            pending_handler_ = std::move(handler);
+            handler_pending_.store(true, std::memory_order_relaxed);
+        }
+    }
+    if (status != 0) {
+        handler(status);
+    }
+}
+
+I_EventsStream::NextBufferHandler I_EventsStream::take_pending_handler() {
+    handler_pending_.store(false, std::memory_order_relaxed);
+    NextBufferHandler handler;
+    std::swap(handler, pending_handler_);
+    return handler;
+}
+
 I_EventsStream::RawData *I_EventsStream::get_latest_raw_data(long &size) {
-    std::lock_guard<std::mutex> lock(new_buffer_safety_);
+    if (ring_) {
+        // Keep a reference to returned buffer to ensure validity until next call to this function
+        if (!ring_->try_pop(returned_buffer_)) {
+            // If no new buffer available yet
+            size = 0;
+            return nullptr;
+        }
+        size = returned_buffer_.size();
+    } else {
+        std::lock_guard<std::mutex> lock(new_buffer_safety_);
+
+        if (available_buffers_.empty()) {
+            // If no new buffer available yet
+            size = 0;
+            return nullptr;
+        }
+
+        // Keep a reference to returned buffer to ensure validity until next call to this function
+        returned_buffer_ = available_buffers_.front();
+        size             = returned_buffer_.size();
+        available_buffers_.pop();
+        available_bytes_ -= size;
 
-    if (available_buffers_.empty()) {
-        // If no new buffer available yet
-        size = 0;
-        return nullptr;
+        if (coalescing_.min_bytes && coalescing_.merge_buffers) {
+            // Take the following buffers up to the next discontinuity, which must be decoded from a reset state
+            while (!available_buffers_.empty() && !available_buffers_.front().is_discontinuous()) {
+                available_bytes_ -= available_buffers_.front().size();
+                buffers_to_merge_.push_back(std::move(available_buffers_.front()));
+                available_buffers_.pop();
+            }
+        }
     }
 
-    // Keep a reference to returned buffer to ensure validity until next call to this function
-    returned_buffer_ = available_buffers_.front();
-    size             = returned_buffer_->size();
-    available_buffers_.pop();
+    if (!buffers_to_merge_.empty()) {
+        // Copied outside of the lock, not to block the producer
+        auto merged = merge_pool_.acquire();
+        merged->clear();
+        merged->insert(merged->end(), returned_buffer_.data(), returned_buffer_.data() + returned_buffer_.size());
+        for (const auto &buffer : buffers_to_merge_) {
+            merged->insert(merged->end(), buffer.data(), buffer.data() + buffer.size());
+        }
+        buffers_to_merge_.clear();
+
+        DataTransfer::BufferSlice merged_slice(merged);
+        merged_slice.set_arrival_time(returned_buffer_.arrival_time());
+        merged_slice.set_discontinuous(returned_buffer_.is_discontinuous());
+        returned_buffer_ = std::move(merged_slice);
+        size             = returned_buffer_.size();
+    }
+
+    if (adaptive_read_size_) {
+        adaptive_read_size_->add_data(size);
+    }
+    if (loop_decoder_ && returned_buffer_.is_discontinuous()) {
+        const RawData *begin = returned_buffer_.data();
+        if (!loop_decoder_->restart_stream(begin, begin + size)) {
+            MV_HAL_LOG_WARNING() << "Failed to reset the decoder when looping over the RAW file.";
+        }
+    }
+
+    if (delivery_subsampling_ == 1) {
+        record_raw_data(returned_buffer_);
+    }
+    return returned_buffer_.data();
+}
 
+void I_EventsStream::record_raw_data(const DataTransfer::BufferSlice &buffer) {
     std::lock_guard<std::mutex> log_lock(log_raw_safety_);
     if (log_raw_data_) {
-        log_raw_data_->write(reinterpret_cast<char *>(returned_buffer_->data()), size * sizeof(RawData));
+        log_raw_data_->write(reinterpret_cast<char *>(buffer.data()), buffer.size() * sizeof(RawData));
+    } else if (async_log_raw_data_) {
+        async_log_raw_data_->write(buffer);
+    } else if (rotating_log_raw_data_) {
+        rotating_log_raw_data_->write(buffer);
+    } else if (striped_log_raw_data_) {
+        striped_log_raw_data_->write(buffer);
+    } else if (mapped_log_raw_data_) {
+        mapped_log_raw_data_->write(buffer.data(), buffer.size() * sizeof(RawData));
     }
-    return returned_buffer_->data();
+    if (flight_recorder_) {
+        flight_recorder_->add_data(buffer);
+    }
+}
+
+std::chrono::steady_clock::time_point I_EventsStream::get_latest_raw_data_arrival_time() const {
+    return returned_buffer_.arrival_time();
 }
 
 void I_EventsStream::stop_log_raw_data() {
-    std::lock_guard<std::mutex> guard(log_raw_safety_);
-    log_raw_data_.reset(nullptr);
+    std::unique_ptr<AsyncRawFileWriter> async_log_raw_data;
+    std::unique_ptr<RotatingRawFileWriter> rotating_log_raw_data;
+    std::unique_ptr<StripedRawFileWriter> striped_log_raw_data;
+    std::unique_ptr<MappedFileWriter> mapped_log_raw_data;
+    {
+        std::lock_guard<std::mutex> guard(log_raw_safety_);
+        log_raw_data_.reset(nullptr);
+        async_log_raw_data    = std::move(async_log_raw_data_);
+        rotating_log_raw_data = std::move(rotating_log_raw_data_);
+        striped_log_raw_data  = std::move(striped_log_raw_data_);
+        mapped_log_raw_data   = std::move(mapped_log_raw_data_);
+    }
+    // Flushes the pending buffers outside of the lock so that the consumer thread is not blocked meanwhile
+    async_log_raw_data.reset(nullptr);
+    rotating_log_raw_data.reset(nullptr);
+    striped_log_raw_data.reset(nullptr);
+    mapped_log_raw_data.reset(nullptr);
 }
 
 bool I_EventsStream::log_raw_data(const std::string &f) {
@@ -126,10 +535,243 @@ bool I_EventsStream::log_raw_data(const std::string &f) {
         return false;
     }
 
+    async_log_raw_data_.reset(nullptr);
+    rotating_log_raw_data_.reset(nullptr);
+    striped_log_raw_data_.reset(nullptr);
+    mapped_log_raw_data_.reset(nullptr);
     (*log_raw_data_) << header;
     return true;
 }
 
+bool I_EventsStream::log_raw_data_async(const std::string &f, const AsyncRawFileWriterConfig &config) {
+    if (f == underlying_filename_) {
+        return false;
+    }
+
+    auto header = hw_identification_->get_header();
+    header.add_date();
+    set_raw_file_compression(header, config.compression_, config.compression_chunk_size_);
+    std::ostringstream header_stream;
+    header_stream << header;
+
+    std::unique_ptr<AsyncRawFileWriter> writer;
+    try {
+        writer.reset(new AsyncRawFileWriter(f, header_stream.str(), config));
+    } catch (const HalException &) { return false; }
+
+    std::unique_ptr<AsyncRawFileWriter> previous_writer;
+    std::unique_ptr<RotatingRawFileWriter> previous_rotating_writer;
+    std::unique_ptr<StripedRawFileWriter> previous_striped_writer;
+    std::unique_ptr<MappedFileWriter> previous_mapped_writer;
+    {
+        std::lock_guard<std::mutex> guard(log_raw_safety_);
+        log_raw_data_.reset(nullptr);
+        previous_writer          = std::move(async_log_raw_data_);
+        previous_rotating_writer = std::move(rotating_log_raw_data_);
+        previous_striped_writer  = std::move(striped_log_raw_data_);
+        previous_mapped_writer   = std::move(mapped_log_raw_data_);
+        async_log_raw_data_      = std::move(writer);
+    }
+    return true;
+}
+
+bool I_EventsStream::log_raw_data_rotating(const RawFileRotationConfig &config) {
+    if (RotatingRawFileWriter::get_filename(config, 0) == underlying_filename_) {
+        return false;
+    }
+
+    // Called from the writing thread to prepare the next files, hence the shared ownership of the facility
+    auto header_builder = [hw_identification = hw_identification_, config](size_t) {
+        auto header = hw_identification->get_header();
+        header.add_date();
+        set_raw_file_compression(header, config.writer_config_.compression_,
+                                 config.writer_config_.compression_chunk_size_);
+        std::ostringstream header_stream;
+        header_stream << header;
+        return header_stream.str();
+    };
+
+    std::unique_ptr<RotatingRawFileWriter> writer;
+    try {
+        writer.reset(new RotatingRawFileWriter(header_builder, config));
+    } catch (const HalException &) { return false; }
+
+    std::unique_ptr<AsyncRawFileWriter> previous_writer;
+    std::unique_ptr<RotatingRawFileWriter> previous_rotating_writer;
+    std::unique_ptr<StripedRawFileWriter> previous_striped_writer;
+    std::unique_ptr<MappedFileWriter> previous_mapped_writer;
+    {
+        std::lock_guard<std::mutex> guard(log_raw_safety_);
+        log_raw_data_.reset(nullptr);
+        previous_writer          = std::move(async_log_raw_data_);
+        previous_rotating_writer = std::move(rotating_log_raw_data_);
+        previous_striped_writer  = std::move(striped_log_raw_data_);
+        previous_mapped_writer   = std::move(mapped_log_raw_data_);
+        rotating_log_raw_data_   = std::move(writer);
+    }
+    return true;
+}
+
+bool I_EventsStream::log_raw_data_striped(const std::string &manifest_path, const StripedRawFileWriterConfig &config) {
+    if (manifest_path == underlying_filename_) {
+        return false;
+    }
+
+    auto header = hw_identification_->get_header();
+    header.add_date();
+    std::ostringstream header_stream;
+    header_stream << header;
+
+    std::unique_ptr<StripedRawFileWriter> writer;
+    try {
+        writer.reset(new StripedRawFileWriter(manifest_path, header_stream.str(), config));
+    } catch (const HalException &) { return false; }
+
+    std::unique_ptr<AsyncRawFileWriter> previous_writer;
+    std::unique_ptr<RotatingRawFileWriter> previous_rotating_writer;
+    std::unique_ptr<StripedRawFileWriter> previous_striped_writer;
+    std::unique_ptr<MappedFileWriter> previous_mapped_writer;
+    {
+        std::lock_guard<std::mutex> guard(log_raw_safety_);
+        log_raw_data_.reset(nullptr);
+        previous_writer          = std::move(async_log_raw_data_);
+        previous_rotating_writer = std::move(rotating_log_raw_data_);
+        previous_striped_writer  = std::move(striped_log_raw_data_);
+        previous_mapped_writer   = std::move(mapped_log_raw_data_);
+        striped_log_raw_data_    = std::move(writer);
+    }
+    return true;
+}
+
+bool I_EventsStream::log_raw_data_mapped(const std::string &f, const MappedFileWriterConfig &config) {
+    if (f == underlying_filename_) {
+        return false;
+    }
+
+    auto header = hw_identification_->get_header();
+    header.add_date();
+    std::ostringstream header_stream;
+    header_stream << header;
+    const std::string header_data = header_stream.str();
+
+    std::unique_ptr<MappedFileWriter> writer;
+    try {
+        writer.reset(new MappedFileWriter(f, config));
+    } catch (const std::exception &) { return false; }
+    if (!writer->write(header_data.data(), header_data.size())) {
+        return false;
+    }
+
+    std::unique_ptr<AsyncRawFileWriter> previous_writer;
+    std::unique_ptr<RotatingRawFileWriter> previous_rotating_writer;
+    std::unique_ptr<StripedRawFileWriter> previous_striped_writer;
+    std::unique_ptr<MappedFileWriter> previous_mapped_writer;
+    {
+        std::lock_guard<std::mutex> guard(log_raw_safety_);
+        log_raw_data_.reset(nullptr);
+        previous_writer          = std::move(async_log_raw_data_);
+        previous_rotating_writer = std::move(rotating_log_raw_data_);
+        previous_striped_writer  = std::move(striped_log_raw_data_);
+        previous_mapped_writer   = std::move(mapped_log_raw_data_);
+        mapped_log_raw_data_     = std::move(writer);
+    }
+    return true;
+}
+
+uint64_t I_EventsStream::get_log_raw_data_dropped_bytes() {
+    std::lock_guard<std::mutex> guard(log_raw_safety_);
+    return mapped_log_raw_data_ ? mapped_log_raw_data_->get_n_dropped_bytes() : 0;
+}
+
+bool I_EventsStream::rotate_log_raw_data() {
+    std::lock_guard<std::mutex> guard(log_raw_safety_);
+    if (!rotating_log_raw_data_) {
+        return false;
+    }
+    rotating_log_raw_data_->request_rotation();
+    return true;
+}
+
+std::vector<std::string> I_EventsStream::get_log_raw_data_files() {
+    std::lock_guard<std::mutex> guard(log_raw_safety_);
+    return rotating_log_raw_data_ ? rotating_log_raw_data_->get_filenames() : std::vector<std::string>();
+}
+
+std::shared_ptr<RawFlightRecorder> I_EventsStream::record_flight(const RawFlightRecorderConfig &config) {
+    auto header = hw_identification_->get_header();
+    header.add_date();
+    set_raw_file_compression(header, config.writer_config_.compression_, config.writer_config_.compression_chunk_size_);
+    std::ostringstream header_stream;
+    header_stream << header;
+
+    auto recorder = std::make_shared<RawFlightRecorder>(header_stream.str(), config);
+    std::shared_ptr<RawFlightRecorder> previous_recorder;
+    {
+        std::lock_guard<std::mutex> guard(log_raw_safety_);
+        previous_recorder = std::move(flight_recorder_);
+        flight_recorder_  = recorder;
+    }
+    return recorder;
+}
+
+void I_EventsStream::stop_record_flight() {
+    std::shared_ptr<RawFlightRecorder> recorder;
+    {
+        std::lock_guard<std::mutex> guard(log_raw_safety_);
+        recorder = std::move(flight_recorder_);
+    }
+    // The dump in progress is completed outside of the lock, unless the caller still references the recorder
+}
+
+std::shared_ptr<SharedMemoryRing> I_EventsStream::publish_raw_data(const std::string &name,
+                                                                   const SharedMemoryRingConfig &config) {
+    auto header = hw_identification_->get_header();
+    header.add_date();
+    std::ostringstream header_stream;
+    header_stream << header;
+
+    // The previous ring is closed first, in case it has the same name
+    stop_publish_raw_data();
+    auto publisher = SharedMemoryRing::create(name, header_stream.str(), config);
+
+    std::lock_guard<std::mutex> guard(publish_safety_);
+    raw_data_publisher_ = publisher;
+    return publisher;
+}
+
+void I_EventsStream::stop_publish_raw_data() {
+    std::shared_ptr<SharedMemoryRing> publisher;
+    {
+        std::lock_guard<std::mutex> guard(publish_safety_);
+        publisher = std::move(raw_data_publisher_);
+    }
+    if (publisher) {
+        publisher->close();
+    }
+}
+
+size_t I_EventsStream::get_log_raw_data_queue_depth() {
+    std::lock_guard<std::mutex> guard(log_raw_safety_);
+    if (rotating_log_raw_data_) {
+        return rotating_log_raw_data_->get_queue_depth();
+    }
+    if (striped_log_raw_data_) {
+        return striped_log_raw_data_->get_queue_depth();
+    }
+    return async_log_raw_data_ ? async_log_raw_data_->get_queue_depth() : 0;
+}
+
+size_t I_EventsStream::get_log_raw_data_bytes_behind() {
+    std::lock_guard<std::mutex> guard(log_raw_safety_);
+    if (rotating_log_raw_data_) {
+        return rotating_log_raw_data_->get_bytes_behind();
+    }
+    if (striped_log_raw_data_) {
+        return striped_log_raw_data_->get_bytes_behind();
+    }
+    return async_log_raw_data_ ? async_log_raw_data_->get_bytes_behind() : 0;
+}
+
 void I_EventsStream::set_underlying_filename(const std::string &filename) {
     underlying_filename_ = filename;
 }
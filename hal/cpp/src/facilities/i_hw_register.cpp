@@ -0,0 +1,77 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include "metavision/hal/facilities/i_hw_register.h"
+
+namespace Metavision {
+
+void I_HW_Register::write_registers(const std::vector<std::pair<uint32_t, uint32_t>> &writes) {
+    for (const auto &write : writes) {
+        write_register(write.first, write.second);
+    }
+}
+
+std::vector<uint32_t> I_HW_Register::read_registers(const std::vector<uint32_t> &addresses) {
+    std::vector<uint32_t> values;
+    values.reserve(addresses.size());
+    for (const auto address : addresses) {
+        values.push_back(read_register(address));
+    }
+    return values;
+}
+
+void I_HW_Register::write_register_bitfields(const std::string &address,
+                                             const std::vector<std::pair<std::string, uint32_t>> &bitfields) {
+    for (const auto &bitfield : bitfields) {
+        write_register(address, bitfield.first, bitfield.second);
+    }
+}
+
+void I_HW_Register::write_registers_by_name(const std::vector<std::pair<std::string, uint32_t>> &writes) {
+    // The consecutive registers whose address is known are written together, the order of the writes being kept
+    std::vector<std::pair<uint32_t, uint32_t>> batch;
+    batch.reserve(writes.size());
+    for (const auto &write : writes) {
+        uint32_t address;
+        if (get_register_address(write.first, address)) {
+            batch.emplace_back(address, write.second);
+            continue;
+        }
+        if (!batch.empty()) {
+            write_registers(batch);
+            batch.clear();
+        }
+        write_register(write.first, write.second);
+    }
+    if (!batch.empty()) {
+        write_registers(batch);
+    }
+}
+
+bool I_HW_Register::get_register_address(const std::string &name, uint32_t &address) {
+    std::lock_guard<std::mutex> lock(address_cache_mutex_);
+    auto it = address_cache_.find(name);
+    if (it != address_cache_.end()) {
+        address = it->second;
+        return true;
+    }
+    if (!lookup_register_address(name, address)) {
+        return false;
+    }
+    address_cache_.emplace(name, address);
+    return true;
+}
+
+bool I_HW_Register::lookup_register_address(const std::string &, uint32_t &) {
+    return false;
+}
+
+} // namespace Metavision
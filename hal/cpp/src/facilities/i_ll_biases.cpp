@@ -0,0 +1,24 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include "metavision/hal/facilities/i_ll_biases.h"
+
+namespace Metavision {
+
+bool I_LL_Biases::set_biases(const std::map<std::string, int> &biases) {
+    bool all_set = true;
+    for (const auto &bias : biases) {
+        all_set = set(bias.first, bias.second) && all_set;
+    }
+    return all_set;
+}
+
+} // namespace Metavision
@@ -14,6 +14,7 @@
 #include <iostream>
 #include <algorithm>
 #include <iterator>
+#include <chrono>
 
 #include "metavision/hal/facilities/i_roi.h"
 #include "metavision/hal/utils/device_roi.h"
@@ -26,11 +27,13 @@ std::vector<uint32_t> I_ROI::create_ROI(const DeviceRoi &roi) {
 }
 
 void I_ROI::set_ROI(const DeviceRoi &roi, bool enable) {
-    set_ROIs_from_bitword(create_ROIs({roi}), enable);
+    programmed_vroiparams_ = create_ROIs({roi});
+    set_ROIs_from_bitword(programmed_vroiparams_, enable);
 }
 
 void I_ROI::set_ROIs(const std::vector<DeviceRoi> &vroi, bool enable) {
-    set_ROIs_from_bitword(create_ROIs(vroi), enable);
+    programmed_vroiparams_ = create_ROIs(vroi);
+    set_ROIs_from_bitword(programmed_vroiparams_, enable);
 }
 
 void I_ROI::set_ROIs_from_file(std::string const &file_path, bool enable) {
@@ -43,7 +46,48 @@ void I_ROI::set_ROIs_from_file(std::string const &file_path, bool enable) {
     std::vector<DeviceRoi> vroi;
     std::copy(std::istream_iterator<DeviceRoi>(roi_file), std::istream_iterator<DeviceRoi>(), std::back_inserter(vroi));
 
-    set_ROIs_from_bitword(create_ROIs(vroi), enable);
+    programmed_vroiparams_ = create_ROIs(vroi);
+    set_ROIs_from_bitword(programmed_vroiparams_, enable);
+}
+
+size_t I_ROI::update_ROIs(const std::vector<DeviceRoi> &vroi) {
+    using namespace std::chrono;
+    const auto start           = steady_clock::now();
+    const size_t num_words     = update_ROIs_from_bitword(create_ROIs(vroi));
+    const uint64_t duration_us = duration_cast<microseconds>(steady_clock::now() - start).count();
+
+    update_statistics_.last_duration_us = duration_us;
+    update_statistics_.max_duration_us  = std::max(update_statistics_.max_duration_us, duration_us);
+    update_statistics_.total_duration_us += duration_us;
+    return num_words;
+}
+
+size_t I_ROI::update_ROIs_from_bitword(const std::vector<uint32_t> &vroiparams) {
+    std::vector<std::pair<size_t, uint32_t>> changed_words;
+    const bool full_update = programmed_vroiparams_.size() != vroiparams.size();
+    for (size_t i = 0; i < vroiparams.size(); ++i) {
+        if (full_update || programmed_vroiparams_[i] != vroiparams[i]) {
+            changed_words.emplace_back(i, vroiparams[i]);
+        }
+    }
+
+    programmed_vroiparams_ = vroiparams;
+    set_ROIs_words(changed_words, programmed_vroiparams_);
+    ++update_statistics_.num_updates;
+    update_statistics_.num_words_written += changed_words.size();
+    return changed_words.size();
+}
+
+void I_ROI::invalidate_ROIs_update() {
+    programmed_vroiparams_.clear();
+}
+
+const I_ROI::UpdateStatistics &I_ROI::get_update_statistics() const {
+    return update_statistics_;
+}
+
+void I_ROI::set_ROIs_words(const std::vector<std::pair<size_t, uint32_t>> &, const std::vector<uint32_t> &vroiparams) {
+    set_ROIs_from_bitword(vroiparams, true);
 }
 
 } // namespace Metavision
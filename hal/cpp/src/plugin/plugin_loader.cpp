@@ -10,8 +10,13 @@
  **********************************************************************************************************************/
 
 #include <memory>
+#include <mutex>
 #include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
 #include <dirent.h>
+#include <sys/stat.h>
 #ifdef _WIN32
 #include <windows.h>
 #include <strsafe.h>
@@ -22,6 +27,8 @@
 #include "metavision/hal/plugin/detail/plugin_loader.h"
 #include "metavision/hal/plugin/plugin.h"
 #include "metavision/hal/plugin/plugin_entrypoint.h"
+#include "metavision/hal/utils/hal_exception.h"
+#include "metavision/hal/utils/hal_error_code.h"
 #include "metavision/hal/utils/hal_log.h"
 
 namespace {
@@ -99,6 +106,9 @@ std::string get_plugin_name(const std::string &filename, const std::string &ext,
 
 using PluginEntry = decltype(&initialize_plugin);
 
+// First line of the manifest, which is followed by the name of the entry point of the plugins it describes
+const std::string manifest_magic = "metavision_hal_plugin_manifest\t1";
+
 struct dlcloser {
     void operator()(void *handle) {
         if (handle) {
@@ -135,14 +145,33 @@ struct PluginLoader::PluginInfo {
 
 struct PluginLoader::Library {
     Library(const std::string &entrypoint_name, const std::string &name, const std::string &path) :
-        handle(load_library(path.c_str())) {
-        if (handle && !entrypoint_name.empty()) {
-            auto entrypoint = reinterpret_cast<PluginEntry>(load_entrypoint(handle.get(), entrypoint_name.c_str()));
-            if (entrypoint) {
-                plugin = PluginLoader::make_plugin(name);
-                entrypoint(plugin.get());
+        entrypoint_name(entrypoint_name), path(path) {
+        description.name = name;
+    }
+
+    // A plugin linked in the application, which has no library to load
+    Library(const std::string &name, StaticPluginEntry static_entry) : static_entry(static_entry) {
+        description.name = name;
+    }
+
+    // Loads the library, the first time only, and gets its plugin or nullptr if it is not a plugin
+    Plugin *get_plugin() {
+        std::call_once(load_flag, [this]() {
+            if (static_entry) {
+                plugin = PluginLoader::make_plugin(description.name);
+                static_entry(plugin.get());
+                return;
             }
-        }
+            handle.reset(load_library(path.c_str()));
+            if (handle && !entrypoint_name.empty()) {
+                auto entrypoint = reinterpret_cast<PluginEntry>(load_entrypoint(handle.get(), entrypoint_name.c_str()));
+                if (entrypoint) {
+                    plugin = PluginLoader::make_plugin(description.name);
+                    entrypoint(plugin.get());
+                }
+            }
+        });
+        return plugin.get();
     }
 
 #ifdef _WIN32
@@ -179,12 +208,26 @@ struct PluginLoader::Library {
     }
 #endif
 
+    const std::string entrypoint_name;
+    const std::string path;
+    const StaticPluginEntry static_entry = nullptr;
+    PluginDescription description;
+    std::once_flag load_flag;
+
     // order is important here, we need to delete the plugin before we delete the handle which will
     // close the shared library
     std::unique_ptr<void, dlcloser> handle;
     std::unique_ptr<Metavision::Plugin> plugin;
 };
 
+struct PluginLoader::ManifestEntry {
+    std::string path;
+    std::int64_t size;
+    std::int64_t modification_time;
+    bool is_plugin;
+    PluginDescription description;
+};
+
 PluginLoader::PluginLoader() = default;
 
 PluginLoader::~PluginLoader() = default;
@@ -205,7 +248,12 @@ void PluginLoader::insert_folders(const std::vector<std::string> &folders) {
     }
 }
 
+void PluginLoader::set_manifest_path(const std::string &path) {
+    manifest_path_ = path;
+}
+
 void PluginLoader::load_plugins() {
+    read_manifest();
     for (auto folder : folders_) {
         DIR *dir_descriptor;
         dir_descriptor = opendir(folder.c_str());
@@ -218,21 +266,139 @@ void PluginLoader::load_plugins() {
             closedir(dir_descriptor);
         }
     }
+    if (manifest_changed_) {
+        write_manifest();
+    }
 }
 
 void PluginLoader::insert_plugin(const std::string &name, const std::string &library_path) {
-    if (!name.empty() && !library_path.empty()) {
-        auto library = std::make_unique<Library>(get_plugin_entry_point(), name, library_path);
-        if (library->plugin) {
+    if (name.empty() || library_path.empty()) {
+        return;
+    }
+    for (const auto &library : libraries_) {
+        if (library->path == library_path) {
+            return;
+        }
+    }
+    struct stat library_stat;
+    if (stat(library_path.c_str(), &library_stat) != 0) {
+        return;
+    }
+
+    auto library = std::make_unique<Library>(get_plugin_entry_point(), name, library_path);
+    auto entry   = std::find_if(manifest_.begin(), manifest_.end(),
+                              [&library_path](const ManifestEntry &entry) { return entry.path == library_path; });
+    if (entry != manifest_.end() && entry->size == static_cast<std::int64_t>(library_stat.st_size) &&
+        entry->modification_time == static_cast<std::int64_t>(library_stat.st_mtime)) {
+        // The library is described by the manifest, it is loaded when the plugin is first accessed
+        if (entry->is_plugin) {
+            library->description = entry->description;
             libraries_.push_back(std::move(library));
         }
+        return;
     }
+
+    // The library is loaded to be described
+    ManifestEntry new_entry{library_path, static_cast<std::int64_t>(library_stat.st_size),
+                            static_cast<std::int64_t>(library_stat.st_mtime), false, library->description};
+    if (Plugin *plugin = library->get_plugin()) {
+        library->description.integrator_name        = plugin->get_integrator_name();
+        library->description.camera_discovery_count = plugin->get_camera_discovery_list().size();
+        library->description.file_discovery_count   = plugin->get_file_discovery_list().size();
+        new_entry.is_plugin                         = true;
+        new_entry.description                       = library->description;
+        libraries_.push_back(std::move(library));
+    }
+    if (entry != manifest_.end()) {
+        *entry = new_entry;
+    } else {
+        manifest_.push_back(new_entry);
+    }
+    manifest_changed_ = true;
+}
+
+void PluginLoader::insert_static_plugin(const std::string &name, StaticPluginEntry entry) {
+    if (name.empty() || !entry) {
+        return;
+    }
+    for (const auto &library : libraries_) {
+        if (library->static_entry && library->description.name == name) {
+            return;
+        }
+    }
+
+    // Initializing a static plugin is cheap, it is done right away to describe it
+    auto library   = std::make_unique<Library>(name, entry);
+    Plugin *plugin = library->get_plugin();
+    library->description.integrator_name        = plugin->get_integrator_name();
+    library->description.camera_discovery_count = plugin->get_camera_discovery_list().size();
+    library->description.file_discovery_count   = plugin->get_file_discovery_list().size();
+    libraries_.push_back(std::move(library));
 }
 
 void PluginLoader::insert_plugin(const PluginInfo &info) {
     insert_plugin(info.name, info.path);
 }
 
+void PluginLoader::read_manifest() {
+    manifest_.clear();
+    manifest_changed_ = false;
+    if (manifest_path_.empty()) {
+        return;
+    }
+
+    std::ifstream ifs(manifest_path_);
+    std::string line;
+    if (!std::getline(ifs, line) || line != manifest_magic || !std::getline(ifs, line) ||
+        line != get_plugin_entry_point()) {
+        // The manifest is missing, or was written by another version of HAL
+        manifest_changed_ = true;
+        return;
+    }
+    while (std::getline(ifs, line)) {
+        std::istringstream iss(line);
+        ManifestEntry entry;
+        std::string is_plugin, size, modification_time, camera_discovery_count, file_discovery_count;
+        if (!std::getline(iss, entry.path, '\t') || !std::getline(iss, size, '\t') ||
+            !std::getline(iss, modification_time, '\t') || !std::getline(iss, is_plugin, '\t') ||
+            !std::getline(iss, entry.description.name, '\t') ||
+            !std::getline(iss, entry.description.integrator_name, '\t') ||
+            !std::getline(iss, camera_discovery_count, '\t') || !std::getline(iss, file_discovery_count)) {
+            manifest_changed_ = true;
+            continue;
+        }
+        try {
+            entry.size                               = std::stoll(size);
+            entry.modification_time                  = std::stoll(modification_time);
+            entry.is_plugin                          = is_plugin == "1";
+            entry.description.camera_discovery_count = std::stoul(camera_discovery_count);
+            entry.description.file_discovery_count   = std::stoul(file_discovery_count);
+        } catch (const std::exception &) {
+            manifest_changed_ = true;
+            continue;
+        }
+        manifest_.push_back(entry);
+    }
+}
+
+void PluginLoader::write_manifest() const {
+    if (manifest_path_.empty()) {
+        return;
+    }
+
+    std::ofstream ofs(manifest_path_);
+    ofs << manifest_magic << "\n" << get_plugin_entry_point() << "\n";
+    for (const auto &entry : manifest_) {
+        ofs << entry.path << "\t" << entry.size << "\t" << entry.modification_time << "\t"
+            << (entry.is_plugin ? "1" : "0") << "\t" << entry.description.name << "\t"
+            << entry.description.integrator_name << "\t" << entry.description.camera_discovery_count << "\t"
+            << entry.description.file_discovery_count << "\n";
+    }
+    if (!ofs) {
+        MV_HAL_LOG_TRACE() << "Unable to write the manifest of the plugins in" << manifest_path_;
+    }
+}
+
 std::unique_ptr<Plugin> PluginLoader::make_plugin(const std::string &plugin_name) {
     return std::unique_ptr<Plugin>(new Plugin(plugin_name));
 }
@@ -249,11 +415,17 @@ PluginLoader::PluginList::iterator &PluginLoader::PluginList::iterator::operator
 }
 
 PluginLoader::PluginList::iterator::reference PluginLoader::PluginList::iterator::operator*() const {
-    return *(*it_)->plugin;
+    return *operator->();
 }
 
 PluginLoader::PluginList::iterator::pointer PluginLoader::PluginList::iterator::operator->() const {
-    return (*it_)->plugin.get();
+    Plugin *plugin = (*it_)->get_plugin();
+    if (!plugin) {
+        // The library has been replaced by one that is not a plugin since the manifest was read
+        throw HalException(HalErrorCode::InternalInitializationError,
+                           "Failed to load plugin " + (*it_)->description.name + " from " + (*it_)->path);
+    }
+    return plugin;
 }
 
 PluginLoader::PluginList::iterator PluginLoader::PluginList::begin() {
@@ -264,7 +436,7 @@ PluginLoader::PluginList::iterator PluginLoader::PluginList::end() {
     return iterator(libraries_.end());
 }
 
-PluginLoader::PluginList::PluginList(container &libraries) : libraries_(libraries) {}
+PluginLoader::PluginList::PluginList(container &&libraries) : libraries_(std::move(libraries)) {}
 
 bool PluginLoader::PluginList::empty() const {
     return libraries_.empty();
@@ -275,7 +447,25 @@ size_t PluginLoader::PluginList::size() const {
 }
 
 PluginLoader::PluginList PluginLoader::get_plugin_list() {
-    return PluginList(libraries_);
+    return get_plugin_list([](const PluginDescription &) { return true; });
+}
+
+PluginLoader::PluginList PluginLoader::get_plugin_list(const PluginFilter &filter) {
+    std::vector<Library *> libraries;
+    for (const auto &library : libraries_) {
+        if (filter(library->description)) {
+            libraries.push_back(library.get());
+        }
+    }
+    return PluginList(std::move(libraries));
+}
+
+std::vector<PluginLoader::PluginDescription> PluginLoader::get_plugin_descriptions() const {
+    std::vector<PluginDescription> descriptions;
+    for (const auto &library : libraries_) {
+        descriptions.push_back(library->description);
+    }
+    return descriptions;
 }
 
 } // namespace Metavision
@@ -0,0 +1,63 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
+#include "metavision/hal/plugin/static_plugin.h"
+
+namespace Metavision {
+
+namespace {
+
+// The plugins may be registered during the static initialization, hence the registry built on first use
+struct StaticPluginRegistry {
+    std::mutex mutex;
+    std::vector<std::pair<std::string, StaticPluginEntry>> plugins;
+};
+
+StaticPluginRegistry &get_registry() {
+    static StaticPluginRegistry registry;
+    return registry;
+}
+
+std::atomic<bool> dynamic_plugin_loading{true};
+
+} // namespace
+
+void register_static_plugin(const std::string &name, StaticPluginEntry entry) {
+    auto &registry = get_registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    auto it = std::find_if(registry.plugins.begin(), registry.plugins.end(),
+                           [&name](const std::pair<std::string, StaticPluginEntry> &plugin) {
+                               return plugin.first == name;
+                           });
+    if (it == registry.plugins.end()) {
+        registry.plugins.emplace_back(name, entry);
+    }
+}
+
+std::vector<std::pair<std::string, StaticPluginEntry>> get_static_plugins() {
+    auto &registry = get_registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    return registry.plugins;
+}
+
+void set_dynamic_plugin_loading(bool enabled) {
+    dynamic_plugin_loading = enabled;
+}
+
+bool is_dynamic_plugin_loading_enabled() {
+    return dynamic_plugin_loading;
+}
+
+} // namespace Metavision
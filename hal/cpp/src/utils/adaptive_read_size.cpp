@@ -0,0 +1,75 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+
+#include "metavision/hal/utils/adaptive_read_size.h"
+#include "metavision/hal/utils/hal_exception.h"
+
+namespace Metavision {
+
+AdaptiveReadSize::AdaptiveReadSize(uint32_t target_duration_us, uint32_t raw_event_size_bytes,
+                                   uint32_t min_read_size_bytes, uint32_t max_read_size_bytes) :
+    target_duration_us_(target_duration_us),
+    raw_event_size_bytes_(std::max(1u, raw_event_size_bytes)),
+    min_read_size_bytes_(std::max(min_read_size_bytes, std::max(1u, raw_event_size_bytes))),
+    max_read_size_bytes_(std::max(max_read_size_bytes, std::max(min_read_size_bytes, raw_event_size_bytes))),
+    read_size_bytes_(min_read_size_bytes_) {
+    if (target_duration_us == 0) {
+        throw HalException(HalErrorCode::InvalidArgument, "The duration of data to read must be greater than 0.");
+    }
+}
+
+void AdaptiveReadSize::add_data(uint64_t n_bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_bytes_ += n_bytes;
+}
+
+void AdaptiveReadSize::add_time(timestamp t) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (last_time_ < 0 || t < last_time_) {
+        last_time_     = t;
+        pending_bytes_ = 0;
+        return;
+    }
+    if (t == last_time_) {
+        // The data decoded so far spans no time, it is accounted for with the next timestamp
+        return;
+    }
+
+    // The estimate follows the changes of rate within a few reads, even when the rate varies by orders of magnitude
+    // between quiet and busy scenes
+    const double rate = static_cast<double>(pending_bytes_) / static_cast<double>(t - last_time_);
+    bytes_per_us_     = bytes_per_us_ < 0 ? rate : 0.5 * (bytes_per_us_ + rate);
+    last_time_        = t;
+    pending_bytes_    = 0;
+
+    const double size = std::min<double>(std::max<double>(bytes_per_us_ * target_duration_us_, min_read_size_bytes_),
+                                         max_read_size_bytes_);
+    const uint32_t n_events = std::max(1u, static_cast<uint32_t>(size) / raw_event_size_bytes_);
+    read_size_bytes_.store(n_events * raw_event_size_bytes_, std::memory_order_relaxed);
+}
+
+void AdaptiveReadSize::reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_bytes_ = 0;
+    last_time_     = -1;
+}
+
+uint32_t AdaptiveReadSize::get_read_size() const {
+    return read_size_bytes_.load(std::memory_order_relaxed);
+}
+
+uint32_t AdaptiveReadSize::get_target_duration_us() const {
+    return target_duration_us_;
+}
+
+} // namespace Metavision
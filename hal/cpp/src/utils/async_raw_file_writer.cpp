@@ -0,0 +1,272 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <fcntl.h>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "metavision/hal/utils/async_raw_file_writer.h"
+#include "metavision/hal/utils/hal_error_code.h"
+#include "metavision/hal/utils/hal_exception.h"
+#include "metavision/hal/utils/hal_log.h"
+
+namespace Metavision {
+
+namespace {
+#ifdef _WIN32
+int open_file(const std::string &filename, int flags) {
+    return _open(filename.c_str(), flags | _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE);
+}
+long write_file(int fd, const uint8_t *data, size_t size) {
+    return _write(fd, data, static_cast<unsigned int>(size));
+}
+void close_fd(int fd) {
+    _close(fd);
+}
+#else
+int open_file(const std::string &filename, int flags) {
+    return open(filename.c_str(), flags | O_WRONLY | O_CREAT | O_TRUNC, 0644);
+}
+long write_file(int fd, const uint8_t *data, size_t size) {
+    return ::write(fd, data, size);
+}
+void close_fd(int fd) {
+    close(fd);
+}
+#endif
+} // namespace
+
+constexpr size_t AsyncRawFileWriter::Alignment;
+
+AsyncRawFileWriter::AsyncRawFileWriter(const std::string &filename, const std::string &header,
+                                       const AsyncRawFileWriterConfig &config) :
+    config_(config), filename_(filename) {
+    config_.batch_size_ = std::max<size_t>(1, (config_.batch_size_ + Alignment - 1) / Alignment) * Alignment;
+
+    if (config_.use_direct_io_) {
+#ifdef O_DIRECT
+        fd_        = open_file(filename, O_DIRECT);
+        direct_io_ = fd_ >= 0;
+#endif
+        if (!direct_io_) {
+            MV_HAL_LOG_WARNING() << "Direct I/O is not available for" << filename << ", using buffered writes.";
+        }
+    }
+    if (fd_ < 0) {
+        fd_ = open_file(filename, 0);
+    }
+    if (fd_ < 0) {
+        throw HalException(HalErrorCode::FailedInitialization, "Could not open file " + filename + " for writing.");
+    }
+
+    staging_storage_.resize(config_.batch_size_ + Alignment);
+    void *ptr   = staging_storage_.data();
+    size_t size = staging_storage_.size();
+    staging_    = static_cast<uint8_t *>(std::align(Alignment, config_.batch_size_, ptr, size));
+
+    if (config_.checksum_chunk_size_ > 0) {
+        checksums_.reset(new RawFileChecksums(config_.checksum_chunk_size_));
+    }
+    append(reinterpret_cast<const uint8_t *>(header.data()), header.size());
+    if (config_.compression_ != RawCompression::None) {
+        config_.compression_chunk_size_ = std::max<size_t>(1, config_.compression_chunk_size_);
+        chunk_.reserve(config_.compression_chunk_size_);
+    }
+    writer_thread_ = std::thread([this]() {
+        if (!apply_thread_policy(config_.thread_policy_, "mv_raw_writer")) {
+            MV_HAL_LOG_WARNING() << "Failed to apply the threading policy of the RAW file writing thread";
+        }
+        run();
+    });
+}
+
+AsyncRawFileWriter::~AsyncRawFileWriter() {
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        closing_ = true;
+    }
+    queue_cond_.notify_one();
+    writer_thread_.join();
+    write_chunk();
+    close_file();
+    if (checksums_ && !failed_ && !checksums_->save(RawFileChecksums::get_sidecar_path(filename_))) {
+        MV_HAL_LOG_WARNING() << "Unable to save the checksums of" << filename_;
+    }
+}
+
+void AsyncRawFileWriter::write(const DataTransfer::BufferSlice &slice) {
+    if (slice.empty()) {
+        return;
+    }
+
+    bool writer_idle;
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        // The writer thread only needs to be woken up if it went through the whole queue
+        writer_idle = queue_.empty();
+        queue_.push_back(slice);
+    }
+    pending_slices_ += 1;
+    pending_bytes_ += slice.size();
+
+    if (writer_idle) {
+        queue_cond_.notify_one();
+    }
+}
+
+size_t AsyncRawFileWriter::get_queue_depth() const {
+    return pending_slices_;
+}
+
+size_t AsyncRawFileWriter::get_bytes_behind() const {
+    return pending_bytes_;
+}
+
+uint64_t AsyncRawFileWriter::get_bytes_written() const {
+    return bytes_written_;
+}
+
+bool AsyncRawFileWriter::has_failed() const {
+    return failed_;
+}
+
+void AsyncRawFileWriter::run() {
+    using Clock = std::chrono::steady_clock;
+    std::deque<DataTransfer::BufferSlice> batch;
+    const auto flush_period = std::chrono::milliseconds(config_.flush_period_ms_);
+    auto last_flush         = Clock::now();
+
+    while (true) {
+        bool closing;
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex_);
+            queue_cond_.wait_until(lock, last_flush + flush_period, [this]() { return closing_ || !queue_.empty(); });
+            batch.swap(queue_);
+            closing = closing_;
+        }
+
+        // Buffers are copied into the staging buffer right away, so that they are given back to their pool as soon as
+        // possible. The file is only written once a whole batch is available, or when the flush period elapsed
+        for (auto &slice : batch) {
+            const size_t size = slice.size();
+            if (config_.compression_ != RawCompression::None) {
+                append_to_chunk(slice.data(), size);
+            } else {
+                append(slice.data(), size);
+            }
+            slice.reset();
+            pending_bytes_ -= size;
+            pending_slices_ -= 1;
+        }
+        batch.clear();
+
+        if (closing) {
+            break;
+        }
+        const auto now = Clock::now();
+        if (now >= last_flush + flush_period) {
+            flush_staging();
+            last_flush = now;
+        }
+    }
+}
+
+void AsyncRawFileWriter::append(const uint8_t *data, size_t size) {
+    while (size > 0) {
+        const size_t n = std::min(size, config_.batch_size_ - staging_bytes_);
+        std::memcpy(staging_ + staging_bytes_, data, n);
+        staging_bytes_ += n;
+        data += n;
+        size -= n;
+        if (staging_bytes_ == config_.batch_size_) {
+            write_staging(staging_bytes_);
+            staging_bytes_ = 0;
+        }
+    }
+}
+
+void AsyncRawFileWriter::append_to_chunk(const uint8_t *data, size_t size) {
+    while (size > 0) {
+        const size_t n = std::min(size, config_.compression_chunk_size_ - chunk_.size());
+        chunk_.insert(chunk_.end(), data, data + n);
+        data += n;
+        size -= n;
+        if (chunk_.size() == config_.compression_chunk_size_) {
+            write_chunk();
+        }
+    }
+}
+
+void AsyncRawFileWriter::write_chunk() {
+    if (chunk_.empty()) {
+        return;
+    }
+    compress_raw_chunk(chunk_.data(), chunk_.size(), config_.compression_, compressed_chunk_);
+    append(compressed_chunk_.data(), compressed_chunk_.size());
+    chunk_.clear();
+}
+
+void AsyncRawFileWriter::flush_staging() {
+    // With direct I/O, only whole blocks can be written: the remainder is kept for the next write
+    const size_t size = direct_io_ ? staging_bytes_ / Alignment * Alignment : staging_bytes_;
+    if (size == 0) {
+        return;
+    }
+    write_staging(size);
+    std::memmove(staging_, staging_ + size, staging_bytes_ - size);
+    staging_bytes_ -= size;
+}
+
+void AsyncRawFileWriter::write_staging(size_t size) {
+    if (failed_) {
+        return;
+    }
+
+    const uint8_t *data = staging_;
+    while (size > 0) {
+        const long n = write_file(fd_, data, size);
+        if (n <= 0) {
+            MV_HAL_LOG_ERROR() << "Failed to write RAW data, recording is stopped.";
+            failed_ = true;
+            return;
+        }
+        bytes_written_ += n;
+        if (checksums_) {
+            checksums_->add_data(data, n);
+        }
+        data += n;
+        size -= n;
+    }
+}
+
+void AsyncRawFileWriter::close_file() {
+    if (staging_bytes_ > 0) {
+#ifdef O_DIRECT
+        if (direct_io_) {
+            // The last write is not a multiple of the alignment, which direct I/O does not support
+            fcntl(fd_, F_SETFL, fcntl(fd_, F_GETFL) & ~O_DIRECT);
+        }
+#endif
+        write_staging(staging_bytes_);
+        staging_bytes_ = 0;
+    }
+    close_fd(fd_);
+    fd_ = -1;
+}
+
+} // namespace Metavision
@@ -0,0 +1,230 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <cstring>
+
+#include "metavision/hal/utils/compressed_raw_file.h"
+#include "metavision/hal/utils/raw_file_header.h"
+
+namespace Metavision {
+
+namespace {
+
+static const std::string compression_key = "compression";
+static const std::string chunk_size_key  = "compression_chunk_size";
+
+// Constants of the LZ4 block format
+constexpr int MinMatch          = 4;
+constexpr size_t LastLiterals   = 5;  // the last bytes of a block are always literals
+constexpr size_t MatchFindLimit = 12; // no match starts in the last bytes of a block
+constexpr size_t MaxOffset      = 65535;
+constexpr int HashLog           = 14;
+
+uint32_t read32(const uint8_t *p) {
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+uint32_t hash(uint32_t sequence) {
+    return (sequence * 2654435761u) >> (32 - HashLog);
+}
+
+uint8_t *write_length(uint8_t *op, size_t length) {
+    for (; length >= 255; length -= 255) {
+        *op++ = 255;
+    }
+    *op++ = static_cast<uint8_t>(length);
+    return op;
+}
+
+// Compresses the data in the LZ4 block format, greedily taking the last match found at the hash of each position.
+// The output must hold at least lz4_compress_bound(size) bytes
+size_t lz4_compress(const uint8_t *src, size_t size, uint8_t *dst) {
+    const uint8_t *const end = src + size;
+    const uint8_t *anchor    = src;
+    const uint8_t *ip        = src;
+    uint8_t *op              = dst;
+
+    auto emit_sequence = [&](const uint8_t *match_begin, size_t offset, size_t match_length) {
+        const size_t literals = match_begin - anchor;
+        uint8_t *token        = op++;
+        *token                = static_cast<uint8_t>(literals >= 15 ? 15 << 4 : literals << 4);
+        if (literals >= 15) {
+            op = write_length(op, literals - 15);
+        }
+        std::memcpy(op, anchor, literals);
+        op += literals;
+        *op++                = static_cast<uint8_t>(offset & 0xFF);
+        *op++                = static_cast<uint8_t>(offset >> 8);
+        const size_t ml_code = match_length - MinMatch;
+        *token |= static_cast<uint8_t>(ml_code >= 15 ? 15 : ml_code);
+        if (ml_code >= 15) {
+            op = write_length(op, ml_code - 15);
+        }
+    };
+
+    if (size > MatchFindLimit) {
+        std::vector<uint32_t> table(1 << HashLog, 0);
+        const uint8_t *const match_find_end   = end - MatchFindLimit;
+        const uint8_t *const match_length_end = end - LastLiterals;
+        ++ip;
+        while (ip < match_find_end) {
+            const uint32_t sequence = read32(ip);
+            uint32_t &entry         = table[hash(sequence)];
+            const uint8_t *ref      = src + entry;
+            entry                   = static_cast<uint32_t>(ip - src);
+            if (ref >= ip || static_cast<size_t>(ip - ref) > MaxOffset || read32(ref) != sequence) {
+                ++ip;
+                continue;
+            }
+
+            size_t length = MinMatch;
+            while (ip + length < match_length_end && ip[length] == ref[length]) {
+                ++length;
+            }
+            while (ip > anchor && ref > src && ip[-1] == ref[-1]) {
+                --ip;
+                --ref;
+                ++length;
+            }
+            emit_sequence(ip, ip - ref, length);
+            ip += length;
+            anchor = ip;
+        }
+    }
+
+    // Last literals
+    const size_t literals = end - anchor;
+    *op++                 = static_cast<uint8_t>(literals >= 15 ? 15 << 4 : literals << 4);
+    if (literals >= 15) {
+        op = write_length(op, literals - 15);
+    }
+    std::memcpy(op, anchor, literals);
+    op += literals;
+    return op - dst;
+}
+
+size_t lz4_compress_bound(size_t size) {
+    return size + size / 255 + 16;
+}
+
+bool read_length(const uint8_t *&ip, const uint8_t *end, size_t &length) {
+    uint8_t b;
+    do {
+        if (ip == end) {
+            return false;
+        }
+        b = *ip++;
+        length += b;
+    } while (b == 255);
+    return true;
+}
+
+bool lz4_decompress(const uint8_t *src, size_t size, uint8_t *dst, size_t raw_size) {
+    const uint8_t *ip        = src;
+    const uint8_t *const end = src + size;
+    uint8_t *op              = dst;
+    uint8_t *const out_end   = dst + raw_size;
+
+    while (ip < end) {
+        const uint8_t token = *ip++;
+        size_t literals     = token >> 4;
+        if (literals == 15 && !read_length(ip, end, literals)) {
+            return false;
+        }
+        if (literals > static_cast<size_t>(end - ip) || literals > static_cast<size_t>(out_end - op)) {
+            return false;
+        }
+        std::memcpy(op, ip, literals);
+        op += literals;
+        ip += literals;
+        if (ip == end) {
+            // The last sequence has no match
+            break;
+        }
+
+        if (end - ip < 2) {
+            return false;
+        }
+        const size_t offset = ip[0] | (ip[1] << 8);
+        ip += 2;
+        size_t length = token & 15;
+        if (length == 15 && !read_length(ip, end, length)) {
+            return false;
+        }
+        length += MinMatch;
+        if (offset == 0 || offset > static_cast<size_t>(op - dst) || length > static_cast<size_t>(out_end - op)) {
+            return false;
+        }
+
+        const uint8_t *match = op - offset;
+        if (offset >= length) {
+            std::memcpy(op, match, length);
+            op += length;
+        } else {
+            // Overlapping copy repeating the last offset bytes
+            for (size_t i = 0; i < length; ++i) {
+                *op++ = *match++;
+            }
+        }
+    }
+    return op == out_end;
+}
+
+} // namespace
+
+void set_raw_file_compression(RawFileHeader &header, RawCompression compression, size_t chunk_size) {
+    if (compression == RawCompression::None) {
+        header.remove_field(compression_key);
+        header.remove_field(chunk_size_key);
+        return;
+    }
+    header.set_field(compression_key, "lz4");
+    header.set_field(chunk_size_key, std::to_string(chunk_size));
+}
+
+RawCompression get_raw_file_compression(const RawFileHeader &header) {
+    return header.get_field(compression_key) == "lz4" ? RawCompression::LZ4 : RawCompression::None;
+}
+
+void compress_raw_chunk(const uint8_t *data, size_t size, RawCompression compression, std::vector<uint8_t> &output) {
+    CompressedRawChunkHeader header;
+    header.raw_size_ = static_cast<uint32_t>(size);
+    output.resize(sizeof(header) + lz4_compress_bound(size));
+
+    size_t compressed_size = size;
+    if (compression == RawCompression::LZ4) {
+        compressed_size = lz4_compress(data, size, output.data() + sizeof(header));
+    }
+    // Data that does not compress is stored as is, which is also faster to read back
+    if (compressed_size >= size) {
+        compressed_size = size;
+        std::memcpy(output.data() + sizeof(header), data, size);
+    }
+    header.compressed_size_ = static_cast<uint32_t>(compressed_size);
+    std::memcpy(output.data(), &header, sizeof(header));
+    output.resize(sizeof(header) + compressed_size);
+}
+
+bool decompress_raw_chunk(const CompressedRawChunkHeader &header, const uint8_t *data, RawCompression compression,
+                          uint8_t *output) {
+    if (header.compressed_size_ == header.raw_size_) {
+        std::memcpy(output, data, header.raw_size_);
+        return true;
+    }
+    if (compression != RawCompression::LZ4) {
+        return false;
+    }
+    return lz4_decompress(data, header.compressed_size_, output, header.raw_size_);
+}
+
+} // namespace Metavision
@@ -0,0 +1,250 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <deque>
+#include <fstream>
+#include <future>
+#include <mutex>
+#include <streambuf>
+#include <thread>
+#include <vector>
+
+#include "metavision/hal/utils/compressed_raw_file_stream.h"
+#include "metavision/hal/utils/hal_error_code.h"
+#include "metavision/hal/utils/hal_exception.h"
+#include "metavision/hal/utils/hal_log.h"
+#include "metavision/hal/utils/raw_file_header.h"
+
+namespace Metavision {
+
+// Stream buffer whose content is the header of the file followed by its chunks once decompressed. The header is
+// handled as a segment of the stream preceding the chunks, that is stored uncompressed.
+class CompressedRawFileStream::ChunkBuffer : public std::streambuf {
+public:
+    ChunkBuffer(const std::string &filename, uint32_t n_threads) :
+        file_(filename, std::ios::in | std::ios::binary),
+        n_threads_(n_threads != 0 ? n_threads : std::max(1u, std::thread::hardware_concurrency())) {
+        if (!file_) {
+            throw HalException(HalErrorCode::FailedInitialization, "Unable to open RAW file '" + filename + "'");
+        }
+
+        RawFileHeader header(file_);
+        compression_ = get_raw_file_compression(header);
+        if (compression_ == RawCompression::None) {
+            throw HalException(HalErrorCode::FailedInitialization,
+                               "RAW file '" + filename + "' is not compressed");
+        }
+
+        // Copies the header as is, then locates the chunks from their headers only
+        const auto data_pos = file_.tellg();
+        file_.seekg(0, std::ios::end);
+        const uint64_t file_size = static_cast<uint64_t>(file_.tellg());
+        header_.resize(static_cast<size_t>(data_pos));
+        file_.seekg(0);
+        file_.read(header_.data(), header_.size());
+
+        uint64_t offset     = header_.size();
+        uint64_t raw_offset = header_.size();
+        CompressedRawChunkHeader chunk_header;
+        while (file_.read(reinterpret_cast<char *>(&chunk_header), sizeof(chunk_header))) {
+            offset += sizeof(chunk_header);
+            if (offset + chunk_header.compressed_size_ > file_size) {
+                // The recording has been interrupted while writing this chunk
+                MV_HAL_LOG_WARNING() << "Compressed RAW file" << filename << "is truncated, its last chunk is ignored";
+                break;
+            }
+            chunks_.push_back({chunk_header, offset, raw_offset});
+            offset += chunk_header.compressed_size_;
+            raw_offset += chunk_header.raw_size_;
+            file_.seekg(offset);
+        }
+        size_ = raw_offset;
+        file_.clear();
+
+        load_segment(0);
+    }
+
+    ~ChunkBuffer() {
+        // Waits for the decompressions in progress, which use the file
+        pending_.clear();
+    }
+
+    size_t get_n_chunks() const {
+        return chunks_.size();
+    }
+
+    uint64_t get_size() const {
+        return size_;
+    }
+
+protected:
+    int_type underflow() override {
+        if (gptr() < egptr()) {
+            return traits_type::to_int_type(*gptr());
+        }
+        // Skips empty chunks, if any
+        while (segment_ < chunks_.size()) {
+            if (!load_segment(segment_ + 1)) {
+                return traits_type::eof();
+            }
+            if (gptr() < egptr()) {
+                return traits_type::to_int_type(*gptr());
+            }
+        }
+        return traits_type::eof();
+    }
+
+    pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override {
+        if (!(which & std::ios_base::in)) {
+            return pos_type(off_type(-1));
+        }
+
+        const off_type current = static_cast<off_type>(segment_begin_ + (gptr() - eback()));
+        if (dir == std::ios_base::cur && off == 0) {
+            return pos_type(current);
+        }
+        off_type target = off;
+        if (dir == std::ios_base::cur) {
+            target += current;
+        } else if (dir == std::ios_base::end) {
+            target += static_cast<off_type>(size_);
+        }
+        return seekpos(pos_type(target), which);
+    }
+
+    pos_type seekpos(pos_type pos, std::ios_base::openmode which) override {
+        const off_type target = off_type(pos);
+        if (!(which & std::ios_base::in) || target < 0 || static_cast<uint64_t>(target) > size_) {
+            return pos_type(off_type(-1));
+        }
+
+        // Segment containing the target, the last one if it is the end of the stream
+        size_t segment = 0;
+        if (static_cast<uint64_t>(target) >= header_.size() && !chunks_.empty()) {
+            auto it = std::upper_bound(chunks_.begin(), chunks_.end(), static_cast<uint64_t>(target),
+                                       [](uint64_t t, const Chunk &chunk) { return t < chunk.raw_offset_; });
+            segment = std::distance(chunks_.begin(), it);
+        }
+        if (segment != segment_ && !load_segment(segment)) {
+            return pos_type(off_type(-1));
+        }
+        setg(eback(), eback() + (target - static_cast<off_type>(segment_begin_)), egptr());
+        return pos;
+    }
+
+private:
+    struct Chunk {
+        CompressedRawChunkHeader header_;
+        // Offset of the compressed data in the file
+        uint64_t offset_;
+        // Offset of the decompressed data in the stream
+        uint64_t raw_offset_;
+    };
+
+    // Makes the get area point to a segment: 0 is the header, i > 0 is the chunk i - 1
+    bool load_segment(size_t segment) {
+        if (segment == 0) {
+            pending_.clear();
+            segment_       = 0;
+            segment_begin_ = 0;
+            setg(header_.data(), header_.data(), header_.data() + header_.size());
+            return true;
+        }
+
+        const size_t chunk_index = segment - 1;
+        // The decompressions launched ahead are only of use when reading forward
+        if (!pending_.empty() && pending_.front().first != chunk_index) {
+            pending_.clear();
+        }
+        if (pending_.empty()) {
+            launch(chunk_index);
+        }
+        // Keeps the threads busy with the next chunks while this one is read
+        for (size_t next = pending_.back().first + 1; next < chunks_.size() && pending_.size() <= n_threads_;
+             ++next) {
+            launch(next);
+        }
+
+        data_ = pending_.front().second.get();
+        pending_.pop_front();
+        if (data_.size() != chunks_[chunk_index].header_.raw_size_) {
+            MV_HAL_LOG_ERROR() << "Corrupted chunk in compressed RAW file, at offset" << chunks_[chunk_index].offset_;
+            setg(nullptr, nullptr, nullptr);
+            return false;
+        }
+        segment_       = segment;
+        segment_begin_ = chunks_[chunk_index].raw_offset_;
+        setg(data_.data(), data_.data(), data_.data() + data_.size());
+        return true;
+    }
+
+    void launch(size_t chunk_index) {
+        pending_.emplace_back(chunk_index, std::async(std::launch::async, [this, chunk_index]() {
+                                  const Chunk &chunk = chunks_[chunk_index];
+                                  std::vector<char> compressed(chunk.header_.compressed_size_);
+                                  {
+                                      std::lock_guard<std::mutex> lock(file_mutex_);
+                                      file_.clear();
+                                      file_.seekg(chunk.offset_);
+                                      file_.read(compressed.data(), compressed.size());
+                                      if (file_.gcount() != static_cast<std::streamsize>(compressed.size())) {
+                                          return std::vector<char>();
+                                      }
+                                  }
+                                  std::vector<char> data(chunk.header_.raw_size_);
+                                  if (!decompress_raw_chunk(chunk.header_,
+                                                            reinterpret_cast<const uint8_t *>(compressed.data()),
+                                                            compression_, reinterpret_cast<uint8_t *>(data.data()))) {
+                                      return std::vector<char>();
+                                  }
+                                  return data;
+                              }));
+    }
+
+    std::ifstream file_;
+    std::mutex file_mutex_;
+    const uint32_t n_threads_;
+    RawCompression compression_;
+    std::vector<char> header_;
+    std::vector<Chunk> chunks_;
+    uint64_t size_ = 0;
+
+    // Segment currently in the get area
+    size_t segment_         = 0;
+    uint64_t segment_begin_ = 0;
+    std::vector<char> data_;
+    std::deque<std::pair<size_t, std::future<std::vector<char>>>> pending_;
+};
+
+CompressedRawFileStream::CompressedRawFileStream(const std::string &filename, uint32_t n_threads) :
+    std::istream(nullptr), buffer_(new ChunkBuffer(filename, n_threads)) {
+    rdbuf(buffer_.get());
+}
+
+CompressedRawFileStream::~CompressedRawFileStream() {
+    rdbuf(nullptr);
+}
+
+bool CompressedRawFileStream::is_compressed(const std::string &filename) {
+    std::ifstream ifs(filename, std::ios::in | std::ios::binary);
+    return ifs && get_raw_file_compression(RawFileHeader(ifs)) != RawCompression::None;
+}
+
+size_t CompressedRawFileStream::get_n_chunks() const {
+    return buffer_->get_n_chunks();
+}
+
+uint64_t CompressedRawFileStream::get_size() const {
+    return buffer_->get_size();
+}
+
+} // namespace Metavision
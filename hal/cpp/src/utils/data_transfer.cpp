@@ -9,20 +9,159 @@
  * See the License for the specific language governing permissions and limitations under the License.                 *
  **********************************************************************************************************************/
 
+#include <algorithm>
+#include <iterator>
+#include <mutex>
+
 #include "metavision/hal/utils/hal_exception.h"
+#include "metavision/hal/utils/hal_log.h"
 #include "metavision/hal/utils/data_transfer.h"
+#include "metavision/sdk/base/utils/trace.h"
 
 namespace Metavision {
 
-DataTransfer::DataTransfer(uint32_t raw_event_size_bytes) : raw_event_size_bytes_(raw_event_size_bytes) {}
+constexpr size_t DataTransfer::BufferAlignment;
+
+DataTransfer::BufferSlice::BufferSlice(const BufferPtr &buffer) :
+    owner_(buffer),
+    data_(buffer ? buffer->data() : nullptr),
+    size_(buffer ? buffer->size() : 0),
+    arrival_time_(std::chrono::steady_clock::now()) {}
+
+DataTransfer::BufferSlice::BufferSlice(Data *begin, Data *end, const std::shared_ptr<const void> &owner) :
+    owner_(owner), data_(begin), size_(std::distance(begin, end)), arrival_time_(std::chrono::steady_clock::now()) {}
+
+DataTransfer::BufferSlice DataTransfer::BufferSlice::from_external_memory(Data *begin, Data *end,
+                                                                          const std::function<void()> &release) {
+    return BufferSlice(begin, end, std::shared_ptr<const void>(begin, [release](const void *) {
+                           if (release) {
+                               release();
+                           }
+                       }));
+}
+
+DataTransfer::Data *DataTransfer::BufferSlice::data() const {
+    return data_;
+}
+
+size_t DataTransfer::BufferSlice::size() const {
+    return size_;
+}
+
+bool DataTransfer::BufferSlice::empty() const {
+    return size_ == 0;
+}
+
+std::chrono::steady_clock::time_point DataTransfer::BufferSlice::arrival_time() const {
+    return arrival_time_;
+}
+
+void DataTransfer::BufferSlice::set_arrival_time(const std::chrono::steady_clock::time_point &arrival_time) {
+    arrival_time_ = arrival_time;
+}
+
+bool DataTransfer::BufferSlice::is_discontinuous() const {
+    return discontinuous_;
+}
+
+void DataTransfer::BufferSlice::set_discontinuous(bool discontinuous) {
+    discontinuous_ = discontinuous;
+}
+
+void DataTransfer::BufferSlice::reset() {
+    owner_.reset();
+    data_          = nullptr;
+    size_          = 0;
+    arrival_time_  = std::chrono::steady_clock::time_point();
+    discontinuous_ = false;
+}
+
+// Buffers allocated on top of a bounded pool, and statistics of the buffers taken from it
+//
+// It is shared with the deleters of the extra buffers, which may be released after the data transfer is destroyed.
+struct DataTransfer::ElasticBuffers : public std::enable_shared_from_this<ElasticBuffers> {
+    // Gets an extra buffer, or nullptr if the memory ceiling is reached
+    BufferPtr acquire() {
+        std::unique_ptr<Buffer> buffer;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            last_shortage_time = std::chrono::steady_clock::now();
+            if (!free_buffers.empty()) {
+                buffer = std::move(free_buffers.back());
+                free_buffers.pop_back();
+            } else if ((num_buffers + 1) * buffer_bytes > config.max_extra_bytes) {
+                ++stats.drops;
+                return BufferPtr();
+            } else {
+                buffer.reset(new Buffer());
+                if (initializer) {
+                    initializer(*buffer);
+                }
+                ++num_buffers;
+            }
+            ++num_used_buffers;
+            ++stats.near_drops;
+        }
+
+        std::weak_ptr<ElasticBuffers> weak_this = shared_from_this();
+        return BufferPtr(buffer.release(), [weak_this](Buffer *buffer) {
+            if (auto elastic_buffers = weak_this.lock()) {
+                elastic_buffers->release(std::unique_ptr<Buffer>(buffer));
+            } else {
+                delete buffer;
+            }
+        });
+    }
+
+    void release(std::unique_ptr<Buffer> buffer) {
+        std::lock_guard<std::mutex> lock(mutex);
+        --num_used_buffers;
+        buffer_bytes = std::max(buffer_bytes, buffer->capacity());
+        if (std::chrono::steady_clock::now() - last_shortage_time < config.shrink_delay) {
+            free_buffers.push_back(std::move(buffer));
+        } else {
+            --num_buffers;
+        }
+    }
+
+    // Frees the unused extra buffers if there has been no shortage for a while
+    void shrink() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!free_buffers.empty() && std::chrono::steady_clock::now() - last_shortage_time >= config.shrink_delay) {
+            num_buffers -= free_buffers.size();
+            free_buffers.clear();
+        }
+    }
+
+    std::mutex mutex;
+    ElasticBufferingConfig config;
+    std::function<void(Buffer &)> initializer; // Called on the extra buffers allocated
+    BufferingStatistics stats;
+    std::vector<std::unique_ptr<Buffer>> free_buffers;
+    size_t num_buffers      = 0;
+    size_t num_used_buffers = 0;
+    size_t buffer_bytes     = 1; // Capacity of the biggest buffer transferred, used to estimate the memory used
+    std::chrono::steady_clock::time_point last_shortage_time;
+};
+
+DataTransfer::DataTransfer(uint32_t raw_event_size_bytes) :
+    raw_event_size_bytes_(raw_event_size_bytes),
+    buffer_pool_size_(0),
+    elastic_buffers_(std::make_shared<ElasticBuffers>()) {
+    buffer_pool_.register_statistics("DataTransfer buffers");
+}
 
 DataTransfer::DataTransfer(uint32_t raw_event_size_bytes, const BufferPool &buffer_pool) :
-    raw_event_size_bytes_(raw_event_size_bytes), buffer_pool_(buffer_pool) {
+    raw_event_size_bytes_(raw_event_size_bytes),
+    buffer_pool_(buffer_pool),
+    buffer_pool_size_(buffer_pool_.size()),
+    elastic_buffers_(std::make_shared<ElasticBuffers>()) {
     if (buffer_pool_.is_bounded() && buffer_pool_.size() < 3) {
         throw HalException(HalErrorCode::InvalidArgument,
                            "A DataTransfer can not be initialized with a bounded object pool of size < 3 (got size " +
                                std::to_string(buffer_pool_.size()) + ").");
     }
+    buffer_pool_.register_statistics("DataTransfer buffers");
 }
 
 DataTransfer::~DataTransfer() {
@@ -37,10 +176,17 @@ void DataTransfer::start() {
         return;
     }
 
-    stop_ = false;
+    stop_                  = false;
+    paused_                = false;
+    discontinuity_pending_ = false;
     start_impl(get_buffer());
 
     run_transfers_thread_ = std::thread([this]() {
+        if (!apply_thread_policy(thread_policy_, "mv_transfer")) {
+            MV_HAL_LOG_WARNING() << "Failed to apply the threading policy of the data transfer thread";
+        }
+        MV_TRACE_THREAD_NAME("mv_transfer");
+
         for (auto cb : status_change_cbs_) {
             cb.second(Status::Started);
         }
@@ -61,11 +207,68 @@ void DataTransfer::stop() {
         return;
     }
 
-    stop_ = true;
+    {
+        std::lock_guard<std::mutex> lock(pause_mutex_);
+        stop_ = true;
+    }
+    pause_cond_.notify_all();
     stop_impl();
     run_transfers_thread_.join();
 }
 
+void DataTransfer::pause() {
+    paused_ = true;
+}
+
+void DataTransfer::resume() {
+    {
+        std::lock_guard<std::mutex> lock(pause_mutex_);
+        paused_ = false;
+    }
+    pause_cond_.notify_all();
+}
+
+bool DataTransfer::is_paused() const {
+    return paused_;
+}
+
+bool DataTransfer::seek(uint64_t position) {
+    if (run_transfers_thread_.joinable()) {
+        throw HalException(HalErrorCode::OperationNotPermitted, "Can not seek while the data is being transferred.");
+    }
+    return seek_impl(position);
+}
+
+void DataTransfer::set_elastic_buffering(const ElasticBufferingConfig &config) {
+    std::lock_guard<std::mutex> lock(elastic_buffers_->mutex);
+    elastic_buffers_->config = config;
+}
+
+bool DataTransfer::set_memory_placement(const MemoryPlacement &placement, size_t buffer_bytes) {
+    if (run_transfers_thread_.joinable()) {
+        throw HalException(HalErrorCode::OperationNotPermitted,
+                           "Can not place the buffers while the data is being transferred.");
+    }
+    const bool placed = place_pool_buffers(buffer_pool_, buffer_bytes, placement);
+
+    std::lock_guard<std::mutex> lock(elastic_buffers_->mutex);
+    elastic_buffers_->initializer = [placement, buffer_bytes](Buffer &buffer) {
+        place_buffer(buffer, buffer_bytes, placement);
+    };
+    return placed;
+}
+
+DataTransfer::BufferingStatistics DataTransfer::get_buffering_statistics() const {
+    std::lock_guard<std::mutex> lock(elastic_buffers_->mutex);
+    BufferingStatistics stats = elastic_buffers_->stats;
+    stats.extra_buffers       = elastic_buffers_->num_buffers;
+    return stats;
+}
+
+void DataTransfer::set_thread_policy(const ThreadPolicy &policy) {
+    thread_policy_ = policy;
+}
+
 size_t DataTransfer::add_status_changed_callback(StatusChangeCallback_t cb) {
     status_change_cbs_[cb_index_] = cb;
     auto ret                      = cb_index_;
@@ -80,24 +283,124 @@ size_t DataTransfer::add_new_buffer_callback(NewBufferCallback_t cb) {
     return ret;
 }
 
+size_t DataTransfer::add_new_slice_callback(NewSliceCallback_t cb) {
+    new_slice_cbs_[cb_index_] = cb;
+    auto ret                  = cb_index_;
+    ++cb_index_;
+    return ret;
+}
+
 void DataTransfer::remove_callback(size_t cb_id) {
     status_change_cbs_.erase(cb_id);
     new_buffer_cbs_.erase(cb_id);
+    new_slice_cbs_.erase(cb_id);
 }
 
 uint32_t DataTransfer::get_raw_event_size_bytes() const {
     return raw_event_size_bytes_;
 }
 
+bool DataTransfer::wait_while_paused() {
+    if (!paused_) {
+        return true;
+    }
+    if (!hold_data_while_paused()) {
+        return false;
+    }
+    MV_TRACE_SCOPE("DataTransfer::wait_while_paused");
+    std::unique_lock<std::mutex> lock(pause_mutex_);
+    pause_cond_.wait(lock, [this]() { return !paused_ || stop_; });
+    return !stop_;
+}
+
 DataTransfer::BufferPtr DataTransfer::transfer_data(const BufferPtr &buffer) {
+    MV_TRACE_SCOPE("DataTransfer::transfer_data");
+    MV_TRACE_COUNTER("DataTransfer buffer bytes", buffer->size());
+    if (!wait_while_paused()) {
+        // The data is dropped: the buffer goes back to the pool as soon as the implementation releases it
+        return get_buffer();
+    }
+
+    if (buffer_pool_.is_bounded()) {
+        std::lock_guard<std::mutex> lock(elastic_buffers_->mutex);
+        elastic_buffers_->buffer_bytes = std::max(elastic_buffers_->buffer_bytes, buffer->capacity());
+    }
+
     for (auto cb : new_buffer_cbs_) {
         cb.second(buffer);
     }
 
+    const bool discontinuous = discontinuity_pending_;
+    discontinuity_pending_   = false;
+    if (!new_slice_cbs_.empty()) {
+        BufferSlice slice(buffer);
+        slice.set_discontinuous(discontinuous);
+        for (auto cb : new_slice_cbs_) {
+            cb.second(slice);
+        }
+    }
+
     return get_buffer();
 }
 
+void DataTransfer::transfer_slice(const BufferSlice &slice) {
+    MV_TRACE_SCOPE("DataTransfer::transfer_slice");
+    MV_TRACE_COUNTER("DataTransfer buffer bytes", slice.size());
+    if (!wait_while_paused()) {
+        return;
+    }
+
+    if (!new_buffer_cbs_.empty()) {
+        // Clients working on buffers from the pool can not refer to memory they don't own: give them a copy
+        auto buffer = get_buffer();
+        buffer->assign(slice.data(), slice.data() + slice.size());
+        for (auto cb : new_buffer_cbs_) {
+            cb.second(buffer);
+        }
+    }
+
+    if (discontinuity_pending_) {
+        discontinuity_pending_ = false;
+        BufferSlice discontinuous_slice(slice);
+        discontinuous_slice.set_discontinuous(true);
+        for (auto cb : new_slice_cbs_) {
+            cb.second(discontinuous_slice);
+        }
+        return;
+    }
+
+    for (auto cb : new_slice_cbs_) {
+        cb.second(slice);
+    }
+}
+
+void DataTransfer::mark_discontinuity() {
+    discontinuity_pending_ = true;
+}
+
 DataTransfer::BufferPtr DataTransfer::get_buffer() {
+    if (!buffer_pool_.is_bounded()) {
+        return buffer_pool_.acquire();
+    }
+
+    // The buffers are only acquired by the transfers, the pool can not be emptied by another thread after this check
+    const size_t num_free_buffers   = buffer_pool_.size();
+    ElasticBuffers &elastic_buffers = *elastic_buffers_;
+    {
+        std::lock_guard<std::mutex> lock(elastic_buffers.mutex);
+        const size_t depth = buffer_pool_size_ - num_free_buffers + elastic_buffers.num_used_buffers + 1;
+        elastic_buffers.stats.peak_depth = std::max(elastic_buffers.stats.peak_depth, depth);
+        MV_TRACE_COUNTER("DataTransfer buffers in use", depth);
+    }
+    if (num_free_buffers == 0) {
+        if (auto buffer = elastic_buffers.acquire()) {
+            return buffer;
+        }
+    } else {
+        elastic_buffers.shrink();
+    }
+    // Waits for a buffer to be released if the pool is empty
+    MV_TRACE_SCOPE("DataTransfer::get_buffer");
     return buffer_pool_.acquire();
 }
 
@@ -109,4 +412,12 @@ void DataTransfer::start_impl(BufferPtr buffer) {}
 
 void DataTransfer::stop_impl() {}
 
+bool DataTransfer::hold_data_while_paused() const {
+    return false;
+}
+
+bool DataTransfer::seek_impl(uint64_t position) {
+    return false;
+}
+
 } // namespace Metavision
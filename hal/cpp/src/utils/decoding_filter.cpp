@@ -0,0 +1,103 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <string>
+
+#include "metavision/hal/utils/decoding_filter.h"
+#include "metavision/hal/utils/hal_exception.h"
+
+namespace Metavision {
+
+DecodingFilter::DecodingFilter(int width, int height) : width_(width), height_(height) {
+    if (width <= 0 || height <= 0) {
+        throw HalException(HalErrorCode::InvalidArgument, "The size of the sensor must be positive.");
+    }
+    row_words_ = static_cast<size_t>(width) / 64 + 2;
+    set_rois({});
+}
+
+void DecodingFilter::set_rois(const std::vector<DeviceRoi> &rois) {
+    rois_ = rois.empty() ? std::vector<DeviceRoi>{DeviceRoi(0, 0, width_, height_)} : rois;
+    update_mask();
+}
+
+void DecodingFilter::set_masked_pixels(const std::vector<std::uint64_t> &mask) {
+    const size_t num_words = (static_cast<size_t>(width_) * height_ + 63) / 64;
+    if (!mask.empty() && mask.size() < num_words) {
+        throw HalException(HalErrorCode::InvalidArgument, "The mask of the pixels must have " +
+                                                              std::to_string(num_words) + " words.");
+    }
+    masked_pixels_ = mask;
+    update_mask();
+}
+
+void DecodingFilter::update_mask() {
+    mask_.assign(row_words_ * height_, 0);
+    rows_.assign(height_, 0);
+    for (const auto &roi : rois_) {
+        const int x0 = std::max(roi.x_, 0), x1 = std::min(roi.x_ + roi.width_, width_);
+        const int y0 = std::max(roi.y_, 0), y1 = std::min(roi.y_ + roi.height_, height_);
+        for (int y = y0; y < y1; ++y) {
+            std::uint64_t *row = mask_.data() + static_cast<size_t>(y) * row_words_;
+            for (int x = x0; x < x1; ++x) {
+                row[x >> 6] |= std::uint64_t(1) << (x & 63);
+            }
+            rows_[y] |= x0 < x1;
+        }
+    }
+    if (masked_pixels_.empty()) {
+        return;
+    }
+
+    // The masked pixels are usually few, so only the bits of the non-zero words are looked up
+    const size_t num_pixels = static_cast<size_t>(width_) * height_;
+    for (size_t w = 0; w < masked_pixels_.size(); ++w) {
+        if (!masked_pixels_[w]) {
+            continue;
+        }
+        for (size_t b = 0, pixel = w * 64; b < 64 && pixel < num_pixels; ++b, ++pixel) {
+            if ((masked_pixels_[w] >> b) & 1) {
+                const int y = static_cast<int>(pixel / width_), x = static_cast<int>(pixel % width_);
+                mask_[static_cast<size_t>(y) * row_words_ + (x >> 6)] &= ~(std::uint64_t(1) << (x & 63));
+            }
+        }
+    }
+    for (int y = 0; y < height_; ++y) {
+        const std::uint64_t *row = mask_.data() + static_cast<size_t>(y) * row_words_;
+        rows_[y]                 = std::any_of(row, row + row_words_, [](std::uint64_t w) { return w != 0; });
+    }
+}
+
+void DecodingFilter::set_polarities(bool negative, bool positive) {
+    polarities_[0] = negative;
+    polarities_[1] = positive;
+}
+
+void DecodingFilter::set_decimation(std::uint32_t factor) {
+    if (factor == 0) {
+        throw HalException(HalErrorCode::InvalidArgument, "The decimation factor must be at least 1.");
+    }
+    decimation_factor_ = factor;
+    decimation_count_  = 0;
+}
+
+EventCD *DecodingFilter::apply(EventCD *begin, EventCD *end) {
+    EventCD *out = begin;
+    for (EventCD *ev = begin; ev != end; ++ev) {
+        if (is_accepted(ev->x, ev->y, ev->p) && decimate()) {
+            *out++ = *ev;
+        }
+    }
+    return out;
+}
+
+} // namespace Metavision
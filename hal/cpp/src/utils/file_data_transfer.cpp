@@ -14,6 +14,11 @@
 #include "metavision/hal/utils/hal_log.h"
 #include "metavision/hal/utils/hal_exception.h"
 #include "metavision/hal/utils/file_data_transfer.h"
+#include "metavision/hal/utils/memory_mapped_file_stream.h"
+#include "metavision/hal/utils/memory_raw_stream.h"
+#include "metavision/hal/utils/network_raw_stream.h"
+#include "metavision/hal/utils/read_ahead_file_stream.h"
+#include "metavision/hal/utils/shared_memory_raw_stream.h"
 
 namespace Metavision {
 
@@ -31,21 +36,109 @@ FileDataTransfer::FileDataTransfer(std::unique_ptr<std::istream> stream, uint32_
                                                           "events to read per read iteration must be greater than 0.");
     }
 
-    read_bytes_size_ = config.n_events_to_read_ * get_raw_event_size_bytes();
+    read_bytes_size_   = config.n_events_to_read_ * get_raw_event_size_bytes();
+    n_read_buffers_       = std::max(2u, config.n_read_buffers_);
+    mapped_stream_        = dynamic_cast<MemoryMappedFileStream *>(stream_to_read_.get());
+    memory_stream_        = dynamic_cast<MemoryRawStream *>(stream_to_read_.get());
+    read_ahead_stream_    = dynamic_cast<ReadAheadFileStream *>(stream_to_read_.get());
+    shared_memory_stream_ = dynamic_cast<SharedMemoryRawStream *>(stream_to_read_.get());
+    network_stream_       = dynamic_cast<NetworkRawStream *>(stream_to_read_.get());
+
+    if (config.n_us_to_read_ > 0) {
+        // The first reads are small, so that the time granularity is right from the start of the file
+        const uint32_t min_events_to_read = std::min(config.n_events_to_read_, 256u);
+        adaptive_read_size_ =
+            std::make_shared<AdaptiveReadSize>(config.n_us_to_read_, get_raw_event_size_bytes(),
+                                               min_events_to_read * get_raw_event_size_bytes(), read_bytes_size_);
+    }
+
+    const MemoryPlacement &placement = config.memory_placement_;
+    if (placement.numa_node >= 0 || placement.huge_pages) {
+        if (!set_memory_placement(placement, read_bytes_size_)) {
+            MV_HAL_LOG_WARNING() << "The memory placement of the buffers of the RAW file could not be applied.";
+        }
+    }
+
+    if (config.loop_ && !shared_memory_stream_ && !network_stream_) {
+        // The data starts where the stream has been left (i.e. after the header). The stream is only looped if it
+        // supports seeking and holds data, not to spin forever on an empty one
+        data_begin_ = stream_to_read_->tellg();
+        if (data_begin_ >= 0 && stream_to_read_->seekg(0, std::ios::end)) {
+            const std::streampos data_end = stream_to_read_->tellg();
+            loop_                         = data_end > data_begin_;
+        }
+        stream_to_read_->clear();
+        if (data_begin_ >= 0) {
+            stream_to_read_->seekg(data_begin_);
+        }
+        if (!loop_) {
+            MV_HAL_LOG_WARNING() << "The RAW file can not be read in a loop, it will be read once.";
+        }
+    }
 }
 
 FileDataTransfer::~FileDataTransfer() {
     stop();
 }
 
+const std::shared_ptr<AdaptiveReadSize> &FileDataTransfer::get_adaptive_read_size() const {
+    return adaptive_read_size_;
+}
+
+bool FileDataTransfer::is_looping() const {
+    return loop_;
+}
+
+uint32_t FileDataTransfer::get_read_size() const {
+    return adaptive_read_size_ ? adaptive_read_size_->get_read_size() : read_bytes_size_;
+}
+
 void FileDataTransfer::start_impl(BufferPtr buffer) {
     data_read_ = buffer;
 }
 
 void FileDataTransfer::run_impl() {
+    do {
+        run_once();
+    } while (loop_ && !should_stop() && rewind());
+}
+
+bool FileDataTransfer::rewind() {
+    stream_to_read_->clear();
+    stream_to_read_->seekg(data_begin_);
+    if (!stream_to_read_->good()) {
+        return false;
+    }
+    mark_discontinuity();
+    return true;
+}
+
+void FileDataTransfer::run_once() {
+    if (mapped_stream_) {
+        run_memory_mapped();
+        return;
+    }
+    if (memory_stream_) {
+        run_memory_buffers();
+        return;
+    }
+    if (shared_memory_stream_) {
+        run_shared_memory();
+        return;
+    }
+    if (network_stream_) {
+        run_network();
+        return;
+    }
+    if (read_ahead_stream_ && read_ahead_stream_->get_n_reads_in_flight() > 1 && read_ahead_stream_->get_file_size()) {
+        run_read_ahead();
+        return;
+    }
+
     while (!should_stop()) {
-        data_read_->resize(read_bytes_size_); // Does not reallocate if enough memory already allocated.
-        stream_to_read_->read(reinterpret_cast<char *>(data_read_->data()), read_bytes_size_);
+        const uint32_t read_size = get_read_size();
+        data_read_->resize(read_size); // Does not reallocate if enough memory already allocated.
+        stream_to_read_->read(reinterpret_cast<char *>(data_read_->data()), read_size);
 
         // get size of what have been read (in bytes)
         auto read = stream_to_read_->gcount();
@@ -63,4 +156,145 @@ void FileDataTransfer::run_impl() {
     }
 }
 
+bool FileDataTransfer::hold_data_while_paused() const {
+    // The reading of a file just waits, so that no data is skipped, while live streams are dropped
+    return !shared_memory_stream_ && !network_stream_;
+}
+
+bool FileDataTransfer::seek_impl(uint64_t position) {
+    // The next transfers start where the stream has been left
+    stream_to_read_->clear();
+    stream_to_read_->seekg(position);
+    return stream_to_read_->good();
+}
+
+void FileDataTransfer::run_memory_mapped() {
+    // The data starts where the stream has been left (i.e. after the header)
+    auto pos = mapped_stream_->tellg();
+    if (pos < 0) {
+        return;
+    }
+
+    auto mapping         = mapped_stream_->get_mapping();
+    uint8_t *const end   = mapped_stream_->data() + mapped_stream_->size();
+    uint8_t *slice_begin = mapped_stream_->data() + static_cast<size_t>(pos);
+    while (!should_stop() && slice_begin < end) {
+        uint8_t *slice_end = slice_begin + std::min<size_t>(get_read_size(), std::distance(slice_begin, end));
+        transfer_slice(BufferSlice(slice_begin, slice_end, mapping));
+        mapped_stream_->seekg(std::distance(slice_begin, slice_end), std::ios::cur);
+        slice_begin = slice_end;
+    }
+}
+
+void FileDataTransfer::run_memory_buffers() {
+    // The data starts where the stream has been left (i.e. after the header)
+    auto pos = memory_stream_->tellg();
+    if (pos < 0) {
+        return;
+    }
+
+    const auto &owner = memory_stream_->get_owner();
+    size_t skip       = static_cast<size_t>(pos);
+    for (const auto &buffer : memory_stream_->get_buffers()) {
+        if (skip >= buffer.size) {
+            skip -= buffer.size;
+            continue;
+        }
+        // The slices never write to the memory of the caller, the const is only cast away to match BufferSlice
+        uint8_t *const end   = const_cast<uint8_t *>(static_cast<const uint8_t *>(buffer.data)) + buffer.size;
+        uint8_t *slice_begin = end - (buffer.size - skip);
+        skip                 = 0;
+        while (slice_begin < end) {
+            if (should_stop()) {
+                return;
+            }
+            uint8_t *slice_end = slice_begin + std::min<size_t>(get_read_size(), std::distance(slice_begin, end));
+            transfer_slice(BufferSlice(slice_begin, slice_end, owner));
+            memory_stream_->seekg(std::distance(slice_begin, slice_end), std::ios::cur);
+            slice_begin = slice_end;
+        }
+    }
+}
+
+void FileDataTransfer::run_read_ahead() {
+    // The data starts where the stream has been left (i.e. after the header)
+    auto pos = read_ahead_stream_->tellg();
+    if (pos < 0) {
+        return;
+    }
+
+    // One buffer of the pool is always kept out of the reads: it is the one the consumer of the transferred data may
+    // still be holding while waiting for the next one
+    const size_t max_reads_in_flight =
+        std::min<size_t>(read_ahead_stream_->get_n_reads_in_flight(), std::max(1u, n_read_buffers_ - 1));
+    const uint64_t file_size = read_ahead_stream_->get_file_size();
+    uint64_t offset          = static_cast<uint64_t>(pos);
+    uint64_t transferred_end = offset; // Offset in the file of the end of the data transferred
+    BufferPtr next_buffer    = std::move(data_read_);
+
+    while (!should_stop()) {
+        while (offset < file_size && read_ahead_stream_->get_n_pending_reads() < max_reads_in_flight) {
+            if (!next_buffer) {
+                next_buffer = get_buffer();
+            }
+            const uint32_t read_size = get_read_size();
+            read_ahead_stream_->submit(next_buffer, offset, read_size);
+            next_buffer = BufferPtr();
+            offset += read_size;
+        }
+
+        auto buffer = read_ahead_stream_->wait_next();
+        if (!buffer || buffer->empty()) {
+            break;
+        }
+        transferred_end += buffer->size();
+        next_buffer = transfer_data(buffer);
+    }
+
+    // Buffers from the pool must not be in use anymore when returning. The reads still in flight are dropped, and the
+    // stream is left at the end of the data transferred, so that the next transfers resume from there
+    while (read_ahead_stream_->wait_next()) {}
+    data_read_ = next_buffer;
+    read_ahead_stream_->clear();
+    read_ahead_stream_->seekg(transferred_end);
+}
+
+void FileDataTransfer::run_shared_memory() {
+    // The data fetched from the ring while parsing the header is transferred first
+    auto pending = shared_memory_stream_->take_pending_slice();
+    if (!pending.empty()) {
+        transfer_slice(pending);
+    }
+
+    // The ring is polled with a timeout, so that a stop request is not delayed while nothing is published
+    auto &ring = shared_memory_stream_->get_ring();
+    while (!should_stop() && !ring->is_closed()) {
+        auto slice = ring->wait_next(std::chrono::milliseconds(100));
+        if (!slice.empty()) {
+            transfer_slice(slice);
+        }
+    }
+}
+
+void FileDataTransfer::run_network() {
+    // The data received while parsing the header is transferred first
+    network_stream_->take_pending_data(*data_read_);
+    if (!data_read_->empty()) {
+        data_read_ = transfer_data(data_read_);
+    }
+
+    // The connection is polled with a timeout, so that a stop request is not delayed while nothing is received
+    while (!should_stop()) {
+        if (!network_stream_->wait_for_data(std::chrono::milliseconds(100))) {
+            continue;
+        }
+        if (!network_stream_->read_chunk(*data_read_)) {
+            break;
+        }
+        if (!data_read_->empty()) {
+            data_read_ = transfer_data(data_read_);
+        }
+    }
+}
+
 } // namespace Metavision
@@ -0,0 +1,374 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <netdb.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#endif
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+#include "metavision/hal/utils/http_range_backend.h"
+#include "metavision/hal/utils/hal_error_code.h"
+#include "metavision/hal/utils/hal_exception.h"
+#include "metavision/hal/utils/hal_log.h"
+
+namespace Metavision {
+
+namespace {
+
+#ifdef _WIN32
+using Socket                   = SOCKET;
+constexpr Socket InvalidSocket = INVALID_SOCKET;
+constexpr int SendFlags        = 0;
+#else
+using Socket                   = int;
+constexpr Socket InvalidSocket = -1;
+#ifdef MSG_NOSIGNAL
+constexpr int SendFlags = MSG_NOSIGNAL;
+#else
+constexpr int SendFlags = 0;
+#endif
+#endif
+
+constexpr size_t MaxResponseHeaderSize = 64 * 1024;
+constexpr int SocketBufferSize         = 4 * 1024 * 1024;
+constexpr int MaxAttempts              = 2;
+constexpr int ReceiveTimeoutMs         = 30000;
+
+void init_sockets() {
+#ifdef _WIN32
+    static struct WinsockInitializer {
+        WinsockInitializer() {
+            WSADATA data;
+            WSAStartup(MAKEWORD(2, 2), &data);
+        }
+    } initializer;
+#endif
+}
+
+void close_socket(Socket socket) {
+#ifdef _WIN32
+    closesocket(socket);
+#else
+    close(socket);
+#endif
+}
+
+bool send_all(Socket socket, const std::string &data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        const auto n = send(socket, data.data() + sent, static_cast<int>(data.size() - sent), SendFlags);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        sent += n;
+    }
+    return true;
+}
+
+// Returns the number of bytes received, 0 if the connection is closed or -1 on error
+int64_t recv_some(Socket socket, uint8_t *data, size_t size) {
+    while (true) {
+        const auto n = recv(socket, reinterpret_cast<char *>(data), static_cast<int>(std::min<size_t>(size, 1 << 30)),
+                            0);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        return n;
+    }
+}
+
+std::string to_lower(std::string s) {
+    std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return s;
+}
+
+// Splits "http://<host>[:<port>][/<path>]" into its host, port and path
+void parse_http_url(const std::string &url, std::string &host, std::string &port, std::string &path) {
+    static const std::string http_prefix = "http://";
+    if (url.compare(0, http_prefix.size(), http_prefix) != 0) {
+        throw HalException(HalErrorCode::InvalidArgument,
+                           "Unsupported URL '" + url + "', only http:// and s3:// URLs are supported.");
+    }
+    const size_t path_pos       = url.find('/', http_prefix.size());
+    const std::string authority = url.substr(http_prefix.size(), path_pos - http_prefix.size());
+    path                        = path_pos == std::string::npos ? "/" : url.substr(path_pos);
+    const size_t port_pos       = authority.rfind(':');
+    host                        = authority.substr(0, port_pos);
+    port                        = port_pos == std::string::npos ? "80" : authority.substr(port_pos + 1);
+    if (host.empty() || port.empty()) {
+        throw HalException(HalErrorCode::InvalidArgument, "Invalid URL '" + url + "'.");
+    }
+}
+
+} // namespace
+
+struct HttpRangeBackend::Connection {
+    ~Connection() {
+        if (socket != InvalidSocket) {
+            close_socket(socket);
+        }
+    }
+
+    Socket socket = InvalidSocket;
+};
+
+struct HttpRangeBackend::Response {
+    int status          = 0;
+    uint64_t total_size = 0; // From the Content-Range header
+    int64_t body_size   = 0;
+    bool keep_alive     = true;
+};
+
+HttpRangeBackend::HttpRangeBackend(const std::string &url) : url_(url) {
+    init_sockets();
+
+    static const std::string s3_prefix = "s3://";
+    if (url.compare(0, s3_prefix.size(), s3_prefix) == 0) {
+        const std::string bucket_and_key = url.substr(s3_prefix.size());
+        const size_t key_pos             = bucket_and_key.find('/');
+        if (key_pos == std::string::npos || key_pos == 0 || key_pos + 1 == bucket_and_key.size()) {
+            throw HalException(HalErrorCode::InvalidArgument,
+                               "Invalid S3 URL '" + url + "', expected s3://<bucket>/<key>.");
+        }
+        const char *endpoint = std::getenv("AWS_ENDPOINT_URL");
+        if (endpoint && *endpoint) {
+            parse_http_url(endpoint, host_, port_, path_);
+            if (path_.back() != '/') {
+                path_ += '/';
+            }
+            path_ += bucket_and_key;
+        } else {
+            parse_http_url("http://" + bucket_and_key.substr(0, key_pos) + ".s3.amazonaws.com" +
+                               bucket_and_key.substr(key_pos),
+                           host_, port_, path_);
+        }
+    } else {
+        parse_http_url(url, host_, port_, path_);
+    }
+
+    // The size of the file is given by the response to a request of its first byte
+    uint8_t first_byte;
+    Response response;
+    if (!fetch(0, 1, &first_byte, response)) {
+        throw HalException(HalErrorCode::FailedInitialization, "Unable to connect to '" + url + "'.");
+    }
+    if (response.status == 416) {
+        // Only an empty file has no first byte
+        size_ = 0;
+    } else if (response.status == 200) {
+        throw HalException(HalErrorCode::FailedInitialization,
+                           "The server of '" + url + "' does not support range requests.");
+    } else if (response.status != 206 || response.total_size == 0) {
+        throw HalException(HalErrorCode::FailedInitialization,
+                           "Unable to open '" + url + "', HTTP status " + std::to_string(response.status) + ".");
+    } else {
+        size_ = response.total_size;
+    }
+}
+
+HttpRangeBackend::~HttpRangeBackend() = default;
+
+const std::string &HttpRangeBackend::get_location() const {
+    return url_;
+}
+
+bool HttpRangeBackend::is_open() const {
+    return true;
+}
+
+uint64_t HttpRangeBackend::get_size() const {
+    return size_;
+}
+
+int64_t HttpRangeBackend::read_at(uint8_t *data, uint64_t offset, size_t size) {
+    if (offset >= size_) {
+        return 0;
+    }
+    size = static_cast<size_t>(std::min<uint64_t>(size, size_ - offset));
+    if (size == 0) {
+        return 0;
+    }
+
+    Response response;
+    if (!fetch(offset, size, data, response)) {
+        MV_HAL_LOG_ERROR() << "Failed to read" << url_;
+        return -1;
+    }
+    if (response.status != 206) {
+        MV_HAL_LOG_ERROR() << "Failed to read" << url_ << ", HTTP status" << response.status;
+        return -1;
+    }
+    return response.body_size;
+}
+
+std::unique_ptr<HttpRangeBackend::Connection> HttpRangeBackend::take_connection() {
+    {
+        std::lock_guard<std::mutex> lock(connections_mutex_);
+        if (!idle_connections_.empty()) {
+            auto connection = std::move(idle_connections_.back());
+            idle_connections_.pop_back();
+            return connection;
+        }
+    }
+
+    addrinfo hints      = {};
+    hints.ai_family     = AF_UNSPEC;
+    hints.ai_socktype   = SOCK_STREAM;
+    hints.ai_protocol   = IPPROTO_TCP;
+    addrinfo *addresses = nullptr;
+    if (getaddrinfo(host_.c_str(), port_.c_str(), &hints, &addresses) != 0) {
+        return nullptr;
+    }
+    auto connection = std::make_unique<Connection>();
+    for (addrinfo *address = addresses; address && connection->socket == InvalidSocket; address = address->ai_next) {
+        connection->socket = socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+        if (connection->socket != InvalidSocket &&
+            connect(connection->socket, address->ai_addr, static_cast<socklen_t>(address->ai_addrlen)) != 0) {
+            close_socket(connection->socket);
+            connection->socket = InvalidSocket;
+        }
+    }
+    freeaddrinfo(addresses);
+    if (connection->socket == InvalidSocket) {
+        return nullptr;
+    }
+    const int buffer_size = SocketBufferSize;
+    setsockopt(connection->socket, SOL_SOCKET, SO_RCVBUF, reinterpret_cast<const char *>(&buffer_size),
+               sizeof(buffer_size));
+    // A stalled server makes the reception fail instead of blocking the reading thread forever
+#ifdef _WIN32
+    const DWORD timeout = ReceiveTimeoutMs;
+#else
+    timeval timeout = {};
+    timeout.tv_sec  = ReceiveTimeoutMs / 1000;
+    timeout.tv_usec = (ReceiveTimeoutMs % 1000) * 1000;
+#endif
+    setsockopt(connection->socket, SOL_SOCKET, SO_RCVTIMEO, reinterpret_cast<const char *>(&timeout),
+               sizeof(timeout));
+    return connection;
+}
+
+void HttpRangeBackend::give_back_connection(std::unique_ptr<Connection> connection) {
+    std::lock_guard<std::mutex> lock(connections_mutex_);
+    idle_connections_.push_back(std::move(connection));
+}
+
+bool HttpRangeBackend::fetch(uint64_t offset, size_t size, uint8_t *data, Response &response) {
+    const std::string request = "GET " + path_ + " HTTP/1.1\r\nHost: " + host_ + (port_ == "80" ? "" : ":" + port_) +
+                                "\r\nRange: bytes=" + std::to_string(offset) + "-" +
+                                std::to_string(offset + size - 1) + "\r\nConnection: keep-alive\r\n\r\n";
+
+    // An idle connection may have been closed by the server in the meantime, the request is then sent again on a new
+    // one
+    for (int attempt = 0; attempt < MaxAttempts; ++attempt) {
+        auto connection = take_connection();
+        if (!connection) {
+            return false;
+        }
+        if (!send_all(connection->socket, request)) {
+            continue;
+        }
+
+        // Header of the response
+        std::string header;
+        size_t header_end = std::string::npos;
+        uint8_t chunk[4096];
+        while (header_end == std::string::npos && header.size() < MaxResponseHeaderSize) {
+            const int64_t n = recv_some(connection->socket, chunk, sizeof(chunk));
+            if (n <= 0) {
+                break;
+            }
+            header.append(reinterpret_cast<const char *>(chunk), static_cast<size_t>(n));
+            header_end = header.find("\r\n\r\n");
+        }
+        if (header_end == std::string::npos) {
+            continue;
+        }
+
+        response               = Response();
+        int64_t content_length = -1;
+        size_t line_begin      = 0;
+        for (size_t line_end = header.find("\r\n"); line_begin < header_end;
+             line_begin = line_end + 2, line_end = header.find("\r\n", line_begin)) {
+            const std::string line = header.substr(line_begin, line_end - line_begin);
+            if (line_begin == 0) {
+                // Status line: HTTP/1.1 <status> <reason>
+                const size_t status_pos = line.find(' ');
+                response.status = status_pos == std::string::npos ? 0 : std::atoi(line.c_str() + status_pos + 1);
+                continue;
+            }
+            const size_t colon = line.find(':');
+            if (colon == std::string::npos) {
+                continue;
+            }
+            const std::string name = to_lower(line.substr(0, colon));
+            std::string value      = line.substr(colon + 1);
+            value.erase(0, value.find_first_not_of(' '));
+            if (name == "content-length") {
+                content_length = std::strtoll(value.c_str(), nullptr, 10);
+            } else if (name == "content-range") {
+                // bytes <first>-<last>/<total>
+                const size_t slash = value.rfind('/');
+                if (slash != std::string::npos) {
+                    response.total_size = std::strtoull(value.c_str() + slash + 1, nullptr, 10);
+                }
+            } else if (name == "connection") {
+                response.keep_alive = to_lower(value).find("close") == std::string::npos;
+            }
+        }
+
+        // The body of an error is not read, the connection is dropped
+        if (response.status != 206) {
+            return true;
+        }
+        // Only the body of a range fitting in the buffer and of known size is read (e.g. chunked ones are not)
+        if (content_length < 0 || static_cast<uint64_t>(content_length) > size) {
+            MV_HAL_LOG_ERROR() << "Unsupported response to a range request of" << url_;
+            return false;
+        }
+        const size_t body_begin  = header_end + 4;
+        const size_t prefix_size = std::min<size_t>(header.size() - body_begin, static_cast<size_t>(content_length));
+        std::memcpy(data, header.data() + body_begin, prefix_size);
+        size_t n_received = prefix_size;
+        while (n_received < static_cast<size_t>(content_length)) {
+            const int64_t n = recv_some(connection->socket, data + n_received, content_length - n_received);
+            if (n <= 0) {
+                break;
+            }
+            n_received += static_cast<size_t>(n);
+        }
+        if (n_received < static_cast<size_t>(content_length)) {
+            continue;
+        }
+        response.body_size = content_length;
+        if (response.keep_alive) {
+            give_back_connection(std::move(connection));
+        }
+        return true;
+    }
+    return false;
+}
+
+} // namespace Metavision
@@ -0,0 +1,169 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "metavision/hal/utils/memory_mapped_file_stream.h"
+#include "metavision/hal/utils/hal_error_code.h"
+#include "metavision/hal/utils/hal_exception.h"
+
+namespace Metavision {
+
+class MemoryMappedFileStream::Mapping {
+public:
+    Mapping(const std::string &filename) {
+#ifdef _WIN32
+        file_ = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+        if (file_ == INVALID_HANDLE_VALUE) {
+            throw HalException(HalErrorCode::FailedInitialization, "Unable to open file '" + filename + "'");
+        }
+        LARGE_INTEGER file_size;
+        if (!GetFileSizeEx(file_, &file_size)) {
+            CloseHandle(file_);
+            throw HalException(HalErrorCode::FailedInitialization, "Unable to get size of file '" + filename + "'");
+        }
+        size_ = static_cast<size_t>(file_size.QuadPart);
+        if (size_ == 0) {
+            return;
+        }
+        mapping_ = CreateFileMappingA(file_, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+        if (mapping_ == NULL) {
+            CloseHandle(file_);
+            throw HalException(HalErrorCode::FailedInitialization, "Unable to map file '" + filename + "'");
+        }
+        data_ = static_cast<uint8_t *>(MapViewOfFile(mapping_, FILE_MAP_COPY, 0, 0, 0));
+        if (data_ == nullptr) {
+            CloseHandle(mapping_);
+            CloseHandle(file_);
+            throw HalException(HalErrorCode::FailedInitialization, "Unable to map file '" + filename + "'");
+        }
+#else
+        int fd = open(filename.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw HalException(HalErrorCode::FailedInitialization, "Unable to open file '" + filename + "'");
+        }
+        struct stat file_stat;
+        if (fstat(fd, &file_stat) != 0) {
+            close(fd);
+            throw HalException(HalErrorCode::FailedInitialization, "Unable to get size of file '" + filename + "'");
+        }
+        size_ = static_cast<size_t>(file_stat.st_size);
+        if (size_ == 0) {
+            close(fd);
+            return;
+        }
+        void *data = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        // The mapping keeps its own reference on the file
+        close(fd);
+        if (data == MAP_FAILED) {
+            throw HalException(HalErrorCode::FailedInitialization, "Unable to map file '" + filename + "'");
+        }
+        data_ = static_cast<uint8_t *>(data);
+        madvise(data_, size_, MADV_SEQUENTIAL);
+#endif
+    }
+
+    ~Mapping() {
+#ifdef _WIN32
+        if (data_) {
+            UnmapViewOfFile(data_);
+            CloseHandle(mapping_);
+        }
+        CloseHandle(file_);
+#else
+        if (data_) {
+            munmap(data_, size_);
+        }
+#endif
+    }
+
+    uint8_t *data() const {
+        return data_;
+    }
+
+    size_t size() const {
+        return size_;
+    }
+
+private:
+#ifdef _WIN32
+    HANDLE file_{INVALID_HANDLE_VALUE};
+    HANDLE mapping_{NULL};
+#endif
+    uint8_t *data_{nullptr};
+    size_t size_{0};
+};
+
+MemoryMappedFileStream::MappedBuffer::MappedBuffer(char *begin, char *end) {
+    setg(begin, begin, end);
+}
+
+MemoryMappedFileStream::MappedBuffer::pos_type
+    MemoryMappedFileStream::MappedBuffer::seekoff(off_type off, std::ios_base::seekdir dir,
+                                                  std::ios_base::openmode which) {
+    if (!(which & std::ios_base::in)) {
+        return pos_type(off_type(-1));
+    }
+
+    char *target = nullptr;
+    if (dir == std::ios_base::beg) {
+        target = eback() + off;
+    } else if (dir == std::ios_base::cur) {
+        target = gptr() + off;
+    } else {
+        target = egptr() + off;
+    }
+
+    if (target < eback() || target > egptr()) {
+        return pos_type(off_type(-1));
+    }
+
+    setg(eback(), target, egptr());
+    return pos_type(target - eback());
+}
+
+MemoryMappedFileStream::MappedBuffer::pos_type
+    MemoryMappedFileStream::MappedBuffer::seekpos(pos_type pos, std::ios_base::openmode which) {
+    return seekoff(off_type(pos), std::ios_base::beg, which);
+}
+
+MemoryMappedFileStream::MemoryMappedFileStream(const std::string &filename) :
+    std::istream(nullptr), mapping_(std::make_shared<Mapping>(filename)) {
+    char *begin = reinterpret_cast<char *>(mapping_->data());
+    buffer_.reset(new MappedBuffer(begin, begin + mapping_->size()));
+    rdbuf(buffer_.get());
+}
+
+MemoryMappedFileStream::~MemoryMappedFileStream() {
+    rdbuf(nullptr);
+}
+
+uint8_t *MemoryMappedFileStream::data() const {
+    return mapping_->data();
+}
+
+size_t MemoryMappedFileStream::size() const {
+    return mapping_->size();
+}
+
+std::shared_ptr<const void> MemoryMappedFileStream::get_mapping() const {
+    return mapping_;
+}
+
+} // namespace Metavision
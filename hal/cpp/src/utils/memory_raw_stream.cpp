@@ -0,0 +1,115 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <streambuf>
+
+#include "metavision/hal/utils/memory_raw_stream.h"
+
+namespace Metavision {
+
+// Stream buffer whose get area is the current buffer of the list, moving to the next one when it is exhausted
+class MemoryRawStream::BuffersStreamBuf : public std::streambuf {
+public:
+    BuffersStreamBuf(const std::vector<Buffer> &buffers) : buffers_(buffers) {
+        for (const auto &buffer : buffers_) {
+            offsets_.push_back(size_);
+            size_ += buffer.size;
+        }
+        if (!buffers_.empty()) {
+            set_buffer(0, 0);
+        }
+    }
+
+    size_t size() const {
+        return size_;
+    }
+
+protected:
+    int_type underflow() override {
+        while (gptr() == egptr() && index_ + 1 < buffers_.size()) {
+            set_buffer(index_ + 1, 0);
+        }
+        return gptr() == egptr() ? traits_type::eof() : traits_type::to_int_type(*gptr());
+    }
+
+    std::streamsize showmanyc() override {
+        const off_type remaining = static_cast<off_type>(size_) - position();
+        return remaining > 0 ? remaining : -1;
+    }
+
+    pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override {
+        if (!(which & std::ios_base::in)) {
+            return pos_type(off_type(-1));
+        }
+        off_type target = off;
+        if (dir == std::ios_base::cur) {
+            target += position();
+        } else if (dir == std::ios_base::end) {
+            target += static_cast<off_type>(size_);
+        }
+        if (target < 0 || target > static_cast<off_type>(size_) || buffers_.empty()) {
+            return target == 0 ? pos_type(0) : pos_type(off_type(-1));
+        }
+        // Last buffer starting at or before the target
+        const size_t index = std::upper_bound(offsets_.begin(), offsets_.end(), static_cast<size_t>(target)) -
+                             offsets_.begin() - 1;
+        set_buffer(index, static_cast<size_t>(target) - offsets_[index]);
+        return pos_type(target);
+    }
+
+    pos_type seekpos(pos_type pos, std::ios_base::openmode which) override {
+        return seekoff(off_type(pos), std::ios_base::beg, which);
+    }
+
+private:
+    off_type position() const {
+        return buffers_.empty() ? 0 : static_cast<off_type>(offsets_[index_]) + (gptr() - eback());
+    }
+
+    void set_buffer(size_t index, size_t offset) {
+        // The get area is never written to, the const is only cast away to match the interface of std::streambuf
+        char *begin = const_cast<char *>(static_cast<const char *>(buffers_[index].data));
+        index_      = index;
+        setg(begin, begin + offset, begin + buffers_[index].size);
+    }
+
+    const std::vector<Buffer> &buffers_;
+    std::vector<size_t> offsets_;
+    size_t size_  = 0;
+    size_t index_ = 0;
+};
+
+MemoryRawStream::MemoryRawStream(const void *data, size_t size, const std::shared_ptr<const void> &owner) :
+    MemoryRawStream(std::vector<Buffer>{{data, size}}, owner) {}
+
+MemoryRawStream::MemoryRawStream(const std::vector<Buffer> &buffers, const std::shared_ptr<const void> &owner) :
+    std::istream(nullptr), buffers_(buffers), owner_(owner), streambuf_(new BuffersStreamBuf(buffers_)) {
+    rdbuf(streambuf_.get());
+}
+
+MemoryRawStream::~MemoryRawStream() {
+    rdbuf(nullptr);
+}
+
+const std::vector<MemoryRawStream::Buffer> &MemoryRawStream::get_buffers() const {
+    return buffers_;
+}
+
+size_t MemoryRawStream::size() const {
+    return streambuf_->size();
+}
+
+const std::shared_ptr<const void> &MemoryRawStream::get_owner() const {
+    return owner_;
+}
+
+} // namespace Metavision
@@ -0,0 +1,543 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <list>
+#include <mutex>
+#include <sstream>
+#include <streambuf>
+#include <thread>
+
+#include "metavision/hal/utils/network_raw_stream.h"
+#include "metavision/hal/utils/hal_error_code.h"
+#include "metavision/hal/utils/hal_exception.h"
+#include "metavision/hal/utils/hal_log.h"
+#include "metavision/hal/utils/raw_file_header.h"
+
+namespace Metavision {
+
+namespace {
+
+#ifdef _WIN32
+using Socket                   = SOCKET;
+constexpr Socket InvalidSocket = INVALID_SOCKET;
+constexpr int SendFlags        = 0;
+#else
+using Socket                   = int;
+constexpr Socket InvalidSocket = -1;
+#ifdef MSG_NOSIGNAL
+// A client closing its connection must not kill the server with SIGPIPE
+constexpr int SendFlags = MSG_NOSIGNAL;
+#else
+constexpr int SendFlags = 0;
+#endif
+#ifdef IOV_MAX
+constexpr size_t MaxIovecs = IOV_MAX;
+#else
+constexpr size_t MaxIovecs = 16;
+#endif
+#endif
+
+// Sent by the server before the header of the RAW data
+struct Preamble {
+    char magic_[4];
+    uint8_t version_;
+    uint8_t compression_;
+    uint16_t reserved_;
+    uint32_t header_size_;
+};
+
+constexpr char Magic[4]          = {'M', 'V', 'R', 'S'};
+constexpr uint8_t Version        = 1;
+constexpr uint32_t MaxHeaderSize = 1024 * 1024;
+constexpr int SocketBufferSize   = 4 * 1024 * 1024;
+constexpr int PollPeriodMs       = 100;
+
+void init_sockets() {
+#ifdef _WIN32
+    static struct WinsockInitializer {
+        WinsockInitializer() {
+            WSADATA data;
+            WSAStartup(MAKEWORD(2, 2), &data);
+        }
+    } initializer;
+#endif
+}
+
+void close_socket(Socket socket) {
+#ifdef _WIN32
+    closesocket(socket);
+#else
+    close(socket);
+#endif
+}
+
+// Interrupts the blocking calls on the socket, which is still to be closed
+void shutdown_socket(Socket socket) {
+#ifdef _WIN32
+    shutdown(socket, SD_BOTH);
+#else
+    shutdown(socket, SHUT_RDWR);
+#endif
+}
+
+// Returns > 0 if the socket can be read (or is closed), 0 on timeout, < 0 on error
+int wait_readable(Socket socket, int timeout_ms) {
+#ifdef _WIN32
+    WSAPOLLFD fd = {socket, POLLRDNORM, 0};
+    return WSAPoll(&fd, 1, timeout_ms);
+#else
+    pollfd fd = {socket, POLLIN, 0};
+    return poll(&fd, 1, timeout_ms);
+#endif
+}
+
+bool recv_all(Socket socket, uint8_t *data, size_t size) {
+    while (size > 0) {
+        const int chunk_size = static_cast<int>(std::min<size_t>(size, 1 << 30));
+        const auto received  = recv(socket, reinterpret_cast<char *>(data), chunk_size, 0);
+        if (received < 0 && errno == EINTR) {
+            continue;
+        }
+        if (received <= 0) {
+            return false;
+        }
+        data += received;
+        size -= received;
+    }
+    return true;
+}
+
+// Sends several buffers in as few system calls as possible
+bool send_all(Socket socket, const std::vector<std::pair<const uint8_t *, size_t>> &buffers) {
+#ifdef _WIN32
+    std::vector<WSABUF> wsa_buffers;
+    for (auto &buffer : buffers) {
+        CHAR *data = reinterpret_cast<CHAR *>(const_cast<uint8_t *>(buffer.first));
+        wsa_buffers.push_back({static_cast<ULONG>(buffer.second), data});
+    }
+    // A blocking WSASend only returns once all the data has been sent
+    DWORD sent = 0;
+    return WSASend(socket, wsa_buffers.data(), static_cast<DWORD>(wsa_buffers.size()), &sent, 0, NULL, NULL) == 0;
+#else
+    std::vector<iovec> iovecs;
+    for (auto &buffer : buffers) {
+        iovecs.push_back({const_cast<uint8_t *>(buffer.first), buffer.second});
+    }
+    size_t first = 0;
+    while (first < iovecs.size()) {
+        msghdr message{};
+        message.msg_iov    = &iovecs[first];
+        message.msg_iovlen = std::min(iovecs.size() - first, MaxIovecs);
+        auto sent          = sendmsg(socket, &message, SendFlags);
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        // Skips what has been sent, which may end in the middle of a buffer
+        while (first < iovecs.size() && static_cast<size_t>(sent) >= iovecs[first].iov_len) {
+            sent -= iovecs[first].iov_len;
+            ++first;
+        }
+        if (first < iovecs.size()) {
+            iovecs[first].iov_base = static_cast<uint8_t *>(iovecs[first].iov_base) + sent;
+            iovecs[first].iov_len -= sent;
+        }
+    }
+    return true;
+#endif
+}
+
+void set_socket_option(Socket socket, int level, int option, int value) {
+    setsockopt(socket, level, option, reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+} // namespace
+
+// The data is queued for each client as frames shared between the clients, and sent by the thread of the client
+class NetworkRawStreamServer::Private {
+public:
+    using Frame = std::shared_ptr<const std::vector<uint8_t>>;
+
+    struct Client {
+        Socket socket;
+        std::mutex mutex;
+        std::condition_variable cond;
+        std::deque<Frame> frames;
+        size_t queued_bytes = 0;
+        bool closing        = false; // Set when the server stops: the frames queued are sent before closing
+        bool closed         = false; // Set when the connection is lost or the client is too slow
+        bool finished       = false; // Set when the thread of the client is done with the socket
+        std::thread thread;
+    };
+
+    Private(uint16_t port, const std::string &header, const NetworkRawStreamServerConfig &config) : config_(config) {
+        if (config_.max_batch_buffers_ == 0) {
+            throw HalException(HalErrorCode::InvalidArgument, "At least one buffer must be sent at once.");
+        }
+        init_sockets();
+
+        Preamble preamble;
+        std::memcpy(preamble.magic_, Magic, sizeof(Magic));
+        preamble.version_     = Version;
+        preamble.compression_ = static_cast<uint8_t>(config_.compression_);
+        preamble.reserved_    = 0;
+        preamble.header_size_ = static_cast<uint32_t>(header.size());
+        auto first_frame      = std::make_shared<std::vector<uint8_t>>(sizeof(preamble) + header.size());
+        std::memcpy(first_frame->data(), &preamble, sizeof(preamble));
+        std::memcpy(first_frame->data() + sizeof(preamble), header.data(), header.size());
+        first_frame_ = first_frame;
+
+        listen_socket_ = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        if (listen_socket_ == InvalidSocket) {
+            throw HalException(HalErrorCode::FailedInitialization, "Unable to create a socket.");
+        }
+        set_socket_option(listen_socket_, SOL_SOCKET, SO_REUSEADDR, 1);
+        sockaddr_in address{};
+        address.sin_family      = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_ANY);
+        address.sin_port        = htons(port);
+        socklen_t address_size  = sizeof(address);
+        if (bind(listen_socket_, reinterpret_cast<sockaddr *>(&address), address_size) != 0 ||
+            listen(listen_socket_, SOMAXCONN) != 0 ||
+            getsockname(listen_socket_, reinterpret_cast<sockaddr *>(&address), &address_size) != 0) {
+            close_socket(listen_socket_);
+            throw HalException(HalErrorCode::FailedInitialization,
+                               "Unable to listen on port " + std::to_string(port) + ".");
+        }
+        port_ = ntohs(address.sin_port);
+
+        accept_thread_ = std::thread([this]() { accept_clients(); });
+    }
+
+    ~Private() {
+        stop_ = true;
+        accept_thread_.join();
+        close_socket(listen_socket_);
+
+        std::lock_guard<std::mutex> lock(clients_mutex_);
+        for (auto &client : clients_) {
+            {
+                std::lock_guard<std::mutex> client_lock(client->mutex);
+                client->closing = true;
+                client->cond.notify_all();
+            }
+            client->thread.join();
+        }
+    }
+
+    void send(const uint8_t *data, size_t size) {
+        if (size == 0) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(clients_mutex_);
+        remove_closed_clients();
+        if (clients_.empty()) {
+            return;
+        }
+
+        // The data is compressed once for all the clients
+        auto frame = std::make_shared<std::vector<uint8_t>>();
+        compress_raw_chunk(data, size, config_.compression_, *frame);
+        for (auto &client : clients_) {
+            std::lock_guard<std::mutex> client_lock(client->mutex);
+            if (client->closed) {
+                continue;
+            }
+            if (client->queued_bytes + frame->size() > config_.max_queued_bytes_) {
+                MV_HAL_LOG_WARNING() << "Disconnecting a client of the RAW stream server, which is too slow to receive "
+                                        "the data";
+                // The thread of the client may be blocked sending data the client does not read
+                shutdown_socket(client->socket);
+                client->closed = true;
+                client->frames.clear();
+                client->cond.notify_all();
+                continue;
+            }
+            client->frames.push_back(frame);
+            client->queued_bytes += frame->size();
+            client->cond.notify_all();
+        }
+    }
+
+    size_t get_n_clients() {
+        std::lock_guard<std::mutex> lock(clients_mutex_);
+        remove_closed_clients();
+        return std::count_if(clients_.begin(), clients_.end(), [](const std::shared_ptr<Client> &client) {
+            std::lock_guard<std::mutex> client_lock(client->mutex);
+            return !client->closed;
+        });
+    }
+
+    uint16_t port_;
+
+private:
+    void accept_clients() {
+        while (!stop_) {
+            // Polls, so that the stop of the server is noticed
+            if (wait_readable(listen_socket_, PollPeriodMs) <= 0) {
+                continue;
+            }
+            Socket client_socket = accept(listen_socket_, nullptr, nullptr);
+            if (client_socket == InvalidSocket) {
+                continue;
+            }
+            set_socket_option(client_socket, IPPROTO_TCP, TCP_NODELAY, 1);
+            set_socket_option(client_socket, SOL_SOCKET, SO_SNDBUF, SocketBufferSize);
+
+            auto client    = std::make_shared<Client>();
+            client->socket = client_socket;
+            client->frames.push_back(first_frame_);
+            client->queued_bytes = first_frame_->size();
+            client->thread       = std::thread([client, this]() { send_frames(*client); });
+
+            std::lock_guard<std::mutex> lock(clients_mutex_);
+            clients_.push_back(client);
+        }
+    }
+
+    void send_frames(Client &client) {
+        std::vector<Frame> batch;
+        std::vector<std::pair<const uint8_t *, size_t>> buffers;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(client.mutex);
+                client.cond.wait(lock,
+                                 [&client]() { return !client.frames.empty() || client.closing || client.closed; });
+                if (client.closed || (client.frames.empty() && client.closing)) {
+                    break;
+                }
+                while (!client.frames.empty() && batch.size() < config_.max_batch_buffers_) {
+                    client.queued_bytes -= client.frames.front()->size();
+                    batch.push_back(std::move(client.frames.front()));
+                    client.frames.pop_front();
+                }
+            }
+
+            buffers.clear();
+            for (auto &frame : batch) {
+                buffers.emplace_back(frame->data(), frame->size());
+            }
+            const bool sent = send_all(client.socket, buffers);
+            batch.clear();
+            if (!sent) {
+                std::lock_guard<std::mutex> lock(client.mutex);
+                client.closed = true;
+                client.frames.clear();
+                break;
+            }
+        }
+        close_socket(client.socket);
+
+        std::lock_guard<std::mutex> lock(client.mutex);
+        client.finished = true;
+    }
+
+    // Removes the clients whose thread is done, so that the caller is never blocked by a client still sending data.
+    // Must be called with clients_mutex_ locked
+    void remove_closed_clients() {
+        for (auto it = clients_.begin(); it != clients_.end();) {
+            bool finished;
+            {
+                std::lock_guard<std::mutex> client_lock((*it)->mutex);
+                finished = (*it)->closed && (*it)->finished;
+            }
+            if (finished) {
+                (*it)->thread.join();
+                it = clients_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    const NetworkRawStreamServerConfig config_;
+    Frame first_frame_;
+    Socket listen_socket_;
+    std::atomic<bool> stop_{false};
+    std::thread accept_thread_;
+    std::list<std::shared_ptr<Client>> clients_;
+    std::mutex clients_mutex_;
+};
+
+NetworkRawStreamServer::NetworkRawStreamServer(uint16_t port, const std::string &header,
+                                               const NetworkRawStreamServerConfig &config) :
+    pimpl_(new Private(port, header, config)) {}
+
+NetworkRawStreamServer::~NetworkRawStreamServer() {}
+
+uint16_t NetworkRawStreamServer::get_port() const {
+    return pimpl_->port_;
+}
+
+size_t NetworkRawStreamServer::get_n_clients() const {
+    return pimpl_->get_n_clients();
+}
+
+void NetworkRawStreamServer::send(const uint8_t *data, size_t size) {
+    pimpl_->send(data, size);
+}
+
+// Stream buffer whose content is the header of the RAW data followed by the chunks received, once decompressed
+class NetworkRawStream::SocketBuffer : public std::streambuf {
+public:
+    SocketBuffer(const std::string &host, uint16_t port) {
+        init_sockets();
+
+        addrinfo hints{};
+        hints.ai_family       = AF_UNSPEC;
+        hints.ai_socktype     = SOCK_STREAM;
+        hints.ai_protocol     = IPPROTO_TCP;
+        addrinfo *addresses   = nullptr;
+        const std::string url = host + ":" + std::to_string(port);
+        if (getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &addresses) != 0) {
+            throw HalException(HalErrorCode::CameraNotFound, "Unable to resolve '" + host + "'.");
+        }
+        for (addrinfo *address = addresses; address && socket_ == InvalidSocket; address = address->ai_next) {
+            socket_ = socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+            if (socket_ != InvalidSocket &&
+                connect(socket_, address->ai_addr, static_cast<socklen_t>(address->ai_addrlen)) != 0) {
+                close_socket(socket_);
+                socket_ = InvalidSocket;
+            }
+        }
+        freeaddrinfo(addresses);
+        if (socket_ == InvalidSocket) {
+            throw HalException(HalErrorCode::CameraNotFound, "Unable to connect to '" + url + "'.");
+        }
+        set_socket_option(socket_, SOL_SOCKET, SO_RCVBUF, SocketBufferSize);
+
+        Preamble preamble;
+        if (!recv_all(socket_, reinterpret_cast<uint8_t *>(&preamble), sizeof(preamble)) ||
+            std::memcmp(preamble.magic_, Magic, sizeof(Magic)) != 0 || preamble.version_ != Version ||
+            preamble.compression_ > static_cast<uint8_t>(RawCompression::LZ4) ||
+            preamble.header_size_ > MaxHeaderSize) {
+            close_socket(socket_);
+            throw HalException(HalErrorCode::FailedInitialization, "'" + url + "' does not stream RAW data.");
+        }
+        compression_ = static_cast<RawCompression>(preamble.compression_);
+        std::vector<uint8_t> header(preamble.header_size_);
+        if (!recv_all(socket_, header.data(), header.size())) {
+            close_socket(socket_);
+            throw HalException(HalErrorCode::FailedInitialization, "Connection to '" + url + "' lost.");
+        }
+
+        // The data read from the stream is decompressed, which must not be recorded in its header
+        std::istringstream header_stream(std::string(header.begin(), header.end()));
+        RawFileHeader raw_header(header_stream);
+        set_raw_file_compression(raw_header, RawCompression::None, 0);
+        std::ostringstream output_header_stream;
+        output_header_stream << raw_header;
+        header_ = output_header_stream.str();
+        setg(&header_[0], &header_[0], &header_[0] + header_.size());
+    }
+
+    ~SocketBuffer() {
+        close_socket(socket_);
+    }
+
+    bool wait_for_data(std::chrono::milliseconds timeout) {
+        return closed_ || wait_readable(socket_, static_cast<int>(timeout.count())) != 0;
+    }
+
+    bool read_chunk(DataTransfer::Buffer &buffer) {
+        CompressedRawChunkHeader header;
+        if (closed_ || !recv_all(socket_, reinterpret_cast<uint8_t *>(&header), sizeof(header))) {
+            closed_ = true;
+            return false;
+        }
+
+        buffer.resize(header.raw_size_);
+        if (header.compressed_size_ == header.raw_size_) {
+            // Data stored uncompressed is received directly in the buffer
+            closed_ = !recv_all(socket_, buffer.data(), buffer.size());
+        } else {
+            compressed_.resize(header.compressed_size_);
+            closed_ = !recv_all(socket_, compressed_.data(), compressed_.size()) ||
+                      !decompress_raw_chunk(header, compressed_.data(), compression_, buffer.data());
+        }
+        if (closed_) {
+            buffer.clear();
+        }
+        return !closed_;
+    }
+
+    void take_pending_data(DataTransfer::Buffer &buffer) {
+        buffer.assign(gptr(), egptr());
+        setg(nullptr, nullptr, nullptr);
+    }
+
+protected:
+    int_type underflow() override {
+        if (gptr() < egptr()) {
+            return traits_type::to_int_type(*gptr());
+        }
+        // Skips empty chunks, if any
+        while (read_chunk(chunk_)) {
+            if (!chunk_.empty()) {
+                char *begin = reinterpret_cast<char *>(chunk_.data());
+                setg(begin, begin, begin + chunk_.size());
+                return traits_type::to_int_type(*gptr());
+            }
+        }
+        setg(nullptr, nullptr, nullptr);
+        return traits_type::eof();
+    }
+
+private:
+    Socket socket_ = InvalidSocket;
+    RawCompression compression_;
+    std::string header_;
+    DataTransfer::Buffer chunk_;
+    std::vector<uint8_t> compressed_;
+    bool closed_ = false;
+};
+
+NetworkRawStream::NetworkRawStream(const std::string &host, uint16_t port) :
+    std::istream(nullptr), buffer_(new SocketBuffer(host, port)) {
+    rdbuf(buffer_.get());
+}
+
+NetworkRawStream::~NetworkRawStream() {}
+
+bool NetworkRawStream::wait_for_data(std::chrono::milliseconds timeout) {
+    return buffer_->wait_for_data(timeout);
+}
+
+bool NetworkRawStream::read_chunk(DataTransfer::Buffer &buffer) {
+    return buffer_->read_chunk(buffer);
+}
+
+void NetworkRawStream::take_pending_data(DataTransfer::Buffer &buffer) {
+    buffer_->take_pending_data(buffer);
+}
+
+} // namespace Metavision
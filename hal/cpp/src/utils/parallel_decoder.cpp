@@ -0,0 +1,177 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <deque>
+#include <future>
+#include <thread>
+#include <vector>
+
+#include "metavision/hal/utils/parallel_decoder.h"
+
+namespace Metavision {
+
+struct ParallelDecoder::DecodedChunk {
+    // Resync point at which the chunk starts
+    I_Decoder::RawData *begin;
+    std::vector<EventCD> cds;
+    std::vector<EventExtTrigger> triggers;
+    // Timestamp of the last event, in the time reference of the decoder of the chunk
+    timestamp last_timestamp;
+};
+
+namespace {
+
+// Decoder collecting the events of a chunk, or nullptr if the events of this type are not requested
+template<typename Event>
+std::shared_ptr<I_EventDecoder<Event>> make_collector(const std::shared_ptr<I_EventDecoder<Event>> &event_decoder,
+                                                      std::vector<Event> &events) {
+    if (!event_decoder) {
+        return std::shared_ptr<I_EventDecoder<Event>>();
+    }
+    auto collector = std::make_shared<I_EventDecoder<Event>>();
+    collector->add_event_buffer_callback(
+        [&events](const Event *begin, const Event *end) { events.insert(events.end(), begin, end); });
+    return collector;
+}
+
+template<typename Event>
+void shift_and_forward(std::vector<Event> &events, timestamp offset, I_EventDecoder<Event> *event_decoder) {
+    if (!event_decoder || events.empty()) {
+        return;
+    }
+    if (offset != 0) {
+        for (auto &ev : events) {
+            ev.t += offset;
+        }
+    }
+    event_decoder->add_event_buffer(events.data(), events.data() + events.size());
+}
+
+} // namespace
+
+constexpr size_t ParallelDecoder::DefaultChunkSize;
+
+ParallelDecoder::ParallelDecoder(const DecoderFactory &decoder_factory, bool time_shifting_enabled,
+                                 const std::shared_ptr<I_EventDecoder<EventCD>> &event_cd_decoder,
+                                 const std::shared_ptr<I_EventDecoder<EventExtTrigger>> &event_ext_trigger_decoder,
+                                 uint32_t n_threads, size_t chunk_size) :
+    decoder_factory_(decoder_factory),
+    time_shifting_enabled_(time_shifting_enabled),
+    cd_event_decoder_(event_cd_decoder),
+    ext_trigger_event_decoder_(event_ext_trigger_decoder),
+    n_threads_(n_threads != 0 ? n_threads : std::max(1u, std::thread::hardware_concurrency())) {
+    probe_decoder_ = decoder_factory_(false, std::shared_ptr<I_EventDecoder<EventCD>>(),
+                                      std::shared_ptr<I_EventDecoder<EventExtTrigger>>());
+    if (!probe_decoder_->reset_last_timestamp(0)) {
+        sequential_decoder_ = decoder_factory_(time_shifting_enabled_, cd_event_decoder_, ext_trigger_event_decoder_);
+    }
+
+    // The chunks must start on raw event boundaries
+    const size_t raw_event_size = probe_decoder_->get_raw_event_size_bytes();
+    chunk_size_                 = std::max(raw_event_size, (chunk_size / raw_event_size) * raw_event_size);
+}
+
+ParallelDecoder::~ParallelDecoder() {}
+
+void ParallelDecoder::decode(I_Decoder::RawData *raw_data_begin, I_Decoder::RawData *raw_data_end) {
+    if (sequential_decoder_) {
+        sequential_decoder_->decode(raw_data_begin, raw_data_end);
+        last_timestamp_ = sequential_decoder_->get_last_timestamp();
+        return;
+    }
+
+    // Returns the first resync point at or after the given position
+    auto find_resync_point = [this, raw_data_begin, raw_data_end](I_Decoder::RawData *from) {
+        return raw_data_begin + (probe_decoder_->find_resync_point(from, raw_data_end) - raw_data_begin);
+    };
+
+    I_Decoder::RawData *chunk_begin = find_resync_point(raw_data_begin);
+    std::deque<std::future<std::unique_ptr<DecodedChunk>>> pending_chunks;
+
+    auto launch_next_chunk = [&]() {
+        I_Decoder::RawData *chunk_end = static_cast<size_t>(raw_data_end - chunk_begin) > chunk_size_ ?
+                                            find_resync_point(chunk_begin + chunk_size_) :
+                                            raw_data_end;
+
+        // The decoders are created here so that the factory is only called from this thread
+        std::unique_ptr<DecodedChunk> chunk(new DecodedChunk);
+        chunk->begin = chunk_begin;
+        std::unique_ptr<I_Decoder> decoder =
+            decoder_factory_(false, make_collector(cd_event_decoder_, chunk->cds),
+                             make_collector(ext_trigger_event_decoder_, chunk->triggers));
+
+        pending_chunks.push_back(std::async(
+            std::launch::async,
+            [chunk_end](std::unique_ptr<DecodedChunk> chunk, std::unique_ptr<I_Decoder> decoder) {
+                decoder->decode(chunk->begin, chunk_end);
+                chunk->last_timestamp = decoder->get_last_timestamp();
+                return chunk;
+            },
+            std::move(chunk), std::move(decoder)));
+        chunk_begin = chunk_end;
+    };
+
+    while (true) {
+        while (chunk_begin != raw_data_end && pending_chunks.size() < n_threads_) {
+            launch_next_chunk();
+        }
+        if (pending_chunks.empty()) {
+            break;
+        }
+
+        std::unique_ptr<DecodedChunk> chunk = pending_chunks.front().get();
+        pending_chunks.pop_front();
+        // Keeps the workers busy while the events of this chunk are forwarded
+        if (chunk_begin != raw_data_end) {
+            launch_next_chunk();
+        }
+        forward(*chunk);
+    }
+}
+
+void ParallelDecoder::forward(DecodedChunk &chunk) {
+    // The chunk has been decoded from its resync point without knowing the previous data: computes the time of this
+    // resync point in both the time reference of the chunk and the one of the stream to get the offset between them
+    I_Decoder::RawData *resync_end = chunk.begin + probe_decoder_->get_raw_event_size_bytes();
+    probe_decoder_->reset_last_timestamp(0);
+    probe_decoder_->decode(chunk.begin, resync_end);
+    const timestamp chunk_time = probe_decoder_->get_last_timestamp();
+
+    timestamp stream_time = chunk_time;
+    if (!time_reference_set_) {
+        time_shift_         = time_shifting_enabled_ ? chunk_time : 0;
+        time_reference_set_ = true;
+    } else {
+        probe_decoder_->reset_last_timestamp(last_timestamp_ + time_shift_);
+        probe_decoder_->decode(chunk.begin, resync_end);
+        stream_time = probe_decoder_->get_last_timestamp();
+    }
+
+    const timestamp offset = stream_time - chunk_time - time_shift_;
+    shift_and_forward(chunk.cds, offset, cd_event_decoder_.get());
+    shift_and_forward(chunk.triggers, offset, ext_trigger_event_decoder_.get());
+    last_timestamp_ = chunk.last_timestamp + offset;
+}
+
+timestamp ParallelDecoder::get_last_timestamp() const {
+    return last_timestamp_;
+}
+
+bool ParallelDecoder::is_parallel() const {
+    return !sequential_decoder_;
+}
+
+uint32_t ParallelDecoder::get_n_threads() const {
+    return n_threads_;
+}
+
+} // namespace Metavision
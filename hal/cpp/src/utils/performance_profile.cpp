@@ -0,0 +1,66 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include "metavision/hal/device/device.h"
+#include "metavision/hal/facilities/i_decoder.h"
+#include "metavision/hal/facilities/i_events_stream.h"
+#include "metavision/hal/utils/hal_exception.h"
+#include "metavision/hal/utils/performance_profile.h"
+
+namespace Metavision {
+
+PerformanceSettings get_performance_settings(PerformanceProfile profile) {
+    PerformanceSettings settings;
+    switch (profile) {
+    case PerformanceProfile::LowLatency:
+        settings.n_events_to_read         = 16384;
+        settings.n_read_buffers           = 8;
+        settings.cd_event_buffer_size     = 320;
+        settings.handoff_capacity         = 64;
+        settings.handoff_spin_count       = 20000;
+        settings.replay_batch_duration_us = 250;
+        settings.buffer_time_slice_us     = 250;
+        break;
+    case PerformanceProfile::Balanced:
+        settings.n_events_to_read         = 1000000;
+        settings.n_read_buffers           = 3;
+        settings.cd_event_buffer_size     = 320;
+        settings.handoff_capacity         = 0;
+        settings.handoff_spin_count       = 0;
+        settings.replay_batch_duration_us = 1000;
+        settings.buffer_time_slice_us     = 1000;
+        break;
+    case PerformanceProfile::HighThroughput:
+        settings.n_events_to_read         = 4000000;
+        settings.n_read_buffers           = 3;
+        settings.cd_event_buffer_size     = 16384;
+        settings.handoff_capacity         = 0;
+        settings.handoff_spin_count       = 0;
+        settings.replay_batch_duration_us = 10000;
+        settings.buffer_time_slice_us     = 10000;
+        break;
+    default:
+        throw HalException(HalErrorCode::InvalidArgument, "Unknown performance profile.");
+    }
+    return settings;
+}
+
+void apply_performance_profile(Device &device, PerformanceProfile profile) {
+    const PerformanceSettings settings = get_performance_settings(profile);
+    if (auto *decoder = device.get_facility<I_Decoder>()) {
+        decoder->set_cd_event_buffer_size(settings.cd_event_buffer_size);
+    }
+    if (auto *events_stream = device.get_facility<I_EventsStream>()) {
+        events_stream->set_lock_free_handoff(settings.handoff_capacity, settings.handoff_spin_count);
+    }
+}
+
+} // namespace Metavision
@@ -0,0 +1,123 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "metavision/hal/utils/ranged_read_backend.h"
+#include "metavision/hal/utils/hal_log.h"
+#include "metavision/hal/utils/http_range_backend.h"
+
+namespace Metavision {
+
+bool RangedReadBackend::is_remote(const std::string &location) {
+    return location.compare(0, 7, "http://") == 0 || location.compare(0, 5, "s3://") == 0;
+}
+
+std::unique_ptr<RangedReadBackend> RangedReadBackend::open(const std::string &location) {
+    if (is_remote(location)) {
+        return std::make_unique<HttpRangeBackend>(location);
+    }
+    return std::make_unique<LocalFileBackend>(location);
+}
+
+LocalFileBackend::LocalFileBackend(const std::string &filename) : filename_(filename) {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    LARGE_INTEGER file_size;
+    if (file != INVALID_HANDLE_VALUE && GetFileSizeEx(file, &file_size)) {
+        file_      = file;
+        file_size_ = static_cast<uint64_t>(file_size.QuadPart);
+    } else if (file != INVALID_HANDLE_VALUE) {
+        CloseHandle(file);
+    }
+#else
+    fd_ = ::open(filename.c_str(), O_RDONLY);
+    struct stat file_stat;
+    if (fd_ >= 0 && fstat(fd_, &file_stat) == 0) {
+        file_size_ = static_cast<uint64_t>(file_stat.st_size);
+#ifdef POSIX_FADV_SEQUENTIAL
+        posix_fadvise(fd_, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+    }
+#endif
+}
+
+LocalFileBackend::~LocalFileBackend() {
+#ifdef _WIN32
+    if (file_) {
+        CloseHandle(file_);
+    }
+#else
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+#endif
+}
+
+const std::string &LocalFileBackend::get_location() const {
+    return filename_;
+}
+
+bool LocalFileBackend::is_open() const {
+#ifdef _WIN32
+    return file_ != nullptr;
+#else
+    return fd_ >= 0;
+#endif
+}
+
+uint64_t LocalFileBackend::get_size() const {
+    return file_size_;
+}
+
+int64_t LocalFileBackend::read_at(uint8_t *data, uint64_t offset, size_t size) {
+    size_t n_read = 0;
+    while (n_read < size) {
+#ifdef _WIN32
+        if (!file_) {
+            return -1;
+        }
+        OVERLAPPED overlapped = {};
+        const uint64_t pos    = offset + n_read;
+        overlapped.Offset     = static_cast<DWORD>(pos & 0xFFFFFFFF);
+        overlapped.OffsetHigh = static_cast<DWORD>(pos >> 32);
+        DWORD n               = 0;
+        if (!ReadFile(file_, data + n_read, static_cast<DWORD>(size - n_read), &n, &overlapped) &&
+            GetLastError() != ERROR_HANDLE_EOF) {
+            MV_HAL_LOG_ERROR() << "Failed to read file" << filename_;
+            return -1;
+        }
+#else
+        if (fd_ < 0) {
+            return -1;
+        }
+        const ssize_t n = pread(fd_, data + n_read, size - n_read, static_cast<off_t>(offset + n_read));
+        if (n < 0) {
+            MV_HAL_LOG_ERROR() << "Failed to read file" << filename_;
+            return -1;
+        }
+#endif
+        if (n == 0) {
+            break;
+        }
+        n_read += n;
+    }
+    return static_cast<int64_t>(n_read);
+}
+
+} // namespace Metavision
@@ -0,0 +1,282 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <cstring>
+
+#include "metavision/hal/decoders/detail/evt2_raw_format.h"
+#include "metavision/hal/decoders/detail/evt3_raw_format.h"
+#include "metavision/hal/utils/hal_exception.h"
+#include "metavision/hal/utils/raw_event_encoder.h"
+#include "metavision/hal/utils/raw_file_header.h"
+
+namespace Metavision {
+
+namespace {
+
+template<typename Word>
+void append_words(const Word *words, size_t n, std::vector<uint8_t> &output) {
+    const size_t offset = output.size();
+    output.resize(offset + n * sizeof(Word));
+    std::memcpy(output.data() + offset, words, n * sizeof(Word));
+}
+
+// Encodes the time highs of a stream, as well as the wrap arounds of their counter between distant timestamps, so that
+// the decoders keep counting its loops
+template<typename Word, int TimeLowBits, timestamp TimeHighMask, typename MakeWord>
+class TimeHighEncoder {
+public:
+    TimeHighEncoder(const MakeWord &make_word) : make_word_(make_word) {}
+
+    // Encodes the time highs up to the one of a timestamp, returns false if it was already encoded
+    bool update(timestamp t, std::vector<Word> &words) {
+        const timestamp time_high = t >> TimeLowBits;
+        if (has_time_high_ && time_high == time_high_) {
+            return false;
+        }
+        if (has_time_high_) {
+            // The decoders detect that the counter wrapped around from its last value to its first ones only
+            for (timestamp loop_begin = (time_high_ | TimeHighMask) + 1; loop_begin <= time_high;
+                 loop_begin += TimeHighMask + 1) {
+                if (loop_begin - 1 != time_high_) {
+                    words.push_back(make_word_(TimeHighMask));
+                }
+                if (loop_begin != time_high) {
+                    words.push_back(make_word_(0));
+                }
+            }
+        }
+        words.push_back(make_word_(time_high & TimeHighMask));
+        time_high_     = time_high;
+        has_time_high_ = true;
+        return true;
+    }
+
+    timestamp time_high() const {
+        return time_high_;
+    }
+
+    void reset() {
+        has_time_high_ = false;
+    }
+
+private:
+    MakeWord make_word_;
+    bool has_time_high_  = false;
+    timestamp time_high_ = 0;
+};
+
+struct Evt2TimeHighWord {
+    Evt2::RawWord operator()(timestamp time_high) const {
+        return (static_cast<Evt2::RawWord>(Evt2::EventTypes::EVT_TIME_HIGH) << Evt2::TypeShift) |
+               static_cast<Evt2::RawWord>(time_high);
+    }
+};
+
+inline Evt3::RawWord make_evt3_word(Evt3::EventTypes type, uint16_t payload) {
+    return static_cast<Evt3::RawWord>((static_cast<Evt3::RawWord>(type) << Evt3::TypeShift) | payload);
+}
+
+struct Evt3TimeHighWord {
+    Evt3::RawWord operator()(timestamp time_high) const {
+        return make_evt3_word(Evt3::EventTypes::EVT_TIME_HIGH, static_cast<uint16_t>(time_high));
+    }
+};
+
+class EVT2Encoder : public RawEventEncoder {
+public:
+    std::string get_format() const override {
+        return "EVT2";
+    }
+
+    uint8_t get_raw_event_size_bytes() const override {
+        return sizeof(Evt2::RawWord);
+    }
+
+private:
+    void encode_cd(const EventCD *begin, const EventCD *end, std::vector<uint8_t> &output) override {
+        while (begin != end) {
+            words_.clear();
+            time_high_.update(begin->t, words_);
+
+            // The events sharing the time high are encoded in a loop without branch, vectorized by the compiler
+            const timestamp run_last_t = ((time_high_.time_high() + 1) << Evt2::TimestampLsbBits) - 1;
+            const EventCD *run_end     = std::upper_bound(begin, end, run_last_t,
+                                                          [](timestamp t, const EventCD &ev) { return t < ev.t; });
+            const size_t offset        = words_.size();
+            const size_t n             = run_end - begin;
+            words_.resize(offset + n);
+            Evt2::RawWord *words        = words_.data() + offset;
+            const Evt2::RawWord cd_type = static_cast<Evt2::RawWord>(Evt2::EventTypes::CD_LOW);
+            for (size_t i = 0; i < n; ++i) {
+                const EventCD &ev        = begin[i];
+                const Evt2::RawWord type = static_cast<Evt2::RawWord>(ev.p != 0) | cd_type;
+                words[i] = (type << Evt2::TypeShift) |
+                           ((static_cast<Evt2::RawWord>(ev.t) & Evt2::TsLsbMask) << Evt2::TimestampShift) |
+                           ((static_cast<Evt2::RawWord>(ev.x) & Evt2::CoordMask) << Evt2::XShift) |
+                           (static_cast<Evt2::RawWord>(ev.y) & Evt2::CoordMask);
+            }
+            append_words(words_.data(), words_.size(), output);
+            begin = run_end;
+        }
+    }
+
+    void encode_trigger(const EventExtTrigger &ev, std::vector<uint8_t> &output) override {
+        words_.clear();
+        time_high_.update(ev.t, words_);
+        words_.push_back((static_cast<Evt2::RawWord>(Evt2::EventTypes::EXT_TRIGGER) << Evt2::TypeShift) |
+                         ((static_cast<Evt2::RawWord>(ev.t) & Evt2::TsLsbMask) << Evt2::TimestampShift) |
+                         ((static_cast<Evt2::RawWord>(ev.id) & Evt2::TriggerMask) << Evt2::TriggerIdShift) |
+                         static_cast<Evt2::RawWord>(ev.p != 0));
+        append_words(words_.data(), words_.size(), output);
+    }
+
+    void reset_impl() override {
+        time_high_.reset();
+    }
+
+    TimeHighEncoder<Evt2::RawWord, Evt2::TimestampLsbBits, Evt2::TsMsbMask, Evt2TimeHighWord> time_high_{
+        Evt2TimeHighWord()};
+    std::vector<Evt2::RawWord> words_;
+};
+
+class EVT3Encoder : public RawEventEncoder {
+public:
+    std::string get_format() const override {
+        return "EVT3";
+    }
+
+    uint8_t get_raw_event_size_bytes() const override {
+        return sizeof(Evt3::RawWord);
+    }
+
+private:
+    // Width of the vectors of events encoded by a VECT_12 word
+    static constexpr int VectorSize = 12;
+
+    void encode_cd(const EventCD *begin, const EventCD *end, std::vector<uint8_t> &output) override {
+        words_.clear();
+        for (const EventCD *ev = begin; ev != end;) {
+            update_time(ev->t);
+            if (ev->y != y_) {
+                words_.push_back(make_evt3_word(Evt3::EventTypes::CD_Y, ev->y & Evt3::CoordMask));
+                y_ = ev->y;
+            }
+
+            // The following events of the same time, row and polarity, at increasing abscissas, are encoded as vectors,
+            // as the sensor would do
+            auto in_vector = [ev, end](const EventCD *next, int base) {
+                return next != end && next->t == ev->t && next->y == ev->y && next->p == ev->p &&
+                       next->x > std::prev(next)->x && next->x >= base && next->x < base + VectorSize;
+            };
+            const uint16_t polarity = static_cast<uint16_t>(ev->p != 0) << Evt3::PolarityShift;
+            if (!in_vector(ev + 1, ev->x)) {
+                words_.push_back(make_evt3_word(Evt3::EventTypes::X_POS, polarity | (ev->x & Evt3::CoordMask)));
+                ++ev;
+                continue;
+            }
+            words_.push_back(make_evt3_word(Evt3::EventTypes::X_BASE, polarity | (ev->x & Evt3::CoordMask)));
+            int base            = ev->x;
+            const EventCD *next = ev + 1;
+            uint16_t mask       = 1;
+            while (true) {
+                for (; in_vector(next, base); ++next) {
+                    mask |= 1 << (next->x - base);
+                }
+                words_.push_back(make_evt3_word(Evt3::EventTypes::VECT_12, mask));
+                base += VectorSize;
+                mask = 0;
+                if (!in_vector(next, base)) {
+                    break;
+                }
+            }
+            ev = next;
+        }
+        append_words(words_.data(), words_.size(), output);
+    }
+
+    void encode_trigger(const EventExtTrigger &ev, std::vector<uint8_t> &output) override {
+        words_.clear();
+        update_time(ev.t);
+        words_.push_back(make_evt3_word(Evt3::EventTypes::EXT_TRIGGER,
+                                        ((ev.id & Evt3::TriggerIdMask) << Evt3::TriggerIdShift) | (ev.p != 0)));
+        append_words(words_.data(), words_.size(), output);
+    }
+
+    void reset_impl() override {
+        time_high_.reset();
+        has_time_low_ = false;
+    }
+
+    void update_time(timestamp t) {
+        // A time high is followed by a time low and a row, so that it is a resync point of the stream
+        if (time_high_.update(t, words_) || !has_time_low_ || t != t_) {
+            words_.push_back(make_evt3_word(Evt3::EventTypes::EVT_TIME_LOW, t & Evt3::TimeMask));
+            has_time_low_ = true;
+            t_            = t;
+            y_            = -1;
+        }
+    }
+
+    TimeHighEncoder<Evt3::RawWord, Evt3::TimeLowBits, Evt3::TimeMask, Evt3TimeHighWord> time_high_{Evt3TimeHighWord()};
+    bool has_time_low_ = false;
+    timestamp t_       = 0;
+    int y_             = -1;
+    std::vector<Evt3::RawWord> words_;
+};
+
+} // namespace
+
+std::unique_ptr<RawEventEncoder> RawEventEncoder::create(const std::string &format) {
+    if (format == "EVT2") {
+        return std::unique_ptr<RawEventEncoder>(new EVT2Encoder());
+    }
+    if (format == "EVT3") {
+        return std::unique_ptr<RawEventEncoder>(new EVT3Encoder());
+    }
+    throw HalException(HalErrorCode::InvalidArgument, "Unsupported RAW format for encoding: " + format);
+}
+
+RawEventEncoder::~RawEventEncoder() {}
+
+void RawEventEncoder::set_header_format(RawFileHeader &header) const {
+    const std::string format = header.get_field("format");
+    if (!format.empty()) {
+        // The properties of the format follow its name, separated by semicolons
+        const auto properties = format.find(';');
+        header.set_field("format", get_format() + (properties == std::string::npos ? "" : format.substr(properties)));
+        header.remove_field("evt");
+    } else {
+        header.set_field("evt", get_format().substr(3) + ".0");
+    }
+}
+
+void RawEventEncoder::encode(const EventCD *cd_begin, const EventCD *cd_end, const EventExtTrigger *trigger_begin,
+                             const EventExtTrigger *trigger_end, std::vector<uint8_t> &output) {
+    for (; trigger_begin != trigger_end; ++trigger_begin) {
+        const EventCD *cd_split = std::upper_bound(
+            cd_begin, cd_end, trigger_begin->t, [](timestamp t, const EventCD &ev) { return t < ev.t; });
+        if (cd_split != cd_begin) {
+            encode_cd(cd_begin, cd_split, output);
+            cd_begin = cd_split;
+        }
+        encode_trigger(*trigger_begin, output);
+    }
+    if (cd_begin != cd_end) {
+        encode_cd(cd_begin, cd_end, output);
+    }
+}
+
+void RawEventEncoder::reset() {
+    reset_impl();
+}
+
+} // namespace Metavision
@@ -0,0 +1,270 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <thread>
+#if defined(__SSE4_2__)
+#include <nmmintrin.h>
+#elif defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#endif
+
+#include "metavision/hal/utils/raw_file_checksums.h"
+#include "metavision/hal/utils/hal_error_code.h"
+#include "metavision/hal/utils/hal_exception.h"
+
+namespace Metavision {
+
+namespace {
+
+constexpr char Magic[8]    = {'M', 'V', 'R', 'A', 'W', 'C', 'R', 'C'};
+constexpr uint32_t Version = 1;
+
+template<typename T>
+void write_value(std::ostream &os, const T &value) {
+    os.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template<typename T>
+bool read_value(std::istream &is, T &value) {
+    return static_cast<bool>(is.read(reinterpret_cast<char *>(&value), sizeof(T)));
+}
+
+#if !defined(__SSE4_2__) && !defined(__ARM_FEATURE_CRC32)
+// Tables of the slicing-by-8 implementation: table[k][b] is the CRC of byte b followed by k null bytes
+struct Crc32cTables {
+    Crc32cTables() {
+        constexpr uint32_t Polynomial = 0x82F63B78; // Castagnoli polynomial, reflected
+        for (uint32_t b = 0; b < 256; ++b) {
+            uint32_t crc = b;
+            for (int i = 0; i < 8; ++i) {
+                crc = (crc >> 1) ^ (crc & 1 ? Polynomial : 0);
+            }
+            table[0][b] = crc;
+        }
+        for (uint32_t b = 0; b < 256; ++b) {
+            for (int k = 1; k < 8; ++k) {
+                table[k][b] = (table[k - 1][b] >> 8) ^ table[0][table[k - 1][b] & 0xFF];
+            }
+        }
+    }
+
+    uint32_t table[8][256];
+};
+#endif
+
+// Updates a CRC, before its final inversion, with a buffer
+uint32_t update_crc32c(uint32_t crc, const uint8_t *data, size_t size) {
+#if defined(__SSE4_2__)
+#if defined(__x86_64__) || defined(_M_X64)
+    uint64_t crc64 = crc;
+    for (; size >= 8; size -= 8, data += 8) {
+        uint64_t word;
+        std::memcpy(&word, data, sizeof(word));
+        crc64 = _mm_crc32_u64(crc64, word);
+    }
+    crc = static_cast<uint32_t>(crc64);
+#endif
+    for (; size > 0; --size, ++data) {
+        crc = _mm_crc32_u8(crc, *data);
+    }
+#elif defined(__ARM_FEATURE_CRC32)
+    for (; size >= 8; size -= 8, data += 8) {
+        uint64_t word;
+        std::memcpy(&word, data, sizeof(word));
+        crc = __crc32cd(crc, word);
+    }
+    for (; size > 0; --size, ++data) {
+        crc = __crc32cb(crc, *data);
+    }
+#else
+    static const Crc32cTables tables;
+    const auto &t = tables.table;
+    for (; size >= 8; size -= 8, data += 8) {
+        const uint32_t low  = crc ^ (uint32_t(data[0]) | uint32_t(data[1]) << 8 | uint32_t(data[2]) << 16 |
+                                    uint32_t(data[3]) << 24);
+        const uint32_t high = uint32_t(data[4]) | uint32_t(data[5]) << 8 | uint32_t(data[6]) << 16 |
+                              uint32_t(data[7]) << 24;
+        crc = t[7][low & 0xFF] ^ t[6][(low >> 8) & 0xFF] ^ t[5][(low >> 16) & 0xFF] ^ t[4][low >> 24] ^
+              t[3][high & 0xFF] ^ t[2][(high >> 8) & 0xFF] ^ t[1][(high >> 16) & 0xFF] ^ t[0][high >> 24];
+    }
+    for (; size > 0; --size, ++data) {
+        crc = (crc >> 8) ^ t[0][(crc ^ *data) & 0xFF];
+    }
+#endif
+    return crc;
+}
+
+} // namespace
+
+uint32_t crc32c(const void *data, size_t size, uint32_t crc) {
+    return ~update_crc32c(~crc, static_cast<const uint8_t *>(data), size);
+}
+
+constexpr uint64_t RawFileChecksums::DefaultChunkSize;
+
+RawFileChecksums::RawFileChecksums(uint64_t chunk_size) : chunk_size_(std::max<uint64_t>(chunk_size, 1)) {}
+
+RawFileChecksums RawFileChecksums::compute(const std::string &raw_file, uint64_t chunk_size) {
+    std::ifstream ifs(raw_file, std::ios::binary);
+    if (!ifs) {
+        throw HalException(HalErrorCode::FailedInitialization, "Unable to open RAW file '" + raw_file + "'");
+    }
+    RawFileChecksums checksums(chunk_size);
+    std::vector<char> buffer(static_cast<size_t>(std::min<uint64_t>(checksums.chunk_size_, 1024 * 1024)));
+    while (ifs.read(buffer.data(), buffer.size()), ifs.gcount() > 0) {
+        checksums.add_data(buffer.data(), static_cast<size_t>(ifs.gcount()));
+    }
+    return checksums;
+}
+
+std::string RawFileChecksums::get_sidecar_path(const std::string &raw_file) {
+    return raw_file + ".crc";
+}
+
+void RawFileChecksums::add_data(const void *data, size_t size) {
+    auto bytes = static_cast<const uint8_t *>(data);
+    raw_file_size_ += size;
+    while (size > 0) {
+        const size_t n = static_cast<size_t>(std::min<uint64_t>(size, chunk_size_ - current_size_));
+        current_crc_   = crc32c(bytes, n, current_crc_);
+        current_size_ += n;
+        bytes += n;
+        size -= n;
+        if (current_size_ == chunk_size_) {
+            checksums_.push_back(current_crc_);
+            current_crc_  = 0;
+            current_size_ = 0;
+        }
+    }
+}
+
+bool RawFileChecksums::load(const std::string &path) {
+    std::ifstream ifs(path, std::ios::binary);
+    char magic[sizeof(Magic)];
+    uint32_t version;
+    uint64_t n_checksums;
+    if (!ifs.read(magic, sizeof(magic)) || std::memcmp(magic, Magic, sizeof(Magic)) != 0 ||
+        !read_value(ifs, version) || version != Version) {
+        return false;
+    }
+
+    RawFileChecksums checksums;
+    if (!read_value(ifs, checksums.chunk_size_) || !read_value(ifs, checksums.raw_file_size_) ||
+        !read_value(ifs, n_checksums) || checksums.chunk_size_ == 0 ||
+        n_checksums != (checksums.raw_file_size_ + checksums.chunk_size_ - 1) / checksums.chunk_size_) {
+        return false;
+    }
+    checksums.checksums_.resize(static_cast<size_t>(n_checksums));
+    for (auto &checksum : checksums.checksums_) {
+        if (!read_value(ifs, checksum)) {
+            return false;
+        }
+    }
+
+    // The last chunk is the one being filled if it is incomplete
+    checksums.current_size_ = checksums.raw_file_size_ % checksums.chunk_size_;
+    if (checksums.current_size_ > 0) {
+        checksums.current_crc_ = checksums.checksums_.back();
+        checksums.checksums_.pop_back();
+    }
+    *this = std::move(checksums);
+    return true;
+}
+
+bool RawFileChecksums::save(const std::string &path) const {
+    const auto checksums = get_checksums();
+    std::ofstream ofs(path, std::ios::binary);
+    ofs.write(Magic, sizeof(Magic));
+    write_value(ofs, Version);
+    write_value(ofs, chunk_size_);
+    write_value(ofs, raw_file_size_);
+    write_value(ofs, static_cast<uint64_t>(checksums.size()));
+    for (const auto checksum : checksums) {
+        write_value(ofs, checksum);
+    }
+    return static_cast<bool>(ofs);
+}
+
+std::vector<size_t> RawFileChecksums::verify(const std::string &raw_file, unsigned int n_threads) const {
+    std::ifstream ifs(raw_file, std::ios::binary | std::ios::ate);
+    if (!ifs) {
+        throw HalException(HalErrorCode::FailedInitialization, "Unable to open RAW file '" + raw_file + "'");
+    }
+    const uint64_t file_size = static_cast<uint64_t>(ifs.tellg());
+    const auto checksums     = get_checksums();
+
+    // Each thread reads the next chunk not checked yet, with its own file handle
+    std::vector<uint8_t> corrupted(checksums.size(), 0);
+    std::atomic<size_t> next_chunk{0};
+    auto worker = [&]() {
+        std::ifstream chunk_ifs(raw_file, std::ios::binary);
+        std::vector<char> buffer;
+        for (size_t i = next_chunk++; i < checksums.size(); i = next_chunk++) {
+            const uint64_t begin = i * chunk_size_;
+            const size_t size    = static_cast<size_t>(std::min(chunk_size_, raw_file_size_ - begin));
+            if (begin + size > file_size) {
+                corrupted[i] = 1;
+                continue;
+            }
+            buffer.resize(size);
+            chunk_ifs.clear();
+            chunk_ifs.seekg(begin);
+            chunk_ifs.read(buffer.data(), size);
+            corrupted[i] =
+                static_cast<size_t>(chunk_ifs.gcount()) != size || crc32c(buffer.data(), size) != checksums[i];
+        }
+    };
+
+    if (n_threads == 0) {
+        n_threads = std::thread::hardware_concurrency();
+    }
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < std::max<size_t>(1, std::min<size_t>(n_threads, checksums.size())); ++i) {
+        threads.emplace_back(worker);
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    std::vector<size_t> corrupted_chunks;
+    for (size_t i = 0; i < corrupted.size(); ++i) {
+        if (corrupted[i]) {
+            corrupted_chunks.push_back(i);
+        }
+    }
+    // Extra data, after the last chunk, is reported as a corruption of the last chunk
+    if (file_size > raw_file_size_ && (corrupted_chunks.empty() || corrupted_chunks.back() + 1 < checksums.size())) {
+        corrupted_chunks.push_back(checksums.empty() ? 0 : checksums.size() - 1);
+    }
+    return corrupted_chunks;
+}
+
+uint64_t RawFileChecksums::get_chunk_size() const {
+    return chunk_size_;
+}
+
+uint64_t RawFileChecksums::get_raw_file_size() const {
+    return raw_file_size_;
+}
+
+std::vector<uint32_t> RawFileChecksums::get_checksums() const {
+    auto checksums = checksums_;
+    if (current_size_ > 0) {
+        checksums.push_back(current_crc_);
+    }
+    return checksums;
+}
+
+} // namespace Metavision
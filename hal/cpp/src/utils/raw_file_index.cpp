@@ -0,0 +1,161 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#include "metavision/hal/facilities/i_decoder.h"
+#include "metavision/hal/utils/raw_file_index.h"
+
+namespace Metavision {
+
+namespace {
+
+constexpr char Magic[8]         = {'M', 'V', 'R', 'A', 'W', 'I', 'D', 'X'};
+constexpr uint32_t Version      = 1;
+constexpr size_t ReadChunkBytes = 1024 * 1024;
+
+template<typename T>
+void write_value(std::ostream &os, const T &value) {
+    os.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template<typename T>
+bool read_value(std::istream &is, T &value) {
+    return static_cast<bool>(is.read(reinterpret_cast<char *>(&value), sizeof(T)));
+}
+
+} // namespace
+
+constexpr timestamp RawFileIndex::DefaultPeriod;
+
+RawFileIndex RawFileIndex::build(std::istream &stream, I_Decoder &decoder, timestamp period) {
+    RawFileIndex index;
+    index.period_ = period;
+
+    const auto pos = stream.tellg();
+    if (pos < 0) {
+        return index;
+    }
+    uint64_t offset = static_cast<uint64_t>(pos);
+
+    // Chunks are a multiple of the size of a raw event so that they all start on the boundary of an event
+    const size_t raw_event_size = decoder.get_raw_event_size_bytes();
+    std::vector<I_Decoder::RawData> chunk((ReadChunkBytes / raw_event_size) * raw_event_size);
+    while (stream.read(reinterpret_cast<char *>(chunk.data()), chunk.size()), stream.gcount() > 0) {
+        I_Decoder::RawData *const begin = chunk.data();
+        I_Decoder::RawData *const end   = begin + stream.gcount();
+        I_Decoder::RawData *cur         = begin;
+        while (true) {
+            auto resync = const_cast<I_Decoder::RawData *>(decoder.find_resync_point(cur, end));
+            if (resync == end) {
+                break;
+            }
+
+            // The events preceding the resync point are decoded to know the timestamp to reset a decoder with, and
+            // the first resync point sets the time base of the data
+            decoder.decode(cur, resync);
+            const uint64_t resync_offset = offset + std::distance(begin, resync);
+            const bool first_entry       = index.entries_.empty();
+            if (!first_entry && decoder.get_last_timestamp() >= index.entries_.back().timestamp_ + period) {
+                index.entries_.push_back({decoder.get_last_timestamp(), resync_offset});
+            }
+            cur = resync + raw_event_size;
+            decoder.decode(resync, cur);
+            if (first_entry) {
+                index.entries_.push_back({decoder.get_last_timestamp(), resync_offset});
+            }
+        }
+        decoder.decode(cur, end);
+        offset += std::distance(begin, end);
+    }
+    index.raw_file_size_ = offset;
+
+    return index;
+}
+
+std::string RawFileIndex::get_sidecar_path(const std::string &raw_file) {
+    return raw_file + ".idx";
+}
+
+bool RawFileIndex::load(const std::string &path) {
+    std::ifstream ifs(path, std::ios::binary);
+    return load(ifs);
+}
+
+bool RawFileIndex::load(std::istream &stream) {
+    char magic[sizeof(Magic)];
+    uint32_t version;
+    uint64_t n_entries;
+    if (!stream.read(magic, sizeof(magic)) || std::memcmp(magic, Magic, sizeof(Magic)) != 0 ||
+        !read_value(stream, version) || version != Version) {
+        return false;
+    }
+
+    RawFileIndex index;
+    if (!read_value(stream, index.period_) || !read_value(stream, index.raw_file_size_) ||
+        !read_value(stream, n_entries)) {
+        return false;
+    }
+    for (uint64_t i = 0; i < n_entries; ++i) {
+        Entry entry;
+        if (!read_value(stream, entry.timestamp_) || !read_value(stream, entry.offset_)) {
+            return false;
+        }
+        index.entries_.push_back(entry);
+    }
+
+    *this = std::move(index);
+    return true;
+}
+
+bool RawFileIndex::save(const std::string &path) const {
+    std::ofstream ofs(path, std::ios::binary);
+    ofs.write(Magic, sizeof(Magic));
+    write_value(ofs, Version);
+    write_value(ofs, period_);
+    write_value(ofs, raw_file_size_);
+    write_value(ofs, static_cast<uint64_t>(entries_.size()));
+    for (const auto &entry : entries_) {
+        write_value(ofs, entry.timestamp_);
+        write_value(ofs, entry.offset_);
+    }
+    return static_cast<bool>(ofs);
+}
+
+const RawFileIndex::Entry &RawFileIndex::find(timestamp t) const {
+    auto it = std::lower_bound(entries_.begin(), entries_.end(), t,
+                               [](const Entry &entry, timestamp t) { return entry.timestamp_ < t; });
+    return it == entries_.begin() ? *it : *std::prev(it);
+}
+
+bool RawFileIndex::empty() const {
+    return entries_.empty();
+}
+
+const std::vector<RawFileIndex::Entry> &RawFileIndex::get_entries() const {
+    return entries_;
+}
+
+timestamp RawFileIndex::get_first_timestamp() const {
+    return entries_.empty() ? 0 : entries_.front().timestamp_;
+}
+
+timestamp RawFileIndex::get_period() const {
+    return period_;
+}
+
+uint64_t RawFileIndex::get_raw_file_size() const {
+    return raw_file_size_;
+}
+
+} // namespace Metavision
@@ -0,0 +1,289 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <future>
+#include <streambuf>
+
+#include "metavision/hal/utils/raw_file_playlist_stream.h"
+#include "metavision/hal/utils/compressed_raw_file_stream.h"
+#include "metavision/hal/utils/hal_error_code.h"
+#include "metavision/hal/utils/hal_exception.h"
+#include "metavision/hal/utils/raw_file_header.h"
+#include "metavision/hal/utils/striped_raw_file_writer.h"
+
+namespace Metavision {
+
+namespace {
+
+// Size of the reads from the current file
+constexpr size_t ReadSize = 1024 * 1024;
+
+// Part of a file in the playlist stream: the whole first file, and the data of the other ones
+struct Segment {
+    std::string path;
+    uint64_t file_offset;   // Offset in the file of the start of the segment
+    uint64_t size;          // Size of the segment
+    uint64_t stream_offset; // Offset in the stream of the start of the segment
+};
+
+// File opened at a given position of a segment, with the first bytes read from there
+struct OpenedSegment {
+    size_t index = 0;
+    std::unique_ptr<std::ifstream> file;
+    std::vector<char> data;
+};
+
+OpenedSegment open_segment(const Segment &segment, size_t index, uint64_t offset, size_t n_bytes_to_read) {
+    OpenedSegment opened;
+    opened.index = index;
+    opened.file  = std::make_unique<std::ifstream>(segment.path, std::ios::in | std::ios::binary);
+    opened.file->seekg(segment.file_offset + offset);
+    opened.data.resize(static_cast<size_t>(std::min<uint64_t>(n_bytes_to_read, segment.size - offset)));
+    opened.file->read(opened.data.data(), opened.data.size());
+    opened.data.resize(static_cast<size_t>(std::max<std::streamsize>(opened.file->gcount(), 0)));
+    return opened;
+}
+
+// Header, without its date, and layout of a RAW file
+struct RawFileInfo {
+    RawFileHeader header;
+    uint64_t data_offset;
+    uint64_t file_size;
+};
+
+RawFileInfo read_raw_file_info(const std::string &raw_file) {
+    if (CompressedRawFileStream::is_compressed(raw_file)) {
+        throw HalException(HalErrorCode::InvalidArgument,
+                           "Compressed RAW file '" + raw_file + "' can not be chained in a playlist.");
+    }
+    std::ifstream ifs(raw_file, std::ios::in | std::ios::binary);
+    if (!ifs) {
+        throw HalException(HalErrorCode::FailedInitialization, "Unable to open RAW file '" + raw_file + "'");
+    }
+    RawFileInfo info;
+    info.header = RawFileHeader(ifs);
+    info.header.remove_date();
+    // The parsing of the header of a file without data reaches its end
+    const bool has_data = ifs.good();
+    const auto data_pos = has_data ? ifs.tellg() : std::streampos(0);
+    ifs.clear();
+    ifs.seekg(0, std::ios::end);
+    info.file_size   = static_cast<uint64_t>(ifs.tellg());
+    info.data_offset = has_data ? static_cast<uint64_t>(data_pos) : info.file_size;
+    return info;
+}
+
+} // namespace
+
+// Stream buffer reading the segments one after the other, the next one being opened in the background
+class RawFilePlaylistStream::PlaylistStreamBuf : public std::streambuf {
+public:
+    PlaylistStreamBuf(std::vector<Segment> segments, size_t prefetch_size) :
+        segments_(std::move(segments)), prefetch_size_(std::max<size_t>(prefetch_size, 1)) {
+        size_ = segments_.back().stream_offset + segments_.back().size;
+        switch_to(0, 0);
+    }
+
+    ~PlaylistStreamBuf() {
+        if (prefetch_.valid()) {
+            prefetch_.wait();
+        }
+    }
+
+    uint64_t size() const {
+        return size_;
+    }
+
+protected:
+    int_type underflow() override {
+        while (gptr() == egptr()) {
+            const Segment &segment = segments_[index_];
+            base_ += egptr() - eback();
+            if (base_ < segment.size && file_) {
+                buffer_.resize(static_cast<size_t>(std::min<uint64_t>(ReadSize, segment.size - base_)));
+                file_->read(buffer_.data(), buffer_.size());
+                const auto n_read = std::max<std::streamsize>(file_->gcount(), 0);
+                setg(buffer_.data(), buffer_.data(), buffer_.data() + n_read);
+                if (n_read == 0) {
+                    // The file has been truncated since the playlist was built
+                    return traits_type::eof();
+                }
+            } else if (index_ + 1 < segments_.size()) {
+                switch_to(index_ + 1, 0);
+            } else {
+                setg(buffer_.data(), buffer_.data(), buffer_.data());
+                return traits_type::eof();
+            }
+        }
+        return traits_type::to_int_type(*gptr());
+    }
+
+    pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override {
+        if (!(which & std::ios_base::in)) {
+            return pos_type(off_type(-1));
+        }
+        off_type target = off;
+        if (dir == std::ios_base::cur) {
+            target += static_cast<off_type>(position());
+        } else if (dir == std::ios_base::end) {
+            target += static_cast<off_type>(size_);
+        }
+        if (target < 0 || static_cast<uint64_t>(target) > size_) {
+            return pos_type(off_type(-1));
+        }
+
+        // The data buffered is kept if the target is in it
+        const uint64_t position = static_cast<uint64_t>(target);
+        const uint64_t begin    = segments_[index_].stream_offset + base_;
+        if (position >= begin && position <= begin + (egptr() - eback())) {
+            setg(eback(), eback() + (position - begin), egptr());
+            return pos_type(target);
+        }
+        // Last segment starting at or before the target
+        auto it = std::upper_bound(segments_.begin(), segments_.end(), position,
+                                   [](uint64_t p, const Segment &s) { return p < s.stream_offset; });
+        const size_t index = std::distance(segments_.begin(), it) - 1;
+        switch_to(index, position - segments_[index].stream_offset);
+        return pos_type(target);
+    }
+
+    pos_type seekpos(pos_type pos, std::ios_base::openmode which) override {
+        return seekoff(off_type(pos), std::ios_base::beg, which);
+    }
+
+private:
+    uint64_t position() const {
+        return segments_[index_].stream_offset + base_ + (gptr() - eback());
+    }
+
+    // Reads the segment @p index from @p offset, then starts prefetching the next one
+    void switch_to(size_t index, uint64_t offset) {
+        OpenedSegment opened;
+        if (prefetch_.valid()) {
+            opened = prefetch_.get();
+        }
+        if (!opened.file || opened.index != index || offset != 0) {
+            opened = open_segment(segments_[index], index, offset, ReadSize);
+        }
+        index_ = index;
+        base_  = offset;
+        file_  = std::move(opened.file);
+        buffer_.swap(opened.data);
+        setg(buffer_.data(), buffer_.data(), buffer_.data() + buffer_.size());
+
+        if (index + 1 < segments_.size()) {
+            const Segment next_segment = segments_[index + 1];
+            const size_t prefetch_size = prefetch_size_;
+            prefetch_                  = std::async(std::launch::async, [next_segment, index, prefetch_size]() {
+                return open_segment(next_segment, index + 1, 0, prefetch_size);
+            });
+        }
+    }
+
+    const std::vector<Segment> segments_;
+    const size_t prefetch_size_;
+    uint64_t size_ = 0;
+
+    size_t index_  = 0;
+    uint64_t base_ = 0; // Offset in the current segment of the start of the buffer
+    std::unique_ptr<std::ifstream> file_;
+    std::vector<char> buffer_;
+    std::future<OpenedSegment> prefetch_;
+};
+
+RawFilePlaylistStream::RawFilePlaylistStream(const std::vector<std::string> &raw_files, size_t prefetch_size) :
+    std::istream(nullptr), raw_files_(raw_files) {
+    if (raw_files_.empty()) {
+        throw HalException(HalErrorCode::InvalidArgument, "A playlist must hold at least one RAW file.");
+    }
+
+    std::vector<Segment> segments;
+    RawFileHeader first_header;
+    uint64_t stream_offset = 0;
+    for (const auto &raw_file : raw_files_) {
+        const auto info = read_raw_file_info(raw_file);
+        if (segments.empty()) {
+            first_header = info.header;
+            segments.push_back({raw_file, 0, info.file_size, 0});
+        } else {
+            if (info.header.get_header_map() != first_header.get_header_map()) {
+                throw HalException(HalErrorCode::InvalidArgument,
+                                   "The header of RAW file '" + raw_file + "' differs from the one of '" +
+                                       raw_files_.front() + "', they can not be chained in a playlist.");
+            }
+            segments.push_back({raw_file, info.data_offset, info.file_size - info.data_offset, stream_offset});
+        }
+        stream_offset += segments.back().size;
+    }
+
+    streambuf_.reset(new PlaylistStreamBuf(std::move(segments), prefetch_size));
+    rdbuf(streambuf_.get());
+}
+
+RawFilePlaylistStream::RawFilePlaylistStream(const std::vector<std::string> &raw_files,
+                                             std::unique_ptr<PlaylistStreamBuf> streambuf) :
+    std::istream(nullptr), raw_files_(raw_files), streambuf_(std::move(streambuf)) {
+    rdbuf(streambuf_.get());
+}
+
+std::unique_ptr<RawFilePlaylistStream> RawFilePlaylistStream::open_stripes(const std::string &manifest_path,
+                                                                         size_t prefetch_size) {
+    const auto manifest = StripedRawFileWriter::read_manifest(manifest_path);
+    const auto &files   = manifest.stripe_files;
+
+    std::vector<RawFileInfo> infos;
+    for (const auto &stripe_file : files) {
+        infos.push_back(read_raw_file_info(stripe_file));
+        if (infos.back().header.get_header_map() != infos.front().header.get_header_map()) {
+            throw HalException(HalErrorCode::InvalidArgument, "The header of stripe file '" + stripe_file +
+                                                                  "' differs from the one of '" + files.front() + "'");
+        }
+    }
+
+    // The header of the first stripe file, followed by the stripes taken in turn from each file. The recording ends
+    // with the first stripe that is missing or incomplete
+    std::vector<Segment> segments{{files.front(), 0, infos.front().data_offset, 0}};
+    uint64_t stream_offset = segments.front().size;
+    for (uint64_t stripe = 0;; ++stripe) {
+        const auto &info           = infos[stripe % files.size()];
+        const uint64_t data_size   = info.file_size - info.data_offset;
+        const uint64_t data_offset = (stripe / files.size()) * manifest.stripe_size;
+        if (data_offset >= data_size) {
+            break;
+        }
+        const uint64_t size = std::min(manifest.stripe_size, data_size - data_offset);
+        segments.push_back({files[stripe % files.size()], info.data_offset + data_offset, size, stream_offset});
+        stream_offset += size;
+        if (size < manifest.stripe_size) {
+            break;
+        }
+    }
+
+    return std::unique_ptr<RawFilePlaylistStream>(
+        new RawFilePlaylistStream(files, std::make_unique<PlaylistStreamBuf>(std::move(segments), prefetch_size)));
+}
+
+RawFilePlaylistStream::~RawFilePlaylistStream() {
+    rdbuf(nullptr);
+}
+
+const std::vector<std::string> &RawFilePlaylistStream::get_raw_files() const {
+    return raw_files_;
+}
+
+uint64_t RawFilePlaylistStream::size() const {
+    return streambuf_->size();
+}
+
+} // namespace Metavision
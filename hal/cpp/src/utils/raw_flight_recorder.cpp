@@ -0,0 +1,152 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <utility>
+
+#include "metavision/hal/utils/hal_exception.h"
+#include "metavision/hal/utils/hal_log.h"
+#include "metavision/hal/utils/raw_flight_recorder.h"
+
+namespace Metavision {
+
+RawFlightRecorder::RawFlightRecorder(const std::string &header, const RawFlightRecorderConfig &config) :
+    header_(header), config_(config) {}
+
+RawFlightRecorder::~RawFlightRecorder() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    writer_.reset();
+    if (closing_thread_.joinable()) {
+        closing_thread_.join();
+    }
+}
+
+void RawFlightRecorder::add_data(const DataTransfer::BufferSlice &slice) {
+    if (slice.empty()) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    last_arrival_time_ = slice.arrival_time();
+    if (writer_) {
+        if (last_arrival_time_ <= dump_end_time_) {
+            writer_->write(slice);
+        } else {
+            finish_dump();
+        }
+    }
+
+    slices_.push_back(slice);
+    buffered_bytes_ += slice.size();
+    const auto oldest_time = last_arrival_time_ - std::chrono::milliseconds(config_.pre_trigger_ms_);
+    while (!slices_.empty() && (slices_.front().arrival_time() < oldest_time || buffered_bytes_ > config_.max_bytes_)) {
+        buffered_bytes_ -= slices_.front().size();
+        slices_.pop_front();
+    }
+}
+
+bool RawFlightRecorder::trigger(const std::string &filename) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return start_dump(filename);
+}
+
+std::string RawFlightRecorder::trigger() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const std::string filename = config_.dump_basename_ + "_" + std::to_string(num_dumps_) + ".raw";
+    return start_dump(filename) ? filename : std::string();
+}
+
+void RawFlightRecorder::add_ext_triggers(const EventExtTrigger *begin, const EventExtTrigger *end) {
+    const bool triggered = std::any_of(begin, end, [this](const EventExtTrigger &ev) {
+        return ev.p == 1 && (config_.ext_trigger_channel_ < 0 || ev.id == config_.ext_trigger_channel_);
+    });
+    if (triggered) {
+        trigger();
+    }
+}
+
+void RawFlightRecorder::add_cd_events(const EventCD *begin, const EventCD *end) {
+    if (config_.event_rate_threshold_ <= 0 || begin == end) {
+        return;
+    }
+    const timestamp window_us = std::max<timestamp>(config_.event_rate_window_us_, 1);
+    const double threshold    = config_.event_rate_threshold_ * window_us / 1e6;
+    if (!rate_window_started_) {
+        rate_window_start_   = begin->t;
+        rate_window_started_ = true;
+    }
+
+    bool triggered = false;
+    while (begin != end) {
+        // The events are sorted in time, the end of the current window is found by a binary search
+        const timestamp window_end = rate_window_start_ + window_us;
+        auto it = std::lower_bound(begin, end, window_end, [](const EventCD &ev, timestamp t) { return ev.t < t; });
+        rate_window_count_ += std::distance(begin, it);
+        if (it == end) {
+            break;
+        }
+        triggered = triggered || rate_window_count_ > threshold;
+        // The windows without any event are skipped
+        rate_window_start_ = it->t - (it->t - rate_window_start_) % window_us;
+        rate_window_count_ = 0;
+        begin              = it;
+    }
+    if (triggered) {
+        trigger();
+    }
+}
+
+bool RawFlightRecorder::is_dumping() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return writer_ != nullptr;
+}
+
+uint32_t RawFlightRecorder::get_num_dumps() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return num_dumps_;
+}
+
+size_t RawFlightRecorder::get_buffered_bytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return buffered_bytes_;
+}
+
+bool RawFlightRecorder::start_dump(const std::string &filename) {
+    // The time of the trigger is the arrival time of the last data, on which the trigger is typically based
+    const auto trigger_time = last_arrival_time_ == Clock::time_point() ? Clock::now() : last_arrival_time_;
+    const auto end_time = trigger_time + std::chrono::milliseconds(config_.post_trigger_ms_);
+    if (writer_) {
+        dump_end_time_ = std::max(dump_end_time_, end_time);
+        return false;
+    }
+
+    try {
+        writer_.reset(new AsyncRawFileWriter(filename, header_, config_.writer_config_));
+    } catch (const HalException &e) {
+        MV_HAL_LOG_ERROR() << "Failed to start the dump of the flight recorder:" << e.what();
+        return false;
+    }
+    for (const auto &slice : slices_) {
+        writer_->write(slice);
+    }
+    dump_end_time_ = end_time;
+    ++num_dumps_;
+    return true;
+}
+
+void RawFlightRecorder::finish_dump() {
+    if (closing_thread_.joinable()) {
+        closing_thread_.join();
+    }
+    closing_thread_ = std::thread([writer = std::move(writer_)]() mutable { writer.reset(); });
+}
+
+} // namespace Metavision
@@ -0,0 +1,198 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <cstring>
+#include <streambuf>
+
+#include "metavision/hal/utils/read_ahead_file_stream.h"
+#include "metavision/hal/utils/hal_log.h"
+#include "metavision/sdk/base/utils/thread_policy.h"
+
+namespace Metavision {
+
+struct ReadAheadFileStream::Read {
+    DataTransfer::BufferPtr buffer;
+    uint64_t offset;
+    size_t size;
+    bool done = false;
+};
+
+// Stream buffer reading the file through the backend, for the standard use of the stream (e.g. parsing the header)
+class ReadAheadFileStream::BackendStreamBuf : public std::streambuf {
+public:
+    BackendStreamBuf(RangedReadBackend &backend) : backend_(backend), buffer_(BufferSize) {
+        setg(buffer_.data(), buffer_.data(), buffer_.data());
+    }
+
+protected:
+    int_type underflow() override {
+        buffer_offset_ = position();
+        const int64_t n_read =
+            backend_.read_at(reinterpret_cast<uint8_t *>(buffer_.data()), buffer_offset_, buffer_.size());
+        setg(buffer_.data(), buffer_.data(), buffer_.data() + std::max<int64_t>(n_read, 0));
+        return n_read > 0 ? traits_type::to_int_type(*gptr()) : traits_type::eof();
+    }
+
+    std::streamsize xsgetn(char_type *data, std::streamsize size) override {
+        // The data buffered is copied, then large reads are done directly in the destination
+        std::streamsize n_copied = std::min<std::streamsize>(size, egptr() - gptr());
+        std::memcpy(data, gptr(), static_cast<size_t>(n_copied));
+        gbump(static_cast<int>(n_copied));
+        if (n_copied == size) {
+            return size;
+        }
+        if (size - n_copied < static_cast<std::streamsize>(buffer_.size())) {
+            return n_copied + std::streambuf::xsgetn(data + n_copied, size - n_copied);
+        }
+        const uint64_t offset = position();
+        const int64_t n_read  = backend_.read_at(reinterpret_cast<uint8_t *>(data + n_copied), offset,
+                                                 static_cast<size_t>(size - n_copied));
+        buffer_offset_        = offset + std::max<int64_t>(n_read, 0);
+        setg(buffer_.data(), buffer_.data(), buffer_.data());
+        return n_copied + std::max<int64_t>(n_read, 0);
+    }
+
+    pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override {
+        if (!(which & std::ios_base::in)) {
+            return pos_type(off_type(-1));
+        }
+        off_type target = off;
+        if (dir == std::ios_base::cur) {
+            target += static_cast<off_type>(position());
+        } else if (dir == std::ios_base::end) {
+            target += static_cast<off_type>(backend_.get_size());
+        }
+        if (target < 0) {
+            return pos_type(off_type(-1));
+        }
+        // The data buffered is kept if the target is in it
+        const uint64_t position = static_cast<uint64_t>(target);
+        if (position >= buffer_offset_ && position <= buffer_offset_ + (egptr() - eback())) {
+            setg(eback(), eback() + (position - buffer_offset_), egptr());
+        } else {
+            buffer_offset_ = position;
+            setg(buffer_.data(), buffer_.data(), buffer_.data());
+        }
+        return pos_type(target);
+    }
+
+    pos_type seekpos(pos_type pos, std::ios_base::openmode which) override {
+        return seekoff(off_type(pos), std::ios_base::beg, which);
+    }
+
+private:
+    static constexpr size_t BufferSize = 64 * 1024;
+
+    uint64_t position() const {
+        return buffer_offset_ + (gptr() - eback());
+    }
+
+    RangedReadBackend &backend_;
+    std::vector<char> buffer_;
+    uint64_t buffer_offset_ = 0; // Offset in the file of the start of the buffer
+};
+
+ReadAheadFileStream::ReadAheadFileStream(const std::string &filename, uint32_t n_reads_in_flight) :
+    ReadAheadFileStream(std::make_unique<LocalFileBackend>(filename), n_reads_in_flight) {}
+
+ReadAheadFileStream::ReadAheadFileStream(std::unique_ptr<RangedReadBackend> backend, uint32_t n_reads_in_flight) :
+    std::istream(nullptr),
+    backend_(std::move(backend)),
+    streambuf_(new BackendStreamBuf(*backend_)),
+    n_reads_in_flight_(std::max(1u, n_reads_in_flight)) {
+    rdbuf(streambuf_.get());
+    if (!backend_->is_open()) {
+        setstate(std::ios::failbit);
+    }
+}
+
+ReadAheadFileStream::~ReadAheadFileStream() {
+    {
+        std::lock_guard<std::mutex> lock(reads_mutex_);
+        stop_reading_threads_ = true;
+    }
+    reads_cond_.notify_all();
+    for (auto &thread : reading_threads_) {
+        thread.join();
+    }
+    rdbuf(nullptr);
+}
+
+uint32_t ReadAheadFileStream::get_n_reads_in_flight() const {
+    return n_reads_in_flight_;
+}
+
+uint64_t ReadAheadFileStream::get_file_size() const {
+    return backend_->get_size();
+}
+
+RangedReadBackend &ReadAheadFileStream::get_backend() const {
+    return *backend_;
+}
+void ReadAheadFileStream::submit(const DataTransfer::BufferPtr &buffer, uint64_t offset, size_t size) {
+    auto read    = std::make_shared<Read>();
+    read->buffer = buffer;
+    read->offset = offset;
+    read->size   = size;
+
+    {
+        std::lock_guard<std::mutex> lock(reads_mutex_);
+        // Reading threads are only started when needed, so that using the stream as a standard one costs nothing
+        if (reading_threads_.size() < n_reads_in_flight_ && reading_threads_.size() <= pending_reads_.size()) {
+            reading_threads_.emplace_back([this]() { run_reading_thread(); });
+        }
+        pending_reads_.push_back(read);
+        reads_to_start_.push_back(read);
+    }
+    reads_cond_.notify_all();
+}
+
+size_t ReadAheadFileStream::get_n_pending_reads() const {
+    std::lock_guard<std::mutex> lock(reads_mutex_);
+    return pending_reads_.size();
+}
+
+DataTransfer::BufferPtr ReadAheadFileStream::wait_next() {
+    std::unique_lock<std::mutex> lock(reads_mutex_);
+    if (pending_reads_.empty()) {
+        return nullptr;
+    }
+
+    auto read = pending_reads_.front();
+    reads_cond_.wait(lock, [&read]() { return read->done; });
+    pending_reads_.pop_front();
+    return read->buffer;
+}
+
+void ReadAheadFileStream::run_reading_thread() {
+    apply_thread_policy(ThreadPolicy(), "mv_read_ahead");
+    std::unique_lock<std::mutex> lock(reads_mutex_);
+    while (true) {
+        reads_cond_.wait(lock, [this]() { return stop_reading_threads_ || !reads_to_start_.empty(); });
+        if (reads_to_start_.empty()) {
+            return;
+        }
+        auto read = reads_to_start_.front();
+        reads_to_start_.pop_front();
+
+        lock.unlock();
+        read->buffer->resize(read->size); // Does not reallocate if enough memory already allocated.
+        const int64_t n_read = backend_->read_at(read->buffer->data(), read->offset, read->size);
+        read->buffer->resize(n_read > 0 ? static_cast<size_t>(n_read) : 0);
+        lock.lock();
+
+        read->done = true;
+        reads_cond_.notify_all();
+    }
+}
+
+} // namespace Metavision
@@ -0,0 +1,168 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <utility>
+
+#include "metavision/hal/utils/resync_decoder.h"
+
+namespace Metavision {
+
+ResyncDecoder::ResyncDecoder(I_Decoder &decoder, const ResyncDecoderConfig &config) :
+    decoder_(decoder),
+    config_(config),
+    raw_event_size_(decoder.get_raw_event_size_bytes()),
+    time_base_period_(decoder.get_time_base_period()) {}
+
+void ResyncDecoder::decode(I_Decoder::RawData *raw_data_begin, I_Decoder::RawData *raw_data_end) {
+    if (time_base_period_ == 0) {
+        decoder_.decode(raw_data_begin, raw_data_end);
+        return;
+    }
+
+    if (!resyncing_) {
+        decode_checked(raw_data_begin, raw_data_end);
+    } else {
+        resync_data_.insert(resync_data_.end(), raw_data_begin, raw_data_end);
+    }
+    // Decoding resumed from a resync point may detect another corruption further in the data
+    while (resyncing_ && resync()) {}
+}
+
+bool ResyncDecoder::is_resyncing() const {
+    return resyncing_;
+}
+
+size_t ResyncDecoder::get_corruption_count() const {
+    return corruption_count_;
+}
+
+uint64_t ResyncDecoder::get_skipped_bytes() const {
+    return skipped_bytes_;
+}
+
+void ResyncDecoder::decode_checked(I_Decoder::RawData *raw_data_begin, I_Decoder::RawData *raw_data_end) {
+    // The time bases are searched on the raw event boundaries of the data already passed to the decoder
+    const size_t first_event_offset = (raw_event_size_ - raw_event_offset_) % raw_event_size_;
+    if (static_cast<size_t>(raw_data_end - raw_data_begin) > first_event_offset) {
+        const I_Decoder::RawData *cur = raw_data_begin + first_event_offset;
+        while (true) {
+            timestamp time_base;
+            const I_Decoder::RawData *time_base_event = decoder_.find_time_base(cur, raw_data_end, time_base);
+            if (time_base_event == raw_data_end) {
+                break;
+            }
+            if (has_time_base_ && !is_consistent(time_base_, time_base)) {
+                // The data preceding the inconsistent time base is decoded, the rest is scanned for a resync point
+                I_Decoder::RawData *corrupted = raw_data_begin + (time_base_event - raw_data_begin);
+                decoder_.decode(raw_data_begin, corrupted);
+                raw_event_offset_ = 0;
+                ++corruption_count_;
+                ++skipped_bytes_;
+                resyncing_ = true;
+                resync_data_.assign(corrupted + 1, raw_data_end);
+                return;
+            }
+            has_time_base_ = true;
+            time_base_     = time_base;
+            cur            = time_base_event + raw_event_size_;
+        }
+    }
+
+    decoder_.decode(raw_data_begin, raw_data_end);
+    raw_event_offset_ = (raw_event_offset_ + (raw_data_end - raw_data_begin)) % raw_event_size_;
+}
+
+bool ResyncDecoder::resync() {
+    const I_Decoder::RawData *begin = resync_data_.data();
+    const I_Decoder::RawData *end   = begin + resync_data_.size();
+
+    // Earliest confirmed resync point, and earliest one that can not be confirmed yet for lack of data
+    size_t resync_offset = resync_data_.size();
+    size_t pending_offset =
+        resync_data_.size() - std::min(resync_data_.size(), static_cast<size_t>(raw_event_size_ - 1));
+    timestamp resync_time_base = 0;
+    for (size_t alignment = 0; alignment < raw_event_size_; ++alignment) {
+        const I_Decoder::RawData *cur = begin + alignment;
+        while (cur < end) {
+            timestamp time_base;
+            const I_Decoder::RawData *candidate = decoder_.find_time_base(cur, end, time_base);
+            if (candidate == end || static_cast<size_t>(candidate - begin) >= resync_offset) {
+                break;
+            }
+            const I_Decoder::RawData *resync_point = decoder_.find_resync_point(candidate, end);
+            if (resync_point == end) {
+                pending_offset = std::min(pending_offset, static_cast<size_t>(candidate - begin));
+                break;
+            }
+            if (resync_point != candidate) {
+                cur = resync_point;
+                continue;
+            }
+
+            // The resync point is confirmed by the next time bases, which must be monotonic
+            const I_Decoder::RawData *next = candidate + raw_event_size_;
+            timestamp previous_time_base   = time_base;
+            uint32_t n_confirmations       = 0;
+            bool consistent                = true;
+            for (; n_confirmations < config_.n_confirmations_; ++n_confirmations) {
+                timestamp next_time_base;
+                const I_Decoder::RawData *next_event = decoder_.find_time_base(next, end, next_time_base);
+                if (next_event == end) {
+                    break;
+                }
+                if (!is_consistent(previous_time_base, next_time_base)) {
+                    consistent = false;
+                    break;
+                }
+                previous_time_base = next_time_base;
+                next               = next_event + raw_event_size_;
+            }
+            if (!consistent) {
+                cur = candidate + raw_event_size_;
+                continue;
+            }
+            if (n_confirmations < config_.n_confirmations_) {
+                pending_offset = std::min(pending_offset, static_cast<size_t>(candidate - begin));
+                break;
+            }
+            resync_offset    = candidate - begin;
+            resync_time_base = time_base;
+            break;
+        }
+    }
+
+    if (resync_offset == resync_data_.size()) {
+        // Only the data that may still contain a resync point is kept
+        skipped_bytes_ += pending_offset;
+        resync_data_.erase(resync_data_.begin(), resync_data_.begin() + pending_offset);
+        return false;
+    }
+
+    skipped_bytes_ += resync_offset;
+    resyncing_     = false;
+    has_time_base_ = true;
+    time_base_     = resync_time_base;
+    decoder_.reset_last_timestamp(decoder_.get_last_timestamp());
+
+    std::vector<I_Decoder::RawData> data;
+    data.swap(resync_data_);
+    decode_checked(data.data() + resync_offset, data.data() + data.size());
+    return true;
+}
+
+bool ResyncDecoder::is_consistent(timestamp previous_time_base, timestamp time_base) const {
+    const timestamp jump = time_base >= previous_time_base ? time_base - previous_time_base :
+                                                             time_base + time_base_period_ - previous_time_base;
+    return jump <= config_.max_time_jump_;
+}
+
+} // namespace Metavision
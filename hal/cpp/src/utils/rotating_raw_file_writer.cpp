@@ -0,0 +1,151 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <cstdio>
+#include <iomanip>
+#include <sstream>
+#include <utility>
+
+#include "metavision/hal/utils/hal_exception.h"
+#include "metavision/hal/utils/hal_log.h"
+#include "metavision/hal/utils/rotating_raw_file_writer.h"
+
+namespace Metavision {
+
+namespace {
+// Delay before trying again to open the next file, after a failure
+constexpr std::chrono::milliseconds RetryPeriod(1000);
+} // namespace
+
+RotatingRawFileWriter::RotatingRawFileWriter(const HeaderBuilder &header_builder,
+                                             const RawFileRotationConfig &config) :
+    header_builder_(header_builder), config_(config) {
+    const std::string filename = get_filename(config_, 0);
+    current_.reset(new AsyncRawFileWriter(filename, header_builder_(0), config_.writer_config_));
+    current_start_ = std::chrono::steady_clock::now();
+    filenames_.push_back(filename);
+    thread_ = std::thread([this] { run(); });
+}
+
+RotatingRawFileWriter::~RotatingRawFileWriter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    cond_.notify_all();
+    thread_.join();
+    current_.reset(nullptr);
+}
+
+std::string RotatingRawFileWriter::get_filename(const RawFileRotationConfig &config, size_t index) {
+    std::ostringstream oss;
+    oss << config.basename_ << "_" << std::setfill('0') << std::setw(4) << index << ".raw";
+    return oss.str();
+}
+
+bool RotatingRawFileWriter::rotation_due(size_t size) const {
+    if (rotation_requested_.load(std::memory_order_relaxed)) {
+        return true;
+    }
+    if (config_.max_file_size_ && current_bytes_ && current_bytes_ + size > config_.max_file_size_) {
+        return true;
+    }
+    return config_.max_file_duration_ms_ &&
+           std::chrono::steady_clock::now() - current_start_ >=
+               std::chrono::milliseconds(config_.max_file_duration_ms_);
+}
+
+void RotatingRawFileWriter::write(const DataTransfer::BufferSlice &slice) {
+    if (rotation_due(slice.size())) {
+        // Never waits for the background thread: if it holds the lock or the next file is not ready, the buffer goes to
+        // the current file and the switch is attempted again with the next buffer
+        std::unique_lock<std::mutex> lock(mutex_, std::try_to_lock);
+        if (lock.owns_lock() && next_) {
+            retired_.push_back(std::move(current_));
+            current_ = std::move(next_);
+            filenames_.push_back(get_filename(config_, next_index_++));
+            lock.unlock();
+            cond_.notify_all();
+
+            current_bytes_ = 0;
+            current_start_ = std::chrono::steady_clock::now();
+            rotation_requested_.store(false, std::memory_order_relaxed);
+        }
+    }
+    current_->write(slice);
+    current_bytes_ += slice.size();
+}
+
+void RotatingRawFileWriter::request_rotation() {
+    rotation_requested_.store(true, std::memory_order_relaxed);
+}
+
+std::vector<std::string> RotatingRawFileWriter::get_filenames() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return filenames_;
+}
+
+size_t RotatingRawFileWriter::get_queue_depth() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return current_->get_queue_depth();
+}
+
+size_t RotatingRawFileWriter::get_bytes_behind() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return current_->get_bytes_behind();
+}
+
+void RotatingRawFileWriter::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        if (!retired_.empty()) {
+            auto retired = std::move(retired_);
+            retired_.clear();
+            // Writes the pending buffers of the previous files without holding the lock, which write may try to take
+            lock.unlock();
+            retired.clear();
+            lock.lock();
+            continue;
+        }
+        if (stopping_) {
+            break;
+        }
+        if (!next_ && !next_failed_) {
+            const size_t index         = next_index_;
+            const std::string filename = get_filename(config_, index);
+            lock.unlock();
+            std::unique_ptr<AsyncRawFileWriter> writer;
+            try {
+                writer.reset(new AsyncRawFileWriter(filename, header_builder_(index), config_.writer_config_));
+            } catch (const std::exception &e) {
+                MV_HAL_LOG_ERROR() << "Failed to open the next file of the recording" << filename << ":" << e.what();
+            }
+            lock.lock();
+            next_failed_ = !writer;
+            next_        = std::move(writer);
+            continue;
+        }
+        if (next_failed_) {
+            cond_.wait_for(lock, RetryPeriod, [this] { return stopping_ || !retired_.empty(); });
+            next_failed_ = false;
+            continue;
+        }
+        cond_.wait(lock, [this] { return stopping_ || !retired_.empty() || !next_; });
+    }
+
+    // The file opened in advance only contains a header
+    if (next_) {
+        next_.reset(nullptr);
+        std::remove(get_filename(config_, next_index_).c_str());
+    }
+}
+
+} // namespace Metavision
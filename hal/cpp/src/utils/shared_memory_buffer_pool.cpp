@@ -0,0 +1,257 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <atomic>
+#include <cstring>
+#include <new>
+
+#include "metavision/hal/utils/shared_memory_buffer_pool.h"
+#include "metavision/hal/utils/detail/shared_memory_mapping.h"
+#include "metavision/hal/utils/hal_error_code.h"
+#include "metavision/hal/utils/hal_exception.h"
+
+namespace Metavision {
+
+namespace {
+
+constexpr char Magic[]     = "metavision_shared_memory_buffer_pool";
+constexpr uint32_t Version = 1;
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "The atomics shared between processes must be lock free");
+
+constexpr uint64_t align(uint64_t offset) {
+    return (offset + 63) & ~uint64_t(63);
+}
+
+// The generation and the reference count of a slab are updated together, so that a stale handle can not change the
+// reference count of a slab that has been reused
+constexpr uint64_t make_state(uint32_t generation, uint32_t refs) {
+    return (uint64_t(generation) << 32) | refs;
+}
+
+constexpr uint32_t get_generation(uint64_t state) {
+    return static_cast<uint32_t>(state >> 32);
+}
+
+constexpr uint32_t get_refs(uint64_t state) {
+    return static_cast<uint32_t>(state);
+}
+
+} // namespace
+
+struct SharedMemoryBufferPool::Header {
+    char magic[sizeof(Magic)];
+    uint32_t version;
+    uint32_t n_slabs;
+    uint64_t slab_size;
+    uint64_t data_offset;
+    uint64_t total_size;
+    int64_t creator_pid;
+    std::atomic<uint32_t> ready;
+    std::atomic<uint32_t> next_slab; // Slab from which the search of a free slab starts, to spread the writes
+    std::atomic<uint64_t> n_drops;
+};
+
+struct alignas(64) SharedMemoryBufferPool::Slab {
+    std::atomic<uint64_t> state; // Generation and reference count of the slab
+};
+
+std::shared_ptr<SharedMemoryBufferPool> SharedMemoryBufferPool::create(const std::string &name,
+                                                                       const SharedMemoryBufferPoolConfig &config) {
+    if (name.empty() || name.find_first_of("/\\:") != std::string::npos) {
+        throw HalException(HalErrorCode::InvalidArgument, "Invalid shared memory buffer pool name '" + name + "'.");
+    }
+    if (config.n_slabs_ == 0 || config.slab_size_bytes_ == 0 || config.slab_size_bytes_ % 64 != 0) {
+        throw HalException(HalErrorCode::InvalidArgument,
+                           "A shared memory buffer pool needs at least 1 slab, of a size multiple of 64 bytes.");
+    }
+
+    const uint64_t slabs_offset = align(sizeof(Header));
+    const uint64_t data_offset  = align(slabs_offset + config.n_slabs_ * sizeof(Slab));
+    const uint64_t total_size   = data_offset + uint64_t(config.n_slabs_) * config.slab_size_bytes_;
+
+    std::unique_ptr<detail::SharedMemoryMapping> mapping(new detail::SharedMemoryMapping(name, total_size));
+    if (mapping->exists()) {
+        // Only a pool whose creator is gone can be replaced
+        bool in_use = true;
+        try {
+            auto previous = open(name);
+            in_use        = detail::is_process_alive(previous->header_->creator_pid);
+        } catch (const HalException &) { in_use = false; }
+        if (in_use) {
+            throw HalException(HalErrorCode::OperationNotPermitted,
+                               "The shared memory buffer pool '" + name + "' is already used by another process.");
+        }
+        detail::SharedMemoryMapping::remove(name);
+        mapping.reset(new detail::SharedMemoryMapping(name, total_size));
+        if (mapping->exists()) {
+            throw HalException(HalErrorCode::OperationNotPermitted,
+                               "The shared memory buffer pool '" + name + "' is already used by another process.");
+        }
+    }
+
+    // The shared memory is zero-initialized: the atomics only need to be constructed
+    Header *shared_header = new (mapping->data()) Header();
+    for (uint32_t i = 0; i < config.n_slabs_; ++i) {
+        new (mapping->data() + slabs_offset + i * sizeof(Slab)) Slab();
+    }
+    std::memcpy(shared_header->magic, Magic, sizeof(Magic));
+    shared_header->version     = Version;
+    shared_header->n_slabs     = config.n_slabs_;
+    shared_header->slab_size   = config.slab_size_bytes_;
+    shared_header->data_offset = data_offset;
+    shared_header->total_size  = total_size;
+    shared_header->creator_pid = detail::get_current_process_id();
+    shared_header->ready.store(1, std::memory_order_release);
+
+    return std::shared_ptr<SharedMemoryBufferPool>(new SharedMemoryBufferPool(name, std::move(mapping)));
+}
+
+std::shared_ptr<SharedMemoryBufferPool> SharedMemoryBufferPool::open(const std::string &name) {
+    std::unique_ptr<detail::SharedMemoryMapping> mapping(new detail::SharedMemoryMapping(name));
+    const Header *shared_header = reinterpret_cast<const Header *>(mapping->data());
+    if (mapping->size() < sizeof(Header) || std::memcmp(shared_header->magic, Magic, sizeof(Magic)) != 0 ||
+        shared_header->version != Version || !shared_header->ready.load(std::memory_order_acquire) ||
+        mapping->size() < shared_header->total_size) {
+        throw HalException(HalErrorCode::FailedInitialization,
+                           "The shared memory '" + name + "' is not a buffer pool, or not ready yet.");
+    }
+    return std::shared_ptr<SharedMemoryBufferPool>(new SharedMemoryBufferPool(name, std::move(mapping)));
+}
+
+SharedMemoryBufferPool::SharedMemoryBufferPool(const std::string &name,
+                                               std::unique_ptr<detail::SharedMemoryMapping> mapping) :
+    name_(name),
+    mapping_(std::move(mapping)),
+    header_(reinterpret_cast<Header *>(mapping_->data())),
+    slabs_(reinterpret_cast<Slab *>(mapping_->data() + align(sizeof(Header)))) {}
+
+SharedMemoryBufferPool::~SharedMemoryBufferPool() = default;
+
+const std::string &SharedMemoryBufferPool::get_name() const {
+    return name_;
+}
+
+size_t SharedMemoryBufferPool::get_n_slabs() const {
+    return header_->n_slabs;
+}
+
+size_t SharedMemoryBufferPool::get_slab_size() const {
+    return header_->slab_size;
+}
+
+size_t SharedMemoryBufferPool::get_n_free_slabs() const {
+    size_t n_free_slabs = 0;
+    for (uint32_t i = 0; i < header_->n_slabs; ++i) {
+        if (get_refs(slabs_[i].state.load(std::memory_order_relaxed)) == 0) {
+            ++n_free_slabs;
+        }
+    }
+    return n_free_slabs;
+}
+
+uint64_t SharedMemoryBufferPool::get_n_dropped_buffers() const {
+    return header_->n_drops.load(std::memory_order_relaxed);
+}
+
+SharedMemoryBufferPool::Handle SharedMemoryBufferPool::acquire() {
+    const uint32_t n_slabs = header_->n_slabs;
+    const uint32_t first   = header_->next_slab.fetch_add(1, std::memory_order_relaxed) % n_slabs;
+    for (uint32_t i = 0; i < n_slabs; ++i) {
+        const uint32_t index = (first + i) % n_slabs;
+        uint64_t state       = slabs_[index].state.load(std::memory_order_relaxed);
+        if (get_refs(state) != 0) {
+            continue;
+        }
+        // The generation 0 is kept for the invalid handles
+        uint32_t generation = get_generation(state) + 1;
+        if (generation == 0) {
+            generation = 1;
+        }
+        if (slabs_[index].state.compare_exchange_strong(state, make_state(generation, 1), std::memory_order_acquire)) {
+            Handle handle;
+            handle.slab       = index;
+            handle.generation = generation;
+            handle.size       = header_->slab_size;
+            return handle;
+        }
+    }
+    header_->n_drops.fetch_add(1, std::memory_order_relaxed);
+    return Handle();
+}
+
+SharedMemoryBufferPool::Handle SharedMemoryBufferPool::write(const void *data, size_t size) {
+    if (size > header_->slab_size) {
+        throw HalException(HalErrorCode::InvalidArgument,
+                           "Unable to write " + std::to_string(size) + " bytes in slabs of " +
+                               std::to_string(header_->slab_size) + " bytes.");
+    }
+    Handle handle = acquire();
+    if (handle.valid()) {
+        std::memcpy(get_data(handle), data, size);
+        handle.size = size;
+    }
+    return handle;
+}
+
+SharedMemoryBufferPool::Slab &SharedMemoryBufferPool::get_slab(const Handle &handle) const {
+    if (!handle.valid() || handle.slab >= header_->n_slabs) {
+        throw HalException(HalErrorCode::InvalidArgument, "Invalid handle of a shared memory buffer.");
+    }
+    return slabs_[handle.slab];
+}
+
+uint8_t *SharedMemoryBufferPool::get_data(const Handle &handle) const {
+    const uint64_t state = get_slab(handle).state.load(std::memory_order_acquire);
+    if (get_generation(state) != handle.generation || get_refs(state) == 0) {
+        throw HalException(HalErrorCode::InvalidArgument, "The shared memory buffer has already been released.");
+    }
+    return mapping_->data() + header_->data_offset + uint64_t(handle.slab) * header_->slab_size;
+}
+
+void SharedMemoryBufferPool::add_reference(const Handle &handle) {
+    Slab &slab     = get_slab(handle);
+    uint64_t state = slab.state.load(std::memory_order_relaxed);
+    do {
+        if (get_generation(state) != handle.generation || get_refs(state) == 0) {
+            throw HalException(HalErrorCode::InvalidArgument, "The shared memory buffer has already been released.");
+        }
+    } while (!slab.state.compare_exchange_weak(state, state + 1, std::memory_order_relaxed));
+}
+
+void SharedMemoryBufferPool::release(const Handle &handle) {
+    Slab &slab     = get_slab(handle);
+    uint64_t state = slab.state.load(std::memory_order_relaxed);
+    do {
+        if (get_generation(state) != handle.generation || get_refs(state) == 0) {
+            throw HalException(HalErrorCode::InvalidArgument, "The shared memory buffer has already been released.");
+        }
+        // The release ordering makes the accesses to the data happen before the slab is reused
+    } while (!slab.state.compare_exchange_weak(state, state - 1, std::memory_order_release));
+}
+
+DataTransfer::BufferSlice SharedMemoryBufferPool::get_slice(const Handle &handle) {
+    uint8_t *data = get_data(handle);
+    if (handle.size > header_->slab_size) {
+        throw HalException(HalErrorCode::InvalidArgument, "Invalid handle of a shared memory buffer.");
+    }
+    auto self = shared_from_this();
+    std::shared_ptr<const void> owner(data, [self, handle](const void *) {
+        try {
+            self->release(handle);
+        } catch (const HalException &) {
+            // The reference has been released by another owner of the handle
+        }
+    });
+    return DataTransfer::BufferSlice(data, data + handle.size, owner);
+}
+
+} // namespace Metavision
@@ -0,0 +1,194 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "metavision/hal/utils/detail/shared_memory_mapping.h"
+#include "metavision/hal/utils/hal_error_code.h"
+#include "metavision/hal/utils/hal_exception.h"
+
+namespace Metavision {
+namespace detail {
+
+namespace {
+
+std::string get_os_name(const std::string &name) {
+#ifdef _WIN32
+    return "Local\\metavision_" + name;
+#else
+    return "/metavision_" + name;
+#endif
+}
+
+} // namespace
+
+SharedMemoryMapping::SharedMemoryMapping(const std::string &name, size_t size) :
+    os_name_(get_os_name(name)), size_(size), owner_(true) {
+#if defined(__ANDROID__)
+    throw HalException(HalErrorCode::OperationNotPermitted, "Shared memory is not supported on Android");
+#elif defined(_WIN32)
+    HANDLE mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, static_cast<DWORD>(size_ >> 32),
+                                        static_cast<DWORD>(size_ & 0xFFFFFFFF), os_name_.c_str());
+    if (mapping != NULL && GetLastError() == ERROR_ALREADY_EXISTS) {
+        CloseHandle(mapping);
+        exists_ = true;
+        return;
+    }
+    if (mapping == NULL) {
+        throw HalException(HalErrorCode::FailedInitialization, "Unable to create shared memory '" + os_name_ + "'");
+    }
+    mapping_ = mapping;
+    map();
+#else
+    int fd = shm_open(os_name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0 && errno == EEXIST) {
+        exists_ = true;
+        return;
+    }
+    if (fd < 0) {
+        throw HalException(HalErrorCode::FailedInitialization, "Unable to create shared memory '" + os_name_ + "'");
+    }
+    if (ftruncate(fd, static_cast<off_t>(size_)) != 0) {
+        ::close(fd);
+        shm_unlink(os_name_.c_str());
+        throw HalException(HalErrorCode::FailedInitialization,
+                           "Unable to allocate " + std::to_string(size_) + " bytes of shared memory");
+    }
+    map(fd);
+#endif
+}
+
+SharedMemoryMapping::SharedMemoryMapping(const std::string &name) : os_name_(get_os_name(name)), owner_(false) {
+#if defined(__ANDROID__)
+    throw HalException(HalErrorCode::OperationNotPermitted, "Shared memory is not supported on Android");
+#elif defined(_WIN32)
+    HANDLE mapping = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, os_name_.c_str());
+    if (mapping == NULL) {
+        throw HalException(HalErrorCode::CameraNotFound, "No shared memory '" + os_name_ + "'");
+    }
+    mapping_ = mapping;
+    map();
+    MEMORY_BASIC_INFORMATION info;
+    size_ = VirtualQuery(data_, &info, sizeof(info)) ? info.RegionSize : 0;
+#else
+    int fd = shm_open(os_name_.c_str(), O_RDWR, 0600);
+    if (fd < 0) {
+        throw HalException(HalErrorCode::CameraNotFound, "No shared memory '" + os_name_ + "'");
+    }
+    struct stat shm_stat;
+    if (fstat(fd, &shm_stat) != 0) {
+        ::close(fd);
+        throw HalException(HalErrorCode::FailedInitialization,
+                           "Unable to get size of shared memory '" + os_name_ + "'");
+    }
+    size_ = static_cast<size_t>(shm_stat.st_size);
+    map(fd);
+#endif
+}
+
+SharedMemoryMapping::~SharedMemoryMapping() {
+#ifdef _WIN32
+    if (data_) {
+        UnmapViewOfFile(data_);
+    }
+    if (mapping_) {
+        CloseHandle(static_cast<HANDLE>(mapping_));
+    }
+#else
+    if (data_) {
+        munmap(data_, size_);
+    }
+#ifndef __ANDROID__
+    if (owner_ && !exists_) {
+        // The processes that opened the object keep their mapping, only the name is removed
+        shm_unlink(os_name_.c_str());
+    }
+#endif
+#endif
+}
+
+void SharedMemoryMapping::remove(const std::string &name) {
+#if !defined(_WIN32) && !defined(__ANDROID__)
+    shm_unlink(get_os_name(name).c_str());
+#endif
+}
+
+bool SharedMemoryMapping::exists() const {
+    return exists_;
+}
+
+uint8_t *SharedMemoryMapping::data() const {
+    return data_;
+}
+
+size_t SharedMemoryMapping::size() const {
+    return size_;
+}
+
+#ifdef _WIN32
+void SharedMemoryMapping::map() {
+    data_ = static_cast<uint8_t *>(MapViewOfFile(static_cast<HANDLE>(mapping_), FILE_MAP_ALL_ACCESS, 0, 0, 0));
+    if (data_ == nullptr) {
+        CloseHandle(static_cast<HANDLE>(mapping_));
+        mapping_ = nullptr;
+        throw HalException(HalErrorCode::FailedInitialization, "Unable to map shared memory '" + os_name_ + "'");
+    }
+}
+#else
+void SharedMemoryMapping::map(int fd) {
+    void *data = size_ ? mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+    // The mapping keeps its own reference on the shared memory object
+    ::close(fd);
+    if (data == MAP_FAILED) {
+#ifndef __ANDROID__
+        if (owner_) {
+            shm_unlink(os_name_.c_str());
+        }
+#endif
+        throw HalException(HalErrorCode::FailedInitialization, "Unable to map shared memory '" + os_name_ + "'");
+    }
+    data_ = static_cast<uint8_t *>(data);
+}
+#endif
+
+int64_t get_current_process_id() {
+#ifdef _WIN32
+    return static_cast<int64_t>(GetCurrentProcessId());
+#else
+    return static_cast<int64_t>(getpid());
+#endif
+}
+
+bool is_process_alive(int64_t pid) {
+#ifdef _WIN32
+    HANDLE process = OpenProcess(SYNCHRONIZE, FALSE, static_cast<DWORD>(pid));
+    if (process == NULL) {
+        return GetLastError() == ERROR_ACCESS_DENIED;
+    }
+    const bool alive = WaitForSingleObject(process, 0) == WAIT_TIMEOUT;
+    CloseHandle(process);
+    return alive;
+#else
+    return kill(static_cast<pid_t>(pid), 0) == 0 || errno == EPERM;
+#endif
+}
+
+} // namespace detail
+} // namespace Metavision
@@ -0,0 +1,75 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <chrono>
+
+#include "metavision/hal/utils/shared_memory_raw_stream.h"
+
+namespace Metavision {
+
+SharedMemoryRawStream::RingBuffer::RingBuffer(const std::shared_ptr<SharedMemoryRing> &ring) :
+    ring_(ring), header_(ring->get_header()) {
+    setg(&header_[0], &header_[0], &header_[0] + header_.size());
+}
+
+SharedMemoryRawStream::RingBuffer::int_type SharedMemoryRawStream::RingBuffer::underflow() {
+    if (gptr() < egptr()) {
+        return traits_type::to_int_type(*gptr());
+    }
+
+    slice_.reset();
+    while (!ring_->is_closed()) {
+        slice_ = ring_->wait_next(std::chrono::milliseconds(100));
+        if (!slice_.empty()) {
+            char *begin = reinterpret_cast<char *>(slice_.data());
+            setg(begin, begin, begin + slice_.size());
+            return traits_type::to_int_type(*gptr());
+        }
+    }
+    setg(nullptr, nullptr, nullptr);
+    return traits_type::eof();
+}
+
+DataTransfer::BufferSlice SharedMemoryRawStream::RingBuffer::take_pending_slice() {
+    DataTransfer::BufferSlice pending;
+    if (gptr() < egptr() && !slice_.empty()) {
+        pending = DataTransfer::BufferSlice(reinterpret_cast<DataTransfer::Data *>(gptr()),
+                                            reinterpret_cast<DataTransfer::Data *>(egptr()),
+                                            std::make_shared<DataTransfer::BufferSlice>(slice_));
+    } else if (gptr() < egptr()) {
+        // The data left is the end of the header, which belongs to the buffer itself
+        auto remaining = std::make_shared<std::string>(gptr(), egptr());
+        pending        = DataTransfer::BufferSlice(reinterpret_cast<DataTransfer::Data *>(&(*remaining)[0]),
+                                                   reinterpret_cast<DataTransfer::Data *>(&(*remaining)[0]) +
+                                                       remaining->size(),
+                                                   remaining);
+    }
+    slice_.reset();
+    setg(nullptr, nullptr, nullptr);
+    return pending;
+}
+
+SharedMemoryRawStream::SharedMemoryRawStream(const std::string &name) :
+    std::istream(nullptr), ring_(SharedMemoryRing::open(name)), buffer_(new RingBuffer(ring_)) {
+    rdbuf(buffer_.get());
+}
+
+SharedMemoryRawStream::~SharedMemoryRawStream() {}
+
+const std::shared_ptr<SharedMemoryRing> &SharedMemoryRawStream::get_ring() const {
+    return ring_;
+}
+
+DataTransfer::BufferSlice SharedMemoryRawStream::take_pending_slice() {
+    return buffer_->take_pending_slice();
+}
+
+} // namespace Metavision
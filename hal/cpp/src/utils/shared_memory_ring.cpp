@@ -0,0 +1,303 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <new>
+#include <thread>
+
+#include "metavision/hal/utils/shared_memory_ring.h"
+#include "metavision/hal/utils/detail/shared_memory_mapping.h"
+#include "metavision/hal/utils/hal_error_code.h"
+#include "metavision/hal/utils/hal_exception.h"
+
+namespace Metavision {
+
+namespace {
+
+constexpr char Magic[]     = "metavision_shared_memory_ring";
+constexpr uint32_t Version = 1;
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "The atomics shared between processes must be lock free");
+
+constexpr uint64_t align(uint64_t offset) {
+    return (offset + 63) & ~uint64_t(63);
+}
+
+} // namespace
+
+struct SharedMemoryRing::Header {
+    char magic[sizeof(Magic)];
+    uint32_t version;
+    uint32_t n_slots;
+    uint64_t slot_size;
+    uint64_t raw_header_size;
+    uint64_t data_offset;
+    uint64_t total_size;
+    int64_t publisher_pid;
+    std::atomic<uint32_t> ready;
+    std::atomic<uint32_t> closed;
+    std::atomic<uint64_t> write_seq;
+    std::atomic<uint64_t> n_drops;
+    std::atomic<uint64_t> readers; // Bit mask of the registered readers
+    std::atomic<int64_t> reader_pids[MaxReaders];
+};
+
+struct alignas(64) SharedMemoryRing::Slot {
+    std::atomic<uint64_t> seq;     // Sequence number of the data in the slot, plus one (0 if never used)
+    std::atomic<uint64_t> readers; // Bit mask of the readers that have not released the slot yet
+    uint64_t size;
+};
+
+std::shared_ptr<SharedMemoryRing> SharedMemoryRing::create(const std::string &name, const std::string &header,
+                                                           const SharedMemoryRingConfig &config) {
+    if (name.empty() || name.find_first_of("/\\:") != std::string::npos) {
+        throw HalException(HalErrorCode::InvalidArgument, "Invalid shared memory ring name '" + name + "'.");
+    }
+    if (config.n_slots_ < 2 || config.slot_size_bytes_ == 0 || config.slot_size_bytes_ % 8 != 0) {
+        throw HalException(HalErrorCode::InvalidArgument,
+                           "A shared memory ring needs at least 2 slots, of a size multiple of 8 bytes.");
+    }
+
+    const uint64_t slots_offset = align(sizeof(Header));
+    const uint64_t data_offset  = align(slots_offset + config.n_slots_ * sizeof(Slot) + header.size());
+    const uint64_t total_size   = data_offset + uint64_t(config.n_slots_) * config.slot_size_bytes_;
+
+    std::unique_ptr<detail::SharedMemoryMapping> mapping(new detail::SharedMemoryMapping(name, total_size));
+    if (mapping->exists()) {
+        // Only a ring whose publisher is gone can be replaced
+        bool in_use = true;
+        try {
+            auto previous = open(name);
+            in_use        = detail::is_process_alive(previous->header_->publisher_pid);
+        } catch (const HalException &) { in_use = false; }
+        if (in_use) {
+            throw HalException(HalErrorCode::OperationNotPermitted,
+                               "The shared memory ring '" + name + "' is already published by another process.");
+        }
+        detail::SharedMemoryMapping::remove(name);
+        mapping.reset(new detail::SharedMemoryMapping(name, total_size));
+        if (mapping->exists()) {
+            throw HalException(HalErrorCode::OperationNotPermitted,
+                               "The shared memory ring '" + name + "' is already published by another process.");
+        }
+    }
+
+    // The shared memory is zero-initialized: the atomics only need to be constructed
+    Header *shared_header = new (mapping->data()) Header();
+    for (uint32_t i = 0; i < config.n_slots_; ++i) {
+        new (mapping->data() + slots_offset + i * sizeof(Slot)) Slot();
+    }
+    std::memcpy(shared_header->magic, Magic, sizeof(Magic));
+    shared_header->version         = Version;
+    shared_header->n_slots         = config.n_slots_;
+    shared_header->slot_size       = config.slot_size_bytes_;
+    shared_header->raw_header_size = header.size();
+    shared_header->data_offset     = data_offset;
+    shared_header->total_size      = total_size;
+    shared_header->publisher_pid   = detail::get_current_process_id();
+    std::memcpy(mapping->data() + slots_offset + config.n_slots_ * sizeof(Slot), header.data(), header.size());
+    shared_header->ready.store(1, std::memory_order_release);
+
+    return std::shared_ptr<SharedMemoryRing>(new SharedMemoryRing(name, std::move(mapping), true));
+}
+
+std::shared_ptr<SharedMemoryRing> SharedMemoryRing::open(const std::string &name) {
+    std::unique_ptr<detail::SharedMemoryMapping> mapping(new detail::SharedMemoryMapping(name));
+    const Header *shared_header = reinterpret_cast<const Header *>(mapping->data());
+    if (mapping->size() < sizeof(Header) || std::memcmp(shared_header->magic, Magic, sizeof(Magic)) != 0 ||
+        shared_header->version != Version || !shared_header->ready.load(std::memory_order_acquire) ||
+        mapping->size() < shared_header->total_size) {
+        throw HalException(HalErrorCode::FailedInitialization,
+                           "The shared memory '" + name + "' is not a ring of RAW data, or not ready yet.");
+    }
+    return std::shared_ptr<SharedMemoryRing>(new SharedMemoryRing(name, std::move(mapping), false));
+}
+
+SharedMemoryRing::SharedMemoryRing(const std::string &name, std::unique_ptr<detail::SharedMemoryMapping> mapping,
+                                   bool is_publisher) :
+    name_(name),
+    mapping_(std::move(mapping)),
+    header_(reinterpret_cast<Header *>(mapping_->data())),
+    slots_(reinterpret_cast<Slot *>(mapping_->data() + align(sizeof(Header)))),
+    is_publisher_(is_publisher) {
+    if (is_publisher_) {
+        return;
+    }
+
+    // A reader takes a bit that is neither registered nor left in a slot by a previous reader, see reclaim
+    uint64_t registered = header_->readers.load();
+    while (true) {
+        uint64_t used = registered;
+        for (uint32_t i = 0; i < header_->n_slots; ++i) {
+            used |= slots_[i].readers.load();
+        }
+        if (~used == 0) {
+            throw HalException(HalErrorCode::OperationNotPermitted,
+                               "The shared memory ring '" + name + "' already has too many readers.");
+        }
+        size_t reader = 0;
+        while (used & (uint64_t(1) << reader)) {
+            ++reader;
+        }
+        if (header_->readers.compare_exchange_weak(registered, registered | (uint64_t(1) << reader))) {
+            reader_ = reader;
+            break;
+        }
+    }
+    header_->reader_pids[reader_].store(detail::get_current_process_id());
+    next_seq_ = header_->write_seq.load(std::memory_order_acquire);
+}
+
+SharedMemoryRing::~SharedMemoryRing() {
+    if (is_publisher_) {
+        close();
+        return;
+    }
+
+    // The slots not read yet are released before the bit of the reader can be reused
+    const uint64_t bit = uint64_t(1) << reader_;
+    for (uint32_t i = 0; i < header_->n_slots; ++i) {
+        slots_[i].readers.fetch_and(~bit);
+    }
+    header_->reader_pids[reader_].store(0);
+    header_->readers.fetch_and(~bit);
+}
+
+const std::string &SharedMemoryRing::get_name() const {
+    return name_;
+}
+
+std::string SharedMemoryRing::get_header() const {
+    const char *raw_header =
+        reinterpret_cast<const char *>(mapping_->data() + align(sizeof(Header)) + header_->n_slots * sizeof(Slot));
+    return std::string(raw_header, header_->raw_header_size);
+}
+
+uint8_t *SharedMemoryRing::get_slot_data(uint64_t index) const {
+    return mapping_->data() + header_->data_offset + index * header_->slot_size;
+}
+
+bool SharedMemoryRing::publish(const uint8_t *data, size_t size) {
+    const uint64_t n_slots = header_->n_slots;
+    while (size > 0) {
+        const uint64_t seq = header_->write_seq.load(std::memory_order_relaxed);
+        Slot &slot         = slots_[seq % n_slots];
+        if (slot.readers.load(std::memory_order_acquire) != 0 && !reclaim(slot)) {
+            header_->n_drops.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        const size_t slot_size = std::min<size_t>(size, header_->slot_size);
+        std::memcpy(get_slot_data(seq % n_slots), data, slot_size);
+        slot.size = slot_size;
+        slot.readers.store(header_->readers.load(std::memory_order_acquire), std::memory_order_relaxed);
+        slot.seq.store(seq + 1, std::memory_order_release);
+        header_->write_seq.store(seq + 1, std::memory_order_release);
+        data += slot_size;
+        size -= slot_size;
+    }
+    return true;
+}
+
+bool SharedMemoryRing::reclaim(Slot &slot) {
+    // The bits of the readers that unregistered while the slot was published, or whose process died, are cleared
+    const uint64_t held       = slot.readers.load(std::memory_order_acquire);
+    const uint64_t registered = header_->readers.load(std::memory_order_acquire);
+    for (size_t reader = 0; reader < MaxReaders; ++reader) {
+        const uint64_t bit = uint64_t(1) << reader;
+        if (!(held & bit)) {
+            continue;
+        }
+        if (!(registered & bit)) {
+            slot.readers.fetch_and(~bit);
+            continue;
+        }
+        const int64_t pid = header_->reader_pids[reader].load();
+        // A pid of 0 is a reader being registered
+        if (pid != 0 && !detail::is_process_alive(pid)) {
+            remove_reader(reader);
+        }
+    }
+    return slot.readers.load(std::memory_order_acquire) == 0;
+}
+
+void SharedMemoryRing::remove_reader(size_t reader) {
+    const uint64_t bit = uint64_t(1) << reader;
+    for (uint32_t i = 0; i < header_->n_slots; ++i) {
+        slots_[i].readers.fetch_and(~bit);
+    }
+    header_->reader_pids[reader].store(0);
+    header_->readers.fetch_and(~bit);
+}
+
+void SharedMemoryRing::close() {
+    header_->closed.store(1, std::memory_order_release);
+}
+
+uint64_t SharedMemoryRing::get_n_dropped_buffers() const {
+    return header_->n_drops.load(std::memory_order_relaxed);
+}
+
+size_t SharedMemoryRing::get_n_readers() const {
+    uint64_t readers = header_->readers.load(std::memory_order_relaxed);
+    size_t n_readers = 0;
+    for (; readers; readers &= readers - 1) {
+        ++n_readers;
+    }
+    return n_readers;
+}
+
+DataTransfer::BufferSlice SharedMemoryRing::wait_next(std::chrono::milliseconds timeout) {
+    const uint64_t bit  = uint64_t(1) << reader_;
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    auto sleep_duration = std::chrono::microseconds(50);
+    while (true) {
+        const bool closed      = header_->closed.load(std::memory_order_acquire) != 0;
+        const uint64_t written = header_->write_seq.load(std::memory_order_acquire);
+        while (next_seq_ < written) {
+            const uint64_t index = next_seq_ % header_->n_slots;
+            const uint64_t seq   = next_seq_++;
+            Slot &slot           = slots_[index];
+            // Skips the slots published before the registration of the reader: once its bit is seen, the slot can not
+            // be reused until it is released
+            if (!(slot.readers.load(std::memory_order_acquire) & bit) ||
+                slot.seq.load(std::memory_order_acquire) != seq + 1) {
+                continue;
+            }
+
+            auto self = shared_from_this();
+            std::shared_ptr<const void> owner(get_slot_data(index), [self, index, bit](const void *) {
+                self->slots_[index].readers.fetch_and(~bit, std::memory_order_acq_rel);
+            });
+            return DataTransfer::BufferSlice(get_slot_data(index), get_slot_data(index) + slot.size, owner);
+        }
+
+        if (closed) {
+            closed_ = true;
+            return DataTransfer::BufferSlice();
+        }
+        const auto now = std::chrono::steady_clock::now();
+        if (now >= deadline) {
+            return DataTransfer::BufferSlice();
+        }
+        // The publisher is polled, with a period growing up to 1ms while no data is published
+        std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(sleep_duration, deadline - now));
+        sleep_duration = std::min(sleep_duration * 2, std::chrono::microseconds(1000));
+    }
+}
+
+bool SharedMemoryRing::is_closed() const {
+    return closed_;
+}
+
+} // namespace Metavision
@@ -0,0 +1,168 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+#include "metavision/hal/utils/striped_raw_file_writer.h"
+#include "metavision/hal/utils/hal_error_code.h"
+#include "metavision/hal/utils/hal_exception.h"
+
+namespace Metavision {
+
+namespace {
+
+const std::string StripeSizeField = "% stripe_size";
+
+bool is_absolute(const std::string &path) {
+    return (!path.empty() && (path[0] == '/' || path[0] == '\\')) || (path.size() > 1 && path[1] == ':');
+}
+
+// Returns the path of the directory containing @p path, empty if it is in the current directory
+std::string get_parent_path(const std::string &path) {
+    const auto pos = path.find_last_of("/\\");
+    return pos == std::string::npos ? std::string() : path.substr(0, pos);
+}
+
+std::string resolve(const std::string &directory, const std::string &path) {
+    return directory.empty() || is_absolute(path) ? path : directory + "/" + path;
+}
+
+} // namespace
+
+constexpr const char *StripedRawFileWriter::ManifestExtension;
+
+StripedRawFileWriter::StripedRawFileWriter(const std::string &manifest_path, const std::string &header,
+                                           const StripedRawFileWriterConfig &config) :
+    stripe_size_(config.stripe_size_) {
+    if (config.directories_.empty()) {
+        throw HalException(HalErrorCode::InvalidArgument, "A striped recording needs at least one directory.");
+    }
+    if (stripe_size_ == 0) {
+        throw HalException(HalErrorCode::InvalidArgument, "The stripe size of a striped recording can not be null.");
+    }
+    if (config.writer_config_.compression_ != RawCompression::None) {
+        throw HalException(HalErrorCode::InvalidArgument, "A striped recording can not be compressed.");
+    }
+
+    // The stripe files are named after the manifest
+    const std::string manifest_directory = get_parent_path(manifest_path);
+    std::string stem = manifest_path.substr(manifest_directory.empty() ? 0 : manifest_directory.size() + 1);
+    if (is_manifest(stem)) {
+        stem.resize(stem.size() - std::string(ManifestExtension).size());
+    }
+
+    std::ofstream manifest(manifest_path);
+    if (!manifest) {
+        throw HalException(HalErrorCode::FailedInitialization,
+                           "Unable to write the manifest of the striped recording '" + manifest_path + "'");
+    }
+    manifest << StripeSizeField << " " << stripe_size_ << "\n";
+    for (size_t i = 0; i < config.directories_.size(); ++i) {
+        const std::string stripe_file = resolve(config.directories_[i], stem + "_" + std::to_string(i) + ".raw");
+        manifest << stripe_file << "\n";
+        stripe_files_.push_back(resolve(manifest_directory, stripe_file));
+        writers_.emplace_back(new AsyncRawFileWriter(stripe_files_.back(), header, config.writer_config_));
+    }
+    if (!manifest.flush()) {
+        throw HalException(HalErrorCode::FailedInitialization,
+                           "Unable to write the manifest of the striped recording '" + manifest_path + "'");
+    }
+}
+
+StripedRawFileWriter::~StripedRawFileWriter() = default;
+
+void StripedRawFileWriter::write(const DataTransfer::BufferSlice &slice) {
+    // The slices referring to parts of the buffer share the reference held on it
+    std::shared_ptr<const DataTransfer::BufferSlice> owner;
+    DataTransfer::Data *begin = slice.data();
+    DataTransfer::Data *end   = begin + slice.size();
+    while (begin != end) {
+        const size_t size = std::min<size_t>(end - begin, stripe_size_ - current_position_);
+        if (size == slice.size()) {
+            writers_[current_writer_]->write(slice);
+        } else {
+            if (!owner) {
+                owner = std::make_shared<const DataTransfer::BufferSlice>(slice);
+            }
+            writers_[current_writer_]->write(DataTransfer::BufferSlice(begin, begin + size, owner));
+        }
+        begin += size;
+        current_position_ += size;
+        if (current_position_ == stripe_size_) {
+            current_position_ = 0;
+            current_writer_   = (current_writer_ + 1) % writers_.size();
+        }
+    }
+}
+
+const std::vector<std::string> &StripedRawFileWriter::get_stripe_files() const {
+    return stripe_files_;
+}
+
+size_t StripedRawFileWriter::get_queue_depth() const {
+    size_t depth = 0;
+    for (const auto &writer : writers_) {
+        depth += writer->get_queue_depth();
+    }
+    return depth;
+}
+
+size_t StripedRawFileWriter::get_bytes_behind() const {
+    size_t bytes = 0;
+    for (const auto &writer : writers_) {
+        bytes += writer->get_bytes_behind();
+    }
+    return bytes;
+}
+
+bool StripedRawFileWriter::is_manifest(const std::string &path) {
+    const std::string extension(ManifestExtension);
+    return path.size() > extension.size() &&
+           path.compare(path.size() - extension.size(), extension.size(), extension) == 0;
+}
+
+StripedRawFileWriter::Manifest StripedRawFileWriter::read_manifest(const std::string &manifest_path) {
+    std::ifstream ifs(manifest_path);
+    if (!ifs) {
+        throw HalException(HalErrorCode::FailedInitialization,
+                           "Unable to read the manifest of the striped recording '" + manifest_path + "'");
+    }
+
+    Manifest manifest;
+    std::string line;
+    if (std::getline(ifs, line) && line.compare(0, StripeSizeField.size(), StripeSizeField) == 0) {
+        std::istringstream iss(line.substr(StripeSizeField.size()));
+        iss >> manifest.stripe_size;
+    }
+    if (manifest.stripe_size == 0) {
+        throw HalException(HalErrorCode::InvalidArgument,
+                           "Invalid stripe size in the manifest of the striped recording '" + manifest_path + "'");
+    }
+
+    const std::string manifest_directory = get_parent_path(manifest_path);
+    while (std::getline(ifs, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (!line.empty()) {
+            manifest.stripe_files.push_back(resolve(manifest_directory, line));
+        }
+    }
+    if (manifest.stripe_files.empty()) {
+        throw HalException(HalErrorCode::InvalidArgument,
+                           "No stripe file in the manifest of the striped recording '" + manifest_path + "'");
+    }
+    return manifest;
+}
+
+} // namespace Metavision
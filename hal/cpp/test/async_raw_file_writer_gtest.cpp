@@ -0,0 +1,106 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include "metavision/utils/gtest/gtest_with_tmp_dir.h"
+#include "metavision/hal/utils/async_raw_file_writer.h"
+#include "metavision/hal/utils/hal_exception.h"
+
+using namespace Metavision;
+
+class AsyncRawFileWriter_GTest : public GTestWithTmpDir {
+protected:
+    virtual void SetUp() override {
+        static int file_counter = 0;
+        filename_               = tmpdir_handler_->get_full_path("record_" + std::to_string(++file_counter) + ".raw");
+
+        data_ = std::make_shared<std::vector<uint8_t>>(30011);
+        std::iota(data_->begin(), data_->end(), 0);
+    }
+
+    // Writes the test data in slices of @p slice_size bytes
+    void write_data(AsyncRawFileWriter &writer, size_t slice_size) {
+        for (size_t offset = 0; offset < data_->size(); offset += slice_size) {
+            const size_t end = std::min(data_->size(), offset + slice_size);
+            writer.write(DataTransfer::BufferSlice(data_->data() + offset, data_->data() + end, data_));
+        }
+    }
+
+    std::vector<uint8_t> read_file() {
+        std::ifstream ifs(filename_, std::ios::binary);
+        return std::vector<uint8_t>(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+    }
+
+    std::vector<uint8_t> expected_content(const std::string &header) {
+        std::vector<uint8_t> content(header.begin(), header.end());
+        content.insert(content.end(), data_->begin(), data_->end());
+        return content;
+    }
+
+    std::string filename_;
+    std::shared_ptr<std::vector<uint8_t>> data_;
+};
+
+TEST_F(AsyncRawFileWriter_GTest, throws_if_file_can_not_be_opened) {
+    ASSERT_THROW(AsyncRawFileWriter(tmpdir_handler_->get_full_path("unknown/record.raw"), ""), HalException);
+}
+
+TEST_F(AsyncRawFileWriter_GTest, writes_header_and_data_in_order) {
+    const std::string header = "% header\n% end\n";
+    {
+        AsyncRawFileWriterConfig config;
+        config.batch_size_ = 1; // rounded up to one block, so that several batches are needed
+        AsyncRawFileWriter writer(filename_, header, config);
+        write_data(writer, 1000);
+    }
+
+    ASSERT_EQ(expected_content(header), read_file());
+}
+
+TEST_F(AsyncRawFileWriter_GTest, writes_same_data_with_direct_io) {
+    // Direct I/O may not be supported by the file system of the temporary directory, in which case the writer falls
+    // back to buffered writes: the content of the file must be the same anyway
+    const std::string header = "% header\n% end\n";
+    {
+        AsyncRawFileWriterConfig config;
+        config.batch_size_    = 2 * AsyncRawFileWriter::Alignment;
+        config.use_direct_io_ = true;
+        AsyncRawFileWriter writer(filename_, header, config);
+        write_data(writer, 777);
+    }
+
+    ASSERT_EQ(expected_content(header), read_file());
+}
+
+TEST_F(AsyncRawFileWriter_GTest, buffers_are_released_once_written) {
+    AsyncRawFileWriterConfig config;
+    config.flush_period_ms_ = 1;
+    AsyncRawFileWriter writer(filename_, "", config);
+    write_data(writer, 1000);
+
+    // WHEN waiting for the flush period to elapse
+    for (int i = 0; i < 1000 && writer.get_queue_depth() != 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+
+    // THEN the writer is no longer behind, and holds no more references on the data
+    ASSERT_EQ(0, writer.get_queue_depth());
+    ASSERT_EQ(0, writer.get_bytes_behind());
+    ASSERT_EQ(1, data_.use_count());
+    ASSERT_FALSE(writer.has_failed());
+}
@@ -0,0 +1,195 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include "metavision/utils/gtest/gtest_with_tmp_dir.h"
+#include "metavision/hal/utils/async_raw_file_writer.h"
+#include "metavision/hal/utils/compressed_raw_file.h"
+#include "metavision/hal/utils/compressed_raw_file_stream.h"
+#include "metavision/hal/utils/hal_exception.h"
+#include "metavision/hal/utils/raw_file_header.h"
+
+using namespace Metavision;
+
+namespace {
+
+// Data looking like a stream of events: few distinct words with noise in their low bits
+std::vector<uint8_t> make_event_like_data(size_t size) {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<uint32_t> dist(0, 15);
+    std::vector<uint8_t> data(size);
+    for (size_t i = 0; i + 4 <= size; i += 4) {
+        const uint32_t word = 0x20000000u | ((i / 400) << 11) | dist(gen);
+        std::memcpy(data.data() + i, &word, sizeof(word));
+    }
+    return data;
+}
+
+std::vector<uint8_t> round_trip(const std::vector<uint8_t> &data) {
+    std::vector<uint8_t> chunk;
+    compress_raw_chunk(data.data(), data.size(), RawCompression::LZ4, chunk);
+
+    CompressedRawChunkHeader header;
+    std::memcpy(&header, chunk.data(), sizeof(header));
+    EXPECT_EQ(data.size(), header.raw_size_);
+    EXPECT_EQ(chunk.size(), sizeof(header) + header.compressed_size_);
+
+    std::vector<uint8_t> decompressed(header.raw_size_);
+    EXPECT_TRUE(decompress_raw_chunk(header, chunk.data() + sizeof(header), RawCompression::LZ4, decompressed.data()));
+    return decompressed;
+}
+
+} // namespace
+
+class CompressedRawFile_GTest : public GTestWithTmpDir {
+protected:
+    virtual void SetUp() override {
+        static int file_counter = 0;
+        filename_               = tmpdir_handler_->get_full_path("record_" + std::to_string(++file_counter) + ".raw");
+        data_ = std::make_shared<std::vector<uint8_t>>(make_event_like_data(300000));
+    }
+
+    // Records the test data in a compressed file, and returns the header written
+    std::string write_compressed_file(size_t chunk_size) {
+        RawFileHeader header;
+        header.set_field("format", "EVT3");
+        set_raw_file_compression(header, RawCompression::LZ4, chunk_size);
+        std::ostringstream header_stream;
+        header_stream << header;
+
+        AsyncRawFileWriterConfig config;
+        config.compression_            = RawCompression::LZ4;
+        config.compression_chunk_size_ = chunk_size;
+        AsyncRawFileWriter writer(filename_, header_stream.str(), config);
+        for (size_t offset = 0; offset < data_->size(); offset += 7000) {
+            const size_t end = std::min(data_->size(), offset + 7000);
+            writer.write(DataTransfer::BufferSlice(data_->data() + offset, data_->data() + end, data_));
+        }
+        return header_stream.str();
+    }
+
+    std::string filename_;
+    std::shared_ptr<std::vector<uint8_t>> data_;
+};
+
+TEST_F(CompressedRawFile_GTest, round_trip_of_compressible_data) {
+    const auto data = make_event_like_data(100000);
+    ASSERT_EQ(data, round_trip(data));
+
+    std::vector<uint8_t> chunk;
+    compress_raw_chunk(data.data(), data.size(), RawCompression::LZ4, chunk);
+    ASSERT_LT(chunk.size(), data.size());
+}
+
+TEST_F(CompressedRawFile_GTest, round_trip_of_small_and_repetitive_data) {
+    for (size_t size : {0, 1, 12, 13, 17, 100, 70000}) {
+        ASSERT_EQ(std::vector<uint8_t>(size, 0xAB), round_trip(std::vector<uint8_t>(size, 0xAB)));
+    }
+}
+
+TEST_F(CompressedRawFile_GTest, incompressible_data_is_stored_as_is) {
+    std::mt19937 gen(0);
+    std::vector<uint8_t> data(10000);
+    for (auto &byte : data) {
+        byte = static_cast<uint8_t>(gen());
+    }
+    std::vector<uint8_t> chunk;
+    compress_raw_chunk(data.data(), data.size(), RawCompression::LZ4, chunk);
+    ASSERT_EQ(sizeof(CompressedRawChunkHeader) + data.size(), chunk.size());
+    ASSERT_EQ(data, round_trip(data));
+}
+
+TEST_F(CompressedRawFile_GTest, corrupted_data_is_detected) {
+    const auto data = make_event_like_data(10000);
+    std::vector<uint8_t> chunk;
+    compress_raw_chunk(data.data(), data.size(), RawCompression::LZ4, chunk);
+    CompressedRawChunkHeader header;
+    std::memcpy(&header, chunk.data(), sizeof(header));
+
+    std::vector<uint8_t> decompressed(header.raw_size_);
+    header.raw_size_ += 1;
+    decompressed.resize(header.raw_size_);
+    ASSERT_FALSE(decompress_raw_chunk(header, chunk.data() + sizeof(header), RawCompression::LZ4, decompressed.data()));
+}
+
+TEST_F(CompressedRawFile_GTest, compression_is_recorded_in_header) {
+    RawFileHeader header;
+    ASSERT_EQ(RawCompression::None, get_raw_file_compression(header));
+    set_raw_file_compression(header, RawCompression::LZ4, 1024);
+    ASSERT_EQ(RawCompression::LZ4, get_raw_file_compression(header));
+    set_raw_file_compression(header, RawCompression::None, 1024);
+    ASSERT_EQ(RawCompression::None, get_raw_file_compression(header));
+}
+
+TEST_F(CompressedRawFile_GTest, stream_reads_header_and_decompressed_data) {
+    const std::string header = write_compressed_file(16384);
+    ASSERT_TRUE(CompressedRawFileStream::is_compressed(filename_));
+
+    CompressedRawFileStream stream(filename_, 3);
+    ASSERT_EQ((data_->size() + 16383) / 16384, stream.get_n_chunks());
+    ASSERT_EQ(header.size() + data_->size(), stream.get_size());
+
+    RawFileHeader read_header(stream);
+    ASSERT_EQ("EVT3", read_header.get_field("format"));
+    ASSERT_EQ(static_cast<std::streamoff>(header.size()), static_cast<std::streamoff>(stream.tellg()));
+
+    std::vector<uint8_t> data(data_->size() + 10);
+    stream.read(reinterpret_cast<char *>(data.data()), data.size());
+    ASSERT_EQ(static_cast<std::streamsize>(data_->size()), stream.gcount());
+    data.resize(data_->size());
+    ASSERT_EQ(*data_, data);
+}
+
+TEST_F(CompressedRawFile_GTest, stream_seeks_in_decompressed_data) {
+    const std::string header = write_compressed_file(10000);
+    CompressedRawFileStream stream(filename_);
+
+    for (size_t offset : {123456, 10000, 0, 299990}) {
+        stream.clear();
+        stream.seekg(header.size() + offset);
+        ASSERT_EQ(static_cast<std::streamoff>(header.size() + offset), static_cast<std::streamoff>(stream.tellg()));
+        std::vector<uint8_t> data(10);
+        stream.read(reinterpret_cast<char *>(data.data()), data.size());
+        ASSERT_TRUE(std::equal(data.begin(), data.end(), data_->begin() + offset));
+    }
+}
+
+TEST_F(CompressedRawFile_GTest, stream_ignores_truncated_chunk) {
+    write_compressed_file(100000);
+    std::vector<char> content;
+    {
+        std::ifstream ifs(filename_, std::ios::binary);
+        content.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+    }
+    {
+        std::ofstream ofs(filename_, std::ios::binary);
+        ofs.write(content.data(), content.size() - 10);
+    }
+
+    CompressedRawFileStream stream(filename_);
+    ASSERT_EQ(2u, stream.get_n_chunks());
+}
+
+TEST_F(CompressedRawFile_GTest, stream_throws_on_uncompressed_file) {
+    {
+        std::ofstream ofs(filename_, std::ios::binary);
+        ofs << RawFileHeader() << "data";
+    }
+    ASSERT_FALSE(CompressedRawFileStream::is_compressed(filename_));
+    ASSERT_THROW(CompressedRawFileStream stream(filename_), HalException);
+}
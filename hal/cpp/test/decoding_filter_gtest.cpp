@@ -0,0 +1,168 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <cstring>
+#include <memory>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "metavision/hal/facilities/i_decoder.h"
+#include "metavision/hal/facilities/i_event_decoder.h"
+#include "metavision/hal/utils/decoding_filter.h"
+#include "metavision/hal/utils/hal_exception.h"
+
+using namespace Metavision;
+
+namespace {
+
+// Decoder of raw data made of EventCD, which does not apply the filter itself
+class EventCDDecoder : public I_Decoder {
+public:
+    EventCDDecoder(const std::shared_ptr<I_EventDecoder<EventCD>> &event_cd_decoder) :
+        I_Decoder(false, event_cd_decoder) {}
+
+    timestamp get_last_timestamp() const override {
+        return last_timestamp_;
+    }
+
+    bool get_timestamp_shift(timestamp &timestamp_shift) const override {
+        return false;
+    }
+
+    uint8_t get_raw_event_size_bytes() const override {
+        return sizeof(EventCD);
+    }
+
+private:
+    void decode_impl(RawData *raw_data_begin, RawData *raw_data_end) override {
+        for (; raw_data_begin != raw_data_end; raw_data_begin += sizeof(EventCD)) {
+            EventCD ev;
+            std::memcpy(&ev, raw_data_begin, sizeof(EventCD));
+            cd_event_forwarder().forward(ev.x, ev.y, ev.p, ev.t);
+            last_timestamp_ = ev.t;
+        }
+    }
+
+    timestamp last_timestamp_{0};
+};
+
+} // namespace
+
+TEST(DecodingFilter_GTest, regions_polarities_and_decimation) {
+    DecodingFilter filter(100, 50);
+
+    // By default, all the events of the sensor are accepted
+    EXPECT_TRUE(filter.is_accepted(0, 0, 0));
+    EXPECT_TRUE(filter.is_accepted(99, 49, 1));
+    EXPECT_FALSE(filter.is_accepted(100, 0, 0));
+    EXPECT_FALSE(filter.is_accepted(0, 50, 0));
+    EXPECT_FALSE(filter.is_decimating());
+
+    // WHEN setting regions of interest, one of them out of the sensor
+    filter.set_rois({DeviceRoi(60, 10, 10, 5), DeviceRoi(95, 40, 20, 20)});
+
+    // THEN only their pixels are accepted, and the rows without pixel accepted are known
+    EXPECT_TRUE(filter.is_accepted(60, 10, 0));
+    EXPECT_TRUE(filter.is_accepted(69, 14, 1));
+    EXPECT_FALSE(filter.is_accepted(70, 14, 1));
+    EXPECT_FALSE(filter.is_accepted(60, 15, 1));
+    EXPECT_TRUE(filter.is_accepted(99, 49, 1));
+    EXPECT_FALSE(filter.is_row_accepted(9));
+    EXPECT_TRUE(filter.is_row_accepted(10));
+    EXPECT_FALSE(filter.is_row_accepted(-1));
+    EXPECT_FALSE(filter.is_row_accepted(50));
+    EXPECT_EQ(0x3FFu, filter.get_row_mask(60, 12, 32));
+    EXPECT_EQ(0xFF0u, filter.get_row_mask(56, 12, 12));
+    EXPECT_EQ(0u, filter.get_row_mask(60, 20, 12));
+    EXPECT_EQ(0x1Fu, filter.get_row_mask(95, 45, 12));
+    EXPECT_EQ(0u, filter.get_row_mask(100, 45, 12));
+
+    // WHEN rejecting a polarity
+    filter.set_polarities(false, true);
+    EXPECT_FALSE(filter.is_accepted(60, 10, 0));
+    EXPECT_TRUE(filter.is_accepted(60, 10, 1));
+
+    // WHEN decimating the events, one out of 3 is kept
+    filter.set_decimation(3);
+    EXPECT_TRUE(filter.is_decimating());
+    std::vector<bool> kept;
+    for (int i = 0; i < 6; ++i) {
+        kept.push_back(filter.decimate());
+    }
+    EXPECT_EQ(std::vector<bool>({true, false, false, true, false, false}), kept);
+}
+
+TEST(DecodingFilter_GTest, masked_pixels) {
+    DecodingFilter filter(100, 50);
+    filter.set_rois({DeviceRoi(0, 0, 100, 20)});
+
+    // WHEN masking pixels, one of them in a row with no other pixel accepted
+    std::vector<std::uint64_t> mask((100 * 50 + 63) / 64, 0);
+    auto mask_pixel = [&mask](int x, int y) { mask[(y * 100 + x) / 64] |= std::uint64_t(1) << ((y * 100 + x) % 64); };
+    mask_pixel(3, 2);
+    mask_pixel(70, 2);
+    mask_pixel(99, 49);
+    filter.set_masked_pixels(mask);
+
+    // THEN their events are rejected, and the other pixels are still accepted
+    EXPECT_FALSE(filter.is_accepted(3, 2, 0));
+    EXPECT_FALSE(filter.is_accepted(70, 2, 1));
+    EXPECT_TRUE(filter.is_accepted(4, 2, 0));
+    EXPECT_TRUE(filter.is_accepted(3, 3, 0));
+    EXPECT_EQ(0xFFFFFFF7u, filter.get_row_mask(0, 2, 32));
+    EXPECT_TRUE(filter.is_row_accepted(2));
+
+    // WHEN changing the regions of interest, the pixels stay masked
+    filter.set_rois({DeviceRoi(99, 49, 1, 1), DeviceRoi(0, 0, 10, 10)});
+    EXPECT_FALSE(filter.is_row_accepted(49));
+    EXPECT_FALSE(filter.is_accepted(3, 2, 0));
+    EXPECT_TRUE(filter.is_accepted(4, 2, 0));
+
+    // WHEN clearing the mask, all the pixels of the regions are accepted again
+    filter.set_masked_pixels({});
+    EXPECT_TRUE(filter.is_row_accepted(49));
+    EXPECT_TRUE(filter.is_accepted(3, 2, 0));
+}
+
+TEST(DecodingFilter_GTest, invalid_arguments) {
+    EXPECT_THROW(DecodingFilter(0, 10), HalException);
+    DecodingFilter filter(10, 10);
+    EXPECT_THROW(filter.set_decimation(0), HalException);
+    EXPECT_THROW(filter.set_masked_pixels(std::vector<std::uint64_t>(1, 0)), HalException);
+}
+
+TEST(DecodingFilter_GTest, applied_to_decoded_buffers_by_other_decoders) {
+    auto cd_decoder = std::make_shared<I_EventDecoder<EventCD>>();
+    std::vector<EventCD> output;
+    cd_decoder->add_event_buffer_callback(
+        [&output](const EventCD *begin, const EventCD *end) { output.insert(output.end(), begin, end); });
+    EventCDDecoder decoder(cd_decoder);
+
+    // GIVEN a decoder that does not apply the filter itself, with a filter of the CD events
+    DecodingFilter filter(640, 480);
+    filter.set_rois({DeviceRoi(0, 0, 320, 480)});
+    filter.set_decimation(2);
+    decoder.set_cd_event_filter(filter);
+
+    // WHEN decoding events, more than a buffer of the forwarder
+    std::vector<EventCD> events;
+    for (int i = 0; i < 2000; ++i) {
+        events.emplace_back(i % 640, i % 480, i % 2, i);
+    }
+    auto begin = reinterpret_cast<I_Decoder::RawData *>(events.data());
+    decoder.decode(begin, begin + events.size() * sizeof(EventCD));
+
+    // THEN the events are filtered before being forwarded
+    ASSERT_EQ(520, output.size());
+    for (size_t i = 0; i < output.size(); ++i) {
+        EXPECT_EQ(static_cast<timestamp>((i / 160) * 640 + (i % 160) * 2), output[i].t);
+    }
+}
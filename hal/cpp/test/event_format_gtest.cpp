@@ -0,0 +1,87 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "metavision/hal/utils/event_format.h"
+
+using namespace Metavision;
+
+namespace {
+// 64-bit format whose fields are not in the order of an EventCD, with x at offset 0
+using Format64 = CDEventFormat<uint64_t, EventFormatField<20, 40>, EventFormatField<0, 12>, EventFormatField<60, 4>,
+                               EventFormatField<12, 1>>;
+// 32-bit format, unpacked without the vectorized path
+using Format32 =
+    CDEventFormat<uint32_t, EventFormatField<0, 10>, EventFormatField<10, 11>, EventFormatField<21, 10>,
+                  EventFormatField<31, 1>>;
+
+template<typename Format>
+std::vector<typename Format::WordType> make_words(size_t n) {
+    std::mt19937_64 gen(42);
+    std::vector<typename Format::WordType> words(n);
+    for (auto &w : words) {
+        w = static_cast<typename Format::WordType>(gen());
+    }
+    return words;
+}
+
+void expect_eq(const EventCD &expected, const EventCD &ev) {
+    EXPECT_EQ(expected.x, ev.x);
+    EXPECT_EQ(expected.y, ev.y);
+    EXPECT_EQ(expected.p, ev.p);
+    EXPECT_EQ(expected.t, ev.t);
+}
+} // namespace
+
+TEST(EventFormat_GTest, encode_and_decode) {
+    const auto word = Format64::encode(4000, 9, 1, 123456789012);
+    EXPECT_EQ(4000, Format64::X::get(word));
+    EXPECT_EQ(9, Format64::Y::get(word));
+    EXPECT_EQ(1, Format64::Polarity::get(word));
+    EXPECT_EQ(123456789012 - 12, Format64::get_time(word, 12));
+    expect_eq(EventCD(4000, 9, 1, 123456789012 - 12), Format64::decode(word, 12));
+
+    // The values are truncated to the number of bits of their fields
+    expect_eq(EventCD(2047, 0, 1, 1023), Format32::decode(Format32::encode(2047 + 2048, 1024, 3, 1023 + 1024)));
+}
+
+TEST(EventFormat_GTest, unpack_events) {
+    // Sizes covering the vectorized blocks and the remaining events
+    for (size_t n : {0, 1, 2, 3, 4, 5, 7, 8, 9, 1001}) {
+        const auto words64 = make_words<Format64>(n);
+        std::vector<EventCD> events(n);
+        Format64::unpack(words64.data(), n, 1000, events.data());
+        for (size_t i = 0; i < n; ++i) {
+            expect_eq(Format64::decode(words64[i], 1000), events[i]);
+        }
+
+        const auto words32 = make_words<Format32>(n);
+        Format32::unpack(words32.data(), n, 0, events.data());
+        for (size_t i = 0; i < n; ++i) {
+            expect_eq(Format32::decode(words32[i]), events[i]);
+        }
+    }
+}
+
+TEST(EventFormat_GTest, unpack_fields) {
+    const size_t n     = 333;
+    const auto words64 = make_words<Format64>(n);
+    std::vector<unsigned short> x(n), y(n);
+    std::vector<short> p(n);
+    std::vector<timestamp> t(n);
+    Format64::unpack(words64.data(), n, 7, x.data(), y.data(), p.data(), t.data());
+    for (size_t i = 0; i < n; ++i) {
+        expect_eq(Format64::decode(words64[i], 7), EventCD(x[i], y[i], p[i], t[i]));
+    }
+}
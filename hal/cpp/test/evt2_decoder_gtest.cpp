@@ -0,0 +1,572 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "metavision/hal/decoders/evt2_decoder.h"
+#include "metavision/hal/decoders/detail/evt2_raw_format.h"
+#include "metavision/hal/facilities/i_event_decoder.h"
+#include "metavision/hal/utils/hal_exception.h"
+
+using namespace Metavision;
+
+namespace {
+
+uint32_t make_time_high(timestamp t) {
+    return (static_cast<uint32_t>(Evt2::EventTypes::EVT_TIME_HIGH) << Evt2::TypeShift) |
+           static_cast<uint32_t>((t >> Evt2::TimestampLsbBits) & Evt2::TsMsbMask);
+}
+
+uint32_t make_cd(unsigned short x, unsigned short y, short p, timestamp t) {
+    return (static_cast<uint32_t>(p ? Evt2::EventTypes::CD_HIGH : Evt2::EventTypes::CD_LOW) << Evt2::TypeShift) |
+           (static_cast<uint32_t>(t & Evt2::TsLsbMask) << Evt2::TimestampShift) | (x << Evt2::XShift) | y;
+}
+
+uint32_t make_trigger(short p, timestamp t, short id) {
+    return (static_cast<uint32_t>(Evt2::EventTypes::EXT_TRIGGER) << Evt2::TypeShift) |
+           (static_cast<uint32_t>(t & Evt2::TsLsbMask) << Evt2::TimestampShift) | (id << Evt2::TriggerIdShift) | p;
+}
+
+} // namespace
+
+class EVT2Decoder_GTest : public ::testing::Test {
+protected:
+    void create_decoder(bool time_shifting_enabled) {
+        cd_decoder_      = std::make_shared<I_EventDecoder<EventCD>>();
+        trigger_decoder_ = std::make_shared<I_EventDecoder<EventExtTrigger>>();
+        decoder_         = std::make_shared<EVT2Decoder>(time_shifting_enabled, cd_decoder_, trigger_decoder_);
+        cd_decoder_->add_event_buffer_callback(
+            [this](const EventCD *begin, const EventCD *end) { cds_.insert(cds_.end(), begin, end); });
+        trigger_decoder_->add_event_buffer_callback([this](const EventExtTrigger *begin, const EventExtTrigger *end) {
+            triggers_.insert(triggers_.end(), begin, end);
+        });
+    }
+
+    void decode(std::vector<uint32_t> &words, size_t split_size = 0) {
+        auto begin = reinterpret_cast<I_Decoder::RawData *>(words.data());
+        auto end   = begin + words.size() * sizeof(uint32_t);
+        if (split_size == 0) {
+            decoder_->decode(begin, end);
+            return;
+        }
+        for (; begin < end; begin += split_size) {
+            decoder_->decode(begin, std::min(begin + split_size, end));
+        }
+    }
+
+    std::shared_ptr<I_EventDecoder<EventCD>> cd_decoder_;
+    std::shared_ptr<I_EventDecoder<EventExtTrigger>> trigger_decoder_;
+    std::shared_ptr<EVT2Decoder> decoder_;
+    std::vector<EventCD> cds_;
+    std::vector<EventExtTrigger> triggers_;
+};
+
+TEST_F(EVT2Decoder_GTest, decodes_cd_and_trigger_events) {
+    create_decoder(false);
+
+    // GIVEN a stream mixing long runs of CD events, triggers and time highs
+    std::vector<uint32_t> words;
+    std::vector<EventCD> expected_cds;
+    timestamp t = 12345 << Evt2::TimestampLsbBits;
+    words.push_back(make_time_high(t));
+    for (int i = 0; i < 100; ++i) {
+        if (i % 37 == 36) {
+            words.push_back(make_trigger(i % 2, t, i % 16));
+        }
+        if (i % 33 == 32) {
+            t += 1 << Evt2::TimestampLsbBits;
+            words.push_back(make_time_high(t));
+        }
+        const timestamp ts = t + (i % 64);
+        expected_cds.emplace_back(i % 640, (3 * i) % 480, i % 3 == 0, ts);
+        words.push_back(make_cd(expected_cds.back().x, expected_cds.back().y, expected_cds.back().p, ts));
+    }
+
+    // WHEN decoding it
+    decode(words);
+
+    // THEN all events are decoded with their values
+    ASSERT_EQ(expected_cds.size(), cds_.size());
+    for (size_t i = 0; i < cds_.size(); ++i) {
+        EXPECT_EQ(expected_cds[i].x, cds_[i].x);
+        EXPECT_EQ(expected_cds[i].y, cds_[i].y);
+        EXPECT_EQ(expected_cds[i].p, cds_[i].p);
+        EXPECT_EQ(expected_cds[i].t, cds_[i].t);
+    }
+    ASSERT_EQ(2, triggers_.size());
+    EXPECT_EQ(36 % 2, triggers_[0].p);
+    EXPECT_EQ(36 % 16, triggers_[0].id);
+    EXPECT_EQ(73 % 16, triggers_[1].id);
+    EXPECT_EQ(expected_cds.back().t, decoder_->get_last_timestamp());
+    EXPECT_EQ(sizeof(uint32_t), decoder_->get_raw_event_size_bytes());
+}
+
+TEST_F(EVT2Decoder_GTest, drops_events_before_first_time_high) {
+    create_decoder(false);
+
+    // GIVEN a stream starting with CD events of unknown time
+    std::vector<uint32_t> words{make_cd(1, 1, 0, 0), make_cd(2, 2, 1, 0), make_time_high(64 * 10),
+                                make_cd(3, 3, 1, 64 * 10 + 5)};
+
+    // WHEN decoding it
+    decode(words);
+
+    // THEN only the events after the first time high are decoded
+    ASSERT_EQ(1, cds_.size());
+    EXPECT_EQ(3, cds_[0].x);
+    EXPECT_EQ(64 * 10 + 5, cds_[0].t);
+}
+
+TEST_F(EVT2Decoder_GTest, time_shifting) {
+    create_decoder(true);
+
+    // GIVEN a stream starting at a large time base
+    const timestamp base = 1000 * 64;
+    std::vector<uint32_t> words{make_time_high(base), make_cd(3, 4, 1, base + 7)};
+
+    // WHEN decoding it with time shifting enabled
+    decode(words);
+
+    // THEN the timestamps are shifted by the first time base
+    timestamp shift;
+    ASSERT_TRUE(decoder_->get_timestamp_shift(shift));
+    EXPECT_EQ(base, shift);
+    ASSERT_EQ(1, cds_.size());
+    EXPECT_EQ(7, cds_[0].t);
+}
+
+TEST_F(EVT2Decoder_GTest, time_high_loop) {
+    create_decoder(false);
+
+    // GIVEN a stream where the time high counter loops
+    const timestamp max_base = ((timestamp(1) << 28) - 1) << Evt2::TimestampLsbBits;
+    std::vector<uint32_t> words{make_time_high(max_base), make_cd(0, 0, 0, max_base), make_time_high(0),
+                                make_cd(1, 1, 0, 3)};
+
+    // WHEN decoding it
+    decode(words);
+
+    // THEN the timestamps keep increasing
+    ASSERT_EQ(2, cds_.size());
+    EXPECT_EQ(max_base, cds_[0].t);
+    EXPECT_EQ(max_base + (1 << Evt2::TimestampLsbBits) + 3, cds_[1].t);
+}
+
+TEST_F(EVT2Decoder_GTest, restarted_stream_timestamps_follow_the_last_one) {
+    for (bool time_shifting_enabled : {false, true}) {
+        create_decoder(time_shifting_enabled);
+        cds_.clear();
+
+        // GIVEN a stream starting at a large time base, fully decoded
+        const timestamp base = 1000 * 64;
+        std::vector<uint32_t> words{make_time_high(base), make_cd(1, 1, 0, base + 7), make_time_high(base + 64),
+                                    make_cd(2, 2, 1, base + 64 + 10)};
+        decode(words);
+        ASSERT_EQ(2, cds_.size());
+        const timestamp last_ts = decoder_->get_last_timestamp();
+
+        // WHEN the stream goes back to its beginning, the decoder being restarted
+        auto begin = reinterpret_cast<I_Decoder::RawData *>(words.data());
+        ASSERT_TRUE(decoder_->restart_stream(begin, begin + words.size() * sizeof(uint32_t)));
+        decode(words);
+
+        // THEN the timestamps of the stream decoded again follow the last one, without gap
+        ASSERT_EQ(4, cds_.size());
+        EXPECT_EQ(last_ts + 1 + 7, cds_[2].t);
+        EXPECT_EQ(last_ts + 1 + 64 + 10, cds_[3].t);
+        EXPECT_EQ(cds_[3].t, decoder_->get_last_timestamp());
+    }
+}
+
+TEST_F(EVT2Decoder_GTest, same_events_with_split_buffers) {
+    std::vector<uint32_t> words{make_time_high(64)};
+    for (int i = 0; i < 50; ++i) {
+        words.push_back(make_cd(i, i, i % 2, 64 + i));
+    }
+
+    // GIVEN the events decoded from a single buffer
+    create_decoder(false);
+    decode(words);
+    const std::vector<EventCD> reference = cds_;
+    cds_.clear();
+
+    // WHEN decoding the same data split at boundaries that are not multiples of the word size
+    create_decoder(false);
+    decode(words, 7);
+
+    // THEN the same events are decoded
+    ASSERT_EQ(reference.size(), cds_.size());
+    for (size_t i = 0; i < cds_.size(); ++i) {
+        EXPECT_EQ(reference[i].x, cds_[i].x);
+        EXPECT_EQ(reference[i].t, cds_[i].t);
+    }
+}
+
+TEST_F(EVT2Decoder_GTest, same_events_with_words_split_over_several_buffers) {
+    std::vector<uint32_t> words{make_time_high(64)};
+    for (int i = 0; i < 20; ++i) {
+        words.push_back(make_cd(i, i, i % 2, 64 + i));
+    }
+
+    // GIVEN the events decoded from a single buffer
+    create_decoder(false);
+    decode(words);
+    const std::vector<EventCD> reference = cds_;
+
+    for (size_t split_size : {1, 3}) {
+        // WHEN decoding the same data split in buffers smaller than a word, so that words span several buffers
+        cds_.clear();
+        create_decoder(false);
+        decode(words, split_size);
+
+        // THEN the same events are decoded
+        ASSERT_EQ(reference.size(), cds_.size());
+        for (size_t i = 0; i < cds_.size(); ++i) {
+            EXPECT_EQ(reference[i].x, cds_[i].x);
+            EXPECT_EQ(reference[i].y, cds_[i].y);
+            EXPECT_EQ(reference[i].p, cds_[i].p);
+            EXPECT_EQ(reference[i].t, cds_[i].t);
+        }
+    }
+}
+
+TEST_F(EVT2Decoder_GTest, decode_until_timestamp) {
+    create_decoder(false);
+    std::vector<uint32_t> words;
+    for (timestamp t = 0; t < 10000; ++t) {
+        if (t % 64 == 0) {
+            words.push_back(make_time_high(t));
+        }
+        words.push_back(make_cd(t % 640, t % 480, t % 2, t));
+    }
+    auto begin = reinterpret_cast<I_Decoder::RawData *>(words.data());
+    auto end   = begin + words.size() * sizeof(uint32_t);
+
+    // WHEN decoding the data up to a timestamp
+    const long consumed = decoder_->decode_until(begin, end, 5000);
+
+    // THEN the decoding stops in the step of raw events reaching the timestamp
+    ASSERT_EQ(0, consumed % sizeof(uint32_t));
+    ASSERT_LT(consumed, std::distance(begin, end));
+    ASSERT_GE(decoder_->get_last_timestamp(), 5000);
+    ASSERT_LT(decoder_->get_last_timestamp(), 5000 + I_Decoder::DecodeUntilStepEvents);
+    ASSERT_EQ(decoder_->get_last_timestamp(), cds_.back().t);
+
+    // WHEN decoding the rest of the data with a truncated raw event at the end, up to a timestamp not reached
+    const long consumed_rest = decoder_->decode_until(begin + consumed, end - 1, 20000);
+    decoder_->decode(end - 1, end);
+
+    // THEN all the data is consumed, and all the events are decoded once
+    ASSERT_EQ(std::distance(begin + consumed, end - 1), consumed_rest);
+    ASSERT_EQ(10000, cds_.size());
+    for (size_t i = 0; i < cds_.size(); ++i) {
+        ASSERT_EQ(static_cast<timestamp>(i), cds_[i].t);
+    }
+}
+
+TEST_F(EVT2Decoder_GTest, runtime_cd_event_buffer_size) {
+    create_decoder(false);
+    std::vector<uint32_t> words{make_time_high(64)};
+    for (int i = 0; i < 2500; ++i) {
+        words.push_back(make_cd(i % 640, i % 480, i % 2, 64 + i % 64));
+    }
+
+    // GIVEN a decoder with a buffer bigger than the default one
+    ASSERT_THROW(decoder_->set_cd_event_buffer_size(10), HalException);
+    decoder_->set_cd_event_buffer_size(1000);
+    ASSERT_EQ(1000, decoder_->get_cd_event_buffer_size());
+    size_t n_batches = 0;
+    cd_decoder_->add_event_buffer_callback([&n_batches](const EventCD *begin, const EventCD *end) {
+        ASSERT_GE(1000, end - begin);
+        ++n_batches;
+    });
+
+    // WHEN decoding the events
+    decode(words);
+
+    // THEN they are forwarded in batches of the requested size
+    ASSERT_EQ(2500, cds_.size());
+    ASSERT_EQ(3, n_batches);
+}
+
+TEST_F(EVT2Decoder_GTest, event_vectors_handed_off_without_copy) {
+    create_decoder(false);
+    std::vector<uint32_t> words{make_time_high(64)};
+    for (int i = 0; i < 1000; ++i) {
+        words.push_back(make_cd(i % 640, i % 480, i % 2, 64 + i % 64));
+    }
+
+    // GIVEN a callback taking the ownership of the decoded buffers, allocated by the caller
+    size_t n_allocations = 0;
+    std::vector<const EventCD *> buffers;
+    std::vector<std::vector<EventCD>> vectors;
+    cd_decoder_->add_event_buffer_callback(
+        [&buffers](const EventCD *begin, const EventCD *end) { buffers.push_back(begin); });
+    cd_decoder_->set_event_vector_callback(
+        [&vectors](std::vector<EventCD> &&events) { vectors.push_back(std::move(events)); },
+        [&n_allocations]() {
+            ++n_allocations;
+            return std::vector<EventCD>();
+        });
+
+    // WHEN decoding the events
+    decode(words);
+
+    // THEN the vectors received are the buffers the events were decoded into
+    ASSERT_EQ(buffers.size(), vectors.size());
+    ASSERT_EQ(vectors.size(), n_allocations);
+    size_t n_events = 0;
+    for (size_t i = 0; i < vectors.size(); ++i) {
+        ASSERT_EQ(buffers[i], vectors[i].data());
+        for (auto &ev : vectors[i]) {
+            ASSERT_EQ(cds_[n_events].x, ev.x);
+            ASSERT_EQ(cds_[n_events].t, ev.t);
+            ++n_events;
+        }
+    }
+    ASSERT_EQ(1000, n_events);
+}
+
+TEST_F(EVT2Decoder_GTest, soa_buffer_callback) {
+    create_decoder(false);
+    std::vector<uint32_t> words{make_time_high(64)};
+    for (int i = 0; i < 1000; ++i) {
+        words.push_back(make_cd(i % 640, i % 480, i % 2, 64 + i % 64));
+    }
+
+    // GIVEN a callback receiving the events as a structure of arrays
+    EventCDBufferSoA soa_events;
+    const size_t id = cd_decoder_->add_event_soa_buffer_callback(
+        [&soa_events](const EventCDBufferSoA &buffer) { buffer.copy_to(std::back_inserter(soa_events)); });
+
+    // WHEN decoding the events
+    decode(words);
+
+    // THEN the same events are received in both layouts
+    ASSERT_EQ(cds_.size(), soa_events.size());
+    for (size_t i = 0; i < cds_.size(); ++i) {
+        ASSERT_EQ(cds_[i].x, soa_events.x()[i]);
+        ASSERT_EQ(cds_[i].y, soa_events.y()[i]);
+        ASSERT_EQ(cds_[i].p, soa_events.p()[i]);
+        ASSERT_EQ(cds_[i].t, soa_events.t()[i]);
+    }
+
+    // WHEN removing the callback and decoding again
+    ASSERT_TRUE(cd_decoder_->remove_callback(id));
+    decode(words);
+
+    // THEN it is not called anymore
+    ASSERT_EQ(cds_.size(), 2 * soa_events.size());
+}
+
+TEST_F(EVT2Decoder_GTest, cd_event_filter_applied_while_decoding) {
+    std::vector<uint32_t> words{make_time_high(64)};
+    for (int i = 0; i < 3000; ++i) {
+        words.push_back(make_cd((i * 7) % 640, (i * 13) % 480, (i / 3) % 2, 64 + i % 64));
+        // Triggers break the blocks of CD events, which are then decoded one by one
+        if (i % 500 == 0) {
+            words.push_back(make_trigger(1, 64 + i % 64, 0));
+        }
+    }
+
+    // GIVEN the events decoded without filter, and then filtered
+    create_decoder(false);
+    decode(words);
+    DecodingFilter filter(640, 480);
+    filter.set_rois({DeviceRoi(100, 50, 200, 100), DeviceRoi(500, 400, 300, 300)});
+    filter.set_polarities(false, true);
+    filter.set_decimation(3);
+    std::vector<EventCD> expected = cds_;
+    DecodingFilter reference(filter);
+    expected.resize(reference.apply(expected.data(), expected.data() + expected.size()) - expected.data());
+    ASSERT_FALSE(expected.empty());
+
+    // WHEN decoding the events with the filter
+    create_decoder(false);
+    decoder_->set_cd_event_filter(filter);
+    ASSERT_NE(nullptr, decoder_->get_cd_event_filter());
+    cds_.clear();
+    triggers_.clear();
+    decode(words);
+
+    // THEN only the events accepted are forwarded
+    ASSERT_EQ(expected.size(), cds_.size());
+    for (size_t i = 0; i < cds_.size(); ++i) {
+        EXPECT_EQ(expected[i].x, cds_[i].x);
+        EXPECT_EQ(expected[i].y, cds_[i].y);
+        EXPECT_EQ(expected[i].p, cds_[i].p);
+        EXPECT_EQ(expected[i].t, cds_[i].t);
+    }
+    EXPECT_EQ(6, triggers_.size());
+
+    // WHEN clearing the filter
+    decoder_->clear_cd_event_filter();
+    ASSERT_EQ(nullptr, decoder_->get_cd_event_filter());
+    cds_.clear();
+    decode(words);
+
+    // THEN all the events are forwarded again
+    EXPECT_EQ(3000, cds_.size());
+}
+
+TEST_F(EVT2Decoder_GTest, trigger_events_are_batched) {
+    create_decoder(false);
+    std::vector<uint32_t> words{make_time_high(64)};
+    for (int i = 0; i < 1000; ++i) {
+        words.push_back(make_trigger(i % 2, 64 + i % 64, 1));
+    }
+    size_t n_batches = 0;
+    trigger_decoder_->add_event_buffer_callback(
+        [&n_batches](const EventExtTrigger *begin, const EventExtTrigger *end) { ++n_batches; });
+
+    // WHEN decoding many trigger events
+    decode(words);
+
+    // THEN they are forwarded in batches rather than one by one
+    ASSERT_EQ(1000, triggers_.size());
+    EXPECT_GE(4, n_batches);
+    for (size_t i = 0; i < triggers_.size(); ++i) {
+        EXPECT_EQ(static_cast<short>(i % 2), triggers_[i].p);
+    }
+}
+
+TEST_F(EVT2Decoder_GTest, event_order_preserved) {
+    // GIVEN a stream interleaving bursts of CD events and trigger events
+    std::vector<uint32_t> words{make_time_high(64)};
+    std::vector<bool> expected_is_trigger;
+    for (int i = 0; i < 2000; ++i) {
+        if (i % 50 < 3) {
+            words.push_back(make_trigger(1, 64 + i % 64, 0));
+            expected_is_trigger.push_back(true);
+        } else {
+            words.push_back(make_cd(i % 640, i % 480, i % 2, 64 + i % 64));
+            expected_is_trigger.push_back(false);
+        }
+    }
+
+    // WHEN decoding it with the order of the events preserved
+    create_decoder(false);
+    decoder_->set_event_order_preserved(true);
+    ASSERT_TRUE(decoder_->is_event_order_preserved());
+    std::vector<bool> is_trigger;
+    cd_decoder_->add_event_buffer_callback([&is_trigger](const EventCD *begin, const EventCD *end) {
+        is_trigger.insert(is_trigger.end(), end - begin, false);
+    });
+    trigger_decoder_->add_event_buffer_callback(
+        [&is_trigger](const EventExtTrigger *begin, const EventExtTrigger *end) {
+            is_trigger.insert(is_trigger.end(), end - begin, true);
+        });
+    decode(words, 1000);
+
+    // THEN the events of both types are received in the order of the stream
+    EXPECT_EQ(expected_is_trigger, is_trigger);
+
+    // WHEN the order is not preserved
+    decoder_->set_event_order_preserved(false);
+    is_trigger.clear();
+    decode(words, 1000);
+
+    // THEN all the events are still received
+    EXPECT_EQ(expected_is_trigger.size(), is_trigger.size());
+    EXPECT_NE(expected_is_trigger, is_trigger);
+}
+
+TEST_F(EVT2Decoder_GTest, decode_into_sink_gives_same_events_as_decode) {
+    std::vector<uint32_t> words{make_time_high(64)};
+    for (int i = 0; i < 3000; ++i) {
+        words.push_back(make_cd((i * 7) % 640, (i * 13) % 480, (i / 3) % 2, 64 + i % 64));
+        if (i % 500 == 0) {
+            words.push_back(make_trigger(1, 64 + i % 64, i % 16));
+        }
+        if (i % 1000 == 999) {
+            words.push_back(make_time_high(64 * (2 + i / 1000)));
+        }
+    }
+    DecodingFilter filter(640, 480);
+    filter.set_polarities(false, true);
+
+    // GIVEN the filtered events decoded with decode
+    create_decoder(false);
+    decoder_->set_cd_event_filter(filter);
+    decode(words);
+
+    // WHEN decoding the same data into a sink of both types of events, in buffers splitting some words
+    struct Sink {
+        void operator()(const EventCD &ev) {
+            cds.push_back(ev);
+        }
+        void operator()(const EventExtTrigger &ev) {
+            triggers.push_back(ev);
+        }
+        std::vector<EventCD> cds;
+        std::vector<EventExtTrigger> triggers;
+    } sink;
+    EVT2Decoder decoder(false);
+    decoder.set_cd_event_filter(filter);
+    const auto *begin = reinterpret_cast<const I_Decoder::RawData *>(words.data());
+    const auto *end   = begin + words.size() * sizeof(uint32_t);
+    const long split_size = 1001;
+    while (begin != end) {
+        const long size = std::min<long>(split_size, end - begin);
+        begin += decoder.decode_into(begin, begin + size, sink);
+    }
+
+    // THEN the same events are given to the sink
+    ASSERT_EQ(cds_.size(), sink.cds.size());
+    for (size_t i = 0; i < cds_.size(); ++i) {
+        EXPECT_EQ(cds_[i].x, sink.cds[i].x);
+        EXPECT_EQ(cds_[i].y, sink.cds[i].y);
+        EXPECT_EQ(cds_[i].p, sink.cds[i].p);
+        EXPECT_EQ(cds_[i].t, sink.cds[i].t);
+    }
+    ASSERT_EQ(triggers_.size(), sink.triggers.size());
+    for (size_t i = 0; i < triggers_.size(); ++i) {
+        EXPECT_EQ(triggers_[i].id, sink.triggers[i].id);
+        EXPECT_EQ(triggers_[i].t, sink.triggers[i].t);
+    }
+    EXPECT_EQ(decoder_->get_last_timestamp(), decoder.get_last_timestamp());
+}
+
+TEST_F(EVT2Decoder_GTest, decode_into_buffered_sink_of_cd_events) {
+    std::vector<uint32_t> words{make_time_high(64)};
+    for (int i = 0; i < 1000; ++i) {
+        words.push_back(make_cd(i % 640, i % 480, i % 2, 64 + i % 64));
+        if (i % 100 == 0) {
+            words.push_back(make_trigger(1, 64 + i % 64, 0));
+        }
+    }
+
+    // GIVEN a sink handling batches of 64 CD events, without handler for the trigger events
+    std::vector<size_t> batch_sizes;
+    size_t n_events = 0;
+    auto sink       = make_buffered_event_sink<EventCD, 64>([&](const EventCD *begin, const EventCD *end) {
+        batch_sizes.push_back(end - begin);
+        n_events += end - begin;
+    });
+
+    // WHEN decoding the data into it
+    EVT2Decoder decoder(false);
+    const auto *begin = reinterpret_cast<const I_Decoder::RawData *>(words.data());
+    ASSERT_EQ(static_cast<long>(words.size() * sizeof(uint32_t)),
+              decoder.decode_into(begin, begin + words.size() * sizeof(uint32_t), sink));
+    sink.flush();
+
+    // THEN all the CD events are given in batches of at most 64 events, the trigger events being dropped
+    EXPECT_EQ(1000, n_events);
+    ASSERT_LE(16, batch_sizes.size());
+    for (auto size : batch_sizes) {
+        EXPECT_LT(0, size);
+        EXPECT_GE(64, size);
+    }
+}
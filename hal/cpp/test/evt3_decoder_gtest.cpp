@@ -0,0 +1,263 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "metavision/hal/decoders/evt3_decoder.h"
+#include "metavision/hal/decoders/detail/evt3_raw_format.h"
+#include "metavision/hal/facilities/i_event_decoder.h"
+
+using namespace Metavision;
+
+namespace {
+
+uint16_t make_word(Evt3::EventTypes type, uint16_t payload) {
+    return static_cast<uint16_t>((static_cast<uint16_t>(type) << Evt3::TypeShift) | payload);
+}
+
+uint16_t make_time_high(timestamp t) {
+    return make_word(Evt3::EventTypes::EVT_TIME_HIGH, (t >> Evt3::TimeLowBits) & Evt3::TimeMask);
+}
+
+uint16_t make_time_low(timestamp t) {
+    return make_word(Evt3::EventTypes::EVT_TIME_LOW, t & Evt3::TimeMask);
+}
+
+uint16_t make_x(Evt3::EventTypes type, unsigned short x, short p) {
+    return make_word(type, (p << Evt3::PolarityShift) | x);
+}
+
+} // namespace
+
+class EVT3Decoder_GTest : public ::testing::Test {
+protected:
+    void create_decoder(bool time_shifting_enabled) {
+        cd_decoder_      = std::make_shared<I_EventDecoder<EventCD>>();
+        trigger_decoder_ = std::make_shared<I_EventDecoder<EventExtTrigger>>();
+        decoder_         = std::make_shared<EVT3Decoder>(time_shifting_enabled, cd_decoder_, trigger_decoder_);
+        cd_decoder_->add_event_buffer_callback(
+            [this](const EventCD *begin, const EventCD *end) { cds_.insert(cds_.end(), begin, end); });
+        trigger_decoder_->add_event_buffer_callback([this](const EventExtTrigger *begin, const EventExtTrigger *end) {
+            triggers_.insert(triggers_.end(), begin, end);
+        });
+    }
+
+    void decode(std::vector<uint16_t> &words, size_t split_size = 0) {
+        auto begin = reinterpret_cast<I_Decoder::RawData *>(words.data());
+        auto end   = begin + words.size() * sizeof(uint16_t);
+        if (split_size == 0) {
+            decoder_->decode(begin, end);
+            return;
+        }
+        for (; begin < end; begin += split_size) {
+            decoder_->decode(begin, std::min(begin + split_size, end));
+        }
+    }
+
+    void expect_cd(const EventCD &ev, unsigned short x, unsigned short y, short p, timestamp t) {
+        EXPECT_EQ(x, ev.x);
+        EXPECT_EQ(y, ev.y);
+        EXPECT_EQ(p, ev.p);
+        EXPECT_EQ(t, ev.t);
+    }
+
+    std::shared_ptr<I_EventDecoder<EventCD>> cd_decoder_;
+    std::shared_ptr<I_EventDecoder<EventExtTrigger>> trigger_decoder_;
+    std::shared_ptr<EVT3Decoder> decoder_;
+    std::vector<EventCD> cds_;
+    std::vector<EventExtTrigger> triggers_;
+};
+
+TEST_F(EVT3Decoder_GTest, decodes_single_and_vectorized_events) {
+    create_decoder(false);
+
+    // GIVEN a stream with a single event, vectors of events and a trigger
+    const timestamp t = (5 << Evt3::TimeLowBits) + 42;
+    std::vector<uint16_t> words{make_time_high(t),
+                                make_time_low(t),
+                                make_word(Evt3::EventTypes::CD_Y, 17),
+                                make_x(Evt3::EventTypes::X_POS, 3, 1),
+                                make_x(Evt3::EventTypes::X_BASE, 100, 0),
+                                make_word(Evt3::EventTypes::VECT_12, 0x805),
+                                make_word(Evt3::EventTypes::VECT_8, 0x81),
+                                make_word(Evt3::EventTypes::EXT_TRIGGER, (2 << Evt3::TriggerIdShift) | 1)};
+
+    // WHEN decoding it
+    decode(words);
+
+    // THEN one event is decoded per bit set in the vectors, from consecutive x bases
+    ASSERT_EQ(6, cds_.size());
+    expect_cd(cds_[0], 3, 17, 1, t);
+    expect_cd(cds_[1], 100, 17, 0, t);
+    expect_cd(cds_[2], 102, 17, 0, t);
+    expect_cd(cds_[3], 111, 17, 0, t);
+    expect_cd(cds_[4], 112, 17, 0, t);
+    expect_cd(cds_[5], 119, 17, 0, t);
+    ASSERT_EQ(1, triggers_.size());
+    EXPECT_EQ(1, triggers_[0].p);
+    EXPECT_EQ(2, triggers_[0].id);
+    EXPECT_EQ(t, triggers_[0].t);
+    EXPECT_EQ(t, decoder_->get_last_timestamp());
+    EXPECT_EQ(sizeof(uint16_t), decoder_->get_raw_event_size_bytes());
+}
+
+TEST_F(EVT3Decoder_GTest, ignores_em_events) {
+    create_decoder(false);
+
+    // GIVEN a stream where the vector follows an EM_Y word
+    std::vector<uint16_t> words{make_time_high(0), make_word(Evt3::EventTypes::EM_Y, 1),
+                                make_x(Evt3::EventTypes::X_BASE, 0, 0), make_word(Evt3::EventTypes::VECT_8, 0xFF)};
+
+    // WHEN decoding it
+    decode(words);
+
+    // THEN no CD event is produced
+    ASSERT_TRUE(cds_.empty());
+}
+
+TEST_F(EVT3Decoder_GTest, time_shifting) {
+    create_decoder(true);
+
+    // GIVEN a stream starting at a large time base
+    const timestamp base = 100 << Evt3::TimeLowBits;
+    std::vector<uint16_t> words{make_time_high(base), make_time_low(base + 9), make_word(Evt3::EventTypes::CD_Y, 1),
+                                make_x(Evt3::EventTypes::X_POS, 2, 0)};
+
+    // WHEN decoding it with time shifting enabled
+    decode(words);
+
+    // THEN the timestamps are shifted by the first time base
+    timestamp shift;
+    ASSERT_TRUE(decoder_->get_timestamp_shift(shift));
+    EXPECT_EQ(base, shift);
+    ASSERT_EQ(1, cds_.size());
+    EXPECT_EQ(9, cds_[0].t);
+}
+
+TEST_F(EVT3Decoder_GTest, time_high_loop) {
+    create_decoder(false);
+
+    // GIVEN a stream where the time high counter loops
+    const timestamp max_base = ((timestamp(1) << 12) - 1) << Evt3::TimeLowBits;
+    std::vector<uint16_t> words{make_time_high(max_base), make_time_high(0), make_time_low(3),
+                                make_word(Evt3::EventTypes::CD_Y, 1), make_x(Evt3::EventTypes::X_POS, 2, 0)};
+
+    // WHEN decoding it
+    decode(words);
+
+    // THEN the timestamps keep increasing
+    ASSERT_EQ(1, cds_.size());
+    EXPECT_EQ(max_base + (1 << Evt3::TimeLowBits) + 3, cds_[0].t);
+}
+
+TEST_F(EVT3Decoder_GTest, same_events_with_split_buffers) {
+    std::vector<uint16_t> words{make_time_high(0), make_word(Evt3::EventTypes::CD_Y, 4)};
+    for (int i = 0; i < 30; ++i) {
+        words.push_back(make_time_low(i));
+        words.push_back(make_x(Evt3::EventTypes::X_BASE, 12 * i, i % 2));
+        words.push_back(make_word(Evt3::EventTypes::VECT_12, 0x0F0 | i));
+    }
+
+    // GIVEN the events decoded from a single buffer
+    create_decoder(false);
+    decode(words);
+    const std::vector<EventCD> reference = cds_;
+    cds_.clear();
+
+    // WHEN decoding the same data split at boundaries that are not multiples of the word size
+    create_decoder(false);
+    decode(words, 3);
+
+    // THEN the same events are decoded
+    ASSERT_FALSE(reference.empty());
+    ASSERT_EQ(reference.size(), cds_.size());
+    for (size_t i = 0; i < cds_.size(); ++i) {
+        EXPECT_EQ(reference[i].x, cds_[i].x);
+        EXPECT_EQ(reference[i].p, cds_[i].p);
+        EXPECT_EQ(reference[i].t, cds_[i].t);
+    }
+}
+
+TEST_F(EVT3Decoder_GTest, cd_event_filter_applied_while_decoding) {
+    std::vector<uint16_t> words{make_time_high(0)};
+    for (int y = 0; y < 40; ++y) {
+        words.push_back(make_time_low(y));
+        words.push_back(make_word(Evt3::EventTypes::CD_Y, y));
+        words.push_back(make_x(Evt3::EventTypes::X_POS, 3 * y, y % 2));
+        words.push_back(make_x(Evt3::EventTypes::X_BASE, 5 * y, (y / 2) % 2));
+        for (int i = 0; i < 10; ++i) {
+            words.push_back(make_word(Evt3::EventTypes::VECT_12, (0x5A5 * (i + y)) & Evt3::Vect12Mask));
+            words.push_back(make_word(Evt3::EventTypes::VECT_8, (0x93 + i + y) & Evt3::Vect8Mask));
+        }
+    }
+
+    // GIVEN the events decoded without filter, and then filtered
+    create_decoder(false);
+    decode(words);
+    DecodingFilter filter(240, 30);
+    filter.set_rois({DeviceRoi(10, 5, 37, 10), DeviceRoi(150, 20, 100, 3)});
+    filter.set_polarities(true, false);
+    filter.set_decimation(2);
+    std::vector<EventCD> expected = cds_;
+    DecodingFilter reference(filter);
+    expected.resize(reference.apply(expected.data(), expected.data() + expected.size()) - expected.data());
+    ASSERT_FALSE(expected.empty());
+
+    // WHEN decoding the events with the filter
+    create_decoder(false);
+    decoder_->set_cd_event_filter(filter);
+    cds_.clear();
+    decode(words);
+
+    // THEN only the events accepted are forwarded
+    ASSERT_EQ(expected.size(), cds_.size());
+    for (size_t i = 0; i < cds_.size(); ++i) {
+        expect_cd(cds_[i], expected[i].x, expected[i].y, expected[i].p, expected[i].t);
+    }
+}
+
+TEST_F(EVT3Decoder_GTest, statistics) {
+    create_decoder(false);
+
+    // GIVEN a stream with a single event, vectors of events, a trigger and a time going back
+    const timestamp t = (5 << Evt3::TimeLowBits) + 42;
+    std::vector<uint16_t> words{make_time_high(t),
+                                make_time_low(t),
+                                make_word(Evt3::EventTypes::CD_Y, 17),
+                                make_x(Evt3::EventTypes::X_POS, 3, 1),
+                                make_x(Evt3::EventTypes::X_BASE, 100, 0),
+                                make_word(Evt3::EventTypes::VECT_12, 0x805),
+                                make_word(Evt3::EventTypes::VECT_8, 0x81),
+                                make_word(Evt3::EventTypes::EXT_TRIGGER, (2 << Evt3::TriggerIdShift) | 1),
+                                make_time_low(t - 2),
+                                make_time_high(t)};
+
+    // WHEN decoding it in chunks of 3 bytes, without and then with the statistics enabled
+    decode(words, 3);
+    EXPECT_EQ(0, decoder_->get_statistics().bytes_decoded);
+    decoder_->enable_statistics(true);
+    decode(words, 3);
+
+    // THEN the statistics count the data decoded since the creation of the decoder
+    const auto statistics = decoder_->get_statistics();
+    EXPECT_TRUE(decoder_->is_statistics_enabled());
+    EXPECT_EQ(2 * words.size() * sizeof(uint16_t), statistics.bytes_decoded);
+    EXPECT_EQ(12, statistics.cd_events);
+    EXPECT_EQ(2, statistics.ext_trigger_events);
+    EXPECT_EQ(4, statistics.time_high_words);
+    EXPECT_EQ(4, statistics.vector_words);
+    EXPECT_EQ(10, statistics.vector_events);
+    EXPECT_EQ(2, statistics.out_of_order_timestamps);
+    EXPECT_GT(statistics.partial_word_carries, 0);
+}
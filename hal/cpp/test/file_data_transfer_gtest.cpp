@@ -0,0 +1,536 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <vector>
+
+#include "metavision/utils/gtest/gtest_with_tmp_dir.h"
+#include "metavision/hal/utils/file_data_transfer.h"
+#include "metavision/hal/utils/hal_exception.h"
+#include "metavision/hal/utils/memory_mapped_file_stream.h"
+#include "metavision/hal/utils/memory_raw_stream.h"
+#include "metavision/hal/utils/raw_file_config.h"
+#include "metavision/hal/utils/read_ahead_file_stream.h"
+
+using namespace Metavision;
+
+class FileDataTransfer_GTest : public GTestWithTmpDir {
+protected:
+    virtual void SetUp() override {
+        static int file_counter = 0;
+        filename_               = tmpdir_handler_->get_full_path("data_" + std::to_string(++file_counter) + ".raw");
+
+        data_.resize(10007);
+        std::iota(data_.begin(), data_.end(), 0);
+        std::ofstream ofs(filename_, std::ios::binary);
+        ofs.write(reinterpret_cast<const char *>(data_.data()), data_.size());
+    }
+
+    // Runs the data transfer until the end of the stream, calling @p on_slice for each slice received
+    void transfer_all(FileDataTransfer &transfer,
+                      const std::function<void(const DataTransfer::BufferSlice &)> &on_slice) {
+        std::mutex mutex;
+        std::condition_variable cond;
+        bool stopped = false;
+
+        transfer.add_new_slice_callback(on_slice);
+        transfer.add_status_changed_callback([&](DataTransfer::Status status) {
+            if (status == DataTransfer::Status::Stopped) {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopped = true;
+                cond.notify_all();
+            }
+        });
+        transfer.start();
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cond.wait(lock, [&stopped] { return stopped; });
+        }
+        transfer.stop();
+    }
+
+    // Runs the data transfer until the end of the stream and returns all the data transferred
+    std::vector<uint8_t> transfer_all(FileDataTransfer &transfer) {
+        std::vector<uint8_t> transferred;
+        transfer_all(transfer, [&transferred](const DataTransfer::BufferSlice &slice) {
+            transferred.insert(transferred.end(), slice.data(), slice.data() + slice.size());
+        });
+        return transferred;
+    }
+
+    std::string filename_;
+    std::vector<uint8_t> data_;
+};
+
+TEST_F(FileDataTransfer_GTest, memory_mapped_stream_reads_like_a_standard_stream) {
+    MemoryMappedFileStream stream(filename_);
+    ASSERT_EQ(data_.size(), stream.size());
+
+    std::vector<uint8_t> read(100);
+    stream.seekg(50);
+    stream.read(reinterpret_cast<char *>(read.data()), read.size());
+    ASSERT_EQ(read.size(), stream.gcount());
+    ASSERT_TRUE(std::equal(read.begin(), read.end(), data_.begin() + 50));
+    ASSERT_EQ(150, stream.tellg());
+
+    stream.seekg(0, std::ios::end);
+    ASSERT_EQ(data_.size(), stream.tellg());
+}
+
+TEST_F(FileDataTransfer_GTest, memory_mapped_stream_throws_on_unknown_file) {
+    ASSERT_THROW(MemoryMappedFileStream("unknown_file.raw"), HalException);
+}
+
+TEST_F(FileDataTransfer_GTest, memory_mapped_transfer_slices_data_without_copy) {
+    RawFileConfig config;
+    config.n_events_to_read_ = 1000;
+
+    auto stream = std::make_unique<MemoryMappedFileStream>(filename_);
+    // Emulates the reading of a header
+    stream->seekg(7);
+    const uint8_t *mapped_begin = stream->data();
+    const uint8_t *mapped_end   = stream->data() + stream->size();
+
+    FileDataTransfer transfer(std::move(stream), 2, config);
+    std::vector<DataTransfer::BufferSlice> slices;
+    transfer_all(transfer, [&slices](const DataTransfer::BufferSlice &slice) { slices.push_back(slice); });
+
+    std::vector<uint8_t> transferred;
+    for (auto &slice : slices) {
+        ASSERT_GE(slice.data(), mapped_begin);
+        ASSERT_LE(slice.data() + slice.size(), mapped_end);
+        ASSERT_LE(slice.size(), 2000);
+        transferred.insert(transferred.end(), slice.data(), slice.data() + slice.size());
+    }
+    ASSERT_EQ(5, slices.size());
+    ASSERT_EQ(std::vector<uint8_t>(data_.begin() + 7, data_.end()), transferred);
+}
+
+TEST_F(FileDataTransfer_GTest, memory_mapped_and_standard_transfers_are_equivalent) {
+    RawFileConfig config;
+    config.n_events_to_read_ = 123;
+
+    FileDataTransfer mapped_transfer(std::make_unique<MemoryMappedFileStream>(filename_), 4, config);
+    FileDataTransfer standard_transfer(std::make_unique<std::ifstream>(filename_, std::ios::binary), 4, config);
+
+    ASSERT_EQ(data_, transfer_all(standard_transfer));
+    ASSERT_EQ(data_, transfer_all(mapped_transfer));
+}
+
+TEST_F(FileDataTransfer_GTest, slices_keep_the_mapping_alive) {
+    RawFileConfig config;
+    std::vector<DataTransfer::BufferSlice> slices;
+    {
+        FileDataTransfer transfer(std::make_unique<MemoryMappedFileStream>(filename_), 1, config);
+        transfer_all(transfer, [&slices](const DataTransfer::BufferSlice &slice) { slices.push_back(slice); });
+    }
+    ASSERT_EQ(1, slices.size());
+    ASSERT_EQ(data_, std::vector<uint8_t>(slices[0].data(), slices[0].data() + slices[0].size()));
+}
+
+TEST_F(FileDataTransfer_GTest, memory_stream_reads_buffers_like_a_standard_stream) {
+    // The data is split in uneven buffers, one of them empty
+    MemoryRawStream stream({{data_.data(), 100}, {data_.data() + 100, 0}, {data_.data() + 100, data_.size() - 100}});
+    ASSERT_EQ(data_.size(), stream.size());
+
+    std::vector<uint8_t> read(100);
+    stream.seekg(50);
+    stream.read(reinterpret_cast<char *>(read.data()), read.size());
+    ASSERT_EQ(read.size(), stream.gcount());
+    ASSERT_TRUE(std::equal(read.begin(), read.end(), data_.begin() + 50));
+    ASSERT_EQ(150, stream.tellg());
+
+    stream.seekg(-10, std::ios::cur);
+    ASSERT_EQ(data_[140], stream.get());
+
+    stream.seekg(0, std::ios::end);
+    ASSERT_EQ(data_.size(), stream.tellg());
+    ASSERT_EQ(std::istream::traits_type::eof(), stream.get());
+}
+
+TEST_F(FileDataTransfer_GTest, memory_transfer_slices_buffers_without_copy) {
+    RawFileConfig config;
+    config.n_events_to_read_ = 1000;
+
+    const std::vector<MemoryRawStream::Buffer> buffers = {
+        {data_.data(), 5}, {data_.data() + 5, 3000}, {data_.data() + 3005, data_.size() - 3005}};
+    auto stream = std::make_unique<MemoryRawStream>(buffers);
+    // Emulates the reading of a header, spanning the first two buffers
+    stream->seekg(7);
+
+    FileDataTransfer transfer(std::move(stream), 2, config);
+    std::vector<DataTransfer::BufferSlice> slices;
+    transfer_all(transfer, [&slices](const DataTransfer::BufferSlice &slice) { slices.push_back(slice); });
+
+    std::vector<uint8_t> transferred;
+    for (auto &slice : slices) {
+        // Each slice aliases a single buffer of the caller
+        ASSERT_TRUE(std::any_of(buffers.begin(), buffers.end(), [&slice](const MemoryRawStream::Buffer &buffer) {
+            const uint8_t *begin = static_cast<const uint8_t *>(buffer.data);
+            return slice.data() >= begin && slice.data() + slice.size() <= begin + buffer.size;
+        }));
+        ASSERT_LE(slice.size(), 2000);
+        transferred.insert(transferred.end(), slice.data(), slice.data() + slice.size());
+    }
+    ASSERT_EQ(6, slices.size());
+    ASSERT_EQ(std::vector<uint8_t>(data_.begin() + 7, data_.end()), transferred);
+}
+
+TEST_F(FileDataTransfer_GTest, slices_keep_the_memory_owner_alive) {
+    RawFileConfig config;
+    auto memory = std::make_shared<std::vector<uint8_t>>(data_);
+    std::weak_ptr<std::vector<uint8_t>> weak_memory(memory);
+    std::vector<DataTransfer::BufferSlice> slices;
+    {
+        FileDataTransfer transfer(std::make_unique<MemoryRawStream>(memory->data(), memory->size(), memory), 1,
+                                  config);
+        memory.reset();
+        transfer_all(transfer, [&slices](const DataTransfer::BufferSlice &slice) { slices.push_back(slice); });
+    }
+    ASSERT_FALSE(weak_memory.expired());
+    ASSERT_EQ(1, slices.size());
+    ASSERT_EQ(data_, std::vector<uint8_t>(slices[0].data(), slices[0].data() + slices[0].size()));
+    slices.clear();
+    ASSERT_TRUE(weak_memory.expired());
+}
+
+TEST_F(FileDataTransfer_GTest, read_ahead_and_standard_transfers_are_equivalent) {
+    for (uint32_t n_reads_in_flight : {2, 3, 8}) {
+        for (uint32_t n_read_buffers : {3, 4, 16}) {
+            RawFileConfig config;
+            config.n_events_to_read_ = 100;
+            config.n_read_buffers_   = n_read_buffers;
+
+            auto stream = std::make_unique<ReadAheadFileStream>(filename_, n_reads_in_flight);
+            ASSERT_TRUE(stream->good());
+            ASSERT_EQ(data_.size(), stream->get_file_size());
+            // Emulates the reading of a header
+            stream->seekg(3);
+
+            FileDataTransfer transfer(std::move(stream), 2, config);
+            ASSERT_EQ(std::vector<uint8_t>(data_.begin() + 3, data_.end()), transfer_all(transfer));
+        }
+    }
+}
+
+TEST_F(FileDataTransfer_GTest, read_ahead_transfer_resumes_where_it_has_been_stopped) {
+    RawFileConfig config;
+    config.n_events_to_read_ = 100;
+    config.n_read_buffers_   = 8;
+    const size_t header_size = 3;
+
+    // GIVEN a transfer reading a file with several reads in flight, whose header has been read
+    auto stream = std::make_unique<ReadAheadFileStream>(filename_, 4);
+    stream->seekg(header_size);
+    FileDataTransfer transfer(std::move(stream), 2, config);
+
+    std::mutex mutex;
+    std::condition_variable cond;
+    std::vector<uint8_t> transferred;
+    int n_stopped = 0;
+    transfer.add_new_slice_callback([&](const DataTransfer::BufferSlice &slice) {
+        std::lock_guard<std::mutex> lock(mutex);
+        transferred.insert(transferred.end(), slice.data(), slice.data() + slice.size());
+        cond.notify_all();
+    });
+    transfer.add_status_changed_callback([&](DataTransfer::Status status) {
+        if (status == DataTransfer::Status::Stopped) {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++n_stopped;
+            cond.notify_all();
+        }
+    });
+
+    // WHEN the transfer is stopped after the first slice, then started again until the end of the file, and once more
+    transfer.start();
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        cond.wait(lock, [&] { return !transferred.empty(); });
+    }
+    transfer.stop();
+    for (int i = 2; i <= 3; ++i) {
+        transfer.start();
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cond.wait(lock, [&] { return n_stopped == i; });
+        }
+        transfer.stop();
+    }
+
+    // THEN the data after the header is transferred once, without gap nor duplicate
+    ASSERT_EQ(data_.size() - header_size, transferred.size());
+    ASSERT_EQ(std::vector<uint8_t>(data_.begin() + header_size, data_.end()), transferred);
+}
+
+TEST_F(FileDataTransfer_GTest, read_ahead_stream_returns_reads_in_submission_order) {
+    ReadAheadFileStream stream(filename_, 4);
+    auto pool = DataTransfer::BufferPool::make_bounded(8);
+
+    // WHEN submitting reads in reverse order of the file, the last one starting beyond the end of the file
+    const std::vector<uint64_t> offsets = {10000, 5000, 1000, 0};
+    for (auto offset : offsets) {
+        stream.submit(pool.acquire(), offset, 1000);
+    }
+    ASSERT_EQ(4, stream.get_n_pending_reads());
+
+    // THEN the buffers are returned in submission order, with the data at the requested offsets
+    for (auto offset : offsets) {
+        auto buffer = stream.wait_next();
+        ASSERT_NE(nullptr, buffer);
+        const size_t expected_size = std::min<size_t>(1000, data_.size() - offset);
+        ASSERT_EQ(expected_size, buffer->size());
+        ASSERT_TRUE(std::equal(buffer->begin(), buffer->end(), data_.begin() + offset));
+    }
+    ASSERT_EQ(nullptr, stream.wait_next());
+}
+
+TEST_F(FileDataTransfer_GTest, adaptive_read_size_follows_the_rate_of_the_data) {
+    // GIVEN reads targeting 1ms of data, between 64 and 100000 events of 4 bytes
+    AdaptiveReadSize read_size(1000, 4, 64 * 4, 100000 * 4);
+    ASSERT_EQ(64 * 4, read_size.get_read_size());
+
+    // WHEN the data is busy, with 1000 bytes per us
+    timestamp t = 0;
+    read_size.add_time(t);
+    read_size.add_data(100000);
+    read_size.add_time(t += 100);
+
+    // THEN the reads grow to their maximal size right away
+    ASSERT_EQ(100000 * 4, read_size.get_read_size());
+
+    // WHEN the data gets quiet, with 1 byte per us
+    for (int i = 0; i < 20; ++i) {
+        read_size.add_data(100);
+        read_size.add_time(t += 100);
+    }
+
+    // THEN the reads shrink to hold 1ms of data within a few reads
+    ASSERT_EQ(1000, read_size.get_read_size());
+
+    // WHEN the timestamps restart after a reset, e.g. after seeking
+    read_size.reset();
+    read_size.add_data(100000);
+    read_size.add_time(0);
+
+    // THEN the data before the first timestamp is not accounted for
+    ASSERT_EQ(1000, read_size.get_read_size());
+}
+
+TEST_F(FileDataTransfer_GTest, adaptive_transfer_uses_the_timestamps_feedback) {
+    // GIVEN a transfer reading 1ms of data at a time
+    RawFileConfig config;
+    config.n_events_to_read_ = 10000;
+    config.n_us_to_read_     = 1000;
+
+    FileDataTransfer transfer(std::make_unique<std::ifstream>(filename_, std::ios::binary), 1, config);
+    auto read_size = transfer.get_adaptive_read_size();
+    ASSERT_NE(nullptr, read_size);
+
+    // WHEN each slice transferred is decoded as 100us of data
+    std::vector<uint8_t> transferred;
+    std::vector<size_t> slice_sizes;
+    timestamp t = 0;
+    read_size->add_time(t);
+    transfer_all(transfer, [&](const DataTransfer::BufferSlice &slice) {
+        transferred.insert(transferred.end(), slice.data(), slice.data() + slice.size());
+        slice_sizes.push_back(slice.size());
+        read_size->add_data(slice.size());
+        read_size->add_time(t += 100);
+    });
+
+    // THEN the first read is small, and the next ones hold 1ms of data at the rate estimated
+    ASSERT_EQ(data_, transferred);
+    ASSERT_LE(3, slice_sizes.size());
+    EXPECT_EQ(256, slice_sizes[0]);
+    EXPECT_EQ(2560, slice_sizes[1]);
+
+    // THEN the transfer has no policy if the size of the reads is fixed
+    config.n_us_to_read_ = 0;
+    FileDataTransfer fixed_transfer(std::make_unique<std::ifstream>(filename_, std::ios::binary), 1, config);
+    EXPECT_EQ(nullptr, fixed_transfer.get_adaptive_read_size());
+}
+
+TEST_F(FileDataTransfer_GTest, elastic_buffering_rides_through_a_stalled_client) {
+    RawFileConfig config;
+    config.n_events_to_read_ = 100;
+    config.n_read_buffers_   = 3;
+
+    FileDataTransfer transfer(std::make_unique<std::ifstream>(filename_, std::ios::binary), 2, config);
+    DataTransfer::ElasticBufferingConfig elastic_config;
+    elastic_config.max_extra_bytes = 1 << 20;
+    elastic_config.shrink_delay    = std::chrono::milliseconds(0);
+    transfer.set_elastic_buffering(elastic_config);
+
+    // WHEN the client holds all the buffers transferred, which would stall the transfers with a pool of 3 buffers
+    std::vector<DataTransfer::BufferSlice> held_slices;
+    transfer_all(transfer, [&](const DataTransfer::BufferSlice &slice) { held_slices.push_back(slice); });
+
+    // THEN all the data is transferred, using buffers allocated on top of the pool
+    std::vector<uint8_t> transferred;
+    for (const auto &slice : held_slices) {
+        transferred.insert(transferred.end(), slice.data(), slice.data() + slice.size());
+    }
+    ASSERT_EQ(data_, transferred);
+    auto stats = transfer.get_buffering_statistics();
+    EXPECT_LE(held_slices.size(), stats.peak_depth);
+    EXPECT_LT(0, stats.near_drops);
+    EXPECT_EQ(0, stats.drops);
+    EXPECT_LT(0, stats.extra_buffers);
+
+    // THEN the extra buffers are freed once the client releases them, the pool not being short of buffers anymore,
+    // except the one kept by the transfer for its next read
+    held_slices.clear();
+    EXPECT_GE(1, transfer.get_buffering_statistics().extra_buffers);
+}
+
+TEST_F(FileDataTransfer_GTest, memory_placement_applies_to_all_the_buffers) {
+    RawFileConfig config;
+    config.n_events_to_read_ = 100;
+    config.n_read_buffers_   = 3;
+
+    // GIVEN a transfer with elastic buffering, whose buffers are placed with more memory than needed for a read
+    FileDataTransfer transfer(std::make_unique<std::ifstream>(filename_, std::ios::binary), 2, config);
+    DataTransfer::ElasticBufferingConfig elastic_config;
+    elastic_config.max_extra_bytes = 64 << 20;
+    transfer.set_elastic_buffering(elastic_config);
+    MemoryPlacement placement;
+    placement.huge_pages      = true;
+    const size_t buffer_bytes = 1 << 20;
+    transfer.set_memory_placement(placement, buffer_bytes);
+
+    // WHEN the client holds all the buffers transferred, so that buffers are allocated on top of the pool
+    std::vector<DataTransfer::BufferPtr> held_buffers;
+    transfer.add_new_buffer_callback([&](const DataTransfer::BufferPtr &buffer) { held_buffers.push_back(buffer); });
+    transfer_all(transfer);
+
+    // THEN all the buffers transferred, from the pool or not, have been placed
+    ASSERT_LT(3, held_buffers.size());
+    EXPECT_LT(0, transfer.get_buffering_statistics().extra_buffers);
+    for (const auto &buffer : held_buffers) {
+        EXPECT_LE(buffer_bytes, buffer->capacity());
+    }
+
+    // WHEN the transfers are running
+    // THEN the placement can not be changed
+    FileDataTransfer running_transfer(std::make_unique<std::ifstream>(filename_, std::ios::binary), 2, config);
+    running_transfer.start();
+    EXPECT_THROW(running_transfer.set_memory_placement(placement, buffer_bytes), HalException);
+    running_transfer.stop();
+}
+
+TEST_F(FileDataTransfer_GTest, buffers_are_aligned) {
+    RawFileConfig config;
+    config.n_events_to_read_ = 1000;
+    FileDataTransfer transfer(std::make_unique<std::ifstream>(filename_, std::ios::binary), 1, config);
+
+    std::vector<uint8_t> transferred;
+    transfer_all(transfer, [&transferred](const DataTransfer::BufferSlice &slice) {
+        ASSERT_EQ(0, reinterpret_cast<uintptr_t>(slice.data()) % DataTransfer::BufferAlignment);
+        transferred.insert(transferred.end(), slice.data(), slice.data() + slice.size());
+    });
+    ASSERT_EQ(data_, transferred);
+}
+
+TEST_F(FileDataTransfer_GTest, looping_transfer_rewinds_after_the_header) {
+    RawFileConfig config;
+    config.n_events_to_read_ = 1000;
+    config.loop_             = true;
+    const size_t header_size = 7;
+
+    std::vector<std::unique_ptr<std::istream>> streams;
+    streams.push_back(std::make_unique<std::ifstream>(filename_, std::ios::binary));
+    streams.push_back(std::make_unique<MemoryMappedFileStream>(filename_));
+    for (auto &stream : streams) {
+        // GIVEN a transfer looping over a file, whose header has been read
+        stream->seekg(header_size);
+        FileDataTransfer transfer(std::move(stream), 1, config);
+        ASSERT_TRUE(transfer.is_looping());
+
+        // WHEN the data of 3 loops is transferred
+        const std::vector<uint8_t> loop_data(data_.begin() + header_size, data_.end());
+        std::mutex mutex;
+        std::condition_variable cond;
+        std::vector<uint8_t> transferred;
+        std::vector<size_t> discontinuities;
+        transfer.add_new_slice_callback([&](const DataTransfer::BufferSlice &slice) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (transferred.size() < 3 * loop_data.size()) {
+                if (slice.is_discontinuous()) {
+                    discontinuities.push_back(transferred.size());
+                }
+                transferred.insert(transferred.end(), slice.data(), slice.data() + slice.size());
+            }
+            cond.notify_all();
+        });
+        transfer.start();
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cond.wait(lock, [&] { return transferred.size() >= 3 * loop_data.size(); });
+        }
+        transfer.stop();
+
+        // THEN the data after the header is transferred again at each loop, the first slice of each loop being
+        // flagged as discontinuous
+        ASSERT_EQ(3 * loop_data.size(), transferred.size());
+        for (size_t i = 0; i < 3; ++i) {
+            ASSERT_TRUE(std::equal(loop_data.begin(), loop_data.end(), transferred.begin() + i * loop_data.size()));
+        }
+        ASSERT_EQ(std::vector<size_t>({loop_data.size(), 2 * loop_data.size()}), discontinuities);
+    }
+}
+
+TEST_F(FileDataTransfer_GTest, empty_file_is_not_looped) {
+    RawFileConfig config;
+    config.loop_ = true;
+
+    auto stream = std::make_unique<std::ifstream>(filename_, std::ios::binary);
+    stream->seekg(0, std::ios::end);
+    FileDataTransfer transfer(std::move(stream), 1, config);
+    ASSERT_FALSE(transfer.is_looping());
+    ASSERT_TRUE(transfer_all(transfer).empty());
+}
+
+TEST(DataTransfer_GTest, buffer_resize_does_not_initialize_data) {
+    DataTransfer::Buffer buffer(100, 0xAB);
+    buffer.clear();
+
+    // WHEN growing the buffer again within its capacity
+    buffer.resize(100);
+
+    // THEN its content is left as is instead of being zeroed
+    ASSERT_TRUE(std::all_of(buffer.begin(), buffer.end(), [](uint8_t v) { return v == 0xAB; }));
+}
+
+TEST(DataTransfer_GTest, external_memory_is_released_with_the_last_slice) {
+    std::vector<uint8_t> memory(100);
+    int num_releases = 0;
+    auto slice       = DataTransfer::BufferSlice::from_external_memory(memory.data(), memory.data() + memory.size(),
+                                                                       [&num_releases]() { ++num_releases; });
+    ASSERT_EQ(memory.data(), slice.data());
+    ASSERT_EQ(100, slice.size());
+
+    // WHEN the slice is copied, then all the copies are destroyed
+    auto copy = slice;
+    slice.reset();
+    ASSERT_EQ(0, num_releases);
+    copy.reset();
+
+    // THEN the memory is released once
+    ASSERT_EQ(1, num_releases);
+}
@@ -0,0 +1,669 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include "metavision/utils/gtest/gtest_with_tmp_dir.h"
+#include "metavision/hal/facilities/i_events_stream.h"
+#include "metavision/hal/facilities/i_hw_identification.h"
+#include "metavision/hal/facilities/i_plugin_software_info.h"
+#include "metavision/hal/utils/file_data_transfer.h"
+#include "metavision/hal/utils/hal_exception.h"
+#include "metavision/hal/utils/hal_software_info.h"
+#include "metavision/hal/utils/raw_file_config.h"
+#include "metavision/hal/utils/raw_file_playlist_stream.h"
+#include "metavision/hal/utils/read_ahead_file_stream.h"
+
+using namespace Metavision;
+
+namespace {
+struct MockHWIdentification : public I_HW_Identification {
+    MockHWIdentification() :
+        I_HW_Identification(std::make_shared<I_PluginSoftwareInfo>("mock", get_hal_software_info())) {}
+
+    std::string get_serial() const override {
+        return std::string();
+    }
+
+    long get_system_id() const override {
+        return 0;
+    }
+
+    SensorInfo get_sensor_info() const override {
+        return SensorInfo();
+    }
+
+    long get_system_version() const override {
+        return 0;
+    }
+
+    std::vector<std::string> get_available_raw_format() const override {
+        return std::vector<std::string>();
+    }
+
+    std::string get_integrator() const override {
+        return std::string();
+    }
+
+    std::string get_connection_type() const override {
+        return std::string();
+    }
+};
+
+// Data transfer never transferring any data, until it is stopped
+struct IdleDataTransfer : public DataTransfer {
+    IdleDataTransfer() : DataTransfer(1) {}
+
+    void run_impl() override {
+        while (!should_stop()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+};
+
+// Data transfer transferring buffers of one byte continuously, as a live source would do
+struct LiveDataTransfer : public DataTransfer {
+    LiveDataTransfer() : DataTransfer(1) {}
+
+    void run_impl() override {
+        auto buffer = get_buffer();
+        while (!should_stop()) {
+            buffer->assign(1, 0);
+            buffer = transfer_data(buffer);
+            ++num_transfers;
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    }
+
+    std::atomic<int> num_transfers{0};
+};
+} // namespace
+
+class I_EventsStream_GTest : public GTestWithTmpDir {
+protected:
+    virtual void SetUp() override {
+        static int file_counter = 0;
+        filename_               = tmpdir_handler_->get_full_path("data_" + std::to_string(++file_counter) + ".raw");
+
+        data_.resize(100003);
+        std::iota(data_.begin(), data_.end(), 0);
+        std::ofstream ofs(filename_, std::ios::binary);
+        ofs.write(reinterpret_cast<const char *>(data_.data()), data_.size());
+    }
+
+    std::unique_ptr<I_EventsStream> make_events_stream(uint32_t n_reads_in_flight = 0) {
+        RawFileConfig config;
+        config.n_events_to_read_ = 100;
+        config.n_read_buffers_   = 4;
+        std::unique_ptr<std::istream> stream;
+        if (n_reads_in_flight > 1) {
+            stream.reset(new ReadAheadFileStream(filename_, n_reads_in_flight));
+        } else {
+            stream.reset(new std::ifstream(filename_, std::ios::binary));
+        }
+        return std::make_unique<I_EventsStream>(std::make_unique<FileDataTransfer>(std::move(stream), 1, config),
+                                                std::make_shared<MockHWIdentification>());
+    }
+
+    // Reads the whole stream as a consumer would do
+    std::vector<uint8_t> read_all(I_EventsStream &es) {
+        std::vector<uint8_t> read;
+        es.start();
+        while (es.wait_next_buffer() > 0) {
+            long n_rawbytes                 = 0;
+            I_EventsStream::RawData *buffer = es.get_latest_raw_data(n_rawbytes);
+            read.insert(read.end(), buffer, buffer + n_rawbytes);
+        }
+        es.stop();
+        return read;
+    }
+
+    // Reads the whole stream with async_wait_next_buffer, the handlers posting the status to the consuming thread as
+    // an executor would do
+    std::vector<uint8_t> read_all_async(I_EventsStream &es) {
+        std::mutex mutex;
+        std::condition_variable cond;
+        std::deque<short> statuses;
+        auto post = [&](short status) {
+            std::lock_guard<std::mutex> lock(mutex);
+            statuses.push_back(status);
+            cond.notify_one();
+        };
+
+        std::vector<uint8_t> read;
+        es.start();
+        es.async_wait_next_buffer(post);
+        while (true) {
+            short status;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                cond.wait(lock, [&]() { return !statuses.empty(); });
+                status = statuses.front();
+                statuses.pop_front();
+            }
+            if (status <= 0) {
+                break;
+            }
+            long n_rawbytes                 = 0;
+            I_EventsStream::RawData *buffer = es.get_latest_raw_data(n_rawbytes);
+            read.insert(read.end(), buffer, buffer + n_rawbytes);
+            es.async_wait_next_buffer(post);
+        }
+        es.stop();
+        return read;
+    }
+
+    std::string filename_;
+    std::vector<uint8_t> data_;
+};
+
+TEST_F(I_EventsStream_GTest, read_all_with_default_handoff) {
+    auto es = make_events_stream();
+    ASSERT_EQ(data_, read_all(*es));
+}
+
+TEST_F(I_EventsStream_GTest, read_all_with_lock_free_handoff) {
+    // GIVEN a ring smaller than the number of buffers in the file, so that the producer has to wait
+    auto es = make_events_stream();
+    es->set_lock_free_handoff(2);
+
+    // THEN all the data is received, in order
+    ASSERT_EQ(data_, read_all(*es));
+}
+
+TEST_F(I_EventsStream_GTest, read_all_with_lock_free_handoff_and_spinning) {
+    auto es = make_events_stream();
+    es->set_lock_free_handoff(8, 1000);
+    ASSERT_EQ(data_, read_all(*es));
+
+    // WHEN restarting the stream after a full read
+    // THEN it can be stopped without hanging and the handoff mode can be changed again
+    es->start();
+    es->stop();
+    ASSERT_NO_THROW(es->set_lock_free_handoff(0));
+}
+
+TEST_F(I_EventsStream_GTest, read_all_with_read_ahead) {
+    // The consumer keeps a reference on the last buffer returned, which must not prevent reads from progressing
+    auto es = make_events_stream(8);
+    ASSERT_EQ(data_, read_all(*es));
+
+    es = make_events_stream(8);
+    es->set_lock_free_handoff(2);
+    ASSERT_EQ(data_, read_all(*es));
+}
+
+TEST_F(I_EventsStream_GTest, log_raw_data_async) {
+    const std::string record_filename = tmpdir_handler_->get_full_path("record.raw");
+    auto es                           = make_events_stream();
+    es->set_underlying_filename(filename_);
+
+    // GIVEN a stream logged asynchronously
+    ASSERT_FALSE(es->log_raw_data_async(filename_));
+    ASSERT_TRUE(es->log_raw_data_async(record_filename));
+
+    // WHEN reading the whole stream
+    ASSERT_EQ(data_, read_all(*es));
+
+    // THEN the record, once stopped, contains a header followed by all the data read
+    es->stop_log_raw_data();
+    ASSERT_EQ(0, es->get_log_raw_data_queue_depth());
+    ASSERT_EQ(0, es->get_log_raw_data_bytes_behind());
+
+    std::ifstream ifs(record_filename, std::ios::binary);
+    const std::vector<uint8_t> record((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+    ASSERT_GT(record.size(), data_.size());
+    ASSERT_TRUE(std::equal(data_.begin(), data_.end(), record.end() - data_.size()));
+    ASSERT_EQ('%', record[0]);
+}
+
+TEST_F(I_EventsStream_GTest, log_raw_data_rotating) {
+    RawFileRotationConfig config;
+    config.basename_ = tmpdir_handler_->get_full_path("record");
+    auto es          = make_events_stream();
+
+    // GIVEN a stream logged in a sequence of files, the first one being the file read
+    es->set_underlying_filename(RotatingRawFileWriter::get_filename(config, 0));
+    ASSERT_FALSE(es->log_raw_data_rotating(config));
+    ASSERT_FALSE(es->rotate_log_raw_data());
+    es->set_underlying_filename(filename_);
+    ASSERT_TRUE(es->log_raw_data_rotating(config));
+
+    // WHEN requesting a rotation while reading the whole stream
+    std::vector<uint8_t> read;
+    es->start();
+    while (es->wait_next_buffer() > 0) {
+        long n_rawbytes                 = 0;
+        I_EventsStream::RawData *buffer = es->get_latest_raw_data(n_rawbytes);
+        read.insert(read.end(), buffer, buffer + n_rawbytes);
+        if (read.size() == static_cast<size_t>(n_rawbytes)) {
+            ASSERT_TRUE(es->rotate_log_raw_data());
+        }
+    }
+    const auto filenames = es->get_log_raw_data_files();
+    es->stop();
+    ASSERT_EQ(data_, read);
+    ASSERT_TRUE(es->get_log_raw_data_files().empty());
+
+    // THEN the files, once stopped, each contain a header followed by their part of the data read
+    ASSERT_LE(1, filenames.size());
+    std::vector<uint8_t> data;
+    for (const auto &filename : filenames) {
+        std::ifstream ifs(filename, std::ios::binary);
+        ASSERT_EQ('%', ifs.peek());
+        RawFileHeader header(ifs);
+        data.insert(data.end(), std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+    }
+    ASSERT_EQ(data_, data);
+}
+
+TEST_F(I_EventsStream_GTest, log_raw_data_striped) {
+    const std::string manifest_path = tmpdir_handler_->get_full_path("record.stripes");
+    auto es                         = make_events_stream();
+    es->set_underlying_filename(manifest_path);
+
+    // GIVEN a stream logged in stripes across several files
+    StripedRawFileWriterConfig config;
+    config.directories_ = {".", ".", "."};
+    config.stripe_size_ = 4096;
+    ASSERT_FALSE(es->log_raw_data_striped(manifest_path, config));
+    es->set_underlying_filename(filename_);
+    ASSERT_TRUE(es->log_raw_data_striped(manifest_path, config));
+
+    // WHEN reading the whole stream
+    ASSERT_EQ(data_, read_all(*es));
+
+    // THEN the recording, once stopped, is read back as the header followed by all the data read
+    es->stop_log_raw_data();
+    auto stream = RawFilePlaylistStream::open_stripes(manifest_path);
+    RawFileHeader header(*stream);
+    const std::vector<uint8_t> record((std::istreambuf_iterator<char>(*stream)), std::istreambuf_iterator<char>());
+    ASSERT_EQ(data_, record);
+}
+
+TEST_F(I_EventsStream_GTest, log_raw_data_mapped) {
+    const std::string record_filename = tmpdir_handler_->get_full_path("record.raw");
+    auto es                           = make_events_stream();
+    es->set_underlying_filename(filename_);
+
+    // GIVEN a stream logged in a preallocated file, large enough for the header and the data
+    MappedFileWriterConfig config;
+    config.capacity_   = data_.size() + 64 * 1024;
+    config.flush_size_ = 4096;
+    ASSERT_FALSE(es->log_raw_data_mapped(filename_, config));
+    ASSERT_TRUE(es->log_raw_data_mapped(record_filename, config));
+
+    // WHEN reading the whole stream
+    ASSERT_EQ(data_, read_all(*es));
+
+    // THEN the record, once stopped, is truncated to a header followed by all the data read
+    ASSERT_EQ(0, es->get_log_raw_data_dropped_bytes());
+    es->stop_log_raw_data();
+    std::ifstream ifs(record_filename, std::ios::binary);
+    RawFileHeader header(ifs);
+    const std::vector<uint8_t> record((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+    ASSERT_EQ(data_, record);
+}
+
+TEST_F(I_EventsStream_GTest, log_raw_data_mapped_drops_data_beyond_capacity) {
+    const std::string record_filename = tmpdir_handler_->get_full_path("record.raw");
+    auto es                           = make_events_stream();
+
+    // GIVEN a stream logged in a preallocated file too small for the data
+    MappedFileWriterConfig config;
+    config.capacity_     = 4096;
+    config.flush_policy_ = MappedFileWriterConfig::FlushPolicy::None;
+    ASSERT_TRUE(es->log_raw_data_mapped(record_filename, config));
+
+    // WHEN reading the whole stream
+    es->start();
+    while (es->wait_next_buffer() > 0) {
+        long n_rawbytes = 0;
+        es->get_latest_raw_data(n_rawbytes);
+    }
+
+    // THEN the data that does not fit is dropped and counted until the logging stops
+    ASSERT_LE(data_.size() - 4096, es->get_log_raw_data_dropped_bytes());
+    es->stop();
+    ASSERT_EQ(0, es->get_log_raw_data_dropped_bytes());
+    std::ifstream ifs(record_filename, std::ios::binary | std::ios::ate);
+    ASSERT_GE(4096, ifs.tellg());
+}
+
+TEST_F(I_EventsStream_GTest, record_flight) {
+    const std::string record_filename = tmpdir_handler_->get_full_path("flight.raw");
+    auto es                           = make_events_stream();
+    // The recorder holds all the buffers of the file, which must be allocated on top of the pool
+    DataTransfer::ElasticBufferingConfig buffering_config;
+    buffering_config.max_extra_bytes = 10 * data_.size();
+    es->set_elastic_buffering(buffering_config);
+
+    // GIVEN a flight recorder keeping more than the duration of the stream
+    RawFlightRecorderConfig config;
+    config.pre_trigger_ms_ = 60000;
+    auto recorder          = es->record_flight(config);
+
+    // WHEN reading the whole stream, then triggering a dump
+    ASSERT_EQ(data_, read_all(*es));
+    ASSERT_TRUE(recorder->trigger(record_filename));
+    es->stop_record_flight();
+    recorder.reset();
+
+    // THEN the record contains a header followed by all the data read
+    std::ifstream ifs(record_filename, std::ios::binary);
+    const std::vector<uint8_t> record((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+    ASSERT_GT(record.size(), data_.size());
+    ASSERT_TRUE(std::equal(data_.begin(), data_.end(), record.end() - data_.size()));
+    ASSERT_EQ('%', record[0]);
+}
+
+TEST_F(I_EventsStream_GTest, lock_free_handoff_can_not_be_set_while_running) {
+    auto es = make_events_stream();
+    es->start();
+    ASSERT_THROW(es->set_lock_free_handoff(4), HalException);
+    es->stop();
+}
+
+TEST_F(I_EventsStream_GTest, delivery_subsampling_records_all_buffers) {
+    const std::string record_filename = tmpdir_handler_->get_full_path("record.raw");
+    auto es                           = make_events_stream();
+
+    // GIVEN a stream logged asynchronously, delivering one buffer in 3
+    es->set_delivery_subsampling(3);
+    ASSERT_EQ(3, es->get_delivery_subsampling());
+    ASSERT_TRUE(es->log_raw_data_async(record_filename));
+
+    // WHEN reading the whole stream
+    const std::vector<uint8_t> read = read_all(*es);
+
+    // THEN only the first buffer of each group of 3 buffers of 100 bytes is delivered
+    std::vector<uint8_t> expected;
+    for (size_t i = 0; i < data_.size(); i += 300) {
+        expected.insert(expected.end(), data_.begin() + i, data_.begin() + std::min(i + 100, data_.size()));
+    }
+    ASSERT_EQ(expected, read);
+
+    // THEN the record contains all the data nonetheless
+    es->stop_log_raw_data();
+    std::ifstream ifs(record_filename, std::ios::binary);
+    const std::vector<uint8_t> record((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+    ASSERT_GT(record.size(), data_.size());
+    ASSERT_TRUE(std::equal(data_.begin(), data_.end(), record.end() - data_.size()));
+}
+
+TEST_F(I_EventsStream_GTest, delivery_subsampling_of_0_only_records) {
+    const std::string record_filename = tmpdir_handler_->get_full_path("record.raw");
+    auto es                           = make_events_stream();
+    es->set_lock_free_handoff(2);
+
+    // GIVEN a stream logged asynchronously, delivering no buffer
+    es->set_delivery_subsampling(0);
+    ASSERT_TRUE(es->log_raw_data_async(record_filename));
+
+    // WHEN reading the whole stream
+    // THEN no data is delivered, and the stream ends with the file
+    ASSERT_TRUE(read_all(*es).empty());
+
+    // THEN the record contains all the data
+    es->stop_log_raw_data();
+    std::ifstream ifs(record_filename, std::ios::binary);
+    const std::vector<uint8_t> record((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+    ASSERT_GT(record.size(), data_.size());
+    ASSERT_TRUE(std::equal(data_.begin(), data_.end(), record.end() - data_.size()));
+}
+
+TEST_F(I_EventsStream_GTest, delivery_subsampling_can_not_be_set_while_running) {
+    auto es = make_events_stream();
+    es->start();
+    ASSERT_THROW(es->set_delivery_subsampling(2), HalException);
+    es->stop();
+    ASSERT_NO_THROW(es->set_delivery_subsampling(2));
+}
+
+TEST_F(I_EventsStream_GTest, latest_raw_data_arrival_time) {
+    auto es = make_events_stream();
+    ASSERT_EQ(std::chrono::steady_clock::time_point(), es->get_latest_raw_data_arrival_time());
+
+    // WHEN reading the whole stream
+    const auto start = std::chrono::steady_clock::now();
+    es->start();
+    auto previous_arrival_time = start;
+    while (es->wait_next_buffer() > 0) {
+        long n_rawbytes = 0;
+        es->get_latest_raw_data(n_rawbytes);
+
+        // THEN each buffer has been stamped when transferred, before being returned, in order
+        const auto arrival_time = es->get_latest_raw_data_arrival_time();
+        ASSERT_LE(previous_arrival_time, arrival_time);
+        ASSERT_LE(arrival_time, std::chrono::steady_clock::now());
+        previous_arrival_time = arrival_time;
+    }
+    es->stop();
+    ASSERT_LT(start, previous_arrival_time);
+}
+
+TEST_F(I_EventsStream_GTest, read_all_with_wakeup_coalescing) {
+    auto es = make_events_stream();
+
+    // GIVEN a stream waking up the consumer once 300 bytes are available, i.e. 3 buffers
+    I_EventsStream::WakeupCoalescingConfig config;
+    config.min_bytes = 300;
+    es->set_wakeup_coalescing(config);
+    ASSERT_EQ(300u, es->get_wakeup_coalescing().min_bytes);
+
+    // WHEN reading the whole stream
+    // THEN all the data is delivered, in order
+    ASSERT_EQ(data_, read_all(*es));
+}
+
+TEST_F(I_EventsStream_GTest, wakeup_coalescing_merges_tiny_buffers) {
+    auto data_transfer = std::make_unique<LiveDataTransfer>();
+    I_EventsStream es(std::move(data_transfer), std::make_shared<MockHWIdentification>());
+
+    // GIVEN a live stream of buffers of one byte, waking up the consumer once 20 bytes are available
+    I_EventsStream::WakeupCoalescingConfig config;
+    config.min_bytes   = 20;
+    config.max_latency = std::chrono::seconds(10);
+    es.set_wakeup_coalescing(config);
+    es.start();
+
+    for (int i = 0; i < 3; ++i) {
+        // WHEN waiting for the next buffer
+        ASSERT_EQ(1, es.wait_next_buffer());
+
+        // THEN the consumer is woken up with at least 20 bytes, merged in one buffer
+        long n_rawbytes = 0;
+        ASSERT_NE(nullptr, es.get_latest_raw_data(n_rawbytes));
+        ASSERT_LE(20, n_rawbytes);
+    }
+    es.stop();
+}
+
+TEST_F(I_EventsStream_GTest, wakeup_coalescing_delivers_data_after_max_latency) {
+    auto data_transfer = std::make_unique<LiveDataTransfer>();
+    I_EventsStream es(std::move(data_transfer), std::make_shared<MockHWIdentification>());
+
+    // GIVEN a live stream waking up the consumer once 1MB is available, or after 5ms
+    I_EventsStream::WakeupCoalescingConfig config;
+    config.min_bytes   = 1 << 20;
+    config.max_latency = std::chrono::milliseconds(5);
+    es.set_wakeup_coalescing(config);
+    es.start();
+
+    // WHEN waiting for the next buffer
+    // THEN the consumer is woken up when the oldest buffer has waited for 5ms
+    ASSERT_EQ(1, es.wait_next_buffer());
+    long n_rawbytes = 0;
+    ASSERT_NE(nullptr, es.get_latest_raw_data(n_rawbytes));
+    ASSERT_LE(std::chrono::milliseconds(5),
+              std::chrono::steady_clock::now() - es.get_latest_raw_data_arrival_time());
+    es.stop();
+}
+
+TEST_F(I_EventsStream_GTest, wakeup_coalescing_can_not_be_set_while_running_or_with_lock_free_handoff) {
+    auto es = make_events_stream();
+    I_EventsStream::WakeupCoalescingConfig config;
+    config.min_bytes = 1000;
+    es->start();
+    ASSERT_THROW(es->set_wakeup_coalescing(config), HalException);
+    es->stop();
+
+    es->set_lock_free_handoff(4);
+    ASSERT_THROW(es->set_wakeup_coalescing(config), HalException);
+    es->set_lock_free_handoff(0);
+    ASSERT_NO_THROW(es->set_wakeup_coalescing(config));
+    ASSERT_THROW(es->set_lock_free_handoff(4), HalException);
+}
+
+TEST_F(I_EventsStream_GTest, read_all_with_async_wait) {
+    auto es = make_events_stream();
+    ASSERT_EQ(data_, read_all_async(*es));
+}
+
+TEST_F(I_EventsStream_GTest, read_all_with_async_wait_and_lock_free_handoff) {
+    auto es = make_events_stream();
+    es->set_lock_free_handoff(2);
+    ASSERT_EQ(data_, read_all_async(*es));
+}
+
+TEST_F(I_EventsStream_GTest, async_wait_on_stopped_stream_calls_handler_right_away) {
+    auto es      = make_events_stream();
+    short status = 0;
+    es->async_wait_next_buffer([&status](short s) { status = s; });
+    ASSERT_EQ(-1, status);
+}
+
+TEST_F(I_EventsStream_GTest, pending_async_wait_is_completed_by_stop) {
+    I_EventsStream es(std::make_unique<IdleDataTransfer>(), std::make_shared<MockHWIdentification>());
+    es.start();
+
+    // GIVEN a handler waiting for data that never comes
+    std::atomic<int> num_calls{0};
+    std::atomic<short> status{0};
+    es.async_wait_next_buffer([&](short s) {
+        status = s;
+        ++num_calls;
+    });
+    ASSERT_EQ(0, num_calls);
+
+    // THEN a second handler can not be registered
+    ASSERT_THROW(es.async_wait_next_buffer([](short) {}), HalException);
+
+    // WHEN stopping the stream
+    es.stop();
+
+    // THEN the handler is called once, with the end of stream status
+    ASSERT_EQ(1, num_calls);
+    ASSERT_EQ(-1, status);
+}
+
+TEST_F(I_EventsStream_GTest, pause_and_resume_file_stream_without_losing_data) {
+    // GIVEN a stream reading a file, with a ring small enough for the reading to be throttled by the consumer
+    auto es = make_events_stream();
+    es->set_lock_free_handoff(2);
+    std::vector<uint8_t> read;
+    auto read_available = [&]() {
+        while (es->poll_buffer() > 0) {
+            long n_rawbytes                 = 0;
+            I_EventsStream::RawData *buffer = es->get_latest_raw_data(n_rawbytes);
+            read.insert(read.end(), buffer, buffer + n_rawbytes);
+        }
+    };
+    es->start();
+    ASSERT_EQ(1, es->wait_next_buffer());
+
+    // WHEN pausing the stream and reading the buffers transferred before
+    es->pause();
+    ASSERT_TRUE(es->is_paused());
+    for (int i = 0; i < 3; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        read_available();
+    }
+
+    // THEN the file is not read anymore
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    ASSERT_EQ(0, es->poll_buffer());
+    ASSERT_LT(read.size(), data_.size());
+
+    // WHEN resuming the stream
+    es->resume();
+    ASSERT_FALSE(es->is_paused());
+    while (es->wait_next_buffer() > 0) {
+        read_available();
+    }
+    es->stop();
+
+    // THEN all the data is received, in order
+    ASSERT_EQ(data_, read);
+}
+
+TEST_F(I_EventsStream_GTest, paused_file_stream_can_be_stopped) {
+    auto es = make_events_stream();
+    es->set_lock_free_handoff(2);
+    es->start();
+    es->pause();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    // WHEN stopping the paused stream, whose reading waits to be resumed
+    // THEN it does not hang, and starting it again resumes it
+    es->stop();
+    es->start();
+    ASSERT_FALSE(es->is_paused());
+    ASSERT_EQ(1, es->wait_next_buffer());
+    es->stop();
+}
+
+TEST_F(I_EventsStream_GTest, pause_and_resume_live_stream) {
+    auto data_transfer = std::make_unique<LiveDataTransfer>();
+    auto &live         = *data_transfer;
+    I_EventsStream es(std::move(data_transfer), std::make_shared<MockHWIdentification>());
+    auto drop_available = [&es]() {
+        long n_rawbytes = 0;
+        while (es.poll_buffer() > 0) {
+            es.get_latest_raw_data(n_rawbytes);
+        }
+    };
+    es.start();
+    ASSERT_EQ(1, es.wait_next_buffer());
+
+    // WHEN pausing the stream
+    es.pause();
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    drop_available();
+    const int num_transfers_paused = live.num_transfers;
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    // THEN the source keeps running, but its data is dropped
+    ASSERT_GT(live.num_transfers, num_transfers_paused);
+    ASSERT_EQ(0, es.poll_buffer());
+
+    // WHEN resuming the stream
+    es.resume();
+
+    // THEN the data is received again
+    ASSERT_EQ(1, es.wait_next_buffer());
+
+    // AND the stream can be stopped while paused
+    es.pause();
+    es.stop();
+    ASSERT_EQ(-1, es.poll_buffer());
+}
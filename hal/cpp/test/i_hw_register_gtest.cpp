@@ -0,0 +1,124 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "metavision/hal/facilities/i_hw_register.h"
+
+using namespace Metavision;
+
+namespace {
+
+// Registers accessed by address, the names "reg<address>" being known for the addresses below 0x100
+class MockHWRegister : public I_HW_Register {
+public:
+    void write_register(uint32_t address, uint32_t v) override {
+        log.push_back("w" + std::to_string(address));
+        registers[address] = v;
+    }
+
+    void write_register(const std::string &address, uint32_t v) override {
+        log.push_back("w" + address);
+        named_registers[address] = v;
+    }
+
+    uint32_t read_register(uint32_t address) override {
+        log.push_back("r" + std::to_string(address));
+        return registers[address];
+    }
+
+    uint32_t read_register(const std::string &address) override {
+        return named_registers[address];
+    }
+
+    void write_register(const std::string &address, const std::string &bitfield, uint32_t v) override {
+        log.push_back("w" + address + "." + bitfield);
+        named_registers[address + "." + bitfield] = v;
+    }
+
+    uint32_t read_register(const std::string &address, const std::string &bitfield) override {
+        return named_registers[address + "." + bitfield];
+    }
+
+    void write_registers(const std::vector<std::pair<uint32_t, uint32_t>> &writes) override {
+        log.push_back("batch" + std::to_string(writes.size()));
+        I_HW_Register::write_registers(writes);
+    }
+
+    std::map<uint32_t, uint32_t> registers;
+    std::map<std::string, uint32_t> named_registers;
+    std::vector<std::string> log;
+    int num_lookups = 0;
+
+protected:
+    bool lookup_register_address(const std::string &name, uint32_t &address) override {
+        ++num_lookups;
+        if (name.compare(0, 3, "reg") != 0) {
+            return false;
+        }
+        address = std::stoul(name.substr(3));
+        return address < 0x100;
+    }
+};
+
+} // anonymous namespace
+
+TEST(I_HW_Register_GTest, write_and_read_registers) {
+    MockHWRegister hw_register;
+    hw_register.write_registers({{1, 10}, {2, 20}, {1, 11}});
+    EXPECT_EQ((std::vector<std::string>{"batch3", "w1", "w2", "w1"}), hw_register.log);
+    EXPECT_EQ(11u, hw_register.registers[1]);
+    EXPECT_EQ(20u, hw_register.registers[2]);
+
+    EXPECT_EQ((std::vector<uint32_t>{20, 11, 0}), hw_register.read_registers({2, 1, 3}));
+    EXPECT_TRUE(hw_register.read_registers({}).empty());
+}
+
+TEST(I_HW_Register_GTest, write_register_bitfields) {
+    MockHWRegister hw_register;
+    hw_register.write_register_bitfields("ctrl", {{"enable", 1}, {"mode", 3}});
+    EXPECT_EQ((std::vector<std::string>{"wctrl.enable", "wctrl.mode"}), hw_register.log);
+    EXPECT_EQ(1u, hw_register.read_register("ctrl", "enable"));
+    EXPECT_EQ(3u, hw_register.read_register("ctrl", "mode"));
+}
+
+TEST(I_HW_Register_GTest, write_registers_by_name_coalesces_known_addresses) {
+    MockHWRegister hw_register;
+    hw_register.write_registers_by_name({{"reg1", 10}, {"reg2", 20}, {"other", 30}, {"reg3", 40}, {"reg1000", 50}});
+
+    // The registers whose address is known are written in batches, without changing the order of the writes
+    EXPECT_EQ((std::vector<std::string>{"batch2", "w1", "w2", "wother", "batch1", "w3", "wreg1000"}), hw_register.log);
+    EXPECT_EQ(10u, hw_register.registers[1]);
+    EXPECT_EQ(20u, hw_register.registers[2]);
+    EXPECT_EQ(40u, hw_register.registers[3]);
+    EXPECT_EQ(30u, hw_register.named_registers["other"]);
+    EXPECT_EQ(50u, hw_register.named_registers["reg1000"]);
+}
+
+TEST(I_HW_Register_GTest, register_addresses_are_cached) {
+    MockHWRegister hw_register;
+    uint32_t address = 0;
+    ASSERT_TRUE(hw_register.get_register_address("reg42", address));
+    EXPECT_EQ(42u, address);
+    ASSERT_TRUE(hw_register.get_register_address("reg42", address));
+    EXPECT_EQ(42u, address);
+    EXPECT_EQ(1, hw_register.num_lookups);
+
+    // The names whose address is unknown are looked up again, as the facility may learn them later
+    EXPECT_FALSE(hw_register.get_register_address("other", address));
+    EXPECT_FALSE(hw_register.get_register_address("other", address));
+    EXPECT_EQ(3, hw_register.num_lookups);
+}
@@ -32,6 +32,123 @@ using namespace Metavision;
 
 class I_ROI_GTest : public GTestWithTmpDir {};
 
+namespace {
+
+// ROI of a 64x32 sensor, whose bitword is made of a word per 32 columns followed by a word per 32 rows
+class MockROI : public I_ROI {
+public:
+    MockROI(bool write_changed_words) : write_changed_words_(write_changed_words) {}
+
+    using I_ROI::set_ROIs;
+
+    void enable(bool state) override {
+        enabled = state;
+    }
+
+    void set_ROIs_from_bitword(const std::vector<uint32_t> &vroiparams, bool enable) override {
+        bitword = vroiparams;
+        enabled = enable;
+        ++num_full_writes;
+    }
+
+    bool set_ROIs(const std::vector<bool> &, const std::vector<bool> &, bool) override {
+        return false;
+    }
+
+    std::vector<uint32_t> create_ROIs(const std::vector<DeviceRoi> &vroi) override {
+        std::vector<uint32_t> vroiparams(3, 0);
+        for (const auto &roi : vroi) {
+            for (int x = roi.x_; x < roi.x_ + roi.width_; ++x) {
+                vroiparams[x / 32] |= 1u << (x % 32);
+            }
+            for (int y = roi.y_; y < roi.y_ + roi.height_; ++y) {
+                vroiparams[2] |= 1u << y;
+            }
+        }
+        return vroiparams;
+    }
+
+    std::vector<uint32_t> bitword;
+    std::vector<std::pair<size_t, uint32_t>> last_changed_words;
+    bool enabled        = false;
+    int num_full_writes = 0;
+
+protected:
+    void set_ROIs_words(const std::vector<std::pair<size_t, uint32_t>> &changed_words,
+                        const std::vector<uint32_t> &vroiparams) override {
+        last_changed_words = changed_words;
+        if (!write_changed_words_) {
+            I_ROI::set_ROIs_words(changed_words, vroiparams);
+            return;
+        }
+        bitword.resize(vroiparams.size());
+        for (const auto &word : changed_words) {
+            bitword[word.first] = word.second;
+        }
+        enabled = true;
+    }
+
+private:
+    const bool write_changed_words_;
+};
+
+} // anonymous namespace
+
+TEST_F(I_ROI_GTest, update_rois_writes_only_changed_words) {
+    MockROI roi(true);
+
+    // The first update programs the whole bitword
+    EXPECT_EQ(3u, roi.update_ROIs({DeviceRoi(0, 0, 4, 4)}));
+    EXPECT_EQ(roi.create_ROIs({DeviceRoi(0, 0, 4, 4)}), roi.bitword);
+    EXPECT_TRUE(roi.enabled);
+
+    // Moving the ROI horizontally in the first 32 columns only changes the first word
+    EXPECT_EQ(1u, roi.update_ROIs({DeviceRoi(8, 0, 4, 4)}));
+    ASSERT_EQ(1u, roi.last_changed_words.size());
+    EXPECT_EQ(0u, roi.last_changed_words[0].first);
+    EXPECT_EQ(roi.create_ROIs({DeviceRoi(8, 0, 4, 4)}), roi.bitword);
+
+    // Moving it to the other columns and rows changes all the words
+    EXPECT_EQ(3u, roi.update_ROIs({DeviceRoi(40, 8, 4, 4)}));
+    EXPECT_EQ(roi.create_ROIs({DeviceRoi(40, 8, 4, 4)}), roi.bitword);
+
+    // Nothing changes when the ROI is the same
+    EXPECT_EQ(0u, roi.update_ROIs({DeviceRoi(40, 8, 4, 4)}));
+    EXPECT_EQ(0, roi.num_full_writes);
+
+    const auto &stats = roi.get_update_statistics();
+    EXPECT_EQ(4u, stats.num_updates);
+    EXPECT_EQ(7u, stats.num_words_written);
+    EXPECT_LE(stats.last_duration_us, stats.max_duration_us);
+    EXPECT_LE(stats.max_duration_us, stats.total_duration_us);
+}
+
+TEST_F(I_ROI_GTest, update_rois_after_set_or_invalidate) {
+    MockROI roi(true);
+
+    // The ROIs set from their geometry are known by the updates
+    roi.set_ROIs({DeviceRoi(0, 0, 4, 4)}, false);
+    EXPECT_FALSE(roi.enabled);
+    EXPECT_EQ(1u, roi.update_ROIs({DeviceRoi(0, 4, 4, 4)}));
+    EXPECT_TRUE(roi.enabled);
+
+    // After an invalidation, the whole bitword is programmed
+    roi.invalidate_ROIs_update();
+    EXPECT_EQ(3u, roi.update_ROIs({DeviceRoi(0, 4, 4, 4)}));
+    EXPECT_EQ(roi.create_ROIs({DeviceRoi(0, 4, 4, 4)}), roi.bitword);
+}
+
+TEST_F(I_ROI_GTest, update_rois_default_programs_whole_bitword) {
+    MockROI roi(false);
+    roi.enable(false);
+
+    EXPECT_EQ(3u, roi.update_ROIs({DeviceRoi(0, 0, 4, 4)}));
+    EXPECT_EQ(1u, roi.update_ROIs({DeviceRoi(0, 4, 4, 4)}));
+    EXPECT_EQ(2, roi.num_full_writes);
+    EXPECT_EQ(roi.create_ROIs({DeviceRoi(0, 4, 4, 4)}), roi.bitword);
+    EXPECT_TRUE(roi.enabled);
+}
+
 TEST_F_WITH_CAMERA(I_ROI_GTest, roi_columns_lines_with_camera) {
     std::unique_ptr<Device> device;
     try {
@@ -0,0 +1,195 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "metavision/hal/utils/compressed_raw_file.h"
+#include "metavision/hal/utils/file_data_transfer.h"
+#include "metavision/hal/utils/hal_exception.h"
+#include "metavision/hal/utils/network_raw_stream.h"
+#include "metavision/hal/utils/raw_file_config.h"
+#include "metavision/hal/utils/raw_file_header.h"
+
+using namespace Metavision;
+
+namespace {
+
+// Waits until the server has @p n_clients clients
+void wait_for_clients(NetworkRawStreamServer &server, size_t n_clients) {
+    for (int i = 0; i < 500 && server.get_n_clients() != n_clients; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_EQ(n_clients, server.get_n_clients());
+}
+
+std::vector<uint8_t> make_data(size_t size) {
+    std::vector<uint8_t> data(size);
+    for (size_t i = 0; i < size; ++i) {
+        data[i] = static_cast<uint8_t>(i / 16);
+    }
+    return data;
+}
+
+} // namespace
+
+TEST(NetworkRawStream_GTest, client_gets_header_and_data_sent_after_it_connected) {
+    NetworkRawStreamServer server(0, "% integrator_name Prophesee\n% plugin_name dummy\n");
+    server.send(make_data(10).data(), 10);
+    NetworkRawStream stream("localhost", server.get_port());
+    wait_for_clients(server, 1);
+
+    // WHEN sending data
+    auto data = make_data(1000);
+    server.send(data.data(), data.size());
+
+    // THEN the client reads the header, then the data
+    RawFileHeader header(stream);
+    EXPECT_EQ("Prophesee", header.get_integrator_name());
+    EXPECT_EQ("dummy", header.get_plugin_name());
+
+    std::vector<uint8_t> received(data.size());
+    stream.read(reinterpret_cast<char *>(received.data()), received.size());
+    ASSERT_EQ(data.size(), stream.gcount());
+    EXPECT_EQ(data, received);
+}
+
+TEST(NetworkRawStream_GTest, compressed_data_is_transferred_as_sent) {
+    NetworkRawStreamServerConfig config;
+    config.compression_ = RawCompression::LZ4;
+    std::unique_ptr<NetworkRawStreamServer> server(new NetworkRawStreamServer(0, "% plugin_name dummy\n", config));
+    auto stream = std::make_unique<NetworkRawStream>("127.0.0.1", server->get_port());
+    wait_for_clients(*server, 1);
+
+    // WHEN sending compressible data, then closing the connection
+    std::vector<std::vector<uint8_t>> sent;
+    for (size_t size : {5000, 1, 70000}) {
+        sent.push_back(make_data(size));
+        server->send(sent.back().data(), sent.back().size());
+    }
+    server.reset();
+
+    // THEN the header does not record any compression, and each buffer is transferred decompressed
+    RawFileHeader header(*stream);
+    EXPECT_EQ(RawCompression::None, get_raw_file_compression(header));
+
+    std::mutex mutex;
+    std::condition_variable cond;
+    bool stopped = false;
+    std::vector<std::vector<uint8_t>> transferred;
+    FileDataTransfer transfer(std::move(stream), 1, RawFileConfig());
+    transfer.add_new_slice_callback([&transferred](const DataTransfer::BufferSlice &slice) {
+        transferred.emplace_back(slice.data(), slice.data() + slice.size());
+    });
+    transfer.add_status_changed_callback([&](DataTransfer::Status status) {
+        if (status == DataTransfer::Status::Stopped) {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopped = true;
+            cond.notify_all();
+        }
+    });
+    transfer.start();
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        cond.wait(lock, [&stopped] { return stopped; });
+    }
+    transfer.stop();
+
+    // The first buffer was partly read while parsing the header
+    std::vector<uint8_t> all_sent, all_transferred;
+    for (auto &buffer : sent) {
+        all_sent.insert(all_sent.end(), buffer.begin(), buffer.end());
+    }
+    for (auto &buffer : transferred) {
+        all_transferred.insert(all_transferred.end(), buffer.begin(), buffer.end());
+    }
+    EXPECT_EQ(all_sent, all_transferred);
+    ASSERT_EQ(3, transferred.size());
+    EXPECT_EQ(sent[2], transferred[2]);
+}
+
+TEST(NetworkRawStream_GTest, all_clients_get_the_data) {
+    NetworkRawStreamServer server(0, "");
+    std::vector<std::unique_ptr<NetworkRawStream>> streams;
+    for (int i = 0; i < 3; ++i) {
+        streams.emplace_back(new NetworkRawStream("localhost", server.get_port()));
+    }
+    wait_for_clients(server, 3);
+
+    auto data = make_data(100);
+    server.send(data.data(), data.size());
+    for (auto &stream : streams) {
+        DataTransfer::Buffer received;
+        ASSERT_TRUE(stream->wait_for_data(std::chrono::milliseconds(1000)));
+        ASSERT_TRUE(stream->read_chunk(received));
+        EXPECT_EQ(data, std::vector<uint8_t>(received.begin(), received.end()));
+    }
+}
+
+TEST(NetworkRawStream_GTest, slow_client_is_disconnected) {
+    NetworkRawStreamServerConfig config;
+    config.max_queued_bytes_ = 1024 * 1024;
+    NetworkRawStreamServer server(0, "", config);
+    NetworkRawStream stream("localhost", server.get_port());
+    wait_for_clients(server, 1);
+
+    // WHEN sending much more data than the client reads and the system buffers
+    auto data = make_data(1024 * 1024);
+    for (int i = 0; i < 256 && server.get_n_clients() != 0; ++i) {
+        server.send(data.data(), data.size());
+    }
+
+    // THEN the client is disconnected, and its stream ends
+    EXPECT_EQ(0, server.get_n_clients());
+    DataTransfer::Buffer received;
+    while (stream.read_chunk(received)) {}
+}
+
+TEST(NetworkRawStream_GTest, client_not_reading_does_not_block_the_server) {
+    NetworkRawStreamServerConfig config;
+    config.max_queued_bytes_ = 8 * 1024 * 1024;
+    NetworkRawStreamServer server(0, "", config);
+    NetworkRawStream stream("localhost", server.get_port());
+    wait_for_clients(server, 1);
+
+    // WHEN sending data at a steady rate to a client that never reads, so that the thread sending the data to the
+    // client gets blocked once the system buffers are full
+    auto data            = make_data(1024 * 1024);
+    auto max_send_period = std::chrono::steady_clock::duration::zero();
+    for (int i = 0; i < 500 && server.get_n_clients() != 0; ++i) {
+        const auto start = std::chrono::steady_clock::now();
+        server.send(data.data(), data.size());
+        max_send_period = std::max(max_send_period, std::chrono::steady_clock::now() - start);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+
+    // THEN the client is disconnected, without the server being blocked meanwhile
+    EXPECT_EQ(0, server.get_n_clients());
+    EXPECT_GT(std::chrono::seconds(1), max_send_period);
+    server.send(data.data(), data.size());
+}
+
+TEST(NetworkRawStream_GTest, connection_to_unknown_server_throws) {
+    uint16_t port;
+    {
+        NetworkRawStreamServer server(0, "");
+        port = server.get_port();
+    }
+    EXPECT_THROW(NetworkRawStream("localhost", port), HalException);
+}
@@ -0,0 +1,197 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <memory>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "metavision/hal/decoders/evt2_decoder.h"
+#include "metavision/hal/decoders/evt3_decoder.h"
+#include "metavision/hal/decoders/detail/evt2_raw_format.h"
+#include "metavision/hal/decoders/detail/evt3_raw_format.h"
+#include "metavision/hal/utils/parallel_decoder.h"
+
+using namespace Metavision;
+
+namespace {
+
+template<typename Decoder>
+std::unique_ptr<I_Decoder> make_decoder(bool time_shifting_enabled,
+                                        const std::shared_ptr<I_EventDecoder<EventCD>> &event_cd_decoder,
+                                        const std::shared_ptr<I_EventDecoder<EventExtTrigger>> &event_trigger_decoder) {
+    return std::unique_ptr<I_Decoder>(new Decoder(time_shifting_enabled, event_cd_decoder, event_trigger_decoder));
+}
+
+// EVT3 decoder that does not support resynchronization
+class SequentialEVT3Decoder : public I_Decoder {
+public:
+    SequentialEVT3Decoder(bool time_shifting_enabled, const std::shared_ptr<I_EventDecoder<EventCD>> &event_cd_decoder,
+                          const std::shared_ptr<I_EventDecoder<EventExtTrigger>> &event_trigger_decoder) :
+        I_Decoder(time_shifting_enabled), decoder_(time_shifting_enabled, event_cd_decoder, event_trigger_decoder) {}
+
+    timestamp get_last_timestamp() const override {
+        return decoder_.get_last_timestamp();
+    }
+
+    bool get_timestamp_shift(timestamp &timestamp_shift) const override {
+        return decoder_.get_timestamp_shift(timestamp_shift);
+    }
+
+    uint8_t get_raw_event_size_bytes() const override {
+        return decoder_.get_raw_event_size_bytes();
+    }
+
+private:
+    void decode_impl(RawData *raw_data_begin, RawData *raw_data_end) override {
+        decoder_.decode(raw_data_begin, raw_data_end);
+    }
+
+    EVT3Decoder decoder_;
+};
+
+uint16_t make_evt3_word(Evt3::EventTypes type, uint16_t payload) {
+    return static_cast<uint16_t>((static_cast<uint16_t>(type) << Evt3::TypeShift) | payload);
+}
+
+// Stream of about 40s, so that the EVT3 time high loops twice
+std::vector<uint16_t> make_evt3_stream() {
+    std::vector<uint16_t> words;
+    timestamp time_high = -1;
+    for (timestamp t = 1000, i = 0; t < 40000000; t += (i % 50 == 49 ? 500000 : 997), ++i) {
+        if ((t >> Evt3::TimeLowBits) != time_high) {
+            time_high = t >> Evt3::TimeLowBits;
+            words.push_back(make_evt3_word(Evt3::EventTypes::EVT_TIME_HIGH, time_high & Evt3::TimeMask));
+        }
+        words.push_back(make_evt3_word(Evt3::EventTypes::EVT_TIME_LOW, t & Evt3::TimeMask));
+        words.push_back(make_evt3_word(Evt3::EventTypes::CD_Y, i % 480));
+        words.push_back(make_evt3_word(Evt3::EventTypes::X_BASE, ((i % 2) << Evt3::PolarityShift) | (i % 600)));
+        words.push_back(make_evt3_word(Evt3::EventTypes::VECT_12, (i * 37) & Evt3::Vect12Mask));
+        words.push_back(make_evt3_word(Evt3::EventTypes::X_POS, 639));
+        if (i % 23 == 0) {
+            words.push_back(make_evt3_word(Evt3::EventTypes::EXT_TRIGGER, ((i % 3) << Evt3::TriggerIdShift) | (i % 2)));
+        }
+    }
+    return words;
+}
+
+// Stream where the EVT2 time high loops twice
+std::vector<uint32_t> make_evt2_stream() {
+    std::vector<uint32_t> words;
+    const timestamp step = timestamp(1) << 22;
+    for (timestamp t = 64, i = 0; t < 2 * (timestamp(1) << 34) + 10 * step; t += step, ++i) {
+        words.push_back((static_cast<uint32_t>(Evt2::EventTypes::EVT_TIME_HIGH) << Evt2::TypeShift) |
+                        static_cast<uint32_t>((t >> Evt2::TimestampLsbBits) & Evt2::TsMsbMask));
+        for (uint32_t j = 0; j < 11; ++j) {
+            words.push_back((static_cast<uint32_t>(j % 2) << Evt2::TypeShift) | ((j * 5) << Evt2::TimestampShift) |
+                            ((i % 640) << Evt2::XShift) | j);
+        }
+    }
+    return words;
+}
+
+} // namespace
+
+class ParallelDecoder_GTest : public ::testing::Test {
+protected:
+    struct Output {
+        Output() :
+            cd_decoder(std::make_shared<I_EventDecoder<EventCD>>()),
+            trigger_decoder(std::make_shared<I_EventDecoder<EventExtTrigger>>()) {
+            cd_decoder->add_event_buffer_callback(
+                [this](const EventCD *begin, const EventCD *end) { cds.insert(cds.end(), begin, end); });
+            trigger_decoder->add_event_buffer_callback(
+                [this](const EventExtTrigger *begin, const EventExtTrigger *end) {
+                    triggers.insert(triggers.end(), begin, end);
+                });
+        }
+
+        std::shared_ptr<I_EventDecoder<EventCD>> cd_decoder;
+        std::shared_ptr<I_EventDecoder<EventExtTrigger>> trigger_decoder;
+        std::vector<EventCD> cds;
+        std::vector<EventExtTrigger> triggers;
+    };
+
+    template<typename Word>
+    void decode_and_compare(const ParallelDecoder::DecoderFactory &factory, std::vector<Word> &words,
+                            bool expect_parallel) {
+        auto begin = reinterpret_cast<I_Decoder::RawData *>(words.data());
+        auto end   = begin + words.size() * sizeof(Word);
+
+        // GIVEN the events decoded sequentially
+        Output reference;
+        auto decoder = factory(true, reference.cd_decoder, reference.trigger_decoder);
+        decoder->decode(begin, end);
+        ASSERT_FALSE(reference.cds.empty());
+
+        // WHEN decoding the same data in small chunks on several threads
+        Output output;
+        ParallelDecoder parallel_decoder(factory, true, output.cd_decoder, output.trigger_decoder, 3, 1001);
+        ASSERT_EQ(expect_parallel, parallel_decoder.is_parallel());
+        parallel_decoder.decode(begin, end);
+
+        // THEN the same events are forwarded, in the same order
+        ASSERT_EQ(reference.cds.size(), output.cds.size());
+        for (size_t i = 0; i < output.cds.size(); ++i) {
+            ASSERT_EQ(reference.cds[i].x, output.cds[i].x);
+            ASSERT_EQ(reference.cds[i].y, output.cds[i].y);
+            ASSERT_EQ(reference.cds[i].p, output.cds[i].p);
+            ASSERT_EQ(reference.cds[i].t, output.cds[i].t);
+        }
+        ASSERT_EQ(reference.triggers.size(), output.triggers.size());
+        for (size_t i = 0; i < output.triggers.size(); ++i) {
+            ASSERT_EQ(reference.triggers[i].p, output.triggers[i].p);
+            ASSERT_EQ(reference.triggers[i].id, output.triggers[i].id);
+            ASSERT_EQ(reference.triggers[i].t, output.triggers[i].t);
+        }
+        ASSERT_EQ(decoder->get_last_timestamp(), parallel_decoder.get_last_timestamp());
+    }
+};
+
+TEST_F(ParallelDecoder_GTest, evt3_same_events_as_sequential_decoding) {
+    auto words = make_evt3_stream();
+    decode_and_compare(make_decoder<EVT3Decoder>, words, true);
+}
+
+TEST_F(ParallelDecoder_GTest, evt2_same_events_as_sequential_decoding) {
+    auto words = make_evt2_stream();
+    decode_and_compare(make_decoder<EVT2Decoder>, words, true);
+}
+
+TEST_F(ParallelDecoder_GTest, sequential_fallback_without_resync_support) {
+    auto words = make_evt3_stream();
+    decode_and_compare(make_decoder<SequentialEVT3Decoder>, words, false);
+}
+
+TEST_F(ParallelDecoder_GTest, successive_calls_continue_the_timeline) {
+    auto words = make_evt3_stream();
+    auto begin = reinterpret_cast<I_Decoder::RawData *>(words.data());
+    auto end   = begin + words.size() * sizeof(uint16_t);
+
+    Output reference;
+    EVT3Decoder decoder(false, reference.cd_decoder);
+    decoder.decode(begin, end);
+
+    // GIVEN a stream split at a resync point
+    Output output;
+    ParallelDecoder parallel_decoder(make_decoder<EVT3Decoder>, false, output.cd_decoder, nullptr, 2, 4096);
+    auto middle = begin + (decoder.find_resync_point(begin + (words.size() / 2) * sizeof(uint16_t), end) - begin);
+    ASSERT_NE(end, middle);
+
+    // WHEN decoding both parts with successive calls
+    parallel_decoder.decode(begin, middle);
+    parallel_decoder.decode(middle, end);
+
+    // THEN the timestamps are the same as when decoding the stream at once
+    ASSERT_EQ(reference.cds.size(), output.cds.size());
+    for (size_t i = 0; i < output.cds.size(); ++i) {
+        ASSERT_EQ(reference.cds[i].t, output.cds[i].t);
+    }
+}
@@ -0,0 +1,148 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "metavision/hal/decoders/evt2_decoder.h"
+#include "metavision/hal/device/device.h"
+#include "metavision/hal/facilities/i_events_stream.h"
+#include "metavision/hal/facilities/i_hal_software_info.h"
+#include "metavision/hal/facilities/i_hw_identification.h"
+#include "metavision/hal/facilities/i_plugin_software_info.h"
+#include "metavision/hal/utils/device_builder.h"
+#include "metavision/hal/utils/hal_exception.h"
+#include "metavision/hal/utils/hal_software_info.h"
+#include "metavision/hal/utils/performance_profile.h"
+#include "metavision/hal/utils/raw_file_config.h"
+
+using namespace Metavision;
+
+namespace {
+struct MockHWIdentification : public I_HW_Identification {
+    MockHWIdentification() :
+        I_HW_Identification(std::make_shared<I_PluginSoftwareInfo>("mock", get_hal_software_info())) {}
+
+    std::string get_serial() const override {
+        return std::string();
+    }
+
+    long get_system_id() const override {
+        return 0;
+    }
+
+    SensorInfo get_sensor_info() const override {
+        return SensorInfo();
+    }
+
+    long get_system_version() const override {
+        return 0;
+    }
+
+    std::vector<std::string> get_available_raw_format() const override {
+        return std::vector<std::string>();
+    }
+
+    std::string get_integrator() const override {
+        return std::string();
+    }
+
+    std::string get_connection_type() const override {
+        return std::string();
+    }
+};
+
+// Data transfer never transferring any data, until it is stopped
+struct IdleDataTransfer : public DataTransfer {
+    IdleDataTransfer() : DataTransfer(1) {}
+
+    void run_impl() override {
+        while (!should_stop()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+};
+
+std::unique_ptr<Device> make_device() {
+    DeviceBuilder builder(std::make_unique<I_HALSoftwareInfo>(get_hal_software_info()),
+                          std::make_unique<I_PluginSoftwareInfo>("mock", get_hal_software_info()));
+    builder.add_facility(std::make_unique<EVT2Decoder>(false, std::make_shared<I_EventDecoder<EventCD>>()));
+    builder.add_facility(std::make_unique<I_EventsStream>(std::make_unique<IdleDataTransfer>(),
+                                                          std::make_shared<MockHWIdentification>()));
+    return builder();
+}
+} // namespace
+
+TEST(PerformanceProfile_GTest, balanced_profile_has_default_settings) {
+    // GIVEN the settings of the balanced profile and a device with the default settings
+    const auto settings = get_performance_settings(PerformanceProfile::Balanced);
+    const RawFileConfig config;
+    auto device = make_device();
+
+    // THEN they match
+    EXPECT_EQ(config.n_events_to_read_, settings.n_events_to_read);
+    EXPECT_EQ(config.n_read_buffers_, settings.n_read_buffers);
+    EXPECT_EQ(device->get_facility<I_Decoder>()->get_cd_event_buffer_size(), settings.cd_event_buffer_size);
+    EXPECT_EQ(0u, settings.handoff_capacity);
+}
+
+TEST(PerformanceProfile_GTest, profiles_trade_latency_for_efficiency) {
+    // GIVEN the settings of the profiles
+    const auto low_latency     = get_performance_settings(PerformanceProfile::LowLatency);
+    const auto balanced        = get_performance_settings(PerformanceProfile::Balanced);
+    const auto high_throughput = get_performance_settings(PerformanceProfile::HighThroughput);
+
+    // THEN the batches grow from the low latency profile to the high throughput one
+    EXPECT_LT(low_latency.n_events_to_read, balanced.n_events_to_read);
+    EXPECT_LT(balanced.n_events_to_read, high_throughput.n_events_to_read);
+    EXPECT_LE(low_latency.cd_event_buffer_size, balanced.cd_event_buffer_size);
+    EXPECT_LT(balanced.cd_event_buffer_size, high_throughput.cd_event_buffer_size);
+    EXPECT_LT(low_latency.replay_batch_duration_us, balanced.replay_batch_duration_us);
+    EXPECT_LT(balanced.replay_batch_duration_us, high_throughput.replay_batch_duration_us);
+    EXPECT_LT(low_latency.buffer_time_slice_us, balanced.buffer_time_slice_us);
+    EXPECT_LT(balanced.buffer_time_slice_us, high_throughput.buffer_time_slice_us);
+
+    // THEN only the low latency profile spins while waiting for the data
+    EXPECT_LT(0u, low_latency.handoff_capacity);
+    EXPECT_LT(0u, low_latency.handoff_spin_count);
+    EXPECT_EQ(0u, high_throughput.handoff_spin_count);
+}
+
+TEST(PerformanceProfile_GTest, applies_profile_to_stopped_device) {
+    // GIVEN a device
+    auto device = make_device();
+
+    // WHEN applying the high throughput profile
+    apply_performance_profile(*device, PerformanceProfile::HighThroughput);
+
+    // THEN the decoder forwards larger batches of events
+    EXPECT_EQ(get_performance_settings(PerformanceProfile::HighThroughput).cd_event_buffer_size,
+              device->get_facility<I_Decoder>()->get_cd_event_buffer_size());
+
+    // WHEN applying a profile while the events stream is running
+    auto *events_stream = device->get_facility<I_EventsStream>();
+    events_stream->start();
+
+    // THEN it fails
+    EXPECT_THROW(apply_performance_profile(*device, PerformanceProfile::LowLatency), HalException);
+    events_stream->stop();
+
+    // WHEN applying the low latency profile once stopped
+    ASSERT_NO_THROW(apply_performance_profile(*device, PerformanceProfile::LowLatency));
+
+    // THEN the decoder forwards small batches of events
+    EXPECT_EQ(get_performance_settings(PerformanceProfile::LowLatency).cd_event_buffer_size,
+              device->get_facility<I_Decoder>()->get_cd_event_buffer_size());
+}
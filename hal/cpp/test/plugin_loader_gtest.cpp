@@ -0,0 +1,194 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "metavision/utils/gtest/gtest_with_tmp_dir.h"
+#include "metavision/hal/plugin/plugin.h"
+#include "metavision/hal/plugin/detail/plugin_loader.h"
+#include "metavision/hal/plugin/plugin_entrypoint.h"
+#include "metavision/hal/plugin/static_plugin.h"
+
+using namespace Metavision;
+
+namespace {
+int static_plugin_initializations = 0;
+
+void initialize_static_test_plugin(void *plugin_ptr) {
+    ++static_plugin_initializations;
+    plugin_cast(plugin_ptr).set_integrator_name("__StaticTest__");
+}
+} // namespace
+
+class PluginLoader_GTest : public GTestWithTmpDir {
+protected:
+    virtual void SetUp() override {
+        manifest_path_ = tmpdir_handler_->get_full_path("plugins_manifest");
+    }
+
+    std::vector<PluginLoader::PluginDescription> load_descriptions() {
+        PluginLoader loader;
+        loader.set_manifest_path(manifest_path_);
+        loader.insert_folder(HAL_DUMMY_TEST_PLUGIN);
+        loader.load_plugins();
+        return loader.get_plugin_descriptions();
+    }
+
+    std::vector<std::string> read_manifest() {
+        std::vector<std::string> lines;
+        std::ifstream ifs(manifest_path_);
+        for (std::string line; std::getline(ifs, line);) {
+            lines.push_back(line);
+        }
+        return lines;
+    }
+
+    void write_manifest(const std::vector<std::string> &lines) {
+        std::ofstream ofs(manifest_path_);
+        for (const auto &line : lines) {
+            ofs << line << "\n";
+        }
+    }
+
+    std::string manifest_path_;
+};
+
+TEST_F(PluginLoader_GTest, plugins_described_in_manifest) {
+    // WHEN loading the plugins without manifest
+    auto descriptions = load_descriptions();
+
+    // THEN the plugin is described, and the manifest is written
+    ASSERT_EQ(1, descriptions.size());
+    EXPECT_EQ("hal_dummy_test_plugin", descriptions[0].name);
+    EXPECT_EQ("__DummyTest__", descriptions[0].integrator_name);
+    EXPECT_EQ(0, descriptions[0].camera_discovery_count);
+    EXPECT_EQ(1, descriptions[0].file_discovery_count);
+    auto lines = read_manifest();
+    ASSERT_EQ(3, lines.size());
+
+    // WHEN the description of the plugin in the manifest is changed, and the plugins are loaded again
+    const std::string integrator = "\t__DummyTest__\t";
+    lines[2].replace(lines[2].find(integrator), integrator.size(), "\t__FromManifest__\t");
+    write_manifest(lines);
+    descriptions = load_descriptions();
+
+    // THEN the plugin is described by the manifest, without loading its library
+    ASSERT_EQ(1, descriptions.size());
+    EXPECT_EQ("__FromManifest__", descriptions[0].integrator_name);
+    EXPECT_EQ(1, descriptions[0].file_discovery_count);
+}
+
+TEST_F(PluginLoader_GTest, outdated_manifest_entries_are_refreshed) {
+    load_descriptions();
+    auto lines = read_manifest();
+    ASSERT_EQ(3, lines.size());
+
+    // WHEN the size of the library in the manifest is not the one of the file anymore
+    const size_t size_pos = lines[2].find('\t') + 1;
+    lines[2].insert(size_pos, "1");
+    const std::string integrator = "\t__DummyTest__\t";
+    lines[2].replace(lines[2].find(integrator), integrator.size(), "\t__FromManifest__\t");
+    write_manifest(lines);
+    auto descriptions = load_descriptions();
+
+    // THEN the library is loaded again to be described
+    ASSERT_EQ(1, descriptions.size());
+    EXPECT_EQ("__DummyTest__", descriptions[0].integrator_name);
+    EXPECT_NE(std::string::npos, read_manifest()[2].find("\t__DummyTest__\t"));
+}
+
+TEST_F(PluginLoader_GTest, filtered_plugins_are_loaded_lazily) {
+    load_descriptions();
+
+    PluginLoader loader;
+    loader.set_manifest_path(manifest_path_);
+    loader.insert_folder(HAL_DUMMY_TEST_PLUGIN);
+    loader.load_plugins();
+
+    // WHEN filtering out the plugins without camera discovery
+    auto camera_plugins = loader.get_plugin_list(
+        [](const PluginLoader::PluginDescription &description) { return description.camera_discovery_count != 0; });
+
+    // THEN the dummy plugin is not listed
+    EXPECT_TRUE(camera_plugins.empty());
+
+    // WHEN listing the plugins with file discoveries
+    auto file_plugins = loader.get_plugin_list(
+        [](const PluginLoader::PluginDescription &description) { return description.file_discovery_count != 0; });
+
+    // THEN the library of the dummy plugin is loaded when it is accessed
+    ASSERT_EQ(1, file_plugins.size());
+    for (auto &plugin : file_plugins) {
+        EXPECT_EQ("hal_dummy_test_plugin", plugin.get_plugin_name());
+        EXPECT_EQ("__DummyTest__", plugin.get_integrator_name());
+    }
+}
+
+TEST_F(PluginLoader_GTest, static_plugins_are_listed_with_loaded_ones) {
+    static_plugin_initializations = 0;
+
+    // WHEN inserting a static plugin, twice, in a loader loading the plugins of a folder
+    PluginLoader loader;
+    loader.set_manifest_path(manifest_path_);
+    loader.insert_static_plugin("static_test_plugin", &initialize_static_test_plugin);
+    loader.insert_static_plugin("static_test_plugin", &initialize_static_test_plugin);
+    loader.insert_folder(HAL_DUMMY_TEST_PLUGIN);
+    loader.load_plugins();
+
+    // THEN the static plugin is initialized once, and described along with the loaded plugin
+    EXPECT_EQ(1, static_plugin_initializations);
+    auto descriptions = loader.get_plugin_descriptions();
+    ASSERT_EQ(2, descriptions.size());
+    EXPECT_EQ("static_test_plugin", descriptions[0].name);
+    EXPECT_EQ("__StaticTest__", descriptions[0].integrator_name);
+    EXPECT_EQ(0, descriptions[0].file_discovery_count);
+    EXPECT_EQ("hal_dummy_test_plugin", descriptions[1].name);
+
+    // WHEN the folders are cleared and the plugins loaded again
+    loader.clear_folders();
+    loader.load_plugins();
+
+    // THEN the static plugin is still listed, and not described by the manifest
+    auto plugins = loader.get_plugin_list();
+    ASSERT_EQ(2, plugins.size());
+    EXPECT_EQ("__StaticTest__", plugins.begin()->get_integrator_name());
+    EXPECT_EQ(1, static_plugin_initializations);
+    for (const auto &line : read_manifest()) {
+        EXPECT_EQ(std::string::npos, line.find("static_test_plugin"));
+    }
+}
+
+TEST_F(PluginLoader_GTest, static_plugins_registration) {
+    // WHEN registering a static plugin twice
+    register_static_plugin("registered_test_plugin", &initialize_static_test_plugin);
+    register_static_plugin("registered_test_plugin", &initialize_static_test_plugin);
+
+    // THEN it is registered once
+    size_t count = 0;
+    for (const auto &plugin : get_static_plugins()) {
+        if (plugin.first == "registered_test_plugin") {
+            EXPECT_EQ(&initialize_static_test_plugin, plugin.second);
+            ++count;
+        }
+    }
+    EXPECT_EQ(1, count);
+
+    // WHEN disabling the loading of the plugins from the folders
+    EXPECT_TRUE(is_dynamic_plugin_loading_enabled());
+    set_dynamic_plugin_loading(false);
+
+    // THEN it is reported as disabled
+    EXPECT_FALSE(is_dynamic_plugin_loading_enabled());
+    set_dynamic_plugin_loading(true);
+}
@@ -0,0 +1,355 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+#ifndef _WIN32
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include "metavision/utils/gtest/gtest_with_tmp_dir.h"
+#include "metavision/hal/utils/file_data_transfer.h"
+#include "metavision/hal/utils/hal_exception.h"
+#include "metavision/hal/utils/http_range_backend.h"
+#include "metavision/hal/utils/ranged_read_backend.h"
+#include "metavision/hal/utils/raw_file_config.h"
+#include "metavision/hal/utils/read_ahead_file_stream.h"
+
+using namespace Metavision;
+
+namespace {
+
+std::vector<uint8_t> make_data(size_t size) {
+    std::vector<uint8_t> data(size);
+    for (size_t i = 0; i < size; ++i) {
+        data[i] = static_cast<uint8_t>(i * 7 + i / 256);
+    }
+    return data;
+}
+
+// Backend reading data in memory slowly, counting the reads done concurrently
+class SlowMemoryBackend : public RangedReadBackend {
+public:
+    SlowMemoryBackend(const std::vector<uint8_t> &data) : data_(data) {}
+
+    const std::string &get_location() const override {
+        return location_;
+    }
+
+    bool is_open() const override {
+        return true;
+    }
+
+    uint64_t get_size() const override {
+        return data_.size();
+    }
+
+    int64_t read_at(uint8_t *data, uint64_t offset, size_t size) override {
+        const int n_reads = ++n_reads_;
+        int max_n_reads   = max_n_reads_;
+        while (n_reads > max_n_reads && !max_n_reads_.compare_exchange_weak(max_n_reads, n_reads)) {}
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        --n_reads_;
+
+        if (offset >= data_.size()) {
+            return 0;
+        }
+        size = std::min<size_t>(size, data_.size() - offset);
+        std::memcpy(data, data_.data() + offset, size);
+        return size;
+    }
+
+    int get_max_concurrent_reads() const {
+        return max_n_reads_;
+    }
+
+private:
+    const std::vector<uint8_t> data_;
+    const std::string location_ = "memory";
+    std::atomic<int> n_reads_{0};
+    std::atomic<int> max_n_reads_{0};
+};
+
+// Runs the data transfer until the end of the stream and returns all the data transferred
+std::vector<uint8_t> transfer_all(FileDataTransfer &transfer) {
+    std::mutex mutex;
+    std::condition_variable cond;
+    bool stopped = false;
+    std::vector<uint8_t> transferred;
+
+    transfer.add_new_slice_callback([&transferred](const DataTransfer::BufferSlice &slice) {
+        transferred.insert(transferred.end(), slice.data(), slice.data() + slice.size());
+    });
+    transfer.add_status_changed_callback([&](DataTransfer::Status status) {
+        if (status == DataTransfer::Status::Stopped) {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopped = true;
+            cond.notify_all();
+        }
+    });
+    transfer.start();
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        cond.wait(lock, [&stopped] { return stopped; });
+    }
+    transfer.stop();
+    return transferred;
+}
+
+#ifndef _WIN32
+// Minimal HTTP server serving a file, with or without support of range requests. Ranges can be sent chunked, except
+// the one probing the size of the file
+class HttpServer {
+public:
+    HttpServer(const std::string &path, const std::vector<uint8_t> &data, bool support_ranges = true,
+               bool chunked_ranges = false) :
+        path_(path), data_(data), support_ranges_(support_ranges), chunked_ranges_(chunked_ranges) {
+        socket_              = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in addr     = {};
+        addr.sin_family      = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        bind(socket_, reinterpret_cast<sockaddr *>(&addr), sizeof(addr));
+        socklen_t addr_size = sizeof(addr);
+        getsockname(socket_, reinterpret_cast<sockaddr *>(&addr), &addr_size);
+        port_ = ntohs(addr.sin_port);
+        listen(socket_, 16);
+        thread_ = std::thread([this]() {
+            int client;
+            while ((client = accept(socket_, nullptr, nullptr)) >= 0) {
+                clients_.emplace_back([this, client]() { serve(client); });
+            }
+        });
+    }
+
+    ~HttpServer() {
+        shutdown(socket_, SHUT_RDWR);
+        close(socket_);
+        thread_.join();
+        for (auto &client : clients_) {
+            client.join();
+        }
+    }
+
+    std::string get_url() const {
+        return "http://127.0.0.1:" + std::to_string(port_) + path_;
+    }
+
+    int get_n_requests() const {
+        return n_requests_;
+    }
+
+private:
+    void serve(int client) {
+        std::string request;
+        char chunk[1024];
+        ssize_t n;
+        while ((n = recv(client, chunk, sizeof(chunk), 0)) > 0) {
+            request.append(chunk, n);
+            size_t end;
+            while ((end = request.find("\r\n\r\n")) != std::string::npos) {
+                respond(client, request.substr(0, end));
+                request.erase(0, end + 4);
+            }
+        }
+        close(client);
+    }
+
+    void respond(int client, const std::string &request) {
+        const size_t path_begin = request.find(' ') + 1;
+        const std::string path  = request.substr(path_begin, request.find(' ', path_begin) - path_begin);
+        const bool first_request = ++n_requests_ == 1;
+        std::string header;
+        uint64_t first = 0, last = data_.size() - 1;
+        if (path != path_) {
+            header = "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\n\r\n";
+            first  = 1;
+            last   = 0;
+        } else if (support_ranges_ && request.find("Range: bytes=") != std::string::npos) {
+            unsigned long long range_first = 0, range_last = 0;
+            std::sscanf(request.c_str() + request.find("Range: bytes="), "Range: bytes=%llu-%llu", &range_first,
+                        &range_last);
+            first  = range_first;
+            last   = range_last;
+            last   = std::min<uint64_t>(last, data_.size() - 1);
+            if (chunked_ranges_ && !first_request) {
+                std::string chunk_size(16, '\0');
+                chunk_size.resize(std::snprintf(&chunk_size[0], chunk_size.size(), "%llx",
+                                                static_cast<unsigned long long>(last + 1 - first)));
+                header = "HTTP/1.1 206 Partial Content\r\nTransfer-Encoding: chunked\r\nContent-Range: bytes " +
+                         std::to_string(first) + "-" + std::to_string(last) + "/" + std::to_string(data_.size()) +
+                         "\r\n\r\n" + chunk_size + "\r\n";
+                header.append(reinterpret_cast<const char *>(data_.data()) + first, last + 1 - first);
+                header += "\r\n0\r\n\r\n";
+                send(client, header.data(), header.size(), MSG_NOSIGNAL);
+                return;
+            }
+            header = "HTTP/1.1 206 Partial Content\r\nContent-Length: " + std::to_string(last + 1 - first) +
+                     "\r\nContent-Range: bytes " + std::to_string(first) + "-" + std::to_string(last) + "/" +
+                     std::to_string(data_.size()) + "\r\n\r\n";
+        } else {
+            header = "HTTP/1.1 200 OK\r\nContent-Length: " + std::to_string(data_.size()) + "\r\n\r\n";
+        }
+        // The response is sent at once, so that it is not delayed by the acknowledgement of a first part
+        if (first <= last) {
+            header.append(reinterpret_cast<const char *>(data_.data()) + first, last + 1 - first);
+        }
+        send(client, header.data(), header.size(), MSG_NOSIGNAL);
+    }
+
+    const std::string path_;
+    const std::vector<uint8_t> data_;
+    const bool support_ranges_;
+    const bool chunked_ranges_;
+    int socket_;
+    uint16_t port_;
+    std::atomic<int> n_requests_{0};
+    std::thread thread_;
+    std::vector<std::thread> clients_;
+};
+#endif
+
+} // namespace
+
+class RangedReadBackend_GTest : public GTestWithTmpDir {};
+
+TEST_F(RangedReadBackend_GTest, local_file_backend_reads_ranges) {
+    const std::string filename = tmpdir_handler_->get_full_path("data.raw");
+    const auto data            = make_data(10000);
+    std::ofstream(filename, std::ios::binary).write(reinterpret_cast<const char *>(data.data()), data.size());
+
+    auto backend = RangedReadBackend::open(filename);
+    ASSERT_TRUE(backend->is_open());
+    ASSERT_EQ(data.size(), backend->get_size());
+
+    std::vector<uint8_t> read(100);
+    ASSERT_EQ(100, backend->read_at(read.data(), 5000, read.size()));
+    ASSERT_TRUE(std::equal(read.begin(), read.end(), data.begin() + 5000));
+    ASSERT_EQ(50, backend->read_at(read.data(), 9950, read.size()));
+    ASSERT_EQ(0, backend->read_at(read.data(), 10000, read.size()));
+
+    ASSERT_FALSE(RangedReadBackend::open(tmpdir_handler_->get_full_path("unknown.raw"))->is_open());
+    ASSERT_FALSE(ReadAheadFileStream(tmpdir_handler_->get_full_path("unknown.raw"), 2).good());
+}
+
+TEST_F(RangedReadBackend_GTest, stream_reads_and_seeks_through_backend) {
+    const auto data = make_data(200000);
+    ReadAheadFileStream stream(std::make_unique<SlowMemoryBackend>(data), 4);
+    ASSERT_EQ(data.size(), stream.get_file_size());
+
+    std::vector<uint8_t> read(100);
+    stream.seekg(50);
+    stream.read(reinterpret_cast<char *>(read.data()), read.size());
+    ASSERT_EQ(read.size(), stream.gcount());
+    ASSERT_TRUE(std::equal(read.begin(), read.end(), data.begin() + 50));
+    ASSERT_EQ(150, stream.tellg());
+
+    // Large reads are done directly in the destination
+    read.resize(100000);
+    stream.read(reinterpret_cast<char *>(read.data()), read.size());
+    ASSERT_EQ(read.size(), stream.gcount());
+    ASSERT_TRUE(std::equal(read.begin(), read.end(), data.begin() + 150));
+
+    stream.seekg(-10, std::ios::end);
+    ASSERT_EQ(data.size() - 10, stream.tellg());
+    stream.read(reinterpret_cast<char *>(read.data()), 100);
+    ASSERT_EQ(10, stream.gcount());
+    ASSERT_TRUE(stream.eof());
+}
+
+TEST_F(RangedReadBackend_GTest, transfer_fetches_ranges_in_parallel) {
+    const auto data = make_data(100000);
+    auto backend    = std::make_unique<SlowMemoryBackend>(data);
+    auto &slow      = *backend;
+    auto stream     = std::make_unique<ReadAheadFileStream>(std::move(backend), 4);
+    stream->seekg(3);
+
+    RawFileConfig config;
+    config.n_events_to_read_ = 1000;
+    config.n_read_buffers_   = 5;
+    FileDataTransfer transfer(std::move(stream), 1, config);
+    ASSERT_EQ(std::vector<uint8_t>(data.begin() + 3, data.end()), transfer_all(transfer));
+    ASSERT_GT(slow.get_max_concurrent_reads(), 1);
+    ASSERT_LE(slow.get_max_concurrent_reads(), 4);
+}
+
+#ifndef _WIN32
+TEST_F(RangedReadBackend_GTest, http_backend_reads_ranges_over_persistent_connections) {
+    const auto data = make_data(300000);
+    HttpServer server("/bucket/data.raw", data);
+
+    HttpRangeBackend backend(server.get_url());
+    ASSERT_EQ(data.size(), backend.get_size());
+
+    std::vector<uint8_t> read(100000);
+    ASSERT_EQ(100000, backend.read_at(read.data(), 1234, read.size()));
+    ASSERT_TRUE(std::equal(read.begin(), read.end(), data.begin() + 1234));
+    ASSERT_EQ(1000, backend.read_at(read.data(), data.size() - 1000, read.size()));
+    ASSERT_TRUE(std::equal(read.begin(), read.begin() + 1000, data.end() - 1000));
+    ASSERT_EQ(0, backend.read_at(read.data(), data.size(), read.size()));
+    ASSERT_EQ(3, server.get_n_requests());
+}
+
+TEST_F(RangedReadBackend_GTest, http_and_s3_files_are_transferred_entirely) {
+    const auto data = make_data(1000000);
+    HttpServer server("/bucket/data.raw", data);
+
+    RawFileConfig config;
+    config.n_events_to_read_ = 4096;
+    config.n_read_buffers_   = 9;
+    FileDataTransfer http_transfer(std::make_unique<ReadAheadFileStream>(RangedReadBackend::open(server.get_url()), 8),
+                                   1, config);
+    ASSERT_EQ(data, transfer_all(http_transfer));
+
+    const std::string endpoint = server.get_url().substr(0, server.get_url().find("/bucket"));
+    setenv("AWS_ENDPOINT_URL", endpoint.c_str(), 1);
+    FileDataTransfer s3_transfer(
+        std::make_unique<ReadAheadFileStream>(RangedReadBackend::open("s3://bucket/data.raw"), 8), 1, config);
+    unsetenv("AWS_ENDPOINT_URL");
+    ASSERT_EQ(data, transfer_all(s3_transfer));
+}
+
+TEST_F(RangedReadBackend_GTest, http_backend_throws_on_missing_file_or_unsupported_ranges) {
+    const auto data = make_data(1000);
+    HttpServer server("/data.raw", data);
+    ASSERT_THROW(HttpRangeBackend(server.get_url() + ".idx"), HalException);
+
+    HttpServer server_without_ranges("/data.raw", data, false);
+    ASSERT_THROW(HttpRangeBackend(server_without_ranges.get_url()), HalException);
+    ASSERT_THROW(HttpRangeBackend("https://localhost/data.raw"), HalException);
+}
+
+TEST_F(RangedReadBackend_GTest, http_backend_fails_to_read_chunked_ranges) {
+    // GIVEN a server sending the ranges with a chunked transfer encoding, whose size is not known beforehand
+    const auto data = make_data(1000);
+    HttpServer server("/data.raw", data, true, true);
+    HttpRangeBackend backend(server.get_url());
+    ASSERT_EQ(data.size(), backend.get_size());
+
+    // WHEN reading a range
+    std::vector<uint8_t> read(100);
+
+    // THEN the read fails instead of being mistaken for the end of the file
+    ASSERT_EQ(-1, backend.read_at(read.data(), 10, read.size()));
+}
+#endif
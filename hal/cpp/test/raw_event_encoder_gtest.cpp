@@ -0,0 +1,129 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <functional>
+#include <memory>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "metavision/hal/decoders/evt2_decoder.h"
+#include "metavision/hal/decoders/evt3_decoder.h"
+#include "metavision/hal/utils/hal_exception.h"
+#include "metavision/hal/utils/raw_event_encoder.h"
+#include "metavision/hal/utils/raw_file_header.h"
+
+using namespace Metavision;
+
+namespace {
+
+using DecoderFactory = std::function<std::unique_ptr<I_Decoder>(
+    bool, const std::shared_ptr<I_EventDecoder<EventCD>> &, const std::shared_ptr<I_EventDecoder<EventExtTrigger>> &)>;
+
+template<typename Decoder>
+std::unique_ptr<I_Decoder> make_decoder(bool time_shifting_enabled,
+                                        const std::shared_ptr<I_EventDecoder<EventCD>> &event_cd_decoder,
+                                        const std::shared_ptr<I_EventDecoder<EventExtTrigger>> &event_trigger_decoder) {
+    return std::unique_ptr<I_Decoder>(new Decoder(time_shifting_enabled, event_cd_decoder, event_trigger_decoder));
+}
+
+// Events of about 60s, with bursts of events on the same rows and a gap longer than the loop of the EVT3 time high
+void make_events(std::vector<EventCD> &cds, std::vector<EventExtTrigger> &triggers) {
+    timestamp t = 100;
+    for (int i = 0; i < 20000; ++i) {
+        if (i % 1000 == 999) {
+            t += 500000;
+        } else if (i == 10000) {
+            t += 40000000;
+        } else {
+            t += (i * 7) % 300;
+        }
+        const unsigned short y = (i * 13) % 480;
+        for (int j = 0; j < 1 + i % 5; ++j) {
+            cds.emplace_back(static_cast<unsigned short>((i + j * (1 + i % 17)) % 640), y, (i / 3) % 2, t);
+        }
+        if (i % 31 == 0) {
+            triggers.emplace_back(i % 2, t, i % 3);
+        }
+    }
+}
+
+} // namespace
+
+class RawEventEncoder_GTest : public ::testing::Test {
+protected:
+    void encode_and_decode(const std::string &format, const DecoderFactory &factory) {
+        // GIVEN events encoded in a format
+        std::vector<EventCD> cds;
+        std::vector<EventExtTrigger> triggers;
+        make_events(cds, triggers);
+        auto encoder = RawEventEncoder::create(format);
+        ASSERT_EQ(format, encoder->get_format());
+        std::vector<uint8_t> data;
+        const size_t half_cds = cds.size() / 2, half_triggers = triggers.size() / 2;
+        encoder->encode(cds.data(), cds.data() + half_cds, triggers.data(), triggers.data() + half_triggers, data);
+        encoder->encode(cds.data() + half_cds, cds.data() + cds.size(), triggers.data() + half_triggers,
+                        triggers.data() + triggers.size(), data);
+        ASSERT_EQ(0u, data.size() % encoder->get_raw_event_size_bytes());
+
+        // WHEN decoding them
+        std::vector<EventCD> decoded_cds;
+        std::vector<EventExtTrigger> decoded_triggers;
+        auto cd_decoder      = std::make_shared<I_EventDecoder<EventCD>>();
+        auto trigger_decoder = std::make_shared<I_EventDecoder<EventExtTrigger>>();
+        cd_decoder->add_event_buffer_callback([&](const EventCD *begin, const EventCD *end) {
+            decoded_cds.insert(decoded_cds.end(), begin, end);
+        });
+        trigger_decoder->add_event_buffer_callback([&](const EventExtTrigger *begin, const EventExtTrigger *end) {
+            decoded_triggers.insert(decoded_triggers.end(), begin, end);
+        });
+        auto decoder = factory(false, cd_decoder, trigger_decoder);
+        decoder->decode(data.data(), data.data() + data.size());
+
+        // THEN the same events are decoded
+        ASSERT_EQ(cds.size(), decoded_cds.size());
+        for (size_t i = 0; i < cds.size(); ++i) {
+            ASSERT_EQ(cds[i].x, decoded_cds[i].x);
+            ASSERT_EQ(cds[i].y, decoded_cds[i].y);
+            ASSERT_EQ(cds[i].p, decoded_cds[i].p);
+            ASSERT_EQ(cds[i].t, decoded_cds[i].t);
+        }
+        ASSERT_EQ(triggers.size(), decoded_triggers.size());
+        for (size_t i = 0; i < triggers.size(); ++i) {
+            ASSERT_EQ(triggers[i].p, decoded_triggers[i].p);
+            ASSERT_EQ(triggers[i].id, decoded_triggers[i].id);
+            ASSERT_EQ(triggers[i].t, decoded_triggers[i].t);
+        }
+    }
+};
+
+TEST_F(RawEventEncoder_GTest, evt2_round_trip) {
+    encode_and_decode("EVT2", make_decoder<EVT2Decoder>);
+}
+
+TEST_F(RawEventEncoder_GTest, evt3_round_trip) {
+    encode_and_decode("EVT3", make_decoder<EVT3Decoder>);
+}
+
+TEST_F(RawEventEncoder_GTest, set_header_format) {
+    // GIVEN a header with the format of a sensor
+    RawFileHeader header;
+    header.set_field("format", "EVT2;height=720;width=1280");
+
+    // WHEN setting the format of an EVT3 encoder
+    RawEventEncoder::create("EVT3")->set_header_format(header);
+
+    // THEN the format is changed and its properties are kept
+    ASSERT_EQ("EVT3;height=720;width=1280", header.get_field("format"));
+}
+
+TEST_F(RawEventEncoder_GTest, unsupported_format_throws) {
+    ASSERT_THROW(RawEventEncoder::create("EVT21"), HalException);
+}
@@ -0,0 +1,124 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <cstring>
+#include <fstream>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "metavision/utils/gtest/gtest_with_tmp_dir.h"
+#include "metavision/hal/utils/async_raw_file_writer.h"
+#include "metavision/hal/utils/hal_exception.h"
+#include "metavision/hal/utils/raw_file_checksums.h"
+
+using namespace Metavision;
+
+class RawFileChecksums_GTest : public GTestWithTmpDir {
+protected:
+    virtual void SetUp() override {
+        filename_ = tmpdir_handler_->get_full_path("record.raw");
+        data_.resize(100003);
+        std::iota(data_.begin(), data_.end(), 0);
+        write_file(data_);
+    }
+
+    void write_file(const std::vector<uint8_t> &data) {
+        std::ofstream ofs(filename_, std::ios::binary);
+        ofs.write(reinterpret_cast<const char *>(data.data()), data.size());
+    }
+
+    std::string filename_;
+    std::vector<uint8_t> data_;
+};
+
+TEST_F(RawFileChecksums_GTest, crc32c_of_reference_values) {
+    const char *digits = "123456789";
+    ASSERT_EQ(0xE3069283, crc32c(digits, std::strlen(digits)));
+    ASSERT_EQ(0, crc32c(digits, 0));
+
+    // The checksum can be computed in several parts, of any alignment and size
+    const std::vector<uint8_t> zeros(32, 0);
+    ASSERT_EQ(0x8A9136AA, crc32c(zeros.data(), zeros.size()));
+    ASSERT_EQ(0x8A9136AA, crc32c(zeros.data() + 3, 29, crc32c(zeros.data(), 3)));
+}
+
+TEST_F(RawFileChecksums_GTest, chunks_checksums) {
+    RawFileChecksums checksums(1000);
+    checksums.add_data(data_.data(), 1500);
+    checksums.add_data(data_.data() + 1500, 1000);
+
+    ASSERT_EQ(2500, checksums.get_raw_file_size());
+    const auto values = checksums.get_checksums();
+    ASSERT_EQ(3, values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        ASSERT_EQ(crc32c(data_.data() + i * 1000, std::min<size_t>(1000, 2500 - i * 1000)), values[i]);
+    }
+}
+
+TEST_F(RawFileChecksums_GTest, save_and_load) {
+    const auto checksums = RawFileChecksums::compute(filename_, 4096);
+    const std::string path = RawFileChecksums::get_sidecar_path(filename_);
+    ASSERT_TRUE(checksums.save(path));
+
+    RawFileChecksums loaded;
+    ASSERT_TRUE(loaded.load(path));
+    ASSERT_EQ(4096, loaded.get_chunk_size());
+    ASSERT_EQ(data_.size(), loaded.get_raw_file_size());
+    ASSERT_EQ(checksums.get_checksums(), loaded.get_checksums());
+
+    ASSERT_FALSE(loaded.load(filename_));
+}
+
+TEST_F(RawFileChecksums_GTest, verify_detects_corrupted_chunks) {
+    const auto checksums = RawFileChecksums::compute(filename_, 4096);
+    ASSERT_TRUE(checksums.verify(filename_, 4).empty());
+
+    // Bits flipped in two chunks
+    auto corrupted = data_;
+    corrupted[5000] ^= 0x10;
+    corrupted[9 * 4096 + 7] ^= 0x01;
+    write_file(corrupted);
+    ASSERT_EQ(std::vector<size_t>({1, 9}), checksums.verify(filename_, 4));
+
+    // Truncated file: the last chunks are missing
+    write_file(std::vector<uint8_t>(data_.begin(), data_.begin() + 23 * 4096 + 10));
+    ASSERT_EQ(std::vector<size_t>({23, 24}), checksums.verify(filename_));
+
+    // Data appended to the file
+    auto longer = data_;
+    longer.push_back(0);
+    write_file(longer);
+    ASSERT_EQ(std::vector<size_t>({24}), checksums.verify(filename_));
+
+    ASSERT_THROW(checksums.verify(tmpdir_handler_->get_full_path("unknown.raw")), HalException);
+}
+
+TEST_F(RawFileChecksums_GTest, computed_by_async_writer) {
+    const std::string header = "% header\n% end\n";
+    {
+        AsyncRawFileWriterConfig config;
+        config.batch_size_          = 1; // rounded up to one block, so that several batches are needed
+        config.checksum_chunk_size_ = 3000;
+        AsyncRawFileWriter writer(filename_, header, config);
+        auto owner = std::make_shared<std::vector<uint8_t>>(data_);
+        for (size_t offset = 0; offset < owner->size(); offset += 7000) {
+            const size_t end = std::min(owner->size(), offset + 7000);
+            writer.write(DataTransfer::BufferSlice(owner->data() + offset, owner->data() + end, owner));
+        }
+    }
+
+    RawFileChecksums checksums;
+    ASSERT_TRUE(checksums.load(RawFileChecksums::get_sidecar_path(filename_)));
+    ASSERT_EQ(header.size() + data_.size(), checksums.get_raw_file_size());
+    ASSERT_EQ(RawFileChecksums::compute(filename_, 3000).get_checksums(), checksums.get_checksums());
+    ASSERT_TRUE(checksums.verify(filename_).empty());
+}
@@ -0,0 +1,227 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "metavision/utils/gtest/gtest_with_tmp_dir.h"
+#include "metavision/hal/decoders/evt2_decoder.h"
+#include "metavision/hal/decoders/detail/evt2_raw_format.h"
+#include "metavision/hal/facilities/i_events_stream.h"
+#include "metavision/hal/facilities/i_hw_identification.h"
+#include "metavision/hal/facilities/i_plugin_software_info.h"
+#include "metavision/hal/utils/file_data_transfer.h"
+#include "metavision/hal/utils/hal_software_info.h"
+#include "metavision/hal/utils/raw_file_config.h"
+#include "metavision/hal/utils/raw_file_index.h"
+
+using namespace Metavision;
+
+namespace {
+struct MockHWIdentification : public I_HW_Identification {
+    MockHWIdentification() :
+        I_HW_Identification(std::make_shared<I_PluginSoftwareInfo>("mock", get_hal_software_info())) {}
+
+    std::string get_serial() const override {
+        return std::string();
+    }
+
+    long get_system_id() const override {
+        return 0;
+    }
+
+    SensorInfo get_sensor_info() const override {
+        return SensorInfo();
+    }
+
+    long get_system_version() const override {
+        return 0;
+    }
+
+    std::vector<std::string> get_available_raw_format() const override {
+        return std::vector<std::string>();
+    }
+
+    std::string get_integrator() const override {
+        return std::string();
+    }
+
+    std::string get_connection_type() const override {
+        return std::string();
+    }
+};
+
+// Two seconds of EVT2 data, with one CD event every 16us, starting at 1s
+std::vector<uint32_t> make_evt2_stream() {
+    std::vector<uint32_t> words;
+    timestamp time_high = -1;
+    for (timestamp t = 1000000, i = 0; t < 3000000; t += 16, ++i) {
+        if ((t >> Evt2::TimestampLsbBits) != time_high) {
+            time_high = t >> Evt2::TimestampLsbBits;
+            words.push_back((static_cast<uint32_t>(Evt2::EventTypes::EVT_TIME_HIGH) << Evt2::TypeShift) |
+                            static_cast<uint32_t>(time_high & Evt2::TsMsbMask));
+        }
+        words.push_back((static_cast<uint32_t>(i % 2) << Evt2::TypeShift) |
+                        static_cast<uint32_t>((t & ((1 << Evt2::TimestampLsbBits) - 1)) << Evt2::TimestampShift) |
+                        static_cast<uint32_t>((i % 640) << Evt2::XShift) | static_cast<uint32_t>(i % 480));
+    }
+    return words;
+}
+
+struct DecodedEvents {
+    DecodedEvents() : cd_decoder(std::make_shared<I_EventDecoder<EventCD>>()) {
+        cd_decoder->add_event_buffer_callback(
+            [this](const EventCD *begin, const EventCD *end) { cds.insert(cds.end(), begin, end); });
+    }
+
+    std::shared_ptr<I_EventDecoder<EventCD>> cd_decoder;
+    std::vector<EventCD> cds;
+};
+} // namespace
+
+class RawFileIndex_GTest : public GTestWithTmpDir {
+protected:
+    virtual void SetUp() override {
+        filename_ = tmpdir_handler_->get_full_path("data.raw");
+        words_    = make_evt2_stream();
+        std::ofstream ofs(filename_, std::ios::binary);
+        ofs.write(reinterpret_cast<const char *>(words_.data()), words_.size() * sizeof(uint32_t));
+    }
+
+    RawFileIndex build_index() {
+        std::ifstream ifs(filename_, std::ios::binary);
+        EVT2Decoder decoder(false);
+        return RawFileIndex::build(ifs, decoder);
+    }
+
+    std::unique_ptr<I_EventsStream> make_events_stream() {
+        RawFileConfig config;
+        config.n_events_to_read_ = 1000;
+        std::unique_ptr<std::istream> stream(new std::ifstream(filename_, std::ios::binary));
+        return std::make_unique<I_EventsStream>(std::make_unique<FileDataTransfer>(std::move(stream), 4, config),
+                                                std::make_shared<MockHWIdentification>());
+    }
+
+    void decode_all(I_EventsStream &es, I_Decoder &decoder) {
+        while (es.wait_next_buffer() > 0) {
+            long n_rawbytes                 = 0;
+            I_EventsStream::RawData *buffer = es.get_latest_raw_data(n_rawbytes);
+            decoder.decode(buffer, buffer + n_rawbytes);
+        }
+    }
+
+    std::string filename_;
+    std::vector<uint32_t> words_;
+};
+
+TEST_F(RawFileIndex_GTest, build) {
+    // WHEN indexing the file
+    const auto index = build_index();
+
+    // THEN the entries are spaced by at least the period, and point to resync points
+    ASSERT_FALSE(index.empty());
+    ASSERT_EQ(words_.size() * sizeof(uint32_t), index.get_raw_file_size());
+    ASSERT_EQ(1000000, index.get_first_timestamp());
+    const auto &entries = index.get_entries();
+    ASSERT_EQ(0, entries.front().offset_);
+    ASSERT_GE(entries.size(), 2000000 / RawFileIndex::DefaultPeriod - 1);
+    for (size_t i = 1; i < entries.size(); ++i) {
+        ASSERT_GE(entries[i].timestamp_, entries[i - 1].timestamp_ + RawFileIndex::DefaultPeriod);
+        ASSERT_LT(entries[i].timestamp_, entries[i - 1].timestamp_ + RawFileIndex::DefaultPeriod + 64);
+        ASSERT_EQ(0, entries[i].offset_ % sizeof(uint32_t));
+        ASSERT_EQ(Evt2::EventTypes::EVT_TIME_HIGH, Evt2::get_type(words_[entries[i].offset_ / sizeof(uint32_t)]));
+    }
+}
+
+TEST_F(RawFileIndex_GTest, find) {
+    const auto index    = build_index();
+    const auto &entries = index.get_entries();
+
+    // THEN the entry found is the last one preceding the timestamp, or the first one
+    ASSERT_EQ(entries.front().offset_, index.find(0).offset_);
+    ASSERT_EQ(entries.front().offset_, index.find(entries.front().timestamp_).offset_);
+    ASSERT_EQ(entries[1].offset_, index.find(entries[1].timestamp_ + 1).offset_);
+    ASSERT_EQ(entries[1].offset_, index.find(entries[2].timestamp_).offset_);
+    ASSERT_EQ(entries.back().offset_, index.find(10000000).offset_);
+}
+
+TEST_F(RawFileIndex_GTest, save_and_load) {
+    const auto index       = build_index();
+    const std::string path = RawFileIndex::get_sidecar_path(filename_);
+    ASSERT_TRUE(index.save(path));
+
+    // WHEN loading the index saved
+    RawFileIndex loaded;
+    ASSERT_TRUE(loaded.load(path));
+
+    // THEN it is the same
+    ASSERT_EQ(index.get_raw_file_size(), loaded.get_raw_file_size());
+    ASSERT_EQ(index.get_period(), loaded.get_period());
+    ASSERT_EQ(index.get_entries().size(), loaded.get_entries().size());
+    for (size_t i = 0; i < index.get_entries().size(); ++i) {
+        ASSERT_EQ(index.get_entries()[i].timestamp_, loaded.get_entries()[i].timestamp_);
+        ASSERT_EQ(index.get_entries()[i].offset_, loaded.get_entries()[i].offset_);
+    }
+
+    // WHEN loading a file that is not an index
+    // THEN it fails and the index is left unchanged
+    ASSERT_FALSE(loaded.load(filename_));
+    ASSERT_FALSE(loaded.load(tmpdir_handler_->get_full_path("missing.idx")));
+    ASSERT_EQ(index.get_entries().size(), loaded.get_entries().size());
+}
+
+TEST_F(RawFileIndex_GTest, seek) {
+    // GIVEN the events of the whole file, decoded with time shifting
+    DecodedEvents reference;
+    {
+        EVT2Decoder decoder(true, reference.cd_decoder);
+        auto es = make_events_stream();
+        es->start();
+        decode_all(*es, decoder);
+        es->stop();
+    }
+
+    // WHEN seeking without index
+    // THEN it fails
+    EVT2Decoder decoder(true);
+    auto es = make_events_stream();
+    ASSERT_FALSE(es->seek(500000, decoder));
+
+    for (const timestamp t : {timestamp(0), timestamp(1234567), timestamp(1999990)}) {
+        // WHEN seeking in the indexed file and decoding from there, with a new decoder
+        DecodedEvents seeked;
+        EVT2Decoder decoder(true, seeked.cd_decoder);
+        auto es = make_events_stream();
+        es->set_raw_file_index(std::make_shared<RawFileIndex>(build_index()));
+        es->start();
+        ASSERT_TRUE(es->seek(t, decoder));
+        ASSERT_LE(decoder.get_last_timestamp(), t);
+        decode_all(*es, decoder);
+        es->stop();
+
+        // THEN the events decoded are the end of the file, from less than one period before the timestamp
+        ASSERT_FALSE(seeked.cds.empty());
+        ASSERT_LE(seeked.cds.size(), reference.cds.size());
+        ASSERT_LE(seeked.cds.front().t, t);
+        ASSERT_GT(seeked.cds.front().t + RawFileIndex::DefaultPeriod + 64, t);
+        const size_t skipped = reference.cds.size() - seeked.cds.size();
+        for (size_t i = 0; i < seeked.cds.size(); ++i) {
+            ASSERT_EQ(reference.cds[skipped + i].t, seeked.cds[i].t);
+            ASSERT_EQ(reference.cds[skipped + i].x, seeked.cds[i].x);
+            ASSERT_EQ(reference.cds[skipped + i].y, seeked.cds[i].y);
+            ASSERT_EQ(reference.cds[skipped + i].p, seeked.cds[i].p);
+        }
+    }
+}
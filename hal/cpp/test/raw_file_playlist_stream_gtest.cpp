@@ -0,0 +1,106 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "metavision/utils/gtest/gtest_with_tmp_dir.h"
+#include "metavision/hal/utils/hal_exception.h"
+#include "metavision/hal/utils/raw_file_header.h"
+#include "metavision/hal/utils/raw_file_playlist_stream.h"
+
+using namespace Metavision;
+
+class RawFilePlaylistStream_GTest : public GTestWithTmpDir {
+protected:
+    // Writes a RAW file with a header and @p size bytes of data, numbered from @p first_byte
+    std::string write_raw_file(const std::string &name, size_t size, uint8_t first_byte,
+                               const std::string &plugin_name = "dummy") {
+        RawFileHeader header;
+        header.set_plugin_name(plugin_name);
+        header.set_integrator_name("Prophesee");
+        header.add_date();
+
+        std::vector<uint8_t> data(size);
+        for (size_t i = 0; i < size; ++i) {
+            data[i] = static_cast<uint8_t>(first_byte + i);
+        }
+        const std::string path = tmpdir_handler_->get_full_path(name);
+        std::ofstream ofs(path, std::ios::binary);
+        ofs << header;
+        ofs.write(reinterpret_cast<const char *>(data.data()), data.size());
+        return path;
+    }
+
+    static std::vector<char> read_file(const std::string &path) {
+        std::ifstream ifs(path, std::ios::binary);
+        return std::vector<char>(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+    }
+
+    static std::vector<char> read_data(const std::string &path) {
+        std::ifstream ifs(path, std::ios::binary);
+        RawFileHeader header(ifs);
+        return std::vector<char>(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+    }
+};
+
+TEST_F(RawFilePlaylistStream_GTest, chains_the_data_of_the_files_after_the_first_header) {
+    const std::vector<std::string> files = {write_raw_file("part_0.raw", 3000, 0), write_raw_file("part_1.raw", 0, 0),
+                                            write_raw_file("part_2.raw", 5000, 184),
+                                            write_raw_file("part_3.raw", 10, 96)};
+
+    std::vector<char> expected = read_file(files[0]);
+    for (size_t i = 1; i < files.size(); ++i) {
+        const auto data = read_data(files[i]);
+        expected.insert(expected.end(), data.begin(), data.end());
+    }
+
+    // A small prefetch makes the transitions happen both within and after the prefetched data
+    RawFilePlaylistStream stream(files, 100);
+    ASSERT_EQ(expected.size(), stream.size());
+
+    RawFileHeader header(stream);
+    ASSERT_EQ("dummy", header.get_plugin_name());
+    stream.seekg(0);
+    std::vector<char> read(expected.size() + 10);
+    stream.read(read.data(), read.size());
+    ASSERT_EQ(expected.size(), stream.gcount());
+    read.resize(expected.size());
+    ASSERT_EQ(expected, read);
+}
+
+TEST_F(RawFilePlaylistStream_GTest, seeks_across_files) {
+    const std::vector<std::string> files = {write_raw_file("part_0.raw", 1000, 0),
+                                            write_raw_file("part_1.raw", 1000, 0)};
+    const auto first_file_size           = read_file(files[0]).size();
+    const auto second_data               = read_data(files[1]);
+
+    RawFilePlaylistStream stream(files);
+    stream.seekg(first_file_size + 500);
+    ASSERT_EQ(static_cast<uint8_t>(second_data[500]), stream.get());
+    stream.seekg(-1000, std::ios::cur);
+    ASSERT_EQ(first_file_size - 499, stream.tellg());
+    ASSERT_EQ(static_cast<uint8_t>(read_file(files[0])[first_file_size - 499]), stream.get());
+    stream.seekg(-1, std::ios::end);
+    ASSERT_EQ(static_cast<uint8_t>(second_data.back()), stream.get());
+    ASSERT_EQ(std::istream::traits_type::eof(), stream.get());
+}
+
+TEST_F(RawFilePlaylistStream_GTest, throws_on_invalid_playlist) {
+    ASSERT_THROW(RawFilePlaylistStream stream({}), HalException);
+    ASSERT_THROW(RawFilePlaylistStream stream({tmpdir_handler_->get_full_path("unknown.raw")}), HalException);
+
+    // The dates of the files differ, which is allowed, but not their plugins
+    const std::vector<std::string> files = {write_raw_file("part_0.raw", 10, 0),
+                                            write_raw_file("part_1.raw", 10, 0, "other")};
+    ASSERT_THROW(RawFilePlaylistStream stream(files), HalException);
+}
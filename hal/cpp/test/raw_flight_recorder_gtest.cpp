@@ -0,0 +1,199 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "metavision/utils/gtest/gtest_with_tmp_dir.h"
+#include "metavision/hal/utils/raw_flight_recorder.h"
+
+using namespace Metavision;
+
+class RawFlightRecorder_GTest : public GTestWithTmpDir {
+protected:
+    virtual void SetUp() override {
+        config_.pre_trigger_ms_  = 1000;
+        config_.post_trigger_ms_ = 500;
+        config_.dump_basename_   = tmpdir_handler_->get_full_path("dump");
+        filename_                = tmpdir_handler_->get_full_path("record.raw");
+        start_time_              = std::chrono::steady_clock::now();
+    }
+
+    // Adds the slices from @p first to @p last excluded, the slice i arriving at i * 100 ms and containing 4 bytes of
+    // value i
+    void add_slices(RawFlightRecorder &recorder, int first, int last) {
+        for (int i = first; i < last; ++i) {
+            auto data = std::make_shared<std::vector<uint8_t>>(4, static_cast<uint8_t>(i));
+            DataTransfer::BufferSlice slice(data->data(), data->data() + data->size(), data);
+            slice.set_arrival_time(start_time_ + std::chrono::milliseconds(100 * i));
+            recorder.add_data(slice);
+        }
+    }
+
+    static std::vector<uint8_t> expected_content(int first, int last) {
+        std::vector<uint8_t> content(Header.begin(), Header.end());
+        for (int i = first; i < last; ++i) {
+            content.insert(content.end(), 4, static_cast<uint8_t>(i));
+        }
+        return content;
+    }
+
+    static std::vector<uint8_t> read_file(const std::string &filename) {
+        std::ifstream ifs(filename, std::ios::binary);
+        return std::vector<uint8_t>(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+    }
+
+    static const std::string Header;
+    RawFlightRecorderConfig config_;
+    std::string filename_;
+    std::chrono::steady_clock::time_point start_time_;
+};
+
+const std::string RawFlightRecorder_GTest::Header = "% header\n% end\n";
+
+TEST_F(RawFlightRecorder_GTest, keeps_only_the_pre_trigger_duration) {
+    RawFlightRecorder recorder(Header, config_);
+    add_slices(recorder, 0, 50);
+
+    // The slices from 3.9s to 4.9s are kept
+    EXPECT_EQ(11 * 4, recorder.get_buffered_bytes());
+    EXPECT_FALSE(recorder.is_dumping());
+    EXPECT_EQ(0, recorder.get_num_dumps());
+}
+
+TEST_F(RawFlightRecorder_GTest, max_bytes) {
+    config_.max_bytes_ = 4 * 5;
+    RawFlightRecorder recorder(Header, config_);
+    add_slices(recorder, 0, 50);
+    EXPECT_EQ(4 * 5, recorder.get_buffered_bytes());
+}
+
+TEST_F(RawFlightRecorder_GTest, dumps_pre_and_post_trigger_data) {
+    {
+        RawFlightRecorder recorder(Header, config_);
+        add_slices(recorder, 0, 50);
+
+        // WHEN triggering at the arrival of the last slice, at 4.9s
+        ASSERT_TRUE(recorder.trigger(filename_));
+        EXPECT_TRUE(recorder.is_dumping());
+        add_slices(recorder, 50, 100);
+
+        // THEN the dump is over once a slice arrives more than the post trigger duration after the trigger
+        EXPECT_FALSE(recorder.is_dumping());
+        EXPECT_EQ(1, recorder.get_num_dumps());
+    }
+
+    // THEN the file contains the slices from 3.9s to 5.4s
+    ASSERT_EQ(expected_content(39, 55), read_file(filename_));
+}
+
+TEST_F(RawFlightRecorder_GTest, trigger_during_dump_extends_it) {
+    {
+        RawFlightRecorder recorder(Header, config_);
+        add_slices(recorder, 0, 50);
+        ASSERT_TRUE(recorder.trigger(filename_));
+        add_slices(recorder, 50, 54);
+
+        // WHEN triggering again during the dump, at 5.3s
+        ASSERT_EQ(std::string(), recorder.trigger());
+        add_slices(recorder, 54, 100);
+        EXPECT_EQ(1, recorder.get_num_dumps());
+    }
+
+    // THEN the dump lasts until the post trigger duration after the last trigger
+    ASSERT_EQ(expected_content(39, 59), read_file(filename_));
+}
+
+TEST_F(RawFlightRecorder_GTest, dump_is_completed_at_destruction) {
+    {
+        RawFlightRecorder recorder(Header, config_);
+        add_slices(recorder, 0, 20);
+        ASSERT_TRUE(recorder.trigger(filename_));
+        add_slices(recorder, 20, 22);
+    }
+    ASSERT_EQ(expected_content(9, 22), read_file(filename_));
+}
+
+TEST_F(RawFlightRecorder_GTest, ext_triggers) {
+    config_.ext_trigger_channel_ = 1;
+    std::string first_dump, second_dump;
+    {
+        RawFlightRecorder recorder(Header, config_);
+        add_slices(recorder, 0, 20);
+
+        // WHEN receiving a falling edge, or a rising edge of another channel
+        std::vector<EventExtTrigger> triggers{EventExtTrigger(0, 1000, 1), EventExtTrigger(1, 1000, 0)};
+        recorder.add_ext_triggers(triggers.data(), triggers.data() + triggers.size());
+
+        // THEN no dump is triggered
+        EXPECT_FALSE(recorder.is_dumping());
+
+        // WHEN receiving a rising edge of the channel
+        triggers = {EventExtTrigger(1, 2000, 1)};
+        recorder.add_ext_triggers(triggers.data(), triggers.data() + triggers.size());
+
+        // THEN a dump is triggered, in a file named after the index of the dump
+        EXPECT_TRUE(recorder.is_dumping());
+        add_slices(recorder, 20, 40);
+        EXPECT_FALSE(recorder.is_dumping());
+        first_dump = config_.dump_basename_ + "_0.raw";
+
+        recorder.add_ext_triggers(triggers.data(), triggers.data() + triggers.size());
+        add_slices(recorder, 40, 41);
+        second_dump = config_.dump_basename_ + "_1.raw";
+        EXPECT_EQ(2, recorder.get_num_dumps());
+    }
+    ASSERT_EQ(expected_content(9, 25), read_file(first_dump));
+    ASSERT_EQ(expected_content(29, 41), read_file(second_dump));
+}
+
+TEST_F(RawFlightRecorder_GTest, event_rate_threshold) {
+    config_.event_rate_threshold_ = 1e6;
+    config_.event_rate_window_us_ = 1000;
+    RawFlightRecorder recorder(Header, config_);
+    add_slices(recorder, 0, 20);
+
+    // Adds n events evenly spread over the window starting at t
+    auto add_events = [&recorder](timestamp t, int n) {
+        std::vector<EventCD> events;
+        for (int i = 0; i < n; ++i) {
+            events.emplace_back(0, 0, 0, t + i * 1000 / n);
+        }
+        recorder.add_cd_events(events.data(), events.data() + events.size());
+    };
+
+    // WHEN the rate stays below 1 Mev/s, i.e. 1000 events per window
+    for (timestamp t = 0; t < 10000; t += 1000) {
+        add_events(t, 900);
+    }
+    // THEN no dump is triggered
+    EXPECT_FALSE(recorder.is_dumping());
+
+    // WHEN a window has more events, even after a gap without events
+    add_events(50000, 1100);
+    EXPECT_FALSE(recorder.is_dumping());
+    add_events(51000, 10);
+
+    // THEN a dump is triggered once the window is over
+    EXPECT_TRUE(recorder.is_dumping());
+}
+
+TEST_F(RawFlightRecorder_GTest, failed_dump) {
+    RawFlightRecorder recorder(Header, config_);
+    add_slices(recorder, 0, 10);
+    ASSERT_FALSE(recorder.trigger(tmpdir_handler_->get_full_path("unknown/record.raw")));
+    EXPECT_FALSE(recorder.is_dumping());
+    EXPECT_EQ(0, recorder.get_num_dumps());
+}
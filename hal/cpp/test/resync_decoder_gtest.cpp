@@ -0,0 +1,212 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <memory>
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "metavision/hal/decoders/evt2_decoder.h"
+#include "metavision/hal/decoders/evt3_decoder.h"
+#include "metavision/hal/decoders/detail/evt2_raw_format.h"
+#include "metavision/hal/decoders/detail/evt3_raw_format.h"
+#include "metavision/hal/utils/resync_decoder.h"
+
+using namespace Metavision;
+
+namespace {
+
+uint16_t make_evt3_word(Evt3::EventTypes type, uint16_t payload) {
+    return static_cast<uint16_t>((static_cast<uint16_t>(type) << Evt3::TypeShift) | payload);
+}
+
+// Stream of about 40s with a time high every 4096us, so that the EVT3 time high loops twice
+std::vector<uint8_t> make_evt3_stream() {
+    std::vector<uint16_t> words;
+    timestamp time_high = -1;
+    for (timestamp t = 1000, i = 0; t < 40000000; t += 997, ++i) {
+        if ((t >> Evt3::TimeLowBits) != time_high) {
+            time_high = t >> Evt3::TimeLowBits;
+            words.push_back(make_evt3_word(Evt3::EventTypes::EVT_TIME_HIGH, time_high & Evt3::TimeMask));
+        }
+        words.push_back(make_evt3_word(Evt3::EventTypes::EVT_TIME_LOW, t & Evt3::TimeMask));
+        words.push_back(make_evt3_word(Evt3::EventTypes::CD_Y, i % 480));
+        words.push_back(make_evt3_word(Evt3::EventTypes::X_BASE, ((i % 2) << Evt3::PolarityShift) | (i % 600)));
+        words.push_back(make_evt3_word(Evt3::EventTypes::VECT_12, (i * 37) & Evt3::Vect12Mask));
+        words.push_back(make_evt3_word(Evt3::EventTypes::X_POS, 639));
+    }
+    auto data = reinterpret_cast<const uint8_t *>(words.data());
+    return std::vector<uint8_t>(data, data + words.size() * sizeof(uint16_t));
+}
+
+// Stream of about 4s with a time high every 64us
+std::vector<uint8_t> make_evt2_stream() {
+    std::vector<uint32_t> words;
+    for (timestamp t = 64, i = 0; t < 4000000; t += 64, ++i) {
+        words.push_back((static_cast<uint32_t>(Evt2::EventTypes::EVT_TIME_HIGH) << Evt2::TypeShift) |
+                        static_cast<uint32_t>((t >> Evt2::TimestampLsbBits) & Evt2::TsMsbMask));
+        for (uint32_t j = 0; j < 5; ++j) {
+            words.push_back((static_cast<uint32_t>(j % 2) << Evt2::TypeShift) | ((j * 7) << Evt2::TimestampShift) |
+                            ((i % 640) << Evt2::XShift) | j);
+        }
+    }
+    auto data = reinterpret_cast<const uint8_t *>(words.data());
+    return std::vector<uint8_t>(data, data + words.size() * sizeof(uint32_t));
+}
+
+} // namespace
+
+class ResyncDecoder_GTest : public ::testing::Test {
+protected:
+    ResyncDecoder_GTest() : cd_decoder_(std::make_shared<I_EventDecoder<EventCD>>()) {
+        cd_decoder_->add_event_buffer_callback(
+            [this](const EventCD *begin, const EventCD *end) { cds_.insert(cds_.end(), begin, end); });
+    }
+
+    // Decodes the data in chunks of odd size, so that the raw events and the corruptions straddle the chunks
+    void decode(ResyncDecoder &decoder, std::vector<uint8_t> &data, size_t chunk_size = 1001) {
+        for (size_t offset = 0; offset < data.size(); offset += chunk_size) {
+            decoder.decode(data.data() + offset, data.data() + std::min(data.size(), offset + chunk_size));
+        }
+    }
+
+    // Checks that the events of the reference from timestamp t onwards are the last decoded events
+    void check_same_events_from(const std::vector<EventCD> &reference, timestamp t) {
+        size_t first = 0;
+        while (first < reference.size() && reference[first].t < t) {
+            ++first;
+        }
+        const size_t n_events = reference.size() - first;
+        ASSERT_LT(0u, n_events);
+        ASSERT_LE(n_events, cds_.size());
+        const size_t offset = cds_.size() - n_events;
+        for (size_t i = 0; i < n_events; ++i) {
+            ASSERT_EQ(reference[first + i].x, cds_[offset + i].x);
+            ASSERT_EQ(reference[first + i].y, cds_[offset + i].y);
+            ASSERT_EQ(reference[first + i].p, cds_[offset + i].p);
+            ASSERT_EQ(reference[first + i].t, cds_[offset + i].t);
+        }
+    }
+
+    std::shared_ptr<I_EventDecoder<EventCD>> cd_decoder_;
+    std::vector<EventCD> cds_;
+};
+
+TEST_F(ResyncDecoder_GTest, valid_stream_is_decoded_as_is) {
+    auto data = make_evt3_stream();
+
+    // GIVEN the events of a valid stream
+    std::vector<EventCD> reference;
+    auto reference_cd_decoder = std::make_shared<I_EventDecoder<EventCD>>();
+    reference_cd_decoder->add_event_buffer_callback(
+        [&reference](const EventCD *begin, const EventCD *end) { reference.insert(reference.end(), begin, end); });
+    EVT3Decoder reference_decoder(false, reference_cd_decoder);
+    reference_decoder.decode(data.data(), data.data() + data.size());
+
+    // WHEN decoding it in chunks with a resync decoder
+    EVT3Decoder evt3_decoder(false, cd_decoder_);
+    ResyncDecoder decoder(evt3_decoder);
+    decode(decoder, data);
+
+    // THEN no corruption is detected and the events are the same
+    ASSERT_EQ(0u, decoder.get_corruption_count());
+    ASSERT_EQ(0u, decoder.get_skipped_bytes());
+    ASSERT_EQ(reference.size(), cds_.size());
+    check_same_events_from(reference, 0);
+}
+
+TEST_F(ResyncDecoder_GTest, evt2_decoding_resumes_after_garbage) {
+    auto data = make_evt2_stream();
+
+    std::vector<EventCD> reference;
+    auto reference_cd_decoder = std::make_shared<I_EventDecoder<EventCD>>();
+    reference_cd_decoder->add_event_buffer_callback(
+        [&reference](const EventCD *begin, const EventCD *end) { reference.insert(reference.end(), begin, end); });
+    EVT2Decoder reference_decoder(false, reference_cd_decoder);
+    const size_t corruption_offset = data.size() / 2 + 1;
+    reference_decoder.decode(data.data(), data.data() + corruption_offset);
+    const timestamp corruption_time = reference_decoder.get_last_timestamp();
+    reference_decoder.decode(data.data() + corruption_offset, data.data() + data.size());
+
+    // GIVEN a stream where random bytes have been inserted in the middle of a raw event
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> dist(0, 255);
+    std::vector<uint8_t> garbage(40003);
+    for (auto &byte : garbage) {
+        byte = static_cast<uint8_t>(dist(gen));
+    }
+    data.insert(data.begin() + corruption_offset, garbage.begin(), garbage.end());
+
+    // WHEN decoding it with a resync decoder
+    EVT2Decoder evt2_decoder(false, cd_decoder_);
+    ResyncDecoder decoder(evt2_decoder);
+    decode(decoder, data);
+
+    // THEN the corruption is skipped and the events following it are decoded with the right timestamps
+    ASSERT_FALSE(decoder.is_resyncing());
+    ASSERT_LE(1u, decoder.get_corruption_count());
+    ASSERT_LT(0u, decoder.get_skipped_bytes());
+    ASSERT_GT(garbage.size() + 1000, decoder.get_skipped_bytes());
+    check_same_events_from(reference, corruption_time + 1000);
+}
+
+TEST_F(ResyncDecoder_GTest, evt3_decoding_resumes_after_truncation) {
+    auto data = make_evt3_stream();
+
+    std::vector<EventCD> reference;
+    auto reference_cd_decoder = std::make_shared<I_EventDecoder<EventCD>>();
+    reference_cd_decoder->add_event_buffer_callback(
+        [&reference](const EventCD *begin, const EventCD *end) { reference.insert(reference.end(), begin, end); });
+    EVT3Decoder reference_decoder(false, reference_cd_decoder);
+    reference_decoder.decode(data.data(), data.data() + data.size());
+
+    // GIVEN a stream truncated in the middle, the remaining data being misaligned
+    const size_t truncation_offset = data.size() / 2;
+    const size_t truncation_size   = 30001;
+    EVT3Decoder prefix_decoder(false);
+    prefix_decoder.decode(data.data(), data.data() + truncation_offset + truncation_size);
+    const timestamp truncation_end_time = prefix_decoder.get_last_timestamp();
+    data.erase(data.begin() + truncation_offset, data.begin() + truncation_offset + truncation_size);
+
+    // WHEN decoding it with a resync decoder
+    EVT3Decoder evt3_decoder(false, cd_decoder_);
+    ResyncDecoder decoder(evt3_decoder);
+    decode(decoder, data, 4096);
+
+    // THEN the decoding resumes with the right timestamps after the truncation
+    ASSERT_FALSE(decoder.is_resyncing());
+    ASSERT_EQ(1u, decoder.get_corruption_count());
+    ASSERT_LT(0u, decoder.get_skipped_bytes());
+    check_same_events_from(reference, truncation_end_time + 50000);
+}
+
+TEST_F(ResyncDecoder_GTest, resync_point_confirmed_by_later_calls) {
+    auto data = make_evt2_stream();
+
+    // GIVEN a stream whose first half is corrupted after its first raw events
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<int> dist(0, 255);
+    for (size_t i = 50; i < data.size() / 2; ++i) {
+        data[i] = static_cast<uint8_t>(dist(gen));
+    }
+
+    // WHEN decoding it in chunks smaller than the raw events needed to confirm a resync point
+    EVT2Decoder evt2_decoder(false, cd_decoder_);
+    ResyncDecoder decoder(evt2_decoder);
+    decode(decoder, data, 7);
+
+    // THEN the decoding resumes and the timeline of the stream is recovered
+    ASSERT_FALSE(decoder.is_resyncing());
+    ASSERT_LE(1u, decoder.get_corruption_count());
+    ASSERT_LT(data.size() / 2 - 1000, decoder.get_skipped_bytes());
+    ASSERT_LT(0u, cds_.size());
+    ASSERT_EQ(timestamp(4000000 - 64 + 28), evt2_decoder.get_last_timestamp());
+}
@@ -0,0 +1,142 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include "metavision/utils/gtest/gtest_with_tmp_dir.h"
+#include "metavision/hal/utils/hal_exception.h"
+#include "metavision/hal/utils/rotating_raw_file_writer.h"
+
+using namespace Metavision;
+
+class RotatingRawFileWriter_GTest : public GTestWithTmpDir {
+protected:
+    virtual void SetUp() override {
+        static int file_counter = 0;
+        config_.basename_       = tmpdir_handler_->get_full_path("record_" + std::to_string(++file_counter));
+
+        data_ = std::make_shared<std::vector<uint8_t>>(30011);
+        std::iota(data_->begin(), data_->end(), 0);
+    }
+
+    static std::string make_header(size_t index) {
+        return "% index " + std::to_string(index) + "\n% end\n";
+    }
+
+    // Writes the test data in slices of @p slice_size bytes, leaving time to the writer to prepare the next file
+    void write_data(RotatingRawFileWriter &writer, size_t slice_size) {
+        for (size_t offset = 0; offset < data_->size(); offset += slice_size) {
+            const size_t end = std::min(data_->size(), offset + slice_size);
+            writer.write(DataTransfer::BufferSlice(data_->data() + offset, data_->data() + end, data_));
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+    }
+
+    static std::vector<uint8_t> read_file(const std::string &filename) {
+        std::ifstream ifs(filename, std::ios::binary);
+        return std::vector<uint8_t>(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+    }
+
+    // Checks that each file starts with its header, and returns the concatenation of the data of the files
+    static std::vector<uint8_t> read_data(const std::vector<std::string> &filenames) {
+        std::vector<uint8_t> data;
+        for (size_t i = 0; i < filenames.size(); ++i) {
+            const auto content = read_file(filenames[i]);
+            const auto header  = make_header(i);
+            EXPECT_GE(content.size(), header.size());
+            EXPECT_TRUE(std::equal(header.begin(), header.end(), content.begin()));
+            data.insert(data.end(), content.begin() + header.size(), content.end());
+        }
+        return data;
+    }
+
+    RawFileRotationConfig config_;
+    std::shared_ptr<std::vector<uint8_t>> data_;
+};
+
+TEST_F(RotatingRawFileWriter_GTest, throws_if_first_file_can_not_be_opened) {
+    config_.basename_ = tmpdir_handler_->get_full_path("unknown/record");
+    ASSERT_THROW(RotatingRawFileWriter writer(make_header, config_), HalException);
+}
+
+TEST_F(RotatingRawFileWriter_GTest, file_names) {
+    config_.basename_ = "dir/record";
+    ASSERT_EQ("dir/record_0000.raw", RotatingRawFileWriter::get_filename(config_, 0));
+    ASSERT_EQ("dir/record_0012.raw", RotatingRawFileWriter::get_filename(config_, 12));
+}
+
+TEST_F(RotatingRawFileWriter_GTest, rotates_on_size_without_missing_nor_duplicating_data) {
+    // GIVEN a writer starting a new file every 5000 bytes of data
+    config_.max_file_size_ = 5000;
+    std::vector<std::string> filenames;
+    {
+        RotatingRawFileWriter writer(make_header, config_);
+
+        // WHEN writing the data
+        write_data(writer, 1000);
+        filenames = writer.get_filenames();
+    }
+
+    // THEN the data is split among several files, none of which exceeds the maximum size
+    ASSERT_LT(1, filenames.size());
+    for (size_t i = 0; i < filenames.size(); ++i) {
+        ASSERT_EQ(RotatingRawFileWriter::get_filename(config_, i), filenames[i]);
+        ASSERT_GE(config_.max_file_size_ + make_header(i).size(), read_file(filenames[i]).size());
+    }
+    ASSERT_EQ(*data_, read_data(filenames));
+
+    // AND the file prepared in advance has been removed
+    ASSERT_FALSE(std::ifstream(RotatingRawFileWriter::get_filename(config_, filenames.size())).is_open());
+}
+
+TEST_F(RotatingRawFileWriter_GTest, rotates_on_request) {
+    std::vector<std::string> filenames;
+    {
+        // GIVEN a writer without rotation policy
+        RotatingRawFileWriter writer(make_header, config_);
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+        // WHEN requesting a rotation in the middle of the data
+        const size_t half = data_->size() / 2;
+        writer.write(DataTransfer::BufferSlice(data_->data(), data_->data() + half, data_));
+        writer.request_rotation();
+        writer.write(DataTransfer::BufferSlice(data_->data() + half, data_->data() + data_->size(), data_));
+        filenames = writer.get_filenames();
+    }
+
+    // THEN each half of the data is in its own file
+    ASSERT_EQ(2, filenames.size());
+    ASSERT_EQ(data_->size() / 2 + make_header(0).size(), read_file(filenames[0]).size());
+    ASSERT_EQ(*data_, read_data(filenames));
+}
+
+TEST_F(RotatingRawFileWriter_GTest, rotates_on_duration) {
+    // GIVEN a writer starting a new file every 20ms
+    config_.max_file_duration_ms_ = 20;
+    std::vector<std::string> filenames;
+    {
+        RotatingRawFileWriter writer(make_header, config_);
+
+        // WHEN writing the data during more than 20ms
+        write_data(writer, 3000);
+        filenames = writer.get_filenames();
+    }
+
+    // THEN the data is split among several files
+    ASSERT_LT(1, filenames.size());
+    ASSERT_EQ(*data_, read_data(filenames));
+}
@@ -0,0 +1,201 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <chrono>
+#include <cstring>
+#include <numeric>
+#include <string>
+#include <vector>
+#ifndef _WIN32
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+#include <gtest/gtest.h>
+
+#include "metavision/hal/utils/hal_exception.h"
+#include "metavision/hal/utils/shared_memory_buffer_pool.h"
+
+using namespace Metavision;
+
+namespace {
+
+class SharedMemoryBufferPool_GTest : public ::testing::Test {
+protected:
+    virtual void SetUp() override {
+        // Each test uses its own pool, so that a pool left by a failed test does not interfere
+        static int pool_counter = 0;
+        name_ = "gtest_pool_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()) + "_" +
+                std::to_string(++pool_counter);
+        config_.n_slabs_         = 4;
+        config_.slab_size_bytes_ = 256;
+    }
+
+    static std::vector<uint8_t> make_data(size_t size, uint8_t first = 0) {
+        std::vector<uint8_t> data(size);
+        std::iota(data.begin(), data.end(), first);
+        return data;
+    }
+
+    std::string name_;
+    SharedMemoryBufferPoolConfig config_;
+};
+
+} // namespace
+
+TEST_F(SharedMemoryBufferPool_GTest, data_written_is_mapped_by_another_pool_instance) {
+    auto writer = SharedMemoryBufferPool::create(name_, config_);
+    auto reader = SharedMemoryBufferPool::open(name_);
+    EXPECT_EQ(4, reader->get_n_slabs());
+    EXPECT_EQ(256, reader->get_slab_size());
+
+    // WHEN writing data and handing its handle over to the reader
+    const auto data = make_data(100);
+    auto handle     = writer->write(data.data(), data.size());
+    ASSERT_TRUE(handle.valid());
+    EXPECT_EQ(100, handle.size);
+    EXPECT_EQ(3, writer->get_n_free_slabs());
+
+    // THEN the reader gets the same data, and the slab is freed once the slice is destroyed
+    {
+        auto slice = reader->get_slice(handle);
+        ASSERT_EQ(data.size(), slice.size());
+        EXPECT_EQ(0, std::memcmp(data.data(), slice.data(), data.size()));
+        auto copy = slice;
+        slice     = DataTransfer::BufferSlice();
+        EXPECT_EQ(3, writer->get_n_free_slabs());
+    }
+    EXPECT_EQ(4, writer->get_n_free_slabs());
+}
+
+TEST_F(SharedMemoryBufferPool_GTest, slab_is_freed_when_its_last_reference_is_released) {
+    auto pool   = SharedMemoryBufferPool::create(name_, config_);
+    auto handle = pool->acquire();
+    ASSERT_TRUE(handle.valid());
+    EXPECT_EQ(256, handle.size);
+
+    // WHEN sharing the handle with two consumers
+    pool->add_reference(handle);
+    pool->release(handle);
+    EXPECT_EQ(3, pool->get_n_free_slabs());
+
+    // THEN the slab is only freed when both have released it
+    pool->release(handle);
+    EXPECT_EQ(4, pool->get_n_free_slabs());
+    EXPECT_THROW(pool->release(handle), HalException);
+    EXPECT_THROW(pool->get_data(handle), HalException);
+}
+
+TEST_F(SharedMemoryBufferPool_GTest, stale_handle_does_not_affect_reused_slab) {
+    config_.n_slabs_ = 1;
+    auto pool        = SharedMemoryBufferPool::create(name_, config_);
+    auto first       = pool->acquire();
+    pool->release(first);
+
+    // WHEN the slab is reused
+    auto second = pool->acquire();
+    ASSERT_TRUE(second.valid());
+    EXPECT_EQ(first.slab, second.slab);
+    EXPECT_NE(first.generation, second.generation);
+
+    // THEN the handle of its previous use is rejected
+    EXPECT_THROW(pool->add_reference(first), HalException);
+    EXPECT_THROW(pool->release(first), HalException);
+    EXPECT_EQ(0, pool->get_n_free_slabs());
+    pool->release(second);
+}
+
+TEST_F(SharedMemoryBufferPool_GTest, data_is_dropped_when_no_slab_is_free) {
+    auto pool = SharedMemoryBufferPool::create(name_, config_);
+    std::vector<SharedMemoryBufferPool::Handle> handles;
+    const auto data = make_data(16);
+    for (int i = 0; i < 4; ++i) {
+        handles.push_back(pool->write(data.data(), data.size()));
+        ASSERT_TRUE(handles.back().valid());
+    }
+
+    // WHEN all slabs are used
+    auto handle = pool->write(data.data(), data.size());
+
+    // THEN the data is dropped, until a slab is released
+    EXPECT_FALSE(handle.valid());
+    EXPECT_EQ(1, pool->get_n_dropped_buffers());
+    pool->release(handles[2]);
+    handle = pool->write(data.data(), data.size());
+    EXPECT_TRUE(handle.valid());
+    EXPECT_EQ(handles[2].slab, handle.slab);
+}
+
+TEST_F(SharedMemoryBufferPool_GTest, range_is_split_over_slabs_without_splitting_elements) {
+    struct Element {
+        uint64_t values[3];
+    };
+    std::vector<Element> elements(20);
+    for (size_t i = 0; i < elements.size(); ++i) {
+        elements[i].values[0] = i;
+    }
+    auto pool = SharedMemoryBufferPool::create(name_, config_);
+
+    // WHEN writing more elements than a slab can hold (10 elements of 24 bytes per slab of 256 bytes)
+    auto handles = pool->write_range(elements.data(), elements.data() + elements.size());
+
+    // THEN they are written in two slabs, holding whole elements
+    ASSERT_EQ(2, handles.size());
+    EXPECT_EQ(10 * sizeof(Element), handles[0].size);
+    EXPECT_EQ(10 * sizeof(Element), handles[1].size);
+    const Element *second = reinterpret_cast<const Element *>(pool->get_data(handles[1]));
+    EXPECT_EQ(10, second[0].values[0]);
+    EXPECT_EQ(19, second[9].values[0]);
+}
+
+#ifndef _WIN32
+TEST_F(SharedMemoryBufferPool_GTest, references_are_counted_across_processes) {
+    auto pool       = SharedMemoryBufferPool::create(name_, config_);
+    const auto data = make_data(64, 10);
+    auto handle     = pool->write(data.data(), data.size());
+    ASSERT_TRUE(handle.valid());
+    pool->add_reference(handle);
+
+    // WHEN another process reads the data and releases the reference it was given
+    pid_t pid = fork();
+    ASSERT_NE(-1, pid);
+    if (pid == 0) {
+        int result = 1;
+        {
+            auto child = SharedMemoryBufferPool::open(name_);
+            auto slice = child->get_slice(handle);
+            result     = std::memcmp(slice.data(), data.data(), data.size()) == 0 ? 0 : 1;
+        }
+        _exit(result);
+    }
+    int status = 0;
+    ASSERT_EQ(pid, waitpid(pid, &status, 0));
+    ASSERT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(0, WEXITSTATUS(status));
+
+    // THEN the slab is only held by the reference of this process
+    EXPECT_EQ(3, pool->get_n_free_slabs());
+    pool->release(handle);
+    EXPECT_EQ(4, pool->get_n_free_slabs());
+}
+#endif
+
+TEST_F(SharedMemoryBufferPool_GTest, invalid_pools_throw) {
+    SharedMemoryBufferPoolConfig config;
+    config.slab_size_bytes_ = 100;
+    EXPECT_THROW(SharedMemoryBufferPool::create(name_, config), HalException);
+    EXPECT_THROW(SharedMemoryBufferPool::create("invalid/name"), HalException);
+    EXPECT_THROW(SharedMemoryBufferPool::open(name_), HalException);
+
+    auto pool = SharedMemoryBufferPool::create(name_, config_);
+    std::vector<uint8_t> data(config_.slab_size_bytes_ + 1);
+    EXPECT_THROW(pool->write(data.data(), data.size()), HalException);
+    EXPECT_THROW(pool->release(SharedMemoryBufferPool::Handle()), HalException);
+}
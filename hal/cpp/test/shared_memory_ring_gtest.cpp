@@ -0,0 +1,255 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <string>
+#include <vector>
+#ifndef _WIN32
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+#include <gtest/gtest.h>
+
+#include "metavision/hal/utils/file_data_transfer.h"
+#include "metavision/hal/utils/hal_exception.h"
+#include "metavision/hal/utils/raw_file_config.h"
+#include "metavision/hal/utils/raw_file_header.h"
+#include "metavision/hal/utils/shared_memory_raw_stream.h"
+#include "metavision/hal/utils/shared_memory_ring.h"
+
+using namespace Metavision;
+
+namespace {
+
+class SharedMemoryRing_GTest : public ::testing::Test {
+protected:
+    virtual void SetUp() override {
+        // Each test uses its own ring, so that a ring left by a failed test does not interfere
+        static int ring_counter = 0;
+        name_ = "gtest_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()) + "_" +
+                std::to_string(++ring_counter);
+    }
+
+    static std::vector<uint8_t> make_data(size_t size, uint8_t first = 0) {
+        std::vector<uint8_t> data(size);
+        std::iota(data.begin(), data.end(), first);
+        return data;
+    }
+
+    static void publish(SharedMemoryRing &ring, const std::vector<uint8_t> &data) {
+        ASSERT_TRUE(ring.publish(data.data(), data.size()));
+    }
+
+    static std::vector<uint8_t> read(SharedMemoryRing &ring, size_t size) {
+        std::vector<uint8_t> data;
+        while (data.size() < size) {
+            auto slice = ring.wait_next(std::chrono::milliseconds(1000));
+            if (slice.empty()) {
+                break;
+            }
+            data.insert(data.end(), slice.data(), slice.data() + slice.size());
+        }
+        return data;
+    }
+
+    std::string name_;
+};
+
+} // namespace
+
+TEST_F(SharedMemoryRing_GTest, reader_gets_header_and_buffers_published) {
+    auto publisher = SharedMemoryRing::create(name_, "% key value\n");
+    auto reader    = SharedMemoryRing::open(name_);
+    EXPECT_EQ("% key value\n", reader->get_header());
+    EXPECT_EQ(1, publisher->get_n_readers());
+
+    // WHEN publishing buffers, one of them being larger than a slot
+    SharedMemoryRingConfig config;
+    auto small_data = make_data(1000);
+    auto large_data = make_data(config.slot_size_bytes_ + 10, 7);
+    publish(*publisher, small_data);
+    publish(*publisher, large_data);
+
+    // THEN the reader gets all the data, in order
+    EXPECT_EQ(small_data, read(*reader, small_data.size()));
+    EXPECT_EQ(large_data, read(*reader, large_data.size()));
+    EXPECT_EQ(0, publisher->get_n_dropped_buffers());
+}
+
+TEST_F(SharedMemoryRing_GTest, reader_only_gets_buffers_published_after_it_is_opened) {
+    auto publisher = SharedMemoryRing::create(name_, "");
+    publish(*publisher, make_data(10));
+
+    auto reader = SharedMemoryRing::open(name_);
+    auto data   = make_data(20, 3);
+    publish(*publisher, data);
+    EXPECT_EQ(data, read(*reader, data.size()));
+}
+
+TEST_F(SharedMemoryRing_GTest, all_readers_get_the_same_data) {
+    auto publisher = SharedMemoryRing::create(name_, "");
+    std::vector<std::shared_ptr<SharedMemoryRing>> readers;
+    for (int i = 0; i < 3; ++i) {
+        readers.push_back(SharedMemoryRing::open(name_));
+    }
+    EXPECT_EQ(3, publisher->get_n_readers());
+
+    auto data = make_data(100);
+    publish(*publisher, data);
+    for (auto &reader : readers) {
+        EXPECT_EQ(data, read(*reader, data.size()));
+    }
+}
+
+TEST_F(SharedMemoryRing_GTest, publisher_drops_data_instead_of_waiting_for_a_slow_reader) {
+    SharedMemoryRingConfig config;
+    config.n_slots_ = 2;
+    auto publisher  = SharedMemoryRing::create(name_, "", config);
+    auto reader     = SharedMemoryRing::open(name_);
+
+    // WHEN the reader holds the slots of all the buffers published
+    publish(*publisher, make_data(8));
+    publish(*publisher, make_data(8, 1));
+    auto first_slice = reader->wait_next(std::chrono::milliseconds(0));
+    ASSERT_EQ(8, first_slice.size());
+
+    // THEN the next buffer is dropped
+    auto data = make_data(8, 2);
+    EXPECT_FALSE(publisher->publish(data.data(), data.size()));
+    EXPECT_EQ(1, publisher->get_n_dropped_buffers());
+    EXPECT_EQ(0, first_slice.data()[0]);
+
+    // WHEN the reader releases its first slot
+    first_slice.reset();
+
+    // THEN a buffer can be published again, after the ones still held
+    publish(*publisher, data);
+    EXPECT_EQ(make_data(8, 1), read(*reader, 8));
+    EXPECT_EQ(data, read(*reader, 8));
+}
+
+TEST_F(SharedMemoryRing_GTest, slots_of_a_closed_reader_are_reused) {
+    SharedMemoryRingConfig config;
+    config.n_slots_ = 2;
+    auto publisher  = SharedMemoryRing::create(name_, "", config);
+    auto reader     = SharedMemoryRing::open(name_);
+    publish(*publisher, make_data(8));
+    publish(*publisher, make_data(8));
+
+    // WHEN the reader is closed without reading the data
+    reader.reset();
+
+    // THEN the slots can be reused
+    EXPECT_EQ(0, publisher->get_n_readers());
+    publish(*publisher, make_data(8));
+    publish(*publisher, make_data(8));
+    EXPECT_EQ(0, publisher->get_n_dropped_buffers());
+}
+
+#ifndef _WIN32
+TEST_F(SharedMemoryRing_GTest, slots_of_a_dead_reader_are_reclaimed) {
+    SharedMemoryRingConfig config;
+    config.n_slots_ = 2;
+    auto publisher  = SharedMemoryRing::create(name_, "", config);
+
+    // WHEN a reader registers from another process, which exits without closing it
+    pid_t pid = fork();
+    ASSERT_NE(-1, pid);
+    if (pid == 0) {
+        new std::shared_ptr<SharedMemoryRing>(SharedMemoryRing::open(name_));
+        _exit(0);
+    }
+    int status = 0;
+    ASSERT_EQ(pid, waitpid(pid, &status, 0));
+    ASSERT_EQ(1, publisher->get_n_readers());
+
+    // THEN the slots it holds are reclaimed once the ring wraps around
+    for (int i = 0; i < 4; ++i) {
+        publish(*publisher, make_data(8));
+    }
+    EXPECT_EQ(0, publisher->get_n_dropped_buffers());
+    EXPECT_EQ(0, publisher->get_n_readers());
+}
+#endif
+
+TEST_F(SharedMemoryRing_GTest, reader_stops_when_ring_is_closed) {
+    auto publisher = SharedMemoryRing::create(name_, "");
+    auto reader    = SharedMemoryRing::open(name_);
+    auto data      = make_data(16);
+    publish(*publisher, data);
+
+    // WHEN the publisher closes the ring
+    publisher.reset();
+
+    // THEN the reader still gets the data published before, then is closed
+    EXPECT_FALSE(reader->is_closed());
+    EXPECT_EQ(data, read(*reader, data.size()));
+    EXPECT_TRUE(reader->wait_next(std::chrono::milliseconds(1000)).empty());
+    EXPECT_TRUE(reader->is_closed());
+}
+
+TEST_F(SharedMemoryRing_GTest, invalid_rings_throw) {
+    SharedMemoryRingConfig config;
+    config.n_slots_ = 1;
+    EXPECT_THROW(SharedMemoryRing::create(name_, "", config), HalException);
+    EXPECT_THROW(SharedMemoryRing::create("invalid/name", ""), HalException);
+    EXPECT_THROW(SharedMemoryRing::open(name_), HalException);
+
+    // A ring can not be published twice
+    auto publisher = SharedMemoryRing::create(name_, "");
+    EXPECT_THROW(SharedMemoryRing::create(name_, ""), HalException);
+}
+
+TEST_F(SharedMemoryRing_GTest, raw_stream_is_transferred_without_copy) {
+    auto publisher = SharedMemoryRing::create(name_, "% integrator_name Prophesee\n% plugin_name dummy\n");
+    auto stream    = std::make_unique<SharedMemoryRawStream>(name_);
+    auto data      = make_data(5000);
+    publish(*publisher, std::vector<uint8_t>(data.begin(), data.begin() + 3000));
+    publish(*publisher, std::vector<uint8_t>(data.begin() + 3000, data.end()));
+    publisher->close();
+
+    // WHEN reading the stream as a RAW file
+    RawFileHeader header(*stream);
+    EXPECT_EQ("Prophesee", header.get_integrator_name());
+    EXPECT_EQ("dummy", header.get_plugin_name());
+
+    std::mutex mutex;
+    std::condition_variable cond;
+    bool stopped = false;
+    std::vector<DataTransfer::BufferSlice> slices;
+    FileDataTransfer transfer(std::move(stream), 1, RawFileConfig());
+    transfer.add_new_slice_callback([&slices](const DataTransfer::BufferSlice &slice) { slices.push_back(slice); });
+    transfer.add_status_changed_callback([&](DataTransfer::Status status) {
+        if (status == DataTransfer::Status::Stopped) {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopped = true;
+            cond.notify_all();
+        }
+    });
+    transfer.start();
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        cond.wait(lock, [&stopped] { return stopped; });
+    }
+    transfer.stop();
+
+    // THEN the data following the header is transferred as published
+    ASSERT_EQ(2, slices.size());
+    std::vector<uint8_t> transferred;
+    for (auto &slice : slices) {
+        transferred.insert(transferred.end(), slice.data(), slice.data() + slice.size());
+    }
+    EXPECT_EQ(data, transferred);
+}
@@ -0,0 +1,143 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "metavision/utils/gtest/gtest_with_tmp_dir.h"
+#include "metavision/hal/utils/hal_exception.h"
+#include "metavision/hal/utils/raw_file_header.h"
+#include "metavision/hal/utils/raw_file_playlist_stream.h"
+#include "metavision/hal/utils/striped_raw_file_writer.h"
+
+using namespace Metavision;
+
+class StripedRawFileWriter_GTest : public GTestWithTmpDir {
+protected:
+    virtual void SetUp() override {
+        manifest_path_ = tmpdir_handler_->get_full_path("record.stripes");
+
+        RawFileHeader header;
+        header.set_plugin_name("dummy");
+        header.set_integrator_name("Prophesee");
+        std::ostringstream oss;
+        oss << header;
+        header_ = oss.str();
+
+        data_ = std::make_shared<std::vector<uint8_t>>(30011);
+        std::iota(data_->begin(), data_->end(), 0);
+
+        // Both relative to the directory of the manifest and absolute directories
+        config_.directories_ = {".", tmpdir_handler_->get_tmpdir_path(), "."};
+        config_.stripe_size_ = 1000;
+    }
+
+    // Writes the test data in slices of @p slice_size bytes
+    void write_data(StripedRawFileWriter &writer, size_t slice_size) {
+        for (size_t offset = 0; offset < data_->size(); offset += slice_size) {
+            const size_t end = std::min(data_->size(), offset + slice_size);
+            writer.write(DataTransfer::BufferSlice(data_->data() + offset, data_->data() + end, data_));
+        }
+    }
+
+    static std::vector<uint8_t> read_all(std::istream &stream) {
+        return std::vector<uint8_t>(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+    }
+
+    std::string manifest_path_;
+    std::string header_;
+    StripedRawFileWriterConfig config_;
+    std::shared_ptr<std::vector<uint8_t>> data_;
+};
+
+TEST_F(StripedRawFileWriter_GTest, throws_on_invalid_configuration) {
+    StripedRawFileWriterConfig config;
+    ASSERT_THROW(StripedRawFileWriter writer(manifest_path_, header_, config), HalException);
+
+    config.directories_ = {"."};
+    config.stripe_size_ = 0;
+    ASSERT_THROW(StripedRawFileWriter writer(manifest_path_, header_, config), HalException);
+
+    config.stripe_size_                = 1000;
+    config.writer_config_.compression_ = RawCompression::LZ4;
+    ASSERT_THROW(StripedRawFileWriter writer(manifest_path_, header_, config), HalException);
+}
+
+TEST_F(StripedRawFileWriter_GTest, stripes_data_across_files) {
+    std::vector<std::string> stripe_files;
+    {
+        StripedRawFileWriter writer(manifest_path_, header_, config_);
+        write_data(writer, 700);
+        stripe_files = writer.get_stripe_files();
+    }
+
+    // Each file holds the header, followed by every third stripe
+    ASSERT_EQ(3, stripe_files.size());
+    for (size_t i = 0; i < stripe_files.size(); ++i) {
+        std::ifstream ifs(stripe_files[i], std::ios::binary);
+        const auto content = read_all(ifs);
+        ASSERT_TRUE(std::equal(header_.begin(), header_.end(), content.begin()));
+        std::vector<uint8_t> expected;
+        for (size_t offset = i * config_.stripe_size_; offset < data_->size();
+             offset += stripe_files.size() * config_.stripe_size_) {
+            const size_t end = std::min(data_->size(), offset + config_.stripe_size_);
+            expected.insert(expected.end(), data_->begin() + offset, data_->begin() + end);
+        }
+        ASSERT_EQ(expected, std::vector<uint8_t>(content.begin() + header_.size(), content.end()));
+    }
+
+    const auto manifest = StripedRawFileWriter::read_manifest(manifest_path_);
+    ASSERT_EQ(config_.stripe_size_, manifest.stripe_size);
+    ASSERT_EQ(3, manifest.stripe_files.size());
+    for (size_t i = 0; i < stripe_files.size(); ++i) {
+        ASSERT_EQ(read_all(*std::make_unique<std::ifstream>(stripe_files[i], std::ios::binary)),
+                  read_all(*std::make_unique<std::ifstream>(manifest.stripe_files[i], std::ios::binary)));
+    }
+}
+
+TEST_F(StripedRawFileWriter_GTest, stripes_are_read_back_as_one_stream) {
+    {
+        StripedRawFileWriter writer(manifest_path_, header_, config_);
+        write_data(writer, 1500);
+    }
+
+    // GIVEN the stream reading the striped recording
+    ASSERT_TRUE(StripedRawFileWriter::is_manifest(manifest_path_));
+    auto stream = RawFilePlaylistStream::open_stripes(manifest_path_, 300);
+
+    // THEN it holds the header followed by all the data
+    std::vector<uint8_t> expected(header_.begin(), header_.end());
+    expected.insert(expected.end(), data_->begin(), data_->end());
+    ASSERT_EQ(expected.size(), stream->size());
+    ASSERT_EQ(expected, read_all(*stream));
+
+    // AND it can be seeked
+    stream->clear();
+    stream->seekg(header_.size() + 4321);
+    char c;
+    ASSERT_TRUE(stream->get(c));
+    ASSERT_EQ(static_cast<uint8_t>(4321), static_cast<uint8_t>(c));
+}
+
+TEST_F(StripedRawFileWriter_GTest, throws_on_invalid_manifest) {
+    ASSERT_THROW(StripedRawFileWriter::read_manifest(tmpdir_handler_->get_full_path("unknown.stripes")), HalException);
+
+    std::ofstream(manifest_path_) << "% stripe_size 0\nrecord_0.raw\n";
+    ASSERT_THROW(StripedRawFileWriter::read_manifest(manifest_path_), HalException);
+
+    std::ofstream(manifest_path_) << "% stripe_size 1000\n";
+    ASSERT_THROW(StripedRawFileWriter::read_manifest(manifest_path_), HalException);
+}
@@ -0,0 +1,91 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "metavision/hal/utils/timestamp_unwrapper.h"
+
+using namespace Metavision;
+
+using Unwrapper = TimestampUnwrapper<4, 6>;
+
+TEST(TimestampUnwrapper_GTest, time_base_follows_the_time_high) {
+    Unwrapper unwrapper(false);
+    ASSERT_FALSE(unwrapper.is_time_base_set());
+    timestamp shift;
+    ASSERT_FALSE(unwrapper.get_time_shift(shift));
+
+    unwrapper.add_time_high(3);
+    ASSERT_TRUE(unwrapper.is_time_base_set());
+    EXPECT_EQ(3 << 6, unwrapper.get_time_base());
+    EXPECT_EQ((3 << 6) + 10, unwrapper.get_time(10));
+    ASSERT_TRUE(unwrapper.get_time_shift(shift));
+    EXPECT_EQ(0, shift);
+
+    unwrapper.add_time_high(5);
+    EXPECT_EQ(5 << 6, unwrapper.get_time_base());
+}
+
+TEST(TimestampUnwrapper_GTest, time_base_is_unwrapped_when_the_time_high_loops) {
+    Unwrapper unwrapper(false);
+
+    // WHEN the time high counter wraps around, several times
+    timestamp expected = 0;
+    for (int loop = 0; loop < 3; ++loop) {
+        for (uint32_t time_high = 0; time_high < 16; ++time_high) {
+            unwrapper.add_time_high(time_high);
+            // THEN the time base keeps increasing
+            ASSERT_EQ(expected, unwrapper.get_time_base());
+            expected += 1 << 6;
+        }
+    }
+
+    // THEN a small step backward is not considered as a loop
+    unwrapper.add_time_high(14);
+    EXPECT_EQ(expected - (2 << 6), unwrapper.get_time_base());
+}
+
+TEST(TimestampUnwrapper_GTest, time_is_shifted_by_the_first_time_high) {
+    Unwrapper unwrapper(true);
+    unwrapper.add_time_high(10);
+    timestamp shift;
+    ASSERT_TRUE(unwrapper.get_time_shift(shift));
+    EXPECT_EQ(10 << 6, shift);
+    EXPECT_EQ(0, unwrapper.get_time_base());
+
+    // WHEN the time high loops after the shift has been set
+    unwrapper.add_time_high(15);
+    unwrapper.add_time_high(1);
+
+    // THEN the time base is unwrapped and shifted
+    EXPECT_EQ((17 - 10) << 6, unwrapper.get_time_base());
+    EXPECT_EQ(((17 - 10) << 6) + 5, unwrapper.get_time(5));
+}
+
+TEST(TimestampUnwrapper_GTest, reset_resumes_from_a_timestamp) {
+    Unwrapper unwrapper(true);
+    unwrapper.set_time_shift(100);
+
+    // WHEN resetting the time to a timestamp located after 2 loops of the counter
+    const timestamp t = 2 * Unwrapper::TimeLoop + (3 << 6) + 20 - 100;
+    unwrapper.reset(t);
+
+    // THEN the time base is the time high preceding it, and the next time highs are unwrapped from there
+    ASSERT_TRUE(unwrapper.is_time_base_set());
+    EXPECT_EQ(t - 20, unwrapper.get_time_base());
+    unwrapper.add_time_high(4);
+    EXPECT_EQ(t - 20 + (1 << 6), unwrapper.get_time_base());
+
+    // THEN the shift set before the reset is kept
+    timestamp shift;
+    ASSERT_TRUE(unwrapper.get_time_shift(shift));
+    EXPECT_EQ(100, shift);
+}
@@ -9,6 +9,8 @@
  * See the License for the specific language governing permissions and limitations under the License.                 *
  **********************************************************************************************************************/
 
+#include <stdexcept>
+#include <vector>
 #include <pybind11/pybind11.h>
 
 #include "hal_python_binder.h"
@@ -37,6 +39,40 @@ std::shared_ptr<Device> open_raw_file_with_config_wrapper(const std::string &raw
     return std::shared_ptr<Device>(DeviceDiscovery::open_raw_file(raw_file, file_config));
 }
 
+std::shared_ptr<Device> open_memory_wrapper(const py::object &data, RawFileConfig &stream_config) {
+    // The python objects exposing the buffers are kept alive by the device and the data it transferred, and are
+    // released with the GIL held, possibly from the thread of the transfers
+    auto views = std::shared_ptr<std::vector<py::buffer_info>>(new std::vector<py::buffer_info>(),
+                                                               [](std::vector<py::buffer_info> *views) {
+                                                                   py::gil_scoped_acquire acquire;
+                                                                   delete views;
+                                                               });
+    std::vector<py::buffer> objects;
+    if (py::isinstance<py::buffer>(data)) {
+        objects.push_back(data.cast<py::buffer>());
+    } else {
+        for (const auto &object : data) {
+            objects.push_back(object.cast<py::buffer>());
+        }
+    }
+
+    std::vector<MemoryRawStream::Buffer> buffers;
+    for (const auto &object : objects) {
+        // Fails if the buffer is not contiguous, instead of silently copying it
+        views->emplace_back(object.request());
+        const auto &view   = views->back();
+        py::ssize_t stride = view.itemsize;
+        for (py::ssize_t i = view.ndim - 1; i >= 0; --i) {
+            if (view.shape[i] > 1 && view.strides[i] != stride) {
+                throw std::invalid_argument("The buffers to read must be contiguous.");
+            }
+            stride *= view.shape[i];
+        }
+        buffers.push_back({view.ptr, static_cast<size_t>(view.size * view.itemsize)});
+    }
+    return std::shared_ptr<Device>(DeviceDiscovery::open_memory(buffers, stream_config, views));
+}
+
 } // anonymous namespace
 
 static HALGenericPythonBinder bind_connection_type([](auto &module) {
@@ -79,6 +115,9 @@ static HALGenericPythonBinder bind([](auto &module) {
                         py::arg("raw_file"), py::arg("file_config"),
                         pybind_doc_hal["Metavision::DeviceDiscovery::open_raw_file(const std::string &raw_file, "
                                        "RawFileConfig &file_config)"])
+            .def_static("open_memory", &open_memory_wrapper, py::return_value_policy::take_ownership, py::arg("data"),
+                        py::arg("stream_config"),
+                        pybind_doc_hal["Metavision::DeviceDiscovery::open_memory"])
             .def_static(
                 "list",
                 +[]() {
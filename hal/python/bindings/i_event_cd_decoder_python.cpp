@@ -14,9 +14,12 @@
 #include <pybind11/functional.h>
 
 #include "metavision/utils/pybind/deprecation_warning_exception.h"
+#include "metavision/utils/pybind/pooled_event_buffer.h"
 #include "hal_python_binder.h"
 #include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/base/events/event_cd_buffer_soa.h"
 #include "metavision/hal/facilities/i_event_decoder.h"
+#include "metavision/hal/utils/shared_memory_buffer_pool.h"
 #include "pb_doc_hal.h"
 
 namespace py = pybind11;
@@ -43,6 +46,8 @@ static HALFacilityPythonBinder<I_EventDecoder<EventCD>> bind_decoder(
     [](auto &module, auto &class_binding) {
         using EventCDIterator_t = I_EventDecoder<EventCD>::EventIterator_t;
 
+        export_PooledEventBuffer<EventCD>(module, "PooledEventCDBuffer");
+
         class_binding
             .def(
                 "add_event_buffer_callback",
@@ -57,6 +62,70 @@ static HALFacilityPythonBinder<I_EventDecoder<EventCD>> bind_decoder(
                     return self.add_event_buffer_callback(gil_cb);
                 },
                 pybind_doc_hal["Metavision::I_EventDecoder::add_event_buffer_callback"])
+            .def(
+                "set_event_vector_callback",
+                +[](I_EventDecoder<EventCD> &self, py::object object) {
+                    if (object.is_none()) {
+                        self.set_event_vector_callback(nullptr);
+                        return;
+                    }
+                    // The events are decoded directly into buffers of the pool, which are handed to Python without
+                    // copy and go back to the pool once the arrays are collected
+                    auto pool = EventBufferPool<EventCD>::make();
+                    self.set_event_vector_callback(
+                        [pool, object](std::vector<EventCD> &&events) {
+                            py::gil_scoped_acquire acquire;
+                            object(make_pooled_numpy_array(std::move(events), pool));
+                        },
+                        [pool]() { return pool->acquire(); });
+                },
+                py::arg("callback"),
+                "Sets the function taking the ownership of the buffers of decoded events.\n"
+                "\n"
+                "The function is called with numpy arrays of the decoded events, which are not copies: they can be "
+                "kept as long as needed, their memory being reused once they are collected. Pass None to unset it.")
+            .def(
+                "add_event_soa_buffer_callback",
+                +[](I_EventDecoder<EventCD> &self, py::object object) {
+                    return self.add_event_soa_buffer_callback([object](const EventCDBufferSoA &buffer) {
+                        // The buffer of the decoder is reused, the one given to Python is a copy it owns
+                        auto events = std::make_shared<EventCDBufferSoA>(buffer);
+                        py::gil_scoped_acquire acquire;
+                        object(events);
+                    });
+                },
+                py::arg("callback"),
+                "Adds a function called with the decoded events, as an EventCDBufferSoA whose fields can be exported "
+                "without copy through the DLPack protocol.\n"
+                "\n"
+                "Returns the ID of the callback, to be passed to remove_callback.")
+            .def(
+                "add_shared_memory_callback",
+                +[](I_EventDecoder<EventCD> &self, std::shared_ptr<SharedMemoryBufferPool> pool, py::object object) {
+                    return self.add_event_buffer_callback(
+                        [pool, object](EventCDIterator_t begin, EventCDIterator_t end) {
+                            // The events are copied once in the shared memory, from the decoding thread
+                            const auto handles = pool->write_range(begin, end);
+                            if (handles.empty()) {
+                                return;
+                            }
+                            py::gil_scoped_acquire acquire;
+                            py::list py_handles;
+                            for (const auto &handle : handles) {
+                                py_handles.append(py::cast(handle));
+                            }
+                            object(py_handles);
+                        });
+                },
+                py::arg("pool"), py::arg("callback"),
+                "Adds a function called with the handles of the slabs of a SharedMemoryBufferPool the decoded events "
+                "are written to.\n"
+                "\n"
+                "The handles can be sent to worker processes, which map the events with pool.numpy(handle) without "
+                "copy. Each handle carries one reference on its slab, to be released by the process it is given to. "
+                "The events are dropped when no slab is free.\n"
+                "\n"
+                "Returns the ID of the callback, to be passed to remove_callback.")
             .def("remove_callback", &I_EventDecoder<EventCD>::remove_callback,
                  pybind_doc_hal["Metavision::I_EventDecoder::remove_callback"])
             .def(
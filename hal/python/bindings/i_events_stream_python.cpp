@@ -10,6 +10,7 @@
  **********************************************************************************************************************/
 
 #include <pybind11/numpy.h>
+#include <pybind11/stl.h>
 
 #include "hal_python_binder.h"
 #include "metavision/hal/facilities/i_events_stream.h"
@@ -34,6 +35,22 @@ static HALFacilityPythonBinder<I_EventsStream> bind(
     [](auto &module, auto &class_binding) {
         class_binding.def("start", &I_EventsStream::start, pybind_doc_hal["Metavision::I_EventsStream::start"])
             .def("stop", &I_EventsStream::stop, pybind_doc_hal["Metavision::I_EventsStream::stop"])
+            .def("pause", &I_EventsStream::pause, pybind_doc_hal["Metavision::I_EventsStream::pause"])
+            .def("resume", &I_EventsStream::resume, pybind_doc_hal["Metavision::I_EventsStream::resume"])
+            .def("is_paused", &I_EventsStream::is_paused, pybind_doc_hal["Metavision::I_EventsStream::is_paused"])
+            .def("set_lock_free_handoff", &I_EventsStream::set_lock_free_handoff, py::arg("capacity"),
+                 py::arg("spin_count") = 0, pybind_doc_hal["Metavision::I_EventsStream::set_lock_free_handoff"])
+            .def(
+                "set_wakeup_coalescing",
+                +[](I_EventsStream &self, size_t min_bytes, uint32_t max_latency_us, bool merge_buffers) {
+                    I_EventsStream::WakeupCoalescingConfig config;
+                    config.min_bytes     = min_bytes;
+                    config.max_latency   = std::chrono::microseconds(max_latency_us);
+                    config.merge_buffers = merge_buffers;
+                    self.set_wakeup_coalescing(config);
+                },
+                py::arg("min_bytes"), py::arg("max_latency_us") = 10000, py::arg("merge_buffers") = true,
+                pybind_doc_hal["Metavision::I_EventsStream::set_wakeup_coalescing"])
             .def("poll_buffer", &I_EventsStream::poll_buffer, pybind_doc_hal["Metavision::I_EventsStream::poll_buffer"])
             .def("wait_next_buffer", &I_EventsStream::wait_next_buffer,
                  pybind_doc_hal["Metavision::I_EventsStream::wait_next_buffer"])
@@ -41,6 +58,51 @@ static HALFacilityPythonBinder<I_EventsStream> bind(
                  pybind_doc_hal["Metavision::I_EventsStream::get_latest_raw_data"])
             .def("log_raw_data", &I_EventsStream::log_raw_data, py::arg("f"),
                  pybind_doc_hal["Metavision::I_EventsStream::log_raw_data"])
+            .def(
+                "log_raw_data_async",
+                +[](I_EventsStream &self, const std::string &f) { return self.log_raw_data_async(f); }, py::arg("f"),
+                pybind_doc_hal["Metavision::I_EventsStream::log_raw_data_async"])
+            .def(
+                "log_raw_data_rotating",
+                +[](I_EventsStream &self, const std::string &basename, uint64_t max_file_size,
+                    uint32_t max_file_duration_ms) {
+                    RawFileRotationConfig config;
+                    config.basename_             = basename;
+                    config.max_file_size_        = max_file_size;
+                    config.max_file_duration_ms_ = max_file_duration_ms;
+                    return self.log_raw_data_rotating(config);
+                },
+                py::arg("basename"), py::arg("max_file_size") = 0, py::arg("max_file_duration_ms") = 0,
+                pybind_doc_hal["Metavision::I_EventsStream::log_raw_data_rotating"])
+            .def(
+                "log_raw_data_striped",
+                +[](I_EventsStream &self, const std::string &manifest_path, const std::vector<std::string> &directories,
+                    size_t stripe_size) {
+                    StripedRawFileWriterConfig config;
+                    config.directories_ = directories;
+                    config.stripe_size_ = stripe_size;
+                    return self.log_raw_data_striped(manifest_path, config);
+                },
+                py::arg("manifest_path"), py::arg("directories"), py::arg("stripe_size") = 4 * 1024 * 1024,
+                pybind_doc_hal["Metavision::I_EventsStream::log_raw_data_striped"])
+            .def(
+                "log_raw_data_mapped",
+                +[](I_EventsStream &self, const std::string &f, uint64_t capacity) {
+                    MappedFileWriterConfig config;
+                    config.capacity_ = capacity;
+                    return self.log_raw_data_mapped(f, config);
+                },
+                py::arg("f"), py::arg("capacity"), pybind_doc_hal["Metavision::I_EventsStream::log_raw_data_mapped"])
+            .def("get_log_raw_data_dropped_bytes", &I_EventsStream::get_log_raw_data_dropped_bytes,
+                 pybind_doc_hal["Metavision::I_EventsStream::get_log_raw_data_dropped_bytes"])
+            .def("rotate_log_raw_data", &I_EventsStream::rotate_log_raw_data,
+                 pybind_doc_hal["Metavision::I_EventsStream::rotate_log_raw_data"])
+            .def("get_log_raw_data_files", &I_EventsStream::get_log_raw_data_files,
+                 pybind_doc_hal["Metavision::I_EventsStream::get_log_raw_data_files"])
+            .def("get_log_raw_data_queue_depth", &I_EventsStream::get_log_raw_data_queue_depth,
+                 pybind_doc_hal["Metavision::I_EventsStream::get_log_raw_data_queue_depth"])
+            .def("get_log_raw_data_bytes_behind", &I_EventsStream::get_log_raw_data_bytes_behind,
+                 pybind_doc_hal["Metavision::I_EventsStream::get_log_raw_data_bytes_behind"])
             .def("stop_log_raw_data", &I_EventsStream::stop_log_raw_data,
                  pybind_doc_hal["Metavision::I_EventsStream::stop_log_raw_data"])
             .def(
@@ -61,7 +61,15 @@ static HALFacilityPythonBinder<I_HW_Register> bind(
                  pybind_doc_hal["Metavision::I_HW_Register::read_register(const std::string &address)=0"])
             .def("read_register", &read_register_wrapper3, py::arg("address"), py::arg("bitfield"),
                  pybind_doc_hal["Metavision::I_HW_Register::read_register(const std::string &address, const "
-                                "std::string &bitfield)=0"]);
+                                "std::string &bitfield)=0"])
+            .def("write_registers", &I_HW_Register::write_registers, py::arg("writes"),
+                 pybind_doc_hal["Metavision::I_HW_Register::write_registers"])
+            .def("read_registers", &I_HW_Register::read_registers, py::arg("addresses"),
+                 pybind_doc_hal["Metavision::I_HW_Register::read_registers"])
+            .def("write_register_bitfields", &I_HW_Register::write_register_bitfields, py::arg("address"),
+                 py::arg("bitfields"), pybind_doc_hal["Metavision::I_HW_Register::write_register_bitfields"])
+            .def("write_registers_by_name", &I_HW_Register::write_registers_by_name, py::arg("writes"),
+                 pybind_doc_hal["Metavision::I_HW_Register::write_registers_by_name"]);
     },
     "I_HW_Register", pybind_doc_hal["Metavision::I_HW_Register"]);
 
@@ -36,7 +36,9 @@ static HALFacilityPythonBinder<I_LL_Biases> bind(
             .def("set", &I_LL_Biases::set, py::arg("bias_name"), py::arg("bias_value"),
                  pybind_doc_hal["Metavision::I_LL_Biases::set"])
             .def("get", &I_LL_Biases::get, py::arg("bias_name"), pybind_doc_hal["Metavision::I_LL_Biases::get"])
-            .def("get_all_biases", &get_all_biases_wrapper, pybind_doc_hal["Metavision::I_LL_Biases::get_all_biases"]);
+            .def("get_all_biases", &get_all_biases_wrapper, pybind_doc_hal["Metavision::I_LL_Biases::get_all_biases"])
+            .def("set_biases", &I_LL_Biases::set_biases, py::arg("biases"),
+                 pybind_doc_hal["Metavision::I_LL_Biases::set_biases"]);
     },
     "I_LL_Biases", pybind_doc_hal["Metavision::I_LL_Biases"]);
 
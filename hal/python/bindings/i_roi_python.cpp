@@ -64,8 +64,31 @@ void set_ROIs_cols_rows_wrapper(I_ROI &i_roi, py::list &cols_to_enable, py::list
         rows_to_enable_vec.push_back((rows_to_enable[idx]).cast<bool>());
     }
 
+    i_roi.invalidate_ROIs_update();
     i_roi.set_ROIs(cols_to_enable_vec, rows_to_enable_vec, enable);
 }
+
+size_t update_ROIs_wrapper(I_ROI &i_roi, py::list &roi_list) {
+    std::vector<DeviceRoi> roi_vec;
+    const ssize_t n_roi = py::len(roi_list);
+
+    for (ssize_t roi_ind = 0; roi_ind < n_roi; ++roi_ind) {
+        roi_vec.push_back((roi_list[roi_ind]).cast<DeviceRoi>());
+    }
+
+    return i_roi.update_ROIs(roi_vec);
+}
+
+py::dict get_update_statistics_wrapper(I_ROI &i_roi) {
+    const auto &stats = i_roi.get_update_statistics();
+    py::dict dictionary;
+    dictionary["num_updates"]       = stats.num_updates;
+    dictionary["num_words_written"] = stats.num_words_written;
+    dictionary["last_duration_us"]  = stats.last_duration_us;
+    dictionary["max_duration_us"]   = stats.max_duration_us;
+    dictionary["total_duration_us"] = stats.total_duration_us;
+    return dictionary;
+}
 } /* anonymous namespace */
 
 static DeviceFacilityGetter<I_ROI> getter("get_i_roi");
@@ -84,7 +107,13 @@ static HALFacilityPythonBinder<I_ROI> bind(
             .def("set_ROIs", &set_ROIs_cols_rows_wrapper, py::arg("cols_to_enable"), py::arg("rows_to_enable"),
                  py::arg("enable") = true)
             .def("create_ROI", &I_ROI::create_ROI, py::arg("roi"), pybind_doc_hal["Metavision::I_ROI::create_ROI"])
-            .def("create_ROIs", &create_ROIs_wrapper, py::arg("roi_list"));
+            .def("create_ROIs", &create_ROIs_wrapper, py::arg("roi_list"))
+            .def("update_ROIs", &update_ROIs_wrapper, py::arg("roi_list"),
+                 pybind_doc_hal["Metavision::I_ROI::update_ROIs"])
+            .def("invalidate_ROIs_update", &I_ROI::invalidate_ROIs_update,
+                 pybind_doc_hal["Metavision::I_ROI::invalidate_ROIs_update"])
+            .def("get_update_statistics", &get_update_statistics_wrapper,
+                 pybind_doc_hal["Metavision::I_ROI::get_update_statistics"]);
     },
     "I_ROI", pybind_doc_hal["Metavision::I_ROI"]);
 
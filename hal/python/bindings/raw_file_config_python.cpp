@@ -22,10 +22,19 @@ static HALClassPythonBinder<RawFileConfig, PythonBases<DeviceConfig>> bind(
             .def(py::init<const RawFileConfig &>())
             .def_readwrite("n_events_to_read", &RawFileConfig::n_events_to_read_,
                            pybind_doc_hal["Metavision::RawFileConfig::n_events_to_read_"])
+            .def_readwrite("n_us_to_read", &RawFileConfig::n_us_to_read_,
+                           pybind_doc_hal["Metavision::RawFileConfig::n_us_to_read_"])
             .def_readwrite("n_read_buffers", &RawFileConfig::n_read_buffers_,
                            pybind_doc_hal["Metavision::RawFileConfig::n_read_buffers_"])
             .def_readwrite("do_time_shifting", &RawFileConfig::do_time_shifting_,
                            pybind_doc_hal["Metavision::RawFileConfig::do_time_shifting_"])
+            .def_readwrite("use_memory_mapping", &RawFileConfig::use_memory_mapping_,
+                           pybind_doc_hal["Metavision::RawFileConfig::use_memory_mapping_"])
+            .def_readwrite("n_reads_in_flight", &RawFileConfig::n_reads_in_flight_,
+                           pybind_doc_hal["Metavision::RawFileConfig::n_reads_in_flight_"])
+            .def_readwrite("n_decompression_threads", &RawFileConfig::n_decompression_threads_,
+                           pybind_doc_hal["Metavision::RawFileConfig::n_decompression_threads_"])
+            .def_readwrite("loop", &RawFileConfig::loop_, pybind_doc_hal["Metavision::RawFileConfig::loop_"])
             .def(
                 "max_events_per_buffer",
                 +[](RawFileConfig &self) { throw DeprecationWarningException("max_events_per_buffer"); });
@@ -0,0 +1,149 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+
+#include "hal_python_binder.h"
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/hal/utils/shared_memory_buffer_pool.h"
+#include "pb_doc_hal.h"
+
+namespace Metavision {
+
+namespace {
+
+using Handle = SharedMemoryBufferPool::Handle;
+
+std::shared_ptr<SharedMemoryBufferPool> create_helper(const std::string &name, uint32_t n_slabs,
+                                                      uint64_t slab_size) {
+    SharedMemoryBufferPoolConfig config;
+    config.n_slabs_         = n_slabs;
+    config.slab_size_bytes_ = slab_size;
+    return SharedMemoryBufferPool::create(name, config);
+}
+
+// The elements are copied in as many slabs as needed, without splitting an element over two slabs
+py::list write_helper(SharedMemoryBufferPool &pool, const py::array &array) {
+    if (!(array.flags() & py::array::c_style)) {
+        throw std::invalid_argument("The array must be C-contiguous");
+    }
+    const auto *data        = static_cast<const uint8_t *>(array.data());
+    const size_t item_size  = static_cast<size_t>(array.itemsize());
+    const size_t n_per_slab = std::max<size_t>(1, pool.get_slab_size() / item_size);
+    size_t n_remaining      = static_cast<size_t>(array.size());
+
+    py::list handles;
+    while (n_remaining > 0) {
+        const size_t n = std::min(n_remaining, n_per_slab);
+        Handle handle;
+        {
+            py::gil_scoped_release release;
+            handle = pool.write(data, n * item_size);
+        }
+        if (!handle.valid()) {
+            break;
+        }
+        handles.append(py::cast(handle));
+        data += n * item_size;
+        n_remaining -= n;
+    }
+    return handles;
+}
+
+// The array takes over the reference carried by the handle, which is released once the array is collected
+py::array numpy_helper(SharedMemoryBufferPool &pool, const Handle &handle, py::object dtype) {
+    const py::dtype array_dtype = dtype.is_none() ? py::dtype::of<EventCD>() : py::dtype::from_args(dtype);
+    const size_t item_size      = static_cast<size_t>(array_dtype.itemsize());
+    if (handle.size % item_size != 0) {
+        throw std::invalid_argument("The buffer of " + std::to_string(handle.size) +
+                                    " bytes does not hold a whole number of elements of " + std::to_string(item_size) +
+                                    " bytes");
+    }
+    auto *slice = new DataTransfer::BufferSlice(pool.get_slice(handle));
+    py::capsule owner(slice, [](void *ptr) { delete static_cast<DataTransfer::BufferSlice *>(ptr); });
+    return py::array(array_dtype, {static_cast<py::ssize_t>(handle.size / item_size)},
+                     {static_cast<py::ssize_t>(item_size)}, slice->data(), owner);
+}
+
+} // anonymous namespace
+
+static HALClassPythonBinder<Handle> bind_handle(
+    [](auto &module, auto &class_binding) {
+        class_binding.def(py::init<>())
+            .def_readonly("slab", &Handle::slab, "Index of the slab")
+            .def_readonly("generation", &Handle::generation,
+                          "Number of times the slab has been acquired, 0 for an invalid handle")
+            .def_readonly("size", &Handle::size, "Number of bytes of data in the slab")
+            .def("valid", &Handle::valid, "Tells whether the handle refers to a slab")
+            .def(py::pickle(
+                [](const Handle &handle) { return py::make_tuple(handle.slab, handle.generation, handle.size); },
+                [](const py::tuple &state) {
+                    Handle handle;
+                    handle.slab       = state[0].cast<uint32_t>();
+                    handle.generation = state[1].cast<uint32_t>();
+                    handle.size       = state[2].cast<uint64_t>();
+                    return handle;
+                }));
+    },
+    "SharedMemoryBufferHandle",
+    "Reference on a slab of a SharedMemoryBufferPool, to be sent to another process");
+
+static HALClassPythonBinder<SharedMemoryBufferPool, std::shared_ptr<SharedMemoryBufferPool>> bind(
+    [](auto &module, auto &class_binding) {
+        class_binding
+            .def_static("create", &create_helper, py::arg("name"), py::arg("n_slabs") = 64,
+                        py::arg("slab_size") = 4 * 1024 * 1024,
+                        "Creates a pool of buffers in shared memory\n"
+                        "\n"
+                        "   :name: Name of the pool, which must be a valid file name\n"
+                        "   :n_slabs: Number of slabs of the pool\n"
+                        "   :slab_size: Size of a slab in bytes, a multiple of 64")
+            .def_static("open", &SharedMemoryBufferPool::open, py::arg("name"),
+                        pybind_doc_hal["Metavision::SharedMemoryBufferPool::open"])
+            .def("get_name", &SharedMemoryBufferPool::get_name,
+                 pybind_doc_hal["Metavision::SharedMemoryBufferPool::get_name"])
+            .def("get_n_slabs", &SharedMemoryBufferPool::get_n_slabs,
+                 pybind_doc_hal["Metavision::SharedMemoryBufferPool::get_n_slabs"])
+            .def("get_slab_size", &SharedMemoryBufferPool::get_slab_size,
+                 pybind_doc_hal["Metavision::SharedMemoryBufferPool::get_slab_size"])
+            .def("get_n_free_slabs", &SharedMemoryBufferPool::get_n_free_slabs,
+                 pybind_doc_hal["Metavision::SharedMemoryBufferPool::get_n_free_slabs"])
+            .def("get_n_dropped_buffers", &SharedMemoryBufferPool::get_n_dropped_buffers,
+                 pybind_doc_hal["Metavision::SharedMemoryBufferPool::get_n_dropped_buffers"])
+            .def("write", &write_helper, py::arg("array"),
+                 "Copies the elements of a numpy array in as many slabs as needed\n"
+                 "\n"
+                 "   Returns the list of the handles of the slabs, each holding one reference. They can be sent to "
+                 "other processes (they are picklable), which must release them, e.g. by collecting the arrays "
+                 "returned by numpy(). If no slab is free, the remaining elements are dropped.\n"
+                 "\n"
+                 "   :array: C-contiguous numpy array")
+            .def("numpy", &numpy_helper, py::arg("handle"), py::arg("dtype") = py::none(),
+                 "Maps the data of a slab as a numpy array, without copy\n"
+                 "\n"
+                 "   The array takes over the reference carried by the handle, which is released once the array (and "
+                 "all the views on it) are collected.\n"
+                 "\n"
+                 "   :handle: Handle of the slab\n"
+                 "   :dtype: Type of the elements, EventCD if None")
+            .def("add_reference", &SharedMemoryBufferPool::add_reference, py::arg("handle"),
+                 pybind_doc_hal["Metavision::SharedMemoryBufferPool::add_reference"])
+            .def("release", &SharedMemoryBufferPool::release, py::arg("handle"),
+                 pybind_doc_hal["Metavision::SharedMemoryBufferPool::release"]);
+    },
+    "SharedMemoryBufferPool", pybind_doc_hal["Metavision::SharedMemoryBufferPool"]);
+
+} // namespace Metavision
@@ -0,0 +1,195 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_BASE_EVENT_CD_BUFFER_SOA_H
+#define METAVISION_SDK_BASE_EVENT_CD_BUFFER_SOA_H
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+#include "metavision/sdk/base/utils/timestamp.h"
+#include "metavision/sdk/base/events/event_cd.h"
+
+namespace Metavision {
+
+/// @brief Buffer of events stored as a structure of arrays
+///
+/// Only defined for the events for which such a layout is available, see @ref EventCDBufferSoA
+/// @tparam Event Type of the events stored in the buffer
+template<typename Event>
+class EventBufferSoA;
+
+/// @brief Buffer of CD events stored as a structure of arrays
+///
+/// Each field of the events is stored in its own contiguous array, which suits vectorized processing (e.g. filtering,
+/// histograms, upload to a GPU) better than an array of @ref EventCD.
+template<>
+class EventBufferSoA<EventCD> {
+public:
+    /// @brief Type of the events, so that std::back_inserter can be used to fill the buffer
+    using value_type = EventCD;
+
+    /// @brief Gets the number of events in the buffer
+    size_t size() const {
+        return t_.size();
+    }
+
+    /// @brief Returns true if the buffer holds no event
+    bool empty() const {
+        return t_.empty();
+    }
+
+    /// @brief Removes all the events of the buffer
+    void clear() {
+        resize(0);
+    }
+
+    /// @brief Reserves memory for the given number of events
+    /// @param n Number of events
+    void reserve(size_t n) {
+        x_.reserve(n);
+        y_.reserve(n);
+        p_.reserve(n);
+        t_.reserve(n);
+    }
+
+    /// @brief Changes the number of events of the buffer
+    /// @param n Number of events
+    void resize(size_t n) {
+        x_.resize(n);
+        y_.resize(n);
+        p_.resize(n);
+        t_.resize(n);
+    }
+
+    /// @brief Appends an event to the buffer
+    /// @param x Column position of the event
+    /// @param y Line position of the event
+    /// @param p Polarity of the event
+    /// @param t Timestamp of the event
+    void push_back(unsigned short x, unsigned short y, short p, timestamp t) {
+        x_.push_back(x);
+        y_.push_back(y);
+        p_.push_back(p);
+        t_.push_back(t);
+    }
+
+    /// @brief Appends an event to the buffer
+    /// @param ev Event to append
+    void push_back(const EventCD &ev) {
+        push_back(ev.x, ev.y, ev.p, ev.t);
+    }
+
+    /// @brief Appends a range of @ref EventCD to the buffer
+    /// @param first Iterator on the first event to append
+    /// @param last Iterator after the last event to append
+    template<typename InputIt>
+    void append(InputIt first, InputIt last) {
+        const size_t offset = size();
+        resize(offset + std::distance(first, last));
+        for (size_t i = offset; first != last; ++first, ++i) {
+            x_[i] = first->x;
+            y_[i] = first->y;
+            p_[i] = first->p;
+            t_[i] = first->t;
+        }
+    }
+
+    /// @brief Replaces the content of the buffer by a range of @ref EventCD
+    /// @param first Iterator on the first event
+    /// @param last Iterator after the last event
+    template<typename InputIt>
+    void assign(InputIt first, InputIt last) {
+        clear();
+        append(first, last);
+    }
+
+    /// @brief Copies the events of the buffer as @ref EventCD
+    /// @param d_first Beginning of the destination range
+    /// @return Iterator pointing to the last + 1 event added in the output
+    template<typename OutputIt>
+    OutputIt copy_to(OutputIt d_first) const {
+        for (size_t i = 0, n = size(); i < n; ++i, ++d_first) {
+            *d_first = EventCD(x_[i], y_[i], p_[i], t_[i]);
+        }
+        return d_first;
+    }
+
+    /// @brief Gets an event of the buffer
+    /// @param i Index of the event
+    /// @return The i-th event of the buffer
+    EventCD get_event(size_t i) const {
+        return EventCD(x_[i], y_[i], p_[i], t_[i]);
+    }
+
+    /// @brief Exchanges the content of the buffer with another one
+    /// @param other Buffer to exchange the content with
+    void swap(EventBufferSoA &other) {
+        x_.swap(other.x_);
+        y_.swap(other.y_);
+        p_.swap(other.p_);
+        t_.swap(other.t_);
+    }
+
+    /// @brief Gets the array of column positions of the events
+    unsigned short *x() {
+        return x_.data();
+    }
+
+    /// @brief Gets the array of column positions of the events
+    const unsigned short *x() const {
+        return x_.data();
+    }
+
+    /// @brief Gets the array of line positions of the events
+    unsigned short *y() {
+        return y_.data();
+    }
+
+    /// @brief Gets the array of line positions of the events
+    const unsigned short *y() const {
+        return y_.data();
+    }
+
+    /// @brief Gets the array of polarities of the events
+    short *p() {
+        return p_.data();
+    }
+
+    /// @brief Gets the array of polarities of the events
+    const short *p() const {
+        return p_.data();
+    }
+
+    /// @brief Gets the array of timestamps of the events
+    timestamp *t() {
+        return t_.data();
+    }
+
+    /// @brief Gets the array of timestamps of the events
+    const timestamp *t() const {
+        return t_.data();
+    }
+
+private:
+    std::vector<unsigned short> x_;
+    std::vector<unsigned short> y_;
+    std::vector<short> p_;
+    std::vector<timestamp> t_;
+};
+
+/// @brief Alias for buffers of CD events stored as a structure of arrays
+using EventCDBufferSoA = EventBufferSoA<EventCD>;
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_BASE_EVENT_CD_BUFFER_SOA_H
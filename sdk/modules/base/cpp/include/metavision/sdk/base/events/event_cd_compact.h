@@ -0,0 +1,250 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_BASE_EVENT_CD_COMPACT_H
+#define METAVISION_SDK_BASE_EVENT_CD_COMPACT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "metavision/sdk/base/utils/timestamp.h"
+#include "metavision/sdk/base/events/event_cd.h"
+
+namespace Metavision {
+
+/// @brief CD event packed in 8 bytes, half the size of an @ref EventCD
+///
+/// The position and polarity are packed in 32 bits (11 bits for x, 10 bits for y and 1 bit for the polarity), and the
+/// timestamp is stored in 32 bits, relative to the base time of the @ref EventCDCompactBuffer holding the event.
+/// Hence, it can only represent the events of sensors up to 2048x1024 pixels, in buffers spanning less than 71
+/// minutes.
+class EventCDCompact {
+public:
+    static constexpr unsigned int XBits = 11; ///< Number of bits of the column position
+    static constexpr unsigned int YBits = 10; ///< Number of bits of the row position
+
+    static constexpr unsigned short MaxX = (1 << XBits) - 1; ///< Largest column position
+    static constexpr unsigned short MaxY = (1 << YBits) - 1; ///< Largest row position
+
+    /// @brief Default constructor
+    EventCDCompact() = default;
+
+    /// @brief Constructor
+    /// @param x Column position of the event in the sensor, at most @ref MaxX
+    /// @param y Row position of the event in the sensor, at most @ref MaxY
+    /// @param p Polarity of the event, 0 or 1
+    /// @param dt Timestamp of the event relative to the base time of its buffer (in us)
+    EventCDCompact(unsigned short x, unsigned short y, short p, std::uint32_t dt) :
+        dt(dt), xyp_(x | (static_cast<std::uint32_t>(y) << XBits) | (static_cast<std::uint32_t>(p & 1) << YShift)) {}
+
+    /// @brief Gets the column position of the event
+    unsigned short x() const {
+        return static_cast<unsigned short>(xyp_ & MaxX);
+    }
+
+    /// @brief Gets the row position of the event
+    unsigned short y() const {
+        return static_cast<unsigned short>((xyp_ >> XBits) & MaxY);
+    }
+
+    /// @brief Gets the polarity of the event
+    short p() const {
+        return static_cast<short>(xyp_ >> YShift);
+    }
+
+    /// @brief Converts the event to an @ref EventCD
+    /// @param base_time Base time of the buffer holding the event (in us)
+    EventCD to_event_cd(timestamp base_time) const {
+        return EventCD(x(), y(), p(), base_time + dt);
+    }
+
+    /// @brief Timestamp of the event relative to the base time of its buffer (in us)
+    std::uint32_t dt;
+
+private:
+    static constexpr unsigned int YShift = XBits + YBits;
+
+    std::uint32_t xyp_;
+};
+
+static_assert(sizeof(EventCDCompact) == 8, "The compact CD event must be 8 bytes");
+
+/// @brief Buffer of @ref EventCDCompact, with the base time their timestamps are relative to
+///
+/// The buffer is filled with @ref EventCD, which are converted on the fly, and read back as @ref EventCD or directly
+/// as compact events. The base time is the timestamp of the first event added to the empty buffer, unless it is set
+/// with @ref reset.
+class EventCDCompactBuffer {
+public:
+    /// @brief Type of the events, so that std::back_inserter can be used to fill the buffer
+    using value_type = EventCD;
+
+    /// @brief Gets the base time of the events (in us)
+    timestamp base_time() const {
+        return base_time_;
+    }
+
+    /// @brief Gets the number of events in the buffer
+    size_t size() const {
+        return events_.size();
+    }
+
+    /// @brief Returns true if the buffer holds no event
+    bool empty() const {
+        return events_.empty();
+    }
+
+    /// @brief Removes all the events of the buffer, the base time being set by the next event added
+    void clear() {
+        events_.clear();
+        base_time_set_ = false;
+    }
+
+    /// @brief Removes all the events of the buffer and sets the base time of the next ones
+    /// @param base_time Base time of the events (in us)
+    void reset(timestamp base_time) {
+        events_.clear();
+        base_time_     = base_time;
+        base_time_set_ = true;
+    }
+
+    /// @brief Reserves memory for the given number of events
+    /// @param n Number of events
+    void reserve(size_t n) {
+        events_.reserve(n);
+    }
+
+    /// @brief Changes the number of events of the buffer
+    /// @param n Number of events
+    void resize(size_t n) {
+        events_.resize(n);
+    }
+
+    /// @brief Appends an event to the buffer
+    /// @param ev Event to append
+    /// @throw std::invalid_argument if the event can not be represented as an @ref EventCDCompact, the buffer being
+    /// left unchanged
+    void push_back(const EventCD &ev) {
+        const timestamp base_time = base_time_set_ ? base_time_ : ev.t;
+        events_.push_back(compact(ev, base_time));
+        base_time_     = base_time;
+        base_time_set_ = true;
+    }
+
+    /// @brief Appends a range of @ref EventCD to the buffer
+    /// @param first Iterator on the first event to append
+    /// @param last Iterator after the last event to append
+    /// @throw std::invalid_argument if an event can not be represented as an @ref EventCDCompact, the buffer being
+    /// left unchanged
+    template<typename InputIt>
+    void append(InputIt first, InputIt last) {
+        if (first == last) {
+            return;
+        }
+        const timestamp base_time = base_time_set_ ? base_time_ : first->t;
+        const size_t offset       = size();
+        resize(offset + std::distance(first, last));
+        try {
+            for (size_t i = offset; first != last; ++first, ++i) {
+                events_[i] = compact(*first, base_time);
+            }
+        } catch (...) {
+            events_.resize(offset);
+            throw;
+        }
+        base_time_     = base_time;
+        base_time_set_ = true;
+    }
+
+    /// @brief Replaces the content of the buffer by a range of @ref EventCD, the base time being the timestamp of
+    /// the first one
+    /// @param first Iterator on the first event
+    /// @param last Iterator after the last event
+    /// @throw std::invalid_argument if an event can not be represented as an @ref EventCDCompact, the buffer being
+    /// left unchanged
+    template<typename InputIt>
+    void assign(InputIt first, InputIt last) {
+        EventCDCompactBuffer buffer;
+        buffer.append(first, last);
+        swap(buffer);
+    }
+
+    /// @brief Copies the events of the buffer as @ref EventCD
+    /// @param d_first Beginning of the destination range
+    /// @return Iterator pointing to the last + 1 event added in the output
+    template<typename OutputIt>
+    OutputIt copy_to(OutputIt d_first) const {
+        for (const auto &ev : events_) {
+            *d_first = ev.to_event_cd(base_time_);
+            ++d_first;
+        }
+        return d_first;
+    }
+
+    /// @brief Gets an event of the buffer
+    /// @param i Index of the event
+    /// @return The i-th event of the buffer
+    EventCD get_event(size_t i) const {
+        return events_[i].to_event_cd(base_time_);
+    }
+
+    /// @brief Exchanges the content of the buffer with another one
+    /// @param other Buffer to exchange the content with
+    void swap(EventCDCompactBuffer &other) {
+        events_.swap(other.events_);
+        std::swap(base_time_, other.base_time_);
+        std::swap(base_time_set_, other.base_time_set_);
+    }
+
+    /// @brief Gets the array of compact events
+    EventCDCompact *data() {
+        return events_.data();
+    }
+
+    /// @brief Gets the array of compact events
+    const EventCDCompact *data() const {
+        return events_.data();
+    }
+
+    /// @brief Gets an iterator on the first compact event
+    std::vector<EventCDCompact>::const_iterator cbegin() const {
+        return events_.cbegin();
+    }
+
+    /// @brief Gets an iterator after the last compact event
+    std::vector<EventCDCompact>::const_iterator cend() const {
+        return events_.cend();
+    }
+
+private:
+    static EventCDCompact compact(const EventCD &ev, timestamp base_time) {
+        const timestamp dt = ev.t - base_time;
+        if (ev.x > EventCDCompact::MaxX || ev.y > EventCDCompact::MaxY || dt < 0 ||
+            dt > std::numeric_limits<std::uint32_t>::max()) {
+            throw std::invalid_argument("The event can not be stored in a compact buffer: its position is out of the "
+                                        "supported geometry, or its timestamp is too far from the base time.");
+        }
+        return EventCDCompact(ev.x, ev.y, ev.p, static_cast<std::uint32_t>(dt));
+    }
+
+    std::vector<EventCDCompact> events_;
+    timestamp base_time_ = 0;
+    bool base_time_set_  = false;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_BASE_EVENT_CD_COMPACT_H
@@ -0,0 +1,215 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_BASE_TIME_INDEXED_EVENT_BUFFER_H
+#define METAVISION_SDK_BASE_TIME_INDEXED_EVENT_BUFFER_H
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "metavision/sdk/base/utils/timestamp.h"
+
+namespace Metavision {
+
+/// @brief Buffer of events sorted by timestamp, with a sparse index of their timestamps to find time boundaries in
+/// logarithmic time
+///
+/// The timestamp of the first event of each block of @ref get_block_size events is indexed as the events are appended,
+/// so that finding the events of a time window costs a binary search in the index and another one in a single block,
+/// instead of a search in the whole buffer. The index is part of the buffer: it is kept when the buffer is copied,
+/// moved or passed between the stages of a pipeline.
+/// @warning The events must be appended in increasing order of timestamp, as they come from a stream
+/// @tparam Event Type of the events, which must have a timestamp field t
+template<typename Event>
+class TimeIndexedEventBuffer {
+public:
+    /// @brief Type of the events, so that std::back_inserter can be used to fill the buffer
+    using value_type = Event;
+
+    /// @brief Iterator on the events, which can not be modified so that the index stays valid
+    using const_iterator = typename std::vector<Event>::const_iterator;
+
+    /// @brief Default number of events per block of the index
+    static constexpr size_t DefaultBlockSize = 1024;
+
+    /// @brief Constructor
+    /// @param block_size Number of events per block of the index: the memory used by the index is one timestamp per
+    /// block, and searching in a block costs the logarithm of its size
+    /// @throw std::invalid_argument If the block size is 0
+    explicit TimeIndexedEventBuffer(size_t block_size = DefaultBlockSize) : block_size_(block_size) {
+        if (block_size_ == 0) {
+            throw std::invalid_argument("The block size of a time indexed event buffer must be strictly positive");
+        }
+    }
+
+    /// @brief Gets the number of events in the buffer
+    size_t size() const {
+        return events_.size();
+    }
+
+    /// @brief Returns true if the buffer holds no event
+    bool empty() const {
+        return events_.empty();
+    }
+
+    /// @brief Gets the number of events per block of the index
+    size_t get_block_size() const {
+        return block_size_;
+    }
+
+    /// @brief Removes all the events of the buffer
+    void clear() {
+        events_.clear();
+        index_.clear();
+    }
+
+    /// @brief Reserves memory for the given number of events
+    /// @param n Number of events
+    void reserve(size_t n) {
+        events_.reserve(n);
+        index_.reserve((n + block_size_ - 1) / block_size_);
+    }
+
+    /// @brief Appends an event to the buffer
+    /// @param ev Event to append, whose timestamp is not lower than the ones of the events of the buffer
+    void push_back(const Event &ev) {
+        if (events_.size() % block_size_ == 0) {
+            index_.push_back(ev.t);
+        }
+        events_.push_back(ev);
+    }
+
+    /// @brief Appends a range of events to the buffer
+    /// @param first Iterator on the first event to append
+    /// @param last Iterator after the last event to append
+    template<typename InputIt>
+    void append(InputIt first, InputIt last) {
+        events_.insert(events_.end(), first, last);
+        update_index();
+    }
+
+    /// @brief Replaces the content of the buffer by a range of events
+    /// @param first Iterator on the first event
+    /// @param last Iterator after the last event
+    template<typename InputIt>
+    void assign(InputIt first, InputIt last) {
+        clear();
+        append(first, last);
+    }
+
+    /// @brief Gets an iterator on the first event
+    const_iterator begin() const {
+        return events_.cbegin();
+    }
+
+    /// @brief Gets an iterator after the last event
+    const_iterator end() const {
+        return events_.cend();
+    }
+
+    /// @brief Gets a pointer to the array of events
+    const Event *data() const {
+        return events_.data();
+    }
+
+    /// @brief Gets an event of the buffer
+    /// @param i Index of the event
+    const Event &operator[](size_t i) const {
+        return events_[i];
+    }
+
+    /// @brief Gets the first event with a timestamp greater than or equal to a timestamp
+    /// @param t Timestamp to search
+    /// @return Iterator on the event, or @ref end if there is none
+    const_iterator lower_bound(timestamp t) const {
+        const size_t block = std::distance(index_.begin(), std::lower_bound(index_.begin(), index_.end(), t));
+        return search_before_block(block, [t](const Event &ev) { return ev.t < t; });
+    }
+
+    /// @brief Gets the first event with a timestamp strictly greater than a timestamp
+    /// @param t Timestamp to search
+    /// @return Iterator on the event, or @ref end if there is none
+    const_iterator upper_bound(timestamp t) const {
+        const size_t block = std::distance(index_.begin(), std::upper_bound(index_.begin(), index_.end(), t));
+        return search_before_block(block, [t](const Event &ev) { return ev.t <= t; });
+    }
+
+    /// @brief Gets the events of a time window
+    /// @param t_begin Beginning of the time window, included
+    /// @param t_end End of the time window, excluded
+    /// @return Iterators on the first event of the window and after its last one
+    std::pair<const_iterator, const_iterator> get_time_window(timestamp t_begin, timestamp t_end) const {
+        const const_iterator first = lower_bound(t_begin);
+        return {first, t_end <= t_begin ? first : lower_bound(t_end)};
+    }
+
+    /// @brief Splits the buffer at a timestamp
+    /// @param t Timestamp of the split
+    /// @return Buffer with the events whose timestamp is greater than or equal to @p t, which are removed from this
+    /// buffer. The returned buffer is indexed with the same block size
+    TimeIndexedEventBuffer split(timestamp t) {
+        const size_t first = std::distance(begin(), lower_bound(t));
+        TimeIndexedEventBuffer tail(block_size_);
+        tail.append(events_.cbegin() + first, events_.cend());
+        events_.resize(first);
+        index_.resize((first + block_size_ - 1) / block_size_);
+        return tail;
+    }
+
+    /// @brief Removes the events with a timestamp strictly lower than a timestamp, as when sliding a time window
+    /// @param t Timestamp of the first events to keep
+    void erase_before(timestamp t) {
+        events_.erase(events_.cbegin(), lower_bound(t));
+        // The blocks start at other events, the index is built again
+        index_.clear();
+        update_index();
+    }
+
+    /// @brief Exchanges the content of the buffer, and its index, with another one
+    /// @param other Buffer to exchange the content with
+    void swap(TimeIndexedEventBuffer &other) {
+        std::swap(block_size_, other.block_size_);
+        events_.swap(other.events_);
+        index_.swap(other.index_);
+    }
+
+private:
+    // Indexes the blocks started by the events appended since the last update
+    void update_index() {
+        for (size_t i = index_.size() * block_size_; i < events_.size(); i += block_size_) {
+            index_.push_back(events_[i].t);
+        }
+    }
+
+    // Searches the first event not verifying is_before, knowing that it is either in the block preceding the given
+    // one or the first event of the latter
+    template<typename IsBefore>
+    const_iterator search_before_block(size_t block, IsBefore is_before) const {
+        if (block == 0) {
+            return begin();
+        }
+        const const_iterator block_begin = begin() + (block - 1) * block_size_;
+        const const_iterator block_end   = begin() + std::min(block * block_size_, events_.size());
+        return std::partition_point(block_begin, block_end, is_before);
+    }
+
+    size_t block_size_;
+    std::vector<Event> events_;
+    std::vector<timestamp> index_; // Timestamp of the first event of each block
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_BASE_TIME_INDEXED_EVENT_BUFFER_H
@@ -0,0 +1,127 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_BASE_CALLBACK_LIST_H
+#define METAVISION_SDK_BASE_CALLBACK_LIST_H
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Metavision {
+
+/// @brief List of callbacks identified by an id, dispatched without taking any lock
+///
+/// The callbacks are stored contiguously in an immutable snapshot. Adding or removing a callback copies the snapshot,
+/// modifies the copy and publishes it atomically (copy-on-write), so that a thread dispatching concurrently keeps
+/// calling the callbacks of the snapshot it has loaded, which stays alive until the dispatch is over. Only the threads
+/// modifying the list synchronize with each other.
+///
+/// @tparam Callback Type of the callbacks, e.g. a std::function
+template<typename Callback>
+class CallbackList {
+public:
+    /// @brief Type of the array of callbacks seen by a dispatch
+    using Callbacks = std::vector<Callback>;
+
+    CallbackList() : snapshot_(std::make_shared<const Snapshot>()) {}
+
+    CallbackList(const CallbackList &) = delete;
+    CallbackList &operator=(const CallbackList &) = delete;
+
+    /// @brief Adds a callback at the end of the list
+    /// @param id Id of the callback, used to remove it
+    /// @param cb Callback to add
+    void add(size_t id, const Callback &cb) {
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        auto snapshot = std::make_shared<Snapshot>(*load());
+        snapshot->ids.push_back(id);
+        snapshot->callbacks.push_back(cb);
+        store(std::move(snapshot));
+    }
+
+    /// @brief Removes a callback
+    /// @param id Id of the callback to remove
+    /// @return true if the callback was found and removed, false otherwise
+    bool remove(size_t id) {
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        const auto current = load();
+        const auto it      = std::find(current->ids.cbegin(), current->ids.cend(), id);
+        if (it == current->ids.cend()) {
+            return false;
+        }
+        const auto index = std::distance(current->ids.cbegin(), it);
+        auto snapshot    = std::make_shared<Snapshot>(*current);
+        snapshot->ids.erase(snapshot->ids.begin() + index);
+        snapshot->callbacks.erase(snapshot->callbacks.begin() + index);
+        store(std::move(snapshot));
+        return true;
+    }
+
+    /// @brief Removes all the callbacks
+    void clear() {
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        store(std::make_shared<Snapshot>());
+    }
+
+    /// @brief Gets the callbacks of the list at the time of the call
+    ///
+    /// The returned array is never modified, and keeps the callbacks alive even if they are removed from the list.
+    std::shared_ptr<const Callbacks> get() const {
+        auto snapshot = load();
+        return std::shared_ptr<const Callbacks>(snapshot, &snapshot->callbacks);
+    }
+
+    /// @brief Gets the number of callbacks in the list
+    size_t size() const {
+        return load()->callbacks.size();
+    }
+
+    /// @brief Checks whether the list has no callback
+    bool empty() const {
+        return size() == 0;
+    }
+
+    /// @brief Calls all the callbacks of the list, in the order they have been added
+    /// @param args Arguments passed to each callback
+    template<typename... Args>
+    void operator()(Args &&...args) const {
+        const auto snapshot       = load();
+        const Callback *callbacks = snapshot->callbacks.data();
+        const size_t n            = snapshot->callbacks.size();
+        for (size_t i = 0; i < n; ++i) {
+            callbacks[i](args...);
+        }
+    }
+
+private:
+    struct Snapshot {
+        std::vector<size_t> ids; ///< Ids of the callbacks, in the same order
+        Callbacks callbacks;     ///< Callbacks, stored contiguously for the dispatch
+    };
+
+    std::shared_ptr<const Snapshot> load() const {
+        return std::atomic_load_explicit(&snapshot_, std::memory_order_acquire);
+    }
+
+    void store(std::shared_ptr<const Snapshot> snapshot) {
+        std::atomic_store_explicit(&snapshot_, std::move(snapshot), std::memory_order_release);
+    }
+
+    std::shared_ptr<const Snapshot> snapshot_; ///< Current snapshot, only accessed atomically
+    std::mutex write_mutex_;                   ///< Serializes the modifications of the list
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_BASE_CALLBACK_LIST_H
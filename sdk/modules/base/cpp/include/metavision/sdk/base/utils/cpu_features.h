@@ -0,0 +1,115 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_BASE_CPU_FEATURES_H
+#define METAVISION_SDK_BASE_CPU_FEATURES_H
+
+#include <initializer_list>
+
+/// @brief Name of the namespace in which the SIMD variant of a kernel compiled in the current translation unit lives
+///
+/// Translation units listed in the @c add_simd_variants CMake function are compiled once per enabled SIMD level, with
+/// this macro defined as @c avx2, @c avx512 or @c neon. Otherwise, it is @c scalar.
+#ifndef MV_SIMD_VARIANT
+#define MV_SIMD_VARIANT scalar
+#endif
+
+namespace Metavision {
+
+/// @brief Instruction sets a kernel can be compiled for, from the least to the most capable one on a given architecture
+enum class SimdLevel {
+    /// Portable code, possibly auto-vectorized for the baseline instruction set of the build
+    Scalar,
+    /// SSE2, baseline of x86-64
+    SSE2,
+    /// AVX2 with FMA and BMI2 (x86-64-v3)
+    AVX2,
+    /// AVX-512 F, BW and VL (x86-64-v4)
+    AVX512,
+    /// Advanced SIMD (NEON) of ARM
+    NEON
+};
+
+/// @brief Features of the CPU the program runs on, that are also supported by the operating system
+struct CpuFeatures {
+    bool sse2_     = false;
+    bool sse4_1_   = false;
+    bool avx_      = false;
+    bool avx2_     = false;
+    bool fma_      = false;
+    bool bmi2_     = false;
+    bool avx512f_  = false;
+    bool avx512bw_ = false;
+    bool avx512vl_ = false;
+    bool neon_     = false;
+};
+
+/// @brief Gets the features of the CPU the program runs on
+///
+/// The features are detected once (with CPUID on x86, with the hardware capabilities on ARM).
+/// @return The features of the CPU
+const CpuFeatures &get_cpu_features();
+
+/// @brief Gets the most capable SIMD level supported by the CPU the program runs on
+///
+/// The level can be lowered with the environment variable MV_SIMD_LEVEL (SCALAR, SSE2, AVX2, AVX512 or NEON), e.g. to
+/// compare the results or the performances of the variants of a kernel.
+/// @return The most capable SIMD level usable
+SimdLevel get_simd_level();
+
+/// @brief Tells whether kernels compiled for a SIMD level can run on the CPU the program runs on
+/// @param level The SIMD level to check
+/// @return true if the level is supported by the CPU and not disabled by the environment variable MV_SIMD_LEVEL
+bool is_simd_level_supported(SimdLevel level);
+
+/// @brief Gets the name of a SIMD level
+/// @param level The SIMD level
+/// @return The name of the level, as used in the environment variable MV_SIMD_LEVEL
+const char *to_string(SimdLevel level);
+
+/// @brief Variant of a kernel compiled for a SIMD level
+/// @tparam Function Type of the kernel (e.g. a pointer to function)
+template<typename Function>
+struct SimdVariant {
+    SimdLevel level_;
+    Function function_;
+};
+
+/// @brief Selects the variant of a kernel best suited to the CPU the program runs on
+///
+/// The selection is meant to be done once, e.g. when initializing a function-scope static variable:
+/// @code
+/// static const auto sum = Metavision::select_simd_variant(&simd::scalar::sum, {
+/// #ifdef METAVISION_SIMD_AVX2
+///     {Metavision::SimdLevel::AVX2, &simd::avx2::sum},
+/// #endif
+/// });
+/// @endcode
+/// @tparam Function Type of the kernel (e.g. a pointer to function)
+/// @param fallback Kernel used when no variant is supported
+/// @param variants Variants of the kernel, in any order
+/// @return The variant of the most capable SIMD level supported, or @p fallback if none is
+template<typename Function>
+Function select_simd_variant(Function fallback, std::initializer_list<SimdVariant<Function>> variants) {
+    Function selected        = fallback;
+    SimdLevel selected_level = SimdLevel::Scalar;
+    for (const auto &variant : variants) {
+        if (variant.level_ > selected_level && is_simd_level_supported(variant.level_)) {
+            selected       = variant.function_;
+            selected_level = variant.level_;
+        }
+    }
+    return selected;
+}
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_BASE_CPU_FEATURES_H
@@ -184,9 +184,12 @@ std::string getLogPrefixFormatString(const std::string &prefixFmt, const std::st
     return s;
 }
 
+struct LogMessage;
+
 class concurrent_ostreambuf : public std::streambuf {
 public:
     concurrent_ostreambuf(std::streambuf *buf);
+    ~concurrent_ostreambuf() override;
 
     bool get_output_sentinel() const;
     void reset_output_sentinel();
@@ -197,9 +200,12 @@ protected:
     int sync() override;
 
 private:
+    std::vector<char> &bytes();
+
     std::vector<char> bytes_;
     std::streambuf *buf_;
     bool has_output_;
+    LogMessage *message_ = nullptr; // Message being built when the logging is asynchronous
 };
 } // namespace detail
 
@@ -0,0 +1,63 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_BASE_DLPACK_H
+#define METAVISION_SDK_BASE_DLPACK_H
+
+#include <cstdint>
+
+namespace Metavision {
+namespace DLPack {
+
+// Types of the DLPack ABI (v0.8), declared here to not depend on dlpack.h. They have the same layout as the ones of
+// dlpack.h, so that the tensors can be consumed by any framework supporting DLPack (PyTorch, CuPy, JAX...).
+
+/// @brief Type of the device holding the data of a tensor
+enum DeviceType : int32_t { CPU = 1, CUDA = 2, CUDAHost = 3 };
+
+/// @brief Kind of the values of a tensor
+enum DataTypeCode : uint8_t { Int = 0, UInt = 1, Float = 2, Bool = 6 };
+
+/// @brief Device holding the data of a tensor
+struct Device {
+    int32_t device_type; ///< One of @ref DeviceType
+    int32_t device_id;   ///< Index of the device
+};
+
+/// @brief Type of the values of a tensor
+struct DataType {
+    uint8_t code;   ///< One of @ref DataTypeCode
+    uint8_t bits;   ///< Number of bits of a value
+    uint16_t lanes; ///< Number of values per element, 1 for scalars
+};
+
+/// @brief Tensor, not owning its data
+struct Tensor {
+    void *data;           ///< Address of the data, on the device
+    Device device;        ///< Device holding the data
+    int32_t ndim;         ///< Number of dimensions
+    DataType dtype;       ///< Type of the values
+    int64_t *shape;       ///< Dimensions of the tensor
+    int64_t *strides;     ///< Strides of the dimensions, in number of values, or nullptr if compact and row-major
+    uint64_t byte_offset; ///< Offset of the first value from @p data, in bytes
+};
+
+/// @brief Tensor owned by its producer, released by its consumer with @p deleter
+struct ManagedTensor {
+    Tensor dl_tensor;                     ///< Tensor
+    void *manager_ctx;                    ///< Context of the producer
+    void (*deleter)(ManagedTensor *self); ///< Function releasing the tensor, called by the consumer
+};
+
+} // namespace DLPack
+} // namespace Metavision
+
+#endif // METAVISION_SDK_BASE_DLPACK_H
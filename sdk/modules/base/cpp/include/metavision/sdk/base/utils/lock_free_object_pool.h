@@ -0,0 +1,352 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_BASE_LOCK_FREE_OBJECT_POOL_H
+#define METAVISION_SDK_BASE_LOCK_FREE_OBJECT_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+
+namespace Metavision {
+
+/// @brief Class that creates a reusable pool of heap allocated objects, without locking on acquisition and release
+///
+/// This pool has the same interface and the same bounded/unbounded semantics as @ref ObjectPool, but the available
+/// objects are kept in a lock-free stack instead of a stack protected by a mutex, so that threads sharing a pool
+/// (e.g. the decoding threads of several cameras) don't contend on a lock for every buffer.
+/// When a bounded pool is empty, @ref acquire spins briefly waiting for an object to be released and only then blocks.
+///
+/// @tparam T the type of object stored
+/// @tparam acquire_shared_ptr if true, the object are wrapped by a @a std::shared_ptr, otherwise
+/// a std::unique_ptr is returned instead
+template<class T, bool acquire_shared_ptr = false>
+class LockFreeObjectPool {
+private:
+    struct Impl;
+    struct Deleter {
+        Deleter(std::weak_ptr<Impl> pool, std::uint32_t node_index) : pool_(pool), node_index_(node_index) {}
+        void operator()(T *ptr) {
+            if (auto pool_ptr = pool_.lock())
+                pool_ptr->release(node_index_, ptr);
+            else
+                std::default_delete<T>{}(ptr);
+        }
+
+    private:
+        std::weak_ptr<Impl> pool_;
+        std::uint32_t node_index_;
+    };
+
+public:
+    using ptr_type =
+        typename std::conditional<acquire_shared_ptr, std::shared_ptr<T>, std::unique_ptr<T, Deleter>>::type;
+
+    /// @brief Creates an object pool with limited number of objects that can be allocated
+    ///
+    /// There won't be memory allocation upon call to @ref acquire if all objects in the memory pool are already
+    /// used.
+    /// @param num_initial_objects Number of objects initially allocated in the pool
+    /// @return An object pool with bounded memory
+    static LockFreeObjectPool<T, acquire_shared_ptr> make_bounded(size_t num_initial_objects = 64) {
+        return LockFreeObjectPool(num_initial_objects, true);
+    }
+
+    /// @brief Creates an object pool with limited number of objects that can be allocated
+    ///
+    /// There won't be memory allocation upon call to @ref acquire if all objects in the memory pool are already
+    /// used.
+    /// @param num_initial_objects Number of objects initially allocated in the pool
+    /// @param args The arguments forwarded to the object constructor during allocation
+    /// @return An object pool with bounded memory
+    template<typename... Args>
+    static LockFreeObjectPool<T, acquire_shared_ptr> make_bounded(size_t num_initial_objects, Args &&...args) {
+        return LockFreeObjectPool(num_initial_objects, true, std::forward<Args>(args)...);
+    }
+
+    /// @brief Creates an object pool with expendable memory usage
+    ///
+    /// A pool with unbounded memory will allocate a new object when all objects in the pool are already used
+    /// and @ref acquire is called.
+    /// @param num_initial_objects Number of objects initially allocated in the pool
+    /// @return An object pool with unbounded memory
+    static LockFreeObjectPool<T, acquire_shared_ptr> make_unbounded(size_t num_initial_objects = 64) {
+        return LockFreeObjectPool(num_initial_objects, false);
+    }
+
+    /// @brief Creates an object pool with expendable memory usage
+    ///
+    /// A pool with unbounded memory will allocate a new object when all objects in the pool are already used
+    /// and @ref acquire is called.
+    /// @param num_initial_objects Number of objects initially allocated in the pool
+    /// @param args The arguments forwarded to the object constructor during allocation
+    /// @return An object pool with unbounded memory
+    template<typename... Args>
+    static LockFreeObjectPool<T, acquire_shared_ptr> make_unbounded(size_t num_initial_objects, Args &&...args) {
+        return LockFreeObjectPool(num_initial_objects, false, std::forward<Args>(args)...);
+    }
+
+    /// @brief Default constructor that builds an unbounded object pool with an initial number of objects
+    /// allocated
+    /// @ref make_unbounded
+    LockFreeObjectPool() : LockFreeObjectPool(64, false) {
+        static_assert(std::is_default_constructible<T>::value, "Using LockFreeObjectPool default constructor: object "
+                                                               "must be default constructible. Otherwise, use static "
+                                                               "build method.");
+    }
+
+    /// @brief Adds an object to the pool
+    /// @param t A unique_ptr storing the object
+    void add(std::unique_ptr<T> t) {
+        impl_->add(std::move(t));
+    }
+
+    /// @brief Allocates or re-use a previously allocated object
+    /// @param args Optional arguments to be passed when allocating the object
+    /// @return A unique or shared pointer to the allocated object
+    template<typename... Args>
+    ptr_type acquire(Args &&...args) {
+        return impl_->acquire(std::forward<Args>(args)...);
+    }
+
+    /// @brief Sets a function called on each object allocated by the pool from now on
+    ///
+    /// Unbounded pools allocate objects when they are empty, the function can be used to prepare them as the initial
+    /// ones (e.g. see @ref place_pool_buffers). The objects already allocated are not affected.
+    /// @param initializer Function called with the objects allocated, or an empty function to stop calling it
+    /// @warning Unlike the other methods, this one must not be called concurrently with @ref acquire
+    void set_initializer(std::function<void(T &)> initializer) {
+        impl_->initializer_ = std::move(initializer);
+    }
+
+    /// @brief Checks if the pool is empty
+    /// @return true if the pool is empty, false if the pool contains object ready to be re-used
+    bool empty() const {
+        return impl_->size() == 0;
+    }
+
+    /// @brief Gets the number of objects in the pool
+    /// @return The number of previously allocated and ready to-reuse objects in the pool
+    size_t size() const {
+        return impl_->size();
+    }
+
+    /// @brief Checks the memory pool type i.e. bounded or unbounded
+    /// @return true if the memory pool is bounded, false if it is unbounded
+    bool is_bounded() const {
+        return impl_->is_bounded();
+    }
+
+private:
+    /// @brief Constructor
+    template<typename... Args>
+    LockFreeObjectPool(size_t num_initial_objects, bool bounded_memory, Args &&...args) :
+        impl_(std::make_shared<Impl>(num_initial_objects, bounded_memory, std::forward<Args>(args)...)) {}
+
+    /// @brief Implementation of the object pool in a separate object
+    ///
+    /// The objects are held by nodes that are never freed before the pool, and the available nodes form a Treiber
+    /// stack. The head of the stack packs the index of the top node with a counter incremented on each modification,
+    /// so that a node popped and pushed back between the read of the head and its update is detected (ABA problem).
+    struct Impl : public std::enable_shared_from_this<Impl> {
+        struct Node {
+            std::unique_ptr<T> object;
+            std::atomic<std::uint32_t> next{NullIndex};
+        };
+
+        static constexpr std::uint32_t NullIndex    = 0xFFFFFFFF;
+        static constexpr size_t FirstSegmentSize    = 64;
+        static constexpr size_t NumSegments         = 26;
+        static constexpr int NumSpinsBeforeBlocking = 128;
+
+        /// @brief Constructor
+        template<typename... Args>
+        Impl(size_t num_initial_objects, bool bounded_memory, Args &&...args) : bounded_memory_(bounded_memory) {
+            if (num_initial_objects == 0) {
+                throw std::invalid_argument(
+                    "Failed to allocate memory for the bounded object pool: pool's size can not be 0.");
+            }
+            for (auto &segment : segments_) {
+                segment = nullptr;
+            }
+            for (size_t i = 0; i < num_initial_objects; ++i) {
+                add(std::unique_ptr<T>(new T(std::forward<Args>(args)...)));
+            }
+        }
+
+        ~Impl() {
+            for (size_t k = 0; k < NumSegments; ++k) {
+                delete[] segments_[k].load(std::memory_order_relaxed);
+            }
+        }
+
+        /// @brief Adds an object to the pool
+        /// @param t A unique_ptr storing the object
+        void add(std::unique_ptr<T> t) {
+            const std::uint32_t index = allocate_node();
+            node(index).object        = std::move(t);
+            push(index);
+        }
+
+        /// @brief Puts back in the pool an object acquired from it
+        /// @param index Index of the node holding the object
+        /// @param ptr The object
+        void release(std::uint32_t index, T *ptr) {
+            node(index).object.reset(ptr);
+            push(index);
+        }
+
+        /// @brief Allocates or re-use a previously allocated object
+        /// @param args Optional arguments to be passed when allocating the object
+        /// @return A unique or shared pointer to the allocated object
+        template<typename... Args>
+        ptr_type acquire(Args &&...args) {
+            std::uint32_t index;
+            if (!pop(index)) {
+                if (bounded_memory_) {
+                    index = wait_for_object();
+                } else {
+                    index              = allocate_node();
+                    node(index).object = std::unique_ptr<T>(new T(std::forward<Args>(args)...));
+                    if (initializer_) {
+                        initializer_(*node(index).object);
+                    }
+                }
+            }
+            return ptr_type(node(index).object.release(), Deleter{this->shared_from_this(), index});
+        }
+
+        /// @brief Gets the number of objects in the pool
+        /// @return The number of previously allocated and ready to-reuse objects in the pool
+        size_t size() const {
+            const auto size = size_.load(std::memory_order_relaxed);
+            return size > 0 ? static_cast<size_t>(size) : 0;
+        }
+
+        /// @brief Checks the memory pool type i.e. bounded or unbounded
+        /// @return true if the memory pool is bounded, false if it is unbounded
+        bool is_bounded() const {
+            return bounded_memory_;
+        }
+
+        std::function<void(T &)> initializer_; // Set before the pool is used, see @ref set_initializer
+
+    private:
+        static std::uint64_t make_head(std::uint64_t head, std::uint32_t index) {
+            return (((head >> 32) + 1) << 32) | index;
+        }
+
+        Node &node(std::uint32_t index) {
+            // segment k holds FirstSegmentSize << k nodes, starting at index FirstSegmentSize * (2^k - 1)
+            size_t k = 0;
+            for (size_t q = index / FirstSegmentSize + 1; q > 1; q >>= 1) {
+                ++k;
+            }
+            return segments_[k].load(std::memory_order_acquire)[index - FirstSegmentSize * ((size_t(1) << k) - 1)];
+        }
+
+        std::uint32_t allocate_node() {
+            const size_t index = num_nodes_.fetch_add(1, std::memory_order_relaxed);
+            size_t k           = 0;
+            for (size_t q = index / FirstSegmentSize + 1; q > 1; q >>= 1) {
+                ++k;
+            }
+            if (k >= NumSegments) {
+                throw std::length_error("Failed to allocate memory for the object pool: too many objects.");
+            }
+            if (!segments_[k].load(std::memory_order_acquire)) {
+                Node *segment  = new Node[FirstSegmentSize << k];
+                Node *expected = nullptr;
+                if (!segments_[k].compare_exchange_strong(expected, segment, std::memory_order_acq_rel)) {
+                    delete[] segment;
+                }
+            }
+            return static_cast<std::uint32_t>(index);
+        }
+
+        void push(std::uint32_t index) {
+            Node &n            = node(index);
+            std::uint64_t head = head_.load(std::memory_order_relaxed);
+            do {
+                n.next.store(static_cast<std::uint32_t>(head), std::memory_order_relaxed);
+            } while (!head_.compare_exchange_weak(head, make_head(head, index), std::memory_order_seq_cst,
+                                                  std::memory_order_relaxed));
+            size_.fetch_add(1, std::memory_order_relaxed);
+
+            // the head update and this load being sequentially consistent, as the waiter's increment and its read of
+            // the head, either the waiter sees the object or the waiter is seen here
+            if (num_waiters_.load() > 0) {
+                // the lock makes sure a waiter can't miss the object between its check and its wait
+                std::lock_guard<std::mutex> lock(mutex_);
+                cond_.notify_one();
+            }
+        }
+
+        bool pop(std::uint32_t &index) {
+            std::uint64_t head = head_.load();
+            while (static_cast<std::uint32_t>(head) != NullIndex) {
+                const std::uint32_t top  = static_cast<std::uint32_t>(head);
+                const std::uint32_t next = node(top).next.load(std::memory_order_relaxed);
+                if (head_.compare_exchange_weak(head, make_head(head, next), std::memory_order_acquire,
+                                                std::memory_order_acquire)) {
+                    size_.fetch_sub(1, std::memory_order_relaxed);
+                    index = top;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        std::uint32_t wait_for_object() {
+            std::uint32_t index;
+            for (int i = 0; i < NumSpinsBeforeBlocking; ++i) {
+                std::this_thread::yield();
+                if (pop(index)) {
+                    return index;
+                }
+            }
+
+            ++num_waiters_;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cond_.wait(lock, [this, &index] { return pop(index); });
+            }
+            --num_waiters_;
+            return index;
+        }
+
+        std::atomic<std::uint64_t> head_{NullIndex};
+        std::atomic<std::int64_t> size_{0};
+        std::atomic<size_t> num_nodes_{0};
+        std::atomic<Node *> segments_[NumSegments];
+        std::atomic<int> num_waiters_{0};
+        std::mutex mutex_;
+        std::condition_variable cond_;
+        bool bounded_memory_{false};
+    };
+
+    std::shared_ptr<Impl> impl_;
+};
+
+/// @brief Convenience alias to use a @ref LockFreeObjectPool returning shared pointers
+/// @tparam T the type of object stored in the pool
+template<typename T>
+using SharedLockFreeObjectPool = LockFreeObjectPool<T, true>;
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_BASE_LOCK_FREE_OBJECT_POOL_H
@@ -126,6 +126,32 @@ void setLogStream(std::ostream &stream);
 /// @sa @ref getLogLevel and @ref setLogLevel
 void resetLogStreamFromEnv();
 
+/// @brief Enables or disables the asynchronous logging
+///
+/// When enabled, the logging operations do not write their messages to the logging stream themselves: the messages
+/// are built in buffers reused by each thread, queued without lock, and written by a background thread. This makes
+/// verbose logging much cheaper for the threads logging, at the cost of a delay before the messages are written.
+/// @param enabled If true, the messages are written asynchronously
+/// @note By default, the logging is synchronous
+/// @note It is also possible to enable the asynchronous logging by setting the environment variable MV_LOG_ASYNC
+/// to 1 (or to disable it with 0). If the environment variable is set, it will have precedence over the value set by
+/// this function. It is only read once, unless you explicitly call @ref resetLogAsyncFromEnv
+/// @note The streams the messages are written to must outlive the messages queued for them, see @ref flushLog
+void setLogAsync(bool enabled);
+
+/// @brief Checks whether the logging is asynchronous
+/// @return true if the messages are written asynchronously
+/// @sa @ref setLogAsync
+bool isLogAsync();
+
+/// @brief Resets the asynchronous logging value read from the environment variable MV_LOG_ASYNC
+/// @sa @ref isLogAsync and @ref setLogAsync
+void resetLogAsyncFromEnv();
+
+/// @brief Waits until all the messages logged asynchronously before the call have been written to their stream
+/// @note It is called by @ref setLogStream and @ref resetLogStreamFromEnv before changing the logging stream
+void flushLog();
+
 // Forward declaration
 namespace detail {
 class concurrent_ostreambuf;
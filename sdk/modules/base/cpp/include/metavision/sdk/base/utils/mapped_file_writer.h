@@ -0,0 +1,144 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_BASE_MAPPED_FILE_WRITER_H
+#define METAVISION_SDK_BASE_MAPPED_FILE_WRITER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace Metavision {
+
+/// @brief Configuration of a @ref MappedFileWriter
+struct MappedFileWriterConfig {
+    /// @brief Policy of synchronization of the mapped data with the disk
+    enum class FlushPolicy {
+        /// The data is written back by the system when it sees fit, it is only guaranteed to be on disk if the system
+        /// does not crash
+        None,
+        /// The data is synchronized with the disk when the file is closed
+        OnClose,
+        /// The write back of the data is started by a background thread each time @ref flush_size_ bytes have been
+        /// written, so that the dirty pages do not pile up in memory, and the data is synchronized when the file is
+        /// closed
+        Background
+    };
+
+    /// Size in bytes preallocated on disk and mapped. Data written beyond it is dropped
+    uint64_t capacity_ = 0;
+
+    /// Synchronization of the data with the disk
+    FlushPolicy flush_policy_ = FlushPolicy::Background;
+
+    /// Number of bytes written between two write backs started by the background thread, when @ref flush_policy_ is
+    /// @ref FlushPolicy::Background
+    size_t flush_size_ = 16 * 1024 * 1024;
+};
+
+/// @brief Writes a file through a memory mapping of its preallocated space
+///
+/// The whole capacity of the file is allocated on disk when it is opened, so that it is not fragmented by a long
+/// recording, and mapped in memory. The data is then copied straight into the mapping: there is neither buffering
+/// layer nor system call per write, the pages being written back by the system or by a background thread, depending on
+/// @ref MappedFileWriterConfig::flush_policy_. When closed, the file is truncated to the size of the data written.
+///
+/// This suits recordings whose maximum size is known in advance, e.g. from their maximum duration and data rate. Once
+/// the capacity is reached, the data written is dropped and counted (see @ref get_n_dropped_bytes).
+///
+/// @ref write, @ref get_write_pointer and @ref commit must be called from a single thread.
+class MappedFileWriter {
+public:
+    /// @brief Creates the file, preallocates and maps its capacity
+    /// @param filename Path of the file to write, truncated if it exists
+    /// @param config Configuration of the writer
+    /// @throw std::invalid_argument if the capacity is null
+    /// @throw std::runtime_error if the file can not be created, its space allocated or mapped
+    MappedFileWriter(const std::string &filename, const MappedFileWriterConfig &config);
+
+    /// @brief Closes the file, see @ref close
+    ~MappedFileWriter();
+
+    MappedFileWriter(const MappedFileWriter &) = delete;
+    MappedFileWriter &operator=(const MappedFileWriter &) = delete;
+
+    /// @brief Copies data at the end of the file
+    /// @param data Data to write
+    /// @param size Size in bytes of the data
+    /// @return false if the data does not fit in the remaining capacity, in which case it is dropped
+    bool write(const void *data, size_t size);
+
+    /// @brief Gets the mapped memory where the next bytes of the file are to be written
+    ///
+    /// This allows writing the data directly in the file, e.g. when encoding it, the data being appended to the file
+    /// by @ref commit.
+    /// @param size Number of bytes to be written
+    /// @return A pointer to @p size bytes of the mapping, or nullptr if they do not fit in the remaining capacity
+    uint8_t *get_write_pointer(size_t size);
+
+    /// @brief Appends to the file the bytes written at the pointer returned by the last call to @ref get_write_pointer
+    /// @param size Number of bytes written, at most the size requested from @ref get_write_pointer
+    void commit(size_t size);
+
+    /// @brief Counts bytes as dropped, e.g. when @ref get_write_pointer returned nullptr
+    void drop(size_t size);
+
+    /// @brief Stops the background thread, synchronizes the data according to the flush policy, unmaps the file and
+    /// truncates it to the size of the data written
+    ///
+    /// Does nothing if the file is already closed.
+    void close();
+
+    /// @brief Gets the path of the file
+    const std::string &get_filename() const;
+
+    /// @brief Gets the size in bytes of the data written so far
+    uint64_t get_size() const;
+
+    /// @brief Gets the capacity of the file, in bytes
+    uint64_t get_capacity() const;
+
+    /// @brief Gets the number of bytes dropped because the capacity of the file was reached
+    uint64_t get_n_dropped_bytes() const;
+
+private:
+    void run_flusher();
+    void flush(uint64_t begin, uint64_t end, bool wait);
+
+    std::string filename_;
+    MappedFileWriterConfig config_;
+    uint8_t *mapping_{nullptr};
+#ifdef _WIN32
+    void *file_{nullptr};
+    void *file_mapping_{nullptr};
+#else
+    int fd_{-1};
+#endif
+
+    std::atomic<uint64_t> size_{0};
+    std::atomic<uint64_t> n_dropped_bytes_{0};
+
+    // Background write back, started each time flush_size_ bytes have been committed since the last one
+    std::atomic<uint64_t> next_flush_size_{0};
+    uint64_t flushed_size_{0}; // used by the flusher thread only
+    bool stop_{false};
+    std::mutex flush_mutex_;
+    std::condition_variable flush_cond_;
+    std::thread flusher_;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_BASE_MAPPED_FILE_WRITER_H
@@ -0,0 +1,90 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_BASE_MEMORY_PLACEMENT_H
+#define METAVISION_SDK_BASE_MEMORY_PLACEMENT_H
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace Metavision {
+
+/// @brief Describes where the memory of a buffer should be physically allocated
+struct MemoryPlacement {
+    /// NUMA node the memory must be allocated from, or -1 to keep the default policy of the system
+    int numa_node = -1;
+
+    /// If true, the memory is backed by 2 MB (transparent) huge pages where possible, to reduce the TLB pressure
+    bool huge_pages = false;
+};
+
+/// @brief Returns the NUMA node of the CPU the calling thread is running on
+///
+/// This can be used to place the buffers of a pool on the node of the thread consuming them.
+/// @return The NUMA node, or -1 if it can't be determined on this system
+int get_current_numa_node();
+
+/// @brief Applies a placement to a memory area
+///
+/// The policy applies to the pages of the area that are not yet allocated, and those already allocated are moved
+/// if possible. Only the pages fully included in the area are affected, and only the huge pages fully included in
+/// the area can be used.
+/// @param data Beginning of the memory area
+/// @param size_bytes Size of the memory area in bytes
+/// @param placement The placement to apply
+/// @return true if the placement was applied, false if it is not supported on this system or it failed (the memory
+/// is then left as is, which is always safe)
+bool place_memory(void *data, size_t size_bytes, const MemoryPlacement &placement);
+
+/// @brief Reserves the memory of a buffer and applies a placement to it
+///
+/// As long as the buffer does not grow beyond @p capacity, it keeps this memory.
+/// @param buffer The buffer to place
+/// @param capacity Number of elements to reserve in the buffer
+/// @param placement The placement to apply
+/// @return true if the placement was applied, false otherwise
+template<typename T, typename Allocator>
+bool place_buffer(std::vector<T, Allocator> &buffer, size_t capacity, const MemoryPlacement &placement) {
+    buffer.reserve(capacity);
+    return place_memory(buffer.data(), buffer.capacity() * sizeof(T), placement);
+}
+
+/// @brief Reserves the memory of all the buffers available in a pool and applies a placement to them
+///
+/// This works with any pool of @a std::vector buffers (e.g. @ref DataTransfer::BufferPool or
+/// @ref BaseStage::EventBufferPool) and must be called before the pool is used, typically right after its creation
+/// from the thread that will consume its buffers. The buffers allocated later by an unbounded pool are placed as well
+/// (see @ref ObjectPool::set_initializer).
+/// @param pool The pool ( @ref ObjectPool or @ref LockFreeObjectPool) whose buffers are placed
+/// @param capacity Number of elements to reserve in each buffer
+/// @param placement The placement to apply
+/// @return true if the placement was applied to all the buffers, false otherwise
+template<typename Pool>
+bool place_pool_buffers(Pool &pool, size_t capacity, const MemoryPlacement &placement) {
+    std::vector<typename Pool::ptr_type> buffers;
+    for (size_t i = 0, size = pool.size(); i < size; ++i) {
+        buffers.emplace_back(pool.acquire());
+    }
+
+    bool placed = true;
+    for (auto &buffer : buffers) {
+        placed = place_buffer(*buffer, capacity, placement) && placed;
+    }
+
+    using Buffer = typename std::decay<decltype(*buffers.front())>::type;
+    pool.set_initializer([capacity, placement](Buffer &buffer) { place_buffer(buffer, capacity, placement); });
+    return placed;
+}
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_BASE_MEMORY_PLACEMENT_H
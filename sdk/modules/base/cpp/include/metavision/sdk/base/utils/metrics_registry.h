@@ -0,0 +1,118 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_BASE_METRICS_REGISTRY_H
+#define METAVISION_SDK_BASE_METRICS_REGISTRY_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace Metavision {
+
+/// @brief Value of a metric at a given time
+struct MetricSample {
+    /// @brief Kind of a metric
+    enum class Type {
+        Counter, ///< Value only increasing, e.g. a number of events
+        Gauge    ///< Value going up and down, e.g. the size of a queue
+    };
+
+    /// Name of the metric, following the Prometheus naming conventions (e.g. metavision_camera_events_total)
+    std::string name_;
+
+    /// Description of the metric
+    std::string help_;
+
+    /// Kind of the metric
+    Type type_ = Type::Gauge;
+
+    /// Labels distinguishing the samples of the same metric, e.g. the name of the camera and the type of events
+    std::vector<std::pair<std::string, std::string>> labels_;
+
+    /// Value of the metric
+    double value_ = 0.;
+
+    /// Increase per second of a counter since the previous report, only computed by
+    /// @ref MetricsRegistry::start_reporting
+    double rate_ = 0.;
+};
+
+/// @brief Formats samples in the Prometheus text exposition format
+/// @param samples Samples to format, e.g. returned by @ref MetricsRegistry::snapshot
+/// @return The samples, one per line, those of the same metric being grouped under a single description
+std::string to_prometheus_text(const std::vector<MetricSample> &samples);
+
+/// @brief Global registry of the metrics of the SDK
+///
+/// The components of the SDK (e.g. cameras, pipelines, telemetry samplers) register themselves on demand with a
+/// collector reading their counters, which are updated without lock by the threads processing the data. The collectors
+/// are only called when the metrics are read, either as snapshots or periodically by a thread of the registry that
+/// passes them to a sink (e.g. to serve them to Prometheus with @ref to_prometheus_text). The occupancy of the pools of
+/// the @ref PoolRegistry is included in the metrics.
+class MetricsRegistry {
+public:
+    /// @brief Function appending the current samples of a component
+    using Collector = std::function<void(std::vector<MetricSample> &)>;
+
+    /// @brief Function called with the samples of all the components, see @ref start_reporting
+    using Sink = std::function<void(const std::vector<MetricSample> &)>;
+
+    /// @brief Returns the global registry
+    static MetricsRegistry &instance();
+
+    /// @brief Registers a collector
+    /// @param collector Function appending the samples of a component, called from any thread until it is removed
+    /// @return Id of the collector in the registry, to remove it
+    size_t add(Collector collector);
+
+    /// @brief Removes a collector from the registry
+    /// @param id Id returned when the collector was added
+    void remove(size_t id);
+
+    /// @brief Returns the samples of all the registered collectors, in the order in which they were added, followed
+    /// by the occupancy of the registered pools
+    std::vector<MetricSample> snapshot() const;
+
+    /// @brief Passes the samples of all the registered collectors to a sink periodically, from a thread of the
+    /// registry
+    ///
+    /// The rate of each counter since the previous report is computed, see @ref MetricSample::rate_
+    /// @param period Period of the reports
+    /// @param sink Function called with the samples
+    void start_reporting(std::chrono::milliseconds period, Sink sink);
+
+    /// @brief Stops the periodic reports
+    void stop_reporting();
+
+private:
+    MetricsRegistry() = default;
+
+    mutable std::mutex mutex_;
+    std::map<size_t, Collector> collectors_;
+    size_t next_id_ = 0;
+
+    std::mutex reporting_mutex_;
+    std::condition_variable reporting_cond_;
+    std::thread reporting_thread_;
+    bool reporting_ = false;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_BASE_METRICS_REGISTRY_H
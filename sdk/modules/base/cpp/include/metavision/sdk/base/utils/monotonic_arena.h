@@ -0,0 +1,204 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_BASE_MONOTONIC_ARENA_H
+#define METAVISION_SDK_BASE_MONOTONIC_ARENA_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace Metavision {
+
+/// @brief Memory arena whose allocations are only released all at once, when it is reset
+///
+/// The arena is meant for the temporaries of a processing repeated at buffer rate (e.g. the intermediate vectors of an
+/// algorithm for a slice of events): allocating is only bumping an offset in a block of memory, deallocating does
+/// nothing, and all the allocations are released by @ref reset at the end of the processing.
+///
+/// The blocks are allocated on demand, each one twice as large as the previous one. When more than one block was used
+/// before a reset, they are replaced by a single block of their total size, so that after a few processings the
+/// arena makes no more allocations from the general-purpose allocator.
+///
+/// Copying an arena copies its settings only, not its memory. The arena is not thread safe.
+class MonotonicArena {
+public:
+    /// @brief Constructor
+    ///
+    /// No memory is allocated until the first allocation from the arena.
+    /// @param initial_block_size Size of the first block of memory allocated, in bytes
+    explicit MonotonicArena(size_t initial_block_size = 64 * 1024) :
+        initial_block_size_(initial_block_size > 0 ? initial_block_size : 1) {}
+
+    MonotonicArena(const MonotonicArena &other) : MonotonicArena(other.initial_block_size_) {}
+    MonotonicArena(MonotonicArena &&)            = default;
+    MonotonicArena &operator=(MonotonicArena &&) = default;
+
+    /// @brief Keeps the memory of the arena, the allocations made from it remaining valid
+    MonotonicArena &operator=(const MonotonicArena &) {
+        return *this;
+    }
+
+    /// @brief Allocates memory from the arena
+    /// @param bytes Size of the memory to allocate, in bytes
+    /// @param alignment Alignment of the memory, a power of 2
+    /// @return Pointer to the memory, valid until the next call to @ref reset or the destruction of the arena
+    void *allocate(size_t bytes, size_t alignment = alignof(std::max_align_t)) {
+        if (current_ < blocks_.size()) {
+            if (void *ptr = allocate_in(blocks_[current_], bytes, alignment)) {
+                return ptr;
+            }
+            // the next block, kept from before a reset, may be large enough
+            if (current_ + 1 < blocks_.size()) {
+                if (void *ptr = allocate_in(blocks_[current_ + 1], bytes, alignment)) {
+                    ++current_;
+                    return ptr;
+                }
+            }
+        }
+
+        size_t size = blocks_.empty() ? initial_block_size_ : 2 * blocks_[current_].size;
+        if (bytes > std::numeric_limits<size_t>::max() - alignment) {
+            throw std::bad_alloc();
+        }
+        size = std::max(size, bytes + alignment);
+        if (!blocks_.empty()) {
+            ++current_;
+        }
+        blocks_.insert(blocks_.begin() + current_, Block(size));
+        ++num_block_allocations_;
+        return allocate_in(blocks_[current_], bytes, alignment);
+    }
+
+    /// @brief Deallocates memory allocated from the arena, which does nothing until the arena is reset
+    void deallocate(void *, size_t) noexcept {}
+
+    /// @brief Releases all the allocations made from the arena
+    ///
+    /// The memory of the arena is kept for the next allocations.
+    void reset() {
+        if (blocks_.size() > 1) {
+            const size_t size = capacity();
+            blocks_.clear();
+            blocks_.emplace_back(size);
+            ++num_block_allocations_;
+        }
+        for (auto &block : blocks_) {
+            block.used = 0;
+        }
+        current_ = 0;
+    }
+
+    /// @brief Gets the number of bytes allocated from the arena since the last reset, including the alignment padding
+    size_t used_bytes() const {
+        size_t used = 0;
+        for (const auto &block : blocks_) {
+            used += block.used;
+        }
+        return used;
+    }
+
+    /// @brief Gets the total size of the blocks of memory of the arena, in bytes
+    size_t capacity() const {
+        size_t size = 0;
+        for (const auto &block : blocks_) {
+            size += block.size;
+        }
+        return size;
+    }
+
+    /// @brief Gets the number of blocks of memory allocated by the arena since its construction
+    size_t num_block_allocations() const {
+        return num_block_allocations_;
+    }
+
+private:
+    struct Block {
+        explicit Block(size_t size) : data(new unsigned char[size]), size(size) {}
+
+        std::unique_ptr<unsigned char[]> data;
+        size_t size;
+        size_t used = 0;
+    };
+
+    static void *allocate_in(Block &block, size_t bytes, size_t alignment) {
+        const auto address = reinterpret_cast<std::uintptr_t>(block.data.get()) + block.used;
+        const size_t padding = static_cast<size_t>((alignment - address % alignment) % alignment);
+        if (padding > block.size - block.used || bytes > block.size - block.used - padding) {
+            return nullptr;
+        }
+        block.used += padding + bytes;
+        return reinterpret_cast<void *>(address + padding);
+    }
+
+    size_t initial_block_size_;
+    std::vector<Block> blocks_;
+    size_t current_               = 0;
+    size_t num_block_allocations_ = 0;
+};
+
+/// @brief Standard allocator allocating from a @ref MonotonicArena, to use the arena with the standard containers
+///
+/// The memory of the containers using it must not be used after the arena is reset.
+/// @tparam T Type of the objects allocated
+template<typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+
+    /// @brief Constructor
+    /// @param arena Arena from which the memory is allocated, which must outlive the allocator
+    ArenaAllocator(MonotonicArena &arena) noexcept : arena_(&arena) {}
+
+    template<typename U>
+    ArenaAllocator(const ArenaAllocator<U> &other) noexcept : arena_(other.arena()) {}
+
+    T *allocate(size_t n) {
+        if (n > std::numeric_limits<size_t>::max() / sizeof(T)) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T *>(arena_->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T *ptr, size_t n) noexcept {
+        arena_->deallocate(ptr, n * sizeof(T));
+    }
+
+    /// @brief Gets the arena from which the memory is allocated
+    MonotonicArena *arena() const noexcept {
+        return arena_;
+    }
+
+private:
+    MonotonicArena *arena_;
+};
+
+template<typename T, typename U>
+bool operator==(const ArenaAllocator<T> &lhs, const ArenaAllocator<U> &rhs) noexcept {
+    return lhs.arena() == rhs.arena();
+}
+
+template<typename T, typename U>
+bool operator!=(const ArenaAllocator<T> &lhs, const ArenaAllocator<U> &rhs) noexcept {
+    return !(lhs == rhs);
+}
+
+/// @brief Vector allocating its memory from a @ref MonotonicArena
+template<typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_BASE_MONOTONIC_ARENA_H
@@ -12,13 +12,18 @@
 #ifndef METAVISION_SDK_BASE_OBJECT_POOL_H
 #define METAVISION_SDK_BASE_OBJECT_POOL_H
 
+#include <algorithm>
 #include <condition_variable>
+#include <functional>
 #include <stack>
 #include <memory>
 #include <mutex>
+#include <string>
 #include <type_traits>
 #include <exception>
 
+#include "metavision/sdk/base/utils/pool_registry.h"
+
 namespace Metavision {
 
 /// @brief Class that creates a reusable pool of heap allocated objects
@@ -42,7 +47,7 @@ private:
         void operator()(T *ptr) {
             if (auto pool_ptr = pool_.lock())
                 try {
-                    pool_ptr->add(std::unique_ptr<T>{ptr});
+                    pool_ptr->release(std::unique_ptr<T>{ptr});
                 } catch (...) {
                     // Out of memory. Free some
                     std::default_delete<T>{}(ptr);
@@ -127,6 +132,15 @@ public:
         return impl_->acquire(std::forward<Args>(args)...);
     }
 
+    /// @brief Sets a function called on each object allocated by the pool from now on
+    ///
+    /// Unbounded pools allocate objects when they are empty, the function can be used to prepare them as the initial
+    /// ones (e.g. see @ref place_pool_buffers). The objects already allocated are not affected.
+    /// @param initializer Function called with the objects allocated, or an empty function to stop calling it
+    void set_initializer(std::function<void(T &)> initializer) {
+        impl_->set_initializer(std::move(initializer));
+    }
+
     /// @brief Checks if the pool is empty
     /// @return true if the pool is empty, false if the pool contains object ready to be re-used
     bool empty() const {
@@ -145,6 +159,31 @@ public:
         return impl_->is_bounded();
     }
 
+    /// @brief Gets the occupancy of the pool
+    /// @return The statistics of the pool since its creation
+    PoolStatistics get_statistics() const {
+        return impl_->get_statistics();
+    }
+
+    /// @brief Frees the objects of the pool that are not in use, to give their memory back
+    ///
+    /// The objects in use are not affected, they are given back to the pool when released. Bounded pools are not
+    /// shrunk, as their objects are all the ones they can hand out.
+    /// @param num_kept Number of objects not in use kept in the pool
+    /// @return The number of freed objects
+    size_t shrink(size_t num_kept = 0) {
+        return impl_->shrink(num_kept);
+    }
+
+    /// @brief Registers the pool in the global @ref PoolRegistry, until it is destroyed
+    ///
+    /// The pool is shared by its copies, it is removed from the registry once all of them are destroyed. Registering
+    /// the pool again replaces its name. The registry may shrink the pool (see @ref PoolRegistry::shrink).
+    /// @param name Name of the pool in the registry
+    void register_statistics(const std::string &name) {
+        impl_->register_statistics(name);
+    }
+
 private:
     /// @brief Constructor
     template<typename... Args>
@@ -165,6 +204,14 @@ private:
             for (size_t i = 0; i < num_initial_objects; ++i) {
                 pool_.push(std::unique_ptr<T>(new T(std::forward<Args>(args)...)));
             }
+            allocated_ = num_initial_objects;
+        }
+
+        /// @brief Destructor, removes the pool from the registry
+        ~Impl() {
+            if (registered_) {
+                PoolRegistry::instance().remove(registry_id_);
+            }
         }
 
         /// @brief Adds an object to the pool
@@ -172,6 +219,24 @@ private:
         void add(std::unique_ptr<T> t) {
             std::lock_guard<std::mutex> lock(mutex_);
             pool_.push(std::move(t));
+            ++allocated_;
+            if (bounded_memory_) {
+                cond_.notify_all();
+            }
+        }
+
+        /// @brief Gives back to the pool an object previously acquired
+        /// @param t A unique_ptr storing the object
+        void release(std::unique_ptr<T> t) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            --in_use_;
+            try {
+                pool_.push(std::move(t));
+            } catch (...) {
+                // the object is freed by the caller
+                --allocated_;
+                throw;
+            }
             if (bounded_memory_) {
                 cond_.notify_all();
             }
@@ -185,16 +250,77 @@ private:
             std::unique_lock<std::mutex> lock(mutex_);
             if (pool_.empty()) {
                 if (bounded_memory_) {
+                    ++waits_;
                     cond_.wait(lock, [this] { return !pool_.empty(); });
                 } else {
-                    pool_.push(std::unique_ptr<T>(new T(std::forward<Args>(args)...)));
+                    std::unique_ptr<T> t(new T(std::forward<Args>(args)...));
+                    if (initializer_) {
+                        initializer_(*t);
+                    }
+                    pool_.push(std::move(t));
+                    ++allocated_;
                 }
             }
             ptr_type tmp(pool_.top().release(), Deleter{this->shared_from_this()});
             pool_.pop();
+            peak_in_use_ = std::max(peak_in_use_, ++in_use_);
             return tmp;
         }
 
+        /// @brief Sets the function called on the objects allocated
+        void set_initializer(std::function<void(T &)> initializer) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            initializer_ = std::move(initializer);
+        }
+
+        /// @brief Gets the occupancy of the pool
+        PoolStatistics get_statistics() const {
+            std::lock_guard<std::mutex> lock(mutex_);
+            PoolStatistics statistics;
+            statistics.allocated_   = allocated_;
+            statistics.in_use_      = in_use_;
+            statistics.peak_in_use_ = peak_in_use_;
+            statistics.waits_       = waits_;
+            statistics.bounded_     = bounded_memory_;
+            return statistics;
+        }
+
+        /// @brief Frees the objects not in use beyond a given number
+        size_t shrink(size_t num_kept) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (bounded_memory_) {
+                return 0;
+            }
+            size_t num_freed = 0;
+            for (; pool_.size() > num_kept; ++num_freed) {
+                pool_.pop();
+                --allocated_;
+            }
+            return num_freed;
+        }
+
+        /// @brief Registers the pool in the global registry
+        void register_statistics(const std::string &name) {
+            // the registry does not keep the pool alive
+            std::weak_ptr<Impl> weak_impl = this->shared_from_this();
+            auto getter                   = [weak_impl] {
+                const auto impl = weak_impl.lock();
+                return impl ? impl->get_statistics() : PoolStatistics();
+            };
+            auto shrinker = [weak_impl] {
+                const auto impl = weak_impl.lock();
+                return impl ? impl->shrink(0) : 0;
+            };
+            const size_t id = PoolRegistry::instance().add(name, getter, shrinker);
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (registered_) {
+                PoolRegistry::instance().remove(registry_id_);
+            }
+            registry_id_ = id;
+            registered_  = true;
+        }
+
         /// @brief Checks if the pool is empty
         /// @return true if the pool is empty, false if the pool contains an object ready to be re-used
         bool empty() const {
@@ -219,6 +345,15 @@ private:
         mutable std::condition_variable cond_;
         std::stack<std::unique_ptr<T>> pool_;
         bool bounded_memory_{false};
+        std::function<void(T &)> initializer_;
+
+        // Statistics
+        size_t allocated_{0};
+        size_t in_use_{0};
+        size_t peak_in_use_{0};
+        size_t waits_{0};
+        size_t registry_id_{0};
+        bool registered_{false};
     };
 
     std::shared_ptr<Impl> impl_;
@@ -0,0 +1,122 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_BASE_POOL_REGISTRY_H
+#define METAVISION_SDK_BASE_POOL_REGISTRY_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Metavision {
+
+/// @brief Occupancy of a pool of objects
+struct PoolStatistics {
+    /// Number of objects allocated by the pool, in use or not
+    size_t allocated_ = 0;
+
+    /// Number of objects acquired and not released yet
+    size_t in_use_ = 0;
+
+    /// Maximum number of objects in use at once
+    size_t peak_in_use_ = 0;
+
+    /// Number of acquisitions that had to wait for an object to be released, for bounded pools
+    size_t waits_ = 0;
+
+    /// Whether the pool is bounded
+    bool bounded_ = false;
+};
+
+/// @brief Writes the statistics of a pool in a stream, on a single line
+std::ostream &operator<<(std::ostream &os, const PoolStatistics &statistics);
+
+/// @brief Global registry of the pools whose occupancy is monitored
+///
+/// The pools of the SDK register themselves with a name describing their use (e.g. the buffers of a
+/// @ref DataTransfer), so that the memory they hold can be monitored at run time, either by taking snapshots of their
+/// statistics or by logging them periodically. The starvation of bounded pools shows as an increasing number of waits,
+/// the growth of unbounded ones as an increasing number of allocated objects.
+class PoolRegistry {
+public:
+    /// @brief Function returning the current statistics of a pool
+    using StatisticsGetter = std::function<PoolStatistics()>;
+
+    /// @brief Function freeing the objects of a pool that are not in use, returning the number of freed objects
+    using Shrinker = std::function<size_t()>;
+
+    /// @brief Statistics of a registered pool
+    struct Entry {
+        /// Name of the pool, several pools may have the same name
+        std::string name_;
+
+        /// Statistics of the pool when the snapshot was taken
+        PoolStatistics statistics_;
+    };
+
+    /// @brief Returns the global registry
+    static PoolRegistry &instance();
+
+    /// @brief Registers a pool
+    /// @param name Name of the pool
+    /// @param getter Function returning the statistics of the pool, called from any thread until the pool is removed
+    /// @param shrinker Function freeing the objects of the pool not in use, called from any thread until the pool is
+    /// removed. If empty, the pool is not shrunk by @ref shrink
+    /// @return Id of the pool in the registry, to remove it
+    size_t add(const std::string &name, StatisticsGetter getter, Shrinker shrinker = Shrinker());
+
+    /// @brief Removes a pool from the registry
+    /// @param id Id returned when the pool was added
+    void remove(size_t id);
+
+    /// @brief Returns the statistics of all the registered pools, in the order in which they were added
+    std::vector<Entry> snapshot() const;
+
+    /// @brief Frees the objects not in use of all the registered pools that can be shrunk, e.g. under memory pressure
+    /// @return The number of freed objects
+    size_t shrink();
+
+    /// @brief Logs the statistics of all the registered pools periodically, from a thread of the registry
+    /// @param period Period of the logging
+    void start_logging(std::chrono::milliseconds period);
+
+    /// @brief Stops the periodic logging
+    void stop_logging();
+
+private:
+    PoolRegistry() = default;
+
+    struct Pool {
+        std::string name;
+        StatisticsGetter getter;
+        Shrinker shrinker;
+    };
+
+    mutable std::mutex mutex_;
+    std::map<size_t, Pool> pools_;
+    size_t next_id_ = 0;
+
+    std::mutex logging_mutex_;
+    std::condition_variable logging_cond_;
+    std::thread logging_thread_;
+    bool logging_ = false;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_BASE_POOL_REGISTRY_H
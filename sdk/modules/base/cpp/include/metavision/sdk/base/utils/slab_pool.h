@@ -0,0 +1,278 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_BASE_SLAB_POOL_H
+#define METAVISION_SDK_BASE_SLAB_POOL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace Metavision {
+
+/// @brief Fixed-capacity chunk of contiguous objects, allocated by a @ref SlabPool
+///
+/// The memory of a chunk starts on a cache line and is never reallocated: a chunk is filled up to its capacity, and
+/// the objects that don't fit go to another chunk (see @ref ChunkedBuffer).
+template<typename T>
+class SlabChunk {
+public:
+    /// @brief Constructor
+    /// @param data Memory of the chunk, which is not owned by the chunk
+    /// @param capacity Number of objects the memory can hold
+    SlabChunk(T *data, size_t capacity) : data_(data), capacity_(capacity) {}
+
+    SlabChunk(const SlabChunk &) = delete;
+    SlabChunk &operator=(const SlabChunk &) = delete;
+
+    T *data() {
+        return data_;
+    }
+    const T *data() const {
+        return data_;
+    }
+    T *begin() {
+        return data_;
+    }
+    const T *begin() const {
+        return data_;
+    }
+    T *end() {
+        return data_ + size_;
+    }
+    const T *end() const {
+        return data_ + size_;
+    }
+    size_t size() const {
+        return size_;
+    }
+    size_t capacity() const {
+        return capacity_;
+    }
+    bool empty() const {
+        return size_ == 0;
+    }
+    bool full() const {
+        return size_ == capacity_;
+    }
+
+    /// @brief Appends as many objects of a range as the chunk can hold
+    /// @return Iterator to the first object of the range that was not appended
+    template<typename InputIt>
+    InputIt append(InputIt first, InputIt last) {
+        for (; first != last && size_ < capacity_; ++first, ++size_) {
+            data_[size_] = *first;
+        }
+        return first;
+    }
+
+    /// @brief Empties the chunk, keeping its memory
+    void clear() {
+        size_ = 0;
+    }
+
+private:
+    T *data_;
+    size_t size_ = 0;
+    size_t capacity_;
+};
+
+/// @brief Pool of fixed-capacity chunks of objects, allocated by slabs of several chunks
+///
+/// Contrary to a pool of vectors (@ref ObjectPool), whose buffers grow when they receive more objects than they were
+/// reserved for and keep the grown memory afterwards, all the chunks of a slab pool have the same capacity and large
+/// amounts of objects are stored in several chunks. The memory used by the pool is hence that of its peak number of
+/// chunks, whatever the sizes of the buffers built from them.
+///
+/// A slab is a single allocation holding several chunks, each of them starting on its own cache line so that threads
+/// filling or reading different chunks don't share lines. New slabs are allocated when all the chunks are used, and
+/// the memory is only freed when the pool is destroyed.
+///
+/// The chunks can be acquired and released from any thread.
+/// @tparam T Type of the objects, which must be trivially copyable (e.g. an event)
+template<typename T>
+class SlabPool {
+public:
+    static_assert(std::is_trivially_copyable<T>::value, "The objects of a SlabPool must be trivially copyable.");
+
+    using Chunk = SlabChunk<T>;
+
+    /// Size of a cache line, to which the chunks are aligned
+    static constexpr size_t cache_line_size = 64;
+
+    static_assert(alignof(T) <= cache_line_size, "The objects of a SlabPool can't be aligned on more than a line.");
+
+    /// @brief Creates a pool
+    /// @param chunk_capacity Number of objects in each chunk
+    /// @param chunks_per_slab Number of chunks allocated at once when the pool needs more
+    /// @throw std::invalid_argument If one of the parameters is 0
+    static std::shared_ptr<SlabPool<T>> make(size_t chunk_capacity = 4096, size_t chunks_per_slab = 16) {
+        return std::shared_ptr<SlabPool<T>>(new SlabPool<T>(chunk_capacity, chunks_per_slab));
+    }
+
+    SlabPool(const SlabPool &) = delete;
+    SlabPool &operator=(const SlabPool &) = delete;
+
+    /// @brief Gets an empty chunk, allocating a new slab if all the chunks are used
+    Chunk *acquire() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (free_chunks_.empty()) {
+            allocate_slab();
+        }
+        Chunk *chunk = free_chunks_.back();
+        free_chunks_.pop_back();
+        return chunk;
+    }
+
+    /// @brief Gives back a chunk acquired from this pool
+    void release(Chunk *chunk) {
+        chunk->clear();
+        std::lock_guard<std::mutex> lock(mutex_);
+        free_chunks_.push_back(chunk);
+    }
+
+    /// @brief Gets the number of objects in each chunk
+    size_t chunk_capacity() const {
+        return chunk_capacity_;
+    }
+
+    /// @brief Gets the number of chunks allocated by the pool, used or not
+    size_t num_chunks() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return chunks_.size();
+    }
+
+    /// @brief Gets the number of chunks ready to be acquired without allocation
+    size_t num_free_chunks() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return free_chunks_.size();
+    }
+
+private:
+    SlabPool(size_t chunk_capacity, size_t chunks_per_slab) :
+        chunk_capacity_(chunk_capacity),
+        chunk_stride_((chunk_capacity * sizeof(T) + cache_line_size - 1) / cache_line_size * cache_line_size),
+        chunks_per_slab_(chunks_per_slab) {
+        if (chunk_capacity == 0 || chunks_per_slab == 0) {
+            throw std::invalid_argument("The chunks and slabs of a SlabPool can not be empty.");
+        }
+    }
+
+    void allocate_slab() {
+        // The allocation is padded to align the first chunk, the next ones being aligned by the stride
+        slabs_.emplace_back(new unsigned char[chunks_per_slab_ * chunk_stride_ + cache_line_size - 1]);
+        const auto address = reinterpret_cast<std::uintptr_t>(slabs_.back().get());
+        unsigned char *data = slabs_.back().get() + (cache_line_size - address % cache_line_size) % cache_line_size;
+        for (size_t i = 0; i < chunks_per_slab_; ++i) {
+            chunks_.emplace_back(reinterpret_cast<T *>(data + i * chunk_stride_), chunk_capacity_);
+            free_chunks_.push_back(&chunks_.back());
+        }
+    }
+
+    const size_t chunk_capacity_;
+    const size_t chunk_stride_; ///< Size of a chunk in bytes, rounded up to a multiple of the cache line size
+    const size_t chunks_per_slab_;
+
+    std::vector<std::unique_ptr<unsigned char[]>> slabs_;
+    std::deque<Chunk> chunks_; ///< All the chunks, in a deque so that they never move
+    std::vector<Chunk *> free_chunks_;
+    mutable std::mutex mutex_;
+};
+
+/// @brief Buffer of objects stored in a chain of chunks from a @ref SlabPool
+///
+/// Inserting objects never reallocates nor copies the objects already stored: when the last chunk is full, another one
+/// is acquired from the pool and chained. The chunks go back to the pool when the buffer is cleared or destroyed.
+template<typename T>
+class ChunkedBuffer {
+public:
+    using Chunk = SlabChunk<T>;
+
+    /// @brief Constructor
+    /// @param pool Pool to acquire the chunks from, which is kept alive as long as the buffer
+    explicit ChunkedBuffer(std::shared_ptr<SlabPool<T>> pool) : pool_(std::move(pool)) {}
+
+    ChunkedBuffer(const ChunkedBuffer &) = delete;
+    ChunkedBuffer &operator=(const ChunkedBuffer &) = delete;
+
+    ~ChunkedBuffer() {
+        clear();
+    }
+
+    /// @brief Appends objects at the end of the buffer, chaining as many chunks as needed
+    template<typename InputIt>
+    void insert_back(InputIt first, InputIt last) {
+        while (first != last) {
+            if (chunks_.empty() || chunks_.back()->full()) {
+                chunks_.push_back(pool_->acquire());
+            }
+            const size_t size_before = chunks_.back()->size();
+            first                    = chunks_.back()->append(first, last);
+            size_ += chunks_.back()->size() - size_before;
+        }
+    }
+
+    /// @brief Empties the buffer, giving its chunks back to the pool
+    void clear() {
+        for (Chunk *chunk : chunks_) {
+            pool_->release(chunk);
+        }
+        chunks_.clear();
+        size_ = 0;
+    }
+
+    /// @brief Gets the number of objects in the buffer
+    size_t size() const {
+        return size_;
+    }
+
+    bool empty() const {
+        return size_ == 0;
+    }
+
+    /// @brief Gets the number of chunks holding the objects of the buffer
+    size_t num_chunks() const {
+        return chunks_.size();
+    }
+
+    /// @brief Gets a chunk of the buffer, whose objects are contiguous
+    /// @param index Index of the chunk, in the order of the objects
+    const Chunk &chunk(size_t index) const {
+        return *chunks_[index];
+    }
+
+    /// @brief Copies the objects of the buffer, in order
+    /// @param out Output iterator where to copy the objects
+    /// @return The output iterator after the last object copied
+    template<typename OutputIt>
+    OutputIt copy_to(OutputIt out) const {
+        for (const Chunk *chunk : chunks_) {
+            out = std::copy(chunk->begin(), chunk->end(), out);
+        }
+        return out;
+    }
+
+private:
+    std::shared_ptr<SlabPool<T>> pool_;
+    std::vector<Chunk *> chunks_;
+    size_t size_ = 0;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_BASE_SLAB_POOL_H
@@ -0,0 +1,150 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_BASE_SPSC_QUEUE_H
+#define METAVISION_SDK_BASE_SPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace Metavision {
+
+/// @brief Bounded, lock-free, single producer / single consumer queue
+///
+/// Elements are stored in a ring buffer allocated once at construction. @ref try_push must only be called from one
+/// thread (the producer) and @ref try_pop, @ref front and @ref pop from one other thread (the consumer). Neither side
+/// ever takes a lock or allocates memory.
+///
+/// @tparam T Type of the elements stored, must be default constructible and move assignable
+template<typename T>
+class SPSCQueue {
+public:
+    /// @brief Constructor
+    /// @param capacity Maximum number of elements the queue can hold, rounded up to the next power of two
+    explicit SPSCQueue(size_t capacity) : capacity_(round_up_pow2(capacity < 2 ? 2 : capacity)), mask_(capacity_ - 1) {
+        slots_.reset(new T[capacity_]);
+    }
+
+    SPSCQueue(const SPSCQueue &) = delete;
+    SPSCQueue &operator=(const SPSCQueue &) = delete;
+
+    /// @brief Gets the maximum number of elements the queue can hold
+    /// @return Capacity of the queue
+    size_t capacity() const {
+        return capacity_;
+    }
+
+    /// @brief Gets the number of elements currently in the queue
+    /// @return Number of elements in the queue
+    /// @note The value is only a snapshot when called from a thread other than the producer or the consumer
+    size_t size() const {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+
+    /// @brief Checks if the queue is empty
+    /// @return true if the queue has no element, false otherwise
+    bool empty() const {
+        return size() == 0;
+    }
+
+    /// @brief Pushes an element at the back of the queue (producer side)
+    /// @param value Element to push
+    /// @return true if the element was pushed, false if the queue is full
+    template<typename U>
+    bool try_push(U &&value) {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_cache_ == capacity_) {
+            head_cache_ = head_.load(std::memory_order_acquire);
+            if (tail - head_cache_ == capacity_) {
+                return false;
+            }
+        }
+        slots_[tail & mask_] = std::forward<U>(value);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// @brief Gets the element at the front of the queue (consumer side)
+    /// @return Pointer to the front element, or nullptr if the queue is empty
+    /// @note The pointer stays valid until the next call to @ref pop
+    T *front() {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_cache_) {
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+            if (head == tail_cache_) {
+                return nullptr;
+            }
+        }
+        return &slots_[head & mask_];
+    }
+
+    /// @brief Removes the element at the front of the queue (consumer side)
+    /// @warning Must only be called after @ref front returned a valid pointer
+    void pop() {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        slots_[head & mask_] = T();
+        head_.store(head + 1, std::memory_order_release);
+    }
+
+    /// @brief Moves the element at the front of the queue into @p value and removes it (consumer side)
+    /// @param value Element in which to move the front of the queue
+    /// @return true if an element was popped, false if the queue is empty
+    bool try_pop(T &value) {
+        T *f = front();
+        if (!f) {
+            return false;
+        }
+        value = std::move(*f);
+        pop();
+        return true;
+    }
+
+    /// @brief Removes all elements from the queue (consumer side)
+    void clear() {
+        while (front()) {
+            pop();
+        }
+    }
+
+private:
+    static size_t round_up_pow2(size_t n) {
+        size_t p = 1;
+        while (p < n) {
+            p <<= 1;
+        }
+        return p;
+    }
+
+    // Producer and consumer indices live on separate cache lines to avoid false sharing. They are separated by a
+    // whole cache line of padding rather than over-aligned, so that the queue can be allocated with a plain new in
+    // C++14, which does not honor alignments larger than the one of std::max_align_t
+    static constexpr size_t cache_line_size = 64;
+
+    const size_t capacity_;
+    const size_t mask_;
+    std::unique_ptr<T[]> slots_;
+
+    char padding_before_head_[cache_line_size];
+    std::atomic<size_t> head_{0};
+    size_t tail_cache_{0}; // consumer's copy of tail_
+
+    char padding_before_tail_[cache_line_size];
+    std::atomic<size_t> tail_{0};
+    size_t head_cache_{0}; // producer's copy of head_
+
+    char padding_after_tail_[cache_line_size];
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_BASE_SPSC_QUEUE_H
@@ -0,0 +1,59 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_BASE_THREAD_POLICY_H
+#define METAVISION_SDK_BASE_THREAD_POLICY_H
+
+#include <string>
+#include <vector>
+
+namespace Metavision {
+
+/// @brief Scheduling policy of a thread
+enum class ThreadScheduling {
+    /// Default time-sharing scheduling of the system
+    Default,
+    /// Real-time first in, first out scheduling (SCHED_FIFO)
+    Fifo,
+    /// Real-time round-robin scheduling (SCHED_RR)
+    RoundRobin
+};
+
+/// @brief Threading policy applied to a thread spawned by the SDK
+///
+/// The default policy leaves the thread as created by the system, except for its name.
+struct ThreadPolicy {
+    /// CPUs the thread is allowed to run on. If empty, the affinity is left unchanged
+    std::vector<unsigned int> cpu_affinity_;
+
+    /// Scheduling policy of the thread
+    ThreadScheduling scheduling_ = ThreadScheduling::Default;
+
+    /// Priority of the thread for the real-time scheduling policies (from 1, lowest, to 99, highest on Linux)
+    int priority_ = 0;
+
+    /// Name of the thread (truncated to 15 characters on Linux). If empty, the SDK's default name is used. The name is
+    /// set on a best-effort basis, it is not taken into account by the result of @ref apply_thread_policy
+    std::string name_;
+};
+
+/// @brief Applies a threading policy to the calling thread
+///
+/// The real-time scheduling policies usually require privileges (e.g. CAP_SYS_NICE on Linux).
+/// @param policy The policy to apply
+/// @param default_name Name given to the thread if the policy does not specify one
+/// @return true if the whole policy was applied, false if some part of it is not supported on this system or could
+/// not be applied (the rest of the policy is applied nonetheless)
+bool apply_thread_policy(const ThreadPolicy &policy, const std::string &default_name = std::string());
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_BASE_THREAD_POLICY_H
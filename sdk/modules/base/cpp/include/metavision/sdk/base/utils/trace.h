@@ -0,0 +1,84 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_BASE_TRACE_H
+#define METAVISION_SDK_BASE_TRACE_H
+
+#include <cstdint>
+#include <string>
+
+namespace Metavision {
+namespace Trace {
+
+/// @brief Starts recording trace events, to be written in a file when the tracing is stopped
+///
+/// The file uses the Trace Event JSON format, which can be opened in the Perfetto UI (https://ui.perfetto.dev) or in
+/// chrome://tracing. If the environment variable MV_TRACE_FILE is set when the library is loaded, the tracing is
+/// started with this path and stopped at exit.
+/// @param path Path of the file to write
+/// @throw std::runtime_error if the file can not be opened
+/// @note The trace events are only emitted by the SDK when compiled with the METAVISION_TRACING option
+void start(const std::string &path);
+
+/// @brief Stops recording trace events, and writes the events recorded since @ref start in the file
+void stop();
+
+/// @brief Returns whether trace events are being recorded
+bool is_enabled();
+
+/// @brief Names the calling thread in the trace
+/// @param name Name of the thread
+void set_thread_name(const std::string &name);
+
+/// @brief Records the value of a counter, shown as a track of its own
+/// @param name Name of the counter, must have a static storage duration (e.g. a string literal)
+/// @param value Value of the counter
+void counter(const char *name, int64_t value);
+
+/// @brief Records the duration of a scope, from its construction to its destruction, on the calling thread's track
+class Scope {
+public:
+    /// @brief Constructor
+    /// @param name Name of the scope, must have a static storage duration (e.g. a string literal)
+    explicit Scope(const char *name);
+
+    /// @brief Destructor, records the scope if the tracing was enabled at construction
+    ~Scope();
+
+    Scope(const Scope &)            = delete;
+    Scope &operator=(const Scope &) = delete;
+
+private:
+    const char *name_;
+    int64_t begin_us_;
+};
+
+} // namespace Trace
+} // namespace Metavision
+
+#define MV_TRACE_CONCAT_IMPL(a, b) a##b
+#define MV_TRACE_CONCAT(a, b) MV_TRACE_CONCAT_IMPL(a, b)
+
+#ifdef METAVISION_TRACING_ENABLED
+/// Records the duration of the enclosing scope
+#define MV_TRACE_SCOPE(name) ::Metavision::Trace::Scope MV_TRACE_CONCAT(mv_trace_scope_, __LINE__)(name)
+/// Records the value of a counter
+#define MV_TRACE_COUNTER(name, value) ::Metavision::Trace::counter(name, static_cast<int64_t>(value))
+/// Names the calling thread
+#define MV_TRACE_THREAD_NAME(name) ::Metavision::Trace::set_thread_name(name)
+#else
+// The arguments are not evaluated, so that the tracing costs nothing when disabled at compile time
+#define MV_TRACE_SCOPE(name) static_cast<void>(0)
+#define MV_TRACE_COUNTER(name, value) static_cast<void>(0)
+#define MV_TRACE_THREAD_NAME(name) static_cast<void>(0)
+#endif
+
+#endif // METAVISION_SDK_BASE_TRACE_H
@@ -0,0 +1,176 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define METAVISION_CPU_X86
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#elif defined(__aarch64__) || defined(__arm__) || defined(_M_ARM64)
+#define METAVISION_CPU_ARM
+#ifdef __linux__
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#endif
+#endif
+
+#include "metavision/sdk/base/utils/cpu_features.h"
+
+namespace Metavision {
+namespace {
+
+constexpr SimdLevel simd_levels[] = {SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::AVX512,
+                                     SimdLevel::NEON};
+
+#ifdef METAVISION_CPU_X86
+void cpuid(unsigned int leaf, unsigned int subleaf, unsigned int regs[4]) {
+#ifdef _MSC_VER
+    int r[4];
+    __cpuidex(r, static_cast<int>(leaf), static_cast<int>(subleaf));
+    for (int i = 0; i < 4; ++i) {
+        regs[i] = static_cast<unsigned int>(r[i]);
+    }
+#else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+// Gets the register states the operating system saves on context switches
+std::uint64_t xgetbv0() {
+#ifdef _MSC_VER
+    return _xgetbv(0);
+#else
+    unsigned int eax, edx;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<std::uint64_t>(edx) << 32) | eax;
+#endif
+}
+#endif
+
+CpuFeatures detect_cpu_features() {
+    CpuFeatures features;
+#if defined(METAVISION_CPU_X86)
+    unsigned int regs[4];
+    cpuid(0, 0, regs);
+    const unsigned int max_leaf = regs[0];
+    if (max_leaf < 1) {
+        return features;
+    }
+
+    cpuid(1, 0, regs);
+    features.sse2_   = (regs[3] >> 26) & 1;
+    features.sse4_1_ = (regs[2] >> 19) & 1;
+
+    // The AVX registers can only be used if the operating system saves them (XMM and YMM states, and the opmask and
+    // ZMM states for AVX-512)
+    const bool osxsave       = (regs[2] >> 27) & 1;
+    const std::uint64_t xcr0 = osxsave ? xgetbv0() : 0;
+    const bool os_saves_ymm  = (xcr0 & 0x6) == 0x6;
+    const bool os_saves_zmm  = (xcr0 & 0xe6) == 0xe6;
+    features.avx_            = os_saves_ymm && ((regs[2] >> 28) & 1);
+    features.fma_            = features.avx_ && ((regs[2] >> 12) & 1);
+
+    if (max_leaf >= 7) {
+        cpuid(7, 0, regs);
+        features.avx2_     = features.avx_ && ((regs[1] >> 5) & 1);
+        features.bmi2_     = (regs[1] >> 8) & 1;
+        features.avx512f_  = os_saves_zmm && ((regs[1] >> 16) & 1);
+        features.avx512bw_ = features.avx512f_ && ((regs[1] >> 30) & 1);
+        features.avx512vl_ = features.avx512f_ && ((regs[1] >> 31) & 1);
+    }
+#elif defined(METAVISION_CPU_ARM)
+#if defined(__linux__) && defined(__aarch64__)
+    features.neon_ = (getauxval(AT_HWCAP) & HWCAP_ASIMD) != 0;
+#elif defined(__linux__)
+    features.neon_ = (getauxval(AT_HWCAP) & HWCAP_NEON) != 0;
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    // Advanced SIMD is mandatory on ARMv8-A
+    features.neon_ = true;
+#endif
+#endif
+    return features;
+}
+
+bool is_simd_level_supported_by_cpu(SimdLevel level) {
+    const CpuFeatures &features = get_cpu_features();
+    switch (level) {
+    case SimdLevel::Scalar:
+        return true;
+    case SimdLevel::SSE2:
+        return features.sse2_;
+    case SimdLevel::AVX2:
+        return features.avx2_ && features.fma_ && features.bmi2_;
+    case SimdLevel::AVX512:
+        return features.avx2_ && features.fma_ && features.bmi2_ && features.avx512f_ && features.avx512bw_ &&
+               features.avx512vl_;
+    case SimdLevel::NEON:
+        return features.neon_;
+    }
+    return false;
+}
+
+// Gets the most capable level allowed by the environment variable MV_SIMD_LEVEL
+SimdLevel get_simd_level_limit() {
+    const char *env = std::getenv("MV_SIMD_LEVEL");
+    if (env) {
+        for (auto level : simd_levels) {
+            if (std::strcmp(env, to_string(level)) == 0) {
+                return level;
+            }
+        }
+    }
+    return SimdLevel::NEON;
+}
+
+} // namespace
+
+const CpuFeatures &get_cpu_features() {
+    static const CpuFeatures features = detect_cpu_features();
+    return features;
+}
+
+SimdLevel get_simd_level() {
+    SimdLevel best = SimdLevel::Scalar;
+    for (auto level : simd_levels) {
+        if (is_simd_level_supported(level)) {
+            best = level;
+        }
+    }
+    return best;
+}
+
+bool is_simd_level_supported(SimdLevel level) {
+    return level <= get_simd_level_limit() && is_simd_level_supported_by_cpu(level);
+}
+
+const char *to_string(SimdLevel level) {
+    switch (level) {
+    case SimdLevel::Scalar:
+        return "SCALAR";
+    case SimdLevel::SSE2:
+        return "SSE2";
+    case SimdLevel::AVX2:
+        return "AVX2";
+    case SimdLevel::AVX512:
+        return "AVX512";
+    case SimdLevel::NEON:
+        return "NEON";
+    }
+    return "UNKNOWN";
+}
+
+} // namespace Metavision
@@ -9,6 +9,7 @@
  * See the License for the specific language governing permissions and limitations under the License.                 *
  **********************************************************************************************************************/
 
+#include <algorithm>
 #include <vector>
 #include <chrono>
 #include <sstream>
@@ -21,6 +22,7 @@ namespace Metavision {
 namespace {
 
 static const std::string field_prefix           = "%";
+static const char *const whitespaces            = " \t\n\v\f\r";
 static const std::vector<std::string> date_keys = {"date", "Date"};
 } // namespace
 
@@ -117,27 +119,33 @@ bool GenericHeader::check_prefix_and_read_header_line(std::istream &stream) {
 }
 
 void GenericHeader::parse_header(std::istream &stream) {
-    std::streampos start_pos = stream.tellg();
-
+    std::string line;
     while (check_prefix_and_read_header_line(stream)) {
         // In order for the value to be insert in the map, the line of the header has to be:
         // % Key value
-        std::string line;
-        std::string tmp_key;
         if (std::getline(stream, line)) {
-            std::vector<std::string> vec;
-            std::istringstream iss(line);
-
-            // After a call to is_next_line_commented, the first two characters have been read already
-            // so we expect the key to be the first extracted field
+            // After a call to check_prefix_and_read_header_line, the first two characters have been read already
+            // so we expect the key to be the first field, the value being the other fields separated by a space.
+            // The fields are split in a single pass, without going through a string stream
             std::string key, value;
-            if (iss >> key) {
-                std::string tot_value;
-                iss >> tot_value;
-                while (iss >> value) {
-                    tot_value += " " + value;
+            for (size_t pos = 0;;) {
+                pos = line.find_first_not_of(whitespaces, pos);
+                if (pos == std::string::npos) {
+                    break;
                 }
-                header_[key] = tot_value;
+                const size_t end = std::min(line.find_first_of(whitespaces, pos), line.size());
+                if (key.empty()) {
+                    key.assign(line, pos, end - pos);
+                } else {
+                    if (!value.empty()) {
+                        value += ' ';
+                    }
+                    value.append(line, pos, end - pos);
+                }
+                pos = end;
+            }
+            if (!key.empty()) {
+                header_[key] = std::move(value);
             }
         }
     }
@@ -9,15 +9,30 @@
  * See the License for the specific language governing permissions and limitations under the License.                 *
  **********************************************************************************************************************/
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
 #include <iostream>
 #include <fstream>
 #include <memory>
 #include <mutex>
+#include <thread>
+#include <vector>
 
 #include "metavision/sdk/base/utils/log.h"
 
 namespace Metavision {
 
+namespace detail {
+/// @brief Message logged asynchronously, recycled once written
+struct LogMessage {
+    std::atomic<LogMessage *> next{nullptr};
+    std::streambuf *buf = nullptr;
+    std::vector<char> bytes;
+};
+} // namespace detail
+
 namespace {
 bool gLogLevelEnvRead    = false;
 const char *gLogLevelEnv = nullptr;
@@ -26,15 +41,224 @@ const char *gLogStreamEnv = nullptr;
 bool gLogStreamEnvRead    = false;
 std::ostream *gStream(&std::cerr);
 std::unique_ptr<std::ofstream> gFileStream;
+bool gLogAsyncEnvRead    = false;
+const char *gLogAsyncEnv = nullptr;
+std::atomic<bool> gLogAsync(false);
 
 std::mutex concurrent_ostreambuf_mutex;
+
+using detail::LogMessage;
+
+/// @brief Writes the messages logged asynchronously from a background thread
+///
+/// The messages are pushed in an intrusive multi-producer single-consumer queue (D. Vyukov's algorithm), where pushing
+/// is a single atomic exchange. Once written, they are put back on a lock-free stack of free messages, which the
+/// logging threads take as a whole to refill their own cache, so that their buffers are reused without allocation.
+class AsyncLogWriter {
+public:
+    AsyncLogWriter() : head_(&stub_), tail_(&stub_) {}
+
+    ~AsyncLogWriter() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+            cond_.notify_all();
+        }
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+        LogMessage *message = free_messages_.exchange(nullptr);
+        while (message) {
+            LogMessage *next = message->next.load(std::memory_order_relaxed);
+            delete message;
+            message = next;
+        }
+    }
+
+    /// @brief Gets an empty message, from the cache of the calling thread
+    LogMessage *acquire() {
+        auto &cache = thread_cache();
+        if (cache.empty()) {
+            LogMessage *message = free_messages_.exchange(nullptr, std::memory_order_acquire);
+            for (; message; message = message->next.load(std::memory_order_relaxed)) {
+                cache.push_back(message);
+            }
+            if (cache.empty()) {
+                auto new_message = new LogMessage();
+                new_message->bytes.reserve(MessageCapacity);
+                return new_message;
+            }
+        }
+        LogMessage *message = cache.back();
+        cache.pop_back();
+        return message;
+    }
+
+    /// @brief Gives back a message which has not been pushed
+    void release(LogMessage *message) {
+        message->bytes.clear();
+        thread_cache().push_back(message);
+    }
+
+    /// @brief Queues a message to be written to its streambuf
+    void push(LogMessage *message) {
+        ensure_started();
+        message->next.store(nullptr, std::memory_order_relaxed);
+        LogMessage *prev = head_.exchange(message, std::memory_order_acq_rel);
+        prev->next.store(message, std::memory_order_release);
+        num_pushed_.fetch_add(1, std::memory_order_release);
+        // Notifying without the lock may miss the writer going to sleep, which only delays it by its polling period
+        if (writer_waiting_.load(std::memory_order_acquire)) {
+            cond_.notify_one();
+        }
+    }
+
+    /// @brief Waits until the messages pushed before the call have been written
+    void flush() {
+        const std::uint64_t target = num_pushed_.load(std::memory_order_acquire);
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (!thread_.joinable()) {
+            return;
+        }
+        cond_.notify_all();
+        flushed_cond_.wait(lock, [this, target]() { return num_written_ >= target; });
+    }
+
+private:
+    static constexpr size_t MessageCapacity = 256;
+
+    struct ThreadCache : std::vector<LogMessage *> {
+        ~ThreadCache() {
+            for (auto message : *this) {
+                delete message;
+            }
+        }
+    };
+
+    static ThreadCache &thread_cache() {
+        static thread_local ThreadCache cache;
+        return cache;
+    }
+
+    void ensure_started() {
+        if (started_.load(std::memory_order_acquire)) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!thread_.joinable()) {
+            thread_ = std::thread([this]() { run(); });
+            started_.store(true, std::memory_order_release);
+        }
+    }
+
+    LogMessage *pop() {
+        LogMessage *tail = tail_;
+        LogMessage *next = tail->next.load(std::memory_order_acquire);
+        if (tail == &stub_) {
+            if (!next) {
+                return nullptr;
+            }
+            tail_ = next;
+            tail  = next;
+            next  = next->next.load(std::memory_order_acquire);
+        }
+        if (next) {
+            tail_ = next;
+            return tail;
+        }
+        if (tail != head_.load(std::memory_order_acquire)) {
+            // A producer is in the middle of a push, its message will be available shortly
+            return nullptr;
+        }
+        stub_.next.store(nullptr, std::memory_order_relaxed);
+        LogMessage *prev = head_.exchange(&stub_, std::memory_order_acq_rel);
+        prev->next.store(&stub_, std::memory_order_release);
+        next = tail->next.load(std::memory_order_acquire);
+        if (next) {
+            tail_ = next;
+            return tail;
+        }
+        return nullptr;
+    }
+
+    void recycle(LogMessage *message) {
+        message->bytes.clear();
+        LogMessage *top = free_messages_.load(std::memory_order_relaxed);
+        do {
+            message->next.store(top, std::memory_order_relaxed);
+        } while (!free_messages_.compare_exchange_weak(top, message, std::memory_order_release,
+                                                       std::memory_order_relaxed));
+    }
+
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            lock.unlock();
+            std::uint64_t num_written = 0;
+            while (LogMessage *message = pop()) {
+                {
+                    std::lock_guard<std::mutex> write_lock(concurrent_ostreambuf_mutex);
+                    message->buf->sputn(message->bytes.data(), message->bytes.size());
+                }
+                recycle(message);
+                ++num_written;
+            }
+            lock.lock();
+
+            if (num_written > 0) {
+                num_written_ += num_written;
+                flushed_cond_.notify_all();
+                continue;
+            }
+            if (stopping_ && num_written_ == num_pushed_.load(std::memory_order_acquire)) {
+                return;
+            }
+            writer_waiting_.store(true, std::memory_order_release);
+            cond_.wait_for(lock, std::chrono::milliseconds(5));
+            writer_waiting_.store(false, std::memory_order_relaxed);
+        }
+    }
+
+    LogMessage stub_;
+    std::atomic<LogMessage *> head_; // Last message pushed
+    LogMessage *tail_;               // Next message to pop, only accessed by the writer
+    std::atomic<LogMessage *> free_messages_{nullptr};
+    std::atomic<std::uint64_t> num_pushed_{0};
+    std::uint64_t num_written_ = 0;
+    std::atomic<bool> writer_waiting_{false};
+    std::atomic<bool> started_{false};
+    bool stopping_ = false;
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::condition_variable flushed_cond_;
+    std::thread thread_;
+};
+
+AsyncLogWriter &getAsyncLogWriter() {
+    static AsyncLogWriter writer;
+    return writer;
+}
 } // namespace
 
 namespace detail {
 concurrent_ostreambuf::concurrent_ostreambuf(std::streambuf *buf) : buf_(buf), has_output_(false) {}
 
+concurrent_ostreambuf::~concurrent_ostreambuf() {
+    if (message_) {
+        getAsyncLogWriter().release(message_);
+    }
+}
+
+std::vector<char> &concurrent_ostreambuf::bytes() {
+    if (!message_ && isLogAsync()) {
+        message_ = getAsyncLogWriter().acquire();
+    }
+    return message_ ? message_->bytes : bytes_;
+}
+
 std::streamsize concurrent_ostreambuf::xsputn(const char_type *s, std::streamsize n) {
-    bytes_.insert(bytes_.end(), s, s + n);
+    auto &bytes = this->bytes();
+    bytes.insert(bytes.end(), s, s + n);
     has_output_ = true;
     return n;
 }
@@ -42,12 +266,18 @@ std::streamsize concurrent_ostreambuf::xsputn(const char_type *s, std::streamsiz
 int concurrent_ostreambuf::overflow(int ch) {
     if (ch != EOF) {
         has_output_ = true;
-        bytes_.push_back(ch);
+        bytes().push_back(ch);
     }
     return ch;
 }
 
 int concurrent_ostreambuf::sync() {
+    if (message_) {
+        message_->buf = buf_;
+        getAsyncLogWriter().push(message_);
+        message_ = nullptr;
+        return 1;
+    }
     {
         std::lock_guard<std::mutex> lock(concurrent_ostreambuf_mutex);
         buf_->sputn(bytes_.data(), bytes_.size());
@@ -113,14 +343,48 @@ std::ostream &getLogStream() {
 }
 
 void setLogStream(std::ostream &stream) {
+    flushLog();
     gStream = &stream;
 }
 
 void resetLogStreamFromEnv() {
+    flushLog();
     gLogStreamEnvRead = false;
     gFileStream.reset(nullptr);
 }
 
+bool isLogAsync() {
+    if (!gLogAsyncEnvRead) {
+        gLogAsyncEnv     = getenv("MV_LOG_ASYNC");
+        gLogAsyncEnvRead = true;
+    }
+    if (gLogAsyncEnv) {
+        const std::string s(gLogAsyncEnv);
+        if (s == "1") {
+            return true;
+        } else if (s == "0") {
+            return false;
+        }
+    }
+    return gLogAsync.load(std::memory_order_relaxed);
+}
+
+void setLogAsync(bool enabled) {
+    gLogAsync.store(enabled, std::memory_order_relaxed);
+    if (!enabled) {
+        flushLog();
+    }
+}
+
+void resetLogAsyncFromEnv() {
+    gLogAsyncEnvRead = false;
+    gLogAsyncEnv     = nullptr;
+}
+
+void flushLog() {
+    getAsyncLogWriter().flush();
+}
+
 #if !defined DEBUG && defined NDEBUG
 constexpr LogLevel LoggingOperation<LogLevel::Debug>::Level;
 
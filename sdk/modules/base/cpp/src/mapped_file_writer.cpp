@@ -0,0 +1,269 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include "metavision/sdk/base/utils/mapped_file_writer.h"
+#include "metavision/sdk/base/utils/sdk_log.h"
+
+namespace Metavision {
+
+namespace {
+uint64_t get_page_size() {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwAllocationGranularity;
+#else
+    return static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+#endif
+}
+} // namespace
+
+MappedFileWriter::MappedFileWriter(const std::string &filename, const MappedFileWriterConfig &config) :
+    filename_(filename), config_(config) {
+    if (config_.capacity_ == 0) {
+        throw std::invalid_argument("The capacity of the mapped file " + filename + " must not be null");
+    }
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, NULL, CREATE_ALWAYS,
+                              FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("Could not create file " + filename);
+    }
+    LARGE_INTEGER capacity;
+    capacity.QuadPart = static_cast<LONGLONG>(config_.capacity_);
+    if (!SetFilePointerEx(file, capacity, NULL, FILE_BEGIN) || !SetEndOfFile(file)) {
+        CloseHandle(file);
+        throw std::runtime_error("Could not allocate " + std::to_string(config_.capacity_) + " bytes for file " +
+                                 filename);
+    }
+    HANDLE file_mapping = CreateFileMappingA(file, NULL, PAGE_READWRITE, 0, 0, NULL);
+    if (file_mapping == NULL) {
+        CloseHandle(file);
+        throw std::runtime_error("Could not map file " + filename);
+    }
+    mapping_ = static_cast<uint8_t *>(MapViewOfFile(file_mapping, FILE_MAP_WRITE, 0, 0, 0));
+    if (mapping_ == nullptr) {
+        CloseHandle(file_mapping);
+        CloseHandle(file);
+        throw std::runtime_error("Could not map file " + filename);
+    }
+    file_         = file;
+    file_mapping_ = file_mapping;
+#else
+    int fd = open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Could not create file " + filename);
+    }
+    // The blocks are allocated upfront, so that writing the mapping never fails for lack of space and the file is
+    // laid out contiguously where the file system allows it
+#ifdef __linux__
+    int error        = posix_fallocate(fd, 0, static_cast<off_t>(config_.capacity_));
+    const bool sized = error == 0;
+    if (error == EOPNOTSUPP || error == EINVAL) {
+        error = 0;
+    }
+#else
+#ifdef __APPLE__
+    // F_PREALLOCATE only reserves the blocks (contiguously if possible), the size of the file is set below
+    fstore_t store = {F_ALLOCATECONTIG | F_ALLOCATEALL, F_PEOFPOSMODE, 0, static_cast<off_t>(config_.capacity_), 0};
+    if (fcntl(fd, F_PREALLOCATE, &store) == -1) {
+        store.fst_flags = F_ALLOCATEALL;
+        fcntl(fd, F_PREALLOCATE, &store);
+    }
+#endif
+    int error        = 0;
+    const bool sized = false;
+#endif
+    if (error == 0 && !sized) {
+        error = ftruncate(fd, static_cast<off_t>(config_.capacity_)) == 0 ? 0 : errno;
+    }
+    if (error != 0) {
+        ::close(fd);
+        throw std::runtime_error("Could not allocate " + std::to_string(config_.capacity_) + " bytes for file " +
+                                 filename + ": " + std::strerror(error));
+    }
+    void *data = mmap(nullptr, config_.capacity_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED) {
+        ::close(fd);
+        throw std::runtime_error("Could not map file " + filename);
+    }
+    madvise(data, config_.capacity_, MADV_SEQUENTIAL);
+    mapping_ = static_cast<uint8_t *>(data);
+    fd_      = fd;
+#endif
+
+    if (config_.flush_policy_ == MappedFileWriterConfig::FlushPolicy::Background && config_.flush_size_ > 0) {
+        next_flush_size_ = config_.flush_size_;
+        flusher_         = std::thread([this] { run_flusher(); });
+    }
+}
+
+MappedFileWriter::~MappedFileWriter() {
+    close();
+}
+
+bool MappedFileWriter::write(const void *data, size_t size) {
+    uint8_t *dest = get_write_pointer(size);
+    if (dest == nullptr) {
+        drop(size);
+        return false;
+    }
+    std::memcpy(dest, data, size);
+    commit(size);
+    return true;
+}
+
+uint8_t *MappedFileWriter::get_write_pointer(size_t size) {
+    const uint64_t offset = size_.load(std::memory_order_relaxed);
+    if (mapping_ == nullptr || size > config_.capacity_ - offset) {
+        return nullptr;
+    }
+    return mapping_ + offset;
+}
+
+void MappedFileWriter::commit(size_t size) {
+    const uint64_t new_size = size_.load(std::memory_order_relaxed) + size;
+    size_.store(new_size, std::memory_order_release);
+    if (flusher_.joinable() && new_size >= next_flush_size_.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock(flush_mutex_);
+        flush_cond_.notify_one();
+    }
+}
+
+void MappedFileWriter::drop(size_t size) {
+    n_dropped_bytes_ += size;
+}
+
+void MappedFileWriter::close() {
+    if (mapping_ == nullptr) {
+        return;
+    }
+    if (flusher_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(flush_mutex_);
+            stop_ = true;
+        }
+        flush_cond_.notify_one();
+        flusher_.join();
+    }
+
+    const uint64_t size = size_;
+    const bool sync     = config_.flush_policy_ != MappedFileWriterConfig::FlushPolicy::None;
+    if (sync) {
+        flush(0, size, true);
+    }
+#ifdef _WIN32
+    UnmapViewOfFile(mapping_);
+    CloseHandle(file_mapping_);
+    LARGE_INTEGER end;
+    end.QuadPart = static_cast<LONGLONG>(size);
+    SetFilePointerEx(file_, end, NULL, FILE_BEGIN);
+    SetEndOfFile(file_);
+    if (sync) {
+        FlushFileBuffers(file_);
+    }
+    CloseHandle(file_);
+    file_         = nullptr;
+    file_mapping_ = nullptr;
+#else
+    munmap(mapping_, config_.capacity_);
+    // The space preallocated and not used is given back
+    if (ftruncate(fd_, static_cast<off_t>(size)) != 0) {
+        MV_SDK_LOG_WARNING() << "Could not truncate file" << filename_ << "to the size of its data," << size << "bytes";
+    }
+    if (sync) {
+        fsync(fd_);
+    }
+    ::close(fd_);
+    fd_ = -1;
+#endif
+    mapping_ = nullptr;
+}
+
+const std::string &MappedFileWriter::get_filename() const {
+    return filename_;
+}
+
+uint64_t MappedFileWriter::get_size() const {
+    return size_;
+}
+
+uint64_t MappedFileWriter::get_capacity() const {
+    return config_.capacity_;
+}
+
+uint64_t MappedFileWriter::get_n_dropped_bytes() const {
+    return n_dropped_bytes_;
+}
+
+void MappedFileWriter::run_flusher() {
+    uint64_t released_size = 0;
+    std::unique_lock<std::mutex> lock(flush_mutex_);
+    while (true) {
+        flush_cond_.wait(lock, [this] { return stop_ || size_.load(std::memory_order_acquire) >= next_flush_size_; });
+        if (stop_) {
+            break;
+        }
+        const uint64_t size = size_.load(std::memory_order_acquire);
+        next_flush_size_    = size + config_.flush_size_;
+        lock.unlock();
+
+        flush(flushed_size_, size, false);
+#if !defined(_WIN32)
+        // The pages whose write back was started at the previous flush are most likely clean by now: they are
+        // released from the process so that a long recording does not grow its resident memory
+        static const uint64_t page_size = get_page_size();
+        const uint64_t release_end      = flushed_size_ / page_size * page_size;
+        if (release_end > released_size) {
+            madvise(mapping_ + released_size, release_end - released_size, MADV_DONTNEED);
+            released_size = release_end;
+        }
+#endif
+        flushed_size_ = size;
+
+        lock.lock();
+    }
+}
+
+void MappedFileWriter::flush(uint64_t begin, uint64_t end, bool wait) {
+    static const uint64_t page_size = get_page_size();
+    begin                           = begin / page_size * page_size;
+    if (end <= begin) {
+        return;
+    }
+#ifdef _WIN32
+    FlushViewOfFile(mapping_ + begin, static_cast<SIZE_T>(end - begin));
+    (void)wait;
+#elif defined(__linux__)
+    if (wait) {
+        msync(mapping_ + begin, end - begin, MS_SYNC);
+    } else {
+        // Starts the write back without waiting for it, which msync(MS_ASYNC) does not do on Linux
+        sync_file_range(fd_, static_cast<off_t>(begin), static_cast<off_t>(end - begin), SYNC_FILE_RANGE_WRITE);
+    }
+#else
+    msync(mapping_ + begin, end - begin, wait ? MS_SYNC : MS_ASYNC);
+#endif
+}
+
+} // namespace Metavision
@@ -0,0 +1,94 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <cstdint>
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "metavision/sdk/base/utils/memory_placement.h"
+
+namespace Metavision {
+
+namespace {
+#ifdef __linux__
+// Values from <numaif.h>, not included to avoid depending on libnuma
+constexpr int MpolBind        = 2;
+constexpr unsigned MpolMfMove = 1 << 1;
+constexpr size_t MaxNumaNodes = 1024;
+constexpr size_t HugePageSize = 2 * 1024 * 1024;
+constexpr size_t BitsPerLong  = 8 * sizeof(unsigned long);
+#endif
+
+// Restricts [data, data + size_bytes) to the area made of full blocks of alignment bytes
+bool align_area(void *data, size_t size_bytes, size_t alignment, void *&begin, size_t &size) {
+    const std::uintptr_t first = reinterpret_cast<std::uintptr_t>(data);
+    const std::uintptr_t b     = (first + alignment - 1) / alignment * alignment;
+    const std::uintptr_t e     = (first + size_bytes) / alignment * alignment;
+    if (e <= b) {
+        return false;
+    }
+    begin = reinterpret_cast<void *>(b);
+    size  = e - b;
+    return true;
+}
+} // namespace
+
+int get_current_numa_node() {
+#if defined(__linux__) && defined(SYS_getcpu)
+    unsigned cpu, node;
+    if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0) {
+        return static_cast<int>(node);
+    }
+#endif
+    return -1;
+}
+
+bool place_memory(void *data, size_t size_bytes, const MemoryPlacement &placement) {
+    if (placement.numa_node < 0 && !placement.huge_pages) {
+        return true;
+    }
+#ifdef __linux__
+    bool placed = true;
+    void *begin;
+    size_t size;
+
+    if (placement.huge_pages) {
+#ifdef MADV_HUGEPAGE
+        placed = align_area(data, size_bytes, HugePageSize, begin, size) && madvise(begin, size, MADV_HUGEPAGE) == 0;
+#else
+        placed = false;
+#endif
+    }
+
+    if (placement.numa_node >= 0) {
+#ifdef SYS_mbind
+        const size_t node = static_cast<size_t>(placement.numa_node);
+        if (node >= MaxNumaNodes ||
+            !align_area(data, size_bytes, static_cast<size_t>(sysconf(_SC_PAGESIZE)), begin, size)) {
+            return false;
+        }
+        unsigned long node_mask[MaxNumaNodes / BitsPerLong] = {0};
+        node_mask[node / BitsPerLong]                       = 1UL << (node % BitsPerLong);
+        placed = syscall(SYS_mbind, begin, size, MpolBind, node_mask, MaxNumaNodes, MpolMfMove) == 0 && placed;
+#else
+        placed = false;
+#endif
+    }
+    return placed;
+#else
+    return false;
+#endif
+}
+
+} // namespace Metavision
@@ -0,0 +1,198 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+#include "metavision/sdk/base/utils/metrics_registry.h"
+#include "metavision/sdk/base/utils/pool_registry.h"
+
+namespace Metavision {
+
+namespace {
+
+std::string escape_label_value(const std::string &value) {
+    std::string escaped;
+    escaped.reserve(value.size());
+    for (char c : value) {
+        switch (c) {
+        case '\\':
+            escaped += "\\\\";
+            break;
+        case '"':
+            escaped += "\\\"";
+            break;
+        case '\n':
+            escaped += "\\n";
+            break;
+        default:
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+// Identifies a sample among the others, to compute the rates of the counters
+std::string get_key(const MetricSample &sample) {
+    std::string key = sample.name_;
+    for (const auto &label : sample.labels_) {
+        key += '\0' + label.first + '\0' + label.second;
+    }
+    return key;
+}
+
+void append_pool_samples(std::vector<MetricSample> &samples) {
+    // Several pools may have the same name, they are distinguished by their rank among them
+    std::map<std::string, size_t> num_pools_per_name;
+    for (const auto &entry : PoolRegistry::instance().snapshot()) {
+        const auto &stats = entry.statistics_;
+        const std::vector<std::pair<std::string, std::string>> labels{
+            {"pool", entry.name_}, {"instance", std::to_string(num_pools_per_name[entry.name_]++)}};
+        samples.push_back({"metavision_pool_allocated", "Number of objects allocated by the pool",
+                           MetricSample::Type::Gauge, labels, static_cast<double>(stats.allocated_)});
+        samples.push_back({"metavision_pool_in_use", "Number of objects of the pool in use", MetricSample::Type::Gauge,
+                           labels, static_cast<double>(stats.in_use_)});
+        samples.push_back({"metavision_pool_peak_in_use", "Maximum number of objects of the pool in use at once",
+                           MetricSample::Type::Gauge, labels, static_cast<double>(stats.peak_in_use_)});
+        if (stats.bounded_) {
+            samples.push_back({"metavision_pool_waits_total", "Number of acquisitions that waited for an object",
+                               MetricSample::Type::Counter, labels, static_cast<double>(stats.waits_)});
+        }
+    }
+}
+
+} // namespace
+
+std::string to_prometheus_text(const std::vector<MetricSample> &samples) {
+    // The samples of a metric have to be contiguous, they are grouped in the order in which the metrics first appear
+    std::vector<const MetricSample *> sorted;
+    std::map<std::string, size_t> metric_ranks;
+    sorted.reserve(samples.size());
+    for (const auto &sample : samples) {
+        metric_ranks.emplace(sample.name_, metric_ranks.size());
+        sorted.push_back(&sample);
+    }
+    std::stable_sort(sorted.begin(), sorted.end(), [&](const MetricSample *lhs, const MetricSample *rhs) {
+        return metric_ranks[lhs->name_] < metric_ranks[rhs->name_];
+    });
+
+    std::ostringstream oss;
+    oss << std::setprecision(12);
+    const std::string *last_name = nullptr;
+    for (const MetricSample *sample : sorted) {
+        if (!last_name || *last_name != sample->name_) {
+            oss << "# HELP " << sample->name_ << " " << sample->help_ << "\n";
+            oss << "# TYPE " << sample->name_ << " "
+                << (sample->type_ == MetricSample::Type::Counter ? "counter" : "gauge") << "\n";
+            last_name = &sample->name_;
+        }
+        oss << sample->name_;
+        if (!sample->labels_.empty()) {
+            const char *sep = "{";
+            for (const auto &label : sample->labels_) {
+                oss << sep << label.first << "=\"" << escape_label_value(label.second) << "\"";
+                sep = ",";
+            }
+            oss << "}";
+        }
+        oss << " " << sample->value_ << "\n";
+    }
+    return oss.str();
+}
+
+MetricsRegistry &MetricsRegistry::instance() {
+    // Never destroyed, as components with static storage may be removed from it after the end of the main function
+    static MetricsRegistry *registry = new MetricsRegistry();
+    return *registry;
+}
+
+size_t MetricsRegistry::add(Collector collector) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const size_t id = next_id_++;
+    collectors_.emplace(id, std::move(collector));
+    return id;
+}
+
+void MetricsRegistry::remove(size_t id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    collectors_.erase(id);
+}
+
+std::vector<MetricSample> MetricsRegistry::snapshot() const {
+    // The collectors are called without holding the lock, as they may release the last reference to a component,
+    // which then removes itself from the registry
+    std::vector<Collector> collectors;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        collectors.reserve(collectors_.size());
+        for (const auto &collector : collectors_) {
+            collectors.push_back(collector.second);
+        }
+    }
+
+    std::vector<MetricSample> samples;
+    for (const auto &collector : collectors) {
+        collector(samples);
+    }
+    append_pool_samples(samples);
+    return samples;
+}
+
+void MetricsRegistry::start_reporting(std::chrono::milliseconds period, Sink sink) {
+    stop_reporting();
+    std::lock_guard<std::mutex> lock(reporting_mutex_);
+    reporting_        = true;
+    reporting_thread_ = std::thread([this, period, sink] {
+        using Clock = std::chrono::steady_clock;
+        std::map<std::string, double> last_values;
+        Clock::time_point last_time;
+
+        std::unique_lock<std::mutex> lock(reporting_mutex_);
+        while (!reporting_cond_.wait_for(lock, period, [this] { return !reporting_; })) {
+            lock.unlock();
+            auto samples    = snapshot();
+            const auto now  = Clock::now();
+            const double dt = std::chrono::duration<double>(now - last_time).count();
+            std::map<std::string, double> values;
+            for (auto &sample : samples) {
+                if (sample.type_ != MetricSample::Type::Counter) {
+                    continue;
+                }
+                const std::string key = get_key(sample);
+                auto it               = last_values.find(key);
+                if (it != last_values.end() && dt > 0.) {
+                    sample.rate_ = (sample.value_ - it->second) / dt;
+                }
+                values.emplace(key, sample.value_);
+            }
+            last_values.swap(values);
+            last_time = now;
+            sink(samples);
+            lock.lock();
+        }
+    });
+}
+
+void MetricsRegistry::stop_reporting() {
+    std::thread thread;
+    {
+        std::lock_guard<std::mutex> lock(reporting_mutex_);
+        reporting_ = false;
+        thread     = std::move(reporting_thread_);
+    }
+    reporting_cond_.notify_all();
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+} // namespace Metavision
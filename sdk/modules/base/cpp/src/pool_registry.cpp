@@ -0,0 +1,119 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <sstream>
+
+#include "metavision/sdk/base/utils/pool_registry.h"
+#include "metavision/sdk/base/utils/sdk_log.h"
+
+namespace Metavision {
+
+std::ostream &operator<<(std::ostream &os, const PoolStatistics &statistics) {
+    os << "allocated: " << statistics.allocated_ << ", in use: " << statistics.in_use_
+       << ", peak in use: " << statistics.peak_in_use_;
+    if (statistics.bounded_) {
+        os << ", waits: " << statistics.waits_;
+    } else {
+        os << " (unbounded)";
+    }
+    return os;
+}
+
+PoolRegistry &PoolRegistry::instance() {
+    // Never destroyed, as pools with static storage may be removed from it after the end of the main function
+    static PoolRegistry *registry = new PoolRegistry();
+    return *registry;
+}
+
+size_t PoolRegistry::add(const std::string &name, StatisticsGetter getter, Shrinker shrinker) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const size_t id = next_id_++;
+    pools_.emplace(id, Pool{name, std::move(getter), std::move(shrinker)});
+    return id;
+}
+
+void PoolRegistry::remove(size_t id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pools_.erase(id);
+}
+
+std::vector<PoolRegistry::Entry> PoolRegistry::snapshot() const {
+    // The getters are called without holding the lock, as they may release the last reference to a pool, which then
+    // removes itself from the registry
+    std::vector<Pool> pools;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pools.reserve(pools_.size());
+        for (const auto &pool : pools_) {
+            pools.push_back(pool.second);
+        }
+    }
+
+    std::vector<Entry> entries;
+    entries.reserve(pools.size());
+    for (const auto &pool : pools) {
+        entries.push_back({pool.name, pool.getter()});
+    }
+    return entries;
+}
+
+size_t PoolRegistry::shrink() {
+    // The shrinkers are called without holding the lock, for the same reason as the getters in snapshot
+    std::vector<Shrinker> shrinkers;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto &pool : pools_) {
+            if (pool.second.shrinker) {
+                shrinkers.push_back(pool.second.shrinker);
+            }
+        }
+    }
+
+    size_t num_freed = 0;
+    for (const auto &shrinker : shrinkers) {
+        num_freed += shrinker();
+    }
+    return num_freed;
+}
+
+void PoolRegistry::start_logging(std::chrono::milliseconds period) {
+    stop_logging();
+    std::lock_guard<std::mutex> lock(logging_mutex_);
+    logging_        = true;
+    logging_thread_ = std::thread([this, period] {
+        std::unique_lock<std::mutex> lock(logging_mutex_);
+        while (!logging_cond_.wait_for(lock, period, [this] { return !logging_; })) {
+            lock.unlock();
+            std::ostringstream oss;
+            oss << "Pools occupancy:";
+            for (const auto &entry : snapshot()) {
+                oss << "\n  " << entry.name_ << ": " << entry.statistics_;
+            }
+            MV_SDK_LOG_INFO() << oss.str();
+            lock.lock();
+        }
+    });
+}
+
+void PoolRegistry::stop_logging() {
+    std::thread thread;
+    {
+        std::lock_guard<std::mutex> lock(logging_mutex_);
+        logging_ = false;
+        thread   = std::move(logging_thread_);
+    }
+    logging_cond_.notify_all();
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+} // namespace Metavision
@@ -0,0 +1,81 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <pthread.h>
+#include <sched.h>
+#elif defined(_WIN32)
+#include <windows.h>
+#endif
+
+#include "metavision/sdk/base/utils/thread_policy.h"
+
+namespace Metavision {
+
+namespace {
+
+// Names the calling thread, as far as the system supports it
+void set_thread_name(const std::string &name) {
+#if defined(__linux__)
+    // names are limited to 16 bytes, including the terminating null character
+    pthread_setname_np(pthread_self(), name.substr(0, 15).c_str());
+#elif defined(__APPLE__)
+    pthread_setname_np(name.substr(0, 63).c_str());
+#elif defined(_WIN32)
+    // SetThreadDescription is only available from Windows 10 1607, hence loaded at runtime
+    using SetThreadDescriptionFunc = HRESULT(WINAPI *)(HANDLE, PCWSTR);
+    static const auto set_thread_description = reinterpret_cast<SetThreadDescriptionFunc>(
+        GetProcAddress(GetModuleHandleW(L"kernel32.dll"), "SetThreadDescription"));
+    if (set_thread_description) {
+        const std::wstring wide_name(name.begin(), name.end());
+        set_thread_description(GetCurrentThread(), wide_name.c_str());
+    }
+#endif
+}
+
+} // namespace
+
+bool apply_thread_policy(const ThreadPolicy &policy, const std::string &default_name) {
+    const std::string &name = policy.name_.empty() ? default_name : policy.name_;
+    if (!name.empty()) {
+        // The name is only a debugging aid: failing to set it does not fail the policy
+        set_thread_name(name);
+    }
+
+#ifdef __linux__
+    bool applied = true;
+
+    if (!policy.cpu_affinity_.empty()) {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        for (auto cpu : policy.cpu_affinity_) {
+            if (cpu < CPU_SETSIZE) {
+                CPU_SET(cpu, &cpus);
+            } else {
+                applied = false;
+            }
+        }
+        applied = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) == 0 && applied;
+    }
+
+    if (policy.scheduling_ != ThreadScheduling::Default) {
+        const int sched_policy = policy.scheduling_ == ThreadScheduling::Fifo ? SCHED_FIFO : SCHED_RR;
+        sched_param param;
+        param.sched_priority = policy.priority_;
+        applied              = pthread_setschedparam(pthread_self(), sched_policy, &param) == 0 && applied;
+    }
+    return applied;
+#else
+    return policy.cpu_affinity_.empty() && policy.scheduling_ == ThreadScheduling::Default;
+#endif
+}
+
+} // namespace Metavision
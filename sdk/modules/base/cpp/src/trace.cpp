@@ -0,0 +1,207 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#include "metavision/sdk/base/utils/trace.h"
+
+namespace Metavision {
+namespace Trace {
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Event {
+    char phase;       // 'X' for a scope, 'C' for a counter
+    const char *name; // Static storage, only the pointer is kept
+    int64_t ts_us;
+    int64_t value; // Duration of a scope or value of a counter
+};
+
+// Events of one thread, only contended when the tracing is started or stopped
+struct ThreadBuffer {
+    std::mutex mutex;
+    int tid = 0;
+    std::string name;
+    std::vector<Event> events;
+};
+
+struct Tracer {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    std::ofstream file;
+    Clock::time_point origin;
+    std::atomic<bool> enabled{false};
+    int next_tid = 1;
+};
+
+Tracer &tracer() {
+    // Never destroyed, as threads may still record events after the end of the main function
+    static Tracer *tracer = new Tracer();
+    return *tracer;
+}
+
+ThreadBuffer &thread_buffer() {
+    thread_local std::shared_ptr<ThreadBuffer> buffer = [] {
+        auto buffer = std::make_shared<ThreadBuffer>();
+        Tracer &t   = tracer();
+        std::lock_guard<std::mutex> lock(t.mutex);
+        buffer->tid = t.next_tid++;
+        t.buffers.push_back(buffer);
+        return buffer;
+    }();
+    return *buffer;
+}
+
+int64_t now_us() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - tracer().origin).count();
+}
+
+void record(const Event &event) {
+    ThreadBuffer &buffer = thread_buffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    buffer.events.push_back(event);
+}
+
+void write_escaped(std::ostream &os, const char *str) {
+    for (; *str; ++str) {
+        if (*str == '"' || *str == '\\') {
+            os << '\\' << *str;
+        } else if (static_cast<unsigned char>(*str) >= 0x20) {
+            os << *str;
+        }
+    }
+}
+
+void stop_locked(Tracer &t) {
+    if (!t.enabled.exchange(false)) {
+        return;
+    }
+
+    std::ostream &os = t.file;
+    const char *sep  = "\n";
+    os << "{\"traceEvents\":[";
+    for (const auto &buffer : t.buffers) {
+        std::vector<Event> events;
+        std::string name;
+        {
+            std::lock_guard<std::mutex> lock(buffer->mutex);
+            events.swap(buffer->events);
+            name = buffer->name;
+        }
+        if (!name.empty()) {
+            os << sep << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" << buffer->tid
+               << ",\"args\":{\"name\":\"";
+            write_escaped(os, name.c_str());
+            os << "\"}}";
+            sep = ",\n";
+        }
+        for (const auto &event : events) {
+            os << sep << "{\"ph\":\"" << event.phase << "\",\"name\":\"";
+            write_escaped(os, event.name);
+            os << "\",\"pid\":1,\"tid\":" << buffer->tid << ",\"ts\":" << event.ts_us;
+            if (event.phase == 'X') {
+                os << ",\"dur\":" << event.value << "}";
+            } else {
+                os << ",\"args\":{\"value\":" << event.value << "}}";
+            }
+            sep = ",\n";
+        }
+    }
+    os << "\n]}\n";
+    t.file.close();
+
+    // Forgets the buffers of the threads that have exited
+    auto last = std::remove_if(t.buffers.begin(), t.buffers.end(),
+                               [](const std::shared_ptr<ThreadBuffer> &buffer) { return buffer.use_count() == 1; });
+    t.buffers.erase(last, t.buffers.end());
+}
+
+#ifdef METAVISION_TRACING_ENABLED
+struct EnvironmentTracing {
+    EnvironmentTracing() {
+        const char *path = std::getenv("MV_TRACE_FILE");
+        if (!path || !*path) {
+            return;
+        }
+        try {
+            start(path);
+            std::atexit([] { stop(); });
+        } catch (const std::exception &e) {
+            // The logging may not be initialized yet
+            std::cerr << e.what() << std::endl;
+        }
+    }
+} environment_tracing;
+#endif
+
+} // namespace
+
+void start(const std::string &path) {
+    Tracer &t = tracer();
+    std::lock_guard<std::mutex> lock(t.mutex);
+    stop_locked(t);
+
+    t.file.open(path);
+    if (!t.file.is_open()) {
+        throw std::runtime_error("Failed to open the trace file " + path);
+    }
+    // Drops the events recorded by scopes that were ending while the previous tracing stopped
+    for (const auto &buffer : t.buffers) {
+        std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+        buffer->events.clear();
+    }
+    t.origin = Clock::now();
+    t.enabled.store(true);
+}
+
+void stop() {
+    Tracer &t = tracer();
+    std::lock_guard<std::mutex> lock(t.mutex);
+    stop_locked(t);
+}
+
+bool is_enabled() {
+    return tracer().enabled.load(std::memory_order_acquire);
+}
+
+void set_thread_name(const std::string &name) {
+    // Kept even if the tracing is not enabled yet, as threads are usually named once when they start
+    ThreadBuffer &buffer = thread_buffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    buffer.name = name;
+}
+
+void counter(const char *name, int64_t value) {
+    if (is_enabled()) {
+        record({'C', name, now_us(), value});
+    }
+}
+
+Scope::Scope(const char *name) : name_(is_enabled() ? name : nullptr), begin_us_(name_ ? now_us() : 0) {}
+
+Scope::~Scope() {
+    if (name_ && is_enabled()) {
+        record({'X', name_, begin_us_, now_us() - begin_us_});
+    }
+}
+
+} // namespace Trace
+} // namespace Metavision
@@ -0,0 +1,127 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <atomic>
+#include <functional>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+#include "metavision/sdk/base/utils/callback_list.h"
+
+using CallbackList = Metavision::CallbackList<std::function<void(int)>>;
+
+TEST(CallbackList_GTest, calls_callbacks_in_order_of_addition) {
+    CallbackList cbs;
+    std::vector<int> calls;
+
+    // WHEN adding callbacks with ids not in increasing order
+    cbs.add(5, [&](int v) { calls.push_back(10 * v + 1); });
+    cbs.add(2, [&](int v) { calls.push_back(10 * v + 2); });
+    cbs.add(8, [&](int v) { calls.push_back(10 * v + 3); });
+
+    // THEN they are called in the order they have been added
+    cbs(1);
+    ASSERT_EQ(std::vector<int>({11, 12, 13}), calls);
+    ASSERT_EQ(3, cbs.size());
+}
+
+TEST(CallbackList_GTest, remove_callback) {
+    CallbackList cbs;
+    std::vector<int> calls;
+    cbs.add(0, [&](int v) { calls.push_back(1); });
+    cbs.add(1, [&](int v) { calls.push_back(2); });
+    cbs.add(2, [&](int v) { calls.push_back(3); });
+
+    // WHEN removing a callback
+    ASSERT_TRUE(cbs.remove(1));
+
+    // THEN it is not called anymore, and can not be removed twice
+    ASSERT_FALSE(cbs.remove(1));
+    ASSERT_FALSE(cbs.remove(42));
+    cbs(0);
+    ASSERT_EQ(std::vector<int>({1, 3}), calls);
+
+    // WHEN clearing the list
+    cbs.clear();
+
+    // THEN no callback is called
+    ASSERT_TRUE(cbs.empty());
+    calls.clear();
+    cbs(0);
+    ASSERT_TRUE(calls.empty());
+}
+
+TEST(CallbackList_GTest, snapshot_is_not_modified_by_later_changes) {
+    CallbackList cbs;
+    int n_calls = 0;
+    cbs.add(0, [&](int) { ++n_calls; });
+
+    // GIVEN the callbacks of the list at some point
+    auto snapshot = cbs.get();
+
+    // WHEN modifying the list
+    cbs.remove(0);
+    cbs.add(1, [&](int) { n_calls += 10; });
+    cbs.add(2, [&](int) { n_calls += 100; });
+
+    // THEN the snapshot still holds the callbacks it was taken with, which can still be called
+    ASSERT_EQ(1, snapshot->size());
+    (*snapshot)[0](0);
+    ASSERT_EQ(1, n_calls);
+    ASSERT_EQ(2, cbs.get()->size());
+}
+
+TEST(CallbackList_GTest, callback_can_modify_the_list_while_dispatched) {
+    CallbackList cbs;
+    int n_calls = 0;
+
+    // GIVEN a callback removing itself and adding another one
+    cbs.add(0, [&](int) {
+        ++n_calls;
+        cbs.remove(0);
+        cbs.add(1, [&](int) { n_calls += 10; });
+    });
+
+    // WHEN dispatching twice
+    cbs(0);
+    ASSERT_EQ(1, n_calls);
+    cbs(0);
+
+    // THEN the modification only applies from the next dispatch
+    ASSERT_EQ(11, n_calls);
+}
+
+TEST(CallbackList_GTest, add_and_remove_while_dispatching_from_another_thread) {
+    CallbackList cbs;
+    std::atomic<int> sum{0};
+    std::atomic<bool> done{false};
+    cbs.add(0, [&](int v) { sum += v; });
+
+    // GIVEN a thread dispatching continuously
+    std::thread dispatcher([&]() {
+        while (!done) {
+            cbs(1);
+        }
+    });
+
+    // WHEN adding and removing callbacks from this thread
+    for (size_t i = 1; i < 1000; ++i) {
+        cbs.add(i, [&](int v) { sum += v; });
+        ASSERT_TRUE(cbs.remove(i));
+    }
+    done = true;
+    dispatcher.join();
+
+    // THEN only the first callback remains
+    ASSERT_EQ(1, cbs.size());
+    ASSERT_LT(0, sum.load());
+}
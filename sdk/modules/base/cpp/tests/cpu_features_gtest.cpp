@@ -0,0 +1,169 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <numeric>
+#include <string>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "metavision/sdk/base/utils/cpu_features.h"
+
+namespace Metavision {
+namespace simd_test {
+#define MV_DECLARE_SIMD_TEST_KERNELS(variant)                     \
+    namespace variant {                                           \
+    const char *variant_name();                                   \
+    std::int64_t sum(const std::int32_t *data, std::size_t size); \
+    }
+MV_DECLARE_SIMD_TEST_KERNELS(scalar)
+MV_DECLARE_SIMD_TEST_KERNELS(avx2)
+MV_DECLARE_SIMD_TEST_KERNELS(avx512)
+MV_DECLARE_SIMD_TEST_KERNELS(neon)
+} // namespace simd_test
+} // namespace Metavision
+
+using namespace Metavision;
+
+namespace {
+using NameKernel = const char *(*)();
+using SumKernel  = std::int64_t (*)(const std::int32_t *, std::size_t);
+
+NameKernel select_name_kernel() {
+    const std::initializer_list<SimdVariant<NameKernel>> variants = {
+#ifdef METAVISION_SIMD_AVX2
+        {SimdLevel::AVX2, &simd_test::avx2::variant_name},
+#endif
+#ifdef METAVISION_SIMD_AVX512
+        {SimdLevel::AVX512, &simd_test::avx512::variant_name},
+#endif
+#ifdef METAVISION_SIMD_NEON
+        {SimdLevel::NEON, &simd_test::neon::variant_name},
+#endif
+    };
+    return select_simd_variant<NameKernel>(&simd_test::scalar::variant_name, variants);
+}
+
+void set_simd_level_limit(const char *level) {
+#ifdef _WIN32
+    std::string s("MV_SIMD_LEVEL=");
+    s += level;
+    _putenv(s.c_str());
+#else
+    if (*level) {
+        setenv("MV_SIMD_LEVEL", level, 1);
+    } else {
+        unsetenv("MV_SIMD_LEVEL");
+    }
+#endif
+}
+} // namespace
+
+TEST(CpuFeatures_GTest, consistent_features) {
+    // GIVEN the features of the CPU
+    const CpuFeatures &features = get_cpu_features();
+
+    // THEN the extensions of an instruction set are only reported along with it
+    if (features.avx2_ || features.fma_) {
+        EXPECT_TRUE(features.avx_);
+    }
+    if (features.avx512bw_ || features.avx512vl_) {
+        EXPECT_TRUE(features.avx512f_);
+    }
+#if defined(__x86_64__) || defined(_M_X64)
+    EXPECT_TRUE(features.sse2_);
+#endif
+#if defined(__aarch64__) || defined(_M_ARM64)
+    EXPECT_TRUE(features.neon_);
+#endif
+}
+
+TEST(CpuFeatures_GTest, best_simd_level_is_supported) {
+    // WHEN getting the most capable SIMD level
+    const SimdLevel level = get_simd_level();
+
+    // THEN it is supported, and so is the scalar one
+    EXPECT_TRUE(is_simd_level_supported(level));
+    EXPECT_TRUE(is_simd_level_supported(SimdLevel::Scalar));
+#if defined(__AVX2__)
+    // AND it is at least the level the tests are compiled for
+    EXPECT_GE(level, SimdLevel::AVX2);
+#endif
+}
+
+TEST(CpuFeatures_GTest, simd_level_limited_by_environment) {
+    // WHEN limiting the SIMD level to the scalar one with the environment variable
+    set_simd_level_limit("SCALAR");
+    const SimdLevel level     = get_simd_level();
+    const bool sse2_supported = is_simd_level_supported(SimdLevel::SSE2);
+    const bool neon_supported = is_simd_level_supported(SimdLevel::NEON);
+    const std::string name    = select_name_kernel()();
+    set_simd_level_limit("");
+
+    // THEN no SIMD level is supported and the scalar variant is selected
+    EXPECT_EQ(SimdLevel::Scalar, level);
+    EXPECT_FALSE(sse2_supported);
+    EXPECT_FALSE(neon_supported);
+    EXPECT_EQ("scalar", name);
+}
+
+TEST(CpuFeatures_GTest, select_best_variant) {
+    // WHEN selecting the variant of a kernel
+    const std::string name = select_name_kernel()();
+
+    // THEN the variant of the most capable level supported, among the ones compiled, is selected
+    std::string expected = "scalar";
+#ifdef METAVISION_SIMD_AVX2
+    if (is_simd_level_supported(SimdLevel::AVX2)) {
+        expected = "avx2";
+    }
+#endif
+#ifdef METAVISION_SIMD_AVX512
+    if (is_simd_level_supported(SimdLevel::AVX512)) {
+        expected = "avx512";
+    }
+#endif
+#ifdef METAVISION_SIMD_NEON
+    if (is_simd_level_supported(SimdLevel::NEON)) {
+        expected = "neon";
+    }
+#endif
+    EXPECT_EQ(expected, name);
+}
+
+TEST(CpuFeatures_GTest, variants_give_same_results) {
+    // GIVEN some data
+    std::vector<std::int32_t> data(1000);
+    std::iota(data.begin(), data.end(), -300);
+    const std::int64_t expected = simd_test::scalar::sum(data.data(), data.size());
+
+    // WHEN computing the same result with every variant supported
+    std::vector<std::pair<SimdLevel, SumKernel>> variants;
+#ifdef METAVISION_SIMD_AVX2
+    variants.emplace_back(SimdLevel::AVX2, &simd_test::avx2::sum);
+#endif
+#ifdef METAVISION_SIMD_AVX512
+    variants.emplace_back(SimdLevel::AVX512, &simd_test::avx512::sum);
+#endif
+#ifdef METAVISION_SIMD_NEON
+    variants.emplace_back(SimdLevel::NEON, &simd_test::neon::sum);
+#endif
+
+    // THEN the results are the same
+    for (const auto &variant : variants) {
+        if (is_simd_level_supported(variant.first)) {
+            EXPECT_EQ(expected, variant.second(data.data(), data.size())) << to_string(variant.first);
+        }
+    }
+}
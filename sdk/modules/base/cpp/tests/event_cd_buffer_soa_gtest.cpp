@@ -0,0 +1,71 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "metavision/sdk/base/events/event_cd_buffer_soa.h"
+
+using namespace Metavision;
+
+TEST(EventCDBufferSoA_GTest, push_back_and_get_event) {
+    // GIVEN an empty buffer
+    EventCDBufferSoA buffer;
+    ASSERT_TRUE(buffer.empty());
+
+    // WHEN appending events
+    buffer.push_back(1, 2, 1, 3);
+    buffer.push_back(EventCD(4, 5, 0, 6));
+
+    // THEN each field is stored in its own array
+    ASSERT_EQ(2, buffer.size());
+    EXPECT_EQ(1, buffer.x()[0]);
+    EXPECT_EQ(5, buffer.y()[1]);
+    EXPECT_EQ(1, buffer.p()[0]);
+    EXPECT_EQ(6, buffer.t()[1]);
+    const EventCD ev = buffer.get_event(1);
+    EXPECT_EQ(4, ev.x);
+    EXPECT_EQ(5, ev.y);
+    EXPECT_EQ(0, ev.p);
+    EXPECT_EQ(6, ev.t);
+}
+
+TEST(EventCDBufferSoA_GTest, conversion_from_and_to_array_of_events) {
+    std::vector<EventCD> events;
+    for (unsigned short i = 0; i < 100; ++i) {
+        events.emplace_back(i, 2 * i, i % 2, 10 * i);
+    }
+
+    // GIVEN a buffer filled from an array of events
+    EventCDBufferSoA buffer;
+    buffer.push_back(7, 7, 7, 7);
+    buffer.assign(events.cbegin(), events.cbegin() + 50);
+    buffer.append(events.cbegin() + 50, events.cend());
+
+    // WHEN converting it back to an array of events
+    std::vector<EventCD> output;
+    buffer.copy_to(std::back_inserter(output));
+
+    // THEN the events are unchanged
+    ASSERT_EQ(events.size(), output.size());
+    for (size_t i = 0; i < events.size(); ++i) {
+        EXPECT_EQ(events[i].x, output[i].x);
+        EXPECT_EQ(events[i].y, output[i].y);
+        EXPECT_EQ(events[i].p, output[i].p);
+        EXPECT_EQ(events[i].t, output[i].t);
+    }
+
+    // WHEN clearing it
+    buffer.clear();
+
+    // THEN it is empty
+    ASSERT_TRUE(buffer.empty());
+}
@@ -0,0 +1,123 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "metavision/sdk/base/events/event_cd_compact.h"
+
+using namespace Metavision;
+
+TEST(EventCDCompact_GTest, packs_the_fields_in_8_bytes) {
+    // GIVEN events at the limits of the supported geometry
+    const EventCDCompact ev(2047, 1023, 1, 4000000000u);
+    const EventCDCompact ev_origin(0, 0, 0, 0);
+
+    // THEN the fields are read back unchanged
+    EXPECT_EQ(8, sizeof(EventCDCompact));
+    EXPECT_EQ(2047, ev.x());
+    EXPECT_EQ(1023, ev.y());
+    EXPECT_EQ(1, ev.p());
+    EXPECT_EQ(4000000000u, ev.dt);
+    EXPECT_EQ(0, ev_origin.x());
+    EXPECT_EQ(0, ev_origin.y());
+    EXPECT_EQ(0, ev_origin.p());
+    const EventCD ev_cd = ev.to_event_cd(10000000000);
+    EXPECT_EQ(2047, ev_cd.x);
+    EXPECT_EQ(1023, ev_cd.y);
+    EXPECT_EQ(1, ev_cd.p);
+    EXPECT_EQ(14000000000, ev_cd.t);
+}
+
+TEST(EventCDCompactBuffer_GTest, conversion_from_and_to_array_of_events) {
+    std::vector<EventCD> events;
+    for (unsigned short i = 0; i < 100; ++i) {
+        events.emplace_back(i, 2 * i, i % 2, 5000000000 + 10 * i);
+    }
+
+    // GIVEN a buffer filled from an array of events
+    EventCDCompactBuffer buffer;
+    buffer.push_back(EventCD(7, 7, 1, 7));
+    buffer.assign(events.cbegin(), events.cbegin() + 50);
+    buffer.append(events.cbegin() + 50, events.cend());
+
+    // THEN the timestamps are relative to the first event
+    ASSERT_EQ(events.size(), buffer.size());
+    EXPECT_EQ(5000000000, buffer.base_time());
+    EXPECT_EQ(0u, buffer.data()[0].dt);
+    EXPECT_EQ(990u, buffer.data()[99].dt);
+
+    // WHEN converting it back to an array of events
+    std::vector<EventCD> output;
+    buffer.copy_to(std::back_inserter(output));
+
+    // THEN the events are unchanged
+    ASSERT_EQ(events.size(), output.size());
+    for (size_t i = 0; i < events.size(); ++i) {
+        EXPECT_EQ(events[i].x, output[i].x);
+        EXPECT_EQ(events[i].y, output[i].y);
+        EXPECT_EQ(events[i].p, output[i].p);
+        EXPECT_EQ(events[i].t, output[i].t);
+    }
+}
+
+TEST(EventCDCompactBuffer_GTest, base_time_set_on_reset) {
+    // GIVEN a buffer reset with a base time
+    EventCDCompactBuffer buffer;
+    buffer.reset(1000);
+
+    // WHEN adding events
+    buffer.push_back(EventCD(1, 2, 0, 1500));
+
+    // THEN their timestamps are relative to the base time
+    EXPECT_EQ(1000, buffer.base_time());
+    EXPECT_EQ(500u, buffer.data()[0].dt);
+    EXPECT_EQ(1500, buffer.get_event(0).t);
+}
+
+TEST(EventCDCompactBuffer_GTest, rejects_events_that_do_not_fit) {
+    EventCDCompactBuffer buffer;
+    buffer.reset(1000);
+    EXPECT_THROW(buffer.push_back(EventCD(2048, 0, 0, 1000)), std::invalid_argument);
+    EXPECT_THROW(buffer.push_back(EventCD(0, 1024, 0, 1000)), std::invalid_argument);
+    EXPECT_THROW(buffer.push_back(EventCD(0, 0, 0, 999)), std::invalid_argument);
+    EXPECT_THROW(buffer.push_back(EventCD(0, 0, 0, 1000 + (timestamp(1) << 32))), std::invalid_argument);
+    EXPECT_TRUE(buffer.empty());
+}
+
+TEST(EventCDCompactBuffer_GTest, unchanged_when_a_range_does_not_fit) {
+    // GIVEN a buffer holding an event, and a range whose last event does not fit
+    EventCDCompactBuffer buffer;
+    buffer.push_back(EventCD(1, 2, 0, 1000));
+    const std::vector<EventCD> events = {EventCD(3, 4, 1, 1100), EventCD(2048, 0, 0, 1200)};
+
+    // WHEN appending or assigning the range
+    EXPECT_THROW(buffer.append(events.cbegin(), events.cend()), std::invalid_argument);
+    EXPECT_THROW(buffer.assign(events.cbegin(), events.cend()), std::invalid_argument);
+
+    // THEN the buffer is left unchanged
+    ASSERT_EQ(1u, buffer.size());
+    EXPECT_EQ(1000, buffer.base_time());
+    EXPECT_EQ(1, buffer.get_event(0).x);
+    EXPECT_EQ(1000, buffer.get_event(0).t);
+
+    // GIVEN an empty buffer
+    EventCDCompactBuffer empty_buffer;
+
+    // WHEN adding events that do not fit
+    EXPECT_THROW(empty_buffer.assign(events.cbegin() + 1, events.cend()), std::invalid_argument);
+    EXPECT_THROW(empty_buffer.push_back(events[1]), std::invalid_argument);
+
+    // THEN the base time is still set by the next event added
+    empty_buffer.push_back(events[0]);
+    EXPECT_EQ(1u, empty_buffer.size());
+    EXPECT_EQ(1100, empty_buffer.base_time());
+}
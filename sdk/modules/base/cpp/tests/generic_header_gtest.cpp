@@ -204,6 +204,30 @@ TEST(GenericHeader_GTest, input_header_non_empty_and_set_new_field) {
     ASSERT_NE(std::string::npos, header.to_string().find(expected_other_field_line));
 }
 
+TEST(GenericHeader_GTest, stream_with_irregular_spacing) {
+    // GIVEN a valid istream with a header whose fields are separated by several spaces, tabs or a carriage return
+    std::stringstream ss;
+    ss << "%   Key   First\tSecond  Third \r\n"
+          "% KeyWithoutValue\n"
+          "%    \n"
+          "% Last Value\n"
+          "Data";
+
+    // WHEN building a generic header from it
+    Metavision::GenericHeader header(ss);
+
+    // THEN the values are the fields following the key, separated by a single space
+    ASSERT_EQ(3, header.get_header_map().size());
+    EXPECT_EQ("First Second Third", header.get_field("Key"));
+    EXPECT_EQ("", header.get_field("KeyWithoutValue"));
+    EXPECT_EQ("Value", header.get_field("Last"));
+
+    // AND THEN the stream is positioned after the header
+    std::string data;
+    ss >> data;
+    EXPECT_EQ("Data", data);
+}
+
 TEST(GenericHeader_GTest, stream_with_date) {
     // GIVEN a valid istream with a header containing a date
     std::stringstream ss;
@@ -0,0 +1,403 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <gtest/gtest.h>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <atomic>
+
+#include "metavision/sdk/base/utils/lock_free_object_pool.h"
+
+TEST(LockFreeObjectPool_GTest, default_constructible) {
+    // WHEN creating a shared object pool with default constructor
+    Metavision::SharedLockFreeObjectPool<int> pool;
+
+    // THEN size is not null
+    ASSERT_NE(0, pool.size());
+
+    // WHEN acquiring an object
+    // THEN the pool does not stall (buffer available)
+    auto object = pool.acquire();
+
+    // THEN the object acquired is not null
+    ASSERT_NE(nullptr, object.get());
+}
+
+TEST(LockFreeObjectPool_GTest, bounded) {
+    // WHEN creating a bounded shared object pool with static builder
+    auto pool = Metavision::SharedLockFreeObjectPool<int>::make_bounded(10);
+
+    // THEN the pool has the requested size
+    ASSERT_EQ(10, pool.size());
+
+    // WHEN acquiring an object
+    // THEN the pool does not stall (buffer available)
+    auto object = pool.acquire();
+
+    // THEN the object acquired is not null
+    ASSERT_NE(nullptr, object.get());
+
+    // THEN the size of the pool has decreased by one
+    ASSERT_EQ(9, pool.size());
+
+    // WHEN releasing the object
+    object.reset();
+
+    // THEN the pool size is increased by 1
+    ASSERT_EQ(10, pool.size());
+}
+
+TEST(LockFreeObjectPool_GTest, bounded_forward_param) {
+    // WHEN creating a bounded shared object pool with static builder and we forward argument for object allocation
+    auto pool = Metavision::SharedLockFreeObjectPool<std::vector<int>>::make_bounded(10, 100, 5);
+
+    // THEN the pool has the requested size
+    ASSERT_EQ(10, pool.size());
+
+    // WHEN acquiring an object
+    // THEN the pool does not stall (buffer available)
+    auto object = pool.acquire();
+
+    // THEN the object acquired is not null
+    ASSERT_NE(nullptr, object.get());
+
+    // THEN the size of the pool has decreased by one
+    ASSERT_EQ(9, pool.size());
+
+    // THEN the object has the expected init parameters
+    ASSERT_EQ(100, object->size());
+    for (auto data : *object) {
+        ASSERT_EQ(5, data);
+    }
+
+    // WHEN releasing the object
+    object.reset();
+
+    // THEN the pool size is increased by 1
+    ASSERT_EQ(10, pool.size());
+}
+
+TEST(LockFreeObjectPool_GTest, bounded_overflow) {
+    // WHEN creating a bounded shared object pool with static builder
+    auto pool = Metavision::SharedLockFreeObjectPool<int>::make_bounded(1);
+
+    // THEN the pool has the requested size
+    ASSERT_EQ(1, pool.size());
+
+    // WHEN acquiring an object
+    // THEN the pool does not stall (buffer available)
+    auto object = pool.acquire();
+
+    // THEN the object acquired is not null
+    ASSERT_NE(nullptr, object.get());
+
+    // THEN the size of the pool has decreased by one
+    ASSERT_EQ(0, pool.size());
+
+    // WHEN request acquisition of an object but the object pool is empty
+    // THEN the method stall until a buffer is given back to the pool
+    std::mutex acquire_success_mutex;
+    std::condition_variable acquire_success_cond;
+    bool acquire_success{false};
+    std::thread release_thread([&]() {
+        object = pool.acquire();
+
+        std::lock_guard<std::mutex> lock(acquire_success_mutex);
+        acquire_success = true;
+        acquire_success_cond.notify_all();
+    });
+
+    while (!release_thread.joinable()) {}
+    std::unique_lock<std::mutex> lock(acquire_success_mutex);
+    auto ret = acquire_success_cond.wait_for(lock, std::chrono::seconds(1), [&]() { return acquire_success; });
+    ASSERT_FALSE(ret);
+
+    // WHEN a buffer is given back in the pool
+    // THEN then the acquire method returns
+    object.reset();
+    acquire_success_cond.wait(lock, [&]() { return acquire_success; });
+    ASSERT_TRUE(acquire_success); // redundant with above cond var returning
+    ASSERT_NE(nullptr, object.get());
+
+    // THEN the size of the pool is still 0
+    ASSERT_EQ(0, pool.size());
+
+    // WHEN releasing the object
+    object.reset();
+
+    // THEN the pool size is increased by 1
+    ASSERT_EQ(1, pool.size());
+
+    release_thread.join();
+}
+
+TEST(LockFreeObjectPool_GTest, unbounded) {
+    // WHEN creating an unbounded shared object pool with static builder
+    auto pool = Metavision::SharedLockFreeObjectPool<int>::make_unbounded(10);
+
+    // THEN the pool has the requested size
+    ASSERT_EQ(10, pool.size());
+
+    // WHEN acquiring an object
+    // THEN the pool does not stall (buffer available)
+    auto object = pool.acquire();
+
+    // THEN the object acquired is not null
+    ASSERT_NE(nullptr, object.get());
+
+    // THEN the size of the pool has decreased by one
+    ASSERT_EQ(9, pool.size());
+
+    // WHEN releasing the object
+    object.reset();
+
+    // THEN the pool size is increased by 1
+    ASSERT_EQ(10, pool.size());
+}
+
+TEST(LockFreeObjectPool_GTest, unbounded_forward_param) {
+    // WHEN creating an unbounded shared object pool with static builder and we forward argument for object allocation
+    auto pool = Metavision::SharedLockFreeObjectPool<std::vector<int>>::make_unbounded(10, 100, 5);
+
+    // THEN the pool has the requested size
+    ASSERT_EQ(10, pool.size());
+
+    // WHEN acquiring an object
+    // THEN the pool does not stall (buffer available)
+    auto object = pool.acquire();
+
+    // THEN the object acquired is not null
+    ASSERT_NE(nullptr, object.get());
+
+    // THEN the size of the pool has decreased by one
+    ASSERT_EQ(9, pool.size());
+
+    // THEN the object has the expected init parameters
+    ASSERT_EQ(100, object->size());
+    for (auto data : *object) {
+        ASSERT_EQ(5, data);
+    }
+
+    // WHEN releasing the object
+    object.reset();
+
+    // THEN the pool size is increased by 1
+    ASSERT_EQ(10, pool.size());
+}
+
+TEST(LockFreeObjectPool_GTest, unbounded_overflow) {
+    // WHEN creating an unbounded shared object pool with static builder
+    auto pool = Metavision::SharedLockFreeObjectPool<int>::make_unbounded(1);
+
+    // THEN the pool has the requested size
+    ASSERT_EQ(1, pool.size());
+
+    // WHEN acquiring an object
+    // THEN the pool does not stall (buffer available)
+    auto object = pool.acquire();
+
+    // THEN the object acquired is not null
+    ASSERT_NE(nullptr, object.get());
+
+    // THEN the size of the pool has decreased by one
+    ASSERT_EQ(0, pool.size());
+
+    // WHEN request acquisition of an object but the object pool is empty
+    // THEN the method does not stall and allocate a new buffer
+    auto new_object = pool.acquire();
+
+    // THEN the object acquired is not null
+    ASSERT_NE(nullptr, new_object.get());
+
+    // THEN the size of the pool is still 0
+    ASSERT_EQ(0, pool.size());
+
+    // WHEN releasing the object
+    object.reset();
+
+    // THEN the pool size is increased by 1
+    ASSERT_EQ(1, pool.size());
+}
+
+TEST(LockFreeObjectPool_GTest, move) {
+    // WHEN creating an unbounded shared object pool with static builder
+    auto pool = Metavision::SharedLockFreeObjectPool<int>::make_unbounded(10);
+
+    // THEN the pool has the requested size
+    ASSERT_EQ(10, pool.size());
+
+    // WHEN acquiring an object
+    // THEN the pool does not stall (buffer available)
+    auto object = pool.acquire();
+
+    // THEN the size of the pool has decreased by one
+    ASSERT_EQ(9, pool.size());
+
+    // WHEN moving the object pool
+    // THEN no crashed occur
+    auto moved_pool = std::move(pool);
+
+    // THEN the size of the moved pool has is the same
+    ASSERT_EQ(9, moved_pool.size());
+
+    // WHEN resetting the object
+    object.reset();
+
+    // THEN no crash occur: object is given back to the moved pool
+    ASSERT_EQ(10, moved_pool.size());
+}
+
+TEST(LockFreeObjectPool_GTest, deleted_object_pool_with_object_in_the_wild) {
+    // WHEN creating an unbounded shared object pool with static builder
+    auto pool = std::make_unique<Metavision::SharedLockFreeObjectPool<int>>(
+        Metavision::SharedLockFreeObjectPool<int>::make_unbounded(10));
+
+    // THEN the pool has the requested size
+    ASSERT_EQ(10, pool->size());
+
+    // WHEN acquiring an object
+    // THEN the pool does not stall (buffer available)
+    auto object = pool->acquire();
+
+    // THEN the size of the pool has decreased by one
+    ASSERT_EQ(9, pool->size());
+
+    // WHEN releasing the object pool
+    // THEN no crashed occur
+    pool.reset(nullptr);
+
+    // WHEN reseting the object
+    // THEN no crash occur: object is deleted instead of being brought back to the pool
+    object.reset();
+}
+
+TEST(LockFreeObjectPool_GTest, unique_ptr_objects_come_back_to_the_pool) {
+    // WHEN creating a bounded object pool returning unique pointers
+    auto pool = Metavision::LockFreeObjectPool<int>::make_bounded(2);
+
+    // WHEN acquiring all the objects and writing to them
+    auto object1 = pool.acquire();
+    auto object2 = pool.acquire();
+    *object1     = 1;
+    *object2     = 2;
+    ASSERT_TRUE(pool.empty());
+
+    // WHEN releasing them
+    object1.reset();
+    object2.reset();
+
+    // THEN the same objects are acquired again
+    ASSERT_EQ(2, pool.size());
+    object1 = pool.acquire();
+    object2 = pool.acquire();
+    ASSERT_EQ(3, *object1 + *object2);
+}
+
+TEST(LockFreeObjectPool_GTest, add) {
+    // WHEN creating a bounded object pool
+    auto pool = Metavision::SharedLockFreeObjectPool<int>::make_bounded(1);
+
+    // WHEN adding objects to the pool
+    for (int i = 0; i < 200; ++i) {
+        pool.add(std::unique_ptr<int>(new int(i)));
+    }
+
+    // THEN the pool size is increased accordingly
+    ASSERT_EQ(201, pool.size());
+
+    // THEN all the objects can be acquired without stalling
+    std::vector<Metavision::SharedLockFreeObjectPool<int>::ptr_type> objects;
+    for (int i = 0; i < 201; ++i) {
+        objects.push_back(pool.acquire());
+        ASSERT_NE(nullptr, objects.back().get());
+    }
+    ASSERT_TRUE(pool.empty());
+
+    // WHEN releasing them
+    objects.clear();
+
+    // THEN they are all back in the pool
+    ASSERT_EQ(201, pool.size());
+}
+
+TEST(LockFreeObjectPool_GTest, concurrent_acquire_and_release_in_bounded_pool) {
+    // WHEN creating a bounded object pool with fewer objects than threads using it
+    const size_t num_objects = 3, num_threads = 8, num_iterations = 2000;
+    auto pool                = Metavision::SharedLockFreeObjectPool<int>::make_bounded(num_objects, 0);
+
+    // WHEN several threads are concurrently acquiring and releasing objects
+    std::atomic<int> num_acquired{0}, max_num_acquired{0};
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&]() {
+            for (size_t i = 0; i < num_iterations; ++i) {
+                auto object = pool.acquire();
+                const int n = ++num_acquired;
+                int max     = max_num_acquired;
+                while (n > max && !max_num_acquired.compare_exchange_weak(max, n)) {}
+                ++*object;
+                --num_acquired;
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    // THEN no more objects than the pool size have been acquired at the same time
+    ASSERT_GE(static_cast<int>(num_objects), max_num_acquired);
+
+    // THEN all the objects are back in the pool, and each acquisition has been done on one of them
+    ASSERT_EQ(num_objects, pool.size());
+    std::vector<Metavision::SharedLockFreeObjectPool<int>::ptr_type> objects;
+    int sum = 0;
+    for (size_t i = 0; i < num_objects; ++i) {
+        objects.push_back(pool.acquire());
+        sum += *objects.back();
+    }
+    ASSERT_EQ(static_cast<int>(num_threads * num_iterations), sum);
+}
+
+TEST(LockFreeObjectPool_GTest, concurrent_acquire_and_release_in_unbounded_pool) {
+    // WHEN creating an unbounded object pool with fewer objects than threads using it
+    const size_t num_threads = 8, num_iterations = 2000;
+    auto pool                = Metavision::LockFreeObjectPool<int>::make_unbounded(1, 0);
+
+    // WHEN several threads are concurrently acquiring and releasing objects
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&]() {
+            for (size_t i = 0; i < num_iterations; ++i) {
+                auto object1 = pool.acquire(0);
+                auto object2 = pool.acquire(0);
+                ++*object1;
+                ++*object2;
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    // THEN the pool allocated new objects instead of stalling, and they are all back in the pool
+    ASSERT_LE(2, pool.size());
+    ASSERT_GE(2 * num_threads, pool.size());
+    std::vector<Metavision::LockFreeObjectPool<int>::ptr_type> objects;
+    int sum = 0;
+    while (!pool.empty()) {
+        objects.push_back(pool.acquire());
+        sum += *objects.back();
+    }
+    ASSERT_EQ(static_cast<int>(2 * num_threads * num_iterations), sum);
+}
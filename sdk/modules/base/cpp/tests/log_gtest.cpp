@@ -13,6 +13,9 @@
 #include <ctime>
 #include <cstdlib>
 #include <iterator>
+#include <sstream>
+#include <thread>
+#include <vector>
 #include <gtest/gtest.h>
 #include <type_traits>
 
@@ -416,6 +419,67 @@ TEST_F(LogWithTmpDir_GTest, streams_with_env) {
     EXPECT_EQ("testbla\nyo\n", content);
 }
 
+TEST_F(LogWithTmpDir_GTest, async_streams) {
+    setLogAsync(true);
+    setLogStream(ofs_);
+    MV_LOG_INFO("") << Metavision::Log::no_space << "test"
+                    << "bla"
+                    << "\n"
+                    << "yo";
+    // The stream is only written to by the background thread, until the messages are flushed
+    flushLog();
+    setLogAsync(false);
+    ofs_.close();
+
+    std::ifstream ifs(filename_);
+    std::vector<char> buf(std::istreambuf_iterator<char>(ifs), {});
+    std::string content(buf.begin(), buf.end());
+    EXPECT_EQ("testbla\nyo\n", content);
+}
+
+TEST(Log_GTest, async_concurrent_messages) {
+    setLogLevel(LogLevel::Info);
+    resetLogLevelFromEnv();
+    resetLogAsyncFromEnv();
+    std::ostringstream oss;
+    setLogStream(oss);
+    setLogAsync(true);
+    EXPECT_TRUE(isLogAsync());
+    EXPECT_EQ(LogLevel::Info, getLogLevel());
+
+    // WHEN several threads log concurrently
+    const int num_threads = 4, num_messages = 1000;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < num_threads; ++i) {
+        threads.emplace_back([i]() {
+            for (int j = 0; j < num_messages; ++j) {
+                MV_LOG_INFO("") << Metavision::Log::no_space << i << " " << j;
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    flushLog();
+    setLogAsync(false);
+    setLogStream(std::cerr);
+
+    // THEN all the messages are written whole, in the order they have been logged by each thread
+    std::istringstream iss(oss.str());
+    std::vector<int> next(num_threads, 0);
+    std::string line;
+    int num_lines = 0;
+    while (std::getline(iss, line)) {
+        std::istringstream line_iss(line);
+        int i, j;
+        ASSERT_TRUE(static_cast<bool>(line_iss >> i >> j)) << line;
+        ASSERT_EQ(next[i], j);
+        ++next[i];
+        ++num_lines;
+    }
+    EXPECT_EQ(num_threads * num_messages, num_lines);
+}
+
 template<LogLevel level>
 using LogLevelConstant = std::integral_constant<LogLevel, level>;
 
@@ -0,0 +1,104 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "metavision/utils/gtest/gtest_with_tmp_dir.h"
+#include "metavision/sdk/base/utils/mapped_file_writer.h"
+
+using namespace Metavision;
+
+class MappedFileWriter_GTest : public GTestWithTmpDir {
+protected:
+    virtual void SetUp() override {
+        path_ = tmpdir_handler_->get_full_path("mapped.bin");
+    }
+
+    std::vector<uint8_t> read_file() const {
+        std::ifstream ifs(path_, std::ios::binary);
+        return std::vector<uint8_t>(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+    }
+
+    std::string path_;
+};
+
+TEST_F(MappedFileWriter_GTest, file_is_truncated_to_data_written) {
+    for (const auto policy :
+         {MappedFileWriterConfig::FlushPolicy::None, MappedFileWriterConfig::FlushPolicy::OnClose,
+          MappedFileWriterConfig::FlushPolicy::Background}) {
+        // GIVEN a writer with a capacity larger than the data written, flushed every few pages
+        MappedFileWriterConfig config;
+        config.capacity_     = 1024 * 1024;
+        config.flush_policy_ = policy;
+        config.flush_size_   = 10000;
+        std::vector<uint8_t> data(3000);
+        std::iota(data.begin(), data.end(), uint8_t(0));
+
+        std::vector<uint8_t> expected;
+        {
+            MappedFileWriter writer(path_, config);
+            // THEN the whole capacity is allocated while writing
+            ASSERT_EQ(config.capacity_, read_file().size());
+
+            // WHEN writing data with copies and in place
+            for (int i = 0; i < 20; ++i) {
+                ASSERT_TRUE(writer.write(data.data(), data.size()));
+                expected.insert(expected.end(), data.begin(), data.end());
+            }
+            uint8_t *dest = writer.get_write_pointer(100);
+            ASSERT_NE(nullptr, dest);
+            std::fill(dest, dest + 50, uint8_t(7));
+            writer.commit(50);
+            expected.insert(expected.end(), 50, uint8_t(7));
+            ASSERT_EQ(expected.size(), writer.get_size());
+        }
+
+        // THEN the file holds the data written only
+        ASSERT_EQ(expected, read_file());
+    }
+}
+
+TEST_F(MappedFileWriter_GTest, data_beyond_capacity_is_dropped) {
+    // GIVEN a writer of a small capacity
+    MappedFileWriterConfig config;
+    config.capacity_ = 100;
+    std::vector<uint8_t> data(60, 1);
+    MappedFileWriter writer(path_, config);
+
+    // WHEN writing more data than it can hold
+    ASSERT_TRUE(writer.write(data.data(), data.size()));
+    ASSERT_FALSE(writer.write(data.data(), data.size()));
+    ASSERT_EQ(nullptr, writer.get_write_pointer(41));
+    ASSERT_TRUE(writer.write(data.data(), 40));
+
+    // THEN the data that does not fit is dropped and counted
+    ASSERT_EQ(100u, writer.get_size());
+    ASSERT_EQ(60u, writer.get_n_dropped_bytes());
+    writer.close();
+    ASSERT_EQ(100u, read_file().size());
+
+    // THEN nothing is written once closed
+    ASSERT_FALSE(writer.write(data.data(), 1));
+}
+
+TEST_F(MappedFileWriter_GTest, invalid_configuration_throws) {
+    MappedFileWriterConfig config;
+    ASSERT_THROW(MappedFileWriter(path_, config), std::invalid_argument);
+    config.capacity_ = 100;
+    ASSERT_THROW(MappedFileWriter(tmpdir_handler_->get_full_path("missing/mapped.bin"), config), std::runtime_error);
+}
@@ -0,0 +1,87 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <cstdint>
+#include <gtest/gtest.h>
+
+#include "metavision/sdk/base/utils/lock_free_object_pool.h"
+#include "metavision/sdk/base/utils/memory_placement.h"
+#include "metavision/sdk/base/utils/object_pool.h"
+
+TEST(MemoryPlacement_GTest, default_placement_is_always_applied) {
+    // WHEN applying the default placement to a buffer
+    std::vector<std::uint8_t> buffer;
+    // THEN it succeeds and the memory is reserved
+    ASSERT_TRUE(Metavision::place_buffer(buffer, 1000, Metavision::MemoryPlacement()));
+    ASSERT_LE(1000, buffer.capacity());
+    ASSERT_TRUE(buffer.empty());
+}
+
+TEST(MemoryPlacement_GTest, current_numa_node) {
+    // WHEN getting the current numa node
+    // THEN it is either unknown or valid
+    ASSERT_LE(-1, Metavision::get_current_numa_node());
+}
+
+TEST(MemoryPlacement_GTest, invalid_numa_node) {
+    // WHEN placing a buffer on a NUMA node that can't exist
+    std::vector<std::uint8_t> buffer;
+    Metavision::MemoryPlacement placement;
+    placement.numa_node = 1 << 20;
+
+    // THEN the placement fails but the buffer is still usable
+    ASSERT_FALSE(Metavision::place_buffer(buffer, 1 << 20, placement));
+    buffer.resize(1 << 20, 1);
+    ASSERT_EQ(1, buffer.back());
+}
+
+TEST(MemoryPlacement_GTest, place_pool_buffers) {
+    // WHEN placing the buffers of a pool on the current NUMA node, with huge pages
+    auto pool = Metavision::SharedObjectPool<std::vector<std::uint8_t>>::make_bounded(3);
+    Metavision::MemoryPlacement placement;
+    placement.numa_node  = std::max(0, Metavision::get_current_numa_node());
+    placement.huge_pages = true;
+    Metavision::place_pool_buffers(pool, 4 * 1024 * 1024, placement);
+
+    // THEN all the buffers are back in the pool, with the reserved memory
+    ASSERT_EQ(3, pool.size());
+    std::vector<Metavision::SharedObjectPool<std::vector<std::uint8_t>>::ptr_type> buffers;
+    for (int i = 0; i < 3; ++i) {
+        buffers.emplace_back(pool.acquire());
+        auto &buffer = buffers.back();
+        ASSERT_LE(4 * 1024 * 1024, buffer->capacity());
+        buffer->resize(4 * 1024 * 1024, 2);
+        ASSERT_EQ(2, buffer->front());
+    }
+}
+
+TEST(MemoryPlacement_GTest, place_pool_buffers_allocated_later) {
+    // GIVEN unbounded pools whose buffers are placed
+    auto pool           = Metavision::SharedObjectPool<std::vector<std::uint8_t>>::make_unbounded(1);
+    auto lock_free_pool = Metavision::SharedLockFreeObjectPool<std::vector<std::uint8_t>>::make_unbounded(1);
+    Metavision::MemoryPlacement placement;
+    placement.huge_pages = true;
+    Metavision::place_pool_buffers(pool, 1000, placement);
+    Metavision::place_pool_buffers(lock_free_pool, 1000, placement);
+
+    // WHEN acquiring more buffers than the pools hold
+    auto buffer_1           = pool.acquire();
+    auto buffer_2           = pool.acquire();
+    auto lock_free_buffer_1 = lock_free_pool.acquire();
+    auto lock_free_buffer_2 = lock_free_pool.acquire();
+
+    // THEN the buffers allocated by the pools are placed as well
+    ASSERT_LE(1000, buffer_1->capacity());
+    ASSERT_LE(1000, buffer_2->capacity());
+    ASSERT_LE(1000, lock_free_buffer_1->capacity());
+    ASSERT_LE(1000, lock_free_buffer_2->capacity());
+}
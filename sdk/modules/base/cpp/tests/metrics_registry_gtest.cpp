@@ -0,0 +1,120 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <gtest/gtest.h>
+
+#include "metavision/sdk/base/utils/metrics_registry.h"
+#include "metavision/sdk/base/utils/object_pool.h"
+
+using namespace Metavision;
+
+namespace {
+
+const MetricSample *find_sample(const std::vector<MetricSample> &samples, const std::string &name,
+                                const std::string &label_value) {
+    auto it = std::find_if(samples.cbegin(), samples.cend(), [&](const MetricSample &s) {
+        return s.name_ == name && !s.labels_.empty() && s.labels_[0].second == label_value;
+    });
+    return it == samples.cend() ? nullptr : &*it;
+}
+
+} // namespace
+
+TEST(MetricsRegistry_GTest, snapshot_of_collectors_and_pools) {
+    // GIVEN a collector reading a counter, and a registered pool
+    auto &registry = MetricsRegistry::instance();
+    std::atomic<uint64_t> num_events{12};
+    const size_t id = registry.add([&num_events](std::vector<MetricSample> &samples) {
+        samples.push_back({"gtest_events_total", "Number of events", MetricSample::Type::Counter,
+                           {{"source", "gtest"}}, static_cast<double>(num_events.load())});
+    });
+    auto pool = SharedObjectPool<int>::make_bounded(2);
+    pool.register_statistics("metrics_gtest_pool");
+    auto object = pool.acquire();
+
+    // WHEN taking a snapshot
+    auto samples = registry.snapshot();
+
+    // THEN it holds the samples of the collector and the occupancy of the pool
+    const MetricSample *events = find_sample(samples, "gtest_events_total", "gtest");
+    ASSERT_NE(nullptr, events);
+    EXPECT_EQ(12., events->value_);
+    const MetricSample *in_use = find_sample(samples, "metavision_pool_in_use", "metrics_gtest_pool");
+    ASSERT_NE(nullptr, in_use);
+    EXPECT_EQ(1., in_use->value_);
+    EXPECT_NE(nullptr, find_sample(samples, "metavision_pool_waits_total", "metrics_gtest_pool"));
+
+    // WHEN removing the collector
+    registry.remove(id);
+
+    // THEN its samples are not in the snapshots anymore
+    samples = registry.snapshot();
+    EXPECT_EQ(nullptr, find_sample(samples, "gtest_events_total", "gtest"));
+}
+
+TEST(MetricsRegistry_GTest, periodic_reports_with_rates) {
+    // GIVEN a counter increasing by 1000 between each report
+    auto &registry = MetricsRegistry::instance();
+    std::atomic<uint64_t> num_events{0};
+    const size_t id = registry.add([&num_events](std::vector<MetricSample> &samples) {
+        samples.push_back({"gtest_rate_events_total", "Number of events", MetricSample::Type::Counter,
+                           {{"source", "gtest"}}, static_cast<double>(num_events.fetch_add(1000))});
+    });
+
+    // WHEN reporting the metrics periodically
+    std::mutex mutex;
+    std::condition_variable cond;
+    std::vector<double> rates;
+    registry.start_reporting(std::chrono::milliseconds(10), [&](const std::vector<MetricSample> &samples) {
+        if (const MetricSample *sample = find_sample(samples, "gtest_rate_events_total", "gtest")) {
+            std::lock_guard<std::mutex> lock(mutex);
+            rates.push_back(sample->rate_);
+            cond.notify_all();
+        }
+    });
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        ASSERT_TRUE(cond.wait_for(lock, std::chrono::seconds(5), [&] { return rates.size() >= 3; }));
+    }
+    registry.stop_reporting();
+    registry.remove(id);
+
+    // THEN the first report has no rate, and the next ones the increase per second since the previous report
+    EXPECT_EQ(0., rates[0]);
+    EXPECT_GT(rates[1], 0.);
+}
+
+TEST(MetricsRegistry_GTest, to_prometheus_text) {
+    // GIVEN the samples of two metrics, interleaved
+    std::vector<MetricSample> samples{
+        {"mv_events_total", "Number of events", MetricSample::Type::Counter, {{"type", "cd"}}, 12.},
+        {"mv_backlog", "Number of buffers", MetricSample::Type::Gauge, {}, 3.},
+        {"mv_events_total", "Number of events", MetricSample::Type::Counter, {{"type", "trigger \"ext\""}}, 1.5},
+    };
+
+    // WHEN formatting them
+    const std::string text = to_prometheus_text(samples);
+
+    // THEN the samples of each metric are grouped under a single description, and the labels are escaped
+    EXPECT_EQ("# HELP mv_events_total Number of events\n"
+              "# TYPE mv_events_total counter\n"
+              "mv_events_total{type=\"cd\"} 12\n"
+              "mv_events_total{type=\"trigger \\\"ext\\\"\"} 1.5\n"
+              "# HELP mv_backlog Number of buffers\n"
+              "# TYPE mv_backlog gauge\n"
+              "mv_backlog 3\n",
+              text);
+}
@@ -0,0 +1,105 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <cstdint>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/base/utils/monotonic_arena.h"
+
+using namespace Metavision;
+
+TEST(MonotonicArena_GTest, allocates_aligned_memory_lazily) {
+    // GIVEN an arena
+    MonotonicArena arena(256);
+
+    // THEN no memory is allocated until it is used
+    EXPECT_EQ(0u, arena.capacity());
+    EXPECT_EQ(0u, arena.num_block_allocations());
+
+    // WHEN allocating memory of various alignments
+    auto *c  = static_cast<char *>(arena.allocate(3, 1));
+    auto *d  = static_cast<double *>(arena.allocate(sizeof(double), alignof(double)));
+    auto *cl = arena.allocate(100, 64);
+
+    // THEN the memory is aligned as requested, in a single block
+    EXPECT_NE(nullptr, c);
+    EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(d) % alignof(double));
+    EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(cl) % 64);
+    EXPECT_EQ(1u, arena.num_block_allocations());
+    EXPECT_GE(arena.used_bytes(), 3 + sizeof(double) + 100);
+}
+
+TEST(MonotonicArena_GTest, grows_and_coalesces_blocks_on_reset) {
+    // GIVEN an arena with small blocks
+    MonotonicArena arena(64);
+
+    // WHEN allocating more than the first block can hold
+    for (int i = 0; i < 10; ++i) {
+        arena.allocate(40);
+    }
+
+    // THEN several blocks are allocated
+    const size_t capacity = arena.capacity();
+    EXPECT_LT(1u, arena.num_block_allocations());
+    EXPECT_LE(400u, capacity);
+
+    // WHEN resetting the arena
+    const size_t num_block_allocations = arena.num_block_allocations();
+    arena.reset();
+
+    // THEN the memory is released and the blocks are replaced by a single one of the same capacity
+    EXPECT_EQ(0u, arena.used_bytes());
+    EXPECT_EQ(capacity, arena.capacity());
+    EXPECT_EQ(num_block_allocations + 1, arena.num_block_allocations());
+
+    // WHEN allocating as much memory again
+    for (int i = 0; i < 10; ++i) {
+        arena.allocate(40);
+    }
+    arena.reset();
+
+    // THEN no block is allocated
+    EXPECT_EQ(num_block_allocations + 1, arena.num_block_allocations());
+}
+
+TEST(MonotonicArena_GTest, allocates_large_objects) {
+    // GIVEN an arena with small blocks
+    MonotonicArena arena(16);
+
+    // WHEN allocating an object larger than the blocks
+    auto *ptr = arena.allocate(1000, 64);
+
+    // THEN the object is allocated in a block large enough
+    EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(ptr) % 64);
+    EXPECT_LE(1000u, arena.capacity());
+}
+
+TEST(MonotonicArena_GTest, backs_standard_containers) {
+    // GIVEN a vector allocating from an arena
+    MonotonicArena arena;
+    ArenaVector<EventCD> events{ArenaAllocator<EventCD>(arena)};
+
+    // WHEN filling the vector
+    for (int i = 0; i < 1000; ++i) {
+        events.emplace_back(static_cast<unsigned short>(i), 0, 0, i);
+    }
+
+    // THEN the events are stored in the memory of the arena
+    ASSERT_EQ(1000u, events.size());
+    EXPECT_EQ(999, events.back().t);
+    EXPECT_GE(arena.used_bytes(), 1000 * sizeof(EventCD));
+
+    // THEN a copy of the arena shares none of its memory
+    MonotonicArena copy(arena);
+    EXPECT_EQ(0u, copy.capacity());
+}
@@ -279,3 +279,107 @@ TEST(ObjectPool_GTest, deleted_object_pool_with_object_in_the_wild) {
     // THEN no crash occur: object is deleted instead of being brought back to the pool
     object.reset();
 }
+
+TEST(ObjectPool_GTest, statistics) {
+    // GIVEN an unbounded pool of 2 objects
+    auto pool = Metavision::ObjectPool<int>::make_unbounded(2);
+
+    // WHEN acquiring more objects than allocated, then releasing some of them
+    auto a = pool.acquire(), b = pool.acquire(), c = pool.acquire();
+    a.reset();
+    b.reset();
+
+    // THEN the pool grew and the occupancy is counted
+    auto statistics = pool.get_statistics();
+    EXPECT_FALSE(statistics.bounded_);
+    EXPECT_EQ(3, statistics.allocated_);
+    EXPECT_EQ(1, statistics.in_use_);
+    EXPECT_EQ(3, statistics.peak_in_use_);
+    EXPECT_EQ(0, statistics.waits_);
+
+    // WHEN adding an object to the pool
+    pool.add(std::make_unique<int>(0));
+
+    // THEN it is counted as allocated
+    EXPECT_EQ(4, pool.get_statistics().allocated_);
+}
+
+TEST(ObjectPool_GTest, shrink) {
+    // GIVEN an unbounded pool of 4 objects, one of which is in use
+    auto pool   = Metavision::SharedObjectPool<int>::make_unbounded(4);
+    auto object = pool.acquire();
+
+    // WHEN shrinking it, keeping one object not in use
+    // THEN the other objects not in use are freed
+    EXPECT_EQ(2, pool.shrink(1));
+    EXPECT_EQ(1, pool.size());
+    EXPECT_EQ(2, pool.get_statistics().allocated_);
+
+    // WHEN releasing the object in use
+    object.reset();
+
+    // THEN it is given back to the pool
+    EXPECT_EQ(2, pool.size());
+    EXPECT_EQ(0, pool.get_statistics().in_use_);
+
+    // WHEN shrinking a bounded pool
+    // THEN its objects are kept
+    auto bounded_pool = Metavision::ObjectPool<int>::make_bounded(4);
+    EXPECT_EQ(0, bounded_pool.shrink());
+    EXPECT_EQ(4, bounded_pool.size());
+}
+
+TEST(ObjectPool_GTest, statistics_waits_on_bounded_pool) {
+    // GIVEN a bounded pool whose only object is in use
+    auto pool   = Metavision::SharedObjectPool<int>::make_bounded(1);
+    auto object = pool.acquire();
+
+    // WHEN acquiring an object from another thread, released later
+    std::thread thread([&pool] { pool.acquire(); });
+    while (pool.get_statistics().waits_ == 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    object.reset();
+    thread.join();
+
+    // THEN the wait is counted, and the pool did not grow
+    const auto statistics = pool.get_statistics();
+    EXPECT_TRUE(statistics.bounded_);
+    EXPECT_EQ(1, statistics.allocated_);
+    EXPECT_EQ(0, statistics.in_use_);
+    EXPECT_EQ(1, statistics.waits_);
+}
+
+TEST(ObjectPool_GTest, registered_statistics) {
+    auto find_entry = [](const std::string &name) {
+        for (const auto &entry : Metavision::PoolRegistry::instance().snapshot()) {
+            if (entry.name_ == name) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    {
+        // GIVEN a pool registered in the global registry, and an object acquired from it
+        auto pool = Metavision::SharedObjectPool<int>::make_bounded(4);
+        pool.register_statistics("registered_statistics_gtest");
+        auto object = pool.acquire();
+
+        // WHEN taking a snapshot of the registry
+        // THEN the statistics of the pool are in it
+        bool found = false;
+        for (const auto &entry : Metavision::PoolRegistry::instance().snapshot()) {
+            if (entry.name_ == "registered_statistics_gtest") {
+                found = true;
+                EXPECT_EQ(4, entry.statistics_.allocated_);
+                EXPECT_EQ(1, entry.statistics_.in_use_);
+            }
+        }
+        EXPECT_TRUE(found);
+    }
+
+    // WHEN the pool is destroyed
+    // THEN it is removed from the registry
+    EXPECT_FALSE(find_entry("registered_statistics_gtest"));
+}
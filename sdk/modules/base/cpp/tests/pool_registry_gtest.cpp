@@ -0,0 +1,89 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+#include <thread>
+#include <gtest/gtest.h>
+
+#include "metavision/sdk/base/utils/log.h"
+#include "metavision/sdk/base/utils/object_pool.h"
+#include "metavision/sdk/base/utils/pool_registry.h"
+
+using namespace Metavision;
+
+TEST(PoolRegistry_GTest, snapshot_in_registration_order) {
+    // GIVEN pools registered with a getter
+    auto &registry = PoolRegistry::instance();
+    PoolStatistics statistics;
+    statistics.allocated_ = 3;
+    const size_t first    = registry.add("first_gtest_pool", [statistics] { return statistics; });
+    const size_t second   = registry.add("second_gtest_pool", [] { return PoolStatistics(); });
+
+    // WHEN taking a snapshot
+    const auto entries = registry.snapshot();
+
+    // THEN the pools are in the order in which they were added
+    auto it_first  = std::find_if(entries.cbegin(), entries.cend(),
+                                  [](const PoolRegistry::Entry &e) { return e.name_ == "first_gtest_pool"; });
+    auto it_second = std::find_if(entries.cbegin(), entries.cend(),
+                                  [](const PoolRegistry::Entry &e) { return e.name_ == "second_gtest_pool"; });
+    ASSERT_NE(entries.cend(), it_first);
+    ASSERT_NE(entries.cend(), it_second);
+    EXPECT_LT(it_first, it_second);
+    EXPECT_EQ(3, it_first->statistics_.allocated_);
+
+    // WHEN removing the pools
+    registry.remove(first);
+    registry.remove(second);
+
+    // THEN they are not in the snapshots anymore
+    for (const auto &entry : registry.snapshot()) {
+        EXPECT_NE("first_gtest_pool", entry.name_);
+        EXPECT_NE("second_gtest_pool", entry.name_);
+    }
+}
+
+TEST(PoolRegistry_GTest, shrink_registered_pools) {
+    // GIVEN an unbounded pool registered in the registry, with objects not in use
+    auto pool = SharedObjectPool<int>::make_unbounded(8);
+    pool.register_statistics("shrunk_gtest_pool");
+    auto object = pool.acquire();
+
+    // WHEN shrinking the registered pools
+    const size_t num_freed = PoolRegistry::instance().shrink();
+
+    // THEN the objects not in use are freed
+    EXPECT_LE(7, num_freed);
+    EXPECT_EQ(0, pool.size());
+    EXPECT_EQ(1, pool.get_statistics().allocated_);
+}
+
+TEST(PoolRegistry_GTest, periodic_logging) {
+    // GIVEN a registered pool and the logs redirected to a stream
+    auto pool = SharedObjectPool<int>::make_bounded(2);
+    pool.register_statistics("logged_gtest_pool");
+    std::ostringstream oss;
+    setLogLevel(LogLevel::Info);
+    setLogStream(oss);
+
+    // WHEN logging the statistics periodically for a while
+    PoolRegistry::instance().start_logging(std::chrono::milliseconds(10));
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    PoolRegistry::instance().stop_logging();
+    resetLogStreamFromEnv();
+    resetLogLevelFromEnv();
+
+    // THEN the statistics of the pool are logged
+    const std::string expected_line("logged_gtest_pool: allocated: 2, in use: 0, peak in use: 0, waits: 0");
+    EXPECT_NE(std::string::npos, oss.str().find(expected_line));
+}
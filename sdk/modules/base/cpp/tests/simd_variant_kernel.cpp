@@ -0,0 +1,39 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <cstddef>
+#include <cstdint>
+
+#include "metavision/sdk/base/utils/cpu_features.h"
+
+// Kernel compiled once per SIMD variant, to test their selection at runtime
+#define MV_STRINGIFY_IMPL(x) #x
+#define MV_STRINGIFY(x) MV_STRINGIFY_IMPL(x)
+
+namespace Metavision {
+namespace simd_test {
+namespace MV_SIMD_VARIANT {
+
+const char *variant_name() {
+    return MV_STRINGIFY(MV_SIMD_VARIANT);
+}
+
+std::int64_t sum(const std::int32_t *data, std::size_t size) {
+    std::int64_t result = 0;
+    for (std::size_t i = 0; i < size; ++i) {
+        result += data[i];
+    }
+    return result;
+}
+
+} // namespace MV_SIMD_VARIANT
+} // namespace simd_test
+} // namespace Metavision
@@ -0,0 +1,109 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <cstdint>
+#include <numeric>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/base/utils/slab_pool.h"
+
+using namespace Metavision;
+
+TEST(SlabPool_GTest, chunks_are_aligned_on_cache_lines) {
+    // WHEN acquiring chunks whose size is not a multiple of a cache line
+    auto pool = SlabPool<EventCD>::make(5, 3);
+    std::vector<SlabChunk<EventCD> *> chunks;
+    for (int i = 0; i < 7; ++i) {
+        chunks.push_back(pool->acquire());
+    }
+
+    // THEN they all start on a cache line and have the requested capacity
+    for (auto chunk : chunks) {
+        EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(chunk->data()) % SlabPool<EventCD>::cache_line_size);
+        EXPECT_EQ(5, chunk->capacity());
+        EXPECT_TRUE(chunk->empty());
+    }
+
+    // THEN the pool has allocated whole slabs
+    EXPECT_EQ(9, pool->num_chunks());
+    EXPECT_EQ(2, pool->num_free_chunks());
+
+    // WHEN releasing the chunks
+    for (auto chunk : chunks) {
+        pool->release(chunk);
+    }
+
+    // THEN they are reused without allocation
+    EXPECT_EQ(9, pool->num_free_chunks());
+    pool->acquire();
+    EXPECT_EQ(9, pool->num_chunks());
+}
+
+TEST(SlabPool_GTest, invalid_parameters) {
+    EXPECT_THROW(SlabPool<EventCD>::make(0, 1), std::invalid_argument);
+    EXPECT_THROW(SlabPool<EventCD>::make(1, 0), std::invalid_argument);
+}
+
+TEST(SlabPool_GTest, chunked_buffer_chains_chunks) {
+    auto pool = SlabPool<int>::make(10, 2);
+    std::vector<int> values(25);
+    std::iota(values.begin(), values.end(), 0);
+
+    // WHEN inserting more values than a chunk can hold, in several times
+    std::vector<int> copy;
+    {
+        ChunkedBuffer<int> buffer(pool);
+        buffer.insert_back(values.begin(), values.begin() + 7);
+        buffer.insert_back(values.begin() + 7, values.end());
+
+        // THEN the values are stored in order in as many chunks as needed
+        ASSERT_EQ(25, buffer.size());
+        ASSERT_EQ(3, buffer.num_chunks());
+        EXPECT_EQ(10, buffer.chunk(0).size());
+        EXPECT_EQ(10, buffer.chunk(1).size());
+        EXPECT_EQ(5, buffer.chunk(2).size());
+        buffer.copy_to(std::back_inserter(copy));
+        EXPECT_EQ(values, copy);
+    }
+
+    // WHEN the buffer is destroyed
+    // THEN its chunks go back to the pool
+    EXPECT_EQ(4, pool->num_chunks());
+    EXPECT_EQ(4, pool->num_free_chunks());
+}
+
+TEST(SlabPool_GTest, concurrent_buffers) {
+    auto pool = SlabPool<int>::make(16, 4);
+
+    // WHEN several threads fill and release buffers from the same pool
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([pool, t]() {
+            std::vector<int> values(100, t), copy;
+            for (int i = 0; i < 200; ++i) {
+                ChunkedBuffer<int> buffer(pool);
+                buffer.insert_back(values.begin(), values.begin() + (i % 100));
+                copy.clear();
+                buffer.copy_to(std::back_inserter(copy));
+                ASSERT_EQ(std::vector<int>(values.begin(), values.begin() + (i % 100)), copy);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    // THEN all the chunks are back in the pool
+    EXPECT_EQ(pool->num_chunks(), pool->num_free_chunks());
+}
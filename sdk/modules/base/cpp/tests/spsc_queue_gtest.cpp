@@ -0,0 +1,105 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "metavision/sdk/base/utils/spsc_queue.h"
+
+TEST(SPSCQueue_GTest, capacity_rounded_to_power_of_two) {
+    // WHEN creating a queue with a capacity that is not a power of two
+    Metavision::SPSCQueue<int> queue(5);
+
+    // THEN the capacity is rounded up to the next power of two
+    ASSERT_EQ(8, queue.capacity());
+    ASSERT_TRUE(queue.empty());
+}
+
+TEST(SPSCQueue_GTest, push_until_full_then_pop_in_order) {
+    Metavision::SPSCQueue<int> queue(4);
+
+    // WHEN filling the queue
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(queue.try_push(i));
+    }
+
+    // THEN no more element can be pushed
+    ASSERT_FALSE(queue.try_push(4));
+    ASSERT_EQ(4, queue.size());
+
+    // WHEN popping all elements
+    // THEN they come out in the order they were pushed
+    int value;
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(queue.try_pop(value));
+        ASSERT_EQ(i, value);
+    }
+    ASSERT_FALSE(queue.try_pop(value));
+    ASSERT_EQ(nullptr, queue.front());
+}
+
+TEST(SPSCQueue_GTest, pop_releases_element) {
+    Metavision::SPSCQueue<std::shared_ptr<int>> queue(2);
+    auto ptr = std::make_shared<int>(3);
+
+    // WHEN pushing then popping a shared pointer
+    ASSERT_TRUE(queue.try_push(ptr));
+    ASSERT_EQ(2, ptr.use_count());
+    ASSERT_NE(nullptr, queue.front());
+    queue.pop();
+
+    // THEN the queue does not keep a reference on it
+    ASSERT_EQ(1, ptr.use_count());
+
+    // WHEN pushing again and clearing
+    ASSERT_TRUE(queue.try_push(ptr));
+    queue.clear();
+
+    // THEN the reference is released too
+    ASSERT_TRUE(queue.empty());
+    ASSERT_EQ(1, ptr.use_count());
+}
+
+TEST(SPSCQueue_GTest, concurrent_producer_consumer) {
+    constexpr size_t n = 200000;
+    Metavision::SPSCQueue<size_t> queue(16);
+
+    // WHEN a producer and a consumer run concurrently on a small queue
+    std::thread producer([&queue]() {
+        for (size_t i = 0; i < n;) {
+            if (queue.try_push(i)) {
+                ++i;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    std::vector<size_t> received;
+    received.reserve(n);
+    size_t value;
+    while (received.size() < n) {
+        if (queue.try_pop(value)) {
+            received.push_back(value);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+
+    // THEN every element is received exactly once and in order
+    for (size_t i = 0; i < n; ++i) {
+        ASSERT_EQ(i, received[i]);
+    }
+    ASSERT_TRUE(queue.empty());
+}
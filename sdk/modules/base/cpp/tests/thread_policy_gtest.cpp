@@ -0,0 +1,95 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <thread>
+#include <gtest/gtest.h>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "metavision/sdk/base/utils/thread_policy.h"
+
+TEST(ThreadPolicy_GTest, default_policy) {
+    // WHEN applying the default policy to a thread
+    bool applied = false;
+    std::thread([&applied]() { applied = Metavision::apply_thread_policy(Metavision::ThreadPolicy()); }).join();
+
+    // THEN it succeeds
+    ASSERT_TRUE(applied);
+}
+
+TEST(ThreadPolicy_GTest, default_policy_with_name) {
+    // WHEN applying the default policy with the name of an SDK thread
+    bool applied = false;
+    std::thread([&applied]() { applied = Metavision::apply_thread_policy(Metavision::ThreadPolicy(), "mv_test"); })
+        .join();
+
+    // THEN it succeeds on any system
+    ASSERT_TRUE(applied);
+}
+
+#ifdef __linux__
+TEST(ThreadPolicy_GTest, name) {
+    // WHEN applying a policy without name, or with a name longer than allowed by the system
+    Metavision::ThreadPolicy policy;
+    char default_name[16], name[16];
+    bool applied_default_name = false, applied_name = false;
+    std::thread([&]() {
+        applied_default_name = Metavision::apply_thread_policy(policy, "mv_test");
+        pthread_getname_np(pthread_self(), default_name, sizeof(default_name));
+        policy.name_ = "mv_test_with_a_long_name";
+        applied_name = Metavision::apply_thread_policy(policy, "mv_test");
+        pthread_getname_np(pthread_self(), name, sizeof(name));
+    }).join();
+
+    // THEN the thread is named after the default name, or the truncated name of the policy
+    ASSERT_TRUE(applied_default_name);
+    ASSERT_STREQ("mv_test", default_name);
+    ASSERT_TRUE(applied_name);
+    ASSERT_STREQ("mv_test_with_a_", name);
+}
+
+TEST(ThreadPolicy_GTest, cpu_affinity) {
+    // WHEN applying a policy restricting a thread to a CPU it is allowed to run on
+    cpu_set_t allowed_cpus;
+    ASSERT_EQ(0, sched_getaffinity(0, sizeof(allowed_cpus), &allowed_cpus));
+    unsigned int cpu = 0;
+    while (!CPU_ISSET(cpu, &allowed_cpus)) {
+        ++cpu;
+    }
+    Metavision::ThreadPolicy policy;
+    policy.cpu_affinity_ = {cpu};
+
+    bool applied = false;
+    cpu_set_t cpus;
+    std::thread([&]() {
+        applied = Metavision::apply_thread_policy(policy);
+        pthread_getaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+    }).join();
+
+    // THEN the thread only runs on this CPU
+    ASSERT_TRUE(applied);
+    ASSERT_EQ(1, CPU_COUNT(&cpus));
+    ASSERT_TRUE(CPU_ISSET(cpu, &cpus));
+}
+
+TEST(ThreadPolicy_GTest, invalid_cpu_affinity) {
+    // WHEN applying a policy with a CPU that can't exist
+    Metavision::ThreadPolicy policy;
+    policy.cpu_affinity_ = {CPU_SETSIZE};
+
+    // THEN it fails
+    bool applied = true;
+    std::thread([&]() { applied = Metavision::apply_thread_policy(policy); }).join();
+    ASSERT_FALSE(applied);
+}
+#endif
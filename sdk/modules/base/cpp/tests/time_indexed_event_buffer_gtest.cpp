@@ -0,0 +1,123 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/base/events/time_indexed_event_buffer.h"
+
+using namespace Metavision;
+
+namespace {
+// Several events share each timestamp, so that the bounds differ, and the blocks do not start on a change of timestamp
+std::vector<EventCD> make_events(size_t n) {
+    std::vector<EventCD> events;
+    for (size_t i = 0; i < n; ++i) {
+        events.emplace_back(i % 640, i % 480, i % 2, 10 * (i / 3));
+    }
+    return events;
+}
+} // namespace
+
+TEST(TimeIndexedEventBuffer_GTest, bounds_are_the_ones_of_a_linear_search) {
+    const auto events = make_events(1000);
+
+    // GIVEN a buffer with small blocks, filled with single events and ranges
+    TimeIndexedEventBuffer<EventCD> buffer(16);
+    for (size_t i = 0; i < 100; ++i) {
+        buffer.push_back(events[i]);
+    }
+    std::copy(events.cbegin() + 100, events.cbegin() + 300, std::back_inserter(buffer));
+    buffer.append(events.cbegin() + 300, events.cend());
+    ASSERT_EQ(events.size(), buffer.size());
+
+    // WHEN searching timestamps before, in and after the buffer
+    for (timestamp t = -5; t <= events.back().t + 15; ++t) {
+        // THEN the bounds are the ones found by a linear search
+        const auto lower = std::find_if(events.cbegin(), events.cend(), [t](const EventCD &ev) { return ev.t >= t; });
+        const auto upper = std::find_if(events.cbegin(), events.cend(), [t](const EventCD &ev) { return ev.t > t; });
+        ASSERT_EQ(std::distance(events.cbegin(), lower), std::distance(buffer.begin(), buffer.lower_bound(t)));
+        ASSERT_EQ(std::distance(events.cbegin(), upper), std::distance(buffer.begin(), buffer.upper_bound(t)));
+    }
+
+    // WHEN getting the events of a time window
+    const auto window = buffer.get_time_window(100, 200);
+
+    // THEN they are the events whose timestamp is in the window, end excluded
+    ASSERT_EQ(30, std::distance(window.first, window.second));
+    EXPECT_EQ(100, window.first->t);
+    EXPECT_EQ(190, std::prev(window.second)->t);
+}
+
+TEST(TimeIndexedEventBuffer_GTest, split_and_erase_keep_the_index_valid) {
+    const auto events = make_events(500);
+
+    // GIVEN a buffer holding events
+    TimeIndexedEventBuffer<EventCD> buffer(8);
+    buffer.assign(events.cbegin(), events.cend());
+
+    // WHEN splitting it at a timestamp
+    auto tail = buffer.split(605);
+
+    // THEN the events before the timestamp are kept, the others are in a buffer indexed with the same block size
+    ASSERT_EQ(183, buffer.size());
+    ASSERT_EQ(events.size() - 183, tail.size());
+    EXPECT_EQ(600, buffer[182].t);
+    EXPECT_EQ(610, tail[0].t);
+    EXPECT_EQ(8, tail.get_block_size());
+    EXPECT_EQ(buffer.end(), buffer.lower_bound(605));
+    EXPECT_EQ(tail.begin() + 3, tail.lower_bound(620));
+
+    // WHEN appending events to the split buffer again
+    buffer.append(events.cbegin() + 183, events.cend());
+
+    // THEN the index covers them
+    EXPECT_EQ(buffer.begin() + 183, buffer.lower_bound(605));
+    EXPECT_EQ(buffer.begin() + 300, buffer.lower_bound(1000));
+
+    // WHEN removing the events before a timestamp
+    buffer.erase_before(1000);
+
+    // THEN the remaining events are searched from the beginning of the buffer
+    ASSERT_EQ(events.size() - 300, buffer.size());
+    EXPECT_EQ(1000, buffer[0].t);
+    EXPECT_EQ(buffer.begin(), buffer.lower_bound(1000));
+    EXPECT_EQ(buffer.begin() + 3, buffer.upper_bound(1000));
+    EXPECT_EQ(buffer.begin() + 150, buffer.lower_bound(1500));
+}
+
+TEST(TimeIndexedEventBuffer_GTest, index_passed_with_the_buffer) {
+    const auto events = make_events(100);
+
+    // GIVEN a buffer handed over through a shared pointer, as between the stages of a pipeline
+    auto buffer = std::make_shared<TimeIndexedEventBuffer<EventCD>>(4);
+    buffer->append(events.cbegin(), events.cend());
+    std::shared_ptr<const TimeIndexedEventBuffer<EventCD>> received = buffer;
+
+    // WHEN copying and swapping it
+    TimeIndexedEventBuffer<EventCD> copy = *received;
+    TimeIndexedEventBuffer<EventCD> swapped;
+    swapped.swap(copy);
+
+    // THEN the index is still valid
+    EXPECT_EQ(4, swapped.get_block_size());
+    EXPECT_TRUE(copy.empty());
+    EXPECT_EQ(swapped.begin() + 51, swapped.lower_bound(170));
+}
+
+TEST(TimeIndexedEventBuffer_GTest, invalid_block_size) {
+    EXPECT_THROW(TimeIndexedEventBuffer<EventCD>(0), std::invalid_argument);
+}
@@ -0,0 +1,91 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <gtest/gtest.h>
+
+#include "metavision/utils/gtest/gtest_with_tmp_dir.h"
+#include "metavision/sdk/base/utils/trace.h"
+
+using namespace Metavision;
+
+class Trace_GTest : public GTestWithTmpDir {
+protected:
+    virtual void SetUp() override {
+        path_ = tmpdir_handler_->get_full_path("trace.json");
+    }
+
+    virtual void TearDown() override {
+        Trace::stop();
+    }
+
+    std::string read_trace() const {
+        std::ifstream ifs(path_);
+        std::stringstream ss;
+        ss << ifs.rdbuf();
+        return ss.str();
+    }
+
+    std::string path_;
+};
+
+TEST_F(Trace_GTest, records_scopes_counters_and_thread_names) {
+    // GIVEN a tracing started, and a thread naming itself
+    Trace::start(path_);
+    ASSERT_TRUE(Trace::is_enabled());
+
+    // WHEN recording scopes and counters from several threads
+    std::thread thread([] {
+        Trace::set_thread_name("worker \"1\"");
+        Trace::Scope scope("worker_scope");
+        Trace::counter("worker_counter", 42);
+    });
+    thread.join();
+    { Trace::Scope scope("main_scope"); }
+    Trace::stop();
+
+    // THEN the trace file holds all of them in the Trace Event format
+    EXPECT_FALSE(Trace::is_enabled());
+    const std::string trace = read_trace();
+    EXPECT_EQ(0u, trace.find("{\"traceEvents\":["));
+    EXPECT_NE(std::string::npos, trace.find("\"ph\":\"M\",\"name\":\"thread_name\""));
+    EXPECT_NE(std::string::npos, trace.find("\"name\":\"worker \\\"1\\\"\""));
+    EXPECT_NE(std::string::npos, trace.find("\"ph\":\"X\",\"name\":\"worker_scope\""));
+    EXPECT_NE(std::string::npos, trace.find("\"ph\":\"X\",\"name\":\"main_scope\""));
+    EXPECT_NE(std::string::npos, trace.find("\"ph\":\"C\",\"name\":\"worker_counter\""));
+    EXPECT_NE(std::string::npos, trace.find("\"args\":{\"value\":42}"));
+}
+
+TEST_F(Trace_GTest, nothing_recorded_when_not_enabled) {
+    // GIVEN events recorded before the tracing is started
+    Trace::counter("before_start", 1);
+    { Trace::Scope scope("before_start_scope"); }
+
+    // WHEN starting and stopping the tracing
+    Trace::start(path_);
+    Trace::stop();
+
+    // THEN the trace is empty
+    const std::string trace = read_trace();
+    EXPECT_EQ(std::string::npos, trace.find("before_start"));
+    EXPECT_NE(std::string::npos, trace.find("]}"));
+}
+
+TEST_F(Trace_GTest, throws_when_the_file_can_not_be_opened) {
+    // GIVEN a path in a directory that does not exist
+    // WHEN starting the tracing
+    // THEN it throws and the tracing is not enabled
+    EXPECT_THROW(Trace::start(tmpdir_handler_->get_full_path("missing/trace.json")), std::runtime_error);
+    EXPECT_FALSE(Trace::is_enabled());
+}
@@ -0,0 +1,81 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <memory>
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/base/events/event_cd_buffer_soa.h"
+#include "metavision/utils/pybind/dlpack_helper.h"
+
+namespace py = pybind11;
+
+namespace Metavision {
+
+namespace { // anonymous
+
+std::shared_ptr<EventCDBufferSoA> make_buffer_soa_helper(const py::array_t<EventCD> &events) {
+    auto info = events.request();
+    if (info.ndim != 1) {
+        throw std::runtime_error("Bad input numpy array dimension " + std::to_string(info.ndim) +
+                                 " should be equal to 1");
+    }
+    auto buffer       = std::make_shared<EventCDBufferSoA>();
+    const auto *begin = static_cast<const EventCD *>(info.ptr);
+    buffer->assign(begin, begin + info.shape[0]);
+    return buffer;
+}
+
+py::array_t<EventCD> numpy_buffer_soa_helper(const EventCDBufferSoA &buffer) {
+    py::array_t<EventCD> events(buffer.size());
+    buffer.copy_to(events.mutable_data());
+    return events;
+}
+
+// The arrays of the fields are viewed without copy, the views keeping the buffer alive
+template<typename T>
+DLPackTensor field_buffer_soa_helper(py::object self, T *data) {
+    const auto size = static_cast<int64_t>(self.cast<const EventCDBufferSoA &>().size());
+    return DLPackTensor(self, data, to_dlpack_dtype(py::dtype::of<T>()), {size});
+}
+
+} // anonymous namespace
+
+void export_event_cd_buffer_soa(py::module &m) {
+    export_DLPackTensor(m);
+
+    py::class_<EventCDBufferSoA, std::shared_ptr<EventCDBufferSoA>>(
+        m, "EventCDBufferSoA",
+        "Buffer of CD events stored as a structure of arrays, whose fields can be exported without copy through the "
+        "DLPack protocol, e.g. torch.from_dlpack(buffer.t)")
+        .def(py::init<>(), "Creates an empty buffer")
+        .def(py::init(&make_buffer_soa_helper), py::arg("events"),
+             "Creates a buffer holding a copy of events\n"
+             "\n"
+             "   :events: numpy array of EventCD")
+        .def("__len__", &EventCDBufferSoA::size)
+        .def("numpy", &numpy_buffer_soa_helper, "Copies the events into a numpy array of EventCD")
+        .def_property_readonly(
+            "x", [](py::object self) { return field_buffer_soa_helper(self, self.cast<EventCDBufferSoA &>().x()); },
+            "Column positions of the events, as a DLPack tensor of uint16")
+        .def_property_readonly(
+            "y", [](py::object self) { return field_buffer_soa_helper(self, self.cast<EventCDBufferSoA &>().y()); },
+            "Line positions of the events, as a DLPack tensor of uint16")
+        .def_property_readonly(
+            "p", [](py::object self) { return field_buffer_soa_helper(self, self.cast<EventCDBufferSoA &>().p()); },
+            "Polarities of the events, as a DLPack tensor of int16")
+        .def_property_readonly(
+            "t", [](py::object self) { return field_buffer_soa_helper(self, self.cast<EventCDBufferSoA &>().t()); },
+            "Timestamps of the events, as a DLPack tensor of int64");
+}
+
+} // namespace Metavision
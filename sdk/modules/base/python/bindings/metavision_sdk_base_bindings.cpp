@@ -36,6 +36,7 @@ PythonBindingsDoc pybind_doc_base;
 #endif
 
 void export_event_cd(py::module &m);
+void export_event_cd_buffer_soa(py::module &m);
 void export_event_ext_trigger(py::module &m);
 void export_software_info(py::module &m);
 void export_debug_buffer_info(py::module &m);
@@ -54,6 +55,7 @@ PYBIND11_MODULE(MODULE_NAME, m) {
 
     // Export events
     Metavision::export_event_cd(m);
+    Metavision::export_event_cd_buffer_soa(m);
     Metavision::export_event_ext_trigger(m);
 
     // Export tools
@@ -8,6 +8,7 @@
 # See the License for the specific language governing permissions and limitations under the License.
 
 import numpy as np
+import pytest
 import metavision_sdk_base
 
 
@@ -27,6 +28,50 @@ def pytestcase_EventExtTrigger():
     assert ev.dtype == np_from_buf.dtype
 
 
+def pytestcase_EventCDBuffer_dlpack():
+    buf = metavision_sdk_base.EventCDBuffer(3)
+    events = buf.numpy()
+    events["x"] = [1, 2, 3]
+    events["t"] = [10, 20, 30]
+
+    # The fields are viewed without copy
+    t = np.from_dlpack(buf.field("t"))
+    assert t.dtype == np.int64
+    assert list(t) == [10, 20, 30]
+    events["t"][1] = 25
+    assert t[1] == 25
+    assert list(np.from_dlpack(buf.field("x"))) == [1, 2, 3]
+
+    raw = np.from_dlpack(buf)
+    assert raw.dtype == np.uint8
+    assert raw.shape == (3, events.itemsize)
+    assert np.array_equal(raw.view(metavision_sdk_base.EventCD).ravel(), events)
+
+    with pytest.raises(ValueError):
+        buf.field("unknown")
+
+
+def pytestcase_EventCDBufferSoA_dlpack():
+    events = np.zeros(4, dtype=metavision_sdk_base.EventCD)
+    events["x"] = [4, 3, 2, 1]
+    events["p"] = [1, 0, 1, 0]
+    events["t"] = [1, 2, 3, 4]
+    soa = metavision_sdk_base.EventCDBufferSoA(events)
+    assert len(soa) == 4
+    assert np.array_equal(soa.numpy(), events)
+
+    x = np.from_dlpack(soa.x)
+    t = np.from_dlpack(soa.t)
+    assert x.dtype == np.uint16 and list(x) == [4, 3, 2, 1]
+    assert np.from_dlpack(soa.p).dtype == np.int16
+    assert t.dtype == np.int64 and list(t) == [1, 2, 3, 4]
+    assert soa.t.shape == (4,)
+
+    # The views keep the buffer alive
+    del soa
+    assert list(t) == [1, 2, 3, 4]
+
+
 def pytestcase_check_SoftwareInfo_exists():
     metavision_sdk_base.SoftwareInfo
 
@@ -0,0 +1,253 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+// Application replaying a RAW file or a synthetic source as fast as possible through a pipeline decoding, filtering
+// the events, generating frames and writing or displaying them, and reporting the throughput and latency of each
+// stage, along with the peak memory and the CPU usage of the process.
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <boost/program_options.hpp>
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+#include <metavision/sdk/base/utils/log.h>
+#include <metavision/sdk/core/algorithms/activity_noise_filter_algorithm.h>
+#include <metavision/sdk/core/algorithms/polarity_filter_algorithm.h>
+#include <metavision/sdk/core/pipeline/frame_generation_stage.h>
+#include <metavision/sdk/core/pipeline/pipeline.h>
+#include <metavision/sdk/core/pipeline/video_writing_stage.h>
+#include <metavision/sdk/driver/camera.h>
+#include <metavision/sdk/driver/pipeline/camera_stage.h>
+#include <metavision/sdk/ui/pipeline/frame_display_stage.h>
+
+namespace po = boost::program_options;
+
+namespace {
+
+const std::string synthetic_prefix = "synthetic:";
+
+struct ProcessUsage {
+    double cpu_time_s   = 0.;
+    size_t peak_rss_kib = 0;
+};
+
+ProcessUsage get_process_usage() {
+    ProcessUsage usage;
+#ifdef _WIN32
+    FILETIME creation, exit, kernel, user;
+    if (GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user)) {
+        auto to_s = [](const FILETIME &t) {
+            return ((static_cast<uint64_t>(t.dwHighDateTime) << 32) | t.dwLowDateTime) * 1e-7;
+        };
+        usage.cpu_time_s = to_s(kernel) + to_s(user);
+    }
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        usage.peak_rss_kib = counters.PeakWorkingSetSize / 1024;
+    }
+#else
+    struct rusage r;
+    if (getrusage(RUSAGE_SELF, &r) == 0) {
+        usage.cpu_time_s = r.ru_utime.tv_sec + r.ru_stime.tv_sec + (r.ru_utime.tv_usec + r.ru_stime.tv_usec) * 1e-6;
+#ifdef __APPLE__
+        usage.peak_rss_kib = r.ru_maxrss / 1024;
+#else
+        usage.peak_rss_kib = r.ru_maxrss;
+#endif
+    }
+#endif
+    return usage;
+}
+
+void print_report(const std::vector<Metavision::StageStatistics> &stats,
+                  const Metavision::CameraLatencyStatistics &camera_stats, uint64_t num_decoded_events, double wall_s,
+                  const ProcessUsage &usage) {
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(1);
+    oss << std::left << std::setw(20) << "Stage" << std::right << std::setw(10) << "Buffers" << std::setw(14)
+        << "Events" << std::setw(12) << "Mev/s" << std::setw(14) << "p50 lat (us)" << std::setw(14) << "p99 lat (us)"
+        << std::setw(14) << "p99 run (us)" << std::setw(10) << "Dropped" << "\n";
+
+    // The decoding is done by the camera, the latency of its buffers being measured up to the end of the events
+    // callbacks, which feed the camera stage
+    oss << std::left << std::setw(20) << stats.front().name << std::right << std::setw(10) << camera_stats.num_buffers
+        << std::setw(14) << num_decoded_events << std::setw(12) << num_decoded_events / wall_s / 1e6 << std::setw(14)
+        << camera_stats.transfer_to_callback.p50_us << std::setw(14) << camera_stats.transfer_to_callback.p99_us
+        << std::setw(14) << "-" << std::setw(10) << "-" << "\n";
+    for (size_t i = 1; i < stats.size(); ++i) {
+        const auto &s = stats[i];
+        oss << std::left << std::setw(20) << s.name << std::right << std::setw(10) << s.num_buffers << std::setw(14)
+            << s.num_events << std::setw(12) << s.num_events / wall_s / 1e6 << std::setw(14) << s.latency_p50_ns / 1e3
+            << std::setw(14) << s.latency_p99_ns / 1e3 << std::setw(14) << s.consume_time_p99_ns / 1e3 << std::setw(10)
+            << s.num_dropped << "\n";
+    }
+    oss << "\nWall time: " << std::setprecision(3) << wall_s << " s, CPU time: " << usage.cpu_time_s << " s ("
+        << std::setprecision(0) << 100. * usage.cpu_time_s / wall_s << "% of a core), peak memory: "
+        << usage.peak_rss_kib / 1024 << " MiB";
+    MV_LOG_INFO() << Metavision::Log::no_space << oss.str();
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    std::string input;
+    std::vector<std::string> filters;
+    Metavision::timestamp activity_threshold_us;
+    int polarity;
+    uint32_t accumulation_time_ms;
+    double fps;
+    std::string out_video_file_path;
+    std::string fourcc;
+    bool display = false;
+    std::string scheduling;
+    size_t num_workers;
+
+    const std::string program_desc(
+        "Application replaying a RAW file or a synthetic source as fast as possible through a pipeline decoding the "
+        "events, filtering them, generating frames and writing or displaying them, and reporting the throughput and "
+        "latency of each stage, the peak memory and the CPU usage.\n\n"
+        "The synthetic sources of the sample plugin are opened with a serial like "
+        "\"synthetic:rate=20M,realtime=0\".\n");
+
+    po::options_description options_desc("Options");
+    // clang-format off
+    options_desc.add_options()
+        ("help,h", "Produce help message.")
+        ("input,i",              po::value<std::string>(&input)->required(), "Path to the input RAW file, or serial of a synthetic source, starting with \"synthetic:\".")
+        ("filters,f",            po::value<std::vector<std::string>>(&filters)->multitoken()->default_value({"activity"}, "activity"), "Filters applied to the events, in order: activity and/or polarity. Use \"none\" to disable the filtering.")
+        ("activity-threshold",   po::value<Metavision::timestamp>(&activity_threshold_us)->default_value(20000), "Threshold of the activity noise filter (in us).")
+        ("polarity",             po::value<int>(&polarity)->default_value(1), "Polarity of the events kept by the polarity filter.")
+        ("accumulation-time,a",  po::value<uint32_t>(&accumulation_time_ms)->default_value(10), "Accumulation time of the frames (in ms).")
+        ("fps",                  po::value<double>(&fps)->default_value(30.), "Frame rate of the frames generated, in the time of the events.")
+        ("output-video-file,o",  po::value<std::string>(&out_video_file_path), "Path to an output AVI file. If not provided, the frames are not encoded.")
+        ("fourcc",               po::value<std::string>(&fourcc)->default_value("MJPG"), "Fourcc 4-character code of the codec used to compress the frames.")
+        ("display,d",            po::bool_switch(&display), "Display the frames.")
+        ("scheduling",           po::value<std::string>(&scheduling)->default_value("thread-per-stage"), "Scheduling of the stages: thread-per-stage or work-stealing.")
+        ("workers",              po::value<size_t>(&num_workers)->default_value(0), "Number of worker threads with the work-stealing scheduling, 0 for the number of cores.")
+    ;
+    // clang-format on
+
+    po::variables_map vm;
+    try {
+        po::store(po::command_line_parser(argc, argv).options(options_desc).run(), vm);
+        if (vm.count("help")) {
+            MV_LOG_INFO() << program_desc;
+            MV_LOG_INFO() << options_desc;
+            return 0;
+        }
+        po::notify(vm);
+    } catch (po::error &e) {
+        MV_LOG_ERROR() << program_desc;
+        MV_LOG_ERROR() << options_desc;
+        MV_LOG_ERROR() << "Parsing error:" << e.what();
+        return 1;
+    }
+
+    Metavision::Pipeline::SchedulingPolicy policy;
+    if (scheduling == "thread-per-stage") {
+        policy = Metavision::Pipeline::SchedulingPolicy::ThreadPerStage;
+    } else if (scheduling == "work-stealing") {
+        policy = Metavision::Pipeline::SchedulingPolicy::WorkStealing;
+    } else {
+        MV_LOG_ERROR() << "Unknown scheduling:" << scheduling;
+        return 1;
+    }
+
+    Metavision::Camera camera;
+    try {
+        if (input.compare(0, synthetic_prefix.size(), synthetic_prefix) == 0) {
+            camera = Metavision::Camera::from_serial(input);
+        } else {
+            camera = Metavision::Camera::from_file(input, false);
+        }
+    } catch (Metavision::CameraException &e) {
+        MV_LOG_ERROR() << e.what();
+        return 1;
+    }
+    camera.enable_latency_statistics();
+    const int width  = camera.geometry().width();
+    const int height = camera.geometry().height();
+
+    Metavision::Pipeline p(true, policy, num_workers);
+    p.enable_statistics();
+
+    // 0) Stage producing the events decoded by the camera
+    auto &camera_stage = p.add_stage(std::make_unique<Metavision::CameraStage>(std::move(camera)));
+    camera_stage.set_name("decode");
+
+    // 1) Stages filtering the events
+    Metavision::BaseStage *last_stage = &camera_stage;
+    try {
+        for (const auto &filter : filters) {
+            if (filter == "activity") {
+                last_stage = &p.add_algorithm_stage(
+                    std::make_unique<Metavision::ActivityNoiseFilterAlgorithm>(width, height, activity_threshold_us),
+                    *last_stage, true);
+                last_stage->set_name("activity_filter");
+            } else if (filter == "polarity") {
+                last_stage = &p.add_algorithm_stage(
+                    std::make_unique<Metavision::PolarityFilterAlgorithm>(static_cast<std::int16_t>(polarity)),
+                    *last_stage, true);
+                last_stage->set_name("polarity_filter");
+            } else if (filter != "none") {
+                MV_LOG_ERROR() << "Unknown filter:" << filter;
+                return 1;
+            }
+        }
+    } catch (std::invalid_argument &e) {
+        MV_LOG_ERROR() << e.what();
+        return 1;
+    }
+
+    // 2) Stage generating the frames
+    auto &frame_stage = p.add_stage(
+        std::make_unique<Metavision::FrameGenerationStage>(width, height, accumulation_time_ms, fps), *last_stage);
+    frame_stage.set_name("frame_generation");
+
+    // 3) Stages encoding and displaying the frames
+    if (!out_video_file_path.empty()) {
+        try {
+            auto &video_stage =
+                p.add_stage(std::make_unique<Metavision::VideoWritingStage>(out_video_file_path, width, height,
+                                                                            static_cast<int>(fps), fourcc),
+                            frame_stage);
+            video_stage.set_name("video_writing");
+        } catch (std::runtime_error &e) {
+            MV_LOG_ERROR() << e.what();
+            return 1;
+        }
+    }
+    if (display) {
+        auto &display_stage =
+            p.add_stage(std::make_unique<Metavision::FrameDisplayStage>("Pipeline benchmark", width, height),
+                        frame_stage);
+        display_stage.set_name("display");
+    }
+
+    MV_LOG_INFO() << "Replaying" << input << "...";
+    const auto start = std::chrono::steady_clock::now();
+    p.run();
+    const double wall_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // The events decoded are the ones consumed by the stage following the camera
+    const auto stats = p.statistics();
+    print_report(stats, camera_stage.camera().get_latency_statistics(), stats.size() > 1 ? stats[1].num_events : 0,
+                 wall_s, get_process_usage());
+    return 0;
+}
@@ -0,0 +1,110 @@
+#!/usr/bin/env python
+
+# Copyright (c) Prophesee S.A.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+# Unless required by applicable law or agreed to in writing, software distributed under the License is distributed
+# on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and limitations under the License.
+
+import pytest
+import os
+import re
+from metavision_utils import pytest_tools
+
+
+def run_benchmark(filename_full, options=""):
+    """Runs metavision_pipeline_benchmark on a file and returns the number of events of each stage of its report
+    """
+
+    # Before launching the app, check the dataset file exists
+    assert os.path.exists(filename_full)
+
+    cmd = "./metavision_pipeline_benchmark -i \"{}\" {}".format(filename_full, options)
+    output, error_code = pytest_tools.run_cmd_setting_mv_log_file(cmd)
+
+    # Check app exited without error
+    assert error_code == 0, "******\nError while executing cmd '{}':{}\n******".format(cmd, output)
+
+    # Check the process usage is reported
+    assert re.search("Wall time: [0-9.]+ s, CPU time: [0-9.]+ s", output)
+
+    # Rows of the report: <stage> <buffers> <events> ...
+    events = {}
+    for match in re.finditer(r"^\s*([a-z_]+)\s+([0-9]+)\s+([0-9]+)\s+[0-9.]+\s", output, re.MULTILINE):
+        events[match.group(1)] = int(match.group(3))
+    return events
+
+
+def pytestcase_test_metavision_pipeline_benchmark_show_help():
+    """
+    Checks output of metavision_pipeline_benchmark when displaying help message
+    """
+
+    cmd = "./metavision_pipeline_benchmark --help"
+    output, error_code = pytest_tools.run_cmd_setting_mv_log_file(cmd)
+
+    # Check app exited without error
+    assert error_code == 0, "******\nError while executing cmd '{}':{}\n******".format(cmd, output)
+
+    # Check that the options showed in the output
+    assert "Options:" in output, "******\nMissing options display in output :{}\n******".format(output)
+
+
+def pytestcase_test_metavision_pipeline_benchmark_missing_input_args():
+    """
+    Checks that metavision_pipeline_benchmark returns an error when not passing required input args
+    """
+
+    cmd = "./metavision_pipeline_benchmark"
+    output, error_code = pytest_tools.run_cmd_setting_mv_log_file(cmd)
+
+    # Assert app returned error
+    assert error_code != 0
+
+    # And now check that the error came from the fact that the input file arg is missing
+    assert re.search("Parsing error: the option (.+) is required but missing", output)
+
+
+def pytestcase_test_metavision_pipeline_benchmark_invalid_options(dataset_dir):
+    """
+    Checks that metavision_pipeline_benchmark returns an error when passing an unknown filter or scheduling
+    """
+
+    filename_full = os.path.join(dataset_dir, "gen31_timer.raw")
+
+    cmd = "./metavision_pipeline_benchmark -i \"{}\" --filters median".format(filename_full)
+    output, error_code = pytest_tools.run_cmd_setting_mv_log_file(cmd)
+    assert error_code != 0
+    assert "Unknown filter: median" in output
+
+    cmd = "./metavision_pipeline_benchmark -i \"{}\" --scheduling round-robin".format(filename_full)
+    output, error_code = pytest_tools.run_cmd_setting_mv_log_file(cmd)
+    assert error_code != 0
+    assert "Unknown scheduling: round-robin" in output
+
+
+def pytestcase_test_metavision_pipeline_benchmark_on_gen31_recording(dataset_dir):
+    """
+    Checks that metavision_pipeline_benchmark reports all the events decoded and filtered by each stage
+    """
+
+    filename_full = os.path.join(dataset_dir, "gen31_timer.raw")
+
+    # Without filter, the frames are generated from all the events decoded
+    events = run_benchmark(filename_full, "--filters none")
+    assert set(events.keys()) == {"decode", "frame_generation"}
+    assert events["decode"] > 0
+    assert events["frame_generation"] == events["decode"]
+
+    # Each stage reports the events it consumes, the filters keeping a part of them whatever the scheduling
+    for scheduling in ["thread-per-stage", "work-stealing"]:
+        filtered_events = run_benchmark(filename_full,
+                                        "--filters polarity activity --scheduling {}".format(scheduling))
+        assert set(filtered_events.keys()) == {"decode", "polarity_filter", "activity_filter", "frame_generation"}
+        assert filtered_events["decode"] == events["decode"]
+        assert filtered_events["polarity_filter"] == events["decode"]
+        assert 0 < filtered_events["activity_filter"] < filtered_events["polarity_filter"]
+        assert 0 < filtered_events["frame_generation"] < filtered_events["activity_filter"]
@@ -21,6 +21,7 @@
 #include "viewer.h"
 #include "view.h"
 #include "params.h"
+#include "frame_cache.h"
 
 class AnalysisView : public View {
 public:
@@ -65,6 +66,7 @@ protected:
     virtual void setup() override;
     virtual void update(cv::Mat &frame, int key_pressed) override;
     virtual std::vector<std::string> getHelpMessages() const override;
+    virtual size_t renderFrame(cv::Mat &frame, Metavision::timestamp ts) override;
 
 private:
     void setMinFps(int min_fps);
@@ -92,9 +94,15 @@ private:
 
     void exportVideo();
 
+    // Renders the events of the accumulation time ending at ts, using events as the storage of the slice of events
+    size_t renderSlice(cv::Mat &frame, std::vector<Metavision::Event2d> &events, Metavision::timestamp ts,
+                       int accumulation_time_us, int frame_period_us, const Metavision::ColorPalette &palette) const;
+
     Metavision::timestamp first_time_us_, last_time_us_;
     bool setup_ = false;
     cv::Mat frame_, tmp_frame_;
+    FrameCache frame_cache_;
+    std::vector<Metavision::Event2d> frame_events_;
 };
 
 #endif // METAVISION_PLAYER_ANALYSIS_VIEW_H
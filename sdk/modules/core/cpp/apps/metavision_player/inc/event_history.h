@@ -0,0 +1,246 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_PLAYER_EVENT_HISTORY_H
+#define METAVISION_PLAYER_EVENT_HISTORY_H
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <metavision/sdk/base/events/event2d.h>
+#include <metavision/sdk/base/utils/timestamp.h>
+
+/// @brief History of the events of a stream, held in a fixed memory budget
+///
+/// The events are appended to a tail of decoded events, which is sealed into a chunk once full. The chunks are stored
+/// delta-encoded, each event taking a few bytes instead of the 16 bytes of a @ref Metavision::Event2d, and the
+/// oldest ones are dropped once the memory budget is exceeded. The chunks are indexed by their first and last
+/// timestamps, and the ones needed to get a slice of events are decoded into a LRU cache, so that scrubbing back and
+/// forth through the history only decodes a few chunks.
+///
+/// The events are expected to be sorted by timestamps, with polarities 0 or 1. Slices can be retrieved concurrently,
+/// but not while events are added.
+class EventHistory {
+public:
+    using value_type = Metavision::Event2d;
+
+    /// @brief Constructor
+    /// @param max_bytes Memory budget of the encoded chunks and of the tail, at least one chunk being kept
+    /// @param events_per_chunk Number of events in each chunk
+    /// @param max_decoded_chunks Number of chunks kept decoded in the cache
+    explicit EventHistory(size_t max_bytes, size_t events_per_chunk = 1 << 16, size_t max_decoded_chunks = 8) :
+        max_bytes_(max_bytes),
+        events_per_chunk_(std::max<size_t>(events_per_chunk, 1)),
+        max_decoded_chunks_(std::max<size_t>(max_decoded_chunks, 1)) {
+        tail_.reserve(events_per_chunk_);
+    }
+
+    /// @brief Adds an event at the end of the history, dropping the oldest chunks if the memory budget is exceeded
+    void push_back(const Metavision::Event2d &ev) {
+        tail_.push_back(ev);
+        if (tail_.size() == events_per_chunk_) {
+            seal();
+        }
+    }
+
+    bool empty() const {
+        return chunks_.empty() && tail_.empty();
+    }
+
+    /// @brief Gets the number of events in the history
+    size_t size() const {
+        return num_chunks_events_ + tail_.size();
+    }
+
+    /// @brief Gets the memory used by the encoded chunks
+    size_t encodedBytes() const {
+        return encoded_bytes_;
+    }
+
+    /// @brief Gets the timestamp of the first event of the history, which must not be empty
+    Metavision::timestamp firstTimeUs() const {
+        return chunks_.empty() ? tail_.front().t : chunks_.front().first_t;
+    }
+
+    /// @brief Gets the timestamp of the last event of the history, which must not be empty
+    Metavision::timestamp lastTimeUs() const {
+        return tail_.empty() ? chunks_.back().last_t : tail_.back().t;
+    }
+
+    void clear() {
+        chunks_.clear();
+        tail_.clear();
+        num_chunks_events_ = 0;
+        encoded_bytes_     = 0;
+        std::lock_guard<std::mutex> lock(cache_mutex_);
+        cache_.clear();
+        cache_index_.clear();
+    }
+
+    /// @brief Gets the events whose timestamps are in (t_begin, t_end]
+    /// @param t_begin Timestamp before the slice
+    /// @param t_end Last timestamp of the slice
+    /// @param events Vector into which the events are copied, cleared beforehand
+    /// @return Number of events of the slice
+    size_t slice(Metavision::timestamp t_begin, Metavision::timestamp t_end,
+                 std::vector<Metavision::Event2d> &events) const {
+        events.clear();
+        if (t_end <= t_begin) {
+            return 0;
+        }
+        // First chunk with events after t_begin
+        auto it = std::partition_point(chunks_.begin(), chunks_.end(),
+                                       [t_begin](const Chunk &c) { return c.last_t <= t_begin; });
+        for (; it != chunks_.end() && it->first_t <= t_end; ++it) {
+            const auto decoded = decode(*it);
+            append(decoded->cbegin(), decoded->cend(), t_begin, t_end, events);
+        }
+        append(tail_.cbegin(), tail_.cend(), t_begin, t_end, events);
+        return events.size();
+    }
+
+private:
+    using DecodedChunk = std::shared_ptr<const std::vector<Metavision::Event2d>>;
+
+    struct Chunk {
+        uint64_t id;
+        Metavision::timestamp first_t, last_t;
+        size_t num_events;
+        std::vector<uint8_t> data;
+    };
+
+    template<typename It>
+    static void append(It begin, It end, Metavision::timestamp t_begin, Metavision::timestamp t_end,
+                       std::vector<Metavision::Event2d> &events) {
+        const auto is_before = [](Metavision::timestamp t, const auto &ev) { return t < ev.t; };
+        const auto first     = std::upper_bound(begin, end, t_begin, is_before);
+        const auto last      = std::upper_bound(first, end, t_end, is_before);
+        events.insert(events.end(), first, last);
+    }
+
+    static uint64_t zigzag(int64_t v) {
+        return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63);
+    }
+
+    static int64_t unzigzag(uint64_t v) {
+        return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+    }
+
+    static void writeVarint(uint64_t v, std::vector<uint8_t> &data) {
+        while (v >= 0x80) {
+            data.push_back(static_cast<uint8_t>(v) | 0x80);
+            v >>= 7;
+        }
+        data.push_back(static_cast<uint8_t>(v));
+    }
+
+    static uint64_t readVarint(const uint8_t *&ptr) {
+        uint64_t v = 0;
+        for (int shift = 0;; shift += 7) {
+            const uint8_t b = *ptr++;
+            v |= static_cast<uint64_t>(b & 0x7F) << shift;
+            if (!(b & 0x80)) {
+                return v;
+            }
+        }
+    }
+
+    // Each event is encoded as the differences of its timestamp, with its polarity in the lowest bit, and coordinates
+    // with the previous event
+    void seal() {
+        Chunk chunk{next_chunk_id_++, tail_.front().t, tail_.back().t, tail_.size(), {}};
+        chunk.data.reserve(4 * tail_.size());
+        Metavision::Event2d prev(0, 0, 0, chunk.first_t);
+        for (const auto &ev : tail_) {
+            writeVarint((zigzag(ev.t - prev.t) << 1) | (ev.p & 1), chunk.data);
+            writeVarint(zigzag(int64_t(ev.x) - prev.x), chunk.data);
+            writeVarint(zigzag(int64_t(ev.y) - prev.y), chunk.data);
+            prev = ev;
+        }
+        chunk.data.shrink_to_fit();
+        encoded_bytes_ += chunk.data.size();
+        num_chunks_events_ += chunk.num_events;
+        chunks_.push_back(std::move(chunk));
+        tail_.clear();
+
+        const size_t tail_bytes = events_per_chunk_ * sizeof(Metavision::Event2d);
+        while (chunks_.size() > 1 && encoded_bytes_ + tail_bytes > max_bytes_) {
+            encoded_bytes_ -= chunks_.front().data.size();
+            num_chunks_events_ -= chunks_.front().num_events;
+            uncache(chunks_.front().id);
+            chunks_.pop_front();
+        }
+    }
+
+    DecodedChunk decode(const Chunk &chunk) const {
+        {
+            std::lock_guard<std::mutex> lock(cache_mutex_);
+            auto it = cache_index_.find(chunk.id);
+            if (it != cache_index_.end()) {
+                cache_.splice(cache_.begin(), cache_, it->second);
+                return it->second->second;
+            }
+        }
+
+        auto events = std::make_shared<std::vector<Metavision::Event2d>>(chunk.num_events);
+        const uint8_t *ptr = chunk.data.data();
+        Metavision::Event2d prev(0, 0, 0, chunk.first_t);
+        for (auto &ev : *events) {
+            const uint64_t tp = readVarint(ptr);
+            ev.t              = prev.t + unzigzag(tp >> 1);
+            ev.p              = static_cast<short>(tp & 1);
+            ev.x              = static_cast<unsigned short>(prev.x + unzigzag(readVarint(ptr)));
+            ev.y              = static_cast<unsigned short>(prev.y + unzigzag(readVarint(ptr)));
+            prev              = ev;
+        }
+
+        std::lock_guard<std::mutex> lock(cache_mutex_);
+        if (cache_index_.find(chunk.id) == cache_index_.end()) {
+            cache_.emplace_front(chunk.id, events);
+            cache_index_.emplace(chunk.id, cache_.begin());
+            if (cache_.size() > max_decoded_chunks_) {
+                cache_index_.erase(cache_.back().first);
+                cache_.pop_back();
+            }
+        }
+        return events;
+    }
+
+    void uncache(uint64_t id) {
+        std::lock_guard<std::mutex> lock(cache_mutex_);
+        auto it = cache_index_.find(id);
+        if (it != cache_index_.end()) {
+            cache_.erase(it->second);
+            cache_index_.erase(it);
+        }
+    }
+
+    const size_t max_bytes_;
+    const size_t events_per_chunk_;
+    const size_t max_decoded_chunks_;
+    std::deque<Chunk> chunks_;
+    std::vector<Metavision::Event2d> tail_;
+    uint64_t next_chunk_id_   = 0;
+    size_t num_chunks_events_ = 0;
+    size_t encoded_bytes_     = 0;
+
+    mutable std::mutex cache_mutex_;
+    mutable std::list<std::pair<uint64_t, DecodedChunk>> cache_;
+    mutable std::unordered_map<uint64_t, std::list<std::pair<uint64_t, DecodedChunk>>::iterator> cache_index_;
+};
+
+#endif // METAVISION_PLAYER_EVENT_HISTORY_H
@@ -0,0 +1,108 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_PLAYER_FRAME_CACHE_H
+#define METAVISION_PLAYER_FRAME_CACHE_H
+
+#include <list>
+#include <map>
+#include <tuple>
+#include <opencv2/core.hpp>
+#include <metavision/sdk/base/utils/timestamp.h>
+#include <metavision/sdk/core/utils/colors.h>
+
+/// @brief LRU cache of the frames rendered from the events buffer
+///
+/// The frames are identified by their time, accumulation time and color palette, and the least recently used ones are
+/// evicted once the memory used by the cached frames exceeds a budget.
+class FrameCache {
+public:
+    struct Key {
+        Metavision::timestamp time_us;
+        int accumulation_time_us;
+        Metavision::ColorPalette palette;
+
+        bool operator<(const Key &other) const {
+            return std::tie(time_us, accumulation_time_us, palette) <
+                   std::tie(other.time_us, other.accumulation_time_us, other.palette);
+        }
+    };
+
+    /// @brief Constructor
+    /// @param max_bytes Memory budget of the cached frames, at least one frame being kept whatever its size
+    explicit FrameCache(size_t max_bytes) : max_bytes_(max_bytes) {}
+
+    /// @brief Gets a frame from the cache, marking it as the most recently used
+    /// @param key Key of the frame
+    /// @param frame Frame into which the cached frame is copied
+    /// @param num_events Number of events in the cached frame
+    /// @return false if the frame is not in the cache
+    bool get(const Key &key, cv::Mat &frame, size_t &num_events) {
+        auto it = index_.find(key);
+        if (it == index_.end()) {
+            return false;
+        }
+        entries_.splice(entries_.begin(), entries_, it->second);
+        it->second->frame.copyTo(frame);
+        num_events = it->second->num_events;
+        return true;
+    }
+
+    /// @brief Adds a copy of a frame to the cache, evicting the least recently used frames if needed
+    /// @param key Key of the frame
+    /// @param frame Frame to cache
+    /// @param num_events Number of events in the frame
+    void put(const Key &key, const cv::Mat &frame, size_t num_events) {
+        auto it = index_.find(key);
+        if (it != index_.end()) {
+            bytes_ -= byteSize(it->second->frame);
+            entries_.erase(it->second);
+            index_.erase(it);
+        }
+        entries_.push_front(Entry{key, frame.clone(), num_events});
+        index_.emplace(key, entries_.begin());
+        bytes_ += byteSize(frame);
+
+        while (bytes_ > max_bytes_ && entries_.size() > 1) {
+            bytes_ -= byteSize(entries_.back().frame);
+            index_.erase(entries_.back().key);
+            entries_.pop_back();
+        }
+    }
+
+    void clear() {
+        entries_.clear();
+        index_.clear();
+        bytes_ = 0;
+    }
+
+    size_t size() const {
+        return entries_.size();
+    }
+
+private:
+    struct Entry {
+        Key key;
+        cv::Mat frame;
+        size_t num_events;
+    };
+
+    static size_t byteSize(const cv::Mat &frame) {
+        return frame.total() * frame.elemSize();
+    }
+
+    const size_t max_bytes_;
+    size_t bytes_ = 0;
+    std::list<Entry> entries_;
+    std::map<Key, std::list<Entry>::iterator> index_;
+};
+
+#endif // METAVISION_PLAYER_FRAME_CACHE_H
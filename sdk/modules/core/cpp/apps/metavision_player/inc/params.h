@@ -25,8 +25,8 @@ struct Parameters {
     std::string out_raw_basename;
     int out_avi_fps = 25;
 
-    // Buffer size in mega events.
-    int buffer_size_mev = 100;
+    // Memory budget of the events history, in MiB.
+    int buffer_size_mib = 1024;
 
     // Show bias sliders
     bool show_biases = false;
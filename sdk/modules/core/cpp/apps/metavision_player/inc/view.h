@@ -67,6 +67,9 @@ protected:
     virtual void update(cv::Mat &frame, int key_pressed)     = 0;
     virtual std::vector<std::string> getHelpMessages() const = 0;
 
+    // Renders the events of the accumulation time ending at ts, and returns their number
+    virtual size_t renderFrame(cv::Mat &frame, Metavision::timestamp ts);
+
 private:
     void showHelp(cv::Mat &frame);
     void addTextBox(const std::string &text, const cv::Scalar &color, const cv::Rect &rect, const cv::Point &pos);
@@ -77,6 +80,7 @@ private:
     std::string window_name_;
     cv::Size window_size_;
     cv::Mat frame_;
+    std::vector<Metavision::Event2d> frame_events_;
     bool setup_;
     bool show_help_;
     Metavision::ColorPalette palette_;
@@ -13,19 +13,19 @@
 #define METAVISION_PLAYER_VIEWER_H
 
 #include <memory>
-#include <boost/circular_buffer.hpp>
 #include <opencv2/core.hpp>
 #include <metavision/sdk/base/events/event2d.h>
 #include <metavision/sdk/driver/camera.h>
 #include <metavision/sdk/core/algorithms/generic_producer_algorithm.h>
 
 #include "params.h"
+#include "event_history.h"
 
 class View;
 
 class Viewer {
 public:
-    using EventBuffer               = boost::circular_buffer<Metavision::Event2d>;
+    using EventBuffer               = EventHistory;
     static constexpr int FRAME_RATE = 25;
 
     Viewer(const Parameters &params);
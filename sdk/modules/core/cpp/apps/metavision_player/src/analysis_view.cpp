@@ -9,6 +9,7 @@
  * See the License for the specific language governing permissions and limitations under the License.                 *
  **********************************************************************************************************************/
 
+#include <algorithm>
 #include <sstream>
 #include <opencv2/imgproc.hpp>
 #include <opencv2/highgui.hpp>
@@ -26,18 +27,22 @@ const std::string SequenceStartRatioLabel("Start (%)");
 const std::string SequenceDurationRatioLabel("Length (%)");
 const std::string FrameIdLabel("Frame #");
 const size_t NumTrackBars = 5;
+// Memory used by the frames already rendered, kept to be shown again without rendering them
+const size_t FrameCacheMaxBytes = 256 * 1024 * 1024;
 } // namespace
 
 AnalysisView::AnalysisView(Metavision::Camera &camera, Viewer::EventBuffer &event_buffer, const Parameters &parameters,
                            const std::string &window_name) :
     View(camera, event_buffer, parameters, cv::Size(0, NumTrackBars * TRACKBAR_HEIGHT), window_name),
-    first_time_us_(event_buffer.front().t),
-    last_time_us_(event_buffer.back().t) {}
+    first_time_us_(event_buffer.firstTimeUs()),
+    last_time_us_(event_buffer.lastTimeUs()),
+    frame_cache_(FrameCacheMaxBytes) {}
 
 AnalysisView::AnalysisView(const View &view) :
     View(cv::Size(0, NumTrackBars * TRACKBAR_HEIGHT), view),
-    first_time_us_(eventBuffer().front().t),
-    last_time_us_(eventBuffer().back().t) {}
+    first_time_us_(eventBuffer().firstTimeUs()),
+    last_time_us_(eventBuffer().lastTimeUs()),
+    frame_cache_(FrameCacheMaxBytes) {}
 
 void AnalysisView::setup() {
     setup_                  = true;
@@ -184,23 +189,28 @@ void AnalysisView::exportVideo() {
     auto log = MV_LOG_INFO() << Metavision::Log::no_endline << Metavision::Log::no_space << "Exporting to "
                              << params.out_avi_file << "@" << params.out_avi_fps << " fps.";
 
-    auto begin = event_buffer.begin(), end = event_buffer.end();
     const int sequence_start_time_us = sequenceStartTimeUs();
     const int sequence_end_time_us   = sequence_start_time_us + sequenceDurationUs();
     const int frame_period_us        = framePeriodUs();
     const int accumulation_time_us   = accumulationTimeUs();
     const auto &sensor_size          = getCameraSize(camera());
-    cv::Mat frame(sensor_size, CV_8UC3);
     cv::VideoWriter video_writer(params.out_avi_file, cv::VideoWriter::fourcc('M', 'J', 'P', 'G'), params.out_avi_fps,
                                  sensor_size);
     int n_frames = 0;
     for (Metavision::timestamp ts_us = sequence_start_time_us; ts_us <= sequence_end_time_us;
          ts_us += frame_period_us, ++n_frames) {}
 
-    auto last    = std::chrono::time_point<std::chrono::high_resolution_clock>::max();
-    int frame_id = 0;
-    for (Metavision::timestamp ts_us = sequence_start_time_us; ts_us <= sequence_end_time_us;
-         ts_us += frame_period_us, ++frame_id) {
+    // The frames are rendered in parallel by batches, and then encoded in order
+    const size_t batch_size = std::max(1, 2 * cv::getNumThreads());
+    std::vector<cv::Mat> frames(batch_size);
+    std::vector<std::vector<Metavision::Event2d>> frames_events(batch_size);
+    std::vector<Metavision::timestamp> frames_ts_us;
+    frames_ts_us.reserve(batch_size);
+
+    auto last                   = std::chrono::time_point<std::chrono::high_resolution_clock>::max();
+    int frame_id                = 0;
+    Metavision::timestamp ts_us = sequence_start_time_us;
+    while (ts_us <= sequence_end_time_us) {
         auto now   = std::chrono::high_resolution_clock::now();
         long delay = std::chrono::duration_cast<std::chrono::milliseconds>(now - last).count();
         if (frame_id == 0 || delay > 500) {
@@ -218,13 +228,44 @@ void AnalysisView::exportVideo() {
             cv::waitKey(1);
             last = now;
         }
-        makeSliceImage(frame, begin, end, ts_us, accumulation_time_us, frame_period_us, params.out_avi_fps, palette);
-        video_writer.write(frame);
+
+        frames_ts_us.clear();
+        for (; ts_us <= sequence_end_time_us && frames_ts_us.size() < batch_size; ts_us += frame_period_us) {
+            frames_ts_us.push_back(ts_us);
+        }
+        cv::parallel_for_(cv::Range(0, static_cast<int>(frames_ts_us.size())), [&](const cv::Range &range) {
+            for (int i = range.start; i < range.end; ++i) {
+                frames[i].create(sensor_size, CV_8UC3);
+                renderSlice(frames[i], frames_events[i], frames_ts_us[i], accumulation_time_us, frame_period_us,
+                            palette);
+            }
+        });
+        for (size_t i = 0; i < frames_ts_us.size(); ++i, ++frame_id) {
+            video_writer.write(frames[i]);
+        }
     }
     log << std::endl;
     MV_LOG_INFO() << "Done writing video, wrote" << n_frames << "frames";
 }
 
+size_t AnalysisView::renderSlice(cv::Mat &frame, std::vector<Metavision::Event2d> &events, Metavision::timestamp ts,
+                                 int accumulation_time_us, int frame_period_us,
+                                 const Metavision::ColorPalette &palette) const {
+    eventBuffer().slice(ts - accumulation_time_us, ts, events);
+    return makeSliceImage(frame, events.cbegin(), events.cend(), ts, accumulation_time_us, frame_period_us,
+                          Viewer::FRAME_RATE, palette);
+}
+
+size_t AnalysisView::renderFrame(cv::Mat &frame, Metavision::timestamp ts) {
+    const FrameCache::Key key{ts, accumulationTimeUs(), colorPalette()};
+    size_t num_events;
+    if (!frame_cache_.get(key, frame, num_events)) {
+        num_events = renderSlice(frame, frame_events_, ts, key.accumulation_time_us, framePeriodUs(), key.palette);
+        frame_cache_.put(key, frame, num_events);
+    }
+    return num_events;
+}
+
 void AnalysisView::update(cv::Mat &frame, int key_pressed) {
     const auto &event_buffer = eventBuffer();
     const auto &params       = parameters();
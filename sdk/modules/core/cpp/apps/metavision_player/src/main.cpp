@@ -66,7 +66,7 @@ bool parse_command_line(int argc, const char *argv[], Parameters &app_params) {
         ("help,h", "Produce help message.")
         ("biases,b",               po::value<std::string>(&app_params.in_bias_file), "Path to a bias file. If not specified, default biases will be used.")
         ("show-biases",            po::bool_switch(&app_params.show_biases)->default_value(false), "Show sliders to change biases dynamically.")
-        ("buffer-capacity,k",      po::value<int>(&app_params.buffer_size_mev)->default_value(100), "Max number of events to be stored in the buffer, in millions of events.")
+        ("buffer-memory,k",        po::value<int>(&app_params.buffer_size_mib)->default_value(1024), "Memory budget of the events history, in MiB. The events are stored compressed, the oldest ones being dropped once the budget is exceeded.")
         ("output-bias-file",       po::value<std::string>(&app_params.out_bias_file)->default_value((docs_path / "out.bias").string()), "Path to the output bias file for exporting, only available if --show-biases is used.")
         ("output-png-file,p",      po::value<std::string>(&app_params.out_png_file)->default_value((docs_path / "frame.png").string()), "Path to the output PNG file for exporting.")
         ("output-avi-file,v",      po::value<std::string>(&app_params.out_avi_file)->default_value((docs_path / "video.avi").string()), "Path to the output AVI file for exporting.")
@@ -108,10 +108,8 @@ int View::update() {
     }
 
     // Draw image and compute statistic message
-    auto &buffer             = eventBuffer();
     Metavision::timestamp ts = currentTimeUs();
-    size_t num_events = makeSliceImage(frame_, buffer.begin(), buffer.end(), ts, accumulationTimeUs(), framePeriodUs(),
-                                       Viewer::FRAME_RATE, colorPalette());
+    size_t num_events        = renderFrame(frame_, ts);
 
     update(frame_, key_pressed);
     if (helpVisible()) {
@@ -137,6 +135,13 @@ int View::update() {
     return key_pressed;
 }
 
+size_t View::renderFrame(cv::Mat &frame, Metavision::timestamp ts) {
+    const int accumulation_time_us = accumulationTimeUs();
+    eventBuffer().slice(ts - accumulation_time_us, ts, frame_events_);
+    return makeSliceImage(frame, frame_events_.cbegin(), frame_events_.cend(), ts, accumulation_time_us,
+                          framePeriodUs(), Viewer::FRAME_RATE, colorPalette());
+}
+
 void View::cycleColorPalette() {
     palette_ = static_cast<Metavision::ColorPalette>((static_cast<int>(palette_) + 1) % 3);
 }
@@ -17,7 +17,7 @@
 #include "analysis_view.h"
 
 Viewer::Viewer(const Parameters &parameters) :
-    parameters_(parameters), event_buffer_(parameters.buffer_size_mev * 1e6) {}
+    parameters_(parameters), event_buffer_(size_t(parameters.buffer_size_mib) * 1024 * 1024) {}
 
 Viewer::~Viewer() {}
 
@@ -65,17 +65,14 @@ void Viewer::run() {
     view_.reset(new CameraView(camera_, event_buffer_, parameters_, live));
 
     Metavision::timestamp ts = 0;
-    std::vector<Metavision::Event2d> input_evt_buffer;
-    bool paused = false;
+    bool paused              = false;
     while (paused || camera_.is_running()) {
         if (!paused) {
-            input_evt_buffer.clear();
             ts += view_->framePeriodUs();
             view_->setCurrentTimeUs(ts);
-            prod_->process_events(ts, std::back_inserter(input_evt_buffer));
 
             // Insert data into the buffer.
-            event_buffer_.insert(event_buffer_.end(), input_evt_buffer.cbegin(), input_evt_buffer.cend());
+            prod_->process_events(ts, std::back_inserter(event_buffer_));
         }
 
         int key_pressed = view_->update();
@@ -86,7 +83,7 @@ void Viewer::run() {
             // Enter/exit pause mode.
             paused = !paused;
             if (paused) {
-                if (event_buffer_.back().t - event_buffer_.front().t < 5'000) {
+                if (event_buffer_.empty() || event_buffer_.lastTimeUs() - event_buffer_.firstTimeUs() < 5'000) {
                     // Ignore the key until we have enough events in the buffer ...
                     paused = false;
                 } else {
@@ -14,6 +14,8 @@
 #include <stdexcept>
 
 #include "analysis_utils.h"
+#include "event_history.h"
+#include "frame_cache.h"
 
 TEST(PlayerTest, frame_period) {
     EXPECT_EQ(1'000'000, compute_frame_period(1));
@@ -169,4 +171,89 @@ TEST(PlayerTest, analysis_data_frame_id_changed) {
     EXPECT_EQ(360'000,
               compute_current_time(compute_sequence_start_time(first_time_us, last_time_us, frame_period_us, 0),
                                    data.frame_id, frame_period_us));
-}
\ No newline at end of file
+}
+
+TEST(PlayerTest, event_history_slice) {
+    // Chunks of 3 events, kept decoded 2 at a time
+    EventHistory history(1024 * 1024, 3, 2);
+    std::vector<Metavision::Event2d> events;
+    const std::vector<Metavision::timestamp> times{3, 3, 5, 10, 12, 12, 20, 31, 31, 31, 47, 60, 1'000'000};
+    for (size_t i = 0; i < times.size(); ++i) {
+        events.emplace_back(static_cast<unsigned short>(i * 37 % 640), static_cast<unsigned short>(479 - i * 53 % 480),
+                            static_cast<short>(i % 2), times[i]);
+        history.push_back(events.back());
+    }
+    EXPECT_EQ(events.size(), history.size());
+    EXPECT_EQ(3, history.firstTimeUs());
+    EXPECT_EQ(1'000'000, history.lastTimeUs());
+
+    // The slices are the same as the ones found in the decoded events, whether they span several chunks, the tail or
+    // the chunks cached
+    std::vector<Metavision::Event2d> slice;
+    for (Metavision::timestamp t_begin = -5; t_begin < 70; ++t_begin) {
+        for (Metavision::timestamp t_end = t_begin - 3; t_end < 75; t_end += 2) {
+            const auto expected = getSlice(events.cbegin(), events.cend(), t_begin, t_end);
+            const size_t n      = std::max<std::ptrdiff_t>(expected.second - expected.first, 0);
+            ASSERT_EQ(n, history.slice(t_begin, t_end, slice));
+            for (size_t i = 0; i < n; ++i) {
+                const auto &ev = expected.first[i];
+                EXPECT_EQ(ev.x, slice[i].x);
+                EXPECT_EQ(ev.y, slice[i].y);
+                EXPECT_EQ(ev.p, slice[i].p);
+                EXPECT_EQ(ev.t, slice[i].t);
+            }
+        }
+    }
+    EXPECT_EQ(1, history.slice(60, 1'000'000, slice));
+
+    history.clear();
+    EXPECT_TRUE(history.empty());
+    EXPECT_EQ(0, history.slice(0, 100, slice));
+}
+
+TEST(PlayerTest, event_history_drops_oldest_chunks) {
+    // Each event takes 3 bytes once encoded, hence a budget of 2 chunks of 100 events along with the tail
+    const size_t events_per_chunk = 100;
+    EventHistory history(events_per_chunk * (sizeof(Metavision::Event2d) + 2 * 3), events_per_chunk);
+    for (Metavision::timestamp t = 0; t < 1000; ++t) {
+        history.push_back(Metavision::Event2d(1, 2, 1, t));
+    }
+    EXPECT_EQ(2 * events_per_chunk * 3, history.encodedBytes());
+    EXPECT_EQ(2 * events_per_chunk, history.size());
+    EXPECT_EQ(800, history.firstTimeUs());
+    EXPECT_EQ(999, history.lastTimeUs());
+
+    std::vector<Metavision::Event2d> slice;
+    EXPECT_EQ(0, history.slice(-1, 799, slice));
+    EXPECT_EQ(200, history.slice(-1, 1000, slice));
+    EXPECT_EQ(800, slice.front().t);
+}
+
+TEST(PlayerTest, frame_cache_evicts_least_recently_used) {
+    const cv::Mat frame(10, 10, CV_8UC3, cv::Scalar(1, 2, 3));
+    const size_t frame_bytes = frame.total() * frame.elemSize();
+    FrameCache cache(2 * frame_bytes);
+    const FrameCache::Key key_0{0, 10, Metavision::ColorPalette::Light};
+    const FrameCache::Key key_1{1, 10, Metavision::ColorPalette::Light};
+    const FrameCache::Key key_2{1, 10, Metavision::ColorPalette::Dark};
+    cache.put(key_0, frame, 5);
+    cache.put(key_1, frame, 6);
+
+    cv::Mat cached_frame;
+    size_t num_events = 0;
+    ASSERT_TRUE(cache.get(key_0, cached_frame, num_events));
+    EXPECT_EQ(5, num_events);
+    EXPECT_EQ(0., cv::norm(frame, cached_frame, cv::NORM_INF));
+
+    // key_1 is the least recently used, hence evicted
+    cache.put(key_2, frame, 7);
+    EXPECT_EQ(2, cache.size());
+    EXPECT_FALSE(cache.get(key_1, cached_frame, num_events));
+    EXPECT_TRUE(cache.get(key_0, cached_frame, num_events));
+    ASSERT_TRUE(cache.get(key_2, cached_frame, num_events));
+    EXPECT_EQ(7, num_events);
+
+    cache.clear();
+    EXPECT_EQ(0, cache.size());
+    EXPECT_FALSE(cache.get(key_0, cached_frame, num_events));
+}
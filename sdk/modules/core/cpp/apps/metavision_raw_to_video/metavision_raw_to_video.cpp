@@ -11,14 +11,27 @@
 
 // Example of using Metavision SDK Driver and Core API for generating a video from a RAW file.
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
 #include <iostream>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <thread>
 #include <boost/program_options.hpp>
 #include <boost/filesystem.hpp>
 #include <opencv2/highgui.hpp>
 #include <opencv2/imgcodecs.hpp>
 #include <opencv2/imgproc.hpp>
+#include <metavision/hal/device/device_discovery.h>
+#include <metavision/hal/utils/hal_exception.h>
+#include <metavision/hal/utils/raw_file_config.h>
 #include <metavision/sdk/base/utils/log.h>
 #include <metavision/sdk/driver/camera.h>
+#include <metavision/sdk/driver/event_file_reader.h>
+#include <metavision/sdk/core/algorithms/on_demand_frame_generation_algorithm.h>
 #include <metavision/sdk/core/algorithms/periodic_frame_generation_algorithm.h>
 #include <metavision/sdk/core/utils/cv_video_recorder.h>
 
@@ -28,6 +41,131 @@ void remove_file(const std::string &filepath) {
     boost::filesystem::remove(boost::filesystem::path(filepath));
 }
 
+// Number of consecutive frames rendered at once by a thread in parallel mode
+constexpr size_t n_frames_per_range = 32;
+
+// Frames of a time range of the file, rendered by a thread in parallel mode
+struct FrameRange {
+    std::vector<cv::Mat> frames;
+    bool last = false; // true if the end of the file has been reached
+};
+
+// Opens a reader per thread, each one able to seek in the file, building its index if needed
+std::vector<std::unique_ptr<Metavision::EventFileReader>>
+    open_seekable_readers(const std::string &in_raw_file_path, Metavision::timestamp frame_period,
+                          unsigned int n_threads) {
+    try {
+        Metavision::RawFileConfig config;
+        config.build_index_ = true;
+        Metavision::DeviceDiscovery::open_raw_file(in_raw_file_path, config);
+    } catch (Metavision::HalException &) { return {}; }
+
+    std::vector<std::unique_ptr<Metavision::EventFileReader>> readers;
+    for (unsigned int i = 0; i < n_threads; ++i) {
+        readers.emplace_back(new Metavision::EventFileReader(in_raw_file_path, frame_period));
+        if (!readers.back()->seek(0)) {
+            return {};
+        }
+    }
+    return readers;
+}
+
+// Renders the frames of the file on several threads, each one rendering ranges of consecutive frames by seeking to
+// their beginning in the file, and writes them in order. The frames are generated at the same timestamps as with a
+// PeriodicFrameGenerationAlgorithm: at each multiple of the frame period following the first event, up to the last
+// event.
+void render_in_parallel(std::vector<std::unique_ptr<Metavision::EventFileReader>> &readers, int width, int height,
+                        uint32_t accumulation_time, Metavision::timestamp frame_period,
+                        Metavision::CvVideoRecorder &recorder) {
+    Metavision::EventFileSlice first_slice;
+    if (!readers[0]->read_next_slice(first_slice)) {
+        return;
+    }
+    const Metavision::timestamp first_frame_ts = first_slice.begin_ts + frame_period;
+
+    std::mutex mutex;
+    std::condition_variable cond;
+    std::map<size_t, FrameRange> rendered;
+    size_t n_written = 0;
+    bool done        = false;
+    std::atomic<size_t> next_range{0}, end_range{std::numeric_limits<size_t>::max()};
+    const size_t max_ranges_in_flight = 2 * readers.size();
+
+    auto render = [&](Metavision::EventFileReader &reader) {
+        Metavision::OnDemandFrameGenerationAlgorithm frame_generation(width, height, accumulation_time);
+        Metavision::EventFileSlice slice;
+        for (size_t r = next_range++; r <= end_range; r = next_range++) {
+            {
+                // The number of frames rendered but not written yet is bounded
+                std::unique_lock<std::mutex> lock(mutex);
+                cond.wait(lock, [&] { return done || r < n_written + max_ranges_in_flight; });
+                if (done) {
+                    return;
+                }
+            }
+
+            FrameRange range;
+            Metavision::timestamp frame_ts =
+                first_frame_ts + static_cast<Metavision::timestamp>(r * n_frames_per_range) * frame_period;
+            reader.seek(frame_ts - accumulation_time);
+            frame_generation.reset();
+            range.last = true;
+            while (reader.read_next_slice(slice)) {
+                // As in sequential mode, a frame is generated only once the events reach its timestamp
+                for (; frame_ts <= slice.begin_ts && range.frames.size() < n_frames_per_range;
+                     frame_ts += frame_period) {
+                    range.frames.emplace_back();
+                    frame_generation.generate(frame_ts, range.frames.back());
+                }
+                if (range.frames.size() == n_frames_per_range) {
+                    range.last = false;
+                    break;
+                }
+                frame_generation.process_events(slice.cd_events.cbegin(), slice.cd_events.cend());
+            }
+            if (range.last) {
+                end_range = std::min<size_t>(end_range, r);
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            rendered[r] = std::move(range);
+            cond.notify_all();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (auto &reader : readers) {
+        threads.emplace_back(render, std::ref(*reader));
+    }
+
+    for (size_t r = 0;; ++r) {
+        FrameRange range;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cond.wait(lock, [&] { return rendered.count(r) > 0; });
+            range = std::move(rendered[r]);
+            rendered.erase(r);
+            ++n_written;
+            cond.notify_all();
+        }
+        for (auto &frame : range.frames) {
+            recorder.write(frame);
+        }
+        if (range.last) {
+            break;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        done = true;
+        cond.notify_all();
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+}
+
 int main(int argc, char *argv[]) {
     std::string in_raw_file_path;
     std::string out_video_file_path;
@@ -36,6 +174,8 @@ int main(int argc, char *argv[]) {
     double slow_motion_factor;
     std::uint16_t fps;
     std::string fourcc;
+    std::string hw_acceleration;
+    unsigned int n_threads;
 
     const std::string program_desc("Application to generate a video from RAW file.\n");
 
@@ -49,6 +189,8 @@ int main(int argc, char *argv[]) {
         ("fps",                  po::value<std::uint16_t>(&fps)->default_value(30), "Frame rate of the video to generate.")
         ("slow-motion-factor,s", po::value<double>(&slow_motion_factor)->default_value(1.), "Slow motion factor (or fast for value lower than 1) to apply to generate the video.")
         ("fourcc",               po::value<std::string>(&fourcc)->default_value("MJPG"), "Fourcc 4-character code of codec used to compress the frames. List of codes can be obtained at [Video Codecs by FOURCC](http://www.fourcc.org/codecs.php) page.")
+        ("hw-acceleration",      po::value<std::string>(&hw_acceleration)->default_value("none"), "Hardware acceleration of the encoding, done by OpenCV's video backends: none, any, vaapi, d3d11 or mfx (Intel QuickSync).")
+        ("threads,j",            po::value<unsigned int>(&n_threads)->default_value(1), "Number of threads rendering the frames. With more than one thread, ranges of frames are rendered in parallel by seeking in the file, whose index is built first if needed.")
     ;
     // clang-format on
     po::variables_map vm;
@@ -90,35 +232,72 @@ int main(int argc, char *argv[]) {
     // Get the geometry of the camera
     auto &geometry = camera.geometry();
 
+    std::vector<int> encoder_params;
+    try {
+        encoder_params = Metavision::VideoWriter::get_hw_acceleration_params(hw_acceleration);
+    } catch (std::invalid_argument &e) {
+        MV_LOG_ERROR() << e.what();
+        return 1;
+    }
+
     // Set up video write
     Metavision::CvVideoRecorder recorder(out_video_file_path,
                                          cv::VideoWriter::fourcc(fourcc[0], fourcc[1], fourcc[2], fourcc[3]), fps,
-                                         cv::Size(geometry.width(), geometry.height()), true);
+                                         cv::Size(geometry.width(), geometry.height()), true, encoder_params);
 
     recorder.start();
 
+    // In parallel mode, the frames are rendered from the file read by the threads, and written by another one
+    const double video_fps                  = slow_motion_factor * fps;
+    const Metavision::timestamp frame_period = static_cast<Metavision::timestamp>(std::round(1000000 / video_fps));
+    std::vector<std::unique_ptr<Metavision::EventFileReader>> readers;
+    if (n_threads > 1) {
+        try {
+            readers = open_seekable_readers(in_raw_file_path, frame_period, n_threads);
+        } catch (Metavision::CameraException &e) {
+            MV_LOG_ERROR() << e.what();
+            return 1;
+        }
+        if (readers.empty()) {
+            MV_LOG_WARNING() << "The RAW file can not be indexed, the frames are rendered sequentially.";
+        }
+    }
+
     // Set up frame generator
     Metavision::PeriodicFrameGenerationAlgorithm frame_generation(geometry.width(), geometry.height());
     frame_generation.set_accumulation_time_us(accumulation_time);
-    frame_generation.set_fps(slow_motion_factor * fps);
-    frame_generation.set_output_callback(
-        [&](Metavision::timestamp frame_ts, cv::Mat &cd_frame) { recorder.write(cd_frame); });
-
-    // Set up cd callback to process the events
-    camera.cd().add_callback([&](const Metavision::EventCD *ev_begin, const Metavision::EventCD *ev_end) {
-        frame_generation.process_events(ev_begin, ev_end);
-    });
-
-    // Set up a change of status callback
-    camera.add_status_change_callback([&recorder](const Metavision::CameraStatus &status) {
-        // When the camera stops, we stop the recorder as well and wait for all the frames to be written.
-        if (status == Metavision::CameraStatus::STOPPED) {
+    frame_generation.set_fps(video_fps);
+    // The frames are queued to the recorder without being copied, and go back to the pool of the generation once
+    // encoded
+    frame_generation.set_pooled_output_callback(
+        [&](Metavision::timestamp frame_ts, const Metavision::CvVideoRecorder::FramePtr &cd_frame) {
+            recorder.write(cd_frame);
+        });
+
+    std::thread rendering_thread;
+    if (!readers.empty()) {
+        rendering_thread = std::thread([&] {
+            render_in_parallel(readers, geometry.width(), geometry.height(), accumulation_time, frame_period,
+                               recorder);
             recorder.stop();
-        }
-    });
+        });
+    } else {
+        // Set up cd callback to process the events
+        camera.cd().add_callback([&](const Metavision::EventCD *ev_begin, const Metavision::EventCD *ev_end) {
+            frame_generation.process_events(ev_begin, ev_end);
+        });
+
+        // Set up a change of status callback
+        camera.add_status_change_callback([&recorder](const Metavision::CameraStatus &status) {
+            // When the camera stops, we stop the recorder as well and wait for all the frames to be written.
+            if (status == Metavision::CameraStatus::STOPPED) {
+                recorder.stop();
+            }
+        });
 
-    // Start the camera streaming
-    camera.start();
+        // Start the camera streaming
+        camera.start();
+    }
 
     // Display a follow up message
     auto log = MV_LOG_INFO() << Metavision::Log::no_space << Metavision::Log::no_endline;
@@ -133,6 +312,10 @@ int main(int argc, char *argv[]) {
         std::this_thread::sleep_for(std::chrono::milliseconds(500));
     }
 
+    if (rendering_thread.joinable()) {
+        rendering_thread.join();
+    }
+
     log << "\rVideo has been saved in " << out_video_file_path << std::endl;
     return 0;
 }
@@ -20,7 +20,7 @@ def decode_fourcc(cc):
     return "".join([chr((int(cc) >> 8 * i) & 0xFF) for i in range(4)])
 
 
-def generate_video(filename_full, fps, expected_video_infos):
+def generate_video(filename_full, fps, expected_video_infos, threads=1):
 
     # Before launching the app, check the dataset file exists
     assert os.path.exists(filename_full)
@@ -28,7 +28,8 @@ def generate_video(filename_full, fps, expected_video_infos):
     tmp_dir = os_tools.TemporaryDirectoryHandler()
     output_video = os.path.join(tmp_dir.temporary_directory(), "out.avi")
 
-    cmd = "./metavision_raw_to_video -i \"{}\" --fps {} -o {} --fourcc MJPG".format(filename_full, fps, output_video)
+    cmd = "./metavision_raw_to_video -i \"{}\" --fps {} -o {} --fourcc MJPG -j {}".format(filename_full, fps,
+                                                                                        output_video, threads)
     output, error_code = pytest_tools.run_cmd_setting_mv_log_file(cmd)
 
     # Check app exited without error
@@ -112,6 +113,17 @@ def pytestcase_test_metavision_raw_to_video_on_gen31_recording_30fps(dataset_dir
     generate_video(filename_full, 30, expected_video_infos)
 
 
+def pytestcase_test_metavision_raw_to_video_on_gen31_recording_30fps_in_parallel(dataset_dir):
+    """
+    Checks that metavision_raw_to_video renders the same number of frames with several threads
+    """
+
+    filename = "gen31_timer.raw"
+    filename_full = os.path.join(dataset_dir, filename)
+    expected_video_infos = {'width': 640, 'height': 480, 'frame-count': 391}
+    generate_video(filename_full, 30, expected_video_infos, threads=4)
+
+
 def pytestcase_test_metavision_raw_to_video_on_gen4_evt2_recording_25fps(dataset_dir):
     """
     Checks output of metavision_raw_to_video application
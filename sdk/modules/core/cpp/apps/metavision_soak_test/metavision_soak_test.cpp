@@ -0,0 +1,540 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+// Application opening several sources in one process, each one processed by its own pipeline, and recording over time
+// the throughput, the drops and the latency of each source along with the CPU and memory usage of the process, to find
+// the number of sources at which the host saturates.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <boost/program_options.hpp>
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+#include <metavision/hal/facilities/i_events_stream.h>
+#include <metavision/hal/utils/performance_profile.h>
+#include <metavision/sdk/base/utils/log.h>
+#include <metavision/sdk/core/algorithms/activity_noise_filter_algorithm.h>
+#include <metavision/sdk/core/algorithms/polarity_filter_algorithm.h>
+#include <metavision/sdk/core/pipeline/frame_generation_stage.h>
+#include <metavision/sdk/core/pipeline/pipeline.h>
+#include <metavision/sdk/driver/camera.h>
+#include <metavision/sdk/driver/pipeline/camera_stage.h>
+
+namespace po = boost::program_options;
+
+namespace {
+
+std::atomic<bool> interrupted{false};
+
+void on_signal(int) {
+    interrupted = true;
+}
+
+const std::string synthetic_prefix = "synthetic:";
+
+struct ProcessUsage {
+    double cpu_time_s  = 0.;
+    size_t rss_kib     = 0; // current resident memory, or the peak one where it is not available
+    size_t num_threads = 0; // 0 if not available
+};
+
+ProcessUsage get_process_usage() {
+    ProcessUsage usage;
+#ifdef _WIN32
+    FILETIME creation, exit, kernel, user;
+    if (GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user)) {
+        auto to_s = [](const FILETIME &t) {
+            return ((static_cast<uint64_t>(t.dwHighDateTime) << 32) | t.dwLowDateTime) * 1e-7;
+        };
+        usage.cpu_time_s = to_s(kernel) + to_s(user);
+    }
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        usage.rss_kib = counters.WorkingSetSize / 1024;
+    }
+#else
+    struct rusage r;
+    if (getrusage(RUSAGE_SELF, &r) == 0) {
+        usage.cpu_time_s = r.ru_utime.tv_sec + r.ru_stime.tv_sec + (r.ru_utime.tv_usec + r.ru_stime.tv_usec) * 1e-6;
+#ifdef __APPLE__
+        usage.rss_kib = r.ru_maxrss / 1024;
+#else
+        usage.rss_kib = r.ru_maxrss;
+#endif
+    }
+#ifdef __linux__
+    std::ifstream statm("/proc/self/statm");
+    size_t size_pages = 0, rss_pages = 0;
+    if (statm >> size_pages >> rss_pages) {
+        usage.rss_kib = rss_pages * static_cast<size_t>(sysconf(_SC_PAGESIZE)) / 1024;
+    }
+    std::ifstream status("/proc/self/status");
+    for (std::string line; std::getline(status, line);) {
+        if (line.compare(0, 8, "Threads:") == 0) {
+            usage.num_threads = std::stoul(line.substr(8));
+            break;
+        }
+    }
+#endif
+#endif
+    return usage;
+}
+
+// Processing applied to the events of each source
+struct PipelineConfig {
+    std::vector<std::string> filters;
+    Metavision::timestamp activity_threshold_us;
+    int polarity;
+    bool generate_frames;
+    uint32_t accumulation_time_ms;
+    double fps;
+    Metavision::PerformanceProfile profile;
+};
+
+// Counters of a source, cumulated since it was opened
+struct SourceSample {
+    uint64_t num_events = 0;
+    uint64_t num_drops  = 0;
+    Metavision::CameraLatencyStatistics latency;
+    bool running = false;
+};
+
+// Source processed by its own pipeline, run by its own thread
+class SourceRun {
+public:
+    SourceRun(const std::string &source, const PipelineConfig &config) : source_(source), pipeline_(true) {
+        Metavision::Camera camera;
+        if (source.compare(0, synthetic_prefix.size(), synthetic_prefix) == 0 || !std::ifstream(source).good()) {
+            camera = Metavision::Camera::from_serial(source);
+        } else {
+            // Files are replayed in a loop at the pace of their recording, as a camera would stream
+            Metavision::FileReplayConfig replay_config;
+            replay_config.loop                = true;
+            replay_config.performance_profile = config.profile;
+            camera                            = Metavision::Camera::from_file(source, replay_config);
+        }
+        camera.enable_latency_statistics();
+        camera.cd().add_callback([this](const Metavision::EventCD *begin, const Metavision::EventCD *end) {
+            num_events_.fetch_add(std::distance(begin, end), std::memory_order_relaxed);
+        });
+        events_stream_   = camera.get_device().get_facility<Metavision::I_EventsStream>();
+        const int width  = camera.geometry().width();
+        const int height = camera.geometry().height();
+
+        camera_stage_ =
+            &pipeline_.add_stage(std::make_unique<Metavision::CameraStage>(std::move(camera), config.profile));
+        Metavision::BaseStage *last_stage = camera_stage_;
+        stages_.push_back(last_stage);
+        for (const auto &filter : config.filters) {
+            if (filter == "activity") {
+                last_stage = &pipeline_.add_algorithm_stage(std::make_unique<Metavision::ActivityNoiseFilterAlgorithm>(
+                                                                width, height, config.activity_threshold_us),
+                                                            *last_stage, true);
+            } else if (filter == "polarity") {
+                last_stage = &pipeline_.add_algorithm_stage(
+                    std::make_unique<Metavision::PolarityFilterAlgorithm>(static_cast<std::int16_t>(config.polarity)),
+                    *last_stage, true);
+            } else if (filter != "none") {
+                throw std::invalid_argument("Unknown filter: " + filter);
+            }
+            if (last_stage != stages_.back()) {
+                stages_.push_back(last_stage);
+            }
+        }
+        if (config.generate_frames) {
+            stages_.push_back(&pipeline_.add_stage(std::make_unique<Metavision::FrameGenerationStage>(width, height,
+                                                                                   config.accumulation_time_ms,
+                                                                                   config.fps),
+                                                   *last_stage));
+        }
+
+        thread_ = std::thread([this] { pipeline_.run(); });
+    }
+
+    ~SourceRun() {
+        stop();
+    }
+
+    void stop() {
+        if (thread_.joinable()) {
+            pipeline_.cancel();
+            thread_.join();
+        }
+    }
+
+    const std::string &source() const {
+        return source_;
+    }
+
+    SourceSample sample() const {
+        SourceSample sample;
+        sample.num_events = num_events_.load(std::memory_order_relaxed);
+        sample.num_drops  = events_stream_ ? events_stream_->get_buffering_statistics().drops : 0;
+        for (const auto *stage : stages_) {
+            sample.num_drops += stage->num_dropped_inputs();
+        }
+        sample.latency = camera_stage_->camera().get_latency_statistics();
+        sample.running = pipeline_.status() == Metavision::Pipeline::Status::Started;
+        return sample;
+    }
+
+private:
+    std::string source_;
+    Metavision::Pipeline pipeline_;
+    Metavision::CameraStage *camera_stage_        = nullptr;
+    Metavision::I_EventsStream *events_stream_    = nullptr;
+    std::vector<const Metavision::BaseStage *> stages_;
+    std::atomic<uint64_t> num_events_{0};
+    std::thread thread_;
+};
+
+// Counters of all the sources and of the process at a given time
+struct Snapshot {
+    std::chrono::steady_clock::time_point time;
+    std::vector<SourceSample> sources;
+    ProcessUsage usage;
+
+    uint64_t num_events() const {
+        uint64_t n = 0;
+        for (const auto &s : sources) {
+            n += s.num_events;
+        }
+        return n;
+    }
+
+    uint64_t num_drops() const {
+        uint64_t n = 0;
+        for (const auto &s : sources) {
+            n += s.num_drops;
+        }
+        return n;
+    }
+
+    double max_latency_p99_us() const {
+        double p99 = 0.;
+        for (const auto &s : sources) {
+            p99 = std::max(p99, s.latency.transfer_to_callback.p99_us);
+        }
+        return p99;
+    }
+};
+
+Snapshot take_snapshot(const std::vector<std::unique_ptr<SourceRun>> &runs) {
+    Snapshot snapshot;
+    snapshot.time = std::chrono::steady_clock::now();
+    for (const auto &run : runs) {
+        snapshot.sources.push_back(run->sample());
+    }
+    snapshot.usage = get_process_usage();
+    return snapshot;
+}
+
+double seconds(std::chrono::steady_clock::duration d) {
+    return std::chrono::duration<double>(d).count();
+}
+
+// Reports the activity of the sources between two snapshots, the sources added meanwhile starting from nothing
+void report(const Snapshot &prev, const Snapshot &cur, const std::vector<std::unique_ptr<SourceRun>> &runs,
+            double elapsed_s, std::ofstream &csv) {
+    const double dt       = std::max(seconds(cur.time - prev.time), 1e-6);
+    const double cpu      = 100. * (cur.usage.cpu_time_s - prev.usage.cpu_time_s) / dt;
+    const double rss_mib  = cur.usage.rss_kib / 1024.;
+    double total_rate_mev = 0.;
+    uint64_t total_drops  = 0;
+
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(1);
+    for (size_t i = 0; i < cur.sources.size(); ++i) {
+        const SourceSample empty;
+        const auto &p        = i < prev.sources.size() ? prev.sources[i] : empty;
+        const auto &c        = cur.sources[i];
+        const double rate    = (c.num_events - p.num_events) / dt / 1e6;
+        const uint64_t drops = c.num_drops - p.num_drops;
+        total_rate_mev += rate;
+        total_drops += drops;
+        oss << "\n  [" << i << "] " << std::setw(8) << rate << " Mev/s, " << drops << " drops, latency p50 "
+            << c.latency.transfer_to_callback.p50_us << " us p99 " << c.latency.transfer_to_callback.p99_us << " us"
+            << (c.running ? "" : " (stopped)");
+        if (csv) {
+            csv << std::fixed << std::setprecision(3) << elapsed_s << "," << cur.sources.size() << "," << i << ","
+                << runs[i]->source() << "," << rate << "," << drops << "," << c.latency.transfer_to_callback.p50_us
+                << "," << c.latency.transfer_to_callback.p99_us << "," << cpu << "," << rss_mib << ","
+                << cur.usage.num_threads << "\n";
+        }
+    }
+    if (csv) {
+        csv.flush();
+    }
+
+    std::ostringstream header;
+    header << std::fixed << std::setprecision(1) << "t=" << elapsed_s << " s, " << cur.sources.size()
+           << " sources: " << total_rate_mev << " Mev/s, " << total_drops << " drops, CPU " << cpu << "%, RSS "
+           << rss_mib << " MiB";
+    if (cur.usage.num_threads > 0) {
+        header << ", " << cur.usage.num_threads << " threads";
+    }
+    MV_LOG_INFO() << Metavision::Log::no_space << header.str() << oss.str();
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    std::vector<std::string> inputs;
+    size_t num_sources;
+    double duration_s, report_period_s, ramp_period_s;
+    double rate_tolerance, max_latency_ms, max_cpu_percent;
+    bool keep_running = false;
+    std::string profile_name;
+    std::string output_csv;
+    PipelineConfig config;
+
+    const std::string program_desc(
+        "Application opening several sources in one process, each one processed by its own pipeline, and recording "
+        "over time the throughput, the drops and the latency of each source, along with the CPU and memory usage of "
+        "the process.\n\n"
+        "The sources are opened in turn from the inputs, which are serials of cameras, RAW files replayed in a loop at "
+        "the pace of their recording, or serials of synthetic sources of the sample plugin, like "
+        "\"synthetic:rate=20M\".\n"
+        "With a ramp period, the sources are added one by one until the host saturates: some data is dropped, the "
+        "throughput per source falls, or the latency or the CPU usage exceeds its maximum.\n");
+
+    po::options_description options_desc("Options");
+    // clang-format off
+    options_desc.add_options()
+        ("help,h", "Produce help message.")
+        ("input,i",              po::value<std::vector<std::string>>(&inputs)->multitoken()->required(), "Serials of the cameras or synthetic sources, or paths to RAW files, opened in turn.")
+        ("num-sources,n",        po::value<size_t>(&num_sources)->default_value(0), "Number of sources to open, 0 for the number of inputs. With a ramp period, maximum number of sources.")
+        ("duration,t",           po::value<double>(&duration_s)->default_value(0.), "Duration of the test (in s), 0 to run until interrupted.")
+        ("report-period,r",      po::value<double>(&report_period_s)->default_value(10.), "Period of the reports (in s).")
+        ("ramp-period",          po::value<double>(&ramp_period_s)->default_value(0.), "Period at which the sources are added one by one (in s), 0 to open them all at once.")
+        ("rate-tolerance",       po::value<double>(&rate_tolerance)->default_value(0.05), "Fraction of the throughput per source of a single source below which the host is saturated.")
+        ("max-latency",          po::value<double>(&max_latency_ms)->default_value(100.), "Latency p99 above which the host is saturated (in ms).")
+        ("max-cpu",              po::value<double>(&max_cpu_percent)->default_value(0.), "CPU usage above which the host is saturated (in % of a core), 0 for 95% of the cores.")
+        ("keep-running",         po::bool_switch(&keep_running), "Keep running with the sources opened once the host is saturated, instead of stopping.")
+        ("profile,p",            po::value<std::string>(&profile_name)->default_value("balanced"), "Performance profile of the sources: low-latency, balanced or high-throughput.")
+        ("filters,f",            po::value<std::vector<std::string>>(&config.filters)->multitoken()->default_value({"activity"}, "activity"), "Filters applied to the events of each source, in order: activity and/or polarity. Use \"none\" to disable the filtering.")
+        ("activity-threshold",   po::value<Metavision::timestamp>(&config.activity_threshold_us)->default_value(20000), "Threshold of the activity noise filter (in us).")
+        ("polarity",             po::value<int>(&config.polarity)->default_value(1), "Polarity of the events kept by the polarity filter.")
+        ("frames",               po::bool_switch(&config.generate_frames), "Generate frames from the events of each source.")
+        ("accumulation-time,a",  po::value<uint32_t>(&config.accumulation_time_ms)->default_value(10), "Accumulation time of the frames (in ms).")
+        ("fps",                  po::value<double>(&config.fps)->default_value(30.), "Frame rate of the frames generated.")
+        ("output-csv,o",         po::value<std::string>(&output_csv), "Path to an output CSV file recording the reports of each source.")
+    ;
+    // clang-format on
+
+    po::variables_map vm;
+    try {
+        po::store(po::command_line_parser(argc, argv).options(options_desc).run(), vm);
+        if (vm.count("help")) {
+            MV_LOG_INFO() << program_desc;
+            MV_LOG_INFO() << options_desc;
+            return 0;
+        }
+        po::notify(vm);
+    } catch (po::error &e) {
+        MV_LOG_ERROR() << program_desc;
+        MV_LOG_ERROR() << options_desc;
+        MV_LOG_ERROR() << "Parsing error:" << e.what();
+        return 1;
+    }
+
+    if (profile_name == "low-latency") {
+        config.profile = Metavision::PerformanceProfile::LowLatency;
+    } else if (profile_name == "balanced") {
+        config.profile = Metavision::PerformanceProfile::Balanced;
+    } else if (profile_name == "high-throughput") {
+        config.profile = Metavision::PerformanceProfile::HighThroughput;
+    } else {
+        MV_LOG_ERROR() << "Unknown performance profile:" << profile_name;
+        return 1;
+    }
+    if (num_sources == 0) {
+        num_sources = inputs.size();
+    }
+    if (report_period_s <= 0.) {
+        MV_LOG_ERROR() << "The report period must be positive.";
+        return 1;
+    }
+    if (max_cpu_percent <= 0.) {
+        max_cpu_percent = 95. * std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    std::ofstream csv;
+    if (!output_csv.empty()) {
+        csv.open(output_csv);
+        if (!csv) {
+            MV_LOG_ERROR() << "Unable to open" << output_csv;
+            return 1;
+        }
+        csv << "time_s,num_sources,source_index,source,rate_mev_s,drops,latency_p50_us,latency_p99_us,cpu_percent,"
+               "rss_mib,num_threads\n";
+    }
+
+    std::signal(SIGINT, on_signal);
+    std::signal(SIGTERM, on_signal);
+
+    std::vector<std::unique_ptr<SourceRun>> runs;
+    auto add_source = [&]() {
+        const std::string &input = inputs[runs.size() % inputs.size()];
+        try {
+            runs.emplace_back(new SourceRun(input, config));
+        } catch (const std::exception &e) {
+            MV_LOG_ERROR() << "Unable to open source" << input << ":" << e.what();
+            return false;
+        }
+        MV_LOG_INFO() << "Opened source" << runs.size() - 1 << ":" << input;
+        return true;
+    };
+
+    const bool ramp = ramp_period_s > 0.;
+    for (size_t i = 0; i < (ramp ? 1 : num_sources); ++i) {
+        if (!add_source()) {
+            return 1;
+        }
+    }
+
+    using clock      = std::chrono::steady_clock;
+    auto to_duration = [](double s) {
+        return std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(s));
+    };
+    const auto start = clock::now();
+    auto next_report = start + to_duration(report_period_s);
+    Snapshot last    = take_snapshot(runs);
+
+    // The throughput of a step of the ramp is measured once the source added has settled, over its last 3 quarters
+    bool ramping        = ramp;
+    auto step_start     = start;
+    bool step_measuring = false;
+    Snapshot step_begin;
+    double single_rate  = 0.;
+    size_t saturated_at = 0;
+    std::string saturation_reason;
+
+    while (!interrupted) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        const auto now       = clock::now();
+        const double elapsed = seconds(now - start);
+        if (duration_s > 0. && elapsed >= duration_s) {
+            break;
+        }
+
+        if (now >= next_report) {
+            Snapshot cur = take_snapshot(runs);
+            report(last, cur, runs, elapsed, csv);
+            last = std::move(cur);
+            next_report += to_duration(report_period_s);
+            if (std::none_of(last.sources.begin(), last.sources.end(),
+                             [](const SourceSample &s) { return s.running; })) {
+                MV_LOG_INFO() << "All the sources have stopped.";
+                break;
+            }
+        }
+
+        if (!ramping) {
+            continue;
+        }
+        if (!step_measuring && now >= step_start + to_duration(ramp_period_s / 4)) {
+            step_begin     = take_snapshot(runs);
+            step_measuring = true;
+        }
+        if (now < step_start + to_duration(ramp_period_s)) {
+            continue;
+        }
+
+        const Snapshot step_end = take_snapshot(runs);
+        const double dt         = std::max(seconds(step_end.time - step_begin.time), 1e-6);
+        const double rate       = (step_end.num_events() - step_begin.num_events()) / dt / runs.size();
+        const uint64_t drops    = step_end.num_drops() - step_begin.num_drops();
+        const double cpu        = 100. * (step_end.usage.cpu_time_s - step_begin.usage.cpu_time_s) / dt;
+        const double p99_ms     = step_end.max_latency_p99_us() / 1000.;
+        if (runs.size() == 1) {
+            single_rate = rate;
+        }
+        MV_LOG_INFO() << Metavision::Log::no_space << "Ramp step with " << runs.size() << " sources: " << rate / 1e6
+                      << " Mev/s per source, " << drops << " drops, CPU " << cpu << "%, latency p99 " << p99_ms
+                      << " ms";
+
+        std::ostringstream reason;
+        if (drops > 0) {
+            reason << drops << " drops";
+        } else if (rate < (1. - rate_tolerance) * single_rate) {
+            reason << "throughput per source down to " << 100. * rate / single_rate << "% of a single source";
+        } else if (p99_ms > max_latency_ms) {
+            reason << "latency p99 of " << p99_ms << " ms";
+        } else if (cpu > max_cpu_percent) {
+            reason << "CPU usage of " << cpu << "%";
+        }
+        if (!reason.str().empty()) {
+            saturated_at      = runs.size();
+            saturation_reason = reason.str();
+            MV_LOG_INFO() << Metavision::Log::no_space << "The host saturates with " << saturated_at << " sources ("
+                          << saturation_reason << ")";
+            ramping = false;
+            if (!keep_running) {
+                break;
+            }
+            continue;
+        }
+        if (runs.size() >= num_sources) {
+            MV_LOG_INFO() << "The host does not saturate with" << runs.size() << "sources";
+            ramping = false;
+            continue;
+        }
+        if (!add_source()) {
+            break;
+        }
+        step_start     = clock::now();
+        step_measuring = false;
+    }
+
+    // Summary of the whole run, before stopping the sources
+    const Snapshot end   = take_snapshot(runs);
+    const double total_s = std::max(seconds(end.time - start), 1e-6);
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(1) << "Ran " << runs.size() << " sources for " << total_s << " s:";
+    for (size_t i = 0; i < end.sources.size(); ++i) {
+        const auto &s = end.sources[i];
+        oss << "\n  [" << i << "] " << runs[i]->source() << ": " << s.num_events << " events, " << s.num_drops
+            << " drops, latency p50 " << s.latency.transfer_to_callback.p50_us << " us p99 "
+            << s.latency.transfer_to_callback.p99_us << " us p99.9 " << s.latency.transfer_to_callback.p999_us
+            << " us";
+    }
+    oss << "\nMean CPU usage: " << 100. * end.usage.cpu_time_s / total_s << "%, RSS: " << end.usage.rss_kib / 1024
+        << " MiB";
+    if (ramp) {
+        if (saturated_at > 0) {
+            oss << "\nThe host saturates with " << saturated_at << " sources (" << saturation_reason << ")";
+        } else {
+            oss << "\nThe host did not saturate with " << runs.size() << " sources";
+        }
+    }
+    MV_LOG_INFO() << Metavision::Log::no_space << oss.str();
+
+    for (auto &run : runs) {
+        run->stop();
+    }
+    return 0;
+}
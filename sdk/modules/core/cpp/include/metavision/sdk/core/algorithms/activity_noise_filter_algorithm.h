@@ -0,0 +1,110 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_ACTIVITY_NOISE_FILTER_ALGORITHM_H
+#define METAVISION_SDK_CORE_ACTIVITY_NOISE_FILTER_ALGORITHM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/base/events/event_cd_buffer_soa.h"
+#include "metavision/sdk/base/utils/timestamp.h"
+#include "metavision/sdk/core/utils/compact_mostrecent_timestamp_buffer.h"
+
+namespace Metavision {
+
+/// @brief Class that filters the background activity noise of the sensor, i.e. the events that are not supported by
+/// a recent event in their neighbourhood
+///
+/// An event is kept if one of the 8 neighbouring pixels has had an event less than a threshold before it. The
+/// timestamp of the last event of each pixel is stored as a 32 bits offset in a @ref CompactMostRecentTimestampBuffer,
+/// padded with a border of pixels without event so that the 3 rows of the neighbourhood are compared to the threshold
+/// with one 128 bits load each, with SSE or NEON when available.
+///
+/// The sensor can be split into horizontal bands of rows processed by several threads. Each band has its own
+/// timestamp map, which includes the rows just above and below it, so that the threads do not share any state and the
+/// events kept are the same whatever the number of threads.
+class ActivityNoiseFilterAlgorithm {
+public:
+    /// @brief Builds a new ActivityNoiseFilterAlgorithm object
+    /// @param width Width of the sensor
+    /// @param height Height of the sensor
+    /// @param threshold_us Maximum duration between an event and the last one of a neighbouring pixel for the event to
+    /// be kept, in us
+    /// @param num_threads Number of threads processing the buffers of events, each one processing a band of rows of the
+    /// sensor
+    /// @throw std::invalid_argument if the size of the sensor, the threshold or the number of threads is invalid
+    ActivityNoiseFilterAlgorithm(int width, int height, timestamp threshold_us, int num_threads = 1);
+
+    /// @brief Sets the threshold of the filter
+    /// @param threshold_us Maximum duration between an event and the last one of a neighbouring pixel, in us
+    /// @throw std::invalid_argument if the threshold is negative
+    void set_threshold(timestamp threshold_us);
+
+    /// @brief Gets the threshold of the filter, in us
+    timestamp get_threshold() const;
+
+    /// @brief Forgets the events processed so far
+    void reset();
+
+    /// @brief Applies the filter to the given input range storing the result in the output range
+    /// @param first Iterator at the beginning of the range of the input elements
+    /// @param last Iterator at the end of the range of the input elements
+    /// @param d_first Beginning of the destination range
+    /// @return Iterator pointing to the last + 1 event added in the output
+    template<class InputIt, class OutputIt>
+    OutputIt process_events(InputIt first, InputIt last, OutputIt d_first) {
+        for (; first != last; ++first) {
+            if (process_event(first->x, first->y, first->t)) {
+                *d_first = *first;
+                ++d_first;
+            }
+        }
+        return d_first;
+    }
+
+    /// @brief Applies the filter to a buffer of events, the bands of rows being processed in parallel
+    /// @param input Buffer of the input events
+    /// @param output Buffer of the events that passed the filter. It can be the same buffer as @p input
+    void process_events(const std::vector<EventCD> &input, std::vector<EventCD> &output);
+
+    /// @brief Applies the filter to a buffer of events stored as a structure of arrays, the bands of rows being
+    /// processed in parallel
+    /// @param input Buffer of the input events
+    /// @param output Buffer of the events that passed the filter. It can be the same buffer as @p input
+    void process_events(const EventCDBufferSoA &input, EventCDBufferSoA &output);
+
+private:
+    // Band of rows of the sensor, with the timestamps of its rows and of the rows just above and below it
+    struct Band {
+        int first_row, last_row;
+        CompactMostRecentTimestampBuffer timestamps;
+    };
+
+    // Updates the timestamp of the pixel of an event in the bands it belongs to, and returns true if it is kept
+    bool process_event(int x, int y, timestamp t);
+
+    // Computes whether each event of a buffer is kept, in parallel for each band
+    template<typename Events>
+    void compute_kept(const Events &events, size_t n);
+
+    int width_, height_;
+    timestamp threshold_;
+    std::vector<Band> bands_;
+    std::vector<std::uint16_t> row_to_band_;
+    std::vector<std::uint8_t> kept_;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_CORE_ACTIVITY_NOISE_FILTER_ALGORITHM_H
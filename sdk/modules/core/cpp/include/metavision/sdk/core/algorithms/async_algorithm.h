@@ -15,6 +15,8 @@
 #include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <iterator>
+#include "metavision/sdk/base/utils/monotonic_arena.h"
 #include "metavision/sdk/base/utils/timestamp.h"
 
 namespace Metavision {
@@ -147,6 +149,17 @@ public:
     template<typename InputIt>
     inline void process_events(const timestamp ts, InputIt it_begin, InputIt it_end);
 
+protected:
+    /// @brief Gets the arena from which the implementation can allocate the temporaries of a time slice
+    ///
+    /// The arena is reset after each call to process_async, so that the processing of the time slices makes no calls
+    /// to the general-purpose allocator once the arena is large enough. The memory allocated from it must not be kept
+    /// beyond the end of the time slice.
+    /// @return The arena of the algorithm, which allocates no memory until it is used
+    MonotonicArena &slice_arena() {
+        return slice_arena_;
+    }
+
 private:
     // Member functions to define in the implementation. Do nothing by default
 
@@ -176,10 +189,21 @@ private:
     template<typename InputIt>
     inline bool find_last_it(const InputIt it_begin, const InputIt it_end, InputIt &to_it);
 
+    /// @brief Finds the first event whose timestamp is not lower than @p ts, searching from the beginning of the range
+    /// @param it_begin First iterator of the range, sorted by timestamp
+    /// @param it_end End iterator of the range
+    /// @param ts Timestamp to search for
+    /// @return Iterator to the first event with a timestamp higher or equal to @p ts, or @p it_end if there is none
+    template<typename InputIt>
+    static inline InputIt lower_bound_ts(InputIt it_begin, const InputIt it_end, const timestamp ts);
+
     /// @brief Function that initializes the algorithm synchronization
     /// @param ts The timestamp to use to initialize the internal states
     void initialize(timestamp ts);
 
+    /// @brief Calls process_async, then releases the temporaries of the time slice
+    inline void call_process_async();
+
     /// @brief Cast as child
     Impl &child_cast() {
         return *static_cast<Impl *>(this);
@@ -197,6 +221,8 @@ private:
     int next_processing_n_events_ =
         0;                   ///< Number of events needed before the next async processing in N_EVENTS or MIXED
     int delta_n_events_ = 0; ///< Number of events between 2 processings in N_EVENTS or MIXED
+
+    MonotonicArena slice_arena_; ///< Memory of the temporaries of the current time slice
 };
 } // namespace Metavision
 
@@ -12,14 +12,17 @@
 #ifndef METAVISION_SDK_CORE_BASE_FRAME_GENERATION_ALGORITHM_H
 #define METAVISION_SDK_CORE_BASE_FRAME_GENERATION_ALGORITHM_H
 
+#include <algorithm>
 #include <array>
 #include <vector>
 #include <stdexcept>
 #include <sstream>
 #include <opencv2/core/mat.hpp>
 
+#include "metavision/sdk/base/events/event_cd_compact.h"
 #include "metavision/sdk/base/utils/timestamp.h"
 #include "metavision/sdk/core/utils/colors.h"
+#include "metavision/sdk/core/algorithms/detail/frame_generation_kernels.h"
 
 namespace Metavision {
 
@@ -86,6 +89,18 @@ public:
                                            const uint32_t accumulation_time_us     = 0,
                                            const Metavision::ColorPalette &palette = default_palette());
 
+    /// @brief Stand-alone (static) method to generate a frame from a buffer of compact events
+    ///
+    /// Same as the method taking a range of @ref EventCD, but reading the compact events directly
+    /// @param events Buffer of the input events
+    /// @param frame Pre-allocated frame that will be filled with CD events
+    /// @param accumulation_time_us Time range of events to update the frame with (in us)
+    /// @param palette The Prophesee's color palette to use
+    /// @throw invalid_argument exception if @p frame does not have the expected type (CV_8U or CV_8UC3)
+    static inline void generate_frame_from_events(const EventCDCompactBuffer &events, cv::Mat &frame,
+                                                  const uint32_t accumulation_time_us     = 0,
+                                                  const Metavision::ColorPalette &palette = default_palette());
+
     /// @brief Sets the color used to generate the frame
     /// @param bg_color Color used as background, when no events were received for a pixel
     /// @param on_color Color used for on events
@@ -164,15 +179,48 @@ void BaseFrameGenerationAlgorithm::generate_frame_from_events(EventIt it_begin,
 
     if (colored) {
         frame.setTo(bg_color);
-        for (auto it = it_begin; it != it_end; ++it)
-            frame.at<cv::Vec3b>(it->y, it->x) = off_on_colors[it->p];
+        if (frame.isContinuous()) {
+            detail::dispatch_on_width(frame.cols, [&](auto width) {
+                detail::draw_events(it_begin, it_end, frame.ptr<cv::Vec3b>(0), width, off_on_colors);
+            });
+        } else {
+            for (auto it = it_begin; it != it_end; ++it)
+                frame.at<cv::Vec3b>(detail::event_y(*it), detail::event_x(*it)) = off_on_colors[detail::event_p(*it)];
+        }
     } else {
         frame.setTo(bg_color[0]);
-        for (auto it = it_begin; it != it_end; ++it)
-            frame.at<uint8_t>(it->y, it->x) = off_on_colors[it->p][0];
+        const std::array<uint8_t, 2> off_on_levels{off_on_colors[0][0], off_on_colors[1][0]};
+        if (frame.isContinuous()) {
+            detail::dispatch_on_width(frame.cols, [&](auto width) {
+                detail::draw_events(it_begin, it_end, frame.ptr<uint8_t>(0), width, off_on_levels);
+            });
+        } else {
+            for (auto it = it_begin; it != it_end; ++it)
+                frame.at<uint8_t>(detail::event_y(*it), detail::event_x(*it)) = off_on_levels[detail::event_p(*it)];
+        }
     }
 }
 
+inline void BaseFrameGenerationAlgorithm::generate_frame_from_events(const EventCDCompactBuffer &events,
+                                                                     cv::Mat &frame,
+                                                                     const uint32_t accumulation_time_us,
+                                                                     const Metavision::ColorPalette &palette) {
+    const cv::Vec3b bg_color = get_cv_color(palette, Metavision::ColorType::Background);
+    const std::array<cv::Vec3b, 2> off_on_colors{get_cv_color(palette, Metavision::ColorType::Negative),
+                                                 get_cv_color(palette, Metavision::ColorType::Positive)};
+    const bool colored = palette != Metavision::ColorPalette::Gray;
+
+    // The timestamps relative to the base time of the buffer are compared directly
+    auto it_begin = events.cbegin(), it_end = events.cend();
+    if (it_begin != it_end && accumulation_time_us != 0) {
+        const std::uint32_t last_dt = std::prev(it_end)->dt;
+        const std::uint32_t min_dt  = last_dt > accumulation_time_us ? last_dt - accumulation_time_us : 0;
+        it_begin = std::lower_bound(it_begin, it_end, min_dt, [](const auto &lhs, auto rhs) { return lhs.dt < rhs; });
+    }
+
+    generate_frame_from_events(it_begin, it_end, frame, bg_color, off_on_colors, colored);
+}
+
 } // namespace Metavision
 
 #endif // METAVISION_SDK_CORE_BASE_FRAME_GENERATION_ALGORITHM_H
\ No newline at end of file
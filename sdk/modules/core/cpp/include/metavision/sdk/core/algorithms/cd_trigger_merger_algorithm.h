@@ -0,0 +1,145 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_CD_TRIGGER_MERGER_ALGORITHM_H
+#define METAVISION_SDK_CORE_CD_TRIGGER_MERGER_ALGORITHM_H
+
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <vector>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/base/events/event_ext_trigger.h"
+#include "metavision/sdk/base/utils/timestamp.h"
+
+namespace Metavision {
+
+/// @brief Configuration of a @ref CDTriggerMergerAlgorithm
+struct CDTriggerMergerConfig {
+    /// Maximum time the CD events are held back waiting for trigger events, or the other way around, in us. Since the
+    /// trigger events are sparse, this is the latency of the merged stream when the time of the triggers is not
+    /// advanced otherwise (see @ref CDTriggerMergerAlgorithm::advance_time)
+    timestamp max_skew_us = 10000;
+
+    /// Polarity of the trigger edges starting the slices, see @ref CDTriggerMergerAlgorithm::set_slice_callback
+    short slice_edge_polarity = 1;
+
+    /// Channel of the trigger edges starting the slices, or -1 to use the edges of all the channels
+    int slice_edge_channel = -1;
+};
+
+/// @brief Class that merges the CD and external trigger events of a stream into a single time ordered stream
+///
+/// The decoders forward the CD and trigger events separately, each of them being time ordered. The events are buffered
+/// until both streams have advanced past their timestamp, and are then output in time order: runs of CD events
+/// interleaved with the trigger events, a trigger being output before the CD events of the same timestamp. Since the
+/// triggers are sparse, a stream is never waited for when it is more than @ref CDTriggerMergerConfig::max_skew_us
+/// behind the other one: its events older than the time already output are then dropped and counted as late.
+///
+/// The merged stream can also be output as slices of CD events aligned on trigger edges, e.g. the events between two
+/// strobes or two steps of an encoder, see @ref set_slice_callback.
+///
+/// The buffers are reused from one call to the next, so that no memory is allocated per event once they have reached
+/// the size of the skew.
+class CDTriggerMergerAlgorithm {
+public:
+    /// @brief Callback receiving a run of time ordered CD events of the merged stream
+    using CDEventsCallback = std::function<void(const EventCD *begin, const EventCD *end)>;
+
+    /// @brief Callback receiving a trigger event of the merged stream
+    using TriggerEventCallback = std::function<void(const EventExtTrigger &trigger)>;
+
+    /// @brief Callback receiving a slice of CD events, from the trigger edge starting it to the next one (excluded)
+    using SliceCallback =
+        std::function<void(const EventExtTrigger &edge, timestamp end_ts, const EventCD *begin, const EventCD *end)>;
+
+    /// @brief Builds a new CDTriggerMergerAlgorithm object
+    /// @param config Configuration of the merger
+    /// @throw std::invalid_argument if the maximum skew is negative
+    CDTriggerMergerAlgorithm(const CDTriggerMergerConfig &config = CDTriggerMergerConfig());
+
+    /// @brief Sets the function called with the runs of CD events of the merged stream
+    void set_cd_events_callback(const CDEventsCallback &cb);
+
+    /// @brief Sets the function called with the trigger events of the merged stream
+    void set_trigger_event_callback(const TriggerEventCallback &cb);
+
+    /// @brief Sets the function called with the slices of CD events aligned on the trigger edges
+    ///
+    /// A slice starts at each trigger edge of polarity @ref CDTriggerMergerConfig::slice_edge_polarity (on the channel
+    /// @ref CDTriggerMergerConfig::slice_edge_channel) and ends at the next one, whose timestamp is passed as
+    /// @p end_ts. The CD events preceding the first edge do not belong to any slice. The events of a slice are
+    /// accumulated in a buffer reused from one slice to the next.
+    void set_slice_callback(const SliceCallback &cb);
+
+    /// @brief Adds time ordered CD events, and outputs the events that are ready
+    /// @param begin Pointer on the first event
+    /// @param end Pointer after the last event
+    void process_cd_events(const EventCD *begin, const EventCD *end);
+
+    /// @brief Adds time ordered trigger events, and outputs the events that are ready
+    /// @param begin Pointer on the first event
+    /// @param end Pointer after the last event
+    void process_trigger_events(const EventExtTrigger *begin, const EventExtTrigger *end);
+
+    /// @brief Notifies that no event of either type will be added before a timestamp, and outputs the events that are
+    /// ready
+    ///
+    /// This is typically called with the last timestamp decoded by the decoder of the stream after each
+    /// buffer of raw data, so that the CD events are not held back for @ref CDTriggerMergerConfig::max_skew_us when
+    /// there is no trigger.
+    /// @param ts Timestamp reached by both streams
+    void advance_time(timestamp ts);
+
+    /// @brief Outputs all the buffered events, as if both streams had ended
+    ///
+    /// The slice started by the last trigger edge is output as well, ending right after its last event.
+    void flush();
+
+    /// @brief Resets the merger to its initial state, dropping the buffered events
+    void reset();
+
+    /// @brief Gets the number of events dropped because they arrived after more recent events had been output
+    size_t get_num_late_events() const;
+
+private:
+    void output(timestamp until);
+    void output_cd_events(const EventCD *begin, const EventCD *end);
+    void output_trigger_event(const EventExtTrigger &trigger);
+    void update();
+
+    const CDTriggerMergerConfig config_;
+    CDEventsCallback cd_events_cb_;
+    TriggerEventCallback trigger_event_cb_;
+    SliceCallback slice_cb_;
+
+    // Events buffered until both streams have advanced past them
+    std::vector<EventCD> cd_events_;
+    std::vector<EventExtTrigger> trigger_events_;
+
+    // Times before which each stream has no more event
+    timestamp cd_time_      = std::numeric_limits<timestamp>::min();
+    timestamp trigger_time_ = std::numeric_limits<timestamp>::min();
+
+    // All the events before it have been output
+    timestamp output_until_ = std::numeric_limits<timestamp>::min();
+    size_t num_late_events_ = 0;
+
+    // Slice started by the last trigger edge, if any
+    bool has_slice_ = false;
+    EventExtTrigger slice_edge_;
+    std::vector<EventCD> slice_events_;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_CORE_CD_TRIGGER_MERGER_ALGORITHM_H
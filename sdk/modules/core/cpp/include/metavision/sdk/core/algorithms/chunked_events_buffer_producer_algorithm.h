@@ -0,0 +1,92 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_CHUNKED_EVENTS_BUFFER_PRODUCER_ALGORITHM_H
+#define METAVISION_SDK_CORE_CHUNKED_EVENTS_BUFFER_PRODUCER_ALGORITHM_H
+
+#include <memory>
+#include <functional>
+
+#include "metavision/sdk/core/algorithms/async_algorithm.h"
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/base/utils/slab_pool.h"
+
+namespace Metavision {
+
+/// @brief Parameters of a @ref ChunkedEventsBufferProducerAlgorithm
+struct ChunkedEventsBufferProducerParameters {
+    uint32_t buffers_events_count_{0};
+    uint32_t buffers_time_slice_us_{5000};
+    uint32_t chunk_capacity_{4096}; ///< number of events in each chunk of the buffers
+    uint32_t chunks_per_slab_{16};  ///< number of chunks allocated at once when the pool needs more
+};
+
+/// @brief A utility class to generate shared ptr around buffers of events according to a processing policy
+/// (e.g. AsyncAlgorithm::Processing from @ref AsyncAlgorithm)
+///
+/// This is an alternative to @ref SharedEventsBufferProducerAlgorithm, whose buffers are vectors which may be
+/// reallocated when a time slice has more events than their capacity. Here, the events of a time slice are stored in
+/// a chain of fixed-capacity chunks from a @ref SlabPool (see @ref ChunkedBuffer), so that events are never moved
+/// once stored, whatever the number of events in a time slice, and the memory stays that of the peak number of chunks
+/// used. The chunks go back to the pool when the last copy of the shared pointer on the buffer is released.
+///
+/// @tparam EventT The type of events contained in the buffer.
+template<typename EventT>
+class ChunkedEventsBufferProducerAlgorithm : public AsyncAlgorithm<ChunkedEventsBufferProducerAlgorithm<EventT>> {
+public:
+    // aliases
+    using EventsBuffer       = ChunkedBuffer<EventT>;
+    using SharedEventsBuffer = std::shared_ptr<const EventsBuffer>;
+    using SharedEventsBufferProducedCb =
+        std::function<void(timestamp, const SharedEventsBuffer &)>; ///< Alias of callback to process a
+                                                                    ///< generated @ref SharedEventsBuffer
+
+    /// @brief Constructor
+    ///
+    /// The processing mode is chosen from the parameters as in @ref SharedEventsBufferProducerAlgorithm, and can be
+    /// overridden after calling the constructor.
+    ///
+    /// @param params An @ref ChunkedEventsBufferProducerParameters object containing the parameters.
+    /// @param buffer_produced_cb A callback called (@ref SharedEventsBufferProducedCb) whenever a buffer is created.
+    /// @throw std::invalid_argument If the chunk capacity or the number of chunks per slab is 0
+    ChunkedEventsBufferProducerAlgorithm(ChunkedEventsBufferProducerParameters params,
+                                         SharedEventsBufferProducedCb buffer_produced_cb);
+
+    /// @brief Resets the internal states of the policy
+    inline void clear();
+
+    /// @brief Gets the pool the chunks of the buffers are acquired from
+    const SlabPool<EventT> &get_pool() const {
+        return *pool_;
+    }
+
+private:
+    /// @brief Function to process directly the events
+    template<typename InputIt>
+    inline void process_online(InputIt it_begin, InputIt it_end);
+
+    /// @brief Function to process the state that is called every n_events or n_us
+    inline void process_async(const timestamp processing_ts, const size_t n_processed_events);
+
+    SharedEventsBufferProducedCb buffer_produced_cb_;
+    std::shared_ptr<SlabPool<EventT>> pool_;
+    std::shared_ptr<EventsBuffer> current_buffer_;
+
+    friend AsyncAlgorithm<ChunkedEventsBufferProducerAlgorithm>;
+};
+
+using ChunkedCdEventsBufferProducerAlgorithm = ChunkedEventsBufferProducerAlgorithm<EventCD>;
+
+} // namespace Metavision
+
+#include "metavision/sdk/core/algorithms/detail/chunked_events_buffer_producer_algorithm_impl.h"
+
+#endif // METAVISION_SDK_CORE_CHUNKED_EVENTS_BUFFER_PRODUCER_ALGORITHM_H
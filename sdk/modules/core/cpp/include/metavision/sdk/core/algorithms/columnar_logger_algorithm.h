@@ -0,0 +1,116 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_COLUMNAR_LOGGER_ALGORITHM_H
+#define METAVISION_SDK_CORE_COLUMNAR_LOGGER_ALGORITHM_H
+
+#include <memory>
+#include <string>
+
+#include "metavision/sdk/base/utils/timestamp.h"
+#include "metavision/sdk/core/utils/columnar_event_file.h"
+
+namespace Metavision {
+
+/// @brief Logs the stream of CD events to a columnar event file
+///
+/// Same as @ref StreamLoggerAlgorithm, but the events are written in the columnar event file format (see
+/// @ref ColumnarEventFileWriter), that can be read back by time windows and by columns.
+class ColumnarLoggerAlgorithm {
+public:
+    /// @brief Builds a new ColumnarLoggerAlgorithm object with given geometry
+    /// @param filename Name of the file to write into. If the file already exists, its previous content will be
+    /// lost.
+    /// @param width Width of the producer
+    /// @param height Height of the producer
+    /// @param block_size Number of events of a block of the file
+    inline ColumnarLoggerAlgorithm(const std::string &filename, std::size_t width, std::size_t height,
+                                   std::size_t block_size = ColumnarEventFileWriter::DefaultBlockSize);
+
+    /// @brief Enables or disables data logging
+    ///
+    /// Enabling the logger (re)creates the file, disabling it writes the footer of the file and closes it.
+    /// @param state Flag to enable/disable the logger
+    /// @param reset_ts Flag to reset the timestamp, the timestamp used in the last call to process_events will be
+    /// considered as timestamp zero
+    /// @throw std::runtime_error if the file can not be opened
+    inline void enable(bool state, bool reset_ts = true);
+
+    /// @brief Returns state of data logging
+    /// @return true if data logging in enabled false otherwise
+    inline bool is_enable() const;
+
+    /// @brief Writes the events of the input buffer in the file, if the logger is enabled
+    /// @tparam InputIterator Read-Only iterator with Event2d base class
+    /// @param first Beginning of the input iterator
+    /// @param last End of the input iterator
+    /// @param ts Input buffer timestamp
+    template<class InputIterator>
+    inline void process_events(InputIterator first, InputIterator last, timestamp ts);
+
+    /// @brief Closes the file
+    inline void close();
+
+private:
+    std::string filename_;
+    std::size_t width_{0};
+    std::size_t height_{0};
+    std::size_t block_size_{0};
+    std::unique_ptr<ColumnarEventFileWriter> writer_;
+    timestamp initial_timestamp_{0};
+    timestamp last_timestamp_{0};
+};
+
+inline ColumnarLoggerAlgorithm::ColumnarLoggerAlgorithm(const std::string &filename, std::size_t width,
+                                                        std::size_t height, std::size_t block_size) :
+    filename_(filename), width_(width), height_(height), block_size_(block_size) {}
+
+inline void ColumnarLoggerAlgorithm::enable(bool state, bool reset_ts) {
+    if (is_enable() == state) {
+        return;
+    }
+    if (state) {
+        writer_.reset(new ColumnarEventFileWriter(filename_, static_cast<int>(width_), static_cast<int>(height_),
+                                                  block_size_));
+        initial_timestamp_ = reset_ts ? last_timestamp_ : 0;
+    } else {
+        close();
+    }
+}
+
+inline bool ColumnarLoggerAlgorithm::is_enable() const {
+    return writer_ != nullptr;
+}
+
+template<class InputIterator>
+inline void ColumnarLoggerAlgorithm::process_events(InputIterator first, InputIterator last, timestamp ts) {
+    if (writer_) {
+        for (; first != last; ++first) {
+            if (first->t >= initial_timestamp_) {
+                auto ev = *first;
+                ev.t -= initial_timestamp_;
+                writer_->write(&ev, &ev + 1);
+            }
+        }
+    }
+    last_timestamp_ = ts;
+}
+
+inline void ColumnarLoggerAlgorithm::close() {
+    if (writer_) {
+        writer_->close();
+        writer_.reset();
+    }
+}
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_CORE_COLUMNAR_LOGGER_ALGORITHM_H
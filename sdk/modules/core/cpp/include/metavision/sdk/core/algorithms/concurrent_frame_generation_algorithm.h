@@ -0,0 +1,112 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_CONCURRENT_FRAME_GENERATION_ALGORITHM_H
+#define METAVISION_SDK_CORE_CONCURRENT_FRAME_GENERATION_ALGORITHM_H
+
+#include <atomic>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/core/algorithms/base_frame_generation_algorithm.h"
+
+namespace Metavision {
+
+/// @brief Algorithm that generates CD frames on demand, from any thread, while the events are being processed
+///
+/// Unlike @ref OnDemandFrameGenerationAlgorithm, the events can be processed by one thread (e.g. the decoding thread)
+/// while frames are generated by other ones (e.g. a rendering thread), without any lock: the last event of each pixel
+/// is stored in an atomic of its own, so that the generation of a frame never blocks the processing of the events,
+/// and the other way around. The timestamp of the last event processed is published once a whole buffer has been
+/// processed (see @ref get_last_processed_timestamp).
+///
+/// As only the last event of each pixel is kept, a frame shows the pixels whose last event is in the accumulation
+/// time window preceding the timestamp of the frame. A pixel that has received events more recent than the frame
+/// hence appears without events, which is why the frames are meant to be generated at the timestamp of the last
+/// events processed, as a live display would.
+///
+/// @warning @ref process_events must be called by a single thread at a time, while @ref generate can be called by
+/// several threads concurrently. The other methods (e.g. @ref reset or @ref set_color_palette) must not be called
+/// concurrently with any other one.
+class ConcurrentFrameGenerationAlgorithm : public BaseFrameGenerationAlgorithm {
+public:
+    /// @brief Constructor
+    /// @param width Sensor's width (in pixels)
+    /// @param height Sensor's height (in pixels)
+    /// @param accumulation_time_us Time range of events to update the frame with (in us)
+    /// @param palette The Prophesee's color palette to use
+    /// @throw invalid_argument if the accumulation time is 0
+    ConcurrentFrameGenerationAlgorithm(int width, int height, uint32_t accumulation_time_us,
+                                       const Metavision::ColorPalette &palette = default_palette());
+
+    /// @brief Processes events
+    /// @tparam EventIt Input event iterator type. Works for iterators over containers of @ref EventCD or equivalent
+    /// @param it_begin Iterator to first input event
+    /// @param it_end Iterator to the past-the-end event
+    /// @warning This method is expected to be called with timestamps increasing monotonically
+    template<typename EventIt>
+    void process_events(EventIt it_begin, EventIt it_end);
+
+    /// @brief Generates a frame, showing the pixels whose last event is in ]ts - accumulation time, ts]
+    ///
+    /// This method can be called by several threads concurrently, and concurrently with @ref process_events.
+    /// @param ts Timestamp at which to generate the frame
+    /// @param frame Frame that will be filled with CD events
+    /// @param allocate Allocates the frame if true. Otherwise, the user must ensure the validity of the input frame.
+    /// @throw invalid_argument exception if the frame doesn't have the expected type and geometry
+    void generate(timestamp ts, cv::Mat &frame, bool allocate = true) const;
+
+    /// @brief Returns the timestamp of the last event of the last buffer processed, or -1 if none has been processed
+    timestamp get_last_processed_timestamp() const;
+
+    /// @brief Sets the accumulation time (in us) to use to generate a frame
+    /// @param accumulation_time_us Time range of events to update the frame with (in us)
+    /// @throw invalid_argument if the accumulation time is 0
+    void set_accumulation_time_us(uint32_t accumulation_time_us);
+
+    /// @brief Returns the current accumulation time (in us).
+    uint32_t get_accumulation_time_us() const;
+
+    /// @brief Resets the internal states
+    void reset();
+
+private:
+    /// Value of the pixels without events
+    static constexpr std::int64_t NoEvent = -1;
+
+    /// @brief Packs the timestamp and polarity of an event in the value of its pixel
+    static std::int64_t pack(timestamp t, int p) {
+        return (t << 1) | (p != 0);
+    }
+
+    std::unique_ptr<std::atomic<std::int64_t>[]> pixels_; ///< Last event of each pixel, see @ref pack
+    std::atomic<timestamp> last_processed_ts_;
+    std::atomic<uint32_t> accumulation_time_us_;
+};
+
+template<typename EventIt>
+void ConcurrentFrameGenerationAlgorithm::process_events(EventIt it_begin, EventIt it_end) {
+    if (it_begin == it_end) {
+        return;
+    }
+    timestamp last_ts = it_begin->t;
+    for (; it_begin != it_end; ++it_begin) {
+        pixels_[it_begin->y * width_ + it_begin->x].store(pack(it_begin->t, it_begin->p), std::memory_order_relaxed);
+        last_ts = it_begin->t;
+    }
+    last_processed_ts_.store(last_ts, std::memory_order_release);
+}
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_CORE_CONCURRENT_FRAME_GENERATION_ALGORITHM_H
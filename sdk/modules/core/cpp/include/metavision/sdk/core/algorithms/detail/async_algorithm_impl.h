@@ -24,7 +24,7 @@ inline void AsyncAlgorithm<Impl>::set_processing_n_events(const int delta_n_even
         if (n_processed_events_ >= delta_n_events_) {
             processing_ts_ = last_event_ts_ + 1;
 
-            child_cast().process_async(processing_ts_, n_processed_events_);
+            call_process_async();
 
             next_processing_n_events_ = delta_n_events_;
             n_processed_events_       = 0;
@@ -45,7 +45,7 @@ inline void AsyncAlgorithm<Impl>::set_processing_n_us(const timestamp delta_ts)
         if (processing_ts_ + delta_ts_ <= last_event_ts_) {
             processing_ts_ = last_event_ts_ + 1;
 
-            child_cast().process_async(processing_ts_, n_processed_events_);
+            call_process_async();
         }
 
         next_processing_ts_ = processing_ts_ + delta_ts_;
@@ -64,7 +64,7 @@ inline void AsyncAlgorithm<Impl>::set_processing_mixed(const int delta_n_events,
         if ((processing_ts_ + delta_ts_ <= last_event_ts_) || (delta_n_events_ <= n_processed_events_)) {
             processing_ts_ = last_event_ts_ + 1;
 
-            child_cast().process_async(processing_ts_, n_processed_events_);
+            call_process_async();
 
             next_processing_n_events_ = delta_n_events_;
             n_processed_events_       = 0;
@@ -84,7 +84,7 @@ inline void AsyncAlgorithm<Impl>::set_processing_sync() {
     if (is_initialized_) {
         processing_ts_ = last_event_ts_ + 1;
 
-        child_cast().process_async(processing_ts_, n_processed_events_);
+        call_process_async();
         n_processed_events_ = 0;
     }
 }
@@ -96,7 +96,7 @@ inline void AsyncAlgorithm<Impl>::set_processing_external() {
     if (is_initialized_) {
         processing_ts_ = last_event_ts_ + 1;
 
-        child_cast().process_async(processing_ts_, n_processed_events_);
+        call_process_async();
         n_processed_events_ = 0;
     }
 }
@@ -111,7 +111,7 @@ inline void AsyncAlgorithm<Impl>::flush() {
     if (is_initialized_) {
         processing_ts_ = last_event_ts_ + 1;
 
-        child_cast().process_async(processing_ts_, n_processed_events_);
+        call_process_async();
 
         switch (processing_) {
         case Processing::N_EVENTS:
@@ -164,7 +164,7 @@ inline void AsyncAlgorithm<Impl>::process_events(InputIt it_begin, InputIt it_en
 
         if (process_async) {
             // Call child function to process the state asynchronously
-            impl.process_async(processing_ts_, n_processed_events_);
+            call_process_async();
             n_processed_events_ = 0;
         }
 
@@ -191,7 +191,7 @@ inline void AsyncAlgorithm<Impl>::process_events(const timestamp ts, InputIt it_
         while (next_processing_ts_ <= ts) {
             processing_ts_ = next_processing_ts_;
             next_processing_ts_ += delta_ts_;
-            child_cast().process_async(processing_ts_, n_processed_events_);
+            call_process_async();
             n_processed_events_ = 0;
         }
     }
@@ -223,8 +223,7 @@ inline bool AsyncAlgorithm<Impl>::find_last_it(const InputIt it_begin, const Inp
     case Processing::N_US: {
         if (std::prev(it_end)->t >= next_processing_ts_) {
             // Find first event with a timestamp higher than (next_processing_ts_ - 1)
-            to_it = std::lower_bound(it_begin, it_end, next_processing_ts_,
-                                     [](const auto &ev, const timestamp &ts) { return ev.t < ts; });
+            to_it = lower_bound_ts(it_begin, it_end, next_processing_ts_);
 
             processing_ts_ = next_processing_ts_;
             next_processing_ts_ += delta_ts_;
@@ -246,8 +245,7 @@ inline bool AsyncAlgorithm<Impl>::find_last_it(const InputIt it_begin, const Inp
         if (buffer_size >= next_processing_n_events_) {
             to_it = it_begin + next_processing_n_events_;
             if (std::prev(to_it)->t >= next_processing_ts_) {
-                to_it = std::lower_bound(it_begin, to_it, next_processing_ts_,
-                                         [](const auto &ev, const timestamp &ts) { return ev.t < ts; });
+                to_it = lower_bound_ts(it_begin, to_it, next_processing_ts_);
 
                 processing_ts_ = next_processing_ts_;
                 next_processing_ts_ += delta_ts_;
@@ -268,8 +266,7 @@ inline bool AsyncAlgorithm<Impl>::find_last_it(const InputIt it_begin, const Inp
         // Look for time slice
         if (std::prev(it_end)->t >= next_processing_ts_) {
             // Find first event with a timestamp higher than next_processing_ts_
-            to_it = std::lower_bound(it_begin, it_end, next_processing_ts_,
-                                     [](const auto &ev, const timestamp &ts) { return ev.t < ts; });
+            to_it = lower_bound_ts(it_begin, it_end, next_processing_ts_);
 
             processing_ts_ = next_processing_ts_;
             next_processing_ts_ += delta_ts_;
@@ -298,6 +295,38 @@ inline bool AsyncAlgorithm<Impl>::find_last_it(const InputIt it_begin, const Inp
     }
 }
 
+template<typename Impl>
+template<typename InputIt>
+inline InputIt AsyncAlgorithm<Impl>::lower_bound_ts(InputIt it_begin, const InputIt it_end, const timestamp ts) {
+    const auto is_before = [](const auto &ev, const timestamp &t) { return ev.t < t; };
+
+    // Empty time slices, e.g. when the events are sparse, are found without searching
+    if (it_begin == it_end || !is_before(*it_begin, ts)) {
+        return it_begin;
+    }
+
+    // Exponential search: the range in which to run the binary search is found by doubling steps from the beginning,
+    // so that each time slice costs a logarithm of its own number of events, not of the whole buffer's one
+    auto remaining = std::distance(it_begin, it_end);
+    decltype(remaining) step = 1;
+    while (step < remaining) {
+        const InputIt it_probe = std::next(it_begin, step);
+        if (!is_before(*it_probe, ts)) {
+            return std::lower_bound(std::next(it_begin), it_probe, ts, is_before);
+        }
+        it_begin = it_probe;
+        remaining -= step;
+        step *= 2;
+    }
+    return std::lower_bound(std::next(it_begin), it_end, ts, is_before);
+}
+
+template<typename Impl>
+inline void AsyncAlgorithm<Impl>::call_process_async() {
+    child_cast().process_async(processing_ts_, n_processed_events_);
+    slice_arena_.reset();
+}
+
 template<typename Impl>
 void AsyncAlgorithm<Impl>::initialize(timestamp ts) {
     switch (processing_) {
@@ -0,0 +1,59 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_DETAIL_CHUNKED_EVENTS_BUFFER_PRODUCER_ALGORITHM_IMPL_H
+#define METAVISION_SDK_CORE_DETAIL_CHUNKED_EVENTS_BUFFER_PRODUCER_ALGORITHM_IMPL_H
+
+namespace Metavision {
+
+template<typename EventT>
+ChunkedEventsBufferProducerAlgorithm<EventT>::ChunkedEventsBufferProducerAlgorithm(
+    ChunkedEventsBufferProducerParameters params, SharedEventsBufferProducedCb buffer_produced_cb) :
+    buffer_produced_cb_(buffer_produced_cb),
+    pool_(SlabPool<EventT>::make(params.chunk_capacity_, params.chunks_per_slab_)),
+    current_buffer_(std::make_shared<EventsBuffer>(pool_)) {
+    if (params.buffers_events_count_ == 0 && params.buffers_time_slice_us_ != 0) {
+        this->set_processing_n_us(params.buffers_time_slice_us_);
+    } else if (params.buffers_time_slice_us_ == 0 && params.buffers_events_count_ != 0) {
+        this->set_processing_n_events(params.buffers_events_count_);
+    } else if (params.buffers_events_count_ != 0 && params.buffers_time_slice_us_ != 0) {
+        this->set_processing_mixed(params.buffers_events_count_, params.buffers_time_slice_us_);
+    } else {
+        this->set_processing_external();
+    }
+}
+
+template<typename EventT>
+void ChunkedEventsBufferProducerAlgorithm<EventT>::clear() {
+    current_buffer_->clear();
+}
+
+template<typename EventT>
+template<typename InputIt>
+void ChunkedEventsBufferProducerAlgorithm<EventT>::process_online(InputIt it_begin, InputIt it_end) {
+    current_buffer_->insert_back(it_begin, it_end);
+}
+
+template<typename EventT>
+void ChunkedEventsBufferProducerAlgorithm<EventT>::process_async(const timestamp processing_ts,
+                                                                 const size_t n_processed_events) {
+    // An empty buffer holds no chunk and is kept for the next time slice
+    if (current_buffer_->empty()) {
+        return;
+    }
+
+    buffer_produced_cb_(processing_ts, current_buffer_);
+    current_buffer_ = std::make_shared<EventsBuffer>(pool_);
+}
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_CORE_DETAIL_CHUNKED_EVENTS_BUFFER_PRODUCER_ALGORITHM_IMPL_H
@@ -0,0 +1,393 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_DETAIL_EVENT_BATCH_KERNELS_H
+#define METAVISION_SDK_CORE_DETAIL_EVENT_BATCH_KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+#include "metavision/sdk/base/events/event2d.h"
+#include "metavision/sdk/base/utils/timestamp.h"
+
+namespace Metavision {
+namespace detail {
+
+/// @brief True if @p EventType is an Event2d, or a class derived from it without additional fields (e.g. EventCD)
+template<typename EventType, bool = std::is_base_of<Event2d, EventType>::value>
+struct has_event2d_layout : std::false_type {};
+
+template<typename EventType>
+struct has_event2d_layout<EventType, true> : std::integral_constant<bool, sizeof(EventType) == sizeof(Event2d)> {};
+
+/// @brief Gives the type of the events of an iterator on contiguous events with the Event2d layout (pointer or
+/// iterator of std::vector), or void for any other iterator
+template<typename It, typename ValueType = typename std::iterator_traits<It>::value_type,
+         bool = has_event2d_layout<ValueType>::value>
+struct event_array_type {
+    using type = void;
+};
+
+template<typename It, typename ValueType>
+struct event_array_type<It, ValueType, true> {
+    using type = std::conditional_t<std::is_pointer<It>::value ||
+                                        std::is_same<It, typename std::vector<ValueType>::iterator>::value ||
+                                        std::is_same<It, typename std::vector<ValueType>::const_iterator>::value,
+                                    ValueType, void>;
+};
+
+/// @brief True if the events of a range can be processed by the batch kernels into the output range
+template<typename InputIt, typename OutputIt, typename InputType = typename event_array_type<InputIt>::type,
+         typename OutputReference = decltype(*std::declval<OutputIt>())>
+struct is_batch_processable
+    : std::integral_constant<bool, !std::is_void<InputType>::value &&
+                                       std::is_same<InputType, typename event_array_type<OutputIt>::type>::value &&
+                                       !std::is_const<std::remove_reference_t<OutputReference>>::value> {};
+
+/// @brief Calls a batch kernel on the events of a range if it is contiguous and of the same type as the output one,
+/// or a fallback on the iterators otherwise
+/// @param kernel Function called with pointers to the input events, to the output ones and the number of input events,
+/// returning the number of output events
+/// @param fallback Function called with the iterators, returning the output iterator after the last event written
+/// @return Iterator pointing to the last + 1 event added in the output
+template<class InputIt, class OutputIt, class Kernel, class Fallback>
+OutputIt dispatch_batch_kernel(InputIt first, InputIt last, OutputIt d_first, Kernel kernel, Fallback,
+                               std::true_type) {
+    if (first == last) {
+        return d_first;
+    }
+    const size_t n_out = kernel(&*first, &*d_first, static_cast<size_t>(std::distance(first, last)));
+    return std::next(d_first, n_out);
+}
+
+template<class InputIt, class OutputIt, class Kernel, class Fallback>
+OutputIt dispatch_batch_kernel(InputIt first, InputIt last, OutputIt d_first, Kernel, Fallback fallback,
+                               std::false_type) {
+    return fallback(first, last, d_first);
+}
+
+template<class InputIt, class OutputIt, class Kernel, class Fallback>
+OutputIt dispatch_batch_kernel(InputIt first, InputIt last, OutputIt d_first, Kernel kernel, Fallback fallback) {
+    return dispatch_batch_kernel(first, last, d_first, kernel, fallback, is_batch_processable<InputIt, OutputIt>{});
+}
+
+/// @brief Number of events processed by an iteration of the batch kernels
+constexpr size_t EventBatchSize = 8;
+
+/// @brief Replaces one of the 16 bits fields of events, in batches of @ref EventBatchSize events
+///
+/// The events are processed as vectors of 16 bits values, in which the field is at index @p Field (0 for x, 1 for y
+/// and 2 for p). The vector operation is applied to all the values but only the field is kept.
+/// @param in Input events
+/// @param out Output events, can be the same as @p in
+/// @param n Number of events
+/// @param vector_op Operation on a vector of 16 bits values, on AVX2 or NEON
+/// @param scalar_op Operation on a single event, for the remaining events or when no SIMD instruction set is available
+template<int Field, typename EventType, typename VectorOp, typename ScalarOp>
+inline void transform_event_field(const EventType *in, EventType *out, size_t n, VectorOp vector_op,
+                                  ScalarOp scalar_op) {
+    static_assert(has_event2d_layout<EventType>::value, "The events must have the layout of Event2d");
+    static_assert(sizeof(EventType) == 16, "An event is processed as a vector of 8 16 bits values");
+    size_t i = 0;
+#if defined(__AVX2__)
+    for (; i + EventBatchSize <= n; i += EventBatchSize) {
+        for (size_t j = 0; j < EventBatchSize; j += 2) {
+            const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i + j));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i + j),
+                                _mm256_blend_epi16(v, vector_op(v), 1 << Field));
+        }
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    const uint16x8_t field_mask = vsetq_lane_u16(0xFFFF, vdupq_n_u16(0), Field);
+    for (; i + EventBatchSize <= n; i += EventBatchSize) {
+        for (size_t j = 0; j < EventBatchSize; ++j) {
+            const int16x8_t v = vld1q_s16(reinterpret_cast<const int16_t *>(in + i + j));
+            vst1q_s16(reinterpret_cast<int16_t *>(out + i + j), vbslq_s16(field_mask, vector_op(v), v));
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        out[i] = in[i];
+        scalar_op(out[i]);
+    }
+}
+
+/// @brief Mirrors the X coordinates of events: x = width_minus_one - x
+template<typename EventType>
+inline size_t flip_x_events(const EventType *in, EventType *out, size_t n, std::int16_t width_minus_one) {
+#if defined(__AVX2__)
+    const __m256i w = _mm256_set1_epi16(width_minus_one);
+    auto vector_op  = [w](__m256i v) { return _mm256_sub_epi16(w, v); };
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    const int16x8_t w = vdupq_n_s16(width_minus_one);
+    auto vector_op    = [w](int16x8_t v) { return vsubq_s16(w, v); };
+#else
+    auto vector_op = [](int v) { return v; };
+#endif
+    transform_event_field<0>(in, out, n, vector_op,
+                             [=](Event2d &ev) { ev.x = static_cast<std::uint16_t>(width_minus_one - ev.x); });
+    return n;
+}
+
+/// @brief Mirrors the Y coordinates of events: y = height_minus_one - y
+template<typename EventType>
+inline size_t flip_y_events(const EventType *in, EventType *out, size_t n, std::int16_t height_minus_one) {
+#if defined(__AVX2__)
+    const __m256i h = _mm256_set1_epi16(height_minus_one);
+    auto vector_op  = [h](__m256i v) { return _mm256_sub_epi16(h, v); };
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    const int16x8_t h = vdupq_n_s16(height_minus_one);
+    auto vector_op    = [h](int16x8_t v) { return vsubq_s16(h, v); };
+#else
+    auto vector_op = [](int v) { return v; };
+#endif
+    transform_event_field<1>(in, out, n, vector_op,
+                             [=](Event2d &ev) { ev.y = static_cast<std::uint16_t>(height_minus_one - ev.y); });
+    return n;
+}
+
+/// @brief Inverts the polarities of events: p = (p > 0) ? 0 : 1
+template<typename EventType>
+inline size_t invert_polarity_events(const EventType *in, EventType *out, size_t n) {
+    // (p > 0) gives -1 or 0 in a vector comparison, to which 1 is added
+#if defined(__AVX2__)
+    auto vector_op = [](__m256i v) {
+        return _mm256_add_epi16(_mm256_cmpgt_epi16(v, _mm256_setzero_si256()), _mm256_set1_epi16(1));
+    };
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    auto vector_op = [](int16x8_t v) {
+        return vaddq_s16(vreinterpretq_s16_u16(vcgtq_s16(v, vdupq_n_s16(0))), vdupq_n_s16(1));
+    };
+#else
+    auto vector_op = [](int v) { return v; };
+#endif
+    transform_event_field<2>(in, out, n, vector_op, [](Event2d &ev) { ev.p = (ev.p > 0) ? 0 : 1; });
+    return n;
+}
+
+/// @brief Copies the events of a given polarity
+/// @return Number of events copied
+template<typename EventType>
+inline size_t filter_polarity_events(const EventType *in, EventType *out, size_t n, std::int16_t polarity) {
+    static_assert(has_event2d_layout<EventType>::value, "The events must have the layout of Event2d");
+    // Branchless compaction, see RoiFilterAlgorithm
+    size_t i = 0, n_out = 0;
+#if defined(__AVX2__)
+    static_assert(sizeof(EventType) == 16, "The polarities of 2 events are compared in a 256 bits register");
+    const __m256i p = _mm256_set1_epi16(polarity);
+    for (; i + EventBatchSize <= n; i += EventBatchSize) {
+        // The comparison mask has 2 bits per 16 bits value, the polarity of the events being at the bytes 4 and 20
+        unsigned int accepted = 0;
+        for (size_t j = 0; j < EventBatchSize; j += 2) {
+            const __m256i v            = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i + j));
+            const unsigned int matches = static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_cmpeq_epi16(v, p)));
+            accepted |= (((matches >> 4) & 1) | ((matches >> 19) & 2)) << j;
+        }
+        for (size_t j = 0; j < EventBatchSize; ++j) {
+            out[n_out] = in[i + j];
+            n_out += (accepted >> j) & 1;
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        out[n_out] = in[i];
+        n_out += (in[i].p == polarity);
+    }
+    return n_out;
+}
+
+/// @brief Copies the events whose timestamps are in [t_begin, t_end), whatever their order
+/// @return Number of events copied
+template<typename EventType>
+inline size_t filter_time_range_events(const EventType *in, EventType *out, size_t n, timestamp t_begin,
+                                       timestamp t_end) {
+    static_assert(has_event2d_layout<EventType>::value, "The events must have the layout of Event2d");
+    // Branchless compaction, see filter_polarity_events
+    size_t i = 0, n_out = 0;
+#if defined(__AVX2__)
+    static_assert(sizeof(EventType) == 16, "The timestamps of 2 events are compared in a 256 bits register");
+    const __m256i b = _mm256_set1_epi64x(t_begin);
+    const __m256i e = _mm256_set1_epi64x(t_end);
+    for (; i + EventBatchSize <= n; i += EventBatchSize) {
+        // The comparison mask has 1 bit per 64 bits value, the timestamps of the events being the values 1 and 3
+        unsigned int accepted = 0;
+        for (size_t j = 0; j < EventBatchSize; j += 2) {
+            const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i + j));
+            // t_begin <= t && t < t_end, written !(t_begin > t) && t_end > t as there is no other comparison
+            const __m256i in_range = _mm256_andnot_si256(_mm256_cmpgt_epi64(b, v), _mm256_cmpgt_epi64(e, v));
+            const unsigned int matches =
+                static_cast<unsigned int>(_mm256_movemask_pd(_mm256_castsi256_pd(in_range)));
+            accepted |= (((matches >> 1) & 1) | ((matches >> 2) & 2)) << j;
+        }
+        for (size_t j = 0; j < EventBatchSize; ++j) {
+            out[n_out] = in[i + j];
+            n_out += (accepted >> j) & 1;
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        out[n_out] = in[i];
+        n_out += (in[i].t >= t_begin) & (in[i].t < t_end);
+    }
+    return n_out;
+}
+
+/// @brief Writes events as the packed records of a DAT file
+///
+/// The events with the layout of Event2d are packed in batches, with SIMD instructions when available, the other ones
+/// with their write_event function.
+/// @param in Input events
+/// @param n Number of events
+/// @param origin Timestamp subtracted from the ones of the events, the result being truncated to 32 bits
+/// @param out Buffer of the records, of at least n * sizeof(EventType::RawEvent) bytes
+template<typename EventType>
+inline void write_dat_events(const EventType *in, size_t n, timestamp origin, void *out) {
+    write_dat_events(in, n, origin, out, has_event2d_layout<EventType>{});
+}
+
+template<typename EventType>
+inline void write_dat_events(const EventType *in, size_t n, timestamp origin, void *out, std::false_type) {
+    auto *buf = static_cast<typename EventType::RawEvent *>(out);
+    for (size_t i = 0; i < n; ++i) {
+        in[i].write_event(buf + i, origin);
+    }
+}
+
+template<typename EventType>
+inline void write_dat_events(const EventType *in, size_t n, timestamp origin, void *out, std::true_type) {
+    // An event is processed as 2 64 bits values: a = x | y << 16 | p << 32 and t, and a record as 1 64 bits value:
+    // ts | x << 32 | y << 46 | p << 60, the bit fields being allocated from the least significant bits
+    static_assert(sizeof(Event2d::RawEvent) == 8, "A record is processed as a 64 bits value");
+    auto *buf = static_cast<Event2d::RawEvent *>(out);
+    size_t i  = 0;
+#if defined(__AVX2__)
+    const __m256i origin_v = _mm256_set1_epi64x(origin);
+    const __m256i low32    = _mm256_set1_epi64x(0xFFFFFFFF);
+    const __m256i mask14   = _mm256_set1_epi64x(0x3FFF);
+    const __m256i mask4    = _mm256_set1_epi64x(0xF);
+    // Packs the 2 events of a vector [a0, t0, a1, t1], the records being in the odd 64 bits lanes
+    auto pack = [&](__m256i v) {
+        const __m256i word = _mm256_or_si256(
+            _mm256_or_si256(_mm256_and_si256(v, mask14),
+                            _mm256_slli_epi64(_mm256_and_si256(_mm256_srli_epi64(v, 16), mask14), 14)),
+            _mm256_slli_epi64(_mm256_and_si256(_mm256_srli_epi64(v, 32), mask4), 28));
+        return _mm256_or_si256(_mm256_and_si256(_mm256_sub_epi64(v, origin_v), low32),
+                               _mm256_slli_epi64(_mm256_bslli_epi128(word, 8), 32));
+    };
+    for (; i + 4 <= n; i += 4) {
+        const __m256i r0 = pack(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i)));
+        const __m256i r1 = pack(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i + 2)));
+        // [r0[1], r1[1], r0[3], r1[3]] reordered as [r0[1], r0[3], r1[1], r1[3]]
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(buf + i),
+                            _mm256_permute4x64_epi64(_mm256_unpackhi_epi64(r0, r1), 0xD8));
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    const uint64x2_t origin_v = vdupq_n_u64(static_cast<std::uint64_t>(origin));
+    const uint64x2_t low32    = vdupq_n_u64(0xFFFFFFFF);
+    const uint64x2_t mask14   = vdupq_n_u64(0x3FFF);
+    const uint64x2_t mask4    = vdupq_n_u64(0xF);
+    for (; i + 2 <= n; i += 2) {
+        // The 2 events are deinterleaved into [a0, a1] and [t0, t1]
+        const uint64x2x2_t v = vld2q_u64(reinterpret_cast<const std::uint64_t *>(in + i));
+        const uint64x2_t x    = vandq_u64(v.val[0], mask14);
+        const uint64x2_t y    = vandq_u64(vshrq_n_u64(v.val[0], 16), mask14);
+        const uint64x2_t p    = vandq_u64(vshrq_n_u64(v.val[0], 32), mask4);
+        const uint64x2_t word = vorrq_u64(vorrq_u64(x, vshlq_n_u64(y, 14)), vshlq_n_u64(p, 28));
+        vst1q_u64(reinterpret_cast<std::uint64_t *>(buf + i),
+                  vorrq_u64(vandq_u64(vsubq_u64(v.val[1], origin_v), low32), vshlq_n_u64(word, 32)));
+    }
+#endif
+    for (; i < n; ++i) {
+        in[i].write_event(buf + i, origin);
+    }
+}
+
+/// @brief Reads events from the packed records of a DAT file
+///
+/// The events with the layout of Event2d are unpacked in batches, with SIMD instructions when available, the other
+/// ones with their read_event function.
+/// @param in Buffer of the records
+/// @param n Number of events
+/// @param delta_ts Timestamp added to the ones of the records
+/// @param out Output events
+template<typename EventType>
+inline void read_dat_events(const void *in, size_t n, timestamp delta_ts, EventType *out) {
+    read_dat_events(in, n, delta_ts, out, has_event2d_layout<EventType>{});
+}
+
+template<typename EventType>
+inline void read_dat_events(const void *in, size_t n, timestamp delta_ts, EventType *out, std::false_type) {
+    using RawEvent = typename EventType::RawEvent;
+    auto *buf      = static_cast<RawEvent *>(const_cast<void *>(in));
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = EventType::read_event(buf + i, delta_ts);
+    }
+}
+
+template<typename EventType>
+inline void read_dat_events(const void *in, size_t n, timestamp delta_ts, EventType *out, std::true_type) {
+    static_assert(sizeof(Event2d::RawEvent) == 8, "A record is processed as a 64 bits value");
+    auto *buf = static_cast<const Event2d::RawEvent *>(in);
+    size_t i  = 0;
+#if defined(__AVX2__)
+    const __m256i delta_v = _mm256_set1_epi64x(delta_ts);
+    const __m256i low32   = _mm256_set1_epi64x(0xFFFFFFFF);
+    const __m256i mask14  = _mm256_set1_epi64x(0x3FFF);
+    const __m256i mask4   = _mm256_set1_epi64x(0xF);
+    for (; i + 4 <= n; i += 4) {
+        // The records are reordered as [r0, r2, r1, r3], so that the unpacking of the 128 bits lanes gives the events
+        // in order
+        const __m256i r =
+            _mm256_permute4x64_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(buf + i)), 0xD8);
+        const __m256i word = _mm256_srli_epi64(r, 32);
+        const __m256i a    = _mm256_or_si256(
+            _mm256_or_si256(_mm256_and_si256(word, mask14),
+                            _mm256_slli_epi64(_mm256_and_si256(_mm256_srli_epi64(word, 14), mask14), 16)),
+            _mm256_slli_epi64(_mm256_and_si256(_mm256_srli_epi64(word, 28), mask4), 32));
+        const __m256i t = _mm256_add_epi64(_mm256_and_si256(r, low32), delta_v);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), _mm256_unpacklo_epi64(a, t));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i + 2), _mm256_unpackhi_epi64(a, t));
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    const uint64x2_t delta_v = vdupq_n_u64(static_cast<std::uint64_t>(delta_ts));
+    const uint64x2_t low32   = vdupq_n_u64(0xFFFFFFFF);
+    const uint64x2_t mask14  = vdupq_n_u64(0x3FFF);
+    const uint64x2_t mask4   = vdupq_n_u64(0xF);
+    for (; i + 2 <= n; i += 2) {
+        const uint64x2_t r    = vld1q_u64(reinterpret_cast<const std::uint64_t *>(buf + i));
+        const uint64x2_t word = vshrq_n_u64(r, 32);
+        const uint64x2_t x    = vandq_u64(word, mask14);
+        const uint64x2_t y    = vandq_u64(vshrq_n_u64(word, 14), mask14);
+        const uint64x2_t p    = vandq_u64(vshrq_n_u64(word, 28), mask4);
+        uint64x2x2_t v;
+        v.val[0] = vorrq_u64(vorrq_u64(x, vshlq_n_u64(y, 16)), vshlq_n_u64(p, 32));
+        v.val[1] = vaddq_u64(vandq_u64(r, low32), delta_v);
+        // The events are interleaved back from [a0, a1] and [t0, t1]
+        vst2q_u64(reinterpret_cast<std::uint64_t *>(out + i), v);
+    }
+#endif
+    for (; i < n; ++i) {
+        out[i] = EventType::read_event(const_cast<Event2d::RawEvent *>(buf + i), delta_ts);
+    }
+}
+
+} // namespace detail
+} // namespace Metavision
+
+#endif // METAVISION_SDK_CORE_DETAIL_EVENT_BATCH_KERNELS_H
@@ -12,6 +12,8 @@
 #ifndef METAVISION_SDK_CORE_DETAIL_FILE_PRODUCER_ALGORITHM_IMPL_H
 #define METAVISION_SDK_CORE_DETAIL_FILE_PRODUCER_ALGORITHM_IMPL_H
 
+#include <algorithm>
+
 #include "metavision/sdk/base/utils/sdk_log.h"
 #include "metavision/sdk/base/utils/generic_header.h"
 
@@ -22,7 +24,9 @@ template<class OutputIt>
 inline void FileProducerAlgorithmT<Event>::process_events(OutputIt d_first, timestamp ts) {
     // using Event = typename std::iterator_traits<OutputIt>::value_type;
     // decltype(*d_first) Event;
-    if (version_ >= 2) {
+    if (columnar_file_) {
+        process_columnar_events(d_first, ts);
+    } else if (version_ >= 2) {
         process_output(
             ts, d_first, Event::read_event,
             [](void *data, timestamp delta_ts) { return static_cast<typename Event::RawEvent *>(data)->ts + delta_ts; },
@@ -39,7 +43,7 @@ inline void FileProducerAlgorithmT<Event>::process_events(OutputIt d_first, time
 
 template<class Event>
 inline timestamp FileProducerAlgorithmT<Event>::get_time_at(timestamp time_window, bool backward) {
-    if (time_last_event_ < 0) {
+    if (time_last_event_ < 0 && !columnar_file_) {
         // Need to parse all the file to get the time of the last event (can't just jump
         // directly to the end because we would miss the overflows
         if (version_ >= 2) {
@@ -73,6 +77,11 @@ inline void FileProducerAlgorithmT<Event>::initialize() {
 
 template<class Event>
 inline void FileProducerAlgorithmT<Event>::start_at_time(timestamp start_time) {
+    if (columnar_file_) {
+        start_columnar_at_time(start_time);
+        return;
+    }
+
     std::function<timestamp(void *, timestamp)> get_time;
     std::function<Event(void *, timestamp)> read_event;
     std::function<void *(void *, uint64_t)> increment_data;
@@ -109,6 +118,9 @@ inline void FileProducerAlgorithmT<Event>::start_at_time(timestamp start_time) {
         position_start_event = (uint64_t)position_first_event_ + ev_size_ * n_tot_events_;
         start_event_         = n_tot_events_;
         origin_              = 0; // start_time;
+    } else if (mapped_file_) {
+        start_event_ = mapped_file_->lower_bound(start_time);
+        origin_      = start_time;
     } else {
         // Binary search
 
@@ -158,7 +170,9 @@ inline void FileProducerAlgorithmT<Event>::start_at_time(timestamp start_time) {
 
     current_event_ = start_event_;
 
-    if (events_from_ram_) {
+    if (mapped_file_) {
+        set_mapped_position(start_event_);
+    } else if (events_from_ram_) {
         if (current_event_ < n_tot_events_) {
             last_data_ = &vrawevents_[start_event_ * times_event_in_vrawevents_];
         }
@@ -179,6 +193,10 @@ inline void FileProducerAlgorithmT<Event>::process_output(timestamp ts, OutputIt
                                                           const FunctionIncrement &increment_data) {
     // Fill the buffer with current events
     while (current_event_ < n_tot_events_ && get_time(last_data_, delta_ts_overflow_) + delta_ts_loop_ - origin_ < ts) {
+        if (process_output_batch(ts, d_first, detail::has_event2d_layout<Event>{})) {
+            continue;
+        }
+
         // Read the current event
         Event ev = read_event(last_data_, delta_ts_overflow_ + delta_ts_loop_ - origin_);
 
@@ -221,7 +239,10 @@ inline void FileProducerAlgorithmT<Event>::process_output(timestamp ts, OutputIt
 
             delta_ts_loop_ = n_loop * get_max_loop_length();
 
-            if (events_from_ram_) {
+            if (mapped_file_) {
+                set_mapped_position(start_event_);
+                continue;
+            } else if (events_from_ram_) {
                 int n      = sizeof(ev_size_) / sizeof(typename decltype(vrawevents_)::value_type);
                 last_data_ = &vrawevents_[start_event_ * n]; // TODO put start_event_ * size instead
             } else {
@@ -230,7 +251,12 @@ inline void FileProducerAlgorithmT<Event>::process_output(timestamp ts, OutputIt
         }
         // no need to check if cur_ev_ < ev_num (if ev_num == 0 we do not enter the while,
         // and if cur_ev_ was == ev_num_ then in the previous if we set it to 0)
-        if (events_from_ram_) {
+        if (mapped_file_) {
+            last_data_ = increment_data(last_data_, 1);
+            if (current_event_ - released_event_ >= MAPPED_RELEASE_STEP) {
+                release_mapped_events(current_event_);
+            }
+        } else if (events_from_ram_) {
             last_data_ = increment_data(last_data_, 1);
         } else {
             file_->read(&last_buffer_[0], ev_size_);
@@ -238,6 +264,50 @@ inline void FileProducerAlgorithmT<Event>::process_output(timestamp ts, OutputIt
     }
 }
 
+template<class Event>
+template<class OutputIt>
+inline bool FileProducerAlgorithmT<Event>::process_output_batch(timestamp ts, OutputIt &d_first, std::true_type) {
+    if (version_ < 2 || !(mapped_file_ || events_from_ram_)) {
+        return false;
+    }
+
+    // The timestamps are only compared in the batch, the overflows and the end of the file being left to the event by
+    // event decoding
+    const auto *raw        = static_cast<const typename Event::RawEvent *>(last_data_);
+    const uint64_t max_n   = std::min<uint64_t>(n_tot_events_ - current_event_ - 1, uint64_t(BATCH_SIZE));
+    const timestamp end_ts = ts - delta_ts_loop_ + origin_;
+    timestamp last_ts      = time_last_event_read_;
+    size_t n               = 0;
+    for (; n < max_n; ++n) {
+        const timestamp t = raw[n].ts + delta_ts_overflow_;
+        if (t >= end_ts || last_ts - t >= MAX_TIMESTAMP_32 - threshold_) {
+            break;
+        }
+        last_ts = t;
+    }
+    if (n == 0) {
+        return false;
+    }
+
+    batch_events_.resize(n);
+    detail::read_dat_events(raw, n, delta_ts_overflow_ + delta_ts_loop_ - origin_, batch_events_.data());
+    d_first = std::copy(batch_events_.cbegin(), batch_events_.cend(), d_first);
+
+    time_last_event_read_ = last_ts;
+    current_event_ += n;
+    last_data_ = const_cast<typename Event::RawEvent *>(raw + n);
+    if (mapped_file_ && current_event_ - released_event_ >= MAPPED_RELEASE_STEP) {
+        release_mapped_events(current_event_);
+    }
+    return true;
+}
+
+template<class Event>
+template<class OutputIt>
+inline bool FileProducerAlgorithmT<Event>::process_output_batch(timestamp, OutputIt &, std::false_type) {
+    return false;
+}
+
 template<class Event>
 template<class FunctionRead, class FunctionIncrement>
 inline void FileProducerAlgorithmT<Event>::loop_through_file(const FunctionRead &read_event,
@@ -294,6 +364,127 @@ inline void FileProducerAlgorithmT<Event>::loop_through_file(const FunctionRead
     MV_SDK_LOG_INFO() << "Total length of file is" << Log::no_space << time_last_event_ << "us";
 }
 
+template<class Event>
+inline void FileProducerAlgorithmT<Event>::set_mapped_position(uint64_t event) {
+    // The pages played so far are not needed anymore
+    mapped_file_->release(0, n_tot_events_);
+    released_event_ = event;
+    if (event < n_tot_events_) {
+        // The overflows are known from the index of the mapping
+        const timestamp t     = mapped_file_->get_timestamp(event);
+        last_data_            = const_cast<uint8_t *>(mapped_file_->get_event_data(event));
+        n_times_overflows_    = t / OVERFLOW_LENGTH;
+        delta_ts_overflow_    = n_times_overflows_ * OVERFLOW_LENGTH;
+        time_last_event_read_ = t;
+        mapped_file_->will_need(event, event + MAPPED_RELEASE_STEP);
+    }
+}
+
+template<class Event>
+inline void FileProducerAlgorithmT<Event>::release_mapped_events(uint64_t end) {
+    mapped_file_->release(released_event_, end);
+    released_event_ = end;
+    mapped_file_->will_need(end, end + MAPPED_RELEASE_STEP);
+}
+
+template<class Event>
+inline void FileProducerAlgorithmT<Event>::open_columnar_file() {
+    columnar_file_.reset(new ColumnarEventFileReader(filename_));
+    const auto &header = columnar_file_->get_header();
+
+    auto value = header.get_field("Width");
+    width_     = value.empty() ? 304 : std::stoi(value);
+    value      = header.get_field("Height");
+    height_    = value.empty() ? 240 : std::stoi(value);
+    date_      = header.get_date();
+
+    n_tot_events_     = columnar_file_->get_n_events();
+    time_first_event_ = columnar_file_->get_first_timestamp();
+    time_last_event_  = columnar_file_->get_last_timestamp();
+    columnar_block_   = columnar_file_->get_blocks().size();
+    if (n_tot_events_ == 0) {
+        MV_SDK_LOG_WARNING() << "No events found in file" << filename_;
+    }
+
+    start_event_          = 0;
+    current_event_        = 0;
+    time_start_event_     = time_first_event_;
+    time_last_event_read_ = time_first_event_;
+}
+
+template<class Event>
+inline size_t FileProducerAlgorithmT<Event>::load_columnar_event(uint64_t event) {
+    const auto &blocks = columnar_file_->get_blocks();
+    if (columnar_block_ >= blocks.size() || event < blocks[columnar_block_].first_event_ ||
+        event >= blocks[columnar_block_].first_event_ + blocks[columnar_block_].n_events_) {
+        auto it         = std::upper_bound(blocks.begin(), blocks.end(), event,
+                                   [](uint64_t e, const ColumnarEventBlockInfo &block) {
+                                       return e < block.first_event_;
+                                   });
+        columnar_block_ = std::distance(blocks.begin(), it) - 1;
+        columnar_file_->read_block(columnar_block_, columnar_events_);
+    }
+    return static_cast<size_t>(event - blocks[columnar_block_].first_event_);
+}
+
+template<class Event>
+template<class OutputIt>
+inline void FileProducerAlgorithmT<Event>::process_columnar_events(OutputIt d_first, timestamp ts) {
+    // The timestamps of a columnar file are stored on 64 bits, there is no overflow to handle
+    while (current_event_ < n_tot_events_) {
+        const size_t i    = load_columnar_event(current_event_);
+        const timestamp t = columnar_events_.t()[i];
+        if (t + delta_ts_loop_ - origin_ >= ts) {
+            break;
+        }
+        *d_first = Event(Event2d(columnar_events_.x()[i], columnar_events_.y()[i], columnar_events_.p()[i],
+                                 t + delta_ts_loop_ - origin_));
+        ++d_first;
+
+        time_last_event_read_ = t;
+        ++current_event_;
+
+        // If we have to loop and we arrived at the last element, restart from the beginning
+        if (current_event_ == n_tot_events_) {
+            if (time_last_event_ + loop_delay_ - origin_ > get_max_loop_length()) {
+                set_max_loop_length(time_last_event_ + loop_delay_ - origin_);
+            }
+
+            if (!loop_) {
+                return;
+            }
+            ++n_loop;
+            current_event_        = start_event_;
+            time_last_event_read_ = time_start_event_;
+            delta_ts_loop_        = n_loop * get_max_loop_length();
+        }
+    }
+}
+
+template<class Event>
+inline void FileProducerAlgorithmT<Event>::start_columnar_at_time(timestamp start_time) {
+    if (start_time <= time_first_event_) {
+        start_event_ = 0;
+        origin_      = start_time;
+    } else if (start_time > time_last_event_) {
+        start_event_ = n_tot_events_;
+        origin_      = 0;
+    } else {
+        // Only the first block that may hold events from the start time is read
+        const size_t block = columnar_file_->find_block(start_time);
+        const auto &info   = columnar_file_->get_blocks()[block];
+        load_columnar_event(info.first_event_);
+        const timestamp *t = columnar_events_.t();
+        start_event_       = info.first_event_ + std::distance(t, std::lower_bound(t, t + info.n_events_, start_time));
+        origin_            = start_time;
+    }
+
+    current_event_        = start_event_;
+    time_start_event_     = start_event_ < n_tot_events_ ? columnar_events_.t()[load_columnar_event(start_event_)] :
+                                                           time_last_event_;
+    time_last_event_read_ = time_first_event_;
+}
+
 template<class Event>
 inline FileProducerAlgorithmT<Event>::FileProducerAlgorithmT(std::string filename, bool loop, timestamp loop_delay) :
     file_(new std::ifstream(filename.c_str(), std::ios::binary)),
@@ -304,6 +495,11 @@ inline FileProducerAlgorithmT<Event>::FileProducerAlgorithmT(std::string filenam
         throw std::runtime_error("Could not open file " + filename_);
     }
 
+    if (ColumnarEventFileReader::is_columnar_event_file(filename_)) {
+        open_columnar_file();
+        return;
+    }
+
     // Get size and type of the events
     unsigned char ev_type, ev_size;
     // Parse the header, if present
@@ -384,6 +580,11 @@ inline void FileProducerAlgorithmT<Event>::reset_max_loop_length() {
 
 template<class Event>
 inline void FileProducerAlgorithmT<Event>::load_to_ram() {
+    if (columnar_file_) {
+        // The blocks are read on demand
+        return;
+    }
+    mapped_file_.reset();
     events_from_ram_ = true;
     file_->seekg(position_start_event);
     file_->read(&last_buffer_[0], ev_size_);
@@ -397,6 +598,50 @@ inline void FileProducerAlgorithmT<Event>::load_to_ram() {
     last_data_ = (&vrawevents_[0]);
 }
 
+template<class Event>
+inline void FileProducerAlgorithmT<Event>::map_to_memory() {
+    if (columnar_file_) {
+        // The blocks are read on demand
+        return;
+    }
+    mapped_file_.reset(new MappedDATFile(filename_));
+    events_from_ram_ = false;
+    vrawevents_.clear();
+    n_tot_events_     = mapped_file_->get_n_events();
+    time_first_event_ = mapped_file_->get_first_timestamp();
+    time_last_event_  = mapped_file_->get_last_timestamp();
+    set_mapped_position(current_event_);
+}
+
+template<class Event>
+template<class OutputIt>
+inline void FileProducerAlgorithmT<Event>::read_window(timestamp begin, timestamp end, OutputIt d_first) const {
+    if (columnar_file_) {
+        EventCDBufferSoA events;
+        columnar_file_->read_window(begin, end, events);
+        for (size_t i = 0, n = events.size(); i < n; ++i) {
+            *d_first = Event(Event2d(events.x()[i], events.y()[i], events.p()[i], events.t()[i]));
+            ++d_first;
+        }
+        return;
+    }
+    if (!mapped_file_) {
+        throw std::runtime_error("Could not read a time window of file " + filename_ + ": it is not mapped to memory");
+    }
+    const auto window = mapped_file_->get_window(begin, end);
+    for (uint64_t i = window.first; i < window.second; ++i) {
+        void *data               = const_cast<uint8_t *>(mapped_file_->get_event_data(i));
+        const timestamp t        = mapped_file_->get_timestamp(i);
+        const timestamp delta_ts = t - (t & MAX_TIMESTAMP_32);
+        if (version_ >= 2) {
+            *d_first = Event::read_event(data, delta_ts);
+        } else {
+            *d_first = Event::read_event_v1(data, delta_ts);
+        }
+        ++d_first;
+    }
+}
+
 template<class Event>
 inline int FileProducerAlgorithmT<Event>::get_width() const {
     return width_;
@@ -28,6 +28,17 @@ inline void FlipXAlgorithm::operator()(Event2d &ev) const {
     ev.x = static_cast<std::uint16_t>(width_minus_one_ - ev.x);
 }
 
+inline void FlipXAlgorithm::process_events(const EventCDBufferSoA &input, EventCDBufferSoA &output) {
+    if (&output != &input) {
+        output = input;
+    }
+    // Only the X coordinates are modified
+    unsigned short *x = output.x();
+    for (size_t i = 0, n = output.size(); i < n; ++i) {
+        x[i] = static_cast<std::uint16_t>(width_minus_one_ - x[i]);
+    }
+}
+
 } // namespace Metavision
 
 #endif // METAVISION_SDK_CORE_DETAIL_FLIP_X_ALGORITHM_IMPL_H
@@ -28,6 +28,17 @@ inline void FlipYAlgorithm::set_height_minus_one(std::int16_t height_minus_one)
     height_minus_one_ = height_minus_one;
 }
 
+inline void FlipYAlgorithm::process_events(const EventCDBufferSoA &input, EventCDBufferSoA &output) {
+    if (&output != &input) {
+        output = input;
+    }
+    // Only the Y coordinates are modified
+    unsigned short *y = output.y();
+    for (size_t i = 0, n = output.size(); i < n; ++i) {
+        y[i] = static_cast<std::uint16_t>(height_minus_one_ - y[i]);
+    }
+}
+
 } // namespace Metavision
 
 #endif // METAVISION_SDK_CORE_DETAIL_FLIP_Y_ALGORITHM_IMPL_H
@@ -0,0 +1,93 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_DETAIL_FRAME_GENERATION_KERNELS_H
+#define METAVISION_SDK_CORE_DETAIL_FRAME_GENERATION_KERNELS_H
+
+#include <array>
+#include <type_traits>
+
+#include "metavision/sdk/base/events/event_cd_compact.h"
+
+namespace Metavision {
+namespace detail {
+
+/// @brief Calls a kernel with the width of the frames it processes, as a std::integral_constant when it is the one of
+/// a common sensor (320, 640 or 1280 pixels), or as an int otherwise
+///
+/// With a compile time width, the pixel indices computed by the kernel do not need any runtime multiplication and its
+/// loops can be unrolled and vectorized by the compiler. The generic kernel, called with the runtime width, is used
+/// for any other geometry.
+/// @param width Width of the frames
+/// @param kernel Generic callable taking the width as its only argument
+template<typename Kernel>
+inline void dispatch_on_width(int width, Kernel &&kernel) {
+    switch (width) {
+    case 320:
+        kernel(std::integral_constant<int, 320>());
+        break;
+    case 640:
+        kernel(std::integral_constant<int, 640>());
+        break;
+    case 1280:
+        kernel(std::integral_constant<int, 1280>());
+        break;
+    default:
+        kernel(width);
+        break;
+    }
+}
+
+/// @brief Accessors to the coordinates and polarity of the events, whether they are stored as fields or computed
+template<typename EventType>
+inline int event_x(const EventType &ev) {
+    return ev.x;
+}
+
+template<typename EventType>
+inline int event_y(const EventType &ev) {
+    return ev.y;
+}
+
+template<typename EventType>
+inline int event_p(const EventType &ev) {
+    return ev.p;
+}
+
+inline int event_x(const EventCDCompact &ev) {
+    return ev.x();
+}
+
+inline int event_y(const EventCDCompact &ev) {
+    return ev.y();
+}
+
+inline int event_p(const EventCDCompact &ev) {
+    return ev.p();
+}
+
+/// @brief Sets the pixels of events in a continuous frame to the color of their polarity
+/// @param it_begin First event to draw
+/// @param it_end Last + 1 event to draw
+/// @param pixels Pointer to the first pixel of the frame, whose rows are stored contiguously
+/// @param width Width of the frame, as an int or a std::integral_constant (see @ref dispatch_on_width)
+/// @param off_on_colors Colors of the negative and positive events
+template<typename EventIt, typename Pixel, typename Width>
+inline void draw_events(EventIt it_begin, EventIt it_end, Pixel *pixels, Width width,
+                        const std::array<Pixel, 2> &off_on_colors) {
+    for (auto it = it_begin; it != it_end; ++it)
+        pixels[event_y(*it) * width + event_x(*it)] = off_on_colors[event_p(*it)];
+}
+
+} // namespace detail
+} // namespace Metavision
+
+#endif // METAVISION_SDK_CORE_DETAIL_FRAME_GENERATION_KERNELS_H
@@ -0,0 +1,152 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_DETAIL_REFRACTORY_FILTER_ALGORITHM_IMPL_H
+#define METAVISION_SDK_CORE_DETAIL_REFRACTORY_FILTER_ALGORITHM_IMPL_H
+
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace Metavision {
+
+template<typename offset_type>
+inline TRefractoryFilterAlgorithm<offset_type>::TRefractoryFilterAlgorithm(int width, int height,
+                                                                           timestamp refractory_period_us,
+                                                                           bool separate_polarities,
+                                                                           timestamp resolution_us) :
+    width_(width), channels_(separate_polarities ? 2 : 1) {
+    if (width <= 0 || height <= 0) {
+        throw std::invalid_argument("The size of the sensor must be positive.");
+    }
+    timestamps_.create(height, width, channels_, resolution_us);
+    set_refractory_period(refractory_period_us);
+}
+
+template<typename offset_type>
+inline void TRefractoryFilterAlgorithm<offset_type>::set_refractory_period(timestamp refractory_period_us) {
+    // The pixels whose last timestamp is out of the range of the offsets must always accept the next event
+    const timestamp range = static_cast<timestamp>(std::numeric_limits<offset_type>::max()) * timestamps_.resolution();
+    if (refractory_period_us < 0 || refractory_period_us > range) {
+        throw std::invalid_argument("The refractory period must not be negative nor exceed " + std::to_string(range) +
+                                    "us.");
+    }
+    refractory_period_ = refractory_period_us;
+}
+
+template<typename offset_type>
+inline timestamp TRefractoryFilterAlgorithm<offset_type>::get_refractory_period() const {
+    return refractory_period_;
+}
+
+template<typename offset_type>
+inline bool TRefractoryFilterAlgorithm<offset_type>::is_separating_polarities() const {
+    return channels_ == 2;
+}
+
+template<typename offset_type>
+inline void TRefractoryFilterAlgorithm<offset_type>::reset() {
+    timestamps_.reset();
+}
+
+template<typename offset_type>
+inline bool TRefractoryFilterAlgorithm<offset_type>::process_event(int x, int y, short p, timestamp t) {
+    timestamps_.rebase(t);
+    const size_t index = (static_cast<size_t>(y) * width_ + x) * channels_ + (channels_ - 1) * (p > 0);
+    offset_type &last  = timestamps_.ptr()[index];
+    const bool kept    = t - timestamps_.to_timestamp(last) >= refractory_period_;
+    if (kept) {
+        last = timestamps_.to_offset(t);
+    }
+    return kept;
+}
+
+template<typename offset_type>
+template<class InputIt, class OutputIt>
+inline OutputIt TRefractoryFilterAlgorithm<offset_type>::process_events(InputIt first, InputIt last,
+                                                                        OutputIt d_first) {
+    return detail::dispatch_batch_kernel(
+        first, last, d_first,
+        [this](const auto *in, auto *out, size_t n) {
+            // Branchless compaction, see RoiFilterAlgorithm
+            size_t n_out = 0;
+            for (size_t i = 0; i < n; ++i) {
+                const auto ev = in[i];
+                out[n_out]    = ev;
+                n_out += process_event(ev.x, ev.y, ev.p, ev.t);
+            }
+            return n_out;
+        },
+        [this](InputIt first, InputIt last, OutputIt d_first) {
+            for (; first != last; ++first) {
+                if (process_event(first->x, first->y, first->p, first->t)) {
+                    *d_first = *first;
+                    ++d_first;
+                }
+            }
+            return d_first;
+        });
+}
+
+template<typename offset_type>
+inline void TRefractoryFilterAlgorithm<offset_type>::process_events(const EventCDBufferSoA &input,
+                                                                    EventCDBufferSoA &output) {
+    const size_t n = input.size();
+    output.resize(n);
+
+    const unsigned short *in_x = input.x(), *in_y = input.y();
+    const short *in_p          = input.p();
+    const timestamp *in_t      = input.t();
+    unsigned short *out_x = output.x(), *out_y = output.y();
+    short *out_p          = output.p();
+    timestamp *out_t      = output.t();
+
+    // Branchless compaction, see RoiFilterAlgorithm
+    size_t n_out = 0;
+    for (size_t i = 0; i < n; ++i) {
+        const unsigned short x = in_x[i], y = in_y[i];
+        const short p          = in_p[i];
+        const timestamp t      = in_t[i];
+        out_x[n_out]           = x;
+        out_y[n_out]           = y;
+        out_p[n_out]           = p;
+        out_t[n_out]           = t;
+        n_out += process_event(x, y, p, t);
+    }
+    output.resize(n_out);
+}
+
+template<typename offset_type>
+inline void TRefractoryFilterAlgorithm<offset_type>::process_events(const EventCDCompactBuffer &input,
+                                                                    EventCDCompactBuffer &output) {
+    const size_t n            = input.size();
+    const timestamp base_time = input.base_time();
+    if (&output != &input) {
+        output.reset(base_time);
+    }
+    output.resize(n);
+
+    // Branchless compaction, see RoiFilterAlgorithm
+    const EventCDCompact *in = input.data();
+    EventCDCompact *out      = output.data();
+    size_t n_out             = 0;
+    for (size_t i = 0; i < n; ++i) {
+        const EventCDCompact ev = in[i];
+        out[n_out]              = ev;
+        n_out += process_event(ev.x(), ev.y(), ev.p(), base_time + ev.dt);
+    }
+    output.resize(n_out);
+}
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_CORE_DETAIL_REFRACTORY_FILTER_ALGORITHM_IMPL_H
@@ -21,6 +21,8 @@ SharedEventsBufferProducerAlgorithm<EventT>::SharedEventsBufferProducerAlgorithm
     buffers_pool_(params.bounded_memory_pool_ ? EventsBufferPool::make_bounded(params.buffers_pool_size_) :
                                                 EventsBufferPool::make_unbounded(params.buffers_pool_size_)),
     params_(params) {
+    buffers_pool_.register_statistics("SharedEventsBufferProducer buffers");
+
     // Preallocate the memory of each buffer in the object pool
     {
         std::vector<SharedEventsBuffer> acquired_for_allocation;
@@ -33,7 +35,9 @@ SharedEventsBufferProducerAlgorithm<EventT>::SharedEventsBufferProducerAlgorithm
     current_shared_buffer_ = buffers_pool_.acquire();
     current_shared_buffer_->reserve(params_.buffers_preallocation_size_);
 
-    if (params.buffers_events_count_ == 0 && params.buffers_time_slice_us_ != 0) {
+    if (params.buffers_trigger_slicing_) {
+        this->set_processing_external();
+    } else if (params.buffers_events_count_ == 0 && params.buffers_time_slice_us_ != 0) {
         this->set_processing_n_us(params.buffers_time_slice_us_);
     } else if (params.buffers_time_slice_us_ == 0 && params.buffers_events_count_ != 0) {
         this->set_processing_n_events(params.buffers_events_count_);
@@ -47,28 +51,86 @@ SharedEventsBufferProducerAlgorithm<EventT>::SharedEventsBufferProducerAlgorithm
 template<typename EventT>
 void SharedEventsBufferProducerAlgorithm<EventT>::clear() {
     current_shared_buffer_->clear();
+    pending_cuts_.clear();
+}
+
+template<typename EventT>
+template<typename InputIt>
+void SharedEventsBufferProducerAlgorithm<EventT>::process_trigger_events(InputIt it_begin, InputIt it_end) {
+    if (!params_.buffers_trigger_slicing_) {
+        return;
+    }
+
+    for (; it_begin != it_end; ++it_begin) {
+        if (params_.buffers_trigger_polarity_ >= 0 && it_begin->p != params_.buffers_trigger_polarity_) {
+            continue;
+        }
+
+        const timestamp cut_ts = it_begin->t;
+        auto &events           = *current_shared_buffer_;
+        if (events.empty() || events.back().t < cut_ts) {
+            // Cut later, when the events reach the trigger
+            pending_cuts_.push_back(cut_ts);
+            continue;
+        }
+
+        // The events past the trigger have already been received: moves them to the next buffer
+        const auto cut_it = std::lower_bound(events.begin(), events.end(), cut_ts,
+                                             [](const EventT &ev, timestamp t) { return ev.t < t; });
+        auto next_buffer  = buffers_pool_.acquire();
+        next_buffer->clear();
+        next_buffer->reserve(params_.buffers_preallocation_size_);
+        next_buffer->insert(next_buffer->end(), cut_it, events.end());
+        events.erase(cut_it, events.end());
+
+        buffer_produced_cb_(cut_ts, current_shared_buffer_);
+        current_shared_buffer_ = std::move(next_buffer);
+    }
 }
 
 template<typename EventT>
 template<typename InputIt>
 void SharedEventsBufferProducerAlgorithm<EventT>::process_online(InputIt it_begin, InputIt it_end) {
+    // Cuts the input at the pending triggers, the events being sorted by timestamp
+    while (!pending_cuts_.empty()) {
+        const timestamp cut_ts = pending_cuts_.front();
+        const auto cut_it =
+            std::lower_bound(it_begin, it_end, cut_ts, [](const EventT &ev, timestamp t) { return ev.t < t; });
+        if (cut_it == it_end) {
+            // The next events may still belong to the current buffer
+            break;
+        }
+
+        current_shared_buffer_->insert(current_shared_buffer_->end(), it_begin, cut_it);
+        produce_current_buffer(cut_ts);
+        pending_cuts_.pop_front();
+        it_begin = cut_it;
+    }
+
     current_shared_buffer_->insert(current_shared_buffer_->end(), it_begin, it_end);
 }
 
 template<typename EventT>
 void SharedEventsBufferProducerAlgorithm<EventT>::process_async(const timestamp processing_ts,
                                                                 const size_t n_processed_events) {
-    if (!current_shared_buffer_->empty()) {
-        buffer_produced_cb_(processing_ts, current_shared_buffer_);
+    // An empty buffer is kept for the next time slice, instead of going through the pool
+    if (current_shared_buffer_->empty()) {
+        return;
     }
 
+    produce_current_buffer(processing_ts);
+}
+
+template<typename EventT>
+void SharedEventsBufferProducerAlgorithm<EventT>::produce_current_buffer(const timestamp processing_ts) {
+    buffer_produced_cb_(processing_ts, current_shared_buffer_);
     current_shared_buffer_ = buffers_pool_.acquire();
 
-    // In the bounded memory case, the memory is already allocated and this is equivalent to a single if if memory is
-    // already allocated.
-    // In the unbounded memory case, if needs to reallocate a new buffer, this will reserve the requested memory
-    current_shared_buffer_->reserve(params_.buffers_preallocation_size_);
+    // The buffer is cleared first, so that reserving never copies the events of its previous use.
+    // In the bounded memory case, the memory is already allocated and reserving is a mere check.
+    // In the unbounded memory case, if a new buffer was allocated, this reserves the requested memory
     current_shared_buffer_->clear();
+    current_shared_buffer_->reserve(params_.buffers_preallocation_size_);
 }
 
 } // namespace Metavision
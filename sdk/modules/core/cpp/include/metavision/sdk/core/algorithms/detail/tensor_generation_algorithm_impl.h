@@ -0,0 +1,75 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_DETAIL_TENSOR_GENERATION_ALGORITHM_IMPL_H
+#define METAVISION_SDK_CORE_DETAIL_TENSOR_GENERATION_ALGORITHM_IMPL_H
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+namespace Metavision {
+
+template<typename InputIt>
+void TensorGenerationAlgorithm::generate(InputIt it_begin, InputIt it_end, timestamp ts_begin, timestamp ts_end,
+                                         float *tensor) {
+    sort_events(it_begin, it_end, ts_begin, ts_end);
+    fill(tensor, nullptr);
+}
+
+template<typename InputIt>
+void TensorGenerationAlgorithm::generate(InputIt it_begin, InputIt it_end, timestamp ts_begin, timestamp ts_end,
+                                         std::uint16_t *tensor) {
+    sort_events(it_begin, it_end, ts_begin, ts_end);
+    float_tensor_.resize(get_tensor_size());
+    fill(float_tensor_.data(), tensor);
+}
+
+template<typename InputIt>
+void TensorGenerationAlgorithm::sort_events(InputIt it_begin, InputIt it_end, timestamp ts_begin, timestamp ts_end) {
+    if (ts_end <= ts_begin) {
+        throw std::invalid_argument("The end of the time interval must be after its beginning.");
+    }
+    auto is_valid = [&](const auto &ev) {
+        return ev.t >= ts_begin && ev.t < ts_end && ev.x < width_ && ev.y < height_;
+    };
+
+    // Counting sort of the events by stripe, which keeps their order within a stripe
+    std::fill(stripe_offsets_.begin(), stripe_offsets_.end(), 0);
+    for (auto it = it_begin; it != it_end; ++it) {
+        if (is_valid(*it)) {
+            ++stripe_offsets_[it->y / RowsPerStripe + 1];
+        }
+    }
+    std::partial_sum(stripe_offsets_.begin(), stripe_offsets_.end(), stripe_offsets_.begin());
+    const size_t num_events = stripe_offsets_.back();
+    xs_.resize(num_events);
+    ys_.resize(num_events);
+    ps_.resize(num_events);
+    ts_.resize(num_events);
+
+    const float inv_duration = static_cast<float>(1. / static_cast<double>(ts_end - ts_begin));
+    ts_step_                 = inv_duration;
+    stripe_cursors_.assign(stripe_offsets_.begin(), stripe_offsets_.end() - 1);
+    for (auto it = it_begin; it != it_end; ++it) {
+        if (is_valid(*it)) {
+            const size_t i = stripe_cursors_[it->y / RowsPerStripe]++;
+            xs_[i]         = static_cast<std::uint16_t>(it->x);
+            ys_[i]         = static_cast<std::uint16_t>(it->y);
+            ps_[i]         = it->p > 0 ? 1 : 0;
+            ts_[i]         = std::min(static_cast<float>(it->t - ts_begin) * inv_duration, 1.f);
+        }
+    }
+}
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_CORE_DETAIL_TENSOR_GENERATION_ALGORITHM_IMPL_H
@@ -12,34 +12,217 @@
 #ifndef METAVISION_SDK_CORE_TIME_SURFACE_PRODUCER_ALGORITHM_IMPL_H
 #define METAVISION_SDK_CORE_TIME_SURFACE_PRODUCER_ALGORITHM_IMPL_H
 
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <opencv2/core/utility.hpp>
+
 namespace Metavision {
 
-template<int CHANNELS>
-TimeSurfaceProducerAlgorithm<CHANNELS>::TimeSurfaceProducerAlgorithm(int width, int height) :
+namespace detail {
+
+/// @brief Converts the timestamps of the events to the values stored in a time surface
+template<typename TimeSurface>
+struct TimeSurfaceWriter {
+    /// @brief Whether the values stored do not depend on the time surface, so that they can be written to another one
+    static constexpr bool Replayable = true;
+
+    /// @brief Prepares the time surface to store timestamps up to a given one
+    static void prepare(TimeSurface &, timestamp) {}
+
+    /// @brief Gets the value stored for a timestamp
+    static timestamp value(const TimeSurface &, timestamp t) {
+        return t;
+    }
+
+    /// @brief Swaps two time surfaces, without copy
+    static void swap(TimeSurface &a, TimeSurface &b) {
+        a.swap(b);
+    }
+
+    /// @brief Copies a time surface into another one, reusing its memory
+    static void copy(const TimeSurface &from, TimeSurface &to) {
+        from.copy_to(to);
+    }
+};
+
+template<typename offset_type>
+struct TimeSurfaceWriter<TCompactMostRecentTimestampBuffer<offset_type>> {
+    // Moving the epoch rewrites all the offsets, so the values written are only valid in the same time surface
+    static constexpr bool Replayable = false;
+
+    // The events being ordered, the epoch is moved once per buffer for the last event
+    static void prepare(TCompactMostRecentTimestampBuffer<offset_type> &time_surface, timestamp last_t) {
+        time_surface.rebase(last_t);
+    }
+
+    static offset_type value(const TCompactMostRecentTimestampBuffer<offset_type> &time_surface, timestamp t) {
+        return time_surface.to_offset(t);
+    }
+
+    static void swap(TCompactMostRecentTimestampBuffer<offset_type> &a,
+                     TCompactMostRecentTimestampBuffer<offset_type> &b) {
+        std::swap(a, b);
+    }
+
+    static void copy(const TCompactMostRecentTimestampBuffer<offset_type> &from,
+                     TCompactMostRecentTimestampBuffer<offset_type> &to) {
+        to = from;
+    }
+};
+
+} // namespace detail
+
+template<int CHANNELS, typename TimeSurface>
+TimeSurfaceProducerAlgorithm<CHANNELS, TimeSurface>::TimeSurfaceProducerAlgorithm(int width, int height) :
     time_surface_(height, width, CHANNELS) {
     time_surface_.set_to(0);
 
-    output_cb_ = [](timestamp, const MostRecentTimestampBuffer &) {};
+    output_cb_ = [](timestamp, const TimeSurface &) {};
+}
+
+template<int CHANNELS, typename TimeSurface>
+TimeSurfaceProducerAlgorithm<CHANNELS, TimeSurface>::TimeSurfaceProducerAlgorithm(const TimeSurface &time_surface) :
+    time_surface_(time_surface) {
+    if (time_surface_.channels() != CHANNELS) {
+        throw std::invalid_argument("The number of channels of the time surface must be " + std::to_string(CHANNELS));
+    }
+
+    output_cb_ = [](timestamp, const TimeSurface &) {};
 }
 
-template<int CHANNELS>
-void TimeSurfaceProducerAlgorithm<CHANNELS>::set_output_callback(const OutputCb &cb) {
+template<int CHANNELS, typename TimeSurface>
+void TimeSurfaceProducerAlgorithm<CHANNELS, TimeSurface>::set_output_callback(const OutputCb &cb) {
     output_cb_ = cb;
 }
 
-template<int CHANNELS>
+template<int CHANNELS, typename TimeSurface>
+void TimeSurfaceProducerAlgorithm<CHANNELS, TimeSurface>::set_n_threads(int n_threads) {
+    n_threads_ = std::max(1, n_threads);
+}
+
+template<int CHANNELS, typename TimeSurface>
+int TimeSurfaceProducerAlgorithm<CHANNELS, TimeSurface>::get_n_threads() const {
+    return n_threads_;
+}
+
+template<int CHANNELS, typename TimeSurface>
+void TimeSurfaceProducerAlgorithm<CHANNELS, TimeSurface>::set_double_buffering(bool enable) {
+    double_buffering_ = enable;
+    pending_writes_.clear();
+    if (enable) {
+        output_time_surface_ = time_surface_;
+    } else {
+        output_time_surface_ = TimeSurface();
+    }
+}
+
+template<int CHANNELS, typename TimeSurface>
+bool TimeSurfaceProducerAlgorithm<CHANNELS, TimeSurface>::is_double_buffering() const {
+    return double_buffering_;
+}
+
+template<int CHANNELS, typename TimeSurface>
 template<typename InputIt>
-inline void TimeSurfaceProducerAlgorithm<CHANNELS>::process_online(InputIt it_begin, InputIt it_end) {
+inline void TimeSurfaceProducerAlgorithm<CHANNELS, TimeSurface>::process_online(InputIt it_begin, InputIt it_end) {
+    using Writer = detail::TimeSurfaceWriter<TimeSurface>;
+    if (it_begin == it_end) {
+        return;
+    }
+    Writer::prepare(time_surface_, std::prev(it_end)->t);
+
+    // The values written are recorded to be written again into the other time surface when they are swapped, unless
+    // there are already more of them than cells, the time surface being copied then
+    const size_t n_cells     = static_cast<size_t>(time_surface_.rows()) * time_surface_.cols() * CHANNELS;
+    const bool record_writes = Writer::Replayable && double_buffering_ && pending_writes_.size() < n_cells;
+
+    // Sharding has a cost of its own, that is only worth it for large buffers
+    constexpr std::ptrdiff_t MinEventsPerThread = 4096;
+    const int n_bands = std::min(n_threads_, time_surface_.rows());
+    if (n_bands <= 1 || std::distance(it_begin, it_end) < MinEventsPerThread * n_bands) {
+        if (record_writes) {
+            CellType *cells       = time_surface_.ptr();
+            const size_t row_size = static_cast<size_t>(time_surface_.cols()) * CHANNELS;
+            for (auto it = it_begin; it != it_end; ++it) {
+                assert(it->p == 0 || it->p == 1);
+                const size_t c    = (CHANNELS == 1) ? 0 : it->p;
+                const size_t cell = it->y * row_size + it->x * CHANNELS + c;
+                const auto value  = Writer::value(time_surface_, it->t);
+                cells[cell]       = value;
+                pending_writes_.push_back({cell, value});
+            }
+            return;
+        }
+        for (auto it = it_begin; it != it_end; ++it) {
+            assert(it->p == 0 || it->p == 1);
+            const auto c                        = (CHANNELS == 1) ? 0 : it->p;
+            *time_surface_.ptr(it->y, it->x, c) = Writer::value(time_surface_, it->t);
+        }
+        return;
+    }
+
+    // Counting sort of the events by band, which keeps the order of the events of a band
+    const int band_height = (time_surface_.rows() + n_bands - 1) / n_bands;
+    band_offsets_.assign(n_bands + 1, 0);
+    for (auto it = it_begin; it != it_end; ++it) {
+        ++band_offsets_[it->y / band_height + 1];
+    }
+    for (int band = 0; band < n_bands; ++band) {
+        band_offsets_[band + 1] += band_offsets_[band];
+    }
+    sharded_events_.resize(band_offsets_[n_bands]);
+    std::vector<size_t> next(band_offsets_.begin(), band_offsets_.end() - 1);
+    const size_t row_size = static_cast<size_t>(time_surface_.cols()) * CHANNELS;
     for (auto it = it_begin; it != it_end; ++it) {
         assert(it->p == 0 || it->p == 1);
-        const auto c                      = (CHANNELS == 1) ? 0 : it->p;
-        time_surface_.at(it->y, it->x, c) = it->t;
+        const size_t c = (CHANNELS == 1) ? 0 : it->p;
+        sharded_events_[next[it->y / band_height]++] = {it->y * row_size + it->x * CHANNELS + c,
+                                                        Writer::value(time_surface_, it->t)};
+    }
+
+    CellType *cells = time_surface_.ptr();
+    cv::parallel_for_(cv::Range(0, n_bands), [&](const cv::Range &range) {
+        for (int band = range.start; band < range.end; ++band) {
+            for (size_t i = band_offsets_[band]; i < band_offsets_[band + 1]; ++i) {
+                cells[sharded_events_[i].cell] = sharded_events_[i].value;
+            }
+        }
+    });
+
+    // The events of a cell all belong to the same band, so their order is kept
+    if (record_writes) {
+        pending_writes_.insert(pending_writes_.end(), sharded_events_.begin(), sharded_events_.end());
+    }
+}
+
+template<int CHANNELS, typename TimeSurface>
+void TimeSurfaceProducerAlgorithm<CHANNELS, TimeSurface>::swap_time_surfaces() {
+    using Writer = detail::TimeSurfaceWriter<TimeSurface>;
+    Writer::swap(time_surface_, output_time_surface_);
+
+    // The time surface to update from now on lacks the events processed since the previous swap
+    const size_t n_cells = static_cast<size_t>(time_surface_.rows()) * time_surface_.cols() * CHANNELS;
+    if (Writer::Replayable && pending_writes_.size() < n_cells) {
+        CellType *cells = time_surface_.ptr();
+        for (const auto &w : pending_writes_) {
+            cells[w.cell] = w.value;
+        }
+    } else {
+        Writer::copy(output_time_surface_, time_surface_);
     }
+    pending_writes_.clear();
 }
 
-template<int CHANNELS>
-void TimeSurfaceProducerAlgorithm<CHANNELS>::process_async(const timestamp processing_ts,
-                                                           const size_t n_processed_events) {
+template<int CHANNELS, typename TimeSurface>
+void TimeSurfaceProducerAlgorithm<CHANNELS, TimeSurface>::process_async(const timestamp processing_ts,
+                                                                        const size_t n_processed_events) {
+    if (double_buffering_) {
+        swap_time_surfaces();
+        output_cb_(processing_ts, output_time_surface_);
+        return;
+    }
     output_cb_(processing_ts, time_surface_);
 }
 
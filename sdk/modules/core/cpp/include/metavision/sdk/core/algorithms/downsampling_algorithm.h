@@ -0,0 +1,124 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_DOWNSAMPLING_ALGORITHM_H
+#define METAVISION_SDK_CORE_DOWNSAMPLING_ALGORITHM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "metavision/sdk/base/events/event_cd_buffer_soa.h"
+#include "metavision/sdk/base/events/event_cd_compact.h"
+#include "metavision/sdk/base/utils/timestamp.h"
+
+namespace Metavision {
+
+/// @brief Class that maps the events to a grid of lower resolution, each cell (or bin) of the grid gathering the
+/// events of a square of factor x factor pixels
+///
+/// The coordinates of the events are divided by the factor, a power of 2, and the events outside the sensor are
+/// dropped. Optionally, the events of a bin and polarity following the last event kept for them by less than a
+/// refractory period are dropped too, which collapses the bursts of events of the pixels of a bin into one event.
+///
+/// The buffers stored as a structure of arrays are processed with a first pass computing the coordinates of the
+/// events and whether they are in the sensor, which the compiler vectorizes, the events being compacted in a second
+/// pass only if some of them are dropped.
+class DownsamplingAlgorithm {
+public:
+    /// @brief Builds a new DownsamplingAlgorithm object
+    /// @param width Width of the sensor
+    /// @param height Height of the sensor
+    /// @param factor Size of the side of a bin, in pixels: 2, 4, 8... (1 to only apply the refractory period)
+    /// @param refractory_period_us Minimum duration between two events of a bin with the same polarity, in us. If 0,
+    /// all the events in the sensor are kept
+    /// @throw std::invalid_argument if the size of the sensor is not positive, the factor not a power of 2 or the
+    /// refractory period negative
+    DownsamplingAlgorithm(int width, int height, int factor, timestamp refractory_period_us = 0);
+
+    /// @brief Gets the size of the side of a bin, in pixels
+    int get_factor() const;
+
+    /// @brief Gets the width of the grid of bins, i.e. of the output events
+    int get_output_width() const;
+
+    /// @brief Gets the height of the grid of bins, i.e. of the output events
+    int get_output_height() const;
+
+    /// @brief Sets the refractory period of the bins
+    /// @param refractory_period_us Minimum duration between two events of a bin with the same polarity, in us, 0 to
+    /// disable it
+    /// @throw std::invalid_argument if the refractory period is negative
+    void set_refractory_period(timestamp refractory_period_us);
+
+    /// @brief Gets the refractory period of the bins, in us
+    timestamp get_refractory_period() const;
+
+    /// @brief Forgets the events processed so far
+    void reset();
+
+    /// @brief Applies the downsampling to the given input range storing the result in the output range
+    /// @param first Iterator at the beginning of the range of the input elements
+    /// @param last Iterator at the end of the range of the input elements
+    /// @param d_first Beginning of the destination range
+    /// @return Iterator pointing to the last + 1 event added in the output
+    template<class InputIt, class OutputIt>
+    OutputIt process_events(InputIt first, InputIt last, OutputIt d_first) {
+        for (; first != last; ++first) {
+            if (first->x >= width_ || first->y >= height_) {
+                continue;
+            }
+            auto ev = *first;
+            ev.x    = static_cast<decltype(ev.x)>(ev.x >> shift_);
+            ev.y    = static_cast<decltype(ev.y)>(ev.y >> shift_);
+            if (refractory_period_ > 0 && !accept(ev.x, ev.y, ev.p, ev.t)) {
+                continue;
+            }
+            *d_first = ev;
+            ++d_first;
+        }
+        return d_first;
+    }
+
+    /// @brief Applies the downsampling to a buffer of events stored as a structure of arrays
+    /// @param input Buffer of the input events
+    /// @param output Buffer of the downsampled events. It can be the same buffer as @p input
+    void process_events(const EventCDBufferSoA &input, EventCDBufferSoA &output);
+
+    /// @brief Applies the downsampling to a buffer of compact events
+    /// @param input Buffer of the input events
+    /// @param output Buffer of the downsampled events, with the base time of @p input. It can be the same buffer as
+    /// @p input
+    void process_events(const EventCDCompactBuffer &input, EventCDCompactBuffer &output);
+
+private:
+    // Returns true if an event of a bin is kept, updating the time before which the next events of the bin are dropped
+    bool accept(int x, int y, int p, timestamp t) {
+        const size_t bin = (static_cast<size_t>(y) * output_width_ + x) * 2 + (p > 0 ? 1 : 0);
+        if (t < next_ts_[bin]) {
+            return false;
+        }
+        next_ts_[bin] = t + refractory_period_;
+        return true;
+    }
+
+    int width_, height_;
+    int factor_;
+    unsigned int shift_;
+    int output_width_, output_height_;
+    timestamp refractory_period_;
+    std::vector<timestamp> next_ts_; ///< Time before which the events of each bin and polarity are dropped
+    std::vector<std::uint8_t> kept_; ///< Whether each event of a buffer is in the sensor
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_CORE_DOWNSAMPLING_ALGORITHM_H
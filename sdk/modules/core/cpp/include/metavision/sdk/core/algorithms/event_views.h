@@ -0,0 +1,224 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_EVENT_VIEWS_H
+#define METAVISION_SDK_CORE_EVENT_VIEWS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include "metavision/sdk/core/algorithms/fused_algorithm.h"
+
+namespace Metavision {
+
+/// @brief Lazy view of a range of events, through a chain of stateless algorithms
+///
+/// No event is processed when the view is built: each event goes through all the algorithms, in a single inlined loop
+/// (see @ref FusedAlgorithm), only when the view is iterated or copied to an output. Views are built with the pipe
+/// operator, from a container of events or another view, and the adaptors of the @ref views namespace:
+///
+/// @code{.cpp}
+/// std::vector<EventCD> output;
+/// (events | views::roi(0, 0, 319, 239) | views::polarity(1) | views::flip_x(319)).copy_to(std::back_inserter(output));
+/// for (const auto &ev : events | views::polarity(0)) {
+///     ...
+/// }
+/// @endcode
+/// @warning The view only holds iterators on the input events, which must outlive it
+/// @tparam InputIt Type of the iterators on the input events. Works for iterators over containers of @ref EventCD or
+/// equivalent
+/// @tparam Algorithms The algorithms applied, an @ref EventOperation must be defined for each of them
+template<typename InputIt, typename... Algorithms>
+class EventView {
+public:
+    /// @brief Type of the events of the view
+    using value_type = typename std::iterator_traits<InputIt>::value_type;
+
+    /// @brief Input iterator on the events of the view, that applies the algorithms when it is incremented
+    class iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type        = EventView::value_type;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = const value_type *;
+        using reference         = const value_type &;
+
+        iterator() = default;
+
+        reference operator*() const {
+            return ev_;
+        }
+
+        pointer operator->() const {
+            return &ev_;
+        }
+
+        iterator &operator++() {
+            ++it_;
+            skip_filtered_events();
+            return *this;
+        }
+
+        iterator operator++(int) {
+            iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        bool operator==(const iterator &other) const {
+            return it_ == other.it_;
+        }
+
+        bool operator!=(const iterator &other) const {
+            return it_ != other.it_;
+        }
+
+    private:
+        friend class EventView;
+
+        iterator(const EventView *view, InputIt it) : view_(view), it_(it) {
+            skip_filtered_events();
+        }
+
+        void skip_filtered_events() {
+            for (; it_ != view_->last_; ++it_) {
+                ev_ = *it_;
+                if (view_->fused_.process_event(ev_)) {
+                    break;
+                }
+            }
+        }
+
+        const EventView *view_ = nullptr;
+        InputIt it_{};
+        value_type ev_{};
+    };
+
+    /// @brief Builds a view of a range of events through the given algorithms
+    /// @param first Beginning of the range of the input events
+    /// @param last End of the range of the input events
+    /// @param algos The algorithms, in the order in which they are applied
+    EventView(InputIt first, InputIt last, Algorithms... algos) :
+        first_(first), last_(last), fused_(std::move(algos)...) {}
+
+    /// @brief Returns an iterator on the first event of the view
+    iterator begin() const {
+        return iterator(this, first_);
+    }
+
+    /// @brief Returns an iterator past the last event of the view
+    iterator end() const {
+        return iterator(this, last_);
+    }
+
+    /// @brief Processes the events of the view and writes them in an output
+    /// @param d_first Beginning of the destination range
+    /// @return Iterator pointing to the last + 1 event added in the output
+    template<class OutputIt>
+    OutputIt copy_to(OutputIt d_first) {
+        return fused_.process_events(first_, last_, d_first);
+    }
+
+    /// @brief Returns a view of the same events, through an additional algorithm applied after the ones of this view
+    /// @param algo The algorithm to apply
+    template<typename Algorithm>
+    EventView<InputIt, Algorithms..., Algorithm> then(Algorithm algo) const {
+        return then(std::move(algo), std::index_sequence_for<Algorithms...>());
+    }
+
+private:
+    template<typename Algorithm, size_t... Is>
+    EventView<InputIt, Algorithms..., Algorithm> then(Algorithm algo, std::index_sequence<Is...>) const {
+        return EventView<InputIt, Algorithms..., Algorithm>(first_, last_, fused_.template get<Is>()...,
+                                                            std::move(algo));
+    }
+
+    InputIt first_, last_;
+    FusedAlgorithm<Algorithms...> fused_;
+};
+
+/// @brief Creates a view of a range of events, to which algorithms can be appended with the pipe operator
+/// @param first Beginning of the range of the input events
+/// @param last End of the range of the input events
+template<typename InputIt>
+EventView<InputIt> make_event_view(InputIt first, InputIt last) {
+    return EventView<InputIt>(first, last);
+}
+
+namespace views {
+
+/// @brief Algorithm to append to an @ref EventView with the pipe operator
+template<typename Algorithm>
+struct Adaptor {
+    Algorithm algo;
+};
+
+/// @brief Appends any algorithm for which an @ref EventOperation is defined
+template<typename Algorithm>
+Adaptor<std::decay_t<Algorithm>> apply(Algorithm &&algo) {
+    return Adaptor<std::decay_t<Algorithm>>{std::forward<Algorithm>(algo)};
+}
+
+/// @brief Keeps the events in a window, see @ref RoiFilterAlgorithm
+inline Adaptor<RoiFilterAlgorithm> roi(std::int32_t x0, std::int32_t y0, std::int32_t x1, std::int32_t y1,
+                                       bool output_relative_coordinates = false) {
+    return Adaptor<RoiFilterAlgorithm>{RoiFilterAlgorithm(x0, y0, x1, y1, output_relative_coordinates)};
+}
+
+/// @brief Keeps the events of a polarity, see @ref PolarityFilterAlgorithm
+inline Adaptor<PolarityFilterAlgorithm> polarity(std::int16_t polarity) {
+    return Adaptor<PolarityFilterAlgorithm>{PolarityFilterAlgorithm(polarity)};
+}
+
+/// @brief Inverts the polarities of the events, see @ref PolarityInverterAlgorithm
+inline Adaptor<PolarityInverterAlgorithm> invert_polarity() {
+    return Adaptor<PolarityInverterAlgorithm>{PolarityInverterAlgorithm()};
+}
+
+/// @brief Mirrors the X coordinates of the events, see @ref FlipXAlgorithm
+inline Adaptor<FlipXAlgorithm> flip_x(std::int16_t width_minus_one) {
+    return Adaptor<FlipXAlgorithm>{FlipXAlgorithm(width_minus_one)};
+}
+
+/// @brief Mirrors the Y coordinates of the events, see @ref FlipYAlgorithm
+inline Adaptor<FlipYAlgorithm> flip_y(std::int16_t height_minus_one) {
+    return Adaptor<FlipYAlgorithm>{FlipYAlgorithm(height_minus_one)};
+}
+
+/// @brief Keeps the events whose timestamps are in [t_begin, t_end), see @ref TimeRangeFilterAlgorithm
+/// @note Each event is compared to the range, use @ref TimeRangeFilterAlgorithm::find_range to get the events in range
+/// of a sorted buffer without iterating over all of them
+inline Adaptor<TimeRangeFilterAlgorithm> time_range(timestamp t_begin, timestamp t_end) {
+    return Adaptor<TimeRangeFilterAlgorithm>{TimeRangeFilterAlgorithm(t_begin, t_end, false)};
+}
+
+} // namespace views
+
+/// @brief Appends an algorithm to a view
+template<typename InputIt, typename... Algorithms, typename Algorithm>
+EventView<InputIt, Algorithms..., Algorithm> operator|(const EventView<InputIt, Algorithms...> &view,
+                                                      views::Adaptor<Algorithm> adaptor) {
+    return view.then(std::move(adaptor.algo));
+}
+
+/// @brief Creates a view of the events of a container through an algorithm
+/// @warning The container must outlive the view
+template<typename Range, typename Algorithm, typename InputIt = decltype(std::cbegin(std::declval<const Range &>()))>
+EventView<InputIt, Algorithm> operator|(const Range &events, views::Adaptor<Algorithm> adaptor) {
+    return EventView<InputIt, Algorithm>(std::cbegin(events), std::cend(events), std::move(adaptor.algo));
+}
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_CORE_EVENT_VIEWS_H
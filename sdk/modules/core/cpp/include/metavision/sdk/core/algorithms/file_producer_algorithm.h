@@ -23,6 +23,9 @@
 #include "metavision/sdk/base/utils/sdk_log.h"
 #include "metavision/sdk/base/utils/timestamp.h"
 #include "metavision/sdk/base/events/event2d.h"
+#include "metavision/sdk/core/algorithms/detail/event_batch_kernels.h"
+#include "metavision/sdk/core/utils/columnar_event_file.h"
+#include "metavision/sdk/core/utils/mapped_dat_file.h"
 
 namespace Metavision {
 
@@ -30,6 +33,9 @@ template<class Event>
 class FileProducerAlgorithmT {
 public:
     /// @brief Builds a new FileProducerAlgorithmT object
+    ///
+    /// The file is either a DAT file or a columnar event file (see @ref ColumnarEventFileReader). The blocks of a
+    /// columnar event file are read on demand, and the time ranges of its blocks are used to seek in it.
     /// @param filename Name of the file to read data from
     /// @param loop If true, the reading from the file will be looped
     /// @param loop_delay Time interval (in us) between two consecutive loops
@@ -82,8 +88,29 @@ public:
     static void reset_max_loop_length();
 
     /// @brief Loads file events to ram
+    /// @note This has no effect on a columnar event file
     void load_to_ram();
 
+    /// @brief Maps the file to memory, instead of reading it or loading it to ram
+    ///
+    /// The events are read in place from the mapping, whose pages are read on demand and released once played, so
+    /// that huge files can be replayed, looped or not, with a bounded memory. The timestamps of the file are indexed
+    /// when mapping it, so that @ref start_at_time, @ref get_time_at and @ref read_window don't need to read the whole
+    /// file.
+    /// @throw std::runtime_error if the file can not be mapped
+    /// @note This has no effect on a columnar event file
+    void map_to_memory();
+
+    /// @brief Reads the events of a time window of the file, with their timestamps as recorded
+    ///
+    /// This does not change the current position of the producer in the file.
+    /// @param begin Beginning of the time window, included
+    /// @param end End of the time window, excluded
+    /// @param d_first Output iterator on which the events are written
+    /// @throw std::runtime_error if the file is a DAT file that has not been mapped to memory (see @ref map_to_memory)
+    template<class OutputIt>
+    inline void read_window(timestamp begin, timestamp end, OutputIt d_first) const;
+
     /// @brief Gets the width of the sensor producer that recorded the data
     /// @return Width of the sensor
     int get_width() const;
@@ -114,9 +141,25 @@ private:
     inline void process_output(timestamp ts, OutputIt d_first, const FunctionRead &read_event,
                                const FunctionTime &get_time, const FunctionIncrement &increment_data);
 
+    // Decodes in a batch the next events in memory before a timestamp, up to a timestamp overflow or the last event of
+    // the file, returning false if no event has been decoded
+    template<class OutputIt>
+    inline bool process_output_batch(timestamp ts, OutputIt &d_first, std::true_type);
+    template<class OutputIt>
+    inline bool process_output_batch(timestamp ts, OutputIt &d_first, std::false_type);
+
     template<class FunctionRead, class FunctionIncrement>
     inline void loop_through_file(const FunctionRead &read_event, const FunctionIncrement &increment_data);
 
+    inline void set_mapped_position(uint64_t event);
+    inline void release_mapped_events(uint64_t end);
+
+    inline void open_columnar_file();
+    template<class OutputIt>
+    inline void process_columnar_events(OutputIt d_first, timestamp ts);
+    inline void start_columnar_at_time(timestamp start_time);
+    inline size_t load_columnar_event(uint64_t event);
+
     // File info
     std::unique_ptr<std::ifstream> file_;
     std::string filename_;
@@ -161,6 +204,20 @@ private:
     std::vector<uint8_t> vrawevents_;
     int times_event_in_vrawevents_ = 0; // number of elements of the vector vrawevents_ a single event occupies
 
+    // DECODING IN BATCHES
+    static constexpr size_t BATCH_SIZE = 4096; // maximum number of events decoded in a batch
+    std::vector<Event> batch_events_;
+
+    // READING FROM MEMORY MAPPING
+    static constexpr uint64_t MAPPED_RELEASE_STEP = 1 << 20; // number of events played between two page releases
+    std::unique_ptr<MappedDATFile> mapped_file_;
+    uint64_t released_event_ = 0; // the pages of the events before this one have been released
+
+    // READING FROM A COLUMNAR FILE
+    std::unique_ptr<ColumnarEventFileReader> columnar_file_;
+    EventCDBufferSoA columnar_events_; // events of the block currently read
+    size_t columnar_block_ = 0;        // index of the block in columnar_events_, invalid if out of range
+
     int width_ = 0, height_ = 0;
 
     std::string date_;
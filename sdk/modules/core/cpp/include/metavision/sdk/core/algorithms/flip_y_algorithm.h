@@ -17,7 +17,9 @@
 
 #include "metavision/sdk/base/utils/sdk_log.h"
 #include "metavision/sdk/core/algorithms/detail/internal_algorithms.h"
+#include "metavision/sdk/core/algorithms/detail/event_batch_kernels.h"
 #include "metavision/sdk/base/events/event2d.h"
+#include "metavision/sdk/base/events/event_cd_buffer_soa.h"
 
 namespace Metavision {
 
@@ -38,11 +40,24 @@ public:
     /// @param first Beginning of the range of the input elements
     /// @param last End of the range of the input elements
     /// @param d_first Beginning of the destination range
+    /// @note Contiguous events (arrays or vectors) are processed in batches, with SIMD instructions when available
     template<class InputIt, class OutputIt>
     inline void process_events(InputIt first, InputIt last, OutputIt d_first) {
-        detail::transform(first, last, d_first, std::ref(*this));
+        detail::dispatch_batch_kernel(
+            first, last, d_first,
+            [this](const auto *in, auto *out, size_t n) {
+                return detail::flip_y_events(in, out, n, height_minus_one_);
+            },
+            [this](InputIt first, InputIt last, OutputIt d_first) {
+                return detail::transform(first, last, d_first, std::ref(*this));
+            });
     }
 
+    /// @brief Applies the Flip Y filter to a buffer of events stored as a structure of arrays
+    /// @param input Buffer of the input events
+    /// @param output Buffer of the flipped events. It can be the same buffer as @p input
+    inline void process_events(const EventCDBufferSoA &input, EventCDBufferSoA &output);
+
     /// @note process(...) is deprecated since version 2.2.0 and will be removed in later releases.
     ///       Please use process_events(...) instead
     template<class InputIt, class OutputIt>
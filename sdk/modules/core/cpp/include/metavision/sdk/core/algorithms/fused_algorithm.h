@@ -0,0 +1,204 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_FUSED_ALGORITHM_H
+#define METAVISION_SDK_CORE_FUSED_ALGORITHM_H
+
+#include <initializer_list>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "metavision/sdk/base/events/event_cd_buffer_soa.h"
+#include "metavision/sdk/core/algorithms/flip_x_algorithm.h"
+#include "metavision/sdk/core/algorithms/flip_y_algorithm.h"
+#include "metavision/sdk/core/algorithms/polarity_filter_algorithm.h"
+#include "metavision/sdk/core/algorithms/polarity_inverter_algorithm.h"
+#include "metavision/sdk/core/algorithms/roi_filter_algorithm.h"
+#include "metavision/sdk/core/algorithms/time_range_filter_algorithm.h"
+
+namespace Metavision {
+
+/// @brief Describes how a stateless algorithm processes a single event, so that it can be fused with other ones in a
+/// @ref FusedAlgorithm
+///
+/// A specialization must define a static function template `bool apply(const Algorithm &algo, Event &ev)` updating
+/// the event and returning false if the event is filtered out. Specializations are provided for the filters and the
+/// flips of this module.
+/// @tparam Algorithm The type of the algorithm
+template<typename Algorithm>
+struct EventOperation;
+
+/// @brief Single event operation of @ref RoiFilterAlgorithm
+template<>
+struct EventOperation<RoiFilterAlgorithm> {
+    template<typename Event>
+    static bool apply(const RoiFilterAlgorithm &algo, Event &ev) {
+        if (!algo(static_cast<const Event &>(ev))) {
+            return false;
+        }
+        if (algo.is_resetting()) {
+            algo(ev);
+        }
+        return true;
+    }
+};
+
+/// @brief Single event operation of @ref PolarityFilterAlgorithm
+template<>
+struct EventOperation<PolarityFilterAlgorithm> {
+    template<typename Event>
+    static bool apply(const PolarityFilterAlgorithm &algo, Event &ev) {
+        return algo(ev);
+    }
+};
+
+/// @brief Single event operation of @ref PolarityInverterAlgorithm
+template<>
+struct EventOperation<PolarityInverterAlgorithm> {
+    template<typename Event>
+    static bool apply(const PolarityInverterAlgorithm &algo, Event &ev) {
+        algo(ev);
+        return true;
+    }
+};
+
+/// @brief Single event operation of @ref FlipXAlgorithm
+template<>
+struct EventOperation<FlipXAlgorithm> {
+    template<typename Event>
+    static bool apply(const FlipXAlgorithm &algo, Event &ev) {
+        algo(ev);
+        return true;
+    }
+};
+
+/// @brief Single event operation of @ref FlipYAlgorithm
+template<>
+struct EventOperation<FlipYAlgorithm> {
+    template<typename Event>
+    static bool apply(const FlipYAlgorithm &algo, Event &ev) {
+        algo(ev);
+        return true;
+    }
+};
+
+/// @brief Single event operation of @ref TimeRangeFilterAlgorithm
+template<>
+struct EventOperation<TimeRangeFilterAlgorithm> {
+    template<typename Event>
+    static bool apply(const TimeRangeFilterAlgorithm &algo, Event &ev) {
+        return algo(ev);
+    }
+};
+
+/// @brief Class that applies a chain of stateless algorithms in a single pass over the events
+///
+/// Each event goes through all the algorithms, in order, and is only written to the output if none of them filtered
+/// it out. Compared to a chain of stages added with @ref Pipeline::add_algorithm_stage, there is no intermediate
+/// buffer, no task scheduled between the algorithms and the events are only read once.
+///
+/// @code{.cpp}
+/// auto &stage = pipeline.add_algorithm_stage(
+///     make_fused_algorithm(RoiFilterAlgorithm(0, 0, 319, 239), PolarityFilterAlgorithm(1), FlipXAlgorithm(319)),
+///     camera_stage);
+/// @endcode
+/// @tparam Algorithms The fused algorithms, an @ref EventOperation must be defined for each of them
+template<typename... Algorithms>
+class FusedAlgorithm {
+public:
+    /// @brief Builds a new FusedAlgorithm object from the algorithms to apply
+    /// @param algos The algorithms, in the order in which they are applied
+    explicit FusedAlgorithm(Algorithms... algos) : algos_(std::move(algos)...) {}
+
+    /// @brief Applies the algorithms to the given input buffer storing the result in the output buffer
+    /// @param first Beginning of the range of the input elements
+    /// @param last End of the range of the input elements
+    /// @param d_first Beginning of the destination range
+    /// @return Iterator pointing to the last + 1 event added in the output
+    template<class InputIt, class OutputIt>
+    inline OutputIt process_events(InputIt first, InputIt last, OutputIt d_first) {
+        for (; first != last; ++first) {
+            auto ev = *first;
+            if (apply(ev, std::index_sequence_for<Algorithms...>())) {
+                *d_first = ev;
+                ++d_first;
+            }
+        }
+        return d_first;
+    }
+
+    /// @brief Applies the algorithms to a buffer of events stored as a structure of arrays
+    ///
+    /// The algorithms are applied one after the other in the output buffer, which must be supported by all of them.
+    /// @param input Buffer of the input events
+    /// @param output Buffer of the processed events. It can be the same buffer as @p input
+    inline void process_events(const EventCDBufferSoA &input, EventCDBufferSoA &output) {
+        if (&output != &input) {
+            output = input;
+        }
+        process_in_place(output, std::index_sequence_for<Algorithms...>());
+    }
+
+    /// @brief Applies the algorithms to a single event
+    /// @param ev The event, updated in place
+    /// @return False if one of the algorithms filtered the event out, in which case @p ev is left partially processed
+    template<typename Event>
+    inline bool process_event(Event &ev) const {
+        return apply(ev, std::index_sequence_for<Algorithms...>());
+    }
+
+    /// @brief Returns one of the fused algorithms
+    /// @tparam I Index of the algorithm in the chain
+    /// @return The algorithm, that can be used to update its parameters
+    template<size_t I>
+    auto &get() {
+        return std::get<I>(algos_);
+    }
+
+    /// @brief Returns one of the fused algorithms
+    /// @tparam I Index of the algorithm in the chain
+    /// @return The algorithm
+    template<size_t I>
+    const auto &get() const {
+        return std::get<I>(algos_);
+    }
+
+private:
+    template<typename Event, size_t... Is>
+    bool apply(Event &ev, std::index_sequence<Is...>) const {
+        // the evaluation stops at the first algorithm filtering the event out
+        bool accepted = true;
+        (void)std::initializer_list<int>{
+            (accepted = accepted && EventOperation<Algorithms>::apply(std::get<Is>(algos_), ev), 0)...};
+        return accepted;
+    }
+
+    template<size_t... Is>
+    void process_in_place(EventCDBufferSoA &buffer, std::index_sequence<Is...>) {
+        (void)std::initializer_list<int>{(std::get<Is>(algos_).process_events(buffer, buffer), 0)...};
+    }
+
+    std::tuple<Algorithms...> algos_;
+};
+
+/// @brief Creates a @ref FusedAlgorithm applying the given algorithms in a single pass
+/// @param algos The algorithms, in the order in which they are applied
+/// @return The fused algorithm, that can be passed to @ref Pipeline::add_algorithm_stage
+template<typename... Algorithms>
+std::unique_ptr<FusedAlgorithm<std::decay_t<Algorithms>...>> make_fused_algorithm(Algorithms &&...algos) {
+    return std::make_unique<FusedAlgorithm<std::decay_t<Algorithms>...>>(std::forward<Algorithms>(algos)...);
+}
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_CORE_FUSED_ALGORITHM_H
@@ -20,7 +20,7 @@
 #include <sstream>
 
 #include "metavision/sdk/base/utils/sdk_log.h"
-#include "metavision/sdk/core/utils/detail/ring.h"
+#include "metavision/sdk/core/utils/detail/spsc_ring.h"
 #include "metavision/sdk/core/utils/timing_profiler.h"
 
 class GenericProducerAlgorithm_GTest;
@@ -40,6 +40,9 @@ namespace Metavision {
 /// events to be inserted. According to the timeout value, the producer will either not wait,
 /// wait indefinitely or wait for a predefined amount of time before returning the events,
 /// @sa @ref set_timeout.
+///
+/// The events are stored in a lock-free ring: @ref register_new_event_buffer and @ref process_events are expected to be
+/// called each from a single thread, and only take a lock to wait or to wake up the other thread.
 template<class EventType>
 class GenericProducerAlgorithm {
 public:
@@ -58,7 +61,7 @@ public:
     GenericProducerAlgorithm(timestamp timeout = 0, uint32_t max_events_per_second = 0,
                              timestamp max_duration_stored   = std::numeric_limits<timestamp>::max(),
                              bool allow_drop_when_overfilled = false) :
-        ring_event_(256, false),
+        ring_event_(1 << 18),
         timeout_(timeout),
         max_events_per_microseconds_(static_cast<float>(max_events_per_second) / 1000000),
         max_duration_stored_(max_duration_stored),
@@ -174,6 +177,9 @@ public:
         }
         last_processed_ts_ = ts;
         MV_SDK_LOG_DEBUG() << "GenericProducerAlgorithm: before overfilled_wait_cond_.notify_all()";
+        {
+            std::lock_guard<std::mutex> lock(overfilled_wait_mut_);
+        }
         overfilled_wait_cond_.notify_all();
         MV_SDK_LOG_DEBUG() << "--> GenericProducerAlgorithm::process() with ts:" << ts;
     }
@@ -326,22 +332,14 @@ private:
             });
         }
 
-        {
-            std::unique_lock<std::mutex> lock(underfilled_wait_mut_);
-            std::unique_lock<std::mutex> lock2(overfilled_wait_mut_);
-            ring_event_.drop();
-            ring_event_.add(start, end);
-        }
+        ring_event_.drop();
+        ring_event_.enqueue(start, end);
         notify_if_needed();
     }
 
     template<typename IteratorEv>
     void enqueue(IteratorEv start, IteratorEv end) {
-        {
-            std::unique_lock<std::mutex> lock(underfilled_wait_mut_);
-            std::unique_lock<std::mutex> lock2(overfilled_wait_mut_);
-            ring_event_.add(start, end);
-        }
+        ring_event_.enqueue(start, end);
         notify_if_needed();
     }
 
@@ -350,6 +348,11 @@ private:
         Metavision::timestamp wanted_ts = wanted_ts_;
         bool already_notified           = last_notified_ts_ >= wanted_ts;
         if (!already_notified && wanted_ts <= last_ts) {
+            // The lock is taken so that the consumer can not miss the notification between the evaluation of its
+            // waiting condition and its wait
+            {
+                std::lock_guard<std::mutex> lock(underfilled_wait_mut_);
+            }
             underfilled_wait_cond_.notify_all();
             last_notified_ts_ = last_ts;
         }
@@ -377,19 +380,15 @@ private:
     }
     template<typename OutputIt>
     void dequeue_with_drop(OutputIt inserter, timestamp ts, float max_events_per_deltat) {
-        std::unique_lock<std::mutex> lock(underfilled_wait_mut_);
-        std::unique_lock<std::mutex> lock2(overfilled_wait_mut_);
-        ring_event_.fill_buffer_to_drop_max_events(inserter, ts, max_events_per_deltat);
+        ring_event_.dequeue_max_events(inserter, ts, max_events_per_deltat);
     }
 
     template<typename OutputIt>
     void dequeue(OutputIt inserter, timestamp ts) {
-        std::unique_lock<std::mutex> lock(underfilled_wait_mut_);
-        std::unique_lock<std::mutex> lock2(overfilled_wait_mut_);
-        ring_event_.fill_buffer_to(inserter, ts);
+        ring_event_.dequeue(inserter, ts);
     }
 
-    Metavision::detail::Ring<EventType> ring_event_;
+    Metavision::detail::SpscRing<EventType> ring_event_;
     std::condition_variable underfilled_wait_cond_;
     mutable std::mutex underfilled_wait_mut_;
     std::condition_variable overfilled_wait_cond_;
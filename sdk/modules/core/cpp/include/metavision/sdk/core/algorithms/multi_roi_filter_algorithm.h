@@ -0,0 +1,97 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_MULTI_ROI_FILTER_ALGORITHM_H
+#define METAVISION_SDK_CORE_MULTI_ROI_FILTER_ALGORITHM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/base/events/event_cd_buffer_soa.h"
+
+namespace Metavision {
+
+/// @brief Class that only propagates events which are contained in a union of regions of interest
+///
+/// The regions are rectangles and/or an arbitrary pixel mask. They are rasterized in a bit mask of the sensor, so that
+/// the cost of the filter does not depend on the number of regions. The overloads processing buffers of events look up
+/// the mask for batches of events with AVX2 or NEON when available, and compact the accepted events in place with
+/// shuffle tables.
+class MultiRoiFilterAlgorithm {
+public:
+    /// @brief Builds a new MultiRoiFilterAlgorithm object, which accepts no event until regions are added
+    /// @param width Width of the sensor
+    /// @param height Height of the sensor
+    /// @throw std::invalid_argument if the size of the sensor is not positive
+    MultiRoiFilterAlgorithm(int width, int height);
+
+    /// @brief Adds a rectangular region of interest, clipped to the sensor
+    /// @param x0 X coordinate of the upper left corner of the region
+    /// @param y0 Y coordinate of the upper left corner of the region
+    /// @param x1 X coordinate of the lower right corner of the region, included
+    /// @param y1 Y coordinate of the lower right corner of the region, included
+    void add_roi(std::int32_t x0, std::int32_t y0, std::int32_t x1, std::int32_t y1);
+
+    /// @brief Replaces the regions of interest by a pixel mask
+    /// @param mask Mask of the sensor in row major order, the events of the pixels with a non zero value are accepted
+    /// @throw std::invalid_argument if the size of the mask is not the one of the sensor
+    void set_mask(const std::vector<std::uint8_t> &mask);
+
+    /// @brief Removes all the regions of interest
+    void clear();
+
+    /// @brief Returns true if the events of a pixel are accepted
+    bool is_accepted(int x, int y) const {
+        if (x < 0 || y < 0 || x >= width_ || y >= height_) {
+            return false;
+        }
+        const size_t index = static_cast<size_t>(y) * width_ + x;
+        return (mask_[index >> 5] >> (index & 31)) & 1;
+    }
+
+    /// @brief Applies the filter to the given input range storing the result in the output range
+    /// @param first Iterator at the beginning of the range of the input elements
+    /// @param last Iterator at the end of the range of the input elements
+    /// @param d_first Beginning of the destination range
+    /// @return Iterator pointing to the last + 1 event added in the output
+    template<class InputIt, class OutputIt>
+    OutputIt process_events(InputIt first, InputIt last, OutputIt d_first) const {
+        for (; first != last; ++first) {
+            if (is_accepted(first->x, first->y)) {
+                *d_first = *first;
+                ++d_first;
+            }
+        }
+        return d_first;
+    }
+
+    /// @brief Applies the filter to a buffer of events, with SIMD instructions when available
+    /// @param input Buffer of the input events
+    /// @param output Buffer of the events that passed the filter. It can be the same buffer as @p input
+    void process_events(const std::vector<EventCD> &input, std::vector<EventCD> &output) const;
+
+    /// @brief Applies the filter to a buffer of events stored as a structure of arrays, with SIMD instructions when
+    /// available
+    /// @param input Buffer of the input events
+    /// @param output Buffer of the events that passed the filter. It can be the same buffer as @p input
+    void process_events(const EventCDBufferSoA &input, EventCDBufferSoA &output) const;
+
+private:
+    int width_, height_;
+    // One bit per pixel, in row major order
+    std::vector<std::uint32_t> mask_;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_CORE_MULTI_ROI_FILTER_ALGORITHM_H
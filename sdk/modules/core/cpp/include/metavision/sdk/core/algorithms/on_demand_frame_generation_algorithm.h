@@ -13,10 +13,12 @@
 #define METAVISION_SDK_CORE_ON_DEMAND_FRAME_GENERATION_ALGORITHM_H
 
 #include <assert.h>
+#include <array>
 #include <deque>
 
 #include "metavision/sdk/base/events/event_cd.h"
 #include "metavision/sdk/core/algorithms/base_frame_generation_algorithm.h"
+#include "metavision/sdk/core/utils/dirty_tile_map.h"
 
 namespace Metavision {
 
@@ -76,6 +78,20 @@ public:
     /// @brief Returns the current accumulation time (in us).
     uint32_t get_accumulation_time_us() const;
 
+    /// @brief Enables or disables the incremental mode
+    ///
+    /// In incremental mode, the frame passed to @ref generate is expected to be the one of the previous call, and only
+    /// its tiles of @ref DirtyTileMap::TileSize x @ref DirtyTileMap::TileSize pixels in which events entered or left
+    /// the accumulation time window are rendered again. This saves most of the rendering time for scenes with a low
+    /// activity.
+    /// @warning In incremental mode, the frame must not be modified between two calls to @ref generate. If another
+    /// frame is passed, it is entirely rendered
+    /// @param incremental Flag to enable/disable the incremental mode
+    void set_incremental(bool incremental);
+
+    /// @brief Returns true if the incremental mode is enabled
+    bool is_incremental() const;
+
     /// @brief Resets the internal states
     ///
     /// The method @ref generate must be called with timestamps increasing monotonically. However there are no
@@ -84,9 +100,24 @@ public:
     void reset();
 
 private:
+    using EventIterator = std::deque<EventCD>::iterator;
+
+    /// @brief Renders the tiles of the frame marked as dirty from the events of the time window
+    /// @param begin Iterator to the first event of the time window
+    /// @param end Iterator to the past-the-end event of the time window
+    /// @param frame Frame to update
+    void generate_dirty_tiles(EventIterator begin, EventIterator end, cv::Mat &frame);
+
     uint32_t accumulation_time_us_; ///< Accumulation time of the events to generate the frame
     timestamp last_frame_ts_us_;    ///< Timestamp of the last generated frame
     std::deque<EventCD> events_queue_;
+
+    // Incremental mode
+    bool incremental_{false};                   ///< Whether only the tiles of the frame that changed are rendered
+    DirtyTileMap dirty_tiles_;                  ///< Tiles to render for the next frame
+    const uchar *rendered_data_{nullptr};       ///< Data of the last frame rendered, to detect another frame
+    std::array<cv::Vec3b, 3> rendered_colors_;  ///< Colors used to render the last frame
+    uint32_t rendered_accumulation_time_us_{0}; ///< Accumulation time used to render the last frame
 };
 
 template<typename EventIt>
@@ -12,10 +12,18 @@
 #ifndef METAVISION_SDK_CORE_PERIODIC_FRAME_GENERATION_ALGORITHM_H
 #define METAVISION_SDK_CORE_PERIODIC_FRAME_GENERATION_ALGORITHM_H
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
 #include <functional>
+#include <vector>
 
 #include "metavision/sdk/core/algorithms/async_algorithm.h"
 #include "metavision/sdk/core/algorithms/base_frame_generation_algorithm.h"
+#include "metavision/sdk/core/algorithms/detail/frame_generation_kernels.h"
+#include "metavision/sdk/core/utils/compact_mostrecent_timestamp_buffer.h"
+#include "metavision/sdk/core/utils/dirty_tile_map.h"
+#include "metavision/sdk/base/utils/object_pool.h"
 #include "metavision/sdk/base/utils/timestamp.h"
 
 namespace Metavision {
@@ -47,6 +55,45 @@ public:
     /// @brief Alias for frame generated callback
     using OutputCb = std::function<void(timestamp, cv::Mat &)>;
 
+    /// @brief Pool of the frames of the pooled output callback and of the output views
+    using FramePool = SharedObjectPool<cv::Mat>;
+
+    /// @brief Alias for the pooled frame generated callback, the frame going back to the pool once released
+    using PooledOutputCb = std::function<void(timestamp, const FramePool::ptr_type &)>;
+
+    /// @brief Alias for the callback of an output view, the frame going back to the pool of the view once released
+    using ViewOutputCb = std::function<void(timestamp, const FramePool::ptr_type &)>;
+
+    /// @brief Layout of the frames of an output view
+    enum class ViewFormat {
+        /// BGR frames (CV_8UC3), or grayscale ones (CV_8UC1) with ColorPalette::Gray
+        Default,
+
+        /// YUV 4:2:0 frames (CV_8UC1 of height * 3 / 2 rows), as expected by hardware encoders: the Y plane followed
+        /// by a plane of interleaved U and V samples
+        NV12,
+
+        /// YUV 4:2:0 frames (CV_8UC1 of height * 3 / 2 rows): the Y plane followed by the U plane and the V plane
+        I420
+    };
+
+    /// @brief Additional output of the frames, rendered from the same time surface (see @ref add_output_view)
+    struct OutputView {
+        /// Region of the sensor rendered, the whole sensor if empty
+        cv::Rect roi;
+
+        /// Factor by which the region is scaled down: each pixel of the view shows the most recent event displayed
+        /// among the corresponding block of downscale x downscale pixels of the region
+        int downscale = 1;
+
+        /// Palette used to render the view, the view being grayscale (single channel) with ColorPalette::Gray
+        Metavision::ColorPalette palette = default_palette();
+
+        /// Layout of the frames. The YUV formats use the BT.601 limited range conversion of the colors of the palette,
+        /// as cv::cvtColor with cv::COLOR_BGR2YUV_I420, each chroma sample being the mean of its 2x2 block of pixels
+        ViewFormat format = ViewFormat::Default;
+    };
+
     /// @brief Constructor
     /// @param sensor_width Sensor's width (in pixels)
     /// @param sensor_height Sensor's height (in pixels)
@@ -81,6 +128,20 @@ public:
     /// used outside the scope of the callback, the user must ensure to swap or copy it to another object
     void set_output_callback(const OutputCb &output_cb);
 
+    /// @brief Sets the callback to call with frames of a pool when an image has been generated, instead of the one
+    /// set with @ref set_output_callback
+    ///
+    /// The frames are rendered in frames acquired from @p frame_pool, and go back to the pool when the last copy of
+    /// their pointer is released. They can thus be kept after the callback, e.g. by asynchronous consumers such as
+    /// encoders, without triggering any allocation in the rendering of the next frames once the pool holds enough
+    /// frames. With a bounded pool, the generation waits for a frame to be released when all of them are in use.
+    /// @warning The frames must not be modified by the consumers, as they may be updated incrementally when they come
+    /// back from the pool (see @ref set_incremental)
+    /// @param output_cb Callback called with the generated frames
+    /// @param frame_pool Pool of the frames
+    void set_pooled_output_callback(const PooledOutputCb &output_cb,
+                                    FramePool frame_pool = FramePool::make_unbounded(2));
+
     /// @brief Processes the events to update the internal time surface for the frame generation
     /// @tparam EventIt Input event iterator type. Works for iterators over containers of @ref EventCD or equivalent
     /// @param it_begin Iterator to first input event
@@ -89,6 +150,23 @@ public:
     template<typename EventIt>
     inline void process_events(EventIt it_begin, EventIt it_end);
 
+    /// @brief Adds a view to render along with each frame, from the same events
+    ///
+    /// Each time a frame is generated, the view is rendered from the time surface of the algorithm into a frame of
+    /// the pool of the view, which is given to @p output_cb after the frame of the output callback (see
+    /// @ref set_output_callback). This avoids processing the same events with several instances of the algorithm to
+    /// get for example a scaled down preview or a crop of the frames. The views are always entirely rendered, whatever
+    /// the incremental mode.
+    /// @param view Description of the view
+    /// @param output_cb Callback called with the frames of the view
+    /// @return The size of the images of the view, which is also the size of the frames for the default format
+    /// @throw std::invalid_argument if the factor of the view is not positive, its region does not overlap the sensor
+    /// or the size of a view in a YUV format is odd
+    cv::Size add_output_view(const OutputView &view, const ViewOutputCb &output_cb);
+
+    /// @brief Removes all the views added with @ref add_output_view
+    void clear_output_views();
+
     /// @brief Forces the generation of a frame for the current period with the input events that have been processed
     ///
     /// This is to be used at the end of a process if one's wants to generate frames with the remaining events
@@ -105,6 +183,25 @@ public:
     /// @brief Returns the current fps at which frames are generated
     double get_fps();
 
+    /// @brief Enables the adaptive frame rate, to save the rendering and encoding of frames of static scenes
+    ///
+    /// The fps set with @ref set_fps becomes the maximum frame rate, at which the activity of the scene is evaluated:
+    /// the scene is active during a frame period if the rate of its events is above @p activity_threshold_hz. The
+    /// frames of an active scene are generated at the maximum frame rate, the first one at the end of the first active
+    /// period, without waiting for the next frame of the static scene. Once the scene gets static, the frame period
+    /// doubles at each frame until the one of @p min_fps. If @p min_fps is 0, no frame is generated once the frame
+    /// period exceeds the accumulation time, i.e. once the last events have been displayed and expired.
+    /// @param min_fps Frame rate of a static scene, or 0 to generate no frame
+    /// @param activity_threshold_hz Event rate above which the scene is active, in Hz
+    /// @throw std::invalid_argument If the frame rate or the event rate is negative
+    void set_adaptive_fps(double min_fps, double activity_threshold_hz);
+
+    /// @brief Disables the adaptive frame rate, the frames being generated at the fps set with @ref set_fps
+    void disable_adaptive_fps();
+
+    /// @brief Returns true if the adaptive frame rate is enabled
+    bool is_adaptive_fps() const;
+
     /// @brief Sets the accumulation time (in us) to use to generate a frame
     ///
     /// Frame generated will only hold events in the interval [t - dt, t[ where t is the timestamp at
@@ -120,6 +217,20 @@ public:
     /// before this timestamp
     void skip_frames_up_to(timestamp ts);
 
+    /// @brief Enables or disables the incremental mode
+    ///
+    /// In incremental mode, the frame is kept from one generation to the next, and only its tiles of
+    /// @ref DirtyTileMap::TileSize x @ref DirtyTileMap::TileSize pixels that received events since the previous frame
+    /// or that displayed events that may have expired since then are rendered again. This saves most of the rendering
+    /// time for scenes with a low activity.
+    /// @warning In incremental mode, the frame passed to the output callback must not be modified. If it is swapped,
+    /// the next frame is entirely rendered
+    /// @param incremental Flag to enable/disable the incremental mode
+    void set_incremental(bool incremental);
+
+    /// @brief Returns true if the incremental mode is enabled
+    bool is_incremental() const;
+
     /// @brief Resets the internal states
     void reset();
 
@@ -132,10 +243,49 @@ private:
     /// This method is called at the input fps frequency
     void process_async(const timestamp processing_ts, const size_t n_processed_events);
 
+    /// @brief Renders a region of the frame from the time surface
+    /// @param region Region of the frame to render
+    /// @param min_display_event_ts Time threshold below which events are not displayed, as an offset of the time
+    /// surface
+    void render(const cv::Rect &region, int32_t min_display_event_ts);
+
+    struct View {
+        cv::Rect roi;
+        int downscale;
+        cv::Size size;
+        bool colored;
+        std::array<cv::Vec3b, 3> colors;     ///< Colors of the OFF and ON events and of the background
+        ViewFormat format;
+        std::array<cv::Vec3b, 3> yuv_colors; ///< Colors in YUV, for the YUV formats
+        ViewOutputCb output_cb;
+        FramePool pool;
+    };
+
+    /// @brief Computes the indices of the colors of pixels of a row of a view
+    /// @param view View to render
+    /// @param vy Row of the view
+    /// @param vx First column of the view
+    /// @param n Number of pixels
+    /// @param min_display_event_ts Time threshold below which events are not displayed, as an offset of the time
+    /// surface
+    /// @param indices Indices of the colors of the pixels
+    void compute_view_indices(const View &view, int vy, int vx, int n, int32_t min_display_event_ts,
+                              uint8_t *indices) const;
+
+    /// @brief Renders rows of a view from the time surface
+    /// @param view View to render
+    /// @param rows Rows of the view to render, or pairs of rows for the YUV formats
+    /// @param min_display_event_ts Time threshold below which events are not displayed, as an offset of the time
+    /// surface
+    /// @param frame Frame of the view
+    void render_view(const View &view, const cv::Range &rows, int32_t min_display_event_ts, cv::Mat &frame) const;
+
     /// @brief Resets the time surface
     void reset_time_surface();
 
-    OutputCb output_cb_; ///< The callback to call when a frame is generated
+    OutputCb output_cb_;              ///< The callback to call when a frame is generated
+    PooledOutputCb pooled_output_cb_; ///< The callback to call with a frame of the pool, if any
+    FramePool frame_pool_;            ///< Pool of the frames given to the pooled output callback
 
     cv::Mat frame_;            ///< Internal image that is filled when asynchronous condition is met
     uint32_t frame_period_us_; ///< Period (in us) between two frames generation (i.e. period between two calls to
@@ -150,10 +300,30 @@ private:
                             /// processed time slice
 
     // Time surface
-    std::vector<std::pair<int32_t, bool>> time_surface_; ///< Pixels' history (time surface). This object stores the
-                                                         ///< last events data that occurred at a given pixel
-    timestamp ts_offset_{0}; ///< State variable to handle time overflow in the time surface. This is to minimize the
-                             ///< memory footprint of the time surface access
+    CompactMostRecentTimestampBuffer time_surface_ts_; ///< Pixels' history (time surface). This object stores the
+                                                       ///< timestamp of the last event that occurred at a given pixel,
+                                                       ///< as a 32 bits offset to minimize the memory footprint
+    std::vector<uint8_t> time_surface_pol_; ///< Polarity (0 or 1) of the last event that occurred at a given pixel.
+                                            ///< Stored apart from the timestamps so that frames are rendered with
+                                            ///< vector instructions
+
+    // Incremental mode
+    bool incremental_{false};                  ///< Whether only the tiles of the frame that changed are rendered
+    DirtyTileMap dirty_tiles_;                 ///< Tiles that received events since the last frame
+    std::vector<int32_t> tile_last_ts_;        ///< Offset of the last event of each tile in the time surface
+    std::vector<cv::Rect> tiles_to_render_;    ///< Tiles rendered for the current frame
+    bool full_render_needed_{true};            ///< Whether the next frame must be entirely rendered
+    int32_t last_min_display_event_ts_{0};     ///< Time threshold used to render the last frame
+    const uchar *rendered_data_{nullptr};      ///< Data of the last frame rendered, to detect that it has been swapped
+    std::array<cv::Vec3b, 3> rendered_colors_; ///< Colors used to render the last frame
+
+    std::vector<View> views_; ///< Additional views rendered along with each frame
+
+    // Adaptive frame rate
+    bool adaptive_fps_{false};             ///< Whether the frame rate adapts to the activity of the scene
+    uint32_t idle_frame_period_us_{0};     ///< Period between the frames of a static scene, 0 if none
+    double activity_threshold_{0.};        ///< Event rate (in Hz) above which the scene is active
+    uint32_t adaptive_frame_period_us_{0}; ///< Current period between frames, ramping down to the idle one
 };
 
 template<typename EventIt>
@@ -178,22 +348,36 @@ void PeriodicFrameGenerationAlgorithm::process_online(EventIt it_begin, EventIt
 
     // Add events in the time surface
 
-    // Checks time overflow. If one occurs, updates the time offset to apply and the timesurface accordingly.
-    while (std::prev(it_end)->t > ts_offset_ + std::numeric_limits<int32_t>::max()) {
-        ts_offset_ += std::numeric_limits<int32_t>::max();
-        for (auto &pix_data : time_surface_) {
-            pix_data.first =
-                pix_data.first >= std::numeric_limits<int32_t>::min() + std::numeric_limits<int32_t>::max() ?
-                    pix_data.first - std::numeric_limits<int32_t>::max() :
-                    std::numeric_limits<int32_t>::min();
-        }
+    // Checks time overflow. If one occurs, the time surface moves its epoch forward, and the timestamps of the tiles
+    // are shifted accordingly
+    const timestamp shift = time_surface_ts_.rebase(std::prev(it_end)->t);
+    if (shift != 0) {
+        for (auto &ts : tile_last_ts_)
+            ts = static_cast<int32_t>(std::max<timestamp>(ts - shift, std::numeric_limits<int32_t>::min()));
+        full_render_needed_ = true;
     }
 
     // Refresh the time-surface using the event buffer
-    for (auto it = it_begin; it != it_end; ++it) {
-        const int32_t it_t                    = static_cast<int32_t>(it->t - ts_offset_);
-        time_surface_[it->y * width_ + it->x] = {it_t, it->p};
-    }
+    int32_t *time_surface_ts = time_surface_ts_.ptr();
+    // The width is a compile time constant for the common sensors' geometries, see detail::dispatch_on_width
+    detail::dispatch_on_width(width_, [&](auto width) {
+        if (incremental_) {
+            for (auto it = it_begin; it != it_end; ++it) {
+                const size_t pixel       = it->y * width + it->x;
+                const size_t tile        = dirty_tiles_.get_tile_index(it->x, it->y);
+                time_surface_ts[pixel]   = time_surface_ts_.to_offset(it->t);
+                time_surface_pol_[pixel] = it->p != 0;
+                tile_last_ts_[tile]      = time_surface_ts[pixel];
+                dirty_tiles_.mark_tile(tile);
+            }
+        } else {
+            for (auto it = it_begin; it != it_end; ++it) {
+                const size_t pixel       = it->y * width + it->x;
+                time_surface_ts[pixel]   = time_surface_ts_.to_offset(it->t);
+                time_surface_pol_[pixel] = it->p != 0;
+            }
+        }
+    });
 }
 
 } // namespace Metavision
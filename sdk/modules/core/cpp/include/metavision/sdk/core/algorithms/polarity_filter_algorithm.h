@@ -16,7 +16,10 @@
 
 #include "metavision/sdk/base/utils/sdk_log.h"
 #include "metavision/sdk/core/algorithms/detail/internal_algorithms.h"
+#include "metavision/sdk/core/algorithms/detail/event_batch_kernels.h"
 #include "metavision/sdk/base/events/event2d.h"
+#include "metavision/sdk/base/events/event_cd_buffer_soa.h"
+#include "metavision/sdk/base/events/event_cd_compact.h"
 
 namespace Metavision {
 
@@ -35,11 +38,28 @@ public:
     /// @param last End of the range of the input elements
     /// @param d_first Beginning of the destination range
     /// @return Iterator pointing to the last + 1 event added in the output
+    /// @note Contiguous events (arrays or vectors) are processed in batches, with SIMD instructions when available
     template<class InputIt, class OutputIt>
     inline OutputIt process_events(InputIt first, InputIt last, OutputIt d_first) {
-        return Metavision::detail::insert_if(first, last, d_first, std::ref(*this));
+        return Metavision::detail::dispatch_batch_kernel(
+            first, last, d_first,
+            [this](const auto *in, auto *out, size_t n) { return detail::filter_polarity_events(in, out, n, pol_); },
+            [this](InputIt first, InputIt last, OutputIt d_first) {
+                return Metavision::detail::insert_if(first, last, d_first, std::ref(*this));
+            });
     }
 
+    /// @brief Applies the Polarity filter to a buffer of events stored as a structure of arrays
+    /// @param input Buffer of the input events
+    /// @param output Buffer of the events that passed the filter. It can be the same buffer as @p input
+    inline void process_events(const EventCDBufferSoA &input, EventCDBufferSoA &output);
+
+    /// @brief Applies the Polarity filter to a buffer of compact events
+    /// @param input Buffer of the input events
+    /// @param output Buffer of the events that passed the filter, with the base time of @p input. It can be the same
+    /// buffer as @p input
+    inline void process_events(const EventCDCompactBuffer &input, EventCDCompactBuffer &output);
+
     /// @note process(...) is deprecated since version 2.2.0 and will be removed in later releases.
     ///       Please use process_events(...) instead
     template<class InputIt, class OutputIt>
@@ -87,6 +107,47 @@ inline int16_t PolarityFilterAlgorithm::polarity() const {
     return pol_;
 }
 
+inline void PolarityFilterAlgorithm::process_events(const EventCDBufferSoA &input, EventCDBufferSoA &output) {
+    const size_t n = input.size();
+    output.resize(n);
+
+    const unsigned short *in_x = input.x(), *in_y = input.y();
+    const short *in_p          = input.p();
+    const timestamp *in_t      = input.t();
+    unsigned short *out_x = output.x(), *out_y = output.y();
+    short *out_p          = output.p();
+    timestamp *out_t      = output.t();
+
+    // Branchless compaction, see RoiFilterAlgorithm
+    size_t n_out = 0;
+    for (size_t i = 0; i < n; ++i) {
+        out_x[n_out] = in_x[i];
+        out_y[n_out] = in_y[i];
+        out_p[n_out] = in_p[i];
+        out_t[n_out] = in_t[i];
+        n_out += (in_p[i] == pol_);
+    }
+    output.resize(n_out);
+}
+
+inline void PolarityFilterAlgorithm::process_events(const EventCDCompactBuffer &input, EventCDCompactBuffer &output) {
+    const size_t n = input.size();
+    if (&output != &input) {
+        output.reset(input.base_time());
+    }
+    output.resize(n);
+
+    // Branchless compaction, see RoiFilterAlgorithm
+    const EventCDCompact *in = input.data();
+    EventCDCompact *out      = output.data();
+    size_t n_out             = 0;
+    for (size_t i = 0; i < n; ++i) {
+        out[n_out] = in[i];
+        n_out += (in[i].p() == pol_);
+    }
+    output.resize(n_out);
+}
+
 inline bool PolarityFilterAlgorithm::operator()(const Event2d &ev) const {
     return (ev.p == pol_);
 }
@@ -16,6 +16,7 @@
 
 #include "metavision/sdk/base/utils/sdk_log.h"
 #include "metavision/sdk/core/algorithms/detail/internal_algorithms.h"
+#include "metavision/sdk/core/algorithms/detail/event_batch_kernels.h"
 #include "metavision/sdk/base/events/event2d.h"
 
 namespace Metavision {
@@ -35,9 +36,15 @@ public:
     /// @param first Beginning of the range of the input elements
     /// @param last End of the range of the input elements
     /// @param d_first Beginning of the destination range
+    /// @note Contiguous events (arrays or vectors) are processed in batches, with SIMD instructions when available
     template<class InputIt, class OutputIt>
     inline void process_events(InputIt first, InputIt last, OutputIt d_first) {
-        Metavision::detail::transform(first, last, d_first, std::ref(*this));
+        Metavision::detail::dispatch_batch_kernel(
+            first, last, d_first,
+            [](const auto *in, auto *out, size_t n) { return detail::invert_polarity_events(in, out, n); },
+            [this](InputIt first, InputIt last, OutputIt d_first) {
+                return Metavision::detail::transform(first, last, d_first, std::ref(*this));
+            });
     }
 
     /// @note process(...) is deprecated since version 2.2.0 and will be removed in later releases.
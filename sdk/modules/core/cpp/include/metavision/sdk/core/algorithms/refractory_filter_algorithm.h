@@ -0,0 +1,106 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_REFRACTORY_FILTER_ALGORITHM_H
+#define METAVISION_SDK_CORE_REFRACTORY_FILTER_ALGORITHM_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "metavision/sdk/base/events/event_cd_buffer_soa.h"
+#include "metavision/sdk/base/events/event_cd_compact.h"
+#include "metavision/sdk/base/utils/timestamp.h"
+#include "metavision/sdk/core/algorithms/detail/event_batch_kernels.h"
+#include "metavision/sdk/core/utils/compact_mostrecent_timestamp_buffer.h"
+
+namespace Metavision {
+
+/// @brief Class that drops the events following the last event kept for their pixel by less than a refractory period
+///
+/// This removes the bursts of redundant events produced by flickering lights or hot pixels. The timestamp of the last
+/// event kept for each pixel, and optionally each polarity, is stored as an offset in a
+/// @ref TCompactMostRecentTimestampBuffer, of 32 bits or 16 bits. With 16 bits offsets, the timestamps are stored at
+/// the resolution given to the constructor, the refractory period being applied to the timestamps rounded down to
+/// this resolution.
+///
+/// The events are compacted without branch, each event being written to the output and the output index only moving
+/// forward when it is kept, which also allows to filter a buffer in place.
+/// @tparam offset_type Type of the offsets of the timestamps, std::int32_t or std::int16_t
+/// @note The events must be inside the sensor
+template<typename offset_type>
+class TRefractoryFilterAlgorithm {
+public:
+    /// @brief Builds a new TRefractoryFilterAlgorithm object
+    /// @param width Width of the sensor
+    /// @param height Height of the sensor
+    /// @param refractory_period_us Minimum duration between two events kept for a pixel, in us
+    /// @param separate_polarities If true, the refractory period applies to the events of each polarity separately
+    /// @param resolution_us Duration (in us) of a unit of the offsets of the timestamps
+    /// @throw std::invalid_argument if the size of the sensor or the resolution is not positive, or if the refractory
+    /// period is negative or longer than the range of the offsets
+    inline TRefractoryFilterAlgorithm(int width, int height, timestamp refractory_period_us,
+                                      bool separate_polarities = true, timestamp resolution_us = 1);
+
+    /// @brief Sets the refractory period of the filter
+    /// @param refractory_period_us Minimum duration between two events kept for a pixel, in us
+    /// @throw std::invalid_argument if the refractory period is negative or longer than the range of the offsets
+    inline void set_refractory_period(timestamp refractory_period_us);
+
+    /// @brief Gets the refractory period of the filter, in us
+    inline timestamp get_refractory_period() const;
+
+    /// @brief Returns true if the refractory period applies to the events of each polarity separately
+    inline bool is_separating_polarities() const;
+
+    /// @brief Forgets the events processed so far
+    inline void reset();
+
+    /// @brief Applies the filter to the given input range storing the result in the output range
+    /// @param first Iterator at the beginning of the range of the input elements
+    /// @param last Iterator at the end of the range of the input elements
+    /// @param d_first Beginning of the destination range
+    /// @return Iterator pointing to the last + 1 event added in the output
+    /// @note Contiguous events (arrays or vectors) are compacted without branch
+    template<class InputIt, class OutputIt>
+    inline OutputIt process_events(InputIt first, InputIt last, OutputIt d_first);
+
+    /// @brief Applies the filter to a buffer of events stored as a structure of arrays
+    /// @param input Buffer of the input events
+    /// @param output Buffer of the events that passed the filter. It can be the same buffer as @p input
+    inline void process_events(const EventCDBufferSoA &input, EventCDBufferSoA &output);
+
+    /// @brief Applies the filter to a buffer of compact events
+    /// @param input Buffer of the input events
+    /// @param output Buffer of the events that passed the filter, with the base time of @p input. It can be the same
+    /// buffer as @p input
+    inline void process_events(const EventCDCompactBuffer &input, EventCDCompactBuffer &output);
+
+private:
+    // Returns true if an event is kept, in which case its timestamp becomes the last one of its pixel
+    inline bool process_event(int x, int y, short p, timestamp t);
+
+    int width_;
+    int channels_;
+    timestamp refractory_period_;
+    TCompactMostRecentTimestampBuffer<offset_type> timestamps_;
+};
+
+/// @brief Refractory filter storing the timestamps as 32 bits offsets
+using RefractoryFilterAlgorithm = TRefractoryFilterAlgorithm<std::int32_t>;
+
+/// @brief Refractory filter storing the timestamps as 16 bits offsets, usually at a coarser resolution than 1us
+using RefractoryFilterAlgorithm16 = TRefractoryFilterAlgorithm<std::int16_t>;
+
+} // namespace Metavision
+
+#include "metavision/sdk/core/algorithms/detail/refractory_filter_algorithm_impl.h"
+
+#endif // METAVISION_SDK_CORE_REFRACTORY_FILTER_ALGORITHM_H
@@ -15,6 +15,8 @@
 #include <memory>
 
 #include "metavision/sdk/base/utils/sdk_log.h"
+#include "metavision/sdk/base/events/event_cd_buffer_soa.h"
+#include "metavision/sdk/base/events/event_cd_compact.h"
 #include "metavision/sdk/core/algorithms/detail/internal_algorithms.h"
 
 namespace Metavision {
@@ -46,6 +48,17 @@ public:
     template<class InputIt, class OutputIt>
     inline OutputIt process_events(InputIt first, InputIt last, OutputIt d_first);
 
+    /// @brief Applies the ROI Mask filter to a buffer of events stored as a structure of arrays
+    /// @param input Buffer of the input events
+    /// @param output Buffer of the events that passed the filter. It can be the same buffer as @p input
+    inline void process_events(const EventCDBufferSoA &input, EventCDBufferSoA &output);
+
+    /// @brief Applies the ROI Mask filter to a buffer of compact events
+    /// @param input Buffer of the input events
+    /// @param output Buffer of the events that passed the filter, with the base time of @p input. It can be the same
+    /// buffer as @p input
+    inline void process_events(const EventCDCompactBuffer &input, EventCDCompactBuffer &output);
+
     /// @note process(...) is deprecated since version 2.2.0 and will be removed in later releases.
     ///       Please use process_events(...) instead
     template<class InputIt, class OutputIt>
@@ -136,6 +149,57 @@ inline OutputIt RoiFilterAlgorithm::process_events(InputIt first, InputIt last,
     }
 }
 
+inline void RoiFilterAlgorithm::process_events(const EventCDBufferSoA &input, EventCDBufferSoA &output) {
+    const size_t n = input.size();
+    output.resize(n);
+
+    const unsigned short *in_x = input.x(), *in_y = input.y();
+    const short *in_p          = input.p();
+    const timestamp *in_t      = input.t();
+    unsigned short *out_x = output.x(), *out_y = output.y();
+    short *out_p          = output.p();
+    timestamp *out_t      = output.t();
+
+    // Branchless compaction: every event is written, but only the accepted ones are kept. Writing in place is safe as
+    // the output index never exceeds the input one
+    const std::int32_t dx = output_relative_coordinates_ ? x0_ : 0;
+    const std::int32_t dy = output_relative_coordinates_ ? y0_ : 0;
+    size_t n_out          = 0;
+    for (size_t i = 0; i < n; ++i) {
+        const std::int32_t x = in_x[i], y = in_y[i];
+        const bool accepted  = (x >= x0_) & (x <= x1_) & (y >= y0_) & (y <= y1_);
+        out_x[n_out]         = static_cast<unsigned short>(x - dx);
+        out_y[n_out]         = static_cast<unsigned short>(y - dy);
+        out_p[n_out]         = in_p[i];
+        out_t[n_out]         = in_t[i];
+        n_out += accepted;
+    }
+    output.resize(n_out);
+}
+
+inline void RoiFilterAlgorithm::process_events(const EventCDCompactBuffer &input, EventCDCompactBuffer &output) {
+    const size_t n = input.size();
+    if (&output != &input) {
+        output.reset(input.base_time());
+    }
+    output.resize(n);
+
+    // Branchless compaction, as for the buffers stored as a structure of arrays
+    const EventCDCompact *in = input.data();
+    EventCDCompact *out      = output.data();
+    const std::int32_t dx    = output_relative_coordinates_ ? x0_ : 0;
+    const std::int32_t dy    = output_relative_coordinates_ ? y0_ : 0;
+    size_t n_out             = 0;
+    for (size_t i = 0; i < n; ++i) {
+        const std::int32_t x = in[i].x(), y = in[i].y();
+        const bool accepted  = (x >= x0_) & (x <= x1_) & (y >= y0_) & (y <= y1_);
+        out[n_out] = EventCDCompact(static_cast<unsigned short>(x - dx), static_cast<unsigned short>(y - dy), in[i].p(),
+                                    in[i].dt);
+        n_out += accepted;
+    }
+    output.resize(n_out);
+}
+
 inline bool RoiFilterAlgorithm::is_resetting() const {
     return output_relative_coordinates_;
 }
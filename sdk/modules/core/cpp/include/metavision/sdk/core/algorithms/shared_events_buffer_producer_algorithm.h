@@ -12,6 +12,8 @@
 #ifndef METAVISION_SDK_CORE_SHARED_EVENTS_BUFFER_PRODUCER_ALGORITHM_H
 #define METAVISION_SDK_CORE_SHARED_EVENTS_BUFFER_PRODUCER_ALGORITHM_H
 
+#include <cstdint>
+#include <deque>
 #include <vector>
 #include <memory>
 #include <algorithm>
@@ -30,6 +32,9 @@ struct SharedEventsBufferProducerParameters {
     uint32_t buffers_preallocation_size_{
         0}; ///< number of events to preallocate buffer with for efficiency purpose at insertion
     bool bounded_memory_pool_{true};
+    bool buffers_trigger_slicing_{false}; ///< cut the buffers at the timestamps of the trigger events given to
+                                          ///< @ref SharedEventsBufferProducerAlgorithm::process_trigger_events
+    int16_t buffers_trigger_polarity_{1}; ///< polarity of the trigger events cutting the buffers, -1 for both edges
 };
 
 /// @brief A utility class to generate shared ptr around a vector of events according to a processing policy
@@ -69,6 +74,9 @@ public:
     /// Setting non zero value to both @ref SharedEventsBufferProducerParameters::buffers_events_count_ and @ref
     /// SharedEventsBufferProducerParameters::buffers_time_slice_us_ calls @ref set_processing_mixed.
     ///
+    /// Setting @ref SharedEventsBufferProducerParameters::buffers_trigger_slicing_ calls @ref set_processing_external
+    /// whatever the other values, the buffers being then cut by @ref process_trigger_events.
+    ///
     /// The mode can be overridden after calling the constructor.
     ///
     /// @param params An @ref SharedEventsBufferProducerParameters object containing the parameters.
@@ -79,6 +87,23 @@ public:
     /// @brief Resets the internal states of the policy
     inline void clear();
 
+    /// @brief Cuts the buffers at the timestamps of trigger events, when
+    /// @ref SharedEventsBufferProducerParameters::buffers_trigger_slicing_ is enabled
+    ///
+    /// Each trigger event of polarity @ref SharedEventsBufferProducerParameters::buffers_trigger_polarity_ ends a
+    /// buffer, produced with the timestamp of the trigger once the first event at or after it is processed: the
+    /// buffer holds the events in [previous trigger timestamp, trigger timestamp[, and may be empty so that there is
+    /// exactly one buffer per trigger. The events before the first trigger are produced in a first buffer.
+    ///
+    /// The trigger events can be given before or after the events they slice, as long as they are not given after a
+    /// buffer holding events past their timestamp has already been produced, in which case they end an empty buffer.
+    /// Does nothing if trigger slicing is disabled.
+    /// @tparam InputIt Iterator over events with a timestamp t and a polarity p (e.g. @ref EventExtTrigger)
+    /// @param it_begin Iterator to the first trigger event
+    /// @param it_end Iterator to the past-the-end trigger event
+    template<typename InputIt>
+    inline void process_trigger_events(InputIt it_begin, InputIt it_end);
+
 private:
     /// @brief Function to process directly the events
     template<typename InputIt>
@@ -87,10 +112,14 @@ private:
     /// @brief Function to process the state that is called every n_events or n_us
     inline void process_async(const timestamp processing_ts, const size_t n_processed_events);
 
+    /// @brief Produces the current buffer with the given timestamp and acquires a new one from the pool
+    inline void produce_current_buffer(const timestamp processing_ts);
+
     SharedEventsBufferProducedCb buffer_produced_cb_;
     EventsBufferPool buffers_pool_;
     SharedEventsBuffer current_shared_buffer_;
     SharedEventsBufferProducerParameters params_;
+    std::deque<timestamp> pending_cuts_; ///< timestamps of the triggers past the last event processed
 
     friend AsyncAlgorithm<SharedEventsBufferProducerAlgorithm>;
 };
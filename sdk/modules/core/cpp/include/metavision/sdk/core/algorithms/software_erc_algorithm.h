@@ -0,0 +1,162 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_SOFTWARE_ERC_ALGORITHM_H
+#define METAVISION_SDK_CORE_SOFTWARE_ERC_ALGORITHM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "metavision/sdk/base/utils/timestamp.h"
+#include "metavision/sdk/core/utils/rate_estimator.h"
+
+namespace Metavision {
+
+/// @brief Configuration of a @ref SoftwareErcAlgorithm
+struct SoftwareErcConfig {
+    /// Maximum rate of the events output, in ev/s
+    double target_rate_ev_per_s = 20e6;
+
+    /// Period at which the rate of the input events is estimated and the decimation updated, in us
+    timestamp rate_step_us = 10000;
+
+    /// Time window over which the rate of the input events is averaged, in us
+    timestamp rate_window_us = 50000;
+
+    /// Backlog of the downstream processing above which the target rate is lowered, see
+    /// @ref SoftwareErcAlgorithm::set_backlog_probe. The unit is the one of the probe (e.g. buffers queued)
+    size_t max_backlog = 0;
+
+    /// Factor applied to the target rate at each update while the backlog is above @ref max_backlog
+    double backoff_factor = 0.7;
+
+    /// Factor applied to the target rate at each update while the backlog is below half of @ref max_backlog, until
+    /// it is back to @ref target_rate_ev_per_s
+    double recovery_factor = 1.1;
+
+    /// Minimum of the target rate lowered because of the backlog, in ev/s
+    double min_target_rate_ev_per_s = 1e6;
+};
+
+/// @brief Class that decimates the events to keep their rate under a target, like the hardware event rate controller
+/// (ERC) of some sensors
+///
+/// The rate of the input events is estimated with a @ref RateEstimator, and the fraction of events kept is updated
+/// periodically so that the output rate does not exceed the target. The decimation is deterministic and spatially
+/// uniform: each pixel keeps the same fraction of its events, regularly spaced, the pixels being out of phase so that
+/// they do not keep their events at the same time.
+///
+/// Optionally, the target rate is lowered while the downstream processing falls behind (see @ref set_backlog_probe),
+/// and raised back once it has caught up, so that the latency of the processing remains bounded during bursts.
+class SoftwareErcAlgorithm {
+public:
+    /// @brief Builds a new SoftwareErcAlgorithm object
+    /// @param width Width of the sensor
+    /// @param height Height of the sensor
+    /// @param config Configuration of the controller
+    /// @throw std::invalid_argument if the size of the sensor or the configuration is invalid
+    SoftwareErcAlgorithm(int width, int height, const SoftwareErcConfig &config = SoftwareErcConfig());
+
+    /// @brief Copy constructor, deleted since the rate estimator refers to the object
+    SoftwareErcAlgorithm(const SoftwareErcAlgorithm &) = delete;
+
+    /// @brief Copy assignment operator, deleted since the rate estimator refers to the object
+    SoftwareErcAlgorithm &operator=(const SoftwareErcAlgorithm &) = delete;
+
+    /// @brief Sets the function giving the backlog of the downstream processing, which closes the control loop
+    ///
+    /// The probe is called at each update of the decimation, from the thread processing the events. It typically
+    /// returns the number of buffers waiting to be processed in a queue of the pipeline.
+    /// @param probe Function returning the backlog, or an empty function to disable the closed loop
+    void set_backlog_probe(const std::function<size_t()> &probe);
+
+    /// @brief Applies the decimation to the given input range storing the result in the output range
+    /// @param first Iterator at the beginning of the range of the input elements
+    /// @param last Iterator at the end of the range of the input elements
+    /// @param d_first Beginning of the destination range, which can be @p first
+    /// @return Iterator pointing to the last + 1 event added in the output
+    template<class InputIt, class OutputIt>
+    OutputIt process_events(InputIt first, InputIt last, OutputIt d_first) {
+        for (; first != last; ++first) {
+            count_event(first->t);
+            if (keep_ratio_ >= KeepAll || is_kept(first->x, first->y)) {
+                *d_first = *first;
+                ++d_first;
+            }
+        }
+        return d_first;
+    }
+
+    /// @brief Gets the current target rate, lowered if the downstream processing is behind, in ev/s
+    double get_target_rate() const;
+
+    /// @brief Gets the last estimated rate of the input events, in ev/s
+    double get_input_rate() const;
+
+    /// @brief Gets the fraction of the events currently kept
+    double get_keep_ratio() const;
+
+    /// @brief Resets the controller to its initial state, keeping all the events until the rate is estimated
+    void reset();
+
+private:
+    // Fraction of the events kept, in 1/65536
+    static constexpr std::uint32_t KeepAll = 1 << 16;
+
+    void count_event(timestamp t) {
+        if (first_t_ < 0) {
+            first_t_            = t;
+            next_rate_update_t_ = t + config_.rate_step_us;
+        }
+        if (t >= next_rate_update_t_) {
+            flush_count(t);
+        }
+        last_t_ = t;
+        ++n_pending_events_;
+    }
+
+    bool is_kept(int x, int y) {
+        const size_t index = (x >= 0 && y >= 0 && x < width_ && y < height_) ? static_cast<size_t>(y) * width_ + x
+                                                                             : accumulators_.size() - 1;
+        std::uint32_t &accumulator = accumulators_[index];
+        accumulator += keep_ratio_;
+        if (accumulator < KeepAll) {
+            return false;
+        }
+        accumulator -= KeepAll;
+        return true;
+    }
+
+    void flush_count(timestamp t);
+    void update(double input_rate);
+
+    const int width_, height_;
+    const SoftwareErcConfig config_;
+    RateEstimator rate_estimator_;
+    std::function<size_t()> backlog_probe_;
+
+    // Phase of the decimation of each pixel, plus one for the events out of the sensor
+    std::vector<std::uint32_t> accumulators_;
+    std::uint32_t keep_ratio_ = KeepAll;
+    double target_rate_;
+    double input_rate_ = 0;
+
+    timestamp first_t_            = -1;
+    timestamp last_t_             = -1;
+    timestamp next_rate_update_t_ = 0;
+    size_t n_pending_events_      = 0;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_CORE_SOFTWARE_ERC_ALGORITHM_H
@@ -13,25 +13,58 @@
 #define METAVISION_SDK_CORE_STREAM_LOGGER_ALGORITHM_H
 
 #include <boost/filesystem.hpp>
+#include <algorithm>
+#include <iterator>
 #include <string>
+#include <type_traits>
 #include <limits>
 #include <vector>
 #include <fstream>
 #include <iomanip>
+#include <atomic>
+#include <cstdio>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
 
 #include "metavision/sdk/base/utils/sdk_log.h"
 #include "metavision/sdk/base/utils/timestamp.h"
 #include "metavision/sdk/base/utils/generic_header.h"
+#include "metavision/sdk/base/utils/mapped_file_writer.h"
 #include "metavision/sdk/base/events/detail/event_traits.h"
 #include "metavision/sdk/base/utils/DAT_helper.h"
+#include "metavision/sdk/core/algorithms/detail/event_batch_kernels.h"
 
 namespace Metavision {
 
 /// @brief Logs the stream to a file
+///
+/// The events are encoded by the caller, and written to the file by a background thread: the events of a call to
+/// @ref process_events are appended to a buffer while the thread writes the previous ones, so that the caller does not
+/// wait for the disk.
+/// Alternatively, the files can be preallocated and mapped in memory (see @ref set_preallocation), the events being
+/// then encoded straight into the file.
 class StreamLoggerAlgorithm {
     static constexpr auto InvalidTimestamp = std::numeric_limits<std::int32_t>::max();
 
 public:
+    /// @brief Policy of synchronization of the files written with the disk
+    enum class FsyncPolicy {
+        /// The data is left in the cache of the OS
+        None,
+        /// Each file is synchronized when it is closed, or split
+        OnClose,
+        /// The data is synchronized each time the background thread writes it, and when the file is closed
+        EveryWrite
+    };
+
     /// @brief Builds a new StreamLogger object with given geometry
     /// @param filename Name of the file to write into. If the file already exists, its previous content will be
     /// lost.
@@ -39,8 +72,10 @@ public:
     /// @param height Height of the producer
     inline StreamLoggerAlgorithm(const std::string &filename, std::size_t width, std::size_t height);
 
-    /// @brief Default destructor
-    ~StreamLoggerAlgorithm() = default;
+    /// @brief Destructor
+    ///
+    /// Writes the pending data and closes the file
+    inline ~StreamLoggerAlgorithm();
 
     /// @brief Enables or disables data logging.
     /// @param state Flag to enable/disable the logger
@@ -57,6 +92,49 @@ public:
 
     inline std::int32_t get_split_time_seconds() const;
 
+    /// @brief Sets the size from which the file is split, in addition to the time split if any
+    ///
+    /// The file is split after the call to @ref process_events during which its size has reached @p split_size_bytes,
+    /// so that the files are a little larger than this size.
+    /// @param split_size_bytes Size of a file, in bytes, or 0 to disable the split on size
+    inline void set_split_size(std::uint64_t split_size_bytes);
+
+    /// @brief Gets the size from which the file is split, or 0 if the split on size is disabled
+    inline std::uint64_t get_split_size() const;
+
+    /// @brief Sets the policy of synchronization of the files with the disk, FsyncPolicy::None by default
+    /// @note This policy is not used by the files written through a memory mapping, see @ref set_preallocation
+    inline void set_fsync_policy(FsyncPolicy policy);
+
+    /// @brief Sets the maximum size of the data waiting to be written by the background thread
+    ///
+    /// When the data of a call to @ref process_events would exceed this size, the call waits until the background
+    /// thread takes the pending data, so that the memory used is bounded when the disk is slower than the events.
+    /// @param max_pending_bytes Maximum size of the pending data, in bytes, or 0 for no limit (default)
+    /// @note This size is not used by the files written through a memory mapping, see @ref set_preallocation
+    inline void set_max_pending_size(std::uint64_t max_pending_bytes);
+
+    /// @brief Gets the maximum size of the data waiting to be written, or 0 if it is not limited
+    inline std::uint64_t get_max_pending_size() const;
+
+    /// @brief Writes the files through a memory mapping of their preallocated space, see @ref MappedFileWriter
+    ///
+    /// Each file is allocated with the capacity of @p config when opened, so that it is not fragmented on long
+    /// recordings, and the events are encoded straight into its mapping, without copy to an intermediate buffer nor
+    /// system call. The file is truncated to the size of its data when closed. The events that do not fit in the
+    /// capacity are dropped (see @ref get_n_dropped_bytes): use the split on size (see @ref set_split_size) with a
+    /// lower size to go on with the next file instead.
+    /// This suits recordings of known maximum duration, the files are then opened by the caller of @ref enable or
+    /// @ref process_events instead of the background thread. The setting applies to the files opened afterwards.
+    /// @param config Configuration of the files, whose capacity is 0 by default to disable this mode
+    inline void set_preallocation(const MappedFileWriterConfig &config);
+
+    /// @brief Gets the number of bytes of events dropped because the capacity of the preallocated files was reached
+    inline std::uint64_t get_n_dropped_bytes() const;
+
+    /// @brief Waits until the events processed so far are written to the file
+    inline void flush();
+
     /// @brief Changes the destination file of the logger.
     /// @param filename Name of the file to write into.
     /// @param reset_ts If we are currently recording,
@@ -93,6 +171,8 @@ public:
     }
 
     /// @brief Closes the streaming.
+    ///
+    /// Waits until the events processed so far are written, then closes the file.
     inline void close();
 
 protected:
@@ -104,18 +184,75 @@ protected:
     /// @note If the system is working in split mode, it returns the file used in each iteration
     inline std::string get_filename() const;
 
-    /// @brief Splits the current file, if the timestamp reach the timeout
+    /// @brief Splits the current file, if the timestamp reach the timeout or the file reach the split size
     /// @param ts Current timestamp
     inline void split_file(timestamp ts);
 
+    /// @brief Returns true if the file is split on time or size
+    inline bool is_split_enabled() const;
+
+    /// @brief Pushes data to be written by the background thread
+    inline void push_data(const std::uint8_t *data, std::size_t size);
+
+    /// @brief Encodes the events from the initial timestamp as DAT records
+    /// @return Number of bytes written in @p buf
+    template<class InputIterator>
+    inline std::size_t encode_events(InputIterator first, InputIterator last, std::uint8_t *buf, std::false_type);
+
+    /// @brief Encodes contiguous events with the layout of Event2d as DAT records, in batches
+    /// @return Number of bytes written in @p buf
+    template<class InputIterator>
+    inline std::size_t encode_events(InputIterator first, InputIterator last, std::uint8_t *buf, std::true_type);
+
+    /// @brief Makes the background thread close the current file, and write the next data in another one
+    /// @param filename Name of the file to open, or empty to only close the current one
+    /// @param file File already opened, used instead of opening @p filename
+    inline void push_file_switch(const std::string &filename, std::FILE *file = nullptr);
+
+    /// @brief Writes data to the current file, through its mapping if preallocated or by the background thread
+    inline void write_data(const std::uint8_t *data, std::size_t size);
+
+    /// @brief Opens a preallocated file, see @ref set_preallocation
+    /// @return false if the file could not be opened, preallocated or mapped
+    inline bool open_mapped_file(const std::string &filename);
+
+    /// @brief Closes the current preallocated file if any
+    inline void close_mapped_file();
+
 protected:
+    // Data to be written by the background thread, and the files to write it to
+    struct PendingWrites {
+        struct FileSwitch {
+            std::size_t offset; // position in data from which the file is used
+            std::string filename;
+            std::FILE *file;
+        };
+
+        std::vector<std::uint8_t> data;
+        std::vector<FileSwitch> switches;
+
+        bool empty() const {
+            return data.empty() && switches.empty();
+        }
+
+        void clear() {
+            data.clear();
+            switches.clear();
+        }
+    };
+
+    inline void run_writer();
+    inline void write(const PendingWrites &writes);
+    inline void write_to_file(const std::uint8_t *data, std::size_t size);
+    inline void close_file();
+    inline void sync_file();
+
     std::size_t width_{0};
     std::size_t height_{0};
     std::size_t split_counter_{0};
     std::string filename_{};
     std::string filename_base_{};
     std::string filename_ext_{};
-    std::ofstream output_{};
     bool enable_{false};
     bool header_written_{false};
     std::int32_t split_timestamp_secs_{InvalidTimestamp};
@@ -123,12 +260,43 @@ protected:
     timestamp initial_timestamp_{0};
     timestamp last_timestamp_{0};
     std::vector<std::uint8_t> buffer_{};
+    std::uint64_t split_size_bytes_{0};
+    std::uint64_t file_size_{0};
+
+    // Preallocated files, used instead of the background writing when the capacity is not null
+    MappedFileWriterConfig mapped_config_{};
+    std::unique_ptr<MappedFileWriter> mapped_file_;
+    bool use_mapping_{false}; // whether the current file is preallocated, mapped_file_ being null if it failed
+    std::uint64_t n_dropped_bytes_{0};
+
+    // Background writing, the caller fills front_ while the writer thread writes back_
+    PendingWrites front_{};
+    PendingWrites back_{};
+    std::uint64_t max_pending_bytes_{0};
+    bool writing_{false};
+    bool stop_{false};
+    std::mutex mutex_;
+    std::condition_variable data_cond_;
+    std::condition_variable written_cond_; // notified when the pending data is taken, then when it is written
+    std::FILE *file_{nullptr}; // used by the writer thread only
+    std::atomic<FsyncPolicy> fsync_policy_{FsyncPolicy::None};
+    std::thread writer_;
 };
 
 inline StreamLoggerAlgorithm::StreamLoggerAlgorithm(const std::string &filename, std::size_t width,
                                                     std::size_t height) :
     width_(width), height_(height) {
     set_filename(filename);
+    writer_ = std::thread([this] { run_writer(); });
+}
+
+inline StreamLoggerAlgorithm::~StreamLoggerAlgorithm() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    data_cond_.notify_one();
+    writer_.join();
 }
 
 inline void StreamLoggerAlgorithm::enable(bool state, bool reset_ts, std::int32_t split_time_seconds) {
@@ -149,20 +317,30 @@ inline void StreamLoggerAlgorithm::enable(bool state, bool reset_ts, std::int32_
     enable_            = state;
     initial_timestamp_ = 0;
     if (enable_) {
-        if (output_.is_open()) {
-            output_.close();
+        // The previous file, that may be the same, must be closed before opening this one
+        push_file_switch("");
+        flush();
+        close_mapped_file();
+        std::FILE *file = nullptr;
+        use_mapping_    = mapped_config_.capacity_ != 0;
+        if (!use_mapping_) {
+            file = std::fopen(get_filename().c_str(), "wb");
         }
-
-        output_.open(get_filename(), std::ios::binary);
-        if (output_.fail()) {
+        if (!file && !open_mapped_file(get_filename())) {
+            enable_ = false;
             throw std::runtime_error(
                 "Could not open file '" + get_filename() +
                 " to record. Make sure it is a valid filename and that you have permissions to write it.");
         }
+        if (file) {
+            push_file_switch(get_filename(), file);
+        }
         header_written_    = false;
+        file_size_         = 0;
         initial_timestamp_ = reset_ts ? last_timestamp_ : 0;
-    } else if (output_.is_open()) {
-        output_.close();
+    } else {
+        push_file_switch("");
+        close_mapped_file();
     }
 }
 
@@ -174,6 +352,42 @@ std::int32_t StreamLoggerAlgorithm::get_split_time_seconds() const {
     return split_timestamp_secs_;
 }
 
+inline void StreamLoggerAlgorithm::set_split_size(std::uint64_t split_size_bytes) {
+    if (!is_split_enabled()) {
+        split_counter_ = 0;
+    }
+    split_size_bytes_ = split_size_bytes;
+}
+
+inline std::uint64_t StreamLoggerAlgorithm::get_split_size() const {
+    return split_size_bytes_;
+}
+
+inline void StreamLoggerAlgorithm::set_fsync_policy(FsyncPolicy policy) {
+    fsync_policy_ = policy;
+}
+
+inline void StreamLoggerAlgorithm::set_max_pending_size(std::uint64_t max_pending_bytes) {
+    max_pending_bytes_ = max_pending_bytes;
+}
+
+inline std::uint64_t StreamLoggerAlgorithm::get_max_pending_size() const {
+    return max_pending_bytes_;
+}
+
+inline void StreamLoggerAlgorithm::set_preallocation(const MappedFileWriterConfig &config) {
+    mapped_config_ = config;
+}
+
+inline std::uint64_t StreamLoggerAlgorithm::get_n_dropped_bytes() const {
+    return n_dropped_bytes_ + (mapped_file_ ? mapped_file_->get_n_dropped_bytes() : 0);
+}
+
+inline void StreamLoggerAlgorithm::flush() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    written_cond_.wait(lock, [this] { return front_.empty() && !writing_; });
+}
+
 inline void StreamLoggerAlgorithm::change_destination(const std::string &filename, bool reset_ts) {
     const auto previous_state = enable_;
     if (enable_) {
@@ -186,18 +400,21 @@ inline void StreamLoggerAlgorithm::change_destination(const std::string &filenam
 }
 
 inline void StreamLoggerAlgorithm::close() {
-    output_.close();
+    push_file_switch("");
+    flush();
+    close_mapped_file();
 }
 
 inline void StreamLoggerAlgorithm::set_filename(const std::string &filename) {
+    // The split files are written next to the file
     boost::filesystem::path path(filename);
     filename_      = filename;
-    filename_base_ = path.stem().string();
+    filename_base_ = (path.parent_path() / path.stem()).string();
     filename_ext_  = path.extension().string();
 }
 
 inline std::string StreamLoggerAlgorithm::get_filename() const {
-    if (split_timestamp_us_ != InvalidTimestamp) {
+    if (is_split_enabled()) {
         std::ostringstream split_filename;
         split_filename << filename_base_ << "_" << std::setw(4) << std::setfill('0') << std::to_string(split_counter_)
                        << filename_ext_;
@@ -208,51 +425,222 @@ inline std::string StreamLoggerAlgorithm::get_filename() const {
 }
 
 void StreamLoggerAlgorithm::split_file(timestamp ts) {
-    if (split_timestamp_us_ != InvalidTimestamp && (ts - initial_timestamp_) >= split_timestamp_us_) {
+    const bool split_on_time =
+        split_timestamp_us_ != InvalidTimestamp && (ts - initial_timestamp_) >= split_timestamp_us_;
+    const bool split_on_size = split_size_bytes_ != 0 && file_size_ >= split_size_bytes_;
+    if (split_on_time || split_on_size) {
         ++split_counter_;
         last_timestamp_ = ts;
-        //        enable(false, true, split_timestamp_secs_);
-        //        enable(true, true, split_timestamp_secs_);
-        if (output_.is_open()) {
-            output_.close();
+        close_mapped_file();
+        use_mapping_ = mapped_config_.capacity_ != 0;
+        if (use_mapping_) {
+            push_file_switch("");
+            if (!open_mapped_file(get_filename())) {
+                MV_SDK_LOG_ERROR() << "Could not open file" << get_filename() << "to record, its events are lost";
+            }
+        } else {
+            // The next file is opened by the writer thread, so that the caller does not wait for it
+            push_file_switch(get_filename());
         }
-
-        output_.open(get_filename(), std::ios::binary);
         header_written_    = false;
+        file_size_         = 0;
         initial_timestamp_ = last_timestamp_;
     }
 }
 
+inline bool StreamLoggerAlgorithm::is_split_enabled() const {
+    return split_timestamp_us_ != InvalidTimestamp || split_size_bytes_ != 0;
+}
+
+inline void StreamLoggerAlgorithm::push_data(const std::uint8_t *data, std::size_t size) {
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (max_pending_bytes_ != 0) {
+            // Data larger than the maximum size is still pushed once the previous one has been taken
+            written_cond_.wait(lock, [this, size] {
+                return front_.data.empty() || front_.data.size() + size <= max_pending_bytes_;
+            });
+        }
+        front_.data.insert(front_.data.end(), data, data + size);
+    }
+    data_cond_.notify_one();
+    file_size_ += size;
+}
+
+inline void StreamLoggerAlgorithm::push_file_switch(const std::string &filename, std::FILE *file) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        front_.switches.push_back({front_.data.size(), filename, file});
+    }
+    data_cond_.notify_one();
+}
+
+inline void StreamLoggerAlgorithm::write_data(const std::uint8_t *data, std::size_t size) {
+    if (!use_mapping_) {
+        push_data(data, size);
+    } else if (mapped_file_) {
+        mapped_file_->write(data, size);
+        file_size_ += size;
+    }
+}
+
+inline bool StreamLoggerAlgorithm::open_mapped_file(const std::string &filename) {
+    if (mapped_config_.capacity_ == 0) {
+        return false;
+    }
+    try {
+        mapped_file_.reset(new MappedFileWriter(filename, mapped_config_));
+    } catch (const std::exception &) { return false; }
+    return true;
+}
+
+inline void StreamLoggerAlgorithm::close_mapped_file() {
+    if (mapped_file_) {
+        mapped_file_->close();
+        n_dropped_bytes_ += mapped_file_->get_n_dropped_bytes();
+        mapped_file_.reset();
+    }
+}
+
+inline void StreamLoggerAlgorithm::run_writer() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        data_cond_.wait(lock, [this] { return stop_ || !front_.empty(); });
+        if (front_.empty()) {
+            break;
+        }
+        std::swap(front_, back_);
+        writing_ = true;
+        lock.unlock();
+        written_cond_.notify_all();
+
+        write(back_);
+        back_.clear();
+
+        lock.lock();
+        writing_ = false;
+        written_cond_.notify_all();
+    }
+    close_file();
+}
+
+inline void StreamLoggerAlgorithm::write(const PendingWrites &writes) {
+    std::size_t offset = 0;
+    for (const auto &file_switch : writes.switches) {
+        write_to_file(writes.data.data() + offset, file_switch.offset - offset);
+        offset = file_switch.offset;
+        close_file();
+        file_ = file_switch.file;
+        if (!file_ && !file_switch.filename.empty()) {
+            file_ = std::fopen(file_switch.filename.c_str(), "wb");
+            if (!file_) {
+                MV_SDK_LOG_ERROR() << "Could not open file" << file_switch.filename << "to record, its events are lost";
+            }
+        }
+    }
+    write_to_file(writes.data.data() + offset, writes.data.size() - offset);
+    if (file_ && fsync_policy_ == FsyncPolicy::EveryWrite) {
+        sync_file();
+    }
+}
+
+inline void StreamLoggerAlgorithm::write_to_file(const std::uint8_t *data, std::size_t size) {
+    if (file_ && size > 0) {
+        std::fwrite(data, 1, size, file_);
+    }
+}
+
+inline void StreamLoggerAlgorithm::close_file() {
+    if (!file_) {
+        return;
+    }
+    if (fsync_policy_ != FsyncPolicy::None) {
+        sync_file();
+    }
+    std::fclose(file_);
+    file_ = nullptr;
+}
+
+inline void StreamLoggerAlgorithm::sync_file() {
+    std::fflush(file_);
+#ifdef _WIN32
+    _commit(_fileno(file_));
+#else
+    fsync(fileno(file_));
+#endif
+}
+
 template<class InputIterator>
 inline void StreamLoggerAlgorithm::process_events(InputIterator first, InputIterator last, timestamp ts) {
     using value_type            = typename std::iterator_traits<InputIterator>::value_type;
     constexpr auto RawEventSize = get_event_size<value_type>();
     const auto size             = static_cast<std::size_t>(std::distance(first, last));
 
-    if (size > 0 && enable_ && output_.is_open()) {
+    if (size > 0 && enable_) {
         if (!header_written_) {
             GenericHeader::HeaderMap header{{"Width", std::to_string(width_)}, {"Height", std::to_string(height_)}};
-            Metavision::write_DAT_header<value_type>(output_, header);
+            std::ostringstream header_stream;
+            Metavision::write_DAT_header<value_type>(header_stream, header);
+            const std::string header_data = header_stream.str();
+            write_data(reinterpret_cast<const std::uint8_t *>(header_data.data()), header_data.size());
             header_written_ = true;
         }
 
-        buffer_.resize(size * RawEventSize);
-        auto *buf         = buffer_.data();
-        auto byte_written = 0ul;
-        for (; first != last; ++first) {
-            if (first->t >= initial_timestamp_) {
-                first->write_event(buf, initial_timestamp_);
-                buf += RawEventSize;
-                byte_written += RawEventSize;
-                last_timestamp_ = first->t;
+        using is_contiguous = std::integral_constant<
+            bool, !std::is_void<typename detail::event_array_type<InputIterator>::type>::value>;
+        if (!use_mapping_) {
+            buffer_.resize(size * RawEventSize);
+            const auto byte_written = encode_events(first, last, buffer_.data(), is_contiguous{});
+            push_data(buffer_.data(), byte_written);
+        } else if (mapped_file_) {
+            // The events are encoded in place, in the mapping of the file
+            std::uint8_t *buf = mapped_file_->get_write_pointer(size * RawEventSize);
+            if (buf) {
+                const auto byte_written = encode_events(first, last, buf, is_contiguous{});
+                mapped_file_->commit(byte_written);
+                file_size_ += byte_written;
+            } else {
+                mapped_file_->drop(size * RawEventSize);
             }
         }
-        output_.write((const char *)buffer_.data(), byte_written);
         split_file(ts);
     }
     last_timestamp_ = ts;
 }
 
+template<class InputIterator>
+inline std::size_t StreamLoggerAlgorithm::encode_events(InputIterator first, InputIterator last, std::uint8_t *buf,
+                                                        std::false_type) {
+    using value_type            = typename std::iterator_traits<InputIterator>::value_type;
+    constexpr auto RawEventSize = get_event_size<value_type>();
+    std::size_t byte_written    = 0;
+    for (; first != last; ++first) {
+        if (first->t >= initial_timestamp_) {
+            first->write_event(buf, initial_timestamp_);
+            buf += RawEventSize;
+            byte_written += RawEventSize;
+            last_timestamp_ = first->t;
+        }
+    }
+    return byte_written;
+}
+
+template<class InputIterator>
+inline std::size_t StreamLoggerAlgorithm::encode_events(InputIterator first, InputIterator last, std::uint8_t *buf,
+                                                        std::true_type) {
+    // The events before the initial timestamp are dropped one by one, which only happens for the first buffers
+    const timestamp initial_timestamp = initial_timestamp_;
+    if (!std::all_of(first, last, [initial_timestamp](const auto &ev) { return ev.t >= initial_timestamp; })) {
+        return encode_events(first, last, buf, std::false_type{});
+    }
+    using value_type            = typename std::iterator_traits<InputIterator>::value_type;
+    constexpr auto RawEventSize = get_event_size<value_type>();
+    const auto n                = static_cast<std::size_t>(std::distance(first, last));
+    detail::write_dat_events(&*first, n, initial_timestamp_, buf);
+    last_timestamp_ = std::prev(last)->t;
+    return n * RawEventSize;
+}
+
 } // namespace Metavision
 
 #endif // METAVISION_SDK_CORE_STREAM_LOGGER_ALGORITHM_H
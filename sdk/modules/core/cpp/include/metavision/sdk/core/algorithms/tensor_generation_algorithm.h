@@ -0,0 +1,137 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_TENSOR_GENERATION_ALGORITHM_H
+#define METAVISION_SDK_CORE_TENSOR_GENERATION_ALGORITHM_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "metavision/sdk/base/utils/timestamp.h"
+
+namespace Metavision {
+
+/// @brief Class generating the tensors fed to neural networks from events: voxel grids, histograms or time surfaces
+///
+/// The events of a time interval [ts_begin, ts_end[ are written into a contiguous tensor provided by the caller, of
+/// 32 bits or 16 bits (half precision) floating point values, with its channels first (CHW) or last (HWC). Each tensor
+/// describes one element of a batch (NCHW or NHWC), the elements of a batch being generated one after the other into
+/// the same buffer.
+///
+/// The tensor channels depend on its type:
+/// - @ref Type::VoxelGrid: @p num_bins temporal bins, each event adding its polarity (+1 or -1) to the 2 bins nearest
+///   to its timestamp, with weights linear in the distance to them (bilinear temporal binning)
+/// - @ref Type::Histogram: the number of negative events, then the number of positive events
+/// - @ref Type::TimeSurface: the time of the last negative event, then of the last positive event, normalized in
+///   ]0, 1] over the time interval, 0 where there was no event
+///
+/// The events are first sorted by stripes of rows, then the stripes are filled in parallel, the temporal binning being
+/// computed on contiguous arrays which the compiler vectorizes.
+class TensorGenerationAlgorithm {
+public:
+    /// @brief Type of tensor generated
+    enum class Type { VoxelGrid, Histogram, TimeSurface };
+
+    /// @brief Order of the dimensions of the tensor
+    enum class Layout {
+        CHW, ///< Channels first, as in NCHW
+        HWC  ///< Channels last, as in NHWC
+    };
+
+    /// @brief Number of rows of a stripe, the unit of work of the threads
+    static constexpr int RowsPerStripe = 8;
+
+    /// @brief Constructor
+    /// @param width Sensor's width (in pixels)
+    /// @param height Sensor's height (in pixels)
+    /// @param type Type of the tensor
+    /// @param num_bins Number of temporal bins of a voxel grid, not used by the other types
+    /// @param layout Order of the dimensions of the tensor
+    /// @throw std::invalid_argument if the dimensions or the number of bins are not positive
+    TensorGenerationAlgorithm(int width, int height, Type type, int num_bins = 5, Layout layout = Layout::CHW);
+
+    /// @brief Gets the number of channels of the tensor
+    int get_num_channels() const;
+
+    /// @brief Gets the dimensions of the tensor, in the order of its layout
+    std::array<size_t, 3> get_shape() const;
+
+    /// @brief Gets the number of values of the tensor
+    size_t get_tensor_size() const;
+
+    /// @brief Gets the layout of the tensor
+    Layout get_layout() const;
+
+    /// @brief Gets the type of the tensor
+    Type get_type() const;
+
+    /// @brief Generates the tensor of the events of a time interval
+    ///
+    /// The events out of the interval or of the sensor are ignored.
+    /// @tparam InputIt Forward iterator on @ref EventCD or equivalent
+    /// @param it_begin Iterator to the first event
+    /// @param it_end Iterator to the past-the-end event
+    /// @param ts_begin Beginning of the time interval, included
+    /// @param ts_end End of the time interval, excluded
+    /// @param tensor Tensor overwritten, of @ref get_tensor_size values
+    /// @throw std::invalid_argument if @p ts_end is not after @p ts_begin
+    template<typename InputIt>
+    void generate(InputIt it_begin, InputIt it_end, timestamp ts_begin, timestamp ts_end, float *tensor);
+
+    /// @brief Generates the tensor of the events of a time interval, in half precision
+    ///
+    /// Same as the version writing 32 bits values, the values being then converted to IEEE 754 half precision floating
+    /// point values, with F16C or NEON instructions when available.
+    /// @param tensor Tensor overwritten, of @ref get_tensor_size values, holding the bits of half precision values
+    template<typename InputIt>
+    void generate(InputIt it_begin, InputIt it_end, timestamp ts_begin, timestamp ts_end, std::uint16_t *tensor);
+
+    /// @brief Converts 32 bits floating point values to half precision, rounding to the nearest even value
+    /// @param in Values to convert
+    /// @param out Bits of the half precision values
+    /// @param n Number of values
+    static void convert_to_half(const float *in, std::uint16_t *out, size_t n);
+
+private:
+    template<typename InputIt>
+    void sort_events(InputIt it_begin, InputIt it_end, timestamp ts_begin, timestamp ts_end);
+    void fill(float *tensor, std::uint16_t *half_tensor);
+    void fill_stripe(int stripe, float *tensor, std::uint16_t *half_tensor);
+
+    const int width_, height_;
+    const Type type_;
+    const int num_bins_;
+    const Layout layout_;
+    const int num_channels_;
+    const int num_stripes_;
+    size_t channel_stride_, pixel_stride_; ///< Distance between 2 channels and 2 pixels in the tensor
+
+    // Events of the interval sorted by stripe, as a structure of arrays
+    std::vector<size_t> stripe_offsets_, stripe_cursors_;
+    std::vector<std::uint16_t> xs_, ys_;
+    std::vector<std::uint8_t> ps_;
+    std::vector<float> ts_; ///< Times normalized in [0, 1] over the interval
+    float ts_step_ = 0.f;   ///< Normalized duration of 1 us
+
+    // Lower bin and weight of the upper bin of the events of a voxel grid
+    std::vector<int> lower_bins_;
+    std::vector<float> upper_weights_;
+
+    std::vector<float> float_tensor_; ///< Tensor of 32 bits values, when generating a tensor in half precision
+};
+
+} // namespace Metavision
+
+#include "metavision/sdk/core/algorithms/detail/tensor_generation_algorithm_impl.h"
+
+#endif // METAVISION_SDK_CORE_TENSOR_GENERATION_ALGORITHM_H
@@ -0,0 +1,192 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_TIME_RANGE_FILTER_ALGORITHM_H
+#define METAVISION_SDK_CORE_TIME_RANGE_FILTER_ALGORITHM_H
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+#include "metavision/sdk/core/algorithms/detail/internal_algorithms.h"
+#include "metavision/sdk/core/algorithms/detail/event_batch_kernels.h"
+#include "metavision/sdk/base/events/event_cd_buffer_soa.h"
+#include "metavision/sdk/base/utils/timestamp.h"
+
+namespace Metavision {
+
+/// @brief Class filter that only propagates the events whose timestamps are in a range [t_begin, t_end)
+///
+/// The events of a buffer sorted by timestamps, as the ones decoded from a camera or a file, are in range between two
+/// positions found by binary search: @ref find_range gives them without copying any event, and @ref process_events
+/// copies them at once. The events of unsorted buffers are compared one by one, with SIMD instructions when available.
+/// This is the building block to cut a stream in slices or around triggers.
+class TimeRangeFilterAlgorithm {
+public:
+    /// @brief Builds a new TimeRangeFilterAlgorithm object
+    /// @param t_begin Beginning of the range, the events with this timestamp being kept
+    /// @param t_end End of the range, the events with this timestamp being filtered out
+    /// @param sorted_input If true, the input events are expected to be sorted by timestamps, and the range is found by
+    /// binary search. Otherwise, each event is compared to the range
+    /// @throw std::invalid_argument if @p t_end is before @p t_begin
+    inline TimeRangeFilterAlgorithm(timestamp t_begin, timestamp t_end, bool sorted_input = true);
+
+    /// @brief Default destructor
+    ~TimeRangeFilterAlgorithm() = default;
+
+    /// @brief Finds the events in range in a buffer sorted by timestamps, without copying them
+    /// @param first Beginning of the range of the input events
+    /// @param last End of the range of the input events
+    /// @return The range of the input events whose timestamps are in [t_begin, t_end)
+    /// @warning The events must be sorted by timestamps, whatever @ref is_sorted_input
+    template<class InputIt>
+    inline std::pair<InputIt, InputIt> find_range(InputIt first, InputIt last) const;
+
+    /// @brief Applies the filter to the given input buffer storing the result in the output buffer
+    /// @param first Beginning of the range of the input elements
+    /// @param last End of the range of the input elements
+    /// @param d_first Beginning of the destination range
+    /// @return Iterator pointing to the last + 1 event added in the output
+    /// @note Sorted events are copied from the range found by binary search. Unsorted contiguous events (arrays or
+    /// vectors) are processed in batches, with SIMD instructions when available
+    template<class InputIt, class OutputIt>
+    inline OutputIt process_events(InputIt first, InputIt last, OutputIt d_first) const;
+
+    /// @brief Applies the filter to a buffer of events stored as a structure of arrays
+    /// @param input Buffer of the input events
+    /// @param output Buffer of the events that passed the filter. It can be the same buffer as @p input
+    inline void process_events(const EventCDBufferSoA &input, EventCDBufferSoA &output) const;
+
+    /// @brief Basic operator to check if an event is accepted
+    /// @param ev Event to be tested
+    template<typename EventType>
+    inline bool operator()(const EventType &ev) const;
+
+    /// @brief Sets the range of timestamps of the events kept
+    /// @param t_begin Beginning of the range, the events with this timestamp being kept
+    /// @param t_end End of the range, the events with this timestamp being filtered out
+    /// @throw std::invalid_argument if @p t_end is before @p t_begin
+    inline void set_range(timestamp t_begin, timestamp t_end);
+
+    /// @brief Returns the beginning of the range, included
+    inline timestamp t_begin() const;
+
+    /// @brief Returns the end of the range, excluded
+    inline timestamp t_end() const;
+
+    /// @brief Sets whether the input events are sorted by timestamps
+    /// @param sorted_input If true, the range is found by binary search. Otherwise, each event is compared to it
+    inline void set_sorted_input(bool sorted_input);
+
+    /// @brief Returns true if the input events are expected to be sorted by timestamps
+    inline bool is_sorted_input() const;
+
+private:
+    timestamp t_begin_;
+    timestamp t_end_;
+    bool sorted_input_;
+};
+
+inline TimeRangeFilterAlgorithm::TimeRangeFilterAlgorithm(timestamp t_begin, timestamp t_end, bool sorted_input) :
+    sorted_input_(sorted_input) {
+    set_range(t_begin, t_end);
+}
+
+template<class InputIt>
+inline std::pair<InputIt, InputIt> TimeRangeFilterAlgorithm::find_range(InputIt first, InputIt last) const {
+    using EventType = typename std::iterator_traits<InputIt>::value_type;
+    auto is_before  = [](const EventType &ev, timestamp t) { return ev.t < t; };
+    first           = std::lower_bound(first, last, t_begin_, is_before);
+    return {first, std::lower_bound(first, last, t_end_, is_before)};
+}
+
+template<class InputIt, class OutputIt>
+inline OutputIt TimeRangeFilterAlgorithm::process_events(InputIt first, InputIt last, OutputIt d_first) const {
+    if (sorted_input_) {
+        const auto range = find_range(first, last);
+        return std::copy(range.first, range.second, d_first);
+    }
+    return Metavision::detail::dispatch_batch_kernel(
+        first, last, d_first,
+        [this](const auto *in, auto *out, size_t n) {
+            return detail::filter_time_range_events(in, out, n, t_begin_, t_end_);
+        },
+        [this](InputIt first, InputIt last, OutputIt d_first) {
+            return Metavision::detail::insert_if(first, last, d_first, std::cref(*this));
+        });
+}
+
+inline void TimeRangeFilterAlgorithm::process_events(const EventCDBufferSoA &input, EventCDBufferSoA &output) const {
+    const size_t n        = input.size();
+    const timestamp *in_t = input.t();
+    size_t begin = 0, end = n;
+    if (sorted_input_) {
+        begin = std::lower_bound(in_t, in_t + n, t_begin_) - in_t;
+        end   = std::lower_bound(in_t + begin, in_t + n, t_end_) - in_t;
+        if (&output == &input && begin == 0) {
+            output.resize(end);
+            return;
+        }
+    }
+
+    const unsigned short *in_x = input.x(), *in_y = input.y();
+    const short *in_p          = input.p();
+    output.resize(n);
+    unsigned short *out_x = output.x(), *out_y = output.y();
+    short *out_p          = output.p();
+    timestamp *out_t      = output.t();
+
+    // Branchless compaction, see RoiFilterAlgorithm. The range of sorted events is kept as a whole
+    size_t n_out = 0;
+    for (size_t i = begin; i < end; ++i) {
+        out_x[n_out] = in_x[i];
+        out_y[n_out] = in_y[i];
+        out_p[n_out] = in_p[i];
+        out_t[n_out] = in_t[i];
+        n_out += sorted_input_ || ((in_t[i] >= t_begin_) & (in_t[i] < t_end_));
+    }
+    output.resize(n_out);
+}
+
+template<typename EventType>
+inline bool TimeRangeFilterAlgorithm::operator()(const EventType &ev) const {
+    return ev.t >= t_begin_ && ev.t < t_end_;
+}
+
+inline void TimeRangeFilterAlgorithm::set_range(timestamp t_begin, timestamp t_end) {
+    if (t_end < t_begin) {
+        throw std::invalid_argument("The end of the time range must not be before its beginning.");
+    }
+    t_begin_ = t_begin;
+    t_end_   = t_end;
+}
+
+inline timestamp TimeRangeFilterAlgorithm::t_begin() const {
+    return t_begin_;
+}
+
+inline timestamp TimeRangeFilterAlgorithm::t_end() const {
+    return t_end_;
+}
+
+inline void TimeRangeFilterAlgorithm::set_sorted_input(bool sorted_input) {
+    sorted_input_ = sorted_input;
+}
+
+inline bool TimeRangeFilterAlgorithm::is_sorted_input() const {
+    return sorted_input_;
+}
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_CORE_TIME_RANGE_FILTER_ALGORITHM_H
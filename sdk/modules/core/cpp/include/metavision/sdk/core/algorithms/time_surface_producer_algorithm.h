@@ -14,8 +14,10 @@
 
 #include <functional>
 #include <type_traits>
+#include <vector>
 
 #include "metavision/sdk/core/algorithms/async_algorithm.h"
+#include "metavision/sdk/core/utils/compact_mostrecent_timestamp_buffer.h"
 #include "metavision/sdk/core/utils/mostrecent_timestamp_buffer.h"
 
 namespace Metavision {
@@ -34,18 +36,28 @@ namespace Metavision {
 /// @tparam CHANNELS Number of channels to use for producing the time surface. Only two values are possible for now: 1
 /// or 2. When a 1-channel time surface is used, events with different polarities are stored all together while they are
 /// stored separately when using a 2-channels time surface.
-template<int CHANNELS = 1>
-class TimeSurfaceProducerAlgorithm : public AsyncAlgorithm<TimeSurfaceProducerAlgorithm<CHANNELS>> {
+/// @tparam TimeSurface Type of the time surface: @ref MostRecentTimestampBuffer, or
+/// @ref CompactMostRecentTimestampBuffer and @ref CompactMostRecentTimestampBuffer16 to store the timestamps as
+/// offsets, which reduces the memory bandwidth used to update and read the time surface.
+template<int CHANNELS = 1, typename TimeSurface = MostRecentTimestampBuffer>
+class TimeSurfaceProducerAlgorithm : public AsyncAlgorithm<TimeSurfaceProducerAlgorithm<CHANNELS, TimeSurface>> {
 public:
     static_assert(CHANNELS == 1 || CHANNELS == 2, "The timesurface producer is only compatible with 1 or 2 channels");
 
-    using OutputCb = std::function<void(timestamp, const MostRecentTimestampBuffer &)>;
+    using OutputCb = std::function<void(timestamp, const TimeSurface &)>;
 
     /// @brief Constructs a new time surface producer
     /// @param width Sensor's width
     /// @param height Sensor's height
     TimeSurfaceProducerAlgorithm(int width, int height);
 
+    /// @brief Constructs a new time surface producer updating a given time surface
+    ///
+    /// This allows using a compact time surface whose resolution is coarser than 1us.
+    /// @param time_surface Initial time surface, whose size is the sensor's one
+    /// @throw std::invalid_argument if the number of channels of the time surface is not @p CHANNELS
+    explicit TimeSurfaceProducerAlgorithm(const TimeSurface &time_surface);
+
     /// @brief Sets a callback to retrieve the produced time surface
     ///
     /// A constant reference of the internal time surface is passed to the callback, allowing to process
@@ -54,8 +66,34 @@ public:
     /// @param cb The callback called when the time surface is ready
     void set_output_callback(const OutputCb &cb);
 
+    /// @brief Sets the number of threads updating the time surface
+    ///
+    /// With several threads, the events of a buffer are sharded by bands of rows of the time surface, each band being
+    /// updated by a single thread in the order of the events. This way, the threads write to disjoint and contiguous
+    /// parts of the memory, and the time surface is the same as with a single thread.
+    /// @param n_threads Number of threads, 1 (the default) to update the time surface in the calling thread
+    void set_n_threads(int n_threads);
+
+    /// @brief Gets the number of threads updating the time surface
+    int get_n_threads() const;
+
+    /// @brief Enables or disables the double buffering of the time surface
+    ///
+    /// With double buffering, the time surface passed to the output callback is not updated by the producer until the
+    /// next call of the callback, so that it can be read by another thread, or kept by the user without copy, while
+    /// the next events are processed into a second time surface. When the time surfaces are swapped, the second one
+    /// is brought up to date by writing again the values of the events processed since the previous swap, or by a copy
+    /// when there were more of them than cells.
+    /// @param enable True to enable the double buffering, false to disable it
+    void set_double_buffering(bool enable);
+
+    /// @brief Returns true if the double buffering of the time surface is enabled
+    bool is_double_buffering() const;
+
 private:
-    friend class AsyncAlgorithm<TimeSurfaceProducerAlgorithm<CHANNELS>>;
+    friend class AsyncAlgorithm<TimeSurfaceProducerAlgorithm<CHANNELS, TimeSurface>>;
+
+    using CellType = std::remove_pointer_t<decltype(std::declval<TimeSurface &>().ptr())>;
 
     /// @brief Updates the time surface with the input events
     /// @tparam InputIt Type of the iterators pointing to the events
@@ -67,8 +105,23 @@ private:
     /// @brief Calls the output callback when the time surface is ready (the output condition is satisfied)
     void process_async(const timestamp processing_ts, const size_t n_processed_events);
 
-    MostRecentTimestampBuffer time_surface_; ///< Time surface updated internally
-    OutputCb output_cb_;                     ///< Callback called when the time surface is ready
+    /// @brief Value written by an event with the position of its cell in the time surface, sorted by band
+    struct ShardedEvent {
+        size_t cell;
+        CellType value;
+    };
+
+    /// @brief Swaps the time surface updated with the one passed to the callback, and brings it up to date
+    void swap_time_surfaces();
+
+    TimeSurface time_surface_;                 ///< Time surface updated internally
+    OutputCb output_cb_;                       ///< Callback called when the time surface is ready
+    int n_threads_{1};                         ///< Number of threads updating the time surface
+    std::vector<ShardedEvent> sharded_events_; ///< Events sorted by band, when updated by several threads
+    std::vector<size_t> band_offsets_;         ///< Index of the first event of each band in sharded_events_
+    bool double_buffering_{false};             ///< Whether the time surface passed to the callback is a second one
+    TimeSurface output_time_surface_;          ///< Time surface passed to the callback, with double buffering
+    std::vector<ShardedEvent> pending_writes_; ///< Values written since the last swap, with double buffering
 };
 } // namespace Metavision
 
@@ -0,0 +1,134 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_CUDA_EVENTS_PROCESSOR_H
+#define METAVISION_SDK_CORE_CUDA_EVENTS_PROCESSOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <opencv2/core/mat.hpp>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/base/utils/timestamp.h"
+#include "metavision/sdk/core/cuda/dlpack.h"
+#include "metavision/sdk/core/utils/colors.h"
+
+namespace Metavision {
+
+/// @brief Class processing CD events on a CUDA device, the host only uploading them
+///
+/// The events are copied into page-locked (pinned) host buffers, then transferred asynchronously to the device on a
+/// CUDA stream of the processor, the next events being copied into another pinned buffer while the previous ones are
+/// transferred and processed. The device keeps:
+/// - a time surface, as a @ref MostRecentTimestampBuffer with 2 channels: the timestamp of the last negative event,
+///   then of the last positive event of each pixel, -1 where there was no event
+/// - a histogram: the number of negative events, then of positive events of each pixel, since its last reset
+/// - a BGR frame, colored like the ones of @ref PeriodicFrameGenerationAlgorithm from the time surface: each pixel has
+///   the color of the polarity of its last event if it is in the accumulation time, the background color otherwise
+///
+/// They stay on the device, and are exported as DLPack tensors so that frameworks like PyTorch consume them without
+/// going through the host memory. The frame can also be downloaded in a cv::Mat, to be displayed or encoded.
+///
+/// @note This class is only implemented when the SDK is compiled with CUDA support (COMPILE_CUDA option)
+class CudaEventsProcessor {
+public:
+    /// @brief Type of the callback called when a frame has been generated
+    ///
+    /// The frame, time surface and histogram can be exported or downloaded from the callback, the device being
+    /// synchronized by these functions.
+    using FrameCallback = std::function<void(timestamp ts)>;
+
+    /// @brief Constructor
+    /// @param width Sensor's width (in pixels)
+    /// @param height Sensor's height (in pixels)
+    /// @param device_id Index of the CUDA device
+    /// @param upload_capacity Number of events of each pinned buffer, the events being uploaded in chunks of this size
+    /// @throw std::invalid_argument if the dimensions or the capacity are not positive
+    /// @throw std::runtime_error if the device can not be used or the memory can not be allocated
+    CudaEventsProcessor(int width, int height, int device_id = 0, size_t upload_capacity = 1 << 20);
+
+    /// @brief Destructor, waiting for the pending transfers and kernels
+    ///
+    /// The memory of the tensors still exported is released when their consumers release them.
+    ~CudaEventsProcessor();
+
+    /// @brief Enables the periodic generation of frames, as @ref PeriodicFrameGenerationAlgorithm does
+    ///
+    /// The events processed are split at the timestamps of the frames, every 1/fps seconds, and the callback is called
+    /// after the frame of the events before its timestamp has been generated.
+    /// @param accumulation_time_us Time range of the events updating a frame (in us)
+    /// @param fps Number of frames per second, in the time of the events
+    /// @param cb Callback called after the generation of each frame
+    /// @throw std::invalid_argument if the accumulation time or the frame rate are not positive
+    void set_periodic_frame_generation(uint32_t accumulation_time_us, double fps, const FrameCallback &cb);
+
+    /// @brief Sets the colors of the frames from a palette
+    void set_color_palette(const ColorPalette &palette);
+
+    /// @brief Uploads and processes events, sorted by timestamp, updating the time surface and the histogram
+    ///
+    /// The function returns when the events have been copied into the pinned buffers, their transfer and processing
+    /// being asynchronous, unless frames are generated periodically.
+    /// @param begin First event to process
+    /// @param end End of the events to process
+    void process_events(const EventCD *begin, const EventCD *end);
+
+    /// @brief Generates the frame of the events processed, at a timestamp, from the time surface
+    /// @param ts Timestamp of the frame, the events processed being before it
+    /// @param accumulation_time_us Time range of the events updating the frame (in us), 0 for all the events
+    void generate_frame(timestamp ts, uint32_t accumulation_time_us);
+
+    /// @brief Resets the histogram, its counts starting again from 0
+    void reset_histogram();
+
+    /// @brief Resets the time surface, as if no event had been processed
+    void reset_time_surface();
+
+    /// @brief Waits for the pending transfers and kernels
+    void synchronize();
+
+    /// @brief Downloads the frame into a BGR image
+    /// @param frame Image, allocated if needed
+    void download_frame(cv::Mat &frame);
+
+    /// @brief Exports the time surface as a DLPack tensor of shape (height, width, 2), of 64 bits integers
+    ///
+    /// The tensor is a view of the time surface of the device, updated by the next events processed. The device is
+    /// synchronized before the export, so that the tensor can be read on any stream.
+    /// @return Tensor, to be released by its consumer with its deleter
+    DLPack::ManagedTensor *export_time_surface();
+
+    /// @brief Exports the histogram as a DLPack tensor of shape (height, width, 2), of 32 bits integers
+    /// @return Tensor, to be released by its consumer with its deleter
+    /// @sa @ref export_time_surface
+    DLPack::ManagedTensor *export_histogram();
+
+    /// @brief Exports the frame as a DLPack tensor of shape (height, width, 3), of 8 bits unsigned integers
+    /// @return Tensor, to be released by its consumer with its deleter
+    /// @sa @ref export_time_surface
+    DLPack::ManagedTensor *export_frame();
+
+    /// @brief Gets the index of the CUDA device
+    int get_device_id() const;
+
+    /// @brief Gets the CUDA stream of the processor, as a cudaStream_t
+    void *get_stream() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_CORE_CUDA_EVENTS_PROCESSOR_H
@@ -0,0 +1,18 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_CUDA_DLPACK_H
+#define METAVISION_SDK_CORE_CUDA_DLPACK_H
+
+// The DLPack types are shared with the CPU buffers exported to Python, they are declared in the base module
+#include "metavision/sdk/base/utils/dlpack.h"
+
+#endif // METAVISION_SDK_CORE_CUDA_DLPACK_H
@@ -0,0 +1,193 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_ACTIVITY_GATING_STAGE_H
+#define METAVISION_SDK_CORE_ACTIVITY_GATING_STAGE_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+#include <boost/any.hpp>
+
+#include "metavision/sdk/core/pipeline/base_stage.h"
+#include "metavision/sdk/core/utils/rate_estimator.h"
+
+namespace Metavision {
+
+/// @brief Stage that forwards the buffers of events of its previous stage only while the scene is active, to spare the
+/// heavy stages following it (e.g. frame generation or inference pre-processing) when the scene is empty
+///
+/// The events are counted per block of pixels over steps of fixed duration. At the end of a step, the events of the
+/// blocks with fewer events than a minimum are discarded as background noise, and the others are added to a
+/// @ref RateEstimator averaging their rate over a sliding window. The scene becomes active when this rate reaches the
+/// activation rate, and inactive when it falls below the deactivation rate, the gap between both rates preventing the
+/// gate from flickering.
+///
+/// While the scene is inactive, no buffer is produced: the next stages are not scheduled and cost nothing. A buffer is
+/// forwarded whole if the scene is active at any time of its events. The changes of activity can also be notified
+/// (see @ref set_activity_callback), e.g. to pause or resume (see @ref I_EventsStream::pause) the streams of the
+/// cameras only needed while the scene is active.
+class ActivityGatingStage : public BaseStage {
+public:
+    /// @brief Callback called when the scene becomes active or inactive, with the end of the step of the change
+    using ActivityCallback = std::function<void(timestamp, bool)>;
+
+    /// @brief Constructor
+    /// @param width Width of the sensor
+    /// @param height Height of the sensor
+    /// @param activation_rate_hz Rate of the events of the active blocks above which the scene becomes active, in Hz
+    /// @param deactivation_rate_hz Rate of the events of the active blocks below which the scene becomes inactive, in
+    /// Hz, not greater than the activation rate
+    /// @param block_size Size of the side of the square blocks of pixels whose events are counted together
+    /// @param min_block_events Minimum number of events of a block during a step for them not to be noise
+    /// @param step_time Duration of the steps over which the events of the blocks are counted, in us
+    /// @param window_time Duration of the window over which the rate of the events is averaged, in us
+    /// @throw std::invalid_argument if the size of the sensor, of the blocks, the step or the window is not positive,
+    /// or the rates are invalid
+    ActivityGatingStage(int width, int height, double activation_rate_hz, double deactivation_rate_hz,
+                        int block_size = 16, std::uint32_t min_block_events = 2, timestamp step_time = 10000,
+                        timestamp window_time = 100000) :
+        width_(width),
+        height_(height),
+        block_size_(block_size),
+        map_width_(block_size > 0 ? (width + block_size - 1) / block_size : 0),
+        min_block_events_(min_block_events),
+        step_time_(step_time),
+        activation_rate_(activation_rate_hz),
+        deactivation_rate_(deactivation_rate_hz),
+        rate_estimator_([this](timestamp, double avg_rate, double) { update_activity(avg_rate); }, step_time,
+                        window_time),
+        active_(false) {
+        if (width <= 0 || height <= 0) {
+            throw std::invalid_argument("ActivityGatingStage: the size of the sensor must be positive.");
+        }
+        if (block_size <= 0) {
+            throw std::invalid_argument("ActivityGatingStage: the size of the blocks must be positive.");
+        }
+        if (step_time <= 0 || window_time <= 0) {
+            throw std::invalid_argument("ActivityGatingStage: the step and the window must be positive.");
+        }
+        if (deactivation_rate_hz < 0 || deactivation_rate_hz > activation_rate_hz) {
+            throw std::invalid_argument(
+                "ActivityGatingStage: the deactivation rate must be in [0, activation rate].");
+        }
+        block_counts_.assign(static_cast<size_t>(map_width_) * ((height + block_size - 1) / block_size), 0);
+
+        set_consuming_callback([this](const boost::any &data) {
+            if (auto *buffer = boost::any_cast<EventBufferPtr>(&data)) {
+                consume_events(*buffer);
+            }
+        });
+    }
+
+    /// @brief Constructor
+    ///
+    /// Overload constructor that simplifies setting the previous stage.
+    /// @param prev_stage Previous stage producing the buffers of events to gate
+    /// @param width Width of the sensor
+    /// @param height Height of the sensor
+    /// @param activation_rate_hz Rate of the events of the active blocks above which the scene becomes active, in Hz
+    /// @param deactivation_rate_hz Rate of the events of the active blocks below which the scene becomes inactive,
+    /// in Hz
+    ActivityGatingStage(BaseStage &prev_stage, int width, int height, double activation_rate_hz,
+                        double deactivation_rate_hz) :
+        ActivityGatingStage(width, height, activation_rate_hz, deactivation_rate_hz) {
+        set_previous_stage(prev_stage);
+    }
+
+    /// @brief Sets the callback called when the scene becomes active or inactive
+    /// @warning The callback is called from the thread consuming the events of the stage
+    /// @param cb Callback called with the end of the step at which the activity changed, and the new activity
+    void set_activity_callback(const ActivityCallback &cb) {
+        activity_cb_ = cb;
+    }
+
+    /// @brief Returns true if the scene is active, i.e. the buffers of events are forwarded
+    bool is_active() const {
+        return active_;
+    }
+
+    /// @brief Gets the number of buffers of events not forwarded because the scene was inactive
+    size_t num_gated_buffers() const {
+        return num_gated_buffers_;
+    }
+
+private:
+    void consume_events(const EventBufferPtr &buffer) {
+        bool forward = active_;
+        for (const auto &ev : *buffer) {
+            if (ev.t >= step_end_) {
+                end_steps(ev.t);
+                forward |= active_;
+            }
+            const unsigned int x = ev.x, y = ev.y;
+            if (x < static_cast<unsigned int>(width_) && y < static_cast<unsigned int>(height_)) {
+                ++block_counts_[(y / block_size_) * map_width_ + x / block_size_];
+            }
+        }
+
+        if (forward) {
+            produce(buffer);
+        } else {
+            ++num_gated_buffers_;
+        }
+    }
+
+    // Adds the counts of the steps ending before a timestamp to the rate estimator
+    void end_steps(timestamp t) {
+        // The first step starts with the first event, the time given to the rate estimator starting from 0
+        if (!started_) {
+            started_     = true;
+            step_end_    = t + step_time_;
+            time_origin_ = t;
+            return;
+        }
+
+        for (; step_end_ <= t; step_end_ += step_time_) {
+            size_t count = 0;
+            for (auto &block_count : block_counts_) {
+                if (block_count >= min_block_events_) {
+                    count += block_count;
+                }
+                block_count = 0;
+            }
+            rate_estimator_.add_data(step_end_ - time_origin_, count);
+        }
+    }
+
+    void update_activity(double rate) {
+        const bool active = active_ ? rate >= deactivation_rate_ : rate >= activation_rate_;
+        if (active != active_) {
+            active_ = active;
+            if (activity_cb_) {
+                activity_cb_(step_end_, active);
+            }
+        }
+    }
+
+    const int width_, height_, block_size_, map_width_;
+    const std::uint32_t min_block_events_;
+    const timestamp step_time_;
+    const double activation_rate_, deactivation_rate_;
+    std::vector<std::uint32_t> block_counts_;
+    RateEstimator rate_estimator_;
+    ActivityCallback activity_cb_;
+    bool started_       = false;
+    timestamp step_end_ = 0, time_origin_ = 0;
+    std::atomic<bool> active_;
+    std::atomic<size_t> num_gated_buffers_{0};
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_CORE_ACTIVITY_GATING_STAGE_H
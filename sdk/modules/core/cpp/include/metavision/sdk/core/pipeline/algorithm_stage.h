@@ -145,6 +145,7 @@ public:
 
 private:
     void init() {
+        event_buffer_pool_.register_statistics("AlgorithmStage buffers");
         set_consuming_callback([this](const boost::any &data) {
             try {
                 auto buffer     = boost::any_cast<InputEventBufferPtr>(data);
@@ -13,7 +13,10 @@
 #define METAVISION_SDK_CORE_BASE_STAGE_H
 
 #include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <mutex>
+#include <string>
 #include <vector>
 #include <functional>
 #include <unordered_map>
@@ -21,7 +24,10 @@
 #include <boost/any.hpp>
 
 #include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/base/utils/monotonic_arena.h"
 #include "metavision/sdk/base/utils/object_pool.h"
+#include "metavision/sdk/base/utils/thread_policy.h"
+#include "metavision/sdk/core/pipeline/stage_statistics.h"
 
 namespace Metavision {
 
@@ -250,6 +256,67 @@ public:
     ///
     inline void set_consuming_callback(BaseStage &prev_stage, const std::function<void(boost::any)> &cb);
 
+    /// @brief Sets the name of the stage, used to identify it in the statistics of the pipeline
+    /// @param name The name of the stage
+    inline void set_name(const std::string &name);
+
+    /// @brief Gets the name of the stage
+    /// @return The name of the stage, empty if none has been set
+    inline std::string name() const;
+
+    /// @brief Enum class representing the policy applied when data is produced for a full input queue
+    enum class InputQueuePolicy {
+        /// the producing stage waits until enough data have been consumed
+        Block,
+        /// the oldest pending data is dropped to make room for the produced one
+        DropOldest,
+        /// the produced data is dropped
+        DropNewest,
+        /// the pending data are dropped and replaced by the produced one, only the most recent data is consumed
+        Coalesce,
+    };
+
+    /// @brief Limits the number of data pending from each previous stage
+    ///
+    /// By default, the data produced by the previous stages are queued without limit until this stage consumes them,
+    /// so that the memory grows as long as this stage can't keep up. Once a limit is set, @p policy is applied whenever
+    /// a previous stage produces data while @p max_size of the data it produced are still pending.
+    /// This limit applies to the previous stages for which no specific limit has been set.
+    ///
+    /// @param max_size Maximum number of data pending from each previous stage, 0 for no limit
+    /// @param policy The policy applied when a previous stage produces data for a full queue
+    /// @warning With @ref InputQueuePolicy::Block, the previous stages must not run on the same thread as this stage,
+    ///          which can happen when the pipeline is run by fewer worker threads than it has stages
+    inline void set_input_queue_limit(size_t max_size, InputQueuePolicy policy = InputQueuePolicy::Block);
+
+    /// @brief Limits the number of data pending from a specific previous stage
+    ///
+    /// @param prev_stage The previous stage for which the limit is set
+    /// @param max_size Maximum number of data pending from @p prev_stage, 0 for no limit
+    /// @param policy The policy applied when @p prev_stage produces data for a full queue
+    ///
+    /// @sa @ref set_input_queue_limit(size_t max_size, InputQueuePolicy policy)
+    inline void set_input_queue_limit(BaseStage &prev_stage, size_t max_size,
+                                      InputQueuePolicy policy = InputQueuePolicy::Block);
+
+    /// @brief Gets the maximum number of data pending from a previous stage
+    /// @param prev_stage The previous stage
+    /// @return The maximum number of pending data, 0 if there is no limit
+    inline size_t input_queue_limit(const BaseStage &prev_stage) const;
+
+    /// @brief Gets the number of data produced by the previous stages and not yet consumed by this stage
+    /// @return The number of pending data
+    inline size_t input_queue_size() const;
+
+    /// @brief Gets the number of data produced by a previous stage and not yet consumed by this stage
+    /// @param prev_stage The previous stage
+    /// @return The number of data pending from @p prev_stage
+    inline size_t input_queue_size(const BaseStage &prev_stage) const;
+
+    /// @brief Gets the number of data dropped because of the input queue limits
+    /// @return The number of dropped data
+    inline size_t num_dropped_inputs() const;
+
     /// @brief Detaches this thread and schedules the execution of any callback on
     /// its own dedicated processing thread of the pipeline
     ///
@@ -267,6 +334,53 @@ public:
     /// and false if stage schedules the execution of its callback on the main thread
     inline bool is_detached() const;
 
+    /// @brief Detaches this stage on a processing thread of the pipeline dedicated to it, with its own threading policy
+    ///
+    /// Whatever the scheduling policy of the pipeline, the callbacks of the stage are then run by a thread that runs
+    /// no other stage, e.g. to isolate the decoding or the recording from the other stages of a busy pipeline, while
+    /// the other detached stages share the remaining processing threads.
+    /// The policy of the pipeline (see @ref Pipeline::set_thread_policy) does not apply to this thread. If @p policy
+    /// does not give a name, the thread is named as the other processing threads.
+    /// A stage can be given a dedicated thread as long as the pipeline has not been started.
+    ///
+    /// @param policy The threading policy of the thread, e.g. the CPUs it runs on
+    /// @return true if the stage will run on a dedicated thread and false otherwise (e.g. if it can't be detached)
+    inline bool set_dedicated_thread(const ThreadPolicy &policy = ThreadPolicy());
+
+    /// @brief Checks if this stage runs on a processing thread dedicated to it
+    /// @return true if @ref set_dedicated_thread has been successfully called, false otherwise
+    inline bool has_dedicated_thread() const;
+
+    /// @brief Gets the threading policy of the thread dedicated to this stage
+    /// @return The policy given to @ref set_dedicated_thread, the default policy if the stage has no dedicated thread
+    inline ThreadPolicy dedicated_thread_policy() const;
+
+    /// @brief Enum class representing the priority class of a stage, used by the pipeline to share the processing
+    /// threads between the stages under CPU pressure
+    enum class Priority {
+        /// the tasks of the stage are run before the ones of the other stages, and its data are never dropped by the
+        /// pipeline (e.g. recording or analytics stages)
+        Critical,
+        /// the default priority
+        Normal,
+        /// the tasks of the stage are run after the ones of the other stages and, as long as tasks of critical stages
+        /// are pending, the data produced for the stage are coalesced with the pending ones, so that it only consumes
+        /// the most recent data (e.g. display or preview stages)
+        BestEffort
+    };
+
+    /// @brief Sets the priority class of the stage
+    ///
+    /// Whatever the priority, the tasks of a stage are still run in the order the data has been produced. The data
+    /// coalesced because of the priority are accounted for in @ref num_dropped_inputs.
+    /// @param priority The priority class of the stage
+    /// @throw std::runtime_error if the pipeline has already started
+    inline void set_priority(Priority priority);
+
+    /// @brief Gets the priority class of the stage
+    /// @return The priority class of the stage, @ref Priority::Normal if none has been set
+    inline Priority priority() const;
+
     /// @brief Returns the associated pipeline
     /// Throws std::runtime_error if no pipeline has been set yet.
     /// @return @ref Pipeline "Pipeline&" the pipeline that owns this stage
@@ -295,6 +409,29 @@ protected:
     /// @param data The produced data
     inline void produce(const boost::any &data);
 
+    /// @brief Produces data for one of the next stages only
+    ///
+    /// This schedules the execution of the consuming callback of @p next_stage
+    /// @param next_stage The next stage consuming the data
+    /// @param data The produced data
+    inline void produce(BaseStage &next_stage, const boost::any &data);
+
+    /// @brief Schedules a task consuming data on one of the next stages
+    ///
+    /// The task is run as a consuming callback of @p next_stage would be. This is used by the stages that pass their
+    /// data by other means than a boost::any, see @ref TypedStage
+    /// @param next_stage The next stage on which the task is run
+    /// @param task The task consuming the data
+    inline void schedule_consuming_task(BaseStage &next_stage, const std::function<void()> &task);
+
+    /// @brief Signals that the data carried by a task scheduled by @ref schedule_consuming_task has been consumed
+    /// @param prev_stage The stage that scheduled the task
+    inline void release_input(const BaseStage &prev_stage);
+
+    /// @brief Accounts for data consumed by a task scheduled by @ref schedule_consuming_task in the statistics
+    /// @param num_events Number of events in the consumed data
+    inline void count_consumed_data(size_t num_events);
+
     /// @brief Sets the stage status and notify next stages when it is done
     ///
     /// This function should be called whenever the stage will never produce any more data
@@ -303,14 +440,30 @@ protected:
     /// processed by following stages.
     inline void complete();
 
+    /// @brief Gets the arena from which the consuming callbacks can allocate their temporaries
+    ///
+    /// The arena is reset after each data consumed by the consuming callbacks (see @ref set_consuming_callback), so
+    /// the memory allocated from it must not be kept beyond the consumption of the data. The tasks scheduled by
+    /// @ref schedule_consuming_task must reset it themselves.
+    /// @return The arena of the stage, which allocates no memory until it is used
+    MonotonicArena &slice_arena() {
+        return slice_arena_;
+    }
+
 private:
     std::atomic<Status> status_{Status::Inactive};
     std::atomic<bool> done_{false}, detachable_{true}, run_on_main_thread_{true};
     std::atomic<size_t> current_prod_id_{0};
+    std::atomic<Priority> priority_{Priority::Normal};
+    bool dedicated_thread_ = false;
+    ThreadPolicy dedicated_thread_policy_;
 
     mutable std::mutex mutex_;
     Pipeline *pipeline_ = nullptr;
     std::unordered_set<BaseStage *> prev_stages_, next_stages_;
+    std::string name_;
+    detail::StageCounters counters_;
+    MonotonicArena slice_arena_;
 
     std::mutex cbs_mutex_;
     std::function<void()> starting_cb_ = [] {};
@@ -320,6 +473,25 @@ private:
     std::unordered_map<BaseStage *, std::function<void(BaseStage &, const NotificationType, const boost::any &)>>
         receiving_cbs_;
 
+    // Data pending from a previous stage, consumed in order by the tasks scheduled on this stage. There are at least
+    // as many pending tasks as data, a task finding no data is a no-op.
+    struct InputQueue {
+        std::deque<boost::any> datas;
+        std::deque<size_t> datas_num_bytes; // estimated memory held by each data, accounted for by the pipeline
+        size_t num_scheduled_tasks = 0; // data carried by the tasks scheduled by schedule_consuming_task
+        size_t max_size            = 0;
+        InputQueuePolicy policy    = InputQueuePolicy::Block;
+        bool has_own_limit         = false;
+    };
+
+    mutable std::mutex inputs_mutex_;
+    std::condition_variable inputs_cond_;
+    std::unordered_map<const BaseStage *, InputQueue> inputs_;
+    size_t inputs_max_size_         = 0;
+    InputQueuePolicy inputs_policy_ = InputQueuePolicy::Block;
+    bool inputs_closed_             = false;
+    std::atomic<size_t> num_dropped_inputs_{0};
+
     inline void start();
     inline void stop();
     inline void cancel();
@@ -330,6 +502,13 @@ private:
 
     inline void signal();
     inline void consume(BaseStage &prev_stage, const boost::any &data);
+    inline bool push_input(const BaseStage &prev_stage, const boost::any &data);
+    inline void push_back_input(InputQueue &input, const boost::any &data, Pipeline *pipeline);
+    inline boost::any pop_input(InputQueue &input, bool front, Pipeline *pipeline);
+    inline size_t clear_input(InputQueue &input, Pipeline *pipeline);
+    inline void cancel_last_input(const BaseStage &prev_stage);
+    inline void consume_input(BaseStage &prev_stage);
+    inline void close_inputs();
     inline void receive(BaseStage &prev_stage, const NotificationType &type, const boost::any &data);
 
     friend class Pipeline;
@@ -0,0 +1,111 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_CD_TRIGGER_MERGING_STAGE_H
+#define METAVISION_SDK_CORE_CD_TRIGGER_MERGING_STAGE_H
+
+#include <vector>
+#include <boost/any.hpp>
+
+#include "metavision/sdk/base/events/event_ext_trigger.h"
+#include "metavision/sdk/core/algorithms/cd_trigger_merger_algorithm.h"
+#include "metavision/sdk/core/pipeline/base_stage.h"
+
+namespace Metavision {
+
+/// @brief Stage that slices the @ref EventCD events consumed on the edges of the @ref EventExtTrigger events consumed
+///
+/// It runs a @ref CDTriggerMergerAlgorithm on the buffers of CD and trigger events produced by the previous stages
+/// (e.g. a @ref CameraStage), and produces a @ref TriggerSlicePtr for each slice of CD events between two trigger
+/// edges (see @ref CDTriggerMergerAlgorithm::set_slice_callback). The slices are taken from a bounded pool, and their
+/// buffers of events are reused once the next stages release them. The last slice is produced when all the previous
+/// stages have completed.
+class CDTriggerMergingStage : public BaseStage {
+public:
+    /// @brief Slice of CD events starting at a trigger edge
+    struct TriggerSlice {
+        /// Trigger edge starting the slice
+        EventExtTrigger edge;
+
+        /// Timestamp of the end of the slice (excluded), i.e. of the next trigger edge
+        timestamp end_ts = 0;
+
+        /// CD events of the slice
+        std::vector<EventCD> events;
+    };
+
+    using TriggerSlicePool       = SharedObjectPool<TriggerSlice>;
+    using TriggerSlicePtr        = TriggerSlicePool::ptr_type;
+    using EventTriggerBuffer     = std::vector<EventExtTrigger>;
+    using EventTriggerBufferPool = SharedObjectPool<EventTriggerBuffer>;
+    using EventTriggerBufferPtr  = EventTriggerBufferPool::ptr_type;
+
+    /// @brief Constructor
+    /// @param config Configuration of the merge of the CD and trigger events
+    CDTriggerMergingStage(const CDTriggerMergerConfig &config = CDTriggerMergerConfig()) :
+        algo_(config), slice_pool_(TriggerSlicePool::make_bounded()) {
+        algo_.set_slice_callback(
+            [this](const EventExtTrigger &edge, timestamp end_ts, const EventCD *begin, const EventCD *end) {
+                auto slice    = slice_pool_.acquire();
+                slice->edge   = edge;
+                slice->end_ts = end_ts;
+                slice->events.assign(begin, end);
+                produce(slice);
+            });
+
+        set_consuming_callback([this](const boost::any &data) { consume_events(data); });
+        set_receiving_callback([this](const NotificationType &type, const boost::any &data) {
+            if (type == NotificationType::Status && are_previous_stages_completed()) {
+                algo_.flush();
+            }
+        });
+    }
+
+    /// @brief Constructor
+    /// @param prev_stage Previous stage, producing both the CD and trigger events
+    /// @param config Configuration of the merge of the CD and trigger events
+    CDTriggerMergingStage(BaseStage &prev_stage, const CDTriggerMergerConfig &config = CDTriggerMergerConfig()) :
+        CDTriggerMergingStage(config) {
+        set_previous_stage(prev_stage);
+    }
+
+    /// @brief Gets algo
+    /// @return Algorithm class associated to this stage
+    CDTriggerMergerAlgorithm &algo() {
+        return algo_;
+    }
+
+private:
+    void consume_events(const boost::any &data) {
+        if (auto *cd_buffer = boost::any_cast<EventBufferPtr>(&data)) {
+            algo_.process_cd_events((*cd_buffer)->data(), (*cd_buffer)->data() + (*cd_buffer)->size());
+        } else if (auto *trigger_buffer = boost::any_cast<EventTriggerBufferPtr>(&data)) {
+            algo_.process_trigger_events((*trigger_buffer)->data(),
+                                         (*trigger_buffer)->data() + (*trigger_buffer)->size());
+        }
+    }
+
+    bool are_previous_stages_completed() const {
+        for (auto *prev_stage : previous_stages()) {
+            if (prev_stage->status() != Status::Completed) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    CDTriggerMergerAlgorithm algo_;
+    TriggerSlicePool slice_pool_;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_CORE_CD_TRIGGER_MERGING_STAGE_H
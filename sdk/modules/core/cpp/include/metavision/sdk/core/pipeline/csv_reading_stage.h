@@ -0,0 +1,70 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_CSV_READING_STAGE_H
+#define METAVISION_SDK_CORE_CSV_READING_STAGE_H
+
+#include <atomic>
+#include <thread>
+
+#include "metavision/sdk/core/pipeline/base_stage.h"
+#include "metavision/sdk/core/utils/csv_event_file_reader.h"
+
+namespace Metavision {
+
+/// @brief Stage that produces the events of a CSV file, one "x,y,p,t" line per event
+///
+/// The file is parsed by the worker threads of a @ref CSVEventFileReader, and the events of each chunk of the file are
+/// produced in a buffer of their own.
+class CSVReadingStage : public BaseStage {
+public:
+    /// @brief Constructor
+    /// @param filename Name of the input file
+    /// @param num_threads Number of threads parsing the file, 0 for the number of cores
+    /// @throw std::runtime_error if the file can not be opened
+    CSVReadingStage(const std::string &filename, size_t num_threads = 0) : reader_(filename, num_threads) {
+        set_starting_callback([this] {
+            done_           = false;
+            reading_thread_ = std::thread([this] { read(); });
+        });
+        set_stopping_callback([this] {
+            done_ = true;
+            if (reading_thread_.joinable())
+                reading_thread_.join();
+        });
+    }
+
+    /// @brief Gets the reader of the stage
+    CSVEventFileReader &reader() {
+        return reader_;
+    }
+
+private:
+    void read() {
+        auto buffer = pool_.acquire();
+        while (!done_ && reader_.read(*buffer)) {
+            if (!buffer->empty()) {
+                produce(buffer);
+                buffer = pool_.acquire();
+            }
+        }
+        complete();
+    }
+
+    CSVEventFileReader reader_;
+    EventBufferPool pool_;
+    std::atomic<bool> done_{false};
+    std::thread reading_thread_;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_CORE_CSV_READING_STAGE_H
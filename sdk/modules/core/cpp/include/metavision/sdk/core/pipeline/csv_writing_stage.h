@@ -0,0 +1,76 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_CSV_WRITING_STAGE_H
+#define METAVISION_SDK_CORE_CSV_WRITING_STAGE_H
+
+#include <stdexcept>
+#include <boost/any.hpp>
+
+#include "metavision/sdk/base/utils/sdk_log.h"
+#include "metavision/sdk/core/pipeline/base_stage.h"
+#include "metavision/sdk/core/pipeline/pipeline.h"
+#include "metavision/sdk/core/utils/csv_event_file_writer.h"
+
+namespace Metavision {
+
+/// @brief Stage that writes the input events to a CSV file, one "x,y,p,t" line per event
+///
+/// The events are formatted by the worker threads of a @ref CSVEventFileWriter, so that the previous stages go on
+/// producing events while they are written.
+class CSVWritingStage : public BaseStage {
+public:
+    /// @brief Constructor
+    /// @param filename Name of the output file
+    /// @param num_threads Number of threads formatting the events, 0 for the number of cores
+    /// @throw std::runtime_error if the file can not be opened
+    CSVWritingStage(const std::string &filename, size_t num_threads = 0) : writer_(filename, num_threads) {
+        set_consuming_callback([this](const boost::any &data) {
+            try {
+                auto buffer = boost::any_cast<EventBufferPtr>(data);
+                writer_.write(buffer->cbegin(), buffer->cend());
+            } catch (boost::bad_any_cast &c) {
+                MV_SDK_LOG_ERROR() << c.what();
+            } catch (std::runtime_error &e) {
+                MV_SDK_LOG_ERROR() << e.what();
+                pipeline().cancel();
+            }
+        });
+        // The file is complete once the pipeline is done
+        set_stopping_callback([this] {
+            try {
+                writer_.close();
+            } catch (std::runtime_error &e) { MV_SDK_LOG_ERROR() << e.what(); }
+        });
+    }
+
+    /// @brief Constructor
+    /// @param prev_stage Previous stage
+    /// @param filename Name of the output file
+    /// @param num_threads Number of threads formatting the events, 0 for the number of cores
+    /// @throw std::runtime_error if the file can not be opened
+    CSVWritingStage(BaseStage &prev_stage, const std::string &filename, size_t num_threads = 0) :
+        CSVWritingStage(filename, num_threads) {
+        set_previous_stage(prev_stage);
+    }
+
+    /// @brief Gets the writer of the stage
+    CSVEventFileWriter &writer() {
+        return writer_;
+    }
+
+private:
+    CSVEventFileWriter writer_;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_CORE_CSV_WRITING_STAGE_H
@@ -12,6 +12,7 @@
 #ifndef METAVISION_SDK_CORE_DETAIL_BASE_STAGE_IMPL_H
 #define METAVISION_SDK_CORE_DETAIL_BASE_STAGE_IMPL_H
 
+#include <numeric>
 #include <stdexcept>
 
 #include "metavision/sdk/core/pipeline/base_stage.h"
@@ -46,6 +47,16 @@ const std::unordered_set<BaseStage *> &BaseStage::next_stages() const {
     return next_stages_;
 }
 
+void BaseStage::set_name(const std::string &name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    name_ = name;
+}
+
+std::string BaseStage::name() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return name_;
+}
+
 BaseStage::Status BaseStage::status() const {
     return status_;
 }
@@ -156,28 +167,284 @@ void BaseStage::set_consuming_callback(BaseStage &prev_stage, const std::functio
     prev_stages_.insert(&prev_stage);
 }
 
+void BaseStage::set_input_queue_limit(size_t max_size, InputQueuePolicy policy) {
+    {
+        std::lock_guard<std::mutex> lock(inputs_mutex_);
+        inputs_max_size_ = max_size;
+        inputs_policy_   = policy;
+    }
+    inputs_cond_.notify_all();
+}
+
+void BaseStage::set_input_queue_limit(BaseStage &prev_stage, size_t max_size, InputQueuePolicy policy) {
+    {
+        std::lock_guard<std::mutex> lock(inputs_mutex_);
+        auto &input         = inputs_[&prev_stage];
+        input.max_size      = max_size;
+        input.policy        = policy;
+        input.has_own_limit = true;
+    }
+    inputs_cond_.notify_all();
+}
+
+size_t BaseStage::input_queue_limit(const BaseStage &prev_stage) const {
+    std::lock_guard<std::mutex> lock(inputs_mutex_);
+    auto it = inputs_.find(&prev_stage);
+    return (it != inputs_.end() && it->second.has_own_limit) ? it->second.max_size : inputs_max_size_;
+}
+
+size_t BaseStage::input_queue_size() const {
+    std::lock_guard<std::mutex> lock(inputs_mutex_);
+    size_t size = 0;
+    for (const auto &p : inputs_) {
+        size += p.second.datas.size() + p.second.num_scheduled_tasks;
+    }
+    return size;
+}
+
+size_t BaseStage::input_queue_size(const BaseStage &prev_stage) const {
+    std::lock_guard<std::mutex> lock(inputs_mutex_);
+    auto it = inputs_.find(&prev_stage);
+    return it != inputs_.end() ? it->second.datas.size() + it->second.num_scheduled_tasks : 0;
+}
+
+size_t BaseStage::num_dropped_inputs() const {
+    return num_dropped_inputs_;
+}
+
 void BaseStage::produce(const boost::any &data) {
     Pipeline *pipeline;
     std::unordered_set<BaseStage *> next_stages;
+    bool is_source;
     {
         std::lock_guard<std::mutex> lock(mutex_);
         pipeline    = pipeline_;
         next_stages = next_stages_;
+        is_source   = prev_stages_.empty();
     }
     if (!pipeline)
         return;
 
+    if (is_source)
+        pipeline->wait_for_memory_budget();
+
     // If the pipeline has been cancelled, we can't produce anything
     if (pipeline->status() == Pipeline::Status::Cancelled)
         return;
 
     for (auto *stage : next_stages) {
-        pipeline->schedule(
-            *stage, [this, stage, data] { stage->consume(*this, data); }, stage->current_prod_id_++, true,
-            stage->run_on_main_thread_);
+        // a task is only needed when the data is queued after the pending ones
+        if (stage->push_input(*this, data) &&
+            !pipeline->schedule(
+                *stage, [this, stage] { stage->consume_input(*this); }, stage->current_prod_id_++, true,
+                stage->run_on_main_thread_)) {
+            stage->cancel_last_input(*this);
+        }
     };
 }
 
+void BaseStage::produce(BaseStage &next_stage, const boost::any &data) {
+    Pipeline *pipeline;
+    bool is_source;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pipeline  = pipeline_;
+        is_source = prev_stages_.empty();
+    }
+    if (!pipeline)
+        return;
+
+    if (is_source)
+        pipeline->wait_for_memory_budget();
+
+    // If the pipeline has been cancelled, we can't produce anything
+    if (pipeline->status() == Pipeline::Status::Cancelled)
+        return;
+
+    if (next_stage.push_input(*this, data) &&
+        !pipeline->schedule(
+            next_stage, [this, &next_stage] { next_stage.consume_input(*this); }, next_stage.current_prod_id_++, true,
+            next_stage.run_on_main_thread_)) {
+        next_stage.cancel_last_input(*this);
+    }
+}
+
+void BaseStage::schedule_consuming_task(BaseStage &next_stage, const std::function<void()> &task) {
+    Pipeline *pipeline;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pipeline = pipeline_;
+    }
+    if (!pipeline)
+        return;
+
+    // If the pipeline has been cancelled, we can't produce anything
+    if (pipeline->status() == Pipeline::Status::Cancelled)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(next_stage.inputs_mutex_);
+        ++next_stage.inputs_[this].num_scheduled_tasks;
+    }
+    if (!pipeline->schedule(next_stage, task, next_stage.current_prod_id_++, true, next_stage.run_on_main_thread_)) {
+        next_stage.release_input(*this);
+    }
+}
+
+void BaseStage::release_input(const BaseStage &prev_stage) {
+    std::lock_guard<std::mutex> lock(inputs_mutex_);
+    auto it = inputs_.find(&prev_stage);
+    if (it != inputs_.end() && it->second.num_scheduled_tasks > 0) {
+        --it->second.num_scheduled_tasks;
+    }
+}
+
+void BaseStage::count_consumed_data(size_t num_events) {
+    counters_.add_buffer(num_events);
+}
+
+bool BaseStage::push_input(const BaseStage &prev_stage, const boost::any &data) {
+    Pipeline *pipeline;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pipeline = pipeline_;
+    }
+    const bool yield_to_other_stages =
+        priority_ == Priority::BestEffort && pipeline &&
+        (pipeline->has_pending_critical_tasks() ||
+         pipeline->is_over_memory_budget(Pipeline::MemoryBudgetPolicy::DropBestEffortInputs));
+
+    std::unique_lock<std::mutex> lock(inputs_mutex_);
+    auto &input                   = inputs_[&prev_stage];
+    const size_t max_size         = input.has_own_limit ? input.max_size : inputs_max_size_;
+    const InputQueuePolicy policy = input.has_own_limit ? input.policy : inputs_policy_;
+    if (yield_to_other_stages && !input.datas.empty() && !inputs_closed_) {
+        // the data is consumed by the task of the pending one it replaces
+        num_dropped_inputs_ += clear_input(input, pipeline);
+        push_back_input(input, data, pipeline);
+        return false;
+    }
+    if (max_size == 0 || input.datas.size() < max_size || inputs_closed_) {
+        push_back_input(input, data, pipeline);
+        return true;
+    }
+
+    switch (policy) {
+    case InputQueuePolicy::Block:
+        // references to the elements of an unordered_map are not invalidated by insertions
+        inputs_cond_.wait(lock, [this, &input, max_size] { return input.datas.size() < max_size || inputs_closed_; });
+        push_back_input(input, data, pipeline);
+        return true;
+    case InputQueuePolicy::DropOldest:
+        pop_input(input, true, pipeline);
+        push_back_input(input, data, pipeline);
+        ++num_dropped_inputs_;
+        return false;
+    case InputQueuePolicy::DropNewest:
+        ++num_dropped_inputs_;
+        return false;
+    case InputQueuePolicy::Coalesce:
+        num_dropped_inputs_ += clear_input(input, pipeline);
+        push_back_input(input, data, pipeline);
+        return false;
+    }
+    return false;
+}
+
+void BaseStage::push_back_input(InputQueue &input, const boost::any &data, Pipeline *pipeline) {
+    size_t num_bytes = 0;
+    if (auto *buffer = boost::any_cast<EventBufferPtr>(&data)) {
+        num_bytes = detail::num_bytes(*buffer);
+    } else if (auto *buffer = boost::any_cast<EventBuffer>(&data)) {
+        num_bytes = detail::num_bytes(*buffer);
+    }
+    input.datas.push_back(data);
+    input.datas_num_bytes.push_back(num_bytes);
+    if (pipeline) {
+        pipeline->add_memory_usage(num_bytes);
+    }
+}
+
+boost::any BaseStage::pop_input(InputQueue &input, bool front, Pipeline *pipeline) {
+    boost::any data;
+    size_t num_bytes;
+    if (front) {
+        data      = std::move(input.datas.front());
+        num_bytes = input.datas_num_bytes.front();
+        input.datas.pop_front();
+        input.datas_num_bytes.pop_front();
+    } else {
+        data      = std::move(input.datas.back());
+        num_bytes = input.datas_num_bytes.back();
+        input.datas.pop_back();
+        input.datas_num_bytes.pop_back();
+    }
+    if (pipeline) {
+        pipeline->remove_memory_usage(num_bytes);
+    }
+    return data;
+}
+
+size_t BaseStage::clear_input(InputQueue &input, Pipeline *pipeline) {
+    const size_t num_datas = input.datas.size();
+    const size_t num_bytes = std::accumulate(input.datas_num_bytes.cbegin(), input.datas_num_bytes.cend(), size_t(0));
+    input.datas.clear();
+    input.datas_num_bytes.clear();
+    if (pipeline) {
+        pipeline->remove_memory_usage(num_bytes);
+    }
+    return num_datas;
+}
+
+void BaseStage::cancel_last_input(const BaseStage &prev_stage) {
+    Pipeline *pipeline;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pipeline = pipeline_;
+    }
+    std::lock_guard<std::mutex> lock(inputs_mutex_);
+    auto it = inputs_.find(&prev_stage);
+    if (it != inputs_.end() && !it->second.datas.empty()) {
+        pop_input(it->second, false, pipeline);
+    }
+}
+
+void BaseStage::consume_input(BaseStage &prev_stage) {
+    Pipeline *pipeline;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pipeline = pipeline_;
+    }
+    boost::any data;
+    {
+        std::lock_guard<std::mutex> lock(inputs_mutex_);
+        auto it = inputs_.find(&prev_stage);
+        if (it == inputs_.end() || it->second.datas.empty()) {
+            // the data has been coalesced with one consumed by a previous task
+            return;
+        }
+        data = pop_input(it->second, true, pipeline);
+    }
+    inputs_cond_.notify_all();
+
+    if (auto *buffer = boost::any_cast<EventBufferPtr>(&data)) {
+        counters_.add_buffer(detail::num_elements(*buffer));
+    } else if (auto *buffer = boost::any_cast<EventBuffer>(&data)) {
+        counters_.add_buffer(buffer->size());
+    } else {
+        counters_.add_buffer(0);
+    }
+    consume(prev_stage, data);
+}
+
+void BaseStage::close_inputs() {
+    {
+        std::lock_guard<std::mutex> lock(inputs_mutex_);
+        inputs_closed_ = true;
+    }
+    inputs_cond_.notify_all();
+}
+
 void BaseStage::consume(BaseStage &prev_stage, const boost::any &data) {
     std::function<void(BaseStage &, const boost::any &)> cb;
     {
@@ -190,6 +457,7 @@ void BaseStage::consume(BaseStage &prev_stage, const boost::any &data) {
         }
     }
     cb(prev_stage, data);
+    slice_arena_.reset();
 }
 
 void BaseStage::signal() {
@@ -208,6 +476,9 @@ void BaseStage::signal() {
         pipeline->schedule(
             *stage, [] {}, stage->current_prod_id_++, true, stage->run_on_main_thread_);
     };
+    // the last stages make sure the main thread notices that the pipeline may be done
+    if (next_stages.empty())
+        pipeline->wake_up();
 }
 
 void BaseStage::notify(const NotificationType &type, const boost::any &data) {
@@ -257,6 +528,39 @@ bool BaseStage::is_detached() const {
     return !run_on_main_thread_;
 }
 
+bool BaseStage::set_dedicated_thread(const ThreadPolicy &policy) {
+    if (!detach()) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    dedicated_thread_        = true;
+    dedicated_thread_policy_ = policy;
+    return true;
+}
+
+bool BaseStage::has_dedicated_thread() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return dedicated_thread_;
+}
+
+ThreadPolicy BaseStage::dedicated_thread_policy() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return dedicated_thread_policy_;
+}
+
+void BaseStage::set_priority(Priority priority) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // the tasks already scheduled must keep their order with the next ones
+    if (pipeline_ && pipeline_->status() == Pipeline::Status::Started) {
+        throw std::runtime_error("BaseStage : priority cannot be changed once the pipeline is started");
+    }
+    priority_ = priority;
+}
+
+BaseStage::Priority BaseStage::priority() const {
+    return priority_;
+}
+
 void BaseStage::set_pipeline(Pipeline &pipeline) {
     {
         std::lock_guard<std::mutex> lock(mutex_);
@@ -191,6 +191,10 @@ void FrameCompositionStage::set_stage_status(BaseStage &stage, const boost::any
 
 inline bool FrameCompositionStage::update_composed_image() {
     bool still_have_frames_to_consume = false;
+    // The sub-images are rendered together, and the input frames are only released afterwards
+    std::vector<std::pair<unsigned int, cv::Mat>> updates;
+    std::vector<std::queue<std::pair<timestamp, cv::Mat>> *> saved_frames_to_pop;
+    std::vector<std::queue<std::pair<timestamp, FramePtr>> *> references_to_pop;
     for (auto &p : sources_info_map_) {
         if (!p.second.saved_frames_queue_.empty()) {
             still_have_frames_to_consume = true; // Regardless of whether or not we enter the if condition below, if
@@ -198,8 +202,8 @@ inline bool FrameCompositionStage::update_composed_image() {
                                                  // consume all the frames of the source
             auto &next_frame_saved_in_queue = p.second.saved_frames_queue_.front();
             if (next_frame_saved_in_queue.first == next_frame_ts_) {
-                frame_composer_.update_subimage(p.first, next_frame_saved_in_queue.second);
-                p.second.saved_frames_queue_.pop();
+                updates.emplace_back(p.first, next_frame_saved_in_queue.second);
+                saved_frames_to_pop.push_back(&p.second.saved_frames_queue_);
                 continue; // No need to look in the queue with the shared ptr: skip to next source
             }
         }
@@ -209,11 +213,19 @@ inline bool FrameCompositionStage::update_composed_image() {
                                                  // consume all the frames of the source
             auto &next_in_queue = p.second.references_to_input_frames_queue_.front();
             if (next_in_queue.first == next_frame_ts_) {
-                frame_composer_.update_subimage(p.first, *(next_in_queue.second));
-                p.second.references_to_input_frames_queue_.pop();
+                updates.emplace_back(p.first, *(next_in_queue.second));
+                references_to_pop.push_back(&p.second.references_to_input_frames_queue_);
             }
         }
     }
+
+    frame_composer_.update_subimages(updates);
+    for (auto queue : saved_frames_to_pop) {
+        queue->pop();
+    }
+    for (auto queue : references_to_pop) {
+        queue->pop();
+    }
     return still_have_frames_to_consume;
 }
 
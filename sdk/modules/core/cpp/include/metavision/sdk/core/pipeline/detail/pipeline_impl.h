@@ -13,20 +13,27 @@
 #define METAVISION_SDK_CORE_DETAIL_PIPELINE_IMPL_H
 
 #include <algorithm>
+#include <chrono>
+#include <deque>
 #include <thread>
 #include <mutex>
 #include <condition_variable>
 
+#include "metavision/sdk/base/utils/metrics_registry.h"
+#include "metavision/sdk/base/utils/pool_registry.h"
+#include "metavision/sdk/base/utils/sdk_log.h"
+#include "metavision/sdk/base/utils/trace.h"
 #include "metavision/sdk/core/pipeline/pipeline.h"
 #include "metavision/sdk/core/pipeline/base_stage.h"
 #include "metavision/sdk/core/pipeline/algorithm_stage.h"
+#include "metavision/sdk/core/utils/detail/work_stealing_deque.h"
 
 namespace Metavision {
 
 struct Task {
     Task(const std::function<void()> &task = std::function<void()>(), size_t id = 0, bool optional = true,
-         BaseStage *stage_ptr = nullptr) :
-        task(task), id(id), optional(optional), stage_ptr(stage_ptr) {}
+         BaseStage *stage_ptr = nullptr, BaseStage::Priority priority = BaseStage::Priority::Normal) :
+        task(task), id(id), optional(optional), stage_ptr(stage_ptr), priority(priority) {}
 
     bool empty() const {
         return !static_cast<bool>(task);
@@ -36,14 +43,18 @@ struct Task {
         task();
     }
 
+    // the tasks of the stages of higher priority come first, then the ones produced first, the priority of a stage
+    // being fixed once the pipeline is started so that its tasks keep their order
     bool operator<(const Task &t) const {
-        return id > t.id;
+        return priority != t.priority ? priority > t.priority : id > t.id;
     }
 
     std::function<void()> task;
     size_t id;
     bool optional;
     BaseStage *stage_ptr;
+    BaseStage::Priority priority;
+    std::chrono::steady_clock::time_point scheduled_time;
 };
 
 class TaskQueue {
@@ -71,12 +82,27 @@ public:
         return t;
     }
 
+    // Waits until a task is available, the queue is cancelled or woken up, or the timeout has elapsed
+    void wait_for(std::chrono::milliseconds timeout) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cond_.wait_for(lock, timeout, [this]() { return !tasks_.empty() || cancel_ || woken_up_; });
+        woken_up_ = false;
+    }
+
+    void wake_up() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            woken_up_ = true;
+        }
+        cond_.notify_all();
+    }
+
     void cancel() {
         {
             std::lock_guard<std::mutex> lock(mutex_);
             cancel_ = true;
         }
-        cond_.notify_one();
+        cond_.notify_all();
     }
 
     void clear() {
@@ -97,6 +123,7 @@ public:
 
 private:
     std::atomic<bool> cancel_{false};
+    bool woken_up_ = false;
     mutable std::mutex mutex_;
     std::condition_variable cond_;
     std::priority_queue<Task> tasks_;
@@ -104,7 +131,12 @@ private:
 
 class Pipeline::TaskScheduler {
 public:
-    TaskScheduler() : running_(false), exited_(false), main_tasks_(std::make_unique<TaskQueue>()) {}
+    TaskScheduler(SchedulingPolicy policy = SchedulingPolicy::ThreadPerStage, size_t num_worker_threads = 0) :
+        running_(false),
+        exited_(false),
+        main_tasks_(std::make_unique<TaskQueue>()),
+        policy_(policy),
+        num_worker_threads_(num_worker_threads) {}
 
     ~TaskScheduler() {}
 
@@ -123,18 +155,28 @@ public:
         }
     }
 
-    void schedule(BaseStage &stage, const Task &task, bool schedule_on_main_thread = true) {
+    bool schedule(BaseStage &stage, Task task, bool schedule_on_main_thread = true) {
         if (!running_)
-            return;
+            return false;
+        MV_TRACE_SCOPE("Pipeline::schedule");
+        if (statistics_enabled_)
+            task.scheduled_time = std::chrono::steady_clock::now();
         if (schedule_on_main_thread) {
             if (std::this_thread::get_id() != main_thread_id_) {
                 {
                     std::lock_guard<std::mutex> lock(stage_tasks_mutex_);
                     ++stages_num_tasks_[&stage];
                 }
-                main_tasks_->push(task);
+                if (task.priority == BaseStage::Priority::Critical)
+                    ++num_critical_tasks_;
+                if (main_thread_wake_up_cb_) {
+                    main_tasks_->push(task);
+                    main_thread_wake_up_cb_();
+                } else {
+                    main_tasks_->push(task);
+                }
             } else {
-                task();
+                run(task);
                 complete_stage_if_done(*task.stage_ptr);
             }
         } else {
@@ -142,36 +184,84 @@ public:
                 std::lock_guard<std::mutex> lock(stage_tasks_mutex_);
                 ++stages_num_tasks_[&stage];
             }
+            if (task.priority == BaseStage::Priority::Critical)
+                ++num_critical_tasks_;
             size_t id = 0;
             {
                 std::lock_guard<std::mutex> lock(processing_map_id_mutex_);
                 auto it = processing_map_id_.find(&stage);
-                if (processing_map_id_.find(&stage) == processing_map_id_.end()) {
-                    id = processing_map_id_[&stage] = processing_current_map_id_++;
-                } else {
+                if (it != processing_map_id_.end()) {
                     id = it->second;
+                } else if (policy_ == SchedulingPolicy::WorkStealing) {
+                    id = processing_tasks_.size();
+                } else {
+                    id = processing_map_id_[&stage] = processing_current_map_id_++;
                 }
             }
+            if (id == processing_tasks_.size()) {
+                // the stage has no thread of its own, it is run by the pool of workers
+                schedule_on_worker(stage, task);
+                return true;
+            }
             processing_tasks_[id]->push(task);
         }
+        return true;
     }
 
     // no need for concurrent access checks or double start logic protection : this function
     // can only be called from Pipeline::start() which already does the controls
-    void init(bool main_thread_will_have_tasks, size_t num_processing_threads) {
+    void init(bool main_thread_will_have_tasks, const std::vector<BaseStage *> &detached_stages) {
         running_ = true;
 
         main_thread_will_have_tasks_ = main_thread_will_have_tasks;
-        processing_tasks_.resize(num_processing_threads);
+
+        // the stages run by a thread of their own are given one queue each, the others share the pool of workers
+        std::vector<ThreadPolicy> queue_policies;
+        size_t num_pooled_stages = 0;
+        for (auto *stage : detached_stages) {
+            if (stage->has_dedicated_thread()) {
+                processing_map_id_[stage] = processing_current_map_id_++;
+                queue_policies.push_back(stage->dedicated_thread_policy());
+            } else if (policy_ == SchedulingPolicy::ThreadPerStage) {
+                processing_map_id_[stage] = processing_current_map_id_++;
+                queue_policies.push_back(processing_thread_policy(queue_policies.size()));
+            } else {
+                ++num_pooled_stages;
+            }
+        }
+        processing_tasks_.resize(queue_policies.size());
         for (auto &q : processing_tasks_)
             q = std::make_unique<TaskQueue>();
-        processing_threads_.resize(num_processing_threads);
+
+        size_t num_workers = 0;
+        if (num_pooled_stages > 0) {
+            // a stage is only run by one worker at a time, more workers than stages would be idle
+            num_workers = num_worker_threads_ > 0 ?
+                              num_worker_threads_ :
+                              std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), num_pooled_stages);
+            worker_deques_.resize(num_workers);
+            for (auto &d : worker_deques_)
+                d = std::make_unique<detail::WorkStealingDeque<StageTasks *>>();
+        }
+
+        processing_thread_policies_ = std::move(queue_policies);
+        for (size_t i = 0; i < num_workers; ++i)
+            processing_thread_policies_.push_back(processing_thread_policy(processing_thread_policies_.size()));
+        processing_threads_.resize(processing_thread_policies_.size());
     }
 
     void start() {
-        size_t num_processing_threads = processing_threads_.size();
-        for (size_t i = 0; i < num_processing_threads; ++i) {
+        const size_t num_queues = processing_tasks_.size();
+        for (size_t i = 0; i < worker_deques_.size(); ++i) {
+            processing_threads_[num_queues + i] = std::thread([this, i, num_queues]() {
+                init_processing_thread(num_queues + i);
+                run_worker(i);
+            });
+        }
+
+        for (size_t i = 0; i < num_queues; ++i) {
             processing_threads_[i] = std::thread([this, i]() {
+                init_processing_thread(i);
                 while (running_) {
                     // This will get an already queued task or wait for one to be scheduled
                     // This will also return an empty task if a call to cancel() or exit() is
@@ -180,11 +270,11 @@ public:
                     Task task = processing_tasks_[i]->pop();
                     if (!task.empty()) {
                         if (!exited_ || !task.optional) {
-                            task();
+                            run(task);
                         }
                     }
 
-                    complete_stage_if_done(*task.stage_ptr, true);
+                    finish(task);
                 }
                 cancel();
             });
@@ -213,7 +303,7 @@ public:
             if (main_tasks_->empty()) {
                 // We have to be careful to not try to pop a task unless there really
                 // is one to pop, otherwise we could block forever
-                std::this_thread::yield();
+                wait_main_thread_events();
             } else {
                 // This will get an already queued task or wait for one to be scheduled
                 // This will also return an empty task if a call to cancel() or exit() is
@@ -222,27 +312,49 @@ public:
                 Task task = main_tasks_->pop();
                 if (!task.empty()) {
                     if (!exited_ || !task.optional) {
-                        task();
+                        run(task);
                     }
                 }
-                complete_stage_if_done(*task.stage_ptr, true);
+                finish(task);
             }
-        } else if (processing_tasks_.empty()) {
+        } else if (processing_threads_.empty()) {
             // We have no tasks to process at all
             cancel();
             return false;
         } else {
-            std::this_thread::yield();
+            wait_main_thread_events();
         }
         return true;
     }
 
+    // Wakes up the main thread if it is waiting in step(), can be called from any thread
+    void wake_up() {
+        if (main_thread_wake_up_cb_)
+            main_thread_wake_up_cb_();
+        main_tasks_->wake_up();
+    }
+
+    void set_main_thread_wait_callbacks(const MainThreadWaitCallback &wait_cb, const StepCallback &wake_up_cb) {
+        main_thread_wait_cb_    = wait_cb;
+        main_thread_wake_up_cb_ = wake_up_cb;
+    }
+
+    void set_step_timeout(std::chrono::milliseconds timeout) {
+        step_timeout_ = timeout;
+    }
+
     // no need for concurrent access checks, this function is thread safe
     void cancel() {
         running_ = false;
         main_tasks_->cancel();
+        if (main_thread_wake_up_cb_)
+            main_thread_wake_up_cb_();
         for (auto &q : processing_tasks_)
             q->cancel();
+        {
+            std::lock_guard<std::mutex> lock(workers_mutex_);
+        }
+        workers_cond_.notify_all();
     }
 
     // no need for concurrent access checks, this function is thread safe
@@ -258,6 +370,8 @@ public:
     bool empty() const {
         if (!main_tasks_->empty())
             return false;
+        if (num_worker_tasks_ != 0)
+            return false;
         for (auto &q : processing_tasks_) {
             if (!q->empty())
                 return false;
@@ -273,7 +387,223 @@ public:
         return main_thread_id_;
     }
 
+    void enable_statistics(bool enable) {
+        statistics_enabled_ = enable;
+    }
+
+    void set_thread_policy(const ThreadPolicy &policy) {
+        thread_policy_ = policy;
+    }
+
+    bool statistics_enabled() const {
+        return statistics_enabled_;
+    }
+
+    bool has_pending_critical_tasks() const {
+        return num_critical_tasks_ != 0;
+    }
+
 private:
+    // Pending tasks of a stage run by the workers, the stage being in at most one deque at a time so that its tasks
+    // are run sequentially and in order
+    struct StageTasks {
+        std::mutex mutex;
+        std::priority_queue<Task> tasks;
+        bool scheduled               = false;
+        BaseStage::Priority priority = BaseStage::Priority::Normal;
+    };
+
+    // Number of tasks a worker runs for a stage before rescheduling it, so that the other stages get a chance to run
+    static constexpr size_t MaxTasksPerTurn = 16;
+
+    struct WorkerContext {
+        const TaskScheduler *scheduler = nullptr;
+        size_t index                   = 0;
+    };
+
+    static WorkerContext &current_worker() {
+        static thread_local WorkerContext context;
+        return context;
+    }
+
+    void schedule_on_worker(BaseStage &stage, const Task &task) {
+        StageTasks *stage_tasks;
+        {
+            std::lock_guard<std::mutex> lock(processing_map_id_mutex_);
+            auto &ptr = stage_tasks_[&stage];
+            if (!ptr) {
+                ptr           = std::make_unique<StageTasks>();
+                ptr->priority = task.priority;
+            }
+            stage_tasks = ptr.get();
+        }
+
+        ++num_worker_tasks_;
+        bool needs_scheduling;
+        {
+            std::lock_guard<std::mutex> lock(stage_tasks->mutex);
+            stage_tasks->tasks.push(task);
+            needs_scheduling       = !stage_tasks->scheduled;
+            stage_tasks->scheduled = true;
+        }
+        if (needs_scheduling) {
+            submit(stage_tasks);
+        }
+    }
+
+    void submit(StageTasks *stage_tasks) {
+        const auto &worker = current_worker();
+        if (stage_tasks->priority == BaseStage::Priority::Critical) {
+            // shared by all the workers, so that the first available one runs the critical stage
+            std::lock_guard<std::mutex> lock(injected_stages_mutex_);
+            critical_stages_.push_back(stage_tasks);
+        } else if (worker.scheduler == this) {
+            worker_deques_[worker.index]->push(stage_tasks);
+        } else {
+            std::lock_guard<std::mutex> lock(injected_stages_mutex_);
+            injected_stages_.push_back(stage_tasks);
+        }
+
+        ++workers_epoch_;
+        if (num_sleeping_workers_ > 0) {
+            // the lock makes sure a worker can't miss the epoch change between its check and its wait
+            std::lock_guard<std::mutex> lock(workers_mutex_);
+            workers_cond_.notify_one();
+        }
+    }
+
+    StageTasks *find_work(size_t index) {
+        StageTasks *stage_tasks = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(injected_stages_mutex_);
+            if (!critical_stages_.empty()) {
+                stage_tasks = critical_stages_.front();
+                critical_stages_.pop_front();
+                return stage_tasks;
+            }
+        }
+        if (worker_deques_[index]->pop(stage_tasks)) {
+            return stage_tasks;
+        }
+        {
+            std::lock_guard<std::mutex> lock(injected_stages_mutex_);
+            if (!injected_stages_.empty()) {
+                stage_tasks = injected_stages_.front();
+                injected_stages_.pop_front();
+                return stage_tasks;
+            }
+        }
+        const size_t num_workers = worker_deques_.size();
+        for (size_t i = 1; i < num_workers; ++i) {
+            if (worker_deques_[(index + i) % num_workers]->steal(stage_tasks)) {
+                return stage_tasks;
+            }
+        }
+        return nullptr;
+    }
+
+    void run_stage_tasks(StageTasks &stage_tasks) {
+        for (size_t num_tasks = 0;; ++num_tasks) {
+            Task task;
+            {
+                std::lock_guard<std::mutex> lock(stage_tasks.mutex);
+                if (stage_tasks.tasks.empty() || !running_) {
+                    stage_tasks.scheduled = false;
+                    return;
+                }
+                // a best effort stage gives way to the critical ones after each task
+                if (num_tasks == MaxTasksPerTurn ||
+                    (num_tasks > 0 && stage_tasks.priority == BaseStage::Priority::BestEffort &&
+                     num_critical_tasks_ != 0)) {
+                    break;
+                }
+                task = stage_tasks.tasks.top();
+                stage_tasks.tasks.pop();
+            }
+
+            if (!exited_ || !task.optional) {
+                run(task);
+            }
+            --num_worker_tasks_;
+            finish(task);
+        }
+
+        // there are tasks left, the stage is still scheduled
+        submit(&stage_tasks);
+    }
+
+    // Policy of a processing thread not dedicated to a stage
+    ThreadPolicy processing_thread_policy(size_t index) const {
+        ThreadPolicy policy = thread_policy_;
+        if (!policy.name_.empty())
+            policy.name_ += "_" + std::to_string(index);
+        return policy;
+    }
+
+    void init_processing_thread(size_t index) {
+        const ThreadPolicy &policy     = processing_thread_policies_[index];
+        const std::string default_name = "mv_pipeline_" + std::to_string(index);
+        if (!apply_thread_policy(policy, default_name))
+            MV_SDK_LOG_WARNING() << "Failed to apply the threading policy of a pipeline processing thread";
+        MV_TRACE_THREAD_NAME(policy.name_.empty() ? default_name : policy.name_);
+    }
+
+    void run_worker(size_t index) {
+        current_worker() = {this, index};
+        while (running_) {
+            const size_t epoch = workers_epoch_;
+            if (StageTasks *stage_tasks = find_work(index)) {
+                run_stage_tasks(*stage_tasks);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(workers_mutex_);
+            ++num_sleeping_workers_;
+            workers_cond_.wait(lock, [this, epoch]() { return workers_epoch_ != epoch || !running_; });
+            --num_sleeping_workers_;
+        }
+        current_worker() = WorkerContext();
+        cancel();
+    }
+
+    // Blocks the main thread until it has a task to run, a stage completes, the pipeline is cancelled or the step
+    // timeout elapses, instead of spinning. With wait callbacks, e.g. of a UI event loop, the main thread waits for its
+    // own events and the tasks at the same time, being woken up by the wake up callback.
+    void wait_main_thread_events() {
+        if (main_thread_wait_cb_) {
+            if (running_ && main_tasks_->empty())
+                main_thread_wait_cb_(step_timeout_);
+        } else {
+            main_tasks_->wait_for(step_timeout_);
+        }
+    }
+
+    void run(const Task &task) {
+        MV_TRACE_SCOPE("Pipeline::execute");
+        if (!statistics_enabled_) {
+            task();
+            return;
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        task();
+        const auto end = std::chrono::steady_clock::now();
+        // the task may have been scheduled before the statistics were enabled
+        const auto queue_wait_time = task.scheduled_time == std::chrono::steady_clock::time_point() ?
+                                         std::chrono::steady_clock::duration::zero() :
+                                         start - task.scheduled_time;
+        task.stage_ptr->counters_.add_task(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(queue_wait_time).count(),
+            std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    }
+
+    // Accounts for the end of a task popped from a queue, whether it has been run or not
+    void finish(const Task &task) {
+        if (task.priority == BaseStage::Priority::Critical)
+            --num_critical_tasks_;
+        complete_stage_if_done(*task.stage_ptr, true);
+    }
+
     bool are_previous_stages_done(const BaseStage &stage) {
         bool done                   = true;
         const auto &prev_stage_ptrs = stage.previous_stages();
@@ -289,25 +619,52 @@ private:
 
     std::atomic<bool> running_;
     std::atomic<bool> exited_;
+    std::atomic<bool> statistics_enabled_{false};
+    std::atomic<size_t> num_critical_tasks_{0};
+    ThreadPolicy thread_policy_;
     std::unique_ptr<TaskQueue> main_tasks_;
     std::thread::id main_thread_id_;
+    std::chrono::milliseconds step_timeout_{10};
+    MainThreadWaitCallback main_thread_wait_cb_;
+    StepCallback main_thread_wake_up_cb_;
 
     std::mutex processing_map_id_mutex_;
     size_t processing_current_map_id_ = 0;
     std::unordered_map<BaseStage *, size_t> processing_map_id_;
 
+    // the threads running the queues of processing_tasks_, followed by the workers
     std::vector<std::unique_ptr<TaskQueue>> processing_tasks_;
     std::vector<std::thread> processing_threads_;
+    std::vector<ThreadPolicy> processing_thread_policies_;
 
     mutable std::mutex stage_tasks_mutex_;
     bool main_thread_will_have_tasks_;
     std::unordered_map<BaseStage *, size_t> stages_num_tasks_;
+
+    // Work stealing policy
+    const SchedulingPolicy policy_;
+    const size_t num_worker_threads_;
+    std::unordered_map<BaseStage *, std::unique_ptr<StageTasks>> stage_tasks_;
+    std::vector<std::unique_ptr<detail::WorkStealingDeque<StageTasks *>>> worker_deques_;
+    std::mutex injected_stages_mutex_;
+    std::deque<StageTasks *> injected_stages_;
+    std::deque<StageTasks *> critical_stages_;
+    std::atomic<size_t> num_worker_tasks_{0};
+    std::mutex workers_mutex_;
+    std::condition_variable workers_cond_;
+    std::atomic<size_t> workers_epoch_{0};
+    std::atomic<size_t> num_sleeping_workers_{0};
 };
 
 Pipeline::Pipeline(bool auto_detach) :
     auto_detach_stages_(auto_detach), scheduler_(std::make_unique<TaskScheduler>()) {}
 
+Pipeline::Pipeline(bool auto_detach, SchedulingPolicy policy, size_t num_worker_threads) :
+    auto_detach_stages_(auto_detach), scheduler_(std::make_unique<TaskScheduler>(policy, num_worker_threads)) {}
+
 Pipeline::~Pipeline() {
+    if (metrics_registered_)
+        MetricsRegistry::instance().remove(metrics_id_);
     cancel();
     step();
 }
@@ -330,6 +687,13 @@ Stage &Pipeline::add_stage(std::unique_ptr<Stage> &&stage, BaseStage &prev_stage
     return static_cast<Stage &>(add_stage_priv(std::move(stage)));
 }
 
+template<typename Stage, typename PrevStage, typename>
+Stage &Pipeline::add_stage(std::unique_ptr<Stage> &&stage, PrevStage &prev_stage) {
+    check_if_started();
+    stage->set_previous_stage(prev_stage);
+    return static_cast<Stage &>(add_stage_priv(std::move(stage)));
+}
+
 template<typename OutputEventType, typename InputEventType, typename Algorithm,
          typename std::enable_if_t<!is_base_stage<Algorithm> && !is_same_type<InputEventType, OutputEventType>, int>>
 AlgorithmStage<Algorithm, OutputEventType, InputEventType> &
@@ -408,19 +772,19 @@ void Pipeline::start() {
         scheduler_->set_main_thread_id(std::this_thread::get_id());
     }
     bool main_thread_will_have_tasks = false;
-    int num_processing_threads       = 0;
+    std::vector<BaseStage *> detached_stages;
     for (auto &stage : stages_) {
         // producing only stages don't count
         const auto &prev_stages = stage->previous_stages();
         if (!prev_stages.empty()) {
             if (stage->is_detached()) {
-                ++num_processing_threads;
+                detached_stages.push_back(stage.get());
             } else {
                 main_thread_will_have_tasks = true;
             }
         }
     }
-    scheduler_->init(main_thread_will_have_tasks, num_processing_threads);
+    scheduler_->init(main_thread_will_have_tasks, detached_stages);
     for (auto &stage : stages_) {
         stage->start();
     }
@@ -428,6 +792,10 @@ void Pipeline::start() {
 }
 
 void Pipeline::stop() {
+    // producers blocked on a full input queue must not prevent the stages from stopping
+    for (auto &stage_ptr : stages_) {
+        stage_ptr->close_inputs();
+    }
     for (auto &stage_ptr : stages_) {
         stage_ptr->stop();
     }
@@ -439,7 +807,9 @@ void Pipeline::stop() {
 }
 
 bool Pipeline::step() {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::unique_lock<std::mutex> lock(mutex_);
+    StatisticsCallback statistics_cb;
+    std::vector<StageStatistics> stats;
     if (status_ == Status::Inactive) {
         status_ = Status::Started;
         start();
@@ -456,6 +826,11 @@ bool Pipeline::step() {
     bool ret = true;
     if (status_ == Status::Cancelled || done) {
         stop();
+        // the pipeline may still be stepped once stopped, e.g. by its destructor
+        if (!stopped_) {
+            stopped_      = true;
+            statistics_cb = take_due_statistics(true, stats);
+        }
         ret = false;
     } else {
         for (const auto &pre_cb : pre_step_cbs_)
@@ -465,8 +840,15 @@ bool Pipeline::step() {
 
         for (const auto &post_cb : post_step_cbs_)
             post_cb();
+
+        statistics_cb = take_due_statistics(false, stats);
     }
 
+    // The statistics callback is called without the lock, so that it may use the pipeline
+    lock.unlock();
+    if (statistics_cb) {
+        statistics_cb(stats);
+    }
     return ret;
 }
 
@@ -480,7 +862,13 @@ void Pipeline::run() {
 void Pipeline::cancel() {
     // can be called concurrently, no need for a mutex
     status_ = Status::Cancelled;
+    {
+        // the sources waiting for the memory budget must not miss the cancellation
+        std::lock_guard<std::mutex> lock(memory_mutex_);
+    }
+    memory_cond_.notify_all();
     for (auto &stage_ptr : stages_) {
+        stage_ptr->close_inputs();
         if (stage_ptr->status() != BaseStage::Status::Completed) {
             stage_ptr->cancel();
         }
@@ -497,9 +885,158 @@ void Pipeline::add_post_step_callback(const StepCallback &cb) {
     post_step_cbs_.emplace_back(cb);
 }
 
-void Pipeline::schedule(BaseStage &stage, const std::function<void()> &task, size_t task_id, bool optional,
+void Pipeline::set_main_thread_wait_callbacks(const MainThreadWaitCallback &wait_cb, const StepCallback &wake_up_cb) {
+    check_if_started();
+    std::lock_guard<std::mutex> lock(mutex_);
+    scheduler_->set_main_thread_wait_callbacks(wait_cb, wake_up_cb);
+}
+
+void Pipeline::set_step_timeout(std::chrono::milliseconds timeout) {
+    check_if_started();
+    std::lock_guard<std::mutex> lock(mutex_);
+    scheduler_->set_step_timeout(timeout);
+}
+
+void Pipeline::wake_up() {
+    scheduler_->wake_up();
+}
+
+bool Pipeline::schedule(BaseStage &stage, const std::function<void()> &task, size_t task_id, bool optional,
                         bool schedule_on_main_thread) {
-    scheduler_->schedule(stage, {task, task_id, optional, &stage}, schedule_on_main_thread);
+    return scheduler_->schedule(stage, {task, task_id, optional, &stage, stage.priority()}, schedule_on_main_thread);
+}
+
+bool Pipeline::has_pending_critical_tasks() const {
+    return scheduler_->has_pending_critical_tasks();
+}
+
+void Pipeline::set_memory_budget(size_t max_bytes, MemoryBudgetPolicy policy) {
+    check_if_started();
+    memory_budget_        = max_bytes;
+    memory_budget_policy_ = policy;
+}
+
+size_t Pipeline::memory_usage() const {
+    return memory_usage_;
+}
+
+void Pipeline::add_memory_usage(size_t num_bytes) {
+    const size_t usage = memory_usage_ += num_bytes;
+    if (memory_budget_ != 0 && memory_budget_policy_ == MemoryBudgetPolicy::ShrinkPoolCaches &&
+        usage > memory_budget_ && usage - num_bytes <= memory_budget_) {
+        PoolRegistry::instance().shrink();
+    }
+}
+
+void Pipeline::remove_memory_usage(size_t num_bytes) {
+    const size_t usage = memory_usage_ -= num_bytes;
+    if (memory_budget_ != 0 && memory_budget_policy_ == MemoryBudgetPolicy::ThrottleSources &&
+        usage <= memory_budget_ && usage + num_bytes > memory_budget_) {
+        {
+            // the sources can't miss the notification between their check and their wait
+            std::lock_guard<std::mutex> lock(memory_mutex_);
+        }
+        memory_cond_.notify_all();
+    }
+}
+
+bool Pipeline::is_over_memory_budget(MemoryBudgetPolicy policy) const {
+    return memory_budget_ != 0 && memory_budget_policy_ == policy && memory_usage_ > memory_budget_;
+}
+
+void Pipeline::wait_for_memory_budget() {
+    // the stages run on the main thread must be able to consume the pending data
+    if (!is_over_memory_budget(MemoryBudgetPolicy::ThrottleSources) ||
+        std::this_thread::get_id() == scheduler_->main_thread_id())
+        return;
+    MV_TRACE_SCOPE("Pipeline::wait_for_memory_budget");
+    std::unique_lock<std::mutex> lock(memory_mutex_);
+    memory_cond_.wait(lock, [this] {
+        return !is_over_memory_budget(MemoryBudgetPolicy::ThrottleSources) || status_ == Status::Cancelled;
+    });
+}
+
+void Pipeline::set_thread_policy(const ThreadPolicy &policy) {
+    check_if_started();
+    scheduler_->set_thread_policy(policy);
+}
+
+void Pipeline::enable_statistics(bool enable) {
+    scheduler_->enable_statistics(enable);
+}
+
+bool Pipeline::statistics_enabled() const {
+    return scheduler_->statistics_enabled();
+}
+
+std::vector<StageStatistics> Pipeline::statistics() const {
+    std::vector<StageStatistics> stats(stages_.size());
+    for (size_t i = 0; i < stages_.size(); ++i) {
+        const auto &stage = *stages_[i];
+        stats[i].name     = stage.name();
+        if (stats[i].name.empty()) {
+            stats[i].name = "stage_" + std::to_string(i);
+        }
+        stage.counters_.fill(stats[i]);
+        stats[i].backlog     = stage.input_queue_size();
+        stats[i].num_dropped = stage.num_dropped_inputs();
+    }
+    return stats;
+}
+
+void Pipeline::set_statistics_callback(const StatisticsCallback &cb, std::chrono::milliseconds period) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    statistics_cb_        = cb;
+    statistics_period_    = period;
+    last_statistics_time_ = std::chrono::steady_clock::now();
+    if (cb) {
+        enable_statistics(true);
+    }
+}
+
+void Pipeline::register_metrics(const std::string &name) {
+    if (metrics_registered_)
+        MetricsRegistry::instance().remove(metrics_id_);
+    metrics_registered_ = true;
+    metrics_id_         = MetricsRegistry::instance().add([this, name](std::vector<MetricSample> &samples) {
+        const auto stats = statistics();
+        auto add_metric  = [&](const char *metric, const char *help, MetricSample::Type type, auto value_getter) {
+            for (const auto &s : stats)
+                samples.push_back({metric, help, type, {{"pipeline", name}, {"stage", s.name}},
+                                   static_cast<double>(value_getter(s))});
+        };
+        const auto counter = MetricSample::Type::Counter;
+        const auto gauge   = MetricSample::Type::Gauge;
+        add_metric("metavision_pipeline_stage_buffers_total", "Number of data consumed by the stage", counter,
+                   [](const StageStatistics &s) { return s.num_buffers; });
+        add_metric("metavision_pipeline_stage_events_total", "Number of events consumed by the stage", counter,
+                   [](const StageStatistics &s) { return s.num_events; });
+        add_metric("metavision_pipeline_stage_consume_seconds_total", "Time spent running the tasks of the stage",
+                   counter, [](const StageStatistics &s) { return s.consume_time_ns / 1e9; });
+        add_metric("metavision_pipeline_stage_latency_seconds_p50",
+                   "Median time from the scheduling of a task of the stage to its end", gauge,
+                   [](const StageStatistics &s) { return s.latency_p50_ns / 1e9; });
+        add_metric("metavision_pipeline_stage_latency_seconds_p99",
+                   "99th percentile of the time from the scheduling of a task to its end", gauge,
+                   [](const StageStatistics &s) { return s.latency_p99_ns / 1e9; });
+        add_metric("metavision_pipeline_stage_backlog", "Number of data waiting to be consumed by the stage", gauge,
+                   [](const StageStatistics &s) { return s.backlog; });
+        add_metric("metavision_pipeline_stage_dropped_total",
+                   "Number of data dropped because the input queue of the stage was full", counter,
+                   [](const StageStatistics &s) { return s.num_dropped; });
+    });
+}
+
+// Must be called with mutex_ locked. Returns a copy of the statistics callback to call with @p stats if they are due
+Pipeline::StatisticsCallback Pipeline::take_due_statistics(bool force, std::vector<StageStatistics> &stats) {
+    if (!statistics_cb_)
+        return StatisticsCallback();
+    const auto now = std::chrono::steady_clock::now();
+    if (!force && now - last_statistics_time_ < statistics_period_)
+        return StatisticsCallback();
+    last_statistics_time_ = now;
+    stats                 = statistics();
+    return statistics_cb_;
 }
 
 } // namespace Metavision
@@ -0,0 +1,132 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_DETAIL_STAGE_STATISTICS_IMPL_H
+#define METAVISION_SDK_CORE_DETAIL_STAGE_STATISTICS_IMPL_H
+
+#include <iomanip>
+
+namespace Metavision {
+namespace detail {
+
+inline void update_max(std::atomic<uint64_t> &max, uint64_t value) {
+    uint64_t current = max.load(std::memory_order_relaxed);
+    while (current < value && !max.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+}
+
+inline LatencyStatistics to_latency_statistics(const LatencyHistogram &histogram, uint64_t max_ns) {
+    LatencyStatistics stats;
+    for (size_t i = 0; i < LatencyHistogram::NumBuckets; ++i) {
+        stats.counts[i] = histogram.count(i);
+        stats.count += stats.counts[i];
+    }
+    stats.max_ns = max_ns;
+    return stats;
+}
+
+inline std::string escape_prometheus_label(const std::string &value) {
+    std::string escaped;
+    escaped.reserve(value.size());
+    for (char c : value) {
+        switch (c) {
+        case '\\':
+            escaped += "\\\\";
+            break;
+        case '"':
+            escaped += "\\\"";
+            break;
+        case '\n':
+            escaped += "\\n";
+            break;
+        default:
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+void StageCounters::add_task(uint64_t queue_wait_time_ns, uint64_t consume_time_ns) {
+    num_tasks.fetch_add(1, std::memory_order_relaxed);
+    this->queue_wait_time_ns.fetch_add(queue_wait_time_ns, std::memory_order_relaxed);
+    this->consume_time_ns.fetch_add(consume_time_ns, std::memory_order_relaxed);
+    update_max(max_queue_wait_time_ns, queue_wait_time_ns);
+    update_max(max_consume_time_ns, consume_time_ns);
+    consume_time_histogram.record_concurrent(consume_time_ns);
+    latency_histogram.record_concurrent(queue_wait_time_ns + consume_time_ns);
+}
+
+void StageCounters::add_buffer(uint64_t num_events) {
+    num_buffers.fetch_add(1, std::memory_order_relaxed);
+    this->num_events.fetch_add(num_events, std::memory_order_relaxed);
+}
+
+void StageCounters::fill(StageStatistics &stats) const {
+    stats.num_tasks              = num_tasks.load(std::memory_order_relaxed);
+    stats.num_buffers            = num_buffers.load(std::memory_order_relaxed);
+    stats.num_events             = num_events.load(std::memory_order_relaxed);
+    stats.queue_wait_time_ns     = queue_wait_time_ns.load(std::memory_order_relaxed);
+    stats.max_queue_wait_time_ns = max_queue_wait_time_ns.load(std::memory_order_relaxed);
+    stats.consume_time_ns        = consume_time_ns.load(std::memory_order_relaxed);
+    stats.max_consume_time_ns    = max_consume_time_ns.load(std::memory_order_relaxed);
+
+    const auto consume_times = to_latency_statistics(consume_time_histogram, stats.max_consume_time_ns);
+    const auto latencies =
+        to_latency_statistics(latency_histogram, stats.max_queue_wait_time_ns + stats.max_consume_time_ns);
+    stats.consume_time_p50_ns = consume_times.percentile(0.5);
+    stats.consume_time_p99_ns = consume_times.percentile(0.99);
+    stats.latency_p50_ns      = latencies.percentile(0.5);
+    stats.latency_p99_ns      = latencies.percentile(0.99);
+}
+
+} // namespace detail
+
+std::string to_prometheus_text(const std::vector<StageStatistics> &stats, const std::string &prefix) {
+    std::ostringstream oss;
+    oss << std::setprecision(12);
+    auto add_metric = [&](const std::string &name, const char *type, const char *help, auto value_getter) {
+        const std::string metric = prefix + "_" + name;
+        oss << "# HELP " << metric << " " << help << "\n";
+        oss << "# TYPE " << metric << " " << type << "\n";
+        for (const auto &s : stats) {
+            oss << metric << "{stage=\"" << detail::escape_prometheus_label(s.name) << "\"} " << value_getter(s)
+                << "\n";
+        }
+    };
+    auto to_seconds = [](uint64_t ns) { return ns / 1e9; };
+
+    add_metric("tasks_total", "counter", "Number of tasks run for the stage",
+               [](const StageStatistics &s) { return s.num_tasks; });
+    add_metric("buffers_total", "counter", "Number of data consumed by the stage",
+               [](const StageStatistics &s) { return s.num_buffers; });
+    add_metric("events_total", "counter", "Number of events consumed by the stage",
+               [](const StageStatistics &s) { return s.num_events; });
+    add_metric("queue_wait_seconds_total", "counter", "Time spent by the tasks of the stage waiting to be run",
+               [&](const StageStatistics &s) { return to_seconds(s.queue_wait_time_ns); });
+    add_metric("queue_wait_seconds_max", "gauge", "Longest time spent by a task of the stage waiting to be run",
+               [&](const StageStatistics &s) { return to_seconds(s.max_queue_wait_time_ns); });
+    add_metric("consume_seconds_total", "counter", "Time spent running the tasks of the stage",
+               [&](const StageStatistics &s) { return to_seconds(s.consume_time_ns); });
+    add_metric("consume_seconds_max", "gauge", "Longest time spent running a task of the stage",
+               [&](const StageStatistics &s) { return to_seconds(s.max_consume_time_ns); });
+    add_metric("latency_seconds_p50", "gauge", "Median time from the scheduling of a task of the stage to its end",
+               [&](const StageStatistics &s) { return to_seconds(s.latency_p50_ns); });
+    add_metric("latency_seconds_p99", "gauge", "99th percentile of the time from the scheduling of a task to its end",
+               [&](const StageStatistics &s) { return to_seconds(s.latency_p99_ns); });
+    add_metric("backlog", "gauge", "Number of data waiting to be consumed by the stage",
+               [](const StageStatistics &s) { return s.backlog; });
+    add_metric("dropped_total", "counter", "Number of data dropped because the input queue of the stage was full",
+               [](const StageStatistics &s) { return s.num_dropped; });
+    return oss.str();
+}
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_CORE_DETAIL_STAGE_STATISTICS_IMPL_H
@@ -0,0 +1,265 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_EVENT_MERGING_STAGE_H
+#define METAVISION_SDK_CORE_EVENT_MERGING_STAGE_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+#include <boost/any.hpp>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/core/pipeline/base_stage.h"
+
+namespace Metavision {
+
+/// @brief Stage that merges the buffers of events produced by several previous stages into buffers sorted by timestamp
+///
+/// Each previous stage (e.g. a @ref CameraStage per camera of a stereo or multi-view setup) is a source of
+/// @ref BaseStage::EventBufferPtr whose events are sorted by timestamp. The timestamp of the last event received from a
+/// source is its watermark: the events older than the watermarks of all the sources can't be preceded by events still
+/// to come, they are merged and produced in a @ref MergedBufferPtr taken from a bounded pool, along with the index of
+/// the source of each event. The events of the same timestamp are ordered by source index.
+///
+/// As a source producing no events would hold the merge back, the latency can be bounded: the events are then merged
+/// as soon as they are older than the watermark of the most advanced source minus the maximum latency, and the events
+/// of a lagging source older than the ones already merged are dropped (see @ref num_late_events).
+/// The remaining events are merged when all the sources have completed.
+class EventMergingStage : public BaseStage {
+public:
+    /// @brief Buffer of events merged from several sources
+    struct MergedBuffer {
+        /// Events of all the sources, sorted by timestamp
+        std::vector<EventCD> events;
+
+        /// Index of the source of each event (see @ref add_source)
+        std::vector<uint16_t> source_indices;
+    };
+
+    using MergedBufferPool = SharedObjectPool<MergedBuffer>;
+    using MergedBufferPtr  = MergedBufferPool::ptr_type;
+
+    /// @brief Constructor
+    /// @param max_latency Maximum time the events are held waiting for the sources lagging behind the most advanced
+    /// one, in us. If 0, the events are held until all the sources have produced more recent ones or have completed
+    EventMergingStage(timestamp max_latency = 0) :
+        max_latency_(max_latency), merged_buffer_pool_(MergedBufferPool::make_bounded()) {
+        if (max_latency < 0) {
+            throw std::invalid_argument("EventMergingStage: the maximum latency can not be negative.");
+        }
+        merged_buffer_pool_.register_statistics("EventMergingStage buffers");
+
+        set_consuming_callback([this](BaseStage &prev_stage, const boost::any &data) {
+            if (auto *buffer = boost::any_cast<EventBufferPtr>(&data)) {
+                consume_events(source(prev_stage), *buffer);
+            }
+        });
+        set_receiving_callback([this](BaseStage &prev_stage, const NotificationType &type, const boost::any &) {
+            if (type == NotificationType::Status && prev_stage.status() == Status::Completed) {
+                source(prev_stage).completed = true;
+                merge();
+            }
+        });
+    }
+
+    /// @brief Constructor
+    /// @param prev_stages Previous stages, the sources of the events, whose indices are their positions in the vector
+    /// @param max_latency Maximum time the events are held waiting for the sources lagging behind the most advanced
+    /// one, in us, see @ref EventMergingStage(timestamp)
+    EventMergingStage(const std::vector<std::reference_wrapper<BaseStage>> &prev_stages, timestamp max_latency = 0) :
+        EventMergingStage(max_latency) {
+        for (auto &prev_stage : prev_stages) {
+            add_source(prev_stage);
+        }
+    }
+
+    /// @brief Adds a previous stage as a source of events
+    ///
+    /// The previous stages set otherwise (e.g. with @ref set_previous_stage) are given the next indices, in an
+    /// unspecified order, when their first data is consumed.
+    /// @param prev_stage Previous stage producing buffers of events sorted by timestamp
+    /// @return Index of the source, given along with its events in the merged buffers
+    size_t add_source(BaseStage &prev_stage) {
+        set_previous_stage(prev_stage);
+        return source_index(prev_stage);
+    }
+
+    /// @brief Gets the number of events dropped because they were older than the ones already merged
+    /// @return The number of late events, always 0 if the latency is not bounded
+    size_t num_late_events() const {
+        return num_late_events_;
+    }
+
+private:
+    // Events received from a previous stage and not merged yet, the first buffer being partially merged
+    struct Source {
+        std::deque<EventBufferPtr> buffers;
+        size_t offset       = 0;
+        timestamp watermark = std::numeric_limits<timestamp>::min();
+        bool completed      = false;
+        uint16_t index      = 0;
+
+        bool has_events() const {
+            return !buffers.empty();
+        }
+
+        timestamp head() const {
+            return (*buffers.front())[offset].t;
+        }
+    };
+
+    size_t source_index(const BaseStage &prev_stage) {
+        auto it = source_indices_.find(&prev_stage);
+        if (it != source_indices_.end()) {
+            return it->second;
+        }
+        if (sources_.size() > std::numeric_limits<uint16_t>::max()) {
+            throw std::runtime_error("EventMergingStage: too many sources.");
+        }
+        sources_.emplace_back();
+        sources_.back().index = static_cast<uint16_t>(sources_.size() - 1);
+        // the heap holds at most one entry per source
+        heap_.reserve(sources_.size());
+        source_indices_[&prev_stage] = sources_.size() - 1;
+        return sources_.size() - 1;
+    }
+
+    Source &source(const BaseStage &prev_stage) {
+        return sources_[source_index(prev_stage)];
+    }
+
+    void consume_events(Source &src, const EventBufferPtr &buffer) {
+        if (!buffer || buffer->empty()) {
+            return;
+        }
+        src.watermark = std::max(src.watermark, buffer->back().t);
+        // the events older than the ones already merged are dropped
+        auto first = buffer->cbegin();
+        if (buffer->front().t < merged_until_) {
+            first = std::lower_bound(buffer->cbegin(), buffer->cend(), merged_until_,
+                                     [](const EventCD &ev, timestamp t) { return ev.t < t; });
+            num_late_events_ += std::distance(buffer->cbegin(), first);
+        }
+        if (first != buffer->cend()) {
+            if (src.buffers.empty()) {
+                src.offset = std::distance(buffer->cbegin(), first);
+            }
+            src.buffers.push_back(buffer);
+        }
+        merge();
+    }
+
+    // Timestamp before which all the events to come are known
+    timestamp merge_bound() const {
+        timestamp bound         = std::numeric_limits<timestamp>::max();
+        timestamp max_watermark = std::numeric_limits<timestamp>::min();
+        for (const auto &src : sources_) {
+            if (!src.completed) {
+                bound = std::min(bound, src.watermark);
+            }
+            max_watermark = std::max(max_watermark, src.watermark);
+        }
+        if (max_latency_ > 0 && max_watermark != std::numeric_limits<timestamp>::min()) {
+            bound = std::max(bound, max_watermark - max_latency_);
+        }
+        return bound;
+    }
+
+    void merge() {
+        const timestamp bound = merge_bound();
+        if (bound <= merged_until_) {
+            return;
+        }
+
+        // min-heap of the sources by timestamp of their next event, then by index
+        auto greater = [this](size_t a, size_t b) {
+            const timestamp ta = sources_[a].head(), tb = sources_[b].head();
+            return ta != tb ? ta > tb : a > b;
+        };
+        heap_.clear();
+        for (size_t i = 0; i < sources_.size(); ++i) {
+            if (sources_[i].has_events() && sources_[i].head() < bound) {
+                heap_.push_back(i);
+            }
+        }
+        std::make_heap(heap_.begin(), heap_.end(), greater);
+
+        MergedBufferPtr merged;
+        while (!heap_.empty()) {
+            std::pop_heap(heap_.begin(), heap_.end(), greater);
+            Source &src = sources_[heap_.back()];
+            heap_.pop_back();
+
+            // the events of the source are taken until the next event of another source or the bound
+            timestamp limit     = bound;
+            bool includes_limit = false;
+            if (!heap_.empty()) {
+                const Source &next = sources_[heap_.front()];
+                if (next.head() < bound) {
+                    limit          = next.head();
+                    includes_limit = src.index < next.index;
+                }
+            }
+
+            if (!merged) {
+                merged = merged_buffer_pool_.acquire();
+                merged->events.clear();
+                merged->source_indices.clear();
+            }
+            while (src.has_events()) {
+                const auto &buffer = *src.buffers.front();
+                const auto begin   = buffer.cbegin() + src.offset;
+                const auto end     = includes_limit ?
+                                         std::upper_bound(begin, buffer.cend(), limit,
+                                                          [](timestamp t, const EventCD &ev) { return t < ev.t; }) :
+                                         std::lower_bound(begin, buffer.cend(), limit,
+                                                          [](const EventCD &ev, timestamp t) { return ev.t < t; });
+                merged->events.insert(merged->events.end(), begin, end);
+                merged->source_indices.insert(merged->source_indices.end(), std::distance(begin, end), src.index);
+                if (end != buffer.cend()) {
+                    src.offset = std::distance(buffer.cbegin(), end);
+                    break;
+                }
+                src.buffers.pop_front();
+                src.offset = 0;
+            }
+
+            if (src.has_events() && src.head() < bound) {
+                heap_.push_back(src.index);
+                std::push_heap(heap_.begin(), heap_.end(), greater);
+            }
+        }
+
+        merged_until_ = bound;
+        if (merged && !merged->events.empty()) {
+            produce(merged);
+        }
+    }
+
+    const timestamp max_latency_;
+    MergedBufferPool merged_buffer_pool_;
+    std::vector<Source> sources_;
+    std::unordered_map<const BaseStage *, size_t> source_indices_;
+    std::vector<size_t> heap_;
+    timestamp merged_until_ = std::numeric_limits<timestamp>::min();
+    std::atomic<size_t> num_late_events_{0};
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_CORE_EVENT_MERGING_STAGE_H
@@ -0,0 +1,164 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_EVENT_REORDERING_STAGE_H
+#define METAVISION_SDK_CORE_EVENT_REORDERING_STAGE_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+#include <boost/any.hpp>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/core/pipeline/base_stage.h"
+
+namespace Metavision {
+
+/// @brief Stage that sorts by timestamp the events of a source producing them slightly out of order (e.g. events
+/// gathered from several links or threads, or resent over a network), holding them at most for a bounded lateness
+///
+/// The events received are held until the most recent timestamp received minus the maximum lateness: they can't be
+/// preceded by events still to come, and are produced sorted by timestamp, the events of the same timestamp keeping
+/// their order of arrival. The events arriving after more recent events have been produced are dropped (see
+/// @ref num_late_events). The remaining events are produced when the previous stage has completed.
+///
+/// The events received are split into their runs of sorted events, merged with each other and with the events held.
+/// On already sorted data, there is a single run following the events held, which is only appended to them.
+class EventReorderingStage : public BaseStage {
+public:
+    /// @brief Constructor
+    /// @param max_lateness Maximum time an event can arrive after a more recent one, in us. If 0, the events are only
+    /// held until an event of a more recent timestamp is received
+    /// @throw std::invalid_argument if the maximum lateness is negative
+    EventReorderingStage(timestamp max_lateness) :
+        max_lateness_(max_lateness), event_buffer_pool_(EventBufferPool::make_bounded()) {
+        if (max_lateness < 0) {
+            throw std::invalid_argument("EventReorderingStage: the maximum lateness can not be negative.");
+        }
+        event_buffer_pool_.register_statistics("EventReorderingStage buffers");
+
+        set_consuming_callback([this](const boost::any &data) {
+            if (auto *buffer = boost::any_cast<EventBufferPtr>(&data)) {
+                consume_events(*buffer);
+            }
+        });
+        set_receiving_callback([this](BaseStage &prev_stage, const NotificationType &type, const boost::any &) {
+            if (type == NotificationType::Status && prev_stage.status() == Status::Completed) {
+                produce_events(std::numeric_limits<timestamp>::max());
+            }
+        });
+    }
+
+    /// @brief Constructor
+    ///
+    /// Overload constructor that simplifies setting the previous stage.
+    /// @param prev_stage Previous stage producing the buffers of events to sort
+    /// @param max_lateness Maximum time an event can arrive after a more recent one, in us
+    EventReorderingStage(BaseStage &prev_stage, timestamp max_lateness) : EventReorderingStage(max_lateness) {
+        set_previous_stage(prev_stage);
+    }
+
+    /// @brief Gets the number of events dropped because they arrived later than the maximum lateness
+    size_t num_late_events() const {
+        return num_late_events_;
+    }
+
+    /// @brief Gets the number of events received after a more recent one and sorted, not including the late events
+    size_t num_reordered_events() const {
+        return num_reordered_events_;
+    }
+
+private:
+    void consume_events(const EventBufferPtr &buffer) {
+        if (!buffer || buffer->empty()) {
+            return;
+        }
+
+        // Appends the events not late, noting where each run of sorted events starts, the events held being the
+        // first run
+        run_begins_.clear();
+        run_begins_.push_back(0);
+        size_t num_late = 0, num_reordered = 0;
+        timestamp last  = events_.empty() ? std::numeric_limits<timestamp>::min() : events_.back().t;
+        for (const auto &ev : *buffer) {
+            max_t_ = std::max(max_t_, ev.t);
+            if (ev.t < produced_until_) {
+                ++num_late;
+                continue;
+            }
+            if (ev.t < last) {
+                ++num_reordered;
+                run_begins_.push_back(events_.size());
+            }
+            events_.push_back(ev);
+            last = ev.t;
+        }
+        run_begins_.push_back(events_.size());
+        num_late_events_ += num_late;
+        num_reordered_events_ += num_reordered;
+
+        // Merges the runs pairwise until a single one remains
+        while (run_begins_.size() > 2) {
+            size_t num_begins = 0;
+            for (size_t i = 0; i + 2 < run_begins_.size(); i += 2) {
+                merge_runs(run_begins_[i], run_begins_[i + 1], run_begins_[i + 2]);
+                run_begins_[num_begins++] = run_begins_[i];
+            }
+            if (run_begins_.size() % 2 == 0) {
+                // odd number of runs, the last one is merged at the next pass
+                run_begins_[num_begins++] = run_begins_[run_begins_.size() - 2];
+            }
+            run_begins_[num_begins++] = events_.size();
+            run_begins_.resize(num_begins);
+        }
+
+        produce_events(max_t_ - max_lateness_);
+    }
+
+    // Merges two consecutive runs of sorted events, only moving the events of the first run more recent than the
+    // first event of the second one
+    void merge_runs(size_t begin, size_t middle, size_t end) {
+        auto first = std::upper_bound(events_.begin() + begin, events_.begin() + middle, events_[middle].t,
+                                      [](timestamp t, const EventCD &ev) { return t < ev.t; });
+        std::inplace_merge(first, events_.begin() + middle, events_.begin() + end,
+                           [](const EventCD &a, const EventCD &b) { return a.t < b.t; });
+    }
+
+    // Produces the events held older than a timestamp
+    void produce_events(timestamp until) {
+        auto end = std::lower_bound(events_.begin(), events_.end(), until,
+                                    [](const EventCD &ev, timestamp t) { return ev.t < t; });
+        produced_until_ = std::max(produced_until_, until);
+        if (end == events_.begin()) {
+            return;
+        }
+        auto buffer = event_buffer_pool_.acquire();
+        buffer->assign(events_.begin(), end);
+        events_.erase(events_.begin(), end);
+        produce(buffer);
+    }
+
+    const timestamp max_lateness_;
+    EventBufferPool event_buffer_pool_;
+    std::vector<EventCD> events_;
+    std::vector<size_t> run_begins_;
+    timestamp max_t_          = std::numeric_limits<timestamp>::min();
+    timestamp produced_until_ = std::numeric_limits<timestamp>::min();
+    std::atomic<size_t> num_late_events_{0};
+    std::atomic<size_t> num_reordered_events_{0};
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_CORE_EVENT_REORDERING_STAGE_H
@@ -42,14 +42,15 @@ public:
         // which uses a lot of memory, and makes real-time interactions weird (due to the
         // interaction operating on frames which will be displayed only much later)
         frame_pool_(FramePool::make_bounded(2)) {
+        frame_pool_.register_statistics("FrameGenerationStage frames");
         const uint32_t accumulation_time_us = accumulation_time_ms * 1000;
         algo_ = std::make_unique<PeriodicFrameGenerationAlgorithm>(width, height, accumulation_time_us, fps, palette);
-        algo_->set_output_callback([this](const timestamp ts, cv::Mat &f) {
-            crt_frame_ptr_ = frame_pool_.acquire();
-            cv::swap(f, *crt_frame_ptr_);
-
-            produce(std::make_pair(ts, crt_frame_ptr_));
-        });
+        algo_->set_pooled_output_callback(
+            [this](const timestamp ts, const FramePtr &f) {
+                crt_frame_ptr_ = f;
+                produce(std::make_pair(ts, crt_frame_ptr_));
+            },
+            frame_pool_);
 
         set_consuming_callback([this](const boost::any &data) { consume_cd_events(data); });
     }
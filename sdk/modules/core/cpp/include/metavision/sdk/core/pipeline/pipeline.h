@@ -12,15 +12,20 @@
 #ifndef METAVISION_SDK_CORE_PIPELINE_H
 #define METAVISION_SDK_CORE_PIPELINE_H
 
+#include <chrono>
+#include <condition_variable>
 #include <memory>
 #include <mutex>
 #include <atomic>
 #include <queue>
+#include <string>
 #include <vector>
 #include <functional>
 #include <unordered_map>
 
 #include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/base/utils/thread_policy.h"
+#include "metavision/sdk/core/pipeline/stage_statistics.h"
 
 namespace Metavision {
 
@@ -39,11 +44,32 @@ class Pipeline {
     class TaskScheduler;
 
 public:
+    /// @brief Enum class representing how the detached stages are run
+    enum class SchedulingPolicy {
+        /// each detached stage is run by its own processing thread
+        ThreadPerStage,
+        /// the detached stages are run by a pool of worker threads, idle workers stealing the pending stages of the
+        /// busy ones
+        WorkStealing
+    };
+
     /// @brief Constructor
     /// @param auto_detach If true, each stage added to the pipeline will automatically be detached (@ref
     /// BaseStage::detach)
     inline Pipeline(bool auto_detach = false);
 
+    /// @brief Constructor
+    ///
+    /// Whatever the policy, the tasks of a stage are never run concurrently, and are run in the order the data has
+    /// been produced.
+    /// @param auto_detach If true, each stage added to the pipeline will automatically be detached (@ref
+    /// BaseStage::detach)
+    /// @param policy Policy used to run the detached stages
+    /// @param num_worker_threads Number of worker threads used with @ref SchedulingPolicy::WorkStealing. If 0, the
+    /// number of cores is used, without exceeding the number of detached stages. The stages given a dedicated thread
+    /// (see @ref BaseStage::set_dedicated_thread) are not run by the workers, whatever the policy
+    inline Pipeline(bool auto_detach, SchedulingPolicy policy, size_t num_worker_threads = 0);
+
     /// @brief Destructor
     ///
     /// The destructor ensures that the pipeline is stopped by calling @ref cancel
@@ -71,6 +97,20 @@ public:
     template<typename Stage, typename = std::enable_if_t<std::is_base_of<BaseStage, Stage>::value>>
     Stage &add_stage(std::unique_ptr<Stage> &&stage, BaseStage &prev_stage);
 
+    /// @brief Adds a stage to the pipeline
+    ///
+    /// Overload used when the type of the previous stage is known, so that the connections between @ref TypedStage
+    /// are checked at compile time and pass the data without type erasure
+    ///
+    /// @param stage Stage to add
+    /// @param prev_stage Previous stage
+    /// @return @ref Stage "Stage&" The added stage
+    template<typename Stage, typename PrevStage,
+             typename = std::enable_if_t<std::is_base_of<BaseStage, Stage>::value &&
+                                         std::is_base_of<BaseStage, PrevStage>::value &&
+                                         !std::is_same<BaseStage, PrevStage>::value>>
+    Stage &add_stage(std::unique_ptr<Stage> &&stage, PrevStage &prev_stage);
+
     /// @brief Adds a stage that wraps an algorithm as the consuming callback to the pipeline
     ///
     /// Convenience overload
@@ -204,6 +244,8 @@ public:
     /// This actually runs one of the scheduled callback on the main thread.
     /// The processing threads runs on their own, but can be blocked by the main
     /// thread if one stage needs to run on the main thread.
+    /// If there is no callback to run on the main thread, this waits for one to be scheduled, for a stage to complete
+    /// or for the pipeline to be cancelled, at most for the step timeout (see @ref set_step_timeout).
     /// @return true if the step was successful, false if the pipeline has no remaining steps to run
     inline bool step();
 
@@ -237,22 +279,136 @@ public:
     /// @warning This method cannot be called from a step callback
     inline void add_post_step_callback(const StepCallback &cb);
 
+    /// @brief A Callback making the main thread wait for its own events, e.g. the ones of a UI, at most a given time
+    using MainThreadWaitCallback = std::function<void(std::chrono::milliseconds)>;
+
+    /// @brief Sets callbacks so that the main thread waits for the callbacks to run and for its own events at once
+    ///
+    /// When the main thread has nothing to run, @ref step waits on a condition variable by default. With these
+    /// callbacks, it calls @p wait_cb instead, e.g. to wait for the events of a UI event loop, and @p wake_up_cb is
+    /// called from any thread to interrupt the wait when a callback is scheduled on the main thread, a stage completes
+    /// or the pipeline is cancelled.
+    /// @param wait_cb Callback waiting at most the given time, called on the thread stepping the pipeline
+    /// @param wake_up_cb Callback interrupting the wait, which may be called before the wait starts, in which case the
+    /// next wait must return immediately
+    /// @throw std::runtime_error if the pipeline has already started
+    inline void set_main_thread_wait_callbacks(const MainThreadWaitCallback &wait_cb, const StepCallback &wake_up_cb);
+
+    /// @brief Sets the maximum time @ref step waits when the main thread has nothing to run
+    ///
+    /// The step callbacks and the statistics callback are hence called at least at this period. Defaults to 10 ms.
+    /// @param timeout Maximum time to wait
+    /// @throw std::runtime_error if the pipeline has already started
+    inline void set_step_timeout(std::chrono::milliseconds timeout);
+
+    /// @brief Sets the threading policy of the processing threads of the pipeline
+    ///
+    /// Unless the policy gives a name, the processing threads are named "mv_pipeline_<i>", <i> being the index of the
+    /// thread. Otherwise, the index is appended to the given name. The threads dedicated to a stage have the policy
+    /// given to @ref BaseStage::set_dedicated_thread instead.
+    /// @param policy The threading policy
+    /// @throw std::runtime_error if the pipeline has already started
+    inline void set_thread_policy(const ThreadPolicy &policy);
+
+    /// @brief Enables the measurement of the time spent by the tasks of the stages
+    ///
+    /// The numbers of consumed data and the backlogs are always available in the statistics, enabling the statistics
+    /// adds the time spent by the tasks in the queues of the stages and the time spent running them, at the cost of
+    /// reading the clock for each task.
+    /// @param enable True to enable the measurement of the times, false to disable it
+    inline void enable_statistics(bool enable = true);
+
+    /// @brief Checks if the time spent by the tasks of the stages is measured
+    /// @return true if the statistics are enabled, false otherwise
+    inline bool statistics_enabled() const;
+
+    /// @brief Gets a snapshot of the statistics of the stages
+    /// @return The statistics of each stage, in the order the stages were added
+    /// @warning This method must not be called concurrently with @ref add_stage or @ref remove_stage
+    inline std::vector<StageStatistics> statistics() const;
+
+    /// @brief A Callback called periodically with the statistics of the stages
+    using StatisticsCallback = std::function<void(const std::vector<StageStatistics> &)>;
+
+    /// @brief Sets a callback called periodically with the statistics of the stages, which enables them
+    ///
+    /// The callback is called after the pipeline steps, on the thread stepping the pipeline, when at least @p period
+    /// has elapsed since the last call. It is called one last time when the pipeline stops.
+    /// @param cb The callback to call, use @ref to_prometheus_text to format the statistics for Prometheus
+    /// @param period The minimum time between two calls
+    /// @warning This method cannot be called from a step callback
+    inline void set_statistics_callback(const StatisticsCallback &cb, std::chrono::milliseconds period);
+
+    /// @brief Registers the statistics of the stages in the @ref MetricsRegistry, until the pipeline is destroyed
+    ///
+    /// The statistics are reported with the labels pipeline=name and stage=<name of the stage>, see @ref statistics.
+    /// The times are only measured when the statistics are enabled, see @ref enable_statistics.
+    /// @param name Name of the pipeline in the metrics
+    /// @warning The stages must all be added before the registration
+    inline void register_metrics(const std::string &name);
+
+    /// @brief Enum class representing the policy applied when the data pending in the stages exceed the memory budget
+    enum class MemoryBudgetPolicy {
+        /// the stages without previous stage (e.g. a camera stage) wait before producing data until enough of the
+        /// pending data have been consumed
+        ThrottleSources,
+        /// the data produced for the best effort stages (see @ref BaseStage::Priority::BestEffort) are coalesced with
+        /// their pending data, so that they only hold the most recent data
+        DropBestEffortInputs,
+        /// the objects not in use of the pools registered in the @ref PoolRegistry are freed whenever the budget is
+        /// exceeded
+        ShrinkPoolCaches
+    };
+
+    /// @brief Sets the budget of the memory held by the data produced by the stages and not yet consumed
+    ///
+    /// The memory of the buffers of events (@ref BaseStage::EventBufferPtr and @ref BaseStage::EventBuffer) waiting in
+    /// the input queues of the stages is accounted for, a buffer being counted once for each stage it is produced for.
+    /// The data passed between @ref TypedStage through their bounded channels are not accounted for. Whenever the
+    /// budget is exceeded, @p policy is applied until enough data have been consumed.
+    /// @param max_bytes Maximum number of bytes held by the pending data, 0 for no budget
+    /// @param policy The policy applied when the budget is exceeded
+    /// @throw std::runtime_error if the pipeline has already started
+    inline void set_memory_budget(size_t max_bytes, MemoryBudgetPolicy policy = MemoryBudgetPolicy::ThrottleSources);
+
+    /// @brief Gets the memory held by the data produced by the stages and not yet consumed
+    /// @return The number of bytes held by the pending data, see @ref set_memory_budget
+    inline size_t memory_usage() const;
+
 private:
     inline BaseStage &add_stage_priv(std::unique_ptr<BaseStage> &&stage);
     inline void check_if_started();
 
     inline void start();
     inline void stop();
-    inline void schedule(BaseStage &stage, const std::function<void()> &task, size_t task_id, bool optional,
+    inline StatisticsCallback take_due_statistics(bool force, std::vector<StageStatistics> &stats);
+    inline void wake_up();
+    inline bool has_pending_critical_tasks() const;
+    inline void add_memory_usage(size_t num_bytes);
+    inline void remove_memory_usage(size_t num_bytes);
+    inline bool is_over_memory_budget(MemoryBudgetPolicy policy) const;
+    inline void wait_for_memory_budget();
+    inline bool schedule(BaseStage &stage, const std::function<void()> &task, size_t task_id, bool optional,
                          bool schedule_on_main_thread = true);
 
     bool auto_detach_stages_ = false;
     std::mutex mutex_;
     std::atomic<Status> status_{Status::Inactive};
+    bool stopped_ = false;
     std::vector<std::unique_ptr<BaseStage>> stages_;
     std::vector<StepCallback> pre_step_cbs_;
     std::vector<StepCallback> post_step_cbs_;
+    StatisticsCallback statistics_cb_;
+    std::chrono::milliseconds statistics_period_{0};
+    std::chrono::steady_clock::time_point last_statistics_time_;
+    size_t metrics_id_       = 0;
+    bool metrics_registered_ = false;
     std::unique_ptr<TaskScheduler> scheduler_;
+    size_t memory_budget_                    = 0;
+    MemoryBudgetPolicy memory_budget_policy_ = MemoryBudgetPolicy::ThrottleSources;
+    std::atomic<size_t> memory_usage_{0};
+    std::mutex memory_mutex_;
+    std::condition_variable memory_cond_;
 
     friend class BaseStage;
 };
@@ -0,0 +1,123 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_STAGE_STATISTICS_H
+#define METAVISION_SDK_CORE_STAGE_STATISTICS_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "metavision/sdk/core/utils/detail/timing_profiler_detail.h"
+
+namespace Metavision {
+
+/// @brief Statistics of a stage run by a @ref Pipeline
+///
+/// The times are only measured when the statistics are enabled with @ref Pipeline::enable_statistics
+struct StageStatistics {
+    /// Name of the stage, see @ref BaseStage::set_name
+    std::string name;
+    /// Number of tasks run for the stage, i.e. data consumed and notifications received
+    uint64_t num_tasks = 0;
+    /// Number of data consumed by the stage
+    uint64_t num_buffers = 0;
+    /// Number of elements of the consumed buffers, e.g. the events of a @ref BaseStage::EventBufferPtr
+    uint64_t num_events = 0;
+    /// Total time spent by the tasks between being scheduled and being run, in nanoseconds
+    uint64_t queue_wait_time_ns = 0;
+    /// Longest time spent by a task between being scheduled and being run, in nanoseconds
+    uint64_t max_queue_wait_time_ns = 0;
+    /// Total time spent running the tasks, in nanoseconds
+    uint64_t consume_time_ns = 0;
+    /// Longest time spent running a task, in nanoseconds
+    uint64_t max_consume_time_ns = 0;
+    /// Median time spent running a task, in nanoseconds
+    uint64_t consume_time_p50_ns = 0;
+    /// 99th percentile of the time spent running a task, in nanoseconds
+    uint64_t consume_time_p99_ns = 0;
+    /// Median latency of a task, from being scheduled to the end of its run, in nanoseconds
+    uint64_t latency_p50_ns = 0;
+    /// 99th percentile of the latency of a task, from being scheduled to the end of its run, in nanoseconds
+    uint64_t latency_p99_ns = 0;
+    /// Number of data waiting to be consumed when the statistics were taken
+    size_t backlog = 0;
+    /// Number of data dropped because of the input queue limits, see @ref BaseStage::set_input_queue_limit
+    size_t num_dropped = 0;
+};
+
+/// @brief Formats statistics of the stages in the Prometheus text exposition format
+/// @param stats Statistics of the stages, e.g. returned by @ref Pipeline::statistics
+/// @param prefix Prefix of the name of the metrics
+/// @return The metrics, one per line and labelled by stage name
+inline std::string to_prometheus_text(const std::vector<StageStatistics> &stats,
+                                      const std::string &prefix = "metavision_pipeline_stage");
+
+namespace detail {
+
+// Counters updated by the pipeline while it runs the tasks of a stage
+struct StageCounters {
+    inline void add_task(uint64_t queue_wait_time_ns, uint64_t consume_time_ns);
+    inline void add_buffer(uint64_t num_events);
+    inline void fill(StageStatistics &stats) const;
+
+    std::atomic<uint64_t> num_tasks{0};
+    std::atomic<uint64_t> num_buffers{0};
+    std::atomic<uint64_t> num_events{0};
+    std::atomic<uint64_t> queue_wait_time_ns{0};
+    std::atomic<uint64_t> max_queue_wait_time_ns{0};
+    std::atomic<uint64_t> consume_time_ns{0};
+    std::atomic<uint64_t> max_consume_time_ns{0};
+    // tasks of the same stage may be timed by different threads
+    LatencyHistogram consume_time_histogram;
+    LatencyHistogram latency_histogram;
+};
+
+template<typename T>
+size_t num_elements(const T &) {
+    return 0;
+}
+
+template<typename T, typename Allocator>
+size_t num_elements(const std::vector<T, Allocator> &buffer) {
+    return buffer.size();
+}
+
+template<typename T>
+size_t num_elements(const std::shared_ptr<T> &ptr) {
+    return ptr ? num_elements(*ptr) : 0;
+}
+
+// Estimated memory held by a buffer
+template<typename T>
+size_t num_bytes(const T &) {
+    return 0;
+}
+
+template<typename T, typename Allocator>
+size_t num_bytes(const std::vector<T, Allocator> &buffer) {
+    return buffer.capacity() * sizeof(T);
+}
+
+template<typename T>
+size_t num_bytes(const std::shared_ptr<T> &ptr) {
+    return ptr ? num_bytes(*ptr) : 0;
+}
+
+} // namespace detail
+} // namespace Metavision
+
+#include "detail/stage_statistics_impl.h"
+
+#endif // METAVISION_SDK_CORE_STAGE_STATISTICS_H
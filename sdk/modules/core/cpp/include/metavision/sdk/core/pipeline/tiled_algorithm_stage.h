@@ -0,0 +1,235 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_TILED_ALGORITHM_STAGE_H
+#define METAVISION_SDK_CORE_TILED_ALGORITHM_STAGE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <boost/any.hpp>
+
+#include "metavision/sdk/core/pipeline/base_stage.h"
+
+namespace Metavision {
+
+/// @brief Stage that runs an instance of an algorithm per tile of the sensor, in parallel
+///
+/// Each buffer consumed is partitioned by sensor tile, each tile having its own instance of the algorithm processing
+/// the events of the tile on its own thread. The outputs of the instances are then merged back in timestamp order,
+/// the events of the same timestamp being ordered by tile, and produced as a single buffer.
+///
+/// This allows stateful per-pixel algorithms (e.g. a @ref RefractoryFilterAlgorithm) to scale across cores, with
+/// results identical to a single instance processing all the events. Algorithms whose output for a pixel depends on
+/// its neighbours (e.g. an @ref ActivityNoiseFilterAlgorithm) only see the events of their tile, so that their output
+/// differs along the borders of the tiles.
+///
+/// The events keep their sensor coordinates, and the events outside of the sensor are dropped. The instances of the
+/// algorithm are only called for the tiles that have events in the buffer consumed.
+///
+/// @tparam Algorithm the type of wrapped algorithm, providing process_events(first, last, d_first)
+/// @tparam OutputEventType optionally, the type of event produced by this stage in @ref produce
+/// @tparam InputEventType optionally, the type of event consumed by this stage in the consuming callback
+template<typename Algorithm, typename OutputEventType = EventCD, typename InputEventType = EventCD>
+class TiledAlgorithmStage : public BaseStage {
+    using InputEventBuffer      = std::vector<InputEventType>;
+    using InputEventBufferPool  = SharedObjectPool<InputEventBuffer>;
+    using InputEventBufferPtr   = typename InputEventBufferPool::ptr_type;
+    using OutputEventBuffer     = std::vector<OutputEventType>;
+    using OutputEventBufferPool = SharedObjectPool<OutputEventBuffer>;
+    using OutputEventBufferPtr  = typename OutputEventBufferPool::ptr_type;
+
+public:
+    /// @brief Function creating the instance of the algorithm of a tile, given the position and size of the tile
+    using AlgorithmFactory = std::function<std::unique_ptr<Algorithm>(int x, int y, int width, int height)>;
+
+    /// @brief Constructor
+    /// @param width Width of the sensor (e.g. Geometry::width)
+    /// @param height Height of the sensor (e.g. Geometry::height)
+    /// @param num_tiles_x Number of columns of tiles
+    /// @param num_tiles_y Number of rows of tiles
+    /// @param factory Function creating the instance of the algorithm of each tile
+    /// @throw std::invalid_argument if the size of the sensor or the number of tiles is not positive, or if there are
+    /// more columns (resp. rows) of tiles than columns (resp. rows) of pixels
+    TiledAlgorithmStage(int width, int height, int num_tiles_x, int num_tiles_y, const AlgorithmFactory &factory) :
+        event_buffer_pool_(OutputEventBufferPool::make_bounded()) {
+        init(width, height, num_tiles_x, num_tiles_y, factory);
+    }
+
+    /// @brief Constructor
+    ///
+    /// Overload constructor that simplifies setting the previous stage.
+    /// @param width Width of the sensor (e.g. Geometry::width)
+    /// @param height Height of the sensor (e.g. Geometry::height)
+    /// @param num_tiles_x Number of columns of tiles
+    /// @param num_tiles_y Number of rows of tiles
+    /// @param factory Function creating the instance of the algorithm of each tile
+    /// @param prev_stage The previous stage of this stage
+    /// @throw std::invalid_argument if the size of the sensor or the number of tiles is not positive, or if there are
+    /// more columns (resp. rows) of tiles than columns (resp. rows) of pixels
+    TiledAlgorithmStage(int width, int height, int num_tiles_x, int num_tiles_y, const AlgorithmFactory &factory,
+                        BaseStage &prev_stage) :
+        BaseStage(prev_stage), event_buffer_pool_(OutputEventBufferPool::make_bounded()) {
+        init(width, height, num_tiles_x, num_tiles_y, factory);
+    }
+
+    /// @brief Returns the number of tiles, i.e. the number of instances of the algorithm
+    size_t get_num_tiles() const {
+        return tiles_.size();
+    }
+
+    /// @brief Returns the instance of the algorithm of a tile
+    /// @param tile Index of the tile, the tiles being numbered row by row
+    /// @return @p Algorithm & the algorithm of the tile
+    Algorithm &algo(size_t tile) {
+        return *tiles_.at(tile).algo;
+    }
+
+    /// @brief Returns the instance of the algorithm of a tile
+    /// @param tile Index of the tile, the tiles being numbered row by row
+    /// @return @p Algorithm & the algorithm of the tile
+    const Algorithm &algo(size_t tile) const {
+        return *tiles_.at(tile).algo;
+    }
+
+private:
+    struct Tile {
+        std::unique_ptr<Algorithm> algo;
+        std::vector<InputEventType> input;
+        std::vector<OutputEventType> output;
+        size_t next; ///< index of the next output event to merge
+    };
+
+    void init(int width, int height, int num_tiles_x, int num_tiles_y, const AlgorithmFactory &factory) {
+        event_buffer_pool_.register_statistics("TiledAlgorithmStage buffers");
+        if (width <= 0 || height <= 0) {
+            throw std::invalid_argument("The size of the sensor must be positive");
+        }
+        if (num_tiles_x <= 0 || num_tiles_y <= 0 || num_tiles_x > width || num_tiles_y > height) {
+            throw std::invalid_argument("The number of tiles must be positive and at most the size of the sensor");
+        }
+
+        // Lookup tables of the column and row of tiles of the pixels, the tiles having the same size up to one pixel
+        std::vector<int> first_cols(num_tiles_x + 1), first_rows(num_tiles_y + 1);
+        for (int i = 0; i <= num_tiles_x; ++i) {
+            first_cols[i] = static_cast<int>(static_cast<std::int64_t>(width) * i / num_tiles_x);
+        }
+        for (int i = 0; i <= num_tiles_y; ++i) {
+            first_rows[i] = static_cast<int>(static_cast<std::int64_t>(height) * i / num_tiles_y);
+        }
+        col_to_tile_.resize(width);
+        for (int i = 0; i < num_tiles_x; ++i) {
+            std::fill(col_to_tile_.begin() + first_cols[i], col_to_tile_.begin() + first_cols[i + 1], i);
+        }
+        row_to_tile_.resize(height);
+        for (int i = 0; i < num_tiles_y; ++i) {
+            std::fill(row_to_tile_.begin() + first_rows[i], row_to_tile_.begin() + first_rows[i + 1],
+                      i * num_tiles_x);
+        }
+
+        tiles_.resize(num_tiles_x * num_tiles_y);
+        for (int j = 0; j < num_tiles_y; ++j) {
+            for (int i = 0; i < num_tiles_x; ++i) {
+                tiles_[j * num_tiles_x + i].algo =
+                    factory(first_cols[i], first_rows[j], first_cols[i + 1] - first_cols[i],
+                            first_rows[j + 1] - first_rows[j]);
+            }
+        }
+
+        set_consuming_callback([this](const boost::any &data) {
+            try {
+                auto buffer     = boost::any_cast<InputEventBufferPtr>(data);
+                auto out_buffer = event_buffer_pool_.acquire();
+                out_buffer->clear();
+                process(*buffer, *out_buffer);
+                produce(out_buffer);
+            } catch (boost::bad_any_cast &) {}
+        });
+    }
+
+    void process(const InputEventBuffer &input, OutputEventBuffer &output) {
+        // Partitions the events by tile
+        for (auto &tile : tiles_) {
+            tile.input.clear();
+            tile.output.clear();
+            tile.next = 0;
+        }
+        const int width = static_cast<int>(col_to_tile_.size()), height = static_cast<int>(row_to_tile_.size());
+        for (const auto &ev : input) {
+            if (ev.x < 0 || ev.y < 0 || ev.x >= width || ev.y >= height) {
+                continue;
+            }
+            tiles_[row_to_tile_[ev.y] + col_to_tile_[ev.x]].input.push_back(ev);
+        }
+
+        // Processes the tiles in parallel, the first one with events being processed on this thread
+        auto process_tile = [](Tile &tile) {
+            tile.algo->process_events(tile.input.cbegin(), tile.input.cend(), std::back_inserter(tile.output));
+        };
+        std::vector<std::thread> threads;
+        Tile *own_tile = nullptr;
+        for (auto &tile : tiles_) {
+            if (tile.input.empty()) {
+                continue;
+            }
+            if (!own_tile) {
+                own_tile = &tile;
+            } else {
+                threads.emplace_back(process_tile, std::ref(tile));
+            }
+        }
+        if (own_tile) {
+            process_tile(*own_tile);
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+
+        // Merges the outputs of the tiles in timestamp order, the heap being ordered by timestamp then tile
+        heap_.clear();
+        for (size_t i = 0; i < tiles_.size(); ++i) {
+            if (!tiles_[i].output.empty()) {
+                heap_.emplace_back(tiles_[i].output.front().t, i);
+            }
+        }
+        const auto later = std::greater<std::pair<timestamp, size_t>>();
+        std::make_heap(heap_.begin(), heap_.end(), later);
+        while (heap_.size() > 1) {
+            std::pop_heap(heap_.begin(), heap_.end(), later);
+            Tile &tile = tiles_[heap_.back().second];
+            output.push_back(tile.output[tile.next++]);
+            if (tile.next < tile.output.size()) {
+                heap_.back().first = tile.output[tile.next].t;
+                std::push_heap(heap_.begin(), heap_.end(), later);
+            } else {
+                heap_.pop_back();
+            }
+        }
+        if (!heap_.empty()) {
+            const Tile &tile = tiles_[heap_.front().second];
+            output.insert(output.end(), tile.output.cbegin() + tile.next, tile.output.cend());
+        }
+    }
+
+    std::vector<Tile> tiles_;
+    std::vector<int> col_to_tile_, row_to_tile_;
+    std::vector<std::pair<timestamp, size_t>> heap_;
+    OutputEventBufferPool event_buffer_pool_;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_CORE_TILED_ALGORITHM_STAGE_H
@@ -0,0 +1,224 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_TYPED_STAGE_H
+#define METAVISION_SDK_CORE_TYPED_STAGE_H
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <boost/any.hpp>
+
+#include "metavision/sdk/base/utils/spsc_queue.h"
+#include "metavision/sdk/core/pipeline/base_stage.h"
+
+namespace Metavision {
+
+template<typename Input, typename Output>
+class TypedStage;
+
+namespace detail {
+
+template<typename T>
+struct TypedStageChannel {
+    TypedStageChannel(const BaseStage &prev_stage, size_t capacity) : prev_stage(prev_stage), queue(capacity) {}
+
+    const BaseStage &prev_stage;
+    SPSCQueue<T> queue;
+};
+
+template<typename T>
+class TypedStageInput {
+public:
+    virtual ~TypedStageInput() = default;
+    virtual void consume_from(TypedStageChannel<T> &channel) = 0;
+};
+
+template<typename T, typename = void>
+struct is_typed_stage : std::false_type {};
+
+template<typename T>
+struct is_typed_stage<T, std::enable_if_t<std::is_base_of<
+                             TypedStage<typename T::InputType, typename T::OutputType>, T>::value>> : std::true_type {};
+
+} // namespace detail
+
+/// @brief Stage consuming data of type @p Input and producing data of type @p Output
+///
+/// When connected to a previous @ref TypedStage producing @p Input, the data are moved through a pre-allocated
+/// single producer / single consumer ring, without being wrapped in a boost::any, and the connection is checked at
+/// compile time.
+/// Connections with other stages still pass the data as boost::any : a typed stage consumes the boost::any holding an
+/// @p Input produced by an untyped stage, and produces boost::any holding @p Output for untyped next stages.
+///
+/// When an input queue limit is set on the connection (see @ref BaseStage::set_input_queue_limit), the data are passed
+/// as boost::any so that the limit and its policy apply.
+///
+/// As for any stage, the consuming callback is never called concurrently. The data must be produced by one thread at
+/// a time, which is the case when producing from the consuming callback or from a single producing thread.
+/// @tparam Input Type of the consumed data, e.g. @ref BaseStage::EventBufferPtr. Must be default constructible
+/// @tparam Output Type of the produced data. Must be default constructible
+template<typename Input, typename Output>
+class TypedStage : public BaseStage, private detail::TypedStageInput<Input> {
+public:
+    /// @brief Type of the consumed data
+    using InputType = Input;
+    /// @brief Type of the produced data
+    using OutputType = Output;
+    /// @brief Type of the consuming callback
+    using ConsumingCallback = std::function<void(Input &&)>;
+
+    /// @brief Default number of data that can be pending between two typed stages before falling back to boost::any
+    static constexpr size_t DefaultChannelCapacity = 64;
+
+    /// @brief Constructor
+    /// @param detachable If this stage can be detached (i.e. can run on its own thread)
+    /// @param channel_capacity Number of data that can be pending from each previous typed stage
+    TypedStage(bool detachable = true, size_t channel_capacity = DefaultChannelCapacity) :
+        BaseStage(detachable), channel_capacity_(channel_capacity) {
+        init();
+    }
+
+    /// @brief Constructor
+    /// @param prev_stage The stage that is executed before the created one
+    /// @param detachable If this stage can be detached (i.e. can run on its own thread)
+    /// @param channel_capacity Number of data that can be pending from each previous typed stage
+    template<typename PrevStage, typename = std::enable_if_t<std::is_base_of<BaseStage, PrevStage>::value>>
+    TypedStage(PrevStage &prev_stage, bool detachable = true, size_t channel_capacity = DefaultChannelCapacity) :
+        TypedStage(detachable, channel_capacity) {
+        set_previous_stage(prev_stage);
+    }
+
+    TypedStage(const TypedStage &) = delete;
+    TypedStage &operator=(const TypedStage &) = delete;
+
+    /// @brief Sets the previous stage
+    ///
+    /// If @p prev_stage is a @ref TypedStage, it must produce @p Input, which is checked at compile time, and the data
+    /// are passed without type erasure.
+    /// @param prev_stage the stage that is executed before this one
+    template<typename PrevStage>
+    void set_previous_stage(PrevStage &prev_stage) {
+        static_assert(std::is_base_of<BaseStage, PrevStage>::value, "The previous stage must be a stage");
+        connect(prev_stage, detail::is_typed_stage<PrevStage>());
+    }
+
+    /// @brief Sets the consuming callback, called with the data produced by the previous stages
+    /// @param cb The consuming callback
+    /// @note This method is not thread safe, the callback must be set before the pipeline is started
+    void set_consuming_callback(const ConsumingCallback &cb) {
+        consuming_cb_ = cb;
+    }
+
+protected:
+    /// @brief Produces data
+    ///
+    /// The data are copied for all the next stages but the last one, to which they are moved
+    /// @param data The produced data
+    void produce(Output data) {
+        const auto &next_stages = this->next_stages();
+        if (next_stages.size() != output_channels_.size()) {
+            const boost::any any_data(data);
+            for (auto *stage : next_stages) {
+                if (std::none_of(output_channels_.cbegin(), output_channels_.cend(),
+                                 [stage](const OutputChannel &c) { return c.stage == stage; })) {
+                    BaseStage::produce(*stage, any_data);
+                }
+            }
+        }
+
+        const size_t num_channels = output_channels_.size();
+        for (size_t i = 0; i < num_channels; ++i) {
+            if (i + 1 == num_channels) {
+                push(output_channels_[i], std::move(data));
+            } else {
+                push(output_channels_[i], Output(data));
+            }
+        }
+    }
+
+private:
+    template<typename, typename>
+    friend class TypedStage;
+
+    struct OutputChannel {
+        BaseStage *stage;
+        detail::TypedStageInput<Output> *input;
+        detail::TypedStageChannel<Output> *channel;
+    };
+
+    void init() {
+        // data produced by untyped stages
+        BaseStage::set_consuming_callback([this](const boost::any &data) {
+            try {
+                auto input = boost::any_cast<Input>(data);
+                if (consuming_cb_) {
+                    consuming_cb_(std::move(input));
+                }
+            } catch (boost::bad_any_cast &) {}
+        });
+    }
+
+    template<typename PrevStage>
+    void connect(PrevStage &prev_stage, std::false_type) {
+        BaseStage::set_previous_stage(prev_stage);
+    }
+
+    template<typename PrevStage>
+    void connect(PrevStage &prev_stage, std::true_type) {
+        static_assert(std::is_same<typename PrevStage::OutputType, Input>::value,
+                      "The previous stage must produce the type of data consumed by this stage");
+        BaseStage::set_previous_stage(prev_stage);
+
+        auto &typed_prev_stage = static_cast<TypedStage<typename PrevStage::InputType, Input> &>(prev_stage);
+        input_channels_.emplace_back(std::make_unique<detail::TypedStageChannel<Input>>(prev_stage, channel_capacity_));
+        typed_prev_stage.output_channels_.push_back(
+            {this, static_cast<detail::TypedStageInput<Input> *>(this), input_channels_.back().get()});
+    }
+
+    void push(OutputChannel &channel, Output &&data) {
+        if (channel.stage->input_queue_limit(*this) != 0) {
+            BaseStage::produce(*channel.stage, boost::any(std::move(data)));
+        } else if (channel.channel->queue.try_push(std::move(data))) {
+            auto *input         = channel.input;
+            auto *input_channel = channel.channel;
+            schedule_consuming_task(*channel.stage, [input, input_channel] { input->consume_from(*input_channel); });
+        } else {
+            // The next stage is lagging behind, the data is carried by the task instead. The order is kept as the
+            // tasks of a stage are run in the order they were scheduled
+            BaseStage::produce(*channel.stage, boost::any(std::move(data)));
+        }
+    }
+
+    void consume_from(detail::TypedStageChannel<Input> &channel) override {
+        Input data;
+        const bool popped = channel.queue.try_pop(data);
+        release_input(channel.prev_stage);
+        if (popped) {
+            count_consumed_data(detail::num_elements(data));
+            if (consuming_cb_) {
+                consuming_cb_(std::move(data));
+            }
+        }
+    }
+
+    const size_t channel_capacity_;
+    ConsumingCallback consuming_cb_;
+    std::vector<std::unique_ptr<detail::TypedStageChannel<Input>>> input_channels_;
+    std::vector<OutputChannel> output_channels_;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_CORE_TYPED_STAGE_H
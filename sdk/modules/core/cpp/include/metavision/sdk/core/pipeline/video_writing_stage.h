@@ -20,12 +20,19 @@
 #include "metavision/sdk/base/utils/sdk_log.h"
 #include "metavision/sdk/core/pipeline/base_stage.h"
 #include "metavision/sdk/core/algorithms/stream_logger_algorithm.h"
+#include "metavision/sdk/core/utils/video_writer.h"
 
 namespace Metavision {
 
 /// @brief Stage that writes the input frames to a video file.
+///
+/// The frames are encoded by a worker thread of the video writer, so that the previous stages go on producing frames
+/// while they are encoded.
 class VideoWritingStage : public BaseStage {
 public:
+    /// @brief Default maximum number of frames waiting to be encoded
+    static constexpr std::size_t DefaultQueueSize = 8;
+
     using FramePool = SharedObjectPool<cv::Mat>;
     using FramePtr  = FramePool::ptr_type;
     using FrameData = std::pair<timestamp, FramePtr>;
@@ -37,8 +44,10 @@ public:
     /// @param fps Frames per second of the output video.
     /// @param codec Codec used by OpenCV to encode the video.
     /// @param colored If true the incoming frames are expected to be color frames, otherwise grayscale.
+    /// @param queue_size Maximum number of frames waiting to be encoded, the stage waits for the encoding of a frame
+    /// when it is reached. If 0, the frames are encoded synchronously.
     VideoWritingStage(const std::string &filename, int width, int height, int fps, const std::string &codec = "MJPG",
-                      bool colored = true) {
+                      bool colored = true, std::size_t queue_size = DefaultQueueSize) {
         if (codec.size() != 4) {
             throw std::runtime_error("VideoWritingStage : codec must be a 4 letter word.");
         }
@@ -50,6 +59,7 @@ public:
         video_writer_.open(filename, CV_FOURCC(codec[0], codec[1], codec[2], codec[3]), fps, cv::Size(width, height),
                            colored);
 #endif
+        video_writer_.set_async(queue_size);
 
         set_consuming_callback([this](const boost::any &data) {
             try {
@@ -67,9 +77,12 @@ public:
     /// @param fps Frames per second of the output video.
     /// @param codec Codec used by OpenCV to encode the video.
     /// @param colored If true the incoming frames are expected to be color frames, otherwise grayscale.
+    /// @param queue_size Maximum number of frames waiting to be encoded, the stage waits for the encoding of a frame
+    /// when it is reached. If 0, the frames are encoded synchronously.
     VideoWritingStage(BaseStage &prev_stage, const std::string &filename, int width, int height, int fps,
-                      const std::string &codec = "MJPG", bool colored = true) :
-        VideoWritingStage(filename, width, height, fps, codec, colored) {
+                      const std::string &codec = "MJPG", bool colored = true,
+                      std::size_t queue_size = DefaultQueueSize) :
+        VideoWritingStage(filename, width, height, fps, codec, colored, queue_size) {
         set_previous_stage(prev_stage);
     }
 
@@ -79,7 +92,7 @@ public:
     }
 
 private:
-    cv::VideoWriter video_writer_;
+    VideoWriter video_writer_;
 };
 
 } // namespace Metavision
@@ -12,14 +12,20 @@
 #ifndef METAVISION_SDK_CORE_CALLBACK_MANAGER_H
 #define METAVISION_SDK_CORE_CALLBACK_MANAGER_H
 
-#include <list>
-#include <map>
+#include <limits>
+#include <memory>
 #include <mutex>
+#include <vector>
 
+#include "metavision/sdk/base/utils/callback_list.h"
 #include "metavision/sdk/core/utils/index_manager.h"
 
 namespace Metavision {
 
+/// @brief Manages callbacks identified by the indices of an @ref IndexManager
+///
+/// The callbacks can be added and removed from any thread, the dispatch (@ref get_cbs, or operator()) never taking a
+/// lock: it works on the callbacks registered when it starts.
 template<class EventsCallback, typename TagType = uint8_t>
 class CallbackManager {
 public:
@@ -33,43 +39,34 @@ public:
         std::unique_lock<std::mutex> lock(cbs_mutex_);
         auto idx = index_manager_.index_generator_.get_next_index();
         index_manager_.counter_map_.tag(tag_id_);
-        cbs_map_[idx] = cb;
+        cbs_.add(idx, cb);
         return idx;
     }
 
     bool remove_callback(size_t callback_id) {
         std::unique_lock<std::mutex> lock(cbs_mutex_);
-        auto it = cbs_map_.find(callback_id);
-        if (it != cbs_map_.end()) {
-            cbs_map_.erase(it);
+        if (cbs_.remove(callback_id)) {
             index_manager_.counter_map_.untag(tag_id_);
             return true;
         }
         return false;
     }
 
-    std::list<EventsCallback> get_cbs() const {
-        std::list<EventsCallback> cbs;
-        std::unique_lock<std::mutex> lock(cbs_mutex_);
-        for (auto &&p : cbs_map_) {
-            cbs.push_back(p.second);
-        }
-        return cbs;
+    /// @brief Gets the callbacks registered at the time of the call, stored contiguously
+    std::shared_ptr<const std::vector<EventsCallback>> get_cbs() const {
+        return cbs_.get();
     }
 
     template<typename... Args>
     void operator()(Args &&...params) {
-        auto cbs = get_cbs();
-
-        for (auto &cb : cbs)
-            cb(std::forward<Args>(params)...);
+        cbs_(std::forward<Args>(params)...);
     }
 
 private:
     IndexManager &index_manager_;
     TagType tag_id_ = std::numeric_limits<TagType>::max();
-    mutable std::mutex cbs_mutex_;
-    std::map<size_t, EventsCallback> cbs_map_;
+    std::mutex cbs_mutex_; // Keeps the tags consistent with the callbacks when they are added or removed
+    CallbackList<EventsCallback> cbs_;
 };
 
 } // namespace Metavision
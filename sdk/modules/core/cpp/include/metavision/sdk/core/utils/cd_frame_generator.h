@@ -12,6 +12,10 @@
 #ifndef METAVISION_SDK_CORE_CD_FRAME_GENERATOR_H
 #define METAVISION_SDK_CORE_CD_FRAME_GENERATOR_H
 
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
 #include "metavision/sdk/base/events/event_cd.h"
 #include "metavision/sdk/core/algorithms/periodic_frame_generation_algorithm.h"
 #include "metavision/sdk/core/utils/threaded_process.h"
@@ -21,12 +25,26 @@ namespace Metavision {
 /// @brief Utility class to display CD events
 class CDFrameGenerator {
 public:
+    /// @brief Ways the events added are handed over to the generator thread
+    enum class EventsTransfer {
+        /// The events are copied into a buffer, which is processed by the generator thread
+        Copy,
+        /// The events update a time surface from the thread adding them, and only the timing of the frames crosses to
+        /// the generator thread, which renders the time surface. Each pixel shows its latest event, which can be more
+        /// recent than the frame if the events keep being added while it is rendered.
+        TimeSurface
+    };
+
     /// @brief Default constructor
     /// @param width Width of the image (in pixels)
     /// @param height Height of the image (in pixels)
     /// @param process_all_frames If true, it will process all frames, not just the latest one. Note that if true
     /// it can slow down the process.
-    CDFrameGenerator(long width, long height, bool process_all_frames = false);
+    /// @param events_transfer How the events added are handed over to the generator thread
+    /// @throw std::invalid_argument if @p process_all_frames is true with the @ref EventsTransfer::TimeSurface
+    /// transfer, which only generates the latest frame
+    CDFrameGenerator(long width, long height, bool process_all_frames = false,
+                     EventsTransfer events_transfer = EventsTransfer::Copy);
 
     /// @brief Destructor
     ~CDFrameGenerator();
@@ -52,6 +70,9 @@ public:
     void set_color_palette(const Metavision::ColorPalette &palette);
 
     /// @brief Adds the buffer of events to be displayed
+    ///
+    /// With the @ref EventsTransfer::TimeSurface transfer, the events are not copied and the generator thread is only
+    /// notified once per frame. This method must then always be called from the same thread.
     /// @param begin Beginning of the buffer of events
     /// @param end End of the buffer of events
     void add_events(const Metavision::EventCD *begin, const Metavision::EventCD *end);
@@ -82,6 +103,7 @@ public:
 
 private:
     bool generate();
+    bool generate_from_time_surface();
 
     // Image to display
     PeriodicFrameGenerationAlgorithm::OutputCb frame_cb_;
@@ -96,6 +118,7 @@ private:
 
     // Is frame dropping allowed ?
     bool process_all_frames_ = false;
+    const EventsTransfer events_transfer_;
     bool events_available_   = false;
     timestamp notify_slice_us_{0};
     timestamp next_notify_us_;
@@ -106,6 +129,14 @@ private:
     std::condition_variable events_available_cond_;
 
     std::unique_ptr<PeriodicFrameGenerationAlgorithm> frame_generation_algo_;
+
+    // Time surface of the TimeSurface transfer, each pixel holding the timestamp of its latest event plus one, shifted
+    // by one bit for its polarity, and 0 if it has no event
+    const long width_, height_;
+    std::unique_ptr<std::atomic<std::uint64_t>[]> time_surface_;
+    std::atomic<timestamp> last_ts_us_{0};
+    timestamp frame_period_us_{0};
+
     // Shadow params
     timestamp accumulation_time_us_;
     cv::Scalar background_color_, on_color_, off_color_;
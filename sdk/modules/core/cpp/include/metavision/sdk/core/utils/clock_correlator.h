@@ -0,0 +1,114 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_CLOCK_CORRELATOR_H
+#define METAVISION_SDK_CORE_CLOCK_CORRELATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+
+#include "metavision/sdk/base/utils/timestamp.h"
+
+namespace Metavision {
+
+/// @brief Relation between the clock of a device and a clock of the host, estimated by a @ref ClockCorrelator
+///
+/// The host time of a device time t is reference_host_time_us_ + (t - reference_device_time_us_) * (1 + drift_ppm_ *
+/// 1e-6).
+struct ClockCorrelation {
+    /// Whether the relation has been estimated, i.e. samples have been added to the correlator
+    bool valid_ = false;
+
+    /// Device time of the reference point of the relation (in us)
+    timestamp reference_device_time_us_ = 0;
+
+    /// Host time matching @ref reference_device_time_us_ (in us)
+    int64_t reference_host_time_us_ = 0;
+
+    /// Drift of the host clock relative to the device clock, in parts per million: positive if the host clock runs
+    /// faster than the device clock
+    double drift_ppm_ = 0.;
+
+    /// Root mean square of the distance of the samples to the relation (in us), i.e. the jitter of the delays between
+    /// the device and the host
+    double jitter_us_ = 0.;
+
+    /// Number of samples the relation was estimated from
+    uint64_t num_samples_ = 0;
+
+    /// @brief Converts a device time to a host time
+    /// @param device_time_us Device time to convert (in us)
+    /// @return The host time (in us)
+    int64_t to_host_time_us(timestamp device_time_us) const;
+
+    /// @brief Converts a host time to a device time
+    /// @param host_time_us Host time to convert (in us)
+    /// @return The device time (in us)
+    timestamp to_device_time_us(int64_t host_time_us) const;
+};
+
+/// @brief Estimates continuously the offset and the drift between the clock of a device and a clock of the host
+///
+/// Each sample pairs a device time with the host time at which it was observed, for instance the timestamp of the
+/// last event of a buffer and the arrival time of the buffer on the host, or the timestamp of an external trigger
+/// event and the host time at which the trigger was fired. As the observations can only be delayed, the minimum
+/// offset between the host time and the device time is kept over bins of device time, and the relation is the line
+/// fitted to these minima, lowered so that it passes below all of them. The relation thus follows the drift of the
+/// clocks over the window of bins, while the delays of the observations are discarded.
+///
+/// The host clock is the one the samples are taken from, e.g. the steady clock for the arrival times of the buffers.
+/// A clock synchronized with PTP can be used by converting the host times of the samples to it.
+/// @note The samples can be added and the correlation read from different threads
+class ClockCorrelator {
+public:
+    /// @brief Constructor
+    /// @param bin_duration_us Duration of device time over which the minimum offset is kept (in us)
+    /// @param num_bins Number of bins the relation is fitted to, the oldest ones being discarded
+    /// @throw std::invalid_argument if the duration of the bins is not positive, or if there are less than 2 bins
+    ClockCorrelator(timestamp bin_duration_us = 100000, size_t num_bins = 100);
+
+    /// @brief Adds a sample
+    ///
+    /// The samples are expected in increasing device time. A device time going back by more than a bin, e.g. when the
+    /// device restarts, resets the correlator.
+    /// @param device_time_us Time of the device (in us)
+    /// @param host_time_us Time of the host at which the device time was observed (in us)
+    void add_sample(timestamp device_time_us, int64_t host_time_us);
+
+    /// @brief Gets the current estimation of the relation between the clocks
+    /// @return The relation, not valid if no sample has been added
+    ClockCorrelation get_correlation() const;
+
+    /// @brief Discards all the samples
+    void reset();
+
+private:
+    struct Bin {
+        int64_t index;
+        timestamp device_time_us;
+        int64_t offset_us;
+    };
+
+    void fit();
+
+    const timestamp bin_duration_us_;
+    const size_t num_bins_;
+    std::deque<Bin> bins_;
+    uint64_t num_samples_ = 0;
+    ClockCorrelation correlation_;
+    mutable std::mutex mutex_;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_CORE_CLOCK_CORRELATOR_H
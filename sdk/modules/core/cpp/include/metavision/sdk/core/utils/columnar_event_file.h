@@ -0,0 +1,175 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_COLUMNAR_EVENT_FILE_H
+#define METAVISION_SDK_CORE_COLUMNAR_EVENT_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "metavision/sdk/base/events/event_cd_buffer_soa.h"
+#include "metavision/sdk/base/utils/generic_header.h"
+#include "metavision/sdk/base/utils/timestamp.h"
+
+namespace Metavision {
+
+/// @brief Description of a block of events of a columnar event file
+///
+/// A columnar event file stores the events in blocks, each holding the t, x, y and p columns of its events one after
+/// the other: the timestamps are delta encoded as variable length integers, the coordinates are stored as arrays of
+/// 16 bits integers and the polarities as bits. The blocks are described in a footer, with the range of the
+/// timestamps of their events, so that the blocks of a time window are found without reading the others.
+struct ColumnarEventBlockInfo {
+    /// Offset of the block in the file
+    uint64_t offset_;
+
+    /// Index of the first event of the block in the file
+    uint64_t first_event_;
+
+    /// Number of events of the block
+    uint32_t n_events_;
+
+    /// Size in bytes of the block in the file
+    uint32_t size_;
+
+    /// Lowest timestamp of the events of the block
+    timestamp t_min_;
+
+    /// Highest timestamp of the events of the block
+    timestamp t_max_;
+};
+
+/// @brief Writes events in a columnar event file (see @ref ColumnarEventBlockInfo)
+class ColumnarEventFileWriter {
+public:
+    /// @brief Default number of events of a block
+    static constexpr size_t DefaultBlockSize = 65536;
+
+    /// @brief Creates the file and writes its header
+    /// @param filename Path to the file to write, truncated if it exists
+    /// @param width Width of the sensor
+    /// @param height Height of the sensor
+    /// @param block_size Number of events of a block
+    /// @throw std::runtime_error if the file can not be opened
+    ColumnarEventFileWriter(const std::string &filename, int width, int height,
+                            size_t block_size = DefaultBlockSize);
+
+    /// @brief Writes the pending events and the footer of the file
+    ~ColumnarEventFileWriter();
+
+    ColumnarEventFileWriter(const ColumnarEventFileWriter &) = delete;
+    ColumnarEventFileWriter &operator=(const ColumnarEventFileWriter &) = delete;
+
+    /// @brief Writes events to the file
+    /// @tparam InputIt Iterator on events with x, y, p and t fields
+    /// @param first Iterator on the first event to write
+    /// @param last Iterator after the last event to write
+    template<typename InputIt>
+    void write(InputIt first, InputIt last) {
+        for (; first != last; ++first) {
+            block_.push_back(first->x, first->y, first->p, first->t);
+            if (block_.size() == block_size_) {
+                write_block();
+            }
+        }
+    }
+
+    /// @brief Writes the pending events and the footer of the file, then closes it
+    ///
+    /// Called by the destructor if not called before
+    void close();
+
+    /// @brief Gets the number of events written, including the ones of the block not written to the file yet
+    uint64_t get_n_events() const;
+
+    /// @brief Gets the number of bytes written to the file so far
+    uint64_t get_n_bytes() const;
+
+private:
+    void write_block();
+
+    std::ofstream output_;
+    const size_t block_size_;
+    EventCDBufferSoA block_;
+    std::vector<uint8_t> encoded_;
+    std::vector<ColumnarEventBlockInfo> blocks_;
+    uint64_t n_events_ = 0;
+    uint64_t offset_   = 0;
+};
+
+/// @brief Reads a columnar event file (see @ref ColumnarEventBlockInfo)
+///
+/// Only the header and the footer of the file are read when opening it, the blocks are read on demand.
+class ColumnarEventFileReader {
+public:
+    /// @brief Opens a columnar event file
+    /// @param filename Path to the file
+    /// @throw std::runtime_error if the file can not be opened or is not a valid columnar event file
+    ColumnarEventFileReader(const std::string &filename);
+
+    /// @brief Returns true if the file @p filename is a columnar event file
+    static bool is_columnar_event_file(const std::string &filename);
+
+    /// @brief Gets the header of the file
+    const GenericHeader &get_header() const;
+
+    /// @brief Gets the number of events of the file
+    uint64_t get_n_events() const;
+
+    /// @brief Gets the description of the blocks of the file, in file order
+    const std::vector<ColumnarEventBlockInfo> &get_blocks() const;
+
+    /// @brief Gets the lowest timestamp of the file, or 0 if it is empty
+    timestamp get_first_timestamp() const;
+
+    /// @brief Gets the highest timestamp of the file, or -1 if it is empty
+    timestamp get_last_timestamp() const;
+
+    /// @brief Finds the first block that may hold events with a timestamp not lower than a given one
+    /// @param t Timestamp
+    /// @return Index of the block, or the number of blocks if all the events are before @p t
+    /// @note The search is in O(log n) if the timestamps of the blocks are ordered, which is the case when the events
+    /// are written in order
+    size_t find_block(timestamp t) const;
+
+    /// @brief Reads the events of a block
+    /// @param block Index of the block
+    /// @param events Buffer replaced by the events of the block
+    /// @throw std::runtime_error if the block can not be read
+    void read_block(size_t block, EventCDBufferSoA &events) const;
+
+    /// @brief Reads the events of a time window, skipping the blocks that have no event in the window
+    /// @param begin Beginning of the time window, included
+    /// @param end End of the time window, excluded
+    /// @param events Buffer replaced by the events of the window
+    /// @throw std::runtime_error if a block can not be read
+    void read_window(timestamp begin, timestamp end, EventCDBufferSoA &events) const;
+
+private:
+    mutable std::ifstream file_;
+    GenericHeader header_;
+    std::vector<ColumnarEventBlockInfo> blocks_;
+    // Highest timestamp of the blocks up to each one, to find blocks by time even if they overlap
+    std::vector<timestamp> max_timestamps_;
+    // True if the lowest timestamps of the blocks are in increasing order
+    bool ordered_      = true;
+    uint64_t n_events_ = 0;
+    mutable std::vector<uint8_t> encoded_;
+    mutable EventCDBufferSoA block_;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_CORE_COLUMNAR_EVENT_FILE_H
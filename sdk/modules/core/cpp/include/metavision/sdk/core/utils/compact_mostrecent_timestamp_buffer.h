@@ -0,0 +1,185 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_COMPACT_MOSTRECENT_TIMESTAMP_BUFFER_H
+#define METAVISION_SDK_CORE_COMPACT_MOSTRECENT_TIMESTAMP_BUFFER_H
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+#include <opencv2/core.hpp>
+
+#include "metavision/sdk/base/utils/timestamp.h"
+#include "metavision/sdk/core/utils/mostrecent_timestamp_buffer.h"
+
+namespace Metavision {
+
+/// @brief Class representing a buffer of the most recent timestamps observed at each pixel of the camera, stored as
+/// 32 or 16 bits offsets from an epoch
+///
+/// Compared to @ref MostRecentTimestampBuffer, the memory footprint and bandwidth are divided by 2 or 4. The offsets
+/// are expressed in units of a resolution (1us by default), and the epoch is moved forward when a timestamp can not be
+/// represented anymore, the offsets of the timestamps that fall out of the range being saturated to the oldest value.
+/// Hence, the timestamps are only retrieved exactly within the range of the offsets before the most recent one: about
+/// 35 minutes with 32 bits offsets and a 1us resolution, 3.2 seconds with 16 bits offsets and a 100us resolution.
+/// The timestamps out of this range, as well as the ones of the pixels without event, are read as the oldest timestamp
+/// that can be represented.
+/// @tparam offset_type Type of the offsets, std::int32_t or std::int16_t
+/// @note The interface follows the one of @ref TMostRecentTimestampBuffer, except that the timestamps are set with
+/// @ref set instead of being written through a reference
+template<typename offset_type>
+class TCompactMostRecentTimestampBuffer {
+public:
+    static_assert(std::is_same<offset_type, std::int32_t>::value || std::is_same<offset_type, std::int16_t>::value,
+                  "The offsets are stored as 32 or 16 bits integers");
+
+    /// @brief Offset of the pixels without event, or whose timestamp is out of the range of the offsets
+    static constexpr offset_type NoTimestamp = std::numeric_limits<offset_type>::min();
+
+    /// @brief Default constructor
+    TCompactMostRecentTimestampBuffer() = default;
+
+    /// @brief Initialization constructor
+    /// @param rows Sensor's height
+    /// @param cols Sensor's width
+    /// @param channels Number of channels
+    /// @param resolution_us Duration (in us) of a unit of the offsets
+    /// @throw std::invalid_argument if the resolution is not positive
+    inline TCompactMostRecentTimestampBuffer(int rows, int cols, int channels = 1, timestamp resolution_us = 1);
+
+    /// @brief Allocates the buffer, all the pixels being without event
+    /// @param rows Sensor's height
+    /// @param cols Sensor's width
+    /// @param channels Number of channels
+    /// @param resolution_us Duration (in us) of a unit of the offsets
+    /// @throw std::invalid_argument if the resolution is not positive
+    inline void create(int rows, int cols, int channels = 1, timestamp resolution_us = 1);
+
+    /// @brief Gets the number of rows of the buffer
+    inline int rows() const;
+
+    /// @brief Gets the number of columns of the buffer
+    inline int cols() const;
+
+    /// @brief Gets the size of the buffer (i.e. Sensor's size as well)
+    inline cv::Size size() const;
+
+    /// @brief Gets the number of channels of the buffer
+    inline int channels() const;
+
+    /// @brief Checks whether the buffer is empty
+    inline bool empty() const;
+
+    /// @brief Gets the duration (in us) of a unit of the offsets
+    inline timestamp resolution() const;
+
+    /// @brief Gets the timestamp corresponding to the offset 0
+    inline timestamp epoch() const;
+
+    /// @brief Sets all elements of the timestamp buffer to a constant, which becomes the epoch
+    /// @param ts The constant timestamp value
+    inline void set_to(timestamp ts);
+
+    /// @brief Sets all the pixels as without event, and the epoch to 0
+    inline void reset();
+
+    /// @brief Moves the epoch forward if needed for a timestamp to be represented
+    ///
+    /// The epoch is moved to the timestamp, and the offsets are shifted accordingly.
+    /// @param ts Timestamp to be represented
+    /// @return The number of units the offsets have been shifted by, 0 if the epoch has not been moved
+    inline timestamp rebase(timestamp ts);
+
+    /// @brief Converts a timestamp to an offset, saturated to the range of the offsets
+    inline offset_type to_offset(timestamp ts) const;
+
+    /// @brief Converts an offset to a timestamp
+    inline timestamp to_timestamp(offset_type offset) const;
+
+    /// @brief Sets the timestamp of a pixel, moving the epoch forward if needed
+    /// @param y The pixel's ordinate
+    /// @param x The pixel's abscissa
+    /// @param c The channel to set the timestamp of
+    /// @param ts The timestamp
+    inline void set(int y, int x, int c, timestamp ts);
+
+    /// @brief Retrieves the timestamp at the specified pixel
+    /// @param y The pixel's ordinate
+    /// @param x The pixel's abscissa
+    /// @param c The channel to retrieve the timestamp from
+    /// @return The timestamp at the given pixel
+    inline timestamp at(int y, int x, int c = 0) const;
+
+    /// @brief Retrieves a const pointer to the offset at the specified pixel
+    /// @param y The pixel's ordinate
+    /// @param x The pixel's abscissa
+    /// @param c The channel to retrieve the offset from
+    inline const offset_type *ptr(int y = 0, int x = 0, int c = 0) const;
+
+    /// @brief Retrieves a pointer to the offset at the specified pixel
+    /// @param y The pixel's ordinate
+    /// @param x The pixel's abscissa
+    /// @param c The channel to retrieve the offset from
+    inline offset_type *ptr(int y = 0, int x = 0, int c = 0);
+
+    /// @brief Retrieves the maximum timestamp across channels at the specified pixel
+    /// @param y The pixel's ordinate
+    /// @param x The pixel's abscissa
+    /// @return The maximum timestamp at that pixel across all the channels in the buffer
+    inline timestamp max_across_channels_at(int y, int x) const;
+
+    /// @brief Copies the timestamps of this buffer into a buffer of 64 bits timestamps
+    /// @param other The timestamp buffer to copy to
+    inline void copy_to(MostRecentTimestampBuffer &other) const;
+
+    /// @brief Generates a CV_8UC1 image of the time surface for the 2 channels
+    /// @sa TMostRecentTimestampBuffer::generate_img_time_surface
+    inline void generate_img_time_surface(timestamp last_ts, timestamp delta_t, cv::Mat &out) const;
+
+    /// @brief Generates a CV_8UC1 image of the time surface, merging the 2 channels
+    /// @sa TMostRecentTimestampBuffer::generate_img_time_surface_collapsing_channels
+    inline void generate_img_time_surface_collapsing_channels(timestamp last_ts, timestamp delta_t,
+                                                              cv::Mat &out) const;
+
+    /// @brief Generates a CV_8UC1 image of the time surface for the 2 channels, with an exponential decay
+    /// @sa TMostRecentTimestampBuffer::generate_img_time_surface_exponential_decay
+    inline void generate_img_time_surface_exponential_decay(timestamp last_ts, double tau, cv::Mat &out) const;
+
+    /// @brief Generates a CV_8UC1 image of the time surface, merging the 2 channels, with an exponential decay
+    /// @sa TMostRecentTimestampBuffer::generate_img_time_surface_collapsing_channels_exponential_decay
+    inline void generate_img_time_surface_collapsing_channels_exponential_decay(timestamp last_ts, double tau,
+                                                                                cv::Mat &out) const;
+
+private:
+    template<typename Decay>
+    inline void generate_img(timestamp last_ts, const Decay &decay, cv::Mat &out) const;
+
+    template<typename Decay>
+    inline void generate_img_collapsing_channels(timestamp last_ts, const Decay &decay, cv::Mat &out) const;
+
+    int rows_{0}, cols_{0}, channels_{0}; ///< Dimensions of the buffer
+    timestamp resolution_{1};             ///< Duration (in us) of a unit of the offsets
+    timestamp epoch_{0};                  ///< Timestamp of the offset 0
+    std::vector<offset_type> offsets_;    ///< Offsets of the most recent timestamps from the epoch
+};
+
+/// @brief Buffer of the most recent timestamps stored as 32 bits offsets
+using CompactMostRecentTimestampBuffer = TCompactMostRecentTimestampBuffer<std::int32_t>;
+
+/// @brief Buffer of the most recent timestamps stored as 16 bits offsets, usually at a coarser resolution than 1us
+using CompactMostRecentTimestampBuffer16 = TCompactMostRecentTimestampBuffer<std::int16_t>;
+
+} // namespace Metavision
+
+#include "detail/compact_mostrecent_timestamp_buffer_impl.h"
+
+#endif // METAVISION_SDK_CORE_COMPACT_MOSTRECENT_TIMESTAMP_BUFFER_H
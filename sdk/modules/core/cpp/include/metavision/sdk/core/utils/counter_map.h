@@ -12,6 +12,9 @@
 #ifndef METAVISION_SDK_CORE_COUNTER_MAP_H
 #define METAVISION_SDK_CORE_COUNTER_MAP_H
 
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <map>
 #include <mutex>
 #include <iostream>
@@ -72,6 +75,47 @@ private:
     std::map<KeyT, size_t> tag_;
 };
 
+/// @brief Associate a counter to a 8 bits key, such as the tag ids of the callbacks of a camera
+///
+/// The counters are atomic and indexed by the key, none of the methods takes a lock: @ref tag_count can be called for
+/// each buffer of data processed, concurrently with the tagging of the keys from other threads.
+template<>
+class CounterMap<uint8_t> {
+public:
+    /// @brief Constructor
+    CounterMap() {
+        for (auto &count : tag_) {
+            count.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    /// @brief Destructor
+    ~CounterMap() {}
+
+    /// @brief Increment the reference counter associated to the input key
+    /// @return The current count for the key
+    size_t tag(uint8_t key) {
+        return tag_[key].fetch_add(1) + 1;
+    }
+
+    /// @brief Decrement the reference counter associated to the input key, if it is not 0
+    /// @return The current count for the key
+    size_t untag(uint8_t key) {
+        size_t count = tag_[key].load();
+        while (count != 0 && !tag_[key].compare_exchange_weak(count, count - 1)) {}
+        return count == 0 ? 0 : count - 1;
+    }
+
+    /// @brief returns the input key reference counter value
+    /// @return The current count for the key
+    size_t tag_count(uint8_t key) const {
+        return tag_[key].load(std::memory_order_acquire);
+    }
+
+private:
+    std::array<std::atomic<size_t>, 256> tag_;
+};
+
 } // namespace Metavision
 
 #endif // METAVISION_SDK_CORE_COUNTER_MAP_H
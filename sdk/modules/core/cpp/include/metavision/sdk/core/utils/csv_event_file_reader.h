@@ -0,0 +1,102 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_CSV_EVENT_FILE_READER_H
+#define METAVISION_SDK_CORE_CSV_EVENT_FILE_READER_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/core/utils/threaded_process.h"
+
+namespace Metavision {
+
+/// @brief Reads CD events from a CSV file, one "x,y,p,t" line per event, as written by @ref CSVEventFileWriter
+///
+/// The file is mapped in memory and split into chunks of whole lines, which are parsed in parallel by worker threads,
+/// without any allocation per line, while the events of the previous chunks are retrieved in order with @ref read.
+/// The lines that are not made of 4 integers, such as a header line, are skipped and counted.
+class CSVEventFileReader {
+public:
+    /// @brief Default size in bytes of a chunk of the file
+    static constexpr size_t DefaultChunkSize = 4 * 1024 * 1024;
+
+    /// @brief Opens and maps a CSV file, and starts parsing its first chunks
+    /// @param filename Path to the CSV file
+    /// @param num_threads Number of threads parsing the chunks, 0 for the number of cores
+    /// @param chunk_size Size in bytes of a chunk, extended to the end of its last line
+    /// @throw std::runtime_error if the file can not be opened or mapped
+    CSVEventFileReader(const std::string &filename, size_t num_threads = 0, size_t chunk_size = DefaultChunkSize);
+
+    /// @brief Stops the worker threads and unmaps the file
+    ~CSVEventFileReader();
+
+    CSVEventFileReader(const CSVEventFileReader &) = delete;
+    CSVEventFileReader &operator=(const CSVEventFileReader &) = delete;
+
+    /// @brief Gets the events of the next chunk of the file, waiting for them to be parsed if needed
+    /// @param events Buffer replaced by the events of the chunk, which may be empty if none of its lines is valid
+    /// @return false if the end of the file has been reached
+    bool read(std::vector<EventCD> &events);
+
+    /// @brief Gets the number of events read so far
+    uint64_t get_n_events() const;
+
+    /// @brief Gets the number of lines skipped so far because they could not be parsed
+    uint64_t get_n_invalid_lines() const;
+
+    /// @brief Gets the size in bytes of the file
+    size_t get_size() const;
+
+    /// @brief Gets the number of bytes of the file read so far
+    size_t get_n_bytes_read() const;
+
+private:
+    struct Chunk {
+        const char *begin = nullptr, *end = nullptr;
+        std::vector<EventCD> events;
+        uint64_t n_invalid_lines = 0;
+        bool parsed              = false;
+    };
+
+    void submit_chunks();
+    void parse_chunk(Chunk &chunk);
+
+    const char *data_{nullptr};
+    size_t size_{0};
+    void *mapping_{nullptr};
+#ifdef _WIN32
+    void *file_{nullptr};
+    void *file_mapping_{nullptr};
+#endif
+
+    const size_t chunk_size_;
+    size_t offset_{0}, n_bytes_read_{0};
+    std::vector<std::unique_ptr<ThreadedProcess>> parsers_;
+    size_t next_parser_{0};
+    std::vector<std::unique_ptr<Chunk>> chunks_;
+    std::vector<Chunk *> free_chunks_;
+    std::deque<Chunk *> pending_chunks_;
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    uint64_t n_events_{0}, n_invalid_lines_{0};
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_CORE_CSV_EVENT_FILE_READER_H
@@ -0,0 +1,114 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_CSV_EVENT_FILE_WRITER_H
+#define METAVISION_SDK_CORE_CSV_EVENT_FILE_WRITER_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/core/utils/threaded_process.h"
+
+namespace Metavision {
+
+/// @brief Writes CD events in a CSV file, one "x,y,p,t" line per event
+///
+/// The events are gathered into chunks, which are formatted in parallel by worker threads into preallocated text
+/// buffers, without going through iostreams, and written to the file in order by another thread. The calls to
+/// @ref write hence return as soon as the events are copied, unless all the chunks are being formatted or written.
+class CSVEventFileWriter {
+public:
+    /// @brief Default number of events of a chunk
+    static constexpr size_t DefaultChunkSize = 65536;
+
+    /// @brief Creates the file and starts the worker threads
+    /// @param filename Path to the file to write, truncated if it exists
+    /// @param num_threads Number of threads formatting the chunks, 0 for the number of cores
+    /// @param chunk_size Number of events of a chunk
+    /// @throw std::runtime_error if the file can not be opened
+    CSVEventFileWriter(const std::string &filename, size_t num_threads = 0, size_t chunk_size = DefaultChunkSize);
+
+    /// @brief Writes the pending events and closes the file
+    ~CSVEventFileWriter();
+
+    CSVEventFileWriter(const CSVEventFileWriter &) = delete;
+    CSVEventFileWriter &operator=(const CSVEventFileWriter &) = delete;
+
+    /// @brief Writes events to the file
+    ///
+    /// Must not be called once the file is closed
+    /// @tparam InputIt Iterator on events with x, y, p and t fields
+    /// @param first Iterator on the first event to write
+    /// @param last Iterator after the last event to write
+    /// @throw std::runtime_error if writing the previous chunks to the file failed
+    template<typename InputIt>
+    void write(InputIt first, InputIt last) {
+        for (; first != last; ++first) {
+            current_->events.emplace_back(first->x, first->y, first->p, first->t);
+            if (current_->events.size() == chunk_size_) {
+                submit_chunk();
+                throw_if_failed();
+            }
+        }
+    }
+
+    /// @brief Waits for all the events written so far to be formatted and written to the file, and flushes it
+    /// @throw std::runtime_error if writing to the file failed
+    void flush();
+
+    /// @brief Writes the pending events and closes the file
+    ///
+    /// Called by the destructor if not called before
+    /// @throw std::runtime_error if writing to the file failed
+    void close();
+
+    /// @brief Gets the number of events written, including the ones not formatted yet
+    uint64_t get_n_events() const;
+
+private:
+    struct Chunk {
+        std::vector<EventCD> events;
+        std::vector<char> text;
+        size_t text_size = 0;
+        bool formatted   = false;
+    };
+
+    void submit_chunk();
+    void format_chunk(Chunk &chunk);
+    void write_chunk(Chunk &chunk);
+    void throw_if_failed();
+
+    std::ofstream output_;
+    const size_t chunk_size_;
+    std::vector<std::unique_ptr<ThreadedProcess>> formatters_;
+    ThreadedProcess writer_;
+    size_t next_formatter_ = 0;
+
+    std::vector<std::unique_ptr<Chunk>> chunks_;
+    std::vector<Chunk *> free_chunks_;
+    Chunk *current_ = nullptr;
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    bool failed_       = false;
+    bool closed_       = false;
+    uint64_t n_events_ = 0;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_CORE_CSV_EVENT_FILE_WRITER_H
@@ -12,6 +12,9 @@
 #ifndef METAVISION_SDK_CORE_CV_VIDEO_RECORDER_H
 #define METAVISION_SDK_CORE_CV_VIDEO_RECORDER_H
 
+#include <atomic>
+#include <mutex>
+#include <vector>
 #include <opencv2/videoio.hpp>
 
 #include "metavision/sdk/core/utils/threaded_process.h"
@@ -21,10 +24,37 @@
 namespace Metavision {
 
 /// @brief A simple threaded video recorder using OpenCV routines
+///
+/// The frames written are queued to a recording thread, each frame waiting to be encoded holding a slot of a bounded
+/// pool, so that the memory used stays flat whatever the speed of the encoding. The frames written by copy are copied
+/// in their slot, which is recycled once encoded, while the frames of a pool (e.g. the ones of
+/// @ref PeriodicFrameGenerationAlgorithm::set_pooled_output_callback) are queued by reference. The methods can be
+/// called from several threads.
 class CvVideoRecorder {
 public:
+    /// @brief Default maximum number of frames waiting to be encoded
+    static constexpr std::size_t DefaultQueueSize = 8;
+
+    using QueuePolicy = VideoWriter::AsyncQueuePolicy;
+    using FramePool   = SharedObjectPool<cv::Mat>;
+    using FramePtr    = FramePool::ptr_type;
+
+    /// @brief Constructor
+    /// @param output_video_file Path to the video file to write
+    /// @param fourcc 4-character code of the codec used to compress the frames
+    /// @param fps Frame rate of the video
+    /// @param size Size of the frames
+    /// @param colored If true the frames are expected to be color frames, otherwise grayscale
+    /// @param params Additional parameters of the encoder, as pairs (id, value), for example the ones returned by
+    /// @ref VideoWriter::get_hw_acceleration_params
+    /// @param queue_size Maximum number of frames waiting to be encoded
+    /// @param policy What to do with a frame written when @p queue_size frames are waiting to be encoded: wait for
+    /// the encoding of a frame, or drop it (see @ref get_n_dropped_frames)
+    /// @throw std::runtime_error if the file can not be opened
+    /// @throw std::invalid_argument if @p queue_size is 0
     CvVideoRecorder(const std::string &output_video_file, const int fourcc, const uint32_t fps, const cv::Size &size,
-                    bool colored);
+                    bool colored, const std::vector<int> &params = std::vector<int>(),
+                    std::size_t queue_size = DefaultQueueSize, QueuePolicy policy = QueuePolicy::Block);
 
     /// @brief Records all remaining frames then destroys the object
     ~CvVideoRecorder();
@@ -37,19 +67,40 @@ public:
     /// The recorder thread remains active until all data added in the queue have been dumped.
     void stop();
 
-    /// @brief Pushes the input frame for writing.
+    /// @brief Pushes a copy of the input frame for writing.
     ///
     /// This method does nothing if the recorder thread is not active
-    void write(cv::Mat &data);
+    void write(const cv::Mat &data);
+
+    /// @brief Pushes a frame of a pool for writing, without copying it
+    ///
+    /// The frame is referenced until it is encoded, and goes back to its pool afterwards. It must hence not be modified
+    /// meanwhile. This method does nothing if the recorder thread is not active
+    /// @param frame The frame to write
+    void write(const FramePtr &frame);
 
     /// @brief Returns if the recording thread is ongoing.
     bool is_recording();
 
+    /// @brief Returns the number of frames dropped because the queue was full, with @ref QueuePolicy::Drop
+    std::size_t get_n_dropped_frames() const;
+
 private:
+    // Takes a slot of the queue, or returns nullptr if the frame is dropped
+    FramePtr acquire_slot();
+    void push(FramePtr slot, FramePtr frame);
+
     VideoWriter writer_;
 
-    using DataPool = SharedObjectPool<cv::Mat>;
-    DataPool data_to_write_pool_;
+    // Frames waiting to be encoded, or their slots when queued by reference, are taken from this pool, whose size
+    // bounds the queue
+    FramePool slot_pool_;
+    // Makes the check of the pool and the acquisition of a slot atomic with QueuePolicy::Drop, so that concurrent
+    // writers never block
+    std::mutex drop_mutex_;
+    const QueuePolicy policy_;
+    std::atomic<std::size_t> n_dropped_frames_{0};
+    std::mutex recording_mutex_;
     ThreadedProcess recorder_thread_;
 };
 
@@ -0,0 +1,233 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_DETAIL_COMPACT_MOSTRECENT_TIMESTAMP_BUFFER_IMPL_H
+#define METAVISION_SDK_CORE_DETAIL_COMPACT_MOSTRECENT_TIMESTAMP_BUFFER_IMPL_H
+
+#include <algorithm>
+#include <stdexcept>
+#include <boost/assert.hpp>
+
+#include "metavision/sdk/core/utils/detail/time_surface_decay.h"
+
+namespace Metavision {
+
+template<typename offset_type>
+constexpr offset_type TCompactMostRecentTimestampBuffer<offset_type>::NoTimestamp;
+
+template<typename offset_type>
+inline TCompactMostRecentTimestampBuffer<offset_type>::TCompactMostRecentTimestampBuffer(int rows, int cols,
+                                                                                         int channels,
+                                                                                         timestamp resolution_us) {
+    create(rows, cols, channels, resolution_us);
+}
+
+template<typename offset_type>
+inline void TCompactMostRecentTimestampBuffer<offset_type>::create(int rows, int cols, int channels,
+                                                                   timestamp resolution_us) {
+    if (resolution_us <= 0) {
+        throw std::invalid_argument("The resolution of the timestamps must be positive");
+    }
+    rows_       = rows;
+    cols_       = cols;
+    channels_   = channels;
+    resolution_ = resolution_us;
+    offsets_.assign(static_cast<size_t>(rows) * cols * channels, NoTimestamp);
+    epoch_ = 0;
+}
+
+template<typename offset_type>
+inline int TCompactMostRecentTimestampBuffer<offset_type>::rows() const {
+    return rows_;
+}
+
+template<typename offset_type>
+inline int TCompactMostRecentTimestampBuffer<offset_type>::cols() const {
+    return cols_;
+}
+
+template<typename offset_type>
+inline cv::Size TCompactMostRecentTimestampBuffer<offset_type>::size() const {
+    return cv::Size(cols_, rows_);
+}
+
+template<typename offset_type>
+inline int TCompactMostRecentTimestampBuffer<offset_type>::channels() const {
+    return channels_;
+}
+
+template<typename offset_type>
+inline bool TCompactMostRecentTimestampBuffer<offset_type>::empty() const {
+    return offsets_.empty();
+}
+
+template<typename offset_type>
+inline timestamp TCompactMostRecentTimestampBuffer<offset_type>::resolution() const {
+    return resolution_;
+}
+
+template<typename offset_type>
+inline timestamp TCompactMostRecentTimestampBuffer<offset_type>::epoch() const {
+    return epoch_;
+}
+
+template<typename offset_type>
+inline void TCompactMostRecentTimestampBuffer<offset_type>::set_to(timestamp ts) {
+    epoch_ = ts;
+    std::fill(offsets_.begin(), offsets_.end(), 0);
+}
+
+template<typename offset_type>
+inline void TCompactMostRecentTimestampBuffer<offset_type>::reset() {
+    epoch_ = 0;
+    std::fill(offsets_.begin(), offsets_.end(), NoTimestamp);
+}
+
+template<typename offset_type>
+inline timestamp TCompactMostRecentTimestampBuffer<offset_type>::rebase(timestamp ts) {
+    if (ts - epoch_ < (static_cast<timestamp>(std::numeric_limits<offset_type>::max()) + 1) * resolution_) {
+        return 0;
+    }
+
+    // The timestamp becomes the offset 0, which leaves the whole positive range for the next timestamps. The offsets
+    // that do not fit anymore are saturated, which keeps the ones of the pixels without event unchanged
+    const timestamp shift = (ts - epoch_) / resolution_;
+    epoch_ += shift * resolution_;
+    for (auto &offset : offsets_) {
+        offset = static_cast<offset_type>(std::max<timestamp>(offset - shift, NoTimestamp));
+    }
+    return shift;
+}
+
+template<typename offset_type>
+inline offset_type TCompactMostRecentTimestampBuffer<offset_type>::to_offset(timestamp ts) const {
+    const timestamp delta = ts - epoch_;
+    // Rounds towards minus infinity, so that the timestamps before the epoch are not rounded up
+    const timestamp units = (delta >= 0 ? delta : delta - resolution_ + 1) / resolution_;
+    return static_cast<offset_type>(std::min<timestamp>(std::max<timestamp>(units, NoTimestamp),
+                                                        std::numeric_limits<offset_type>::max()));
+}
+
+template<typename offset_type>
+inline timestamp TCompactMostRecentTimestampBuffer<offset_type>::to_timestamp(offset_type offset) const {
+    return epoch_ + static_cast<timestamp>(offset) * resolution_;
+}
+
+template<typename offset_type>
+inline void TCompactMostRecentTimestampBuffer<offset_type>::set(int y, int x, int c, timestamp ts) {
+    rebase(ts);
+    *ptr(y, x, c) = to_offset(ts);
+}
+
+template<typename offset_type>
+inline timestamp TCompactMostRecentTimestampBuffer<offset_type>::at(int y, int x, int c) const {
+    return to_timestamp(*ptr(y, x, c));
+}
+
+template<typename offset_type>
+inline const offset_type *TCompactMostRecentTimestampBuffer<offset_type>::ptr(int y, int x, int c) const {
+    BOOST_ASSERT_MSG(x >= 0 && x < cols_ && y >= 0 && y < rows_ && c >= 0 && c < channels_,
+                     "Input coordinates are outside the bounds of the buffer!");
+    return offsets_.data() + (static_cast<size_t>(y) * cols_ + x) * channels_ + c;
+}
+
+template<typename offset_type>
+inline offset_type *TCompactMostRecentTimestampBuffer<offset_type>::ptr(int y, int x, int c) {
+    BOOST_ASSERT_MSG(x >= 0 && x < cols_ && y >= 0 && y < rows_ && c >= 0 && c < channels_,
+                     "Input coordinates are outside the bounds of the buffer!");
+    return offsets_.data() + (static_cast<size_t>(y) * cols_ + x) * channels_ + c;
+}
+
+template<typename offset_type>
+inline timestamp TCompactMostRecentTimestampBuffer<offset_type>::max_across_channels_at(int y, int x) const {
+    const offset_type *offsets = ptr(y, x, 0);
+    return to_timestamp(*std::max_element(offsets, offsets + channels_));
+}
+
+template<typename offset_type>
+inline void TCompactMostRecentTimestampBuffer<offset_type>::copy_to(MostRecentTimestampBuffer &other) const {
+    other.create(rows_, cols_, channels_);
+    if (empty()) {
+        return;
+    }
+    std::transform(offsets_.cbegin(), offsets_.cend(), other.ptr(),
+                   [this](offset_type offset) { return to_timestamp(offset); });
+}
+
+template<typename offset_type>
+inline void TCompactMostRecentTimestampBuffer<offset_type>::generate_img_time_surface(timestamp last_ts,
+                                                                                      timestamp delta_t,
+                                                                                      cv::Mat &out) const {
+    generate_img(last_ts, detail::LinearTimeSurfaceDecay(static_cast<double>(delta_t) / resolution_), out);
+}
+
+template<typename offset_type>
+inline void TCompactMostRecentTimestampBuffer<offset_type>::generate_img_time_surface_collapsing_channels(
+    timestamp last_ts, timestamp delta_t, cv::Mat &out) const {
+    generate_img_collapsing_channels(last_ts,
+                                     detail::LinearTimeSurfaceDecay(static_cast<double>(delta_t) / resolution_), out);
+}
+
+template<typename offset_type>
+inline void TCompactMostRecentTimestampBuffer<offset_type>::generate_img_time_surface_exponential_decay(
+    timestamp last_ts, double tau, cv::Mat &out) const {
+    generate_img(last_ts, detail::ExponentialTimeSurfaceDecay(tau / resolution_), out);
+}
+
+template<typename offset_type>
+inline void
+    TCompactMostRecentTimestampBuffer<offset_type>::generate_img_time_surface_collapsing_channels_exponential_decay(
+        timestamp last_ts, double tau, cv::Mat &out) const {
+    generate_img_collapsing_channels(last_ts, detail::ExponentialTimeSurfaceDecay(tau / resolution_), out);
+}
+
+// The ages are computed in units of the resolution, from the last timestamp converted to a fractional offset
+template<typename offset_type>
+template<typename Decay>
+inline void TCompactMostRecentTimestampBuffer<offset_type>::generate_img(timestamp last_ts, const Decay &decay,
+                                                                         cv::Mat &out) const {
+    out.create(rows_, channels_ * cols_, CV_8UC1);
+
+    const double last_offset = static_cast<double>(last_ts - epoch_) / resolution_;
+    for (int row = 0; row < rows_; ++row) {
+        for (int p = 0; p < channels_; ++p) {
+            // Channels are interleaved
+            detail::apply_time_surface_decay(ptr(row, 0, p), channels_, cols_, last_offset, decay,
+                                             out.ptr<uint8_t>(row, cols_ * p));
+        }
+    }
+}
+
+template<typename offset_type>
+template<typename Decay>
+inline void TCompactMostRecentTimestampBuffer<offset_type>::generate_img_collapsing_channels(timestamp last_ts,
+                                                                                             const Decay &decay,
+                                                                                             cv::Mat &out) const {
+    out.create(rows_, cols_, CV_8UC1);
+    if (channels_ == 1) {
+        generate_img(last_ts, decay, out);
+        return;
+    }
+
+    const double last_offset = static_cast<double>(last_ts - epoch_) / resolution_;
+    std::vector<offset_type> row_offsets(cols_);
+    for (int row = 0; row < rows_; ++row) {
+        const offset_type *offsets = ptr(row, 0, 0);
+        for (int col = 0; col < cols_; ++col, offsets += channels_) {
+            row_offsets[col] = *std::max_element(offsets, offsets + channels_);
+        }
+        detail::apply_time_surface_decay(row_offsets.data(), 1, cols_, last_offset, decay, out.ptr<uint8_t>(row));
+    }
+}
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_CORE_DETAIL_COMPACT_MOSTRECENT_TIMESTAMP_BUFFER_IMPL_H
@@ -14,6 +14,8 @@
 
 #include <boost/assert.hpp>
 
+#include "metavision/sdk/core/utils/detail/time_surface_decay.h"
+
 namespace Metavision {
 
 /// @brief Default constructor
@@ -165,50 +167,62 @@ template<typename timestamp_type>
 inline void TMostRecentTimestampBuffer<timestamp_type>::generate_img_time_surface(timestamp_type last_ts,
                                                                                   timestamp_type delta_t,
                                                                                   cv::Mat &out) const {
-    out.create(this->rows(), this->channels() * this->cols(), CV_8UC1);
-    out.setTo(cv::Scalar::all(0));
+    generate_img(last_ts, detail::LinearTimeSurfaceDecay(static_cast<double>(delta_t)), out);
+}
+
+// @brief Generates a CV_8UC1 image of the time surface, merging the 2 channels
+// The time surface is normalized between last_ts (0) and last_ts - delta_t (255)
+template<typename timestamp_type>
+inline void TMostRecentTimestampBuffer<timestamp_type>::generate_img_time_surface_collapsing_channels(
+    timestamp_type last_ts, timestamp_type delta_t, cv::Mat &out) const {
+    generate_img_collapsing_channels(last_ts, detail::LinearTimeSurfaceDecay(static_cast<double>(delta_t)), out);
+}
 
-    const double ratio    = 255. / delta_t;
-    const int nb_channels = this->channels();
+template<typename timestamp_type>
+inline void TMostRecentTimestampBuffer<timestamp_type>::generate_img_time_surface_exponential_decay(
+    timestamp_type last_ts, double tau, cv::Mat &out) const {
+    generate_img(last_ts, detail::ExponentialTimeSurfaceDecay(tau), out);
+}
+
+template<typename timestamp_type>
+inline void TMostRecentTimestampBuffer<timestamp_type>::generate_img_time_surface_collapsing_channels_exponential_decay(
+    timestamp_type last_ts, double tau, cv::Mat &out) const {
+    generate_img_collapsing_channels(last_ts, detail::ExponentialTimeSurfaceDecay(tau), out);
+}
+
+template<typename timestamp_type>
+template<typename Decay>
+inline void TMostRecentTimestampBuffer<timestamp_type>::generate_img(timestamp_type last_ts, const Decay &decay,
+                                                                     cv::Mat &out) const {
+    out.create(this->rows(), this->channels() * this->cols(), CV_8UC1);
 
     for (int row = 0; row < this->rows(); ++row) {
-        for (int p = 0; p < nb_channels; ++p) {
-            auto img_ptr  = out.ptr<uint8_t>(row, this->cols() * p);
-            auto last_ptr = img_ptr + this->cols();
-            auto ts_ptr   = this->ptr(row, 0, p);
-            for (; img_ptr != last_ptr; ++img_ptr) {
-                auto diff = last_ts - *ts_ptr;
-                if (diff <= delta_t) {
-                    *img_ptr = (uint8_t)(diff * ratio);
-                }
-                ts_ptr += nb_channels /* channels are interleaved */;
-            }
+        for (int p = 0; p < this->channels(); ++p) {
+            // Channels are interleaved
+            detail::apply_time_surface_decay(this->ptr(row, 0, p), this->channels(), this->cols(), last_ts, decay,
+                                             out.ptr<uint8_t>(row, this->cols() * p));
         }
     }
 }
 
-// @brief Generates a CV_8UC1 image of the time surface, merging the 2 channels
-// The time surface is normalized between last_ts (0) and last_ts - delta_t (255)
 template<typename timestamp_type>
-inline void TMostRecentTimestampBuffer<timestamp_type>::generate_img_time_surface_collapsing_channels(
-    timestamp_type last_ts, timestamp_type delta_t, cv::Mat &out) const {
+template<typename Decay>
+inline void TMostRecentTimestampBuffer<timestamp_type>::generate_img_collapsing_channels(timestamp_type last_ts,
+                                                                                         const Decay &decay,
+                                                                                         cv::Mat &out) const {
     out.create(this->rows(), this->cols(), CV_8UC1);
-    out.setTo(cv::Scalar::all(0));
-    const double ratio = 255. / delta_t;
+    if (this->channels() == 1) {
+        generate_img(last_ts, decay, out);
+        return;
+    }
 
+    std::vector<timestamp_type> row_ts(this->cols());
     for (int row = 0; row < this->rows(); ++row) {
-        auto img_ptr  = out.ptr<uint8_t>(row, 0);
-        auto ts_ptr   = this->ptr(row, 0, 0);
-        auto last_ptr = img_ptr + this->cols();
-        while (img_ptr != last_ptr) {
-            auto delta = last_ts - *std::max_element(ts_ptr, ts_ptr + this->channels());
-
-            if (delta <= delta_t) {
-                *img_ptr = (uint8_t)(delta * ratio);
-            }
-            ++img_ptr;
-            ts_ptr += this->channels() /* channels are interleaved */;
+        const timestamp_type *ts_ptr = this->ptr(row, 0, 0);
+        for (int col = 0; col < this->cols(); ++col, ts_ptr += this->channels()) {
+            row_ts[col] = *std::max_element(ts_ptr, ts_ptr + this->channels());
         }
+        detail::apply_time_surface_decay(row_ts.data(), 1, this->cols(), last_ts, decay, out.ptr<uint8_t>(row));
     }
 }
 
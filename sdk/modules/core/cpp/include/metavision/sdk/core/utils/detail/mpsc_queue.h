@@ -0,0 +1,94 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_DETAIL_MPSC_QUEUE_H
+#define METAVISION_SDK_CORE_DETAIL_MPSC_QUEUE_H
+
+#include <atomic>
+
+namespace Metavision {
+namespace detail {
+
+/// @brief Node of a @ref MpscQueue, from which the items of the queue derive
+struct MpscQueueNode {
+    std::atomic<MpscQueueNode *> next{nullptr};
+};
+
+/// @brief Lock-free intrusive queue, for several producer threads and a single consumer thread
+///
+/// This is the intrusive node-based queue of Vyukov: pushing is a single atomic exchange, and popping does not need any
+/// atomic read-modify-write in the common case. The queue does not own its nodes, which are allocated and released by
+/// the caller.
+///
+/// A node whose push is in progress (i.e. whose producer has been preempted between the exchange and the link) blocks
+/// the nodes pushed after it: they are only popped once the push of the former is complete.
+class MpscQueue {
+public:
+    MpscQueue() : head_(&stub_), tail_(&stub_) {}
+
+    MpscQueue(const MpscQueue &) = delete;
+    MpscQueue &operator=(const MpscQueue &) = delete;
+
+    /// @brief Pushes a node at the end of the queue, from any thread
+    void push(MpscQueueNode *node) {
+        node->next.store(nullptr, std::memory_order_relaxed);
+        MpscQueueNode *prev = head_.exchange(node, std::memory_order_acq_rel);
+        // The link is sequentially consistent, so that a consumer checking if the queue is empty before sleeping
+        // either sees the node or is seen sleeping by the producer
+        prev->next.store(node, std::memory_order_seq_cst);
+    }
+
+    /// @brief Pops the node at the front of the queue
+    /// @return The node, or nullptr if the queue is empty or its first node is still being pushed
+    /// @warning Must only be called by the consumer thread
+    MpscQueueNode *pop() {
+        MpscQueueNode *tail = tail_;
+        MpscQueueNode *next = tail->next.load(std::memory_order_acquire);
+        if (tail == &stub_) {
+            if (!next) {
+                return nullptr;
+            }
+            tail_ = tail = next;
+            next         = next->next.load(std::memory_order_acquire);
+        }
+        if (next) {
+            tail_ = next;
+            return tail;
+        }
+        if (tail != head_.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+        // The last node is only popped once another one follows it, the stub being pushed for that purpose
+        push(&stub_);
+        next = tail->next.load(std::memory_order_acquire);
+        if (next) {
+            tail_ = next;
+            return tail;
+        }
+        return nullptr;
+    }
+
+    /// @brief Checks if the queue holds no node
+    /// @warning Must only be called by the consumer thread
+    bool empty() const {
+        return tail_ == &stub_ && !stub_.next.load(std::memory_order_seq_cst);
+    }
+
+private:
+    std::atomic<MpscQueueNode *> head_; ///< Last node pushed, exchanged by the producers
+    MpscQueueNode *tail_;               ///< Next node to pop, owned by the consumer
+    MpscQueueNode stub_;                ///< Node in the queue when it is empty, so that head and tail never are null
+};
+
+} // namespace detail
+} // namespace Metavision
+
+#endif // METAVISION_SDK_CORE_DETAIL_MPSC_QUEUE_H
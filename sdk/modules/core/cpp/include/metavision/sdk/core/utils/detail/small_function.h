@@ -0,0 +1,202 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_DETAIL_SMALL_FUNCTION_H
+#define METAVISION_SDK_CORE_DETAIL_SMALL_FUNCTION_H
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Metavision {
+namespace detail {
+
+template<typename Signature, std::size_t Capacity = 48>
+class SmallFunction;
+
+/// @brief Copyable wrapper of a callable, like std::function, storing the callables up to @p Capacity bytes inline
+///
+/// Lambdas capturing a few pointers or references, bound member functions and the like are hence wrapped without
+/// allocating memory. The larger callables, or the ones that could throw when moved, are allocated on the heap.
+/// @tparam R Type returned by the callable
+/// @tparam Args Types of the arguments of the callable
+/// @tparam Capacity Size of the inline storage, in bytes
+template<typename R, typename... Args, std::size_t Capacity>
+class SmallFunction<R(Args...), Capacity> {
+public:
+    SmallFunction() noexcept = default;
+
+    SmallFunction(std::nullptr_t) noexcept {}
+
+    template<typename F, typename = std::enable_if_t<!std::is_same<std::decay_t<F>, SmallFunction>::value>>
+    SmallFunction(F &&f) {
+        using Callable = std::decay_t<F>;
+        using Storage  = std::conditional_t<fits_inline<Callable>(), InlineStorage<Callable>, HeapStorage<Callable>>;
+        Storage::create(&storage_, std::forward<F>(f));
+        ops_ = &Storage::ops;
+    }
+
+    SmallFunction(const SmallFunction &other) {
+        if (other.ops_) {
+            other.ops_->copy(&other.storage_, &storage_);
+            ops_ = other.ops_;
+        }
+    }
+
+    SmallFunction(SmallFunction &&other) noexcept {
+        if (other.ops_) {
+            other.ops_->move(&other.storage_, &storage_);
+            ops_       = other.ops_;
+            other.ops_ = nullptr;
+        }
+    }
+
+    ~SmallFunction() {
+        reset();
+    }
+
+    SmallFunction &operator=(const SmallFunction &other) {
+        if (this != &other) {
+            SmallFunction copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    SmallFunction &operator=(SmallFunction &&other) noexcept {
+        if (this != &other) {
+            reset();
+            if (other.ops_) {
+                other.ops_->move(&other.storage_, &storage_);
+                ops_       = other.ops_;
+                other.ops_ = nullptr;
+            }
+        }
+        return *this;
+    }
+
+    SmallFunction &operator=(std::nullptr_t) noexcept {
+        reset();
+        return *this;
+    }
+
+    template<typename F, typename = std::enable_if_t<!std::is_same<std::decay_t<F>, SmallFunction>::value>>
+    SmallFunction &operator=(F &&f) {
+        return *this = SmallFunction(std::forward<F>(f));
+    }
+
+    /// @brief Checks if a callable is wrapped
+    explicit operator bool() const noexcept {
+        return ops_ != nullptr;
+    }
+
+    /// @brief Calls the wrapped callable
+    /// @throw std::bad_function_call if no callable is wrapped
+    R operator()(Args... args) const {
+        if (!ops_) {
+            throw std::bad_function_call();
+        }
+        return ops_->invoke(&storage_, std::forward<Args>(args)...);
+    }
+
+private:
+    using Storage = std::aligned_storage_t<Capacity, alignof(std::max_align_t)>;
+
+    // Type erased operations on the wrapped callable
+    struct Ops {
+        R (*invoke)(Storage *, Args &&...);
+        void (*copy)(const Storage *, Storage *);
+        void (*move)(Storage *, Storage *);
+        void (*destroy)(Storage *);
+    };
+
+    template<typename Callable>
+    static constexpr bool fits_inline() {
+        return sizeof(Callable) <= sizeof(Storage) && alignof(Storage) % alignof(Callable) == 0 &&
+               std::is_nothrow_move_constructible<Callable>::value;
+    }
+
+    template<typename Callable>
+    struct InlineStorage {
+        template<typename F>
+        static void create(Storage *storage, F &&f) {
+            new (storage) Callable(std::forward<F>(f));
+        }
+        static Callable *get(Storage *storage) {
+            return reinterpret_cast<Callable *>(storage);
+        }
+        static R invoke(Storage *storage, Args &&...args) {
+            return (*get(storage))(std::forward<Args>(args)...);
+        }
+        static void copy(const Storage *src, Storage *dst) {
+            new (dst) Callable(*get(const_cast<Storage *>(src)));
+        }
+        static void move(Storage *src, Storage *dst) {
+            new (dst) Callable(std::move(*get(src)));
+            get(src)->~Callable();
+        }
+        static void destroy(Storage *storage) {
+            get(storage)->~Callable();
+        }
+        static constexpr Ops ops{&invoke, &copy, &move, &destroy};
+    };
+
+    template<typename Callable>
+    struct HeapStorage {
+        template<typename F>
+        static void create(Storage *storage, F &&f) {
+            new (storage) Callable *(new Callable(std::forward<F>(f)));
+        }
+        static Callable *&get(Storage *storage) {
+            return *reinterpret_cast<Callable **>(storage);
+        }
+        static R invoke(Storage *storage, Args &&...args) {
+            return (*get(storage))(std::forward<Args>(args)...);
+        }
+        static void copy(const Storage *src, Storage *dst) {
+            new (dst) Callable *(new Callable(*get(const_cast<Storage *>(src))));
+        }
+        static void move(Storage *src, Storage *dst) {
+            new (dst) Callable *(get(src));
+        }
+        static void destroy(Storage *storage) {
+            delete get(storage);
+        }
+        static constexpr Ops ops{&invoke, &copy, &move, &destroy};
+    };
+
+    void reset() noexcept {
+        if (ops_) {
+            ops_->destroy(&storage_);
+            ops_ = nullptr;
+        }
+    }
+
+    mutable Storage storage_;
+    const Ops *ops_ = nullptr;
+};
+
+template<typename R, typename... Args, std::size_t Capacity>
+template<typename Callable>
+constexpr typename SmallFunction<R(Args...), Capacity>::Ops
+    SmallFunction<R(Args...), Capacity>::InlineStorage<Callable>::ops;
+
+template<typename R, typename... Args, std::size_t Capacity>
+template<typename Callable>
+constexpr typename SmallFunction<R(Args...), Capacity>::Ops
+    SmallFunction<R(Args...), Capacity>::HeapStorage<Callable>::ops;
+
+} // namespace detail
+} // namespace Metavision
+
+#endif // METAVISION_SDK_CORE_DETAIL_SMALL_FUNCTION_H
@@ -0,0 +1,284 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_DETAIL_SPSC_RING_H
+#define METAVISION_SDK_CORE_DETAIL_SPSC_RING_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+#include "metavision/sdk/base/utils/timestamp.h"
+#include "metavision/sdk/core/utils/detail/iterator_traits.h"
+#include "metavision/sdk/core/utils/detail/ring.h"
+
+namespace Metavision {
+namespace detail {
+
+/// @brief Lock-free ring of time ordered events, for a single producer thread and a single consumer thread
+///
+/// The events are stored contiguously in a circular block whose capacity is a power of 2. When the block is full, the
+/// producer continues in a new block twice as large, and the previous one is released once the consumer has left it:
+/// in steady state, the ring neither allocates memory nor takes any lock.
+///
+/// The events are identified by their index since the creation of the ring. The producer publishes the index after the
+/// last event written, and the consumer the index of the next event to read, so that each side knows which part of the
+/// blocks it can access.
+template<typename Event>
+class SpscRing {
+public:
+    /// @brief Constructor
+    /// @param initial_capacity Number of events the ring can store before allocating a larger block, rounded up to a
+    /// power of 2
+    SpscRing(size_t initial_capacity = 1 << 16) {
+        front_ = oldest_ = back_ = new Block(0, round_up_capacity(initial_capacity));
+    }
+
+    ~SpscRing() {
+        while (oldest_) {
+            Block *next = oldest_->next.load(std::memory_order_relaxed);
+            delete oldest_;
+            oldest_ = next;
+        }
+    }
+
+    SpscRing(const SpscRing &) = delete;
+    SpscRing &operator=(const SpscRing &) = delete;
+
+    /// @brief Adds events at the end of the ring, to be called from the producer thread
+    template<class IteratorEv>
+    void enqueue(IteratorEv start, IteratorEv end) {
+        const size_t n = static_cast<size_t>(std::distance(start, end));
+        if (n == 0) {
+            return;
+        }
+
+        const size_t write_index = write_index_.load(std::memory_order_relaxed);
+        const size_t read_index  = std::max(read_index_.load(std::memory_order_acquire), back_->base);
+        const size_t n_free      = back_->events.size() - (write_index - read_index);
+        const size_t n_back      = std::min(n, n_free);
+        write(back_, write_index, start, n_back);
+        if (n_back < n) {
+            // The new block is published before the index, so that the consumer finds the events it is allowed to read
+            std::advance(start, n_back);
+            Block *block = new Block(write_index + n_back, round_up_capacity(std::max(2 * back_->events.size(), n)));
+            write(block, block->base, start, n - n_back);
+            back_->next.store(block, std::memory_order_release);
+            back_ = block;
+        }
+        // The timestamp is published after the events, so that it is never more recent than the last readable event
+        write_index_.store(write_index + n, std::memory_order_release);
+        last_time_.store(get_time(*std::prev(end)), std::memory_order_release);
+
+        // Blocks left by the consumer are released by the producer, which is the only thread allocating them
+        Block *front = front_.load(std::memory_order_acquire);
+        while (oldest_ != front) {
+            Block *next = oldest_->next.load(std::memory_order_relaxed);
+            delete oldest_;
+            oldest_ = next;
+        }
+    }
+
+    /// @brief Moves the events before a timestamp out of the ring, to be called from the consumer thread
+    /// @param d_first Output iterator
+    /// @param ts Timestamp before which the events are output
+    template<typename OutputIt>
+    void dequeue(OutputIt d_first, timestamp ts) {
+        static_assert(std::is_same<Event, typename iterator_traits<OutputIt>::value_type>::value,
+                      "dequeue called with invalid type of events.");
+        size_t first, last;
+        begin_read(first, last);
+        last = lower_bound(first, last, ts);
+        copy(first, last, d_first);
+        end_read(last);
+    }
+
+    /// @brief Moves the events before a timestamp out of the ring, keeping only the latest ones, to be called from
+    /// the consumer thread
+    /// @param d_first Output iterator
+    /// @param ts Timestamp before which the events are output
+    /// @param max_events Maximum number of events output, the older events being dropped
+    template<typename OutputIt>
+    void dequeue_max_events(OutputIt d_first, timestamp ts, int max_events) {
+        static_assert(std::is_same<Event, typename iterator_traits<OutputIt>::value_type>::value,
+                      "dequeue_max_events called with invalid type of events.");
+        size_t first, last;
+        begin_read(first, last);
+        last = lower_bound(first, last, ts);
+        if (max_events > 0) {
+            copy(last - std::min(last - first, static_cast<size_t>(max_events)), last, d_first);
+        }
+        end_read(last);
+    }
+
+    /// @brief Moves all the events out of the ring, to be called from the consumer thread
+    template<typename OutputIt>
+    void dequeue_all(OutputIt d_first) {
+        static_assert(std::is_same<Event, typename iterator_traits<OutputIt>::value_type>::value,
+                      "dequeue_all called with invalid type of events.");
+        size_t first, last;
+        begin_read(first, last);
+        copy(first, last, d_first);
+        end_read(last);
+    }
+
+    /// @brief Drops all the events of the ring, to be called from the producer thread
+    ///
+    /// The events are skipped by the consumer on its next read, which releases their memory.
+    void drop() {
+        drop_index_.store(write_index_.load(std::memory_order_relaxed), std::memory_order_release);
+    }
+
+    /// @brief Checks if the ring holds events
+    bool data_available() const {
+        return size() != 0;
+    }
+
+    /// @brief Checks if the ring holds an event at or after a timestamp
+    bool data_available(timestamp ts) const {
+        return data_available() && get_last_time() >= ts;
+    }
+
+    /// @brief Gets the number of events in the ring
+    size_t size() const {
+        // The first index is loaded before the last one, which is never lower
+        const size_t first = first_index();
+        return write_index_.load(std::memory_order_acquire) - first;
+    }
+
+    /// @brief Gets the timestamp of the first event, or -1 if the ring is empty. To be called from the producer or the
+    /// consumer thread
+    timestamp get_first_time() const {
+        // The block is loaded before the index, which is then at least the base of the block
+        const Block *block = front_.load(std::memory_order_acquire);
+        const size_t first = first_index();
+        if (first == write_index_.load(std::memory_order_acquire)) {
+            return -1;
+        }
+        return get_time(at(block, first));
+    }
+
+    /// @brief Gets the timestamp of the last event, or -1 if the ring is empty
+    ///
+    /// While events are being added, the timestamp of the previous ones can be returned.
+    timestamp get_last_time() const {
+        return data_available() ? last_time_.load(std::memory_order_acquire) : -1;
+    }
+
+private:
+    struct Block {
+        Block(size_t base, size_t capacity) : base(base), mask(capacity - 1), events(capacity) {}
+
+        const size_t base;                  ///< Index of the first event written in the block
+        const size_t mask;                  ///< Capacity of the block minus 1, to wrap the indices
+        std::vector<Event> events;          ///< Circular storage of the events
+        std::atomic<Block *> next{nullptr}; ///< Block following this one, set once this one is full
+    };
+
+    static size_t round_up_capacity(size_t capacity) {
+        size_t rounded = 1;
+        while (rounded < capacity) {
+            rounded <<= 1;
+        }
+        return rounded;
+    }
+
+    // Index of the first event that has neither been read nor dropped
+    size_t first_index() const {
+        return std::max(read_index_.load(std::memory_order_acquire), drop_index_.load(std::memory_order_acquire));
+    }
+
+    // Returns the block holding the event of a given index, looking for it from a block before it
+    template<typename BlockType>
+    static BlockType *find_block(BlockType *block, size_t index) {
+        BlockType *next;
+        while ((next = block->next.load(std::memory_order_acquire)) && index >= next->base) {
+            block = next;
+        }
+        return block;
+    }
+
+    static const Event &at(const Block *block, size_t index) {
+        block = find_block(block, index);
+        return block->events[(index - block->base) & block->mask];
+    }
+
+    template<class IteratorEv>
+    static void write(Block *block, size_t index, IteratorEv start, size_t n) {
+        const size_t offset = (index - block->base) & block->mask;
+        const size_t n_tail = std::min(n, block->events.size() - offset);
+        IteratorEv middle   = std::next(start, n_tail);
+        std::copy(start, middle, block->events.begin() + offset);
+        std::copy(middle, std::next(middle, n - n_tail), block->events.begin());
+    }
+
+    // Gets the range of indices readable by the consumer, applying the pending drop
+    void begin_read(size_t &first, size_t &last) const {
+        first = first_index();
+        last  = write_index_.load(std::memory_order_acquire);
+    }
+
+    // Publishes the index of the next event to read, and the block where it will be read
+    void end_read(size_t index) {
+        Block *block = find_block(front_.load(std::memory_order_relaxed), index);
+        read_index_.store(index, std::memory_order_release);
+        front_.store(block, std::memory_order_release);
+    }
+
+    // Returns the index of the first event in [first, last) whose timestamp is not lower than ts
+    size_t lower_bound(size_t first, size_t last, timestamp ts) const {
+        const Block *block = front_.load(std::memory_order_relaxed);
+        if (first == last || get_time(at(block, last - 1)) < ts) {
+            return last;
+        }
+        while (first < last) {
+            const size_t middle = first + (last - first) / 2;
+            if (get_time(at(block, middle)) < ts) {
+                first = middle + 1;
+            } else {
+                last = middle;
+            }
+        }
+        return first;
+    }
+
+    // Copies the events of [first, last) by contiguous chunks
+    template<typename OutputIt>
+    void copy(size_t first, size_t last, OutputIt &d_first) const {
+        const Block *block = front_.load(std::memory_order_relaxed);
+        while (first < last) {
+            block                   = find_block(block, first);
+            const Block *next       = block->next.load(std::memory_order_acquire);
+            const size_t block_last = next ? std::min(last, next->base) : last;
+            const size_t offset     = (first - block->base) & block->mask;
+            const size_t n          = std::min(block_last - first, block->events.size() - offset);
+            const auto chunk_begin  = block->events.cbegin() + offset;
+            d_first                 = std::copy(chunk_begin, chunk_begin + n, d_first);
+            first += n;
+        }
+    }
+
+    std::atomic<size_t> write_index_{0};   ///< Index after the last event written, set by the producer
+    std::atomic<size_t> read_index_{0};    ///< Index of the next event to read, set by the consumer
+    std::atomic<size_t> drop_index_{0};    ///< Index before which the events are dropped, set by the producer
+    std::atomic<timestamp> last_time_{-1}; ///< Timestamp of the last event written
+    std::atomic<Block *> front_;           ///< Block of the next event to read, set by the consumer
+    Block *back_;                          ///< Block where the producer writes
+    Block *oldest_;                        ///< Oldest block not released, owned by the producer
+};
+
+} // namespace detail
+} // namespace Metavision
+
+#endif // METAVISION_SDK_CORE_DETAIL_SPSC_RING_H
@@ -0,0 +1,241 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_DETAIL_TIME_SURFACE_DECAY_H
+#define METAVISION_SDK_CORE_DETAIL_TIME_SURFACE_DECAY_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+#include "metavision/sdk/base/utils/timestamp.h"
+
+namespace Metavision {
+namespace detail {
+
+// Ages are converted to double with the exponent trick, which requires them to be lower than 2^52
+constexpr double MaxDecayAge = 4503599627370495.;
+
+/// @brief Linear decay of a time surface: the ages up to delta_t are mapped to [0, 255], older ones to 0
+struct LinearTimeSurfaceDecay {
+    LinearTimeSurfaceDecay(double delta_t) : delta_t(delta_t), ratio(255. / delta_t) {}
+
+    double max_age() const {
+        return std::min(delta_t + 1, MaxDecayAge);
+    }
+
+    std::uint8_t operator()(double age) const {
+        return age <= delta_t ? static_cast<std::uint8_t>(age * ratio) : 0;
+    }
+
+#if defined(__AVX2__)
+    __m128i operator()(__m256d age) const {
+        const __m256d kept = _mm256_and_pd(age, _mm256_cmp_pd(age, _mm256_set1_pd(delta_t), _CMP_LE_OQ));
+        return _mm256_cvttpd_epi32(_mm256_mul_pd(kept, _mm256_set1_pd(ratio)));
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    int64x2_t operator()(float64x2_t age) const {
+        const uint64x2_t kept = vandq_u64(vreinterpretq_u64_f64(age), vcleq_f64(age, vdupq_n_f64(delta_t)));
+        return vcvtq_s64_f64(vmulq_f64(vreinterpretq_f64_u64(kept), vdupq_n_f64(ratio)));
+    }
+#endif
+
+    double delta_t, ratio;
+};
+
+/// @brief Exponential decay of a time surface: the ages are mapped to round(255 * exp(-age / tau))
+struct ExponentialTimeSurfaceDecay {
+    ExponentialTimeSurfaceDecay(double tau) : tau(tau), scale(-1. / (tau * std::log(2.))) {}
+
+    // 255 * exp(-8) rounds to 0
+    double max_age() const {
+        return std::min(8 * tau, MaxDecayAge);
+    }
+
+    std::uint8_t operator()(double age) const {
+        return static_cast<std::uint8_t>(std::lround(255. * std::exp(-age / tau)));
+    }
+
+    // 2^x = 2^n * 2^f with n = floor(x) and f in [0, 1), 2^f being approximated by its Taylor series, precise enough
+    // for 8 bits values
+#if defined(__AVX2__)
+    __m128i operator()(__m256d age) const {
+        const __m256d x = _mm256_mul_pd(age, _mm256_set1_pd(scale));
+        const __m256d n = _mm256_floor_pd(x);
+        const __m256d f = _mm256_sub_pd(x, n);
+        __m256d p       = _mm256_set1_pd(1.3333558146428443e-3);
+        p               = _mm256_add_pd(_mm256_mul_pd(p, f), _mm256_set1_pd(9.618129107628477e-3));
+        p               = _mm256_add_pd(_mm256_mul_pd(p, f), _mm256_set1_pd(5.550410866482158e-2));
+        p               = _mm256_add_pd(_mm256_mul_pd(p, f), _mm256_set1_pd(0.2402265069591007));
+        p               = _mm256_add_pd(_mm256_mul_pd(p, f), _mm256_set1_pd(0.6931471805599453));
+        p               = _mm256_add_pd(_mm256_mul_pd(p, f), _mm256_set1_pd(1.));
+        const __m256i exponent = _mm256_slli_epi64(_mm256_cvtepi32_epi64(_mm256_cvtpd_epi32(n)), 52);
+        const __m256d value    = _mm256_castsi256_pd(_mm256_add_epi64(_mm256_castpd_si256(p), exponent));
+        return _mm256_cvtpd_epi32(_mm256_mul_pd(value, _mm256_set1_pd(255.)));
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    int64x2_t operator()(float64x2_t age) const {
+        const float64x2_t x = vmulq_f64(age, vdupq_n_f64(scale));
+        const float64x2_t n = vrndmq_f64(x);
+        const float64x2_t f = vsubq_f64(x, n);
+        float64x2_t p       = vdupq_n_f64(1.3333558146428443e-3);
+        p                   = vfmaq_f64(vdupq_n_f64(9.618129107628477e-3), p, f);
+        p                   = vfmaq_f64(vdupq_n_f64(5.550410866482158e-2), p, f);
+        p                   = vfmaq_f64(vdupq_n_f64(0.2402265069591007), p, f);
+        p                   = vfmaq_f64(vdupq_n_f64(0.6931471805599453), p, f);
+        p                   = vfmaq_f64(vdupq_n_f64(1.), p, f);
+        const int64x2_t exponent = vshlq_n_s64(vcvtq_s64_f64(n), 52);
+        const float64x2_t value  = vreinterpretq_f64_s64(vaddq_s64(vreinterpretq_s64_f64(p), exponent));
+        return vcvtnq_s64_f64(vmulq_f64(value, vdupq_n_f64(255.)));
+    }
+#endif
+
+    double tau, scale;
+};
+
+/// @brief Maps timestamps to 8 bits values with vector instructions, for as many pixels as possible
+/// @return Number of pixels processed, the remaining ones being processed by @ref apply_time_surface_decay
+template<typename timestamp_type, typename last_timestamp_type, typename Decay>
+inline int apply_time_surface_decay_simd(const timestamp_type *, int, int, last_timestamp_type, const Decay &,
+                                         std::uint8_t *) {
+    return 0;
+}
+
+template<typename Decay>
+inline int apply_time_surface_decay_simd(const timestamp *ts, int stride, int n, timestamp last_ts,
+                                         const Decay &decay, std::uint8_t *out) {
+    int i = 0;
+#if defined(__AVX2__)
+    if (stride > 2) {
+        return 0;
+    }
+    const __m256i last    = _mm256_set1_epi64x(last_ts);
+    const __m256i max_age = _mm256_set1_epi64x(static_cast<timestamp>(decay.max_age()));
+    const __m256i magic   = _mm256_castpd_si256(_mm256_set1_pd(4503599627370496.));
+    // Loads the timestamps of 4 pixels, deinterleaving the channels if needed, and computes their clamped ages
+    auto ages = [&](const timestamp *p) {
+        __m256i t = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+        if (stride == 2) {
+            const __m256i t1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + 4));
+            t                = _mm256_permute4x64_epi64(_mm256_unpacklo_epi64(t, t1), 0xD8);
+        }
+        __m256i age = _mm256_sub_epi64(last, t);
+        age         = _mm256_andnot_si256(_mm256_cmpgt_epi64(_mm256_setzero_si256(), age), age);
+        age         = _mm256_blendv_epi8(age, max_age, _mm256_cmpgt_epi64(age, max_age));
+        return _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(age, magic)), _mm256_castsi256_pd(magic));
+    };
+    // With 2 channels, the timestamps of the second channel of a pixel are loaded with the ones of the next pixel
+    for (; i + 8 + (stride - 1) <= n; i += 8) {
+        const __m128i values = _mm_packs_epi32(decay(ages(ts + i * stride)), decay(ages(ts + (i + 4) * stride)));
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(out + i), _mm_packus_epi16(values, values));
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    if (stride > 2) {
+        return 0;
+    }
+    const int64x2_t last    = vdupq_n_s64(last_ts);
+    const int64x2_t max_age = vdupq_n_s64(static_cast<timestamp>(decay.max_age()));
+    // Computes the clamped ages of 2 pixels
+    auto ages = [&](const timestamp *p) {
+        const int64x2_t t   = stride == 2 ? vld2q_s64(reinterpret_cast<const int64_t *>(p)).val[0] :
+                                            vld1q_s64(reinterpret_cast<const int64_t *>(p));
+        const int64x2_t age = vminq_s64(vmaxq_s64(vsubq_s64(last, t), vdupq_n_s64(0)), max_age);
+        return vcvtq_f64_s64(age);
+    };
+    for (; i + 8 + (stride - 1) <= n; i += 8) {
+        int32x4_t values[2];
+        for (int j = 0; j < 2; ++j) {
+            const timestamp *p = ts + (i + 4 * j) * stride;
+            values[j] = vcombine_s32(vmovn_s64(decay(ages(p))), vmovn_s64(decay(ages(p + 2 * stride))));
+        }
+        vst1_u8(out + i, vqmovun_s16(vcombine_s16(vqmovn_s32(values[0]), vqmovn_s32(values[1]))));
+    }
+#endif
+    return i;
+}
+
+// Timestamps stored as 32 bits offsets, the last one being a fractional offset. The offsets are exactly converted to
+// double, so that the ages are not clamped before the conversion
+template<typename Decay>
+inline int apply_time_surface_decay_simd(const std::int32_t *ts, int stride, int n, double last_ts,
+                                         const Decay &decay, std::uint8_t *out) {
+    int i = 0;
+#if defined(__AVX2__)
+    if (stride > 2) {
+        return 0;
+    }
+    const __m256d last    = _mm256_set1_pd(last_ts);
+    const __m256d max_age = _mm256_set1_pd(decay.max_age());
+    const __m256i even    = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+    // Loads the offsets of 4 pixels, deinterleaving the channels if needed, and computes their clamped ages
+    auto ages = [&](const std::int32_t *p) {
+        const __m128i t =
+            stride == 2 ? _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(
+                              _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)), even)) :
+                          _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+        const __m256d age = _mm256_sub_pd(last, _mm256_cvtepi32_pd(t));
+        return _mm256_min_pd(_mm256_max_pd(age, _mm256_setzero_pd()), max_age);
+    };
+    for (; i + 8 + (stride - 1) <= n; i += 8) {
+        const __m128i values = _mm_packs_epi32(decay(ages(ts + i * stride)), decay(ages(ts + (i + 4) * stride)));
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(out + i), _mm_packus_epi16(values, values));
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    if (stride > 2) {
+        return 0;
+    }
+    const float64x2_t last    = vdupq_n_f64(last_ts);
+    const float64x2_t max_age = vdupq_n_f64(decay.max_age());
+    // Computes the clamped ages of 2 pixels
+    auto ages = [&](const std::int32_t *p) {
+        const int32x2_t t     = stride == 2 ? vld2_s32(p).val[0] : vld1_s32(p);
+        const float64x2_t age = vsubq_f64(last, vcvtq_f64_s64(vmovl_s32(t)));
+        return vminq_f64(vmaxq_f64(age, vdupq_n_f64(0.)), max_age);
+    };
+    for (; i + 8 + (stride - 1) <= n; i += 8) {
+        int32x4_t values[2];
+        for (int j = 0; j < 2; ++j) {
+            const std::int32_t *p = ts + (i + 4 * j) * stride;
+            values[j] = vcombine_s32(vmovn_s64(decay(ages(p))), vmovn_s64(decay(ages(p + 2 * stride))));
+        }
+        vst1_u8(out + i, vqmovun_s16(vcombine_s16(vqmovn_s32(values[0]), vqmovn_s32(values[1]))));
+    }
+#endif
+    return i;
+}
+
+/// @brief Maps the timestamps of a row of a time surface to 8 bits values, according to their age
+/// @param ts Timestamps of the row
+/// @param stride Distance between the timestamps of two consecutive pixels (i.e. the number of channels)
+/// @param n Number of pixels
+/// @param last_ts Timestamp from which the ages are computed, the ages of more recent timestamps being 0. It can be of
+/// a different type than the timestamps, e.g. a fractional offset when the timestamps are stored as offsets
+/// @param decay Decay function
+/// @param out Output values
+template<typename timestamp_type, typename last_timestamp_type, typename Decay>
+inline void apply_time_surface_decay(const timestamp_type *ts, int stride, int n, last_timestamp_type last_ts,
+                                     const Decay &decay, std::uint8_t *out) {
+    const double max_age = decay.max_age();
+    for (int i = apply_time_surface_decay_simd(ts, stride, n, last_ts, decay, out); i < n; ++i) {
+        const double age = std::min(std::max(static_cast<double>(last_ts - ts[i * stride]), 0.), max_age);
+        out[i]           = decay(age);
+    }
+}
+
+} // namespace detail
+} // namespace Metavision
+
+#endif // METAVISION_SDK_CORE_DETAIL_TIME_SURFACE_DECAY_H
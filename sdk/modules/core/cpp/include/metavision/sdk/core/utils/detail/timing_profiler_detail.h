@@ -17,12 +17,18 @@
 #include <boost/format.hpp>
 #include <boost/timer/timer.hpp>
 #endif
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <cmath>
 #include <cstddef>
 #include <iomanip>
 #include <iostream>
+#include <limits>
 #include <map>
+#include <memory>
 #include <mutex>
+#include <stdexcept>
 #include <string>
 #include <tuple>
 #include <unordered_map>
@@ -58,6 +64,20 @@ public:
     }
 };
 
+/// Does not protect the storage policy, which must be thread safe itself (e.g. @ref OperationStoragePolicyHistogram)
+class ConcurrencyPolicyLockFree : public ConcurrencyPolicyThreadUnsafe {};
+
+/// Identifier of an interned operation
+struct OperationId {
+    static constexpr size_t InvalidIndex = static_cast<size_t>(-1);
+
+    bool is_valid() const {
+        return index != InvalidIndex;
+    }
+
+    size_t index = InvalidIndex;
+};
+
 /********************************************************************************
  * TimingPolicy : classes to define how to time operations (which timer to use) *
  ********************************************************************************/
@@ -410,6 +430,350 @@ private:
     std::map<std::string, std::tuple<detail::CpuTimes, size_t, size_t>> data_;
 };
 
+/********************************************************************************
+ * Latency histograms : lock-free per thread accumulators of timed operations   *
+ ********************************************************************************/
+
+/// Histogram of latencies with a bounded relative error (HDR like)
+///
+/// Values below 2^SubBucketBits ns are counted exactly. Above, each power of two is split into 2^SubBucketBits
+/// buckets, so that the relative error is below 2^-SubBucketBits (~3%). Values above 2^MaxExponent ns (~18 min) are
+/// counted in the last bucket. The histogram has a single writer: updates are not atomic read-modify-write
+/// operations, but may be read concurrently. Use @ref record_concurrent when several threads update it.
+class LatencyHistogram {
+public:
+    static constexpr unsigned SubBucketBits = 5;
+    static constexpr unsigned SubBuckets    = 1u << SubBucketBits;
+    static constexpr unsigned MaxExponent   = 40;
+    static constexpr size_t NumBuckets      = (MaxExponent - SubBucketBits + 1) * SubBuckets;
+
+    LatencyHistogram() {
+        for (auto &count : counts_)
+            count.store(0, std::memory_order_relaxed);
+    }
+
+    static size_t bucket_index(uint64_t value) {
+        if (value < SubBuckets)
+            return static_cast<size_t>(value);
+        unsigned exponent = 0;
+        for (uint64_t v = value; v >>= 1;)
+            ++exponent;
+        if (exponent >= MaxExponent)
+            return NumBuckets - 1;
+        const uint64_t sub_bucket = (value >> (exponent - SubBucketBits)) & (SubBuckets - 1);
+        return (exponent - SubBucketBits + 1) * SubBuckets + static_cast<size_t>(sub_bucket);
+    }
+
+    /// Returns the middle of the values counted in a bucket
+    static uint64_t bucket_value(size_t index) {
+        if (index < SubBuckets)
+            return index;
+        const unsigned shift = static_cast<unsigned>(index / SubBuckets) - 1;
+        const uint64_t lower = (SubBuckets + index % SubBuckets) << shift;
+        return lower + ((uint64_t(1) << shift) >> 1);
+    }
+
+    void record(uint64_t value) {
+        add(bucket_index(value), 1);
+    }
+
+    void add(size_t index, uint64_t n) {
+        auto &count = counts_[index];
+        count.store(count.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+
+    void record_concurrent(uint64_t value) {
+        counts_[bucket_index(value)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    uint64_t count(size_t index) const {
+        return counts_[index].load(std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<uint64_t> counts_[NumBuckets];
+};
+
+/// Statistics of the latencies of an operation, merged from all the threads that timed it
+struct LatencyStatistics {
+    LatencyStatistics() : counts(LatencyHistogram::NumBuckets, 0) {}
+
+    /// Returns the latency, in ns, below which a given fraction of the operations are
+    /// @param q Fraction of the operations, between 0 and 1 (e.g. 0.99 for the 99th percentile)
+    uint64_t percentile(double q) const {
+        if (count == 0)
+            return 0;
+        const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(q * count)));
+        uint64_t cumulated  = 0;
+        for (size_t i = 0; i < counts.size(); ++i) {
+            cumulated += counts[i];
+            if (cumulated >= rank)
+                return std::min(std::max(LatencyHistogram::bucket_value(i), min_ns), max_ns);
+        }
+        return max_ns;
+    }
+
+    size_t count{0}, num_processed_elements{0};
+    uint64_t total_ns{0}, min_ns{0}, max_ns{0};
+    std::vector<uint64_t> counts;
+};
+
+/// Thread safe storage policy that accumulates the timed operations of each thread in its own lock-free accumulators
+/// and keeps a latency histogram of each operation. To be used with @ref ConcurrencyPolicyLockFree.
+///
+/// Operations are interned: @ref intern returns an @ref OperationId with which operations are timed without any
+/// lookup nor lock. The other methods, using names, have the same interface as the other storage policies.
+class OperationStoragePolicyHistogram {
+public:
+    static constexpr size_t MaxNumOperations = 256;
+
+    OperationStoragePolicyHistogram() : state_(std::make_shared<State>()) {}
+
+    /// Copies a snapshot of the operations timed so far
+    OperationStoragePolicyHistogram(const OperationStoragePolicyHistogram &other) :
+        state_(std::make_shared<State>()) {
+        other.snapshot(*this);
+    }
+
+    OperationStoragePolicyHistogram &operator=(const OperationStoragePolicyHistogram &other) {
+        if (this != &other) {
+            state_ = std::make_shared<State>();
+            other.snapshot(*this);
+        }
+        return *this;
+    }
+
+    OperationId intern(const std::string &op) {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        auto it = state_->ids.find(op);
+        if (it != state_->ids.end())
+            return it->second;
+        if (state_->names.size() >= MaxNumOperations)
+            throw std::length_error("Too many operations timed by the profiler (max " +
+                                    std::to_string(MaxNumOperations) + ").");
+        OperationId id{state_->names.size()};
+        state_->ids.emplace(op, id);
+        state_->names.push_back(op);
+        return id;
+    }
+
+    void insert(const std::string &op) {
+        intern(op);
+    }
+
+    void insert(const std::string &op, size_t num_processed_elements, const detail::CpuTimes &time) {
+        insert(intern(op), num_processed_elements, time);
+    }
+
+    void insert(const OperationId &id, size_t num_processed_elements, const detail::CpuTimes &time) {
+        auto &acc            = thread_accumulators().get(id.index);
+        const uint64_t value = static_cast<uint64_t>(std::max<int64_t>(0, time.wall.count()));
+        add(acc.count, size_t(1));
+        add(acc.num_processed_elements, num_processed_elements);
+        add(acc.total_ns, value);
+        if (value > acc.max_ns.load(std::memory_order_relaxed))
+            acc.max_ns.store(value, std::memory_order_relaxed);
+        if (value < acc.min_ns.load(std::memory_order_relaxed))
+            acc.min_ns.store(value, std::memory_order_relaxed);
+        acc.histogram.record(value);
+    }
+
+    std::vector<std::string> get_ordered_keys() const {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        return state_->names;
+    }
+
+    /// Gets the latency statistics of an operation, merged from all threads
+    LatencyStatistics get_latency_statistics(const std::string &op, bool *found = nullptr) const {
+        LatencyStatistics stats;
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        auto it = state_->ids.find(op);
+        if (found)
+            *found = it != state_->ids.end();
+        if (it == state_->ids.end())
+            return stats;
+
+        stats.min_ns = std::numeric_limits<uint64_t>::max();
+        for (auto &slot : state_->slots) {
+            const Accumulator *acc = slot->accumulators[it->second.index].load(std::memory_order_acquire);
+            if (!acc)
+                continue;
+            stats.count += acc->count.load(std::memory_order_relaxed);
+            stats.num_processed_elements += acc->num_processed_elements.load(std::memory_order_relaxed);
+            stats.total_ns += acc->total_ns.load(std::memory_order_relaxed);
+            stats.min_ns = std::min(stats.min_ns, acc->min_ns.load(std::memory_order_relaxed));
+            stats.max_ns = std::max(stats.max_ns, acc->max_ns.load(std::memory_order_relaxed));
+            for (size_t i = 0; i < LatencyHistogram::NumBuckets; ++i)
+                stats.counts[i] += acc->histogram.count(i);
+        }
+        if (stats.count == 0)
+            stats.min_ns = 0;
+        return stats;
+    }
+
+    detail::CpuTimes get_time(const std::string &op, bool *found = nullptr) const {
+        return detail::CpuTimes(std::chrono::nanoseconds(get_latency_statistics(op, found).total_ns));
+    }
+
+    size_t get_num_processed_elements(const std::string &op, bool *found = nullptr) const {
+        return get_latency_statistics(op, found).num_processed_elements;
+    }
+
+    size_t get_count(const std::string &op, bool *found = nullptr) const {
+        return get_latency_statistics(op, found).count;
+    }
+
+private:
+    struct Accumulator {
+        std::atomic<size_t> count{0}, num_processed_elements{0};
+        std::atomic<uint64_t> total_ns{0}, min_ns{std::numeric_limits<uint64_t>::max()}, max_ns{0};
+        LatencyHistogram histogram;
+    };
+
+    // Accumulators of one thread, only written by this thread
+    struct ThreadAccumulators {
+        ThreadAccumulators() {
+            for (auto &acc : accumulators)
+                acc.store(nullptr, std::memory_order_relaxed);
+        }
+        ~ThreadAccumulators() {
+            for (auto &acc : accumulators)
+                delete acc.load(std::memory_order_relaxed);
+        }
+        Accumulator &get(size_t index) {
+            Accumulator *acc = accumulators[index].load(std::memory_order_relaxed);
+            if (!acc) {
+                acc = new Accumulator();
+                accumulators[index].store(acc, std::memory_order_release);
+            }
+            return *acc;
+        }
+        std::atomic<Accumulator *> accumulators[MaxNumOperations];
+    };
+
+    struct State {
+        State() : instance_id(next_instance_id()) {}
+        static uint64_t next_instance_id() {
+            static std::atomic<uint64_t> id{0};
+            return ++id;
+        }
+
+        const uint64_t instance_id;
+        mutable std::mutex mutex;
+        std::unordered_map<std::string, OperationId> ids;
+        std::vector<std::string> names;
+        std::vector<std::unique_ptr<ThreadAccumulators>> slots;
+    };
+
+    template<typename T>
+    static void add(std::atomic<T> &a, T value) {
+        a.store(a.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+    ThreadAccumulators &thread_accumulators() {
+        // the accumulators of the last storages used by this thread, the instance ids are never reused so that the
+        // entries of a destroyed storage never match
+        static thread_local std::vector<std::pair<uint64_t, ThreadAccumulators *>> cache;
+        for (auto &entry : cache) {
+            if (entry.first == state_->instance_id)
+                return *entry.second;
+        }
+
+        if (cache.size() >= 16)
+            cache.clear();
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        state_->slots.emplace_back(std::make_unique<ThreadAccumulators>());
+        cache.emplace_back(state_->instance_id, state_->slots.back().get());
+        return *state_->slots.back();
+    }
+
+    void snapshot(OperationStoragePolicyHistogram &copy) const {
+        for (const auto &op : get_ordered_keys()) {
+            const auto stats = get_latency_statistics(op);
+            auto &acc        = copy.thread_accumulators().get(copy.intern(op).index);
+            acc.count.store(stats.count, std::memory_order_relaxed);
+            acc.num_processed_elements.store(stats.num_processed_elements, std::memory_order_relaxed);
+            acc.total_ns.store(stats.total_ns, std::memory_order_relaxed);
+            acc.min_ns.store(stats.count > 0 ? stats.min_ns : std::numeric_limits<uint64_t>::max(),
+                             std::memory_order_relaxed);
+            acc.max_ns.store(stats.max_ns, std::memory_order_relaxed);
+            for (size_t i = 0; i < LatencyHistogram::NumBuckets; ++i)
+                acc.histogram.add(i, stats.counts[i]);
+        }
+    }
+
+    std::shared_ptr<State> state_;
+};
+
+/// Printer of the latency percentiles of the operations stored by @ref OperationStoragePolicyHistogram
+class PrinterUsingSTLWithPercentiles {
+public:
+    void operator()(const OperationStoragePolicyHistogram &storage_policy) {
+        const auto &keys = storage_policy.get_ordered_keys();
+        if (keys.empty())
+            return;
+
+        auto log = MV_SDK_LOG_INFO() << Metavision::Log::no_endline << Metavision::Log::no_space << std::setw(size_op_)
+                                     << "Operation" << std::setw(size_calls_) << "Number of calls"
+                                     << std::setw(size_time_) << "p50" << std::setw(size_time_) << "p99"
+                                     << std::setw(size_time_) << "p999" << std::setw(size_time_) << "max"
+                                     << std::setw(size_elements_) << "Total elements"
+                                     << "\n";
+        log << Metavision::Log::prefix << std::setw(size_op_ + size_calls_) << "" << std::setw(size_time_) << "(us)"
+            << std::setw(size_time_) << "(us)" << std::setw(size_time_) << "(us)" << std::setw(size_time_) << "(us)"
+            << std::setw(size_elements_) << ""
+            << "\n";
+        log << Metavision::Log::prefix << std::setfill('-') << std::setw(size_total_) << ""
+            << "\n"
+            << std::setfill(' ');
+
+        for (const auto &key : keys) {
+            const auto stats = storage_policy.get_latency_statistics(key);
+            log << Metavision::Log::prefix << std::setw(size_op_) << key.substr(0, size_op_) << std::setw(size_calls_)
+                << stats.count << std::fixed << std::setprecision(1) << std::setw(size_time_)
+                << stats.percentile(0.5) / 1000. << std::setw(size_time_) << stats.percentile(0.99) / 1000.
+                << std::setw(size_time_) << stats.percentile(0.999) / 1000. << std::setw(size_time_)
+                << stats.max_ns / 1000. << std::setw(size_elements_) << stats.num_processed_elements << "\n";
+        }
+        log << std::flush;
+    }
+
+private:
+    int size_op_{20};
+    int size_calls_{20};
+    int size_time_{12};
+    int size_elements_{20};
+    int size_total_{size_op_ + size_calls_ + 4 * size_time_ + size_elements_};
+};
+
+/// Default printer used by the profiler for a storage policy
+template<typename OperationStoragePolicy>
+struct DefaultPrinter {
+    using type = PrinterUsingSTL<OperationStoragePolicy>;
+};
+
+template<>
+struct DefaultPrinter<OperationStoragePolicyHistogram> {
+    using type = PrinterUsingSTLWithPercentiles;
+};
+
+/// Inserts a timed operation by id if the storage policy supports it, by name otherwise
+template<typename OperationStoragePolicy>
+auto insert_timed_operation(OperationStoragePolicy &storage_policy, const OperationId &id, const std::string &op,
+                            size_t num_processed_elements, const detail::CpuTimes &time, int)
+    -> decltype(storage_policy.insert(id, num_processed_elements, time), void()) {
+    if (id.is_valid())
+        storage_policy.insert(id, num_processed_elements, time);
+    else
+        storage_policy.insert(op, num_processed_elements, time);
+}
+
+template<typename OperationStoragePolicy>
+void insert_timed_operation(OperationStoragePolicy &storage_policy, const OperationId &, const std::string &op,
+                            size_t num_processed_elements, const detail::CpuTimes &time, long) {
+    storage_policy.insert(op, num_processed_elements, time);
+}
+
 } /* namespace detail */
 } // namespace Metavision
 
@@ -0,0 +1,156 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_DETAIL_WORK_STEALING_DEQUE_H
+#define METAVISION_SDK_CORE_DETAIL_WORK_STEALING_DEQUE_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace Metavision {
+namespace detail {
+
+/// @brief Lock-free deque in which one owner thread pushes and pops items at the bottom, while the other threads
+/// steal items from the top
+///
+/// This is the dynamic circular work-stealing deque of Chase and Lev, with the memory orderings of Le et al.
+/// The storage grows when full and the previous arrays are kept until the destruction of the deque, as a thief may
+/// still be reading them.
+/// @tparam T Type of the items, that must be trivially copyable (e.g. a pointer)
+template<typename T>
+class WorkStealingDeque {
+    static_assert(std::is_trivially_copyable<T>::value, "The items of the deque must be trivially copyable");
+
+public:
+    /// @brief Constructor
+    /// @param capacity Initial capacity, rounded up to a power of 2
+    explicit WorkStealingDeque(size_t capacity = 64) {
+        size_t rounded_capacity = 1;
+        while (rounded_capacity < capacity) {
+            rounded_capacity <<= 1;
+        }
+        arrays_.emplace_back(std::make_unique<Array>(rounded_capacity));
+        array_.store(arrays_.back().get(), std::memory_order_relaxed);
+    }
+
+    WorkStealingDeque(const WorkStealingDeque &) = delete;
+    WorkStealingDeque &operator=(const WorkStealingDeque &) = delete;
+
+    /// @brief Pushes an item at the bottom of the deque
+    /// @warning Must only be called by the owner thread
+    void push(T item) {
+        const int64_t b = bottom_.load(std::memory_order_relaxed);
+        const int64_t t = top_.load(std::memory_order_acquire);
+        Array *a        = array_.load(std::memory_order_relaxed);
+        if (b - t > static_cast<int64_t>(a->capacity()) - 1) {
+            a = grow(a, t, b);
+        }
+        a->put(b, item);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+
+    /// @brief Pops the item at the bottom of the deque, i.e. the last pushed one
+    /// @warning Must only be called by the owner thread
+    /// @param item Popped item
+    /// @return false if the deque is empty, true otherwise
+    bool pop(T &item) {
+        const int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+        Array *a        = array_.load(std::memory_order_relaxed);
+        bottom_.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = top_.load(std::memory_order_relaxed);
+
+        bool popped = false;
+        if (t <= b) {
+            item   = a->get(b);
+            popped = true;
+            if (t == b) {
+                // last item, races with the thieves
+                popped = top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+                bottom_.store(b + 1, std::memory_order_relaxed);
+            }
+        } else {
+            bottom_.store(b + 1, std::memory_order_relaxed);
+        }
+        return popped;
+    }
+
+    /// @brief Steals the item at the top of the deque, i.e. the first pushed one
+    /// @note Can be called from any thread
+    /// @param item Stolen item
+    /// @return false if the deque is empty or if the item has been taken by another thread, true otherwise
+    bool steal(T &item) {
+        int64_t t = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const int64_t b = bottom_.load(std::memory_order_acquire);
+        if (t >= b) {
+            return false;
+        }
+
+        Array *a = array_.load(std::memory_order_acquire);
+        item     = a->get(t);
+        return top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    }
+
+    /// @brief Checks if the deque is empty
+    /// @note The result may be outdated as soon as it is returned if other threads access the deque
+    bool empty() const {
+        const int64_t b = bottom_.load(std::memory_order_relaxed);
+        const int64_t t = top_.load(std::memory_order_relaxed);
+        return b <= t;
+    }
+
+private:
+    class Array {
+    public:
+        explicit Array(size_t capacity) : mask_(capacity - 1), items_(new std::atomic<T>[capacity]) {}
+
+        size_t capacity() const {
+            return mask_ + 1;
+        }
+
+        T get(int64_t i) const {
+            return items_[i & mask_].load(std::memory_order_relaxed);
+        }
+
+        void put(int64_t i, T item) {
+            items_[i & mask_].store(item, std::memory_order_relaxed);
+        }
+
+    private:
+        const size_t mask_;
+        std::unique_ptr<std::atomic<T>[]> items_;
+    };
+
+    Array *grow(Array *a, int64_t t, int64_t b) {
+        arrays_.emplace_back(std::make_unique<Array>(2 * a->capacity()));
+        Array *new_array = arrays_.back().get();
+        for (int64_t i = t; i < b; ++i) {
+            new_array->put(i, a->get(i));
+        }
+        array_.store(new_array, std::memory_order_release);
+        return new_array;
+    }
+
+    std::atomic<int64_t> top_{0};
+    std::atomic<int64_t> bottom_{0};
+    std::atomic<Array *> array_{nullptr};
+    std::vector<std::unique_ptr<Array>> arrays_; // only accessed by the owner thread
+};
+
+} // namespace detail
+} // namespace Metavision
+
+#endif // METAVISION_SDK_CORE_DETAIL_WORK_STEALING_DEQUE_H
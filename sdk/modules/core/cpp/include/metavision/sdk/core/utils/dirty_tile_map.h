@@ -0,0 +1,92 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_DIRTY_TILE_MAP_H
+#define METAVISION_SDK_CORE_DIRTY_TILE_MAP_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <opencv2/core/types.hpp>
+
+namespace Metavision {
+
+/// @brief Splits a frame in square tiles and keeps track of the tiles that have to be rendered again
+///
+/// Used by the frame generation algorithms in incremental mode, to only update the tiles of a persistent frame whose
+/// content changed since the previous frame
+class DirtyTileMap {
+public:
+    /// @brief Size in pixels of the side of a tile
+    static constexpr int TileSize = 32;
+
+    /// @brief Constructor
+    /// @param width Width of the frame (in pixels)
+    /// @param height Height of the frame (in pixels)
+    DirtyTileMap(int width, int height) :
+        width_(width),
+        height_(height),
+        n_tiles_x_((width + TileSize - 1) / TileSize),
+        marked_(static_cast<size_t>(n_tiles_x_) * ((height + TileSize - 1) / TileSize), 0) {}
+
+    /// @brief Gets the number of tiles of the frame
+    size_t get_n_tiles() const {
+        return marked_.size();
+    }
+
+    /// @brief Gets the index of the tile of a pixel
+    size_t get_tile_index(int x, int y) const {
+        return static_cast<size_t>(y / TileSize) * n_tiles_x_ + x / TileSize;
+    }
+
+    /// @brief Gets the area of the frame covered by a tile, clipped to the frame on the right and bottom borders
+    cv::Rect get_tile_rect(size_t tile) const {
+        const int x = static_cast<int>(tile % n_tiles_x_) * TileSize;
+        const int y = static_cast<int>(tile / n_tiles_x_) * TileSize;
+        return cv::Rect(x, y, std::min(width_ - x, static_cast<int>(TileSize)),
+                        std::min(height_ - y, static_cast<int>(TileSize)));
+    }
+
+    /// @brief Marks the tile of a pixel as dirty
+    void mark(int x, int y) {
+        marked_[get_tile_index(x, y)] = 1;
+    }
+
+    /// @brief Marks a tile as dirty
+    void mark_tile(size_t tile) {
+        marked_[tile] = 1;
+    }
+
+    /// @brief Returns true if the tile has been marked as dirty since the last call to @ref clear
+    bool is_marked(size_t tile) const {
+        return marked_[tile] != 0;
+    }
+
+    /// @brief Returns true if the tile of a pixel has been marked as dirty since the last call to @ref clear
+    bool is_marked(int x, int y) const {
+        return marked_[get_tile_index(x, y)] != 0;
+    }
+
+    /// @brief Unmarks all the tiles
+    void clear() {
+        std::fill(marked_.begin(), marked_.end(), 0);
+    }
+
+private:
+    int width_, height_;
+    int n_tiles_x_;
+    std::vector<uint8_t> marked_;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_CORE_DIRTY_TILE_MAP_H
@@ -0,0 +1,119 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_EVENT_RATE_MAP_H
+#define METAVISION_SDK_CORE_EVENT_RATE_MAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <opencv2/core/mat.hpp>
+
+#include "metavision/sdk/base/utils/timestamp.h"
+
+namespace Metavision {
+
+/// @brief Class maintaining a map of the event rates of the pixels, or of blocks of pixels, of a sensor
+///
+/// Each cell of the map holds the count of its events decayed exponentially with their age, which divided by the decay
+/// time is an estimate of the event rate of the cell.
+///
+/// The decay is lazy: the counts are stored relative to a reference time, the events being weighted by the growth
+/// of the decay since this time, so that processing an event is a single addition. The decay of the whole map is only
+/// applied when reading it, or when the weights become too large, in a loop vectorized by the compiler.
+class EventRateMap {
+public:
+    /// @brief Constructor
+    /// @param width Width of the sensor
+    /// @param height Height of the sensor
+    /// @param decay_time_us Time constant of the exponential decay of the counts, in us
+    /// @param block_size Size of the side of the square blocks of pixels sharing a cell of the map
+    /// @throw std::invalid_argument if the size of the sensor, the decay time or the size of the blocks is not positive
+    EventRateMap(int width, int height, timestamp decay_time_us, int block_size = 1);
+
+    /// @brief Counts the events of a range
+    /// @param first Iterator at the beginning of the range of the input events
+    /// @param last Iterator at the end of the range of the input events
+    template<class InputIt>
+    void process_events(InputIt first, InputIt last) {
+        for (; first != last; ++first) {
+            if (first->t != weight_ts_) {
+                update_weight(first->t);
+            }
+            const unsigned int x = first->x, y = first->y;
+            if (x < static_cast<unsigned int>(width_) && y < static_cast<unsigned int>(height_)) {
+                counts_[row_offsets_[y] + cols_[x]] += weight_;
+            }
+        }
+    }
+
+    /// @brief Applies the decay of the counts up to a timestamp, after which @ref data holds the decayed counts
+    /// @param ts Timestamp at which the counts are read, not older than the last events processed
+    void decay(timestamp ts);
+
+    /// @brief Gets the counts of the cells of the map, row by row, as of the timestamp of the last call to @ref decay
+    ///
+    /// The counts are contiguous, so that they can be viewed without copy, e.g. as a cv::Mat of type CV_32FC1 or as
+    /// a NumPy array.
+    const float *data() const;
+
+    /// @brief Gets the decayed count of events of a cell
+    /// @param x Abscissa of a pixel of the cell
+    /// @param y Ordinate of a pixel of the cell
+    /// @param ts Timestamp at which the count is read, not older than the last events processed
+    float get_count(int x, int y, timestamp ts) const;
+
+    /// @brief Gets the event rate of a cell, in Hz
+    /// @param x Abscissa of a pixel of the cell
+    /// @param y Ordinate of a pixel of the cell
+    /// @param ts Timestamp at which the rate is read, not older than the last events processed
+    float get_rate(int x, int y, timestamp ts) const;
+
+    /// @brief Generates the map of the event rates of the cells, in Hz
+    /// @param ts Timestamp at which the rates are read, not older than the last events processed
+    /// @param rates Image of type CV_32FC1 and of size (@ref get_map_width, @ref get_map_height), allocated if needed
+    void generate_rates(timestamp ts, cv::Mat &rates) const;
+
+    /// @brief Gets the width of the map, in cells
+    int get_map_width() const;
+
+    /// @brief Gets the height of the map, in cells
+    int get_map_height() const;
+
+    /// @brief Gets the size of the side of the blocks of pixels sharing a cell
+    int get_block_size() const;
+
+    /// @brief Gets the time constant of the decay, in us
+    timestamp get_decay_time() const;
+
+    /// @brief Forgets the events counted
+    void reset();
+
+private:
+    // Updates the weight of the events of a timestamp, rebasing the counts if it becomes too large
+    void update_weight(timestamp ts);
+
+    // Gets the factor converting the stored counts into the counts decayed as of a timestamp
+    float get_scale(timestamp ts) const;
+
+    int width_, height_, block_size_;
+    int map_width_, map_height_;
+    timestamp decay_time_;
+    std::vector<std::uint32_t> cols_, row_offsets_;
+    std::vector<float> counts_;
+    timestamp reference_ts_;
+    timestamp weight_ts_;
+    float weight_;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_CORE_EVENT_RATE_MAP_H
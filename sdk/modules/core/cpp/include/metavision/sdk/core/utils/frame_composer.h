@@ -12,7 +12,9 @@
 #ifndef METAVISION_SDK_CORE_FRAME_COMPOSER_H
 #define METAVISION_SDK_CORE_FRAME_COMPOSER_H
 
+#include <atomic>
 #include <string>
+#include <utility>
 #include <vector>
 #include <opencv2/opencv.hpp>
 #include <opencv2/imgproc.hpp>
@@ -32,6 +34,10 @@ namespace Metavision {
 ///
 /// Ideally the class takes integer pixels as inputs (CV_8UC1 or CV_8UC3). In case of floating point values, the cv::Mat
 /// is converted to an int type, which might slightly slow down the process.
+///
+/// The sub-images are rendered directly into their region of the full image. Several of them can be rendered in
+/// parallel with @ref FrameComposer::update_subimages, and a frame generator producing 3 channels frames of the size of
+/// a sub-image can render straight into the region returned by @ref FrameComposer::get_subimage, without any copy.
 class FrameComposer {
 public:
     enum InterpolationType { Nearest = cv::INTER_NEAREST, Linear = cv::INTER_LINEAR, Area = cv::INTER_AREA };
@@ -99,6 +105,24 @@ public:
     /// If the type is different than CV_8UC3 or CV_8UC1, then a conversion is performed
     bool update_subimage(unsigned int img_ref, const cv::Mat &image);
 
+    /// @brief Updates several sub-parts of the final image at once
+    ///
+    /// The sub-images are rendered in parallel on the OpenCV thread pool, unless their regions overlap, in which case
+    /// they are rendered in the given order.
+    /// @param updates Pairs of reference ID of a sub-image and image to display at the corresponding location, as
+    /// passed to @ref update_subimage
+    /// @return false if one of the sub-images could not be updated
+    bool update_subimages(const std::vector<std::pair<unsigned int, cv::Mat>> &updates);
+
+    /// @brief Gets the sub-part of the final image corresponding to the reference @p img_ref
+    ///
+    /// The returned CV_8UC3 image shares its data with the full image, hence a sub-image can be rendered straight
+    /// into it instead of being passed to @ref update_subimage. It is invalidated when a new sub-image enlarges the
+    /// full image.
+    /// @param img_ref Reference ID of the sub-image, defined in the function @ref add_new_subimage_parameters
+    /// @return The sub-part of the final image, or an empty image if the reference is unknown
+    cv::Mat get_subimage(unsigned int img_ref) const;
+
     /// @brief Gets the full image
     /// @return The composed image
     const cv::Mat &get_full_image() const;
@@ -115,7 +139,7 @@ private:
     /// @brief Struct containing an image alongside with its preprocessing options and relative position inside the
     /// final composed image
     struct ImageParams {
-        cv::Mat image, image_grey_tmp, image_copy_tmp;
+        cv::Mat image, image_grey_tmp, image_copy_tmp, image_resized_tmp;
         cv::Point position;
         cv::Size size;
         cv::Rect roi;
@@ -218,15 +242,58 @@ inline bool FrameComposer::update_subimage(unsigned int img_ref, const cv::Mat &
         const cv::Rect crop_rect((image.cols - params.size.width) / 2, (image.rows - params.size.height) / 2,
                                  params.size.width, params.size.height);
         img_convert(image(crop_rect), params);
-    } else {
+    } else if (image.channels() == 3) {
+        // The resized color image is written directly in its region of the full image
         cv::resize(image, params.image, params.size, 0., 0., params.interp_type);
-        if (image.channels() != 3) // Otherwise the color image is already in params.image
-            img_convert(params.image, params);
+    } else {
+        // The grey image is resized aside, so that the region of the full image is not reallocated
+        cv::resize(image, params.image_resized_tmp, params.size, 0., 0., params.interp_type);
+        img_convert(params.image_resized_tmp, params);
     }
     assert(!params.image.empty());
     return true;
 }
 
+inline bool FrameComposer::update_subimages(const std::vector<std::pair<unsigned int, cv::Mat>> &updates) {
+    // The regions of the full image are only written in parallel if they are disjoint, so that the order of the
+    // updates still decides which sub-image is visible in the overlapping areas
+    bool disjoint = true;
+    for (size_t i = 0; i < updates.size() && disjoint; ++i) {
+        for (size_t j = i + 1; j < updates.size() && disjoint; ++j) {
+            const unsigned int ref_i = updates[i].first, ref_j = updates[j].first;
+            disjoint = ref_i < srcs_.size() && ref_j < srcs_.size() && ref_i != ref_j &&
+                       (srcs_[ref_i].roi & srcs_[ref_j].roi).empty();
+        }
+    }
+
+    if (!disjoint || updates.size() < 2) {
+        bool updated = true;
+        for (const auto &update : updates) {
+            updated &= update_subimage(update.first, update.second);
+        }
+        return updated;
+    }
+
+    std::atomic<bool> updated{true};
+    cv::parallel_for_(
+        cv::Range(0, static_cast<int>(updates.size())),
+        [&](const cv::Range &range) {
+            for (int i = range.start; i < range.end; ++i) {
+                if (!update_subimage(updates[i].first, updates[i].second)) {
+                    updated = false;
+                }
+            }
+        },
+        static_cast<double>(updates.size()));
+    return updated;
+}
+
+inline cv::Mat FrameComposer::get_subimage(unsigned int img_ref) const {
+    if (img_ref >= srcs_.size())
+        return cv::Mat();
+    return full_img_(srcs_[img_ref].roi);
+}
+
 inline void FrameComposer::img_convert(const cv::Mat &src, ImageParams &params) {
     if (src.channels() == 3) {
         src.copyTo(params.image);
@@ -0,0 +1,105 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_HOT_PIXEL_DETECTOR_H
+#define METAVISION_SDK_CORE_HOT_PIXEL_DETECTOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "metavision/sdk/base/utils/timestamp.h"
+
+namespace Metavision {
+
+/// @brief Class detecting the hot pixels of a sensor, i.e. the pixels producing events at a much higher rate than the
+/// others, and building a bit mask of them
+///
+/// The events of each pixel are counted over periods of fixed duration, at the end of which the event rate of each
+/// pixel is updated with an exponential moving average of the rates of the periods. A pixel is hot if its rate is
+/// above a minimum rate and above a factor of the mean rate of the sensor.
+///
+/// Once detected, a pixel remains hot until @ref reset is called. Hence, the mask can be applied upstream of the
+/// detector, e.g. with the DecodingFilter of a decoder of Metavision HAL, without the pixels being detected as cold
+/// again as soon as their events are no longer seen.
+///
+/// The mask has one bit per pixel: the pixel (x, y) is hot if the bit (y * width + x) % 64 of the word
+/// (y * width + x) / 64 is set, which is the format expected by DecodingFilter::set_masked_pixels.
+class HotPixelDetector {
+public:
+    /// @brief Constructor
+    /// @param width Width of the sensor
+    /// @param height Height of the sensor
+    /// @param period_us Duration of the periods over which the events are counted, in us
+    /// @param min_rate_hz Minimum event rate of a hot pixel, in Hz
+    /// @param rate_factor Minimum ratio between the event rate of a hot pixel and the mean rate of the sensor
+    /// @param smoothing Weight of the previous rate of a pixel in its moving average, in [0, 1)
+    /// @throw std::invalid_argument if the size of the sensor or the period is not positive, or the rates or the
+    /// smoothing are invalid
+    HotPixelDetector(int width, int height, timestamp period_us = 1000000, double min_rate_hz = 1000.,
+                     double rate_factor = 20., double smoothing = 0.5);
+
+    /// @brief Counts the events of a range, updating the rates and the mask at the end of each period
+    /// @param first Iterator at the beginning of the range of the input events
+    /// @param last Iterator at the end of the range of the input events
+    /// @return true if new hot pixels have been detected
+    template<class InputIt>
+    bool process_events(InputIt first, InputIt last) {
+        bool updated = false;
+        for (; first != last; ++first) {
+            if (first->t >= period_end_) {
+                updated |= end_periods(first->t);
+            }
+            const unsigned int x = first->x, y = first->y;
+            if (x < static_cast<unsigned int>(width_) && y < static_cast<unsigned int>(height_)) {
+                ++counts_[static_cast<size_t>(y) * width_ + x];
+            }
+        }
+        return updated;
+    }
+
+    /// @brief Gets the bit mask of the hot pixels
+    const std::vector<std::uint64_t> &get_mask() const;
+
+    /// @brief Returns true if a pixel is hot
+    /// @param x Abscissa of the pixel
+    /// @param y Ordinate of the pixel
+    bool is_hot(int x, int y) const;
+
+    /// @brief Gets the number of hot pixels
+    size_t get_num_hot_pixels() const;
+
+    /// @brief Gets the event rate of a pixel, as of the end of the last period, in Hz
+    /// @param x Abscissa of the pixel
+    /// @param y Ordinate of the pixel
+    float get_rate(int x, int y) const;
+
+    /// @brief Forgets the events counted, the rates and the hot pixels
+    void reset();
+
+private:
+    // Updates the rates and the mask with the counts of the periods ending before a timestamp
+    bool end_periods(timestamp t);
+
+    int width_, height_;
+    timestamp period_;
+    float min_rate_, rate_factor_, smoothing_;
+    bool started_;
+    timestamp period_end_;
+    std::vector<std::uint32_t> counts_;
+    std::vector<float> rates_;
+    std::vector<std::uint64_t> mask_;
+    size_t num_hot_pixels_;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_CORE_HOT_PIXEL_DETECTOR_H
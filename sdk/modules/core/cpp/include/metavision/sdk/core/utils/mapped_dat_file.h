@@ -0,0 +1,130 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_MAPPED_DAT_FILE_H
+#define METAVISION_SDK_CORE_MAPPED_DAT_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "metavision/sdk/base/utils/generic_header.h"
+#include "metavision/sdk/base/utils/timestamp.h"
+
+namespace Metavision {
+
+/// @brief Read-only memory mapping of a DAT file, with a sparse index of the timestamps of its events
+///
+/// The events are accessed in place, the pages of the file being read by the system when accessed. Only the timestamp
+/// of one event every @ref get_index_step events is read when opening the file, so that finding the events of a given
+/// time (see @ref lower_bound) takes O(log n) without reading the whole file.
+/// The timestamps stored in DAT files are 32 bits wide and loop every ~71 minutes: the timestamps returned by this
+/// class are unwrapped, assuming that two consecutive indexed events are less than 71 minutes apart.
+class MappedDATFile {
+public:
+    /// @brief Default number of events between two entries of the index
+    static constexpr size_t DefaultIndexStep = 4096;
+
+    /// @brief Opens and maps a DAT file
+    /// @param filename Path to the DAT file
+    /// @param index_step Number of events between two entries of the index
+    /// @throw std::runtime_error if the file can not be opened or mapped
+    MappedDATFile(const std::string &filename, size_t index_step = DefaultIndexStep);
+
+    /// @brief Unmaps the file
+    ~MappedDATFile();
+
+    MappedDATFile(const MappedDATFile &) = delete;
+    MappedDATFile &operator=(const MappedDATFile &) = delete;
+
+    /// @brief Gets the header of the file
+    const GenericHeader &get_header() const;
+
+    /// @brief Gets the version of the format of the file, as given in its header (0 if none)
+    int get_version() const;
+
+    /// @brief Gets the type of the events of the file, as given after the header
+    uint8_t get_event_type() const;
+
+    /// @brief Gets the size in bytes of an event of the file
+    size_t get_event_size() const;
+
+    /// @brief Gets the number of events of the file
+    uint64_t get_n_events() const;
+
+    /// @brief Gets the number of events between two entries of the index
+    size_t get_index_step() const;
+
+    /// @brief Gets a pointer to the raw data of an event
+    /// @param i Index of the event, in [0, @ref get_n_events())
+    const uint8_t *get_event_data(uint64_t i) const;
+
+    /// @brief Gets the unwrapped timestamp of an event
+    /// @param i Index of the event, in [0, @ref get_n_events())
+    timestamp get_timestamp(uint64_t i) const;
+
+    /// @brief Gets the unwrapped timestamp of the first event, or 0 if the file is empty
+    timestamp get_first_timestamp() const;
+
+    /// @brief Gets the unwrapped timestamp of the last event, or -1 if the file is empty
+    timestamp get_last_timestamp() const;
+
+    /// @brief Finds the first event with a timestamp not lower than a given one
+    /// @param t Unwrapped timestamp
+    /// @return Index of the event, or @ref get_n_events() if all the events are before @p t
+    uint64_t lower_bound(timestamp t) const;
+
+    /// @brief Finds the events of a time window
+    /// @param begin Unwrapped timestamp of the beginning of the window, included
+    /// @param end Unwrapped timestamp of the end of the window, excluded
+    /// @return The indices of the first event of the window and after its last event
+    std::pair<uint64_t, uint64_t> get_window(timestamp begin, timestamp end) const;
+
+    /// @brief Advises the system that a range of events will be read soon, so that their pages are read ahead
+    /// @param begin Index of the first event of the range
+    /// @param end Index after the last event of the range
+    void will_need(uint64_t begin, uint64_t end) const;
+
+    /// @brief Releases the memory of the pages of a range of events, which are read again from the file if accessed
+    ///
+    /// This bounds the memory used when reading huge files, the pages accessed being otherwise kept by the process.
+    /// @param begin Index of the first event of the range
+    /// @param end Index after the last event of the range
+    void release(uint64_t begin, uint64_t end) const;
+
+private:
+    uint32_t get_raw_timestamp(uint64_t i) const;
+    void advise(uint64_t begin, uint64_t end, int advice, bool inner_pages) const;
+
+    GenericHeader header_;
+    int version_{0};
+    uint8_t event_type_{0};
+    size_t event_size_{8};
+    uint64_t n_events_{0};
+    size_t index_step_;
+
+    uint8_t *mapping_{nullptr};
+    size_t mapping_size_{0};
+    const uint8_t *events_{nullptr};
+#ifdef _WIN32
+    void *file_{nullptr};
+    void *file_mapping_{nullptr};
+#endif
+
+    // Unwrapped timestamps of the events i * index_step_, and of the last event
+    std::vector<timestamp> index_;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_CORE_MAPPED_DAT_FILE_H
@@ -136,7 +136,33 @@ public:
     inline void generate_img_time_surface_collapsing_channels(timestamp_type last_ts, timestamp_type delta_t,
                                                               cv::Mat &out) const;
 
+    /// @brief Generates a CV_8UC1 image of the time surface for the 2 channels, with an exponential decay
+    ///
+    /// Side-by-side: negative polarity time surface, positive polarity time surface
+    /// Each pixel is set to 255 * exp(-(last_ts - t) / tau), t being its timestamp
+    ///
+    /// @param last_ts Last timestamp value stored in the buffer
+    /// @param tau Time constant of the decay
+    /// @param out The produced image
+    inline void generate_img_time_surface_exponential_decay(timestamp_type last_ts, double tau, cv::Mat &out) const;
+
+    /// @brief Generates a CV_8UC1 image of the time surface, merging the 2 channels, with an exponential decay
+    ///
+    /// Each pixel is set to 255 * exp(-(last_ts - t) / tau), t being its most recent timestamp across the channels
+    ///
+    /// @param last_ts Last timestamp value stored in the buffer
+    /// @param tau Time constant of the decay
+    /// @param out The produced image
+    inline void generate_img_time_surface_collapsing_channels_exponential_decay(timestamp_type last_ts, double tau,
+                                                                                cv::Mat &out) const;
+
 private:
+    template<typename Decay>
+    inline void generate_img(timestamp_type last_ts, const Decay &decay, cv::Mat &out) const;
+
+    template<typename Decay>
+    inline void generate_img_collapsing_channels(timestamp_type last_ts, const Decay &decay, cv::Mat &out) const;
+
     int rows_, cols_, channels_;           ///< Dimensions of the buffer
     int cols_channels_;                    ///< Total number of cells per row (columns x channels)
     std::vector<timestamp_type> tsbuffer_; ///< Buffer of the most recent timestamps
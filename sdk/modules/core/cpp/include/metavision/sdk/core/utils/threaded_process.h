@@ -15,19 +15,25 @@
 #include <memory>
 #include <condition_variable>
 #include <thread>
-#include <queue>
 #include <atomic>
+#include <chrono>
 #include <functional>
 
 #include "metavision/sdk/base/utils/object_pool.h"
+#include "metavision/sdk/base/utils/thread_policy.h"
+#include "metavision/sdk/core/utils/detail/mpsc_queue.h"
+#include "metavision/sdk/core/utils/detail/small_function.h"
 
 namespace Metavision {
 
 /// @brief A convenient object whose purpose is to queue and dequeue tasks in a thread
+///
+/// The tasks are queued without lock, the callables capturing a few pointers or references being stored without
+/// any other allocation than the one of their queue node. A repeating task keeps its node until it is done.
 class ThreadedProcess {
 public:
-    using Task          = std::function<void()>;
-    using RepeatingTask = std::function<bool()>;
+    using Task          = detail::SmallFunction<void()>;
+    using RepeatingTask = detail::SmallFunction<bool()>;
 
     /// @brief Destructor
     ///
@@ -41,6 +47,19 @@ public:
     /// @brief Adds a task that is repeated once it is done if and only if its result returns true.
     void add_repeating_task(RepeatingTask task);
 
+    /// @brief Sets the threading policy of the processing thread
+    ///
+    /// The policy is applied the next time the processing thread is started.
+    /// @param policy The threading policy
+    void set_thread_policy(const ThreadPolicy &policy);
+
+    /// @brief Sets how long the processing thread keeps polling for new tasks before sleeping, when it has none
+    ///
+    /// Polling lowers the latency of the tasks added at a high rate, at the expense of the CPU usage. By default,
+    /// the processing thread sleeps as soon as it has no task.
+    /// @param duration Polling duration, 0 to sleep right away
+    void set_spin_before_sleep(std::chrono::microseconds duration);
+
     /// @brief Starts the processing thread
     /// @return false if the processing thread is already started
     bool start();
@@ -59,15 +78,26 @@ public:
     bool is_active();
 
 private:
+    struct TaskNode : detail::MpscQueueNode {
+        Task task;
+        RepeatingTask repeating_task;
+    };
+
+    void push(TaskNode *node);
+    TaskNode *wait_next_task();
+    void clear_tasks();
     void stop(bool abort);
     void processing_thread();
 
 private:
-    std::queue<Task> tasks_;
+    detail::MpscQueue tasks_;
     std::thread processing_thread_;
+    ThreadPolicy thread_policy_;
     std::mutex process_mutex_;
     std::condition_variable process_cond_;
     std::atomic<bool> stop_{true}, abort_{true};
+    std::atomic<bool> sleeping_{false};
+    std::atomic<std::chrono::microseconds::rep> spin_before_sleep_us_{0};
 };
 
 } // namespace Metavision
@@ -20,6 +20,10 @@
 namespace Metavision {
 
 /// @brief Class used for profiling algorithms
+///
+/// With @ref detail::ConcurrencyPolicyLockFree and @ref detail::OperationStoragePolicyHistogram, the operations timed
+/// from any thread are accumulated without lock in per thread histograms, and the percentiles of their latencies are
+/// printed instead of their means. Timing operations interned with @ref intern is then cheap enough to be left enabled.
 template<bool do_profiling = true, typename ConcurrencyPolicy = detail::ConcurrencyPolicyThreadSafe,
          typename OperationStoragePolicy = detail::OperationStoragePolicyInsertionOrder,
          typename TimingPolicy           = detail::TimingPolicyUsingSTL>
@@ -46,10 +50,25 @@ public:
         /// @param profiler Instance of the profiler to use
         TimedOperation(const std::string &op, TimingProfiler *profiler) : TimedOperation(op, 0, profiler) {}
 
+        /// @brief Constructor for TimedOperation, from an operation interned by the profiler
+        ///
+        /// Contrary to the other constructors, neither a name is built nor a label is added to the profiler.
+        /// @param op Identifier of the operation, returned by @ref TimingProfiler::intern
+        /// @param num_processed_elements Number of elements processed by the operation
+        /// @param profiler Instance of the profiler to use
+        TimedOperation(const detail::OperationId &op, size_t num_processed_elements = 0,
+                       TimingProfiler *profiler = TimingProfiler::instance()) :
+            op_id_{op}, num_processed_elements_{num_processed_elements}, profiler_{profiler} {}
+
+        /// @brief Constructor for TimedOperation, from an operation interned by the profiler
+        /// @param op Identifier of the operation, returned by @ref TimingProfiler::intern
+        /// @param profiler Instance of the profiler to use
+        TimedOperation(const detail::OperationId &op, TimingProfiler *profiler) : TimedOperation(op, 0, profiler) {}
+
         /// @brief Destructor
         ~TimedOperation() {
             if (profiler_)
-                profiler_->add_timed_operation(op_, num_processed_elements_, t_.elapsed());
+                profiler_->add_timed_operation(op_id_, op_, num_processed_elements_, t_.elapsed());
         }
 
         /// @brief Sets the number of elements processed by the operation.
@@ -62,6 +81,7 @@ public:
 
     private:
         std::string op_;
+        detail::OperationId op_id_;
         size_t num_processed_elements_;
         TimingProfiler *profiler_;
         typename TimingPolicy::Timer t_;
@@ -70,7 +90,8 @@ public:
     /// @brief Constructor
     /// @param storage_policy Instance of the storage policy (instantiates a new one by default)
     TimingProfiler(const OperationStoragePolicy &storage_policy = OperationStoragePolicy()) :
-        storage_policy_{storage_policy}, printing_cb_{detail::PrinterUsingSTL<OperationStoragePolicy>()} {}
+        storage_policy_{storage_policy},
+        printing_cb_{typename detail::DefaultPrinter<OperationStoragePolicy>::type()} {}
 
     /// @brief Destructor
     ~TimingProfiler() {
@@ -94,6 +115,16 @@ public:
         storage_policy_.insert(op, num_processed_elements, times);
     }
 
+    /// @brief Interns an operation, so that it can then be timed without building its name nor looking it up
+    ///
+    /// Only available with storage policies supporting it, such as @ref detail::OperationStoragePolicyHistogram
+    /// @param op Name of the operation
+    /// @return The identifier of the operation, to give to the @ref TimedOperation
+    detail::OperationId intern(const std::string &op) {
+        auto protection = concurrency_policy_.protect_scope();
+        return storage_policy_.intern(op);
+    }
+
     /// @brief Gets the singleton instance of the profiler
     /// @return The profiler's singleton instance
     static TimingProfiler *instance() {
@@ -117,6 +148,12 @@ public:
     }
 
 private:
+    void add_timed_operation(const detail::OperationId &op_id, const std::string &op, size_t num_processed_elements,
+                             const detail::CpuTimes &times) {
+        auto protection = concurrency_policy_.protect_scope();
+        detail::insert_timed_operation(storage_policy_, op_id, op, num_processed_elements, times, 0);
+    }
+
     OperationStoragePolicy storage_policy_;
     mutable ConcurrencyPolicy concurrency_policy_;
     std::function<void(const OperationStoragePolicy &)> printing_cb_;
@@ -165,6 +202,10 @@ public:
         TimedOperation(const char *const, size_t) {}
         TimedOperation(const char *const, TimingProfiler *) {}
         TimedOperation(const char *const) {}
+        TimedOperation(const detail::OperationId &, size_t, TimingProfiler *) {}
+        TimedOperation(const detail::OperationId &, size_t) {}
+        TimedOperation(const detail::OperationId &, TimingProfiler *) {}
+        TimedOperation(const detail::OperationId &) {}
 
         void setNumProcessedElements(size_t) {}
     };
@@ -172,6 +213,10 @@ public:
     TimingProfiler() {}
     TimingProfiler(const OperationStoragePolicy &) {}
 
+    detail::OperationId intern(const std::string &) {
+        return detail::OperationId();
+    }
+
     template<typename T>
     void set_printing_callback(const T &) {}
 
@@ -54,7 +54,10 @@
 #ifndef METAVISION_SDK_CORE_VIDEO_WRITER_H
 #define METAVISION_SDK_CORE_VIDEO_WRITER_H
 
+#include <cstddef>
+#include <memory>
 #include <string>
+#include <vector>
 #include <opencv2/core.hpp>
 #include <opencv2/videoio.hpp>
 
@@ -72,6 +75,13 @@ The class provides C++ API for writing video files or image sequences.
 */
 class VideoWriter : public cv::VideoWriter {
 public:
+    /** @brief Behavior of @ref write in asynchronous mode when the queue of frames to encode is full
+     */
+    enum class AsyncQueuePolicy {
+        Block, ///< waits until a frame has been encoded
+        Drop   ///< drops the frame
+    };
+
     /** @brief Default constructors
      */
     VideoWriter();
@@ -205,8 +215,51 @@ public:
      */
     cv::String getBackendName() const;
 
+    /** @brief Returns the parameters to pass to @ref open to encode the video with hardware acceleration
+
+    The hardware accelerated encoders are those of OpenCV's backends (FFMPEG, GStreamer, Media Foundation), which
+    upload the frames and convert their pixel format on the device. They are used instead of the MJPEG encoder of this
+    class, that runs on the CPU, whenever hardware acceleration is requested.
+
+    @param acceleration Name of the acceleration: "none", "any" (first available one), "vaapi", "d3d11" or "mfx"
+    (Intel QuickSync)
+    @return Parameters to append to the ones passed to @ref open, empty if no acceleration is requested or if the
+    version of OpenCV does not support it
+    @throw std::invalid_argument if the acceleration is unknown
+     */
+    static std::vector<int> get_hw_acceleration_params(const std::string &acceleration);
+
+    /** @brief Enables or disables the asynchronous mode
+
+    In asynchronous mode, @ref write copies the frame to a frame recycled from a pool, and the frames are encoded by a
+    worker thread, so that the rendering of the next frames is not serialized with the encoding. The properties are
+    set and read by the worker thread too, in the order of the calls. The MJPEG encoder can additionally encode each
+    frame with several threads, see cv::VIDEOWRITER_PROP_NSTRIPES.
+
+    @param queue_size Maximum number of frames waiting to be encoded, 0 to disable the asynchronous mode. When
+    disabling it, or changing the size of the queue, the frames already queued are encoded first.
+    @param policy What to do with a frame written when the queue is full
+     */
+    void set_async(std::size_t queue_size, AsyncQueuePolicy policy = AsyncQueuePolicy::Block);
+
+    /** @brief Returns true if the asynchronous mode is enabled
+     */
+    bool is_async() const;
+
+    /** @brief Returns the number of frames dropped in asynchronous mode because the queue was full
+     */
+    std::size_t get_n_dropped_frames() const;
+
 private:
+    void write_frame(cv::InputArray image);
+    bool set_property(int propId, double value);
+    double get_property(int propId) const;
+
     cv::Ptr<cv45::IVideoWriter> writer_;
+
+    struct AsyncState;
+    std::unique_ptr<AsyncState> async_;
+    std::size_t n_dropped_frames_ = 0;
 };
 
 } // namespace Metavision
@@ -15,32 +15,26 @@
 
 #include <iostream>
 #include <functional>
-#include <fstream>
 #include <boost/program_options.hpp>
 #include <metavision/sdk/base/utils/log.h>
 #include <metavision/sdk/core/pipeline/pipeline.h>
+#include <metavision/sdk/core/utils/csv_event_file_reader.h>
 #include <metavision/sdk/core/pipeline/frame_generation_stage.h>
 #include <metavision/sdk/core/algorithms/polarity_filter_algorithm.h>
 #include <metavision/sdk/ui/utils/event_loop.h>
 #include <metavision/sdk/ui/pipeline/frame_display_stage.h>
 
 // A stage producing events from a CSV file with events written in the following format:
-// x1,y1,t1,p1
-// x2,y2,t2,p2
+// x1,y1,p1,t1
+// x2,y2,p2,t2
 // ...
-// xn,yn,tn,pn
+// xn,yn,pn,tn
+// The file is parsed in parallel by the worker threads of a CSVEventFileReader
 
 /// [PIPELINE_USAGE_DEFINE_STAGE_BEGIN]
 class CSVReadingStage : public Metavision::BaseStage {
 public:
-    CSVReadingStage(const std::string &filename) : ifs_(filename) {
-        if (!ifs_.is_open()) {
-            throw std::runtime_error("Unable to open " + filename);
-        }
-
-        cur_cd_buffer_ = cd_buffer_pool_.acquire();
-        cur_cd_buffer_->clear();
-
+    CSVReadingStage(const std::string &filename) : reader_(filename) {
         // this callback is called once the pipeline is started, so the stage knows it can start producing
         set_starting_callback([this]() {
             done_           = false;
@@ -58,30 +52,19 @@ public:
 
     /// [PIPELINE_USAGE_READ_BEGIN]
     void read() {
-        std::string line;
-        while (!done_ && std::getline(ifs_, line)) {
-            // once here, we know that the stage has not been stopped yet,
-            // so we read a line and may produce a buffer
-            std::istringstream iss(line);
-            std::vector<std::string> tokens;
-            std::string token;
-            while (std::getline(iss, token, ',')) {
-                tokens.push_back(token);
-            }
-            if (tokens.size() != 4) {
-                MV_LOG_ERROR() << "Invalid line : <" << line << "> ignored";
-            } else {
-                if (cur_cd_buffer_->size() > 5000) {
-                    // this is how a stage produces data to be consumed by the next stages
-                    produce(cur_cd_buffer_);
-                    cur_cd_buffer_ = cd_buffer_pool_.acquire();
-                    cur_cd_buffer_->clear();
-                }
-                cur_cd_buffer_->emplace_back(static_cast<unsigned short>(std::stoul(tokens[0])),
-                                             static_cast<unsigned short>(std::stoul(tokens[1])),
-                                             static_cast<short>(std::stoi(tokens[2])), std::stoll(tokens[3]));
+        auto cd_buffer = cd_buffer_pool_.acquire();
+        // the reader fills the buffer with the events of the next chunk of the file, parsed in the background
+        while (!done_ && reader_.read(*cd_buffer)) {
+            // once here, we know that the stage has not been stopped yet, so we may produce a buffer
+            if (!cd_buffer->empty()) {
+                // this is how a stage produces data to be consumed by the next stages
+                produce(cd_buffer);
+                cd_buffer = cd_buffer_pool_.acquire();
             }
         }
+        if (reader_.get_n_invalid_lines() > 0) {
+            MV_LOG_ERROR() << reader_.get_n_invalid_lines() << "invalid lines ignored";
+        }
         // notifies to the pipeline that this producer has no more data to produce
         complete();
     }
@@ -90,9 +73,8 @@ public:
 private:
     std::atomic<bool> done_;
     std::thread reading_thread_;
-    std::ifstream ifs_;
+    Metavision::CSVEventFileReader reader_;
     EventBufferPool cd_buffer_pool_;
-    EventBufferPtr cur_cd_buffer_;
 };
 /// [PIPELINE_USAGE_DEFINE_STAGE_END]
 
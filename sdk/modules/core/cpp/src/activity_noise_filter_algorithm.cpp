@@ -0,0 +1,238 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+#include "metavision/sdk/core/algorithms/activity_noise_filter_algorithm.h"
+
+namespace Metavision {
+
+namespace {
+
+// The maps of the bands have a column of pixels without event on the left of the sensor, and 2 on the right, so that
+// the 4 values loaded from the column on the left of any pixel are in the map
+constexpr int LeftBorder  = 1;
+constexpr int RightBorder = 2;
+
+// Returns true if one of the 8 neighbours of a pixel has an offset greater than or equal to a lower bound, given
+// pointers to the values on the left of the pixel in the row above, in its row and in the row below
+inline bool has_recent_neighbour(const std::int32_t *above, const std::int32_t *row, const std::int32_t *below,
+                                 std::int32_t lower) {
+#if defined(__AVX2__)
+    // The lower bound is greater than the offset of the pixels without event, it can be decremented
+    const __m128i bound = _mm_set1_epi32(lower - 1);
+    const __m128i up    = _mm_loadu_si128(reinterpret_cast<const __m128i *>(above));
+    const __m128i mid   = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row));
+    const __m128i down  = _mm_loadu_si128(reinterpret_cast<const __m128i *>(below));
+    __m128i recent      = _mm_or_si128(_mm_cmpgt_epi32(up, bound), _mm_cmpgt_epi32(down, bound));
+    // The pixel itself is not part of its neighbourhood
+    recent = _mm_or_si128(recent, _mm_and_si128(_mm_cmpgt_epi32(mid, bound), _mm_setr_epi32(-1, 0, -1, 0)));
+    return (_mm_movemask_ps(_mm_castsi128_ps(recent)) & 0x7) != 0;
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    static const std::uint32_t row_lanes[4]  = {~0u, 0, ~0u, 0};
+    static const std::uint32_t used_lanes[4] = {~0u, ~0u, ~0u, 0};
+    const int32x4_t bound                    = vdupq_n_s32(lower);
+    uint32x4_t recent = vorrq_u32(vcgeq_s32(vld1q_s32(above), bound), vcgeq_s32(vld1q_s32(below), bound));
+    recent            = vorrq_u32(recent, vandq_u32(vcgeq_s32(vld1q_s32(row), bound), vld1q_u32(row_lanes)));
+    return vmaxvq_u32(vandq_u32(recent, vld1q_u32(used_lanes))) != 0;
+#else
+    return above[0] >= lower || above[1] >= lower || above[2] >= lower || row[0] >= lower || row[2] >= lower ||
+           below[0] >= lower || below[1] >= lower || below[2] >= lower;
+#endif
+}
+
+// Sets the timestamp of a pixel in the map of a band, whose row 0 is the one just above the band
+inline void set_timestamp(CompactMostRecentTimestampBuffer &timestamps, int row, int x, timestamp t) {
+    timestamps.rebase(t);
+    *timestamps.ptr(row, x + LeftBorder) = timestamps.to_offset(t);
+}
+
+// Sets the timestamp of a pixel of a band in its map, and returns true if one of its neighbours has had an event less
+// than a threshold before it
+inline bool update_band(CompactMostRecentTimestampBuffer &timestamps, int row, int x, timestamp t,
+                        timestamp threshold) {
+    timestamps.rebase(t);
+    const std::int32_t offset = timestamps.to_offset(t);
+    const std::int32_t lower  = static_cast<std::int32_t>(std::max<timestamp>(
+        static_cast<timestamp>(offset) - threshold, CompactMostRecentTimestampBuffer::NoTimestamp + 1));
+    std::int32_t *left        = timestamps.ptr(row, x + LeftBorder - 1);
+    const bool supported      = has_recent_neighbour(left - timestamps.cols(), left, left + timestamps.cols(), lower);
+    left[1]                   = offset;
+    return supported;
+}
+
+// Accessors to the fields of the events of a buffer
+struct EventArray {
+    int x(size_t i) const {
+        return events[i].x;
+    }
+    int y(size_t i) const {
+        return events[i].y;
+    }
+    timestamp t(size_t i) const {
+        return events[i].t;
+    }
+    const EventCD *events;
+};
+
+struct EventArraySoA {
+    int x(size_t i) const {
+        return xs[i];
+    }
+    int y(size_t i) const {
+        return ys[i];
+    }
+    timestamp t(size_t i) const {
+        return ts[i];
+    }
+    const unsigned short *xs, *ys;
+    const timestamp *ts;
+};
+
+} // namespace
+
+ActivityNoiseFilterAlgorithm::ActivityNoiseFilterAlgorithm(int width, int height, timestamp threshold_us,
+                                                           int num_threads) :
+    width_(width), height_(height) {
+    if (width <= 0 || height <= 0) {
+        throw std::invalid_argument("The size of the sensor must be positive");
+    }
+    if (num_threads < 1 || num_threads > std::numeric_limits<std::uint16_t>::max()) {
+        throw std::invalid_argument("The number of threads must be between 1 and 65535");
+    }
+    set_threshold(threshold_us);
+
+    // Each band has at least one row
+    const int num_bands = std::min(num_threads, height);
+    row_to_band_.resize(height);
+    for (int b = 0; b < num_bands; ++b) {
+        Band band;
+        band.first_row = static_cast<int>(static_cast<std::int64_t>(height) * b / num_bands);
+        band.last_row  = static_cast<int>(static_cast<std::int64_t>(height) * (b + 1) / num_bands);
+        band.timestamps.create(band.last_row - band.first_row + 2, LeftBorder + width + RightBorder);
+        std::fill(row_to_band_.begin() + band.first_row, row_to_band_.begin() + band.last_row,
+                  static_cast<std::uint16_t>(b));
+        bands_.emplace_back(std::move(band));
+    }
+}
+
+void ActivityNoiseFilterAlgorithm::set_threshold(timestamp threshold_us) {
+    if (threshold_us < 0) {
+        throw std::invalid_argument("The threshold of the filter must not be negative");
+    }
+    threshold_ = threshold_us;
+}
+
+timestamp ActivityNoiseFilterAlgorithm::get_threshold() const {
+    return threshold_;
+}
+
+void ActivityNoiseFilterAlgorithm::reset() {
+    for (auto &band : bands_) {
+        band.timestamps.reset();
+    }
+}
+
+bool ActivityNoiseFilterAlgorithm::process_event(int x, int y, timestamp t) {
+    if (x < 0 || y < 0 || x >= width_ || y >= height_) {
+        return false;
+    }
+    // The rows on the edges of a band are also in the map of the neighbouring band
+    const size_t b = row_to_band_[y];
+    Band &band     = bands_[b];
+    if (y == band.first_row && b > 0) {
+        Band &above = bands_[b - 1];
+        set_timestamp(above.timestamps, above.last_row - above.first_row + 1, x, t);
+    }
+    if (y == band.last_row - 1 && b + 1 < bands_.size()) {
+        set_timestamp(bands_[b + 1].timestamps, 0, x, t);
+    }
+    return update_band(band.timestamps, y - band.first_row + 1, x, t, threshold_);
+}
+
+template<typename Events>
+void ActivityNoiseFilterAlgorithm::compute_kept(const Events &events, size_t n) {
+    kept_.assign(n, 0);
+    // Each band goes through all the events, and only keeps track of the ones of its rows and of the rows just above
+    // and below. The flags of the events are set by the band of their row, so that no memory is written concurrently
+    auto process_band = [this, &events, n](Band &band) {
+        const int first_row = band.first_row - 1, last_row = band.last_row + 1;
+        for (size_t i = 0; i < n; ++i) {
+            const int x = events.x(i), y = events.y(i);
+            if (y < first_row || y >= last_row || y >= height_ || x < 0 || x >= width_) {
+                continue;
+            }
+            if (y >= band.first_row && y < band.last_row) {
+                kept_[i] = update_band(band.timestamps, y - first_row, x, events.t(i), threshold_);
+            } else {
+                set_timestamp(band.timestamps, y - first_row, x, events.t(i));
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t b = 1; b < bands_.size(); ++b) {
+        threads.emplace_back(process_band, std::ref(bands_[b]));
+    }
+    process_band(bands_[0]);
+    for (auto &thread : threads) {
+        thread.join();
+    }
+}
+
+void ActivityNoiseFilterAlgorithm::process_events(const std::vector<EventCD> &input, std::vector<EventCD> &output) {
+    const size_t n = input.size();
+    compute_kept(EventArray{input.data()}, n);
+
+    // Writing in place is safe as the output index never exceeds the input one
+    output.resize(n);
+    const EventCD *in = input.data();
+    EventCD *out      = output.data();
+    size_t n_out      = 0;
+    for (size_t i = 0; i < n; ++i) {
+        out[n_out] = in[i];
+        n_out += kept_[i];
+    }
+    output.resize(n_out);
+}
+
+void ActivityNoiseFilterAlgorithm::process_events(const EventCDBufferSoA &input, EventCDBufferSoA &output) {
+    const size_t n = input.size();
+    compute_kept(EventArraySoA{input.x(), input.y(), input.t()}, n);
+
+    output.resize(n);
+    const unsigned short *in_x = input.x(), *in_y = input.y();
+    const short *in_p          = input.p();
+    const timestamp *in_t      = input.t();
+    unsigned short *out_x = output.x(), *out_y = output.y();
+    short *out_p          = output.p();
+    timestamp *out_t      = output.t();
+    size_t n_out          = 0;
+    for (size_t i = 0; i < n; ++i) {
+        out_x[n_out] = in_x[i];
+        out_y[n_out] = in_y[i];
+        out_p[n_out] = in_p[i];
+        out_t[n_out] = in_t[i];
+        n_out += kept_[i];
+    }
+    output.resize(n_out);
+}
+
+} // namespace Metavision
@@ -9,13 +9,25 @@
  * See the License for the specific language governing permissions and limitations under the License.                 *
  **********************************************************************************************************************/
 
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+
 #include "metavision/sdk/core/utils/cd_frame_generator.h"
 #include "metavision/sdk/core/utils/colors.h"
 
 namespace Metavision {
 
-CDFrameGenerator::CDFrameGenerator(long width, long height, bool process_all_frames) :
-    process_all_frames_(process_all_frames) {
+CDFrameGenerator::CDFrameGenerator(long width, long height, bool process_all_frames,
+                                   EventsTransfer events_transfer) :
+    process_all_frames_(process_all_frames), events_transfer_(events_transfer), width_(width), height_(height) {
+    if (events_transfer_ == EventsTransfer::TimeSurface) {
+        if (process_all_frames_) {
+            throw std::invalid_argument("The time surface transfer of the events only generates the latest frame.");
+        }
+        time_surface_.reset(new std::atomic<std::uint64_t>[width * height]());
+    }
+
     // Builds algo
     frame_generation_algo_.reset(new PeriodicFrameGenerationAlgorithm(width, height));
 
@@ -64,6 +76,23 @@ void CDFrameGenerator::add_events(const EventCD *begin, const EventCD *end) {
         return;
     }
 
+    if (events_transfer_ == EventsTransfer::TimeSurface) {
+        // Only the timing of the frames is shared with the generator thread, the pixels being read without lock
+        for (auto it = begin; it != end; ++it) {
+            time_surface_[it->y * width_ + it->x].store((static_cast<std::uint64_t>(it->t + 1) << 1) | it->p,
+                                                        std::memory_order_relaxed);
+        }
+        const timestamp last_ts_us = std::prev(end)->t;
+        last_ts_us_.store(last_ts_us, std::memory_order_relaxed);
+        if (last_ts_us >= next_notify_us_) {
+            next_notify_us_ = frame_period_us_ * (1 + last_ts_us / frame_period_us_);
+            std::lock_guard<std::mutex> lock(processing_mutex_);
+            events_available_ = true;
+            events_available_cond_.notify_all();
+        }
+        return;
+    }
+
     std::lock_guard<std::mutex> lock(processing_mutex_);
     // Note: one could call frame_generation_algorithm->process_events directly but it may have a high overhead
     // depending on the inputs.and decreases the performance. Better ensure that bigger chunks of data are processed
@@ -112,6 +141,57 @@ bool CDFrameGenerator::generate() {
     return !stop_;
 }
 
+bool CDFrameGenerator::generate_from_time_surface() {
+    timestamp accumulation_time_us;
+    cv::Vec3b bg_color;
+    std::array<cv::Vec3b, 2> off_on_colors;
+    bool colored;
+    {
+        std::unique_lock<std::mutex> lock(processing_mutex_);
+        events_available_cond_.wait(lock, [this]() { return events_available_ || stop_; });
+        if (!events_available_) {
+            return false;
+        }
+        events_available_ = false;
+
+        accumulation_time_us = accumulation_time_us_;
+        for (int i = 0; i < 3; ++i) {
+            bg_color[i]         = static_cast<uchar>(background_color_[i]);
+            off_on_colors[1][i] = static_cast<uchar>(on_color_[i]);
+            off_on_colors[0][i] = static_cast<uchar>(off_color_[i]);
+        }
+        colored = colored_;
+    }
+
+    // The pixels whose latest event is older than the accumulation time, or which have none, show the background
+    const timestamp last_ts_us = last_ts_us_.load(std::memory_order_relaxed);
+    const std::uint64_t min_value =
+        static_cast<std::uint64_t>(std::max(timestamp(0), last_ts_us - accumulation_time_us) + 1) << 1;
+
+    auto &frame = frames_[0].frame_;
+    frame.create(height_, width_, colored ? CV_8UC3 : CV_8UC1);
+    const std::atomic<std::uint64_t> *pixel = time_surface_.get();
+    for (int y = 0; y < height_; ++y) {
+        if (colored) {
+            auto *row = frame.ptr<cv::Vec3b>(y);
+            for (int x = 0; x < width_; ++x, ++pixel) {
+                const std::uint64_t value = pixel->load(std::memory_order_relaxed);
+                row[x]                    = value >= min_value ? off_on_colors[value & 1] : bg_color;
+            }
+        } else {
+            auto *row = frame.ptr<uchar>(y);
+            for (int x = 0; x < width_; ++x, ++pixel) {
+                const std::uint64_t value = pixel->load(std::memory_order_relaxed);
+                row[x]                    = value >= min_value ? off_on_colors[value & 1][0] : bg_color[0];
+            }
+        }
+    }
+    frames_[0].ts_us_ = last_ts_us;
+    frame_cb_(frames_[0].ts_us_, frames_[0].frame_);
+
+    return !stop_;
+}
+
 bool CDFrameGenerator::start(std::uint16_t fps, const PeriodicFrameGenerationAlgorithm::OutputCb &cb) {
     auto ret = processing_thread_.start();
     if (!ret) {
@@ -132,6 +212,22 @@ bool CDFrameGenerator::start(std::uint16_t fps, const PeriodicFrameGenerationAlg
         ++frames_count_;
     });
 
+    if (events_transfer_ == EventsTransfer::TimeSurface) {
+        std::fill(time_surface_.get(), time_surface_.get() + width_ * height_, 0);
+        frames_.resize(1);
+        {
+            std::lock_guard<std::mutex> lock(processing_mutex_);
+            // As with the periodic frame generation, a frame rate of 0 generates a frame per accumulation time
+            frame_period_us_ =
+                std::max(timestamp(1), fps > 0 ? static_cast<timestamp>(1e6 / fps) : accumulation_time_us_);
+            next_notify_us_   = 0;
+            events_available_ = false;
+        }
+        stop_ = false;
+        processing_thread_.add_repeating_task(std::bind(&CDFrameGenerator::generate_from_time_surface, this));
+        return true;
+    }
+
     stop_ = false;
 
     processing_thread_.add_repeating_task(std::bind(&CDFrameGenerator::generate, this));
@@ -0,0 +1,164 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+
+#include "metavision/sdk/core/algorithms/cd_trigger_merger_algorithm.h"
+
+namespace Metavision {
+
+namespace {
+
+// Returns the first event of the time ordered range [begin, end) whose timestamp is not before t
+template<typename Event>
+const Event *find_time(const Event *begin, const Event *end, timestamp t) {
+    return std::lower_bound(begin, end, t, [](const Event &ev, timestamp t) { return ev.t < t; });
+}
+
+} // namespace
+
+CDTriggerMergerAlgorithm::CDTriggerMergerAlgorithm(const CDTriggerMergerConfig &config) : config_(config) {
+    if (config.max_skew_us < 0) {
+        throw std::invalid_argument("The maximum skew between the CD and trigger events can not be negative.");
+    }
+}
+
+void CDTriggerMergerAlgorithm::set_cd_events_callback(const CDEventsCallback &cb) {
+    cd_events_cb_ = cb;
+}
+
+void CDTriggerMergerAlgorithm::set_trigger_event_callback(const TriggerEventCallback &cb) {
+    trigger_event_cb_ = cb;
+}
+
+void CDTriggerMergerAlgorithm::set_slice_callback(const SliceCallback &cb) {
+    slice_cb_ = cb;
+}
+
+void CDTriggerMergerAlgorithm::process_cd_events(const EventCD *begin, const EventCD *end) {
+    if (begin == end) {
+        return;
+    }
+    // The events being time ordered, the late ones are the first ones
+    const EventCD *first = find_time(begin, end, output_until_);
+    num_late_events_ += std::distance(begin, first);
+    cd_events_.insert(cd_events_.end(), first, end);
+    cd_time_ = std::max(cd_time_, std::prev(end)->t);
+    update();
+}
+
+void CDTriggerMergerAlgorithm::process_trigger_events(const EventExtTrigger *begin, const EventExtTrigger *end) {
+    if (begin == end) {
+        return;
+    }
+    const EventExtTrigger *first = find_time(begin, end, output_until_);
+    num_late_events_ += std::distance(begin, first);
+    trigger_events_.insert(trigger_events_.end(), first, end);
+    trigger_time_ = std::max(trigger_time_, std::prev(end)->t);
+    update();
+}
+
+void CDTriggerMergerAlgorithm::advance_time(timestamp ts) {
+    cd_time_      = std::max(cd_time_, ts);
+    trigger_time_ = std::max(trigger_time_, ts);
+    update();
+}
+
+void CDTriggerMergerAlgorithm::flush() {
+    const timestamp newest = std::max(cd_time_, trigger_time_);
+    if (newest != std::numeric_limits<timestamp>::min() && newest + 1 > output_until_) {
+        output(newest + 1);
+    }
+    if (has_slice_ && slice_cb_) {
+        const timestamp end_ts = (slice_events_.empty() ? slice_edge_.t : slice_events_.back().t) + 1;
+        slice_cb_(slice_edge_, end_ts, slice_events_.data(), slice_events_.data() + slice_events_.size());
+    }
+    has_slice_ = false;
+    slice_events_.clear();
+}
+
+void CDTriggerMergerAlgorithm::reset() {
+    cd_events_.clear();
+    trigger_events_.clear();
+    cd_time_         = std::numeric_limits<timestamp>::min();
+    trigger_time_    = std::numeric_limits<timestamp>::min();
+    output_until_    = std::numeric_limits<timestamp>::min();
+    num_late_events_ = 0;
+    has_slice_       = false;
+    slice_events_.clear();
+}
+
+size_t CDTriggerMergerAlgorithm::get_num_late_events() const {
+    return num_late_events_;
+}
+
+void CDTriggerMergerAlgorithm::update() {
+    // A stream more than the maximum skew behind the other one is not waited for anymore
+    const timestamp newest            = std::max(cd_time_, trigger_time_);
+    const timestamp not_waited_before = newest - config_.max_skew_us;
+    const timestamp until = std::min(std::max(cd_time_, not_waited_before), std::max(trigger_time_, not_waited_before));
+    if (until > output_until_) {
+        output(until);
+    }
+}
+
+void CDTriggerMergerAlgorithm::output(timestamp until) {
+    output_until_ = until;
+
+    // Two-way merge: each trigger is preceded by the run of CD events older than it
+    const EventCD *cd_begin                   = cd_events_.data();
+    const EventCD *const cd_end               = find_time(cd_begin, cd_begin + cd_events_.size(), until);
+    const EventExtTrigger *trigger            = trigger_events_.data();
+    const EventExtTrigger *const triggers_end = find_time(trigger, trigger + trigger_events_.size(), until);
+    for (; trigger != triggers_end; ++trigger) {
+        const EventCD *run_end = find_time(cd_begin, cd_end, trigger->t);
+        output_cd_events(cd_begin, run_end);
+        cd_begin = run_end;
+        output_trigger_event(*trigger);
+    }
+    output_cd_events(cd_begin, cd_end);
+
+    // The events output are removed, the buffers keeping their capacity
+    cd_events_.erase(cd_events_.begin(), cd_events_.begin() + (cd_end - cd_events_.data()));
+    trigger_events_.erase(trigger_events_.begin(), trigger_events_.begin() + (triggers_end - trigger_events_.data()));
+}
+
+void CDTriggerMergerAlgorithm::output_cd_events(const EventCD *begin, const EventCD *end) {
+    if (begin == end) {
+        return;
+    }
+    if (cd_events_cb_) {
+        cd_events_cb_(begin, end);
+    }
+    if (has_slice_ && slice_cb_) {
+        slice_events_.insert(slice_events_.end(), begin, end);
+    }
+}
+
+void CDTriggerMergerAlgorithm::output_trigger_event(const EventExtTrigger &trigger) {
+    if (trigger_event_cb_) {
+        trigger_event_cb_(trigger);
+    }
+    if (!slice_cb_ || trigger.p != config_.slice_edge_polarity ||
+        (config_.slice_edge_channel >= 0 && trigger.id != config_.slice_edge_channel)) {
+        return;
+    }
+    if (has_slice_) {
+        slice_cb_(slice_edge_, trigger.t, slice_events_.data(), slice_events_.data() + slice_events_.size());
+        slice_events_.clear();
+    }
+    slice_edge_ = trigger;
+    has_slice_  = true;
+}
+
+} // namespace Metavision
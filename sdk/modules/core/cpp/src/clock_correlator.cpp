@@ -0,0 +1,130 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "metavision/sdk/core/utils/clock_correlator.h"
+
+namespace Metavision {
+
+int64_t ClockCorrelation::to_host_time_us(timestamp device_time_us) const {
+    const int64_t dt = device_time_us - reference_device_time_us_;
+    return reference_host_time_us_ + dt + std::llround(dt * drift_ppm_ * 1e-6);
+}
+
+timestamp ClockCorrelation::to_device_time_us(int64_t host_time_us) const {
+    const int64_t dt = host_time_us - reference_host_time_us_;
+    return reference_device_time_us_ + std::llround(dt / (1. + drift_ppm_ * 1e-6));
+}
+
+ClockCorrelator::ClockCorrelator(timestamp bin_duration_us, size_t num_bins) :
+    bin_duration_us_(bin_duration_us), num_bins_(num_bins) {
+    if (bin_duration_us <= 0) {
+        throw std::invalid_argument("The duration of the bins of the clock correlator must be positive.");
+    }
+    if (num_bins < 2) {
+        throw std::invalid_argument("The clock correlator needs at least 2 bins to estimate the drift.");
+    }
+}
+
+void ClockCorrelator::add_sample(timestamp device_time_us, int64_t host_time_us) {
+    // Rounds towards minus infinity, so that the bins have the same duration around 0
+    const int64_t index =
+        device_time_us >= 0 ? device_time_us / bin_duration_us_ : -((-device_time_us - 1) / bin_duration_us_) - 1;
+    const int64_t offset_us = host_time_us - device_time_us;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!bins_.empty() && index < bins_.back().index - 1) {
+        bins_.clear();
+        num_samples_ = 0;
+    }
+    ++num_samples_;
+    correlation_.num_samples_ = num_samples_;
+
+    if (bins_.empty() || index > bins_.back().index) {
+        bins_.push_back({index, device_time_us, offset_us});
+        if (bins_.size() > num_bins_) {
+            bins_.pop_front();
+        }
+        fit();
+        return;
+    }
+
+    // The sample belongs to one of the last bins, the relation only changes if it lowers the minimum of the bin
+    for (auto it = bins_.rbegin(); it != bins_.rend() && it->index >= index; ++it) {
+        if (it->index == index) {
+            if (offset_us < it->offset_us) {
+                it->device_time_us = device_time_us;
+                it->offset_us      = offset_us;
+                fit();
+            }
+            return;
+        }
+    }
+}
+
+ClockCorrelation ClockCorrelator::get_correlation() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return correlation_;
+}
+
+void ClockCorrelator::reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    bins_.clear();
+    num_samples_ = 0;
+    correlation_ = ClockCorrelation();
+}
+
+void ClockCorrelator::fit() {
+    // Least squares fit of the minimum offsets, centered on their mean to keep the precision of the large timestamps
+    const Bin &reference = bins_.back();
+    double mean_t = 0., mean_offset = 0.;
+    for (const auto &bin : bins_) {
+        mean_t += bin.device_time_us - reference.device_time_us;
+        mean_offset += bin.offset_us - reference.offset_us;
+    }
+    mean_t /= bins_.size();
+    mean_offset /= bins_.size();
+
+    double cov = 0., var = 0.;
+    for (const auto &bin : bins_) {
+        const double dt = bin.device_time_us - reference.device_time_us - mean_t;
+        cov += dt * (bin.offset_us - reference.offset_us - mean_offset);
+        var += dt * dt;
+    }
+    const double slope = var > 0. ? cov / var : 0.;
+
+    // Lowers the line below all the minima, as the observations can only be delayed
+    auto residual = [&](const Bin &bin) {
+        return bin.offset_us - reference.offset_us - mean_offset -
+               slope * (bin.device_time_us - reference.device_time_us - mean_t);
+    };
+    double shift = 0.;
+    for (const auto &bin : bins_) {
+        shift = std::min(shift, residual(bin));
+    }
+    double sum_squares = 0.;
+    for (const auto &bin : bins_) {
+        const double distance = residual(bin) - shift;
+        sum_squares += distance * distance;
+    }
+
+    correlation_.valid_                    = true;
+    correlation_.reference_device_time_us_ = reference.device_time_us;
+    correlation_.reference_host_time_us_ =
+        reference.device_time_us + reference.offset_us + std::llround(mean_offset - slope * mean_t + shift);
+    correlation_.drift_ppm_ = slope * 1e6;
+    correlation_.jitter_us_ = std::sqrt(sum_squares / bins_.size());
+}
+
+} // namespace Metavision
@@ -0,0 +1,290 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include "metavision/sdk/core/utils/columnar_event_file.h"
+
+namespace Metavision {
+
+namespace {
+
+constexpr char Magic[8]      = {'M', 'V', 'C', 'O', 'L', 'E', 'V', 'T'};
+const std::string FormatKey  = "Format";
+const std::string FormatName = "columnar";
+const std::string VersionKey = "Version";
+const std::string Version    = "1";
+
+// Header of a block in the file: number of events, size of the timestamps column and timestamp of the first event.
+// The timestamps column holds the zigzag encoded differences between successive timestamps, as variable length
+// integers
+struct BlockHeader {
+    uint32_t n_events;
+    uint32_t t_bytes;
+    timestamp t_first;
+};
+
+// Entry of the footer of the file, i.e. a ColumnarEventBlockInfo without the index of the first event
+struct FooterEntry {
+    uint64_t offset;
+    uint32_t n_events;
+    uint32_t size;
+    timestamp t_min;
+    timestamp t_max;
+};
+
+struct Trailer {
+    uint64_t n_blocks;
+    uint64_t footer_offset;
+    char magic[sizeof(Magic)];
+};
+
+void append_varint(std::vector<uint8_t> &buffer, uint64_t value) {
+    while (value >= 0x80) {
+        buffer.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    buffer.push_back(static_cast<uint8_t>(value));
+}
+
+uint64_t zigzag_encode(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+int64_t zigzag_decode(uint64_t value) {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+} // namespace
+
+constexpr size_t ColumnarEventFileWriter::DefaultBlockSize;
+
+ColumnarEventFileWriter::ColumnarEventFileWriter(const std::string &filename, int width, int height,
+                                                 size_t block_size) :
+    output_(filename, std::ios::binary), block_size_(std::max<size_t>(1, block_size)) {
+    if (!output_.is_open()) {
+        throw std::runtime_error("Could not open file " + filename);
+    }
+
+    GenericHeader header;
+    header.set_field(FormatKey, FormatName);
+    header.set_field(VersionKey, Version);
+    header.set_field("Width", std::to_string(width));
+    header.set_field("Height", std::to_string(height));
+    header.add_date();
+    output_ << header;
+    offset_ = static_cast<uint64_t>(output_.tellp());
+    block_.reserve(block_size_);
+}
+
+ColumnarEventFileWriter::~ColumnarEventFileWriter() {
+    close();
+}
+
+void ColumnarEventFileWriter::close() {
+    if (!output_.is_open()) {
+        return;
+    }
+    write_block();
+
+    const uint64_t footer_offset = offset_;
+    for (const auto &block : blocks_) {
+        const FooterEntry entry{block.offset_, block.n_events_, block.size_, block.t_min_, block.t_max_};
+        output_.write(reinterpret_cast<const char *>(&entry), sizeof(entry));
+    }
+    Trailer trailer{blocks_.size(), footer_offset, {}};
+    std::memcpy(trailer.magic, Magic, sizeof(Magic));
+    output_.write(reinterpret_cast<const char *>(&trailer), sizeof(trailer));
+    output_.close();
+}
+
+uint64_t ColumnarEventFileWriter::get_n_events() const {
+    return n_events_ + block_.size();
+}
+
+uint64_t ColumnarEventFileWriter::get_n_bytes() const {
+    return offset_;
+}
+
+void ColumnarEventFileWriter::write_block() {
+    const size_t n = block_.size();
+    if (n == 0) {
+        return;
+    }
+
+    const timestamp *t = block_.t();
+    encoded_.clear();
+    encoded_.resize(sizeof(BlockHeader));
+    timestamp previous = t[0];
+    timestamp t_min = t[0], t_max = t[0];
+    for (size_t i = 0; i < n; ++i) {
+        append_varint(encoded_, zigzag_encode(t[i] - previous));
+        previous = t[i];
+        t_min    = std::min(t_min, t[i]);
+        t_max    = std::max(t_max, t[i]);
+    }
+    const BlockHeader header{static_cast<uint32_t>(n), static_cast<uint32_t>(encoded_.size() - sizeof(BlockHeader)),
+                             t[0]};
+    std::memcpy(encoded_.data(), &header, sizeof(header));
+
+    // The coordinates are stored as is, so that they are read back with a copy
+    const size_t coordinates_offset = encoded_.size();
+    encoded_.resize(coordinates_offset + 2 * n * sizeof(uint16_t) + (n + 7) / 8, 0);
+    std::memcpy(encoded_.data() + coordinates_offset, block_.x(), n * sizeof(uint16_t));
+    std::memcpy(encoded_.data() + coordinates_offset + n * sizeof(uint16_t), block_.y(), n * sizeof(uint16_t));
+    uint8_t *polarities = encoded_.data() + coordinates_offset + 2 * n * sizeof(uint16_t);
+    const short *p      = block_.p();
+    for (size_t i = 0; i < n; ++i) {
+        polarities[i / 8] |= static_cast<uint8_t>((p[i] > 0 ? 1 : 0) << (i % 8));
+    }
+
+    output_.write(reinterpret_cast<const char *>(encoded_.data()), encoded_.size());
+    blocks_.push_back(
+        {offset_, n_events_, static_cast<uint32_t>(n), static_cast<uint32_t>(encoded_.size()), t_min, t_max});
+    offset_ += encoded_.size();
+    n_events_ += n;
+    block_.clear();
+}
+
+ColumnarEventFileReader::ColumnarEventFileReader(const std::string &filename) : file_(filename, std::ios::binary) {
+    if (!file_.is_open()) {
+        throw std::runtime_error("Could not open file " + filename);
+    }
+    header_ = GenericHeader(file_);
+    if (header_.get_field(FormatKey) != FormatName) {
+        throw std::runtime_error("File " + filename + " is not a columnar event file");
+    }
+
+    Trailer trailer;
+    file_.seekg(-static_cast<std::streamoff>(sizeof(trailer)), std::ios::end);
+    if (!file_.read(reinterpret_cast<char *>(&trailer), sizeof(trailer)) ||
+        std::memcmp(trailer.magic, Magic, sizeof(Magic)) != 0) {
+        throw std::runtime_error("Columnar event file " + filename + " has no footer, it has not been closed");
+    }
+
+    std::vector<FooterEntry> entries(trailer.n_blocks);
+    file_.seekg(trailer.footer_offset);
+    if (!file_.read(reinterpret_cast<char *>(entries.data()), entries.size() * sizeof(FooterEntry))) {
+        throw std::runtime_error("Could not read the footer of columnar event file " + filename);
+    }
+    blocks_.reserve(entries.size());
+    max_timestamps_.reserve(entries.size());
+    for (const auto &entry : entries) {
+        ordered_ = ordered_ && (blocks_.empty() || entry.t_min >= blocks_.back().t_min_);
+        blocks_.push_back({entry.offset, n_events_, entry.n_events, entry.size, entry.t_min, entry.t_max});
+        max_timestamps_.push_back(max_timestamps_.empty() ? entry.t_max :
+                                                            std::max(max_timestamps_.back(), entry.t_max));
+        n_events_ += entry.n_events;
+    }
+}
+
+bool ColumnarEventFileReader::is_columnar_event_file(const std::string &filename) {
+    std::ifstream file(filename, std::ios::binary);
+    return file.is_open() && GenericHeader(file).get_field(FormatKey) == FormatName;
+}
+
+const GenericHeader &ColumnarEventFileReader::get_header() const {
+    return header_;
+}
+
+uint64_t ColumnarEventFileReader::get_n_events() const {
+    return n_events_;
+}
+
+const std::vector<ColumnarEventBlockInfo> &ColumnarEventFileReader::get_blocks() const {
+    return blocks_;
+}
+
+timestamp ColumnarEventFileReader::get_first_timestamp() const {
+    if (blocks_.empty()) {
+        return 0;
+    }
+    return std::min_element(blocks_.begin(), blocks_.end(),
+                            [](const ColumnarEventBlockInfo &a, const ColumnarEventBlockInfo &b) {
+                                return a.t_min_ < b.t_min_;
+                            })
+        ->t_min_;
+}
+
+timestamp ColumnarEventFileReader::get_last_timestamp() const {
+    return max_timestamps_.empty() ? -1 : max_timestamps_.back();
+}
+
+size_t ColumnarEventFileReader::find_block(timestamp t) const {
+    return std::distance(max_timestamps_.begin(), std::lower_bound(max_timestamps_.begin(), max_timestamps_.end(), t));
+}
+
+void ColumnarEventFileReader::read_block(size_t block, EventCDBufferSoA &events) const {
+    const auto &info = blocks_.at(block);
+    encoded_.resize(info.size_);
+    file_.clear();
+    file_.seekg(info.offset_);
+    BlockHeader header;
+    if (info.size_ < sizeof(header) || !file_.read(reinterpret_cast<char *>(encoded_.data()), info.size_)) {
+        throw std::runtime_error("Could not read block " + std::to_string(block) + " of columnar event file");
+    }
+    std::memcpy(&header, encoded_.data(), sizeof(header));
+    const size_t n = header.n_events;
+    if (n != info.n_events_ || sizeof(header) + header.t_bytes + 2 * n * sizeof(uint16_t) + (n + 7) / 8 != info.size_) {
+        throw std::runtime_error("Corrupted block " + std::to_string(block) + " in columnar event file");
+    }
+
+    events.resize(n);
+    const uint8_t *data = encoded_.data() + sizeof(header);
+    const uint8_t *end  = data + header.t_bytes;
+    timestamp *t        = events.t();
+    timestamp previous  = header.t_first;
+    for (size_t i = 0; i < n; ++i) {
+        uint64_t value = 0;
+        for (int shift = 0; data < end; shift += 7) {
+            const uint8_t byte = *data++;
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) {
+                break;
+            }
+        }
+        previous += zigzag_decode(value);
+        t[i] = previous;
+    }
+
+    std::memcpy(events.x(), end, n * sizeof(uint16_t));
+    std::memcpy(events.y(), end + n * sizeof(uint16_t), n * sizeof(uint16_t));
+    const uint8_t *polarities = end + 2 * n * sizeof(uint16_t);
+    short *p                  = events.p();
+    for (size_t i = 0; i < n; ++i) {
+        p[i] = (polarities[i / 8] >> (i % 8)) & 1;
+    }
+}
+
+void ColumnarEventFileReader::read_window(timestamp begin, timestamp end, EventCDBufferSoA &events) const {
+    events.clear();
+    for (size_t i = find_block(begin); i < blocks_.size(); ++i) {
+        const auto &info = blocks_[i];
+        if (info.t_max_ < begin || info.t_min_ >= end) {
+            // When the events are written in order, no block after this one has events in the window
+            if (info.t_min_ >= end && ordered_) {
+                break;
+            }
+            continue;
+        }
+        read_block(i, block_);
+        for (size_t j = 0, n = block_.size(); j < n; ++j) {
+            const timestamp t = block_.t()[j];
+            if (t >= begin && t < end) {
+                events.push_back(block_.x()[j], block_.y()[j], block_.p()[j], t);
+            }
+        }
+    }
+}
+
+} // namespace Metavision
@@ -0,0 +1,88 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+#include "metavision/sdk/core/algorithms/concurrent_frame_generation_algorithm.h"
+
+namespace Metavision {
+
+constexpr std::int64_t ConcurrentFrameGenerationAlgorithm::NoEvent;
+
+ConcurrentFrameGenerationAlgorithm::ConcurrentFrameGenerationAlgorithm(int width, int height,
+                                                                       uint32_t accumulation_time_us,
+                                                                       const Metavision::ColorPalette &palette) :
+    BaseFrameGenerationAlgorithm(width, height, palette),
+    pixels_(new std::atomic<std::int64_t>[static_cast<size_t>(width) * height]) {
+    set_accumulation_time_us(accumulation_time_us);
+    reset();
+}
+
+void ConcurrentFrameGenerationAlgorithm::generate(timestamp ts, cv::Mat &frame, bool allocate) const {
+    if (allocate)
+        frame.create(height_, width_, colored_ ? CV_8UC3 : CV_8U);
+
+    if (frame.rows != height_ || frame.cols != width_ || frame.type() != (colored_ ? CV_8UC3 : CV_8UC1)) {
+        std::ostringstream ss;
+        ss << "Incompatible matrix. Must be (" << height_ << ", " << width_ << ") of type "
+           << (colored_ ? "CV_8UC3" : "CV_8UC1") << ".";
+        throw std::invalid_argument(ss.str());
+    }
+
+    // A pixel is shown if its last event is in ]ts - accumulation time, ts], i.e. if its packed value is in
+    // [min_value, max_value], whatever the polarity. The pixels without events are below any min_value
+    const timestamp min_ts       = ts - accumulation_time_us_.load(std::memory_order_relaxed) + 1;
+    const std::int64_t min_value = pack(std::max<timestamp>(min_ts, 0), 0);
+    const std::int64_t max_value = pack(ts, 1);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    for (int y = 0; y < height_; ++y) {
+        const std::atomic<std::int64_t> *pixels = pixels_.get() + static_cast<size_t>(y) * width_;
+        if (colored_) {
+            cv::Vec3b *row = frame.ptr<cv::Vec3b>(y);
+            for (int x = 0; x < width_; ++x) {
+                const std::int64_t value = pixels[x].load(std::memory_order_relaxed);
+                row[x] = (value < min_value || value > max_value) ? bg_color_ : off_on_colors_[value & 1];
+            }
+        } else {
+            uint8_t *row = frame.ptr<uint8_t>(y);
+            for (int x = 0; x < width_; ++x) {
+                const std::int64_t value = pixels[x].load(std::memory_order_relaxed);
+                row[x] = (value < min_value || value > max_value) ? bg_color_[0] : off_on_colors_[value & 1][0];
+            }
+        }
+    }
+}
+
+timestamp ConcurrentFrameGenerationAlgorithm::get_last_processed_timestamp() const {
+    return last_processed_ts_.load(std::memory_order_acquire);
+}
+
+void ConcurrentFrameGenerationAlgorithm::set_accumulation_time_us(uint32_t accumulation_time_us) {
+    if (accumulation_time_us == 0)
+        throw std::invalid_argument("Accumulation time must be positive.");
+
+    accumulation_time_us_.store(accumulation_time_us, std::memory_order_relaxed);
+}
+
+uint32_t ConcurrentFrameGenerationAlgorithm::get_accumulation_time_us() const {
+    return accumulation_time_us_.load(std::memory_order_relaxed);
+}
+
+void ConcurrentFrameGenerationAlgorithm::reset() {
+    for (size_t i = 0, n = static_cast<size_t>(width_) * height_; i < n; ++i) {
+        pixels_[i].store(NoEvent, std::memory_order_relaxed);
+    }
+    last_processed_ts_.store(-1, std::memory_order_release);
+}
+
+} // namespace Metavision
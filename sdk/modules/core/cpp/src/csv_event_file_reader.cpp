@@ -0,0 +1,262 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+
+#include "metavision/sdk/core/utils/csv_event_file_reader.h"
+
+namespace Metavision {
+
+namespace {
+
+// Parses a decimal integer, possibly negative, and returns the position after its last digit, or nullptr if there is
+// no integer at the beginning of [p, end) or if it does not fit in T
+template<typename T>
+const char *parse_int(const char *p, const char *end, T &value) {
+    const bool negative = p != end && *p == '-';
+    if (negative) {
+        if (!std::numeric_limits<T>::is_signed) {
+            return nullptr;
+        }
+        ++p;
+    }
+    const char *first = p;
+    uint64_t v        = 0;
+    // 19 digits always fit in 64 bits
+    for (; p != end && p - first < 20 && static_cast<unsigned char>(*p - '0') < 10; ++p) {
+        v = v * 10 + static_cast<unsigned char>(*p - '0');
+    }
+    if (p == first || p - first > 19) {
+        return nullptr;
+    }
+    const uint64_t max = static_cast<uint64_t>(std::numeric_limits<T>::max());
+    if (v > max + (negative ? 1 : 0)) {
+        return nullptr;
+    }
+    value = negative ? static_cast<T>(0 - v) : static_cast<T>(v);
+    return p;
+}
+
+// Parses a "x,y,p,t" line, without its end of line
+bool parse_line(const char *p, const char *end, EventCD &ev) {
+    if (end != p && end[-1] == '\r') {
+        --end;
+    }
+    p = parse_int(p, end, ev.x);
+    if (p == nullptr || p == end || *p++ != ',') {
+        return false;
+    }
+    p = parse_int(p, end, ev.y);
+    if (p == nullptr || p == end || *p++ != ',') {
+        return false;
+    }
+    p = parse_int(p, end, ev.p);
+    if (p == nullptr || p == end || *p++ != ',') {
+        return false;
+    }
+    p = parse_int(p, end, ev.t);
+    return p == end;
+}
+
+} // namespace
+
+constexpr size_t CSVEventFileReader::DefaultChunkSize;
+
+CSVEventFileReader::CSVEventFileReader(const std::string &filename, size_t num_threads, size_t chunk_size) :
+    chunk_size_(std::max<size_t>(chunk_size, 1)) {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("Could not open file " + filename);
+    }
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size)) {
+        CloseHandle(file);
+        throw std::runtime_error("Could not get size of file " + filename);
+    }
+    file_ = file;
+    size_ = static_cast<size_t>(file_size.QuadPart);
+    if (size_ > 0) {
+        HANDLE file_mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (file_mapping == NULL) {
+            CloseHandle(file);
+            throw std::runtime_error("Could not map file " + filename);
+        }
+        mapping_ = MapViewOfFile(file_mapping, FILE_MAP_READ, 0, 0, 0);
+        if (mapping_ == nullptr) {
+            CloseHandle(file_mapping);
+            CloseHandle(file);
+            throw std::runtime_error("Could not map file " + filename);
+        }
+        file_mapping_ = file_mapping;
+    }
+#else
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Could not open file " + filename);
+    }
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0) {
+        close(fd);
+        throw std::runtime_error("Could not get size of file " + filename);
+    }
+    size_ = static_cast<size_t>(file_stat.st_size);
+    if (size_ > 0) {
+        void *data = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+        if (data == MAP_FAILED) {
+            close(fd);
+            throw std::runtime_error("Could not map file " + filename);
+        }
+        mapping_ = data;
+        madvise(mapping_, size_, MADV_SEQUENTIAL);
+    }
+    // The mapping keeps its own reference on the file
+    close(fd);
+#endif
+    data_ = static_cast<const char *>(mapping_);
+
+    if (num_threads == 0) {
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for (size_t i = 0; i < num_threads; ++i) {
+        parsers_.emplace_back(new ThreadedProcess());
+        parsers_.back()->start();
+    }
+    // The chunks being parsed are followed by as many parsed ones, so that the parsers do not wait for the reader
+    for (size_t i = 0; i < 2 * num_threads; ++i) {
+        chunks_.emplace_back(new Chunk());
+        free_chunks_.push_back(chunks_.back().get());
+    }
+    submit_chunks();
+}
+
+CSVEventFileReader::~CSVEventFileReader() {
+    for (auto &parser : parsers_) {
+        parser->stop();
+    }
+#ifdef _WIN32
+    if (mapping_) {
+        UnmapViewOfFile(mapping_);
+        CloseHandle(file_mapping_);
+    }
+    CloseHandle(file_);
+#else
+    if (mapping_) {
+        munmap(mapping_, size_);
+    }
+#endif
+}
+
+bool CSVEventFileReader::read(std::vector<EventCD> &events) {
+    if (pending_chunks_.empty()) {
+        return false;
+    }
+
+    Chunk *chunk = pending_chunks_.front();
+    pending_chunks_.pop_front();
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cond_.wait(lock, [chunk]() { return chunk->parsed; });
+    }
+    events.swap(chunk->events);
+    chunk->events.clear();
+    n_events_ += events.size();
+    n_invalid_lines_ += chunk->n_invalid_lines;
+
+#ifndef _WIN32
+    // The pages fully read are released, to bound the memory used when reading huge files
+    static const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    const size_t first_page       = (n_bytes_read_ + page_size - 1) / page_size * page_size;
+    n_bytes_read_                 = chunk->end - data_;
+    const size_t last_page        = n_bytes_read_ / page_size * page_size;
+    if (first_page < last_page) {
+        madvise(static_cast<char *>(mapping_) + first_page, last_page - first_page, MADV_DONTNEED);
+    }
+#else
+    n_bytes_read_ = chunk->end - data_;
+#endif
+
+    free_chunks_.push_back(chunk);
+    submit_chunks();
+    return true;
+}
+
+uint64_t CSVEventFileReader::get_n_events() const {
+    return n_events_;
+}
+
+uint64_t CSVEventFileReader::get_n_invalid_lines() const {
+    return n_invalid_lines_;
+}
+
+size_t CSVEventFileReader::get_size() const {
+    return size_;
+}
+
+size_t CSVEventFileReader::get_n_bytes_read() const {
+    return n_bytes_read_;
+}
+
+void CSVEventFileReader::submit_chunks() {
+    while (offset_ < size_ && !free_chunks_.empty()) {
+        Chunk *chunk = free_chunks_.back();
+        free_chunks_.pop_back();
+
+        // The chunk ends after the end of line following its nominal size
+        chunk->begin     = data_ + offset_;
+        const char *last = data_ + std::min(size_, offset_ + chunk_size_) - 1;
+        const char *eol  = static_cast<const char *>(std::memchr(last, '\n', data_ + size_ - last));
+        chunk->end       = eol ? eol + 1 : data_ + size_;
+        chunk->parsed    = false;
+        offset_          = chunk->end - data_;
+
+        pending_chunks_.push_back(chunk);
+        parsers_[next_parser_]->add_task([this, chunk]() { parse_chunk(*chunk); });
+        next_parser_ = (next_parser_ + 1) % parsers_.size();
+    }
+}
+
+void CSVEventFileReader::parse_chunk(Chunk &chunk) {
+    // The buffer is reserved for short lines, so that it is reallocated at most once
+    chunk.events.reserve((chunk.end - chunk.begin) / 16);
+    chunk.n_invalid_lines = 0;
+
+    EventCD ev;
+    for (const char *p = chunk.begin; p != chunk.end;) {
+        const char *eol      = static_cast<const char *>(std::memchr(p, '\n', chunk.end - p));
+        const char *line_end = eol ? eol : chunk.end;
+        if (parse_line(p, line_end, ev)) {
+            chunk.events.push_back(ev);
+        } else if (line_end != p && !(line_end - p == 1 && *p == '\r')) {
+            ++chunk.n_invalid_lines;
+        }
+        p = eol ? eol + 1 : chunk.end;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    chunk.parsed = true;
+    cond_.notify_all();
+}
+
+} // namespace Metavision
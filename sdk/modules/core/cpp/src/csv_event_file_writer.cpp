@@ -0,0 +1,200 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+
+#include "metavision/sdk/base/utils/sdk_log.h"
+#include "metavision/sdk/core/utils/csv_event_file_writer.h"
+
+namespace Metavision {
+
+namespace {
+
+// Longest line of an event: 5 digits for x and y, a sign and 5 digits for p, a sign and 19 digits for t, 3 commas and
+// the end of line
+constexpr size_t MaxLineSize = 5 + 5 + 6 + 20 + 3 + 1;
+
+constexpr char Digits[] = "00010203040506070809101112131415161718192021222324"
+                          "25262728293031323334353637383940414243444546474849"
+                          "50515253545556575859606162636465666768697071727374"
+                          "75767778798081828384858687888990919293949596979899";
+
+// Writes the decimal digits of a value, two at a time, and returns the position after the last one
+char *append_uint(char *out, uint64_t value) {
+    char digits[20];
+    char *first = digits + sizeof(digits);
+    while (value >= 100) {
+        const size_t i = static_cast<size_t>(value % 100) * 2;
+        value /= 100;
+        *--first = Digits[i + 1];
+        *--first = Digits[i];
+    }
+    if (value >= 10) {
+        const size_t i = static_cast<size_t>(value) * 2;
+        *--first       = Digits[i + 1];
+        *--first       = Digits[i];
+    } else {
+        *--first = static_cast<char>('0' + value);
+    }
+    const size_t n = digits + sizeof(digits) - first;
+    std::memcpy(out, first, n);
+    return out + n;
+}
+
+char *append_int(char *out, int64_t value) {
+    if (value < 0) {
+        *out++ = '-';
+        return append_uint(out, 0 - static_cast<uint64_t>(value));
+    }
+    return append_uint(out, static_cast<uint64_t>(value));
+}
+
+} // namespace
+
+constexpr size_t CSVEventFileWriter::DefaultChunkSize;
+
+CSVEventFileWriter::CSVEventFileWriter(const std::string &filename, size_t num_threads, size_t chunk_size) :
+    output_(filename, std::ios::binary), chunk_size_(std::max<size_t>(1, chunk_size)) {
+    if (!output_.is_open()) {
+        throw std::runtime_error("Could not open file " + filename);
+    }
+
+    if (num_threads == 0) {
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for (size_t i = 0; i < num_threads; ++i) {
+        formatters_.emplace_back(new ThreadedProcess());
+        formatters_.back()->start();
+    }
+    writer_.start();
+
+    // A chunk is filled and another one is written while the others are formatted
+    for (size_t i = 0; i < num_threads + 2; ++i) {
+        chunks_.emplace_back(new Chunk());
+        chunks_.back()->events.reserve(chunk_size_);
+        free_chunks_.push_back(chunks_.back().get());
+    }
+    current_ = free_chunks_.back();
+    free_chunks_.pop_back();
+}
+
+CSVEventFileWriter::~CSVEventFileWriter() {
+    try {
+        close();
+    } catch (const std::runtime_error &e) { MV_SDK_LOG_ERROR() << e.what(); }
+}
+
+void CSVEventFileWriter::flush() {
+    if (closed_) {
+        return;
+    }
+    if (!current_->events.empty()) {
+        submit_chunk();
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    cond_.wait(lock, [this]() { return free_chunks_.size() + 1 == chunks_.size(); });
+    if (!output_.flush()) {
+        failed_ = true;
+    }
+    lock.unlock();
+    throw_if_failed();
+}
+
+void CSVEventFileWriter::close() {
+    if (closed_) {
+        return;
+    }
+
+    if (!current_->events.empty()) {
+        submit_chunk();
+    }
+    closed_ = true;
+    for (auto &formatter : formatters_) {
+        formatter->stop();
+    }
+    writer_.stop();
+    output_.close();
+    if (output_.fail()) {
+        failed_ = true;
+    }
+    throw_if_failed();
+}
+
+uint64_t CSVEventFileWriter::get_n_events() const {
+    return n_events_ + current_->events.size();
+}
+
+void CSVEventFileWriter::submit_chunk() {
+    Chunk *chunk = current_;
+    n_events_ += chunk->events.size();
+    formatters_[next_formatter_]->add_task([this, chunk]() { format_chunk(*chunk); });
+    next_formatter_ = (next_formatter_ + 1) % formatters_.size();
+    // The writer processes its tasks in order, hence the chunks are written in the order they are submitted
+    writer_.add_task([this, chunk]() { write_chunk(*chunk); });
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    cond_.wait(lock, [this]() { return !free_chunks_.empty(); });
+    current_ = free_chunks_.back();
+    free_chunks_.pop_back();
+}
+
+void CSVEventFileWriter::format_chunk(Chunk &chunk) {
+    if (chunk.text.size() < chunk.events.size() * MaxLineSize) {
+        chunk.text.resize(chunk_size_ * MaxLineSize);
+    }
+
+    char *out = chunk.text.data();
+    for (const auto &ev : chunk.events) {
+        out    = append_uint(out, ev.x);
+        *out++ = ',';
+        out    = append_uint(out, ev.y);
+        *out++ = ',';
+        out    = append_int(out, ev.p);
+        *out++ = ',';
+        out    = append_int(out, ev.t);
+        *out++ = '\n';
+    }
+    chunk.text_size = out - chunk.text.data();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    chunk.formatted = true;
+    cond_.notify_all();
+}
+
+void CSVEventFileWriter::write_chunk(Chunk &chunk) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cond_.wait(lock, [&chunk]() { return chunk.formatted; });
+    lock.unlock();
+
+    const bool written = static_cast<bool>(output_.write(chunk.text.data(), chunk.text_size));
+
+    lock.lock();
+    if (!written) {
+        failed_ = true;
+    }
+    chunk.events.clear();
+    chunk.formatted = false;
+    free_chunks_.push_back(&chunk);
+    cond_.notify_all();
+}
+
+void CSVEventFileWriter::throw_if_failed() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (failed_) {
+        throw std::runtime_error("Could not write the events to the CSV file");
+    }
+}
+
+} // namespace Metavision
@@ -0,0 +1,327 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <cuda_runtime.h>
+
+#include "metavision/sdk/core/cuda/cuda_events_processor.h"
+
+namespace Metavision {
+
+namespace {
+
+constexpr int ThreadsPerBlock = 256;
+
+void check_cuda(cudaError_t err, const char *call) {
+    if (err != cudaSuccess) {
+        throw std::runtime_error(std::string(call) + " failed: " + cudaGetErrorString(err));
+    }
+}
+
+std::shared_ptr<void> allocate_device_memory(size_t num_bytes) {
+    void *ptr = nullptr;
+    check_cuda(cudaMalloc(&ptr, num_bytes), "cudaMalloc");
+    // The memory is released when the processor and the tensors exported are all released
+    return std::shared_ptr<void>(ptr, [](void *p) { cudaFree(p); });
+}
+
+int num_blocks(size_t num_threads) {
+    return static_cast<int>((num_threads + ThreadsPerBlock - 1) / ThreadsPerBlock);
+}
+
+uchar3 to_uchar3(const ColorPalette &palette, const ColorType &type) {
+    const RGBColor c = getColor(palette, type);
+    return make_uchar3(static_cast<unsigned char>(c.b * 255 + 0.5), static_cast<unsigned char>(c.g * 255 + 0.5),
+                       static_cast<unsigned char>(c.r * 255 + 0.5));
+}
+
+__global__ void update_kernel(const EventCD *events, int num_events, int width, int height,
+                              long long *time_surface, int *histogram) {
+    const int i = blockIdx.x * blockDim.x + threadIdx.x;
+    if (i >= num_events) {
+        return;
+    }
+    const EventCD ev = events[i];
+    if (ev.x >= width || ev.y >= height) {
+        return;
+    }
+    const int idx = 2 * (ev.y * width + ev.x) + (ev.p > 0 ? 1 : 0);
+    // The events of a pixel are processed in any order, the time surface keeping the most recent one
+    atomicMax(time_surface + idx, static_cast<long long>(ev.t));
+    atomicAdd(histogram + idx, 1);
+}
+
+__global__ void frame_kernel(const long long *time_surface, int num_pixels, long long min_ts, uchar3 bg_color,
+                             uchar3 off_color, uchar3 on_color, unsigned char *frame) {
+    const int i = blockIdx.x * blockDim.x + threadIdx.x;
+    if (i >= num_pixels) {
+        return;
+    }
+    const long long t_off = time_surface[2 * i];
+    const long long t_on  = time_surface[2 * i + 1];
+    const long long last  = t_on >= t_off ? t_on : t_off;
+    uchar3 c              = bg_color;
+    if (last >= 0 && last >= min_ts) {
+        c = t_on >= t_off ? on_color : off_color;
+    }
+    frame[3 * i]     = c.x;
+    frame[3 * i + 1] = c.y;
+    frame[3 * i + 2] = c.z;
+}
+
+/// @brief Context of an exported tensor, keeping the memory of the device alive
+struct ExportContext {
+    DLPack::ManagedTensor tensor;
+    std::shared_ptr<void> memory;
+    int64_t shape[3];
+};
+
+DLPack::ManagedTensor *export_tensor(const std::shared_ptr<void> &memory, int device_id, DLPack::DataType dtype,
+                                     int64_t height, int64_t width, int64_t channels) {
+    auto *ctx                         = new ExportContext();
+    ctx->memory                       = memory;
+    ctx->shape[0]                     = height;
+    ctx->shape[1]                     = width;
+    ctx->shape[2]                     = channels;
+    ctx->tensor.dl_tensor.data        = memory.get();
+    ctx->tensor.dl_tensor.device      = {DLPack::CUDA, device_id};
+    ctx->tensor.dl_tensor.ndim        = 3;
+    ctx->tensor.dl_tensor.dtype       = dtype;
+    ctx->tensor.dl_tensor.shape       = ctx->shape;
+    ctx->tensor.dl_tensor.strides     = nullptr;
+    ctx->tensor.dl_tensor.byte_offset = 0;
+    ctx->tensor.manager_ctx           = ctx;
+    ctx->tensor.deleter               = [](DLPack::ManagedTensor *self) {
+        delete static_cast<ExportContext *>(self->manager_ctx);
+    };
+    return &ctx->tensor;
+}
+
+} // anonymous namespace
+
+struct CudaEventsProcessor::Impl {
+    int width_;
+    int height_;
+    int device_id_;
+    size_t upload_capacity_;
+    cudaStream_t stream_ = nullptr;
+
+    // Pinned buffers, alternately filled by the host, and events signaling the end of their transfer
+    std::array<EventCD *, 2> pinned_events_   = {{nullptr, nullptr}};
+    std::array<cudaEvent_t, 2> transfer_done_ = {{nullptr, nullptr}};
+    int next_pinned_                          = 0;
+
+    std::shared_ptr<void> events_;
+    std::shared_ptr<void> time_surface_;
+    std::shared_ptr<void> histogram_;
+    std::shared_ptr<void> frame_;
+
+    uchar3 bg_color_;
+    uchar3 off_color_;
+    uchar3 on_color_;
+
+    uint32_t accumulation_time_us_ = 0;
+    timestamp frame_period_us_     = 0;
+    timestamp next_frame_ts_       = 0;
+    FrameCallback frame_cb_;
+
+    // Also called when the constructor of the processor throws, with the resources allocated so far
+    ~Impl() {
+        if (!stream_) {
+            return;
+        }
+        cudaSetDevice(device_id_);
+        cudaStreamSynchronize(stream_);
+        for (int i = 0; i < 2; ++i) {
+            if (transfer_done_[i]) {
+                cudaEventDestroy(transfer_done_[i]);
+            }
+            if (pinned_events_[i]) {
+                cudaFreeHost(pinned_events_[i]);
+            }
+        }
+        cudaStreamDestroy(stream_);
+    }
+
+    size_t num_pixels() const {
+        return static_cast<size_t>(width_) * height_;
+    }
+
+    void make_current() const {
+        check_cuda(cudaSetDevice(device_id_), "cudaSetDevice");
+    }
+
+    void upload(const EventCD *begin, const EventCD *end) {
+        while (begin != end) {
+            const size_t n = std::min<size_t>(end - begin, upload_capacity_);
+            // The pinned buffer is reused once its previous transfer is done
+            check_cuda(cudaEventSynchronize(transfer_done_[next_pinned_]), "cudaEventSynchronize");
+            std::copy(begin, begin + n, pinned_events_[next_pinned_]);
+            check_cuda(cudaMemcpyAsync(events_.get(), pinned_events_[next_pinned_], n * sizeof(EventCD),
+                                       cudaMemcpyHostToDevice, stream_),
+                       "cudaMemcpyAsync");
+            check_cuda(cudaEventRecord(transfer_done_[next_pinned_], stream_), "cudaEventRecord");
+            update_kernel<<<num_blocks(n), ThreadsPerBlock, 0, stream_>>>(
+                static_cast<const EventCD *>(events_.get()), static_cast<int>(n), width_, height_,
+                static_cast<long long *>(time_surface_.get()), static_cast<int *>(histogram_.get()));
+            check_cuda(cudaGetLastError(), "update_kernel");
+            next_pinned_ = 1 - next_pinned_;
+            begin += n;
+        }
+    }
+
+    void generate_frame(timestamp ts, uint32_t accumulation_time_us) {
+        const long long min_ts = accumulation_time_us == 0 ? 0 : ts - accumulation_time_us;
+        frame_kernel<<<num_blocks(num_pixels()), ThreadsPerBlock, 0, stream_>>>(
+            static_cast<const long long *>(time_surface_.get()), static_cast<int>(num_pixels()), min_ts, bg_color_,
+            off_color_, on_color_, static_cast<unsigned char *>(frame_.get()));
+        check_cuda(cudaGetLastError(), "frame_kernel");
+    }
+};
+
+CudaEventsProcessor::CudaEventsProcessor(int width, int height, int device_id, size_t upload_capacity) :
+    impl_(new Impl()) {
+    if (width <= 0 || height <= 0) {
+        throw std::invalid_argument("The dimensions of the sensor must be positive.");
+    }
+    if (upload_capacity == 0) {
+        throw std::invalid_argument("The capacity of the pinned buffers must be positive.");
+    }
+    impl_->width_           = width;
+    impl_->height_          = height;
+    impl_->device_id_       = device_id;
+    impl_->upload_capacity_ = upload_capacity;
+
+    impl_->make_current();
+    check_cuda(cudaStreamCreateWithFlags(&impl_->stream_, cudaStreamNonBlocking), "cudaStreamCreateWithFlags");
+    for (int i = 0; i < 2; ++i) {
+        check_cuda(cudaHostAlloc(reinterpret_cast<void **>(&impl_->pinned_events_[i]),
+                                 upload_capacity * sizeof(EventCD), cudaHostAllocWriteCombined),
+                   "cudaHostAlloc");
+        check_cuda(cudaEventCreateWithFlags(&impl_->transfer_done_[i], cudaEventDisableTiming), "cudaEventCreate");
+    }
+    impl_->events_       = allocate_device_memory(upload_capacity * sizeof(EventCD));
+    impl_->time_surface_ = allocate_device_memory(2 * impl_->num_pixels() * sizeof(long long));
+    impl_->histogram_    = allocate_device_memory(2 * impl_->num_pixels() * sizeof(int));
+    impl_->frame_        = allocate_device_memory(3 * impl_->num_pixels());
+
+    set_color_palette(ColorPalette::Dark);
+    reset_time_surface();
+    reset_histogram();
+    generate_frame(0, 0);
+}
+
+CudaEventsProcessor::~CudaEventsProcessor() = default;
+
+void CudaEventsProcessor::set_periodic_frame_generation(uint32_t accumulation_time_us, double fps,
+                                                        const FrameCallback &cb) {
+    if (accumulation_time_us == 0 || fps <= 0) {
+        throw std::invalid_argument("The accumulation time and the frame rate must be positive.");
+    }
+    impl_->accumulation_time_us_ = accumulation_time_us;
+    impl_->frame_period_us_      = static_cast<timestamp>(std::round(1000000 / fps));
+    impl_->next_frame_ts_        = impl_->frame_period_us_;
+    impl_->frame_cb_             = cb;
+}
+
+void CudaEventsProcessor::set_color_palette(const ColorPalette &palette) {
+    impl_->bg_color_  = to_uchar3(palette, ColorType::Background);
+    impl_->off_color_ = to_uchar3(palette, ColorType::Negative);
+    impl_->on_color_  = to_uchar3(palette, ColorType::Positive);
+}
+
+void CudaEventsProcessor::process_events(const EventCD *begin, const EventCD *end) {
+    impl_->make_current();
+    if (impl_->frame_period_us_ == 0) {
+        impl_->upload(begin, end);
+        return;
+    }
+
+    // The events are split at the timestamps of the frames, a frame being generated from the events before it
+    while (begin != end) {
+        const EventCD *split = std::lower_bound(begin, end, impl_->next_frame_ts_,
+                                                [](const EventCD &ev, timestamp ts) { return ev.t < ts; });
+        impl_->upload(begin, split);
+        if (split == end) {
+            break;
+        }
+        impl_->generate_frame(impl_->next_frame_ts_, impl_->accumulation_time_us_);
+        if (impl_->frame_cb_) {
+            impl_->frame_cb_(impl_->next_frame_ts_);
+        }
+        impl_->next_frame_ts_ += impl_->frame_period_us_;
+        begin = split;
+    }
+}
+
+void CudaEventsProcessor::generate_frame(timestamp ts, uint32_t accumulation_time_us) {
+    impl_->make_current();
+    impl_->generate_frame(ts, accumulation_time_us);
+}
+
+void CudaEventsProcessor::reset_histogram() {
+    impl_->make_current();
+    check_cuda(cudaMemsetAsync(impl_->histogram_.get(), 0, 2 * impl_->num_pixels() * sizeof(int), impl_->stream_),
+               "cudaMemsetAsync");
+}
+
+void CudaEventsProcessor::reset_time_surface() {
+    impl_->make_current();
+    // All bytes set to 0xFF, for timestamps of -1
+    check_cuda(
+        cudaMemsetAsync(impl_->time_surface_.get(), 0xFF, 2 * impl_->num_pixels() * sizeof(long long), impl_->stream_),
+        "cudaMemsetAsync");
+}
+
+void CudaEventsProcessor::synchronize() {
+    impl_->make_current();
+    check_cuda(cudaStreamSynchronize(impl_->stream_), "cudaStreamSynchronize");
+}
+
+void CudaEventsProcessor::download_frame(cv::Mat &frame) {
+    frame.create(impl_->height_, impl_->width_, CV_8UC3);
+    impl_->make_current();
+    check_cuda(cudaMemcpy2DAsync(frame.data, frame.step, impl_->frame_.get(), 3 * impl_->width_, 3 * impl_->width_,
+                                 impl_->height_, cudaMemcpyDeviceToHost, impl_->stream_),
+               "cudaMemcpy2DAsync");
+    synchronize();
+}
+
+DLPack::ManagedTensor *CudaEventsProcessor::export_time_surface() {
+    synchronize();
+    return export_tensor(impl_->time_surface_, impl_->device_id_, {DLPack::Int, 64, 1}, impl_->height_,
+                         impl_->width_, 2);
+}
+
+DLPack::ManagedTensor *CudaEventsProcessor::export_histogram() {
+    synchronize();
+    return export_tensor(impl_->histogram_, impl_->device_id_, {DLPack::Int, 32, 1}, impl_->height_, impl_->width_,
+                         2);
+}
+
+DLPack::ManagedTensor *CudaEventsProcessor::export_frame() {
+    synchronize();
+    return export_tensor(impl_->frame_, impl_->device_id_, {DLPack::UInt, 8, 1}, impl_->height_, impl_->width_, 3);
+}
+
+int CudaEventsProcessor::get_device_id() const {
+    return impl_->device_id_;
+}
+
+void *CudaEventsProcessor::get_stream() const {
+    return impl_->stream_;
+}
+
+} // namespace Metavision
@@ -17,9 +17,24 @@
 
 namespace Metavision {
 
+namespace {
+std::vector<int> make_writer_params(bool colored, const std::vector<int> &params) {
+#if CV_MAJOR_VERSION >= 4 && CV_MINOR_VERSION >= 4
+    std::vector<int> writer_params{cv::VIDEOWRITER_PROP_IS_COLOR, static_cast<int>(colored)};
+#else
+    std::vector<int> writer_params{4, static_cast<int>(colored)};
+#endif
+    writer_params.insert(writer_params.end(), params.begin(), params.end());
+    return writer_params;
+}
+} // namespace
+
 CvVideoRecorder::CvVideoRecorder(const std::string &output_video_file, const int fourcc, const uint32_t fps,
-                                 const cv::Size &size, bool colored) :
-    writer_(output_video_file, fourcc, fps, size, colored) {
+                                 const cv::Size &size, bool colored, const std::vector<int> &params,
+                                 std::size_t queue_size, QueuePolicy policy) :
+    writer_(output_video_file, fourcc, fps, size, make_writer_params(colored, params)),
+    slot_pool_(FramePool::make_bounded(queue_size)),
+    policy_(policy) {
     if (!writer_.isOpened()) {
         std::string message = "'" + output_video_file + "' is not writable. ";
         auto p              = boost::filesystem::path(output_video_file);
@@ -38,25 +53,66 @@ CvVideoRecorder::~CvVideoRecorder() {
 }
 
 bool CvVideoRecorder::start() {
+    std::lock_guard<std::mutex> lock(recording_mutex_);
     return recorder_thread_.start();
 }
 
 void CvVideoRecorder::stop() {
+    std::lock_guard<std::mutex> lock(recording_mutex_);
     recorder_thread_.stop();
 }
 
-void CvVideoRecorder::write(cv::Mat &data) {
+void CvVideoRecorder::write(const cv::Mat &data) {
+    if (!is_recording()) {
+        return;
+    }
+
+    auto slot = acquire_slot();
+    if (slot) {
+        data.copyTo(*slot);
+        push(slot, slot);
+    }
+}
+
+void CvVideoRecorder::write(const FramePtr &frame) {
     if (!is_recording()) {
         return;
     }
 
-    auto to_write = data_to_write_pool_.acquire();
-    data.copyTo(*to_write);
-    recorder_thread_.add_task([this, to_write]() { writer_.write(*to_write); });
+    auto slot = acquire_slot();
+    if (slot) {
+        push(std::move(slot), frame);
+    }
+}
+
+CvVideoRecorder::FramePtr CvVideoRecorder::acquire_slot() {
+    if (policy_ == QueuePolicy::Drop) {
+        // Slots are only taken under the lock, the pool can not be emptied by another writer once checked
+        std::lock_guard<std::mutex> lock(drop_mutex_);
+        if (slot_pool_.empty()) {
+            ++n_dropped_frames_;
+            return nullptr;
+        }
+        return slot_pool_.acquire();
+    }
+    // Blocks until a frame has been encoded if the queue is full
+    return slot_pool_.acquire();
+}
+
+void CvVideoRecorder::push(FramePtr slot, FramePtr frame) {
+    // The recording may have been stopped while waiting for a slot, the frame is then not recorded
+    std::lock_guard<std::mutex> lock(recording_mutex_);
+    if (recorder_thread_.is_active()) {
+        recorder_thread_.add_task([this, slot, frame]() { writer_.write(*frame); });
+    }
 }
 
 bool CvVideoRecorder::is_recording() {
     return recorder_thread_.is_active();
 }
 
+std::size_t CvVideoRecorder::get_n_dropped_frames() const {
+    return n_dropped_frames_;
+}
+
 } // namespace Metavision
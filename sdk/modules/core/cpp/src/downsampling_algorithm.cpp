@@ -0,0 +1,139 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+#include "metavision/sdk/core/algorithms/downsampling_algorithm.h"
+
+namespace Metavision {
+
+DownsamplingAlgorithm::DownsamplingAlgorithm(int width, int height, int factor, timestamp refractory_period_us) :
+    width_(width), height_(height), factor_(factor), shift_(0) {
+    if (width <= 0 || height <= 0) {
+        throw std::invalid_argument("The size of the sensor must be positive.");
+    }
+    if (factor <= 0 || (factor & (factor - 1)) != 0) {
+        throw std::invalid_argument("The downsampling factor must be a power of 2.");
+    }
+    while ((1 << shift_) < factor) {
+        ++shift_;
+    }
+    output_width_  = (width + factor - 1) / factor;
+    output_height_ = (height + factor - 1) / factor;
+    set_refractory_period(refractory_period_us);
+    reset();
+}
+
+int DownsamplingAlgorithm::get_factor() const {
+    return factor_;
+}
+
+int DownsamplingAlgorithm::get_output_width() const {
+    return output_width_;
+}
+
+int DownsamplingAlgorithm::get_output_height() const {
+    return output_height_;
+}
+
+void DownsamplingAlgorithm::set_refractory_period(timestamp refractory_period_us) {
+    if (refractory_period_us < 0) {
+        throw std::invalid_argument("The refractory period must not be negative.");
+    }
+    refractory_period_ = refractory_period_us;
+}
+
+timestamp DownsamplingAlgorithm::get_refractory_period() const {
+    return refractory_period_;
+}
+
+void DownsamplingAlgorithm::reset() {
+    next_ts_.assign(static_cast<size_t>(output_width_) * output_height_ * 2, std::numeric_limits<timestamp>::min());
+}
+
+void DownsamplingAlgorithm::process_events(const EventCDBufferSoA &input, EventCDBufferSoA &output) {
+    const size_t n = input.size();
+    if (&output != &input) {
+        output.resize(n);
+        std::copy(input.p(), input.p() + n, output.p());
+        std::copy(input.t(), input.t() + n, output.t());
+    }
+
+    const unsigned short *in_x = input.x(), *in_y = input.y();
+    unsigned short *out_x = output.x(), *out_y = output.y();
+    short *out_p          = output.p();
+    timestamp *out_t      = output.t();
+
+    // First pass, without dependency between the events: the coordinates are divided in place and the events outside
+    // the sensor are marked
+    kept_.resize(n);
+    std::uint8_t *kept          = kept_.data();
+    const unsigned short width  = static_cast<unsigned short>(std::min(width_, 0xFFFF));
+    const unsigned short height = static_cast<unsigned short>(std::min(height_, 0xFFFF));
+    const unsigned int shift    = shift_;
+    size_t n_kept               = 0;
+    for (size_t i = 0; i < n; ++i) {
+        const unsigned short x = in_x[i], y = in_y[i];
+        const std::uint8_t k   = (x < width) & (y < height);
+        out_x[i]               = static_cast<unsigned short>(x >> shift);
+        out_y[i]               = static_cast<unsigned short>(y >> shift);
+        kept[i]                = k;
+        n_kept += k;
+    }
+    if (n_kept == n && refractory_period_ == 0) {
+        return;
+    }
+
+    // Second pass, compacting the events kept, in the order of the events for the refractory period
+    size_t n_out = 0;
+    for (size_t i = 0; i < n; ++i) {
+        bool k = kept[i] != 0;
+        if (k && refractory_period_ > 0) {
+            k = accept(out_x[i], out_y[i], out_p[i], out_t[i]);
+        }
+        out_x[n_out] = out_x[i];
+        out_y[n_out] = out_y[i];
+        out_p[n_out] = out_p[i];
+        out_t[n_out] = out_t[i];
+        n_out += k;
+    }
+    output.resize(n_out);
+}
+
+void DownsamplingAlgorithm::process_events(const EventCDCompactBuffer &input, EventCDCompactBuffer &output) {
+    const size_t n            = input.size();
+    const timestamp base_time = input.base_time();
+    if (&output != &input) {
+        output.reset(base_time);
+    }
+    output.resize(n);
+
+    // Branchless compaction, writing in place being safe as the output index never exceeds the input one
+    const EventCDCompact *in = input.data();
+    EventCDCompact *out      = output.data();
+    size_t n_out             = 0;
+    for (size_t i = 0; i < n; ++i) {
+        const EventCDCompact ev = in[i];
+        const int x = ev.x(), y = ev.y();
+        bool k      = (x < width_) & (y < height_);
+        const int bx = x >> shift_, by = y >> shift_;
+        if (k && refractory_period_ > 0) {
+            k = accept(bx, by, ev.p(), base_time + ev.dt);
+        }
+        out[n_out] = EventCDCompact(static_cast<unsigned short>(bx), static_cast<unsigned short>(by), ev.p(), ev.dt);
+        n_out += k;
+    }
+    output.resize(n_out);
+}
+
+} // namespace Metavision
@@ -0,0 +1,120 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "metavision/sdk/core/utils/event_rate_map.h"
+
+namespace Metavision {
+
+namespace {
+// Maximum age of the reference time of the counts, in decay times, before they are rebased. The weights of the events
+// are then at most exp(20), which keeps the counts far from the range of floats while rebasing seldom.
+constexpr double max_reference_age = 20.;
+} // namespace
+
+EventRateMap::EventRateMap(int width, int height, timestamp decay_time_us, int block_size) :
+    width_(width), height_(height), block_size_(block_size), decay_time_(decay_time_us) {
+    if (width <= 0 || height <= 0) {
+        throw std::invalid_argument("The size of the sensor must be positive.");
+    }
+    if (decay_time_us <= 0) {
+        throw std::invalid_argument("The decay time must be positive.");
+    }
+    if (block_size <= 0) {
+        throw std::invalid_argument("The size of the blocks must be positive.");
+    }
+    map_width_  = (width + block_size - 1) / block_size;
+    map_height_ = (height + block_size - 1) / block_size;
+
+    // The cell of a pixel is looked up rather than computed, to save the divisions when processing the events
+    cols_.resize(width);
+    for (int x = 0; x < width; ++x) {
+        cols_[x] = x / block_size;
+    }
+    row_offsets_.resize(height);
+    for (int y = 0; y < height; ++y) {
+        row_offsets_[y] = static_cast<std::uint32_t>(y / block_size) * map_width_;
+    }
+    reset();
+}
+
+void EventRateMap::decay(timestamp ts) {
+    const float scale = get_scale(ts);
+    for (float &count : counts_) {
+        count *= scale;
+    }
+    reference_ts_ = ts;
+    weight_ts_    = std::numeric_limits<timestamp>::min();
+}
+
+const float *EventRateMap::data() const {
+    return counts_.data();
+}
+
+float EventRateMap::get_count(int x, int y, timestamp ts) const {
+    return counts_[row_offsets_[y] + cols_[x]] * get_scale(ts);
+}
+
+float EventRateMap::get_rate(int x, int y, timestamp ts) const {
+    return get_count(x, y, ts) * 1e6f / static_cast<float>(decay_time_);
+}
+
+void EventRateMap::generate_rates(timestamp ts, cv::Mat &rates) const {
+    rates.create(map_height_, map_width_, CV_32FC1);
+    const float scale = get_scale(ts) * 1e6f / static_cast<float>(decay_time_);
+    for (int y = 0; y < map_height_; ++y) {
+        const float *counts = counts_.data() + static_cast<size_t>(y) * map_width_;
+        float *row          = rates.ptr<float>(y);
+        for (int x = 0; x < map_width_; ++x) {
+            row[x] = counts[x] * scale;
+        }
+    }
+}
+
+int EventRateMap::get_map_width() const {
+    return map_width_;
+}
+
+int EventRateMap::get_map_height() const {
+    return map_height_;
+}
+
+int EventRateMap::get_block_size() const {
+    return block_size_;
+}
+
+timestamp EventRateMap::get_decay_time() const {
+    return decay_time_;
+}
+
+void EventRateMap::reset() {
+    counts_.assign(static_cast<size_t>(map_width_) * map_height_, 0.f);
+    reference_ts_ = 0;
+    weight_ts_    = std::numeric_limits<timestamp>::min();
+    weight_       = 1.f;
+}
+
+void EventRateMap::update_weight(timestamp ts) {
+    if (static_cast<double>(ts - reference_ts_) > max_reference_age * decay_time_) {
+        decay(ts);
+    }
+    weight_ts_ = ts;
+    weight_    = static_cast<float>(std::exp(static_cast<double>(ts - reference_ts_) / decay_time_));
+}
+
+float EventRateMap::get_scale(timestamp ts) const {
+    return static_cast<float>(std::exp(-static_cast<double>(ts - reference_ts_) / decay_time_));
+}
+
+} // namespace Metavision
@@ -0,0 +1,106 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+#include "metavision/sdk/core/utils/hot_pixel_detector.h"
+
+namespace Metavision {
+
+HotPixelDetector::HotPixelDetector(int width, int height, timestamp period_us, double min_rate_hz,
+                                   double rate_factor, double smoothing) :
+    width_(width),
+    height_(height),
+    period_(period_us),
+    min_rate_(static_cast<float>(min_rate_hz)),
+    rate_factor_(static_cast<float>(rate_factor)),
+    smoothing_(static_cast<float>(smoothing)) {
+    if (width <= 0 || height <= 0) {
+        throw std::invalid_argument("The size of the sensor must be positive.");
+    }
+    if (period_us <= 0) {
+        throw std::invalid_argument("The period must be positive.");
+    }
+    if (min_rate_hz < 0 || rate_factor < 0) {
+        throw std::invalid_argument("The minimum rate and the rate factor must not be negative.");
+    }
+    if (smoothing < 0 || smoothing >= 1) {
+        throw std::invalid_argument("The smoothing must be in [0, 1).");
+    }
+    reset();
+}
+
+const std::vector<std::uint64_t> &HotPixelDetector::get_mask() const {
+    return mask_;
+}
+
+bool HotPixelDetector::is_hot(int x, int y) const {
+    const size_t pixel = static_cast<size_t>(y) * width_ + x;
+    return (mask_[pixel / 64] >> (pixel % 64)) & 1;
+}
+
+size_t HotPixelDetector::get_num_hot_pixels() const {
+    return num_hot_pixels_;
+}
+
+float HotPixelDetector::get_rate(int x, int y) const {
+    return rates_[static_cast<size_t>(y) * width_ + x];
+}
+
+void HotPixelDetector::reset() {
+    const size_t num_pixels = static_cast<size_t>(width_) * height_;
+    counts_.assign(num_pixels, 0);
+    rates_.assign(num_pixels, 0.f);
+    mask_.assign((num_pixels + 63) / 64, 0);
+    num_hot_pixels_ = 0;
+    started_        = false;
+    period_end_     = std::numeric_limits<timestamp>::min();
+}
+
+bool HotPixelDetector::end_periods(timestamp t) {
+    // The first period starts with the first event
+    if (!started_) {
+        started_    = true;
+        period_end_ = t + period_;
+        return false;
+    }
+
+    // The period of the counts is followed by the periods without event before the timestamp, which lower the rates
+    const timestamp num_periods = (t - period_end_) / period_ + 1;
+    period_end_ += num_periods * period_;
+    float empty_periods_decay = 1.f;
+    for (timestamp i = 1; i < num_periods && empty_periods_decay > 0.f; ++i) {
+        empty_periods_decay *= smoothing_;
+    }
+
+    const float count_to_rate = (1.f - smoothing_) * 1e6f / static_cast<float>(period_);
+    double sum_rates          = 0.;
+    for (size_t i = 0; i < rates_.size(); ++i) {
+        rates_[i]  = (smoothing_ * rates_[i] + count_to_rate * counts_[i]) * empty_periods_decay;
+        counts_[i] = 0;
+        sum_rates += rates_[i];
+    }
+
+    const float threshold = std::max(min_rate_, rate_factor_ * static_cast<float>(sum_rates / rates_.size()));
+    bool updated          = false;
+    for (size_t i = 0; i < rates_.size(); ++i) {
+        if (rates_[i] > threshold && !((mask_[i / 64] >> (i % 64)) & 1)) {
+            mask_[i / 64] |= std::uint64_t(1) << (i % 64);
+            ++num_hot_pixels_;
+            updated = true;
+        }
+    }
+    return updated;
+}
+
+} // namespace Metavision
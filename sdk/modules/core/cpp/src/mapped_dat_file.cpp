@@ -0,0 +1,256 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include "metavision/sdk/core/utils/mapped_dat_file.h"
+
+namespace Metavision {
+
+constexpr size_t MappedDATFile::DefaultIndexStep;
+
+MappedDATFile::MappedDATFile(const std::string &filename, size_t index_step) :
+    index_step_(std::max<size_t>(index_step, 1)) {
+    uint64_t data_offset = 0;
+    {
+        std::ifstream file(filename, std::ios::binary);
+        if (!file.is_open()) {
+            throw std::runtime_error("Could not open file " + filename);
+        }
+        header_ = GenericHeader(file);
+        // Files without header only contain Event2ds
+        if (!header_.empty()) {
+            unsigned char ev_type = 0, ev_size = 8;
+            file.read((char *)&ev_type, 1);
+            file.read((char *)&ev_size, 1);
+            if (!file || ev_size < sizeof(uint32_t)) {
+                throw std::runtime_error("Invalid event information in file " + filename);
+            }
+            event_type_ = ev_type;
+            event_size_ = ev_size;
+        }
+        data_offset = static_cast<uint64_t>(file.tellg());
+        auto value  = header_.get_field("Version");
+        if (!value.empty()) {
+            version_ = std::stoi(value);
+        }
+    }
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("Could not open file " + filename);
+    }
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size)) {
+        CloseHandle(file);
+        throw std::runtime_error("Could not get size of file " + filename);
+    }
+    file_         = file;
+    mapping_size_ = static_cast<size_t>(file_size.QuadPart);
+    if (mapping_size_ > data_offset) {
+        HANDLE file_mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (file_mapping == NULL) {
+            CloseHandle(file);
+            throw std::runtime_error("Could not map file " + filename);
+        }
+        mapping_ = static_cast<uint8_t *>(MapViewOfFile(file_mapping, FILE_MAP_READ, 0, 0, 0));
+        if (mapping_ == nullptr) {
+            CloseHandle(file_mapping);
+            CloseHandle(file);
+            throw std::runtime_error("Could not map file " + filename);
+        }
+        file_mapping_ = file_mapping;
+    }
+#else
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Could not open file " + filename);
+    }
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0) {
+        close(fd);
+        throw std::runtime_error("Could not get size of file " + filename);
+    }
+    mapping_size_ = static_cast<size_t>(file_stat.st_size);
+    if (mapping_size_ > data_offset) {
+        void *data = mmap(nullptr, mapping_size_, PROT_READ, MAP_SHARED, fd, 0);
+        if (data == MAP_FAILED) {
+            close(fd);
+            throw std::runtime_error("Could not map file " + filename);
+        }
+        mapping_ = static_cast<uint8_t *>(data);
+    }
+    // The mapping keeps its own reference on the file
+    close(fd);
+#endif
+
+    if (mapping_ == nullptr) {
+        return;
+    }
+    events_   = mapping_ + data_offset;
+    n_events_ = (mapping_size_ - data_offset) / event_size_;
+    if (n_events_ == 0) {
+        return;
+    }
+
+    // Only the indexed events are read, their pages are released once the index is built
+    const uint64_t n_entries = (n_events_ + index_step_ - 1) / index_step_;
+    index_.reserve(n_entries + 1);
+    timestamp last_ts    = get_raw_timestamp(0);
+    uint32_t last_raw_ts = static_cast<uint32_t>(last_ts);
+    for (uint64_t k = 0; k < n_entries; ++k) {
+        const uint32_t raw_ts = get_raw_timestamp(k * index_step_);
+        last_ts += static_cast<uint32_t>(raw_ts - last_raw_ts);
+        last_raw_ts = raw_ts;
+        index_.push_back(last_ts);
+    }
+    index_.push_back(get_timestamp(n_events_ - 1));
+    release(0, n_events_);
+}
+
+MappedDATFile::~MappedDATFile() {
+#ifdef _WIN32
+    if (mapping_) {
+        UnmapViewOfFile(mapping_);
+        CloseHandle(file_mapping_);
+    }
+    CloseHandle(file_);
+#else
+    if (mapping_) {
+        munmap(mapping_, mapping_size_);
+    }
+#endif
+}
+
+const GenericHeader &MappedDATFile::get_header() const {
+    return header_;
+}
+
+int MappedDATFile::get_version() const {
+    return version_;
+}
+
+uint8_t MappedDATFile::get_event_type() const {
+    return event_type_;
+}
+
+size_t MappedDATFile::get_event_size() const {
+    return event_size_;
+}
+
+uint64_t MappedDATFile::get_n_events() const {
+    return n_events_;
+}
+
+size_t MappedDATFile::get_index_step() const {
+    return index_step_;
+}
+
+const uint8_t *MappedDATFile::get_event_data(uint64_t i) const {
+    return events_ + i * event_size_;
+}
+
+timestamp MappedDATFile::get_timestamp(uint64_t i) const {
+    const uint64_t entry = i / index_step_;
+    return index_[entry] + static_cast<uint32_t>(get_raw_timestamp(i) - get_raw_timestamp(entry * index_step_));
+}
+
+timestamp MappedDATFile::get_first_timestamp() const {
+    return index_.empty() ? 0 : index_.front();
+}
+
+timestamp MappedDATFile::get_last_timestamp() const {
+    return index_.empty() ? -1 : index_.back();
+}
+
+uint64_t MappedDATFile::lower_bound(timestamp t) const {
+    if (n_events_ == 0 || t <= index_.front()) {
+        return 0;
+    }
+    if (t > index_.back()) {
+        return n_events_;
+    }
+    // First indexed event not before t, the result lies in the range of events preceding it
+    const auto entries_end = index_.end() - 1;
+    const uint64_t entry   = std::lower_bound(index_.begin(), entries_end, t) - index_.begin();
+    uint64_t first         = (entry - 1) * index_step_;
+    uint64_t count         = std::min<uint64_t>(entry * index_step_, n_events_) - first;
+    while (count > 0) {
+        const uint64_t step = count / 2;
+        if (get_timestamp(first + step) < t) {
+            first += step + 1;
+            count -= step + 1;
+        } else {
+            count = step;
+        }
+    }
+    return first;
+}
+
+std::pair<uint64_t, uint64_t> MappedDATFile::get_window(timestamp begin, timestamp end) const {
+    const uint64_t first = lower_bound(begin);
+    return std::make_pair(first, std::max(first, lower_bound(end)));
+}
+
+void MappedDATFile::will_need(uint64_t begin, uint64_t end) const {
+#ifndef _WIN32
+    advise(begin, end, MADV_WILLNEED, false);
+#endif
+}
+
+void MappedDATFile::release(uint64_t begin, uint64_t end) const {
+#ifndef _WIN32
+    advise(begin, end, MADV_DONTNEED, true);
+#endif
+}
+
+uint32_t MappedDATFile::get_raw_timestamp(uint64_t i) const {
+    uint32_t ts;
+    std::memcpy(&ts, get_event_data(i), sizeof(ts));
+    return ts;
+}
+
+void MappedDATFile::advise(uint64_t begin, uint64_t end, int advice, bool inner_pages) const {
+#ifndef _WIN32
+    end = std::min(end, n_events_);
+    if (mapping_ == nullptr || begin >= end) {
+        return;
+    }
+    // When inner_pages is set, only the pages fully covered by the range are advised, to leave the neighbouring
+    // events untouched
+    static const uint64_t page_size = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+    const uint64_t offset           = static_cast<uint64_t>(events_ - mapping_);
+    const uint64_t round_up         = inner_pages ? page_size - 1 : 0;
+    const uint64_t first_byte       = (offset + begin * event_size_ + round_up) / page_size * page_size;
+    uint64_t last_byte              = mapping_size_;
+    if (end < n_events_) {
+        last_byte = (offset + end * event_size_ + page_size - 1 - round_up) / page_size * page_size;
+    }
+    if (first_byte < last_byte) {
+        madvise(mapping_ + first_byte, last_byte - first_byte, advice);
+    }
+#endif
+}
+
+} // namespace Metavision
@@ -0,0 +1,234 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <stdexcept>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+#include "metavision/sdk/core/algorithms/multi_roi_filter_algorithm.h"
+
+namespace Metavision {
+
+namespace {
+
+// Number of events whose acceptance is evaluated at once
+constexpr size_t BatchSize = 8;
+
+#if defined(__AVX2__) || (defined(__ARM_NEON) && defined(__aarch64__))
+// For each mask of accepted events in a batch, the indices of the bytes packing the 16 bits values of the accepted
+// events at the beginning of a 128 bits register, and the indices of the 32 bits values packing the 64 bits values
+// of the accepted events among 4 at the beginning of a 256 bits register. Also holds the number of accepted events
+struct CompactionTables {
+    CompactionTables() {
+        for (int mask = 0; mask < 256; ++mask) {
+            int n = 0;
+            for (int i = 0; i < 8; ++i) {
+                if ((mask >> i) & 1) {
+                    shuffle16[mask][2 * n]     = static_cast<uint8_t>(2 * i);
+                    shuffle16[mask][2 * n + 1] = static_cast<uint8_t>(2 * i + 1);
+                    ++n;
+                }
+            }
+            count[mask] = static_cast<uint8_t>(n);
+            // Out of range indices zero the unused values, which are overwritten by the next batch anyway
+            std::fill(&shuffle16[mask][2 * n], &shuffle16[mask][16], 0x80);
+        }
+        for (int mask = 0; mask < 16; ++mask) {
+            int n = 0;
+            for (int i = 0; i < 4; ++i) {
+                if ((mask >> i) & 1) {
+                    permute64[mask][2 * n]     = 2 * i;
+                    permute64[mask][2 * n + 1] = 2 * i + 1;
+                    ++n;
+                }
+            }
+            std::fill(&permute64[mask][2 * n], &permute64[mask][8], 0);
+        }
+    }
+
+    alignas(16) uint8_t shuffle16[256][16];
+    uint8_t count[256];
+    alignas(32) int32_t permute64[16][8];
+};
+
+const CompactionTables &get_compaction_tables() {
+    static const CompactionTables tables;
+    return tables;
+}
+#endif
+
+#if defined(__AVX2__)
+// Returns the mask of the accepted events among 8, given their coordinates as 32 bits integers
+inline unsigned int accepted_mask(__m256i x, __m256i y, __m256i width, __m256i height, const uint32_t *mask) {
+    const __m256i inside = _mm256_and_si256(_mm256_cmpgt_epi32(width, x), _mm256_cmpgt_epi32(height, y));
+    // The index of the events out of the sensor is zeroed, so that they are gathered in the mask
+    const __m256i index = _mm256_and_si256(_mm256_add_epi32(_mm256_mullo_epi32(y, width), x), inside);
+    const __m256i words =
+        _mm256_i32gather_epi32(reinterpret_cast<const int *>(mask), _mm256_srli_epi32(index, 5), sizeof(uint32_t));
+    const __m256i bits = _mm256_srlv_epi32(words, _mm256_and_si256(index, _mm256_set1_epi32(31)));
+    return static_cast<unsigned int>(
+        _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_and_si256(_mm256_slli_epi32(bits, 31), inside))));
+}
+#endif
+
+} // namespace
+
+MultiRoiFilterAlgorithm::MultiRoiFilterAlgorithm(int width, int height) : width_(width), height_(height) {
+    if (width <= 0 || height <= 0) {
+        throw std::invalid_argument("The size of the sensor must be positive");
+    }
+    mask_.resize((static_cast<size_t>(width) * height + 31) / 32, 0);
+}
+
+void MultiRoiFilterAlgorithm::add_roi(std::int32_t x0, std::int32_t y0, std::int32_t x1, std::int32_t y1) {
+    x0 = std::max(x0, 0);
+    y0 = std::max(y0, 0);
+    x1 = std::min(x1, width_ - 1);
+    y1 = std::min(y1, height_ - 1);
+    for (std::int32_t y = y0; y <= y1; ++y) {
+        for (std::int32_t x = x0; x <= x1; ++x) {
+            const size_t index = static_cast<size_t>(y) * width_ + x;
+            mask_[index >> 5] |= 1u << (index & 31);
+        }
+    }
+}
+
+void MultiRoiFilterAlgorithm::set_mask(const std::vector<std::uint8_t> &mask) {
+    if (mask.size() != static_cast<size_t>(width_) * height_) {
+        throw std::invalid_argument("The size of the mask must be the one of the sensor");
+    }
+    clear();
+    for (size_t index = 0; index < mask.size(); ++index) {
+        mask_[index >> 5] |= static_cast<std::uint32_t>(mask[index] != 0) << (index & 31);
+    }
+}
+
+void MultiRoiFilterAlgorithm::clear() {
+    std::fill(mask_.begin(), mask_.end(), 0);
+}
+
+void MultiRoiFilterAlgorithm::process_events(const std::vector<EventCD> &input, std::vector<EventCD> &output) const {
+    const size_t n = input.size();
+    output.resize(n);
+    const EventCD *in = input.data();
+    EventCD *out      = output.data();
+
+    // Branchless compaction, see RoiFilterAlgorithm
+    size_t i = 0, n_out = 0;
+#if defined(__AVX2__)
+    static_assert(sizeof(EventCD) == 16, "The coordinates of 2 events are loaded from a 256 bits register");
+    const __m256i width  = _mm256_set1_epi32(width_);
+    const __m256i height = _mm256_set1_epi32(height_);
+    const __m256i low16  = _mm256_set1_epi32(0xFFFF);
+    const __m256i order  = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+    for (; i + BatchSize <= n; i += BatchSize) {
+        // Gathers the 32 bits words holding x and y of the events, the first of each event
+        const __m256i *src = reinterpret_cast<const __m256i *>(in + i);
+        const __m256i e01  = _mm256_unpacklo_epi32(_mm256_loadu_si256(src), _mm256_loadu_si256(src + 1));
+        const __m256i e23  = _mm256_unpacklo_epi32(_mm256_loadu_si256(src + 2), _mm256_loadu_si256(src + 3));
+        const __m256i xy   = _mm256_permutevar8x32_epi32(_mm256_unpacklo_epi64(e01, e23), order);
+        const unsigned int accepted =
+            accepted_mask(_mm256_and_si256(xy, low16), _mm256_srli_epi32(xy, 16), width, height, mask_.data());
+        for (size_t j = 0; j < BatchSize; ++j) {
+            out[n_out] = in[i + j];
+            n_out += (accepted >> j) & 1;
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        out[n_out] = in[i];
+        n_out += is_accepted(in[i].x, in[i].y);
+    }
+    output.resize(n_out);
+}
+
+void MultiRoiFilterAlgorithm::process_events(const EventCDBufferSoA &input, EventCDBufferSoA &output) const {
+    const size_t n = input.size();
+    output.resize(n);
+
+    const unsigned short *in_x = input.x(), *in_y = input.y();
+    const short *in_p          = input.p();
+    const timestamp *in_t      = input.t();
+    unsigned short *out_x = output.x(), *out_y = output.y();
+    short *out_p          = output.p();
+    timestamp *out_t      = output.t();
+
+    // The accepted events of a batch are packed at the beginning of the registers, which are written whole at the
+    // current output index: the values of the rejected events are overwritten by the next batch. Writing in place is
+    // safe as the batch is loaded before being written, and the output index never exceeds the input one
+    size_t i = 0, n_out = 0;
+#if defined(__AVX2__) || (defined(__ARM_NEON) && defined(__aarch64__))
+    const CompactionTables &tables = get_compaction_tables();
+#if defined(__AVX2__)
+    const __m256i width  = _mm256_set1_epi32(width_);
+    const __m256i height = _mm256_set1_epi32(height_);
+#endif
+    for (; i + BatchSize <= n; i += BatchSize) {
+#if defined(__AVX2__)
+        const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in_x + i));
+        const __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in_y + i));
+        const __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in_p + i));
+        const __m256i t0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in_t + i));
+        const __m256i t1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in_t + i + 4));
+        const unsigned int accepted =
+            accepted_mask(_mm256_cvtepu16_epi32(x), _mm256_cvtepu16_epi32(y), width, height, mask_.data());
+
+        const __m128i shuffle = _mm_load_si128(reinterpret_cast<const __m128i *>(tables.shuffle16[accepted]));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out_x + n_out), _mm_shuffle_epi8(x, shuffle));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out_y + n_out), _mm_shuffle_epi8(y, shuffle));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out_p + n_out), _mm_shuffle_epi8(p, shuffle));
+
+        const unsigned int accepted0 = accepted & 0xF, accepted1 = accepted >> 4;
+        const __m256i permute0 = _mm256_load_si256(reinterpret_cast<const __m256i *>(tables.permute64[accepted0]));
+        const __m256i permute1 = _mm256_load_si256(reinterpret_cast<const __m256i *>(tables.permute64[accepted1]));
+        const size_t n_out0    = n_out + tables.count[accepted0];
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out_t + n_out), _mm256_permutevar8x32_epi32(t0, permute0));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out_t + n_out0), _mm256_permutevar8x32_epi32(t1, permute1));
+        n_out = n_out0 + tables.count[accepted1];
+#else
+        // NEON has no gather instruction, the mask is looked up for each event but the compaction is vectorized
+        unsigned int accepted = 0;
+        for (size_t j = 0; j < BatchSize; ++j) {
+            accepted |= static_cast<unsigned int>(is_accepted(in_x[i + j], in_y[i + j])) << j;
+        }
+        const uint16x8_t x = vld1q_u16(in_x + i);
+        const uint16x8_t y = vld1q_u16(in_y + i);
+        const int16x8_t p  = vld1q_s16(in_p + i);
+        timestamp t[BatchSize];
+        std::copy(in_t + i, in_t + i + BatchSize, t);
+
+        const uint8x16_t shuffle = vld1q_u8(tables.shuffle16[accepted]);
+        vst1q_u16(out_x + n_out, vreinterpretq_u16_u8(vqtbl1q_u8(vreinterpretq_u8_u16(x), shuffle)));
+        vst1q_u16(out_y + n_out, vreinterpretq_u16_u8(vqtbl1q_u8(vreinterpretq_u8_u16(y), shuffle)));
+        vst1q_s16(out_p + n_out, vreinterpretq_s16_u8(vqtbl1q_u8(vreinterpretq_u8_s16(p), shuffle)));
+        for (size_t j = 0; j < BatchSize; ++j) {
+            out_t[n_out] = t[j];
+            n_out += (accepted >> j) & 1;
+        }
+#endif
+    }
+#endif
+    for (; i < n; ++i) {
+        const bool accepted = is_accepted(in_x[i], in_y[i]);
+        out_x[n_out]        = in_x[i];
+        out_y[n_out]        = in_y[i];
+        out_p[n_out]        = in_p[i];
+        out_t[n_out]        = in_t[i];
+        n_out += accepted;
+    }
+    output.resize(n_out);
+}
+
+} // namespace Metavision
@@ -17,7 +17,9 @@ namespace Metavision {
 
 OnDemandFrameGenerationAlgorithm::OnDemandFrameGenerationAlgorithm(int width, int height, uint32_t accumulation_time_us,
                                                                    const Metavision::ColorPalette &palette) :
-    BaseFrameGenerationAlgorithm(width, height, palette), accumulation_time_us_(accumulation_time_us) {
+    BaseFrameGenerationAlgorithm(width, height, palette),
+    accumulation_time_us_(accumulation_time_us),
+    dirty_tiles_(width, height) {
     reset();
 }
 
@@ -43,8 +45,36 @@ void OnDemandFrameGenerationAlgorithm::generate(timestamp ts, cv::Mat &frame, bo
     const auto end =
         std::upper_bound(begin, events_queue_.end(), ts, [](timestamp t, const auto &ev) { return t < ev.t; });
 
-    // Generate frame using events from the queue
-    generate_frame_from_events(begin, end, frame, bg_color_, off_on_colors_, colored_);
+    // Generate frame using events from the queue. In incremental mode, the frame is entirely rendered only if it is not
+    // the one of the previous call
+    const std::array<cv::Vec3b, 3> colors{off_on_colors_[0], off_on_colors_[1], bg_color_};
+    if (!incremental_ || frame.data != rendered_data_ || colors != rendered_colors_ ||
+        accumulation_time_us_ != rendered_accumulation_time_us_) {
+        generate_frame_from_events(begin, end, frame, bg_color_, off_on_colors_, colored_);
+    } else {
+        // The tiles to render are the ones of the events leaving the time window, and the ones of the new events
+        for (auto it = events_queue_.begin(); it != begin; ++it)
+            dirty_tiles_.mark(it->x, it->y);
+        for (auto it = begin; it != end; ++it) {
+            if (it->t > last_frame_ts_us_)
+                dirty_tiles_.mark(it->x, it->y);
+        }
+        generate_dirty_tiles(begin, end, frame);
+    }
+
+    if (incremental_) {
+        dirty_tiles_.clear();
+        rendered_data_                 = frame.data;
+        rendered_colors_               = colors;
+        rendered_accumulation_time_us_ = accumulation_time_us_;
+        // Without accumulation time, the events of this frame are removed from the queue below but they are to be
+        // erased from the next frame
+        if (accumulation_time_us_ == 0) {
+            for (auto it = begin; it != end; ++it)
+                dirty_tiles_.mark(it->x, it->y);
+        }
+    }
+
     // Remove events older than ts - accumulation_time,
     // Or remove all the processed events if the accumulation time is null
     events_queue_.erase(events_queue_.begin(), (accumulation_time_us_ == 0 ? end : begin));
@@ -63,9 +93,48 @@ uint32_t OnDemandFrameGenerationAlgorithm::get_accumulation_time_us() const {
     return accumulation_time_us_;
 }
 
+void OnDemandFrameGenerationAlgorithm::set_incremental(bool incremental) {
+    incremental_   = incremental;
+    rendered_data_ = nullptr;
+    dirty_tiles_.clear();
+}
+
+bool OnDemandFrameGenerationAlgorithm::is_incremental() const {
+    return incremental_;
+}
+
+void OnDemandFrameGenerationAlgorithm::generate_dirty_tiles(EventIterator begin, EventIterator end, cv::Mat &frame) {
+    if (frame.type() != (colored_ ? CV_8UC3 : CV_8UC1)) {
+        std::ostringstream ss;
+        ss << "Incompatible matrix type. Must be " << (colored_ ? "CV_8UC3" : "CV_8UC1") << ".";
+        throw std::invalid_argument(ss.str());
+    }
+
+    for (size_t tile = 0; tile < dirty_tiles_.get_n_tiles(); ++tile) {
+        if (dirty_tiles_.is_marked(tile)) {
+            cv::Mat roi = frame(dirty_tiles_.get_tile_rect(tile));
+            if (colored_)
+                roi.setTo(bg_color_);
+            else
+                roi.setTo(bg_color_[0]);
+        }
+    }
+
+    for (auto it = begin; it != end; ++it) {
+        if (!dirty_tiles_.is_marked(it->x, it->y))
+            continue;
+        if (colored_)
+            frame.at<cv::Vec3b>(it->y, it->x) = off_on_colors_[it->p];
+        else
+            frame.at<uint8_t>(it->y, it->x) = off_on_colors_[it->p][0];
+    }
+}
+
 void OnDemandFrameGenerationAlgorithm::reset() {
     events_queue_.clear();
     last_frame_ts_us_ = 0;
+    rendered_data_    = nullptr;
+    dirty_tiles_.clear();
 }
 
 } // namespace Metavision
\ No newline at end of file
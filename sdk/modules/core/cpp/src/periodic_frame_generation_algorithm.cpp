@@ -9,18 +9,112 @@
  * See the License for the specific language governing permissions and limitations under the License.                 *
  **********************************************************************************************************************/
 
+#include <cmath>
+#include <limits>
 #include <stdexcept>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+#include <opencv2/core/utility.hpp>
+
+#include "metavision/sdk/base/utils/trace.h"
 #include "metavision/sdk/core/algorithms/periodic_frame_generation_algorithm.h"
 
 namespace Metavision {
 
+namespace {
+
+// Minimum number of pixels rendered by a thread, so that small frames are rendered by the calling thread
+constexpr size_t MinPixelsPerStripe = 1 << 17;
+
+// Index of the color of a pixel in a palette of 3 colors: OFF, ON and background
+constexpr uint8_t BackgroundIndex = 2;
+
+// Number of pixels of a row of a colored frame whose color indices are computed at once
+constexpr int ColorIndicesChunkSize = 256;
+
+// Computes the indices of the colors of n pixels: the background if the last event of the pixel is before min_ts,
+// otherwise its polarity
+inline void compute_color_indices(const int32_t *ts, const uint8_t *pol, int32_t min_ts, uint8_t *indices, size_t n) {
+    size_t i = 0;
+#if defined(__AVX2__)
+    const __m256i min        = _mm256_set1_epi32(min_ts);
+    const __m256i background = _mm256_set1_epi8(BackgroundIndex);
+    // Packing the 32 bits comparisons interleaves the 128 bits lanes, this restores the order of the pixels
+    const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+    for (; i + 32 <= n; i += 32) {
+        const __m256i old0 = _mm256_cmpgt_epi32(min, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(ts + i)));
+        const __m256i old1 = _mm256_cmpgt_epi32(min, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(ts + i + 8)));
+        const __m256i old2 =
+            _mm256_cmpgt_epi32(min, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(ts + i + 16)));
+        const __m256i old3 =
+            _mm256_cmpgt_epi32(min, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(ts + i + 24)));
+        const __m256i old = _mm256_permutevar8x32_epi32(
+            _mm256_packs_epi16(_mm256_packs_epi32(old0, old1), _mm256_packs_epi32(old2, old3)), order);
+        const __m256i p = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pol + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(indices + i), _mm256_blendv_epi8(p, background, old));
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    const int32x4_t min         = vdupq_n_s32(min_ts);
+    const uint8x16_t background = vdupq_n_u8(BackgroundIndex);
+    for (; i + 16 <= n; i += 16) {
+        const uint16x8_t old_low  = vcombine_u16(vmovn_u32(vcltq_s32(vld1q_s32(ts + i), min)),
+                                                 vmovn_u32(vcltq_s32(vld1q_s32(ts + i + 4), min)));
+        const uint16x8_t old_high = vcombine_u16(vmovn_u32(vcltq_s32(vld1q_s32(ts + i + 8), min)),
+                                                 vmovn_u32(vcltq_s32(vld1q_s32(ts + i + 12), min)));
+        const uint8x16_t old      = vcombine_u8(vmovn_u16(old_low), vmovn_u16(old_high));
+        vst1q_u8(indices + i, vbslq_u8(old, background, vld1q_u8(pol + i)));
+    }
+#endif
+    for (; i < n; ++i) {
+        indices[i] = ts[i] < min_ts ? BackgroundIndex : pol[i];
+    }
+}
+
+// Replaces the indices of n pixels by their gray levels
+inline void apply_gray_levels(const std::array<uint8_t, 3> &levels, uint8_t *pixels, size_t n) {
+    size_t i = 0;
+#if defined(__AVX2__)
+    const __m256i table = _mm256_setr_epi8(levels[0], levels[1], levels[2], 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                                           levels[0], levels[1], levels[2], 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+    for (; i + 32 <= n; i += 32) {
+        const __m256i indices = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pixels + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(pixels + i), _mm256_shuffle_epi8(table, indices));
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    const uint8_t table_data[16] = {levels[0], levels[1], levels[2]};
+    const uint8x16_t table       = vld1q_u8(table_data);
+    for (; i + 16 <= n; i += 16) {
+        vst1q_u8(pixels + i, vqtbl1q_u8(table, vld1q_u8(pixels + i)));
+    }
+#endif
+    for (; i < n; ++i) {
+        pixels[i] = levels[pixels[i]];
+    }
+}
+
+// Converts a BGR color to YUV with the BT.601 limited range coefficients used by cv::cvtColor
+cv::Vec3b bgr_to_yuv(const cv::Vec3b &bgr) {
+    const double b = bgr[0], g = bgr[1], r = bgr[2];
+    auto saturate  = [](double v) { return static_cast<uint8_t>(std::min(255., std::max(0., std::round(v)))); };
+    return cv::Vec3b(saturate(0.257 * r + 0.504 * g + 0.098 * b + 16),
+                     saturate(-0.148 * r - 0.291 * g + 0.439 * b + 128),
+                     saturate(0.439 * r - 0.368 * g - 0.071 * b + 128));
+}
+
+} // namespace
+
 PeriodicFrameGenerationAlgorithm::PeriodicFrameGenerationAlgorithm(int sensor_width, int sensor_height,
                                                                    uint32_t accumulation_time_us, double fps,
                                                                    const Metavision::ColorPalette &palette) :
     BaseFrameGenerationAlgorithm(sensor_width, sensor_height, palette),
     output_cb_([](auto, auto) {}),
+    frame_pool_(FramePool::make_unbounded(2)),
     accumulation_time_us_(accumulation_time_us),
-    force_next_frame_(false) {
+    force_next_frame_(false),
+    dirty_tiles_(sensor_width, sensor_height) {
     if (fps < 0)
         throw std::invalid_argument("Frame rate must be positive or null.");
 
@@ -33,7 +127,14 @@ PeriodicFrameGenerationAlgorithm::PeriodicFrameGenerationAlgorithm(int sensor_wi
 }
 
 void PeriodicFrameGenerationAlgorithm::set_output_callback(const OutputCb &output_cb) {
-    output_cb_ = output_cb;
+    output_cb_        = output_cb;
+    pooled_output_cb_ = nullptr;
+}
+
+void PeriodicFrameGenerationAlgorithm::set_pooled_output_callback(const PooledOutputCb &output_cb,
+                                                                  FramePool frame_pool) {
+    pooled_output_cb_ = output_cb;
+    frame_pool_       = std::move(frame_pool);
 }
 
 void PeriodicFrameGenerationAlgorithm::force_generate() {
@@ -55,69 +156,343 @@ void PeriodicFrameGenerationAlgorithm::set_fps(double fps) {
         frame_period_us_ = static_cast<uint32_t>(std::round(1000000. / fps));
 
     set_processing_n_us(frame_period_us_);
+    adaptive_frame_period_us_ = frame_period_us_;
 }
 
 double PeriodicFrameGenerationAlgorithm::get_fps() {
     return 1000000. / frame_period_us_;
 }
 
+void PeriodicFrameGenerationAlgorithm::set_adaptive_fps(double min_fps, double activity_threshold_hz) {
+    if (min_fps < 0)
+        throw std::invalid_argument("Frame rate must be positive or null.");
+    if (activity_threshold_hz < 0)
+        throw std::invalid_argument("Activity threshold must be positive or null.");
+
+    adaptive_fps_             = true;
+    idle_frame_period_us_     = min_fps > 0. ? static_cast<uint32_t>(std::round(1000000. / min_fps)) : 0;
+    activity_threshold_       = activity_threshold_hz;
+    adaptive_frame_period_us_ = frame_period_us_;
+}
+
+void PeriodicFrameGenerationAlgorithm::disable_adaptive_fps() {
+    adaptive_fps_ = false;
+}
+
+bool PeriodicFrameGenerationAlgorithm::is_adaptive_fps() const {
+    return adaptive_fps_;
+}
+
 void PeriodicFrameGenerationAlgorithm::set_accumulation_time_us(uint32_t accumulation_time_us) {
     if (accumulation_time_us <= 0)
         throw std::invalid_argument("Accumulation time must be strictly positive.");
 
-    accumulation_time_us_   = accumulation_time_us;
-    min_event_ts_us_to_use_ = next_frame_ts_us_ - accumulation_time_us_;
+    // In adaptive mode, the next frame may be generated before the next frame timestamp, the events processed since
+    // the last frame are kept
+    accumulation_time_us_        = accumulation_time_us;
+    const timestamp min_event_ts = next_frame_ts_us_ - accumulation_time_us_;
+    min_event_ts_us_to_use_      = adaptive_fps_ ? std::min(min_event_ts_us_to_use_, min_event_ts) : min_event_ts;
 }
 
 uint32_t PeriodicFrameGenerationAlgorithm::get_accumulation_time_us() {
     return accumulation_time_us_;
 }
 
+void PeriodicFrameGenerationAlgorithm::set_incremental(bool incremental) {
+    if (incremental == incremental_)
+        return;
+
+    incremental_ = incremental;
+    if (incremental_) {
+        // The events processed so far have not been tracked, retrieve the timestamp of the last event of each tile
+        // from the time surface
+        tile_last_ts_.assign(dirty_tiles_.get_n_tiles(), std::numeric_limits<int32_t>::min());
+        for (int y = 0; y < height_; ++y) {
+            for (int x = 0; x < width_; ++x) {
+                auto &tile_ts = tile_last_ts_[dirty_tiles_.get_tile_index(x, y)];
+                tile_ts       = std::max(tile_ts, *time_surface_ts_.ptr(y, x));
+            }
+        }
+        dirty_tiles_.clear();
+        full_render_needed_ = true;
+    }
+}
+
+bool PeriodicFrameGenerationAlgorithm::is_incremental() const {
+    return incremental_;
+}
+
 void PeriodicFrameGenerationAlgorithm::reset() {
     force_generate();
     AsyncAlgorithm<PeriodicFrameGenerationAlgorithm>::reset();
 
     reset_time_surface();
-    next_frame_ts_us_ = 0;
+    next_frame_ts_us_         = 0;
+    adaptive_frame_period_us_ = frame_period_us_;
 
     min_event_ts_us_to_use_ = 0;
 }
 
 void PeriodicFrameGenerationAlgorithm::process_async(const timestamp processing_ts, const size_t n_processed_events) {
-    if (processing_ts < next_frame_ts_us_ && !force_next_frame_)
+    // In adaptive mode, the frames of a static scene are spaced by more than the period of the processing, while an
+    // active period triggers a frame right away
+    const bool active = adaptive_fps_ && n_processed_events * 1e6 > activity_threshold_ * frame_period_us_;
+    if (processing_ts < next_frame_ts_us_ && !force_next_frame_ && !active)
         return;
+    MV_TRACE_SCOPE("PeriodicFrameGenerationAlgorithm::generate");
 
-    // Generate Frame using the time surface
-    frame_.create(height_, width_, colored_ ? CV_8UC3 : CV_8U);
+    // Generate Frame using the time surface. In incremental mode, the frame is entirely rendered only if it has been
+    // reallocated or swapped by the user since the last frame
+    // With the pooled output callback, frame_ is a header sharing the data of a frame of the pool
+    FramePool::ptr_type pooled_frame;
+    if (pooled_output_cb_) {
+        pooled_frame = frame_pool_.acquire();
+        frame_       = *pooled_frame;
+    }
+    const int type        = colored_ ? CV_8UC3 : CV_8U;
+    const bool same_frame = frame_.data == rendered_data_ && frame_.rows == height_ && frame_.cols == width_ &&
+                            frame_.type() == type;
+    frame_.create(height_, width_, type);
+    if (pooled_frame) {
+        *pooled_frame = frame_;
+    }
 
     // Compute the time threshold below which events are not to be displayed
     // N.B. min_event_ts_us_to_use_ might be wrong at the initialization.
     //      Let's subtract the accumulation time to the current processing timestamp
-    const int32_t min_display_event_ts = static_cast<int32_t>((processing_ts - accumulation_time_us_) - ts_offset_);
-
-    // Fill the frame from the time surface
-    const size_t num_pixels = time_surface_.size();
-    if (colored_) {
-        auto img_it = frame_.begin<cv::Vec3b>();
-        for (size_t i = 0; i < num_pixels; ++i, ++img_it) {
-            const auto &last_pix_data = time_surface_[i];
-            *img_it = last_pix_data.first < min_display_event_ts ? bg_color_ : off_on_colors_[last_pix_data.second];
-        }
+    //      The threshold is saturated in the range of the time surface, above the pixels without event
+    const int32_t min_display_event_ts =
+        std::max<int32_t>(time_surface_ts_.to_offset(processing_ts - accumulation_time_us_),
+                          CompactMostRecentTimestampBuffer::NoTimestamp + 1);
+
+    const std::array<cv::Vec3b, 3> colors{off_on_colors_[0], off_on_colors_[1], bg_color_};
+    if (!incremental_ || full_render_needed_ || !same_frame || colors != rendered_colors_ ||
+        min_display_event_ts < last_min_display_event_ts_) {
+        // Fill the frame from the time surface, the rows being split among threads for large sensors
+        const size_t num_pixels = static_cast<size_t>(width_) * height_;
+        cv::parallel_for_(
+            cv::Range(0, height_),
+            [&](const cv::Range &rows) {
+                render(cv::Rect(0, rows.start, width_, rows.end - rows.start), min_display_event_ts);
+            },
+            std::max(1., static_cast<double>(num_pixels) / MinPixelsPerStripe));
     } else {
-        auto img_it = frame_.begin<uint8_t>();
-        for (size_t i = 0; i < num_pixels; ++i, ++img_it) {
-            const auto &last_pix_data = time_surface_[i];
-            *img_it =
-                last_pix_data.first < min_display_event_ts ? bg_color_[0] : off_on_colors_[last_pix_data.second][0];
+        // Only render the tiles that received events, and the ones that displayed events in the last frame as they
+        // may have expired since then
+        tiles_to_render_.clear();
+        for (size_t tile = 0; tile < dirty_tiles_.get_n_tiles(); ++tile) {
+            if (dirty_tiles_.is_marked(tile) || tile_last_ts_[tile] >= last_min_display_event_ts_)
+                tiles_to_render_.push_back(dirty_tiles_.get_tile_rect(tile));
         }
+        const size_t num_pixels = tiles_to_render_.size() * DirtyTileMap::TileSize * DirtyTileMap::TileSize;
+        cv::parallel_for_(
+            cv::Range(0, static_cast<int>(tiles_to_render_.size())),
+            [&](const cv::Range &tiles) {
+                for (int tile = tiles.start; tile < tiles.end; ++tile)
+                    render(tiles_to_render_[tile], min_display_event_ts);
+            },
+            std::max(1., static_cast<double>(num_pixels) / MinPixelsPerStripe));
+    }
+
+    if (incremental_) {
+        dirty_tiles_.clear();
+        full_render_needed_        = false;
+        last_min_display_event_ts_ = min_display_event_ts;
+        rendered_data_             = frame_.data;
+        rendered_colors_           = colors;
     }
 
     // Return generate frame through the output callback
-    output_cb_(processing_ts, frame_);
+    if (pooled_frame) {
+        pooled_output_cb_(processing_ts, pooled_frame);
+    } else {
+        output_cb_(processing_ts, frame_);
+    }
+
+    for (auto &view : views_) {
+        auto view_frame = view.pool.acquire();
+        const bool yuv  = view.format != ViewFormat::Default;
+        if (yuv) {
+            view_frame->create(view.size.height * 3 / 2, view.size.width, CV_8U);
+        } else {
+            view_frame->create(view.size, view.colored ? CV_8UC3 : CV_8U);
+        }
+        cv::parallel_for_(
+            cv::Range(0, yuv ? view.size.height / 2 : view.size.height),
+            [&](const cv::Range &rows) { render_view(view, rows, min_display_event_ts, *view_frame); },
+            std::max(1., static_cast<double>(view.roi.area()) / MinPixelsPerStripe));
+        view.output_cb(processing_ts, view_frame);
+    }
 
     // Increment internal variables
-    next_frame_ts_us_       = processing_ts + frame_period_us_;
-    min_event_ts_us_to_use_ = next_frame_ts_us_ - accumulation_time_us_;
+    timestamp frame_period = frame_period_us_;
+    if (adaptive_fps_) {
+        // The period doubles at each frame of a static scene, up to the idle one, or until the events have expired if
+        // no frame of a static scene is to be generated
+        if (active) {
+            adaptive_frame_period_us_ = frame_period_us_;
+        } else if (idle_frame_period_us_ > 0) {
+            adaptive_frame_period_us_ = std::min(2 * adaptive_frame_period_us_, idle_frame_period_us_);
+        } else if (adaptive_frame_period_us_ <= accumulation_time_us_) {
+            adaptive_frame_period_us_ *= 2;
+        }
+        frame_period = adaptive_frame_period_us_;
+        if (!active && idle_frame_period_us_ == 0 && adaptive_frame_period_us_ > accumulation_time_us_)
+            frame_period = std::numeric_limits<timestamp>::max() - processing_ts;
+    }
+    next_frame_ts_us_ = processing_ts + frame_period;
+    // In adaptive mode, a frame may be generated at the next processing already
+    const timestamp next_processing_ts = adaptive_fps_ ? processing_ts + frame_period_us_ : next_frame_ts_us_;
+    min_event_ts_us_to_use_            = next_processing_ts - accumulation_time_us_;
+}
+
+void PeriodicFrameGenerationAlgorithm::render(const cv::Rect &region, int32_t min_display_event_ts) {
+    const std::array<cv::Vec3b, 3> colors{off_on_colors_[0], off_on_colors_[1], bg_color_};
+    const std::array<uint8_t, 3> gray_levels{colors[0][0], colors[1][0], colors[2][0]};
+    std::array<uint8_t, ColorIndicesChunkSize> indices;
+    for (int y = region.y; y < region.y + region.height; ++y) {
+        const size_t offset = static_cast<size_t>(y) * width_;
+        const int32_t *ts   = time_surface_ts_.ptr(y);
+        const uint8_t *pol  = time_surface_pol_.data() + offset;
+        if (colored_) {
+            cv::Vec3b *row = frame_.ptr<cv::Vec3b>(y);
+            for (int x = region.x, x_end = region.x + region.width; x < x_end; x += ColorIndicesChunkSize) {
+                const int n = std::min(ColorIndicesChunkSize, x_end - x);
+                compute_color_indices(ts + x, pol + x, min_display_event_ts, indices.data(), n);
+                for (int i = 0; i < n; ++i) {
+                    row[x + i] = colors[indices[i]];
+                }
+            }
+        } else {
+            uint8_t *row = frame_.ptr<uint8_t>(y) + region.x;
+            compute_color_indices(ts + region.x, pol + region.x, min_display_event_ts, row, region.width);
+            apply_gray_levels(gray_levels, row, region.width);
+        }
+    }
+}
+
+cv::Size PeriodicFrameGenerationAlgorithm::add_output_view(const OutputView &view, const ViewOutputCb &output_cb) {
+    if (view.downscale < 1) {
+        throw std::invalid_argument("The downscale factor of a view must be positive.");
+    }
+    const cv::Rect sensor(0, 0, width_, height_);
+    const cv::Rect roi = view.roi.empty() ? sensor : view.roi & sensor;
+    if (roi.empty()) {
+        throw std::invalid_argument("The region of a view must overlap the sensor.");
+    }
+
+    const cv::Size size((roi.width + view.downscale - 1) / view.downscale,
+                        (roi.height + view.downscale - 1) / view.downscale);
+    if (view.format != ViewFormat::Default && (size.width % 2 != 0 || size.height % 2 != 0)) {
+        throw std::invalid_argument("The size of a view in a YUV format must be even.");
+    }
+    const std::array<cv::Vec3b, 3> colors{get_cv_color(view.palette, Metavision::ColorType::Negative),
+                                          get_cv_color(view.palette, Metavision::ColorType::Positive),
+                                          get_cv_color(view.palette, Metavision::ColorType::Background)};
+    const std::array<cv::Vec3b, 3> yuv_colors{bgr_to_yuv(colors[0]), bgr_to_yuv(colors[1]), bgr_to_yuv(colors[2])};
+    views_.push_back({roi, view.downscale, size, view.palette != Metavision::ColorPalette::Gray, colors, view.format,
+                      yuv_colors, output_cb, FramePool::make_unbounded(2)});
+    return size;
+}
+
+void PeriodicFrameGenerationAlgorithm::clear_output_views() {
+    views_.clear();
+}
+
+void PeriodicFrameGenerationAlgorithm::compute_view_indices(const View &view, int vy, int vx, int n,
+                                                            int32_t min_display_event_ts, uint8_t *indices) const {
+    if (view.downscale == 1) {
+        const int y = view.roi.y + vy, x = view.roi.x + vx;
+        compute_color_indices(time_surface_ts_.ptr(y) + x, time_surface_pol_.data() + y * width_ + x,
+                              min_display_event_ts, indices, n);
+        return;
+    }
+
+    // The block is clipped to the region on its right and bottom edges
+    const int roi_x_end = view.roi.x + view.roi.width, roi_y_end = view.roi.y + view.roi.height;
+    const int y_begin   = view.roi.y + vy * view.downscale;
+    const int y_end     = std::min(y_begin + view.downscale, roi_y_end);
+    for (int i = 0; i < n; ++i) {
+        const int x_begin = view.roi.x + (vx + i) * view.downscale;
+        const int x_end   = std::min(x_begin + view.downscale, roi_x_end);
+        int32_t last_ts   = min_display_event_ts - 1;
+        uint8_t index     = BackgroundIndex;
+        for (int y = y_begin; y < y_end; ++y) {
+            const int32_t *ts  = time_surface_ts_.ptr(y);
+            const uint8_t *pol = time_surface_pol_.data() + y * width_;
+            for (int x = x_begin; x < x_end; ++x) {
+                if (ts[x] > last_ts) {
+                    last_ts = ts[x];
+                    index   = pol[x];
+                }
+            }
+        }
+        indices[i] = index;
+    }
+}
+
+void PeriodicFrameGenerationAlgorithm::render_view(const View &view, const cv::Range &rows,
+                                                   int32_t min_display_event_ts, cv::Mat &frame) const {
+    if (view.format != ViewFormat::Default) {
+        // Each pair of rows is rendered at once, the chroma of each 2x2 block being computed from the same indices
+        // as its luma
+        const std::array<uint8_t, 3> y_levels{view.yuv_colors[0][0], view.yuv_colors[1][0], view.yuv_colors[2][0]};
+        const int width  = view.size.width, chroma_width = width / 2;
+        uint8_t *y_plane = frame.ptr<uint8_t>(0);
+        uint8_t *u_plane = y_plane + static_cast<size_t>(width) * view.size.height;
+        uint8_t *v_plane = u_plane + static_cast<size_t>(chroma_width) * (view.size.height / 2);
+        std::array<uint8_t, ColorIndicesChunkSize> top, bottom;
+        for (int cy = rows.start; cy < rows.end; ++cy) {
+            for (int vx = 0; vx < width; vx += ColorIndicesChunkSize) {
+                // The chunks hold an even number of pixels, as the width
+                const int n = std::min(ColorIndicesChunkSize, width - vx);
+                compute_view_indices(view, 2 * cy, vx, n, min_display_event_ts, top.data());
+                compute_view_indices(view, 2 * cy + 1, vx, n, min_display_event_ts, bottom.data());
+
+                for (int i = 0; i < n; i += 2) {
+                    const auto &c00 = view.yuv_colors[top[i]], &c01 = view.yuv_colors[top[i + 1]];
+                    const auto &c10 = view.yuv_colors[bottom[i]], &c11 = view.yuv_colors[bottom[i + 1]];
+                    const uint8_t u = static_cast<uint8_t>((c00[1] + c01[1] + c10[1] + c11[1] + 2) / 4);
+                    const uint8_t v = static_cast<uint8_t>((c00[2] + c01[2] + c10[2] + c11[2] + 2) / 4);
+                    const size_t cx = (vx + i) / 2;
+                    if (view.format == ViewFormat::NV12) {
+                        u_plane[static_cast<size_t>(cy) * width + 2 * cx]     = u;
+                        u_plane[static_cast<size_t>(cy) * width + 2 * cx + 1] = v;
+                    } else {
+                        u_plane[static_cast<size_t>(cy) * chroma_width + cx] = u;
+                        v_plane[static_cast<size_t>(cy) * chroma_width + cx] = v;
+                    }
+                }
+
+                uint8_t *top_row    = y_plane + static_cast<size_t>(2 * cy) * width + vx;
+                uint8_t *bottom_row = top_row + width;
+                std::copy(top.cbegin(), top.cbegin() + n, top_row);
+                std::copy(bottom.cbegin(), bottom.cbegin() + n, bottom_row);
+                apply_gray_levels(y_levels, top_row, n);
+                apply_gray_levels(y_levels, bottom_row, n);
+            }
+        }
+        return;
+    }
+
+    const std::array<uint8_t, 3> gray_levels{view.colors[0][0], view.colors[1][0], view.colors[2][0]};
+    std::array<uint8_t, ColorIndicesChunkSize> indices;
+    for (int vy = rows.start; vy < rows.end; ++vy) {
+        for (int vx = 0; vx < view.size.width; vx += ColorIndicesChunkSize) {
+            const int n = std::min(ColorIndicesChunkSize, view.size.width - vx);
+            compute_view_indices(view, vy, vx, n, min_display_event_ts, indices.data());
+            if (view.colored) {
+                cv::Vec3b *row = frame.ptr<cv::Vec3b>(vy) + vx;
+                for (int i = 0; i < n; ++i) {
+                    row[i] = view.colors[indices[i]];
+                }
+            } else {
+                uint8_t *row = frame.ptr<uint8_t>(vy) + vx;
+                std::copy(indices.cbegin(), indices.cbegin() + n, row);
+                apply_gray_levels(gray_levels, row, n);
+            }
+        }
+    }
 }
 
 void PeriodicFrameGenerationAlgorithm::skip_frames_up_to(timestamp ts) {
@@ -128,9 +503,12 @@ void PeriodicFrameGenerationAlgorithm::skip_frames_up_to(timestamp ts) {
 }
 
 void PeriodicFrameGenerationAlgorithm::reset_time_surface() {
-    time_surface_.resize(width_ * height_);
-    std::fill(time_surface_.begin(), time_surface_.end(), std::make_pair(std::numeric_limits<int32_t>::min(), false));
-    ts_offset_ = 0;
+    time_surface_ts_.create(height_, width_);
+    time_surface_pol_.assign(width_ * height_, 0);
+
+    tile_last_ts_.assign(incremental_ ? dirty_tiles_.get_n_tiles() : 0, std::numeric_limits<int32_t>::min());
+    dirty_tiles_.clear();
+    full_render_needed_ = true;
 }
 
 } // namespace Metavision
\ No newline at end of file
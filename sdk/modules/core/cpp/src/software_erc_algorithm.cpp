@@ -0,0 +1,108 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "metavision/sdk/core/algorithms/software_erc_algorithm.h"
+
+namespace Metavision {
+
+SoftwareErcAlgorithm::SoftwareErcAlgorithm(int width, int height, const SoftwareErcConfig &config) :
+    width_(width), height_(height), config_(config), target_rate_(config.target_rate_ev_per_s) {
+    if (width <= 0 || height <= 0) {
+        throw std::invalid_argument("The size of the sensor must be positive.");
+    }
+    if (!(config.target_rate_ev_per_s > 0) || config.rate_step_us <= 0 || config.rate_window_us < config.rate_step_us) {
+        throw std::invalid_argument("The target rate and the rate step must be positive, and the rate window must "
+                                    "not be shorter than the step.");
+    }
+    if (!(config.backoff_factor > 0 && config.backoff_factor <= 1) || !(config.recovery_factor >= 1) ||
+        !(config.min_target_rate_ev_per_s > 0)) {
+        throw std::invalid_argument("The backoff factor must be in ]0, 1], the recovery factor at least 1 and the "
+                                    "minimum target rate positive.");
+    }
+    accumulators_.resize(static_cast<size_t>(width) * height + 1);
+    reset();
+}
+
+void SoftwareErcAlgorithm::set_backlog_probe(const std::function<size_t()> &probe) {
+    backlog_probe_ = probe;
+}
+
+double SoftwareErcAlgorithm::get_target_rate() const {
+    return target_rate_;
+}
+
+double SoftwareErcAlgorithm::get_input_rate() const {
+    return input_rate_;
+}
+
+double SoftwareErcAlgorithm::get_keep_ratio() const {
+    return keep_ratio_ / static_cast<double>(KeepAll);
+}
+
+void SoftwareErcAlgorithm::reset() {
+    // The pixels start with scattered phases, so that they do not keep their events at the same time
+    for (size_t i = 0; i < accumulators_.size(); ++i) {
+        accumulators_[i] = (static_cast<std::uint32_t>(i) * 2654435761u) >> 16;
+    }
+    rate_estimator_ = RateEstimator([this](timestamp, double avg_rate, double) { update(avg_rate); },
+                                    config_.rate_step_us, config_.rate_window_us);
+    keep_ratio_       = KeepAll;
+    target_rate_      = config_.target_rate_ev_per_s;
+    input_rate_       = 0;
+    first_t_          = -1;
+    last_t_           = -1;
+    n_pending_events_ = 0;
+}
+
+void SoftwareErcAlgorithm::flush_count(timestamp t) {
+    // The times given to the estimator are relative to the first event, and start after 0 so that the duration of the
+    // first sample is not null
+    rate_estimator_.add_data(last_t_ - first_t_ + 1, n_pending_events_);
+    n_pending_events_ = 0;
+    next_rate_update_t_ += config_.rate_step_us;
+
+    if (t >= next_rate_update_t_ + config_.rate_window_us) {
+        // After a silence longer than the window, the estimation starts over, the previous counts being outdated
+        rate_estimator_ = RateEstimator([this](timestamp, double avg_rate, double) { update(avg_rate); },
+                                        config_.rate_step_us, config_.rate_window_us);
+        update(0);
+        first_t_            = t;
+        next_rate_update_t_ = t + config_.rate_step_us;
+    } else if (t >= next_rate_update_t_) {
+        next_rate_update_t_ = t + config_.rate_step_us;
+    }
+}
+
+void SoftwareErcAlgorithm::update(double input_rate) {
+    // The window may hold no count if the events are sparse
+    input_rate_ = std::isfinite(input_rate) ? input_rate : 0;
+
+    if (backlog_probe_ && config_.max_backlog > 0) {
+        const size_t backlog = backlog_probe_();
+        if (backlog > config_.max_backlog) {
+            target_rate_ = std::max(config_.min_target_rate_ev_per_s, target_rate_ * config_.backoff_factor);
+        } else if (backlog <= config_.max_backlog / 2) {
+            target_rate_ = std::min(config_.target_rate_ev_per_s, target_rate_ * config_.recovery_factor);
+        }
+    }
+
+    if (input_rate_ <= target_rate_) {
+        keep_ratio_ = KeepAll;
+    } else {
+        keep_ratio_ = std::max<std::uint32_t>(1, static_cast<std::uint32_t>(target_rate_ / input_rate_ * KeepAll));
+    }
+}
+
+} // namespace Metavision
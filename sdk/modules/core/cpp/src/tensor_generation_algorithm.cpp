@@ -0,0 +1,212 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#if defined(__F16C__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+#include <opencv2/core/utility.hpp>
+
+#include "metavision/sdk/core/algorithms/tensor_generation_algorithm.h"
+
+namespace Metavision {
+
+namespace {
+
+// Minimum number of events and values processed by a thread, so that small tensors are filled by the calling thread
+constexpr size_t MinWorkPerThread = 1 << 16;
+
+int num_channels_of(TensorGenerationAlgorithm::Type type, int num_bins) {
+    return type == TensorGenerationAlgorithm::Type::VoxelGrid ? num_bins : 2;
+}
+
+std::uint16_t float_to_half(float value) {
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    const std::uint32_t sign = (bits >> 16) & 0x8000;
+    const std::uint32_t abs  = bits & 0x7FFFFFFF;
+
+    if (abs >= 0x7F800000) {
+        // Infinity, or NaN kept quiet
+        return static_cast<std::uint16_t>(sign | 0x7C00 | (abs > 0x7F800000 ? 0x200 : 0));
+    }
+    if (abs >= 0x477FF000) {
+        // Rounded to infinity from 65520, halfway between the largest half value and 2^16
+        return static_cast<std::uint16_t>(sign | 0x7C00);
+    }
+
+    std::uint32_t half, rest, halfway;
+    if (abs < 0x38800000) {
+        // Below 2^-14, the value is a subnormal half, down to 2^-25 below which it is rounded to 0
+        if (abs < 0x33000000) {
+            return static_cast<std::uint16_t>(sign);
+        }
+        const std::uint32_t mantissa = (abs & 0x7FFFFF) | 0x800000;
+        const std::uint32_t shift    = 126 - (abs >> 23);
+        half                         = mantissa >> shift;
+        rest                         = mantissa & ((1u << shift) - 1);
+        halfway                      = 1u << (shift - 1);
+    } else {
+        // Rebiases the exponent from 127 to 15 and drops the 13 lower bits of the mantissa
+        const std::uint32_t rebiased = abs - 0x38000000;
+        half                         = rebiased >> 13;
+        rest                         = rebiased & 0x1FFF;
+        halfway                      = 0x1000;
+    }
+    if (rest > halfway || (rest == halfway && (half & 1))) {
+        ++half;
+    }
+    return static_cast<std::uint16_t>(sign | half);
+}
+
+} // namespace
+
+TensorGenerationAlgorithm::TensorGenerationAlgorithm(int width, int height, Type type, int num_bins, Layout layout) :
+    width_(width),
+    height_(height),
+    type_(type),
+    num_bins_(num_bins),
+    layout_(layout),
+    num_channels_(num_channels_of(type, num_bins)),
+    num_stripes_((height + RowsPerStripe - 1) / RowsPerStripe) {
+    if (width <= 0 || height <= 0) {
+        throw std::invalid_argument("The dimensions of the tensor must be positive.");
+    }
+    if (type == Type::VoxelGrid && num_bins <= 0) {
+        throw std::invalid_argument("The number of bins of a voxel grid must be positive.");
+    }
+    const size_t num_pixels = static_cast<size_t>(width_) * height_;
+    channel_stride_         = layout_ == Layout::CHW ? num_pixels : 1;
+    pixel_stride_           = layout_ == Layout::CHW ? 1 : num_channels_;
+    stripe_offsets_.resize(num_stripes_ + 1);
+}
+
+int TensorGenerationAlgorithm::get_num_channels() const {
+    return num_channels_;
+}
+
+std::array<size_t, 3> TensorGenerationAlgorithm::get_shape() const {
+    const size_t c = num_channels_, h = height_, w = width_;
+    return layout_ == Layout::CHW ? std::array<size_t, 3>{c, h, w} : std::array<size_t, 3>{h, w, c};
+}
+
+size_t TensorGenerationAlgorithm::get_tensor_size() const {
+    return static_cast<size_t>(num_channels_) * height_ * width_;
+}
+
+TensorGenerationAlgorithm::Layout TensorGenerationAlgorithm::get_layout() const {
+    return layout_;
+}
+
+TensorGenerationAlgorithm::Type TensorGenerationAlgorithm::get_type() const {
+    return type_;
+}
+
+void TensorGenerationAlgorithm::convert_to_half(const float *in, std::uint16_t *out, size_t n) {
+    size_t i = 0;
+#if defined(__F16C__)
+    for (; i + 8 <= n; i += 8) {
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i),
+                         _mm256_cvtps_ph(_mm256_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT));
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    for (; i + 4 <= n; i += 4) {
+        vst1_u16(out + i, vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(in + i))));
+    }
+#endif
+    for (; i < n; ++i) {
+        out[i] = float_to_half(in[i]);
+    }
+}
+
+void TensorGenerationAlgorithm::fill(float *tensor, std::uint16_t *half_tensor) {
+    if (type_ == Type::VoxelGrid) {
+        lower_bins_.resize(xs_.size());
+        upper_weights_.resize(xs_.size());
+    }
+    const size_t work = xs_.size() + get_tensor_size();
+    cv::parallel_for_(
+        cv::Range(0, num_stripes_),
+        [&](const cv::Range &stripes) {
+            for (int stripe = stripes.start; stripe < stripes.end; ++stripe) {
+                fill_stripe(stripe, tensor, half_tensor);
+            }
+        },
+        std::max(1., static_cast<double>(work) / MinWorkPerThread));
+}
+
+void TensorGenerationAlgorithm::fill_stripe(int stripe, float *tensor, std::uint16_t *half_tensor) {
+    const int row_begin = stripe * RowsPerStripe;
+    const int row_end   = std::min(row_begin + RowsPerStripe, height_);
+
+    // Values of the rows of the stripe, one range per channel with channels first, a single one with channels last
+    const size_t num_ranges  = layout_ == Layout::CHW ? num_channels_ : 1;
+    const size_t range_size  = static_cast<size_t>(row_end - row_begin) * width_ * pixel_stride_;
+    const size_t range_begin = static_cast<size_t>(row_begin) * width_ * pixel_stride_;
+    for (size_t r = 0; r < num_ranges; ++r) {
+        std::fill_n(tensor + r * channel_stride_ + range_begin, range_size, 0.f);
+    }
+
+    const size_t begin = stripe_offsets_[stripe], end = stripe_offsets_[stripe + 1];
+    auto pixel_index   = [this](size_t i) { return (static_cast<size_t>(ys_[i]) * width_ + xs_[i]) * pixel_stride_; };
+    switch (type_) {
+    case Type::VoxelGrid: {
+        // The bins and weights are computed first on contiguous arrays, in a loop without dependencies which is
+        // vectorized, the accumulation being done after
+        const float max_bin  = static_cast<float>(num_bins_ - 1);
+        const int last_lower = std::max(num_bins_ - 2, 0);
+        for (size_t i = begin; i < end; ++i) {
+            const float bin   = ts_[i] * max_bin;
+            const int lower   = std::min(static_cast<int>(bin), last_lower);
+            lower_bins_[i]    = lower;
+            upper_weights_[i] = bin - static_cast<float>(lower);
+        }
+        if (num_bins_ == 1) {
+            for (size_t i = begin; i < end; ++i) {
+                tensor[pixel_index(i)] += ps_[i] ? 1.f : -1.f;
+            }
+            break;
+        }
+        for (size_t i = begin; i < end; ++i) {
+            const float polarity = ps_[i] ? 1.f : -1.f;
+            float *lower_value   = tensor + pixel_index(i) + lower_bins_[i] * channel_stride_;
+            lower_value[0] += polarity * (1.f - upper_weights_[i]);
+            lower_value[channel_stride_] += polarity * upper_weights_[i];
+        }
+        break;
+    }
+    case Type::Histogram:
+        for (size_t i = begin; i < end; ++i) {
+            tensor[pixel_index(i) + ps_[i] * channel_stride_] += 1.f;
+        }
+        break;
+    case Type::TimeSurface:
+        // Shifted by 1 us, so that an event at the beginning of the interval is distinguished from no event
+        for (size_t i = begin; i < end; ++i) {
+            float &value = tensor[pixel_index(i) + ps_[i] * channel_stride_];
+            value        = std::max(value, std::min(ts_[i] + ts_step_, 1.f));
+        }
+        break;
+    }
+
+    if (half_tensor) {
+        for (size_t r = 0; r < num_ranges; ++r) {
+            const size_t offset = r * channel_stride_ + range_begin;
+            convert_to_half(tensor + offset, half_tensor + offset, range_size);
+        }
+    }
+}
+
+} // namespace Metavision
@@ -10,11 +10,13 @@
  **********************************************************************************************************************/
 
 #include "metavision/sdk/core/utils/threaded_process.h"
+#include "metavision/sdk/base/utils/sdk_log.h"
 
 namespace Metavision {
 
 ThreadedProcess::~ThreadedProcess() {
     stop();
+    clear_tasks();
 }
 
 void ThreadedProcess::add_task(Task task) {
@@ -22,17 +24,43 @@ void ThreadedProcess::add_task(Task task) {
         return;
     }
 
-    std::lock_guard<std::mutex> lock(process_mutex_);
-    tasks_.push(task);
-    process_cond_.notify_all();
+    TaskNode *node = new TaskNode;
+    node->task     = std::move(task);
+    push(node);
 }
 
 void ThreadedProcess::add_repeating_task(RepeatingTask task) {
-    add_task([this, task]() {
-        if (task()) {
-            add_repeating_task(task);
-        }
-    });
+    if (abort_) {
+        return;
+    }
+
+    TaskNode *node       = new TaskNode;
+    node->repeating_task = std::move(task);
+    push(node);
+}
+
+void ThreadedProcess::push(TaskNode *node) {
+    tasks_.push(node);
+    // The processing thread only needs to be notified if it is sleeping, as it checks the queue before that
+    if (sleeping_) {
+        std::lock_guard<std::mutex> lock(process_mutex_);
+        process_cond_.notify_all();
+    }
+}
+
+void ThreadedProcess::clear_tasks() {
+    while (auto node = tasks_.pop()) {
+        delete static_cast<TaskNode *>(node);
+    }
+}
+
+void ThreadedProcess::set_thread_policy(const ThreadPolicy &policy) {
+    std::lock_guard<std::mutex> lock(process_mutex_);
+    thread_policy_ = policy;
+}
+
+void ThreadedProcess::set_spin_before_sleep(std::chrono::microseconds duration) {
+    spin_before_sleep_us_ = duration.count();
 }
 
 bool ThreadedProcess::start() {
@@ -43,8 +71,7 @@ bool ThreadedProcess::start() {
     }
 
     // Clears tasks list
-    std::queue<Task> tasks;
-    tasks.swap(tasks_);
+    clear_tasks();
 
     processing_thread_ = std::thread(&ThreadedProcess::processing_thread, this);
     process_cond_.wait(lock, [this]() { return !stop_ && !abort_; });
@@ -84,31 +111,54 @@ bool ThreadedProcess::is_active() {
 void ThreadedProcess::processing_thread() {
     {
         std::lock_guard<std::mutex> lock(process_mutex_);
+        if (!apply_thread_policy(thread_policy_, "mv_threaded_proc")) {
+            MV_SDK_LOG_WARNING() << "Failed to apply the threading policy of the processing thread";
+        }
         stop_  = false;
         abort_ = false;
         process_cond_.notify_all();
     }
 
     while (!abort_) {
-        std::queue<Task> tasks;
-        {
-            std::unique_lock<std::mutex> lock(process_mutex_);
-            // Waits for tasks
-            process_cond_.wait(lock, [this]() { return stop_ || !tasks_.empty(); });
-            if (tasks_.empty()) {
-                // Stop call and no pending tasks
-                break;
-            }
+        TaskNode *node = wait_next_task();
+        if (!node) {
+            // Stop call and no pending tasks
+            break;
+        }
 
-            // Swap tasks
-            tasks.swap(tasks_);
+        // Run task, a repeating task being queued again with the same node
+        if (node->repeating_task) {
+            if (node->repeating_task() && !abort_) {
+                tasks_.push(node);
+                continue;
+            }
+        } else {
+            node->task();
         }
+        delete node;
+    }
+}
 
-        // Run tasks
-        while (!tasks.empty() && !abort_) {
-            tasks.front()();
-            tasks.pop();
+ThreadedProcess::TaskNode *ThreadedProcess::wait_next_task() {
+    const auto spin_deadline =
+        std::chrono::steady_clock::now() + std::chrono::microseconds(spin_before_sleep_us_.load());
+    while (true) {
+        if (auto node = tasks_.pop()) {
+            return static_cast<TaskNode *>(node);
         }
+        if (stop_ && tasks_.empty()) {
+            return nullptr;
+        }
+        if (std::chrono::steady_clock::now() < spin_deadline) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        // Waits for tasks, the queue being checked after announcing the sleep so that no push is missed
+        std::unique_lock<std::mutex> lock(process_mutex_);
+        sleeping_ = true;
+        process_cond_.wait(lock, [this]() { return stop_ || !tasks_.empty(); });
+        sleeping_ = false;
     }
 }
 
@@ -48,10 +48,16 @@
 //
 //M*/
 
+#include <future>
+#include <map>
+#include <stdexcept>
 #include <opencv2/videoio.hpp>
 #include <opencv2/core/types_c.h>
 
+#include "metavision/sdk/base/utils/object_pool.h"
 #include "metavision/sdk/base/utils/sdk_log.h"
+#include "metavision/sdk/base/utils/trace.h"
+#include "metavision/sdk/core/utils/threaded_process.h"
 #include "metavision/sdk/core/utils/video_writer.h"
 
 // defining the stuff required for OpenCV's implementation from v4.5.0
@@ -196,6 +202,15 @@ enum VideoWriterProperties {
 #else
     VIDEOWRITER_PROP_IS_COLOR = 4,
 #endif
+    VIDEOWRITER_PROP_HW_ACCELERATION = 6,
+};
+
+enum VideoAccelerationType {
+    VIDEO_ACCELERATION_NONE  = 0,
+    VIDEO_ACCELERATION_ANY   = 1,
+    VIDEO_ACCELERATION_D3D11 = 2,
+    VIDEO_ACCELERATION_VAAPI = 3,
+    VIDEO_ACCELERATION_MFX   = 4,
 };
 
 } // namespace cv45
@@ -208,6 +223,29 @@ enum VideoWriterProperties {
 
 namespace Metavision {
 
+struct VideoWriter::AsyncState {
+    AsyncState(std::size_t queue_size, AsyncQueuePolicy policy) :
+        frame_pool_(SharedObjectPool<cv::Mat>::make_bounded(queue_size)), policy_(policy) {}
+
+    // Runs a function on the worker thread, after the frames queued so far, and returns its result
+    template<typename F>
+    auto run(const F &f) -> decltype(f()) {
+        if (!thread_.is_active()) {
+            return f();
+        }
+        std::packaged_task<decltype(f())()> task(f);
+        auto result = task.get_future();
+        thread_.add_task([&task]() { task(); });
+        return result.get();
+    }
+
+    // Frames waiting to be encoded are taken from this pool, whose size bounds the queue
+    SharedObjectPool<cv::Mat> frame_pool_;
+    const AsyncQueuePolicy policy_;
+    // Destroyed first, so that the frames queued are encoded before the pool is destroyed
+    ThreadedProcess thread_;
+};
+
 VideoWriter::VideoWriter() {}
 
 VideoWriter::VideoWriter(const cv::String &filename, int _fourcc, double fps, cv::Size frameSize, bool isColor) {
@@ -230,6 +268,10 @@ VideoWriter::VideoWriter(const cv::String &filename, int apiPreference, int four
 }
 
 void VideoWriter::release() {
+    if (async_) {
+        // Encodes the frames queued
+        async_->thread_.stop();
+    }
     writer_.release();
     cv::VideoWriter::release();
 }
@@ -260,7 +302,11 @@ bool VideoWriter::open(const cv::String &filename, int apiPreference, int fourcc
         release();
     }
 
-    if (fourcc == CV_FOURCC('M', 'J', 'P', 'G')) {
+    // The MJPEG encoder of this class runs on the CPU, the hardware accelerated encoders are those of OpenCV's backends
+    if (fourcc == CV_FOURCC('M', 'J', 'P', 'G') &&
+        cv45::VideoWriterParameters(params).get(cv45::VIDEOWRITER_PROP_HW_ACCELERATION,
+                                                static_cast<int>(cv45::VIDEO_ACCELERATION_NONE)) ==
+            cv45::VIDEO_ACCELERATION_NONE) {
         const cv45::VideoWriterParameters parameters(params);
         writer_ = cv45::createMotionJpegWriter(filename, CV_FOURCC('M', 'J', 'P', 'G'), fps, frameSize, parameters);
         try {
@@ -303,6 +349,20 @@ bool VideoWriter::isOpened() const {
 }
 
 bool VideoWriter::set(int propId, double value) {
+    if (async_) {
+        return async_->run([&]() { return set_property(propId, value); });
+    }
+    return set_property(propId, value);
+}
+
+double VideoWriter::get(int propId) const {
+    if (async_) {
+        return async_->run([&]() { return get_property(propId); });
+    }
+    return get_property(propId);
+}
+
+bool VideoWriter::set_property(int propId, double value) {
     if (propId != static_cast<int>(cv45::CAP_PROP_BACKEND)) {
         if (writer_) {
             return writer_->setProperty(propId, value);
@@ -311,7 +371,7 @@ bool VideoWriter::set(int propId, double value) {
     return cv::VideoWriter::set(propId, value);
 }
 
-double VideoWriter::get(int propId) const {
+double VideoWriter::get_property(int propId) const {
     if (propId != static_cast<int>(cv45::CAP_PROP_BACKEND)) {
         if (writer_) {
             return writer_->getProperty(propId);
@@ -320,6 +380,27 @@ double VideoWriter::get(int propId) const {
     return cv::VideoWriter::get(propId);
 }
 
+std::vector<int> VideoWriter::get_hw_acceleration_params(const std::string &acceleration) {
+    static const std::map<std::string, cv45::VideoAccelerationType> accelerations = {
+        {"none", cv45::VIDEO_ACCELERATION_NONE},   {"any", cv45::VIDEO_ACCELERATION_ANY},
+        {"d3d11", cv45::VIDEO_ACCELERATION_D3D11}, {"vaapi", cv45::VIDEO_ACCELERATION_VAAPI},
+        {"mfx", cv45::VIDEO_ACCELERATION_MFX},
+    };
+    const auto it = accelerations.find(acceleration);
+    if (it == accelerations.end()) {
+        throw std::invalid_argument("Unknown video hardware acceleration '" + acceleration + "'");
+    }
+    if (it->second == cv45::VIDEO_ACCELERATION_NONE) {
+        return {};
+    }
+#if CV_MAJOR_VERSION * 10000 + CV_MINOR_VERSION * 100 + CV_SUBMINOR_VERSION >= 40502
+    return {cv45::VIDEOWRITER_PROP_HW_ACCELERATION, static_cast<int>(it->second)};
+#else
+    MV_SDK_LOG_WARNING() << "Video hardware acceleration requires OpenCV 4.5.2 or later, the encoding is done on CPU";
+    return {};
+#endif
+}
+
 cv::String VideoWriter::getBackendName() const {
     if (writer_) {
         return "VideoWriter";
@@ -333,6 +414,40 @@ cv::String VideoWriter::getBackendName() const {
 }
 
 void VideoWriter::write(cv::InputArray image) {
+    if (!async_) {
+        write_frame(image);
+        return;
+    }
+
+    if (async_->policy_ == AsyncQueuePolicy::Drop && async_->frame_pool_.empty()) {
+        ++n_dropped_frames_;
+        return;
+    }
+    // Blocks until a frame is available if the queue is full
+    auto frame = async_->frame_pool_.acquire();
+    image.copyTo(*frame);
+    async_->thread_.start();
+    async_->thread_.add_task([this, frame]() { write_frame(*frame); });
+}
+
+void VideoWriter::set_async(std::size_t queue_size, AsyncQueuePolicy policy) {
+    // Encodes the frames queued before changing the mode
+    async_.reset();
+    if (queue_size > 0) {
+        async_.reset(new AsyncState(queue_size, policy));
+    }
+}
+
+bool VideoWriter::is_async() const {
+    return async_ != nullptr;
+}
+
+std::size_t VideoWriter::get_n_dropped_frames() const {
+    return n_dropped_frames_;
+}
+
+void VideoWriter::write_frame(cv::InputArray image) {
+    MV_TRACE_SCOPE("VideoWriter::encode");
     if (writer_) {
         writer_->write(image);
         return;
@@ -0,0 +1,129 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include <boost/any.hpp>
+#include <gtest/gtest.h>
+
+#include "metavision/sdk/core/pipeline/pipeline.h"
+#include "metavision/sdk/core/pipeline/activity_gating_stage.h"
+
+using namespace Metavision;
+
+namespace {
+
+// Produces buffers of events when started, as a camera stage would
+struct MockProducingStage : public BaseStage {
+    MockProducingStage(const std::vector<std::vector<EventCD>> &buffers) : pool(EventBufferPool::make_unbounded()) {
+        set_starting_callback([this, buffers] {
+            for (const auto &events : buffers) {
+                auto buffer = pool.acquire();
+                buffer->assign(events.begin(), events.end());
+                produce(buffer);
+            }
+            complete();
+        });
+    }
+
+    EventBufferPool pool;
+};
+
+struct MockConsumingStage : public BaseStage {
+    MockConsumingStage(std::vector<BaseStage::EventBufferPtr> &buffers) {
+        set_consuming_callback([&buffers](const boost::any &data) {
+            buffers.push_back(boost::any_cast<BaseStage::EventBufferPtr>(data));
+        });
+    }
+};
+
+// Makes buffers of 1ms of events, with a burst of activity in a block between 2 timestamps
+std::vector<std::vector<EventCD>> make_buffers(timestamp burst_begin, timestamp burst_end, timestamp end) {
+    std::vector<std::vector<EventCD>> buffers;
+    for (timestamp t = 0; t < end; t += 1000) {
+        buffers.emplace_back();
+        // background noise, an event in a different block each time
+        buffers.back().emplace_back((t / 1000 * 16) % 640, 100, 0, t);
+        if (t >= burst_begin && t < burst_end) {
+            for (timestamp dt = 0; dt < 1000; dt += 10) {
+                buffers.back().emplace_back(5, 5, 1, t + dt);
+            }
+        }
+    }
+    return buffers;
+}
+
+} // namespace
+
+TEST(ActivityGatingStage_GTest, invalid_arguments) {
+    EXPECT_THROW(ActivityGatingStage(0, 480, 1000., 100.), std::invalid_argument);
+    EXPECT_THROW(ActivityGatingStage(640, 480, 1000., 100., 0), std::invalid_argument);
+    EXPECT_THROW(ActivityGatingStage(640, 480, 1000., 2000.), std::invalid_argument);
+    EXPECT_THROW(ActivityGatingStage(640, 480, 1000., 100., 16, 2, 0), std::invalid_argument);
+}
+
+TEST(ActivityGatingStage_GTest, gates_the_buffers_of_an_inactive_scene) {
+    // GIVEN a scene with background noise, and a burst of activity of 100kHz in a block between 20ms and 40ms
+    Pipeline p;
+    auto &producing_stage = p.add_stage(std::make_unique<MockProducingStage>(make_buffers(20000, 40000, 80000)));
+    auto &gating_stage    = p.add_stage(
+        std::make_unique<ActivityGatingStage>(640, 480, 50000., 10000., 16, 2, 1000, 4000), producing_stage);
+    std::vector<std::pair<timestamp, bool>> changes;
+    gating_stage.set_activity_callback([&changes](timestamp t, bool active) { changes.emplace_back(t, active); });
+    std::vector<BaseStage::EventBufferPtr> buffers;
+    p.add_stage(std::make_unique<MockConsumingStage>(buffers), gating_stage);
+
+    // WHEN running the pipeline until the end of the events
+    p.run();
+
+    // THEN the scene is active during the burst only, the noise being ignored
+    ASSERT_EQ(2u, changes.size());
+    EXPECT_TRUE(changes[0].second);
+    EXPECT_GT(changes[0].first, 20000);
+    EXPECT_LT(changes[0].first, 25000);
+    EXPECT_FALSE(changes[1].second);
+    EXPECT_GT(changes[1].first, 40000);
+    EXPECT_LT(changes[1].first, 46000);
+    EXPECT_FALSE(gating_stage.is_active());
+
+    // THEN only the buffers of the active scene are forwarded
+    ASSERT_FALSE(buffers.empty());
+    EXPECT_EQ(80u, buffers.size() + gating_stage.num_gated_buffers());
+    for (const auto &buffer : buffers) {
+        EXPECT_GE(buffer->front().t, 20000);
+        EXPECT_LT(buffer->front().t, 46000);
+    }
+}
+
+TEST(ActivityGatingStage_GTest, hysteresis_keeps_the_scene_active) {
+    // GIVEN a scene whose activity falls from 100kHz to 20kHz, between the activation and deactivation rates
+    std::vector<std::vector<EventCD>> events = make_buffers(0, 20000, 20000);
+    for (timestamp t = 20000; t < 60000; t += 1000) {
+        events.emplace_back();
+        for (timestamp dt = 0; dt < 1000; dt += 50) {
+            events.back().emplace_back(5, 5, 1, t + dt);
+        }
+    }
+    Pipeline p;
+    auto &producing_stage = p.add_stage(std::make_unique<MockProducingStage>(events));
+    auto &gating_stage    = p.add_stage(
+        std::make_unique<ActivityGatingStage>(640, 480, 50000., 10000., 16, 2, 1000, 4000), producing_stage);
+    std::vector<BaseStage::EventBufferPtr> buffers;
+    p.add_stage(std::make_unique<MockConsumingStage>(buffers), gating_stage);
+
+    // WHEN running the pipeline until the end of the events
+    p.run();
+
+    // THEN the scene remains active once activated
+    EXPECT_TRUE(gating_stage.is_active());
+    EXPECT_EQ(buffers.back()->back().t, events.back().back().t);
+}
@@ -0,0 +1,192 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <gtest/gtest.h>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/core/algorithms/activity_noise_filter_algorithm.h"
+
+using namespace Metavision;
+
+namespace {
+
+constexpr int Width = 40, Height = 30;
+
+// Straightforward implementation of the filter, with 64 bits timestamps
+std::vector<EventCD> filter_reference(const std::vector<EventCD> &events, timestamp threshold) {
+    std::vector<timestamp> last(Width * Height, -1);
+    std::vector<EventCD> output;
+    for (const auto &ev : events) {
+        if (ev.x >= Width || ev.y >= Height) {
+            continue;
+        }
+        bool supported = false;
+        for (int y = ev.y - 1; y <= ev.y + 1; ++y) {
+            for (int x = ev.x - 1; x <= ev.x + 1; ++x) {
+                if (x < 0 || y < 0 || x >= Width || y >= Height || (x == ev.x && y == ev.y)) {
+                    continue;
+                }
+                const timestamp t = last[y * Width + x];
+                supported |= t >= 0 && ev.t - t <= threshold;
+            }
+        }
+        last[ev.y * Width + ev.x] = ev.t;
+        if (supported) {
+            output.push_back(ev);
+        }
+    }
+    return output;
+}
+
+void expect_events(const std::vector<EventCD> &expected, const std::vector<EventCD> &output) {
+    ASSERT_EQ(expected.size(), output.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(expected[i].x, output[i].x);
+        EXPECT_EQ(expected[i].y, output[i].y);
+        EXPECT_EQ(expected[i].p, output[i].p);
+        EXPECT_EQ(expected[i].t, output[i].t);
+    }
+}
+
+} // namespace
+
+TEST(ActivityNoiseFilterAlgorithm_GTest, keeps_events_supported_by_a_recent_neighbour) {
+    ActivityNoiseFilterAlgorithm algo(Width, Height, 100);
+    std::vector<EventCD> output;
+
+    // GIVEN an isolated event, a neighbour within the threshold, another one of the same pixel and a neighbour too late
+    const std::vector<EventCD> events = {EventCD(10, 10, 1, 1000), EventCD(11, 11, 0, 1100), EventCD(11, 11, 0, 1150),
+                                         EventCD(12, 10, 1, 1300)};
+
+    // WHEN filtering the events
+    algo.process_events(events.cbegin(), events.cend(), std::back_inserter(output));
+
+    // THEN only the event supported by a neighbour is kept
+    ASSERT_EQ(1u, output.size());
+    EXPECT_EQ(1100, output[0].t);
+}
+
+TEST(ActivityNoiseFilterAlgorithm_GTest, pixels_on_the_edges_of_the_sensor) {
+    ActivityNoiseFilterAlgorithm algo(Width, Height, 100);
+    std::vector<EventCD> events = {EventCD(0, 0, 0, 10),
+                                   EventCD(1, 1, 0, 20),
+                                   EventCD(Width - 1, Height - 1, 0, 30),
+                                   EventCD(Width - 2, Height - 1, 0, 40),
+                                   EventCD(Width - 1, 0, 0, 50),
+                                   EventCD(0, Height - 1, 0, 60),
+                                   EventCD(Width, 0, 0, 70)};
+
+    // WHEN filtering events in the corners, and out of the sensor
+    algo.process_events(events, events);
+
+    // THEN the events are only supported by the pixels of the sensor, and the ones out of the sensor are dropped
+    ASSERT_EQ(2u, events.size());
+    EXPECT_EQ(20, events[0].t);
+    EXPECT_EQ(40, events[1].t);
+}
+
+TEST(ActivityNoiseFilterAlgorithm_GTest, same_events_as_reference_whatever_the_number_of_threads) {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> x_dist(0, Width), y_dist(0, Height), p_dist(0, 1), dt_dist(0, 20);
+    std::vector<EventCD> events;
+    timestamp t = 0;
+    for (int i = 0; i < 20000; ++i) {
+        t += dt_dist(gen);
+        events.emplace_back(x_dist(gen), y_dist(gen), p_dist(gen), t);
+    }
+    const timestamp threshold         = 1000;
+    const std::vector<EventCD> expect = filter_reference(events, threshold);
+    ASSERT_FALSE(expect.empty());
+    ASSERT_LT(expect.size(), events.size());
+
+    for (int num_threads : {1, 3, 4, Height, 100}) {
+        SCOPED_TRACE(num_threads);
+        // WHEN filtering the events in several buffers, whose bands are processed in parallel
+        ActivityNoiseFilterAlgorithm algo(Width, Height, threshold, num_threads);
+        std::vector<EventCD> output, buffer;
+        for (size_t i = 0; i < events.size(); i += 3000) {
+            buffer.assign(events.begin() + i, events.begin() + std::min(events.size(), i + 3000));
+            algo.process_events(buffer, buffer);
+            output.insert(output.end(), buffer.begin(), buffer.end());
+        }
+
+        // THEN the events kept are the same as with a single map of the sensor
+        expect_events(expect, output);
+
+        // AND the same with the other overloads
+        algo.reset();
+        output.clear();
+        algo.process_events(events.cbegin(), events.cend(), std::back_inserter(output));
+        expect_events(expect, output);
+
+        algo.reset();
+        EventCDBufferSoA input_soa, output_soa;
+        for (const auto &ev : events) {
+            input_soa.push_back(ev.x, ev.y, ev.p, ev.t);
+        }
+        algo.process_events(input_soa, output_soa);
+        ASSERT_EQ(expect.size(), output_soa.size());
+        for (size_t i = 0; i < expect.size(); ++i) {
+            EXPECT_EQ(expect[i].x, output_soa.x()[i]);
+            EXPECT_EQ(expect[i].y, output_soa.y()[i]);
+            EXPECT_EQ(expect[i].p, output_soa.p()[i]);
+            EXPECT_EQ(expect[i].t, output_soa.t()[i]);
+        }
+    }
+}
+
+TEST(ActivityNoiseFilterAlgorithm_GTest, timestamps_beyond_the_range_of_the_offsets) {
+    ActivityNoiseFilterAlgorithm algo(Width, Height, 100, 2);
+    const timestamp t0 = 5000000000;
+
+    // WHEN filtering events hours apart, more than the range of the 32 bits offsets of the map
+    std::vector<EventCD> events = {EventCD(5, 5, 0, 10),      EventCD(5, 6, 0, 20),       EventCD(6, 6, 0, t0),
+                                   EventCD(6, 5, 0, t0 + 50), EventCD(7, 7, 0, 2 * t0),   EventCD(5, 5, 0, 2 * t0 + 10),
+                                   EventCD(8, 8, 0, 2 * t0 + 20)};
+    algo.process_events(events, events);
+
+    // THEN the old events do not support the new ones
+    ASSERT_EQ(3u, events.size());
+    EXPECT_EQ(20, events[0].t);
+    EXPECT_EQ(t0 + 50, events[1].t);
+    EXPECT_EQ(2 * t0 + 20, events[2].t);
+}
+
+TEST(ActivityNoiseFilterAlgorithm_GTest, reset_and_threshold) {
+    ActivityNoiseFilterAlgorithm algo(Width, Height, 100);
+    std::vector<EventCD> events = {EventCD(5, 5, 0, 10)};
+    algo.process_events(events, events);
+
+    // WHEN resetting the filter, the previous events do not support the next ones
+    algo.reset();
+    events = {EventCD(5, 6, 0, 20)};
+    algo.process_events(events, events);
+    EXPECT_TRUE(events.empty());
+
+    // WHEN changing the threshold, it applies to the next events
+    algo.set_threshold(1000);
+    EXPECT_EQ(1000, algo.get_threshold());
+    events = {EventCD(5, 7, 0, 520)};
+    algo.process_events(events, events);
+    EXPECT_EQ(1u, events.size());
+}
+
+TEST(ActivityNoiseFilterAlgorithm_GTest, invalid_arguments) {
+    EXPECT_THROW(ActivityNoiseFilterAlgorithm(0, Height, 100), std::invalid_argument);
+    EXPECT_THROW(ActivityNoiseFilterAlgorithm(Width, Height, -1), std::invalid_argument);
+    EXPECT_THROW(ActivityNoiseFilterAlgorithm(Width, Height, 100, 0), std::invalid_argument);
+    ActivityNoiseFilterAlgorithm algo(Width, Height, 100);
+    EXPECT_THROW(algo.set_threshold(-1), std::invalid_argument);
+}
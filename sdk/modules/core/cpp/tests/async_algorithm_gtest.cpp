@@ -488,3 +488,98 @@ TEST_F(AsyncAlgorithm_GTest, explicit_end_ts) {
     ASSERT_EQ(3, buffer_sizes.back());
     ASSERT_EQ(100, timestamps.back());
 }
+
+TEST_F(AsyncAlgorithm_GTest, many_time_slices_in_one_buffer) {
+    // GIVEN a buffer of events with bursts and gaps, spanning many short time slices
+    std::vector<Event2d> events;
+    for (timestamp t = 3; t < 20000; t += 1 + (t % 7) * (t % 13)) {
+        for (timestamp i = 0; i < t % 5; ++i) {
+            events.push_back(Event2d(0, 0, 0, t));
+        }
+    }
+
+    // WHEN we process in N_US mode the full buffer at once, and then the events one by one
+    const auto process = [&](bool one_by_one) {
+        AsyncAlgorithmImpl algo;
+        algo.set_processing_n_us(3);
+        std::vector<std::pair<timestamp, size_t>> slices;
+        algo.set_callback([&](const std::vector<Event2d> &buffer) {
+            slices.emplace_back(algo.current_processing_ts_us_, buffer.size());
+        });
+        if (one_by_one) {
+            for (auto it = events.cbegin(); it != events.cend(); ++it) {
+                algo.process_events(it, std::next(it));
+            }
+        } else {
+            algo.process_events(events.cbegin(), events.cend());
+        }
+        algo.flush();
+        return slices;
+    };
+
+    // THEN the time slices are the same
+    const auto slices = process(false);
+    ASSERT_EQ(process(true), slices);
+    size_t sum_ev = 0;
+    for (size_t i = 0; i < slices.size(); ++i) {
+        sum_ev += slices[i].second;
+        if (i + 1 < slices.size()) {
+            ASSERT_EQ(3 * static_cast<timestamp>(i + 2), slices[i].first);
+        }
+    }
+    ASSERT_EQ(events.size(), sum_ev);
+}
+
+namespace {
+
+// Sorts the events of each time slice by x in a temporary vector allocated from the slice arena
+class ArenaAlgorithmImpl : public AsyncAlgorithm<ArenaAlgorithmImpl> {
+public:
+    ArenaAlgorithmImpl() : sorted_(ArenaAllocator<Event2d>(slice_arena())) {}
+
+    template<class InputIt>
+    inline void process_online(InputIt it_begin, InputIt it_end) {
+        sorted_.insert(sorted_.cend(), it_begin, it_end);
+    }
+
+    void process_async(const timestamp, const size_t) {
+        std::sort(sorted_.begin(), sorted_.end(), [](const Event2d &a, const Event2d &b) { return a.x < b.x; });
+        used_bytes = slice_arena().used_bytes();
+        num_block_allocations.push_back(slice_arena().num_block_allocations());
+        // the vector is reset along with the arena
+        sorted_ = ArenaVector<Event2d>(ArenaAllocator<Event2d>(slice_arena()));
+    }
+
+    size_t arena_used_bytes() {
+        return slice_arena().used_bytes();
+    }
+
+    size_t used_bytes = 0;
+    std::vector<size_t> num_block_allocations;
+
+private:
+    ArenaVector<Event2d> sorted_;
+};
+
+} // namespace
+
+TEST(AsyncAlgorithmArena_GTest, slice_arena_is_reset_at_each_time_slice) {
+    // GIVEN an algorithm allocating its temporaries from the slice arena, processing slices of 1000 events
+    ArenaAlgorithmImpl algo;
+    algo.set_processing_n_events(1000);
+    std::vector<Event2d> events;
+    for (int i = 0; i < 20000; ++i) {
+        events.push_back(Event2d(static_cast<unsigned short>((i * 7919) % 640), 0, 0, i));
+    }
+
+    // WHEN processing many time slices
+    for (size_t i = 0; i < events.size(); i += 500) {
+        algo.process_events(events.cbegin() + i, events.cbegin() + i + 500);
+    }
+
+    // THEN the memory of each slice is released at its end, and the arena stops allocating after a few slices
+    EXPECT_GT(algo.used_bytes, 1000 * sizeof(Event2d));
+    EXPECT_EQ(0u, algo.arena_used_bytes());
+    ASSERT_EQ(20u, algo.num_block_allocations.size());
+    EXPECT_EQ(algo.num_block_allocations[3], algo.num_block_allocations.back());
+}
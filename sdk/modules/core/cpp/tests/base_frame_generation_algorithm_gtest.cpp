@@ -80,6 +80,30 @@ TEST(BaseFrameGenerationAlgorithm_GTest, static_frame_generation_with_accumulati
         std::equal(expected_frame.begin<cv::Vec3b>(), expected_frame.end<cv::Vec3b>(), frame.begin<cv::Vec3b>()));
 }
 
+TEST(BaseFrameGenerationAlgorithm_GTest, static_frame_generation_from_compact_events) {
+    const int sensor_width               = 10;
+    const int sensor_height              = 10;
+    const timestamp accumulation_time_us = 10000;
+    cv::Mat frame(sensor_height, sensor_width, CV_8UC3);
+
+    // GIVEN the following events, stored as compact events relative to the first one
+    std::vector<EventCD> events{{EventCD{5, 1, 0, 50000}, EventCD{5, 5, 0, 50000 + accumulation_time_us + 10},
+                                 EventCD{5, 8, 1, 50000 + 2 * accumulation_time_us}}};
+    EventCDCompactBuffer compact_events;
+    compact_events.assign(events.cbegin(), events.cend());
+
+    // WHEN we generate a frame from the compact events
+    BaseFrameGenerationAlgorithm::generate_frame_from_events(compact_events, frame, accumulation_time_us);
+
+    // THEN we generate the same frame as from the input events
+    cv::Mat expected_frame(sensor_height, sensor_width, CV_8UC3);
+    BaseFrameGenerationAlgorithm::generate_frame_from_events(events.cbegin(), events.cend(), expected_frame,
+                                                             accumulation_time_us);
+    ASSERT_EQ(BaseFrameGenerationAlgorithm::off_color_default(), frame.at<cv::Vec3b>(5, 5));
+    ASSERT_TRUE(
+        std::equal(expected_frame.begin<cv::Vec3b>(), expected_frame.end<cv::Vec3b>(), frame.begin<cv::Vec3b>()));
+}
+
 TEST(BaseFrameGenerationAlgorithm_GTest, static_frame_generation_with_accumulation_time_and_color) {
     const int sensor_width               = 10;
     const int sensor_height              = 10;
@@ -107,3 +131,31 @@ TEST(BaseFrameGenerationAlgorithm_GTest, static_frame_generation_with_accumulati
     ASSERT_EQ(expected_frame.size(), frame.size());
     ASSERT_TRUE(std::equal(expected_frame.begin<uint8_t>(), expected_frame.end<uint8_t>(), frame.begin<uint8_t>()));
 }
+
+TEST(BaseFrameGenerationAlgorithm_GTest, static_frame_generation_matches_generic_path_for_sensor_widths) {
+    for (const int sensor_width : {320, 640, 1280, 333}) {
+        for (const auto palette : {ColorPalette::Dark, ColorPalette::Gray}) {
+            const int sensor_height = 48;
+            const int type          = palette == ColorPalette::Gray ? CV_8UC1 : CV_8UC3;
+
+            // GIVEN events spread over the whole sensor
+            std::vector<EventCD> events;
+            for (int i = 0; i < 1000; ++i)
+                events.emplace_back((i * 37) % sensor_width, (i * 11) % sensor_height, i % 3 == 0, i);
+
+            // WHEN we generate a continuous frame, drawn with the kernel specialized for the width if any, and a frame
+            // that is a region of a larger one, drawn by the generic path
+            cv::Mat frame(sensor_height, sensor_width, type);
+            BaseFrameGenerationAlgorithm::generate_frame_from_events(events.cbegin(), events.cend(), frame, 0,
+                                                                     palette);
+            cv::Mat padded_frame(sensor_height, sensor_width + 1, type);
+            cv::Mat generic_frame = padded_frame(cv::Rect(0, 0, sensor_width, sensor_height));
+            ASSERT_FALSE(generic_frame.isContinuous());
+            BaseFrameGenerationAlgorithm::generate_frame_from_events(events.cbegin(), events.cend(), generic_frame, 0,
+                                                                     palette);
+
+            // THEN both frames are the same
+            ASSERT_EQ(0, cv::norm(frame, generic_frame, cv::NORM_INF)) << "width " << sensor_width;
+        }
+    }
+}
@@ -187,3 +187,50 @@ TEST_F(CDFrameGenerator_GTest, generate_all_frames) {
     ASSERT_TRUE(std::equal(expected_cd_frames.back().begin<uint8_t>(), expected_cd_frames.back().end<uint8_t>(),
                            cd_frames.back().begin<uint8_t>()));
 }
+
+TEST_F(CDFrameGenerator_GTest, time_surface_transfer_generates_latest_events) {
+    int width         = 415;
+    int height        = 225;
+    std::uint16_t fps = 1;
+
+    Metavision::CDFrameGenerator cd_frame_generator(width, height, false,
+                                                    Metavision::CDFrameGenerator::EventsTransfer::TimeSurface);
+    cd_frame_generator.set_display_accumulation_time_us(500000);
+    cd_frame_generator.set_colors(cv::Scalar::all(128), cv::Scalar::all(255), cv::Scalar::all(0), false);
+
+    std::atomic<int> cb_count{0};
+    cv::Mat cd_frame;
+    Metavision::timestamp frame_ts = -1;
+    cd_frame_generator.start(fps, [&](const Metavision::timestamp &ts, const cv::Mat &frame) {
+        if (cb_count == 0) {
+            cd_frame = frame.clone();
+            frame_ts = ts;
+        }
+        ++cb_count;
+    });
+
+    // The event at (10, 10) is shown with the polarity of the latest one, and the one at (5, 5) is too old
+    std::vector<Metavision::EventCD> events = {
+        Metavision::EventCD(5, 5, 1, 100000), Metavision::EventCD(10, 10, 1, 400000),
+        Metavision::EventCD(20, 20, 0, 800000), Metavision::EventCD(30, 30, 1, 1000002),
+        Metavision::EventCD(10, 10, 0, 1000002)};
+    cd_frame_generator.add_events(events.data(), events.data() + events.size());
+
+    while (cb_count == 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    cd_frame_generator.stop();
+
+    ASSERT_EQ(events.back().t, frame_ts);
+    cv::Mat expected_cd_frame(height, width, CV_8UC1, 128);
+    expected_cd_frame.at<std::uint8_t>(10, 10) = 0;
+    expected_cd_frame.at<std::uint8_t>(20, 20) = 0;
+    expected_cd_frame.at<std::uint8_t>(30, 30) = 255;
+    ASSERT_TRUE(std::equal(expected_cd_frame.begin<uint8_t>(), expected_cd_frame.end<uint8_t>(),
+                           cd_frame.begin<uint8_t>()));
+}
+
+TEST_F(CDFrameGenerator_GTest, time_surface_transfer_does_not_process_all_frames) {
+    EXPECT_THROW(Metavision::CDFrameGenerator(100, 50, true, Metavision::CDFrameGenerator::EventsTransfer::TimeSurface),
+                 std::invalid_argument);
+}
@@ -0,0 +1,157 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/base/events/event_ext_trigger.h"
+#include "metavision/sdk/core/algorithms/cd_trigger_merger_algorithm.h"
+
+using namespace Metavision;
+
+namespace {
+
+// Event of the merged stream: a CD event, or a trigger event if is_trigger is set
+struct MergedEvent {
+    bool is_trigger;
+    timestamp t;
+};
+
+class CDTriggerMergerAlgorithm_GTest : public ::testing::Test {
+protected:
+    void create_merger(const CDTriggerMergerConfig &config) {
+        merger_ = std::make_unique<CDTriggerMergerAlgorithm>(config);
+        merger_->set_cd_events_callback([this](const EventCD *begin, const EventCD *end) {
+            for (auto it = begin; it != end; ++it) {
+                merged_.push_back({false, it->t});
+            }
+        });
+        merger_->set_trigger_event_callback(
+            [this](const EventExtTrigger &trigger) { merged_.push_back({true, trigger.t}); });
+    }
+
+    std::unique_ptr<CDTriggerMergerAlgorithm> merger_;
+    std::vector<MergedEvent> merged_;
+};
+
+} // namespace
+
+TEST_F(CDTriggerMergerAlgorithm_GTest, merges_in_time_order) {
+    CDTriggerMergerConfig config;
+    config.max_skew_us = 1000;
+    create_merger(config);
+
+    // GIVEN CD and trigger events added separately, the triggers being late compared to the CD events
+    const std::vector<EventCD> cds{{0, 0, 0, 10}, {0, 0, 0, 20}, {0, 0, 0, 30}, {0, 0, 0, 40}};
+    const std::vector<EventExtTrigger> triggers{{1, 20, 0}, {0, 35, 0}};
+
+    // WHEN adding them, then advancing the time of both streams
+    merger_->process_cd_events(cds.data(), cds.data() + cds.size());
+    ASSERT_TRUE(merged_.empty());
+    merger_->process_trigger_events(triggers.data(), triggers.data() + triggers.size());
+    merger_->advance_time(50);
+
+    // THEN they are output in time order, a trigger preceding the CD events with the same timestamp
+    const std::vector<MergedEvent> expected{{false, 10}, {true, 20}, {false, 20}, {false, 30}, {true, 35},
+                                            {false, 40}};
+    ASSERT_EQ(expected.size(), merged_.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(expected[i].is_trigger, merged_[i].is_trigger);
+        EXPECT_EQ(expected[i].t, merged_[i].t);
+    }
+    EXPECT_EQ(0, merger_->get_num_late_events());
+}
+
+TEST_F(CDTriggerMergerAlgorithm_GTest, stalled_stream_is_not_waited_beyond_max_skew) {
+    CDTriggerMergerConfig config;
+    config.max_skew_us = 100;
+    create_merger(config);
+
+    // GIVEN CD events spanning more than the maximum skew, without trigger
+    std::vector<EventCD> cds;
+    for (timestamp t = 0; t < 500; t += 10) {
+        cds.emplace_back(0, 0, 0, t);
+    }
+
+    // WHEN adding them
+    merger_->process_cd_events(cds.data(), cds.data() + cds.size());
+
+    // THEN the CD events more than the maximum skew older than the last one are output without waiting for the
+    // triggers
+    ASSERT_EQ(39, merged_.size());
+    EXPECT_EQ(380, merged_.back().t);
+
+    // WHEN a trigger older than the events already output arrives
+    const EventExtTrigger late_trigger(1, 200, 0);
+    merger_->process_trigger_events(&late_trigger, &late_trigger + 1);
+
+    // THEN it is dropped and counted as late
+    EXPECT_EQ(1, merger_->get_num_late_events());
+    merger_->flush();
+    ASSERT_EQ(cds.size(), merged_.size());
+    for (const auto &ev : merged_) {
+        EXPECT_FALSE(ev.is_trigger);
+    }
+}
+
+TEST_F(CDTriggerMergerAlgorithm_GTest, slices_on_trigger_edges) {
+    CDTriggerMergerConfig config;
+    config.slice_edge_polarity = 1;
+    config.slice_edge_channel  = 2;
+    create_merger(config);
+
+    struct Slice {
+        timestamp begin_ts, end_ts;
+        std::vector<timestamp> events_ts;
+    };
+    std::vector<Slice> slices;
+    merger_->set_slice_callback(
+        [&slices](const EventExtTrigger &edge, timestamp end_ts, const EventCD *begin, const EventCD *end) {
+            slices.push_back({edge.t, end_ts, {}});
+            for (auto it = begin; it != end; ++it) {
+                slices.back().events_ts.push_back(it->t);
+            }
+        });
+
+    // GIVEN a stream of CD events with rising and falling edges, on the slicing channel and on another one
+    std::vector<EventCD> cds;
+    for (timestamp t = 0; t < 100; t += 5) {
+        cds.emplace_back(0, 0, 0, t);
+    }
+    const std::vector<EventExtTrigger> triggers{{1, 10, 2}, {0, 20, 2}, {1, 30, 3}, {1, 40, 2}, {1, 70, 2}};
+
+    // WHEN merging it, split in several buffers, until its end
+    merger_->process_trigger_events(triggers.data(), triggers.data() + 2);
+    merger_->process_cd_events(cds.data(), cds.data() + 10);
+    merger_->process_trigger_events(triggers.data() + 2, triggers.data() + triggers.size());
+    merger_->process_cd_events(cds.data() + 10, cds.data() + cds.size());
+    merger_->flush();
+
+    // THEN the CD events are sliced on the rising edges of the slicing channel, the last slice ending after its last
+    // event
+    ASSERT_EQ(3, slices.size());
+    EXPECT_EQ(10, slices[0].begin_ts);
+    EXPECT_EQ(40, slices[0].end_ts);
+    EXPECT_EQ(std::vector<timestamp>({10, 15, 20, 25, 30, 35}), slices[0].events_ts);
+    EXPECT_EQ(40, slices[1].begin_ts);
+    EXPECT_EQ(70, slices[1].end_ts);
+    EXPECT_EQ(std::vector<timestamp>({40, 45, 50, 55, 60, 65}), slices[1].events_ts);
+    EXPECT_EQ(70, slices[2].begin_ts);
+    EXPECT_EQ(96, slices[2].end_ts);
+    EXPECT_EQ(std::vector<timestamp>({70, 75, 80, 85, 90, 95}), slices[2].events_ts);
+}
+
+TEST_F(CDTriggerMergerAlgorithm_GTest, throws_on_negative_skew) {
+    CDTriggerMergerConfig config;
+    config.max_skew_us = -1;
+    EXPECT_THROW(CDTriggerMergerAlgorithm{config}, std::invalid_argument);
+}
@@ -0,0 +1,80 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <vector>
+#include <boost/any.hpp>
+#include <gtest/gtest.h>
+
+#include "metavision/sdk/core/pipeline/pipeline.h"
+#include "metavision/sdk/core/pipeline/cd_trigger_merging_stage.h"
+
+using namespace Metavision;
+
+namespace {
+
+// Produces the CD and trigger events in buffers, as a camera stage would
+struct MockProducingStage : public BaseStage {
+    MockProducingStage(const std::vector<EventCD> &cds, const std::vector<EventExtTrigger> &triggers) :
+        cd_pool(EventBufferPool::make_bounded()),
+        trigger_pool(CDTriggerMergingStage::EventTriggerBufferPool::make_bounded()) {
+        set_starting_callback([this, cds, triggers] {
+            auto trigger_buffer = trigger_pool.acquire();
+            trigger_buffer->assign(triggers.begin(), triggers.end());
+            produce(trigger_buffer);
+            for (size_t i = 0; i < cds.size(); i += 4) {
+                auto cd_buffer = cd_pool.acquire();
+                cd_buffer->assign(cds.begin() + i, cds.begin() + std::min(i + 4, cds.size()));
+                produce(cd_buffer);
+            }
+            complete();
+        });
+    }
+
+    EventBufferPool cd_pool;
+    CDTriggerMergingStage::EventTriggerBufferPool trigger_pool;
+};
+
+struct MockConsumingStage : public BaseStage {
+    MockConsumingStage(std::vector<CDTriggerMergingStage::TriggerSlicePtr> &slices) {
+        set_consuming_callback([&slices](const boost::any &data) {
+            slices.push_back(boost::any_cast<CDTriggerMergingStage::TriggerSlicePtr>(data));
+        });
+    }
+};
+
+} // namespace
+
+TEST(CDTriggerMergingStage_GTest, produces_slices_aligned_on_trigger_edges) {
+    // GIVEN a stage producing CD events and two rising edges
+    std::vector<EventCD> cds;
+    for (timestamp t = 0; t < 50; t += 5) {
+        cds.emplace_back(0, 0, 0, t);
+    }
+    const std::vector<EventExtTrigger> triggers{{1, 10, 0}, {0, 15, 0}, {1, 30, 0}};
+
+    std::vector<CDTriggerMergingStage::TriggerSlicePtr> slices;
+    Pipeline p;
+    auto &s1 = p.add_stage(std::make_unique<MockProducingStage>(cds, triggers));
+    auto &s2 = p.add_stage(std::make_unique<CDTriggerMergingStage>(), s1);
+    p.add_stage(std::make_unique<MockConsumingStage>(slices), s2);
+
+    // WHEN running the pipeline until the end of the events
+    p.run();
+
+    // THEN the CD events are sliced on the rising edges, the last slice being produced at the end of the stream
+    ASSERT_EQ(2, slices.size());
+    EXPECT_EQ(10, slices[0]->edge.t);
+    EXPECT_EQ(30, slices[0]->end_ts);
+    EXPECT_EQ(4, slices[0]->events.size());
+    EXPECT_EQ(30, slices[1]->edge.t);
+    EXPECT_EQ(46, slices[1]->end_ts);
+    EXPECT_EQ(4, slices[1]->events.size());
+}
@@ -0,0 +1,111 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "metavision/sdk/core/algorithms/chunked_events_buffer_producer_algorithm.h"
+
+using namespace Metavision;
+
+namespace {
+using EventIt = std::vector<EventCD>::const_iterator;
+
+std::vector<timestamp> timestamps(EventIt begin, EventIt end) {
+    std::vector<timestamp> ts;
+    for (auto it = begin; it != end; ++it) {
+        ts.push_back(it->t);
+    }
+    return ts;
+}
+
+struct ChunkedCdBufferEvent {
+    timestamp t;
+    ChunkedCdEventsBufferProducerAlgorithm::SharedEventsBuffer data_;
+};
+
+std::vector<timestamp> timestamps(const ChunkedCdEventsBufferProducerAlgorithm::SharedEventsBuffer &buffer) {
+    std::vector<EventCD> events;
+    buffer->copy_to(std::back_inserter(events));
+    return timestamps(events.cbegin(), events.cend());
+}
+} // namespace
+
+TEST(ChunkedCdEventsBufferProducer_Gtest, time_slices_larger_than_a_chunk) {
+    // GIVEN a producer of 100us time slices, with chunks of 8 events
+    ChunkedEventsBufferProducerParameters params;
+    params.buffers_time_slice_us_ = 100;
+    params.chunk_capacity_        = 8;
+    params.chunks_per_slab_       = 2;
+
+    std::vector<ChunkedCdBufferEvent> produced;
+    ChunkedCdEventsBufferProducerAlgorithm producer(
+        params, [&](timestamp ts, const ChunkedCdEventsBufferProducerAlgorithm::SharedEventsBuffer &buffer) {
+            produced.push_back({ts, buffer});
+        });
+
+    // WHEN processing 30 events in the first time slice, 3 in the second one, and 1 in the fourth one
+    std::vector<EventCD> events;
+    for (timestamp t = 0; t < 30; ++t) {
+        events.emplace_back(0, 0, 0, t);
+    }
+    events.emplace_back(0, 0, 0, 110);
+    events.emplace_back(0, 0, 0, 120);
+    events.emplace_back(0, 0, 0, 130);
+    events.emplace_back(0, 0, 0, 310);
+    producer.process_events(events.cbegin(), events.cend());
+    producer.flush();
+
+    // THEN the events of each time slice are chained in as many chunks as needed, and the empty slice is skipped
+    ASSERT_EQ(3, produced.size());
+    EXPECT_EQ(100, produced[0].t);
+    EXPECT_EQ(4, produced[0].data_->num_chunks());
+    EXPECT_EQ(timestamps(events.cbegin(), events.cbegin() + 30), timestamps(produced[0].data_));
+    EXPECT_EQ(200, produced[1].t);
+    EXPECT_EQ(timestamps(events.cbegin() + 30, events.cbegin() + 33), timestamps(produced[1].data_));
+    EXPECT_EQ(311, produced[2].t);
+    EXPECT_EQ(1, produced[2].data_->size());
+
+    // WHEN the produced buffers are released
+    produced.clear();
+
+    // THEN their chunks go back to the pool
+    EXPECT_EQ(6, producer.get_pool().num_chunks());
+    EXPECT_EQ(6, producer.get_pool().num_free_chunks());
+}
+
+TEST(ChunkedCdEventsBufferProducer_Gtest, chunks_are_reused) {
+    // GIVEN a producer of buffers of 10 events, with chunks of 4 events
+    ChunkedEventsBufferProducerParameters params;
+    params.buffers_events_count_  = 10;
+    params.buffers_time_slice_us_ = 0;
+    params.chunk_capacity_        = 4;
+    params.chunks_per_slab_       = 3;
+
+    size_t num_buffers = 0;
+    ChunkedCdEventsBufferProducerAlgorithm producer(
+        params, [&](timestamp ts, const ChunkedCdEventsBufferProducerAlgorithm::SharedEventsBuffer &buffer) {
+            ASSERT_EQ(10, buffer->size());
+            ++num_buffers;
+        });
+
+    // WHEN producing many buffers, which are released right away
+    std::vector<EventCD> events;
+    for (timestamp t = 0; t < 1000; ++t) {
+        events.emplace_back(0, 0, 0, t);
+    }
+    producer.process_events(events.cbegin(), events.cend());
+
+    // THEN the pool never allocates more chunks than needed for a single buffer
+    EXPECT_EQ(100, num_buffers);
+    EXPECT_EQ(3, producer.get_pool().num_chunks());
+}
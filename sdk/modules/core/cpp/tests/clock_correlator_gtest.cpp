@@ -0,0 +1,101 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <gtest/gtest.h>
+
+#include "metavision/sdk/core/utils/clock_correlator.h"
+
+using namespace Metavision;
+
+TEST(ClockCorrelator_GTest, invalid_parameters) {
+    EXPECT_THROW(ClockCorrelator(0, 10), std::invalid_argument);
+    EXPECT_THROW(ClockCorrelator(1000, 1), std::invalid_argument);
+}
+
+TEST(ClockCorrelator_GTest, not_valid_without_samples) {
+    ClockCorrelator correlator;
+    EXPECT_FALSE(correlator.get_correlation().valid_);
+    EXPECT_EQ(0u, correlator.get_correlation().num_samples_);
+}
+
+TEST(ClockCorrelator_GTest, estimates_offset_and_drift_from_delayed_samples) {
+    // GIVEN a host clock running 50 ppm faster than the device clock, with an offset of 1000 s, and observations of the
+    // device time delayed by up to 2 ms, some of them without delay
+    const double drift_ppm = 50.;
+    auto host_time_of  = [&](timestamp t) { return 1000000000 + t + static_cast<int64_t>(t * drift_ppm * 1e-6); };
+    ClockCorrelator correlator(100000, 50);
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int64_t> delay(0, 2000);
+
+    // WHEN adding a sample every ms for 10 s
+    for (timestamp t = 0; t < 10000000; t += 1000) {
+        correlator.add_sample(t, host_time_of(t) + (t % 20000 == 0 ? 0 : delay(gen)));
+    }
+
+    // THEN the relation recovers the drift and the offset of the clocks, ignoring the delays
+    const auto correlation = correlator.get_correlation();
+    ASSERT_TRUE(correlation.valid_);
+    EXPECT_EQ(10000u, correlation.num_samples_);
+    EXPECT_NEAR(drift_ppm, correlation.drift_ppm_, 1.);
+    EXPECT_LT(correlation.jitter_us_, 5.);
+    for (timestamp t : {5000000, 9999000, 12000000}) {
+        EXPECT_NEAR(host_time_of(t), correlation.to_host_time_us(t), 5) << "at " << t;
+        EXPECT_NEAR(t, correlation.to_device_time_us(host_time_of(t)), 5) << "at " << t;
+    }
+}
+
+TEST(ClockCorrelator_GTest, follows_a_change_of_drift) {
+    // GIVEN a relation estimated with a drift of 100 ppm
+    ClockCorrelator correlator(100000, 10);
+    double host_time = 0.;
+    timestamp t      = 0;
+    for (; t < 2000000; t += 1000) {
+        correlator.add_sample(t, std::llround(host_time));
+        host_time += 1000 * (1 + 100e-6);
+    }
+    EXPECT_NEAR(100., correlator.get_correlation().drift_ppm_, 1.);
+
+    // WHEN the drift changes to -50 ppm for more than the window of bins
+    for (; t < 4000000; t += 1000) {
+        correlator.add_sample(t, std::llround(host_time));
+        host_time += 1000 * (1 - 50e-6);
+    }
+
+    // THEN the relation follows it
+    EXPECT_NEAR(-50., correlator.get_correlation().drift_ppm_, 1.);
+}
+
+TEST(ClockCorrelator_GTest, resets_when_device_time_goes_back) {
+    // GIVEN samples with an offset of 1000 us
+    ClockCorrelator correlator(1000, 10);
+    for (timestamp t = 0; t < 100000; t += 100) {
+        correlator.add_sample(t, t + 1000);
+    }
+    EXPECT_EQ(1000, correlator.get_correlation().to_host_time_us(0));
+
+    // WHEN the device restarts with an offset of 5000 us
+    correlator.add_sample(0, 5000);
+
+    // THEN the previous samples are discarded
+    const auto correlation = correlator.get_correlation();
+    EXPECT_EQ(1u, correlation.num_samples_);
+    EXPECT_EQ(5000, correlation.to_host_time_us(0));
+    EXPECT_EQ(0., correlation.drift_ppm_);
+
+    // WHEN resetting it
+    correlator.reset();
+
+    // THEN it is not valid anymore
+    EXPECT_FALSE(correlator.get_correlation().valid_);
+}
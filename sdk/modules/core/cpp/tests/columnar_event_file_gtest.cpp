@@ -0,0 +1,208 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+#include "metavision/utils/gtest/gtest_with_tmp_dir.h"
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/core/algorithms/columnar_logger_algorithm.h"
+#include "metavision/sdk/core/algorithms/file_producer_algorithm.h"
+#include "metavision/sdk/core/utils/columnar_event_file.h"
+
+using namespace Metavision;
+
+class ColumnarEventFile_GTest : public GTestWithTmpDir {
+protected:
+    void SetUp() override {
+        static int file_counter = 0;
+        filename_ = tmpdir_handler_->get_full_path("columnar_" + std::to_string(++file_counter) + ".evt");
+
+        // 100us between two events, with a few identical timestamps
+        for (int i = 0; i < 10000; ++i) {
+            events_.emplace_back(i % 640, i % 480, (i / 3) % 2, 100LL * (i - i % 4) + 17);
+        }
+    }
+
+    void write_file(size_t block_size) {
+        ColumnarEventFileWriter writer(filename_, 640, 480, block_size);
+        writer.write(events_.cbegin(), events_.cend());
+        ASSERT_EQ(events_.size(), writer.get_n_events());
+    }
+
+    void expect_events(size_t first, const EventCDBufferSoA &events) {
+        ASSERT_LE(first + events.size(), events_.size());
+        for (size_t i = 0; i < events.size(); ++i) {
+            ASSERT_EQ(events_[first + i].x, events.x()[i]);
+            ASSERT_EQ(events_[first + i].y, events.y()[i]);
+            ASSERT_EQ(events_[first + i].p, events.p()[i]);
+            ASSERT_EQ(events_[first + i].t, events.t()[i]);
+        }
+    }
+
+    std::string filename_;
+    std::vector<EventCD> events_;
+};
+
+TEST_F(ColumnarEventFile_GTest, round_trip) {
+    // GIVEN a columnar event file with several blocks, the last one being incomplete
+    write_file(1024);
+
+    // WHEN reading it
+    ASSERT_TRUE(ColumnarEventFileReader::is_columnar_event_file(filename_));
+    ColumnarEventFileReader reader(filename_);
+
+    // THEN the header, the blocks and the events are retrieved
+    ASSERT_EQ("640", reader.get_header().get_field("Width"));
+    ASSERT_EQ(events_.size(), reader.get_n_events());
+    ASSERT_EQ(10u, reader.get_blocks().size());
+    ASSERT_EQ(events_.front().t, reader.get_first_timestamp());
+    ASSERT_EQ(events_.back().t, reader.get_last_timestamp());
+
+    EventCDBufferSoA events;
+    for (size_t i = 0; i < reader.get_blocks().size(); ++i) {
+        const auto &block = reader.get_blocks()[i];
+        ASSERT_EQ(i * 1024, block.first_event_);
+        reader.read_block(i, events);
+        ASSERT_EQ(block.n_events_, events.size());
+        ASSERT_EQ(events.t()[0], block.t_min_);
+        ASSERT_EQ(events.t()[events.size() - 1], block.t_max_);
+        expect_events(block.first_event_, events);
+    }
+}
+
+TEST_F(ColumnarEventFile_GTest, timestamps_are_smaller_than_raw_events) {
+    // GIVEN a columnar event file
+    write_file(ColumnarEventFileWriter::DefaultBlockSize);
+
+    // THEN the file is smaller than the DAT events, the timestamps taking less than 2 bytes per event
+    std::ifstream file(filename_, std::ios::binary | std::ios::ate);
+    ASSERT_LT(static_cast<size_t>(file.tellg()), events_.size() * sizeof(EventCD::RawEvent));
+}
+
+TEST_F(ColumnarEventFile_GTest, read_window) {
+    // GIVEN a columnar event file
+    write_file(1000);
+    ColumnarEventFileReader reader(filename_);
+
+    // THEN the blocks of any time are found
+    ASSERT_EQ(0u, reader.find_block(-1));
+    ASSERT_EQ(0u, reader.find_block(events_[999].t));
+    ASSERT_EQ(1u, reader.find_block(events_[999].t + 1));
+    ASSERT_EQ(10u, reader.find_block(events_.back().t + 1));
+
+    // WHEN reading time windows
+    // THEN their events are read
+    EventCDBufferSoA events;
+    reader.read_window(events_[2500].t, events_[7500].t, events);
+    ASSERT_EQ(5000u, events.size());
+    expect_events(2500, events);
+
+    reader.read_window(events_.back().t + 1, events_.back().t + 1000, events);
+    ASSERT_EQ(0u, events.size());
+}
+
+TEST_F(ColumnarEventFile_GTest, unclosed_file_throws) {
+    // GIVEN a columnar event file whose footer has not been written
+    write_file(1000);
+    std::vector<char> content;
+    {
+        std::ifstream ifs(filename_, std::ios::binary);
+        content.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+    }
+    {
+        std::ofstream ofs(filename_, std::ios::binary);
+        ofs.write(content.data(), content.size() - 10);
+    }
+
+    // THEN it can not be read
+    ASSERT_TRUE(ColumnarEventFileReader::is_columnar_event_file(filename_));
+    ASSERT_THROW(ColumnarEventFileReader reader(filename_), std::runtime_error);
+}
+
+TEST_F(ColumnarEventFile_GTest, logger_algorithm) {
+    // GIVEN a logger writing buffers of events, enabled after the first buffer
+    ColumnarLoggerAlgorithm logger(filename_, 640, 480, 1000);
+    logger.process_events(events_.cbegin(), events_.cbegin() + 1000, events_[1000].t);
+    logger.enable(true);
+    logger.process_events(events_.cbegin() + 1000, events_.cend(), events_.back().t);
+    logger.enable(false);
+
+    // THEN the events logged are read back, relatively to the time the logger was enabled
+    ColumnarEventFileReader reader(filename_);
+    ASSERT_EQ(9000u, reader.get_n_events());
+    EventCDBufferSoA events;
+    reader.read_block(0, events);
+    ASSERT_EQ(events_[1000].t - events_[1000].t, events.t()[0]);
+    ASSERT_EQ(events_[1999].t - events_[1000].t, events.t()[999]);
+}
+
+TEST_F(ColumnarEventFile_GTest, file_producer) {
+    // GIVEN a file producer reading a columnar event file
+    write_file(1000);
+    FileProducerAlgorithmT<EventCD> producer(filename_);
+    ASSERT_EQ(640, producer.get_width());
+    ASSERT_EQ(events_.size(), producer.get_n_tot_ev());
+    ASSERT_EQ(events_.back().t, producer.get_time_at(0, true));
+
+    // WHEN playing the beginning of the file
+    std::vector<EventCD> output;
+    producer.process_events(std::back_inserter(output), events_[1500].t);
+
+    // THEN the events are played in order
+    ASSERT_EQ(1500u, output.size());
+    for (size_t i = 0; i < output.size(); ++i) {
+        ASSERT_EQ(events_[i].t, output[i].t);
+        ASSERT_EQ(events_[i].x, output[i].x);
+    }
+
+    // WHEN starting at a given time
+    const timestamp start_time = events_[6001].t;
+    producer.start_at_time(start_time);
+    output.clear();
+    producer.process_events(std::back_inserter(output), 100000);
+
+    // THEN the events are played from this time, relatively to it
+    ASSERT_EQ(1000u, output.size());
+    for (size_t i = 0; i < output.size(); ++i) {
+        ASSERT_EQ(events_[6000 + i].t - start_time, output[i].t);
+        ASSERT_EQ(events_[6000 + i].y, output[i].y);
+    }
+
+    // WHEN reading a time window
+    output.clear();
+    producer.read_window(events_[10].t, events_[3010].t, std::back_inserter(output));
+
+    // THEN the events of the window are read, with their timestamps as recorded
+    ASSERT_EQ(3000u, output.size());
+    ASSERT_EQ(events_[8].t, output.front().t);
+}
+
+TEST_F(ColumnarEventFile_GTest, file_producer_loop) {
+    // GIVEN a file producer looping over a columnar event file
+    write_file(1000);
+    FileProducerAlgorithmT<EventCD>::reset_max_loop_length();
+    FileProducerAlgorithmT<EventCD> producer(filename_, true);
+
+    // WHEN playing the file for more than two loops
+    std::vector<EventCD> output;
+    producer.process_events(std::back_inserter(output), 2500000);
+
+    // THEN the events are played again after the end of the file, with increasing timestamps
+    ASSERT_GT(output.size(), 2 * events_.size());
+    for (size_t i = 0; i < output.size(); ++i) {
+        ASSERT_EQ(events_[i % events_.size()].x, output[i].x);
+        if (i > 0) {
+            ASSERT_LE(output[i - 1].t, output[i].t);
+        }
+    }
+}
@@ -0,0 +1,125 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include <opencv2/core.hpp>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/core/algorithms/concurrent_frame_generation_algorithm.h"
+
+using namespace Metavision;
+
+namespace {
+std::vector<EventCD> make_random_events(int width, int height, timestamp duration) {
+    std::mt19937 gen(42);
+    std::vector<EventCD> events;
+    for (timestamp t = 0; t < duration; ++t) {
+        events.emplace_back(gen() % width, gen() % height, gen() % 2, t);
+    }
+    return events;
+}
+} // namespace
+
+TEST(ConcurrentFrameGenerationAlgorithm_GTest, frames_match_events) {
+    // GIVEN random events
+    const int width = 64, height = 48;
+    const uint32_t accumulation_time_us = 1000;
+    const auto events                   = make_random_events(width, height, 5000);
+
+    for (const auto palette : {ColorPalette::Dark, ColorPalette::Gray}) {
+        ConcurrentFrameGenerationAlgorithm frame_generation(width, height, accumulation_time_us, palette);
+        ASSERT_EQ(-1, frame_generation.get_last_processed_timestamp());
+
+        // WHEN processing them and generating a frame at the last one
+        frame_generation.process_events(events.cbegin(), events.cend());
+        ASSERT_EQ(events.back().t, frame_generation.get_last_processed_timestamp());
+        cv::Mat frame;
+        frame_generation.generate(events.back().t, frame);
+
+        // THEN the frame is the one of the events of the accumulation time
+        cv::Mat expected(height, width, frame.type());
+        const auto begin = std::find_if(events.cbegin(), events.cend(), [&](const EventCD &ev) {
+            return ev.t > events.back().t - accumulation_time_us;
+        });
+        BaseFrameGenerationAlgorithm::generate_frame_from_events(begin, events.cend(), expected, 0, palette);
+        ASSERT_EQ(0, cv::norm(expected, frame, cv::NORM_INF));
+    }
+}
+
+TEST(ConcurrentFrameGenerationAlgorithm_GTest, frames_before_first_events_are_empty) {
+    // GIVEN an algorithm that has processed no events
+    ConcurrentFrameGenerationAlgorithm frame_generation(8, 4, 100);
+
+    // WHEN generating a frame at the beginning of the stream
+    cv::Mat frame;
+    frame_generation.generate(0, frame);
+
+    // THEN the frame only has the background color
+    cv::Mat expected(4, 8, CV_8UC3, BaseFrameGenerationAlgorithm::bg_color_default());
+    ASSERT_EQ(0, cv::norm(expected, frame, cv::NORM_INF));
+
+    // WHEN setting an accumulation time of 0
+    // THEN it throws
+    ASSERT_THROW(frame_generation.set_accumulation_time_us(0), std::invalid_argument);
+}
+
+TEST(ConcurrentFrameGenerationAlgorithm_GTest, concurrent_generation) {
+    // GIVEN random events processed by buffers on a thread
+    const int width = 64, height = 48;
+    const auto events = make_random_events(width, height, 20000);
+    ConcurrentFrameGenerationAlgorithm frame_generation(width, height, 1000);
+
+    const int n_rendering_threads = 2;
+    std::atomic<int> n_rendering_threads_started{0};
+    std::atomic<bool> done{false};
+    std::thread processing_thread([&] {
+        for (size_t i = 0; i < events.size(); i += 100) {
+            frame_generation.process_events(events.cbegin() + i, events.cbegin() + std::min(i + 100, events.size()));
+        }
+        // Each rendering thread generates at least one frame, even if it is only scheduled after the processing
+        while (n_rendering_threads_started < n_rendering_threads) {
+            std::this_thread::yield();
+        }
+        done = true;
+    });
+
+    // WHEN generating frames on other threads at the same time
+    std::vector<std::thread> rendering_threads;
+    std::atomic<int> n_frames{0};
+    for (int i = 0; i < n_rendering_threads; ++i) {
+        rendering_threads.emplace_back([&] {
+            cv::Mat frame;
+            frame_generation.generate(frame_generation.get_last_processed_timestamp(), frame);
+            ++n_frames;
+            ++n_rendering_threads_started;
+            while (!done) {
+                frame_generation.generate(frame_generation.get_last_processed_timestamp(), frame);
+                ++n_frames;
+            }
+        });
+    }
+    processing_thread.join();
+    for (auto &thread : rendering_threads) {
+        thread.join();
+    }
+
+    // THEN the frame generated after the processing is the one of the last events
+    cv::Mat frame, expected(height, width, CV_8UC3);
+    frame_generation.generate(events.back().t, frame);
+    BaseFrameGenerationAlgorithm::generate_frame_from_events(events.cend() - 1000, events.cend(), expected);
+    ASSERT_EQ(0, cv::norm(expected, frame, cv::NORM_INF));
+    ASSERT_LT(0, n_frames);
+}
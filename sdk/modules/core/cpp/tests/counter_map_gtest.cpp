@@ -9,6 +9,9 @@
  * See the License for the specific language governing permissions and limitations under the License.                 *
  **********************************************************************************************************************/
 
+#include <cstdint>
+#include <thread>
+#include <vector>
 #include <gtest/gtest.h>
 
 #include "metavision/sdk/core/utils/counter_map.h"
@@ -66,4 +69,47 @@ TEST_F(CounterMap_GTest, tag_untag) {
     ASSERT_EQ(0, counter_map_.tag_count(RANDOMKEY));
 }
 
+TEST(CounterMap8Bits_GTest, tag_untag) {
+    CounterMap<uint8_t> counter_map;
+    for (int key = 0; key < 256; ++key) {
+        ASSERT_EQ(0, counter_map.tag_count(static_cast<uint8_t>(key)));
+    }
+
+    ASSERT_EQ(1, counter_map.tag(0));
+    ASSERT_EQ(1, counter_map.tag(255));
+    ASSERT_EQ(2, counter_map.tag(255));
+    ASSERT_EQ(1, counter_map.tag_count(0));
+    ASSERT_EQ(2, counter_map.tag_count(255));
+
+    // decrease twice. First time goes from 1 to 0, second time remains at 0
+    ASSERT_EQ(0, counter_map.untag(0));
+    ASSERT_EQ(0, counter_map.untag(0));
+    ASSERT_EQ(0, counter_map.tag_count(0));
+    ASSERT_EQ(1, counter_map.untag(255));
+    ASSERT_EQ(1, counter_map.tag_count(255));
+}
+
+TEST(CounterMap8Bits_GTest, concurrent_tag_untag) {
+    CounterMap<uint8_t> counter_map;
+    const int n_threads = 4, n_tags = 10000;
+
+    // WHEN tagging and untagging the same key from several threads
+    std::vector<std::thread> threads;
+    for (int i = 0; i < n_threads; ++i) {
+        threads.emplace_back([&counter_map]() {
+            for (int j = 0; j < n_tags; ++j) {
+                counter_map.tag(3);
+                counter_map.tag(3);
+                counter_map.untag(3);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    // THEN no update is lost
+    ASSERT_EQ(n_threads * n_tags, counter_map.tag_count(3));
+}
+
 } // namespace Metavision
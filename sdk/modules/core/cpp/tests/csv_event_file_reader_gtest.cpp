@@ -0,0 +1,157 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <atomic>
+#include <fstream>
+#include <limits>
+#include <vector>
+#include <boost/any.hpp>
+
+#include "metavision/utils/gtest/gtest_with_tmp_dir.h"
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/core/pipeline/csv_reading_stage.h"
+#include "metavision/sdk/core/pipeline/pipeline.h"
+#include "metavision/sdk/core/pipeline/stage.h"
+#include "metavision/sdk/core/utils/csv_event_file_reader.h"
+#include "metavision/sdk/core/utils/csv_event_file_writer.h"
+
+using namespace Metavision;
+
+class CSVEventFileReader_GTest : public GTestWithTmpDir {
+protected:
+    void SetUp() override {
+        static int file_counter = 0;
+        filename_ = tmpdir_handler_->get_full_path("events_" + std::to_string(++file_counter) + ".csv");
+
+        events_.emplace_back(std::numeric_limits<unsigned short>::max(), 1, -1, -123456789);
+        events_.emplace_back(9, 10, std::numeric_limits<short>::min(), std::numeric_limits<timestamp>::max());
+        events_.emplace_back(99, 100, 1, std::numeric_limits<timestamp>::min());
+        for (int i = 0; i < 10000; ++i) {
+            events_.emplace_back(i % 640, i % 480, (i / 3) % 2, 97LL * i * i + 5);
+        }
+    }
+
+    void write_file() {
+        CSVEventFileWriter writer(filename_, 2, 1000);
+        writer.write(events_.cbegin(), events_.cend());
+    }
+
+    std::vector<EventCD> read_file(CSVEventFileReader &reader) {
+        std::vector<EventCD> events, chunk;
+        while (reader.read(chunk)) {
+            events.insert(events.end(), chunk.cbegin(), chunk.cend());
+        }
+        return events;
+    }
+
+    void expect_events(const std::vector<EventCD> &events) {
+        ASSERT_EQ(events_.size(), events.size());
+        for (size_t i = 0; i < events.size(); ++i) {
+            ASSERT_EQ(events_[i].x, events[i].x);
+            ASSERT_EQ(events_[i].y, events[i].y);
+            ASSERT_EQ(events_[i].p, events[i].p);
+            ASSERT_EQ(events_[i].t, events[i].t);
+        }
+    }
+
+    std::string filename_;
+    std::vector<EventCD> events_;
+};
+
+TEST_F(CSVEventFileReader_GTest, round_trip) {
+    // GIVEN a CSV file written by the CSV writer
+    write_file();
+
+    // WHEN reading it in small chunks on several threads
+    CSVEventFileReader reader(filename_, 3, 1000);
+    const auto events = read_file(reader);
+
+    // THEN the events are read in order
+    expect_events(events);
+    ASSERT_EQ(events_.size(), reader.get_n_events());
+    ASSERT_EQ(0u, reader.get_n_invalid_lines());
+    ASSERT_EQ(reader.get_size(), reader.get_n_bytes_read());
+}
+
+TEST_F(CSVEventFileReader_GTest, chunks_larger_than_file) {
+    // GIVEN a CSV file written by the CSV writer
+    write_file();
+
+    // WHEN reading it in a single chunk
+    CSVEventFileReader reader(filename_, 1);
+    const auto events = read_file(reader);
+
+    // THEN the events are read in order
+    expect_events(events);
+}
+
+TEST_F(CSVEventFileReader_GTest, invalid_lines) {
+    // GIVEN a CSV file with a header, windows ends of line, empty lines, invalid lines and no final end of line
+    {
+        std::ofstream ofs(filename_, std::ios::binary);
+        ofs << "x,y,p,t\r\n"
+            << "1,2,1,100\r\n"
+            << "\r\n"
+            << "\n"
+            << "3,4,0,-5\n"
+            << "65536,4,0,5\n"                // x overflow
+            << "3,4,0,5,6\n"                  // too many fields
+            << "3,4,0\n"                      // too few fields
+            << "3, 4,0,5\n"                   // space
+            << "-3,4,0,5\n"                   // negative x
+            << "1,1,1,99999999999999999999\n" // t overflow
+            << "7,8,1,200";
+    }
+
+    // WHEN reading it with chunks of a few lines
+    CSVEventFileReader reader(filename_, 2, 16);
+    const auto events = read_file(reader);
+
+    // THEN only the valid lines are read, the other non empty lines being counted
+    ASSERT_EQ(3u, events.size());
+    ASSERT_EQ(2, events[0].y);
+    ASSERT_EQ(100, events[0].t);
+    ASSERT_EQ(-5, events[1].t);
+    ASSERT_EQ(7, events[2].x);
+    ASSERT_EQ(200, events[2].t);
+    ASSERT_EQ(7u, reader.get_n_invalid_lines());
+}
+
+TEST_F(CSVEventFileReader_GTest, empty_file) {
+    { std::ofstream ofs(filename_); }
+    CSVEventFileReader reader(filename_);
+    std::vector<EventCD> events;
+    ASSERT_FALSE(reader.read(events));
+    ASSERT_EQ(0u, reader.get_size());
+}
+
+TEST_F(CSVEventFileReader_GTest, invalid_file) {
+    ASSERT_THROW(CSVEventFileReader(tmpdir_handler_->get_full_path("missing.csv")), std::runtime_error);
+}
+
+TEST_F(CSVEventFileReader_GTest, stage) {
+    // GIVEN a pipeline reading a CSV file
+    write_file();
+    std::vector<EventCD> events;
+    Pipeline p(true);
+    auto &reading_stage = p.add_stage(std::make_unique<CSVReadingStage>(filename_, 2));
+    auto &consuming_stage = p.add_stage(std::make_unique<Stage>(), reading_stage);
+    consuming_stage.set_consuming_callback([&events](const boost::any &data) {
+        auto buffer = boost::any_cast<Stage::EventBufferPtr>(data);
+        events.insert(events.end(), buffer->cbegin(), buffer->cend());
+    });
+
+    // WHEN running it
+    p.run();
+
+    // THEN the events of the file are produced in order
+    expect_events(events);
+}
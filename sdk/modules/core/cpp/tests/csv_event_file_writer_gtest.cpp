@@ -0,0 +1,140 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <atomic>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "metavision/utils/gtest/gtest_with_tmp_dir.h"
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/core/pipeline/csv_writing_stage.h"
+#include "metavision/sdk/core/pipeline/pipeline.h"
+#include "metavision/sdk/core/utils/csv_event_file_writer.h"
+
+using namespace Metavision;
+
+class CSVEventFileWriter_GTest : public GTestWithTmpDir {
+protected:
+    void SetUp() override {
+        static int file_counter = 0;
+        filename_ = tmpdir_handler_->get_full_path("events_" + std::to_string(++file_counter) + ".csv");
+
+        // Values of all the widths, including the extreme ones
+        events_.emplace_back(0, 0, 0, 0);
+        events_.emplace_back(std::numeric_limits<unsigned short>::max(), 1, -1, -123456789);
+        events_.emplace_back(9, 10, std::numeric_limits<short>::min(), std::numeric_limits<timestamp>::max());
+        events_.emplace_back(99, 100, 1, std::numeric_limits<timestamp>::min());
+        for (int i = 0; i < 10000; ++i) {
+            events_.emplace_back(i % 640, i % 480, (i / 3) % 2, 97LL * i * i + 5);
+        }
+    }
+
+    std::string expected_text() const {
+        std::ostringstream oss;
+        for (const auto &ev : events_) {
+            oss << ev.x << "," << ev.y << "," << ev.p << "," << ev.t << "\n";
+        }
+        return oss.str();
+    }
+
+    std::string read_text() const {
+        std::ifstream ifs(filename_, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+    }
+
+    std::string filename_;
+    std::vector<EventCD> events_;
+};
+
+namespace {
+struct MockProducingStage : public BaseStage {
+    MockProducingStage(const std::vector<EventCD> &events, size_t buffer_size) :
+        events(events), buffer_size(buffer_size) {
+        set_starting_callback([this] {
+            thread = std::thread([this] {
+                for (size_t i = 0; i < this->events.size() && !stopped; i += this->buffer_size) {
+                    auto buffer = pool.acquire();
+                    buffer->assign(this->events.cbegin() + i,
+                                   this->events.cbegin() + std::min(i + this->buffer_size, this->events.size()));
+                    produce(buffer);
+                }
+                if (!stopped)
+                    complete();
+            });
+        });
+        set_stopping_callback([this] {
+            stopped = true;
+            if (thread.joinable()) {
+                thread.join();
+            }
+        });
+    }
+
+    std::thread thread;
+    std::atomic<bool> stopped{false};
+    const std::vector<EventCD> &events;
+    const size_t buffer_size;
+    EventBufferPool pool;
+};
+} // namespace
+
+TEST_F(CSVEventFileWriter_GTest, write_in_order) {
+    // GIVEN a writer formatting small chunks on several threads
+    CSVEventFileWriter writer(filename_, 4, 100);
+
+    // WHEN writing the events with calls of various sizes, not aligned on the chunks
+    size_t first = 0;
+    for (size_t n = 1; first < events_.size(); n = n * 3 + 1) {
+        const size_t last = std::min(first + n, events_.size());
+        writer.write(events_.cbegin() + first, events_.cbegin() + last);
+        first = last;
+    }
+    ASSERT_EQ(events_.size(), writer.get_n_events());
+    writer.close();
+
+    // THEN the file holds the lines of the events in order, formatted as with iostreams
+    ASSERT_EQ(expected_text(), read_text());
+}
+
+TEST_F(CSVEventFileWriter_GTest, flush) {
+    // GIVEN a writer with a single thread, and chunks larger than the events written
+    CSVEventFileWriter writer(filename_, 1);
+    writer.write(events_.cbegin(), events_.cend());
+
+    // WHEN flushing it
+    writer.flush();
+
+    // THEN the pending events are written to the file, which is still open
+    ASSERT_EQ(expected_text(), read_text());
+    writer.write(events_.cbegin(), events_.cbegin() + 1);
+    writer.close();
+    ASSERT_EQ(expected_text() + "0,0,0,0\n", read_text());
+}
+
+TEST_F(CSVEventFileWriter_GTest, invalid_file) {
+    ASSERT_THROW(CSVEventFileWriter(tmpdir_handler_->get_full_path("missing_dir/events.csv")), std::runtime_error);
+}
+
+TEST_F(CSVEventFileWriter_GTest, stage) {
+    // GIVEN a pipeline producing the events to a CSV writing stage
+    Pipeline p(true);
+    auto &prod_stage = p.add_stage(std::make_unique<MockProducingStage>(events_, 333));
+    p.add_stage(std::make_unique<CSVWritingStage>(filename_, 2), prod_stage);
+
+    // WHEN running it
+    p.run();
+
+    // THEN the file is complete once the pipeline is done
+    ASSERT_EQ(expected_text(), read_text());
+}
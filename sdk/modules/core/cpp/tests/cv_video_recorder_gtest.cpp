@@ -0,0 +1,133 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <fstream>
+#include <iterator>
+#include <thread>
+#include <vector>
+#include <opencv2/core.hpp>
+
+#include "metavision/utils/gtest/gtest_with_tmp_dir.h"
+#include "metavision/sdk/core/utils/cv_video_recorder.h"
+
+using namespace Metavision;
+
+class CvVideoRecorder_GTest : public GTestWithTmpDir {
+protected:
+    // Reads the content of a video file
+    std::vector<char> read_file(const std::string &filename) {
+        std::ifstream ifs(filename, std::ios::binary);
+        return std::vector<char>(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+    }
+
+    const cv::Size size_{64, 48};
+    const int fourcc_   = cv::VideoWriter::fourcc('M', 'J', 'P', 'G');
+    const int n_frames_ = 100;
+};
+
+TEST_F(CvVideoRecorder_GTest, pooled_frames_write_same_video_as_copies) {
+    const std::string copy_filename   = tmpdir_handler_->get_full_path("copy.avi");
+    const std::string pooled_filename = tmpdir_handler_->get_full_path("pooled.avi");
+
+    // GIVEN the same frames written by copy, and by reference from a pool
+    {
+        CvVideoRecorder recorder(copy_filename, fourcc_, 30, size_, true, {}, 2);
+        ASSERT_TRUE(recorder.start());
+        cv::Mat frame(size_.height, size_.width, CV_8UC3);
+        for (int i = 0; i < n_frames_; ++i) {
+            frame.setTo(cv::Scalar(i, 2 * i, 3 * i));
+            recorder.write(frame);
+        }
+        recorder.stop();
+        ASSERT_EQ(0u, recorder.get_n_dropped_frames());
+    }
+
+    auto frame_pool = CvVideoRecorder::FramePool::make_bounded(3);
+    {
+        CvVideoRecorder recorder(pooled_filename, fourcc_, 30, size_, true, {}, 2);
+        ASSERT_TRUE(recorder.start());
+        for (int i = 0; i < n_frames_; ++i) {
+            auto frame = frame_pool.acquire();
+            frame->create(size_.height, size_.width, CV_8UC3);
+            frame->setTo(cv::Scalar(i, 2 * i, 3 * i));
+            recorder.write(frame);
+        }
+        recorder.stop();
+        ASSERT_EQ(0u, recorder.get_n_dropped_frames());
+    }
+
+    // THEN the videos are the same, and the frames are back in their pool once encoded
+    const auto copy_video = read_file(copy_filename);
+    ASSERT_FALSE(copy_video.empty());
+    ASSERT_EQ(copy_video, read_file(pooled_filename));
+    ASSERT_EQ(3u, frame_pool.size());
+}
+
+TEST_F(CvVideoRecorder_GTest, drops_frames_when_queue_is_full) {
+    const std::string filename = tmpdir_handler_->get_full_path("drop.avi");
+
+    // GIVEN frames written faster than they are encoded, with a queue of one frame dropping the frames
+    CvVideoRecorder recorder(filename, fourcc_, 30, size_, true, {}, 1, CvVideoRecorder::QueuePolicy::Drop);
+    ASSERT_TRUE(recorder.start());
+    cv::Mat frame(size_.height, size_.width, CV_8UC3, cv::Scalar(0, 0, 0));
+    for (int i = 0; i < n_frames_; ++i) {
+        recorder.write(frame);
+    }
+    recorder.stop();
+
+    // THEN the video is written, and at most all the frames but the first one are dropped
+    ASSERT_FALSE(read_file(filename).empty());
+    ASSERT_LT(recorder.get_n_dropped_frames(), static_cast<std::size_t>(n_frames_));
+}
+
+TEST_F(CvVideoRecorder_GTest, concurrent_writers_drop_frames_when_queue_is_full) {
+    const std::string filename = tmpdir_handler_->get_full_path("concurrent_drop.avi");
+    const int n_writers        = 4;
+
+    // GIVEN several threads writing frames faster than they are encoded, with a queue of one frame dropping the frames
+    CvVideoRecorder recorder(filename, fourcc_, 30, size_, true, {}, 1, CvVideoRecorder::QueuePolicy::Drop);
+    ASSERT_TRUE(recorder.start());
+    std::vector<std::thread> writers;
+    for (int w = 0; w < n_writers; ++w) {
+        writers.emplace_back([&]() {
+            cv::Mat frame(size_.height, size_.width, CV_8UC3, cv::Scalar(0, 0, 0));
+            for (int i = 0; i < n_frames_; ++i) {
+                recorder.write(frame);
+            }
+        });
+    }
+
+    // WHEN all the frames have been written
+    for (auto &writer : writers) {
+        writer.join();
+    }
+    recorder.stop();
+
+    // THEN the video is written, and at most all the frames but the first one are dropped
+    ASSERT_FALSE(read_file(filename).empty());
+    ASSERT_LT(recorder.get_n_dropped_frames(), static_cast<std::size_t>(n_writers * n_frames_));
+}
+
+TEST_F(CvVideoRecorder_GTest, frames_written_while_stopped_are_ignored) {
+    const std::string filename = tmpdir_handler_->get_full_path("stopped.avi");
+    auto frame_pool            = CvVideoRecorder::FramePool::make_bounded(1);
+
+    // GIVEN a recorder that is not started
+    CvVideoRecorder recorder(filename, fourcc_, 30, size_, true);
+    ASSERT_FALSE(recorder.is_recording());
+
+    // WHEN writing a frame of a pool
+    recorder.write(frame_pool.acquire());
+
+    // THEN the frame is not referenced by the recorder
+    ASSERT_EQ(1u, frame_pool.size());
+    ASSERT_EQ(0u, recorder.get_n_dropped_frames());
+}
@@ -0,0 +1,145 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "metavision/sdk/core/algorithms/downsampling_algorithm.h"
+
+using namespace Metavision;
+
+namespace {
+
+std::vector<EventCD> make_events(int width, int height, size_t n) {
+    std::vector<EventCD> events;
+    for (size_t i = 0; i < n; ++i) {
+        // Some of the events are outside the sensor
+        events.emplace_back(static_cast<unsigned short>((i * 37) % (width + 8)),
+                            static_cast<unsigned short>((i * 11) % (height + 4)), static_cast<short>(i % 3 == 0),
+                            static_cast<timestamp>(1000 + 3 * i));
+    }
+    return events;
+}
+
+void expect_same_events(const std::vector<EventCD> &expected, const std::vector<EventCD> &actual) {
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(expected[i].x, actual[i].x);
+        EXPECT_EQ(expected[i].y, actual[i].y);
+        EXPECT_EQ(expected[i].p, actual[i].p);
+        EXPECT_EQ(expected[i].t, actual[i].t);
+    }
+}
+
+} // namespace
+
+TEST(DownsamplingAlgorithm_GTest, output_geometry) {
+    DownsamplingAlgorithm algo(640, 480, 4);
+    EXPECT_EQ(4, algo.get_factor());
+    EXPECT_EQ(160, algo.get_output_width());
+    EXPECT_EQ(120, algo.get_output_height());
+
+    DownsamplingAlgorithm algo_odd(641, 481, 8);
+    EXPECT_EQ(81, algo_odd.get_output_width());
+    EXPECT_EQ(61, algo_odd.get_output_height());
+}
+
+TEST(DownsamplingAlgorithm_GTest, invalid_arguments) {
+    EXPECT_THROW(DownsamplingAlgorithm(0, 480, 2), std::invalid_argument);
+    EXPECT_THROW(DownsamplingAlgorithm(640, -1, 2), std::invalid_argument);
+    EXPECT_THROW(DownsamplingAlgorithm(640, 480, 0), std::invalid_argument);
+    EXPECT_THROW(DownsamplingAlgorithm(640, 480, 3), std::invalid_argument);
+    EXPECT_THROW(DownsamplingAlgorithm(640, 480, 2, -1), std::invalid_argument);
+
+    DownsamplingAlgorithm algo(640, 480, 2);
+    EXPECT_THROW(algo.set_refractory_period(-10), std::invalid_argument);
+    EXPECT_EQ(0, algo.get_refractory_period());
+}
+
+TEST(DownsamplingAlgorithm_GTest, divides_coordinates_and_drops_events_outside_the_sensor) {
+    DownsamplingAlgorithm algo(10, 6, 2);
+    const std::vector<EventCD> input = {{0, 0, 0, 10}, {9, 5, 1, 11}, {10, 2, 1, 12}, {3, 6, 0, 13}, {7, 3, 0, 14}};
+
+    std::vector<EventCD> output;
+    algo.process_events(input.cbegin(), input.cend(), std::back_inserter(output));
+    expect_same_events({{0, 0, 0, 10}, {4, 2, 1, 11}, {3, 1, 0, 14}}, output);
+}
+
+TEST(DownsamplingAlgorithm_GTest, refractory_period_per_bin_and_polarity) {
+    DownsamplingAlgorithm algo(8, 8, 4, 100);
+    const std::vector<EventCD> input = {
+        {0, 0, 1, 0},   // kept
+        {3, 3, 1, 50},  // same bin and polarity, dropped
+        {1, 2, 0, 60},  // other polarity, kept
+        {4, 0, 1, 70},  // other bin, kept
+        {2, 1, 1, 99},  // dropped
+        {2, 1, 1, 100}, // kept, the period has elapsed
+    };
+
+    std::vector<EventCD> output;
+    algo.process_events(input.cbegin(), input.cend(), std::back_inserter(output));
+    expect_same_events({{0, 0, 1, 0}, {0, 0, 0, 60}, {1, 0, 1, 70}, {0, 0, 1, 100}}, output);
+
+    // The state is kept between the calls, until reset
+    const std::vector<EventCD> next = {{0, 0, 1, 150}};
+    output.clear();
+    algo.process_events(next.cbegin(), next.cend(), std::back_inserter(output));
+    EXPECT_TRUE(output.empty());
+
+    algo.reset();
+    algo.process_events(next.cbegin(), next.cend(), std::back_inserter(output));
+    expect_same_events(next, output);
+}
+
+TEST(DownsamplingAlgorithm_GTest, buffers_give_same_events_as_iterators) {
+    const int width = 100, height = 60;
+    const auto input = make_events(width, height, 5000);
+
+    for (int factor : {1, 2, 4, 8}) {
+        for (timestamp refractory_period : {0, 20}) {
+            DownsamplingAlgorithm algo_ref(width, height, factor, refractory_period);
+            std::vector<EventCD> expected;
+            algo_ref.process_events(input.cbegin(), input.cend(), std::back_inserter(expected));
+
+            DownsamplingAlgorithm algo_soa(width, height, factor, refractory_period);
+            EventCDBufferSoA soa_input, soa_output;
+            soa_input.assign(input.cbegin(), input.cend());
+            algo_soa.process_events(soa_input, soa_output);
+            std::vector<EventCD> actual;
+            soa_output.copy_to(std::back_inserter(actual));
+            expect_same_events(expected, actual);
+
+            // In place
+            algo_soa.reset();
+            algo_soa.process_events(soa_input, soa_input);
+            actual.clear();
+            soa_input.copy_to(std::back_inserter(actual));
+            expect_same_events(expected, actual);
+
+            DownsamplingAlgorithm algo_compact(width, height, factor, refractory_period);
+            EventCDCompactBuffer compact_input, compact_output;
+            compact_input.assign(input.cbegin(), input.cend());
+            algo_compact.process_events(compact_input, compact_output);
+            EXPECT_EQ(compact_input.base_time(), compact_output.base_time());
+            actual.clear();
+            compact_output.copy_to(std::back_inserter(actual));
+            expect_same_events(expected, actual);
+
+            algo_compact.reset();
+            algo_compact.process_events(compact_input, compact_input);
+            actual.clear();
+            compact_input.copy_to(std::back_inserter(actual));
+            expect_same_events(expected, actual);
+        }
+    }
+}
@@ -0,0 +1,150 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <functional>
+#include <vector>
+#include <boost/any.hpp>
+#include <gtest/gtest.h>
+
+#include "metavision/sdk/core/pipeline/pipeline.h"
+#include "metavision/sdk/core/pipeline/event_merging_stage.h"
+
+using namespace Metavision;
+
+namespace {
+
+// Produces buffers of events when started, as a camera stage would
+struct MockProducingStage : public BaseStage {
+    MockProducingStage(const std::vector<std::vector<EventCD>> &buffers, bool completes = true) :
+        pool(EventBufferPool::make_unbounded()) {
+        set_starting_callback([this, buffers, completes] {
+            for (const auto &events : buffers) {
+                auto buffer = pool.acquire();
+                buffer->assign(events.begin(), events.end());
+                produce(buffer);
+            }
+            if (completes) {
+                complete();
+            }
+        });
+    }
+
+    EventBufferPool pool;
+};
+
+struct MockConsumingStage : public BaseStage {
+    MockConsumingStage(std::vector<EventMergingStage::MergedBufferPtr> &buffers) {
+        set_consuming_callback([&buffers](const boost::any &data) {
+            buffers.push_back(boost::any_cast<EventMergingStage::MergedBufferPtr>(data));
+        });
+    }
+};
+
+std::vector<EventCD> make_events(std::initializer_list<timestamp> ts, unsigned short x) {
+    std::vector<EventCD> events;
+    for (auto t : ts) {
+        events.emplace_back(x, 0, 0, t);
+    }
+    return events;
+}
+
+} // namespace
+
+TEST(EventMergingStage_GTest, merges_sources_by_timestamp) {
+    // GIVEN three sources producing sorted buffers of events, with timestamps in common
+    Pipeline p;
+    auto &s1 = p.add_stage(std::make_unique<MockProducingStage>(std::vector<std::vector<EventCD>>{
+        make_events({0, 10, 20}, 1), make_events({20, 30, 60}, 1)}));
+    auto &s2 = p.add_stage(std::make_unique<MockProducingStage>(std::vector<std::vector<EventCD>>{
+        make_events({5, 20}, 2), make_events({}, 2), make_events({25, 70}, 2)}));
+    auto &s3 = p.add_stage(std::make_unique<MockProducingStage>(
+        std::vector<std::vector<EventCD>>{make_events({20, 40, 50, 80, 90}, 0)}));
+    auto &merging_stage = p.add_stage(std::make_unique<EventMergingStage>(
+        std::vector<std::reference_wrapper<BaseStage>>{s3, s1, s2}));
+    std::vector<EventMergingStage::MergedBufferPtr> buffers;
+    p.add_stage(std::make_unique<MockConsumingStage>(buffers), merging_stage);
+
+    // WHEN running the pipeline until the end of the events
+    p.run();
+
+    // THEN all the events are produced sorted by timestamp, then by source index
+    std::vector<timestamp> ts;
+    std::vector<uint16_t> indices;
+    for (const auto &buffer : buffers) {
+        ASSERT_FALSE(buffer->events.empty());
+        ASSERT_EQ(buffer->events.size(), buffer->source_indices.size());
+        for (size_t i = 0; i < buffer->events.size(); ++i) {
+            ts.push_back(buffer->events[i].t);
+            indices.push_back(buffer->source_indices[i]);
+            // the x coordinate of the events gives the index of their source
+            EXPECT_EQ(buffer->events[i].x, buffer->source_indices[i]);
+        }
+    }
+    EXPECT_EQ(std::vector<timestamp>({0, 5, 10, 20, 20, 20, 20, 25, 30, 40, 50, 60, 70, 80, 90}), ts);
+    EXPECT_EQ(std::vector<uint16_t>({1, 2, 1, 0, 1, 1, 2, 2, 1, 0, 0, 1, 2, 0, 0}), indices);
+    EXPECT_EQ(0, merging_stage.num_late_events());
+}
+
+TEST(EventMergingStage_GTest, waits_for_all_sources_without_latency_bound) {
+    // GIVEN a source that produces events and another one that does not produce any yet
+    Pipeline p;
+    auto &s1 = p.add_stage(std::make_unique<MockProducingStage>(
+        std::vector<std::vector<EventCD>>{make_events({0, 100, 200, 300}, 0)}, false));
+    auto &s2 = p.add_stage(std::make_unique<MockProducingStage>(std::vector<std::vector<EventCD>>{}, false));
+    auto &merging_stage = p.add_stage(std::make_unique<EventMergingStage>());
+    EXPECT_EQ(0, merging_stage.add_source(s1));
+    EXPECT_EQ(1, merging_stage.add_source(s2));
+    std::vector<EventMergingStage::MergedBufferPtr> buffers;
+    p.add_stage(std::make_unique<MockConsumingStage>(buffers), merging_stage);
+
+    // WHEN the events are consumed
+    p.step();
+    p.step();
+
+    // THEN nothing is produced until the other source produces events
+    EXPECT_TRUE(buffers.empty());
+    p.cancel();
+    p.run();
+}
+
+TEST(EventMergingStage_GTest, bounds_the_latency) {
+    // GIVEN a source lagging behind another one by more than the maximum latency
+    Pipeline p;
+    auto &s1 = p.add_stage(std::make_unique<MockProducingStage>(
+        std::vector<std::vector<EventCD>>{make_events({0, 100, 200, 300}, 0)}));
+    auto &s2 = p.add_stage(std::make_unique<MockProducingStage>(
+        std::vector<std::vector<EventCD>>{make_events({50, 150, 250, 350}, 1)}));
+    auto &merging_stage = p.add_stage(
+        std::make_unique<EventMergingStage>(std::vector<std::reference_wrapper<BaseStage>>{s1, s2}, 100));
+    std::vector<EventMergingStage::MergedBufferPtr> buffers;
+    p.add_stage(std::make_unique<MockConsumingStage>(buffers), merging_stage);
+
+    // WHEN running the pipeline, the first source producing all its events before the second one
+    p.run();
+
+    // THEN the events older than the maximum latency are produced without waiting for the lagging source, whose
+    // events older than the produced ones are dropped
+    std::vector<std::vector<timestamp>> ts;
+    for (const auto &buffer : buffers) {
+        ts.emplace_back();
+        for (const auto &ev : buffer->events) {
+            ts.back().push_back(ev.t);
+        }
+    }
+    ASSERT_LE(2, ts.size());
+    EXPECT_EQ(std::vector<timestamp>({0, 100}), ts[0]);
+    EXPECT_EQ(std::vector<timestamp>({200, 250, 300}), ts[1]);
+    EXPECT_EQ(2, merging_stage.num_late_events());
+}
+
+TEST(EventMergingStage_GTest, invalid_latency) {
+    EXPECT_THROW(EventMergingStage(-1), std::invalid_argument);
+}
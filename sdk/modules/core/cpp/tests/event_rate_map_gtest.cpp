@@ -0,0 +1,94 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/core/utils/event_rate_map.h"
+
+using namespace Metavision;
+
+TEST(EventRateMap_GTest, invalid_arguments) {
+    EXPECT_THROW(EventRateMap(0, 10, 1000), std::invalid_argument);
+    EXPECT_THROW(EventRateMap(10, 10, 0), std::invalid_argument);
+    EXPECT_THROW(EventRateMap(10, 10, 1000, 0), std::invalid_argument);
+}
+
+TEST(EventRateMap_GTest, counts_decay_with_the_age_of_the_events) {
+    // GIVEN a map of single pixels, with a decay time of 1ms
+    EventRateMap map(4, 3, 1000);
+    EXPECT_EQ(4, map.get_map_width());
+    EXPECT_EQ(3, map.get_map_height());
+
+    // WHEN processing 2 events of a pixel, and an event out of the sensor
+    const std::vector<EventCD> events = {{1, 2, 0, 5000}, {1, 2, 1, 6000}, {4, 3, 0, 6000}};
+    map.process_events(events.cbegin(), events.cend());
+
+    // THEN the count of the pixel is the sum of the decays of its events, the other pixels having no event
+    const float expected = std::exp(-1.f) + 1.f;
+    EXPECT_NEAR(expected, map.get_count(1, 2, 6000), 1e-5f);
+    EXPECT_NEAR(expected * std::exp(-2.f), map.get_count(1, 2, 8000), 1e-5f);
+    EXPECT_NEAR(expected * 1000.f, map.get_rate(1, 2, 6000), 1e-2f);
+    EXPECT_EQ(0.f, map.get_count(0, 0, 6000));
+
+    // WHEN applying the decay to the map
+    map.decay(7000);
+
+    // THEN the counts can be read directly, row by row
+    EXPECT_NEAR(expected * std::exp(-1.f), map.data()[2 * 4 + 1], 1e-5f);
+    EXPECT_NEAR(expected * std::exp(-1.f), map.get_count(1, 2, 7000), 1e-5f);
+
+    // WHEN resetting the map, THEN the events are forgotten
+    map.reset();
+    EXPECT_EQ(0.f, map.get_count(1, 2, 7000));
+}
+
+TEST(EventRateMap_GTest, counts_are_rebased_over_long_recordings) {
+    // GIVEN a pixel with an event every 10us, over a duration much longer than the decay time
+    EventRateMap map(2, 2, 1000);
+    std::vector<EventCD> events;
+    for (timestamp t = 0; t <= 1000000; t += 10) {
+        events.emplace_back(0, 0, 0, t);
+    }
+
+    // WHEN processing the events
+    map.process_events(events.cbegin(), events.cend());
+
+    // THEN the rate of the pixel converges to its event rate, without loss of precision
+    const float expected = 1.f / (1.f - std::exp(-0.01f));
+    EXPECT_NEAR(expected, map.get_count(0, 0, 1000000), expected * 1e-3f);
+    EXPECT_NEAR(100000.f, map.get_rate(0, 0, 1000000), 100000.f * 1e-2f);
+}
+
+TEST(EventRateMap_GTest, blocks_of_pixels) {
+    // GIVEN a map of blocks of 2x2 pixels, the last blocks overlapping the borders of the sensor
+    EventRateMap map(5, 3, 1000, 2);
+    EXPECT_EQ(3, map.get_map_width());
+    EXPECT_EQ(2, map.get_map_height());
+
+    // WHEN processing events of several pixels of the same blocks
+    const std::vector<EventCD> events = {{0, 0, 0, 1000}, {1, 1, 0, 1000}, {4, 2, 0, 1000}, {3, 0, 0, 1000}};
+    map.process_events(events.cbegin(), events.cend());
+
+    // THEN the events of the pixels of a block are counted together
+    cv::Mat rates;
+    map.generate_rates(1000, rates);
+    ASSERT_EQ(2, rates.rows);
+    ASSERT_EQ(3, rates.cols);
+    EXPECT_FLOAT_EQ(2000.f, rates.at<float>(0, 0));
+    EXPECT_FLOAT_EQ(1000.f, rates.at<float>(0, 1));
+    EXPECT_FLOAT_EQ(0.f, rates.at<float>(0, 2));
+    EXPECT_FLOAT_EQ(1000.f, rates.at<float>(1, 2));
+    EXPECT_FLOAT_EQ(2000.f, map.get_rate(1, 0, 1000));
+}
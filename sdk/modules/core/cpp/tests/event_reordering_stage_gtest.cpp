@@ -0,0 +1,182 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <random>
+#include <vector>
+#include <boost/any.hpp>
+#include <gtest/gtest.h>
+
+#include "metavision/sdk/core/pipeline/pipeline.h"
+#include "metavision/sdk/core/pipeline/event_reordering_stage.h"
+
+using namespace Metavision;
+
+namespace {
+
+// Produces buffers of events when started, as a camera stage would
+struct MockProducingStage : public BaseStage {
+    MockProducingStage(const std::vector<std::vector<EventCD>> &buffers) : pool(EventBufferPool::make_unbounded()) {
+        set_starting_callback([this, buffers] {
+            for (const auto &events : buffers) {
+                auto buffer = pool.acquire();
+                buffer->assign(events.begin(), events.end());
+                produce(buffer);
+            }
+            complete();
+        });
+    }
+
+    EventBufferPool pool;
+};
+
+struct MockConsumingStage : public BaseStage {
+    MockConsumingStage(std::vector<EventCD> &events, size_t &num_buffers) {
+        set_consuming_callback([&events, &num_buffers](const boost::any &data) {
+            auto buffer = boost::any_cast<BaseStage::EventBufferPtr>(data);
+            events.insert(events.end(), buffer->cbegin(), buffer->cend());
+            ++num_buffers;
+        });
+    }
+};
+
+std::vector<EventCD> make_events(std::initializer_list<timestamp> ts) {
+    std::vector<EventCD> events;
+    for (auto t : ts) {
+        events.emplace_back(static_cast<unsigned short>(events.size()), 0, 0, t);
+    }
+    return events;
+}
+
+std::vector<timestamp> timestamps(const std::vector<EventCD> &events) {
+    std::vector<timestamp> ts;
+    for (const auto &ev : events) {
+        ts.push_back(ev.t);
+    }
+    return ts;
+}
+
+} // namespace
+
+TEST(EventReorderingStage_GTest, throws_on_negative_lateness) {
+    EXPECT_THROW(EventReorderingStage(-1), std::invalid_argument);
+}
+
+TEST(EventReorderingStage_GTest, forwards_sorted_events) {
+    // GIVEN a source producing sorted events
+    Pipeline p;
+    auto &s = p.add_stage(std::make_unique<MockProducingStage>(
+        std::vector<std::vector<EventCD>>{make_events({0, 10, 10, 20}), make_events({30, 40}), make_events({50})}));
+    auto &reordering_stage = p.add_stage(std::make_unique<EventReorderingStage>(s, 15));
+    std::vector<EventCD> events;
+    size_t num_buffers = 0;
+    p.add_stage(std::make_unique<MockConsumingStage>(events, num_buffers), reordering_stage);
+
+    // WHEN running the pipeline until the end of the events
+    p.run();
+
+    // THEN all the events are produced, none being counted as reordered or late
+    EXPECT_EQ(std::vector<timestamp>({0, 10, 10, 20, 30, 40, 50}), timestamps(events));
+    EXPECT_EQ(0u, reordering_stage.num_reordered_events());
+    EXPECT_EQ(0u, reordering_stage.num_late_events());
+}
+
+TEST(EventReorderingStage_GTest, sorts_events_within_lateness) {
+    // GIVEN a source producing events out of order by at most the maximum lateness
+    Pipeline p;
+    auto &s = p.add_stage(std::make_unique<MockProducingStage>(std::vector<std::vector<EventCD>>{
+        make_events({10, 5, 20, 12, 30}), make_events({25, 40, 21}), make_events({35, 50, 45})}));
+    auto &reordering_stage = p.add_stage(std::make_unique<EventReorderingStage>(s, 10));
+    std::vector<EventCD> events;
+    size_t num_buffers = 0;
+    p.add_stage(std::make_unique<MockConsumingStage>(events, num_buffers), reordering_stage);
+
+    // WHEN running the pipeline until the end of the events
+    p.run();
+
+    // THEN all the events are produced sorted by timestamp
+    EXPECT_EQ(std::vector<timestamp>({5, 10, 12, 20, 21, 25, 30, 35, 40, 45, 50}), timestamps(events));
+    EXPECT_EQ(6u, reordering_stage.num_reordered_events());
+    EXPECT_EQ(0u, reordering_stage.num_late_events());
+}
+
+TEST(EventReorderingStage_GTest, keeps_order_of_arrival_of_same_timestamps) {
+    // GIVEN a source producing events of the same timestamp, out of order with others
+    Pipeline p;
+    auto &s = p.add_stage(std::make_unique<MockProducingStage>(
+        std::vector<std::vector<EventCD>>{make_events({10, 20, 10, 10, 30, 10})}));
+    auto &reordering_stage = p.add_stage(std::make_unique<EventReorderingStage>(s, 100));
+    std::vector<EventCD> events;
+    size_t num_buffers = 0;
+    p.add_stage(std::make_unique<MockConsumingStage>(events, num_buffers), reordering_stage);
+
+    // WHEN running the pipeline until the end of the events
+    p.run();
+
+    // THEN the events of the same timestamp are produced in their order of arrival
+    ASSERT_EQ(std::vector<timestamp>({10, 10, 10, 10, 20, 30}), timestamps(events));
+    std::vector<unsigned short> xs;
+    for (const auto &ev : events) {
+        xs.push_back(ev.x);
+    }
+    EXPECT_EQ(std::vector<unsigned short>({0, 2, 3, 5, 1, 4}), xs);
+}
+
+TEST(EventReorderingStage_GTest, drops_late_events) {
+    // GIVEN a source producing events later than the maximum lateness
+    Pipeline p;
+    auto &s = p.add_stage(std::make_unique<MockProducingStage>(
+        std::vector<std::vector<EventCD>>{make_events({0, 10, 20, 30}), make_events({5, 25, 40, 12, 35})}));
+    auto &reordering_stage = p.add_stage(std::make_unique<EventReorderingStage>(s, 10));
+    std::vector<EventCD> events;
+    size_t num_buffers = 0;
+    p.add_stage(std::make_unique<MockConsumingStage>(events, num_buffers), reordering_stage);
+
+    // WHEN running the pipeline until the end of the events
+    p.run();
+
+    // THEN the events older than the ones already produced are dropped and counted
+    EXPECT_EQ(std::vector<timestamp>({0, 10, 20, 25, 30, 35, 40}), timestamps(events));
+    EXPECT_EQ(2u, reordering_stage.num_late_events());
+}
+
+TEST(EventReorderingStage_GTest, sorts_shuffled_events) {
+    // GIVEN a source producing events shuffled within windows of the maximum lateness
+    const timestamp max_lateness = 50;
+    std::vector<EventCD> all_events;
+    for (timestamp t = 0; t < 10000; t += 3) {
+        all_events.emplace_back(0, 0, 0, t);
+    }
+    std::mt19937 gen(42);
+    for (size_t i = 0; i + 16 <= all_events.size(); i += 16) {
+        std::shuffle(all_events.begin() + i, all_events.begin() + i + 16, gen);
+    }
+    std::vector<std::vector<EventCD>> buffers;
+    for (size_t i = 0; i < all_events.size(); i += 100) {
+        buffers.emplace_back(all_events.begin() + i, all_events.begin() + std::min(i + 100, all_events.size()));
+    }
+    Pipeline p;
+    auto &s                = p.add_stage(std::make_unique<MockProducingStage>(buffers));
+    auto &reordering_stage = p.add_stage(std::make_unique<EventReorderingStage>(s, max_lateness));
+    std::vector<EventCD> events;
+    size_t num_buffers = 0;
+    p.add_stage(std::make_unique<MockConsumingStage>(events, num_buffers), reordering_stage);
+
+    // WHEN running the pipeline until the end of the events
+    p.run();
+
+    // THEN all the events are produced sorted, in several buffers
+    ASSERT_EQ(all_events.size(), events.size());
+    EXPECT_TRUE(std::is_sorted(events.begin(), events.end(),
+                               [](const EventCD &a, const EventCD &b) { return a.t < b.t; }));
+    EXPECT_EQ(0u, reordering_stage.num_late_events());
+    EXPECT_LT(1u, num_buffers);
+}
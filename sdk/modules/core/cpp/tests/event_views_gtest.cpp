@@ -0,0 +1,104 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <iterator>
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/core/algorithms/event_views.h"
+
+using namespace Metavision;
+
+namespace {
+std::vector<EventCD> make_events(size_t n) {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> x_dist(0, 639), y_dist(0, 479), p_dist(0, 1);
+    std::vector<EventCD> events(n);
+    for (size_t i = 0; i < n; ++i) {
+        events[i] = EventCD(x_dist(gen), y_dist(gen), p_dist(gen), static_cast<timestamp>(i));
+    }
+    return events;
+}
+
+void expect_same_events(const std::vector<EventCD> &expected, const std::vector<EventCD> &events) {
+    ASSERT_EQ(expected.size(), events.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(expected[i].x, events[i].x);
+        EXPECT_EQ(expected[i].y, events[i].y);
+        EXPECT_EQ(expected[i].p, events[i].p);
+        EXPECT_EQ(expected[i].t, events[i].t);
+    }
+}
+} // namespace
+
+TEST(EventViews_GTest, same_output_as_fused_algorithm) {
+    // GIVEN events and a chain of algorithms
+    const auto events = make_events(10000);
+    FusedAlgorithm<RoiFilterAlgorithm, PolarityFilterAlgorithm, FlipXAlgorithm, PolarityInverterAlgorithm> fused(
+        RoiFilterAlgorithm(100, 50, 400, 300, true), PolarityFilterAlgorithm(1), FlipXAlgorithm(300),
+        PolarityInverterAlgorithm());
+    std::vector<EventCD> expected;
+    fused.process_events(events.cbegin(), events.cend(), std::back_inserter(expected));
+
+    // WHEN we copy the events of a view through the same algorithms
+    std::vector<EventCD> output;
+    (events | views::roi(100, 50, 400, 300, true) | views::polarity(1) | views::flip_x(300) | views::invert_polarity())
+        .copy_to(std::back_inserter(output));
+
+    // THEN the events are the ones of the fused algorithm
+    expect_same_events(expected, output);
+}
+
+TEST(EventViews_GTest, iterate_over_view) {
+    // GIVEN a view of events through a filter and a flip
+    const auto events = make_events(1000);
+    const auto view   = make_event_view(events.cbegin(), events.cend()) | views::polarity(0) | views::flip_y(479);
+
+    // WHEN we iterate over the view
+    std::vector<EventCD> output(view.begin(), view.end());
+
+    // THEN we get the processed events, without the filtered ones
+    std::vector<EventCD> expected;
+    for (const auto &ev : events) {
+        if (ev.p == 0) {
+            expected.emplace_back(ev.x, 479 - ev.y, ev.p, ev.t);
+        }
+    }
+    expect_same_events(expected, output);
+}
+
+TEST(EventViews_GTest, view_is_lazy) {
+    // GIVEN a view of events
+    auto events     = make_events(100);
+    const auto view = events | views::apply(FlipXAlgorithm(639));
+
+    // WHEN the input events are modified after the view is built
+    for (auto &ev : events) {
+        ev.x = 10;
+    }
+
+    // THEN the view processes the modified events
+    for (const auto &ev : view) {
+        EXPECT_EQ(629, ev.x);
+    }
+}
+
+TEST(EventViews_GTest, empty_view) {
+    // GIVEN a view where all events are filtered out
+    const std::vector<EventCD> events{EventCD(1, 1, 0, 0), EventCD(2, 2, 0, 1)};
+    const auto view = events | views::polarity(1);
+
+    // WHEN we iterate over it
+    // THEN no event is returned
+    EXPECT_TRUE(view.begin() == view.end());
+}
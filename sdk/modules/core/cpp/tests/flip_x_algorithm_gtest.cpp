@@ -14,6 +14,8 @@
 
 #include "metavision/sdk/core/algorithms/flip_x_algorithm.h"
 #include "metavision/sdk/base/events/event2d.h"
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/base/events/event_cd_buffer_soa.h"
 
 TEST(FlipXAlgorithm_GTest, constructor) {
     // GIVEN a FlipXAlgorithm instance
@@ -90,3 +92,54 @@ TEST(FlipXAlgorithm_GTest, process) {
         EXPECT_EQ(it_exp->t, it->t);
     }
 }
+
+TEST(FlipXAlgorithm_GTest, process_soa_buffer) {
+    // GIVEN a FlipXAlgorithm instance and a buffer of events stored as a structure of arrays
+    Metavision::FlipXAlgorithm algo(119);
+    Metavision::EventCDBufferSoA input, output;
+    input.push_back(0, 45, 0, 155);
+    input.push_back(119, 8, 1, 980);
+    input.push_back(100, 64, 0, 5200);
+
+    // WHEN processing the buffer, to another buffer and in place
+    algo.process_events(input, output);
+    algo.process_events(input, input);
+
+    // THEN only the x coordinates are flipped
+    for (auto &buffer : {output, input}) {
+        ASSERT_EQ(3, buffer.size());
+        EXPECT_EQ(119, buffer.x()[0]);
+        EXPECT_EQ(0, buffer.x()[1]);
+        EXPECT_EQ(19, buffer.x()[2]);
+        EXPECT_EQ(8, buffer.y()[1]);
+        EXPECT_EQ(1, buffer.p()[1]);
+        EXPECT_EQ(5200, buffer.t()[2]);
+    }
+}
+
+TEST(FlipXAlgorithm_GTest, process_batches) {
+    // GIVEN a FlipXAlgorithm instance and more events than a batch, the last batch being incomplete
+    Metavision::FlipXAlgorithm algo(639);
+    std::vector<Metavision::EventCD> input_events;
+    for (int i = 0; i < 37; ++i) {
+        input_events.emplace_back(17 * i, 480 - i, i % 2, 1000 + i);
+    }
+
+    // WHEN processing the events into a pre-sized buffer and in place
+    std::vector<Metavision::EventCD> output_events(input_events.size());
+    algo.process_events(input_events.cbegin(), input_events.cend(), output_events.begin());
+    std::vector<Metavision::EventCD> inplace_events = input_events;
+    algo.process_events(inplace_events.data(), inplace_events.data() + inplace_events.size(), inplace_events.data());
+
+    // THEN only the x coordinates are flipped, as with the function call operator
+    for (auto &events : {output_events, inplace_events}) {
+        for (size_t i = 0; i < input_events.size(); ++i) {
+            Metavision::EventCD expected = input_events[i];
+            algo(expected);
+            EXPECT_EQ(expected.x, events[i].x);
+            EXPECT_EQ(expected.y, events[i].y);
+            EXPECT_EQ(expected.p, events[i].p);
+            EXPECT_EQ(expected.t, events[i].t);
+        }
+    }
+}
@@ -11,6 +11,7 @@
 
 #include <gtest/gtest.h>
 
+#include "metavision/sdk/base/events/event_cd.h"
 #include "metavision/sdk/core/algorithms/flip_y_algorithm.h"
 
 using namespace Metavision;
@@ -103,3 +104,54 @@ TYPED_TEST(FlipYAlgorithm_GTest, few_events_flipped) {
         EXPECT_EQ(height_minus_one - iter_input->y, iter_output->y);
     }
 }
+
+TEST(FlipYAlgorithmSoA_GTest, process_soa_buffer) {
+    // GIVEN a FlipYAlgorithm instance and a buffer of events stored as a structure of arrays
+    FlipYAlgorithm algo(239);
+    EventCDBufferSoA input, output;
+    input.push_back(10, 0, 0, 155);
+    input.push_back(20, 239, 1, 980);
+    input.push_back(30, 100, 0, 5200);
+
+    // WHEN processing the buffer, to another buffer and in place
+    algo.process_events(input, output);
+    algo.process_events(input, input);
+
+    // THEN only the y coordinates are flipped
+    for (auto &buffer : {output, input}) {
+        ASSERT_EQ(3, buffer.size());
+        EXPECT_EQ(239, buffer.y()[0]);
+        EXPECT_EQ(0, buffer.y()[1]);
+        EXPECT_EQ(139, buffer.y()[2]);
+        EXPECT_EQ(20, buffer.x()[1]);
+        EXPECT_EQ(1, buffer.p()[1]);
+        EXPECT_EQ(5200, buffer.t()[2]);
+    }
+}
+
+TEST(FlipYAlgorithm_GTest, process_batches) {
+    // GIVEN a FlipYAlgorithm instance and more events than a batch, the last batch being incomplete
+    FlipYAlgorithm algo(479);
+    std::vector<EventCD> input_events;
+    for (int i = 0; i < 37; ++i) {
+        input_events.emplace_back(640 - i, 13 * i, i % 2, 1000 + i);
+    }
+
+    // WHEN processing the events into a pre-sized buffer and in place
+    std::vector<EventCD> output_events(input_events.size());
+    algo.process_events(input_events.cbegin(), input_events.cend(), output_events.begin());
+    std::vector<EventCD> inplace_events = input_events;
+    algo.process_events(inplace_events.begin(), inplace_events.end(), inplace_events.begin());
+
+    // THEN only the y coordinates are flipped, as with the function call operator
+    for (auto &events : {output_events, inplace_events}) {
+        for (size_t i = 0; i < input_events.size(); ++i) {
+            EventCD expected = input_events[i];
+            algo(expected);
+            EXPECT_EQ(expected.x, events[i].x);
+            EXPECT_EQ(expected.y, events[i].y);
+            EXPECT_EQ(expected.p, events[i].p);
+            EXPECT_EQ(expected.t, events[i].t);
+        }
+    }
+}
@@ -399,3 +399,69 @@ TEST_F(FrameComposer_GTest, gray_to_color) {
     }
     ASSERT_TRUE(is_equal);
 }
+
+TEST_F(FrameComposer_GTest, update_subimages_in_parallel) {
+    // GIVEN 4 gray and color images, resized or not, placed in disjoint regions
+    const int width = 16, height = 10;
+    std::vector<cv::Mat> frames;
+    for (int i = 0; i < 4; ++i) {
+        const uchar intensity = 30 * i + 50;
+        if (i % 2 == 0) {
+            frames.emplace_back(height * (i + 1), width, CV_8UC1, cv::Scalar(intensity));
+        } else {
+            frames.emplace_back(height, width * (i + 1), CV_8UC3, cv::Vec3b(intensity, 0, 255 - intensity));
+        }
+    }
+
+    // WHEN we update them all at once in a FrameComposer, and one by one in another one
+    FrameComposer composer(cv::Vec3b(0, 0, 0)), ref_composer(cv::Vec3b(0, 0, 0));
+    std::vector<std::pair<unsigned int, cv::Mat>> updates;
+    for (int i = 0; i < 4; ++i) {
+        FrameComposer::ResizingOptions resize_options(width, height);
+        FrameComposer::GrayToColorOptions gray_o;
+        const unsigned int id = composer.add_new_subimage_parameters(width * i, 0, resize_options, gray_o);
+        ref_composer.add_new_subimage_parameters(width * i, 0, resize_options, gray_o);
+        updates.emplace_back(id, frames[i]);
+        ASSERT_TRUE(ref_composer.update_subimage(id, frames[i]));
+    }
+    ASSERT_TRUE(composer.update_subimages(updates));
+
+    // THEN both composed images are the same
+    const cv::Mat &test_frame = composer.get_full_image();
+    const cv::Mat &ref_frame  = ref_composer.get_full_image();
+    ASSERT_EQ(ref_frame.size(), test_frame.size());
+    ASSERT_EQ(ref_frame.type(), test_frame.type());
+    ASSERT_EQ(0., cv::norm(ref_frame, test_frame, cv::NORM_INF));
+
+    // WHEN one of the updates refers to an unknown sub-image
+    updates.emplace_back(4, frames[0]);
+
+    // THEN the other sub-images are still updated, but the failure is reported
+    ASSERT_FALSE(composer.update_subimages(updates));
+    ASSERT_EQ(0., cv::norm(ref_frame, composer.get_full_image(), cv::NORM_INF));
+}
+
+TEST_F(FrameComposer_GTest, render_into_subimage) {
+    // GIVEN a FrameComposer with 2 sub-images
+    const int width = 8, height = 6;
+    FrameComposer composer(cv::Vec3b(0, 0, 0));
+    FrameComposer::ResizingOptions resize_options(width, height);
+    FrameComposer::GrayToColorOptions gray_o;
+    composer.add_new_subimage_parameters(0, 0, resize_options, gray_o);
+    const unsigned int id = composer.add_new_subimage_parameters(width, 0, resize_options, gray_o);
+
+    // WHEN we render into the region of the second one
+    cv::Mat subimage = composer.get_subimage(id);
+    ASSERT_EQ(cv::Size(width, height), subimage.size());
+    ASSERT_EQ(CV_8UC3, subimage.type());
+    subimage.setTo(cv::Vec3b(10, 20, 30));
+
+    // THEN the full image is updated without any copy, and only in this region
+    const cv::Mat &full_frame = composer.get_full_image();
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < 2 * width; ++x) {
+            ASSERT_EQ(x < width ? cv::Vec3b(0, 0, 0) : cv::Vec3b(10, 20, 30), full_frame.at<cv::Vec3b>(y, x));
+        }
+    }
+    ASSERT_TRUE(composer.get_subimage(2).empty());
+}
@@ -0,0 +1,133 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <iterator>
+#include <memory>
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/core/algorithms/fused_algorithm.h"
+#include "metavision/sdk/core/pipeline/pipeline.h"
+#include "metavision/sdk/core/pipeline/stage.h"
+
+using namespace Metavision;
+
+namespace {
+std::vector<EventCD> make_events(size_t n) {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> x_dist(0, 639), y_dist(0, 479), p_dist(0, 1);
+    std::vector<EventCD> events(n);
+    for (size_t i = 0; i < n; ++i) {
+        events[i] = EventCD(x_dist(gen), y_dist(gen), p_dist(gen), static_cast<timestamp>(i));
+    }
+    return events;
+}
+
+template<typename Algorithm>
+std::vector<EventCD> apply(Algorithm &algo, const std::vector<EventCD> &events) {
+    std::vector<EventCD> output;
+    algo.process_events(events.cbegin(), events.cend(), std::back_inserter(output));
+    return output;
+}
+
+struct BufferProducingStage : public BaseStage {
+    BufferProducingStage(const std::vector<EventCD> &events) {
+        set_starting_callback([this, events] {
+            produce(EventBufferPtr(std::make_shared<EventBuffer>(events)));
+            complete();
+        });
+    }
+};
+
+void expect_same_events(const std::vector<EventCD> &expected, const std::vector<EventCD> &events) {
+    ASSERT_EQ(expected.size(), events.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(expected[i].x, events[i].x);
+        EXPECT_EQ(expected[i].y, events[i].y);
+        EXPECT_EQ(expected[i].p, events[i].p);
+        EXPECT_EQ(expected[i].t, events[i].t);
+    }
+}
+} // namespace
+
+TEST(FusedAlgorithm_GTest, same_output_as_chained_algorithms) {
+    const auto events = make_events(10000);
+    RoiFilterAlgorithm roi(100, 50, 400, 300, true);
+    PolarityFilterAlgorithm polarity(1);
+    FlipXAlgorithm flip_x(300);
+    PolarityInverterAlgorithm inverter;
+
+    auto expected = apply(roi, events);
+    expected      = apply(polarity, expected);
+    expected      = apply(flip_x, expected);
+    std::vector<EventCD> inverted;
+    inverter.process_events(expected.cbegin(), expected.cend(), std::back_inserter(inverted));
+
+    auto fused = make_fused_algorithm(roi, polarity, flip_x, inverter);
+    expect_same_events(inverted, apply(*fused, events));
+}
+
+TEST(FusedAlgorithm_GTest, output_iterator) {
+    const auto events = make_events(1000);
+    FusedAlgorithm<PolarityFilterAlgorithm, FlipYAlgorithm> fused(PolarityFilterAlgorithm(0), FlipYAlgorithm(479));
+
+    std::vector<EventCD> output(events.size());
+    auto it = fused.process_events(events.cbegin(), events.cend(), output.begin());
+    output.resize(std::distance(output.begin(), it));
+
+    PolarityFilterAlgorithm polarity(0);
+    FlipYAlgorithm flip_y(479);
+    expect_same_events(apply(flip_y, apply(polarity, events)), output);
+}
+
+TEST(FusedAlgorithm_GTest, update_fused_algorithm) {
+    const auto events = make_events(1000);
+    auto fused        = make_fused_algorithm(PolarityFilterAlgorithm(0), FlipXAlgorithm(639));
+    fused->get<0>().set_polarity(1);
+
+    PolarityFilterAlgorithm polarity(1);
+    FlipXAlgorithm flip_x(639);
+    expect_same_events(apply(flip_x, apply(polarity, events)), apply(*fused, events));
+}
+
+TEST(FusedAlgorithm_GTest, structure_of_arrays) {
+    const auto events = make_events(1000);
+    auto fused        = make_fused_algorithm(RoiFilterAlgorithm(0, 0, 319, 239), PolarityFilterAlgorithm(1),
+                                      FlipXAlgorithm(319), FlipYAlgorithm(239));
+    EventCDBufferSoA input, output;
+    input.assign(events.cbegin(), events.cend());
+    fused->process_events(input, output);
+
+    std::vector<EventCD> soa_output(output.size());
+    output.copy_to(soa_output.begin());
+    expect_same_events(apply(*fused, events), soa_output);
+}
+
+TEST(FusedAlgorithm_GTest, fused_algorithm_stage) {
+    const auto events = make_events(1000);
+    auto fused          = make_fused_algorithm(RoiFilterAlgorithm(0, 0, 319, 239), PolarityFilterAlgorithm(1));
+    const auto expected = apply(*fused, events);
+
+    Pipeline p;
+    auto &producer = p.add_stage(std::make_unique<BufferProducingStage>(events));
+    auto &fused_stage = p.add_algorithm_stage(std::move(fused), producer);
+    auto &consumer    = p.add_stage(std::make_unique<Stage>(), fused_stage);
+    std::vector<EventCD> output;
+    consumer.set_consuming_callback([&output](const boost::any &data) {
+        auto buffer = boost::any_cast<BaseStage::EventBufferPtr>(data);
+        output.insert(output.end(), buffer->cbegin(), buffer->cend());
+    });
+    p.run();
+
+    expect_same_events(expected, output);
+}
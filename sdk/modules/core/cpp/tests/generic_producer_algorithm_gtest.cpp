@@ -27,7 +27,7 @@ protected:
 
     virtual void TearDown() override {}
 
-    detail::Ring<Event2d> &get_ring() {
+    detail::SpscRing<Event2d> &get_ring() {
         return producer_algo_.ring_event_;
     }
 
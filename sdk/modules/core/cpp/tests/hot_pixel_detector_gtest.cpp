@@ -0,0 +1,93 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <stdexcept>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/core/utils/hot_pixel_detector.h"
+
+using namespace Metavision;
+
+TEST(HotPixelDetector_GTest, invalid_arguments) {
+    EXPECT_THROW(HotPixelDetector(0, 10), std::invalid_argument);
+    EXPECT_THROW(HotPixelDetector(10, 10, 0), std::invalid_argument);
+    EXPECT_THROW(HotPixelDetector(10, 10, 1000, -1.), std::invalid_argument);
+    EXPECT_THROW(HotPixelDetector(10, 10, 1000, 1., -1.), std::invalid_argument);
+    EXPECT_THROW(HotPixelDetector(10, 10, 1000, 1., 1., 1.), std::invalid_argument);
+}
+
+TEST(HotPixelDetector_GTest, detects_pixels_with_outsized_rates) {
+    const int width = 100, height = 10;
+    HotPixelDetector detector(width, height, 10000, 1000., 20., 0.);
+    EXPECT_EQ(static_cast<size_t>((width * height + 63) / 64), detector.get_mask().size());
+
+    // GIVEN all the pixels having an event every 10ms, and 2 pixels having an event every 100us
+    std::vector<EventCD> events;
+    for (timestamp t = 0; t < 30000; t += 100) {
+        events.emplace_back(7, 3, 1, t);
+        events.emplace_back(99, 9, 0, t);
+        if (t % 10000 == 0) {
+            for (int y = 0; y < height; ++y) {
+                for (int x = 0; x < width; ++x) {
+                    events.emplace_back(x, y, 0, t);
+                }
+            }
+        }
+    }
+    // An event out of the sensor is ignored
+    events.emplace_back(width, height, 0, 100);
+
+    // WHEN processing the events of the first period, the rates are not known yet
+    auto split = events.begin();
+    while (split->t < 10000) {
+        ++split;
+    }
+    EXPECT_FALSE(detector.process_events(events.begin(), split));
+    EXPECT_EQ(0u, detector.get_num_hot_pixels());
+
+    // THEN the hot pixels are detected at the end of the period
+    EXPECT_TRUE(detector.process_events(split, events.end()));
+    EXPECT_EQ(2u, detector.get_num_hot_pixels());
+    EXPECT_TRUE(detector.is_hot(7, 3));
+    EXPECT_TRUE(detector.is_hot(99, 9));
+    EXPECT_FALSE(detector.is_hot(8, 3));
+    EXPECT_FLOAT_EQ(10100.f, detector.get_rate(7, 3));
+    EXPECT_FLOAT_EQ(100.f, detector.get_rate(8, 3));
+
+    const auto &mask = detector.get_mask();
+    const size_t pixel = 3 * width + 7;
+    EXPECT_EQ(std::uint64_t(1) << (pixel % 64), mask[pixel / 64]);
+
+    // WHEN the hot pixels stop producing events, e.g. because they are masked upstream, they remain hot
+    const std::vector<EventCD> later = {{0, 0, 0, 50000}, {0, 0, 0, 70000}};
+    EXPECT_FALSE(detector.process_events(later.cbegin(), later.cend()));
+    EXPECT_EQ(0.f, detector.get_rate(7, 3));
+    EXPECT_TRUE(detector.is_hot(7, 3));
+
+    // THEN they are only forgotten when resetting the detector
+    detector.reset();
+    EXPECT_EQ(0u, detector.get_num_hot_pixels());
+    EXPECT_FALSE(detector.is_hot(7, 3));
+}
+
+TEST(HotPixelDetector_GTest, minimum_rate) {
+    // GIVEN a single pixel having events, whose rate is higher than the mean one but below the minimum rate
+    HotPixelDetector detector(10, 10, 1000, 5000., 2., 0.);
+    std::vector<EventCD> events;
+    for (timestamp t = 0; t <= 2000; t += 500) {
+        events.emplace_back(1, 1, 0, t);
+    }
+    EXPECT_FALSE(detector.process_events(events.cbegin(), events.cend()));
+    EXPECT_FLOAT_EQ(2000.f, detector.get_rate(1, 1));
+    EXPECT_FALSE(detector.is_hot(1, 1));
+}
@@ -0,0 +1,174 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+#include "metavision/utils/gtest/gtest_with_tmp_dir.h"
+#include "metavision/sdk/base/events/event2d.h"
+#include "metavision/sdk/base/utils/DAT_helper.h"
+#include "metavision/sdk/core/algorithms/file_producer_algorithm.h"
+#include "metavision/sdk/core/utils/mapped_dat_file.h"
+
+using namespace Metavision;
+
+class MappedDATFile_GTest : public GTestWithTmpDir {
+protected:
+    void SetUp() override {
+        filename_ = tmpdir_handler_->get_full_path("mapped_dat_file.dat");
+
+        // 1s between two events, so that the timestamps of the file overflow twice
+        for (int i = 0; i < 10000; ++i) {
+            events_.emplace_back(i % 640, i % 480, i % 2, 1000000LL * i + 17);
+        }
+
+        std::ofstream file(filename_, std::ios::binary);
+        write_DAT_header<Event2d>(file, make_DAT_header_map_with_geometry(640, 480).get_header_map());
+        for (const auto &ev : events_) {
+            Event2d::RawEvent raw;
+            ev.write_event(&raw, 0);
+            file.write(reinterpret_cast<const char *>(&raw), sizeof(raw));
+        }
+    }
+
+    std::string filename_;
+    std::vector<Event2d> events_;
+};
+
+TEST_F(MappedDATFile_GTest, index) {
+    // GIVEN a DAT file whose timestamps overflow
+    ASSERT_GT(events_.back().t, 2 * (1LL << 32));
+
+    // WHEN mapping it
+    MappedDATFile file(filename_, 64);
+
+    // THEN the events and their unwrapped timestamps are retrieved
+    ASSERT_EQ(2, file.get_version());
+    ASSERT_EQ(sizeof(Event2d::RawEvent), file.get_event_size());
+    ASSERT_EQ(events_.size(), file.get_n_events());
+    ASSERT_EQ(events_.front().t, file.get_first_timestamp());
+    ASSERT_EQ(events_.back().t, file.get_last_timestamp());
+    for (uint64_t i = 0; i < file.get_n_events(); ++i) {
+        ASSERT_EQ(events_[i].t, file.get_timestamp(i));
+        const auto ev = Event2d::read_event(const_cast<uint8_t *>(file.get_event_data(i)));
+        ASSERT_EQ(events_[i].x, ev.x);
+        ASSERT_EQ(events_[i].y, ev.y);
+    }
+
+    // THEN the events of any time are found
+    const auto less = [](const Event2d &ev, timestamp t) { return ev.t < t; };
+    for (timestamp t : {-1LL, 0LL, 17LL, 18LL, 5000000017LL, 5000000018LL, 9999000017LL, 9999000018LL}) {
+        const auto expected = std::lower_bound(events_.begin(), events_.end(), t, less) - events_.begin();
+        ASSERT_EQ(expected, file.lower_bound(t));
+    }
+    const auto window = file.get_window(4294000000LL, 4300000000LL);
+    ASSERT_EQ(4294u, window.first);
+    ASSERT_EQ(4300u, window.second);
+}
+
+TEST_F(MappedDATFile_GTest, file_producer_start_at_time) {
+    // GIVEN a file producer reading a mapped DAT file
+    FileProducerAlgorithm producer(filename_);
+    producer.map_to_memory();
+    ASSERT_EQ(events_.size(), producer.get_n_tot_ev());
+    ASSERT_EQ(events_.back().t, producer.get_time_at(0, true));
+
+    // WHEN starting at a time after the first overflow
+    const timestamp start_time = 6000000000LL;
+    producer.start_at_time(start_time);
+    std::vector<Event2d> output;
+    producer.process_events(std::back_inserter(output), 1000000000LL);
+
+    // THEN the events are played from this time, relatively to it
+    ASSERT_EQ(1000u, output.size());
+    for (size_t i = 0; i < output.size(); ++i) {
+        ASSERT_EQ(events_[6000 + i].t - start_time, output[i].t);
+        ASSERT_EQ(events_[6000 + i].x, output[i].x);
+    }
+}
+
+TEST_F(MappedDATFile_GTest, file_producer_loop) {
+    // GIVEN file producers looping over the same DAT file, read from the file and mapped to memory
+    FileProducerAlgorithm::reset_max_loop_length();
+    FileProducerAlgorithm read_producer(filename_, true);
+    FileProducerAlgorithm mapped_producer(filename_, true);
+    mapped_producer.map_to_memory();
+
+    // WHEN playing the files for more than two loops
+    std::vector<Event2d> read_output, mapped_output;
+    const timestamp duration = 25000000000LL;
+    read_producer.process_events(std::back_inserter(read_output), duration);
+    FileProducerAlgorithm::reset_max_loop_length();
+    mapped_producer.process_events(std::back_inserter(mapped_output), duration);
+
+    // THEN the same events are played
+    ASSERT_GT(mapped_output.size(), 2 * events_.size());
+    ASSERT_EQ(read_output.size(), mapped_output.size());
+    for (size_t i = 0; i < mapped_output.size(); ++i) {
+        ASSERT_EQ(read_output[i].t, mapped_output[i].t);
+        ASSERT_EQ(read_output[i].x, mapped_output[i].x);
+    }
+}
+
+TEST_F(MappedDATFile_GTest, file_producer_batches_of_events_in_ram) {
+    // GIVEN file producers reading the same DAT file, from the file and from the RAM, where the events are decoded in
+    // batches
+    FileProducerAlgorithm::reset_max_loop_length();
+    FileProducerAlgorithm read_producer(filename_);
+    FileProducerAlgorithm ram_producer(filename_);
+    ram_producer.load_to_ram();
+
+    // WHEN playing the files by steps of various durations, across the timestamp overflows
+    std::vector<Event2d> read_output, ram_output;
+    for (timestamp t = 0, step = 1; t < 11000000000LL; step = (step * 7919) % 1000000007LL) {
+        t += step;
+        read_producer.process_events(std::back_inserter(read_output), t);
+        ram_producer.process_events(std::back_inserter(ram_output), t);
+        ASSERT_EQ(read_output.size(), ram_output.size());
+    }
+
+    // THEN the same events are played
+    ASSERT_EQ(events_.size(), ram_output.size());
+    for (size_t i = 0; i < ram_output.size(); ++i) {
+        ASSERT_EQ(events_[i].t, ram_output[i].t);
+        ASSERT_EQ(events_[i].x, ram_output[i].x);
+        ASSERT_EQ(events_[i].y, ram_output[i].y);
+        ASSERT_EQ(events_[i].p, ram_output[i].p);
+    }
+}
+
+TEST_F(MappedDATFile_GTest, file_producer_read_window) {
+    // GIVEN a file producer
+    FileProducerAlgorithm producer(filename_);
+    std::vector<Event2d> output;
+
+    // WHEN reading a time window without mapping the file
+    // THEN it fails
+    ASSERT_THROW(producer.read_window(0, 1, std::back_inserter(output)), std::runtime_error);
+
+    // WHEN reading a time window of the mapped file
+    producer.map_to_memory();
+    producer.read_window(4294000000LL, 8600000000LL, std::back_inserter(output));
+
+    // THEN the events of the window are read, with their timestamps unwrapped
+    ASSERT_EQ(4306u, output.size());
+    for (size_t i = 0; i < output.size(); ++i) {
+        ASSERT_EQ(events_[4294 + i].t, output[i].t);
+    }
+
+    // THEN the producer position is unchanged
+    ASSERT_EQ(events_.front().t, producer.get_time_at(0, false));
+    std::vector<Event2d> played;
+    producer.process_events(std::back_inserter(played), 1000000000LL);
+    ASSERT_EQ(1000u, played.size());
+}
@@ -0,0 +1,94 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "metavision/sdk/core/utils/detail/mpsc_queue.h"
+
+using Metavision::detail::MpscQueue;
+using Metavision::detail::MpscQueueNode;
+
+namespace {
+struct Item : MpscQueueNode {
+    Item(int producer = 0, int value = 0) : producer(producer), value(value) {}
+    int producer, value;
+};
+} // namespace
+
+TEST(MpscQueue_GTest, empty_after_construction) {
+    MpscQueue q;
+    EXPECT_TRUE(q.empty());
+    EXPECT_EQ(nullptr, q.pop());
+}
+
+TEST(MpscQueue_GTest, pops_in_push_order) {
+    MpscQueue q;
+    std::vector<Item> items(4);
+    for (int i = 0; i < 4; ++i) {
+        items[i].value = i;
+        q.push(&items[i]);
+        EXPECT_FALSE(q.empty());
+    }
+
+    for (int i = 0; i < 4; ++i) {
+        auto item = static_cast<Item *>(q.pop());
+        ASSERT_NE(nullptr, item);
+        EXPECT_EQ(i, item->value);
+    }
+    EXPECT_TRUE(q.empty());
+    EXPECT_EQ(nullptr, q.pop());
+
+    // The nodes can be pushed again once popped
+    q.push(&items[2]);
+    EXPECT_EQ(&items[2], q.pop());
+    EXPECT_TRUE(q.empty());
+}
+
+TEST(MpscQueue_GTest, keeps_the_order_of_each_producer) {
+    // GIVEN several threads pushing items while the consumer pops them
+    static constexpr int NumItems     = 100000;
+    static constexpr int NumProducers = 4;
+    MpscQueue q;
+    std::vector<std::unique_ptr<Item[]>> items;
+    for (int p = 0; p < NumProducers; ++p) {
+        items.emplace_back(new Item[NumItems]);
+    }
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < NumProducers; ++p) {
+        producers.emplace_back([&q, &items, p]() {
+            for (int i = 0; i < NumItems; ++i) {
+                items[p][i].producer = p;
+                items[p][i].value    = i;
+                q.push(&items[p][i]);
+            }
+        });
+    }
+
+    // THEN all the items are popped once, in the order of their producer
+    std::vector<int> next_values(NumProducers, 0);
+    for (int n = 0; n < NumProducers * NumItems;) {
+        if (auto item = static_cast<Item *>(q.pop())) {
+            ASSERT_EQ(next_values[item->producer], item->value);
+            ++next_values[item->producer];
+            ++n;
+        }
+    }
+    for (auto &t : producers) {
+        t.join();
+    }
+    EXPECT_TRUE(q.empty());
+    EXPECT_EQ(std::vector<int>(NumProducers, NumItems), next_values);
+}
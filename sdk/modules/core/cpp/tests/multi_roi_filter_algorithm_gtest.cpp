@@ -0,0 +1,156 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <gtest/gtest.h>
+#include <iterator>
+#include <random>
+#include <vector>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/core/algorithms/multi_roi_filter_algorithm.h"
+
+using namespace Metavision;
+
+class MultiRoiFilterAlgorithm_GTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // Random events, some of them out of the sensor
+        std::mt19937 gen(42);
+        std::uniform_int_distribution<int> x_dist(0, Width + 10), y_dist(0, Height + 10), p_dist(0, 1);
+        for (int i = 0; i < 10003; ++i) {
+            events_.emplace_back(x_dist(gen), y_dist(gen), p_dist(gen), i);
+        }
+    }
+
+    void expect_filtered_events(const MultiRoiFilterAlgorithm &algo) {
+        std::vector<EventCD> expected;
+        for (const auto &ev : events_) {
+            if (algo.is_accepted(ev.x, ev.y)) {
+                expected.push_back(ev);
+            }
+        }
+        ASSERT_FALSE(expected.empty());
+        ASSERT_LT(expected.size(), events_.size());
+
+        std::vector<EventCD> output;
+        algo.process_events(events_.cbegin(), events_.cend(), std::back_inserter(output));
+        expect_events(expected, output);
+
+        // Into another buffer and in place
+        algo.process_events(events_, output);
+        expect_events(expected, output);
+        output = events_;
+        algo.process_events(output, output);
+        expect_events(expected, output);
+
+        EventCDBufferSoA input_soa, output_soa;
+        for (const auto &ev : events_) {
+            input_soa.push_back(ev.x, ev.y, ev.p, ev.t);
+        }
+        algo.process_events(input_soa, output_soa);
+        expect_events(expected, output_soa);
+        algo.process_events(input_soa, input_soa);
+        expect_events(expected, input_soa);
+    }
+
+    static void expect_events(const std::vector<EventCD> &expected, const std::vector<EventCD> &events) {
+        ASSERT_EQ(expected.size(), events.size());
+        for (size_t i = 0; i < expected.size(); ++i) {
+            ASSERT_EQ(expected[i].x, events[i].x);
+            ASSERT_EQ(expected[i].y, events[i].y);
+            ASSERT_EQ(expected[i].p, events[i].p);
+            ASSERT_EQ(expected[i].t, events[i].t);
+        }
+    }
+
+    static void expect_events(const std::vector<EventCD> &expected, const EventCDBufferSoA &events) {
+        ASSERT_EQ(expected.size(), events.size());
+        for (size_t i = 0; i < expected.size(); ++i) {
+            ASSERT_EQ(expected[i].x, events.x()[i]);
+            ASSERT_EQ(expected[i].y, events.y()[i]);
+            ASSERT_EQ(expected[i].p, events.p()[i]);
+            ASSERT_EQ(expected[i].t, events.t()[i]);
+        }
+    }
+
+    static constexpr int Width = 100, Height = 60;
+    std::vector<EventCD> events_;
+};
+
+constexpr int MultiRoiFilterAlgorithm_GTest::Width;
+constexpr int MultiRoiFilterAlgorithm_GTest::Height;
+
+TEST_F(MultiRoiFilterAlgorithm_GTest, no_roi) {
+    // GIVEN a filter without region of interest
+    MultiRoiFilterAlgorithm algo(Width, Height);
+
+    // WHEN filtering events
+    std::vector<EventCD> output;
+    algo.process_events(events_, output);
+
+    // THEN no event is accepted
+    ASSERT_TRUE(output.empty());
+}
+
+TEST_F(MultiRoiFilterAlgorithm_GTest, several_rois) {
+    // GIVEN a filter with overlapping rectangles, one of them crossing the border of the sensor
+    MultiRoiFilterAlgorithm algo(Width, Height);
+    algo.add_roi(10, 5, 30, 20);
+    algo.add_roi(25, 15, 40, 50);
+    algo.add_roi(90, 50, 200, 200);
+
+    // THEN the pixels of the rectangles, and only them, are accepted
+    ASSERT_TRUE(algo.is_accepted(10, 5));
+    ASSERT_TRUE(algo.is_accepted(30, 20));
+    ASSERT_TRUE(algo.is_accepted(40, 50));
+    ASSERT_TRUE(algo.is_accepted(Width - 1, Height - 1));
+    ASSERT_FALSE(algo.is_accepted(9, 5));
+    ASSERT_FALSE(algo.is_accepted(31, 5));
+    ASSERT_FALSE(algo.is_accepted(41, 50));
+    ASSERT_FALSE(algo.is_accepted(Width, Height - 1));
+
+    // WHEN filtering events with all the overloads
+    // THEN the accepted events are kept, in order
+    expect_filtered_events(algo);
+
+    // WHEN removing the regions
+    algo.clear();
+
+    // THEN no pixel is accepted
+    ASSERT_FALSE(algo.is_accepted(10, 5));
+}
+
+TEST_F(MultiRoiFilterAlgorithm_GTest, mask) {
+    // GIVEN a filter with a checkerboard mask
+    MultiRoiFilterAlgorithm algo(Width, Height);
+    algo.add_roi(0, 0, Width - 1, Height - 1);
+    std::vector<uint8_t> mask(Width * Height);
+    for (int y = 0; y < Height; ++y) {
+        for (int x = 0; x < Width; ++x) {
+            mask[y * Width + x] = ((x / 3 + y / 2) % 2) * 255;
+        }
+    }
+    algo.set_mask(mask);
+
+    // THEN the mask replaces the previous regions
+    for (int y = 0; y < Height; ++y) {
+        for (int x = 0; x < Width; ++x) {
+            ASSERT_EQ(mask[y * Width + x] != 0, algo.is_accepted(x, y));
+        }
+    }
+
+    // WHEN filtering events with all the overloads
+    // THEN the accepted events are kept, in order
+    expect_filtered_events(algo);
+
+    // THEN a mask of another size is rejected
+    ASSERT_THROW(algo.set_mask(std::vector<uint8_t>(Width)), std::invalid_argument);
+}
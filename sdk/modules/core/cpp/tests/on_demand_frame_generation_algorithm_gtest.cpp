@@ -10,6 +10,8 @@
  **********************************************************************************************************************/
 
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
 #include <vector>
 #include <opencv2/core.hpp>
 
@@ -646,4 +648,43 @@ TEST(OnDemandFrameGenerationAlgorithm_GTest, delay_overlapping_frame_generation)
         ASSERT_TRUE(std::equal(expected_frame.begin<cv::Vec3b>(), expected_frame.end<cv::Vec3b>(),
                                generated_mat.begin<cv::Vec3b>()));
     }
-}
\ No newline at end of file
+}
+
+TEST(OnDemandFrameGenerationAlgorithm_GTest, incremental_frames_match_full_frames) {
+    // GIVEN a sensor whose size is not a multiple of the tile size, and events in a few areas of the sensor
+    const int sensor_width  = 200;
+    const int sensor_height = 150;
+    std::mt19937 gen(42);
+    std::vector<EventCD> events;
+    for (timestamp t = 0; t < 200000; t += 10) {
+        const int area = (t / 30000) % 3;
+        events.emplace_back(area * 60 + gen() % 50, area * 40 + gen() % 70, gen() % 2, t);
+    }
+
+    for (const uint32_t accumulation_time_us : {0, 10000}) {
+        for (const auto palette : {ColorPalette::Dark, ColorPalette::Gray}) {
+            OnDemandFrameGenerationAlgorithm full_generation(sensor_width, sensor_height, accumulation_time_us,
+                                                             palette);
+            OnDemandFrameGenerationAlgorithm incremental_generation(sensor_width, sensor_height,
+                                                                    accumulation_time_us, palette);
+            incremental_generation.set_incremental(true);
+            ASSERT_TRUE(incremental_generation.is_incremental());
+
+            // WHEN we generate overlapping frames in the same matrix after processing buffers of events
+            cv::Mat full_frame, incremental_frame;
+            const size_t buffer_size = 350;
+            for (size_t i = 0; i < events.size(); i += buffer_size) {
+                const auto end = events.cbegin() + std::min(events.size(), i + buffer_size);
+                full_generation.process_events(events.cbegin() + i, end);
+                incremental_generation.process_events(events.cbegin() + i, end);
+
+                const timestamp ts = std::prev(end)->t - 1000;
+                full_generation.generate(ts, full_frame);
+                incremental_generation.generate(ts, incremental_frame);
+
+                // THEN the frames generated incrementally are the same as the ones entirely rendered
+                ASSERT_EQ(0, cv::norm(full_frame, incremental_frame, cv::NORM_INF));
+            }
+        }
+    }
+}
@@ -10,6 +10,9 @@
  **********************************************************************************************************************/
 
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <set>
 #include <vector>
 #include <opencv2/core.hpp>
 
@@ -720,4 +723,336 @@ TEST(PeriodicFrameGenerationAlgorithm_GTest, test_doc_example_output) {
     // clang-format on
 
     ASSERT_EQ(expected_message, is.str());
-}
\ No newline at end of file
+}
+
+TEST(PeriodicFrameGenerationAlgorithm_GTest, large_sensor_frames_match_events) {
+    // GIVEN a large sensor, so that the frames are rendered by several threads, and random events
+    const int sensor_width               = 1280;
+    const int sensor_height              = 720;
+    const timestamp period_us            = 10000;
+    const timestamp accumulation_time_us = 5000;
+    std::mt19937 gen(42);
+    std::vector<EventCD> events;
+    for (timestamp t = 0; t < 3 * period_us; t += 1) {
+        for (int i = 0; i < 20; ++i) {
+            events.emplace_back(gen() % sensor_width, gen() % sensor_height, gen() % 2, t);
+        }
+    }
+
+    for (const auto palette : {ColorPalette::Dark, ColorPalette::Gray}) {
+        PeriodicFrameGenerationAlgorithm frame_generation(sensor_width, sensor_height, accumulation_time_us,
+                                                          1.e6 / period_us, palette);
+
+        // WHEN we process the events
+        std::vector<FrameData> generated_frames;
+        frame_generation.set_output_callback(
+            [&](timestamp ts, cv::Mat &frame) { generated_frames.push_back({ts, frame.clone()}); });
+        frame_generation.process_events(events.cbegin(), events.cend());
+
+        // THEN the frames are the ones generated from the events of their accumulation time
+        ASSERT_EQ(size_t(2), generated_frames.size());
+        for (const auto &frame_data : generated_frames) {
+            cv::Mat expected_frame(sensor_height, sensor_width, frame_data.frame_.type());
+            const auto is_before = [](const EventCD &ev, timestamp t) { return ev.t < t; };
+            const auto begin =
+                std::lower_bound(events.cbegin(), events.cend(), frame_data.ts_us_ - accumulation_time_us, is_before);
+            const auto end = std::lower_bound(events.cbegin(), events.cend(), frame_data.ts_us_, is_before);
+            BaseFrameGenerationAlgorithm::generate_frame_from_events(begin, end, expected_frame, 0, palette);
+            ASSERT_EQ(0, cv::norm(expected_frame, frame_data.frame_, cv::NORM_INF));
+        }
+    }
+}
+
+TEST(PeriodicFrameGenerationAlgorithm_GTest, incremental_frames_match_full_frames) {
+    // GIVEN a sensor whose size is not a multiple of the tile size, and events in a few areas of the sensor
+    const int sensor_width  = 200;
+    const int sensor_height = 150;
+    std::mt19937 gen(42);
+    std::vector<EventCD> events;
+    for (timestamp t = 0; t < 200000; t += 10) {
+        const int area = (t / 30000) % 3;
+        events.emplace_back(area * 60 + gen() % 50, area * 40 + gen() % 70, gen() % 2, t);
+    }
+
+    for (const auto palette : {ColorPalette::Dark, ColorPalette::Gray}) {
+        PeriodicFrameGenerationAlgorithm full_generation(sensor_width, sensor_height, 10000, 200., palette);
+        PeriodicFrameGenerationAlgorithm incremental_generation(sensor_width, sensor_height, 10000, 200., palette);
+        incremental_generation.set_incremental(true);
+        ASSERT_TRUE(incremental_generation.is_incremental());
+
+        std::vector<FrameData> full_frames, incremental_frames;
+        full_generation.set_output_callback(
+            [&](timestamp ts, cv::Mat &frame) { full_frames.push_back({ts, frame.clone()}); });
+        incremental_generation.set_output_callback(
+            [&](timestamp ts, cv::Mat &frame) { incremental_frames.push_back({ts, frame.clone()}); });
+
+        // WHEN we process the events by buffers, changing the accumulation time in the middle of the stream
+        const size_t buffer_size = 350;
+        for (size_t i = 0; i < events.size(); i += buffer_size) {
+            const auto end = events.cbegin() + std::min(events.size(), i + buffer_size);
+            if (i == events.size() / 2) {
+                full_generation.set_accumulation_time_us(3000);
+                incremental_generation.set_accumulation_time_us(3000);
+            }
+            full_generation.process_events(events.cbegin() + i, end);
+            incremental_generation.process_events(events.cbegin() + i, end);
+        }
+
+        // THEN the frames generated incrementally are the same as the ones entirely rendered
+        ASSERT_EQ(size_t(39), full_frames.size());
+        ASSERT_EQ(full_frames.size(), incremental_frames.size());
+        for (size_t i = 0; i < full_frames.size(); ++i) {
+            ASSERT_EQ(full_frames[i].ts_us_, incremental_frames[i].ts_us_);
+            ASSERT_EQ(0, cv::norm(full_frames[i].frame_, incremental_frames[i].frame_, cv::NORM_INF));
+        }
+    }
+}
+
+TEST(PeriodicFrameGenerationAlgorithm_GTest, pooled_frames_match_frames) {
+    // GIVEN a generator rendering incrementally in frames of a pool, and a consumer keeping every third frame
+    const int sensor_width  = 200;
+    const int sensor_height = 150;
+    std::mt19937 gen(42);
+    std::vector<EventCD> events;
+    for (timestamp t = 0; t < 200000; t += 10) {
+        events.emplace_back(gen() % sensor_width, gen() % sensor_height, gen() % 2, t);
+    }
+
+    PeriodicFrameGenerationAlgorithm full_generation(sensor_width, sensor_height, 10000, 200.);
+    PeriodicFrameGenerationAlgorithm pooled_generation(sensor_width, sensor_height, 10000, 200.);
+    pooled_generation.set_incremental(true);
+
+    std::vector<FrameData> full_frames, pooled_frames;
+    std::vector<PeriodicFrameGenerationAlgorithm::FramePool::ptr_type> kept_frames;
+    std::set<const uchar *> frame_buffers;
+    full_generation.set_output_callback(
+        [&](timestamp ts, cv::Mat &frame) { full_frames.push_back({ts, frame.clone()}); });
+    pooled_generation.set_pooled_output_callback(
+        [&](timestamp ts, const PeriodicFrameGenerationAlgorithm::FramePool::ptr_type &frame) {
+            pooled_frames.push_back({ts, frame->clone()});
+            frame_buffers.insert(frame->data);
+            if (pooled_frames.size() % 3 == 0) {
+                kept_frames.push_back(frame);
+            }
+        });
+
+    // WHEN we process the events
+    full_generation.process_events(events.cbegin(), events.cend());
+    pooled_generation.process_events(events.cbegin(), events.cend());
+
+    // THEN the pooled frames are the same as the frames of the output callback, the frames kept by the consumer are
+    // left untouched and only the frames released are reused
+    ASSERT_EQ(size_t(39), full_frames.size());
+    ASSERT_EQ(full_frames.size(), pooled_frames.size());
+    for (size_t i = 0; i < full_frames.size(); ++i) {
+        ASSERT_EQ(full_frames[i].ts_us_, pooled_frames[i].ts_us_);
+        ASSERT_EQ(0, cv::norm(full_frames[i].frame_, pooled_frames[i].frame_, cv::NORM_INF));
+    }
+    ASSERT_EQ(size_t(13), kept_frames.size());
+    for (size_t i = 0; i < kept_frames.size(); ++i) {
+        ASSERT_EQ(0, cv::norm(full_frames[3 * i + 2].frame_, *kept_frames[i], cv::NORM_INF));
+    }
+    ASSERT_EQ(kept_frames.size(), frame_buffers.size());
+}
+
+TEST(PeriodicFrameGenerationAlgorithm_GTest, output_views_match_frames) {
+    // GIVEN a generator with a cropped view, a grayscale view and a view scaled down by a factor not dividing the
+    // sensor size, and events with distinct timestamps
+    const int sensor_width               = 200;
+    const int sensor_height              = 150;
+    const timestamp accumulation_time_us = 5000;
+    std::mt19937 gen(42);
+    std::vector<EventCD> events;
+    for (timestamp t = 0; t < 30000; t += 2) {
+        events.emplace_back(gen() % sensor_width, gen() % sensor_height, gen() % 2, t);
+    }
+
+    PeriodicFrameGenerationAlgorithm frame_generation(sensor_width, sensor_height, accumulation_time_us, 100.);
+    PeriodicFrameGenerationAlgorithm gray_generation(sensor_width, sensor_height, accumulation_time_us, 100.,
+                                                     ColorPalette::Gray);
+    std::vector<FrameData> frames, gray_frames, cropped_views, gray_views, scaled_views;
+    frame_generation.set_output_callback([&](timestamp ts, cv::Mat &frame) { frames.push_back({ts, frame.clone()}); });
+    gray_generation.set_output_callback(
+        [&](timestamp ts, cv::Mat &frame) { gray_frames.push_back({ts, frame.clone()}); });
+
+    const cv::Rect roi(30, 20, 100, 80);
+    PeriodicFrameGenerationAlgorithm::OutputView cropped, gray, scaled;
+    cropped.roi      = roi;
+    gray.palette     = ColorPalette::Gray;
+    scaled.downscale = 4;
+    auto add_view = [&](const PeriodicFrameGenerationAlgorithm::OutputView &view, std::vector<FrameData> &views) {
+        return frame_generation.add_output_view(
+            view, [&views](timestamp ts, const PeriodicFrameGenerationAlgorithm::FramePool::ptr_type &frame) {
+                views.push_back({ts, frame->clone()});
+            });
+    };
+    ASSERT_EQ(roi.size(), add_view(cropped, cropped_views));
+    ASSERT_EQ(cv::Size(sensor_width, sensor_height), add_view(gray, gray_views));
+    ASSERT_EQ(cv::Size(50, 38), add_view(scaled, scaled_views));
+
+    // WHEN we process the events
+    frame_generation.process_events(events.cbegin(), events.cend());
+    gray_generation.process_events(events.cbegin(), events.cend());
+
+    // THEN each view is rendered along with each frame
+    ASSERT_EQ(size_t(2), frames.size());
+    ASSERT_EQ(frames.size(), cropped_views.size());
+    ASSERT_EQ(frames.size(), gray_views.size());
+    ASSERT_EQ(frames.size(), scaled_views.size());
+    for (size_t i = 0; i < frames.size(); ++i) {
+        ASSERT_EQ(frames[i].ts_us_, cropped_views[i].ts_us_);
+        ASSERT_EQ(0, cv::norm(frames[i].frame_(roi), cropped_views[i].frame_, cv::NORM_INF));
+        ASSERT_EQ(0, cv::norm(gray_frames[i].frame_, gray_views[i].frame_, cv::NORM_INF));
+
+        // Each pixel of the scaled down view shows the last event of its block
+        cv::Mat expected(38, 50, CV_8UC3, bg_color);
+        for (const auto &ev : events) {
+            if (ev.t >= frames[i].ts_us_ - accumulation_time_us && ev.t < frames[i].ts_us_) {
+                expected.at<cv::Vec3b>(ev.y / 4, ev.x / 4) = ev.p ? on_color : off_color;
+            }
+        }
+        ASSERT_EQ(0, cv::norm(expected, scaled_views[i].frame_, cv::NORM_INF));
+    }
+
+    // WHEN adding invalid views
+    // THEN it throws
+    PeriodicFrameGenerationAlgorithm::OutputView invalid;
+    invalid.downscale = 0;
+    ASSERT_THROW(frame_generation.add_output_view(invalid, nullptr), std::invalid_argument);
+    invalid.downscale = 1;
+    invalid.roi       = cv::Rect(sensor_width, 0, 10, 10);
+    ASSERT_THROW(frame_generation.add_output_view(invalid, nullptr), std::invalid_argument);
+}
+
+TEST(PeriodicFrameGenerationAlgorithm_GTest, yuv_views_match_bgr_view) {
+    // GIVEN a generator with a BGR view, an NV12 view and an I420 view of the same region, scaled down
+    const int sensor_width  = 200;
+    const int sensor_height = 150;
+    std::mt19937 gen(42);
+    std::vector<EventCD> events;
+    for (timestamp t = 0; t < 30000; t += 2) {
+        events.emplace_back(gen() % sensor_width, gen() % sensor_height, gen() % 2, t);
+    }
+
+    PeriodicFrameGenerationAlgorithm frame_generation(sensor_width, sensor_height, 5000, 100.);
+    std::vector<FrameData> bgr_views, nv12_views, i420_views;
+    PeriodicFrameGenerationAlgorithm::OutputView view;
+    view.roi       = cv::Rect(10, 10, 180, 120);
+    view.downscale = 3;
+    auto add_view  = [&](PeriodicFrameGenerationAlgorithm::ViewFormat format, std::vector<FrameData> &views) {
+        view.format = format;
+        return frame_generation.add_output_view(
+            view, [&views](timestamp ts, const PeriodicFrameGenerationAlgorithm::FramePool::ptr_type &frame) {
+                views.push_back({ts, frame->clone()});
+            });
+    };
+    const cv::Size size(60, 40);
+    ASSERT_EQ(size, add_view(PeriodicFrameGenerationAlgorithm::ViewFormat::Default, bgr_views));
+    ASSERT_EQ(size, add_view(PeriodicFrameGenerationAlgorithm::ViewFormat::NV12, nv12_views));
+    ASSERT_EQ(size, add_view(PeriodicFrameGenerationAlgorithm::ViewFormat::I420, i420_views));
+
+    // WHEN we process the events
+    frame_generation.process_events(events.cbegin(), events.cend());
+
+    // THEN the YUV views hold the conversion of the BGR view, with the chroma averaged over 2x2 blocks
+    auto to_yuv = [](const cv::Vec3b &bgr) {
+        const double b = bgr[0], g = bgr[1], r = bgr[2];
+        return std::array<int, 3>{static_cast<int>(std::round(0.257 * r + 0.504 * g + 0.098 * b + 16)),
+                                  static_cast<int>(std::round(-0.148 * r - 0.291 * g + 0.439 * b + 128)),
+                                  static_cast<int>(std::round(0.439 * r - 0.368 * g - 0.071 * b + 128))};
+    };
+    ASSERT_EQ(size_t(2), bgr_views.size());
+    ASSERT_EQ(bgr_views.size(), nv12_views.size());
+    ASSERT_EQ(bgr_views.size(), i420_views.size());
+    for (size_t f = 0; f < bgr_views.size(); ++f) {
+        const cv::Mat &bgr = bgr_views[f].frame_, &nv12 = nv12_views[f].frame_, &i420 = i420_views[f].frame_;
+        ASSERT_EQ(cv::Size(size.width, size.height * 3 / 2), nv12.size());
+        ASSERT_EQ(cv::Size(size.width, size.height * 3 / 2), i420.size());
+        const uchar *nv12_uv = nv12.ptr<uchar>(size.height);
+        const uchar *i420_u  = i420.ptr<uchar>(size.height);
+        const uchar *i420_v  = i420_u + size.area() / 4;
+        for (int y = 0; y < size.height; y += 2) {
+            for (int x = 0; x < size.width; x += 2) {
+                int u = 0, v = 0;
+                for (int dy = 0; dy < 2; ++dy) {
+                    for (int dx = 0; dx < 2; ++dx) {
+                        const auto yuv = to_yuv(bgr.at<cv::Vec3b>(y + dy, x + dx));
+                        ASSERT_EQ(yuv[0], nv12.at<uchar>(y + dy, x + dx));
+                        ASSERT_EQ(yuv[0], i420.at<uchar>(y + dy, x + dx));
+                        u += yuv[1];
+                        v += yuv[2];
+                    }
+                }
+                const int c = (y / 2) * (size.width / 2) + x / 2;
+                ASSERT_EQ((u + 2) / 4, nv12_uv[2 * c]);
+                ASSERT_EQ((v + 2) / 4, nv12_uv[2 * c + 1]);
+                ASSERT_EQ((u + 2) / 4, i420_u[c]);
+                ASSERT_EQ((v + 2) / 4, i420_v[c]);
+            }
+        }
+    }
+
+    // WHEN adding a YUV view of odd size
+    // THEN it throws
+    view.roi = cv::Rect(0, 0, 61, 40);
+    ASSERT_THROW(add_view(PeriodicFrameGenerationAlgorithm::ViewFormat::NV12, nv12_views), std::invalid_argument);
+}
+
+TEST(PeriodicFrameGenerationAlgorithm_GTest, adaptive_fps) {
+    // GIVEN a static scene with an event every 500us, and a burst of activity of 100 events per ms from 20ms to 25ms
+    const int sensor_width  = 100;
+    const int sensor_height = 100;
+    std::vector<EventCD> events;
+    for (timestamp t = 0; t < 80000; t += 10) {
+        if (t % 500 == 0 || (t >= 20000 && t < 25000)) {
+            events.emplace_back(t % sensor_width, (t / 100) % sensor_height, 1, t);
+        }
+    }
+
+    // GIVEN a generator at up to 1000 fps, down to 100 fps while the event rate is under 10kHz
+    PeriodicFrameGenerationAlgorithm frame_generation(sensor_width, sensor_height, 1000, 1000.);
+    frame_generation.set_adaptive_fps(100., 10000.);
+    ASSERT_TRUE(frame_generation.is_adaptive_fps());
+    std::vector<timestamp> frame_ts;
+    frame_generation.set_output_callback([&](timestamp ts, cv::Mat &) { frame_ts.push_back(ts); });
+
+    // WHEN we process the events
+    frame_generation.process_events(events.cbegin(), events.cend());
+
+    // THEN the frames of the static scene are spaced by the idle period, the burst being rendered at the maximum fps
+    // as soon as it starts, after which the period doubles at each frame
+    std::vector<timestamp> burst_frame_ts;
+    std::copy_if(frame_ts.cbegin(), frame_ts.cend(), std::back_inserter(burst_frame_ts),
+                 [](timestamp ts) { return ts > 20000 && ts <= 25000; });
+    EXPECT_EQ(std::vector<timestamp>({21000, 22000, 23000, 24000, 25000}), burst_frame_ts);
+    auto it = std::find(frame_ts.cbegin(), frame_ts.cend(), 25000);
+    ASSERT_LE(5, std::distance(it, frame_ts.cend()));
+    EXPECT_EQ(26000, *std::next(it));
+    EXPECT_EQ(28000, *std::next(it, 2));
+    EXPECT_EQ(32000, *std::next(it, 3));
+    EXPECT_EQ(40000, *std::next(it, 4));
+    for (size_t i = 1; i < frame_ts.size(); ++i) {
+        if (frame_ts[i - 1] >= 40000) {
+            EXPECT_EQ(10000, frame_ts[i] - frame_ts[i - 1]);
+        }
+    }
+
+    // WHEN no frame is to be generated for the static scene
+    frame_generation.reset();
+    frame_ts.clear();
+    frame_generation.set_adaptive_fps(0., 10000.);
+    frame_generation.process_events(events.cbegin(), events.cend());
+
+    // THEN the frames stop once the period exceeds the accumulation time, the events of the burst having expired
+    std::vector<timestamp> expected_frame_ts{1000, 21000, 22000, 23000, 24000, 25000, 26000};
+    EXPECT_EQ(expected_frame_ts, frame_ts);
+
+    // WHEN disabling the adaptive fps
+    frame_generation.reset();
+    frame_ts.clear();
+    frame_generation.disable_adaptive_fps();
+    frame_generation.process_events(events.cbegin(), events.cend());
+
+    // THEN the frames are generated at the maximum fps
+    EXPECT_LE(79u, frame_ts.size());
+}
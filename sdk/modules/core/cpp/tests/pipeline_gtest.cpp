@@ -9,14 +9,20 @@
  * See the License for the specific language governing permissions and limitations under the License.                 *
  **********************************************************************************************************************/
 
+#include <algorithm>
 #include <atomic>
 #include <thread>
 #include <future>
 #include <chrono>
 #include <boost/any.hpp>
 #include <gtest/gtest.h>
+#include <numeric>
 #include <stdexcept>
+#ifdef __linux__
+#include <pthread.h>
+#endif
 
+#include "metavision/sdk/base/utils/metrics_registry.h"
 #include "metavision/sdk/core/pipeline/pipeline.h"
 #include "metavision/sdk/core/pipeline/stage.h"
 
@@ -91,6 +97,55 @@ struct MockConsumingStage : public BaseStage {
     std::vector<int> datas;
     std::atomic<bool> started_{false};
 };
+
+struct MockForwardingStage : public BaseStage {
+    MockForwardingStage() {
+        set_consuming_callback([this](const boost::any &data) {
+            if (running_.exchange(true)) {
+                concurrent_runs_ = true;
+            }
+            std::this_thread::yield();
+            running_ = false;
+            produce(data);
+        });
+    }
+    std::atomic<bool> running_{false};
+    std::atomic<bool> concurrent_runs_{false};
+};
+
+// Produces a first data, waits for the next stage to be consuming it and produces the remaining data at once
+struct GatedProducingStage : public MockProducingStage {
+    GatedProducingStage(int num_datas) : num_datas(num_datas) {}
+    bool produce_impl() override {
+        produce(0);
+        while (!consuming_ && !stopped_) {
+            std::this_thread::yield();
+        }
+        for (int i = 1; i < num_datas; ++i) {
+            produce(i);
+        }
+        produced_ = true;
+        return false;
+    }
+    int num_datas;
+    std::atomic<bool> consuming_{false};
+    std::atomic<bool> produced_{false};
+};
+
+// Produces buffers of events
+struct EventBufferProducingStage : public MockProducingStage {
+    EventBufferProducingStage(size_t num_buffers, size_t buffer_size) :
+        num_buffers(num_buffers), buffer_size(buffer_size) {}
+    bool produce_impl() override {
+        if (num_produced < num_buffers) {
+            produce(EventBuffer(buffer_size));
+            ++num_produced;
+            return true;
+        }
+        return false;
+    }
+    size_t num_buffers, buffer_size, num_produced = 0;
+};
 } // namespace
 
 TEST(PipelineTest, no_stages) {
@@ -508,6 +563,517 @@ TEST(PipelineTest, process_all_data_two_producer_two_detached_consumer) {
     EXPECT_EQ(std::vector<int>({3, 4, 5}), s4.datas);
 }
 
+TEST(PipelineTest, process_all_data_in_order_with_work_stealing) {
+    ////////////////////////////////////////////////////////////////////////////////
+    // PURPOSE
+    // Checks that a pipeline run by a pool of workers forwards all the data to all stages, runs the tasks of a stage
+    // sequentially and keeps the order of the produced data
+    std::vector<int> datas1(1000), datas2(500);
+    std::iota(datas1.begin(), datas1.end(), 0);
+    std::iota(datas2.begin(), datas2.end(), 1000);
+
+    Pipeline p(true, Pipeline::SchedulingPolicy::WorkStealing, 4);
+    auto &s1 = p.add_stage(std::make_unique<VectorProducingStage>(datas1));
+    auto &s2 = p.add_stage(std::make_unique<VectorProducingStage>(datas2));
+    auto &s3 = p.add_stage(std::make_unique<MockForwardingStage>(), s1);
+    auto &s4 = p.add_stage(std::make_unique<MockForwardingStage>(), s2);
+    auto &s5 = p.add_stage(std::make_unique<MockConsumingStage>(), s3);
+    auto &s6 = p.add_stage(std::make_unique<MockConsumingStage>(), s4);
+    p.run();
+
+    EXPECT_EQ(Pipeline::Status::Completed, p.status());
+    EXPECT_FALSE(s3.concurrent_runs_);
+    EXPECT_FALSE(s4.concurrent_runs_);
+    EXPECT_EQ(datas1, s5.datas);
+    EXPECT_EQ(datas2, s6.datas);
+}
+
+TEST(PipelineTest, process_all_data_with_work_stealing_and_undetached_consumer) {
+    ////////////////////////////////////////////////////////////////////////////////
+    // PURPOSE
+    // Checks that the stages run on the main thread are still run there when the other ones are run by the workers
+    Pipeline p(false, Pipeline::SchedulingPolicy::WorkStealing);
+    auto &s1 = p.add_stage(std::make_unique<VectorProducingStage>(std::vector<int>{1, 2, 3}));
+    auto &s2 = p.add_stage(std::make_unique<MockForwardingStage>(), s1);
+    s2.detach();
+    std::thread::id consumer_thread_id;
+    auto &s3 = p.add_stage(std::make_unique<Stage>(), s2);
+    std::vector<int> datas;
+    s3.set_consuming_callback([&](const boost::any &data) {
+        consumer_thread_id = std::this_thread::get_id();
+        datas.emplace_back(boost::any_cast<int>(data));
+    });
+    p.run();
+
+    EXPECT_EQ(Pipeline::Status::Completed, p.status());
+    EXPECT_EQ(std::vector<int>({1, 2, 3}), datas);
+    EXPECT_EQ(std::this_thread::get_id(), consumer_thread_id);
+}
+
+TEST(PipelineTest, input_queue_limit_blocks_producer) {
+    ////////////////////////////////////////////////////////////////////////////////
+    // PURPOSE
+    // Checks that a producer waits for a slow consumer when its input queue is full, without losing any data
+    std::vector<int> datas1(100);
+    std::iota(datas1.begin(), datas1.end(), 0);
+
+    Pipeline p(true);
+    auto &s1 = p.add_stage(std::make_unique<VectorProducingStage>(datas1));
+    auto &s2 = p.add_stage(std::make_unique<Stage>(), s1);
+    s2.set_input_queue_limit(2, BaseStage::InputQueuePolicy::Block);
+    std::vector<int> datas;
+    size_t max_queue_size = 0;
+    s2.set_consuming_callback([&](const boost::any &data) {
+        max_queue_size = std::max(max_queue_size, s2.input_queue_size());
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+        datas.emplace_back(boost::any_cast<int>(data));
+    });
+    p.run();
+
+    EXPECT_EQ(Pipeline::Status::Completed, p.status());
+    EXPECT_EQ(size_t(2), s2.input_queue_limit(s1));
+    EXPECT_EQ(datas1, datas);
+    EXPECT_GE(size_t(2), max_queue_size);
+    EXPECT_EQ(size_t(0), s2.num_dropped_inputs());
+    EXPECT_EQ(size_t(0), s2.input_queue_size());
+}
+
+namespace {
+struct InputQueuePolicyResult {
+    std::vector<int> datas;
+    size_t queue_size;
+    size_t num_dropped;
+};
+
+InputQueuePolicyResult run_with_input_queue_limit(size_t max_size, BaseStage::InputQueuePolicy policy) {
+    InputQueuePolicyResult result;
+    Pipeline p(true);
+    auto &s1 = p.add_stage(std::make_unique<GatedProducingStage>(10));
+    auto &s2 = p.add_stage(std::make_unique<Stage>(), s1);
+    s2.set_input_queue_limit(s1, max_size, policy);
+    s2.set_consuming_callback([&](const boost::any &data) {
+        if (result.datas.empty()) {
+            s1.consuming_ = true;
+            while (!s1.produced_) {
+                std::this_thread::yield();
+            }
+            result.queue_size = s2.input_queue_size(s1);
+        }
+        result.datas.emplace_back(boost::any_cast<int>(data));
+    });
+    p.run();
+    result.num_dropped = s2.num_dropped_inputs();
+    return result;
+}
+} // namespace
+
+TEST(PipelineTest, input_queue_limit_drops_newest) {
+    ////////////////////////////////////////////////////////////////////////////////
+    // PURPOSE
+    // Checks that the data produced for a full input queue are dropped
+    auto result = run_with_input_queue_limit(3, BaseStage::InputQueuePolicy::DropNewest);
+    EXPECT_EQ(std::vector<int>({0, 1, 2, 3}), result.datas);
+    EXPECT_EQ(size_t(3), result.queue_size);
+    EXPECT_EQ(size_t(6), result.num_dropped);
+}
+
+TEST(PipelineTest, input_queue_limit_drops_oldest) {
+    ////////////////////////////////////////////////////////////////////////////////
+    // PURPOSE
+    // Checks that the oldest pending data are dropped to make room for the ones produced for a full input queue
+    auto result = run_with_input_queue_limit(3, BaseStage::InputQueuePolicy::DropOldest);
+    EXPECT_EQ(std::vector<int>({0, 7, 8, 9}), result.datas);
+    EXPECT_EQ(size_t(3), result.queue_size);
+    EXPECT_EQ(size_t(6), result.num_dropped);
+}
+
+TEST(PipelineTest, input_queue_limit_coalesces) {
+    ////////////////////////////////////////////////////////////////////////////////
+    // PURPOSE
+    // Checks that the pending data are replaced by the one produced for a full input queue
+    auto result = run_with_input_queue_limit(2, BaseStage::InputQueuePolicy::Coalesce);
+    EXPECT_EQ(std::vector<int>({0, 9}), result.datas);
+    EXPECT_EQ(size_t(1), result.queue_size);
+    EXPECT_EQ(size_t(8), result.num_dropped);
+}
+
+TEST(PipelineTest, input_queue_limit_of_another_previous_stage) {
+    ////////////////////////////////////////////////////////////////////////////////
+    // PURPOSE
+    // Checks that the limit set for a previous stage does not apply to the other ones
+    Pipeline p(true);
+    auto &s1 = p.add_stage(std::make_unique<VectorProducingStage>(std::vector<int>{1, 2, 3}));
+    auto &s2 = p.add_stage(std::make_unique<VectorProducingStage>(std::vector<int>{4, 5, 6}));
+    auto &s3 = p.add_stage(std::make_unique<MockConsumingStage>(), s1);
+    s3.set_previous_stage(s2);
+    s3.set_input_queue_limit(4);
+    s3.set_input_queue_limit(s1, 1, BaseStage::InputQueuePolicy::DropNewest);
+
+    EXPECT_EQ(size_t(1), s3.input_queue_limit(s1));
+    EXPECT_EQ(size_t(4), s3.input_queue_limit(s2));
+    s3.set_input_queue_limit(s1, 0);
+    EXPECT_EQ(size_t(0), s3.input_queue_limit(s1));
+    EXPECT_EQ(size_t(4), s3.input_queue_limit(s2));
+}
+
+TEST(PipelineTest, best_effort_stage_coalesces_inputs_while_critical_tasks_are_pending) {
+    ////////////////////////////////////////////////////////////////////////////////
+    // PURPOSE
+    // Checks that a best effort stage only consumes the most recent data while a critical stage has pending tasks,
+    // and that the critical stage consumes all the data
+    Pipeline p(true);
+    auto &s1 = p.add_stage(std::make_unique<GatedProducingStage>(10));
+    auto &s2 = p.add_stage(std::make_unique<Stage>(), s1);
+    auto &s3 = p.add_stage(std::make_unique<Stage>(), s1);
+    s2.set_priority(BaseStage::Priority::Critical);
+    s3.set_priority(BaseStage::Priority::BestEffort);
+    EXPECT_EQ(BaseStage::Priority::Critical, s2.priority());
+    EXPECT_EQ(BaseStage::Priority::BestEffort, s3.priority());
+
+    // both consumers are busy with the first data while the others are produced
+    std::atomic<int> num_consuming{0};
+    auto make_consuming_cb = [&](std::vector<int> &datas) {
+        return [&](const boost::any &data) {
+            if (datas.empty()) {
+                if (++num_consuming == 2) {
+                    s1.consuming_ = true;
+                }
+                while (!s1.produced_) {
+                    std::this_thread::yield();
+                }
+            }
+            datas.emplace_back(boost::any_cast<int>(data));
+        };
+    };
+    std::vector<int> datas2, datas3;
+    s2.set_consuming_callback(make_consuming_cb(datas2));
+    s3.set_consuming_callback(make_consuming_cb(datas3));
+    p.run();
+
+    EXPECT_EQ(Pipeline::Status::Completed, p.status());
+    EXPECT_EQ(std::vector<int>({0, 1, 2, 3, 4, 5, 6, 7, 8, 9}), datas2);
+    EXPECT_EQ(size_t(0), s2.num_dropped_inputs());
+    EXPECT_EQ(std::vector<int>({0, 9}), datas3);
+    EXPECT_EQ(size_t(8), s3.num_dropped_inputs());
+}
+
+TEST(PipelineTest, priority_cannot_be_changed_once_started) {
+    ////////////////////////////////////////////////////////////////////////////////
+    // PURPOSE
+    // Checks that the priority of a stage is fixed once the pipeline is started
+    Pipeline p(true);
+    auto &s1 = p.add_stage(std::make_unique<VectorProducingStage>(std::vector<int>{1, 2, 3}));
+    auto &s2 = p.add_stage(std::make_unique<MockConsumingStage>(), s1);
+    EXPECT_EQ(BaseStage::Priority::Normal, s2.priority());
+    s2.set_priority(BaseStage::Priority::Critical);
+    p.step();
+    EXPECT_THROW(s2.set_priority(BaseStage::Priority::Normal), std::runtime_error);
+    p.run();
+    EXPECT_EQ(std::vector<int>({1, 2, 3}), s2.datas);
+}
+
+TEST(PipelineTest, memory_budget_throttles_sources) {
+    ////////////////////////////////////////////////////////////////////////////////
+    // PURPOSE
+    // Checks that a source waits before producing while the pending buffers exceed the memory budget, without losing
+    // any data
+    const size_t buffer_num_bytes = 1000 * sizeof(EventCD);
+    Pipeline p(true);
+    p.set_memory_budget(3 * buffer_num_bytes, Pipeline::MemoryBudgetPolicy::ThrottleSources);
+    auto &s1 = p.add_stage(std::make_unique<EventBufferProducingStage>(20, 1000));
+    auto &s2 = p.add_stage(std::make_unique<Stage>(), s1);
+    size_t num_buffers = 0, max_memory_usage = 0;
+    s2.set_consuming_callback([&](const boost::any &) {
+        max_memory_usage = std::max(max_memory_usage, p.memory_usage());
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+        ++num_buffers;
+    });
+    p.run();
+
+    EXPECT_EQ(Pipeline::Status::Completed, p.status());
+    EXPECT_EQ(size_t(20), num_buffers);
+    EXPECT_EQ(size_t(0), s2.num_dropped_inputs());
+    // the budget may be exceeded by the buffer produced when it was not yet
+    EXPECT_GE(4 * buffer_num_bytes, max_memory_usage);
+    EXPECT_EQ(size_t(0), p.memory_usage());
+}
+
+TEST(PipelineTest, memory_budget_drops_best_effort_inputs) {
+    ////////////////////////////////////////////////////////////////////////////////
+    // PURPOSE
+    // Checks that the inputs of a best effort stage are coalesced while the memory budget is exceeded, the other
+    // stages consuming all the data
+    struct GatedBufferProducingStage : public MockProducingStage {
+        bool produce_impl() override {
+            produce(EventBuffer(100));
+            while (!consuming_ && !stopped_) {
+                std::this_thread::yield();
+            }
+            for (int i = 1; i < 10; ++i) {
+                produce(EventBuffer(100));
+            }
+            produced_ = true;
+            return false;
+        }
+        std::atomic<bool> consuming_{false};
+        std::atomic<bool> produced_{false};
+    };
+
+    Pipeline p(true);
+    p.set_memory_budget(1, Pipeline::MemoryBudgetPolicy::DropBestEffortInputs);
+    auto &s1 = p.add_stage(std::make_unique<GatedBufferProducingStage>());
+    auto &s2 = p.add_stage(std::make_unique<Stage>(), s1);
+    auto &s3 = p.add_stage(std::make_unique<Stage>(), s1);
+    s3.set_priority(BaseStage::Priority::BestEffort);
+
+    // both consumers are busy with the first buffer while the others are produced
+    std::atomic<int> num_consuming{0};
+    auto make_consuming_cb = [&](size_t &num_buffers) {
+        return [&](const boost::any &) {
+            if (num_buffers++ == 0) {
+                if (++num_consuming == 2) {
+                    s1.consuming_ = true;
+                }
+                while (!s1.produced_) {
+                    std::this_thread::yield();
+                }
+            }
+        };
+    };
+    size_t num_buffers2 = 0, num_buffers3 = 0;
+    s2.set_consuming_callback(make_consuming_cb(num_buffers2));
+    s3.set_consuming_callback(make_consuming_cb(num_buffers3));
+    p.run();
+
+    EXPECT_EQ(Pipeline::Status::Completed, p.status());
+    EXPECT_EQ(size_t(10), num_buffers2);
+    EXPECT_EQ(size_t(2), num_buffers3);
+    EXPECT_EQ(size_t(8), s3.num_dropped_inputs());
+}
+
+TEST(PipelineTest, memory_budget_cannot_be_changed_once_started) {
+    ////////////////////////////////////////////////////////////////////////////////
+    // PURPOSE
+    // Checks that the memory budget can only be set before the pipeline is started
+    Pipeline p(true);
+    auto &s1 = p.add_stage(std::make_unique<VectorProducingStage>(std::vector<int>{1, 2, 3}));
+    p.add_stage(std::make_unique<MockConsumingStage>(), s1);
+    p.set_memory_budget(1024);
+    p.step();
+    EXPECT_THROW(p.set_memory_budget(0), std::runtime_error);
+    p.run();
+}
+
+TEST(PipelineTest, statistics_of_stages) {
+    ////////////////////////////////////////////////////////////////////////////////
+    // PURPOSE
+    // Checks that the statistics account for the data consumed by each stage and the time spent running its tasks
+    Pipeline p(true);
+    p.enable_statistics();
+    auto &s1 = p.add_stage(std::make_unique<EventBufferProducingStage>(10, 5));
+    auto &s2 = p.add_stage(std::make_unique<Stage>(), s1);
+    s2.set_name("consumer");
+    s2.set_consuming_callback([](const boost::any &) { std::this_thread::sleep_for(std::chrono::microseconds(10)); });
+    p.run();
+
+    EXPECT_TRUE(p.statistics_enabled());
+    const auto stats = p.statistics();
+    ASSERT_EQ(size_t(2), stats.size());
+    EXPECT_EQ("stage_0", stats[0].name);
+    EXPECT_EQ(uint64_t(0), stats[0].num_buffers);
+    EXPECT_EQ("consumer", stats[1].name);
+    EXPECT_EQ(uint64_t(10), stats[1].num_buffers);
+    EXPECT_EQ(uint64_t(50), stats[1].num_events);
+    EXPECT_LE(uint64_t(10), stats[1].num_tasks);
+    EXPECT_LE(uint64_t(10 * 10000), stats[1].consume_time_ns);
+    EXPECT_LE(uint64_t(10000), stats[1].max_consume_time_ns);
+    EXPECT_GE(stats[1].queue_wait_time_ns, stats[1].max_queue_wait_time_ns);
+    // the percentiles are estimated with a relative error below 4%
+    EXPECT_LE(uint64_t(9600), stats[1].consume_time_p50_ns);
+    EXPECT_LE(stats[1].consume_time_p50_ns, stats[1].consume_time_p99_ns);
+    EXPECT_LE(stats[1].consume_time_p99_ns, stats[1].max_consume_time_ns);
+    EXPECT_LE(stats[1].consume_time_p50_ns, stats[1].latency_p50_ns);
+    EXPECT_LE(stats[1].consume_time_p99_ns, stats[1].latency_p99_ns);
+    EXPECT_EQ(size_t(0), stats[1].backlog);
+    EXPECT_EQ(size_t(0), stats[1].num_dropped);
+}
+
+TEST(PipelineTest, statistics_callback) {
+    ////////////////////////////////////////////////////////////////////////////////
+    // PURPOSE
+    // Checks that the statistics callback is called while the pipeline runs and when it stops
+    std::vector<int> datas1(100);
+    std::iota(datas1.begin(), datas1.end(), 0);
+    Pipeline p;
+    auto &s1 = p.add_stage(std::make_unique<VectorProducingStage>(datas1));
+    p.add_stage(std::make_unique<MockConsumingStage>(), s1);
+    size_t num_calls = 0;
+    std::vector<StageStatistics> last_stats;
+    p.set_statistics_callback(
+        [&](const std::vector<StageStatistics> &stats) {
+            ++num_calls;
+            last_stats = stats;
+        },
+        std::chrono::milliseconds(0));
+    p.run();
+
+    EXPECT_TRUE(p.statistics_enabled());
+    EXPECT_LE(size_t(2), num_calls);
+    ASSERT_EQ(size_t(2), last_stats.size());
+    EXPECT_EQ(uint64_t(100), last_stats[1].num_buffers);
+    EXPECT_EQ(size_t(0), last_stats[1].backlog);
+}
+
+TEST(PipelineTest, statistics_callback_replaced_from_itself) {
+    ////////////////////////////////////////////////////////////////////////////////
+    // PURPOSE
+    // Checks that the statistics callback can replace itself, as it is called without the lock of the pipeline
+    std::vector<int> datas1(100);
+    std::iota(datas1.begin(), datas1.end(), 0);
+    Pipeline p;
+    auto &s1 = p.add_stage(std::make_unique<VectorProducingStage>(datas1));
+    p.add_stage(std::make_unique<MockConsumingStage>(), s1);
+    size_t num_first_calls = 0, num_second_calls = 0;
+    auto second_cb = [&](const std::vector<StageStatistics> &) { ++num_second_calls; };
+    p.set_statistics_callback(
+        [&](const std::vector<StageStatistics> &) {
+            ++num_first_calls;
+            p.set_statistics_callback(second_cb, std::chrono::milliseconds(0));
+        },
+        std::chrono::milliseconds(0));
+    p.run();
+
+    EXPECT_EQ(size_t(1), num_first_calls);
+    EXPECT_LE(size_t(1), num_second_calls);
+}
+
+TEST(PipelineTest, statistics_in_metrics_registry) {
+    ////////////////////////////////////////////////////////////////////////////////
+    // PURPOSE
+    // Checks that the statistics of the stages are reported in the metrics registry until the pipeline is destroyed
+    auto find_buffers = [](const std::vector<MetricSample> &samples) {
+        return std::find_if(samples.cbegin(), samples.cend(), [](const MetricSample &s) {
+            return s.name_ == "metavision_pipeline_stage_buffers_total" && s.labels_.size() == 2 &&
+                   s.labels_[0].second == "gtest_pipeline" && s.labels_[1].second == "consumer";
+        });
+    };
+    {
+        std::vector<int> datas1(100);
+        std::iota(datas1.begin(), datas1.end(), 0);
+        Pipeline p;
+        auto &s1 = p.add_stage(std::make_unique<VectorProducingStage>(datas1));
+        p.add_stage(std::make_unique<MockConsumingStage>(), s1).set_name("consumer");
+        p.register_metrics("gtest_pipeline");
+        p.run();
+
+        const auto samples = MetricsRegistry::instance().snapshot();
+        auto it            = find_buffers(samples);
+        ASSERT_NE(samples.cend(), it);
+        EXPECT_EQ(MetricSample::Type::Counter, it->type_);
+        EXPECT_EQ(100., it->value_);
+    }
+    const auto samples = MetricsRegistry::instance().snapshot();
+    EXPECT_EQ(samples.cend(), find_buffers(samples));
+}
+
+TEST(PipelineTest, statistics_to_prometheus_text) {
+    ////////////////////////////////////////////////////////////////////////////////
+    // PURPOSE
+    // Checks the formatting of the statistics in the Prometheus text exposition format
+    StageStatistics stats;
+    stats.name            = "display \"main\"";
+    stats.num_buffers     = 12;
+    stats.consume_time_ns = 1500000000;
+    stats.backlog         = 3;
+
+    const std::string text = to_prometheus_text({stats}, "mv");
+
+    EXPECT_NE(std::string::npos, text.find("# TYPE mv_buffers_total counter\n"));
+    EXPECT_NE(std::string::npos, text.find("mv_buffers_total{stage=\"display \\\"main\\\"\"} 12\n"));
+    EXPECT_NE(std::string::npos, text.find("mv_consume_seconds_total{stage=\"display \\\"main\\\"\"} 1.5\n"));
+    EXPECT_NE(std::string::npos, text.find("# TYPE mv_backlog gauge\n"));
+    EXPECT_NE(std::string::npos, text.find("mv_backlog{stage=\"display \\\"main\\\"\"} 3\n"));
+}
+
+#ifdef __linux__
+TEST(PipelineTest, thread_policy_of_processing_threads) {
+    ////////////////////////////////////////////////////////////////////////////////
+    // PURPOSE
+    // Checks that the threading policy is applied to the processing threads running the stages
+    struct ThreadNameStage : public BaseStage {
+        ThreadNameStage() {
+            set_consuming_callback([this](const boost::any &) {
+                char name[16];
+                pthread_getname_np(pthread_self(), name, sizeof(name));
+                names.emplace_back(name);
+            });
+        }
+        std::vector<std::string> names;
+    };
+
+    Pipeline p(true);
+    ThreadPolicy policy;
+    policy.name_ = "mv_test";
+    p.set_thread_policy(policy);
+    auto &s1 = p.add_stage(std::make_unique<VectorProducingStage>(std::vector<int>{1, 2}));
+    auto &s2 = p.add_stage(std::make_unique<ThreadNameStage>(), s1);
+    p.run();
+
+    EXPECT_EQ(Pipeline::Status::Completed, p.status());
+    ASSERT_EQ(2u, s2.names.size());
+    EXPECT_EQ(0u, s2.names[0].find("mv_test_"));
+    EXPECT_EQ(s2.names[0], s2.names[1]);
+}
+
+TEST(PipelineTest, dedicated_thread_of_stage) {
+    ////////////////////////////////////////////////////////////////////////////////
+    // PURPOSE
+    // Checks that a stage given a dedicated thread is run by a thread of its own with its policy, the other stages
+    // being run by the pool of workers
+    struct ThreadStage : public BaseStage {
+        ThreadStage() {
+            set_consuming_callback([this](const boost::any &) {
+                char name[16];
+                pthread_getname_np(pthread_self(), name, sizeof(name));
+                names.emplace_back(name);
+                cpu_set_t cpus;
+                CPU_ZERO(&cpus);
+                pthread_getaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+                num_cpus.emplace_back(CPU_COUNT(&cpus));
+                thread_ids.emplace_back(std::this_thread::get_id());
+            });
+        }
+        std::vector<std::string> names;
+        std::vector<int> num_cpus;
+        std::vector<std::thread::id> thread_ids;
+    };
+
+    Pipeline p(true, Pipeline::SchedulingPolicy::WorkStealing, 2);
+    auto &s1 = p.add_stage(std::make_unique<VectorProducingStage>(std::vector<int>{1, 2, 3}));
+    auto &s2 = p.add_stage(std::make_unique<ThreadStage>(), s1);
+    auto &s3 = p.add_stage(std::make_unique<ThreadStage>(), s1);
+    ThreadPolicy policy;
+    policy.name_         = "mv_dedicated";
+    policy.cpu_affinity_ = {0};
+    EXPECT_FALSE(s2.has_dedicated_thread());
+    EXPECT_TRUE(s2.set_dedicated_thread(policy));
+    EXPECT_TRUE(s2.has_dedicated_thread());
+    EXPECT_EQ(std::vector<unsigned int>{0}, s2.dedicated_thread_policy().cpu_affinity_);
+    p.run();
+
+    EXPECT_EQ(Pipeline::Status::Completed, p.status());
+    ASSERT_EQ(3u, s2.names.size());
+    ASSERT_EQ(3u, s3.names.size());
+    for (size_t i = 0; i < 3; ++i) {
+        EXPECT_EQ("mv_dedicated", s2.names[i]);
+        EXPECT_EQ(1, s2.num_cpus[i]);
+        EXPECT_EQ(s2.thread_ids[0], s2.thread_ids[i]);
+        EXPECT_EQ(0u, s3.names[i].find("mv_pipeline_"));
+        EXPECT_NE(s2.thread_ids[0], s3.thread_ids[i]);
+    }
+}
+#endif
+
 TEST(PipelineTest, cancel_when_consuming_with_undetached_consumer) {
     ////////////////////////////////////////////////////////////////////////////////
     // PURPOSE
@@ -574,15 +1140,17 @@ TEST(PipelineTest, cancel_with_no_remaining_tasks_on_main_thread) {
     auto &s3 = p.add_stage(std::make_unique<Stage>(), s1);
     std::atomic<bool> run{false};
     // clang-format off
-    std::thread([&run, &p] {
+    std::thread cancel_thread([&run, &p] {
         while (!run) {
         }
         p.cancel();
-    }).detach();
+    });
     // clang-format on
     while (p.step()) {
         run = true;
     }
+    // the pipeline must outlive the call to cancel
+    cancel_thread.join();
     EXPECT_EQ(Pipeline::Status::Cancelled, p.status());
 }
 
@@ -734,4 +1302,75 @@ TEST(PipelineTest, on_setup_callback_is_called) {
     // THEN all the callbacks are called
     EXPECT_TRUE(has_setup_cb_been_called);
     EXPECT_TRUE(has_pre_step_cb_been_called);
-}
\ No newline at end of file
+}
+
+TEST(PipelineTest, idle_main_thread_waits_instead_of_spinning) {
+    ////////////////////////////////////////////////////////////////////////////////
+    // PURPOSE
+    // Checks that the main thread sleeps when it has nothing to run, and is woken up when the pipeline is done
+    Pipeline p(true);
+    auto &s1 = p.add_stage(std::make_unique<VectorProducingStage>(std::vector<int>{1, 2, 3}));
+    auto &s2 = p.add_stage(std::make_unique<Stage>(), s1);
+    s2.set_consuming_callback([](const boost::any &) { std::this_thread::sleep_for(std::chrono::milliseconds(50)); });
+    size_t num_steps = 0;
+    p.add_post_step_callback([&]() { ++num_steps; });
+    p.set_step_timeout(std::chrono::seconds(10));
+
+    // WHEN running the pipeline, whose stages run on processing threads for 150ms
+    const auto start = std::chrono::steady_clock::now();
+    p.run();
+    const auto duration = std::chrono::steady_clock::now() - start;
+
+    // THEN the main thread does not step continuously, and does not wait for the timeout once the stages completed
+    EXPECT_GT(std::chrono::seconds(5), duration);
+    EXPECT_GT(size_t(50), num_steps);
+    EXPECT_EQ(Pipeline::Status::Completed, p.status());
+}
+
+TEST(PipelineTest, main_thread_wait_callbacks) {
+    ////////////////////////////////////////////////////////////////////////////////
+    // PURPOSE
+    // Checks that the main thread waits with the given callbacks, which are interrupted when it has a task to run
+    struct SlowProducingStage : public VectorProducingStage {
+        SlowProducingStage() : VectorProducingStage({1, 2, 3}) {}
+        bool produce_impl() override {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            return VectorProducingStage::produce_impl();
+        }
+    };
+    Pipeline p(true);
+    auto &s1 = p.add_stage(std::make_unique<SlowProducingStage>());
+    auto &s2 = p.add_stage(std::make_unique<MockConsumingStage>(), s1);
+    s2.detach();
+    auto &s3 = p.add_stage(std::make_unique<Stage>(false), s1);
+    std::vector<int> datas;
+    s3.set_consuming_callback([&](const boost::any &data) { datas.emplace_back(boost::any_cast<int>(data)); });
+
+    std::mutex mutex;
+    std::condition_variable cond;
+    bool woken_up     = false;
+    size_t num_waits = 0;
+    p.set_step_timeout(std::chrono::seconds(10));
+    p.set_main_thread_wait_callbacks(
+        [&](std::chrono::milliseconds timeout) {
+            EXPECT_EQ(std::chrono::milliseconds(10000), timeout);
+            std::unique_lock<std::mutex> lock(mutex);
+            ++num_waits;
+            cond.wait_for(lock, timeout, [&]() { return woken_up; });
+            woken_up = false;
+        },
+        [&]() {
+            std::lock_guard<std::mutex> lock(mutex);
+            woken_up = true;
+            cond.notify_all();
+        });
+
+    // WHEN running the pipeline
+    const auto start = std::chrono::steady_clock::now();
+    p.run();
+
+    // THEN the tasks of the main thread are run without waiting for the timeout
+    EXPECT_GT(std::chrono::seconds(5), std::chrono::steady_clock::now() - start);
+    EXPECT_EQ(std::vector<int>({1, 2, 3}), datas);
+    EXPECT_LE(size_t(1), num_waits);
+}
@@ -12,6 +12,7 @@
 #include <gtest/gtest.h>
 
 #include "metavision/sdk/base/events/event2d.h"
+#include "metavision/sdk/base/events/event_cd.h"
 #include "metavision/sdk/core/algorithms/polarity_filter_algorithm.h"
 
 using namespace Metavision;
@@ -137,3 +138,81 @@ TYPED_TEST(PolarityFilterAlgorithm_GTest, test_some_valid_some_invalid) {
     ASSERT_NE(this->input_.size(), this->output_.size());
     ASSERT_EQ(this->output_.size(), number_valid);
 }
+
+TEST(PolarityFilterAlgorithmSoA_GTest, process_soa_buffer) {
+    // GIVEN a buffer of events of both polarities stored as a structure of arrays
+    PolarityFilterAlgorithm algo(1);
+    EventCDBufferSoA input, output;
+    for (unsigned short i = 0; i < 20; ++i) {
+        input.push_back(i, 2 * i, i % 3 == 0, 10 * i);
+    }
+
+    // WHEN filtering it, to another buffer and in place
+    algo.process_events(input, output);
+    algo.process_events(input, input);
+
+    // THEN only the events of the requested polarity are kept, in order
+    for (auto &buffer : {output, input}) {
+        ASSERT_EQ(7, buffer.size());
+        for (size_t i = 0; i < buffer.size(); ++i) {
+            EXPECT_EQ(3 * i, buffer.x()[i]);
+            EXPECT_EQ(6 * i, buffer.y()[i]);
+            EXPECT_EQ(1, buffer.p()[i]);
+            EXPECT_EQ(30 * i, buffer.t()[i]);
+        }
+    }
+}
+
+TEST(PolarityFilterAlgorithmCompact_GTest, process_compact_buffer) {
+    // GIVEN a buffer of compact events of both polarities
+    PolarityFilterAlgorithm algo(1);
+    EventCDCompactBuffer input, output;
+    for (unsigned short i = 0; i < 20; ++i) {
+        input.push_back(EventCD(i, 2 * i, i % 3 == 0, 1000 + 10 * i));
+    }
+
+    // WHEN filtering it, to another buffer and in place
+    algo.process_events(input, output);
+    algo.process_events(input, input);
+
+    // THEN only the events of the requested polarity are kept, in order
+    for (auto &buffer : {output, input}) {
+        ASSERT_EQ(7, buffer.size());
+        EXPECT_EQ(1000, buffer.base_time());
+        for (size_t i = 0; i < buffer.size(); ++i) {
+            const EventCD ev = buffer.get_event(i);
+            EXPECT_EQ(3 * i, ev.x);
+            EXPECT_EQ(6 * i, ev.y);
+            EXPECT_EQ(1, ev.p);
+            EXPECT_EQ(1000 + 30 * i, ev.t);
+        }
+    }
+}
+
+TEST(PolarityFilterAlgorithm_GTest, process_batches) {
+    // GIVEN more events than a batch, with random polarities, the last batch being incomplete
+    PolarityFilterAlgorithm algo(1);
+    std::vector<EventCD> input;
+    for (int i = 0; i < 1003; ++i) {
+        input.emplace_back(i % 640, i % 480, (i * 7919) % 11 < 5, i);
+    }
+    std::vector<EventCD> expected;
+    std::copy_if(input.cbegin(), input.cend(), std::back_inserter(expected), [](const EventCD &ev) { return ev.p; });
+
+    // WHEN filtering them into a pre-sized buffer and in place
+    std::vector<EventCD> output(input.size());
+    output.resize(std::distance(output.begin(), algo.process_events(input.cbegin(), input.cend(), output.begin())));
+    std::vector<EventCD> inplace = input;
+    inplace.resize(
+        std::distance(inplace.begin(), algo.process_events(inplace.begin(), inplace.end(), inplace.begin())));
+
+    // THEN only the events of the requested polarity are kept, in order
+    for (auto &events : {output, inplace}) {
+        ASSERT_EQ(expected.size(), events.size());
+        for (size_t i = 0; i < expected.size(); ++i) {
+            EXPECT_EQ(expected[i].x, events[i].x);
+            EXPECT_EQ(expected[i].p, events[i].p);
+            EXPECT_EQ(expected[i].t, events[i].t);
+        }
+    }
+}
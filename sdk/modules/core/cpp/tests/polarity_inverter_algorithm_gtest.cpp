@@ -0,0 +1,61 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <gtest/gtest.h>
+#include <iterator>
+#include <vector>
+
+#include "metavision/sdk/base/events/event2d.h"
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/core/algorithms/polarity_inverter_algorithm.h"
+
+using namespace Metavision;
+
+TEST(PolarityInverterAlgorithm_GTest, function_call_operator) {
+    // GIVEN a PolarityInverterAlgorithm instance
+    PolarityInverterAlgorithm algo;
+
+    // WHEN processing events of both polarities
+    Event2d ev_on(10, 20, 1, 100), ev_off(10, 20, 0, 100);
+    algo(ev_on);
+    algo(ev_off);
+
+    // THEN their polarity is inverted
+    EXPECT_EQ(0, ev_on.p);
+    EXPECT_EQ(1, ev_off.p);
+}
+
+TEST(PolarityInverterAlgorithm_GTest, process_batches) {
+    // GIVEN more events than a batch, the last batch being incomplete
+    PolarityInverterAlgorithm algo;
+    std::vector<EventCD> input_events;
+    for (int i = 0; i < 37; ++i) {
+        input_events.emplace_back(i, 2 * i, (i / 3) % 2, 1000 + i);
+    }
+
+    // WHEN processing the events into a pre-sized buffer, in place and with a back inserter
+    std::vector<EventCD> output_events(input_events.size()), inserted_events;
+    algo.process_events(input_events.cbegin(), input_events.cend(), output_events.begin());
+    std::vector<EventCD> inplace_events = input_events;
+    algo.process_events(inplace_events.begin(), inplace_events.end(), inplace_events.begin());
+    algo.process_events(input_events.cbegin(), input_events.cend(), std::back_inserter(inserted_events));
+
+    // THEN only the polarities are inverted
+    for (auto &events : {output_events, inplace_events, inserted_events}) {
+        ASSERT_EQ(input_events.size(), events.size());
+        for (size_t i = 0; i < input_events.size(); ++i) {
+            EXPECT_EQ(input_events[i].x, events[i].x);
+            EXPECT_EQ(input_events[i].y, events[i].y);
+            EXPECT_EQ(1 - input_events[i].p, events[i].p);
+            EXPECT_EQ(input_events[i].t, events[i].t);
+        }
+    }
+}
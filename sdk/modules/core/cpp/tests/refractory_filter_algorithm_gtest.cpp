@@ -0,0 +1,153 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <iterator>
+#include <list>
+#include <stdexcept>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "metavision/sdk/core/algorithms/refractory_filter_algorithm.h"
+
+using namespace Metavision;
+
+namespace {
+
+void expect_same_events(const std::vector<EventCD> &expected, const std::vector<EventCD> &actual) {
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(expected[i].x, actual[i].x);
+        EXPECT_EQ(expected[i].y, actual[i].y);
+        EXPECT_EQ(expected[i].p, actual[i].p);
+        EXPECT_EQ(expected[i].t, actual[i].t);
+    }
+}
+
+} // namespace
+
+TEST(RefractoryFilterAlgorithm_GTest, invalid_arguments) {
+    EXPECT_THROW(RefractoryFilterAlgorithm(0, 480, 100), std::invalid_argument);
+    EXPECT_THROW(RefractoryFilterAlgorithm(640, 480, -1), std::invalid_argument);
+    EXPECT_THROW(RefractoryFilterAlgorithm(640, 480, 100, true, 0), std::invalid_argument);
+    // The refractory period must fit in the range of the 16 bits offsets
+    EXPECT_THROW(RefractoryFilterAlgorithm16(640, 480, 40000), std::invalid_argument);
+    EXPECT_NO_THROW(RefractoryFilterAlgorithm16(640, 480, 40000, true, 10));
+
+    RefractoryFilterAlgorithm algo(640, 480, 100);
+    EXPECT_THROW(algo.set_refractory_period(-10), std::invalid_argument);
+    EXPECT_EQ(100, algo.get_refractory_period());
+}
+
+TEST(RefractoryFilterAlgorithm_GTest, drops_events_within_refractory_period) {
+    RefractoryFilterAlgorithm algo(10, 10, 100);
+    EXPECT_TRUE(algo.is_separating_polarities());
+    const std::vector<EventCD> input = {
+        {1, 1, 1, 1000}, // kept
+        {1, 1, 1, 1050}, // dropped
+        {1, 1, 0, 1060}, // other polarity, kept
+        {2, 1, 1, 1070}, // other pixel, kept
+        {1, 1, 1, 1099}, // dropped, the period starting from the last event kept
+        {1, 1, 1, 1100}, // kept
+    };
+
+    std::vector<EventCD> output;
+    algo.process_events(input.cbegin(), input.cend(), std::back_inserter(output));
+    expect_same_events({{1, 1, 1, 1000}, {1, 1, 0, 1060}, {2, 1, 1, 1070}, {1, 1, 1, 1100}}, output);
+
+    // The state is kept between the calls, until reset
+    const std::vector<EventCD> next = {{1, 1, 1, 1150}};
+    output.clear();
+    algo.process_events(next.cbegin(), next.cend(), std::back_inserter(output));
+    EXPECT_TRUE(output.empty());
+
+    algo.reset();
+    algo.process_events(next.cbegin(), next.cend(), std::back_inserter(output));
+    expect_same_events(next, output);
+}
+
+TEST(RefractoryFilterAlgorithm_GTest, polarities_sharing_refractory_period) {
+    RefractoryFilterAlgorithm algo(10, 10, 100, false);
+    EXPECT_FALSE(algo.is_separating_polarities());
+    const std::vector<EventCD> input = {{1, 1, 1, 1000}, {1, 1, 0, 1060}, {1, 1, 0, 1100}};
+
+    std::vector<EventCD> output;
+    algo.process_events(input.cbegin(), input.cend(), std::back_inserter(output));
+    expect_same_events({{1, 1, 1, 1000}, {1, 1, 0, 1100}}, output);
+}
+
+TEST(RefractoryFilterAlgorithm_GTest, long_recordings_with_16_bits_offsets) {
+    // With a 100us resolution, the 16 bits offsets span about 3.2s, after which the epoch is moved forward
+    RefractoryFilterAlgorithm16 algo(4, 4, 1000, true, 100);
+    std::vector<EventCD> input, expected;
+    for (timestamp t = 0; t < 20'000'000; t += 400) {
+        input.emplace_back(1, 2, 0, t);
+        if (t % 1200 == 0) {
+            expected.emplace_back(1, 2, 0, t);
+        }
+    }
+    // A pixel without event for much longer than the range of the offsets
+    input.emplace_back(3, 3, 1, 20'000'000);
+    expected.emplace_back(3, 3, 1, 20'000'000);
+
+    std::vector<EventCD> output;
+    algo.process_events(input.cbegin(), input.cend(), std::back_inserter(output));
+    expect_same_events(expected, output);
+}
+
+TEST(RefractoryFilterAlgorithm_GTest, all_buffers_give_same_events) {
+    const int width = 32, height = 16;
+    std::vector<EventCD> input;
+    for (size_t i = 0; i < 20000; ++i) {
+        input.emplace_back(static_cast<unsigned short>((i * 7) % width), static_cast<unsigned short>((i * 3) % height),
+                           static_cast<short>((i / 5) % 2), static_cast<timestamp>(i));
+    }
+
+    for (bool separate_polarities : {true, false}) {
+        RefractoryFilterAlgorithm algo_ref(width, height, 300, separate_polarities);
+        const std::list<EventCD> input_list(input.cbegin(), input.cend());
+        std::vector<EventCD> expected;
+        algo_ref.process_events(input_list.cbegin(), input_list.cend(), std::back_inserter(expected));
+        EXPECT_LT(expected.size(), input.size());
+        EXPECT_GT(expected.size(), 0u);
+
+        RefractoryFilterAlgorithm algo(width, height, 300, separate_polarities);
+        std::vector<EventCD> actual(input.size());
+        actual.resize(std::distance(actual.begin(), algo.process_events(input.cbegin(), input.cend(), actual.begin())));
+        expect_same_events(expected, actual);
+
+        algo.reset();
+        actual = input;
+        actual.resize(std::distance(actual.begin(), algo.process_events(actual.begin(), actual.end(), actual.begin())));
+        expect_same_events(expected, actual);
+
+        algo.reset();
+        EventCDBufferSoA soa_input, soa_output;
+        soa_input.assign(input.cbegin(), input.cend());
+        algo.process_events(soa_input, soa_output);
+        actual.clear();
+        soa_output.copy_to(std::back_inserter(actual));
+        expect_same_events(expected, actual);
+
+        algo.reset();
+        EventCDCompactBuffer compact_input, compact_output;
+        compact_input.assign(input.cbegin(), input.cend());
+        algo.process_events(compact_input, compact_output);
+        actual.clear();
+        compact_output.copy_to(std::back_inserter(actual));
+        expect_same_events(expected, actual);
+
+        algo.reset();
+        algo.process_events(compact_input, compact_input);
+        actual.clear();
+        compact_input.copy_to(std::back_inserter(actual));
+        expect_same_events(expected, actual);
+    }
+}
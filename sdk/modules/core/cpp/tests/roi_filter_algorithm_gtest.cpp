@@ -198,3 +198,59 @@ TYPED_TEST(RoiFilterAlgorithm_GTest, test_some_valid_some_outside_border) {
     ASSERT_NE(this->input_.size(), this->output_.size());
     ASSERT_EQ(this->output_.size(), number_valid);
 }
+
+TEST(RoiFilterAlgorithmSoA_GTest, process_soa_buffer) {
+    // GIVEN a buffer of events along the diagonal stored as a structure of arrays
+    EventCDBufferSoA input;
+    for (unsigned short i = 0; i < 50; ++i) {
+        input.push_back(i, i, i % 2, i);
+    }
+
+    for (bool relative : {false, true}) {
+        // WHEN filtering it with a ROI, to another buffer and in place
+        RoiFilterAlgorithm algo(10, 12, 20, 30, relative);
+        EventCDBufferSoA output, in_place = input;
+        algo.process_events(input, output);
+        algo.process_events(in_place, in_place);
+
+        // THEN only the events in the ROI are kept, with coordinates expressed as requested
+        for (auto &buffer : {output, in_place}) {
+            ASSERT_EQ(9, buffer.size());
+            for (size_t i = 0; i < buffer.size(); ++i) {
+                EXPECT_EQ(12 + i - (relative ? 10 : 0), buffer.x()[i]);
+                EXPECT_EQ(12 + i - (relative ? 12 : 0), buffer.y()[i]);
+                EXPECT_EQ((12 + i) % 2, buffer.p()[i]);
+                EXPECT_EQ(12 + i, buffer.t()[i]);
+            }
+        }
+    }
+}
+
+TEST(RoiFilterAlgorithmCompact_GTest, process_compact_buffer) {
+    // GIVEN a buffer of compact events along the diagonal
+    EventCDCompactBuffer input;
+    for (unsigned short i = 0; i < 50; ++i) {
+        input.push_back(EventCD(i, i, i % 2, 1000 + i));
+    }
+
+    for (bool relative : {false, true}) {
+        // WHEN filtering it with a ROI, to another buffer and in place
+        RoiFilterAlgorithm algo(10, 12, 20, 30, relative);
+        EventCDCompactBuffer output, in_place = input;
+        algo.process_events(input, output);
+        algo.process_events(in_place, in_place);
+
+        // THEN only the events in the ROI are kept, with coordinates expressed as requested
+        for (auto &buffer : {output, in_place}) {
+            ASSERT_EQ(9, buffer.size());
+            EXPECT_EQ(1000, buffer.base_time());
+            for (size_t i = 0; i < buffer.size(); ++i) {
+                const EventCD ev = buffer.get_event(i);
+                EXPECT_EQ(12 + i - (relative ? 10 : 0), ev.x);
+                EXPECT_EQ(12 + i - (relative ? 12 : 0), ev.y);
+                EXPECT_EQ((12 + i) % 2, ev.p);
+                EXPECT_EQ(1012 + i, ev.t);
+            }
+        }
+    }
+}
@@ -14,6 +14,7 @@
 #include <random>
 #include <vector>
 
+#include "metavision/sdk/base/events/event_ext_trigger.h"
 #include "metavision/sdk/core/algorithms/shared_cd_events_buffer_producer_algorithm.h"
 
 struct SharedCdBufferEvent {
@@ -261,3 +262,50 @@ TEST_F(SharedCdEventsBufferProducer_Gtest, shared_cd_buffer_producer_none_policy
     ASSERT_EQ(data.back().t + 1, produced[0].t);
     ASSERT_EQ(data.size(), produced[0].data_->size());
 }
+
+TEST_F(SharedCdEventsBufferProducer_Gtest, shared_cd_buffer_producer_trigger_slicing) {
+    // GIVEN A buffer producer slicing on the rising edges of the triggers, the time slice being ignored
+    Metavision::SharedEventsBufferProducerParameters params;
+    params.buffers_pool_size_       = 10;
+    params.buffers_trigger_slicing_ = true;
+
+    std::vector<SharedCdBufferEvent> produced;
+    Metavision::SharedCdEventsBufferProducerAlgorithm producer(params, [&](Metavision::timestamp ts, const auto &ev) {
+        produced.push_back({ts, ev});
+    });
+
+    // WHEN processing triggers ahead of the events they slice, including a falling edge and two close rising edges
+    std::vector<Metavision::EventExtTrigger> triggers{{1, 100, 0}, {0, 150, 0}, {1, 300, 0}, {1, 310, 0}};
+    producer.process_trigger_events(triggers.cbegin(), triggers.cend());
+    std::vector<Metavision::EventCD> data{{0, 0, 0, 50},  {0, 0, 0, 99},  {0, 0, 0, 100}, {0, 0, 0, 200},
+                                          {0, 0, 0, 299}, {0, 0, 0, 320}, {0, 0, 0, 400}};
+    producer.process_events(data.cbegin(), data.cend());
+
+    // THEN one buffer is produced per rising edge, with the events before it, even when it is empty
+    ASSERT_EQ(3, produced.size());
+    ASSERT_EQ(100, produced[0].t);
+    ASSERT_EQ(2, produced[0].data_->size());
+    ASSERT_EQ(300, produced[1].t);
+    ASSERT_EQ(3, produced[1].data_->size());
+    ASSERT_EQ(100, produced[1].data_->front().t);
+    ASSERT_EQ(310, produced[2].t);
+    ASSERT_TRUE(produced[2].data_->empty());
+
+    // WHEN processing a trigger received after the events past it
+    std::vector<Metavision::EventExtTrigger> late_trigger{{1, 380, 0}};
+    producer.process_trigger_events(late_trigger.cbegin(), late_trigger.cend());
+
+    // THEN the current buffer is cut at the trigger
+    ASSERT_EQ(4, produced.size());
+    ASSERT_EQ(380, produced[3].t);
+    ASSERT_EQ(1, produced[3].data_->size());
+    ASSERT_EQ(320, produced[3].data_->front().t);
+
+    // WHEN flushing
+    producer.flush();
+
+    // THEN the events after the last trigger are produced
+    ASSERT_EQ(5, produced.size());
+    ASSERT_EQ(1, produced[4].data_->size());
+    ASSERT_EQ(400, produced[4].data_->front().t);
+}
@@ -0,0 +1,64 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <array>
+#include <functional>
+#include <memory>
+#include <gtest/gtest.h>
+
+#include "metavision/sdk/core/utils/detail/small_function.h"
+
+using Metavision::detail::SmallFunction;
+
+TEST(SmallFunction_GTest, empty_function_throws_when_called) {
+    SmallFunction<void()> f;
+    EXPECT_FALSE(f);
+    EXPECT_THROW(f(), std::bad_function_call);
+}
+
+TEST(SmallFunction_GTest, calls_small_and_large_callables) {
+    // GIVEN a callable stored inline and another one too large for that
+    int n                    = 0;
+    SmallFunction<void()> f  = [&n]() { ++n; };
+    std::array<int, 64> data = {};
+    data[0]                  = 3;
+    SmallFunction<int(int)> g = [data](int x) { return x + data[0]; };
+
+    // THEN both can be called, copied and moved
+    f();
+    auto f_copy = f;
+    f_copy();
+    EXPECT_EQ(2, n);
+
+    auto g_copy  = g;
+    auto g_moved = std::move(g);
+    EXPECT_FALSE(g);
+    EXPECT_EQ(4, g_copy(1));
+    EXPECT_EQ(5, g_moved(2));
+}
+
+TEST(SmallFunction_GTest, releases_the_captures) {
+    // GIVEN functions holding a reference to a shared object
+    auto object = std::make_shared<int>(1);
+    {
+        SmallFunction<int()> f = [object]() { return *object; };
+        SmallFunction<int()> g = f;
+        EXPECT_EQ(3, object.use_count());
+
+        // WHEN they are reset or destroyed
+        f = nullptr;
+        EXPECT_EQ(2, object.use_count());
+        EXPECT_EQ(1, g());
+    }
+
+    // THEN the captures are released
+    EXPECT_EQ(1, object.use_count());
+}
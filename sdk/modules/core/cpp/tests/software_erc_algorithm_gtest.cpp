@@ -0,0 +1,170 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/core/algorithms/software_erc_algorithm.h"
+
+using namespace Metavision;
+
+namespace {
+
+constexpr int Width  = 64;
+constexpr int Height = 64;
+
+// Events at 1 Mev/s, cycling over all the pixels
+std::vector<EventCD> make_events(timestamp begin, timestamp end) {
+    std::vector<EventCD> events;
+    for (timestamp t = begin; t < end; ++t) {
+        const int index = static_cast<int>(t % (Width * Height));
+        events.emplace_back(index % Width, index / Width, 0, t);
+    }
+    return events;
+}
+
+std::vector<EventCD> process(SoftwareErcAlgorithm &algo, const std::vector<EventCD> &events) {
+    std::vector<EventCD> output;
+    // Processes the events in buffers of 1000 events, as a camera would send them
+    for (size_t i = 0; i < events.size(); i += 1000) {
+        algo.process_events(events.cbegin() + i, events.cbegin() + std::min(events.size(), i + 1000),
+                            std::back_inserter(output));
+    }
+    return output;
+}
+
+} // namespace
+
+TEST(SoftwareErcAlgorithm_GTest, events_under_the_target_rate_are_all_kept) {
+    SoftwareErcConfig config;
+    config.target_rate_ev_per_s = 2e6;
+    SoftwareErcAlgorithm algo(Width, Height, config);
+
+    auto events = make_events(0, 200000);
+    auto output = process(algo, events);
+    EXPECT_EQ(events.size(), output.size());
+    EXPECT_DOUBLE_EQ(1., algo.get_keep_ratio());
+    EXPECT_NEAR(1e6, algo.get_input_rate(), 1e4);
+}
+
+TEST(SoftwareErcAlgorithm_GTest, events_are_decimated_uniformly_to_the_target_rate) {
+    SoftwareErcConfig config;
+    config.target_rate_ev_per_s = 250e3;
+    SoftwareErcAlgorithm algo(Width, Height, config);
+
+    // WHEN the rate of the events is 4 times the target
+    process(algo, make_events(0, 100000));
+    auto output = process(algo, make_events(100000, 500000));
+
+    // THEN a quarter of the events is kept, in time order
+    EXPECT_NEAR(0.25, algo.get_keep_ratio(), 0.01);
+    EXPECT_NEAR(100000, output.size(), 1000);
+    EXPECT_TRUE(std::is_sorted(output.begin(), output.end(),
+                               [](const EventCD &ev1, const EventCD &ev2) { return ev1.t < ev2.t; }));
+
+    // AND each pixel keeps a quarter of its events
+    std::vector<int> counts(Width * Height, 0);
+    for (const auto &ev : output) {
+        ++counts[ev.y * Width + ev.x];
+    }
+    const auto minmax = std::minmax_element(counts.begin(), counts.end());
+    EXPECT_LE(*minmax.second - *minmax.first, 2);
+
+    // AND the pixels do not keep their events in the same cycles
+    std::vector<timestamp> first_kept_t(Width * Height, -1);
+    for (const auto &ev : output) {
+        auto &t = first_kept_t[ev.y * Width + ev.x];
+        t       = (t < 0) ? ev.t : t;
+    }
+    const auto first_kept_minmax = std::minmax_element(first_kept_t.begin(), first_kept_t.end());
+    EXPECT_LE(0, *first_kept_minmax.first);
+    EXPECT_GT(*first_kept_minmax.second - *first_kept_minmax.first, 2 * Width * Height);
+}
+
+TEST(SoftwareErcAlgorithm_GTest, decimation_is_deterministic) {
+    SoftwareErcConfig config;
+    config.target_rate_ev_per_s = 300e3;
+    SoftwareErcAlgorithm algo1(Width, Height, config), algo2(Width, Height, config);
+
+    auto events  = make_events(0, 300000);
+    auto output1 = process(algo1, events);
+    auto output2 = process(algo2, events);
+    ASSERT_EQ(output1.size(), output2.size());
+    for (size_t i = 0; i < output1.size(); ++i) {
+        ASSERT_EQ(output1[i].t, output2[i].t);
+    }
+
+    // The same is true after a reset
+    algo1.reset();
+    auto output3 = process(algo1, events);
+    ASSERT_EQ(output1.size(), output3.size());
+}
+
+TEST(SoftwareErcAlgorithm_GTest, target_rate_follows_the_backlog) {
+    SoftwareErcConfig config;
+    config.target_rate_ev_per_s     = 2e6;
+    config.min_target_rate_ev_per_s = 100e3;
+    config.max_backlog              = 10;
+    SoftwareErcAlgorithm algo(Width, Height, config);
+    size_t backlog = 100;
+    algo.set_backlog_probe([&backlog]() { return backlog; });
+
+    // WHEN the downstream processing is behind
+    process(algo, make_events(0, 300000));
+
+    // THEN the target rate is lowered down to its minimum
+    EXPECT_DOUBLE_EQ(100e3, algo.get_target_rate());
+    EXPECT_NEAR(0.1, algo.get_keep_ratio(), 0.01);
+
+    // WHEN the downstream processing has caught up
+    backlog = 0;
+    process(algo, make_events(300000, 800000));
+
+    // THEN the target rate is raised back, and all the events are kept again
+    EXPECT_DOUBLE_EQ(2e6, algo.get_target_rate());
+    EXPECT_DOUBLE_EQ(1., algo.get_keep_ratio());
+}
+
+TEST(SoftwareErcAlgorithm_GTest, silence_restarts_the_estimation) {
+    SoftwareErcConfig config;
+    config.target_rate_ev_per_s = 250e3;
+    SoftwareErcAlgorithm algo(Width, Height, config);
+    process(algo, make_events(0, 100000));
+    ASSERT_NEAR(0.25, algo.get_keep_ratio(), 0.01);
+
+    // WHEN the events resume at a low rate after a silence
+    std::vector<EventCD> sparse_events;
+    for (timestamp t = 10000000; t < 10200000; t += 10) {
+        sparse_events.emplace_back(0, 0, 0, t);
+    }
+    auto output = process(algo, sparse_events);
+
+    // THEN they are soon all kept
+    EXPECT_DOUBLE_EQ(1., algo.get_keep_ratio());
+    EXPECT_GT(output.size(), sparse_events.size() * 9 / 10);
+}
+
+TEST(SoftwareErcAlgorithm_GTest, invalid_configuration_throws) {
+    EXPECT_THROW(SoftwareErcAlgorithm(0, Height), std::invalid_argument);
+    SoftwareErcConfig config;
+    config.target_rate_ev_per_s = 0;
+    EXPECT_THROW(SoftwareErcAlgorithm(Width, Height, config), std::invalid_argument);
+    config                = SoftwareErcConfig();
+    config.rate_window_us = config.rate_step_us - 1;
+    EXPECT_THROW(SoftwareErcAlgorithm(Width, Height, config), std::invalid_argument);
+    config                = SoftwareErcConfig();
+    config.backoff_factor = 1.5;
+    EXPECT_THROW(SoftwareErcAlgorithm(Width, Height, config), std::invalid_argument);
+}
@@ -0,0 +1,137 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <atomic>
+#include <iterator>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "metavision/sdk/base/utils/timestamp.h"
+#include "metavision/sdk/core/utils/detail/spsc_ring.h"
+
+namespace {
+struct Event_Gtest {
+    Metavision::timestamp t;
+};
+
+std::vector<Event_Gtest> make_events(Metavision::timestamp first, Metavision::timestamp last) {
+    std::vector<Event_Gtest> events;
+    for (Metavision::timestamp t = first; t < last; ++t) {
+        events.push_back(Event_Gtest{t});
+    }
+    return events;
+}
+} // namespace
+
+TEST(SpscRing_GTest, empty) {
+    Metavision::detail::SpscRing<Event_Gtest> ring;
+    EXPECT_FALSE(ring.data_available());
+    EXPECT_EQ(size_t(0), ring.size());
+    EXPECT_EQ(Metavision::timestamp(-1), ring.get_first_time());
+    EXPECT_EQ(Metavision::timestamp(-1), ring.get_last_time());
+}
+
+TEST(SpscRing_GTest, dequeue_up_to_timestamp_across_blocks) {
+    // GIVEN a ring whose initial block is smaller than the events added
+    Metavision::detail::SpscRing<Event_Gtest> ring(4);
+    const auto events = make_events(0, 10);
+    ring.enqueue(events.cbegin(), events.cbegin() + 3);
+    ring.enqueue(events.cbegin() + 3, events.cend());
+    EXPECT_EQ(size_t(10), ring.size());
+    EXPECT_EQ(Metavision::timestamp(0), ring.get_first_time());
+    EXPECT_EQ(Metavision::timestamp(9), ring.get_last_time());
+    EXPECT_TRUE(ring.data_available(9));
+    EXPECT_FALSE(ring.data_available(10));
+
+    // WHEN dequeuing the events in several steps
+    std::vector<Event_Gtest> output;
+    ring.dequeue(std::back_inserter(output), 2);
+    ASSERT_EQ(size_t(2), output.size());
+    ring.dequeue(std::back_inserter(output), 7);
+    ASSERT_EQ(size_t(7), output.size());
+    EXPECT_EQ(Metavision::timestamp(7), ring.get_first_time());
+
+    // AND adding events wrapping around the current block
+    const auto more_events = make_events(10, 14);
+    ring.enqueue(more_events.cbegin(), more_events.cend());
+    ring.dequeue_all(std::back_inserter(output));
+
+    // THEN all the events are retrieved in order
+    ASSERT_EQ(size_t(14), output.size());
+    for (size_t i = 0; i < output.size(); ++i) {
+        EXPECT_EQ(Metavision::timestamp(i), output[i].t);
+    }
+    EXPECT_FALSE(ring.data_available());
+    EXPECT_EQ(Metavision::timestamp(-1), ring.get_last_time());
+}
+
+TEST(SpscRing_GTest, dequeue_max_events_keeps_latest) {
+    Metavision::detail::SpscRing<Event_Gtest> ring(8);
+    const auto events = make_events(0, 20);
+    ring.enqueue(events.cbegin(), events.cend());
+
+    std::vector<Event_Gtest> output;
+    ring.dequeue_max_events(std::back_inserter(output), 15, 4);
+    ASSERT_EQ(size_t(4), output.size());
+    EXPECT_EQ(Metavision::timestamp(11), output.front().t);
+    EXPECT_EQ(Metavision::timestamp(14), output.back().t);
+    EXPECT_EQ(Metavision::timestamp(15), ring.get_first_time());
+}
+
+TEST(SpscRing_GTest, drop) {
+    Metavision::detail::SpscRing<Event_Gtest> ring(8);
+    const auto events = make_events(0, 6), more_events = make_events(6, 8);
+    ring.enqueue(events.cbegin(), events.cend());
+
+    // WHEN dropping the events and adding new ones
+    ring.drop();
+    EXPECT_FALSE(ring.data_available());
+    ring.enqueue(more_events.cbegin(), more_events.cend());
+
+    // THEN only the new events are retrieved
+    EXPECT_EQ(size_t(2), ring.size());
+    EXPECT_EQ(Metavision::timestamp(6), ring.get_first_time());
+    std::vector<Event_Gtest> output;
+    ring.dequeue_all(std::back_inserter(output));
+    ASSERT_EQ(size_t(2), output.size());
+    EXPECT_EQ(Metavision::timestamp(6), output.front().t);
+}
+
+TEST(SpscRing_GTest, producer_and_consumer_threads) {
+    // GIVEN a producer thread adding buffers of events of various sizes to a small ring
+    Metavision::detail::SpscRing<Event_Gtest> ring(16);
+    const Metavision::timestamp n_events = 200000;
+    std::thread producer([&] {
+        Metavision::timestamp t = 0;
+        for (size_t n = 1; t < n_events; n = n % 37 + 1) {
+            const auto events = make_events(t, std::min(t + static_cast<Metavision::timestamp>(n), n_events));
+            ring.enqueue(events.cbegin(), events.cend());
+            t += events.size();
+        }
+    });
+
+    // WHEN a consumer thread dequeues the events by time slices
+    std::vector<Event_Gtest> output;
+    for (Metavision::timestamp ts = 0; ts <= n_events; ts += 100) {
+        while (ring.get_last_time() < ts - 1) {
+            std::this_thread::yield();
+        }
+        ring.dequeue(std::back_inserter(output), ts);
+        ASSERT_EQ(size_t(ts), output.size());
+    }
+    producer.join();
+
+    // THEN the events are retrieved in order
+    for (size_t i = 0; i < output.size(); ++i) {
+        ASSERT_EQ(Metavision::timestamp(i), output[i].t);
+    }
+}
@@ -225,3 +225,144 @@ TEST_F(StreamLoggerAlgorithm_GTest, test_stream_logger_multiple_events_rand) {
     algo.close();
     validate_file(filename_, buffer);
 }
+
+TEST_F(StreamLoggerAlgorithm_GTest, test_stream_logger_split_on_size) {
+    std::vector<Event2d> buffer;
+    for (int i = 0; i < 500; ++i) {
+        buffer.emplace_back(i % 640, i % 480, i % 2, 10 * i);
+    }
+
+    // Run the simulation, with files split as soon as events are written in them
+    StreamLoggerAlgorithm algo(filename_, 640, 480);
+    algo.set_split_size(1);
+    algo.set_fsync_policy(StreamLoggerAlgorithm::FsyncPolicy::OnClose);
+    algo.enable(true);
+    for (int i = 0; i < 5; ++i) {
+        algo.process_events(std::cbegin(buffer) + 100 * i, std::cbegin(buffer) + 100 * (i + 1), 10 * 100 * (i + 1));
+    }
+    algo.close();
+
+    // Each buffer of events is in its own file, next to the requested one
+    const std::string base = tmpdir_handler_->get_full_path("tmp_td_mock_");
+    for (int i = 0; i < 5; ++i) {
+        std::vector<Event2d> expected(std::cbegin(buffer) + 100 * i, std::cbegin(buffer) + 100 * (i + 1));
+        for (auto &ev : expected) {
+            ev.t -= 10 * 100 * i;
+        }
+        validate_file(base + "000" + std::to_string(i) + ".dat", expected);
+    }
+}
+
+TEST_F(StreamLoggerAlgorithm_GTest, test_stream_logger_background_writes) {
+    std::vector<Event2d> buffer;
+    for (int i = 0; i < 100000; ++i) {
+        buffer.emplace_back(i % 640, i % 480, i % 2, i);
+    }
+
+    // Run the simulation, with small buffers written while the next ones are processed
+    {
+        StreamLoggerAlgorithm algo(filename_, 640, 480);
+        algo.set_fsync_policy(StreamLoggerAlgorithm::FsyncPolicy::EveryWrite);
+        algo.enable(true);
+        for (size_t i = 0; i < buffer.size(); i += 1000) {
+            algo.process_events(std::cbegin(buffer) + i, std::cbegin(buffer) + i + 1000, i + 1000);
+        }
+        algo.flush();
+        validate_file(filename_, buffer);
+    }
+
+    // The pending events are written when the logger is destroyed
+    {
+        StreamLoggerAlgorithm algo(filename_, 640, 480);
+        algo.enable(true);
+        algo.process_events(std::cbegin(buffer), std::cend(buffer), buffer.size());
+    }
+    validate_file(filename_, buffer);
+}
+
+TEST_F(StreamLoggerAlgorithm_GTest, test_stream_logger_max_pending_size) {
+    // Logger giving the size of the data waiting for the background thread
+    struct PendingSizeStreamLogger : public StreamLoggerAlgorithm {
+        using StreamLoggerAlgorithm::StreamLoggerAlgorithm;
+
+        std::size_t get_pending_size() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return front_.data.size();
+        }
+    };
+
+    std::vector<Event2d> buffer;
+    for (int i = 0; i < 100000; ++i) {
+        buffer.emplace_back(i % 640, i % 480, i % 2, i);
+    }
+
+    // Run the simulation, with a writer slowed down by the synchronization of each write with the disk
+    const std::size_t max_pending_size = 20000;
+    PendingSizeStreamLogger algo(filename_, 640, 480);
+    algo.set_fsync_policy(StreamLoggerAlgorithm::FsyncPolicy::EveryWrite);
+    algo.set_max_pending_size(max_pending_size);
+    ASSERT_EQ(max_pending_size, algo.get_max_pending_size());
+    algo.enable(true);
+    for (size_t i = 0; i < buffer.size(); i += 1000) {
+        algo.process_events(std::cbegin(buffer) + i, std::cbegin(buffer) + i + 1000, i + 1000);
+        // The data of a call is only pushed if it fits with the pending one
+        ASSERT_LE(algo.get_pending_size(), max_pending_size);
+    }
+    algo.close();
+    validate_file(filename_, buffer);
+}
+
+TEST_F(StreamLoggerAlgorithm_GTest, test_stream_logger_preallocated_files) {
+    std::vector<Event2d> buffer;
+    for (int i = 0; i < 100000; ++i) {
+        buffer.emplace_back(i % 640, i % 480, i % 2, i);
+    }
+
+    // Run the simulation, with the events encoded in preallocated files split on size
+    MappedFileWriterConfig config;
+    config.capacity_   = 1024 * 1024;
+    config.flush_size_ = 64 * 1024;
+    StreamLoggerAlgorithm algo(filename_, 640, 480);
+    algo.set_preallocation(config);
+    algo.set_split_size(400000);
+    algo.enable(true);
+    for (size_t i = 0; i < buffer.size(); i += 1000) {
+        algo.process_events(std::cbegin(buffer) + i, std::cbegin(buffer) + i + 1000, i + 1000);
+    }
+    algo.close();
+    ASSERT_EQ(0u, algo.get_n_dropped_bytes());
+
+    // The files are truncated to their events: 50000 events of 8 bytes fill a file beyond the split size
+    const std::string base = tmpdir_handler_->get_full_path("tmp_td_mock_");
+    for (int i = 0; i < 2; ++i) {
+        std::vector<Event2d> expected(std::cbegin(buffer) + 50000 * i, std::cbegin(buffer) + 50000 * (i + 1));
+        for (auto &ev : expected) {
+            ev.t -= 50000 * i;
+        }
+        validate_file(base + "000" + std::to_string(i) + ".dat", expected);
+    }
+}
+
+TEST_F(StreamLoggerAlgorithm_GTest, test_stream_logger_preallocated_file_full) {
+    std::vector<Event2d> buffer;
+    for (int i = 0; i < 1000; ++i) {
+        buffer.emplace_back(i % 640, i % 480, i % 2, i);
+    }
+
+    // Run the simulation, with a preallocated file too small for all the events
+    MappedFileWriterConfig config;
+    config.capacity_ = 4096;
+    StreamLoggerAlgorithm algo(filename_, 640, 480);
+    algo.set_preallocation(config);
+    algo.enable(true);
+    for (size_t i = 0; i < buffer.size(); i += 100) {
+        algo.process_events(std::cbegin(buffer) + i, std::cbegin(buffer) + i + 100, i + 100);
+    }
+    algo.enable(false);
+
+    // The buffers of events that do not fit are dropped
+    ASSERT_LT(0u, algo.get_n_dropped_bytes());
+    ASSERT_EQ(0u, algo.get_n_dropped_bytes() % (100 * 8));
+    const size_t n_written = buffer.size() - algo.get_n_dropped_bytes() / 8;
+    validate_file(filename_, std::vector<Event2d>(std::cbegin(buffer), std::cbegin(buffer) + n_written));
+}
@@ -0,0 +1,194 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/core/algorithms/tensor_generation_algorithm.h"
+
+using namespace Metavision;
+
+namespace {
+
+using Type   = TensorGenerationAlgorithm::Type;
+using Layout = TensorGenerationAlgorithm::Layout;
+
+// Straightforward voxel grid, histogram or time surface with channels first
+std::vector<float> reference_tensor(const std::vector<EventCD> &events, int width, int height, Type type, int num_bins,
+                                    timestamp ts_begin, timestamp ts_end) {
+    const int num_channels = type == Type::VoxelGrid ? num_bins : 2;
+    std::vector<float> tensor(static_cast<size_t>(num_channels) * width * height, 0.f);
+    auto at = [&](int c, const EventCD &ev) -> float & { return tensor[(c * height + ev.y) * width + ev.x]; };
+    const double duration = static_cast<double>(ts_end - ts_begin);
+    for (const auto &ev : events) {
+        if (ev.t < ts_begin || ev.t >= ts_end) {
+            continue;
+        }
+        const double t = (ev.t - ts_begin) / duration;
+        switch (type) {
+        case Type::VoxelGrid: {
+            const double bin = t * (num_bins - 1);
+            const int lower  = static_cast<int>(bin);
+            const float pol  = ev.p ? 1.f : -1.f;
+            at(lower, ev) += static_cast<float>(pol * (1. - (bin - lower)));
+            if (lower + 1 < num_bins) {
+                at(lower + 1, ev) += static_cast<float>(pol * (bin - lower));
+            }
+            break;
+        }
+        case Type::Histogram:
+            at(ev.p, ev) += 1.f;
+            break;
+        case Type::TimeSurface:
+            at(ev.p, ev) = std::max(at(ev.p, ev), static_cast<float>((ev.t - ts_begin + 1) / duration));
+            break;
+        }
+    }
+    return tensor;
+}
+
+std::vector<EventCD> random_events(int width, int height, size_t n, timestamp duration) {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> x(0, width - 1), y(0, height - 1), p(0, 1);
+    std::vector<EventCD> events;
+    for (size_t i = 0; i < n; ++i) {
+        events.emplace_back(x(gen), y(gen), p(gen), static_cast<timestamp>(i * duration / n));
+    }
+    return events;
+}
+
+float half_to_float(std::uint16_t h) {
+    const int exponent = (h >> 10) & 0x1F, mantissa = h & 0x3FF;
+    const float sign   = (h & 0x8000) ? -1.f : 1.f;
+    if (exponent == 0) {
+        return sign * std::ldexp(static_cast<float>(mantissa), -24);
+    }
+    if (exponent == 31) {
+        return mantissa ? std::numeric_limits<float>::quiet_NaN() : sign * std::numeric_limits<float>::infinity();
+    }
+    return sign * std::ldexp(static_cast<float>(mantissa | 0x400), exponent - 25);
+}
+
+} // namespace
+
+TEST(TensorGenerationAlgorithm_GTest, shape) {
+    TensorGenerationAlgorithm voxel(640, 480, Type::VoxelGrid, 5);
+    EXPECT_EQ(5, voxel.get_num_channels());
+    EXPECT_EQ((std::array<size_t, 3>{5, 480, 640}), voxel.get_shape());
+    EXPECT_EQ(5u * 480 * 640, voxel.get_tensor_size());
+
+    TensorGenerationAlgorithm histo(640, 480, Type::Histogram, 5, Layout::HWC);
+    EXPECT_EQ(2, histo.get_num_channels());
+    EXPECT_EQ((std::array<size_t, 3>{480, 640, 2}), histo.get_shape());
+
+    EXPECT_THROW(TensorGenerationAlgorithm(0, 480, Type::Histogram), std::invalid_argument);
+    EXPECT_THROW(TensorGenerationAlgorithm(640, 480, Type::VoxelGrid, 0), std::invalid_argument);
+}
+
+TEST(TensorGenerationAlgorithm_GTest, voxel_grid_bilinear_binning) {
+    // GIVEN a voxel grid of 3 bins over [0, 100[
+    TensorGenerationAlgorithm algo(4, 2, Type::VoxelGrid, 3);
+    std::vector<float> tensor(algo.get_tensor_size(), 42.f);
+
+    // WHEN generating it from a positive event at 1/4 of the interval and a negative one at the middle
+    std::vector<EventCD> events{EventCD(1, 0, 1, 25), EventCD(2, 1, 0, 50), EventCD(3, 1, 1, 100)};
+    algo.generate(events.cbegin(), events.cend(), 0, 100, tensor.data());
+
+    // THEN the first one is split between bins 0 and 1, the second one is all in bin 1, the last one is ignored
+    std::vector<float> expected(algo.get_tensor_size(), 0.f);
+    expected[0 * 8 + 1]     = 0.5f;
+    expected[1 * 8 + 1]     = 0.5f;
+    expected[1 * 8 + 4 + 2] = -1.f;
+    EXPECT_EQ(expected, tensor);
+}
+
+TEST(TensorGenerationAlgorithm_GTest, histogram_and_time_surface) {
+    std::vector<EventCD> events{EventCD(0, 0, 1, 10), EventCD(0, 0, 1, 20), EventCD(0, 0, 0, 30),
+                                EventCD(1, 1, 0, 0)};
+
+    TensorGenerationAlgorithm histo(2, 2, Type::Histogram);
+    std::vector<float> tensor(histo.get_tensor_size());
+    histo.generate(events.cbegin(), events.cend(), 0, 40, tensor.data());
+    EXPECT_EQ((std::vector<float>{1, 0, 0, 1, 2, 0, 0, 0}), tensor);
+
+    TensorGenerationAlgorithm surface(2, 2, Type::TimeSurface);
+    surface.generate(events.cbegin(), events.cend(), 0, 40, tensor.data());
+    EXPECT_EQ((std::vector<float>{31 / 40.f, 0, 0, 1 / 40.f, 21 / 40.f, 0, 0, 0}), tensor);
+}
+
+TEST(TensorGenerationAlgorithm_GTest, matches_reference_in_both_layouts) {
+    // GIVEN enough events for the tensor to be filled by several threads
+    const int width = 320, height = 240, num_bins = 5;
+    const auto events = random_events(width, height, 500000, 50000);
+
+    for (auto type : {Type::VoxelGrid, Type::Histogram, Type::TimeSurface}) {
+        const auto expected = reference_tensor(events, width, height, type, num_bins, 10000, 40000);
+        const int c_count   = type == Type::VoxelGrid ? num_bins : 2;
+
+        TensorGenerationAlgorithm chw(width, height, type, num_bins, Layout::CHW);
+        std::vector<float> tensor(chw.get_tensor_size());
+        chw.generate(events.data(), events.data() + events.size(), 10000, 40000, tensor.data());
+        for (size_t i = 0; i < expected.size(); ++i) {
+            ASSERT_NEAR(expected[i], tensor[i], 1e-4) << i;
+        }
+
+        TensorGenerationAlgorithm hwc(width, height, type, num_bins, Layout::HWC);
+        hwc.generate(events.data(), events.data() + events.size(), 10000, 40000, tensor.data());
+        for (int c = 0; c < c_count; ++c) {
+            for (int p = 0; p < width * height; ++p) {
+                ASSERT_NEAR(expected[c * width * height + p], tensor[p * c_count + c], 1e-4);
+            }
+        }
+    }
+}
+
+TEST(TensorGenerationAlgorithm_GTest, half_precision) {
+    // GIVEN values covering the normal, subnormal and out of range half values
+    const std::vector<float> values{0.f,     -0.f,   1.f,     -2.5f,  0.1f,   65504.f, 65519.f, 65520.f, 1e9f,
+                                    6.1e-5f, 1e-7f,  2.9e-8f, 3e-8f,  -1e-6f, 1.0005f, 1.001f, 1.0015f,
+                                    std::numeric_limits<float>::infinity()};
+    std::vector<std::uint16_t> halves(values.size());
+    TensorGenerationAlgorithm::convert_to_half(values.data(), halves.data(), values.size());
+
+    // THEN each value is rounded to the nearest half value
+    for (size_t i = 0; i < values.size(); ++i) {
+        const float h = half_to_float(halves[i]);
+        if (std::isinf(values[i]) || std::fabs(values[i]) >= 65520.f) {
+            EXPECT_TRUE(std::isinf(h)) << values[i];
+        } else {
+            // The rounding error is at most half of the distance between 2 half values around the value
+            const float ulp = std::fabs(values[i]) < 6.104e-5f ? std::ldexp(1.f, -24) :
+                                                                  std::ldexp(1.f, std::ilogb(values[i]) - 10);
+            EXPECT_LE(std::fabs(h - values[i]), ulp / 2) << values[i];
+        }
+    }
+    EXPECT_EQ(0x3C00, halves[2]);
+    EXPECT_EQ(0x8000, halves[1]);
+
+    // WHEN generating a histogram in half precision
+    TensorGenerationAlgorithm algo(64, 64, Type::Histogram);
+    const auto events = random_events(64, 64, 10000, 1000);
+    std::vector<float> tensor(algo.get_tensor_size());
+    std::vector<std::uint16_t> half_tensor(algo.get_tensor_size());
+    algo.generate(events.cbegin(), events.cend(), 0, 1000, tensor.data());
+    algo.generate(events.cbegin(), events.cend(), 0, 1000, half_tensor.data());
+
+    // THEN it holds the same counts
+    for (size_t i = 0; i < tensor.size(); ++i) {
+        ASSERT_EQ(tensor[i], half_to_float(half_tensor[i]));
+    }
+}
@@ -12,6 +12,7 @@
 #include <vector>
 #include <atomic>
 #include <fstream>
+#include <thread>
 #include <gtest/gtest.h>
 
 #include "metavision/sdk/core/utils/threaded_process.h"
@@ -391,3 +392,36 @@ TEST_F(ThreadedProcess_GTest, calling_stop_without_abort_wait_end_of_repeating_t
     // THEN The request to not abort repeating task using stop waits the end of the repeating process.
     ASSERT_EQ(3, task_processed_count);
 }
+
+TEST_F(ThreadedProcess_GTest, tasks_added_from_several_threads_are_all_executed) {
+    // GIVEN a threaded process polling for new tasks before sleeping
+    static constexpr int NumTasks   = 10000;
+    static constexpr int NumThreads = 4;
+    std::atomic<int> task_processed_count{0};
+
+    // WHEN several threads add tasks
+    {
+        Metavision::ThreadedProcess threaded_process;
+        threaded_process.set_spin_before_sleep(std::chrono::microseconds(100));
+        threaded_process.start();
+        std::vector<std::thread> threads;
+        for (int t = 0; t < NumThreads; ++t) {
+            threads.emplace_back([&]() {
+                for (int i = 0; i < NumTasks; ++i) {
+                    threaded_process.add_task([&]() { ++task_processed_count; });
+                    if (i % 1000 == 0) {
+                        // Lets the processing thread fall asleep from time to time
+                        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    }
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        threaded_process.stop();
+    }
+
+    // THEN all the tasks are processed
+    ASSERT_EQ(NumThreads * NumTasks, task_processed_count);
+}
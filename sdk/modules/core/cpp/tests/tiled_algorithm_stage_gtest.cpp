@@ -0,0 +1,121 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <tuple>
+#include <vector>
+#include <boost/any.hpp>
+#include <gtest/gtest.h>
+
+#include "metavision/sdk/core/algorithms/refractory_filter_algorithm.h"
+#include "metavision/sdk/core/pipeline/pipeline.h"
+#include "metavision/sdk/core/pipeline/tiled_algorithm_stage.h"
+
+using namespace Metavision;
+
+namespace {
+
+struct MockProducingStage : public BaseStage {
+    MockProducingStage(const std::vector<EventCD> &events, size_t buffer_size) :
+        pool(EventBufferPool::make_bounded()) {
+        set_starting_callback([this, events, buffer_size] {
+            for (size_t i = 0; i < events.size(); i += buffer_size) {
+                auto buffer = pool.acquire();
+                buffer->assign(events.begin() + i, events.begin() + std::min(i + buffer_size, events.size()));
+                produce(buffer);
+            }
+            complete();
+        });
+    }
+
+    EventBufferPool pool;
+};
+
+struct MockConsumingStage : public BaseStage {
+    MockConsumingStage(std::vector<EventCD> &events, BaseStage &prev_stage) : BaseStage(prev_stage) {
+        set_consuming_callback([&events](const boost::any &data) {
+            auto buffer = boost::any_cast<EventBufferPtr>(data);
+            events.insert(events.end(), buffer->cbegin(), buffer->cend());
+        });
+    }
+};
+
+} // namespace
+
+TEST(TiledAlgorithmStage_GTest, invalid_tiling_throws) {
+    // GIVEN a factory of refractory filters
+    auto factory = [](int, int, int, int) { return std::make_unique<RefractoryFilterAlgorithm>(8, 4, 10); };
+
+    // WHEN creating stages with no tile, or more tiles than pixels
+    // THEN it throws
+    using Stage = TiledAlgorithmStage<RefractoryFilterAlgorithm>;
+    EXPECT_THROW(Stage(8, 4, 0, 1, factory), std::invalid_argument);
+    EXPECT_THROW(Stage(8, 4, 1, 5, factory), std::invalid_argument);
+    EXPECT_THROW(Stage(0, 4, 1, 1, factory), std::invalid_argument);
+}
+
+TEST(TiledAlgorithmStage_GTest, tiled_refractory_filter_matches_a_single_instance) {
+    // GIVEN random events on a 64x48 sensor, some of them outside of it
+    const int width = 64, height = 48;
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> x_dist(0, width), y_dist(0, height - 1), dt_dist(0, 3), p_dist(0, 1);
+    std::vector<EventCD> events;
+    timestamp t = 0;
+    for (int i = 0; i < 20000; ++i) {
+        t += dt_dist(gen);
+        events.emplace_back(x_dist(gen), y_dist(gen), p_dist(gen), t);
+    }
+
+    // WHEN filtering them with a stage of 3x2 refractory filters
+    std::vector<std::array<int, 4>> tiles;
+    std::vector<EventCD> tiled_output;
+    Pipeline p;
+    auto &s1 = p.add_stage(std::make_unique<MockProducingStage>(events, 1000));
+    auto &s2 = p.add_stage(std::make_unique<TiledAlgorithmStage<RefractoryFilterAlgorithm>>(
+                               width, height, 3, 2,
+                               [&tiles, width, height](int x, int y, int w, int h) {
+                                   tiles.push_back({x, y, w, h});
+                                   return std::make_unique<RefractoryFilterAlgorithm>(width, height, 50);
+                               }),
+                           s1);
+    p.add_stage(std::make_unique<MockConsumingStage>(tiled_output, s2));
+    p.run();
+
+    // THEN the tiles cover the sensor
+    ASSERT_EQ(6, tiles.size());
+    EXPECT_EQ((std::array<int, 4>{0, 0, 21, 24}), tiles[0]);
+    EXPECT_EQ((std::array<int, 4>{42, 24, 22, 24}), tiles[5]);
+
+    // THEN the output is the one of a single filter, without the events outside of the sensor
+    std::vector<EventCD> inside, expected;
+    std::copy_if(events.cbegin(), events.cend(), std::back_inserter(inside),
+                 [&](const EventCD &ev) { return ev.x < width; });
+    RefractoryFilterAlgorithm filter(width, height, 50);
+    filter.process_events(inside.cbegin(), inside.cend(), std::back_inserter(expected));
+    ASSERT_EQ(expected.size(), tiled_output.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_EQ(expected[i].t, tiled_output[i].t);
+    }
+
+    // The events of the same timestamp are ordered by tile rather than as they were received
+    auto by_time_and_position = [](const EventCD &a, const EventCD &b) {
+        return std::tie(a.t, a.y, a.x, a.p) < std::tie(b.t, b.y, b.x, b.p);
+    };
+    std::sort(expected.begin(), expected.end(), by_time_and_position);
+    std::sort(tiled_output.begin(), tiled_output.end(), by_time_and_position);
+    for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_EQ(expected[i].x, tiled_output[i].x);
+        ASSERT_EQ(expected[i].y, tiled_output[i].y);
+        ASSERT_EQ(expected[i].p, tiled_output[i].p);
+    }
+}
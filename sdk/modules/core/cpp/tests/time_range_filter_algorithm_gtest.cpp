@@ -0,0 +1,138 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/base/events/event_cd_buffer_soa.h"
+#include "metavision/sdk/core/algorithms/event_views.h"
+#include "metavision/sdk/core/algorithms/time_range_filter_algorithm.h"
+
+using namespace Metavision;
+
+namespace Metavision {
+bool operator==(const EventCD &lhs, const EventCD &rhs) {
+    return lhs.x == rhs.x && lhs.y == rhs.y && lhs.p == rhs.p && lhs.t == rhs.t;
+}
+} // namespace Metavision
+
+class TimeRangeFilterAlgorithm_GTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // Sorted events, several events sharing each timestamp
+        for (timestamp t = 0; t < 1000; ++t) {
+            for (int i = 0; i < 3; ++i) {
+                sorted_.emplace_back(static_cast<unsigned short>(t % 640), static_cast<unsigned short>(i), i % 2, t);
+            }
+        }
+        shuffled_ = sorted_;
+        std::shuffle(shuffled_.begin(), shuffled_.end(), std::mt19937(42));
+    }
+
+    // Reference result, the events in range in the order of the input
+    std::vector<EventCD> expected(const std::vector<EventCD> &input, timestamp t_begin, timestamp t_end) {
+        std::vector<EventCD> output;
+        std::copy_if(input.cbegin(), input.cend(), std::back_inserter(output),
+                     [&](const EventCD &ev) { return ev.t >= t_begin && ev.t < t_end; });
+        return output;
+    }
+
+    std::vector<EventCD> sorted_, shuffled_;
+};
+
+TEST_F(TimeRangeFilterAlgorithm_GTest, find_range_in_sorted_events_without_copy) {
+    // GIVEN a filter of the range [100, 250)
+    TimeRangeFilterAlgorithm algo(100, 250);
+
+    // WHEN finding the range in sorted events
+    const auto range = algo.find_range(sorted_.cbegin(), sorted_.cend());
+
+    // THEN the range refers to the input events in range
+    ASSERT_EQ(sorted_.cbegin() + 300, range.first);
+    ASSERT_EQ(sorted_.cbegin() + 750, range.second);
+
+    // THEN empty and out of bounds ranges give empty ranges
+    algo.set_range(2000, 3000);
+    const auto after = algo.find_range(sorted_.cbegin(), sorted_.cend());
+    ASSERT_EQ(after.first, after.second);
+    algo.set_range(500, 500);
+    const auto empty = algo.find_range(sorted_.cbegin(), sorted_.cend());
+    ASSERT_EQ(empty.first, empty.second);
+}
+
+TEST_F(TimeRangeFilterAlgorithm_GTest, process_sorted_and_unsorted_events) {
+    for (const timestamp t_begin : {-10, 0, 1, 333, 999}) {
+        for (const timestamp t_end : {t_begin, t_begin + 1, t_begin + 17, timestamp(2000)}) {
+            // GIVEN sorted events processed by binary search, and shuffled ones compared one by one
+            TimeRangeFilterAlgorithm sorted_algo(t_begin, t_end);
+            TimeRangeFilterAlgorithm unsorted_algo(t_begin, t_end, false);
+
+            std::vector<EventCD> sorted_output(sorted_.size()), unsorted_output;
+            sorted_output.erase(sorted_algo.process_events(sorted_.cbegin(), sorted_.cend(), sorted_output.begin()),
+                                sorted_output.end());
+            unsorted_algo.process_events(shuffled_.cbegin(), shuffled_.cend(), std::back_inserter(unsorted_output));
+
+            // THEN the events in range are kept, in their input order
+            ASSERT_EQ(expected(sorted_, t_begin, t_end), sorted_output);
+            ASSERT_EQ(expected(shuffled_, t_begin, t_end), unsorted_output);
+
+            // THEN the batch kernel gives the same result when processing in place
+            std::vector<EventCD> in_place = shuffled_;
+            in_place.erase(unsorted_algo.process_events(in_place.cbegin(), in_place.cend(), in_place.begin()),
+                           in_place.end());
+            ASSERT_EQ(unsorted_output, in_place);
+        }
+    }
+}
+
+TEST_F(TimeRangeFilterAlgorithm_GTest, process_soa_buffers) {
+    for (const bool sorted : {true, false}) {
+        const auto &input = sorted ? sorted_ : shuffled_;
+        EventCDBufferSoA buffer;
+        buffer.assign(input.cbegin(), input.cend());
+
+        // GIVEN a buffer of events stored as a structure of arrays, filtered in place
+        TimeRangeFilterAlgorithm algo(100, 250, sorted);
+        algo.process_events(buffer, buffer);
+
+        // THEN the events in range are kept, in their input order
+        const auto expected_output = expected(input, 100, 250);
+        ASSERT_EQ(expected_output.size(), buffer.size());
+        for (size_t i = 0; i < buffer.size(); ++i) {
+            ASSERT_EQ(expected_output[i].x, buffer.x()[i]);
+            ASSERT_EQ(expected_output[i].t, buffer.t()[i]);
+        }
+    }
+}
+
+TEST_F(TimeRangeFilterAlgorithm_GTest, view_of_time_range) {
+    // GIVEN a view of the events in a range
+    std::vector<EventCD> output;
+    (shuffled_ | views::time_range(10, 20) | views::polarity(1)).copy_to(std::back_inserter(output));
+
+    // THEN the events in range of the polarity are kept
+    auto reference = expected(shuffled_, 10, 20);
+    reference.erase(std::remove_if(reference.begin(), reference.end(), [](const EventCD &ev) { return ev.p != 1; }),
+                    reference.end());
+    ASSERT_EQ(reference, output);
+}
+
+TEST_F(TimeRangeFilterAlgorithm_GTest, invalid_range_throws) {
+    ASSERT_THROW(TimeRangeFilterAlgorithm(10, 5), std::invalid_argument);
+    TimeRangeFilterAlgorithm algo(0, 1);
+    ASSERT_THROW(algo.set_range(2, 1), std::invalid_argument);
+    ASSERT_EQ(0, algo.t_begin());
+    ASSERT_EQ(1, algo.t_end());
+}
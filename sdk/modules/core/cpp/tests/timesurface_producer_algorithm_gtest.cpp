@@ -9,10 +9,16 @@
  * See the License for the specific language governing permissions and limitations under the License.                 *
  **********************************************************************************************************************/
 
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <vector>
 #include <gtest/gtest.h>
 #include <metavision/sdk/base/events/event_cd.h>
 
 #include "metavision/sdk/core/algorithms/time_surface_producer_algorithm.h"
+#include "metavision/sdk/core/utils/compact_mostrecent_timestamp_buffer.h"
 
 class TimesurfaceProducerAlgorithmGTest : public ::testing::Test {
 public:
@@ -141,4 +147,249 @@ TEST_F(TimesurfaceProducerAlgorithmGTest, test_keeping_history) {
     ASSERT_EQ(timesurface.at(2, 0), 6);
     ASSERT_EQ(timesurface.at(2, 1), 7);
     ASSERT_EQ(timesurface.at(2, 2), 0);
-}
\ No newline at end of file
+}
+
+TEST_F(TimesurfaceProducerAlgorithmGTest, several_threads_give_same_time_surface) {
+    // GIVEN producers using 1 and 4 threads, and a buffer of events with many events on the same pixels
+    const int width = 101, height = 67;
+    Metavision::TimeSurfaceProducerAlgorithm<2> producer(width, height), mt_producer(width, height);
+    mt_producer.set_n_threads(4);
+    ASSERT_EQ(4, mt_producer.get_n_threads());
+
+    Metavision::MostRecentTimestampBuffer timesurface, mt_timesurface;
+    producer.set_processing_n_events(50000);
+    mt_producer.set_processing_n_events(50000);
+    producer.set_output_callback(
+        [&](Metavision::timestamp, const Metavision::MostRecentTimestampBuffer &ts) { ts.copy_to(timesurface); });
+    mt_producer.set_output_callback(
+        [&](Metavision::timestamp, const Metavision::MostRecentTimestampBuffer &ts) { ts.copy_to(mt_timesurface); });
+
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<int> x_dist(0, width - 1), y_dist(0, height - 1), p_dist(0, 1);
+    std::vector<Metavision::EventCD> events;
+    for (int i = 0; i < 50000; ++i) {
+        events.emplace_back(x_dist(gen) / 4, y_dist(gen), p_dist(gen), i);
+    }
+
+    // WHEN processing the events
+    producer.process_events(events.cbegin(), events.cend());
+    mt_producer.process_events(events.cbegin(), events.cend());
+
+    // THEN the time surfaces are the same
+    ASSERT_EQ(height, mt_timesurface.rows());
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            for (int c = 0; c < 2; ++c) {
+                ASSERT_EQ(timesurface.at(y, x, c), mt_timesurface.at(y, x, c));
+            }
+        }
+    }
+}
+
+TEST_F(TimesurfaceProducerAlgorithmGTest, generate_images_with_decay) {
+    // GIVEN a 2-channels time surface whose width is not a multiple of the vector size, with future timestamps and
+    // timestamps older than the window
+    const int width = 37, height = 5;
+    const Metavision::timestamp last_ts = 100000, delta_t = 20000;
+    const double tau                    = 5000;
+    Metavision::MostRecentTimestampBuffer timesurface(height, width, 2);
+    std::mt19937 gen(3);
+    std::uniform_int_distribution<Metavision::timestamp> ts_dist(last_ts - 2 * delta_t, last_ts + 100);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            for (int c = 0; c < 2; ++c) {
+                timesurface.at(y, x, c) = ts_dist(gen);
+            }
+        }
+    }
+
+    // WHEN generating the images with linear and exponential decays
+    cv::Mat linear, linear_collapsed, exponential, exponential_collapsed;
+    timesurface.generate_img_time_surface(last_ts, delta_t, linear);
+    timesurface.generate_img_time_surface_collapsing_channels(last_ts, delta_t, linear_collapsed);
+    timesurface.generate_img_time_surface_exponential_decay(last_ts, tau, exponential);
+    timesurface.generate_img_time_surface_collapsing_channels_exponential_decay(last_ts, tau, exponential_collapsed);
+
+    // THEN the pixels are set according to the age of the timestamps
+    auto linear_value = [&](Metavision::timestamp ts) {
+        const Metavision::timestamp age = std::max<Metavision::timestamp>(last_ts - ts, 0);
+        return age <= delta_t ? static_cast<int>(age * 255. / delta_t) : 0;
+    };
+    auto exponential_value = [&](Metavision::timestamp ts) {
+        return 255. * std::exp(-std::max<Metavision::timestamp>(last_ts - ts, 0) / tau);
+    };
+    ASSERT_EQ(cv::Size(2 * width, height), linear.size());
+    ASSERT_EQ(cv::Size(width, height), exponential_collapsed.size());
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            const Metavision::timestamp max_ts = timesurface.max_across_channels_at(y, x);
+            for (int c = 0; c < 2; ++c) {
+                const Metavision::timestamp ts = timesurface.at(y, x, c);
+                ASSERT_EQ(linear_value(ts), linear.at<uint8_t>(y, c * width + x));
+                ASSERT_NEAR(exponential_value(ts), exponential.at<uint8_t>(y, c * width + x), 1.);
+            }
+            ASSERT_EQ(linear_value(max_ts), linear_collapsed.at<uint8_t>(y, x));
+            ASSERT_NEAR(exponential_value(max_ts), exponential_collapsed.at<uint8_t>(y, x), 1.);
+        }
+    }
+}
+
+TEST_F(TimesurfaceProducerAlgorithmGTest, compact_time_surface_gives_same_timestamps_and_images) {
+    // GIVEN producers of 64 bits and compact time surfaces, one of them using several threads
+    const int width = 53, height = 21;
+    Metavision::TimeSurfaceProducerAlgorithm<2> producer(width, height);
+    Metavision::TimeSurfaceProducerAlgorithm<2, Metavision::CompactMostRecentTimestampBuffer> compact_producer(
+        width, height),
+        mt_compact_producer(width, height);
+    mt_compact_producer.set_n_threads(3);
+
+    Metavision::MostRecentTimestampBuffer timesurface;
+    Metavision::CompactMostRecentTimestampBuffer compact_timesurface, mt_compact_timesurface;
+    producer.set_processing_n_events(20000);
+    compact_producer.set_processing_n_events(20000);
+    mt_compact_producer.set_processing_n_events(20000);
+    producer.set_output_callback(
+        [&](Metavision::timestamp, const Metavision::MostRecentTimestampBuffer &ts) { ts.copy_to(timesurface); });
+    compact_producer.set_output_callback(
+        [&](Metavision::timestamp, const Metavision::CompactMostRecentTimestampBuffer &ts) {
+            compact_timesurface = ts;
+        });
+    mt_compact_producer.set_output_callback(
+        [&](Metavision::timestamp, const Metavision::CompactMostRecentTimestampBuffer &ts) {
+            mt_compact_timesurface = ts;
+        });
+
+    // The timestamps exceed the range of 32 bits offsets, so that the time surface is rebased
+    std::mt19937 gen(11);
+    std::uniform_int_distribution<int> x_dist(0, width - 1), y_dist(0, height - 1), p_dist(0, 1);
+    std::vector<Metavision::EventCD> events;
+    for (int i = 0; i < 20000; ++i) {
+        events.emplace_back(x_dist(gen), y_dist(gen), p_dist(gen), 5000000000LL + 100 * i);
+    }
+
+    // WHEN processing the events
+    producer.process_events(events.cbegin(), events.cend());
+    compact_producer.process_events(events.cbegin(), events.cend());
+    mt_compact_producer.process_events(events.cbegin(), events.cend());
+
+    // THEN the timestamps and the generated images are the same
+    ASSERT_EQ(height, compact_timesurface.rows());
+    ASSERT_LT(0, compact_timesurface.epoch());
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            for (int c = 0; c < 2; ++c) {
+                if (timesurface.at(y, x, c) != 0) {
+                    ASSERT_EQ(timesurface.at(y, x, c), compact_timesurface.at(y, x, c));
+                }
+                ASSERT_EQ(compact_timesurface.at(y, x, c), mt_compact_timesurface.at(y, x, c));
+            }
+        }
+    }
+
+    const Metavision::timestamp last_ts = events.back().t;
+    cv::Mat img, compact_img;
+    timesurface.generate_img_time_surface(last_ts, 300000, img);
+    compact_timesurface.generate_img_time_surface(last_ts, 300000, compact_img);
+    ASSERT_EQ(0, cv::norm(img, compact_img, cv::NORM_INF));
+    timesurface.generate_img_time_surface_collapsing_channels_exponential_decay(last_ts, 50000, img);
+    compact_timesurface.generate_img_time_surface_collapsing_channels_exponential_decay(last_ts, 50000, compact_img);
+    ASSERT_EQ(0, cv::norm(img, compact_img, cv::NORM_INF));
+}
+
+TEST_F(TimesurfaceProducerAlgorithmGTest, compact_time_surface_rebases_at_coarse_resolution) {
+    // GIVEN a time surface of 16 bits offsets with a resolution of 100us
+    Metavision::CompactMostRecentTimestampBuffer16 timesurface(2, 2, 1, 100);
+    ASSERT_EQ(100, timesurface.resolution());
+    ASSERT_EQ(Metavision::CompactMostRecentTimestampBuffer16::NoTimestamp, *timesurface.ptr(1, 1));
+
+    // WHEN setting timestamps within the range of the offsets
+    timesurface.set(0, 0, 0, 1000);
+    timesurface.set(0, 1, 0, 1000 + 30000 * 100 + 42);
+
+    // THEN they are retrieved at the resolution
+    ASSERT_EQ(0, timesurface.epoch());
+    ASSERT_EQ(1000, timesurface.at(0, 0));
+    ASSERT_EQ(1000 + 30000 * 100, timesurface.at(0, 1));
+
+    // WHEN setting a timestamp out of the range of the offsets
+    const Metavision::timestamp ts = 1000 + 40000 * 100 + 42;
+    timesurface.set(1, 0, 0, ts);
+
+    // THEN the epoch is moved forward, and only the timestamps out of the range are saturated
+    ASSERT_EQ(ts - 42, timesurface.epoch());
+    ASSERT_EQ(0, *timesurface.ptr(1, 0));
+    ASSERT_EQ(ts - 42, timesurface.at(1, 0));
+    ASSERT_EQ(1000 + 30000 * 100, timesurface.at(0, 1));
+    ASSERT_EQ(Metavision::CompactMostRecentTimestampBuffer16::NoTimestamp, *timesurface.ptr(0, 0));
+    ASSERT_EQ(Metavision::CompactMostRecentTimestampBuffer16::NoTimestamp, *timesurface.ptr(1, 1));
+    ASSERT_EQ(ts - 42, timesurface.max_across_channels_at(1, 0));
+
+    // THEN the timestamps before the epoch are rounded down
+    ASSERT_EQ(-1, timesurface.to_offset(ts - 43));
+    ASSERT_THROW(Metavision::CompactMostRecentTimestampBuffer16(2, 2, 1, 0), std::invalid_argument);
+}
+
+TEST_F(TimesurfaceProducerAlgorithmGTest, double_buffering_gives_same_time_surfaces_and_keeps_the_output_unchanged) {
+    // GIVEN producers with and without double buffering, one of them using several threads, and buffers of events
+    // smaller and larger than the time surface, so that it is updated by writing the events again or by a copy
+    const int width = 31, height = 17;
+    for (int n_events : {100, 5000}) {
+        Metavision::TimeSurfaceProducerAlgorithm<2> producer(width, height), db_producer(width, height),
+            mt_db_producer(width, height);
+        db_producer.set_double_buffering(true);
+        mt_db_producer.set_double_buffering(true);
+        mt_db_producer.set_n_threads(2);
+        ASSERT_TRUE(db_producer.is_double_buffering());
+        ASSERT_FALSE(producer.is_double_buffering());
+
+        std::vector<Metavision::MostRecentTimestampBuffer> timesurfaces;
+        std::vector<const Metavision::timestamp *> db_outputs, mt_db_outputs;
+        std::vector<Metavision::MostRecentTimestampBuffer> db_copies;
+        producer.set_processing_n_events(n_events);
+        db_producer.set_processing_n_events(n_events);
+        mt_db_producer.set_processing_n_events(n_events);
+        producer.set_output_callback([&](Metavision::timestamp, const Metavision::MostRecentTimestampBuffer &ts) {
+            timesurfaces.emplace_back(ts);
+        });
+        db_producer.set_output_callback([&](Metavision::timestamp, const Metavision::MostRecentTimestampBuffer &ts) {
+            db_outputs.push_back(ts.ptr());
+            db_copies.emplace_back(ts);
+        });
+        mt_db_producer.set_output_callback([&](Metavision::timestamp, const Metavision::MostRecentTimestampBuffer &ts) {
+            mt_db_outputs.push_back(ts.ptr());
+        });
+
+        std::mt19937 gen(13);
+        std::uniform_int_distribution<int> x_dist(0, width - 1), y_dist(0, height - 1), p_dist(0, 1);
+        std::vector<Metavision::EventCD> events;
+        for (int i = 0; i < 10 * n_events; ++i) {
+            events.emplace_back(x_dist(gen), y_dist(gen), p_dist(gen), i);
+        }
+
+        // WHEN processing the events, by halves of the periods of the time surfaces
+        for (size_t i = 0; i < events.size(); i += n_events / 2) {
+            const auto begin = events.cbegin() + i, end = events.cbegin() + i + n_events / 2;
+            producer.process_events(begin, end);
+            db_producer.process_events(begin, end);
+            mt_db_producer.process_events(begin, end);
+
+            // THEN the last output is not updated by the events processed since
+            if (!db_outputs.empty()) {
+                const auto *output = db_outputs.back();
+                ASSERT_TRUE(std::equal(output, output + width * height * 2, db_copies.back().ptr()));
+            }
+        }
+        ASSERT_LE(2u, db_outputs.size());
+        ASSERT_NE(db_outputs[0], db_outputs[1]);
+
+        // THEN the time surfaces are the same with and without double buffering
+        ASSERT_EQ(timesurfaces.size(), db_copies.size());
+        ASSERT_EQ(timesurfaces.size(), mt_db_outputs.size());
+        for (size_t i = 0; i < timesurfaces.size(); ++i) {
+            ASSERT_TRUE(
+                std::equal(timesurfaces[i].ptr(), timesurfaces[i].ptr() + width * height * 2, db_copies[i].ptr()));
+        }
+        const auto *last = mt_db_outputs.back();
+        ASSERT_TRUE(std::equal(last, last + width * height * 2, timesurfaces.back().ptr()));
+    }
+}
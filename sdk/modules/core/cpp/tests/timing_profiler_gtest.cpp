@@ -13,6 +13,7 @@
 #include <chrono>
 #include <cstdlib>
 #include <iostream>
+#include <limits>
 #include <thread>
 #include <vector>
 
@@ -172,6 +173,110 @@ TEST_F(TimingProfiler_GTest, test_thread_safe) {
     ASSERT_EQ(size_t(2000), count);
 }
 
+using HistogramTimingProfiler =
+    TimingProfiler<true, detail::ConcurrencyPolicyLockFree, detail::OperationStoragePolicyHistogram>;
+
+TEST_F(TimingProfiler_GTest, test_latency_histogram_buckets) {
+    // small values are counted exactly
+    for (uint64_t v = 0; v < detail::LatencyHistogram::SubBuckets; ++v) {
+        ASSERT_EQ(v, detail::LatencyHistogram::bucket_value(detail::LatencyHistogram::bucket_index(v)));
+    }
+    // larger values are counted with a bounded relative error
+    for (uint64_t v = 32; v < (uint64_t(1) << 39); v = v * 3 / 2 + 7) {
+        const size_t index   = detail::LatencyHistogram::bucket_index(v);
+        const uint64_t value = detail::LatencyHistogram::bucket_value(index);
+        ASSERT_LT(index, size_t(detail::LatencyHistogram::NumBuckets));
+        ASSERT_LE(std::abs(double(value) - double(v)) / v, 1. / detail::LatencyHistogram::SubBuckets);
+    }
+    ASSERT_EQ(size_t(detail::LatencyHistogram::NumBuckets - 1),
+              detail::LatencyHistogram::bucket_index(std::numeric_limits<uint64_t>::max()));
+}
+
+TEST_F(TimingProfiler_GTest, test_histogram_percentiles) {
+    // 1000 operations taking 1 to 1000 us
+    detail::OperationStoragePolicyHistogram storage;
+    const auto id = storage.intern("test");
+    for (int i = 1; i <= 1000; ++i) {
+        storage.insert(id, 2, detail::CpuTimes(std::chrono::microseconds(i)));
+    }
+
+    bool found = false;
+    auto stats = storage.get_latency_statistics("test", &found);
+    ASSERT_TRUE(found);
+    ASSERT_EQ(size_t(1000), stats.count);
+    ASSERT_EQ(size_t(2000), stats.num_processed_elements);
+    ASSERT_EQ(uint64_t(1000), stats.min_ns);
+    ASSERT_EQ(uint64_t(1000000), stats.max_ns);
+    ASSERT_EQ(uint64_t(500500000), stats.total_ns);
+    ASSERT_NEAR(500000., double(stats.percentile(0.5)), 500000. / 32);
+    ASSERT_NEAR(990000., double(stats.percentile(0.99)), 990000. / 32);
+    ASSERT_NEAR(999000., double(stats.percentile(0.999)), 999000. / 32);
+    ASSERT_EQ(uint64_t(1000000), stats.percentile(1.));
+    ASSERT_EQ(std::chrono::nanoseconds(500500000), storage.get_time("test").wall);
+    ASSERT_EQ(size_t(1000), storage.get_count("test"));
+
+    // a copy is a snapshot of the operations
+    detail::OperationStoragePolicyHistogram copy(storage);
+    storage.insert(id, 0, detail::CpuTimes(std::chrono::microseconds(1)));
+    ASSERT_EQ(size_t(1000), copy.get_count("test"));
+    ASSERT_EQ(size_t(1001), storage.get_count("test"));
+    ASSERT_NEAR(990000., double(copy.get_latency_statistics("test").percentile(0.99)), 990000. / 32);
+
+    copy.get_count("unknown", &found);
+    ASSERT_FALSE(found);
+}
+
+TEST_F(TimingProfiler_GTest, test_histogram_interned_operations) {
+    HistogramTimingProfiler profiler;
+    const auto id = profiler.intern("interned");
+    ASSERT_EQ(id.index, profiler.intern("interned").index);
+    {
+        HistogramTimingProfiler::TimedOperation op(id, 10, &profiler);
+    }
+    {
+        HistogramTimingProfiler::TimedOperation op("by name", &profiler);
+        op.setNumProcessedElements(5);
+    }
+
+    const auto storage_policy = profiler.get_storage_policy();
+    ASSERT_EQ(std::vector<std::string>({"interned", "by name"}), storage_policy.get_ordered_keys());
+    ASSERT_EQ(size_t(1), storage_policy.get_count("interned"));
+    ASSERT_EQ(size_t(10), storage_policy.get_num_processed_elements("interned"));
+    ASSERT_EQ(size_t(1), storage_policy.get_count("by name"));
+    ASSERT_EQ(size_t(5), storage_policy.get_num_processed_elements("by name"));
+
+    // interned operations can be given to the no-op profiler as well
+    TimingProfiler<false> noop_profiler;
+    TimingProfiler<false>::TimedOperation noop(noop_profiler.intern("interned"), &noop_profiler);
+}
+
+TEST_F(TimingProfiler_GTest, test_histogram_thread_safe) {
+    HistogramTimingProfiler profiler;
+    const auto id = profiler.intern("test");
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&profiler, id, t]() {
+            for (int i = 0; i < 1000; ++i) {
+                if (t % 2) {
+                    HistogramTimingProfiler::TimedOperation op(id, 1, &profiler);
+                } else {
+                    HistogramTimingProfiler::TimedOperation op("test", 1, &profiler);
+                }
+            }
+        });
+    }
+    // operations can be read while being timed
+    while (profiler.get_storage_policy().get_count("test") < 1000) {}
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    const auto storage_policy = profiler.get_storage_policy();
+    ASSERT_EQ(size_t(1), storage_policy.get_ordered_keys().size());
+    ASSERT_EQ(size_t(4000), storage_policy.get_count("test"));
+    ASSERT_EQ(size_t(4000), storage_policy.get_num_processed_elements("test"));
+}
+
 #if 0
 // We cannot guarantee that the test does not crash
 // Keep the code just for reference but do not activate it
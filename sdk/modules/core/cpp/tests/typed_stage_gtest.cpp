@@ -0,0 +1,213 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <numeric>
+#include <thread>
+#include <vector>
+#include <boost/any.hpp>
+#include <gtest/gtest.h>
+
+#include "metavision/sdk/core/pipeline/pipeline.h"
+#include "metavision/sdk/core/pipeline/stage.h"
+#include "metavision/sdk/core/pipeline/typed_stage.h"
+
+using namespace Metavision;
+
+namespace {
+// Typed stage producing the given data from its own thread
+struct TypedVectorProducingStage : public TypedStage<int, int> {
+    TypedVectorProducingStage(const std::vector<int> &datas) : datas(datas) {
+        set_starting_callback([this] {
+            thread_ = std::thread([this] {
+                for (size_t i = 0; i < this->datas.size() && !stopped_; ++i) {
+                    produce(this->datas[i]);
+                }
+                if (!stopped_)
+                    complete();
+            });
+        });
+        set_stopping_callback([this] {
+            stopped_ = true;
+            if (thread_.joinable()) {
+                thread_.join();
+            }
+        });
+    }
+    std::vector<int> datas;
+    std::thread thread_;
+    std::atomic<bool> stopped_{false};
+};
+
+// Untyped stage producing the given data as boost::any from its own thread
+struct VectorProducingStage : public BaseStage {
+    VectorProducingStage(const std::vector<int> &datas) {
+        set_starting_callback([this, datas] {
+            thread_ = std::thread([this, datas] {
+                for (auto d : datas) {
+                    produce(d);
+                }
+                complete();
+            });
+        });
+        set_stopping_callback([this] {
+            if (thread_.joinable()) {
+                thread_.join();
+            }
+        });
+    }
+    std::thread thread_;
+};
+
+// Typed stage multiplying the data it receives by a factor
+template<typename Input>
+struct TypedMultiplyingStage : public TypedStage<Input, int> {
+    template<typename PrevStage>
+    TypedMultiplyingStage(PrevStage &prev_stage, int factor, size_t channel_capacity) :
+        TypedStage<Input, int>(prev_stage, true, channel_capacity) {
+        this->set_consuming_callback([this, factor](int &&data) { this->produce(factor * data); });
+    }
+};
+
+struct TypedConsumingStage : public TypedStage<int, int> {
+    TypedConsumingStage(std::chrono::microseconds delay = std::chrono::microseconds(0)) {
+        set_consuming_callback([this, delay](int &&data) {
+            std::this_thread::sleep_for(delay);
+            datas.emplace_back(data);
+        });
+    }
+    std::vector<int> datas;
+};
+
+struct UntypedConsumingStage : public BaseStage {
+    UntypedConsumingStage() {
+        set_consuming_callback([this](const boost::any &data) {
+            try {
+                datas.emplace_back(boost::any_cast<int>(data));
+            } catch (boost::bad_any_cast &) {}
+        });
+    }
+    std::vector<int> datas;
+};
+
+std::vector<int> make_datas(size_t n) {
+    std::vector<int> datas(n);
+    std::iota(datas.begin(), datas.end(), 0);
+    return datas;
+}
+
+std::vector<int> multiplied(std::vector<int> datas, int factor) {
+    for (auto &d : datas) {
+        d *= factor;
+    }
+    return datas;
+}
+} // namespace
+
+TEST(TypedStageTest, typed_stages_pass_all_data_in_order) {
+    ////////////////////////////////////////////////////////////////////////////////
+    // PURPOSE
+    // Checks that data moved through the channels between typed stages are all consumed, in order
+    const auto datas = make_datas(1000);
+    Pipeline p(true);
+    auto &s1 = p.add_stage(std::make_unique<TypedVectorProducingStage>(datas));
+    auto &s2 = p.add_stage(std::make_unique<TypedMultiplyingStage<int>>(s1, 2, 16));
+    auto &s3 = p.add_stage(std::make_unique<TypedConsumingStage>(), s2);
+    p.run();
+
+    EXPECT_EQ(Pipeline::Status::Completed, p.status());
+    EXPECT_EQ(multiplied(datas, 2), s3.datas);
+}
+
+TEST(TypedStageTest, full_channel_keeps_order) {
+    ////////////////////////////////////////////////////////////////////////////////
+    // PURPOSE
+    // Checks that the data are still consumed in order when a slow stage fills its channel
+    const auto datas = make_datas(200);
+    Pipeline p(true);
+    auto &s1 = p.add_stage(std::make_unique<TypedVectorProducingStage>(datas));
+    auto &s2 = p.add_stage(std::make_unique<TypedMultiplyingStage<int>>(s1, 3, 2));
+    auto &s3 = p.add_stage(std::make_unique<TypedConsumingStage>(std::chrono::microseconds(100)), s2);
+    p.run();
+
+    EXPECT_EQ(Pipeline::Status::Completed, p.status());
+    EXPECT_EQ(multiplied(datas, 3), s3.datas);
+}
+
+TEST(TypedStageTest, typed_stage_copies_data_for_all_next_stages) {
+    ////////////////////////////////////////////////////////////////////////////////
+    // PURPOSE
+    // Checks that data produced by a typed stage are received by all its next stages, typed or not
+    const auto datas = make_datas(100);
+    Pipeline p;
+    auto &s1 = p.add_stage(std::make_unique<TypedVectorProducingStage>(datas));
+    auto &s2 = p.add_stage(std::make_unique<TypedConsumingStage>(), s1);
+    auto &s3 = p.add_stage(std::make_unique<TypedConsumingStage>(), s1);
+    auto &s4 = p.add_stage(std::make_unique<UntypedConsumingStage>(), s1);
+    p.run();
+
+    EXPECT_EQ(Pipeline::Status::Completed, p.status());
+    EXPECT_EQ(datas, s2.datas);
+    EXPECT_EQ(datas, s3.datas);
+    EXPECT_EQ(datas, s4.datas);
+}
+
+TEST(TypedStageTest, typed_stage_between_untyped_stages) {
+    ////////////////////////////////////////////////////////////////////////////////
+    // PURPOSE
+    // Checks that a typed stage consumes the data of an untyped stage and produces data for an untyped stage
+    const auto datas = make_datas(100);
+    Pipeline p(true);
+    auto &s1 = p.add_stage(std::make_unique<VectorProducingStage>(datas));
+    auto &s2 = p.add_stage(std::make_unique<TypedMultiplyingStage<int>>(s1, 2, 16));
+    auto &s3 = p.add_stage(std::make_unique<UntypedConsumingStage>(), s2);
+    p.run();
+
+    EXPECT_EQ(Pipeline::Status::Completed, p.status());
+    EXPECT_EQ(multiplied(datas, 2), s3.datas);
+}
+
+TEST(TypedStageTest, typed_stages_with_work_stealing) {
+    ////////////////////////////////////////////////////////////////////////////////
+    // PURPOSE
+    // Checks that the channels between typed stages keep the order of the data when the stages are run by a pool of
+    // workers
+    const auto datas = make_datas(1000);
+    Pipeline p(true, Pipeline::SchedulingPolicy::WorkStealing, 3);
+    auto &s1 = p.add_stage(std::make_unique<TypedVectorProducingStage>(datas));
+    auto &s2 = p.add_stage(std::make_unique<TypedMultiplyingStage<int>>(s1, 2, 8));
+    auto &s3 = p.add_stage(std::make_unique<TypedMultiplyingStage<int>>(s2, 5, 8));
+    auto &s4 = p.add_stage(std::make_unique<TypedConsumingStage>(), s3);
+    p.run();
+
+    EXPECT_EQ(Pipeline::Status::Completed, p.status());
+    EXPECT_EQ(multiplied(datas, 10), s4.datas);
+}
+
+TEST(TypedStageTest, input_queue_limit_between_typed_stages) {
+    ////////////////////////////////////////////////////////////////////////////////
+    // PURPOSE
+    // Checks that an input queue limit set between typed stages bounds the pending data
+    const auto datas = make_datas(200);
+    Pipeline p(true);
+    auto &s1 = p.add_stage(std::make_unique<TypedVectorProducingStage>(datas));
+    auto &s2 = p.add_stage(std::make_unique<TypedConsumingStage>(std::chrono::microseconds(100)), s1);
+    s2.set_input_queue_limit(s1, 4, BaseStage::InputQueuePolicy::Block);
+    size_t max_queue_size = 0;
+    p.add_pre_step_callback([&] { max_queue_size = std::max(max_queue_size, s2.input_queue_size()); });
+    p.run();
+
+    EXPECT_EQ(Pipeline::Status::Completed, p.status());
+    EXPECT_EQ(datas, s2.datas);
+    EXPECT_GE(size_t(4), max_queue_size);
+}
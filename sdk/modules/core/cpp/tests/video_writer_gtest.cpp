@@ -0,0 +1,64 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <fstream>
+#include <iterator>
+#include <vector>
+#include <opencv2/core.hpp>
+
+#include "metavision/utils/gtest/gtest_with_tmp_dir.h"
+#include "metavision/sdk/core/utils/video_writer.h"
+
+using namespace Metavision;
+
+class VideoWriter_GTest : public GTestWithTmpDir {
+protected:
+    // Writes frames whose content changes with their index, and returns the content of the video file
+    std::vector<char> write_video(const std::string &filename, std::size_t queue_size,
+                                  VideoWriter::AsyncQueuePolicy policy = VideoWriter::AsyncQueuePolicy::Block) {
+        VideoWriter writer(filename, cv::VideoWriter::fourcc('M', 'J', 'P', 'G'), 30, cv::Size(64, 48));
+        EXPECT_TRUE(writer.isOpened());
+        writer.set_async(queue_size, policy);
+        cv::Mat frame(48, 64, CV_8UC3);
+        for (int i = 0; i < n_frames_; ++i) {
+            frame.setTo(cv::Scalar(i, 2 * i, 3 * i));
+            writer.write(frame);
+        }
+        n_dropped_frames_ = writer.get_n_dropped_frames();
+        writer.release();
+
+        std::ifstream ifs(filename, std::ios::binary);
+        return std::vector<char>(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+    }
+
+    const int n_frames_           = 100;
+    std::size_t n_dropped_frames_ = 0;
+};
+
+TEST_F(VideoWriter_GTest, async_writes_same_video_as_sync) {
+    // GIVEN the same frames written synchronously and asynchronously
+    const auto sync_video  = write_video(tmpdir_handler_->get_full_path("sync.avi"), 0);
+    const auto async_video = write_video(tmpdir_handler_->get_full_path("async.avi"), 4);
+
+    // THEN no frame is dropped and the videos are the same
+    ASSERT_EQ(0u, n_dropped_frames_);
+    ASSERT_FALSE(sync_video.empty());
+    ASSERT_EQ(sync_video, async_video);
+}
+
+TEST_F(VideoWriter_GTest, async_drops_frames_when_queue_is_full) {
+    // GIVEN frames written faster than they are encoded, with a queue of one frame dropping the frames
+    const auto video = write_video(tmpdir_handler_->get_full_path("drop.avi"), 1, VideoWriter::AsyncQueuePolicy::Drop);
+
+    // THEN the video is written, and at most all the frames but the first one are dropped
+    ASSERT_FALSE(video.empty());
+    ASSERT_LT(n_dropped_frames_, static_cast<std::size_t>(n_frames_));
+}
@@ -0,0 +1,105 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "metavision/sdk/core/utils/detail/work_stealing_deque.h"
+
+using Metavision::detail::WorkStealingDeque;
+
+TEST(WorkStealingDeque_GTest, empty_after_construction) {
+    WorkStealingDeque<int> d;
+    int item;
+    EXPECT_TRUE(d.empty());
+    EXPECT_FALSE(d.pop(item));
+    EXPECT_FALSE(d.steal(item));
+}
+
+TEST(WorkStealingDeque_GTest, pop_returns_last_pushed_and_steal_first_pushed) {
+    WorkStealingDeque<int> d;
+    for (int i = 0; i < 4; ++i) {
+        d.push(i);
+    }
+
+    int item;
+    ASSERT_TRUE(d.pop(item));
+    EXPECT_EQ(3, item);
+    ASSERT_TRUE(d.steal(item));
+    EXPECT_EQ(0, item);
+    ASSERT_TRUE(d.pop(item));
+    EXPECT_EQ(2, item);
+    ASSERT_TRUE(d.steal(item));
+    EXPECT_EQ(1, item);
+    EXPECT_TRUE(d.empty());
+}
+
+TEST(WorkStealingDeque_GTest, grows_when_full) {
+    // GIVEN a deque with a capacity smaller than the number of pushed items
+    WorkStealingDeque<int> d(2);
+    for (int i = 0; i < 100; ++i) {
+        d.push(i);
+    }
+
+    // THEN all the items are kept
+    int item;
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_TRUE(d.steal(item));
+        EXPECT_EQ(i, item);
+    }
+    EXPECT_TRUE(d.empty());
+}
+
+TEST(WorkStealingDeque_GTest, each_item_is_taken_once_with_concurrent_thieves) {
+    // GIVEN an owner pushing and popping items while other threads steal them
+    static constexpr int NumItems   = 100000;
+    static constexpr int NumThieves = 3;
+    WorkStealingDeque<int> d(4);
+    std::vector<std::atomic<int>> taken(NumItems);
+    for (auto &t : taken) {
+        t = 0;
+    }
+    std::atomic<bool> done{false};
+
+    std::vector<std::thread> thieves;
+    for (int i = 0; i < NumThieves; ++i) {
+        thieves.emplace_back([&]() {
+            int item;
+            while (!done || !d.empty()) {
+                if (d.steal(item)) {
+                    ++taken[item];
+                }
+            }
+        });
+    }
+
+    int item;
+    for (int i = 0; i < NumItems; ++i) {
+        d.push(i);
+        if (i % 3 == 0 && d.pop(item)) {
+            ++taken[item];
+        }
+    }
+    while (d.pop(item)) {
+        ++taken[item];
+    }
+    done = true;
+    for (auto &t : thieves) {
+        t.join();
+    }
+
+    // THEN each item has been taken exactly once
+    for (int i = 0; i < NumItems; ++i) {
+        ASSERT_EQ(1, taken[i]) << "item " << i;
+    }
+}
@@ -32,6 +32,7 @@ void static_generate_frame_helper(const py::array_t<EventCD> &events, py::array
     }
     auto nelem   = static_cast<size_t>(info.shape[0]);
     auto *in_ptr = static_cast<EventCD *>(info.ptr);
+    py::gil_scoped_release release;
     BaseFrameGenerationAlgorithm::generate_frame_from_events(in_ptr, in_ptr + nelem, img_cv, accumulation_time_us,
                                                              palette);
 }
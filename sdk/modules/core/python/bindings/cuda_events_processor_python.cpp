@@ -0,0 +1,88 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#include <pybind11/functional.h>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/core/cuda/cuda_events_processor.h"
+#include "metavision/utils/pybind/dlpack_helper.h"
+#include "pb_doc_core.h"
+
+namespace py = pybind11;
+
+namespace Metavision {
+
+namespace { // anonymous
+
+void process_events_helper(CudaEventsProcessor &processor, const py::array_t<EventCD> &events) {
+    auto info = events.request();
+    if (info.ndim != 1) {
+        throw std::runtime_error("Bad input numpy array dimension " + std::to_string(info.ndim) +
+                                 " should be equal to 1");
+    }
+    const auto *begin = static_cast<const EventCD *>(info.ptr);
+    const auto *end   = begin + info.shape[0];
+    py::gil_scoped_release release;
+    processor.process_events(begin, end);
+}
+
+} // anonymous namespace
+
+void export_cuda_events_processor(py::module &m) {
+    py::class_<CudaEventsProcessor>(m, "CudaEventsProcessor", pybind_doc_core["Metavision::CudaEventsProcessor"])
+        .def(py::init<int, int, int, size_t>(), py::arg("width"), py::arg("height"), py::arg("device_id") = 0,
+             py::arg("upload_capacity") = 1 << 20,
+             pybind_doc_core["Metavision::CudaEventsProcessor::CudaEventsProcessor"])
+        .def(
+            "set_periodic_frame_generation",
+            [](CudaEventsProcessor &processor, uint32_t accumulation_time_us, double fps, py::function cb) {
+                // The callback is called from process_events, which does not hold the GIL
+                processor.set_periodic_frame_generation(accumulation_time_us, fps, [cb](timestamp ts) {
+                    py::gil_scoped_acquire acquire;
+                    cb(ts);
+                });
+            },
+            py::arg("accumulation_time_us"), py::arg("fps"), py::arg("frame_callback"),
+            pybind_doc_core["Metavision::CudaEventsProcessor::set_periodic_frame_generation"])
+        .def("set_color_palette", &CudaEventsProcessor::set_color_palette, py::arg("palette"),
+             pybind_doc_core["Metavision::CudaEventsProcessor::set_color_palette"])
+        .def("process_events", &process_events_helper, py::arg("events"),
+             pybind_doc_core["Metavision::CudaEventsProcessor::process_events"])
+        .def("generate_frame", &CudaEventsProcessor::generate_frame, py::arg("ts"), py::arg("accumulation_time_us"),
+             py::call_guard<py::gil_scoped_release>(),
+             pybind_doc_core["Metavision::CudaEventsProcessor::generate_frame"])
+        .def("reset_histogram", &CudaEventsProcessor::reset_histogram,
+             pybind_doc_core["Metavision::CudaEventsProcessor::reset_histogram"])
+        .def("reset_time_surface", &CudaEventsProcessor::reset_time_surface,
+             pybind_doc_core["Metavision::CudaEventsProcessor::reset_time_surface"])
+        .def("synchronize", &CudaEventsProcessor::synchronize, py::call_guard<py::gil_scoped_release>(),
+             pybind_doc_core["Metavision::CudaEventsProcessor::synchronize"])
+        .def(
+            "time_surface",
+            [](CudaEventsProcessor &processor) { return to_dlpack_capsule(processor.export_time_surface()); },
+            "Exports the time surface as a DLPack capsule of shape (height, width, 2), of int64 timestamps, to be "
+            "consumed by torch.utils.dlpack.from_dlpack for instance. The tensor is a view of the device memory.")
+        .def(
+            "histogram",
+            [](CudaEventsProcessor &processor) { return to_dlpack_capsule(processor.export_histogram()); },
+            "Exports the histogram as a DLPack capsule of shape (height, width, 2), of int32 counts, to be consumed by "
+            "torch.utils.dlpack.from_dlpack for instance. The tensor is a view of the device memory.")
+        .def(
+            "frame", [](CudaEventsProcessor &processor) { return to_dlpack_capsule(processor.export_frame()); },
+            "Exports the frame as a DLPack capsule of shape (height, width, 3), of uint8 BGR values, to be consumed by "
+            "torch.utils.dlpack.from_dlpack for instance. The tensor is a view of the device memory.")
+        .def("get_device_id", &CudaEventsProcessor::get_device_id,
+             pybind_doc_core["Metavision::CudaEventsProcessor::get_device_id"]);
+}
+
+} // namespace Metavision
@@ -0,0 +1,48 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/utils/pybind/sync_algorithm_process_helper.h"
+#include "metavision/sdk/core/algorithms/downsampling_algorithm.h"
+#include "pb_doc_core.h"
+
+namespace Metavision {
+
+void export_downsampling_algorithm(py::module &m) {
+    py::class_<DownsamplingAlgorithm>(m, "DownsamplingAlgorithm", pybind_doc_core["Metavision::DownsamplingAlgorithm"])
+        .def(py::init<int, int, int, timestamp>(), py::arg("width"), py::arg("height"), py::arg("factor"),
+             py::arg("refractory_period_us") = 0,
+             pybind_doc_core["Metavision::DownsamplingAlgorithm::DownsamplingAlgorithm"])
+        .def("process_events", &process_events_array_sync<DownsamplingAlgorithm, EventCD>, py::arg("input_np"),
+             py::arg("output_buf"), doc_process_events_array_sync_str)
+        .def("process_events", &process_events_buffer_sync<DownsamplingAlgorithm, EventCD>, py::arg("input_buf"),
+             py::arg("output_buf"), doc_process_events_buffer_sync_str)
+        .def("process_events_into", &process_events_array_sync_into<DownsamplingAlgorithm, EventCD>,
+             py::arg("input_np"), py::arg("output_np"), doc_process_events_array_sync_into_str)
+        .def("process_events_", &process_events_buffer_sync_inplace<DownsamplingAlgorithm, EventCD>,
+             py::arg("events_buf"), doc_process_events_buffer_sync_inplace_str)
+        .def_static("get_empty_output_buffer", &getEmptyPODBuffer<EventCD>, doc_get_empty_output_buffer_str)
+        .def("get_factor", &DownsamplingAlgorithm::get_factor,
+             pybind_doc_core["Metavision::DownsamplingAlgorithm::get_factor"])
+        .def("get_output_width", &DownsamplingAlgorithm::get_output_width,
+             pybind_doc_core["Metavision::DownsamplingAlgorithm::get_output_width"])
+        .def("get_output_height", &DownsamplingAlgorithm::get_output_height,
+             pybind_doc_core["Metavision::DownsamplingAlgorithm::get_output_height"])
+        .def_property("refractory_period_us", &DownsamplingAlgorithm::get_refractory_period,
+                      &DownsamplingAlgorithm::set_refractory_period,
+                      pybind_doc_core["Metavision::DownsamplingAlgorithm::set_refractory_period"])
+        .def("reset", &DownsamplingAlgorithm::reset, pybind_doc_core["Metavision::DownsamplingAlgorithm::reset"]);
+}
+
+} // namespace Metavision
@@ -0,0 +1,89 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#include <opencv2/core/mat.hpp>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/core/utils/event_rate_map.h"
+#include "pb_doc_core.h"
+
+namespace py = pybind11;
+
+namespace Metavision {
+
+namespace { // anonymous
+
+void process_events_helper(EventRateMap &map, const py::array_t<EventCD> &events) {
+    auto info = events.request();
+    if (info.ndim != 1) {
+        throw std::runtime_error("Bad input numpy array dimension " + std::to_string(info.ndim) +
+                                 " should be equal to 1");
+    }
+    const auto *begin = static_cast<const EventCD *>(info.ptr);
+    const auto *end   = begin + info.shape[0];
+    py::gil_scoped_release release;
+    map.process_events(begin, end);
+}
+
+// The counts are compact and row-major, the array is a view of them keeping the map alive
+py::array_t<float> numpy_helper(py::object self, timestamp ts) {
+    auto &map = self.cast<EventRateMap &>();
+    map.decay(ts);
+    return py::array_t<float>({map.get_map_height(), map.get_map_width()}, map.data(), self);
+}
+
+py::array_t<float> generate_rates_helper(const EventRateMap &map, timestamp ts) {
+    py::array_t<float> rates({map.get_map_height(), map.get_map_width()});
+    cv::Mat rates_cv(map.get_map_height(), map.get_map_width(), CV_32FC1, rates.mutable_data());
+    map.generate_rates(ts, rates_cv);
+    return rates;
+}
+
+} // anonymous namespace
+
+void export_event_rate_map(py::module &m) {
+    using namespace pybind11::literals;
+
+    py::class_<EventRateMap, std::shared_ptr<EventRateMap>>(m, "EventRateMap",
+                                                            pybind_doc_core["Metavision::EventRateMap"])
+        .def(py::init<int, int, timestamp, int>(), "width"_a, "height"_a, "decay_time_us"_a, "block_size"_a = 1,
+             pybind_doc_core["Metavision::EventRateMap::EventRateMap"])
+        .def("process_events", &process_events_helper, "events_np"_a,
+             "Counts the events of a numpy array of EventCD")
+        .def("decay", &EventRateMap::decay, "ts"_a, pybind_doc_core["Metavision::EventRateMap::decay"])
+        .def("numpy", &numpy_helper, "ts"_a,
+             "Applies the decay of the counts up to a timestamp and returns them as a numpy array of float32\n"
+             "\n"
+             "   The array is a view of the counts of the map, keeping it alive, and is only valid until the next "
+             "events are processed.\n"
+             "\n"
+             "   :ts: Timestamp at which the counts are read, not older than the last events processed")
+        .def("get_count", &EventRateMap::get_count, "x"_a, "y"_a, "ts"_a,
+             pybind_doc_core["Metavision::EventRateMap::get_count"])
+        .def("get_rate", &EventRateMap::get_rate, "x"_a, "y"_a, "ts"_a,
+             pybind_doc_core["Metavision::EventRateMap::get_rate"])
+        .def("generate_rates", &generate_rates_helper, "ts"_a,
+             "Returns the event rates of the cells, in Hz, as a numpy array of float32\n"
+             "\n"
+             "   :ts: Timestamp at which the rates are read, not older than the last events processed")
+        .def("get_map_width", &EventRateMap::get_map_width, pybind_doc_core["Metavision::EventRateMap::get_map_width"])
+        .def("get_map_height", &EventRateMap::get_map_height,
+             pybind_doc_core["Metavision::EventRateMap::get_map_height"])
+        .def("get_block_size", &EventRateMap::get_block_size,
+             pybind_doc_core["Metavision::EventRateMap::get_block_size"])
+        .def("get_decay_time", &EventRateMap::get_decay_time,
+             pybind_doc_core["Metavision::EventRateMap::get_decay_time"])
+        .def("reset", &EventRateMap::reset, pybind_doc_core["Metavision::EventRateMap::reset"]);
+}
+
+} // namespace Metavision
@@ -0,0 +1,109 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_EVENTS_SLICE_ITERATOR_H
+#define METAVISION_SDK_CORE_EVENTS_SLICE_ITERATOR_H
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "metavision/hal/device/device.h"
+#include "metavision/hal/facilities/i_decoder.h"
+#include "metavision/hal/facilities/i_device_control.h"
+#include "metavision/hal/facilities/i_event_decoder.h"
+#include "metavision/hal/facilities/i_events_stream.h"
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/core/algorithms/shared_cd_events_buffer_producer_algorithm.h"
+
+namespace Metavision {
+
+/// @brief Iterates over slices of CD events of a device, decoded by a background thread
+///
+/// The data of the device are read and decoded by a thread of its own, which does not need the Python interpreter,
+/// and the events are accumulated into slices of fixed duration or number of events by a
+/// @ref SharedCdEventsBufferProducerAlgorithm. The slices are queued until they are retrieved with @ref next, or with
+/// @ref try_next by an event loop watching the file descriptor returned by @ref get_notification_fd.
+class EventsSliceIterator {
+public:
+    using EventsBufferPtr = SharedCdEventsBufferProducerAlgorithm::SharedEventsBuffer;
+
+    /// @brief Constructor, starting the device and the decoding thread
+    /// @param device Device to read the events of, which must outlive the iterator
+    /// @param params Parameters of the slices
+    /// @param max_queued_slices Maximum number of slices waiting to be retrieved, the decoding thread waiting when it
+    /// is reached
+    EventsSliceIterator(Device &device, const SharedEventsBufferProducerParameters &params, size_t max_queued_slices);
+
+    /// @brief Destructor, stopping the device and the decoding thread
+    ~EventsSliceIterator();
+
+    /// @brief Gets the next slice of events, waiting for it if needed
+    /// @param end_ts Timestamp of the end of the slice
+    /// @param events Events of the slice
+    /// @return false if the device has no more events
+    bool next(timestamp &end_ts, EventsBufferPtr &events);
+
+    /// @brief Result of @ref try_next
+    enum class Status { Slice, NotReady, Done };
+
+    /// @brief Gets the next slice of events if it is available, without waiting
+    ///
+    /// The notifications pending on the file descriptor returned by @ref get_notification_fd are consumed first, so
+    /// that the descriptor becomes readable again only once a new slice is queued, or the stream ends.
+    /// @param end_ts Timestamp of the end of the slice
+    /// @param events Events of the slice
+    /// @return Status::Slice if a slice was retrieved, Status::NotReady if none is queued yet, Status::Done if the
+    /// device has no more events
+    Status try_next(timestamp &end_ts, EventsBufferPtr &events);
+
+    /// @brief Gets a file descriptor becoming readable when a slice is queued in an empty queue or the stream ends
+    ///
+    /// It can be watched by an event loop (e.g. with asyncio's add_reader), which then calls @ref try_next until it
+    /// returns Status::NotReady. It must not be read or closed by the caller.
+    /// @return The file descriptor, or -1 if notifications are not supported on this platform
+    int get_notification_fd() const;
+
+    /// @brief Stops the device and the decoding thread, the slices already queued remaining available
+    void stop();
+
+private:
+    void run();
+    void notify();
+    void clear_notifications();
+    bool pop_slice(timestamp &end_ts, EventsBufferPtr &events);
+
+    I_EventsStream *events_stream_;
+    I_Decoder *decoder_;
+    I_EventDecoder<EventCD> *cd_decoder_;
+    I_DeviceControl *device_control_;
+    size_t cd_callback_id_;
+    SharedCdEventsBufferProducerAlgorithm producer_;
+
+    const size_t max_queued_slices_;
+    std::deque<std::pair<timestamp, EventsBufferPtr>> slices_;
+    bool done_    = false;
+    bool stopped_ = false;
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::thread thread_;
+
+    // Read and write ends of the notifications, which are the same eventfd on Linux and a pipe on other POSIX systems
+    int notification_read_fd_  = -1;
+    int notification_write_fd_ = -1;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_CORE_EVENTS_SLICE_ITERATOR_H
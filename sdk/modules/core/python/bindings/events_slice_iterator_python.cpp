@@ -0,0 +1,256 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#ifdef __linux__
+#include <sys/eventfd.h>
+#endif
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+
+#include "events_slice_iterator.h"
+
+namespace py = pybind11;
+
+namespace Metavision {
+
+EventsSliceIterator::EventsSliceIterator(Device &device, const SharedEventsBufferProducerParameters &params,
+                                         size_t max_queued_slices) :
+    events_stream_(device.get_facility<I_EventsStream>()),
+    decoder_(device.get_facility<I_Decoder>()),
+    cd_decoder_(device.get_facility<I_EventDecoder<EventCD>>()),
+    device_control_(device.get_facility<I_DeviceControl>()),
+    producer_(params,
+              [this](timestamp end_ts, const EventsBufferPtr &events) {
+                  std::unique_lock<std::mutex> lock(mutex_);
+                  // The decoding waits for the consumer, the data being buffered upstream by the events stream
+                  cond_.wait(lock, [this]() { return slices_.size() < max_queued_slices_ || stopped_; });
+                  slices_.emplace_back(end_ts, events);
+                  cond_.notify_all();
+                  // The consumer empties the queue before waiting for a notification, which is hence only needed
+                  // when the queue was empty
+                  if (slices_.size() == 1) {
+                      notify();
+                  }
+              }),
+    max_queued_slices_(std::max<size_t>(max_queued_slices, 1)) {
+    if (!events_stream_ || !decoder_ || !cd_decoder_) {
+        throw std::runtime_error("The device does not provide the facilities needed to decode its CD events.");
+    }
+#if defined(__linux__)
+    notification_read_fd_ = notification_write_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+#elif !defined(_WIN32)
+    int fds[2];
+    if (pipe(fds) == 0) {
+        for (int fd : fds) {
+            fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+            fcntl(fd, F_SETFD, FD_CLOEXEC);
+        }
+        notification_read_fd_  = fds[0];
+        notification_write_fd_ = fds[1];
+    }
+#endif
+    cd_callback_id_ = cd_decoder_->add_event_buffer_callback(
+        [this](const EventCD *begin, const EventCD *end) { producer_.process_events(begin, end); });
+
+    events_stream_->start();
+    if (device_control_) {
+        device_control_->start();
+    }
+    thread_ = std::thread([this]() { run(); });
+}
+
+EventsSliceIterator::~EventsSliceIterator() {
+    stop();
+    cd_decoder_->remove_callback(cd_callback_id_);
+#ifndef _WIN32
+    if (notification_read_fd_ >= 0) {
+        close(notification_read_fd_);
+    }
+    if (notification_write_fd_ >= 0 && notification_write_fd_ != notification_read_fd_) {
+        close(notification_write_fd_);
+    }
+#endif
+}
+
+void EventsSliceIterator::run() {
+    while (events_stream_->wait_next_buffer() >= 0) {
+        long n_rawbytes                = 0;
+        I_EventsStream::RawData *begin = events_stream_->get_latest_raw_data(n_rawbytes);
+        decoder_->decode(begin, begin + n_rawbytes);
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopped_) {
+            break;
+        }
+    }
+
+    // The last slice is incomplete when the stream ends
+    producer_.flush();
+    std::lock_guard<std::mutex> lock(mutex_);
+    done_ = true;
+    cond_.notify_all();
+    notify();
+}
+
+bool EventsSliceIterator::pop_slice(timestamp &end_ts, EventsBufferPtr &events) {
+    if (slices_.empty()) {
+        return false;
+    }
+    end_ts = slices_.front().first;
+    events = std::move(slices_.front().second);
+    slices_.pop_front();
+    cond_.notify_all();
+    return true;
+}
+
+bool EventsSliceIterator::next(timestamp &end_ts, EventsBufferPtr &events) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cond_.wait(lock, [this]() { return !slices_.empty() || done_; });
+    return pop_slice(end_ts, events);
+}
+
+EventsSliceIterator::Status EventsSliceIterator::try_next(timestamp &end_ts, EventsBufferPtr &events) {
+    clear_notifications();
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (pop_slice(end_ts, events)) {
+        return Status::Slice;
+    }
+    return done_ ? Status::Done : Status::NotReady;
+}
+
+int EventsSliceIterator::get_notification_fd() const {
+    return notification_read_fd_;
+}
+
+void EventsSliceIterator::notify() {
+#ifndef _WIN32
+    if (notification_write_fd_ >= 0) {
+        // An eventfd is written 8 bytes at a time, a pipe 1 byte. The write can only fail if notifications are
+        // already pending, which is enough to wake the consumer up
+        const uint64_t one = 1;
+        const size_t size  = notification_read_fd_ == notification_write_fd_ ? sizeof(one) : 1;
+        const ssize_t ret  = write(notification_write_fd_, &one, size);
+        static_cast<void>(ret);
+    }
+#endif
+}
+
+void EventsSliceIterator::clear_notifications() {
+#ifndef _WIN32
+    if (notification_read_fd_ >= 0) {
+        char buffer[64];
+        while (read(notification_read_fd_, buffer, sizeof(buffer)) > 0) {}
+    }
+#endif
+}
+
+void EventsSliceIterator::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopped_) {
+            return;
+        }
+        stopped_ = true;
+        cond_.notify_all();
+    }
+    // Stopping the stream wakes the decoding thread up if it is waiting for data
+    if (device_control_) {
+        device_control_->stop();
+    }
+    events_stream_->stop();
+    thread_.join();
+}
+
+namespace {
+struct Memo {
+    EventsSliceIterator::EventsBufferPtr ptr;
+};
+
+py::tuple make_slice(timestamp end_ts, const EventsSliceIterator::EventsBufferPtr &events) {
+    // The capsule holds a reference to the slice, which goes back to the pool when the array is collected
+    auto memo     = new Memo{events};
+    auto capsule  = py::capsule(memo, [](void *v) { delete reinterpret_cast<Memo *>(v); });
+    auto py_array = py::array_t<EventCD>(events->size(), events->data(), capsule);
+    return py::make_tuple(end_ts, py_array);
+}
+} // namespace
+
+void export_events_slice_iterator(py::module &m) {
+    py::class_<EventsSliceIterator>(
+        m, "EventsSliceIterator",
+        "Iterates over slices of CD events of a device from Metavision HAL\n\n"
+        "The data of the device are read and decoded by a background thread, without holding the GIL, and the events "
+        "are accumulated into slices of fixed duration and/or number of events. Each iteration returns the timestamp "
+        "of the end of a slice and a numpy array of its events, which is not a copy.")
+        .def(py::init([](Device &device, uint32_t event_count, uint32_t time_slice_us, size_t max_queued_slices) {
+                 SharedEventsBufferProducerParameters params;
+                 params.buffers_events_count_  = event_count;
+                 params.buffers_time_slice_us_ = time_slice_us;
+                 params.bounded_memory_pool_   = false;
+                 return new EventsSliceIterator(device, params, max_queued_slices);
+             }),
+             py::arg("device"), py::arg("event_count") = 0, py::arg("time_slice_us") = 10000,
+             py::arg("max_queued_slices") = 64, py::keep_alive<1, 2>(),
+             "Args:\n"
+             "    device (Device): device to read the events of, which is started by the iterator\n"
+             "    event_count (int): number of events in each slice\n"
+             "    time_slice_us (int): duration of each slice in us\n"
+             "    max_queued_slices (int): number of slices decoded in advance, the decoding waiting when it is "
+             "reached\n")
+        .def("__iter__", [](EventsSliceIterator &self) -> EventsSliceIterator & { return self; })
+        .def("__next__",
+             [](EventsSliceIterator &self) {
+                 timestamp end_ts;
+                 EventsSliceIterator::EventsBufferPtr events;
+                 bool available;
+                 {
+                     py::gil_scoped_release release;
+                     available = self.next(end_ts, events);
+                 }
+                 if (!available) {
+                     throw py::stop_iteration();
+                 }
+                 return make_slice(end_ts, events);
+             })
+        .def(
+            "try_next",
+            [](EventsSliceIterator &self) -> py::object {
+                timestamp end_ts;
+                EventsSliceIterator::EventsBufferPtr events;
+                switch (self.try_next(end_ts, events)) {
+                case EventsSliceIterator::Status::Slice:
+                    return make_slice(end_ts, events);
+                case EventsSliceIterator::Status::NotReady:
+                    return py::none();
+                default:
+                    throw py::stop_iteration();
+                }
+            },
+            "Gets the next slice without waiting for it.\n\n"
+            "Returns the same tuple as the iteration, or None if no slice is decoded yet. Raises StopIteration when "
+            "the device has no more events.")
+        .def("fileno", &EventsSliceIterator::get_notification_fd,
+             "Gets a file descriptor becoming readable when a slice is decoded while none was queued, or when the "
+             "device has no more events.\n\n"
+             "It is meant to be watched by an event loop, which then calls try_next until it returns None (see "
+             "metavision_core.event_io.AsyncEventsIterator). Returns -1 if notifications are not supported on this "
+             "platform.")
+        .def("stop", &EventsSliceIterator::stop, py::call_guard<py::gil_scoped_release>(),
+             "Stops the device and the decoding thread. The slices already decoded can still be iterated over.");
+}
+
+} // namespace Metavision
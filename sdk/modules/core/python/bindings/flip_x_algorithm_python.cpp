@@ -27,6 +27,8 @@ void export_flip_x_algorithm(py::module &m) {
              py::arg("output_buf"), doc_process_events_array_sync_str)
         .def("process_events", &process_events_buffer_sync<FlipXAlgorithm, EventCD>, py::arg("input_buf"),
              py::arg("output_buf"), doc_process_events_buffer_sync_str)
+        .def("process_events_into", &process_events_array_sync_into<FlipXAlgorithm, EventCD>, py::arg("input_np"),
+             py::arg("output_np"), doc_process_events_array_sync_into_str)
         .def("process_events_", &process_events_array_sync_inplace<FlipXAlgorithm, EventCD>, py::arg("events_np"),
              doc_process_events_array_sync_inplace_str)
         .def_static("get_empty_output_buffer", &getEmptyPODBuffer<EventCD>, doc_get_empty_output_buffer_str)
@@ -39,6 +39,12 @@ PythonBindingsDoc pybind_doc_core;
 
 void export_base_frame_generation_algorithm(py::module &);
 void export_colors(py::module &);
+#ifdef METAVISION_SDK_CORE_CUDA
+void export_cuda_events_processor(py::module &);
+#endif
+void export_downsampling_algorithm(py::module &);
+void export_event_rate_map(py::module &);
+void export_events_slice_iterator(py::module &);
 void export_flip_x_algorithm(py::module &);
 void export_flip_y_algorithm(py::module &);
 void export_on_demand_frame_generation_algorithm(py::module &);
@@ -46,8 +52,10 @@ void export_mostrecent_timestamp_buffer(py::module &m);
 void export_periodic_frame_generation_algorithm(py::module &);
 void export_polarity_filter_algorithm(py::module &);
 void export_polarity_inverter_algorithm(py::module &);
+void export_refractory_filter_algorithm(py::module &);
 void export_roi_filter_algorithm(py::module &);
 void export_shared_cd_events_buffer_producer(py::module &);
+void export_tensor_generation_algorithm(py::module &);
 void export_timesurface_producer_algorithm(py::module &);
 } // namespace Metavision
 
@@ -68,13 +76,23 @@ PYBIND11_MODULE(MODULE_NAME, m) {
 
     // 3. Export algos
     Metavision::export_base_frame_generation_algorithm(m);
+    Metavision::export_downsampling_algorithm(m);
+    Metavision::export_event_rate_map(m);
     Metavision::export_flip_x_algorithm(m);
     Metavision::export_flip_y_algorithm(m);
     Metavision::export_on_demand_frame_generation_algorithm(m);
     Metavision::export_periodic_frame_generation_algorithm(m);
     Metavision::export_polarity_filter_algorithm(m);
     Metavision::export_polarity_inverter_algorithm(m);
+    Metavision::export_refractory_filter_algorithm(m);
     Metavision::export_roi_filter_algorithm(m);
     Metavision::export_shared_cd_events_buffer_producer(m);
+    Metavision::export_tensor_generation_algorithm(m);
     Metavision::export_timesurface_producer_algorithm(m);
+#ifdef METAVISION_SDK_CORE_CUDA
+    Metavision::export_cuda_events_processor(m);
+#endif
+
+    // 4. Export stream utilities
+    Metavision::export_events_slice_iterator(m);
 }
@@ -13,6 +13,7 @@
 #include <pybind11/numpy.h>
 
 #include "metavision/sdk/core/utils/mostrecent_timestamp_buffer.h"
+#include "metavision/utils/pybind/dlpack_helper.h"
 #include "metavision/utils/pybind/py_array_to_cv_mat.h"
 
 #include "pb_doc_core.h"
@@ -20,39 +21,50 @@
 namespace Metavision {
 
 namespace {
-py::array_t<timestamp> numpy_time_surface_helper(MostRecentTimestampBuffer &time_surface, bool copy = false) {
+std::vector<py::ssize_t> shape_time_surface_helper(const MostRecentTimestampBuffer &time_surface) {
     std::vector<py::ssize_t> shape = {time_surface.rows(), time_surface.cols()};
     if (time_surface.channels() != 1)
         shape.emplace_back(time_surface.channels());
+    return shape;
+}
+
+// The timestamps are stored row by row, the channels of a pixel being contiguous
+std::vector<py::ssize_t> strides_time_surface_helper(const MostRecentTimestampBuffer &time_surface) {
+    const auto elem_size = static_cast<py::ssize_t>(sizeof(timestamp));
+    if (time_surface.channels() == 1)
+        return {elem_size * time_surface.cols(), elem_size};
+    return {elem_size * time_surface.cols() * time_surface.channels(), elem_size * time_surface.channels(), elem_size};
+}
+
+py::array_t<timestamp> numpy_time_surface_helper(py::object self, bool copy = false) {
+    auto &time_surface = self.cast<MostRecentTimestampBuffer &>();
+    const auto shape   = shape_time_surface_helper(time_surface);
+    const auto strides = strides_time_surface_helper(time_surface);
 
     if (time_surface.empty() || copy)
-        return py::array_t<timestamp>(shape, time_surface.ptr());
+        return py::array_t<timestamp>(shape, strides, time_surface.ptr());
 
-    auto capsule = py::capsule(time_surface.ptr(), [](void *v) {});
-    return py::array_t<timestamp>(shape, time_surface.ptr(), capsule);
+    // The array is a view of the buffer, which is kept alive by the array
+    return py::array_t<timestamp>(shape, strides, time_surface.ptr(), self);
 }
 
 py::buffer_info buffer_info_time_surface_helper(MostRecentTimestampBuffer &time_surface) {
-    const py::ssize_t ndim         = (time_surface.channels() == 1 ? 2 : 3);
-    std::vector<py::ssize_t> shape = {time_surface.rows(), time_surface.cols()};
-    std::vector<py::ssize_t> strides; // stride (in bytes) for each index
-
-    if (time_surface.channels() == 1) {
-        strides = {static_cast<py::ssize_t>(sizeof(timestamp) * time_surface.cols()),
-                   static_cast<py::ssize_t>(sizeof(timestamp))};
-    } else {
-        shape.emplace_back(time_surface.channels());
-        strides = {static_cast<py::ssize_t>(sizeof(timestamp) * time_surface.cols() * time_surface.rows()),
-                   static_cast<py::ssize_t>(sizeof(timestamp) * time_surface.cols()),
-                   static_cast<py::ssize_t>(sizeof(timestamp))};
-    }
-
+    const auto shape = shape_time_surface_helper(time_surface);
     return py::buffer_info(time_surface.ptr(),                         // pointer to buffer
                            sizeof(timestamp),                          // size of one element
                            py::format_descriptor<timestamp>::format(), // python struct-style format descriptor
-                           ndim,                                       // number of dimensions
+                           static_cast<py::ssize_t>(shape.size()),     // number of dimensions
                            shape,                                      // shape
-                           strides);                                   // stride
+                           strides_time_surface_helper(time_surface)); // stride
+}
+
+// The timestamps are compact and row-major, the tensor hence needs no strides
+py::capsule dlpack_time_surface_helper(py::object self, py::object stream) {
+    auto &time_surface = self.cast<MostRecentTimestampBuffer &>();
+    const auto shape   = shape_time_surface_helper(time_surface);
+    return DLPackTensor(self, time_surface.ptr(), to_dlpack_dtype(py::dtype::of<timestamp>()),
+                        std::vector<int64_t>(shape.cbegin(), shape.cend()))
+        .capsule();
 }
 
 void generate_img_time_surface_helper(MostRecentTimestampBuffer &time_surface, timestamp last_ts, timestamp delta_t,
@@ -68,6 +80,21 @@ void generate_img_time_surface_collapsing_channels_helper(MostRecentTimestampBuf
     Metavision::py_array_to_cv_mat(image, img_cv, true);
     time_surface.generate_img_time_surface_collapsing_channels(last_ts, delta_t, img_cv);
 }
+
+void generate_img_time_surface_exponential_decay_helper(MostRecentTimestampBuffer &time_surface, timestamp last_ts,
+                                                        double tau, py::array &image) {
+    cv::Mat img_cv;
+    Metavision::py_array_to_cv_mat(image, img_cv, true);
+    time_surface.generate_img_time_surface_exponential_decay(last_ts, tau, img_cv);
+}
+
+void generate_img_time_surface_collapsing_channels_exponential_decay_helper(MostRecentTimestampBuffer &time_surface,
+                                                                            timestamp last_ts, double tau,
+                                                                            py::array &image) {
+    cv::Mat img_cv;
+    Metavision::py_array_to_cv_mat(image, img_cv, true);
+    time_surface.generate_img_time_surface_collapsing_channels_exponential_decay(last_ts, tau, img_cv);
+}
 } // anonymous namespace
 
 void export_mostrecent_timestamp_buffer(py::module &m) {
@@ -80,7 +107,21 @@ void export_mostrecent_timestamp_buffer(py::module &m) {
         .def(py::init<int, int, int>(), "rows"_a, "cols"_a, "channels"_a = 1,
              pybind_doc_core["Metavision::TMostRecentTimestampBuffer::TMostRecentTimestampBuffer(int rows, int cols, "
                              "int channels=1)"])
-        .def("numpy", &numpy_time_surface_helper, "Converts to a numpy array", "copy"_a = false)
+        .def("numpy", &numpy_time_surface_helper,
+             "Converts to a numpy array\n"
+             "\n"
+             "   Without copy, the array is a view of the timestamps of the buffer, keeping it alive. The time "
+             "surfaces passed to the callbacks of the time surface producers are views of the ones of the "
+             "producers.\n"
+             "\n"
+             "   :copy: If True, the timestamps are copied into the array",
+             "copy"_a = false)
+        .def("__dlpack__", &dlpack_time_surface_helper, "stream"_a = py::none(),
+             "Exports the timestamps without copy as a DLPack tensor, of the same shape as the numpy array, keeping "
+             "the buffer alive\n"
+             "\n"
+             "   :stream: Not used, the memory being on the CPU")
+        .def("__dlpack_device__", [](const MostRecentTimestampBuffer &) { return dlpack_cpu_device(); })
         .def("_buffer_info", &buffer_info_time_surface_helper)
         .def("set_to", &MostRecentTimestampBuffer::set_to, "ts"_a,
              pybind_doc_core["Metavision::TMostRecentTimestampBuffer::set_to"])
@@ -96,7 +137,14 @@ void export_mostrecent_timestamp_buffer(py::module &m) {
              pybind_doc_core["Metavision::TMostRecentTimestampBuffer::generate_img_time_surface"])
         .def("generate_img_time_surface_collapsing_channels", &generate_img_time_surface_collapsing_channels_helper,
              "last_ts"_a, "delta_t"_a, "out"_a,
-             pybind_doc_core["Metavision::TMostRecentTimestampBuffer::generate_img_time_surface_collapsing_channels"]);
+             pybind_doc_core["Metavision::TMostRecentTimestampBuffer::generate_img_time_surface_collapsing_channels"])
+        .def("generate_img_time_surface_exponential_decay", &generate_img_time_surface_exponential_decay_helper,
+             "last_ts"_a, "tau"_a, "out"_a,
+             pybind_doc_core["Metavision::TMostRecentTimestampBuffer::generate_img_time_surface_exponential_decay"])
+        .def("generate_img_time_surface_collapsing_channels_exponential_decay",
+             &generate_img_time_surface_collapsing_channels_exponential_decay_helper, "last_ts"_a, "tau"_a, "out"_a,
+             pybind_doc_core["Metavision::TMostRecentTimestampBuffer::generate_img_time_surface_collapsing_channels_"
+                             "exponential_decay"]);
 }
 
 } // namespace Metavision
@@ -38,6 +38,7 @@ void export_on_demand_frame_generation_algorithm(py::module &m) {
                 cv::Mat img_cv;
                 Metavision::py_array_to_cv_mat(frame, img_cv, channels == 3);
 
+                py::gil_scoped_release release;
                 return algo.generate(ts, img_cv, false);
             },
             py::arg("ts"), py::arg("frame"), pybind_doc_core["Metavision::OnDemandFrameGenerationAlgorithm::generate"])
@@ -45,6 +45,8 @@ void export_periodic_frame_generation_algorithm(py::module &m) {
             "set_output_callback",
             [](PeriodicFrameGenerationAlgorithm &algo, const py::object &object) {
                 PeriodicFrameGenerationAlgorithm::OutputCb cb = [object](timestamp ts, cv::Mat &mat) {
+                    // The events are processed without holding the GIL
+                    py::gil_scoped_acquire acquire;
                     auto frame = frame_pool.acquire();
                     cv::swap(*frame, mat);
 
@@ -86,6 +88,13 @@ void export_periodic_frame_generation_algorithm(py::module &m) {
              pybind_doc_core["Metavision::PeriodicFrameGenerationAlgorithm::set_fps"])
         .def("get_fps", &PeriodicFrameGenerationAlgorithm::get_fps,
              pybind_doc_core["Metavision::PeriodicFrameGenerationAlgorithm::get_fps"])
+        .def("set_adaptive_fps", &PeriodicFrameGenerationAlgorithm::set_adaptive_fps, py::arg("min_fps"),
+             py::arg("activity_threshold_hz"),
+             pybind_doc_core["Metavision::PeriodicFrameGenerationAlgorithm::set_adaptive_fps"])
+        .def("disable_adaptive_fps", &PeriodicFrameGenerationAlgorithm::disable_adaptive_fps,
+             pybind_doc_core["Metavision::PeriodicFrameGenerationAlgorithm::disable_adaptive_fps"])
+        .def("is_adaptive_fps", &PeriodicFrameGenerationAlgorithm::is_adaptive_fps,
+             pybind_doc_core["Metavision::PeriodicFrameGenerationAlgorithm::is_adaptive_fps"])
         .def("skip_frames_up_to", &PeriodicFrameGenerationAlgorithm::skip_frames_up_to, py::arg("ts"),
              pybind_doc_core["Metavision::PeriodicFrameGenerationAlgorithm::skip_frames_up_to"])
         .def("reset", &PeriodicFrameGenerationAlgorithm::reset,
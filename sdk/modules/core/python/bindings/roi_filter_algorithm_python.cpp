@@ -28,6 +28,8 @@ void export_roi_filter_algorithm(py::module &m) {
              py::arg("output_buf"), doc_process_events_array_sync_str)
         .def("process_events", &process_events_buffer_sync<RoiFilterAlgorithm, EventCD>, py::arg("input_buf"),
              py::arg("output_buf"), doc_process_events_buffer_sync_str)
+        .def("process_events_into", &process_events_array_sync_into<RoiFilterAlgorithm, EventCD>, py::arg("input_np"),
+             py::arg("output_np"), doc_process_events_array_sync_into_str)
         .def("process_events_", &process_events_buffer_sync_inplace<RoiFilterAlgorithm, EventCD>, py::arg("events_buf"),
              doc_process_events_buffer_sync_inplace_str)
         .def_static("get_empty_output_buffer", &getEmptyPODBuffer<EventCD>, doc_get_empty_output_buffer_str)
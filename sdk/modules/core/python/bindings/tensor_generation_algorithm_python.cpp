@@ -0,0 +1,97 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/core/algorithms/tensor_generation_algorithm.h"
+#include "pb_doc_core.h"
+
+namespace py = pybind11;
+
+namespace Metavision {
+
+namespace { // anonymous
+
+void generate_helper(TensorGenerationAlgorithm &algo, const py::array_t<EventCD> &events, timestamp ts_begin,
+                     timestamp ts_end, py::array &tensor) {
+    auto info = events.request();
+    if (info.ndim != 1) {
+        throw std::runtime_error("Bad input numpy array dimension " + std::to_string(info.ndim) +
+                                 " should be equal to 1");
+    }
+    if (!(tensor.flags() & py::array::c_style) || !tensor.writeable()) {
+        throw std::runtime_error("The tensor must be a writeable C-contiguous numpy array");
+    }
+    if (static_cast<size_t>(tensor.size()) != algo.get_tensor_size()) {
+        throw std::runtime_error("The tensor has " + std::to_string(tensor.size()) + " values instead of " +
+                                 std::to_string(algo.get_tensor_size()));
+    }
+
+    const auto *begin = static_cast<const EventCD *>(info.ptr);
+    const auto *end   = begin + info.shape[0];
+    // The tensor is written in place, without holding the GIL
+    if (tensor.dtype().is(py::dtype::of<float>())) {
+        auto *data = static_cast<float *>(tensor.mutable_data());
+        py::gil_scoped_release release;
+        algo.generate(begin, end, ts_begin, ts_end, data);
+    } else if (tensor.dtype().kind() == 'f' && tensor.dtype().itemsize() == 2) {
+        auto *data = static_cast<std::uint16_t *>(tensor.mutable_data());
+        py::gil_scoped_release release;
+        algo.generate(begin, end, ts_begin, ts_end, data);
+    } else {
+        throw std::runtime_error("The tensor must be an array of float32 or float16 values");
+    }
+}
+
+} // anonymous namespace
+
+void export_tensor_generation_algorithm(py::module &m) {
+    py::class_<TensorGenerationAlgorithm> algo(m, "TensorGenerationAlgorithm",
+                                               pybind_doc_core["Metavision::TensorGenerationAlgorithm"]);
+
+    py::enum_<TensorGenerationAlgorithm::Type>(algo, "Type")
+        .value("VoxelGrid", TensorGenerationAlgorithm::Type::VoxelGrid)
+        .value("Histogram", TensorGenerationAlgorithm::Type::Histogram)
+        .value("TimeSurface", TensorGenerationAlgorithm::Type::TimeSurface);
+
+    py::enum_<TensorGenerationAlgorithm::Layout>(algo, "Layout")
+        .value("CHW", TensorGenerationAlgorithm::Layout::CHW)
+        .value("HWC", TensorGenerationAlgorithm::Layout::HWC);
+
+    algo.def(py::init<int, int, TensorGenerationAlgorithm::Type, int, TensorGenerationAlgorithm::Layout>(),
+             py::arg("width"), py::arg("height"), py::arg("type"), py::arg("num_bins") = 5,
+             py::arg("layout") = TensorGenerationAlgorithm::Layout::CHW,
+             pybind_doc_core["Metavision::TensorGenerationAlgorithm::TensorGenerationAlgorithm"])
+        .def("get_num_channels", &TensorGenerationAlgorithm::get_num_channels,
+             pybind_doc_core["Metavision::TensorGenerationAlgorithm::get_num_channels"])
+        .def(
+            "get_shape",
+            [](const TensorGenerationAlgorithm &algo) {
+                const auto shape = algo.get_shape();
+                return py::make_tuple(shape[0], shape[1], shape[2]);
+            },
+            "Gets the dimensions of the tensor, in the order of its layout, as a tuple")
+        .def("generate", &generate_helper, py::arg("events"), py::arg("ts_begin"), py::arg("ts_end"),
+             py::arg("tensor"),
+             "Generates the tensor of the events of the time interval [ts_begin, ts_end[\n"
+             "\n"
+             "   The tensor is written in place, without copy. To generate a batch, pass each element of a batch "
+             "array, e.g. batch[i] of an array of shape (N,) + get_shape().\n"
+             "\n"
+             "   :events: Array of input events\n"
+             "   :ts_begin: Beginning of the time interval, included\n"
+             "   :ts_end: End of the time interval, excluded\n"
+             "   :tensor: C-contiguous numpy array of float32 or float16 values, of get_shape() dimensions");
+}
+
+} // namespace Metavision
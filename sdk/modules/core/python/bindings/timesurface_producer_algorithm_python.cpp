@@ -20,6 +20,17 @@
 
 namespace Metavision {
 
+namespace {
+const char doc_set_output_callback_str[] =
+    "Sets a callback to retrieve the produced time surface\n"
+    "\n"
+    "   The time surface passed to the callback is a view of the one of the producer, not a copy. It is updated by "
+    "the next events processed, unless the double buffering is enabled, in which case it is kept unchanged until the "
+    "next call of the callback.\n"
+    "\n"
+    "   :cb: Callback called with the timestamp and the time surface";
+} // anonymous namespace
+
 void export_timesurface_producer_algorithm(py::module &m) {
     using TimeSurfaceProducerAlgorithmMergePolarities = TimeSurfaceProducerAlgorithm<1>;
 
@@ -36,15 +47,28 @@ void export_timesurface_producer_algorithm(py::module &m) {
              pybind_doc_core["Metavision::TimeSurfaceProducerAlgorithm::TimeSurfaceProducerAlgorithm"])
         .def(
             "set_output_callback",
-            [](TimeSurfaceProducerAlgorithmMergePolarities &algo, const py::object &object) {
+            [](py::object self, const py::object &object) {
+                // The time surface is passed without copy, as a view of the one of the producer, which it keeps alive.
+                // The producer is not referenced by its callback, which would prevent it from being collected.
+                py::handle producer = self;
                 TimeSurfaceProducerAlgorithmMergePolarities::OutputCb cb =
-                    [object](timestamp ts, const MostRecentTimestampBuffer &most_recent_timestamp_buffer) {
-                        assert(most_recent_timestamp_buffer.channels() == 1);
-                        object(ts, most_recent_timestamp_buffer);
+                    [object, producer](timestamp ts, const MostRecentTimestampBuffer &time_surface) {
+                        py::gil_scoped_acquire acquire;
+                        assert(time_surface.channels() == 1);
+                        object(ts, py::cast(&time_surface, py::return_value_policy::reference_internal, producer));
                     };
-                algo.set_output_callback(cb);
+                self.cast<TimeSurfaceProducerAlgorithmMergePolarities &>().set_output_callback(cb);
             },
-            "Sets a callback to retrieve the produced time surface")
+            py::arg("cb"), doc_set_output_callback_str)
+        .def("set_double_buffering", &TimeSurfaceProducerAlgorithmMergePolarities::set_double_buffering,
+             py::arg("enable"),
+             pybind_doc_core["Metavision::TimeSurfaceProducerAlgorithm::set_double_buffering"])
+        .def("is_double_buffering", &TimeSurfaceProducerAlgorithmMergePolarities::is_double_buffering,
+             pybind_doc_core["Metavision::TimeSurfaceProducerAlgorithm::is_double_buffering"])
+        .def("set_n_threads", &TimeSurfaceProducerAlgorithmMergePolarities::set_n_threads, py::arg("n_threads"),
+             pybind_doc_core["Metavision::TimeSurfaceProducerAlgorithm::set_n_threads"])
+        .def("get_n_threads", &TimeSurfaceProducerAlgorithmMergePolarities::get_n_threads,
+             pybind_doc_core["Metavision::TimeSurfaceProducerAlgorithm::get_n_threads"])
         .def("process_events", &process_events_array_async<TimeSurfaceProducerAlgorithmMergePolarities, EventCD>,
              py::arg("events_np"), doc_process_events_array_async_str);
 
@@ -61,15 +85,28 @@ void export_timesurface_producer_algorithm(py::module &m) {
              pybind_doc_core["Metavision::TimeSurfaceProducerAlgorithm::TimeSurfaceProducerAlgorithm"])
         .def(
             "set_output_callback",
-            [](TimeSurfaceProducerAlgorithmSplitPolarities &algo, const py::object &object) {
+            [](py::object self, const py::object &object) {
+                // The time surface is passed without copy, as a view of the one of the producer, which it keeps alive.
+                // The producer is not referenced by its callback, which would prevent it from being collected.
+                py::handle producer = self;
                 TimeSurfaceProducerAlgorithmSplitPolarities::OutputCb cb =
-                    [object](timestamp ts, const MostRecentTimestampBuffer &most_recent_timestamp_buffer) {
-                        assert(most_recent_timestamp_buffer.channels() == 2);
-                        object(ts, most_recent_timestamp_buffer);
+                    [object, producer](timestamp ts, const MostRecentTimestampBuffer &time_surface) {
+                        py::gil_scoped_acquire acquire;
+                        assert(time_surface.channels() == 2);
+                        object(ts, py::cast(&time_surface, py::return_value_policy::reference_internal, producer));
                     };
-                algo.set_output_callback(cb);
+                self.cast<TimeSurfaceProducerAlgorithmSplitPolarities &>().set_output_callback(cb);
             },
-            "Sets a callback to retrieve the produced time surface")
+            py::arg("cb"), doc_set_output_callback_str)
+        .def("set_double_buffering", &TimeSurfaceProducerAlgorithmSplitPolarities::set_double_buffering,
+             py::arg("enable"),
+             pybind_doc_core["Metavision::TimeSurfaceProducerAlgorithm::set_double_buffering"])
+        .def("is_double_buffering", &TimeSurfaceProducerAlgorithmSplitPolarities::is_double_buffering,
+             pybind_doc_core["Metavision::TimeSurfaceProducerAlgorithm::is_double_buffering"])
+        .def("set_n_threads", &TimeSurfaceProducerAlgorithmSplitPolarities::set_n_threads, py::arg("n_threads"),
+             pybind_doc_core["Metavision::TimeSurfaceProducerAlgorithm::set_n_threads"])
+        .def("get_n_threads", &TimeSurfaceProducerAlgorithmSplitPolarities::get_n_threads,
+             pybind_doc_core["Metavision::TimeSurfaceProducerAlgorithm::get_n_threads"])
         .def("process_events", &process_events_array_async<TimeSurfaceProducerAlgorithmSplitPolarities, EventCD>,
              py::arg("events_np"), doc_process_events_array_async_str);
 }
@@ -12,3 +12,4 @@ from .py_reader import EventDatReader, EventNpyReader
 from .raw_reader import RawReader
 from .events_iterator import EventsIterator
 from .live_replay import LiveReplayEventsIterator, is_live_camera
+from .async_events_iterator import AsyncEventsIterator
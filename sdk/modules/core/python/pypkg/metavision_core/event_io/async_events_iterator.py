@@ -0,0 +1,86 @@
+# Copyright (c) Prophesee S.A.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+# Unless required by applicable law or agreed to in writing, software distributed under the License is distributed
+# on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and limitations under the License.
+
+"""
+Asynchronous iterator over the events of a device, for asyncio applications
+"""
+import asyncio
+
+from metavision_sdk_core import EventsSliceIterator
+
+
+class AsyncEventsIterator(object):
+    """
+    AsyncEventsIterator iterates over slices of CD events of a device from Metavision HAL without blocking the asyncio
+    event loop, so that a single thread can serve many devices.
+
+    The data of the device are read and decoded by a C++ thread, without holding the GIL, which wakes the event loop up
+    through a file descriptor (an eventfd on Linux, a pipe on other POSIX systems). Each iteration returns the timestamp
+    of the end of a slice and a numpy array of its events, which is not a copy: its memory goes back to a pool once it
+    is collected.
+
+    The event loop must support add_reader, which is not the case of the proactor event loop of Windows.
+
+    Args:
+        device (Device): device to read the events of, which is started by the iterator
+        event_count (int): number of events in each slice
+        time_slice_us (int): duration of each slice in us
+        max_queued_slices (int): number of slices decoded in advance, the decoding waiting when it is reached
+
+    Examples:
+        >>> async def process(device):
+        >>>     async with AsyncEventsIterator(device, time_slice_us=10000) as it:
+        >>>         async for end_ts, events in it:
+        >>>             print(end_ts, events.size)
+    """
+
+    def __init__(self, device, event_count=0, time_slice_us=10000, max_queued_slices=64):
+        self._iterator = EventsSliceIterator(device, event_count=event_count, time_slice_us=time_slice_us,
+                                             max_queued_slices=max_queued_slices)
+        self._fd = self._iterator.fileno()
+        if self._fd < 0:
+            raise OSError("Asynchronous iteration is not supported on this platform")
+
+    def __aiter__(self):
+        return self
+
+    async def __anext__(self):
+        while True:
+            try:
+                events_slice = self._iterator.try_next()
+            except StopIteration:
+                raise StopAsyncIteration
+            if events_slice is not None:
+                return events_slice
+            await self._wait_notification()
+
+    async def _wait_notification(self):
+        loop = asyncio.get_running_loop()
+        notified = loop.create_future()
+
+        def on_readable():
+            if not notified.done():
+                notified.set_result(None)
+
+        loop.add_reader(self._fd, on_readable)
+        try:
+            await notified
+        finally:
+            loop.remove_reader(self._fd)
+
+    def stop(self):
+        """Stops the device and the decoding thread. The slices already decoded can still be iterated over."""
+        self._iterator.stop()
+
+    async def __aenter__(self):
+        return self
+
+    async def __aexit__(self, exc_type, exc_value, traceback):
+        # Joining the decoding thread may take a moment, it is done out of the event loop
+        await asyncio.get_running_loop().run_in_executor(None, self.stop)
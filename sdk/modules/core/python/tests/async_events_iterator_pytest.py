@@ -0,0 +1,61 @@
+# Copyright (c) Prophesee S.A.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+# Unless required by applicable law or agreed to in writing, software distributed under the License is distributed
+# on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and limitations under the License.
+
+"""
+Unit tests for AsyncEventsIterator class
+"""
+import asyncio
+import os
+import numpy as np
+
+from metavision_core.event_io import AsyncEventsIterator
+from metavision_core.event_io import load_events
+
+from metavision_core.event_io.raw_reader import initiate_device
+
+
+async def read_all(filename, time_slice_us):
+    slices = []
+    async with AsyncEventsIterator(initiate_device(filename), time_slice_us=time_slice_us) as it:
+        async for end_ts, events in it:
+            slices.append((end_ts, events))
+    return slices
+
+
+def pytestcase_async_iterator_equivalence(tmpdir, dataset_dir):
+    """Ensures the equivalence of events iterated asynchronously from a RAW file and its RAW to DAT equivalent"""
+    # GIVEN
+    filename = os.path.join(dataset_dir,
+                            "metavision_core", "event_io", "recording.raw")
+
+    # WHEN
+    slices = asyncio.run(read_all(filename, 10000))
+    evs = np.concatenate([events for _, events in slices])
+
+    # THEN
+    dat_evs = load_events(filename.replace(".raw", "_td.dat"))
+    assert len(dat_evs) == len(evs)
+    assert all([np.allclose(dat_evs[name], evs[name]) for name in ("t", "x", "y", "p")])
+    assert all(end_ts_1 < end_ts_2 for (end_ts_1, _), (end_ts_2, _) in zip(slices[:-1], slices[1:]))
+
+
+def pytestcase_async_iterator_concurrent_devices(tmpdir, dataset_dir):
+    """Ensures that several devices are served concurrently by a single event loop"""
+    # GIVEN
+    filename = os.path.join(dataset_dir,
+                            "metavision_core", "event_io", "recording.raw")
+
+    # WHEN
+    async def read_concurrently():
+        return await asyncio.gather(read_all(filename, 10000), read_all(filename, 5000))
+    slices_10ms, slices_5ms = asyncio.run(read_concurrently())
+
+    # THEN
+    assert sum(events.size for _, events in slices_10ms) == sum(events.size for _, events in slices_5ms)
+    assert len(slices_5ms) > len(slices_10ms)
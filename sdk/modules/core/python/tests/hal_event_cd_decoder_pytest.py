@@ -0,0 +1,90 @@
+# Copyright (c) Prophesee S.A.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+# Unless required by applicable law or agreed to in writing, software distributed under the License is distributed
+# on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and limitations under the License.
+
+"""
+Unit tests for the decoding of CD events into pooled buffers by the HAL bindings
+"""
+import gc
+import os
+import numpy as np
+
+from metavision_hal import DeviceDiscovery, RawFileConfig, PooledEventCDBuffer
+
+
+def open_recording(dataset_dir):
+    """Opens the recording and reads its first buffer of RAW data"""
+    filename = os.path.join(dataset_dir, "metavision_core", "event_io", "recording.raw")
+    config = RawFileConfig()
+    config.n_events_to_read = 10000
+    device = DeviceDiscovery.open_raw_file(filename, config)
+    assert device is not None
+
+    events_stream = device.get_i_events_stream()
+    events_stream.start()
+    assert events_stream.wait_next_buffer() > 0
+    raw_data = events_stream.get_latest_raw_data().copy()
+    events_stream.stop()
+    return device, raw_data
+
+
+def pytestcase_event_vector_callback_hands_pooled_buffers(dataset_dir):
+    """Tests that the events decoded into pooled buffers are viewed without copy and are the ones decoded"""
+    # GIVEN a decoder handing its events to Python in pooled buffers, and copying them to another callback
+    device, raw_data = open_recording(dataset_dir)
+    cd_decoder = device.get_i_event_cd_decoder()
+    copies = []
+    cd_decoder.add_event_buffer_callback(lambda events: copies.append(events.copy()))
+    arrays = []
+    cd_decoder.set_event_vector_callback(arrays.append)
+
+    # WHEN decoding a buffer of RAW data
+    device.get_i_decoder().decode(raw_data)
+
+    # THEN the arrays are views on the pooled buffers, holding the same events as the copies
+    assert len(arrays) > 0
+    for array in arrays:
+        assert not array.flags["OWNDATA"]
+        assert isinstance(array.base, PooledEventCDBuffer)
+        assert len(array.base) == len(array)
+    received = np.concatenate(arrays)
+    expected = np.concatenate(copies)
+    assert len(received) > 0
+    assert all([np.array_equal(expected[name], received[name]) for name in ("x", "y", "p", "t")])
+
+    # WHEN the arrays are collected and the same data is decoded again
+    data_ptrs = set(array.ctypes.data for array in arrays if len(array) > 0)
+    del arrays[:]
+    gc.collect()
+    device.get_i_decoder().decode(raw_data)
+
+    # THEN the memory of the collected buffers is reused
+    assert data_ptrs & set(array.ctypes.data for array in arrays if len(array) > 0)
+
+
+def pytestcase_pooled_buffers_outlive_the_decoder(dataset_dir):
+    """Tests that the views on pooled buffers stay valid once the callback, the decoder and the device are gone"""
+    # GIVEN views on the pooled buffers of a decoder
+    device, raw_data = open_recording(dataset_dir)
+    cd_decoder = device.get_i_event_cd_decoder()
+    arrays = []
+    cd_decoder.set_event_vector_callback(arrays.append)
+    device.get_i_decoder().decode(raw_data)
+    assert len(arrays) > 0
+    view = arrays[0][:10]
+    expected = view.copy()
+
+    # WHEN the arrays, the callback, the decoder and the device are released
+    del arrays
+    cd_decoder.set_event_vector_callback(None)
+    del cd_decoder
+    del device
+    gc.collect()
+
+    # THEN the view still holds the decoded events
+    assert np.array_equal(expected, view)
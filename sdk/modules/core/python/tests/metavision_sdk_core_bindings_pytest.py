@@ -299,3 +299,77 @@ def pytestcase_TimeSurfaceProducerAlgoritm():
     assert time_surface_double_channel.numpy()[0, 2].tolist() == [0, 4]
     assert time_surface_double_channel.numpy()[0, 3].tolist() == [3, 0]
     assert (time_surface_double_channel.numpy()[0, 4] == 0).all()
+
+
+def pytestcase_TimeSurfaceProducerAlgorithmDoubleBuffering():
+    events = np.zeros(5, dtype=metavision_sdk_base.EventCD)
+    events["x"] = [1, 2, 3, 2, 1]
+    events["p"] = [0, 1, 0, 1, 1]
+    events["t"] = [1, 2, 3, 4, 5]
+
+    ts_prod = metavision_sdk_core.TimeSurfaceProducerAlgorithmSplitPolarities(5, 5)
+    ts_prod.set_double_buffering(True)
+    assert ts_prod.is_double_buffering()
+
+    # The time surfaces are kept as views, without copy
+    views = []
+
+    def callback(ts, time_surface):
+        views.append(time_surface.numpy())
+    ts_prod.set_output_callback(callback)
+
+    ts_prod.process_events(events[:3])
+    ts_prod.process_events(events[3:])
+    assert len(views) == 2
+    assert not views[0].flags.owndata
+    assert views[0].shape == (5, 5, 2)
+    assert views[0].strides == (5 * 2 * 8, 2 * 8, 8)
+
+    # The previous time surface is not updated by the events processed after it
+    assert views[0][0, 1].tolist() == [1, 0]
+    assert views[0][0, 2].tolist() == [0, 2]
+    assert views[1][0, 1].tolist() == [1, 5]
+    assert views[1][0, 2].tolist() == [0, 4]
+    assert views[1][0, 3].tolist() == [3, 0]
+
+
+def pytestcase_MostRecentTimestampBufferDLPack():
+    time_surface = metavision_sdk_core.MostRecentTimestampBuffer(3, 4, 2)
+    time_surface.set_to(7)
+
+    # The tensor is a view of the timestamps, keeping the buffer alive
+    tensor = np.from_dlpack(time_surface)
+    assert tensor.dtype == np.int64
+    assert tensor.shape == (3, 4, 2)
+    time_surface.numpy()[1, 2, 1] = 42
+    del time_surface
+    assert tensor[1, 2].tolist() == [7, 42]
+
+
+def pytestcase_ProcessEventsIntoArrays():
+    events = np.zeros(5, dtype=metavision_sdk_base.EventCD)
+    events["x"] = range(10, 60, 10)
+    events["y"] = range(110, 160, 10)
+    events["p"] = [0, 1, 0, 1, 1]
+
+    # Filtering into a provided array, the number of events written being returned
+    roi = metavision_sdk_core.RoiFilterAlgorithm(x0=25, y0=125, x1=45, y1=145)
+    output = np.zeros(5, dtype=metavision_sdk_base.EventCD)
+    assert roi.process_events_into(events, output) == 2
+    assert output["x"][:2].tolist() == [30, 40]
+
+    # Filtering in place, into the input array
+    polarity_filter = metavision_sdk_core.PolarityFilterAlgorithm(1)
+    filtered = events.copy()
+    n = polarity_filter.process_events_into(filtered, filtered)
+    assert filtered["x"][:n].tolist() == [20, 40, 50]
+
+    # Transforming into a provided array, which must be large enough
+    flip_x = metavision_sdk_core.FlipXAlgorithm(639)
+    assert flip_x.process_events_into(events, output) == 5
+    assert output["x"].tolist() == [629, 619, 609, 599, 589]
+    try:
+        flip_x.process_events_into(events, output[:3])
+        assert False
+    except ValueError:
+        pass
@@ -15,17 +15,18 @@
 #include <iomanip>
 #include <sstream>
 #include <array>
-#include <thread>
 #include <fstream>
+#include <memory>
 #include <boost/format.hpp>
 #include <boost/filesystem/operations.hpp>
 #include <boost/program_options.hpp>
+#include <metavision/hal/device/device.h>
 #include <metavision/hal/facilities/i_hw_identification.h>
 #include <metavision/hal/facilities/i_plugin_software_info.h>
 #include <metavision/hal/utils/raw_file_header.h>
 #include <metavision/sdk/base/utils/log.h>
-#include <metavision/sdk/driver/camera.h>
 #include <metavision/sdk/driver/camera_exception.h>
+#include <metavision/sdk/driver/event_file_reader.h>
 
 namespace po = boost::program_options;
 
@@ -104,9 +105,11 @@ int main(int argc, char *argv[]) {
     }
 
     Metavision::RawFileHeader header(ifs);
-    Metavision::Camera camera;
+
+    // The file is read in slices of 1s, decoded by this thread
+    std::unique_ptr<Metavision::EventFileReader> reader;
     try {
-        camera = Metavision::Camera::from_file(in_raw_file_path, false);
+        reader = std::make_unique<Metavision::EventFileReader>(in_raw_file_path, 1000000);
     } catch (Metavision::CameraException &e) {
         MV_LOG_ERROR() << e.what();
         return 1;
@@ -123,40 +126,25 @@ int main(int argc, char *argv[]) {
     std::fill(last_ts.begin(), last_ts.end(), -1);
     std::fill(num_events.begin(), num_events.end(), 0);
 
-    try {
-        Metavision::CD &cd = camera.cd();
-        cd.add_callback(
-            [&num_events, &first_ts, &last_ts](const Metavision::EventCD *begin, const Metavision::EventCD *end) {
-                num_events[EventType::CD] += std::distance(begin, end);
-                first_ts[EventType::CD] = std::min(first_ts[EventType::CD], begin->t);
-                last_ts[EventType::CD]  = std::max(last_ts[EventType::CD], (end - 1)->t);
-            });
-    } catch (...) {}
-
-    try {
-        Metavision::ExtTrigger &ext_trigger = camera.ext_trigger();
-        ext_trigger.add_callback([&num_events, &first_ts, &last_ts](const Metavision::EventExtTrigger *begin,
-                                                                    const Metavision::EventExtTrigger *end) {
-            num_events[EventType::ExtTrigger] += std::distance(begin, end);
-            first_ts[EventType::ExtTrigger] = std::min(first_ts[EventType::ExtTrigger], begin->t);
-            last_ts[EventType::ExtTrigger]  = std::max(last_ts[EventType::ExtTrigger], (end - 1)->t);
-        });
-    } catch (...) {}
-
-    camera.start();
+    auto update_stats = [&num_events, &first_ts, &last_ts](size_t type, const auto &events) {
+        if (!events.empty()) {
+            num_events[type] += events.size();
+            first_ts[type] = std::min(first_ts[type], events.front().t);
+            last_ts[type]  = std::max(last_ts[type], events.back().t);
+        }
+    };
 
     const std::string message("Analysing RAW file...");
     auto log = MV_LOG_INFO() << Metavision::Log::no_endline << Metavision::Log::no_space << message << std::flush;
     int dots = 0;
 
-    // wait for the analysis to end
-    while (camera.is_running()) {
+    for (const auto &slice : *reader) {
+        update_stats(EventType::CD, slice.cd_events);
+        update_stats(EventType::ExtTrigger, slice.ext_trigger_events);
         log << "\r" << message.substr(0, message.size() - 3 + dots) + std::string("   ").substr(0, 3 - dots)
             << std::flush;
         dots = (dots + 1) % 4;
-        std::this_thread::sleep_for(std::chrono::milliseconds(500));
     }
-    camera.stop();
 
     // update duration as the maximum timestamp ever found
     for (size_t i = 0; i < EventType::Count; ++i) {
@@ -178,9 +166,9 @@ int main(int argc, char *argv[]) {
         << "\n";
     log << boost::format(global_format) % "Duration" % human_readable_time(duration) << "\n";
 
-    std::string event_encoding, systemID, serial, integrator;
+    std::string event_encoding, systemID, serial, integrator, generation;
     Metavision::I_HW_Identification *hw_identification =
-        camera.get_device().get_facility<Metavision::I_HW_Identification>();
+        reader->get_device().get_facility<Metavision::I_HW_Identification>();
     if (hw_identification) {
         auto raw_formats = hw_identification->get_available_raw_format();
         if (!raw_formats.empty()) {
@@ -189,10 +177,11 @@ int main(int argc, char *argv[]) {
         systemID   = std::to_string(hw_identification->get_system_id());
         serial     = hw_identification->get_serial();
         integrator = hw_identification->get_integrator();
+        generation = hw_identification->get_sensor_info().as_string();
     }
     std::string plugin_name;
     Metavision::I_PluginSoftwareInfo *plugin_info =
-        camera.get_device().get_facility<Metavision::I_PluginSoftwareInfo>();
+        reader->get_device().get_facility<Metavision::I_PluginSoftwareInfo>();
     if (plugin_info) {
         plugin_name = plugin_info->get_plugin_name();
     }
@@ -208,10 +197,9 @@ int main(int argc, char *argv[]) {
     if (!event_encoding.empty()) {
         log << boost::format(global_format) % "Event encoding" % event_encoding << "\n";
     }
-    auto &gen = camera.generation();
-    tmp_oss   = std::ostringstream();
-    tmp_oss << gen.version_major() << "." << gen.version_minor();
-    log << boost::format(global_format) % "Camera generation" % tmp_oss.str() << "\n";
+    if (!generation.empty()) {
+        log << boost::format(global_format) % "Camera generation" % generation << "\n";
+    }
     if (!systemID.empty()) {
         log << boost::format(global_format) % "Camera systemID" % systemID << "\n";
     }
@@ -15,17 +15,177 @@
 #include <iostream>
 #include <functional>
 #include <chrono>
+#include <condition_variable>
 #include <cstdio>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <vector>
 #include <boost/program_options.hpp>
+#include <metavision/sdk/base/utils/DAT_helper.h>
 #include <metavision/sdk/base/utils/log.h>
+#include <metavision/sdk/core/algorithms/detail/event_batch_kernels.h>
 #include <metavision/sdk/core/pipeline/pipeline.h>
 #include <metavision/sdk/core/pipeline/stream_logging_stage.h>
 #include <metavision/sdk/driver/pipeline/camera_stage.h>
+#include <metavision/hal/decoders/evt2_decoder.h>
+#include <metavision/hal/decoders/evt3_decoder.h>
+#include <metavision/hal/utils/hal_exception.h>
+#include <metavision/hal/utils/memory_mapped_file_stream.h>
+#include <metavision/hal/utils/parallel_decoder.h>
+#include <metavision/hal/utils/raw_file_header.h>
 
 namespace po = boost::program_options;
 
+namespace {
+
+// Writes batches of events to a DAT file from a dedicated thread, with large buffered writes
+template<typename EventType>
+class DATWriter {
+public:
+    DATWriter(const std::string &filename, unsigned short width, unsigned short height) :
+        buffer_(WriteBufferSize) {
+        output_.rdbuf()->pubsetbuf(buffer_.data(), buffer_.size());
+        output_.open(filename, std::ios::binary);
+        Metavision::write_DAT_header<EventType>(
+            output_, {{"Width", std::to_string(width)}, {"Height", std::to_string(height)}});
+        thread_ = std::thread([this] { run(); });
+    }
+
+    ~DATWriter() {
+        close();
+    }
+
+    // Queues a copy of the events, blocks while too many batches are already waiting to be written
+    void write(const EventType *begin, const EventType *end) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cond_.wait(lock, [this] { return batches_.size() < MaxPendingBatches; });
+        batches_.emplace_back(begin, end);
+        cond_.notify_all();
+    }
+
+    // Writes the pending batches and closes the file
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (done_) {
+                return;
+            }
+            done_ = true;
+            cond_.notify_all();
+        }
+        thread_.join();
+        output_.close();
+    }
+
+    size_t get_n_events() const {
+        return n_events_;
+    }
+
+private:
+    static constexpr size_t WriteBufferSize   = 16 * 1024 * 1024;
+    static constexpr size_t MaxPendingBatches = 8;
+
+    void run() {
+        constexpr auto RawEventSize = Metavision::get_event_size<EventType>();
+        std::vector<char> encoded;
+        while (true) {
+            std::vector<EventType> batch;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cond_.wait(lock, [this] { return done_ || !batches_.empty(); });
+                if (batches_.empty()) {
+                    return;
+                }
+                batch = std::move(batches_.front());
+                batches_.pop_front();
+                cond_.notify_all();
+            }
+
+            // The CD events are packed in batches, with SIMD instructions when available
+            encoded.resize(batch.size() * RawEventSize);
+            Metavision::detail::write_dat_events(batch.data(), batch.size(), 0, encoded.data());
+            output_.write(encoded.data(), encoded.size());
+            n_events_ += batch.size();
+        }
+    }
+
+    std::vector<char> buffer_;
+    std::ofstream output_;
+    std::thread thread_;
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::deque<std::vector<EventType>> batches_;
+    bool done_{false};
+    size_t n_events_{0};
+};
+
+// Returns the factory of the decoders of the format of the RAW file, or an empty function if it is not one of the
+// formats the converter can decode in parallel
+Metavision::ParallelDecoder::DecoderFactory get_decoder_factory(const Metavision::RawFileHeader &header) {
+    const std::string evt    = header.get_field("evt");
+    const std::string format = header.get_field("format");
+    if (evt == "2.0" || format.compare(0, 4, "EVT2") == 0) {
+        return [](bool time_shifting_enabled, const auto &cd_decoder, const auto &ext_trigger_decoder) {
+            return std::make_unique<Metavision::EVT2Decoder>(time_shifting_enabled, cd_decoder, ext_trigger_decoder);
+        };
+    }
+    if (evt == "3.0" || format.compare(0, 4, "EVT3") == 0) {
+        return [](bool time_shifting_enabled, const auto &cd_decoder, const auto &ext_trigger_decoder) {
+            return std::make_unique<Metavision::EVT3Decoder>(time_shifting_enabled, cd_decoder, ext_trigger_decoder);
+        };
+    }
+    return Metavision::ParallelDecoder::DecoderFactory();
+}
+
+// Converts the RAW file with a pipeline made of a reader (memory mapping), parallel decoders and one writer thread per
+// output file. Returns false if the format of the file can not be decoded this way
+bool convert_in_parallel(const std::string &raw_file, unsigned short width, unsigned short height, uint32_t n_threads,
+                         const std::string &cd_filename, const std::string &ext_trigger_filename,
+                         size_t &n_cd_events, size_t &n_ext_trigger_events) {
+    std::unique_ptr<Metavision::MemoryMappedFileStream> stream;
+    try {
+        stream = std::make_unique<Metavision::MemoryMappedFileStream>(raw_file);
+    } catch (Metavision::HalException &) { return false; }
+
+    const Metavision::RawFileHeader header(*stream);
+    auto decoder_factory = get_decoder_factory(header);
+    const auto data_pos  = stream->tellg();
+    if (!decoder_factory || data_pos < 0) {
+        return false;
+    }
+
+    DATWriter<Metavision::EventCD> cd_writer(cd_filename, width, height);
+    DATWriter<Metavision::EventExtTrigger> ext_trigger_writer(ext_trigger_filename, width, height);
+    auto cd_decoder = std::make_shared<Metavision::I_EventDecoder<Metavision::EventCD>>();
+    cd_decoder->add_event_buffer_callback(
+        [&cd_writer](const Metavision::EventCD *begin, const Metavision::EventCD *end) {
+            cd_writer.write(begin, end);
+        });
+    auto ext_trigger_decoder = std::make_shared<Metavision::I_EventDecoder<Metavision::EventExtTrigger>>();
+    ext_trigger_decoder->add_event_buffer_callback(
+        [&ext_trigger_writer](const Metavision::EventExtTrigger *begin, const Metavision::EventExtTrigger *end) {
+            ext_trigger_writer.write(begin, end);
+        });
+
+    Metavision::ParallelDecoder decoder(decoder_factory, true, cd_decoder, ext_trigger_decoder, n_threads);
+    MV_LOG_INFO() << "Decoding with" << decoder.get_n_threads() << "threads...";
+    // The whole mapping is handed to the decoder, which bounds the number of chunks decoded at once
+    decoder.decode(stream->data() + data_pos, stream->data() + stream->size());
+
+    cd_writer.close();
+    ext_trigger_writer.close();
+    n_cd_events          = cd_writer.get_n_events();
+    n_ext_trigger_events = ext_trigger_writer.get_n_events();
+    return true;
+}
+
+} // namespace
+
 int main(int argc, char *argv[]) {
     std::string in_raw_file_path;
+    uint32_t n_threads;
 
     const std::string program_desc("Application to convert RAW file to DAT file.\n");
 
@@ -34,6 +194,7 @@ int main(int argc, char *argv[]) {
     options_desc.add_options()
         ("help,h", "Produce help message.")
         ("input-raw-file,i", po::value<std::string>(&in_raw_file_path)->required(), "Path to input RAW file.")
+        ("threads,j",         po::value<uint32_t>(&n_threads)->default_value(0), "Number of threads decoding the RAW file, 0 to use one per core. Only used for EVT2 and EVT3 files, other formats are decoded by the camera.")
     ;
     // clang-format on
 
@@ -54,22 +215,6 @@ int main(int argc, char *argv[]) {
         return 1;
     }
 
-    // A pipeline for which all added stages will automatically be run in their own processing threads (if applicable)
-    Metavision::Pipeline p(true);
-
-    /// Pipeline
-    //                  0 (Camera)
-    //                  |
-    //                  v
-    //                  |
-    //  |----------<--------->-----------|
-    //  |                                |
-    //  v                                v
-    //  |                                |
-    //  1 (Log CD)                       2 (Log Ext Trigger)
-    //
-
-    // 0) Stage producing events from a camera
     Metavision::Camera camera;
     try {
         camera = Metavision::Camera::from_file(in_raw_file_path, false);
@@ -77,50 +222,81 @@ int main(int argc, char *argv[]) {
         MV_LOG_ERROR() << e.what();
         return 1;
     }
-    auto &cam_stage = p.add_stage(std::make_unique<Metavision::CameraStage>(std::move(camera)));
-    // Gets the wrapped camera from the stage to extract sensor's resolution
-    Metavision::Camera &cam     = cam_stage.camera();
-    const unsigned short width  = cam.geometry().width();
-    const unsigned short height = cam.geometry().height();
+    // Extracts the sensor's resolution from the camera
+    const unsigned short width  = camera.geometry().width();
+    const unsigned short height = camera.geometry().height();
 
     // Get the base of the input filename and the path
     std::string output_base = in_raw_file_path.substr(0, in_raw_file_path.find_last_of(".raw") - 3);
-
-    // 1) Stage that will write CD events to a DAT file
     std::string cd_filename(output_base + "_cd.dat");
-    p.add_stage(std::make_unique<Metavision::StreamLoggingStage<Metavision::EventCD>>(cd_filename, width, height),
-                cam_stage);
-
-    // 2) Stage that will write external triggers events to a DAT file
     std::string ext_trigger_filename(output_base + "_trigger.dat");
-    bool has_ext_trigger = false;
-    try {
-        cam.ext_trigger().add_callback([&has_ext_trigger, &cam_stage](const Metavision::EventExtTrigger *begin,
-                                                                      const Metavision::EventExtTrigger *end) {
-            has_ext_trigger = true;
-            cam_stage.add_ext_trigger_events(begin, end);
-        });
-        // if no external triggers events are available in the recording, then an exception will be thrown and
-        // the stage will never be added
-        p.add_stage(std::make_unique<Metavision::StreamLoggingStage<Metavision::EventExtTrigger>>(ext_trigger_filename,
-                                                                                                  width, height),
+
+    const auto start_time       = std::chrono::high_resolution_clock::now();
+    size_t n_cd_events          = 0;
+    size_t n_ext_trigger_events = 0;
+    const bool converted_in_parallel = convert_in_parallel(in_raw_file_path, width, height, n_threads, cd_filename,
+                                                           ext_trigger_filename, n_cd_events, n_ext_trigger_events);
+    bool has_ext_trigger = n_ext_trigger_events > 0;
+
+    if (!converted_in_parallel) {
+        // A pipeline for which all added stages will automatically be run in their own processing threads (if
+        // applicable)
+        Metavision::Pipeline p(true);
+
+        /// Pipeline
+        //                  0 (Camera)
+        //                  |
+        //                  v
+        //                  |
+        //  |----------<--------->-----------|
+        //  |                                |
+        //  v                                v
+        //  |                                |
+        //  1 (Log CD)                       2 (Log Ext Trigger)
+        //
+
+        // 0) Stage producing events from a camera
+        auto &cam_stage = p.add_stage(std::make_unique<Metavision::CameraStage>(std::move(camera)));
+        Metavision::Camera &cam = cam_stage.camera();
+
+        // 1) Stage that will write CD events to a DAT file
+        p.add_stage(std::make_unique<Metavision::StreamLoggingStage<Metavision::EventCD>>(cd_filename, width, height),
                     cam_stage);
-    } catch (Metavision::CameraException &) {}
-
-    // Run the pipeline step by step to give a visual feedback about the progression
-    using namespace std::chrono_literals;
-    auto log = MV_LOG_INFO() << Metavision::Log::no_space << Metavision::Log::no_endline;
-    const std::string message("Writing DAT file...");
-    int dots       = 0;
-    auto last_time = std::chrono::high_resolution_clock::now();
-
-    while (p.step()) {
-        const auto time = std::chrono::high_resolution_clock::now();
-        if (std::chrono::duration_cast<std::chrono::milliseconds>(time - last_time) > 500ms) {
-            last_time = time;
-            log << "\r" << message.substr(0, message.size() - 3 + dots) + std::string("   ").substr(0, 3 - dots)
-                << std::flush;
-            dots = (dots + 1) % 4;
+        cam.cd().add_callback([&n_cd_events](const Metavision::EventCD *begin, const Metavision::EventCD *end) {
+            n_cd_events += std::distance(begin, end);
+        });
+
+        // 2) Stage that will write external triggers events to a DAT file
+        try {
+            cam.ext_trigger().add_callback([&has_ext_trigger, &n_ext_trigger_events, &cam_stage](
+                                               const Metavision::EventExtTrigger *begin,
+                                               const Metavision::EventExtTrigger *end) {
+                has_ext_trigger = true;
+                n_ext_trigger_events += std::distance(begin, end);
+                cam_stage.add_ext_trigger_events(begin, end);
+            });
+            // if no external triggers events are available in the recording, then an exception will be thrown and
+            // the stage will never be added
+            p.add_stage(std::make_unique<Metavision::StreamLoggingStage<Metavision::EventExtTrigger>>(
+                            ext_trigger_filename, width, height),
+                        cam_stage);
+        } catch (Metavision::CameraException &) {}
+
+        // Run the pipeline step by step to give a visual feedback about the progression
+        using namespace std::chrono_literals;
+        auto log = MV_LOG_INFO() << Metavision::Log::no_space << Metavision::Log::no_endline;
+        const std::string message("Writing DAT file...");
+        int dots       = 0;
+        auto last_time = std::chrono::high_resolution_clock::now();
+
+        while (p.step()) {
+            const auto time = std::chrono::high_resolution_clock::now();
+            if (std::chrono::duration_cast<std::chrono::milliseconds>(time - last_time) > 500ms) {
+                last_time = time;
+                log << "\r" << message.substr(0, message.size() - 3 + dots) + std::string("   ").substr(0, 3 - dots)
+                    << std::flush;
+                dots = (dots + 1) % 4;
+            }
         }
     }
 
@@ -131,5 +307,15 @@ int main(int argc, char *argv[]) {
         std::remove(ext_trigger_filename.c_str());
     }
 
+    // Reports the throughput of the conversion
+    const double elapsed_s =
+        std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start_time).count();
+    std::ifstream raw_file(in_raw_file_path, std::ios::binary | std::ios::ate);
+    const double raw_mb  = raw_file ? static_cast<double>(raw_file.tellg()) / (1024 * 1024) : 0.;
+    const double n_events = static_cast<double>(n_cd_events + n_ext_trigger_events);
+    MV_LOG_INFO() << Metavision::Log::no_space << "Converted " << raw_mb << " MB and " << n_events << " events in "
+                  << elapsed_s << " s (" << (elapsed_s > 0 ? raw_mb / elapsed_s : 0.) << " MB/s, "
+                  << (elapsed_s > 0 ? n_events / elapsed_s / 1e6 : 0.) << " Mev/s)";
+
     return 0;
 }
@@ -78,12 +78,24 @@
 // Metavision SDK timestamp
 #include "metavision/sdk/base/utils/timestamp.h"
 
+// Metavision SDK thread policy
+#include "metavision/sdk/base/utils/thread_policy.h"
+
 // Metavision SDK Driver AntiFlickerModule class
 #include "metavision/sdk/driver/antiflicker_module.h"
 
 // Metavision SDK Driver NoiseFilterModule class
 #include "metavision/sdk/driver/noise_filter_module.h"
 
+// Definition of ReplayClock
+#include "metavision/sdk/driver/replay_clock.h"
+
+// Metavision HAL performance profile
+#include "metavision/hal/utils/performance_profile.h"
+
+// Metavision SDK Core ClockCorrelator class
+#include "metavision/sdk/core/utils/clock_correlator.h"
+
 // Metavision SDK core deprecated feature util
 #include "metavision/sdk/base/utils/detail/deprecated_feature.h"
 
@@ -112,6 +124,35 @@ enum class CameraStatus : short {
 /// @brief Available online sources type alias
 using AvailableSourcesList = std::map<OnlineSourceType, std::vector<std::string>>;
 
+/// @brief Configuration of the replay of a RAW file at the pace of its recording (see @ref Camera::from_file)
+struct FileReplayConfig {
+    /// Speed of the replay relative to the recording, from 0.1 (10 times slower) to 100 (100 times faster)
+    double speed_factor = 1.;
+
+    /// Period of the refresh of the display of the events, in us of wall clock time, or 0 to decode all the data.
+    /// When replaying faster than real time, only the data that can be displayed is then decoded: the data preceding
+    /// the last @ref display_window_us before each refresh is skipped, by seeking in the file (see
+    /// @ref RawFileConfig::build_index_). The skipped data is not passed to the callbacks of @ref RawData either.
+    uint32_t display_period_us = 0;
+
+    /// Duration of the events displayed at each refresh, in us of the recording
+    uint32_t display_window_us = 10000;
+
+    /// Replay the file in a loop, going back to its beginning when reaching its end (see @ref RawFileConfig::loop_).
+    /// The timestamps keep increasing across the loops. The data is not skipped when looping, whatever
+    /// @ref display_period_us.
+    bool loop = false;
+
+    /// Clock shared with other RAW files replayed in sync with this one, or nullptr to follow the wall clock on its
+    /// own. The speed of the replay is then the one of the clock (see @ref ReplayClockConfig::speed_factor), the other
+    /// settings of the speed and the display being ignored
+    std::shared_ptr<ReplayClock> clock;
+
+    /// Trade-off between the latency and the efficiency of the replay, setting the sizes of the reads of the file and
+    /// of the batches of events decoded (see @ref Camera::set_performance_profile)
+    PerformanceProfile performance_profile = PerformanceProfile::Balanced;
+};
+
 /// @brief Callback type alias for @ref CameraException
 /// @ref CameraException the camera exception generated.
 using RuntimeErrorCallback = std::function<void(const CameraException &)>;
@@ -132,6 +173,44 @@ struct CameraConfiguration {
     std::string serial_number = "";
 };
 
+/// @brief Report of the start of a camera, see @ref Camera::start_all
+struct CameraStartReport {
+    /// @brief true if the camera has been started, false if it was already started
+    bool started = false;
+
+    /// @brief Time elapsed between the call to @ref Camera::start_all and the reception of the first buffer of data,
+    /// in microseconds, or -1 if no buffer has been received before the timeout
+    int64_t time_to_first_buffer_us = -1;
+};
+
+/// @brief Percentiles of a latency, in microseconds
+struct LatencyPercentiles {
+    double p50_us  = 0.;
+    double p90_us  = 0.;
+    double p99_us  = 0.;
+    double p999_us = 0.;
+    double max_us  = 0.;
+    double mean_us = 0.;
+};
+
+/// @brief Statistics of the latency of the events delivered by a camera, see @ref Camera::get_latency_statistics
+struct CameraLatencyStatistics {
+    /// @brief Number of buffers of data measured
+    size_t num_buffers = 0;
+
+    /// @brief Latency from the arrival of the buffers on the host (end of their transfer) to the end of the events
+    /// callbacks called on their data
+    LatencyPercentiles transfer_to_callback;
+
+    /// @brief Estimated latency from the generation of the last event of the buffers by the sensor to the end of the
+    /// events callbacks called on their data
+    ///
+    /// The device clock is related to the host clock by @ref Camera::get_clock_correlation, which assumes that the
+    /// fastest buffers were transferred instantly. This estimate is thus a lower bound of the latency, which does not
+    /// account for the minimal transfer time. It is not available when reading from a file.
+    LatencyPercentiles sensor_to_callback;
+};
+
 /// @brief Main class for the camera interface
 class Camera {
 public:
@@ -209,13 +288,41 @@ public:
     ///                                  amount of time it took for them to be received when recording the RAW file. If
     ///                                  false, the file will be read as fast as possible and the events will be
     ///                                  available as soon as possible as well. The max_event_lifespan will only be
-    ///                                  taken into account when reproducing the camera behavior.
+    ///                                  taken into account when reproducing the camera behavior. When false, several
+    ///                                  reads of the file are also kept in flight at once (see
+    ///                                  @ref RawFileConfig::n_reads_in_flight_).
     /// @note Since 2.1.0, the @p reproduce_camera_behavior is only taken into account if at least one event callback
     ///       is registered (CD or ExtTrigger), it will have no effect if only a RawData callback is registered.
     /// @return @ref Camera instance initialized from the input RAW file
     static Camera from_file(const std::string &rawfile, bool reproduce_camera_behavior = true);
 
-    /// @note This method is deprecated since version 2.1.0 and will be removed in next releases
+    /// @brief Initializes a camera instance from a RAW file, replayed at a given pace relative to its recording
+    ///
+    /// This is the same as @ref from_file reproducing the camera behavior, except that the file can be replayed
+    /// faster or slower than it was recorded, and that the data that can not be displayed can be skipped when
+    /// replaying fast (see @ref FileReplayConfig). Several files given the same @ref FileReplayConfig::clock are
+    /// replayed in sync.
+    /// @throw A @ref CameraException in case of initialization failure, if the speed factor is out of range or if the
+    /// display window is empty while the display period is set
+    /// @param rawfile Path to the RAW file
+    /// @param replay_config Configuration of the replay
+    /// @return @ref Camera instance initialized from the input RAW file
+    static Camera from_file(const std::string &rawfile, const FileReplayConfig &replay_config);
+
+    /// @brief Initializes a camera instance from several RAW files, replayed in order as a single recording
+    ///
+    /// The files are typically the parts of a recording split by time or size. They are chained without reopening the
+    /// device or restarting the decoding, so that the events and their timestamps are continuous from one file to the
+    /// next. The headers of the files must be identical, except for their dates. Seeking is not supported.
+    /// @throw A @ref CameraException in case of initialization failure.
+    /// @param rawfiles Paths to the RAW files, in order
+    /// @param reproduce_camera_behavior If true, the files are read at the same speed as was sent by the camera when
+    ///                                  they were recorded (see @ref from_file)
+    /// @return @ref Camera instance initialized from the input RAW files
+    static Camera from_files(const std::vector<std::string> &rawfiles, bool reproduce_camera_behavior = true);
+
+    /// @note This method is deprecated since version 2.1.0 and will be removed in next releases. Use @ref CameraGroup
+    /// to acquire from synchronized cameras
     METAVISION_DEPRECATED_FEATURE(2.1.0) static bool synchronize_and_start_cameras(Camera &master, Camera &slave);
 
     /// @brief Gets class to handle RAW data from the camera
@@ -338,6 +445,18 @@ public:
     /// started.
     bool start();
 
+    /// @brief Starts several cameras concurrently
+    ///
+    /// The cameras are started from separate threads, which is faster than starting them one after the other when
+    /// starting a device takes time. The function then waits for each camera to receive its first buffer of data.
+    /// @param cameras Cameras to start
+    /// @param first_buffer_timeout_ms Maximum time to wait for the first buffer of the cameras, in milliseconds
+    /// @throw A @ref CameraException if one of the cameras has not been initialized. The other cameras are started
+    /// nonetheless.
+    /// @return Report of the start of each camera, in the same order as @p cameras
+    static std::vector<CameraStartReport> start_all(const std::vector<Camera *> &cameras,
+                                                    uint32_t first_buffer_timeout_ms = 1000);
+
     /// @brief Checks if the camera is running or there are data remaining from an offline source
     ///
     /// If the source is online, it always returns true unless the @ref stop function has been called.\n
@@ -353,6 +472,24 @@ public:
     /// running, this function returns false.
     bool stop();
 
+    /// @brief Pauses the streaming without stopping the camera
+    ///
+    /// The threads and the buffers of the camera are kept, and only the data flow is stopped: the events of a live
+    /// camera are dropped while paused, and a file is not read anymore until resumed. Resuming is thus much faster than
+    /// restarting the camera with @ref stop and @ref start. The camera remains running while paused.
+    /// @throw A @ref CameraException if the camera has not been initialized.
+    /// @return true if the camera has been paused, false if it is not running or already paused
+    bool pause();
+
+    /// @brief Resumes the streaming paused with @ref pause
+    /// @throw A @ref CameraException if the camera has not been initialized.
+    /// @return true if the camera has been resumed, false if it is not running or not paused
+    bool resume();
+
+    /// @brief Checks if the streaming is paused, see @ref pause
+    /// @return true if the camera is paused, false otherwise
+    bool is_paused();
+
     /// @note This method is deprecated since version 2.1.0 and will be removed in next releases
     METAVISION_DEPRECATED_FEATURE(2.1.0) bool set_max_event_rate_limit(uint32_t rate_kEV_s);
 
@@ -373,6 +510,98 @@ public:
     /// @throw A @ref CameraException if the camera has not been initialized.
     void stop_recording();
 
+    /// @brief Sets the threading policy of the threads spawned by the camera
+    ///
+    /// The policy applies to the thread transferring the data from the source and to the thread decoding it and
+    /// calling the events callbacks, the next time the camera is started. Unless the policy gives a name, these threads
+    /// are respectively named "mv_transfer" and "mv_camera".
+    /// @throw A @ref CameraException if the camera has not been initialized.
+    /// @param policy The threading policy
+    void set_thread_policy(const ThreadPolicy &policy);
+
+    /// @brief Sets the trade-off between the latency of the events and the efficiency of their transfer, decoding and
+    /// dispatch
+    ///
+    /// The profile sets the number of events decoded before the CD events callbacks are called, the wait strategy of
+    /// the thread decoding the data (spinning or sleeping while waiting for the next buffer), and the duration of the
+    /// batches of events decoded when replaying a file at the pace of its recording (see @ref PerformanceSettings).
+    /// The sizes of the reads of a file are set when opening it, see @ref FileReplayConfig::performance_profile.
+    /// @throw A @ref CameraException if the camera has not been initialized or is running.
+    /// @param profile The performance profile
+    void set_performance_profile(PerformanceProfile profile);
+
+    /// @brief Gets the trade-off between the latency of the events and the efficiency of their processing
+    /// @return The performance profile, @ref PerformanceProfile::Balanced unless set otherwise
+    PerformanceProfile get_performance_profile() const;
+
+    /// @brief Decodes only one buffer of data in @p n, all the data being still recorded
+    ///
+    /// The buffers not decoded are recorded (see @ref start_recording) by the thread transferring the data, without
+    /// waking up the thread decoding it, so that a recording at full rate can go along with a preview of a fraction of
+    /// the events, or run without any decoding at all. As the buffers decoded do not follow each other, the decoding
+    /// of each of them resumes from its first resync point (see @ref I_Decoder::find_resync_point), the events before
+    /// it being dropped. The RAW data callbacks are only called with the data decoded.
+    /// @throw A @ref CameraException if the camera has not been initialized or is running.
+    /// @param n One buffer in @p n is decoded. 1 decodes all the data (default), 0 decodes nothing, the data being only
+    /// recorded
+    void set_decoding_subsampling(uint32_t n);
+
+    /// @brief Gets the subsampling of the buffers of data decoded
+    /// @return One buffer in this number is decoded, see @ref set_decoding_subsampling
+    uint32_t get_decoding_subsampling() const;
+
+    /// @brief Calls the events callbacks on a thread of their own, while the next buffer of data is decoded
+    ///
+    /// By default, the thread of the camera decodes each buffer of data and calls the callbacks with its events before
+    /// decoding the next one, so that heavy callbacks slow down the decoding. When pipelined, the events decoded from
+    /// a buffer are stored in one of two batches, the callbacks being called with them on a second thread while the
+    /// next buffer is decoded in the other batch. The callbacks are called in the same order and with the same events
+    /// as without pipelining, only the thread calling them changes. The RAW data callbacks are called on the same
+    /// thread, after the events callbacks of the data, which is then copied in the batch. The state of the decoder
+    /// (e.g. its last timestamp) is not in sync with the events any more when read from the callbacks. The pipelining
+    /// is not used when reproducing the camera behavior with a file (see @ref from_file), where the callbacks follow
+    /// the pace of the decoding.
+    /// @throw A @ref CameraException if the camera has not been initialized or is running.
+    /// @param enable true to pipeline the decoding and the callbacks, false to run them in sequence (default)
+    void enable_callback_pipelining(bool enable = true);
+
+    /// @brief Checks if the decoding and the events callbacks are pipelined
+    /// @return true if the callbacks are called on a thread of their own, see @ref enable_callback_pipelining
+    bool is_callback_pipelining_enabled() const;
+
+    /// @brief Enables or disables the measurement of the latency of the events
+    ///
+    /// When enabled, the time elapsed from the arrival of each buffer of data on the host to the end of the events
+    /// callbacks called on its data is measured. Statistics are reset each time the camera is started.
+    /// @param enable true to enable the measurement, false to disable it
+    void enable_latency_statistics(bool enable = true);
+
+    /// @brief Gets the statistics of the latency of the events measured since the camera was started
+    ///
+    /// Can be called while the camera is running.
+    /// @return The latency statistics, empty if the measurement has not been enabled
+    /// @sa @ref enable_latency_statistics
+    CameraLatencyStatistics get_latency_statistics() const;
+
+    /// @brief Registers the metrics of the camera in the @ref MetricsRegistry, until the camera is destroyed
+    ///
+    /// The numbers of events decoded per type and of bytes processed, the time spent decoding the buffers, the backlog
+    /// of the events stream and the buffers dropped by the data transfer are reported with the label camera=name. The
+    /// counters are updated without lock by the decoding thread, there is no need to count the events in callbacks.
+    /// @param name Name of the camera in the metrics
+    void register_metrics(const std::string &name);
+
+    /// @brief Gets the relation between the timestamps of the events and the steady clock of the host
+    ///
+    /// The relation is estimated continuously, while the camera runs, from the arrival times of the buffers of data on
+    /// the host and the timestamps of their last event, and follows the drift of the clocks (see @ref
+    /// ClockCorrelator). The host times are in us since the epoch of std::chrono::steady_clock, they can be converted
+    /// to another clock of the host (e.g. the system clock synchronized with PTP) by adding the offset between the
+    /// clocks.
+    /// It is reset each time the camera is started, and is not available when reading from a file.
+    /// @return The relation, not valid if no buffer has been received yet
+    ClockCorrelation get_clock_correlation() const;
+
     /// @brief Returns @ref CameraConfiguration of the camera that holds the camera properties (dimensions, camera
     /// biases, ...)
     ///
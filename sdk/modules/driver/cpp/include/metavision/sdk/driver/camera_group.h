@@ -0,0 +1,133 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_DRIVER_CAMERA_GROUP_H
+#define METAVISION_SDK_DRIVER_CAMERA_GROUP_H
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/base/utils/timestamp.h"
+#include "metavision/sdk/driver/camera.h"
+
+namespace Metavision {
+
+/// @brief Callback type alias for the merged CD events of a @ref CameraGroup
+/// @param begin @ref EventCD pointer to the beginning of the buffer
+/// @param end @ref EventCD pointer to the end of the buffer
+/// @param camera_indices Index in the group of the camera of each event of the buffer
+using MergedEventsCDCallback =
+    std::function<void(const EventCD *begin, const EventCD *end, const std::uint16_t *camera_indices)>;
+
+/// @brief Configuration of a @ref CameraGroup
+struct CameraGroupConfig {
+    /// @brief If true, the first camera of the group is set as master and the others as slaves, so that they share the
+    /// same clock. Requires the cameras to be connected with a synchronization cable
+    bool synchronize = true;
+
+    /// @brief Maximum time a camera is waited for when its events are behind the ones of the other cameras, in us
+    ///
+    /// The events of a camera arriving later than that are dropped from the merged stream.
+    timestamp max_skew_us = 10000;
+
+    /// @brief If true, the timestamps of each camera are shifted so that its first event is at 0
+    ///
+    /// To be used when the cameras do not share the same clock, for instance when reading recordings of cameras that
+    /// were not synchronized.
+    bool align_first_events = false;
+
+    /// @brief Maximum time to wait for the first buffer of the cameras when starting the group, in milliseconds
+    uint32_t first_buffer_timeout_ms = 1000;
+};
+
+/// @brief Group of cameras acquiring synchronously, whose CD events are merged into a single time ordered stream
+///
+/// The group sets up the master and slave modes of the cameras, starts them in the order required by the
+/// synchronization and merges their events by a k-way merge. The events of each camera are buffered until the other
+/// cameras have caught up, within a bounded skew (see @ref CameraGroupConfig::max_skew_us), so that fused processing
+/// receives a single stream of time ordered events.
+///
+/// The cameras remain accessible with @ref camera, for instance to set their biases or to add callbacks on their own
+/// events.
+class CameraGroup {
+public:
+    /// @brief Opens the cameras of given serial numbers, the first one being the master
+    /// @throw A @ref CameraException if a camera can not be opened, or if the synchronization fails
+    /// @param serials Serial numbers of the cameras
+    /// @param config Configuration of the group
+    static CameraGroup from_serials(const std::vector<std::string> &serials,
+                                    const CameraGroupConfig &config = CameraGroupConfig());
+
+    /// @brief Opens RAW files as a group, each file being read as a camera
+    /// @throw A @ref CameraException if a file can not be opened
+    /// @param rawfiles Paths to the RAW files
+    /// @param config Configuration of the group, the cameras being never synchronized
+    static CameraGroup from_files(const std::vector<std::string> &rawfiles,
+                                  const CameraGroupConfig &config = CameraGroupConfig());
+
+    /// @brief Constructor
+    /// @throw A @ref CameraException if the group is empty or too large, or if the synchronization fails
+    /// @param cameras Cameras of the group, the first one being the master when synchronizing them
+    /// @param config Configuration of the group
+    CameraGroup(std::vector<Camera> &&cameras, const CameraGroupConfig &config = CameraGroupConfig());
+
+    /// @brief Move constructor
+    CameraGroup(CameraGroup &&group);
+
+    /// @brief Move assignment
+    CameraGroup &operator=(CameraGroup &&group);
+
+    /// @brief Destructor
+    ///
+    /// Stops the cameras if they are running.
+    ~CameraGroup();
+
+    /// @brief Gets the number of cameras of the group
+    size_t size() const;
+
+    /// @brief Gets a camera of the group
+    /// @param index Index of the camera, 0 being the master when synchronizing the cameras
+    Camera &camera(size_t index);
+
+    /// @brief Sets the function called with the merged CD events of the cameras
+    ///
+    /// The function is called from the threads of the cameras, one call at a time.
+    /// @param cb Callback to call with the merged events
+    void set_merged_cd_callback(const MergedEventsCDCallback &cb);
+
+    /// @brief Starts the cameras, the slaves before the master when they are synchronized
+    /// @throw A @ref CameraException if a camera has not been initialized
+    /// @return Report of the start of each camera, in the order of the group
+    std::vector<CameraStartReport> start();
+
+    /// @brief Checks if at least one of the cameras is running
+    bool is_running();
+
+    /// @brief Stops the cameras, the master first, and outputs the events still buffered
+    /// @return true if all the cameras were running and have been stopped, false otherwise
+    bool stop();
+
+    /// @brief Gets the number of events dropped from the merged stream since the start, because they arrived more than
+    /// the maximum skew after the events of the other cameras
+    size_t get_num_late_events() const;
+
+private:
+    class Private;
+    std::unique_ptr<Private> pimpl_;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_DRIVER_CAMERA_GROUP_H
@@ -12,6 +12,7 @@
 #ifndef METAVISION_SDK_DRIVER_CD_H
 #define METAVISION_SDK_DRIVER_CD_H
 
+#include <cstddef>
 #include <memory>
 #include <functional>
 
@@ -28,6 +29,54 @@ namespace Metavision {
 /// @param end @ref EventCD pointer to the end of the buffer.
 using EventsCDCallback = std::function<void(const EventCD *begin, const EventCD *end)>;
 
+/// @brief Callback type alias for slices of @ref EventCD
+/// @param ts Timestamp of the slice: the end of its time range for slices of a fixed duration, or the timestamp of
+/// its last event for slices of a fixed number of events
+/// @param begin @ref EventCD pointer to the beginning of the slice.
+/// @param end @ref EventCD pointer to the end of the slice.
+using EventsCDSliceCallback = std::function<void(timestamp ts, const EventCD *begin, const EventCD *end)>;
+
+/// @brief Condition ending the slices of events given to a callback added with @ref CD::add_slice_callback
+struct SliceCondition {
+    /// @brief Type of the slices
+    enum class Type {
+        N_US,    ///< Slices of a fixed duration, aligned on multiples of this duration
+        N_EVENTS ///< Slices of a fixed number of events
+    };
+
+    /// @brief Makes a condition of slices of a fixed duration
+    /// @param delta_ts Duration of the slices, in us
+    static SliceCondition make_n_us(timestamp delta_ts) {
+        return SliceCondition{Type::N_US, delta_ts, 0};
+    }
+
+    /// @brief Makes a condition of slices of a fixed number of events
+    /// @param delta_n_events Number of events of the slices
+    static SliceCondition make_n_events(size_t delta_n_events) {
+        return SliceCondition{Type::N_EVENTS, 0, delta_n_events};
+    }
+
+    Type type;             ///< Type of the slices
+    timestamp delta_ts;    ///< Duration of the slices, in us, if @ref type is @ref Type::N_US
+    size_t delta_n_events; ///< Number of events of the slices, if @ref type is @ref Type::N_EVENTS
+};
+
+/// @brief Policy applied when the queue of a callback run on a worker thread is full
+enum class AsyncCallbackDropPolicy {
+    Block,      ///< The decoding waits for the callback to catch up, no buffer is lost
+    DropNewest, ///< The buffer just decoded is not queued
+    DropOldest  ///< The oldest queued buffer is dropped to make room for the one just decoded
+};
+
+/// @brief Configuration of a callback run on a worker thread
+struct AsyncCallbackConfig {
+    /// Maximum number of buffers waiting to be processed by the callback
+    size_t max_queued_buffers = 64;
+
+    /// What to do with a decoded buffer when the queue is full
+    AsyncCallbackDropPolicy drop_policy = AsyncCallbackDropPolicy::Block;
+};
+
 /// @brief Facility class to handle CD events
 class CD {
 public:
@@ -44,12 +93,46 @@ public:
     /// @return ID of the added callback
     CallbackId add_callback(const EventsCDCallback &cb);
 
+    /// @brief Subscribes to CD events with a callback run on a worker thread of its own
+    ///
+    /// Callbacks added with @ref add_callback are called one after the other on the decoding thread, which a slow
+    /// one can hold back. Instead, the callback added here is called on its own thread, with the buffers queued
+    /// for it. The decoded events are copied once per buffer, whatever the number of such callbacks, in a pooled
+    /// buffer shared by all of them, which must hence not be modified.
+    /// @param cb Callback to call on the worker thread for each buffer of eventCD decoded
+    /// @param config Size of the queue of the callback and policy applied when it is full
+    /// @return ID of the added callback, to be removed with @ref remove_callback
+    CallbackId add_async_callback(const EventsCDCallback &cb, const AsyncCallbackConfig &config = {});
+
+    /// @brief Subscribes to slices of CD events of a fixed duration or number of events
+    ///
+    /// The buffers of decoded events are cut into slices on the decoding thread, which spares consumers working on
+    /// slices another buffering stage (e.g. a SharedEventsBufferProducerAlgorithm). The boundaries of the slices
+    /// are found by binary search: a slice held by a single decoded buffer is given as is, and the events of a slice
+    /// spanning several buffers are copied once. The slices of a fixed duration are also given when they hold no
+    /// events, so that their period is regular. The events of the last slice, not ended yet when the callback is
+    /// removed, are not given.
+    /// @param condition Condition ending the slices, see @ref SliceCondition::make_n_us and
+    /// @ref SliceCondition::make_n_events
+    /// @param cb Callback to call on the decoding thread with each slice of eventCD
+    /// @return ID of the added callback, to be removed with @ref remove_callback
+    /// @throw CameraException if the duration or number of events of the slices is not positive
+    CallbackId add_slice_callback(const SliceCondition &condition, const EventsCDSliceCallback &cb);
+
     /// @brief Removes a previously registered callback
+    ///
+    /// If the callback runs on a worker thread, the buffers already queued for it are processed before this function
+    /// returns.
     /// @param callback_id Callback ID
     /// @return true if the callback has been unregistered correctly, false otherwise.
-    /// @sa @ref add_callback
+    /// @sa @ref add_callback, @ref add_async_callback, @ref add_slice_callback
     bool remove_callback(CallbackId callback_id);
 
+    /// @brief Gets the number of buffers dropped because the queue of a callback run on a worker thread was full
+    /// @param callback_id ID of a callback added with @ref add_async_callback
+    /// @return Number of buffers dropped, 0 if the callback is unknown
+    size_t get_num_dropped_buffers(CallbackId callback_id) const;
+
     /// @brief For internal use
     class Private;
     /// @brief For internal use
@@ -0,0 +1,185 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_DRIVER_EVENT_FILE_READER_H
+#define METAVISION_SDK_DRIVER_EVENT_FILE_READER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/base/events/event_ext_trigger.h"
+#include "metavision/sdk/base/utils/timestamp.h"
+
+namespace Metavision {
+
+class Device;
+class I_Decoder;
+class RawFileIndex;
+template<typename Event>
+class I_EventDecoder;
+
+/// @brief Events of a RAW file over a slice of time
+struct EventFileSlice {
+    /// Timestamp of the beginning of the slice, included
+    timestamp begin_ts = 0;
+
+    /// Timestamp of the end of the slice, excluded
+    timestamp end_ts = 0;
+
+    /// CD events of the slice
+    std::vector<EventCD> cd_events;
+
+    /// External trigger events of the slice
+    std::vector<EventExtTrigger> ext_trigger_events;
+};
+
+/// @brief Reads a RAW file slice by slice, decoding it on the calling thread
+///
+/// Unlike @ref Camera::from_file, no thread is started to read or decode the file and no lock is taken: the data is
+/// read and decoded when the next slice is requested, and the slice given is always the same object, its buffers
+/// being reused. Batch jobs can hence process many files in parallel with one thread per file.
+///
+/// @code
+/// EventFileReader reader("recording.raw", 10000);
+/// for (const auto &slice : reader) {
+///     process(slice.cd_events);
+/// }
+/// @endcode
+///
+/// The slices are consecutive and all have the same duration, the first one starting at the first multiple of the
+/// duration before the first event. A slice is given as soon as the data decoded reaches its end, even if it has no
+/// events, except the last one which is given only if it has events.
+/// @note Compressed RAW files (see @ref RawCompression) are decompressed by a single helper thread
+class EventFileReader {
+public:
+    /// @brief Input iterator over the slices of the file, which are all the same object
+    class Iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type        = EventFileSlice;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = const EventFileSlice *;
+        using reference         = const EventFileSlice &;
+
+        /// @brief Builds the end iterator
+        Iterator() = default;
+
+        reference operator*() const {
+            return reader_->slice_;
+        }
+        pointer operator->() const {
+            return &reader_->slice_;
+        }
+
+        /// @brief Reads the next slice, the iterator becoming the end iterator if there is none
+        Iterator &operator++();
+
+        bool operator==(const Iterator &other) const {
+            return reader_ == other.reader_;
+        }
+        bool operator!=(const Iterator &other) const {
+            return reader_ != other.reader_;
+        }
+
+    private:
+        friend class EventFileReader;
+        explicit Iterator(EventFileReader *reader) : reader_(reader) {}
+
+        EventFileReader *reader_ = nullptr;
+    };
+
+    /// @brief Opens a RAW file
+    /// @param path Path to the RAW file
+    /// @param slice_duration_us Duration of the slices, in us
+    /// @param n_events_to_read Number of RAW events read from the file at once
+    /// @param do_time_shifting If true, the timestamps are shifted so that the file starts at 0
+    /// @throw CameraException if the file does not exist, can not be opened or no plugin can decode it
+    /// @throw std::invalid_argument if the duration of the slices is not positive
+    EventFileReader(const std::string &path, timestamp slice_duration_us, uint32_t n_events_to_read = 100000,
+                    bool do_time_shifting = true);
+
+    /// @brief Destructor
+    ~EventFileReader();
+
+    EventFileReader(const EventFileReader &) = delete;
+    EventFileReader &operator=(const EventFileReader &) = delete;
+
+    /// @brief Reads the next slice of the file
+    /// @param slice Slice filled with the events, its buffers being reused
+    /// @return false if there are no more slices, @p slice being then left empty
+    bool read_next_slice(EventFileSlice &slice);
+
+    /// @brief Reads the first slice and returns an iterator on it
+    /// @note The reading is not restarted: calling this function again goes on from the current position
+    Iterator begin();
+
+    /// @brief Returns the end iterator
+    Iterator end();
+
+    /// @brief Moves the reading to a timestamp, using the index of the file
+    ///
+    /// The reading resumes at the last entry of the index preceding the timestamp, so that the next slice may start
+    /// before it, at most one period of the index earlier (see @ref RawFileIndex). The slices are then consecutive
+    /// from there, the first one starting at the first multiple of the duration before its first event.
+    /// The index is loaded from the sidecar file of the RAW file when it is opened, if it is up to date (see
+    /// @ref RawFileConfig::build_index_ to build it).
+    /// @param t Timestamp to reach
+    /// @return true if the reading has been moved, false if the file has no index or the reading could not be moved
+    bool seek(timestamp t);
+
+    /// @brief Gets the device decoding the file, to query its facilities
+    /// @warning The device must not be started, the file being read by this object
+    Device &get_device();
+
+    /// @brief Gets the number of bytes of RAW data read so far, the header excluded
+    uint64_t get_n_bytes_read() const;
+
+private:
+    bool decode_next_chunk();
+
+    template<typename Event>
+    static void take_until(std::vector<Event> &pending, size_t &pending_begin, timestamp end_ts,
+                           std::vector<Event> &out);
+
+    std::unique_ptr<std::istream> stream_;
+    std::unique_ptr<Device> device_;
+    std::unique_ptr<RawFileIndex> index_;
+    I_Decoder *decoder_                                   = nullptr;
+    I_EventDecoder<EventCD> *cd_decoder_                  = nullptr;
+    I_EventDecoder<EventExtTrigger> *ext_trigger_decoder_ = nullptr;
+    size_t cd_callback_id_                                = 0;
+    size_t ext_trigger_callback_id_                       = 0;
+
+    const timestamp slice_duration_us_;
+    std::vector<uint8_t> read_buffer_;
+    uint64_t n_bytes_read_   = 0;
+    bool eof_                = false;
+    bool started_            = false;
+    timestamp next_begin_ts_ = 0;
+
+    // Events decoded but not given yet, starting from their begin index
+    std::vector<EventCD> pending_cd_;
+    size_t pending_cd_begin_ = 0;
+    std::vector<EventExtTrigger> pending_ext_trigger_;
+    size_t pending_ext_trigger_begin_ = 0;
+
+    EventFileSlice slice_;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_DRIVER_EVENT_FILE_READER_H
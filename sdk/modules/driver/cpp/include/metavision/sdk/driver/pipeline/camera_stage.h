@@ -78,7 +78,7 @@ public:
     /// @param enable_cd_events_callback If true, enables the callback of CD events
     CameraStage(Camera &&camera, SharedEventsBufferProducerParameters buffer_producer_parameters,
                 bool enable_cd_events_callback = true) :
-        ext_trigger_buffer_pool_(EventTriggerBufferPool::make_bounded()) {
+        camera_(std::move(camera)), ext_trigger_buffer_pool_(EventTriggerBufferPool::make_bounded()) {
         if (enable_cd_events_callback) {
             init_cd_processing(buffer_producer_parameters);
         }
@@ -105,10 +105,28 @@ public:
         init();
     }
 
+    /// @brief Constructor
+    ///
+    /// The camera and the buffers of events produced are configured for a trade-off between latency and efficiency.
+    /// @param camera Camera producing the input events
+    /// @param profile Performance profile of the camera (see @ref Camera::set_performance_profile), also setting the
+    /// duration of the buffers of CD events produced (see @ref PerformanceSettings::buffer_time_slice_us)
+    /// @param enable_cd_events_callback If true, enables the callback of CD events
+    CameraStage(Camera &&camera, PerformanceProfile profile, bool enable_cd_events_callback = true) :
+        CameraStage(std::move(camera), make_buffer_producer_parameters(profile), enable_cd_events_callback) {
+        camera_.set_performance_profile(profile);
+    }
+
     /// @brief Adds trigger events
+    ///
+    /// The trigger events also cut the CD events buffers if
+    /// @ref SharedEventsBufferProducerParameters::buffers_trigger_slicing_ is enabled.
     /// @param begin @ref EventExtTrigger pointer to the beginning of the buffer
     /// @param end @ref EventExtTrigger pointer to the end of the buffer
     void add_ext_trigger_events(const EventExtTrigger *begin, const EventExtTrigger *end) {
+        if (cd_buffer_pool_) {
+            cd_buffer_pool_->process_trigger_events(begin, end);
+        }
         cur_ext_trigger_buffer_->insert(std::end(*cur_ext_trigger_buffer_), begin, end);
         produce(cur_ext_trigger_buffer_);
         cur_ext_trigger_buffer_ = ext_trigger_buffer_pool_.acquire();
@@ -122,6 +140,15 @@ public:
     }
 
 private:
+    static SharedEventsBufferProducerParameters make_buffer_producer_parameters(PerformanceProfile profile) {
+        SharedEventsBufferProducerParameters buffer_producer_parameters;
+        buffer_producer_parameters.buffers_events_count_       = 0;
+        buffer_producer_parameters.buffers_pool_size_          = 64;
+        buffer_producer_parameters.buffers_time_slice_us_      = get_performance_settings(profile).buffer_time_slice_us;
+        buffer_producer_parameters.buffers_preallocation_size_ = 50000;
+        return buffer_producer_parameters;
+    }
+
     void init_cd_processing(const SharedEventsBufferProducerParameters &params) {
         cd_buffer_pool_.reset(new CdBufferProducer(
             params,
@@ -0,0 +1,75 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_DRIVER_REPLAY_CLOCK_H
+#define METAVISION_SDK_DRIVER_REPLAY_CLOCK_H
+
+#include <memory>
+
+#include "metavision/sdk/base/utils/timestamp.h"
+
+namespace Metavision {
+
+/// @brief Configuration of a @ref ReplayClock
+struct ReplayClockConfig {
+    /// Speed of the replay relative to the recordings, or 0 to replay them as fast as possible, in lock-step
+    double speed_factor = 1.;
+
+    /// Maximum advance, in us of recording, of a file over the others when replaying them as fast as possible
+    timestamp lock_step_us = 1000;
+
+    /// If true, the first events of the files are replayed at the same time. Otherwise their timestamps are used as
+    /// is, for files recorded by cameras sharing the same clock (e.g. synchronized in a @ref CameraGroup): the events
+    /// of all the files with the same timestamp are then replayed at the same time
+    bool align_first_events = true;
+};
+
+/// @brief Virtual clock shared by RAW files replayed together, so that they are replayed in sync
+///
+/// Each file replayed at the pace of its recording (see @ref Camera::from_file) otherwise follows the wall clock on its
+/// own, from the time its first event is decoded, and the files drift apart. The files given the same clock (see
+/// @ref FileReplayConfig::clock) start their replay once the first event of each of them has been decoded, and then
+/// follow a single time reference:
+///  - when replaying at a given speed, the deadlines of all the files are computed from the same wall clock origin,
+///  - when replaying as fast as possible, the clock advances by steps of @ref ReplayClockConfig::lock_step_us, once
+///    all the files have decoded the events of the current step.
+///
+/// All the cameras sharing a clock must hence be started for the replay to begin. A camera stopped, or reaching the
+/// end of its file, does not hold back the others. Pausing a camera does not pause the clock.
+class ReplayClock {
+public:
+    /// @brief Constructor
+    /// @throw A @ref CameraException if the speed factor is negative or the lock step is not positive
+    /// @param config Configuration of the clock
+    ReplayClock(const ReplayClockConfig &config = ReplayClockConfig());
+
+    /// @brief Destructor
+    ~ReplayClock();
+
+    /// @brief Gets the configuration of the clock
+    const ReplayClockConfig &get_config() const;
+
+    /// @brief Gets the time of the replay, i.e. the time of recording elapsed since the replay started
+    /// @return Time in us, or -1 if the replay has not started yet
+    timestamp get_time() const;
+
+    /// @brief For internal use
+    class Private;
+    /// @brief For internal use
+    Private &get_pimpl();
+
+private:
+    std::unique_ptr<Private> pimpl_;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_DRIVER_REPLAY_CLOCK_H
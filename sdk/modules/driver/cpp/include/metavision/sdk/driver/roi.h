@@ -81,6 +81,20 @@ public:
     /// @param to_set a vector of @ref Roi::Rectangle
     void set(const std::vector<Rectangle> &to_set);
 
+    /// @brief Updates the hardware ROIs, sending to the sensor only the part of its configuration that changed
+    ///
+    /// This is meant to move the ROIs at a high rate, for instance to follow objects. The ROIs are combined as with
+    /// @ref set(const std::vector<Rectangle> &), and the achieved update latency is available with
+    /// @ref get_update_statistics.
+    ///
+    /// @param to_set a vector of @ref Roi::Rectangle
+    /// @return The number of words of the ROI configuration sent to the sensor
+    size_t update(const std::vector<Rectangle> &to_set);
+
+    /// @brief Gets the statistics of the updates done with @ref update, including their latency
+    /// @return The statistics of the updates
+    const I_ROI::UpdateStatistics &get_update_statistics() const;
+
     /// @brief Unsets any set ROI on the sensor
     void unset();
 
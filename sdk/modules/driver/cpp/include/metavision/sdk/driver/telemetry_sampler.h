@@ -0,0 +1,169 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_DRIVER_TELEMETRY_SAMPLER_H
+#define METAVISION_SDK_DRIVER_TELEMETRY_SAMPLER_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/base/utils/callback_id.h"
+#include "metavision/sdk/base/utils/timestamp.h"
+
+namespace Metavision {
+
+class Camera;
+class I_Monitoring;
+class I_Erc;
+class I_EventRateNoiseFilterModule;
+
+/// @brief Values of the device telemetry sampled at a given time
+///
+/// The values of the facilities the device does not have are left to their default and flagged as unavailable.
+struct TelemetrySnapshot {
+    /// Index of the sample, starting at 1, 0 meaning that no sample has been taken yet
+    uint64_t sample_index = 0;
+
+    /// Timestamp of the last event processed when the sample was taken (in us), -1 if none was
+    timestamp event_timestamp_us = -1;
+
+    /// Time of the sample on the steady clock of the host (in us)
+    int64_t host_time_us = 0;
+
+    /// Number of CD events processed since the sampler was created
+    uint64_t num_events = 0;
+
+    /// CD event rate measured between the previous sample and this one (in events per second)
+    double event_rate = 0.;
+
+    /// Whether the temperature and the illumination are available
+    bool has_monitoring = false;
+
+    /// Sensor's temperature (in C)
+    int temperature_c = 0;
+
+    /// Sensor's illumination (in lux)
+    int illumination_lux = 0;
+
+    /// Whether the ERC state is available
+    bool has_erc = false;
+
+    /// Whether the ERC is enabled
+    bool erc_enabled = false;
+
+    /// Target CD event rate of the ERC (in events per second)
+    uint32_t erc_cd_event_rate = 0;
+
+    /// Whether the threshold of the event rate noise filter is available
+    bool has_noise_filter = false;
+
+    /// Event rate threshold of the noise filter (in kev/s)
+    uint32_t noise_filter_threshold_kev_s = 0;
+};
+
+/// @brief Samples the telemetry of a device in the background
+///
+/// The temperature, the illumination, the ERC state and the noise filter threshold are read from the device
+/// facilities by a thread of the sampler, at a given rate, so that the processing threads never wait for these
+/// synchronous register reads. The last snapshot is published without lock and can be read at any time with
+/// @ref get_latest. Each snapshot is correlated with the stream by the timestamp of the last event processed when it
+/// was taken, and carries the event rate measured from the events processed.
+class TelemetrySampler {
+public:
+    /// @brief Callback called by the sampling thread with each new snapshot, for instance to record it
+    using SampleCallback = std::function<void(const TelemetrySnapshot &)>;
+
+    /// @brief Constructor, the events having to be passed to @ref process_events
+    /// @param monitoring Facility providing the temperature and the illumination, can be nullptr
+    /// @param erc Facility providing the ERC state, can be nullptr
+    /// @param noise_filter Facility providing the event rate noise filter threshold, can be nullptr
+    /// @param rate_hz Number of samples per second
+    /// @throw std::invalid_argument if the rate is not positive
+    TelemetrySampler(I_Monitoring *monitoring, I_Erc *erc, I_EventRateNoiseFilterModule *noise_filter,
+                     double rate_hz);
+
+    /// @brief Constructor sampling the facilities of a camera and processing its CD events
+    /// @param camera Camera to sample, which must outlive the sampler
+    /// @param rate_hz Number of samples per second
+    /// @throw std::invalid_argument if the rate is not positive
+    TelemetrySampler(Camera &camera, double rate_hz);
+
+    /// @brief Destructor, stopping the sampling thread
+    ~TelemetrySampler();
+
+    /// @brief Starts the sampling thread, which takes a first sample right away
+    void start();
+
+    /// @brief Stops the sampling thread
+    void stop();
+
+    /// @brief Processes CD events, to correlate the snapshots with them and to measure the event rate
+    ///
+    /// This only updates a few atomic counters and is meant to be called from the decoding thread.
+    /// @param begin Beginning of the buffer of events
+    /// @param end End of the buffer of events
+    void process_events(const EventCD *begin, const EventCD *end);
+
+    /// @brief Gets the last snapshot, without lock
+    /// @return The last snapshot, whose @ref TelemetrySnapshot::sample_index is 0 if no sample has been taken yet
+    TelemetrySnapshot get_latest() const;
+
+    /// @brief Sets the callback called by the sampling thread with each new snapshot
+    /// @param cb Callback to call, which must be set before @ref start
+    void set_sample_callback(const SampleCallback &cb);
+
+    /// @brief Registers the last snapshot in the @ref MetricsRegistry, until the sampler is destroyed
+    ///
+    /// The event rate, the temperature, the illumination, the ERC state and the noise filter threshold available on
+    /// the device are reported with the label device=name.
+    /// @param name Name of the device in the metrics
+    void register_metrics(const std::string &name);
+
+private:
+    void run();
+    TelemetrySnapshot sample(uint64_t sample_index, int64_t previous_host_time_us, uint64_t previous_num_events);
+    void publish(const TelemetrySnapshot &snapshot);
+
+    I_Monitoring *monitoring_;
+    I_Erc *erc_;
+    I_EventRateNoiseFilterModule *noise_filter_;
+    const std::chrono::microseconds period_;
+    Camera *camera_            = nullptr;
+    CallbackId cd_callback_id_ = 0;
+    SampleCallback sample_cb_;
+    size_t metrics_id_       = 0;
+    bool metrics_registered_ = false;
+
+    std::atomic<timestamp> last_event_timestamp_us_{-1};
+    std::atomic<uint64_t> num_events_{0};
+
+    // Seqlock made of atomic words, so that the snapshot is read without lock by any thread
+    static constexpr size_t NumWords = (sizeof(TelemetrySnapshot) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+    std::atomic<uint64_t> sequence_{0};
+    std::array<std::atomic<uint64_t>, NumWords> words_;
+
+    bool running_ = false;
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::thread thread_;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_DRIVER_TELEMETRY_SAMPLER_H
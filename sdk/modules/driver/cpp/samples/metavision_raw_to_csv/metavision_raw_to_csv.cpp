@@ -11,19 +11,16 @@
 
 // This code sample demonstrates how to use Metavision SDK Driver and Core (pipeline utility) to convert an event-based
 // RAW file to a CSV formatted event-based file.
-// It also shows how to customize an instance of BaseStage to write to a file.
-// This can be an alternative to creating a class deriving from BaseStage, especially when the code is not particularly
-// reusable.
+// The events are formatted in parallel by the CSV writing stage, while the next ones are decoded.
 
 #include <exception>
 #include <iostream>
-#include <fstream>
 #include <functional>
 #include <chrono>
 #include <boost/program_options.hpp>
 #include <metavision/sdk/base/utils/log.h>
+#include <metavision/sdk/core/pipeline/csv_writing_stage.h>
 #include <metavision/sdk/core/pipeline/pipeline.h>
-#include <metavision/sdk/core/pipeline/stage.h>
 #include <metavision/sdk/driver/camera_exception.h>
 #include <metavision/sdk/driver/pipeline/camera_stage.h>
 
@@ -79,31 +76,15 @@ int main(int argc, char *argv[]) {
     }
     auto &cam_stage = p.add_stage(std::make_unique<Metavision::CameraStage>(std::move(cam)));
 
-    // 1) Construct a stage instance that will be customized to write the data in a CSV formatted file
-    std::unique_ptr<Metavision::Stage> csv_stage_ptr = std::make_unique<Metavision::Stage>();
+    // 1) Construct a stage writing the events in a CSV formatted file
     std::string filename("cd.csv");
-    std::ofstream ofs(filename);
-    if (!ofs.is_open()) {
+    try {
+        p.add_stage(std::make_unique<Metavision::CSVWritingStage>(filename), cam_stage);
+    } catch (std::runtime_error &e) {
         MV_LOG_ERROR() << "Unable to write in" << filename;
         return 1;
     }
 
-    // Set the consuming callback of the stage to actually write the data produced by the camera stage
-    std::string lines;
-    csv_stage_ptr->set_consuming_callback([&lines, &ofs](const boost::any &data) {
-        try {
-            auto buffer = boost::any_cast<Metavision::Stage::EventBufferPtr>(data);
-            for (auto &event : *buffer) {
-                ofs << event.x << "," << event.y << "," << event.p << "," << event.t << "\n";
-            }
-        } catch (boost::bad_any_cast &) {
-            MV_LOG_WARNING() << Metavision::Log::function << "Wrong type of data passed to consuming callback !";
-        }
-    });
-
-    // Add the stage to the pipeline
-    p.add_stage(std::move(csv_stage_ptr), cam_stage);
-
     using namespace std::chrono_literals;
     auto log = MV_LOG_INFO() << Metavision::Log::no_space << Metavision::Log::no_endline;
     const std::string message("Writing CSV file...");
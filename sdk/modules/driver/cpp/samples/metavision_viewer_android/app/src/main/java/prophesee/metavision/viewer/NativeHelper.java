@@ -12,6 +12,7 @@
 package prophesee.metavision.viewer;
 
 import android.graphics.Bitmap;
+import android.view.Surface;
 
 public class NativeHelper {
     static {
@@ -67,4 +68,14 @@ public class NativeHelper {
      * This must be called regularly to update the frame displayed in the app.
      */
     public static native void updateFrame(Bitmap bitmap);
+
+    /**
+     * Registers a Surface into which the frames are rendered by native C++ code as soon as they are generated, which
+     * avoids the copies to a bitmap of @ref updateFrame. Its buffers have the geometry of the camera and are scaled
+     * to the size of the Surface. Passing null unregisters it, the frames being then available to @ref updateFrame.
+     * This must be called after the camera has been created.
+     *
+     * @return true if the Surface was registered
+     */
+    public static native boolean setOutputSurface(Surface surface);
 }
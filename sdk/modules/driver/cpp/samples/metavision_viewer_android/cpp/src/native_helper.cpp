@@ -12,12 +12,17 @@
 #include <ostream>
 #include <streambuf>
 #include <cstdlib>
+#include <mutex>
 #include <string.h>
 #include <jni.h>
 #include <dirent.h>
 #include <dlfcn.h>
 #include <android/bitmap.h>
 #include <android/log.h>
+#include <android/native_window_jni.h>
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
 #include <opencv2/core/core.hpp>
 #include <opencv2/imgproc/imgproc.hpp>
 #if CV_MAJOR_VERSION >= 4
@@ -37,6 +42,10 @@ cv::Mat frame;
 std::int64_t callback_id = -1;
 int frame_type;
 std::uint64_t cd_counter = 0, em_counter = 0;
+// Window of the Surface registered by setOutputSurface, into which the frames are rendered as soon as they are
+// generated, and mutex protecting it and the last frame from the calls of the UI thread
+ANativeWindow *output_window = nullptr;
+std::mutex frame_mutex;
 
 class AndroidLogPrintStreamBuf : public std::streambuf {
     enum {
@@ -97,6 +106,75 @@ public:
     }
 };
 std::unique_ptr<AndroidLogPrintOutputStream> android_log_stream;
+
+/// @brief Converts a BGR or grayscale frame to RGBA pixels, in rows of @p dst_stride pixels
+void frame_to_rgba(const cv::Mat &src, std::uint8_t *dst, int dst_stride) {
+    for (int y = 0; y < src.rows; ++y) {
+        const std::uint8_t *in = src.ptr<std::uint8_t>(y);
+        std::uint8_t *out      = dst + 4 * static_cast<size_t>(y) * dst_stride;
+        int x                  = 0;
+        if (src.type() == CV_8UC3) {
+#if defined(__ARM_NEON)
+            for (; x + 16 <= src.cols; x += 16, in += 48, out += 64) {
+                const uint8x16x3_t bgr = vld3q_u8(in);
+                uint8x16x4_t rgba;
+                rgba.val[0] = bgr.val[2];
+                rgba.val[1] = bgr.val[1];
+                rgba.val[2] = bgr.val[0];
+                rgba.val[3] = vdupq_n_u8(255);
+                vst4q_u8(out, rgba);
+            }
+#endif
+            for (; x < src.cols; ++x, in += 3, out += 4) {
+                out[0] = in[2];
+                out[1] = in[1];
+                out[2] = in[0];
+                out[3] = 255;
+            }
+        } else if (src.type() == CV_8UC1) {
+#if defined(__ARM_NEON)
+            for (; x + 16 <= src.cols; x += 16, in += 16, out += 64) {
+                const uint8x16_t gray = vld1q_u8(in);
+                uint8x16x4_t rgba;
+                rgba.val[0] = gray;
+                rgba.val[1] = gray;
+                rgba.val[2] = gray;
+                rgba.val[3] = vdupq_n_u8(255);
+                vst4q_u8(out, rgba);
+            }
+#endif
+            for (; x < src.cols; ++x, ++in, out += 4) {
+                out[0] = out[1] = out[2] = *in;
+                out[3]                   = 255;
+            }
+        }
+    }
+}
+
+/// @brief Renders a frame directly into the buffer of the output window, if any
+///
+/// The window buffers have the geometry of the camera and are scaled by the compositor, so that the frame is converted
+/// once, straight into the memory displayed, without going through a Java bitmap.
+void render_to_window(const cv::Mat &f) {
+    ANativeWindow_Buffer buffer;
+    if (ANativeWindow_lock(output_window, &buffer, nullptr) != 0) {
+        return;
+    }
+    if (buffer.format == WINDOW_FORMAT_RGBA_8888 && buffer.width == f.cols && buffer.height == f.rows) {
+        frame_to_rgba(f, static_cast<std::uint8_t *>(buffer.bits), buffer.stride);
+    }
+    ANativeWindow_unlockAndPost(output_window);
+}
+
+void on_frame(const Metavision::timestamp &, const cv::Mat &f) {
+    std::lock_guard<std::mutex> lock(frame_mutex);
+    if (output_window) {
+        render_to_window(f);
+    } else {
+        // The frame is left untouched by the generator until the next callback, so that no copy is needed
+        frame = f;
+    }
+}
 } // namespace
 
 JNIEXPORT void JNICALL Java_prophesee_metavision_viewer_NativeHelper_setupEnvironment(JNIEnv *env, jobject thiz,
@@ -156,7 +234,7 @@ JNIEXPORT jboolean JNICALL Java_prophesee_metavision_viewer_NativeHelper_createC
             cd_frame_generator->add_events(ev_begin, ev_end);
         });
 
-        cd_frame_generator->start(30, [](const Metavision::timestamp &, const cv::Mat &f) { frame = f; });
+        cd_frame_generator->start(30, on_frame);
     } catch (Metavision::CameraException &e) {
         std::cerr << e.what() << std::endl;
         return false;
@@ -182,7 +260,7 @@ JNIEXPORT jboolean JNICALL Java_prophesee_metavision_viewer_NativeHelper_createC
             cd_frame_generator->add_events(ev_begin, ev_end);
         });
 
-        cd_frame_generator->start(30, [](const Metavision::timestamp &t, const cv::Mat &f) { frame = f; });
+        cd_frame_generator->start(30, on_frame);
 
         env->ReleaseStringUTFChars(path, raw_path_cstr);
     } catch (Metavision::CameraException &e) {
@@ -226,16 +304,20 @@ JNIEXPORT jboolean JNICALL Java_prophesee_metavision_viewer_NativeHelper_stopCam
 namespace {
 
 void mat_to_bitmap(JNIEnv *env, const cv::Mat &src, jobject &bitmap) {
+    AndroidBitmapInfo info;
     void *pixels = 0;
+    if (AndroidBitmap_getInfo(env, bitmap, &info) != ANDROID_BITMAP_RESULT_SUCCESS ||
+        info.format != ANDROID_BITMAP_FORMAT_RGBA_8888 || static_cast<int>(info.width) != src.cols ||
+        static_cast<int>(info.height) != src.rows) {
+        return;
+    }
     AndroidBitmap_lockPixels(env, bitmap, &pixels);
 
-    cv::Mat tmp(src.rows, src.cols, CV_8UC4, pixels);
-    if (src.type() == CV_8UC1) {
-        cvtColor(src, tmp, CV_GRAY2RGBA);
-    } else if (src.type() == CV_8UC3) {
-        cvtColor(src, tmp, CV_BGR2RGBA);
-    } else if (src.type() == CV_8UC4) {
+    if (src.type() == CV_8UC4) {
+        cv::Mat tmp(src.rows, src.cols, CV_8UC4, pixels, info.stride);
         cvtColor(src, tmp, CV_BGRA2RGBA);
+    } else {
+        frame_to_rgba(src, static_cast<std::uint8_t *>(pixels), info.stride / 4);
     }
 
     AndroidBitmap_unlockPixels(env, bitmap);
@@ -248,9 +330,36 @@ JNIEXPORT jlong JNICALL Java_prophesee_metavision_viewer_NativeHelper_updateFram
     if (!camera_initialized) {
         return 0;
     }
+    std::lock_guard<std::mutex> lock(frame_mutex);
     if (!frame.empty()) {
         mat_to_bitmap(env, frame, bitmap);
     }
     return 0;
 }
+
+JNIEXPORT jboolean JNICALL Java_prophesee_metavision_viewer_NativeHelper_setOutputSurface(JNIEnv *env, jobject thiz,
+                                                                                       jobject surface) {
+    std::lock_guard<std::mutex> lock(frame_mutex);
+    if (output_window) {
+        ANativeWindow_release(output_window);
+        output_window = nullptr;
+    }
+    if (surface == nullptr || !camera_initialized) {
+        return false;
+    }
+
+    output_window = ANativeWindow_fromSurface(env, surface);
+    if (!output_window) {
+        return false;
+    }
+    auto &geometry = camera.geometry();
+    if (ANativeWindow_setBuffersGeometry(output_window, geometry.width(), geometry.height(), WINDOW_FORMAT_RGBA_8888) !=
+        0) {
+        ANativeWindow_release(output_window);
+        output_window = nullptr;
+        return false;
+    }
+    frame = cv::Mat();
+    return true;
+}
 }
@@ -92,10 +92,9 @@ void Biases::set_from_file(const std::string &biases_filename) {
         biases_to_set.emplace(bias_name, value);
     }
 
-    // If we get here, no error was found, and we can proceed in setting the biases
-    for (auto it = biases_to_set.begin(), it_end = biases_to_set.end(); it != it_end; ++it) {
-        pimpl_->set(it->first, it->second);
-    }
+    // If we get here, no error was found, and we can proceed in setting the biases, all at once so that the facility
+    // can program them in a single transaction
+    pimpl_->set_biases(biases_to_set);
 }
 
 void Biases::save_to_file(const std::string &dest_file) const {
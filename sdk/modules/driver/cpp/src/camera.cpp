@@ -10,11 +10,15 @@
  **********************************************************************************************************************/
 
 #include <algorithm>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <exception>
 #include <fstream>
 #include <functional>
+#include <future>
 #include <iostream>
+#include <iterator>
 #include <limits>
 #include <list>
 #include <memory>
@@ -28,6 +32,9 @@
 #include "metavision/sdk/driver/biases.h"
 #include "metavision/sdk/base/utils/callback_id.h"
 #include "metavision/sdk/base/utils/get_time.h"
+#include "metavision/sdk/base/utils/metrics_registry.h"
+#include "metavision/sdk/base/utils/sdk_log.h"
+#include "metavision/sdk/base/utils/trace.h"
 #include "metavision/sdk/core/utils/callback_manager.h"
 #include "metavision/sdk/driver/camera_error_code.h"
 #include "metavision/sdk/driver/internal/camera_error_code_internal.h"
@@ -47,9 +54,13 @@
 #include "metavision/sdk/core/utils/index_generator.h"
 #include "metavision/hal/device/device_discovery.h"
 #include "metavision/hal/facilities/i_trigger_out.h"
+#include "metavision/hal/utils/hal_exception.h"
+#include "metavision/hal/utils/ranged_read_backend.h"
+#include "metavision/hal/utils/striped_raw_file_writer.h"
 #include "metavision/sdk/driver/raw_data.h"
 #include "metavision/sdk/driver/internal/raw_data_internal.h"
 #include "metavision/sdk/driver/internal/camera_generation_internal.h"
+#include "metavision/sdk/driver/internal/replay_clock_internal.h"
 #include "metavision/sdk/driver/roi.h"
 #include "metavision/sdk/driver/trigger_out.h"
 #include "metavision/sdk/base/utils/timestamp.h"
@@ -57,6 +68,19 @@
 
 namespace Metavision {
 
+namespace {
+LatencyPercentiles to_latency_percentiles(const detail::LatencyStatistics &stats) {
+    LatencyPercentiles percentiles;
+    percentiles.p50_us  = stats.percentile(0.5) / 1000.;
+    percentiles.p90_us  = stats.percentile(0.9) / 1000.;
+    percentiles.p99_us  = stats.percentile(0.99) / 1000.;
+    percentiles.p999_us = stats.percentile(0.999) / 1000.;
+    percentiles.max_us  = stats.max_ns / 1000.;
+    percentiles.mean_us = stats.count > 0 ? stats.total_ns / (1000. * stats.count) : 0.;
+    return percentiles;
+}
+} // namespace
+
 // ********************
 // PIMPL
 Camera::Private::Private(bool empty_init) {
@@ -125,14 +149,28 @@ Camera::Private::Private(const std::string &rawfile, const RawFileConfig &file_s
     open_raw_file(rawfile, file_stream_config, reproduce_camera_behavior);
 }
 
+Camera::Private::Private(const std::vector<std::string> &rawfiles, const RawFileConfig &file_stream_config,
+                         bool reproduce_camera_behavior) {
+    open_raw_files(rawfiles, file_stream_config, reproduce_camera_behavior);
+}
+
 Camera::Private::~Private() {
     if (is_init_) {
         stop();
     }
+    remove_replay_clock_source();
+    if (metrics_registered_) {
+        MetricsRegistry::instance().remove(metrics_id_);
+    }
 }
 
 void Camera::Private::open_raw_file(const std::string &rawfile, const RawFileConfig &file_stream_config,
                                     bool reproduce_camera_behavior) {
+    open_raw_files({rawfile}, file_stream_config, reproduce_camera_behavior);
+}
+
+void Camera::Private::open_raw_files(const std::vector<std::string> &rawfiles, const RawFileConfig &file_stream_config,
+                                     bool reproduce_camera_behavior) {
     if (is_init_ && run_thread_.joinable()) {
         stop();
     }
@@ -140,23 +178,41 @@ void Camera::Private::open_raw_file(const std::string &rawfile, const RawFileCon
     is_init_              = true;
     detail::Config config = detail::Config();
 
-    if (!boost::filesystem::exists(rawfile)) {
-        throw CameraException(CameraErrorCode::FileDoesNotExist,
-                              "Opening RAW file at " + rawfile + ": not an existing file.");
+    if (rawfiles.empty()) {
+        throw CameraException(CameraErrorCode::InvalidArgument, "No RAW file to open.");
     }
 
-    if (!boost::filesystem::is_regular_file(rawfile)) {
-        throw CameraException(CameraErrorCode::NotARegularFile);
-    }
+    // Remote files (e.g. in object storage) are checked when opened by the HAL
+    bool is_remote = false;
+    for (const auto &rawfile : rawfiles) {
+        is_remote = RangedReadBackend::is_remote(rawfile);
+        if (!is_remote && !boost::filesystem::exists(rawfile)) {
+            throw CameraException(CameraErrorCode::FileDoesNotExist,
+                                  "Opening RAW file at " + rawfile + ": not an existing file.");
+        }
 
-    if (boost::filesystem::extension(rawfile) != ".raw") {
-        throw CameraException(CameraErrorCode::WrongExtension,
-                              "Expected .raw as extension for the provided input file " + rawfile + ".");
+        if (!is_remote && !boost::filesystem::is_regular_file(rawfile)) {
+            throw CameraException(CameraErrorCode::NotARegularFile);
+        }
+
+        // The manifest of a striped recording is read as a RAW file
+        if (boost::filesystem::extension(rawfile) != ".raw" && !StripedRawFileWriter::is_manifest(rawfile)) {
+            throw CameraException(CameraErrorCode::WrongExtension,
+                                  "Expected .raw as extension for the provided input file " + rawfile + ".");
+        }
     }
 
     raw_file_stream_config_ = file_stream_config;
 
-    device_ = DeviceDiscovery::open_raw_file(rawfile, raw_file_stream_config_);
+    const std::string &rawfile = rawfiles.front();
+    try {
+        device_ = DeviceDiscovery::open_raw_files(rawfiles, raw_file_stream_config_);
+    } catch (const HalException &e) {
+        if (!is_remote) {
+            throw;
+        }
+        throw CameraException(CameraErrorCode::FileDoesNotExist, "Opening RAW file at " + rawfile + ": " + e.what());
+    }
     if (!device_) {
         // We should never get here as open_raw_file should throw an exception if the system is unknown
         throw CameraException(CameraErrorCode::InvalidRawfile,
@@ -230,8 +286,22 @@ bool Camera::Private::start() {
             return false;
         }
 
-        camera_is_started_ = false;
-        run_thread_        = std::thread([this] {
+        {
+            std::lock_guard<std::mutex> start_lock(start_mutex_);
+            camera_is_started_     = false;
+            first_buffer_received_ = false;
+            run_ended_             = false;
+        }
+        {
+            std::lock_guard<std::mutex> latency_lock(latency_mutex_);
+            latency_storage_ = detail::OperationStoragePolicyHistogram();
+        }
+        add_replay_clock_source();
+        run_thread_ = std::thread([this, policy = run_thread_policy_] {
+            if (!apply_thread_policy(policy, "mv_camera")) {
+                MV_SDK_LOG_WARNING() << "Failed to apply the threading policy of the camera thread";
+            }
+            MV_TRACE_THREAD_NAME("mv_camera");
             if (print_timings_) {
                 run(timing_profiler_tuple_.get_profiler<true>());
             } else {
@@ -239,19 +309,19 @@ bool Camera::Private::start() {
             }
         });
 
-        // Be sure the thread has been launched to set is_running to true
-        // Thus, checking 'is_running()' right after start is expected to return true
-        // unless cases where the thread ends after one iteration (end of file already reached, camera unplugged ...)
-        while (!run_thread_.joinable()) {}
-
+        // is_running is set before the thread can run, so that checking 'is_running()' right after start is expected
+        // to return true unless cases where the thread ends after one iteration (end of file already reached, camera
+        // unplugged ...)
         set_is_running(true);
         run_thread_status_ = RunThreadStatus::STARTED;
     }
 
     // notifies the thread that it can start running
-    run_thread_cond_.notify_one();
+    run_thread_cond_.notify_all();
 
-    while (!camera_is_started_) {}
+    // waits for the source to be started by the thread
+    std::unique_lock<std::mutex> start_lock(start_mutex_);
+    start_cond_.wait(start_lock, [this]() { return camera_is_started_; });
 
     return true;
 }
@@ -269,6 +339,8 @@ bool Camera::Private::stop() {
     run_thread_status_ = RunThreadStatus::STOPPED;
 
     set_is_running(false);
+    // Wakes the run thread up if it is waiting for the other files replayed with the same clock
+    remove_replay_clock_source();
 
     i_events_stream_->stop();
     if (i_device_control_) {
@@ -288,6 +360,34 @@ bool Camera::Private::stop() {
     return true;
 }
 
+bool Camera::Private::pause() {
+    check_initialization();
+
+    std::lock_guard<std::mutex> lock(run_thread_mutex_);
+    if (!run_thread_.joinable() || i_events_stream_->is_paused()) {
+        return false;
+    }
+    i_events_stream_->pause();
+    return true;
+}
+
+bool Camera::Private::resume() {
+    check_initialization();
+
+    std::lock_guard<std::mutex> lock(run_thread_mutex_);
+    if (!run_thread_.joinable() || !i_events_stream_->is_paused()) {
+        return false;
+    }
+    // The time spent paused must not be caught up when emulating real time
+    resync_clocks_ = true;
+    i_events_stream_->resume();
+    return true;
+}
+
+bool Camera::Private::is_paused() const {
+    return is_running_ && i_events_stream_ && i_events_stream_->is_paused();
+}
+
 void Camera::Private::start_recording(const std::string &rawfile_path) {
     check_camera_device_instance();
     check_events_stream_instance();
@@ -300,7 +400,10 @@ void Camera::Private::start_recording(const std::string &rawfile_path) {
         biases_->save_to_file(base_path + ".bias");
     }
 
-    if (!i_events_stream_->log_raw_data(base_path + ".raw")) {
+    // When subsampling the decoding, the data is recorded by the data transfer thread, which must not wait for the disk
+    const bool opened = decoding_subsampling_ == 1 ? i_events_stream_->log_raw_data(base_path + ".raw") :
+                                                     i_events_stream_->log_raw_data_async(base_path + ".raw");
+    if (!opened) {
         throw CameraException(
             CameraErrorCode::CouldNotOpenFile,
             "Could not open file '" + base_path +
@@ -316,6 +419,98 @@ void Camera::Private::stop_recording() {
     is_recording_ = false;
 }
 
+void Camera::Private::set_thread_policy(const ThreadPolicy &policy) {
+    check_events_stream_instance();
+    std::lock_guard<std::mutex> lock(run_thread_mutex_);
+    run_thread_policy_ = policy;
+    i_events_stream_->set_thread_policy(policy);
+}
+
+void Camera::Private::set_performance_profile(PerformanceProfile profile) {
+    check_events_stream_instance();
+    std::lock_guard<std::mutex> lock(run_thread_mutex_);
+    if (run_thread_.joinable()) {
+        throw CameraException(CameraErrorCode::RuntimeError,
+                              "The performance profile can not be changed while the camera is running.");
+    }
+    apply_performance_profile(*device_, profile);
+    performance_profile_      = profile;
+    replay_batch_duration_us_ = get_performance_settings(profile).replay_batch_duration_us;
+}
+
+void Camera::Private::set_decoding_subsampling(uint32_t n) {
+    check_events_stream_instance();
+    std::lock_guard<std::mutex> lock(run_thread_mutex_);
+    if (run_thread_.joinable()) {
+        throw CameraException(CameraErrorCode::RuntimeError,
+                              "The decoding subsampling can not be changed while the camera is running.");
+    }
+    i_events_stream_->set_delivery_subsampling(n);
+    decoding_subsampling_ = n;
+}
+
+void Camera::Private::enable_callback_pipelining(bool enable) {
+    check_events_stream_instance();
+    std::lock_guard<std::mutex> lock(run_thread_mutex_);
+    if (run_thread_.joinable()) {
+        throw CameraException(CameraErrorCode::RuntimeError,
+                              "The callback pipelining can not be changed while the camera is running.");
+    }
+    callback_pipelining_ = enable;
+}
+
+void Camera::Private::enable_latency_statistics(bool enable) {
+    latency_statistics_enabled_ = enable;
+}
+
+CameraLatencyStatistics Camera::Private::get_latency_statistics() const {
+    std::lock_guard<std::mutex> lock(latency_mutex_);
+    CameraLatencyStatistics stats;
+    const auto transfer_to_callback = latency_storage_.get_latency_statistics("TransferToCallback");
+    const auto sensor_to_callback   = latency_storage_.get_latency_statistics("SensorToCallback");
+    stats.num_buffers               = transfer_to_callback.count;
+    stats.transfer_to_callback      = to_latency_percentiles(transfer_to_callback);
+    stats.sensor_to_callback        = to_latency_percentiles(sensor_to_callback);
+    return stats;
+}
+
+void Camera::Private::register_metrics(const std::string &name) {
+    if (metrics_registered_.exchange(true)) {
+        MetricsRegistry::instance().remove(metrics_id_);
+    }
+    metrics_id_ = MetricsRegistry::instance().add([this, name](std::vector<MetricSample> &samples) {
+        using Type = MetricSample::Type;
+        auto add   = [&](const char *metric, const char *help, Type type, double value, const char *event_type) {
+            std::vector<std::pair<std::string, std::string>> labels{{"camera", name}};
+            if (event_type) {
+                labels.emplace_back("type", event_type);
+            }
+            samples.push_back({metric, help, type, std::move(labels), value});
+        };
+        const char *events_help = "Number of events decoded by the camera";
+        add("metavision_camera_events_total", events_help, Type::Counter,
+            static_cast<double>(num_cd_events_.load(std::memory_order_relaxed)), "cd");
+        if (ext_trigger_) {
+            add("metavision_camera_events_total", events_help, Type::Counter,
+                static_cast<double>(num_ext_trigger_events_.load(std::memory_order_relaxed)), "ext_trigger");
+        }
+        add("metavision_camera_bytes_total", "Number of bytes of RAW data processed by the camera", Type::Counter,
+            static_cast<double>(num_bytes_.load(std::memory_order_relaxed)), nullptr);
+        add("metavision_camera_buffers_total", "Number of buffers of RAW data processed by the camera", Type::Counter,
+            static_cast<double>(num_buffers_.load(std::memory_order_relaxed)), nullptr);
+        add("metavision_camera_decode_seconds_total", "Time spent decoding the buffers of RAW data", Type::Counter,
+            decode_time_ns_.load(std::memory_order_relaxed) / 1e9, nullptr);
+        if (i_events_stream_) {
+            const auto buffering = i_events_stream_->get_buffering_statistics();
+            add("metavision_camera_backlog", "Number of buffers of RAW data waiting to be decoded", Type::Gauge,
+                static_cast<double>(i_events_stream_->get_backlog()), nullptr);
+            add("metavision_camera_dropped_total",
+                "Number of times the data transfer had no buffer to transfer data into, live data may be lost",
+                Type::Counter, static_cast<double>(buffering.drops), nullptr);
+        }
+    });
+}
+
 Biases &Camera::Private::biases() {
     if (from_file_) {
         throw CameraException(UnsupportedFeatureErrors::BiasesUnavailable, "Cannot get biases from a file.");
@@ -478,8 +673,11 @@ void Camera::Private::init_callbacks() {
         throw CameraException(InternalInitializationErrors::ICDDecoderNotFound);
     }
     i_cd_events_decoder->add_event_buffer_callback([this](const EventCD *begin, const EventCD *end) {
-        for (auto &&cb : cd_->get_pimpl().get_cbs()) {
-            cb(begin, end);
+        num_cd_events_.fetch_add(std::distance(begin, end), std::memory_order_relaxed);
+        if (decoding_batch_) {
+            decoding_batch_->add_cd_events(begin, end);
+        } else {
+            cd_->get_pimpl()(begin, end);
         }
     });
 
@@ -490,8 +688,11 @@ void Camera::Private::init_callbacks() {
         ext_trigger_.reset(ExtTrigger::Private::build(index_manager_));
         i_ext_trigger_events_decoder->add_event_buffer_callback(
             [this](const EventExtTrigger *begin, const EventExtTrigger *end) {
-                for (auto &&cb : ext_trigger_->get_pimpl().get_cbs()) {
-                    cb(begin, end);
+                num_ext_trigger_events_.fetch_add(std::distance(begin, end), std::memory_order_relaxed);
+                if (decoding_batch_) {
+                    decoding_batch_->add_ext_trigger_events(begin, end);
+                } else {
+                    ext_trigger_->get_pimpl()(begin, end);
                 }
             });
     }
@@ -507,7 +708,7 @@ void Camera::Private::run(TimingProfilerType *profiler) {
     }
 
     // notifies that this thread can now be stopped if needed
-    run_thread_cond_.notify_one();
+    run_thread_cond_.notify_all();
 
     check_camera_device_instance();
     check_events_stream_instance();
@@ -524,111 +725,318 @@ void Camera::Private::run(TimingProfilerType *profiler) {
 
 template<typename TimingProfilerType>
 int Camera::Private::run_main_loop(TimingProfilerType *profiler) {
-    camera_is_started_ = true;
+    notify_camera_started();
 
-    int res             = 0;
-    long int n_rawbytes = 0;
+    int res                    = 0;
+    long int n_rawbytes        = 0;
+    bool first_buffer_received = false;
+    // The buffers do not follow each other when subsampling the decoding, except for the first one
+    const bool subsampled      = decoding_subsampling_ > 1;
+    bool resync                = false;
 
     init_clocks();
+    init_latency_statistics();
+    if (callback_pipelining_ && !emulate_real_time_) {
+        callback_pipeline_.reset(
+            new CallbackPipeline([this](const CallbackPipeline::Batch &batch) { dispatch_batch(batch); },
+                                 run_thread_policy_));
+    }
 
+    const auto polling_op_id    = profiler->intern("Polling");
+    const auto processing_op_id = profiler->intern("Processing");
     while (is_running_) {
         {
-            typename TimingProfilerType::TimedOperation t("Polling", profiler);
+            typename TimingProfilerType::TimedOperation t(polling_op_id, profiler);
             res = i_events_stream_->wait_next_buffer();
         }
 
         if (res < 0) {
             break;
         } else if (res > 0) {
-            typename TimingProfilerType::TimedOperation t("Processing", profiler);
+            if (resync_clocks_.exchange(false)) {
+                init_clocks();
+            }
+            if (!first_buffer_received) {
+                notify_first_buffer();
+                first_buffer_received = true;
+            }
+            typename TimingProfilerType::TimedOperation t(processing_op_id, profiler);
+            MV_TRACE_SCOPE("Camera::dispatch_callbacks");
             I_EventsStream::RawData *ev_buffer = i_events_stream_->get_latest_raw_data(n_rawbytes);
+            if (resync) {
+                resync_decoding(ev_buffer, n_rawbytes);
+            }
+            resync = subsampled;
 
+            const size_t n_events = n_rawbytes / i_decoder_->get_raw_event_size_bytes();
+            bool decoded          = true;
+            num_bytes_.fetch_add(n_rawbytes, std::memory_order_relaxed);
+            num_buffers_.fetch_add(1, std::memory_order_relaxed);
             if (emulate_real_time_) {
                 emulate_real_time(ev_buffer, n_rawbytes);
-                t.setNumProcessedElements(n_rawbytes / i_decoder_->get_raw_event_size_bytes());
+                t.setNumProcessedElements(n_events);
             } else {
+                // When pipelined, the events and the RAW data are stored in a batch, waiting for the callbacks to be
+                // done with the batch before the previous one
+                if (callback_pipeline_) {
+                    decoding_batch_ = callback_pipeline_->acquire();
+                }
                 // we first decode the buffer and call the corresponding events callback ...
-                if (index_manager_.counter_map_.tag_count(CallbackTagIds::DECODE_CALLBACK_TAG_ID)) {
+                decoded = index_manager_.counter_map_.tag_count(CallbackTagIds::DECODE_CALLBACK_TAG_ID) != 0;
+                if (decoded) {
+                    // The decoding is only timed for the metrics, to save the clock reads otherwise
+                    const bool timed = metrics_registered_.load(std::memory_order_relaxed);
+                    const auto decode_start =
+                        timed ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
                     i_decoder_->decode(ev_buffer, ev_buffer + n_rawbytes);
-                    t.setNumProcessedElements(n_rawbytes / i_decoder_->get_raw_event_size_bytes());
+                    if (timed) {
+                        const auto decode_time = std::chrono::steady_clock::now() - decode_start;
+                        decode_time_ns_.fetch_add(
+                            std::chrono::duration_cast<std::chrono::nanoseconds>(decode_time).count(),
+                            std::memory_order_relaxed);
+                    }
+                    t.setNumProcessedElements(n_events);
                 }
                 // ... then we call the raw buffer callback so that a user have access to some info (e.g last decoded
                 // timestamp) when the raw callback is called
-                for (auto &cb : raw_data_->get_pimpl().get_cbs()) {
-                    cb(ev_buffer, n_rawbytes);
+                if (!decoding_batch_) {
+                    MV_TRACE_SCOPE("Camera::raw_data_callbacks");
+                    raw_data_->get_pimpl()(ev_buffer, n_rawbytes);
+                } else if (index_manager_.counter_map_.tag_count(CallbackTagIds::RAW_CALLBACK_TAG_ID) != 0) {
+                    decoding_batch_->raw_data.assign(ev_buffer, ev_buffer + n_rawbytes);
+                    decoding_batch_->has_raw_data = true;
                 }
             }
+
+            if (!from_file_ && decoded && n_rawbytes > 0) {
+                correlate_clocks();
+            }
+            if (decoding_batch_) {
+                decoding_batch_->n_bytes      = n_rawbytes;
+                decoding_batch_->n_events     = n_events;
+                decoding_batch_->decoded      = decoded;
+                decoding_batch_->last_ts      = i_decoder_->get_last_timestamp();
+                decoding_batch_->arrival_time = i_events_stream_->get_latest_raw_data_arrival_time();
+                callback_pipeline_->push(std::move(decoding_batch_));
+            } else if (latency_statistics_enabled_.load(std::memory_order_relaxed) && n_rawbytes > 0) {
+                record_latency(n_events, decoded, i_events_stream_->get_latest_raw_data_arrival_time(),
+                               i_decoder_->get_last_timestamp());
+            }
         }
     }
 
+    // The callbacks are called with the batches already decoded before the run ends
+    callback_pipeline_.reset();
+
     return res;
 }
 
+void Camera::Private::resync_decoding(I_EventsStream::RawData *&ev_buffer, long &n_rawbytes) {
+    // The data skipped since the last buffer decoded is not known to the decoder, whose state is reset to decode the
+    // buffer from its first resync point. Buffers without any are decoded as they are.
+    I_EventsStream::RawData *const ev_buffer_end = ev_buffer + n_rawbytes;
+    const I_EventsStream::RawData *resync_point  = i_decoder_->find_resync_point(ev_buffer, ev_buffer_end);
+    if (resync_point != ev_buffer_end && i_decoder_->reset_last_timestamp(i_decoder_->get_last_timestamp())) {
+        const long n_skipped_bytes = static_cast<long>(resync_point - ev_buffer);
+        ev_buffer += n_skipped_bytes;
+        n_rawbytes -= n_skipped_bytes;
+    }
+}
+
 void Camera::Private::init_clocks() {
     first_ts_       = i_decoder_->get_last_timestamp();
     first_ts_clock_ = 0;
 }
 
-void Camera::Private::emulate_real_time(I_EventsStream::RawData *ev_buffer, long n_rawbytes) {
-    // when reading from a file, we read a huge chunk of data to avoid overhead of reading small
-    // buffers. To emulate real time, we handle buffer of events of smaller
-    // (arbitrary) size, closer to the size of a buffer normally sent by the camera, to avoid huge
-    // latency and so that the real time emulation feels more natural
+void Camera::Private::init_latency_statistics() {
+    transfer_to_callback_id_ = latency_storage_.intern("TransferToCallback");
+    sensor_to_callback_id_   = latency_storage_.intern("SensorToCallback");
+    clock_correlator_.reset();
+}
 
-    // This is here to show that when reading speed will be featured, this
-    // will affect the quantity of events decoded at a time to have a
-    // smooth cadencing. The slower the cadencing, the lesser events you want to decode at a time.
-    constexpr double reading_speed_factor = 1.;
+void Camera::Private::correlate_clocks() {
+    // The last event of a buffer was generated before the buffer arrived on the host
+    const auto arrival_time = i_events_stream_->get_latest_raw_data_arrival_time();
+    clock_correlator_.add_sample(
+        i_decoder_->get_last_timestamp(),
+        std::chrono::duration_cast<std::chrono::microseconds>(arrival_time.time_since_epoch()).count());
+}
 
-    // Reference number of events to decode at a time at real time speed (i.e. 1.)
-    constexpr uint32_t events_per_buffer_to_decode = 1024;
+void Camera::Private::record_latency(size_t n_events, bool decoded,
+                                     const std::chrono::steady_clock::time_point &arrival_time, timestamp last_ts) {
+    using namespace std::chrono;
+    const auto now = steady_clock::now();
+    latency_storage_.insert(transfer_to_callback_id_, n_events, detail::CpuTimes(now - arrival_time));
 
-    // Reference minimum number of events to decode at a time
-    constexpr uint32_t min_events_per_buffer_to_decode = 128;
+    if (from_file_ || !decoded) {
+        return;
+    }
 
-    I_EventsStream::RawData *ev_buffer_ref       = ev_buffer;
-    I_EventsStream::RawData *const ev_buffer_end = ev_buffer + n_rawbytes;
+    // The device clock is related to the host clock by the correlation of the arrival times of the buffers with the
+    // timestamps of their last event, i.e. assuming the fastest buffers were transferred instantly
+    const int64_t generation_time_us = clock_correlator_.get_correlation().to_host_time_us(last_ts);
+    const int64_t now_us             = duration_cast<microseconds>(now.time_since_epoch()).count();
+    latency_storage_.insert(sensor_to_callback_id_, n_events,
+                            detail::CpuTimes(microseconds(now_us - generation_time_us)));
+}
+
+void Camera::Private::dispatch_batch(const CallbackPipeline::Batch &batch) {
+    MV_TRACE_SCOPE("Camera::dispatch_batch");
+    const EventCD *cd_events                  = batch.cd_events.data();
+    const EventExtTrigger *ext_trigger_events = batch.ext_trigger_events.data();
+    for (const auto &call : batch.calls) {
+        if (call.first == CallbackPipeline::Batch::EventType::CD) {
+            cd_->get_pimpl()(cd_events, cd_events + call.second);
+            cd_events += call.second;
+        } else {
+            ext_trigger_->get_pimpl()(ext_trigger_events, ext_trigger_events + call.second);
+            ext_trigger_events += call.second;
+        }
+    }
+    if (batch.has_raw_data) {
+        raw_data_->get_pimpl()(batch.raw_data.data(), batch.raw_data.size());
+    }
+    if (latency_statistics_enabled_.load(std::memory_order_relaxed) && batch.n_bytes > 0) {
+        record_latency(batch.n_events, batch.decoded, batch.arrival_time, batch.last_ts);
+    }
+}
+
+void Camera::Private::emulate_real_time(I_EventsStream::RawData *ev_buffer, long n_rawbytes) {
+    if (replay_config_.clock) {
+        replay_with_clock(ev_buffer, n_rawbytes);
+        return;
+    }
 
-    // Computes the number of bytes per sub buffer to decode from the polled raw buffer
-    const uint32_t bytes_step_to_decode =
-        std::max(min_events_per_buffer_to_decode,
-                 i_decoder_->get_raw_event_size_bytes() *
-                     static_cast<uint32_t>(std::round(events_per_buffer_to_decode * reading_speed_factor)));
+    // when reading from a file, we read a huge chunk of data to avoid overhead of reading small
+    // buffers. To emulate real time, we decode the data in batches, so that the events are available
+    // regularly, as when they are sent by the camera, and the real time emulation feels natural.
+    // Each batch is decoded up to the timestamp of the next wall clock deadline, so that it spans about the same wall
+    // clock time whatever the rate of the events and the reading speed.
 
-    long bytes_to_decode;
+    const double speed_factor                    = replay_config_.speed_factor;
+    const bool skip_hidden_data                  = replay_config_.display_period_us > 0 && speed_factor > 1.;
+    I_EventsStream::RawData *const ev_buffer_end = ev_buffer + n_rawbytes;
 
-    // Decode each sub buffer and cadence depending on the reading speed.
-    for (; ev_buffer < ev_buffer_end && is_running_; ev_buffer += bytes_to_decode) {
-        const uint32_t remains = std::distance(ev_buffer, ev_buffer_end);
-        bytes_to_decode        = std::min(remains, bytes_step_to_decode);
+    // Decode each batch and cadence depending on the reading speed.
+    while (ev_buffer < ev_buffer_end && is_running_) {
+        // Until the clocks are synchronized on the first timestamp, the data is decoded until the time moves
+        timestamp ts_limit = i_decoder_->get_last_timestamp() + 1;
+        if (first_ts_clock_ != 0) {
+            const uint64_t deadline_clock = get_system_time_us() + replay_batch_duration_us_;
+            ts_limit = first_ts_ + static_cast<timestamp>((deadline_clock - first_ts_clock_) * speed_factor);
+        }
 
         // we first decode the buffer and call the corresponding events callback ...
-        i_decoder_->decode(ev_buffer, ev_buffer + bytes_to_decode);
+        const long bytes_decoded = i_decoder_->decode_until(ev_buffer, ev_buffer_end, ts_limit);
 
         // ... then we call the raw buffer callback with the same subset of data that was decoded, so that a user have
         // access to some info (e.g last decoded timestamp) when the raw callback is called
-        for (auto &cb : raw_data_->get_pimpl().get_cbs()) {
-            cb(ev_buffer, bytes_to_decode);
-        }
-
-        const timestamp cur_ts      = i_decoder_->get_last_timestamp();
-        const uint64_t cur_ts_clock = get_system_time_us();
+        raw_data_->get_pimpl()(ev_buffer, bytes_decoded);
+        ev_buffer += bytes_decoded;
 
         // compute the offset first, if never done
+        const timestamp cur_ts = i_decoder_->get_last_timestamp();
         if (first_ts_clock_ == 0 && cur_ts != first_ts_) {
-            first_ts_clock_ = cur_ts_clock;
-            first_ts_       = cur_ts;
+            first_ts_clock_  = get_system_time_us();
+            first_ts_        = cur_ts;
+            next_display_ts_ = first_ts_ + static_cast<timestamp>(replay_config_.display_period_us * speed_factor);
         }
 
-        const timestamp diff       = (1 / reading_speed_factor) * (cur_ts - first_ts_);
-        const uint64_t expected_ts = first_ts_clock_ + diff;
+        wait_until(first_ts_clock_ + static_cast<uint64_t>((cur_ts - first_ts_) / speed_factor));
 
-        if (cur_ts_clock < expected_ts) {
-            std::this_thread::sleep_for(std::chrono::microseconds(expected_ts - cur_ts_clock));
+        // The rest of the buffer is dropped when the reading moves forward
+        if (skip_hidden_data && skip_to_display_window(cur_ts)) {
+            return;
         }
     }
 }
 
+void Camera::Private::replay_with_clock(I_EventsStream::RawData *ev_buffer, long n_rawbytes) {
+    // The data is decoded in batches as when following the wall clock on its own (see emulate_real_time), up to the
+    // limits given by the clock shared with the other files
+    ReplayClock::Private &clock                  = replay_config_.clock->get_pimpl();
+    I_EventsStream::RawData *const ev_buffer_end = ev_buffer + n_rawbytes;
+    while (ev_buffer < ev_buffer_end && is_running_) {
+        // Until the first timestamp of the file is known, the data is decoded until the time moves
+        const timestamp ts_limit = replay_clock_source_started_ ? clock.get_ts_limit(replay_clock_source_) :
+                                                                  i_decoder_->get_last_timestamp() + 1;
+        const long bytes_decoded = i_decoder_->decode_until(ev_buffer, ev_buffer_end, ts_limit);
+        raw_data_->get_pimpl()(ev_buffer, bytes_decoded);
+        ev_buffer += bytes_decoded;
+
+        const timestamp cur_ts = i_decoder_->get_last_timestamp();
+        if (!replay_clock_source_started_) {
+            if (cur_ts != first_ts_) {
+                // Waits for the first timestamps of the other files
+                if (!clock.start_source(replay_clock_source_, cur_ts)) {
+                    return;
+                }
+                replay_clock_source_started_ = true;
+            }
+        } else if (ev_buffer < ev_buffer_end && !clock.wait(replay_clock_source_, ts_limit)) {
+            // The limit has been reached before the end of the buffer, and the camera has been stopped meanwhile
+            return;
+        }
+    }
+}
+
+void Camera::Private::add_replay_clock_source() {
+    if (replay_config_.clock && emulate_real_time_ && !replay_clock_source_added_) {
+        replay_clock_source_         = replay_config_.clock->get_pimpl().add_source();
+        replay_clock_source_added_   = true;
+        replay_clock_source_started_ = false;
+    }
+}
+
+void Camera::Private::remove_replay_clock_source() {
+    if (replay_clock_source_added_) {
+        replay_config_.clock->get_pimpl().remove_source(replay_clock_source_);
+        replay_clock_source_added_ = false;
+    }
+}
+
+void Camera::Private::wait_until(uint64_t time_us) const {
+    // Sleeping is only accurate to the scheduler's granularity: the thread sleeps until shortly before the time, then
+    // yields until it is reached
+    constexpr uint64_t spin_duration_us = 1000;
+
+    uint64_t now_us = get_system_time_us();
+    if (now_us + spin_duration_us < time_us) {
+        std::this_thread::sleep_for(std::chrono::microseconds(time_us - now_us - spin_duration_us));
+        now_us = get_system_time_us();
+    }
+    while (now_us < time_us && is_running_) {
+        std::this_thread::yield();
+        now_us = get_system_time_us();
+    }
+}
+
+bool Camera::Private::skip_to_display_window(timestamp cur_ts) {
+    // The timestamps of a file replayed in a loop are not those of the index once it has looped
+    if (first_ts_clock_ == 0 || replay_config_.loop) {
+        return false;
+    }
+
+    // Finds the next refresh of the display whose window has not been decoded yet
+    const timestamp display_period_ts =
+        std::max<timestamp>(1, static_cast<timestamp>(replay_config_.display_period_us * replay_config_.speed_factor));
+    while (next_display_ts_ <= cur_ts) {
+        next_display_ts_ += display_period_ts;
+    }
+
+    // The reading moves to the last entry of the index of the file before the window, so it is only worth it if the
+    // window starts more than a period of the index ahead
+    const auto index = i_events_stream_->get_raw_file_index();
+    if (!index || index->empty()) {
+        return false;
+    }
+    const timestamp window_begin_ts = next_display_ts_ - replay_config_.display_window_us;
+    if (window_begin_ts - cur_ts <= index->get_period()) {
+        return false;
+    }
+    return i_events_stream_->seek(window_begin_ts, *i_decoder_);
+}
+
 template<typename TimingProfilerType>
 int Camera::Private::run_from_camera(TimingProfilerType *profiler) {
     check_ccam_instance();
@@ -672,6 +1080,34 @@ void Camera::Private::set_is_running(bool is_running) {
     }
 }
 
+void Camera::Private::notify_camera_started() {
+    {
+        std::lock_guard<std::mutex> lock(start_mutex_);
+        camera_is_started_ = true;
+    }
+    start_cond_.notify_all();
+}
+
+void Camera::Private::notify_first_buffer() {
+    {
+        std::lock_guard<std::mutex> lock(start_mutex_);
+        first_buffer_received_ = true;
+        first_buffer_time_     = std::chrono::steady_clock::now();
+    }
+    start_cond_.notify_all();
+}
+
+bool Camera::Private::wait_first_buffer(const std::chrono::steady_clock::time_point &deadline,
+                                        std::chrono::steady_clock::time_point &first_buffer_time) {
+    std::unique_lock<std::mutex> lock(start_mutex_);
+    start_cond_.wait_until(lock, deadline, [this]() { return first_buffer_received_ || run_ended_; });
+    if (!first_buffer_received_) {
+        return false;
+    }
+    first_buffer_time = first_buffer_time_;
+    return true;
+}
+
 void Camera::Private::end_run(int run_output) {
     if (run_output == -1) {
         std::map<CallbackId, RuntimeErrorCallback> callbacks_to_call;
@@ -685,6 +1121,16 @@ void Camera::Private::end_run(int run_output) {
     }
 
     set_is_running(false);
+    // The end of the file does not hold back the other files replayed with the same clock
+    remove_replay_clock_source();
+
+    {
+        std::lock_guard<std::mutex> lock(start_mutex_);
+        // also releases start() if the source stopped before the main loop was reached
+        camera_is_started_ = true;
+        run_ended_         = true;
+    }
+    start_cond_.notify_all();
 }
 
 void Camera::Private::check_initialization() const {
@@ -734,11 +1180,14 @@ void Camera::Private::check_decoder_device_instance() const {
 AvailableSourcesList Camera::list_online_sources() {
     AvailableSourcesList ret;
 
+    // Get only remote sources, while the connected ones are listed
+    auto remote_systems_future =
+        std::async(std::launch::async, []() { return DeviceDiscovery::list_available_sources_remote(); });
+
     // Get Connected (mipi, usb) available sources
     DeviceDiscovery::SystemList available_systems = DeviceDiscovery::list_available_sources_local();
 
-    // Get only remote sources
-    DeviceDiscovery::SystemList available_remote_systems = DeviceDiscovery::list_available_sources_remote();
+    DeviceDiscovery::SystemList available_remote_systems = remote_systems_future.get();
 
     // First, scan remote sources :
     for (auto system : available_remote_systems) {
@@ -801,13 +1250,45 @@ Camera Camera::from_serial(const std::string &serial) {
 
 Camera Camera::from_file(const std::string &rawfile, bool reproduce_camera_behavior) {
     RawFileConfig config;
+    if (!reproduce_camera_behavior) {
+        // When reading as fast as possible, keep several reads in flight so that fast storage devices are saturated
+        config.n_reads_in_flight_ = 4;
+        config.n_read_buffers_    = config.n_reads_in_flight_ + 2;
+    }
     return Camera(new Private(rawfile, config, reproduce_camera_behavior));
 }
 
+Camera Camera::from_files(const std::vector<std::string> &rawfiles, bool reproduce_camera_behavior) {
+    return Camera(new Private(rawfiles, RawFileConfig(), reproduce_camera_behavior));
+}
+
+Camera Camera::from_file(const std::string &rawfile, const FileReplayConfig &replay_config) {
+    if (!replay_config.clock && !(replay_config.speed_factor >= 0.1 && replay_config.speed_factor <= 100.)) {
+        throw CameraException(CameraErrorCode::InvalidArgument,
+                              "The speed factor of the replay of a RAW file must be between 0.1 and 100.");
+    }
+    if (replay_config.display_period_us > 0 && replay_config.display_window_us == 0) {
+        throw CameraException(CameraErrorCode::InvalidArgument,
+                              "The display window of the replay of a RAW file can not be empty when the display is "
+                              "refreshed periodically.");
+    }
+
+    RawFileConfig config;
+    // The data is skipped by seeking in the file, which requires its index
+    config.build_index_ = replay_config.display_period_us > 0 && replay_config.speed_factor > 1. &&
+                          !replay_config.loop && !replay_config.clock;
+    config.loop_                = replay_config.loop;
+    config.performance_profile_ = replay_config.performance_profile;
+    Camera camera(new Private(rawfile, config, true));
+    camera.pimpl_->replay_config_ = replay_config;
+    camera.set_performance_profile(replay_config.performance_profile);
+    return camera;
+}
+
 bool Camera::synchronize_and_start_cameras(Camera &master, Camera &slave) {
     throw CameraException(
         CameraErrorCode::DeprecatedFeature,
-        "Cameras synchronization not available with Metavision SDK Driver. Use Metavision HAL instead.");
+        "Cameras synchronization is not available with this function anymore. Use Metavision::CameraGroup instead.");
 }
 
 RawData &Camera::raw_data() {
@@ -915,6 +1396,43 @@ bool Camera::start() {
     return pimpl_->start();
 }
 
+std::vector<CameraStartReport> Camera::start_all(const std::vector<Camera *> &cameras,
+                                                 uint32_t first_buffer_timeout_ms) {
+    const auto start_time = std::chrono::steady_clock::now();
+
+    // Starting a device may take a while, they are hence all started concurrently
+    std::vector<std::future<bool>> starts;
+    for (auto camera : cameras) {
+        starts.emplace_back(std::async(std::launch::async, [camera]() { return camera->start(); }));
+    }
+
+    std::vector<CameraStartReport> reports(cameras.size());
+    std::exception_ptr exception;
+    for (size_t i = 0; i < starts.size(); ++i) {
+        try {
+            reports[i].started = starts[i].get();
+        } catch (...) {
+            if (!exception) {
+                exception = std::current_exception();
+            }
+        }
+    }
+    if (exception) {
+        std::rethrow_exception(exception);
+    }
+
+    const auto deadline = start_time + std::chrono::milliseconds(first_buffer_timeout_ms);
+    for (size_t i = 0; i < cameras.size(); ++i) {
+        std::chrono::steady_clock::time_point first_buffer_time;
+        if (reports[i].started && cameras[i]->pimpl_->wait_first_buffer(deadline, first_buffer_time)) {
+            reports[i].time_to_first_buffer_us =
+                std::chrono::duration_cast<std::chrono::microseconds>(first_buffer_time - start_time).count();
+        }
+    }
+
+    return reports;
+}
+
 bool Camera::is_running() {
     return pimpl_->is_running_;
 }
@@ -923,6 +1441,18 @@ bool Camera::stop() {
     return pimpl_->stop();
 }
 
+bool Camera::pause() {
+    return pimpl_->pause();
+}
+
+bool Camera::resume() {
+    return pimpl_->resume();
+}
+
+bool Camera::is_paused() {
+    return pimpl_->is_paused();
+}
+
 void Camera::start_recording(const std::string &rawfile_path) {
     pimpl_->start_recording(rawfile_path);
 }
@@ -931,6 +1461,50 @@ void Camera::stop_recording() {
     pimpl_->stop_recording();
 }
 
+void Camera::set_thread_policy(const ThreadPolicy &policy) {
+    pimpl_->set_thread_policy(policy);
+}
+
+void Camera::set_performance_profile(PerformanceProfile profile) {
+    pimpl_->set_performance_profile(profile);
+}
+
+PerformanceProfile Camera::get_performance_profile() const {
+    return pimpl_->performance_profile_;
+}
+
+void Camera::set_decoding_subsampling(uint32_t n) {
+    pimpl_->set_decoding_subsampling(n);
+}
+
+uint32_t Camera::get_decoding_subsampling() const {
+    return pimpl_->decoding_subsampling_;
+}
+
+void Camera::enable_callback_pipelining(bool enable) {
+    pimpl_->enable_callback_pipelining(enable);
+}
+
+bool Camera::is_callback_pipelining_enabled() const {
+    return pimpl_->callback_pipelining_;
+}
+
+void Camera::enable_latency_statistics(bool enable) {
+    pimpl_->enable_latency_statistics(enable);
+}
+
+CameraLatencyStatistics Camera::get_latency_statistics() const {
+    return pimpl_->get_latency_statistics();
+}
+
+void Camera::register_metrics(const std::string &name) {
+    pimpl_->register_metrics(name);
+}
+
+ClockCorrelation Camera::get_clock_correlation() const {
+    return pimpl_->clock_correlator_.get_correlation();
+}
+
 const CameraConfiguration &Camera::get_camera_configuration() {
     return pimpl_->camera_configuration_;
 }
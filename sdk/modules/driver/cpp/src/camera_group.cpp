@@ -0,0 +1,186 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <limits>
+#include <string>
+
+#include "metavision/hal/facilities/i_decoder.h"
+#include "metavision/hal/facilities/i_device_control.h"
+#include "metavision/sdk/driver/camera_group.h"
+#include "metavision/sdk/driver/camera_exception.h"
+#include "metavision/sdk/driver/camera_error_code.h"
+#include "metavision/sdk/driver/internal/event_stream_merger.h"
+
+namespace Metavision {
+
+class CameraGroup::Private {
+public:
+    Private(std::vector<Camera> &&cameras, const CameraGroupConfig &config) :
+        cameras_(std::move(cameras)),
+        config_(config),
+        merger_(cameras_.size(), config.max_skew_us, config.align_first_events) {
+        if (cameras_.empty()) {
+            throw CameraException(CameraErrorCode::InvalidArgument, "A camera group needs at least one camera.");
+        }
+        if (cameras_.size() > static_cast<size_t>(std::numeric_limits<std::uint16_t>::max()) + 1) {
+            throw CameraException(CameraErrorCode::InvalidArgument, "Too many cameras in the group.");
+        }
+        if (config_.synchronize) {
+            synchronize();
+        }
+
+        for (size_t i = 0; i < cameras_.size(); ++i) {
+            Camera &camera = cameras_[i];
+            camera.cd().add_callback(
+                [this, i](const EventCD *begin, const EventCD *end) { merger_.add_events(i, begin, end); });
+            // Lets the other cameras advance when this one has no event
+            I_Decoder *decoder = camera.get_device().get_facility<I_Decoder>();
+            if (decoder) {
+                decoder->add_time_callback([this, i](timestamp ts) { merger_.advance_time(i, ts); });
+            }
+            // A camera stopped by the user, or at the end of a recording, is not waited for anymore
+            camera.add_status_change_callback([this, i](const CameraStatus &status) {
+                if (status == CameraStatus::STOPPED) {
+                    merger_.close_source(i);
+                }
+            });
+        }
+    }
+
+    ~Private() {
+        stop();
+    }
+
+    std::vector<CameraStartReport> start() {
+        if (!is_running()) {
+            merger_.reset();
+        }
+        if (!config_.synchronize || cameras_.size() == 1) {
+            return Camera::start_all(camera_pointers(0, cameras_.size()), config_.first_buffer_timeout_ms);
+        }
+
+        // The slaves wait for the clock of the master, which must hence be started last. They do not receive any data
+        // before, so that their first buffer is only waited for with the master's
+        auto slave_reports  = Camera::start_all(camera_pointers(1, cameras_.size()), 0);
+        auto master_reports = Camera::start_all(camera_pointers(0, 1), config_.first_buffer_timeout_ms);
+
+        std::vector<CameraStartReport> reports{master_reports[0]};
+        reports.insert(reports.end(), slave_reports.begin(), slave_reports.end());
+        return reports;
+    }
+
+    bool is_running() {
+        for (auto &camera : cameras_) {
+            if (camera.is_running()) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool stop() {
+        // The master is stopped first, so that the slaves do not receive a clock anymore
+        bool stopped = true;
+        for (size_t i = 0; i < cameras_.size(); ++i) {
+            stopped = cameras_[i].stop() && stopped;
+            merger_.close_source(i);
+        }
+        return stopped;
+    }
+
+    std::vector<Camera> cameras_;
+    const CameraGroupConfig config_;
+    EventStreamMerger<EventCD> merger_;
+
+private:
+    void synchronize() {
+        for (size_t i = 0; i < cameras_.size(); ++i) {
+            I_DeviceControl *device_control = cameras_[i].get_device().get_facility<I_DeviceControl>();
+            if (!device_control) {
+                throw CameraException(CameraErrorCode::UnsupportedFeature,
+                                      "Camera " + std::to_string(i) + " of the group can not be synchronized.");
+            }
+            const bool set = (i == 0) ? device_control->set_mode_master() : device_control->set_mode_slave();
+            if (!set) {
+                throw CameraException(CameraErrorCode::UnsupportedFeature,
+                                      "Failed to set camera " + std::to_string(i) + " of the group as " +
+                                          (i == 0 ? "master." : "slave."));
+            }
+        }
+    }
+
+    std::vector<Camera *> camera_pointers(size_t first, size_t last) {
+        std::vector<Camera *> pointers;
+        for (size_t i = first; i < last; ++i) {
+            pointers.push_back(&cameras_[i]);
+        }
+        return pointers;
+    }
+};
+
+CameraGroup CameraGroup::from_serials(const std::vector<std::string> &serials, const CameraGroupConfig &config) {
+    std::vector<Camera> cameras;
+    for (const auto &serial : serials) {
+        cameras.emplace_back(Camera::from_serial(serial));
+    }
+    return CameraGroup(std::move(cameras), config);
+}
+
+CameraGroup CameraGroup::from_files(const std::vector<std::string> &rawfiles, const CameraGroupConfig &config) {
+    // The files are read at the speed of the recording, so that they do not drift apart from each other by more than
+    // the maximum skew
+    std::vector<Camera> cameras;
+    for (const auto &rawfile : rawfiles) {
+        cameras.emplace_back(Camera::from_file(rawfile, true));
+    }
+    CameraGroupConfig files_config = config;
+    files_config.synchronize       = false;
+    return CameraGroup(std::move(cameras), files_config);
+}
+
+CameraGroup::CameraGroup(std::vector<Camera> &&cameras, const CameraGroupConfig &config) :
+    pimpl_(new Private(std::move(cameras), config)) {}
+
+CameraGroup::CameraGroup(CameraGroup &&group) = default;
+
+CameraGroup &CameraGroup::operator=(CameraGroup &&group) = default;
+
+CameraGroup::~CameraGroup() {}
+
+size_t CameraGroup::size() const {
+    return pimpl_->cameras_.size();
+}
+
+Camera &CameraGroup::camera(size_t index) {
+    return pimpl_->cameras_.at(index);
+}
+
+void CameraGroup::set_merged_cd_callback(const MergedEventsCDCallback &cb) {
+    pimpl_->merger_.set_output_callback(cb);
+}
+
+std::vector<CameraStartReport> CameraGroup::start() {
+    return pimpl_->start();
+}
+
+bool CameraGroup::is_running() {
+    return pimpl_->is_running();
+}
+
+bool CameraGroup::stop() {
+    return pimpl_->stop();
+}
+
+size_t CameraGroup::get_num_late_events() const {
+    return pimpl_->merger_.get_num_late_events();
+}
+
+} // namespace Metavision
@@ -11,9 +11,11 @@
 
 #include "metavision/sdk/driver/cd.h"
 
+#include "metavision/sdk/driver/camera_exception.h"
 #include "metavision/sdk/driver/internal/cd_internal.h"
 #include "metavision/sdk/core/utils/index_manager.h"
 #include "metavision/sdk/driver/internal/callback_tag_ids.h"
+#include "metavision/sdk/driver/internal/events_slicer.h"
 
 namespace Metavision {
 
@@ -22,20 +24,88 @@ CD *CD::Private::build(IndexManager &index_manager) {
 }
 
 CD::Private::Private(IndexManager &index_manager) :
-    CallbackManager<EventsCDCallback>(index_manager, CallbackTagIds::DECODE_CALLBACK_TAG_ID) {}
+    CallbackManager<EventsCDCallback>(index_manager, CallbackTagIds::DECODE_CALLBACK_TAG_ID) {
+    buffer_pool_.register_statistics("CD decoded event buffers");
+}
 
 CD::Private::~Private() {}
 
+CallbackId CD::Private::add_async_callback(const EventsCDCallback &cb, const AsyncCallbackConfig &config) {
+    std::lock_guard<std::mutex> lock(workers_mutex_);
+    // The callback dispatched on the decoding thread does nothing, but accounts for the events to be decoded
+    const CallbackId id = CallbackManager<EventsCDCallback>::add_callback([](const EventCD *, const EventCD *) {});
+    auto worker         = std::make_shared<Worker>(cb, config);
+    workers_[id]        = worker;
+    workers_queues_.add(id, [worker](const SharedEventsBuffer &buffer) { worker->push(buffer); });
+    return id;
+}
+
+CallbackId CD::Private::add_slice_callback(const SliceCondition &condition, const EventsCDSliceCallback &cb) {
+    if ((condition.type == SliceCondition::Type::N_US && condition.delta_ts <= 0) ||
+        (condition.type == SliceCondition::Type::N_EVENTS && condition.delta_n_events == 0)) {
+        throw CameraException(CameraErrorCode::InvalidArgument,
+                              "The duration or number of events of the slices must be positive.");
+    }
+    auto slicer = std::make_shared<EventsSlicer<EventCD>>(condition, cb);
+    return CallbackManager<EventsCDCallback>::add_callback(
+        [slicer](const EventCD *begin, const EventCD *end) { slicer->process(begin, end); });
+}
+
+bool CD::Private::remove_callback(CallbackId callback_id) {
+    std::shared_ptr<Worker> worker;
+    {
+        std::lock_guard<std::mutex> lock(workers_mutex_);
+        auto it = workers_.find(callback_id);
+        if (it != workers_.end()) {
+            worker = std::move(it->second);
+            workers_.erase(it);
+            workers_queues_.remove(callback_id);
+        }
+    }
+    if (worker) {
+        worker->stop();
+    }
+    return CallbackManager<EventsCDCallback>::remove_callback(callback_id);
+}
+
+size_t CD::Private::get_num_dropped_buffers(CallbackId callback_id) const {
+    std::lock_guard<std::mutex> lock(workers_mutex_);
+    auto it = workers_.find(callback_id);
+    return it == workers_.end() ? 0 : it->second->get_num_dropped_buffers();
+}
+
+void CD::Private::operator()(const EventCD *begin, const EventCD *end) {
+    // The workers are fed first, so that they run while the other callbacks are called
+    if (!workers_queues_.empty()) {
+        auto buffer = buffer_pool_.acquire();
+        buffer->assign(begin, end);
+        workers_queues_(SharedEventsBuffer(std::move(buffer)));
+    }
+    CallbackManager<EventsCDCallback>::operator()(begin, end);
+}
+
 CD::~CD() {}
 
 CallbackId CD::add_callback(const EventsCDCallback &cb) {
     return pimpl_->add_callback(cb);
 }
 
+CallbackId CD::add_async_callback(const EventsCDCallback &cb, const AsyncCallbackConfig &config) {
+    return pimpl_->add_async_callback(cb, config);
+}
+
+CallbackId CD::add_slice_callback(const SliceCondition &condition, const EventsCDSliceCallback &cb) {
+    return pimpl_->add_slice_callback(condition, cb);
+}
+
 bool CD::remove_callback(CallbackId callback_id) {
     return pimpl_->remove_callback(callback_id);
 }
 
+size_t CD::get_num_dropped_buffers(CallbackId callback_id) const {
+    return pimpl_->get_num_dropped_buffers(callback_id);
+}
+
 CD::Private &CD::get_pimpl() {
     return *pimpl_;
 }
@@ -0,0 +1,230 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <boost/filesystem.hpp>
+
+#include "metavision/hal/device/device.h"
+#include "metavision/hal/device/device_discovery.h"
+#include "metavision/hal/facilities/i_decoder.h"
+#include "metavision/hal/facilities/i_event_decoder.h"
+#include "metavision/hal/utils/compressed_raw_file_stream.h"
+#include "metavision/hal/utils/hal_exception.h"
+#include "metavision/hal/utils/raw_file_config.h"
+#include "metavision/hal/utils/raw_file_header.h"
+#include "metavision/hal/utils/raw_file_index.h"
+#include "metavision/sdk/driver/camera_exception.h"
+#include "metavision/sdk/driver/event_file_reader.h"
+
+namespace Metavision {
+
+EventFileReader::Iterator &EventFileReader::Iterator::operator++() {
+    if (reader_ && !reader_->read_next_slice(reader_->slice_)) {
+        reader_ = nullptr;
+    }
+    return *this;
+}
+
+EventFileReader::EventFileReader(const std::string &path, timestamp slice_duration_us, uint32_t n_events_to_read,
+                                 bool do_time_shifting) :
+    slice_duration_us_(slice_duration_us) {
+    if (slice_duration_us <= 0) {
+        throw std::invalid_argument("The duration of the slices must be positive.");
+    }
+    if (!boost::filesystem::exists(path)) {
+        throw CameraException(CameraErrorCode::FileDoesNotExist,
+                              "Opening RAW file at " + path + ": not an existing file.");
+    }
+
+    try {
+        if (CompressedRawFileStream::is_compressed(path)) {
+            stream_.reset(new CompressedRawFileStream(path, 1));
+        } else {
+            stream_.reset(new std::ifstream(path, std::ios::binary));
+        }
+    } catch (const HalException &e) { throw CameraException(CameraErrorCode::CouldNotOpenFile, e.what()); }
+    if (!stream_->good()) {
+        throw CameraException(CameraErrorCode::CouldNotOpenFile, "Could not open RAW file at " + path + ".");
+    }
+
+    // The offsets of the index of a compressed file are the ones of the decompressed data
+    stream_->seekg(0, std::ios::end);
+    const auto raw_file_size = static_cast<uint64_t>(stream_->tellg());
+    stream_->seekg(0);
+    index_.reset(new RawFileIndex());
+    if (!index_->load(RawFileIndex::get_sidecar_path(path)) || index_->get_raw_file_size() != raw_file_size ||
+        index_->empty()) {
+        index_.reset();
+    }
+
+    // The device is only used to decode the data: it is given the header alone, so that it never reads the file nor
+    // starts a thread to do so, the data being read by this object
+    RawFileHeader header(*stream_);
+    RawFileConfig config;
+    config.n_events_to_read_ = n_events_to_read;
+    config.do_time_shifting_ = do_time_shifting;
+    try {
+        device_ = DeviceDiscovery::open_stream(std::make_unique<std::istringstream>(header.to_string()), config);
+    } catch (const HalException &e) { throw CameraException(CameraErrorCode::InvalidRawfile, e.what()); }
+    if (device_) {
+        decoder_ = device_->get_facility<I_Decoder>();
+    }
+    if (!decoder_) {
+        throw CameraException(CameraErrorCode::InvalidRawfile,
+                              "The RAW file at " + path + " could not be decoded by any plugin.");
+    }
+
+    cd_decoder_ = device_->get_facility<I_EventDecoder<EventCD>>();
+    if (cd_decoder_) {
+        cd_callback_id_ = cd_decoder_->add_event_buffer_callback(
+            [this](const EventCD *begin, const EventCD *end) { pending_cd_.insert(pending_cd_.end(), begin, end); });
+    }
+    ext_trigger_decoder_ = device_->get_facility<I_EventDecoder<EventExtTrigger>>();
+    if (ext_trigger_decoder_) {
+        ext_trigger_callback_id_ = ext_trigger_decoder_->add_event_buffer_callback(
+            [this](const EventExtTrigger *begin, const EventExtTrigger *end) {
+                pending_ext_trigger_.insert(pending_ext_trigger_.end(), begin, end);
+            });
+    }
+
+    read_buffer_.resize(static_cast<size_t>(std::max<uint32_t>(n_events_to_read, 1)) *
+                        decoder_->get_raw_event_size_bytes());
+}
+
+EventFileReader::~EventFileReader() {
+    if (cd_decoder_) {
+        cd_decoder_->remove_callback(cd_callback_id_);
+    }
+    if (ext_trigger_decoder_) {
+        ext_trigger_decoder_->remove_callback(ext_trigger_callback_id_);
+    }
+}
+
+bool EventFileReader::decode_next_chunk() {
+    if (eof_) {
+        return false;
+    }
+    stream_->read(reinterpret_cast<char *>(read_buffer_.data()), read_buffer_.size());
+    const auto n_bytes = stream_->gcount();
+    if (!*stream_) {
+        eof_ = true;
+    }
+    if (n_bytes <= 0) {
+        eof_ = true;
+        return false;
+    }
+    n_bytes_read_ += n_bytes;
+    decoder_->decode(read_buffer_.data(), read_buffer_.data() + n_bytes);
+    return true;
+}
+
+template<typename Event>
+void EventFileReader::take_until(std::vector<Event> &pending, size_t &pending_begin, timestamp end_ts,
+                                 std::vector<Event> &out) {
+    const auto first = pending.begin() + pending_begin;
+    const auto last  = std::find_if(first, pending.end(), [end_ts](const Event &ev) { return ev.t >= end_ts; });
+    out.assign(first, last);
+    pending_begin = std::distance(pending.begin(), last);
+
+    // The events given are only removed once they make up most of the buffer, to avoid moving the others each time
+    if (pending_begin == pending.size()) {
+        pending.clear();
+        pending_begin = 0;
+    } else if (pending_begin > pending.size() / 2) {
+        pending.erase(pending.begin(), pending.begin() + pending_begin);
+        pending_begin = 0;
+    }
+}
+
+bool EventFileReader::read_next_slice(EventFileSlice &slice) {
+    auto has_pending = [this]() {
+        return pending_cd_begin_ < pending_cd_.size() || pending_ext_trigger_begin_ < pending_ext_trigger_.size();
+    };
+
+    if (!started_) {
+        // The first slice starts at the first multiple of the duration before the first event
+        while (!has_pending() && decode_next_chunk()) {}
+        if (!has_pending()) {
+            slice = EventFileSlice();
+            return false;
+        }
+        timestamp first_ts = std::numeric_limits<timestamp>::max();
+        if (!pending_cd_.empty()) {
+            first_ts = pending_cd_.front().t;
+        }
+        if (!pending_ext_trigger_.empty()) {
+            first_ts = std::min(first_ts, pending_ext_trigger_.front().t);
+        }
+        next_begin_ts_ = (first_ts / slice_duration_us_) * slice_duration_us_;
+        started_       = true;
+    }
+
+    const timestamp end_ts = next_begin_ts_ + slice_duration_us_;
+    while (decoder_->get_last_timestamp() < end_ts && decode_next_chunk()) {}
+
+    if (eof_ && !has_pending()) {
+        slice.begin_ts = slice.end_ts = end_ts;
+        slice.cd_events.clear();
+        slice.ext_trigger_events.clear();
+        return false;
+    }
+
+    slice.begin_ts = next_begin_ts_;
+    slice.end_ts   = end_ts;
+    take_until(pending_cd_, pending_cd_begin_, end_ts, slice.cd_events);
+    take_until(pending_ext_trigger_, pending_ext_trigger_begin_, end_ts, slice.ext_trigger_events);
+    next_begin_ts_ = end_ts;
+    return true;
+}
+
+EventFileReader::Iterator EventFileReader::begin() {
+    return read_next_slice(slice_) ? Iterator(this) : end();
+}
+
+EventFileReader::Iterator EventFileReader::end() {
+    return Iterator();
+}
+
+bool EventFileReader::seek(timestamp t) {
+    if (!index_) {
+        return false;
+    }
+    const timestamp shift = decoder_->is_time_shifting_enabled() ? index_->get_first_timestamp() : 0;
+    const auto &entry     = index_->find(t + shift);
+
+    stream_->clear();
+    if (!stream_->seekg(entry.offset_) || !decoder_->reset_timestamp_shift(shift) ||
+        !decoder_->reset_last_timestamp(entry.timestamp_ - shift)) {
+        return false;
+    }
+
+    eof_     = false;
+    started_ = false;
+    pending_cd_.clear();
+    pending_cd_begin_ = 0;
+    pending_ext_trigger_.clear();
+    pending_ext_trigger_begin_ = 0;
+    return true;
+}
+
+Device &EventFileReader::get_device() {
+    return *device_;
+}
+
+uint64_t EventFileReader::get_n_bytes_read() const {
+    return n_bytes_read_;
+}
+
+} // namespace Metavision
@@ -0,0 +1,163 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_DRIVER_ASYNC_CALLBACK_WORKER_H
+#define METAVISION_SDK_DRIVER_ASYNC_CALLBACK_WORKER_H
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "metavision/sdk/driver/cd.h"
+
+namespace Metavision {
+
+/// @brief Calls a callback on a thread of its own, with the buffers of events queued for it
+///
+/// The buffers are shared with the other workers, and are never modified. When the queue is full, the buffer pushed
+/// is handled according to an @ref AsyncCallbackDropPolicy.
+template<typename Event>
+class AsyncCallbackWorker {
+public:
+    using EventsBuffer       = std::vector<Event>;
+    using SharedEventsBuffer = std::shared_ptr<const EventsBuffer>;
+    using Callback           = std::function<void(const Event *begin, const Event *end)>;
+
+    /// @brief Constructor, starting the thread
+    /// @param cb Callback to call with the events of each buffer
+    /// @param config Size of the queue and policy applied when it is full
+    AsyncCallbackWorker(const Callback &cb, const AsyncCallbackConfig &config) :
+        state_(std::make_shared<State>(cb, config)) {
+        // The thread shares the state, so that it can outlive the worker when it is stopped from the callback
+        auto state = state_;
+        thread_    = std::thread([state]() { state->run(); });
+    }
+
+    AsyncCallbackWorker(const AsyncCallbackWorker &) = delete;
+    AsyncCallbackWorker &operator=(const AsyncCallbackWorker &) = delete;
+
+    /// @brief Destructor, stopping the thread
+    ~AsyncCallbackWorker() {
+        stop();
+    }
+
+    /// @brief Queues a buffer to be processed by the callback
+    /// @param buffer Buffer of events
+    /// @return false if the buffer has been dropped
+    bool push(const SharedEventsBuffer &buffer) {
+        return state_->push(buffer);
+    }
+
+    /// @brief Processes the buffers already queued, then stops the thread
+    ///
+    /// If called from the callback itself, returns without waiting for the thread.
+    void stop() {
+        state_->stop();
+        if (!thread_.joinable()) {
+            return;
+        }
+        if (thread_.get_id() == std::this_thread::get_id()) {
+            thread_.detach();
+        } else {
+            thread_.join();
+        }
+    }
+
+    /// @brief Gets the number of buffers dropped because the queue was full
+    size_t get_num_dropped_buffers() const {
+        std::lock_guard<std::mutex> lock(state_->mutex_);
+        return state_->num_dropped_buffers_;
+    }
+
+private:
+    struct State {
+        State(const Callback &cb, const AsyncCallbackConfig &config) :
+            cb_(cb),
+            max_queued_buffers_(std::max<size_t>(config.max_queued_buffers, 1)),
+            drop_policy_(config.drop_policy) {}
+
+        bool push(const SharedEventsBuffer &buffer) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            if (stopped_) {
+                return false;
+            }
+            if (queue_.size() >= max_queued_buffers_) {
+                switch (drop_policy_) {
+                case AsyncCallbackDropPolicy::Block:
+                    not_full_cond_.wait(lock, [this]() { return queue_.size() < max_queued_buffers_ || stopped_; });
+                    if (stopped_) {
+                        ++num_dropped_buffers_;
+                        return false;
+                    }
+                    break;
+                case AsyncCallbackDropPolicy::DropNewest:
+                    ++num_dropped_buffers_;
+                    return false;
+                case AsyncCallbackDropPolicy::DropOldest:
+                    queue_.pop_front();
+                    ++num_dropped_buffers_;
+                    break;
+                }
+            }
+            queue_.push_back(buffer);
+            not_empty_cond_.notify_one();
+            return true;
+        }
+
+        void stop() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopped_ = true;
+            not_empty_cond_.notify_all();
+            not_full_cond_.notify_all();
+        }
+
+        void run() {
+            std::unique_lock<std::mutex> lock(mutex_);
+            while (true) {
+                not_empty_cond_.wait(lock, [this]() { return !queue_.empty() || stopped_; });
+                if (queue_.empty()) {
+                    return;
+                }
+                SharedEventsBuffer buffer = std::move(queue_.front());
+                queue_.pop_front();
+                not_full_cond_.notify_one();
+
+                lock.unlock();
+                cb_(buffer->data(), buffer->data() + buffer->size());
+                // The buffer goes back to its pool without holding the lock
+                buffer.reset();
+                lock.lock();
+            }
+        }
+
+        const Callback cb_;
+        const size_t max_queued_buffers_;
+        const AsyncCallbackDropPolicy drop_policy_;
+        std::deque<SharedEventsBuffer> queue_;
+        size_t num_dropped_buffers_ = 0;
+        bool stopped_               = false;
+        std::mutex mutex_;
+        std::condition_variable not_empty_cond_;
+        std::condition_variable not_full_cond_;
+    };
+
+    std::shared_ptr<State> state_;
+    std::thread thread_;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_DRIVER_ASYNC_CALLBACK_WORKER_H
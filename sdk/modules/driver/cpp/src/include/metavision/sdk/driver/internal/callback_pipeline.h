@@ -0,0 +1,171 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_DRIVER_CALLBACK_PIPELINE_H
+#define METAVISION_SDK_DRIVER_CALLBACK_PIPELINE_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/base/events/event_ext_trigger.h"
+#include "metavision/sdk/base/utils/object_pool.h"
+#include "metavision/sdk/base/utils/sdk_log.h"
+#include "metavision/sdk/base/utils/thread_policy.h"
+#include "metavision/sdk/base/utils/timestamp.h"
+#include "metavision/sdk/base/utils/trace.h"
+
+namespace Metavision {
+
+/// @brief Calls the callbacks of the events decoded by the camera on a thread of its own
+///
+/// The decoding thread fills a batch with the events decoded from a buffer of RAW data and pushes it, the thread of
+/// the pipeline calling the callbacks with it while the next buffer is decoded. The batches are handled in the order
+/// they are pushed, and are taken from a pool of 2, so that the decoding runs at most one buffer ahead of the
+/// callbacks.
+class CallbackPipeline {
+public:
+    /// @brief Events decoded from a buffer of RAW data
+    struct Batch {
+        enum class EventType : uint8_t { CD, ExtTrigger };
+
+        std::vector<EventCD> cd_events;
+        std::vector<EventExtTrigger> ext_trigger_events;
+        // Type and number of events of each call of the decoder's callbacks, in order
+        std::vector<std::pair<EventType, size_t>> calls;
+        // Copy of the RAW data decoded, if there are RAW data callbacks to call after the events callbacks
+        std::vector<uint8_t> raw_data;
+        bool has_raw_data = false;
+        size_t n_bytes    = 0;
+        size_t n_events   = 0;
+        bool decoded      = false;
+        timestamp last_ts = 0;
+        std::chrono::steady_clock::time_point arrival_time;
+
+        void add_cd_events(const EventCD *begin, const EventCD *end) {
+            cd_events.insert(cd_events.end(), begin, end);
+            add_call(EventType::CD, std::distance(begin, end));
+        }
+
+        void add_ext_trigger_events(const EventExtTrigger *begin, const EventExtTrigger *end) {
+            ext_trigger_events.insert(ext_trigger_events.end(), begin, end);
+            add_call(EventType::ExtTrigger, std::distance(begin, end));
+        }
+
+        void clear() {
+            cd_events.clear();
+            ext_trigger_events.clear();
+            calls.clear();
+            raw_data.clear();
+            has_raw_data = false;
+        }
+
+    private:
+        void add_call(EventType type, size_t n) {
+            // Consecutive calls for the same type are merged, as if the decoder had called the callback once
+            if (!calls.empty() && calls.back().first == type) {
+                calls.back().second += n;
+            } else {
+                calls.emplace_back(type, n);
+            }
+        }
+    };
+
+    using BatchPtr = SharedObjectPool<Batch>::ptr_type;
+    using Handler  = std::function<void(const Batch &)>;
+
+    /// @brief Constructor, starting the thread
+    /// @param handler Function calling the callbacks with the events of a batch
+    /// @param policy Policy of the thread
+    CallbackPipeline(const Handler &handler, const ThreadPolicy &policy) :
+        handler_(handler), pool_(SharedObjectPool<Batch>::make_bounded(2)) {
+        thread_ = std::thread([this, policy]() {
+            if (!apply_thread_policy(policy, "mv_camera_cb")) {
+                MV_SDK_LOG_WARNING() << "Failed to apply the threading policy of the camera callbacks thread";
+            }
+            MV_TRACE_THREAD_NAME("mv_camera_cb");
+            run();
+        });
+    }
+
+    CallbackPipeline(const CallbackPipeline &) = delete;
+    CallbackPipeline &operator=(const CallbackPipeline &) = delete;
+
+    /// @brief Destructor, handling the batches already pushed then stopping the thread
+    ~CallbackPipeline() {
+        stop();
+    }
+
+    /// @brief Takes an empty batch from the pool, waiting for the callbacks to be done with one if none is available
+    BatchPtr acquire() {
+        BatchPtr batch = pool_.acquire();
+        batch->clear();
+        return batch;
+    }
+
+    /// @brief Queues a batch to be handled once the ones pushed before are
+    void push(BatchPtr batch) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_.push_back(std::move(batch));
+        cond_.notify_one();
+    }
+
+    /// @brief Handles the batches already pushed, then stops the thread
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopped_ = true;
+            cond_.notify_one();
+        }
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+    }
+
+private:
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            cond_.wait(lock, [this]() { return !queue_.empty() || stopped_; });
+            if (queue_.empty()) {
+                return;
+            }
+            BatchPtr batch = std::move(queue_.front());
+            queue_.pop_front();
+
+            lock.unlock();
+            handler_(*batch);
+            // The batch goes back to the pool, releasing the decoding thread if it is waiting for it
+            batch.reset();
+            lock.lock();
+        }
+    }
+
+    const Handler handler_;
+    SharedObjectPool<Batch> pool_;
+    std::deque<BatchPtr> queue_;
+    bool stopped_ = false;
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::thread thread_;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_DRIVER_CALLBACK_PIPELINE_H
@@ -15,6 +15,7 @@
 #include <mutex>
 #include <thread>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <map>
 
@@ -22,7 +23,10 @@
 #include "metavision/hal/facilities/i_events_stream.h"
 #include "metavision/hal/facilities/i_decoder.h"
 #include "metavision/hal/utils/raw_file_config.h"
+#include "metavision/sdk/base/utils/thread_policy.h"
 #include "metavision/sdk/driver/camera.h"
+#include "metavision/sdk/driver/internal/callback_pipeline.h"
+#include "metavision/sdk/core/utils/clock_correlator.h"
 #include "metavision/sdk/core/utils/index_manager.h"
 #include "metavision/sdk/core/utils/timing_profiler.h"
 
@@ -54,11 +58,15 @@ public:
     Private(OnlineSourceType input_source_type, uint32_t source_index);
     Private(const Serial &serial);
     Private(const std::string &rawfile, const RawFileConfig &file_stream_config, bool reproduce_camera_behavior);
+    Private(const std::vector<std::string> &rawfiles, const RawFileConfig &file_stream_config,
+            bool reproduce_camera_behavior);
 
     ~Private();
 
     void open_raw_file(const std::string &rawfile, const RawFileConfig &file_stream_config,
                        bool reproduce_camera_behavior);
+    void open_raw_files(const std::vector<std::string> &rawfiles, const RawFileConfig &file_stream_config,
+                        bool reproduce_camera_behavior);
 
     RawFileConfig raw_file_stream_config_;
 
@@ -71,6 +79,9 @@ public:
 
     bool start();
     bool stop();
+    bool pause();
+    bool resume();
+    bool is_paused() const;
 
     // Get Event handlers classes :
     CD &cd();
@@ -98,6 +109,13 @@ public:
 
     void start_recording(const std::string &rawfile_path);
     void stop_recording();
+    void set_thread_policy(const ThreadPolicy &policy);
+    void set_performance_profile(PerformanceProfile profile);
+    void set_decoding_subsampling(uint32_t n);
+    void enable_callback_pipelining(bool enable);
+    void enable_latency_statistics(bool enable);
+    CameraLatencyStatistics get_latency_statistics() const;
+    void register_metrics(const std::string &name);
 
     // Pimpl functions
     void init_online_interfaces(const detail::Config &cfg = detail::Config());
@@ -114,12 +132,27 @@ public:
     int run_from_file(TimingProfilerType *profiler);
     template<typename TimingProfilerType>
     int run_main_loop(TimingProfilerType *profiler);
+    void resync_decoding(I_EventsStream::RawData *&ev_buffer, long &n_rawbytes);
     void emulate_real_time(I_EventsStream::RawData *ev_buffer, long n_rawbytes);
+    void replay_with_clock(I_EventsStream::RawData *ev_buffer, long n_rawbytes);
+    void add_replay_clock_source();
+    void remove_replay_clock_source();
+    void wait_until(uint64_t time_us) const;
+    bool skip_to_display_window(timestamp cur_ts);
     void init_clocks();
+    void init_latency_statistics();
+    void record_latency(size_t n_events, bool decoded, const std::chrono::steady_clock::time_point &arrival_time,
+                        timestamp last_ts);
+    void dispatch_batch(const CallbackPipeline::Batch &batch);
+    void correlate_clocks();
 
     void set_up_from_config();
     void end_run(int run_output);
     void set_is_running(bool);
+    void notify_camera_started();
+    void notify_first_buffer();
+    bool wait_first_buffer(const std::chrono::steady_clock::time_point &deadline,
+                           std::chrono::steady_clock::time_point &first_buffer_time);
 
     // initialization check up
     void check_initialization() const;
@@ -131,10 +164,21 @@ public:
 
     CameraConfiguration camera_configuration_;
     bool emulate_real_time_ = false;
+    FileReplayConfig replay_config_;
+    PerformanceProfile performance_profile_ = PerformanceProfile::Balanced;
+    uint64_t replay_batch_duration_us_      = 1000; // Wall clock time between two deadlines of the replay, in us
+    uint32_t decoding_subsampling_          = 1;    // One buffer in this number is decoded, 0 for none
+    bool callback_pipelining_               = false;
+    // Source of the replay in the clock shared with other files, if any
+    size_t replay_clock_source_       = 0;
+    bool replay_clock_source_added_   = false;
+    bool replay_clock_source_started_ = false;
     timestamp first_ts_;
     uint64_t first_ts_clock_;
+    timestamp next_display_ts_ = 0; // End of the next display window, when skipping the data that is not displayed
     bool print_timings_ = false;
-    TimingProfilerPair<> timing_profiler_tuple_;
+    TimingProfilerPair<detail::ConcurrencyPolicyLockFree, detail::OperationStoragePolicyHistogram>
+        timing_profiler_tuple_;
 
     std::unique_ptr<Device> device_    = nullptr;
     I_DeviceControl *i_device_control_ = nullptr;
@@ -145,13 +189,40 @@ public:
     bool is_init_      = false;
     bool is_recording_ = false;
     std::atomic<bool> is_running_{false}, done_decoding_{true};
+    std::atomic<bool> resync_clocks_{false}; // Set when resumed, for the run thread to resync the real time emulation
 
     std::thread run_thread_;
+    ThreadPolicy run_thread_policy_;
     std::mutex run_thread_mutex_, cbs_mutex_;
     enum class RunThreadStatus { STARTED, RUNNING, STOPPED };
     RunThreadStatus run_thread_status_ = RunThreadStatus::STOPPED;
     std::condition_variable run_thread_cond_;
-    std::atomic<bool> camera_is_started_;
+
+    // Handshake between start() and the run thread. It does not use run_thread_mutex_ as stop() holds it while joining
+    // the run thread
+    std::mutex start_mutex_;
+    std::condition_variable start_cond_;
+    bool camera_is_started_     = false;
+    bool first_buffer_received_ = false;
+    bool run_ended_             = false;
+    std::chrono::steady_clock::time_point first_buffer_time_;
+
+    // Latency of the events, see enable_latency_statistics. The storage is only written by the run thread, or by the
+    // thread of the callback pipeline when pipelined, and replaced before the thread is started under latency_mutex_
+    std::atomic<bool> latency_statistics_enabled_{false};
+    mutable std::mutex latency_mutex_;
+    detail::OperationStoragePolicyHistogram latency_storage_;
+    detail::OperationId transfer_to_callback_id_, sensor_to_callback_id_;
+
+    // Relation between the timestamps of the events and the steady clock of the host, estimated by the run thread from
+    // the arrival times of the buffers. It is reset each time the camera is started
+    ClockCorrelator clock_correlator_;
+
+    // Counters of the metrics, see register_metrics. They are only written by the run thread
+    std::atomic<uint64_t> num_cd_events_{0}, num_ext_trigger_events_{0}, num_bytes_{0}, num_buffers_{0};
+    std::atomic<uint64_t> decode_time_ns_{0};
+    std::atomic<bool> metrics_registered_{false};
+    size_t metrics_id_ = 0;
 
     // Facilities' wrappers :
     std::unique_ptr<Geometry> geometry_;
@@ -169,6 +240,11 @@ public:
     std::unique_ptr<RawData> raw_data_;
     std::unique_ptr<CameraGeneration> generation_;
 
+    // Thread calling the events callbacks when pipelined, see enable_callback_pipelining. The decoded events are stored
+    // in the batch being filled, if any, instead of being dispatched to the callbacks
+    std::unique_ptr<CallbackPipeline> callback_pipeline_;
+    CallbackPipeline::BatchPtr decoding_batch_;
+
     std::vector<Event2d> cd_events_front_, cd_events_back_;
     std::mutex cd_events_mutex_;
     CallbackId cd_events_cb_id_;
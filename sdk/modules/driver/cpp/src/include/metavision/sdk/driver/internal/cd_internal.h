@@ -12,11 +12,17 @@
 #ifndef METAVISION_SDK_DRIVER_CD_INTERNAL_H
 #define METAVISION_SDK_DRIVER_CD_INTERNAL_H
 
+#include <functional>
 #include <list>
 #include <map>
+#include <memory>
 #include <mutex>
 
+#include "metavision/sdk/base/utils/callback_list.h"
+#include "metavision/sdk/base/utils/object_pool.h"
 #include "metavision/sdk/core/utils/callback_manager.h"
+#include "metavision/sdk/driver/cd.h"
+#include "metavision/sdk/driver/internal/async_callback_worker.h"
 
 namespace Metavision {
 
@@ -29,6 +35,33 @@ public:
     virtual ~Private();
 
     static CD *build(IndexManager &index_manager);
+
+    /// @brief Adds a callback run on a worker thread of its own
+    CallbackId add_async_callback(const EventsCDCallback &cb, const AsyncCallbackConfig &config);
+
+    /// @brief Adds a callback called with slices of the decoded events
+    CallbackId add_slice_callback(const SliceCondition &condition, const EventsCDSliceCallback &cb);
+
+    /// @brief Removes a callback, waiting for its worker thread to process its queue if it has one
+    bool remove_callback(CallbackId callback_id);
+
+    /// @brief Gets the number of buffers dropped by the worker thread of a callback
+    size_t get_num_dropped_buffers(CallbackId callback_id) const;
+
+    /// @brief Dispatches a buffer of decoded events to the callbacks
+    ///
+    /// If some callbacks run on worker threads, the events are copied once in a pooled buffer queued for each of them,
+    /// before the other callbacks are called on the calling thread.
+    void operator()(const EventCD *begin, const EventCD *end);
+
+private:
+    using Worker             = AsyncCallbackWorker<EventCD>;
+    using SharedEventsBuffer = Worker::SharedEventsBuffer;
+
+    SharedObjectPool<Worker::EventsBuffer> buffer_pool_;
+    CallbackList<std::function<void(const SharedEventsBuffer &)>> workers_queues_;
+    std::map<CallbackId, std::shared_ptr<Worker>> workers_;
+    mutable std::mutex workers_mutex_;
 };
 
 } // namespace Metavision
@@ -0,0 +1,214 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_DRIVER_EVENT_STREAM_MERGER_H
+#define METAVISION_SDK_DRIVER_EVENT_STREAM_MERGER_H
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "metavision/sdk/base/utils/timestamp.h"
+
+namespace Metavision {
+
+/// @brief Merges time ordered streams of events coming from several sources into a single time ordered stream
+///
+/// The events of each source are buffered until all the sources have advanced past their timestamp, and are then
+/// output by a k-way merge. To bound the latency and the memory used when a source stalls, a source is never waited for
+/// when it is more than a maximum skew behind the most advanced one: its events older than the time already output are
+/// then dropped and counted as late.
+///
+/// The functions can be called from different threads, typically one per source. The output callback is called from
+/// the thread whose call made events ready, one call at a time.
+template<typename Event>
+class EventStreamMerger {
+public:
+    /// @brief Callback receiving the merged events, along with the index of the source of each event
+    using OutputCallback = std::function<void(const Event *begin, const Event *end, const std::uint16_t *sources)>;
+
+    /// @brief Constructor
+    /// @param num_sources Number of sources merged
+    /// @param max_skew_us Maximum time a source is waited for when it is behind the most advanced one
+    /// @param align_first_events If true, the timestamps of each source are shifted so that its first event is at 0.
+    /// Otherwise, the sources are assumed to share the same clock
+    EventStreamMerger(size_t num_sources, timestamp max_skew_us, bool align_first_events = false) :
+        max_skew_us_(max_skew_us), align_first_events_(align_first_events), sources_(num_sources) {}
+
+    /// @brief Sets the function called with the merged events
+    void set_output_callback(const OutputCallback &cb) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        output_cb_ = cb;
+    }
+
+    /// @brief Resets the merger to its initial state, all the sources being open and without event
+    void reset() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto &source : sources_) {
+            source = Source();
+        }
+        output_until_    = std::numeric_limits<timestamp>::min();
+        num_late_events_ = 0;
+    }
+
+    /// @brief Adds time ordered events from a source, and outputs the events that are ready
+    void add_events(size_t source_index, const Event *begin, const Event *end) {
+        if (begin == end) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        Source &source = sources_[source_index];
+        if (!source.has_offset) {
+            source.offset     = align_first_events_ ? -begin->t : 0;
+            source.has_offset = true;
+        }
+        // The events being time ordered, the late ones are the first ones
+        const timestamp offset = source.offset;
+        const Event *first     = std::find_if(
+            begin, end, [this, offset](const Event &ev) { return ev.t + offset >= output_until_; });
+        num_late_events_ += std::distance(begin, first);
+        const size_t num_events = source.events.size();
+        source.events.insert(source.events.end(), first, end);
+        if (offset != 0) {
+            for (auto it = source.events.begin() + num_events; it != source.events.end(); ++it) {
+                it->t += offset;
+            }
+        }
+        source.time = std::max(source.time, std::prev(end)->t + source.offset);
+        output();
+    }
+
+    /// @brief Notifies that a source will not output events before a timestamp, and outputs the events that are ready
+    ///
+    /// This lets the other sources advance when this one has no event.
+    void advance_time(size_t source_index, timestamp ts) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Source &source = sources_[source_index];
+        if (!source.has_offset) {
+            // The time of a source can not be related to the others before its first event when aligning them
+            return;
+        }
+        source.time = std::max(source.time, ts + source.offset);
+        output();
+    }
+
+    /// @brief Notifies that a source will not output events anymore, and outputs the events that are ready
+    ///
+    /// Once all the sources are closed, all the buffered events have been output.
+    void close_source(size_t source_index) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        sources_[source_index].time = std::numeric_limits<timestamp>::max();
+        output();
+    }
+
+    /// @brief Gets the number of events dropped because they arrived after more recent events had been output
+    size_t get_num_late_events() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return num_late_events_;
+    }
+
+private:
+    struct Source {
+        std::vector<Event> events;                                ///< Buffered events, from the index @p next
+        size_t next      = 0;                                     ///< Index of the next event to output
+        timestamp time   = std::numeric_limits<timestamp>::min(); ///< Time before which the source has no more event
+        timestamp offset = 0;                                     ///< Offset added to the timestamps of the source
+        bool has_offset  = false;                                 ///< True once the offset is known
+    };
+
+    // Outputs the buffered events older than the time all the sources have reached, or are not waited for anymore
+    void output() {
+        // The closed sources do not count in the skew, otherwise the other ones would not be waited for anymore
+        constexpr timestamp closed = std::numeric_limits<timestamp>::max();
+        timestamp newest           = std::numeric_limits<timestamp>::min();
+        bool all_closed            = true;
+        for (const auto &source : sources_) {
+            if (source.time != closed) {
+                newest     = std::max(newest, source.time);
+                all_closed = false;
+            }
+        }
+        if (newest == std::numeric_limits<timestamp>::min() && !all_closed) {
+            return;
+        }
+        const timestamp not_waited_before = all_closed ? closed : newest - max_skew_us_;
+        timestamp until = std::numeric_limits<timestamp>::max();
+        for (const auto &source : sources_) {
+            until = std::min(until, std::max(source.time, not_waited_before));
+        }
+        if (until <= output_until_) {
+            return;
+        }
+        output_until_ = until;
+
+        // K-way merge: the source with the oldest pending event outputs all its events up to the next source's one
+        heap_.clear();
+        for (size_t i = 0; i < sources_.size(); ++i) {
+            const Source &source = sources_[i];
+            if (source.next < source.events.size() && source.events[source.next].t < until) {
+                heap_.emplace_back(source.events[source.next].t, i);
+            }
+        }
+        const auto later = [](const HeapEntry &lhs, const HeapEntry &rhs) { return lhs > rhs; };
+        std::make_heap(heap_.begin(), heap_.end(), later);
+        while (!heap_.empty()) {
+            std::pop_heap(heap_.begin(), heap_.end(), later);
+            const size_t index = heap_.back().second;
+            heap_.pop_back();
+
+            const timestamp run_until = heap_.empty() ? until : std::min(until, heap_.front().first + 1);
+            Source &source            = sources_[index];
+            const auto run_begin      = source.events.cbegin() + source.next;
+            const auto run_end        = std::find_if(run_begin, source.events.cend(),
+                                              [run_until](const Event &ev) { return ev.t >= run_until; });
+            merged_events_.insert(merged_events_.end(), run_begin, run_end);
+            merged_sources_.insert(merged_sources_.end(), std::distance(run_begin, run_end),
+                                   static_cast<std::uint16_t>(index));
+            source.next = std::distance(source.events.cbegin(), run_end);
+            if (run_end != source.events.cend() && run_end->t < until) {
+                heap_.emplace_back(run_end->t, index);
+                std::push_heap(heap_.begin(), heap_.end(), later);
+            }
+        }
+
+        for (auto &source : sources_) {
+            source.events.erase(source.events.begin(), source.events.begin() + source.next);
+            source.next = 0;
+        }
+        if (!merged_events_.empty() && output_cb_) {
+            output_cb_(merged_events_.data(), merged_events_.data() + merged_events_.size(), merged_sources_.data());
+        }
+        merged_events_.clear();
+        merged_sources_.clear();
+    }
+
+    using HeapEntry = std::pair<timestamp, size_t>;
+
+    const timestamp max_skew_us_;
+    const bool align_first_events_;
+    std::vector<Source> sources_;
+    timestamp output_until_ = std::numeric_limits<timestamp>::min(); ///< All the events before it have been output
+    size_t num_late_events_ = 0;
+    std::vector<HeapEntry> heap_;
+    std::vector<Event> merged_events_;
+    std::vector<std::uint16_t> merged_sources_;
+    OutputCallback output_cb_;
+    mutable std::mutex mutex_;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_DRIVER_EVENT_STREAM_MERGER_H
@@ -0,0 +1,100 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_DRIVER_EVENTS_SLICER_H
+#define METAVISION_SDK_DRIVER_EVENTS_SLICER_H
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+#include "metavision/sdk/base/utils/timestamp.h"
+#include "metavision/sdk/driver/cd.h"
+
+namespace Metavision {
+
+/// @brief Cuts the buffers of decoded events into slices of fixed duration or number of events
+///
+/// The boundaries of the slices are found by binary search in the decoded buffers. A slice contained in a single
+/// decoded buffer is given to the callback as is, the events are only copied, in a buffer reused from one slice to
+/// the next, when a slice spans several decoded buffers.
+template<typename Event>
+class EventsSlicer {
+public:
+    using Callback = std::function<void(timestamp ts, const Event *begin, const Event *end)>;
+
+    /// @brief Constructor
+    /// @param condition Condition ending the slices
+    /// @param cb Callback to call with each slice
+    EventsSlicer(const SliceCondition &condition, const Callback &cb) : condition_(condition), cb_(cb) {}
+
+    /// @brief Processes a buffer of events, calling the callback for each slice it ends
+    void process(const Event *begin, const Event *end) {
+        if (condition_.type == SliceCondition::Type::N_US) {
+            process_n_us(begin, end);
+        } else {
+            process_n_events(begin, end);
+        }
+    }
+
+private:
+    void process_n_us(const Event *begin, const Event *end) {
+        if (begin == end) {
+            return;
+        }
+        if (!has_slice_end_) {
+            slice_end_ts_  = (begin->t / condition_.delta_ts + 1) * condition_.delta_ts;
+            has_slice_end_ = true;
+        }
+        while (true) {
+            const Event *split = std::lower_bound(begin, end, slice_end_ts_,
+                                                  [](const Event &ev, timestamp t) { return ev.t < t; });
+            if (split == end) {
+                slice_.insert(slice_.end(), begin, end);
+                return;
+            }
+            // The slices without events, in the gaps of the stream, are given too so that their period is regular
+            produce(slice_end_ts_, begin, split);
+            begin = split;
+            slice_end_ts_ += condition_.delta_ts;
+        }
+    }
+
+    void process_n_events(const Event *begin, const Event *end) {
+        while (static_cast<size_t>(end - begin) + slice_.size() >= condition_.delta_n_events) {
+            const Event *split = begin + (condition_.delta_n_events - slice_.size());
+            produce(std::prev(split)->t, begin, split);
+            begin = split;
+        }
+        slice_.insert(slice_.end(), begin, end);
+    }
+
+    // Gives the events of the slice being accumulated followed by [begin, end) to the callback
+    void produce(timestamp ts, const Event *begin, const Event *end) {
+        if (slice_.empty()) {
+            cb_(ts, begin, end);
+            return;
+        }
+        slice_.insert(slice_.end(), begin, end);
+        cb_(ts, slice_.data(), slice_.data() + slice_.size());
+        slice_.clear();
+    }
+
+    const SliceCondition condition_;
+    const Callback cb_;
+    std::vector<Event> slice_;
+    timestamp slice_end_ts_ = 0;
+    bool has_slice_end_     = false;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_DRIVER_EVENTS_SLICER_H
@@ -0,0 +1,83 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_DRIVER_REPLAY_CLOCK_INTERNAL_H
+#define METAVISION_SDK_DRIVER_REPLAY_CLOCK_INTERNAL_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <map>
+#include <mutex>
+
+#include "metavision/sdk/driver/replay_clock.h"
+
+namespace Metavision {
+
+/// @brief Synchronizes the replay of the sources of a @ref ReplayClock, each of them replayed by its own thread
+///
+/// A source decodes its data up to @ref get_ts_limit, then calls @ref wait before decoding past this limit.
+class ReplayClock::Private {
+public:
+    Private(const ReplayClockConfig &config);
+
+    /// @brief Adds a source to replay, the replay starting once the first timestamp of all the sources is known
+    /// @return ID of the source
+    size_t add_source();
+
+    /// @brief Removes a source, which no longer holds back the other ones. The calls of the source waiting return
+    void remove_source(size_t id);
+
+    /// @brief Sets the first timestamp of a source, and waits for the replay to start
+    /// @return false if the source has been removed meanwhile
+    bool start_source(size_t id, timestamp first_ts);
+
+    /// @brief Gets the timestamp up to which a started source can decode its data now, excluded
+    timestamp get_ts_limit(size_t id);
+
+    /// @brief Waits until a source can output the events past a timestamp
+    /// @return false if the source has been removed meanwhile
+    bool wait(size_t id, timestamp ts);
+
+    timestamp get_time() const;
+
+    const ReplayClockConfig config_;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Source {
+        bool started      = false;
+        timestamp first_ts = 0;
+        timestamp origin   = 0; // Timestamp of the source at the origin of the time of the replay
+        timestamp done_ts  = 0; // Time of the replay up to which the source has output its events
+    };
+
+    void try_start();
+    void try_advance_step();
+    timestamp get_time_impl() const;
+
+    // Wall clock time between two deadlines of a source, when replaying at a given speed
+    static constexpr std::chrono::microseconds BatchDuration{1000};
+
+    std::map<size_t, Source> sources_;
+    size_t next_id_ = 0;
+    bool started_   = false;
+    Clock::time_point start_time_;
+    timestamp common_origin_ = 0; // Origin of the sources, if their first events are not aligned
+    timestamp step_end_      = 0; // End of the current step when replaying as fast as possible
+    mutable std::mutex mutex_;
+    std::condition_variable cond_;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_DRIVER_REPLAY_CLOCK_INTERNAL_H
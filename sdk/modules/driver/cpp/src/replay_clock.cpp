@@ -0,0 +1,175 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <limits>
+
+#include "metavision/sdk/driver/camera_exception.h"
+#include "metavision/sdk/driver/camera_error_code.h"
+#include "metavision/sdk/driver/replay_clock.h"
+#include "metavision/sdk/driver/internal/replay_clock_internal.h"
+
+namespace Metavision {
+
+constexpr std::chrono::microseconds ReplayClock::Private::BatchDuration;
+
+ReplayClock::Private::Private(const ReplayClockConfig &config) : config_(config) {
+    if (!(config.speed_factor >= 0.)) {
+        throw CameraException(CameraErrorCode::InvalidArgument,
+                              "The speed factor of a replay clock can not be negative.");
+    }
+    if (config.lock_step_us <= 0) {
+        throw CameraException(CameraErrorCode::InvalidArgument, "The lock step of a replay clock must be positive.");
+    }
+}
+
+size_t ReplayClock::Private::add_source() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    sources_[next_id_] = Source();
+    return next_id_++;
+}
+
+void ReplayClock::Private::remove_source(size_t id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (sources_.erase(id) == 0) {
+        return;
+    }
+    if (!started_) {
+        try_start();
+    } else {
+        try_advance_step();
+    }
+    cond_.notify_all();
+}
+
+bool ReplayClock::Private::start_source(size_t id, timestamp first_ts) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto it = sources_.find(id);
+    if (it == sources_.end()) {
+        return false;
+    }
+    it->second.started  = true;
+    it->second.first_ts = first_ts;
+    if (started_) {
+        // The source joins a replay already running, at its current time
+        const timestamp time = get_time_impl();
+        it->second.origin    = config_.align_first_events ? first_ts - time : common_origin_;
+        it->second.done_ts   = time;
+    } else {
+        try_start();
+    }
+    cond_.wait(lock, [this, id]() { return started_ || sources_.count(id) == 0; });
+    return sources_.count(id) != 0;
+}
+
+timestamp ReplayClock::Private::get_ts_limit(size_t id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = sources_.find(id);
+    if (it == sources_.end() || !started_) {
+        return std::numeric_limits<timestamp>::max();
+    }
+    if (config_.speed_factor == 0.) {
+        return it->second.origin + step_end_;
+    }
+    const auto elapsed =
+        std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() + BatchDuration - start_time_);
+    return it->second.origin + static_cast<timestamp>(elapsed.count() * config_.speed_factor);
+}
+
+bool ReplayClock::Private::wait(size_t id, timestamp ts) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto it = sources_.find(id);
+    if (it == sources_.end()) {
+        return false;
+    }
+    const timestamp time = ts - it->second.origin;
+    if (config_.speed_factor == 0.) {
+        it->second.done_ts = time;
+        try_advance_step();
+        cond_.wait(lock, [this, id, time]() { return step_end_ > time || sources_.count(id) == 0; });
+    } else {
+        const auto deadline =
+            start_time_ + std::chrono::microseconds(static_cast<int64_t>(time / config_.speed_factor));
+        cond_.wait_until(lock, deadline, [this, id]() { return sources_.count(id) == 0; });
+    }
+    return sources_.count(id) != 0;
+}
+
+timestamp ReplayClock::Private::get_time() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return get_time_impl();
+}
+
+void ReplayClock::Private::try_start() {
+    if (sources_.empty() ||
+        !std::all_of(sources_.begin(), sources_.end(), [](const auto &source) { return source.second.started; })) {
+        return;
+    }
+    common_origin_ = std::numeric_limits<timestamp>::max();
+    for (const auto &source : sources_) {
+        common_origin_ = std::min(common_origin_, source.second.first_ts);
+    }
+    for (auto &source : sources_) {
+        source.second.origin  = config_.align_first_events ? source.second.first_ts : common_origin_;
+        source.second.done_ts = 0;
+    }
+    start_time_ = Clock::now();
+    step_end_   = config_.lock_step_us;
+    started_    = true;
+    cond_.notify_all();
+}
+
+void ReplayClock::Private::try_advance_step() {
+    if (config_.speed_factor != 0.) {
+        return;
+    }
+    // The step ends once all the sources replayed have output its events
+    timestamp min_done_ts = std::numeric_limits<timestamp>::max();
+    for (const auto &source : sources_) {
+        if (source.second.started) {
+            min_done_ts = std::min(min_done_ts, source.second.done_ts);
+        }
+    }
+    if (min_done_ts == std::numeric_limits<timestamp>::max() || min_done_ts < step_end_) {
+        return;
+    }
+    step_end_ = (min_done_ts / config_.lock_step_us + 1) * config_.lock_step_us;
+    cond_.notify_all();
+}
+
+timestamp ReplayClock::Private::get_time_impl() const {
+    if (!started_) {
+        return -1;
+    }
+    if (config_.speed_factor == 0.) {
+        return step_end_ - config_.lock_step_us;
+    }
+    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start_time_);
+    return static_cast<timestamp>(elapsed.count() * config_.speed_factor);
+}
+
+ReplayClock::ReplayClock(const ReplayClockConfig &config) : pimpl_(new Private(config)) {}
+
+ReplayClock::~ReplayClock() {}
+
+const ReplayClockConfig &ReplayClock::get_config() const {
+    return pimpl_->config_;
+}
+
+timestamp ReplayClock::get_time() const {
+    return pimpl_->get_time();
+}
+
+ReplayClock::Private &ReplayClock::get_pimpl() {
+    return *pimpl_;
+}
+
+} // namespace Metavision
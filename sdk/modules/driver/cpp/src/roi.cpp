@@ -26,6 +26,8 @@ void Roi::set(Rectangle roi) {
 }
 
 void Roi::set(const std::vector<bool> &cols_to_enable, const std::vector<bool> &rows_to_enable) {
+    // The bitword programmed from the binary maps is not known, so that the next update programs a whole one
+    pimpl_->invalidate_ROIs_update();
     if (!pimpl_->set_ROIs(cols_to_enable, rows_to_enable, true)) {
         throw(CameraException(
             CameraErrorCode::RoiError,
@@ -41,6 +43,19 @@ void Roi::set(const std::vector<Roi::Rectangle> &rois_to_set) {
     pimpl_->set_ROIs(to_set);
 }
 
+size_t Roi::update(const std::vector<Roi::Rectangle> &rois_to_set) {
+    std::vector<DeviceRoi> to_set;
+    to_set.reserve(rois_to_set.size());
+    for (auto roi : rois_to_set) {
+        to_set.push_back({roi.x, roi.y, roi.width, roi.height});
+    }
+    return pimpl_->update_ROIs(to_set);
+}
+
+const I_ROI::UpdateStatistics &Roi::get_update_statistics() const {
+    return pimpl_->get_update_statistics();
+}
+
 void Roi::unset() {
     pimpl_->enable(false);
 }
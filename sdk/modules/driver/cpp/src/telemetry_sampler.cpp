@@ -0,0 +1,230 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+#include "metavision/hal/facilities/i_erc.h"
+#include "metavision/hal/facilities/i_event_rate_noise_filter_module.h"
+#include "metavision/hal/facilities/i_monitoring.h"
+#include "metavision/sdk/base/utils/metrics_registry.h"
+#include "metavision/sdk/base/utils/sdk_log.h"
+#include "metavision/sdk/driver/camera.h"
+#include "metavision/sdk/driver/telemetry_sampler.h"
+
+namespace Metavision {
+
+static_assert(std::is_trivially_copyable<TelemetrySnapshot>::value, "The snapshot is copied word by word");
+
+namespace {
+int64_t get_host_time_us() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+} // namespace
+
+TelemetrySampler::TelemetrySampler(I_Monitoring *monitoring, I_Erc *erc, I_EventRateNoiseFilterModule *noise_filter,
+                                   double rate_hz) :
+    monitoring_(monitoring),
+    erc_(erc),
+    noise_filter_(noise_filter),
+    period_(rate_hz > 0. ? static_cast<int64_t>(1e6 / rate_hz) : 0) {
+    if (!(rate_hz > 0.)) {
+        throw std::invalid_argument("The telemetry sampling rate must be positive.");
+    }
+    publish(TelemetrySnapshot());
+}
+
+TelemetrySampler::TelemetrySampler(Camera &camera, double rate_hz) :
+    TelemetrySampler(camera.get_device().get_facility<I_Monitoring>(), camera.get_device().get_facility<I_Erc>(),
+                     camera.get_device().get_facility<I_EventRateNoiseFilterModule>(), rate_hz) {
+    camera_         = &camera;
+    cd_callback_id_ = camera.cd().add_callback(
+        [this](const EventCD *begin, const EventCD *end) { process_events(begin, end); });
+}
+
+TelemetrySampler::~TelemetrySampler() {
+    if (metrics_registered_) {
+        MetricsRegistry::instance().remove(metrics_id_);
+    }
+    stop();
+    if (camera_) {
+        camera_->cd().remove_callback(cd_callback_id_);
+    }
+}
+
+void TelemetrySampler::start() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (running_) {
+        return;
+    }
+    running_ = true;
+    thread_  = std::thread([this]() { run(); });
+}
+
+void TelemetrySampler::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_) {
+            return;
+        }
+        running_ = false;
+        cond_.notify_all();
+    }
+    thread_.join();
+}
+
+void TelemetrySampler::process_events(const EventCD *begin, const EventCD *end) {
+    if (begin == end) {
+        return;
+    }
+    num_events_.fetch_add(std::distance(begin, end), std::memory_order_relaxed);
+    last_event_timestamp_us_.store((end - 1)->t, std::memory_order_relaxed);
+}
+
+TelemetrySnapshot TelemetrySampler::get_latest() const {
+    std::array<uint64_t, NumWords> words;
+    uint64_t sequence;
+    do {
+        sequence = sequence_.load(std::memory_order_acquire);
+        for (size_t i = 0; i < NumWords; ++i) {
+            words[i] = words_[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+    } while ((sequence & 1) || sequence != sequence_.load(std::memory_order_relaxed));
+
+    TelemetrySnapshot snapshot;
+    std::memcpy(&snapshot, words.data(), sizeof(snapshot));
+    return snapshot;
+}
+
+void TelemetrySampler::set_sample_callback(const SampleCallback &cb) {
+    sample_cb_ = cb;
+}
+
+void TelemetrySampler::register_metrics(const std::string &name) {
+    if (metrics_registered_) {
+        MetricsRegistry::instance().remove(metrics_id_);
+    }
+    metrics_registered_ = true;
+    metrics_id_         = MetricsRegistry::instance().add([this, name](std::vector<MetricSample> &samples) {
+        const TelemetrySnapshot snapshot = get_latest();
+        if (snapshot.sample_index == 0) {
+            return;
+        }
+        auto add = [&](const char *metric, const char *help, double value) {
+            samples.push_back({metric, help, MetricSample::Type::Gauge, {{"device", name}}, value});
+        };
+        add("metavision_device_event_rate", "CD event rate measured by the telemetry sampler, in events per second",
+            snapshot.event_rate);
+        if (snapshot.has_monitoring) {
+            add("metavision_device_temperature_celsius", "Temperature of the sensor", snapshot.temperature_c);
+            add("metavision_device_illumination_lux", "Illumination of the sensor", snapshot.illumination_lux);
+        }
+        if (snapshot.has_erc) {
+            add("metavision_device_erc_enabled", "Whether the ERC is enabled", snapshot.erc_enabled ? 1. : 0.);
+            add("metavision_device_erc_event_rate", "Target CD event rate of the ERC, in events per second",
+                snapshot.erc_cd_event_rate);
+        }
+        if (snapshot.has_noise_filter) {
+            add("metavision_device_noise_filter_threshold", "Event rate threshold of the noise filter, in kev/s",
+                snapshot.noise_filter_threshold_kev_s);
+        }
+    });
+}
+
+void TelemetrySampler::run() {
+    uint64_t sample_index         = 0;
+    int64_t previous_host_time_us = get_host_time_us();
+    uint64_t previous_num_events  = num_events_.load(std::memory_order_relaxed);
+    auto next_sample_time         = std::chrono::steady_clock::now();
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (running_) {
+        lock.unlock();
+        const auto snapshot = sample(++sample_index, previous_host_time_us, previous_num_events);
+        publish(snapshot);
+        if (sample_cb_) {
+            sample_cb_(snapshot);
+        }
+        previous_host_time_us = snapshot.host_time_us;
+        previous_num_events   = snapshot.num_events;
+        lock.lock();
+
+        // The samples are taken on a fixed grid, the late ones being skipped rather than taken in a burst
+        next_sample_time += period_;
+        const auto now = std::chrono::steady_clock::now();
+        if (next_sample_time < now) {
+            next_sample_time += ((now - next_sample_time) / period_ + 1) * period_;
+        }
+        cond_.wait_until(lock, next_sample_time, [this]() { return !running_; });
+    }
+}
+
+TelemetrySnapshot TelemetrySampler::sample(uint64_t sample_index, int64_t previous_host_time_us,
+                                           uint64_t previous_num_events) {
+    TelemetrySnapshot snapshot;
+    snapshot.sample_index = sample_index;
+
+    // The facilities are read first, so that the events counted include the ones received while reading them
+    if (monitoring_) {
+        try {
+            snapshot.temperature_c    = monitoring_->get_temperature();
+            snapshot.illumination_lux = monitoring_->get_illumination();
+            snapshot.has_monitoring   = true;
+        } catch (const std::exception &e) {
+            MV_SDK_LOG_WARNING() << "Failed to read the sensor monitoring:" << e.what();
+        }
+    }
+    if (erc_) {
+        try {
+            snapshot.erc_enabled       = erc_->is_enabled();
+            snapshot.erc_cd_event_rate = erc_->get_cd_event_rate();
+            snapshot.has_erc           = true;
+        } catch (const std::exception &e) {
+            MV_SDK_LOG_WARNING() << "Failed to read the ERC state:" << e.what();
+        }
+    }
+    if (noise_filter_) {
+        try {
+            snapshot.noise_filter_threshold_kev_s = noise_filter_->get_event_rate_threshold();
+            snapshot.has_noise_filter             = true;
+        } catch (const std::exception &e) {
+            MV_SDK_LOG_WARNING() << "Failed to read the noise filter threshold:" << e.what();
+        }
+    }
+
+    snapshot.host_time_us       = get_host_time_us();
+    snapshot.num_events         = num_events_.load(std::memory_order_relaxed);
+    snapshot.event_timestamp_us = last_event_timestamp_us_.load(std::memory_order_relaxed);
+    if (snapshot.host_time_us > previous_host_time_us) {
+        snapshot.event_rate =
+            (snapshot.num_events - previous_num_events) * 1e6 / (snapshot.host_time_us - previous_host_time_us);
+    }
+    return snapshot;
+}
+
+void TelemetrySampler::publish(const TelemetrySnapshot &snapshot) {
+    std::array<uint64_t, NumWords> words{};
+    std::memcpy(words.data(), &snapshot, sizeof(snapshot));
+
+    const uint64_t sequence = sequence_.load(std::memory_order_relaxed);
+    sequence_.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < NumWords; ++i) {
+        words_[i].store(words[i], std::memory_order_relaxed);
+    }
+    sequence_.store(sequence + 2, std::memory_order_release);
+}
+
+} // namespace Metavision
@@ -46,11 +46,21 @@ public:
         return biases_map_;
     }
 
+    virtual bool set_biases(const std::map<std::string, int> &biases) override {
+        ++num_set_biases_calls_;
+        return I_LL_Biases::set_biases(biases);
+    }
+
     void set_biases_map(const std::map<std::string, int> &biases_map) {
         biases_map_ = biases_map;
     }
 
+    int get_num_set_biases_calls() const {
+        return num_set_biases_calls_;
+    }
+
 private:
+    int num_set_biases_calls_ = 0;
     std::map<std::string, int> biases_map_;
 };
 
@@ -163,6 +173,24 @@ TEST_F(Biases_GTest, set_from_file_exa) {
     compare_biases(expected_biases, biases_set);
 }
 
+TEST_F(Biases_GTest, set_from_file_sets_all_biases_at_once) {
+    // GIVEN a bias file
+    std::string contents = "299  % bias_diff\n"
+                           "228  % bias_diff_off\n"
+                           "370  % bias_diff_on\n";
+    std::string filename = tmpdir_handler_->get_full_path("input.bias");
+    write_file(filename, contents);
+
+    // WHEN we set the biases from file
+    ASSERT_NO_THROW(biases_->set_from_file(filename));
+
+    // THEN the biases are passed to the HAL facility in a single call, which can program them in one transaction
+    auto mock_biases = static_cast<Mock_LL_Biases *>(i_ll_biases_.get());
+    EXPECT_EQ(1, mock_biases->get_num_set_biases_calls());
+    EXPECT_EQ(228, mock_biases->get("bias_diff_off"));
+    EXPECT_EQ(-1, mock_biases->get("bias_fo"));
+}
+
 TEST_F(Biases_GTest, set_from_file_wrong_extension) {
     // GIVEN a bias file with wrong extension
     std::string filename = tmpdir_handler_->get_full_path("input.txt");
@@ -133,6 +133,47 @@ protected:
         return data;
     }
 
+    // Writes a RAW file of events at a regular rate, to check the pace of its replay
+    std::vector<EventCD> write_evt2_raw_data_at_rate(timestamp duration_us, timestamp period_us) {
+        std::vector<EventCD> events;
+        for (timestamp t = period_us; t <= duration_us; t += period_us) {
+            events.emplace_back((t / period_us) % 640, (t / period_us / 640) % 480, 1, t);
+        }
+
+        open_file();
+        write_header(get_default_header());
+        TEncoder<Evt2RawFormat, TimerHighRedundancyEvt2Default> encoder;
+        encoder.set_encode_event_callback([&](const uint8_t *data, const uint8_t *data_end) {
+            log_raw_data_->write(reinterpret_cast<const char *>(data), std::distance(data, data_end));
+            bytes_written_ += std::distance(data, data_end);
+        });
+        encoder.encode(events.cbegin(), events.cend());
+        encoder.flush();
+        close_file();
+
+        return events;
+    }
+
+    // Replays the whole file, and returns the events received along with the wall clock duration of the replay, in us
+    std::pair<std::vector<EventCD>, uint64_t> replay_file(const FileReplayConfig &replay_config) {
+        Camera camera = Camera::from_file(tmp_file_, replay_config);
+        std::vector<EventCD> received_events;
+        camera.cd().add_callback([&](const EventCD *ev_begin, const EventCD *ev_end) {
+            received_events.insert(received_events.end(), ev_begin, ev_end);
+        });
+
+        const auto start = std::chrono::steady_clock::now();
+        camera.start();
+        while (camera.is_running()) {
+            std::this_thread::sleep_for(std::chrono::microseconds(1000));
+        }
+        const auto duration = std::chrono::steady_clock::now() - start;
+        camera.stop();
+
+        return std::make_pair(received_events,
+                              std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+    }
+
     std::string tmp_file_;
     std::unique_ptr<std::ofstream> log_raw_data_;
     size_t bytes_written_{0};
@@ -1293,6 +1334,161 @@ TEST_F(Camera_Gtest, decode_evt2_data) {
     }
 }
 
+TEST_F(Camera_Gtest, decode_evt2_data_with_callback_pipelining) {
+    const auto expected_events = write_evt2_raw_data_with_trigger();
+    Camera camera              = Camera::from_file(tmp_file_, false);
+
+    // GIVEN a camera calling its callbacks on a thread of their own, with a slow CD callback
+    camera.enable_callback_pipelining();
+    ASSERT_TRUE(camera.is_callback_pipelining_enabled());
+    std::vector<EventCD> received_events;
+    std::vector<EventExtTrigger> received_triggers;
+    std::vector<std::thread::id> callbacks_threads;
+    size_t n_raw_bytes = 0, n_events_at_raw_callback = 0;
+    camera.cd().add_callback([&](const EventCD *ev_begin, const EventCD *ev_end) {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+        received_events.insert(received_events.end(), ev_begin, ev_end);
+        callbacks_threads.push_back(std::this_thread::get_id());
+    });
+    camera.ext_trigger().add_callback([&](const EventExtTrigger *ev_begin, const EventExtTrigger *ev_end) {
+        received_triggers.insert(received_triggers.end(), ev_begin, ev_end);
+        callbacks_threads.push_back(std::this_thread::get_id());
+    });
+    camera.raw_data().add_callback([&](const uint8_t *data, size_t size) {
+        n_raw_bytes += size;
+        n_events_at_raw_callback = received_events.size();
+        callbacks_threads.push_back(std::this_thread::get_id());
+    });
+
+    // WHEN reading the whole file
+    camera.start();
+    while (camera.is_running()) {
+        std::this_thread::sleep_for(std::chrono::microseconds(1000));
+    }
+    camera.stop();
+
+    // THEN all the events are received, in order, once the camera is done running
+    ASSERT_EQ(expected_events.first.size(), received_events.size());
+    ASSERT_EQ(expected_events.second.size(), received_triggers.size());
+    for (size_t i = 1; i < received_events.size(); ++i) {
+        ASSERT_LE(received_events[i - 1].t, received_events[i].t);
+    }
+    for (size_t i = 0, i_end = expected_events.first.size(); i < i_end; ++i) {
+        ASSERT_EQ(expected_events.first[i].x, received_events[i].x);
+        ASSERT_EQ(expected_events.first[i].y, received_events[i].y);
+    }
+
+    // THEN the RAW data callbacks are called after the events callbacks of the data, on the same thread
+    ASSERT_LT(0u, n_raw_bytes);
+    ASSERT_EQ(received_events.size(), n_events_at_raw_callback);
+    ASSERT_FALSE(callbacks_threads.empty());
+    for (const auto &id : callbacks_threads) {
+        ASSERT_EQ(callbacks_threads.front(), id);
+    }
+}
+
+TEST_F(Camera_Gtest, callback_pipelining_can_not_be_changed_while_running) {
+    write_evt2_raw_data();
+    Camera camera = Camera::from_file(tmp_file_, false);
+
+    std::atomic<bool> wait(true);
+    camera.cd().add_callback([&wait](const EventCD *begin, const EventCD *end) {
+        while (wait) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+    camera.start();
+    ASSERT_THROW(camera.enable_callback_pipelining(), CameraException);
+    wait = false;
+    camera.stop();
+    ASSERT_NO_THROW(camera.enable_callback_pipelining());
+    ASSERT_TRUE(camera.is_callback_pipelining_enabled());
+}
+
+TEST_F(Camera_Gtest, from_file_with_invalid_replay_config) {
+    write_evt2_raw_data();
+
+    // GIVEN speed factors out of the range of the replay
+    for (const double speed_factor : {0.05, 200., -1.}) {
+        FileReplayConfig replay_config;
+        replay_config.speed_factor = speed_factor;
+
+        // WHEN opening the file
+        // THEN it throws
+        ASSERT_THROW(Camera::from_file(tmp_file_, replay_config), CameraException);
+    }
+
+    // GIVEN an empty display window with a periodic refresh of the display
+    FileReplayConfig replay_config;
+    replay_config.speed_factor      = 10.;
+    replay_config.display_period_us = 20000;
+    replay_config.display_window_us = 0;
+
+    // WHEN opening the file
+    // THEN it throws
+    ASSERT_THROW(Camera::from_file(tmp_file_, replay_config), CameraException);
+
+    // GIVEN valid configurations at the limits of the range of the speed factor
+    for (const double speed_factor : {0.1, 100.}) {
+        replay_config.speed_factor      = speed_factor;
+        replay_config.display_window_us = 10000;
+
+        // WHEN opening the file
+        // THEN it succeeds
+        ASSERT_NO_THROW(Camera::from_file(tmp_file_, replay_config));
+    }
+}
+
+TEST_F(Camera_Gtest, from_file_replays_at_the_speed_factor) {
+    // GIVEN a file of 500ms of recording
+    const timestamp duration_us = 500000;
+    const auto expected_events  = write_evt2_raw_data_at_rate(duration_us, 100);
+
+    // WHEN replaying it in real time and 10 times faster
+    FileReplayConfig replay_config;
+    const auto real_time_replay = replay_file(replay_config);
+    replay_config.speed_factor  = 10.;
+    const auto fast_replay      = replay_file(replay_config);
+
+    // THEN all the events are received in both cases
+    ASSERT_EQ(expected_events.size(), real_time_replay.first.size());
+    ASSERT_EQ(expected_events.size(), fast_replay.first.size());
+
+    // THEN the real time replay lasts as long as the recording, and the fast one much less
+    ASSERT_LE(static_cast<uint64_t>(0.9 * duration_us), real_time_replay.second);
+    ASSERT_GE(static_cast<uint64_t>(0.4 * duration_us), fast_replay.second);
+    ASSERT_LE(static_cast<uint64_t>(0.08 * duration_us), fast_replay.second);
+}
+
+TEST_F(Camera_Gtest, from_file_skips_the_data_out_of_the_display_windows) {
+    // GIVEN a file of 2s of recording, replayed 10 times faster with the display refreshed every 20ms, i.e. every
+    // 200ms of recording
+    const timestamp duration_us = 2000000;
+    const auto expected_events  = write_evt2_raw_data_at_rate(duration_us, 100);
+    FileReplayConfig replay_config;
+    replay_config.speed_factor      = 10.;
+    replay_config.display_period_us = 20000;
+    replay_config.display_window_us = 10000;
+
+    // WHEN replaying it
+    const auto replay           = replay_file(replay_config);
+    const auto &received_events = replay.first;
+
+    // THEN the data far from the display windows is skipped by seeking in the file
+    ASSERT_FALSE(received_events.empty());
+    ASSERT_GT(expected_events.size() / 2, received_events.size());
+
+    // THEN the events are still received in order, and the window of each refresh of the display is decoded
+    const timestamp display_period_ts = static_cast<timestamp>(replay_config.display_period_us * 10.);
+    for (size_t i = 1; i < received_events.size(); ++i) {
+        ASSERT_LT(received_events[i - 1].t, received_events[i].t);
+        ASSERT_GE(display_period_ts, received_events[i].t - received_events[i - 1].t);
+    }
+
+    // THEN the replay does not last longer than when decoding all the data
+    ASSERT_GE(static_cast<uint64_t>(0.4 * duration_us), replay.second);
+}
+
 TEST_F_WITH_DATASET(Camera_Gtest, decode_evt3_data) {
     // Read the dataset provided
     std::string dataset_file_path =
@@ -0,0 +1,229 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/core/utils/index_manager.h"
+#include "metavision/sdk/driver/cd.h"
+#include "metavision/sdk/driver/internal/callback_tag_ids.h"
+#include "metavision/sdk/driver/internal/cd_internal.h"
+
+using namespace Metavision;
+
+namespace {
+
+class CDAsyncCallback_GTest : public ::testing::Test {
+protected:
+    CDAsyncCallback_GTest() : cd_(CD::Private::build(index_manager_)) {}
+
+    void dispatch(timestamp t, size_t n = 10) {
+        std::vector<EventCD> events;
+        for (size_t i = 0; i < n; ++i) {
+            events.emplace_back(0, 0, 0, t);
+        }
+        cd_->get_pimpl()(events.data(), events.data() + events.size());
+    }
+
+    /// Blocks the callbacks until @ref release is called
+    struct Gate {
+        void wait() {
+            std::unique_lock<std::mutex> lock(mutex);
+            cond.wait(lock, [this]() { return open; });
+        }
+        void release() {
+            std::lock_guard<std::mutex> lock(mutex);
+            open = true;
+            cond.notify_all();
+        }
+        std::mutex mutex;
+        std::condition_variable cond;
+        bool open = false;
+    };
+
+    IndexManager index_manager_;
+    std::unique_ptr<CD> cd_;
+};
+
+} // namespace
+
+TEST_F(CDAsyncCallback_GTest, callbacks_run_on_their_own_threads) {
+    const auto decoding_thread = std::this_thread::get_id();
+    std::vector<timestamp> received[2];
+    std::atomic<bool> called_on_decoding_thread{false};
+    CallbackId ids[2];
+    for (int i = 0; i < 2; ++i) {
+        ids[i] = cd_->add_async_callback([&, i](const EventCD *begin, const EventCD *end) {
+            called_on_decoding_thread = called_on_decoding_thread || std::this_thread::get_id() == decoding_thread;
+            EXPECT_EQ(10, std::distance(begin, end));
+            received[i].push_back(begin->t);
+        });
+    }
+    // The events are to be decoded as long as the callbacks are registered
+    EXPECT_TRUE(index_manager_.counter_map_.tag_count(CallbackTagIds::DECODE_CALLBACK_TAG_ID) > 0);
+
+    // WHEN dispatching buffers, then removing the callbacks
+    for (timestamp t = 0; t < 100; ++t) {
+        dispatch(t);
+    }
+    EXPECT_TRUE(cd_->remove_callback(ids[0]));
+    EXPECT_TRUE(cd_->remove_callback(ids[1]));
+
+    // THEN each callback has received all the buffers in order, on another thread
+    EXPECT_FALSE(called_on_decoding_thread);
+    for (int i = 0; i < 2; ++i) {
+        ASSERT_EQ(100, received[i].size());
+        for (timestamp t = 0; t < 100; ++t) {
+            EXPECT_EQ(t, received[i][t]);
+        }
+        EXPECT_EQ(0, cd_->get_num_dropped_buffers(ids[i]));
+    }
+    EXPECT_EQ(0, index_manager_.counter_map_.tag_count(CallbackTagIds::DECODE_CALLBACK_TAG_ID));
+    EXPECT_FALSE(cd_->remove_callback(ids[0]));
+}
+
+TEST_F(CDAsyncCallback_GTest, buffers_are_shared_by_the_callbacks) {
+    std::mutex mutex;
+    std::vector<const EventCD *> buffers;
+    int sync_copies = 0;
+    auto cb         = [&](const EventCD *begin, const EventCD *) {
+        std::lock_guard<std::mutex> lock(mutex);
+        buffers.push_back(begin);
+    };
+    auto id1 = cd_->add_async_callback(cb);
+    auto id2 = cd_->add_async_callback(cb);
+    auto id3 = cd_->add_callback([&](const EventCD *, const EventCD *) { ++sync_copies; });
+
+    dispatch(0);
+    cd_->remove_callback(id1);
+    cd_->remove_callback(id2);
+    cd_->remove_callback(id3);
+
+    // THEN the callbacks on worker threads have received the same copy of the events
+    ASSERT_EQ(2, buffers.size());
+    EXPECT_EQ(buffers[0], buffers[1]);
+    EXPECT_EQ(1, sync_copies);
+}
+
+TEST_F(CDAsyncCallback_GTest, drop_newest) {
+    Gate gate;
+    std::vector<timestamp> received;
+    AsyncCallbackConfig config;
+    config.max_queued_buffers = 2;
+    config.drop_policy        = AsyncCallbackDropPolicy::DropNewest;
+    std::atomic<bool> started{false};
+    auto id = cd_->add_async_callback(
+        [&](const EventCD *begin, const EventCD *) {
+            started = true;
+            gate.wait();
+            received.push_back(begin->t);
+        },
+        config);
+
+    // WHEN the callback is blocked on the first buffer, and more buffers than the queue can hold are dispatched
+    dispatch(0);
+    while (!started) {
+        std::this_thread::yield();
+    }
+    for (timestamp t = 1; t < 5; ++t) {
+        dispatch(t);
+    }
+    EXPECT_EQ(2, cd_->get_num_dropped_buffers(id));
+    gate.release();
+    cd_->remove_callback(id);
+
+    // THEN the last buffers have been dropped
+    EXPECT_EQ((std::vector<timestamp>{0, 1, 2}), received);
+}
+
+TEST_F(CDAsyncCallback_GTest, drop_oldest) {
+    Gate gate;
+    std::vector<timestamp> received;
+    AsyncCallbackConfig config;
+    config.max_queued_buffers = 2;
+    config.drop_policy        = AsyncCallbackDropPolicy::DropOldest;
+    std::atomic<bool> started{false};
+    auto id = cd_->add_async_callback(
+        [&](const EventCD *begin, const EventCD *) {
+            started = true;
+            gate.wait();
+            received.push_back(begin->t);
+        },
+        config);
+
+    dispatch(0);
+    while (!started) {
+        std::this_thread::yield();
+    }
+    for (timestamp t = 1; t < 5; ++t) {
+        dispatch(t);
+    }
+    EXPECT_EQ(2, cd_->get_num_dropped_buffers(id));
+    gate.release();
+    cd_->remove_callback(id);
+
+    // THEN the oldest queued buffers have been dropped
+    EXPECT_EQ((std::vector<timestamp>{0, 3, 4}), received);
+}
+
+TEST_F(CDAsyncCallback_GTest, block_waits_for_the_callback) {
+    std::atomic<int> processed{0};
+    AsyncCallbackConfig config;
+    config.max_queued_buffers = 1;
+    auto id                   = cd_->add_async_callback(
+        [&](const EventCD *, const EventCD *) {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            ++processed;
+        },
+        config);
+
+    // WHEN dispatching buffers faster than the callback processes them
+    for (timestamp t = 0; t < 20; ++t) {
+        dispatch(t);
+        // THEN the dispatch waits, at most one buffer being queued besides the one processed
+        EXPECT_GE(processed.load(), t - 1);
+    }
+    cd_->remove_callback(id);
+    EXPECT_EQ(20, processed);
+    EXPECT_EQ(0, cd_->get_num_dropped_buffers(id));
+}
+
+TEST_F(CDAsyncCallback_GTest, callback_can_remove_itself) {
+    std::atomic<int> calls{0};
+    CallbackId id;
+    std::atomic<bool> added{false};
+    id = cd_->add_async_callback([&](const EventCD *, const EventCD *) {
+        while (!added) {
+            std::this_thread::yield();
+        }
+        cd_->remove_callback(id);
+        ++calls;
+    });
+    added = true;
+
+    dispatch(0);
+    while (calls == 0) {
+        std::this_thread::yield();
+    }
+    // THEN the buffers dispatched after the removal are not processed
+    dispatch(1);
+    dispatch(2);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_EQ(1, calls);
+}
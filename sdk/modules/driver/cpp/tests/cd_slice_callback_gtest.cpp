@@ -0,0 +1,129 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <memory>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/core/utils/index_manager.h"
+#include "metavision/sdk/driver/camera_exception.h"
+#include "metavision/sdk/driver/cd.h"
+#include "metavision/sdk/driver/internal/cd_internal.h"
+
+using namespace Metavision;
+
+namespace {
+
+class CDSliceCallback_GTest : public ::testing::Test {
+protected:
+    CDSliceCallback_GTest() : cd_(CD::Private::build(index_manager_)) {}
+
+    struct Slice {
+        timestamp ts;
+        std::vector<timestamp> events_ts;
+    };
+
+    CallbackId add_slice_callback(const SliceCondition &condition) {
+        return cd_->add_slice_callback(condition, [this](timestamp ts, const EventCD *begin, const EventCD *end) {
+            slices_.push_back(Slice{ts, {}});
+            for (auto it = begin; it != end; ++it) {
+                slices_.back().events_ts.push_back(it->t);
+            }
+        });
+    }
+
+    void dispatch(const std::vector<timestamp> &events_ts) {
+        std::vector<EventCD> events;
+        for (auto t : events_ts) {
+            events.emplace_back(0, 0, 0, t);
+        }
+        cd_->get_pimpl()(events.data(), events.data() + events.size());
+    }
+
+    IndexManager index_manager_;
+    std::unique_ptr<CD> cd_;
+    std::vector<Slice> slices_;
+};
+
+} // namespace
+
+TEST_F(CDSliceCallback_GTest, n_us_slices) {
+    // GIVEN a callback of slices of 10us
+    add_slice_callback(SliceCondition::make_n_us(10));
+
+    // WHEN dispatching buffers whose boundaries do not match the ones of the slices, with a gap of several slices
+    dispatch({3, 5, 9, 10, 12});
+    dispatch({15, 19});
+    dispatch({20, 45, 48});
+    dispatch({51});
+
+    // THEN the events are given in slices aligned on multiples of 10us, the empty ones included
+    ASSERT_EQ(5, slices_.size());
+    EXPECT_EQ(10, slices_[0].ts);
+    EXPECT_EQ((std::vector<timestamp>{3, 5, 9}), slices_[0].events_ts);
+    EXPECT_EQ(20, slices_[1].ts);
+    EXPECT_EQ((std::vector<timestamp>{10, 12, 15, 19}), slices_[1].events_ts);
+    EXPECT_EQ(30, slices_[2].ts);
+    EXPECT_EQ((std::vector<timestamp>{20}), slices_[2].events_ts);
+    EXPECT_EQ(40, slices_[3].ts);
+    EXPECT_TRUE(slices_[3].events_ts.empty());
+    EXPECT_EQ(50, slices_[4].ts);
+    EXPECT_EQ((std::vector<timestamp>{45, 48}), slices_[4].events_ts);
+}
+
+TEST_F(CDSliceCallback_GTest, n_events_slices) {
+    // GIVEN a callback of slices of 3 events
+    add_slice_callback(SliceCondition::make_n_events(3));
+
+    // WHEN dispatching buffers of various sizes
+    dispatch({1, 2});
+    dispatch({3, 4, 5, 6, 7, 8, 9});
+    dispatch({10});
+
+    // THEN the events are given in slices of 3 events, stamped with their last event
+    ASSERT_EQ(3, slices_.size());
+    EXPECT_EQ(3, slices_[0].ts);
+    EXPECT_EQ((std::vector<timestamp>{1, 2, 3}), slices_[0].events_ts);
+    EXPECT_EQ(6, slices_[1].ts);
+    EXPECT_EQ((std::vector<timestamp>{4, 5, 6}), slices_[1].events_ts);
+    EXPECT_EQ(9, slices_[2].ts);
+    EXPECT_EQ((std::vector<timestamp>{7, 8, 9}), slices_[2].events_ts);
+}
+
+TEST_F(CDSliceCallback_GTest, slices_within_a_buffer_are_not_copied) {
+    // GIVEN a callback of slices of 2 events
+    std::vector<const EventCD *> slices_begin;
+    cd_->add_slice_callback(SliceCondition::make_n_events(2),
+                            [&](timestamp, const EventCD *begin, const EventCD *) { slices_begin.push_back(begin); });
+
+    // WHEN dispatching a buffer holding several slices
+    std::vector<EventCD> events(4, EventCD(0, 0, 0, 0));
+    cd_->get_pimpl()(events.data(), events.data() + events.size());
+
+    // THEN the slices point into the dispatched buffer
+    ASSERT_EQ(2, slices_begin.size());
+    EXPECT_EQ(events.data(), slices_begin[0]);
+    EXPECT_EQ(events.data() + 2, slices_begin[1]);
+}
+
+TEST_F(CDSliceCallback_GTest, removed_callback_is_not_called) {
+    auto id = add_slice_callback(SliceCondition::make_n_events(1));
+    dispatch({1});
+    EXPECT_TRUE(cd_->remove_callback(id));
+    dispatch({2});
+    EXPECT_EQ(1, slices_.size());
+}
+
+TEST_F(CDSliceCallback_GTest, invalid_condition_throws) {
+    EXPECT_THROW(add_slice_callback(SliceCondition::make_n_us(0)), CameraException);
+    EXPECT_THROW(add_slice_callback(SliceCondition::make_n_events(0)), CameraException);
+}
@@ -0,0 +1,49 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <gtest/gtest.h>
+
+#include "metavision/utils/gtest/gtest_with_tmp_dir.h"
+#include "metavision/sdk/driver/camera_exception.h"
+#include "metavision/sdk/driver/event_file_reader.h"
+
+using namespace Metavision;
+
+class EventFileReader_GTest : public GTestWithTmpDir {};
+
+TEST_F(EventFileReader_GTest, non_existing_file) {
+    try {
+        EventFileReader reader(tmpdir_handler_->get_full_path("non_existing_file.raw"), 1000);
+        FAIL() << "Expected exception CameraErrorCode::FileDoesNotExist";
+    } catch (CameraException &e) { ASSERT_EQ(e.code().value(), CameraErrorCode::FileDoesNotExist); }
+}
+
+TEST_F(EventFileReader_GTest, invalid_slice_duration) {
+    const std::string path = tmpdir_handler_->get_full_path("file.raw");
+    std::ofstream(path) << "% format EVT3\n";
+    ASSERT_THROW(EventFileReader(path, 0), std::invalid_argument);
+    ASSERT_THROW(EventFileReader(path, -10), std::invalid_argument);
+}
+
+TEST_F(EventFileReader_GTest, file_not_decodable) {
+    // GIVEN a file that no plugin can read
+    const std::string path = tmpdir_handler_->get_full_path("unknown.raw");
+    std::ofstream(path) << "% integrator_name unknown\n% plugin_name unknown\n" << std::string(64, '\0');
+
+    // THEN it can not be opened
+    try {
+        EventFileReader reader(path, 1000);
+        FAIL() << "Expected exception CameraErrorCode::InvalidRawfile";
+    } catch (CameraException &e) { ASSERT_EQ(e.code().value(), CameraErrorCode::InvalidRawfile); }
+}
@@ -0,0 +1,223 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/driver/internal/event_stream_merger.h"
+
+using namespace Metavision;
+
+namespace {
+
+class EventStreamMerger_GTest : public ::testing::Test {
+protected:
+    void connect(EventStreamMerger<EventCD> &merger) {
+        merger.set_output_callback([this](const EventCD *begin, const EventCD *end, const std::uint16_t *sources) {
+            output_events_.insert(output_events_.end(), begin, end);
+            output_sources_.insert(output_sources_.end(), sources, sources + std::distance(begin, end));
+        });
+    }
+
+    static std::vector<EventCD> make_events(const std::vector<timestamp> &timestamps, std::int16_t x = 0) {
+        std::vector<EventCD> events;
+        for (auto t : timestamps) {
+            events.emplace_back(x, 0, 0, t);
+        }
+        return events;
+    }
+
+    static void add(EventStreamMerger<EventCD> &merger, size_t source, const std::vector<EventCD> &events) {
+        merger.add_events(source, events.data(), events.data() + events.size());
+    }
+
+    std::vector<EventCD> output_events_;
+    std::vector<std::uint16_t> output_sources_;
+};
+
+} // namespace
+
+TEST_F(EventStreamMerger_GTest, merges_sources_in_time_order) {
+    EventStreamMerger<EventCD> merger(3, 1000000);
+    connect(merger);
+
+    // WHEN adding interleaved events from 3 sources
+    add(merger, 0, make_events({1, 4, 7, 10}, 0));
+    add(merger, 1, make_events({2, 5, 8}, 1));
+    add(merger, 2, make_events({3, 6, 9}, 2));
+
+    // THEN only the events before the time all the sources have reached are output
+    ASSERT_EQ(7, output_events_.size());
+
+    // WHEN all the sources are closed
+    merger.close_source(0);
+    merger.close_source(1);
+    merger.close_source(2);
+
+    // THEN all the events are output in time order, with their source
+    ASSERT_EQ(10, output_events_.size());
+    for (size_t i = 0; i < output_events_.size(); ++i) {
+        EXPECT_EQ(static_cast<timestamp>(i + 1), output_events_[i].t);
+        EXPECT_EQ(i % 3, output_sources_[i]);
+        EXPECT_EQ(output_events_[i].x, output_sources_[i]);
+    }
+    EXPECT_EQ(0, merger.get_num_late_events());
+}
+
+TEST_F(EventStreamMerger_GTest, events_with_same_timestamp_are_kept) {
+    EventStreamMerger<EventCD> merger(2, 1000000);
+    connect(merger);
+
+    // WHEN the sources have events with the same timestamps, split across several buffers
+    add(merger, 0, make_events({5, 5}));
+    add(merger, 1, make_events({5}));
+    add(merger, 0, make_events({5, 6}));
+    add(merger, 1, make_events({5, 6}));
+    merger.close_source(0);
+    merger.close_source(1);
+
+    // THEN no event is lost nor late
+    ASSERT_EQ(7, output_events_.size());
+    for (size_t i = 1; i < output_events_.size(); ++i) {
+        EXPECT_LE(output_events_[i - 1].t, output_events_[i].t);
+    }
+    EXPECT_EQ(0, merger.get_num_late_events());
+}
+
+TEST_F(EventStreamMerger_GTest, advance_time_unblocks_idle_source) {
+    EventStreamMerger<EventCD> merger(2, 1000000);
+    connect(merger);
+    add(merger, 0, make_events({10}));
+    add(merger, 1, make_events({20, 30, 40}));
+    ASSERT_EQ(0, output_events_.size());
+
+    // WHEN the source 0 has no events, but notifies that its time advances
+    merger.advance_time(0, 35);
+
+    // THEN the events of the source 1 before that time are output
+    ASSERT_EQ(3, output_events_.size());
+    EXPECT_EQ(30, output_events_.back().t);
+}
+
+TEST_F(EventStreamMerger_GTest, stalled_source_is_not_waited_beyond_max_skew) {
+    EventStreamMerger<EventCD> merger(2, 100);
+    connect(merger);
+    add(merger, 0, make_events({0}));
+    add(merger, 1, make_events({0}));
+
+    // WHEN a source advances more than the maximum skew ahead of the other one
+    add(merger, 0, make_events({50, 150, 250}));
+
+    // THEN its events more than the maximum skew before its last one are output without waiting for the other source
+    ASSERT_EQ(3, output_events_.size());
+    EXPECT_EQ(50, output_events_.back().t);
+
+    // WHEN the stalled source sends events older than the events output
+    add(merger, 1, make_events({100, 160}));
+
+    // THEN they are dropped, and the newer ones are still merged
+    EXPECT_EQ(1, merger.get_num_late_events());
+    merger.close_source(0);
+    merger.close_source(1);
+    ASSERT_EQ(6, output_events_.size());
+    EXPECT_EQ(160, output_events_[4].t);
+    EXPECT_EQ(1, output_sources_[4]);
+    EXPECT_EQ(250, output_events_[5].t);
+}
+
+TEST_F(EventStreamMerger_GTest, closed_source_does_not_hold_the_others) {
+    EventStreamMerger<EventCD> merger(2, 100);
+    connect(merger);
+
+    // WHEN a source is closed
+    add(merger, 0, make_events({10, 20}));
+    merger.close_source(0);
+
+    // THEN the other source is still waited for
+    add(merger, 1, make_events({1000}));
+    ASSERT_EQ(2, output_events_.size());
+    add(merger, 1, make_events({1000, 1001}));
+    EXPECT_EQ(0, merger.get_num_late_events());
+}
+
+TEST_F(EventStreamMerger_GTest, align_first_events) {
+    EventStreamMerger<EventCD> merger(2, 1000000, true);
+    connect(merger);
+
+    // WHEN aligning sources whose clocks have different origins
+    add(merger, 0, make_events({1000, 1010}));
+    add(merger, 1, make_events({5000, 5005}));
+    merger.close_source(0);
+    merger.close_source(1);
+
+    // THEN the first event of each source is at 0
+    ASSERT_EQ(4, output_events_.size());
+    EXPECT_EQ(0, output_events_[0].t);
+    EXPECT_EQ(0, output_events_[1].t);
+    EXPECT_EQ(5, output_events_[2].t);
+    EXPECT_EQ(1, output_sources_[2]);
+    EXPECT_EQ(10, output_events_[3].t);
+}
+
+TEST_F(EventStreamMerger_GTest, reset_reopens_the_sources) {
+    EventStreamMerger<EventCD> merger(1, 100);
+    connect(merger);
+    add(merger, 0, make_events({10}));
+    merger.close_source(0);
+    add(merger, 0, make_events({20}));
+    ASSERT_EQ(1, merger.get_num_late_events());
+
+    // WHEN resetting the merger
+    merger.reset();
+
+    // THEN the events can be merged again, from any time
+    add(merger, 0, make_events({5, 6}));
+    merger.close_source(0);
+    EXPECT_EQ(0, merger.get_num_late_events());
+    ASSERT_EQ(3, output_events_.size());
+    EXPECT_EQ(6, output_events_.back().t);
+}
+
+TEST_F(EventStreamMerger_GTest, concurrent_sources) {
+    const size_t num_sources = 4, num_batches = 200, batch_size = 50;
+    EventStreamMerger<EventCD> merger(num_sources, 1000000000);
+    connect(merger);
+
+    // WHEN each source adds its events from its own thread
+    std::vector<std::thread> threads;
+    for (size_t s = 0; s < num_sources; ++s) {
+        threads.emplace_back([&, s]() {
+            std::vector<EventCD> events;
+            for (size_t b = 0; b < num_batches; ++b) {
+                events.clear();
+                for (size_t i = 0; i < batch_size; ++i) {
+                    events.emplace_back(static_cast<std::uint16_t>(s), 0, 0,
+                                        static_cast<timestamp>((b * batch_size + i) * num_sources + s));
+                }
+                add(merger, s, events);
+            }
+            merger.close_source(s);
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    // THEN all the events are output in time order
+    ASSERT_EQ(num_sources * num_batches * batch_size, output_events_.size());
+    for (size_t i = 0; i < output_events_.size(); ++i) {
+        ASSERT_EQ(static_cast<timestamp>(i), output_events_[i].t);
+        ASSERT_EQ(i % num_sources, output_sources_[i]);
+    }
+}
@@ -0,0 +1,133 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "metavision/sdk/driver/camera_exception.h"
+#include "metavision/sdk/driver/replay_clock.h"
+#include "metavision/sdk/driver/internal/replay_clock_internal.h"
+
+using namespace Metavision;
+
+namespace {
+
+// Replays a source whose events are every @p period us from @p first_ts, and records the time of the clock at which the
+// events are output, relative to the first one of the source
+void replay_source(ReplayClock &clock, size_t id, timestamp first_ts, timestamp period, timestamp duration,
+                   std::vector<std::pair<timestamp, timestamp>> &outputs) {
+    auto &pimpl = clock.get_pimpl();
+    ASSERT_TRUE(pimpl.start_source(id, first_ts));
+    timestamp t = first_ts;
+    while (t < first_ts + duration) {
+        const timestamp ts_limit = pimpl.get_ts_limit(id);
+        for (; t < ts_limit && t < first_ts + duration; t += period) {
+            outputs.emplace_back(t - first_ts, clock.get_time());
+        }
+        if (t < first_ts + duration) {
+            ASSERT_TRUE(pimpl.wait(id, ts_limit));
+        }
+    }
+    pimpl.remove_source(id);
+}
+
+} // namespace
+
+TEST(ReplayClock_GTest, as_fast_as_possible_in_lock_step) {
+    // GIVEN a clock replaying as fast as possible, and two sources of different rates and first timestamps
+    ReplayClockConfig config;
+    config.speed_factor = 0.;
+    config.lock_step_us = 100;
+    ReplayClock clock(config);
+    const size_t id0 = clock.get_pimpl().add_source();
+    const size_t id1 = clock.get_pimpl().add_source();
+
+    // WHEN replaying them concurrently
+    std::vector<std::pair<timestamp, timestamp>> outputs0, outputs1;
+    std::thread thread0([&]() { replay_source(clock, id0, 1000, 3, 10000, outputs0); });
+    std::thread thread1([&]() { replay_source(clock, id1, 500000, 7, 10000, outputs1); });
+    thread0.join();
+    thread1.join();
+
+    // THEN all the events are output, at most one step ahead of the clock, i.e. of the slowest source
+    ASSERT_EQ((10000 + 2) / 3, outputs0.size());
+    ASSERT_EQ((10000 + 6) / 7, outputs1.size());
+    for (const auto &outputs : {outputs0, outputs1}) {
+        for (const auto &output : outputs) {
+            EXPECT_LT(output.first, output.second + 2 * config.lock_step_us);
+            EXPECT_GE(output.first, output.second);
+        }
+    }
+}
+
+TEST(ReplayClock_GTest, real_time_with_aligned_first_events) {
+    // GIVEN a clock replaying 10 times faster than real time, and two sources of different first timestamps
+    ReplayClockConfig config;
+    config.speed_factor = 10.;
+    ReplayClock clock(config);
+    const size_t id0 = clock.get_pimpl().add_source();
+    const size_t id1 = clock.get_pimpl().add_source();
+    EXPECT_EQ(-1, clock.get_time());
+
+    // WHEN replaying 200ms of recording
+    std::vector<std::pair<timestamp, timestamp>> outputs0, outputs1;
+    const auto start = std::chrono::steady_clock::now();
+    std::thread thread0([&]() { replay_source(clock, id0, 0, 1000, 200000, outputs0); });
+    std::thread thread1([&]() { replay_source(clock, id1, 3000000, 1000, 200000, outputs1); });
+    thread0.join();
+    thread1.join();
+    const auto duration = std::chrono::steady_clock::now() - start;
+
+    // THEN the replay takes about 20ms, and both sources output their events at the time of the clock
+    EXPECT_GE(duration, std::chrono::milliseconds(19));
+    ASSERT_EQ(200, outputs0.size());
+    ASSERT_EQ(200, outputs1.size());
+    for (const auto &outputs : {outputs0, outputs1}) {
+        for (const auto &output : outputs) {
+            // The events are decoded up to a batch of wall clock time ahead of the clock
+            EXPECT_LT(output.first, output.second + 10 * 1000 + 1000);
+        }
+    }
+}
+
+TEST(ReplayClock_GTest, removed_source_does_not_hold_back_the_others) {
+    ReplayClockConfig config;
+    config.speed_factor = 0.;
+    ReplayClock clock(config);
+    const size_t id0 = clock.get_pimpl().add_source();
+    const size_t id1 = clock.get_pimpl().add_source();
+
+    // GIVEN a source waiting for the start of the replay
+    std::atomic<bool> started{false};
+    std::thread thread([&]() { started = clock.get_pimpl().start_source(id0, 0); });
+
+    // WHEN the other source is removed before starting
+    clock.get_pimpl().remove_source(id1);
+    thread.join();
+
+    // THEN the replay starts
+    EXPECT_TRUE(started);
+    EXPECT_EQ(0, clock.get_time());
+}
+
+TEST(ReplayClock_GTest, invalid_config_throws) {
+    ReplayClockConfig config;
+    config.speed_factor = -1.;
+    EXPECT_THROW(ReplayClock clock(config), CameraException);
+    config.speed_factor = 1.;
+    config.lock_step_us = 0;
+    EXPECT_THROW(ReplayClock clock(config), CameraException);
+}
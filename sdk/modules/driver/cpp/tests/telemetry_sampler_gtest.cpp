@@ -0,0 +1,227 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "metavision/hal/facilities/i_event_rate_noise_filter_module.h"
+#include "metavision/hal/facilities/i_monitoring.h"
+#include "metavision/sdk/base/utils/metrics_registry.h"
+#include "metavision/sdk/driver/telemetry_sampler.h"
+
+using namespace Metavision;
+
+namespace {
+
+// Returns the number of reads as temperature and illumination, so that a torn snapshot would show different values
+class MockMonitoring : public I_Monitoring {
+public:
+    int get_temperature() override {
+        if (fail) {
+            throw std::runtime_error("read failure");
+        }
+        return ++num_reads;
+    }
+
+    int get_illumination() override {
+        return num_reads;
+    }
+
+    std::atomic<bool> fail{false};
+    std::atomic<int> num_reads{0};
+};
+
+class MockNoiseFilter : public I_EventRateNoiseFilterModule {
+public:
+    void enable(bool) override {}
+
+    bool set_event_rate_threshold(uint32_t) override {
+        return true;
+    }
+
+    uint32_t get_event_rate_threshold() override {
+        return 42;
+    }
+};
+
+template<typename F>
+bool wait_for(F &&predicate) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!predicate()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+TEST(TelemetrySampler_GTest, invalid_rate) {
+    EXPECT_THROW(TelemetrySampler(nullptr, nullptr, nullptr, 0.), std::invalid_argument);
+    EXPECT_THROW(TelemetrySampler(nullptr, nullptr, nullptr, -1.), std::invalid_argument);
+}
+
+TEST(TelemetrySampler_GTest, samples_facilities_in_background) {
+    MockMonitoring monitoring;
+    MockNoiseFilter noise_filter;
+    TelemetrySampler sampler(&monitoring, nullptr, &noise_filter, 1000.);
+
+    std::mutex mutex;
+    std::vector<uint64_t> sample_indexes;
+    sampler.set_sample_callback([&](const TelemetrySnapshot &snapshot) {
+        std::lock_guard<std::mutex> lock(mutex);
+        sample_indexes.push_back(snapshot.sample_index);
+    });
+
+    // No sample is available before the sampler is started
+    EXPECT_EQ(0u, sampler.get_latest().sample_index);
+    EXPECT_FALSE(sampler.get_latest().has_monitoring);
+
+    sampler.start();
+    ASSERT_TRUE(wait_for([&]() { return sampler.get_latest().sample_index >= 3; }));
+    sampler.stop();
+
+    const auto snapshot = sampler.get_latest();
+    EXPECT_TRUE(snapshot.has_monitoring);
+    EXPECT_EQ(monitoring.num_reads.load(), snapshot.temperature_c);
+    EXPECT_EQ(snapshot.temperature_c, snapshot.illumination_lux);
+    EXPECT_FALSE(snapshot.has_erc);
+    EXPECT_TRUE(snapshot.has_noise_filter);
+    EXPECT_EQ(42u, snapshot.noise_filter_threshold_kev_s);
+    EXPECT_EQ(-1, snapshot.event_timestamp_us);
+
+    // The callback was called with each snapshot, in order
+    std::lock_guard<std::mutex> lock(mutex);
+    ASSERT_EQ(snapshot.sample_index, sample_indexes.size());
+    for (size_t i = 0; i < sample_indexes.size(); ++i) {
+        EXPECT_EQ(i + 1, sample_indexes[i]);
+    }
+}
+
+TEST(TelemetrySampler_GTest, correlates_samples_with_events) {
+    TelemetrySampler sampler(nullptr, nullptr, nullptr, 1000.);
+    std::mutex mutex;
+    std::vector<TelemetrySnapshot> snapshots;
+    sampler.set_sample_callback([&](const TelemetrySnapshot &snapshot) {
+        std::lock_guard<std::mutex> lock(mutex);
+        snapshots.push_back(snapshot);
+    });
+
+    std::vector<EventCD> events(100, EventCD(0, 0, 0, 0));
+    for (size_t i = 0; i < events.size(); ++i) {
+        events[i].t = 1000 + i;
+    }
+    sampler.process_events(events.data(), events.data() + events.size());
+    sampler.process_events(events.data(), events.data());
+
+    sampler.start();
+    ASSERT_TRUE(wait_for([&]() { return sampler.get_latest().sample_index >= 1; }));
+    sampler.process_events(events.data(), events.data() + 50);
+    ASSERT_TRUE(wait_for([&]() { return sampler.get_latest().num_events == 150; }));
+    sampler.stop();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto &first = snapshots.front();
+    EXPECT_EQ(1099, first.event_timestamp_us);
+    EXPECT_EQ(100u, first.num_events);
+    EXPECT_FALSE(first.has_monitoring);
+
+    // The event rate is measured between two samples, the first one seeing the new events measuring it
+    for (size_t i = 1; i < snapshots.size(); ++i) {
+        EXPECT_GE(snapshots[i].host_time_us, snapshots[i - 1].host_time_us);
+        if (snapshots[i].num_events != snapshots[i - 1].num_events) {
+            EXPECT_EQ(150u, snapshots[i].num_events);
+            EXPECT_EQ(1049, snapshots[i].event_timestamp_us);
+            EXPECT_GT(snapshots[i].event_rate, 0.);
+        } else {
+            EXPECT_EQ(0., snapshots[i].event_rate);
+        }
+    }
+}
+
+TEST(TelemetrySampler_GTest, failing_facility_is_flagged_unavailable) {
+    MockMonitoring monitoring;
+    monitoring.fail = true;
+    TelemetrySampler sampler(&monitoring, nullptr, nullptr, 1000.);
+    sampler.start();
+    ASSERT_TRUE(wait_for([&]() { return sampler.get_latest().sample_index >= 2; }));
+    EXPECT_FALSE(sampler.get_latest().has_monitoring);
+
+    monitoring.fail = false;
+    ASSERT_TRUE(wait_for([&]() { return sampler.get_latest().has_monitoring; }));
+}
+
+TEST(TelemetrySampler_GTest, concurrent_readers_get_consistent_snapshots) {
+    MockMonitoring monitoring;
+    TelemetrySampler sampler(&monitoring, nullptr, nullptr, 100000.);
+    sampler.start();
+
+    std::atomic<bool> torn{false};
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; ++i) {
+        readers.emplace_back([&]() {
+            uint64_t last_index = 0;
+            for (int j = 0; j < 20000; ++j) {
+                const auto snapshot = sampler.get_latest();
+                if (snapshot.temperature_c != snapshot.illumination_lux || snapshot.sample_index < last_index ||
+                    (snapshot.sample_index > 0 && !snapshot.has_monitoring)) {
+                    torn = true;
+                }
+                last_index = snapshot.sample_index;
+            }
+        });
+    }
+    for (auto &reader : readers) {
+        reader.join();
+    }
+    sampler.stop();
+    EXPECT_FALSE(torn);
+    EXPECT_GT(sampler.get_latest().sample_index, 0u);
+}
+
+TEST(TelemetrySampler_GTest, reports_metrics) {
+    auto find_temperature = [](const std::vector<MetricSample> &samples) {
+        return std::find_if(samples.cbegin(), samples.cend(), [](const MetricSample &s) {
+            return s.name_ == "metavision_device_temperature_celsius" && s.labels_.size() == 1 &&
+                   s.labels_[0].second == "gtest_device";
+        });
+    };
+    {
+        MockMonitoring monitoring;
+        TelemetrySampler sampler(&monitoring, nullptr, nullptr, 1000.);
+        sampler.register_metrics("gtest_device");
+
+        // Nothing is reported before the first sample
+        auto samples = MetricsRegistry::instance().snapshot();
+        EXPECT_EQ(samples.cend(), find_temperature(samples));
+
+        sampler.start();
+        ASSERT_TRUE(wait_for([&]() { return sampler.get_latest().sample_index >= 1; }));
+        sampler.stop();
+
+        samples = MetricsRegistry::instance().snapshot();
+        auto it = find_temperature(samples);
+        ASSERT_NE(samples.cend(), it);
+        EXPECT_EQ(static_cast<double>(sampler.get_latest().temperature_c), it->value_);
+    }
+
+    // The metrics are removed with the sampler
+    const auto samples = MetricsRegistry::instance().snapshot();
+    EXPECT_EQ(samples.cend(), find_temperature(samples));
+}
@@ -0,0 +1,116 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_UI_DETAIL_EVENT_FRAME_RENDERER_H
+#define METAVISION_SDK_UI_DETAIL_EVENT_FRAME_RENDERER_H
+
+#include <GL/glew.h>
+#include <array>
+#include <cstdint>
+#include <vector>
+#include <opencv2/core.hpp>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/base/utils/timestamp.h"
+
+namespace Metavision {
+namespace detail {
+
+/// @brief Generates frames from CD events on the GPU
+///
+/// The events are uploaded to the GPU, where they update a texture holding the timestamp and polarity of the last event
+/// of each pixel. The frames are then colored from this texture as done by @ref BaseFrameGenerationAlgorithm, in any
+/// framebuffer of the size of the sensor. It is shared by the on screen and offscreen renderings.
+/// @warning The same OpenGL 3.3 context must be current when calling the constructor, the destructor and the methods
+class EventFrameRenderer {
+public:
+    /// @brief Constructor
+    /// @param width Width of the sensor
+    /// @param height Height of the sensor
+    /// @throw std::runtime_error if the OpenGL objects can not be created
+    EventFrameRenderer(int width, int height);
+
+    /// @brief Destructor
+    ~EventFrameRenderer();
+
+    /// @brief Uploads events to the GPU and updates the timestamps texture with them
+    /// @param begin Pointer to the first event
+    /// @param end Pointer to the past-the-end event
+    /// @warning The events are expected to be ordered by timestamps
+    void process_events(const EventCD *begin, const EventCD *end);
+
+    /// @brief Renders the frame at a given timestamp, generated from the events processed so far
+    /// @param ts Timestamp of the frame, the events older than @p ts minus the accumulation time are not displayed
+    /// @param accumulation_time_us Time range of events displayed in the frame (in us)
+    /// @param colors Off, on and background colors
+    /// @param is_gray Whether the framebuffer only has a red channel, which is then set from the first channel of the
+    /// colors. Otherwise, the framebuffer is expected in RGB
+    /// @param framebuffer Framebuffer in which the frame is rendered
+    void render(timestamp ts, uint32_t accumulation_time_us, const std::array<cv::Vec3b, 3> &colors, bool is_gray,
+                GLuint framebuffer);
+
+    /// @brief Forgets the events processed so far
+    void reset();
+
+private:
+    /// @brief Event as uploaded to the GPU: its coordinates and its timestamp relative to @ref ts_offset_, shifted by
+    /// one bit to store the polarity
+    struct GPUEvent {
+        uint16_t x, y;
+        int32_t ts_p;
+    };
+
+    /// @brief Number of events of a segment of the events buffer
+    static constexpr int SegmentSize = 1 << 16;
+
+    /// @brief Number of segments of the events buffer. The GPU reads a segment while the next ones are written
+    static constexpr int NumSegments = 3;
+
+    void create_gl_objects();
+    void delete_gl_objects();
+
+    /// @brief Converts the events to their GPU format and splats them into the timestamps texture
+    void upload_and_splat(const EventCD *begin, const EventCD *end);
+
+    /// @brief Shifts the timestamps of the texture so that relative timestamps up to @p ts fit in it
+    void rebase_timestamps(timestamp ts);
+
+    /// @brief Clears the timestamps texture
+    void clear_timestamps();
+
+    /// @brief Draws a quad covering the current framebuffer
+    void draw_quad();
+
+    int width_, height_;
+
+    timestamp ts_offset_{0};    ///< Timestamp corresponding to 0 in the timestamps texture
+    bool has_ts_offset_{false}; ///< Whether the offset has been set from the first processed event
+
+    GLuint splat_program_{0};
+    GLuint color_program_{0};
+    GLuint rebase_program_{0};
+    std::array<GLuint, 2> ts_textures_{};     ///< Timestamps textures, the second one is used to rebase the timestamps
+    std::array<GLuint, 2> ts_framebuffers_{}; ///< Framebuffers rendering in the timestamps textures
+    GLuint quad_vertex_array_{0};
+    GLuint quad_buffer_{0};
+    GLuint events_vertex_array_{0};
+    GLuint events_buffer_{0};
+
+    GPUEvent *mapped_events_{nullptr};                  ///< Persistently mapped events buffer, if supported
+    std::array<GLsync, NumSegments> segment_fences_{}; ///< Fences on the GPU reading the segments of the buffer
+    int segment_{0};                                    ///< Next segment of the buffer to write
+    std::vector<GPUEvent> staging_events_;              ///< Events to upload when the buffer can not be mapped
+};
+
+} // namespace detail
+} // namespace Metavision
+
+#endif // METAVISION_SDK_UI_DETAIL_EVENT_FRAME_RENDERER_H
@@ -0,0 +1,26 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SHADER_UTILS_H
+#define METAVISION_SHADER_UTILS_H
+
+namespace Metavision {
+namespace detail {
+
+/// @brief Compiles and links a program from the sources of its vertex and fragment shaders
+///
+/// Compilation and link errors are logged
+unsigned int load_program(const char *vertex_shader_str, const char *fragment_shader_str);
+
+} // namespace detail
+} // namespace Metavision
+
+#endif // METAVISION_SHADER_UTILS_H
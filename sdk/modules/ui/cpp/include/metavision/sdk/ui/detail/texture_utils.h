@@ -21,6 +21,13 @@ unsigned int initialize_texture(int width, int height, bool is_gray);
 
 void upload_texture(const cv::Mat &img, const unsigned int &tex_id);
 
+// Same as above, but the image is copied in a pixel buffer object from which the texture is updated asynchronously,
+// so that the call does not wait for the GPU to be done with the previous content of the texture
+void upload_texture(const cv::Mat &img, const unsigned int &tex_id, const unsigned int &pbo_id);
+
+// Creates a framebuffer rendering in a texture. Throws std::runtime_error if the framebuffer is not complete
+unsigned int create_framebuffer(unsigned int tex_id);
+
 } // namespace detail
 } // namespace Metavision
 
@@ -0,0 +1,136 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_UI_EVENT_DISPLAY_STAGE_H
+#define METAVISION_SDK_UI_EVENT_DISPLAY_STAGE_H
+
+#include <cmath>
+#include <vector>
+#include <boost/any.hpp>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/base/utils/sdk_log.h"
+#include "metavision/sdk/core/pipeline/base_stage.h"
+#include "metavision/sdk/core/pipeline/pipeline.h"
+#include "metavision/sdk/ui/utils/event_window.h"
+#include "metavision/sdk/ui/utils/event_loop.h"
+
+namespace Metavision {
+
+/// @brief Stage that displays the input CD events in a window, the frames being generated on the GPU
+///
+/// The window is refreshed when the input events reach the next frame period (see @ref EventWindow).
+class EventDisplayStage : public BaseStage {
+public:
+    using EventBuffer     = std::vector<EventCD>;
+    using EventBufferPool = SharedObjectPool<EventBuffer>;
+    using EventBufferPtr  = EventBufferPool::ptr_type;
+
+    /// @brief Constructs a new event display stage
+    /// @param title Window's title
+    /// @param width Sensor's width, and window's initial width
+    /// @param height Sensor's height, and window's initial height
+    /// @param accumulation_time_us Time range of events displayed in a frame (in us)
+    /// @param fps Frame rate of the display, the time reference being the one of the input events
+    /// @param palette The color palette to use
+    /// @param auto_exit Flag indicating if the application automatically closes if the user presses 'Q' or 'ESCAPE'
+    EventDisplayStage(const std::string &title, int width, int height, uint32_t accumulation_time_us = 10000,
+                      double fps = 25., const ColorPalette &palette = BaseFrameGenerationAlgorithm::default_palette(),
+                      bool auto_exit = true) :
+        window_(title, width, height, accumulation_time_us, palette),
+        frame_period_us_(static_cast<timestamp>(std::round(1000000 / fps))) {
+        init(auto_exit);
+    }
+
+    /// @brief Constructs a new event display stage given an explicit previous stage
+    /// @param prev_stage Stage producing the input events for this display stage
+    /// @param title Window's title
+    /// @param width Sensor's width, and window's initial width
+    /// @param height Sensor's height, and window's initial height
+    /// @param accumulation_time_us Time range of events displayed in a frame (in us)
+    /// @param fps Frame rate of the display, the time reference being the one of the input events
+    /// @param palette The color palette to use
+    /// @param auto_exit Flag indicating if the application automatically closes if the user presses 'Q' or 'ESCAPE'
+    EventDisplayStage(BaseStage &prev_stage, const std::string &title, int width, int height,
+                      uint32_t accumulation_time_us = 10000, double fps = 25.,
+                      const ColorPalette &palette = BaseFrameGenerationAlgorithm::default_palette(),
+                      bool auto_exit = true) :
+        EventDisplayStage(title, width, height, accumulation_time_us, fps, palette, auto_exit) {
+        set_previous_stage(prev_stage);
+    }
+
+    /// @brief Sets a callback that is called when the user presses a key
+    ///
+    /// @note The callback is only called when the window has the focus
+    /// @param cb The callback to call
+    void set_key_callback(const EventWindow::KeyCallback &cb) {
+        on_key_cb_ = cb;
+    }
+
+    /// @brief Gets the window
+    EventWindow &window() {
+        return window_;
+    }
+
+private:
+    void init(bool auto_exit) {
+        static bool is_pre_step_cb_set = false;
+        if (!is_pre_step_cb_set) {
+            set_setup_callback([this]() {
+                pipeline().add_pre_step_callback([]() { EventLoop::poll_and_dispatch(); });
+                // the main thread sleeps until a window event or a task to run
+                pipeline().set_main_thread_wait_callbacks(
+                    [](std::chrono::milliseconds timeout) { EventLoop::wait_and_dispatch(timeout.count()); },
+                    []() { EventLoop::wake_up(); });
+            });
+            is_pre_step_cb_set = true;
+        }
+
+        set_consuming_callback([this](const boost::any &data) {
+            try {
+                auto buffer = boost::any_cast<EventBufferPtr>(data);
+                if (!buffer || buffer->empty())
+                    return;
+
+                window_.process_events(buffer->data(), buffer->data() + buffer->size());
+
+                // Only the last frame period reached by the buffer is displayed
+                const timestamp last_ts = buffer->back().t;
+                if (last_ts >= next_frame_ts_) {
+                    window_.show(last_ts);
+                    next_frame_ts_ = (last_ts / frame_period_us_ + 1) * frame_period_us_;
+                }
+            } catch (boost::bad_any_cast &c) { MV_SDK_LOG_ERROR() << c.what(); }
+        });
+
+        window_.set_keyboard_callback([this, auto_exit](UIKeyEvent key, int scancode, UIAction action, int mods) {
+            on_key_cb_(key, scancode, action, mods);
+
+            if (auto_exit) {
+                if (action == UIAction::RELEASE) {
+                    if (key == UIKeyEvent::KEY_ESCAPE || key == UIKeyEvent::KEY_Q)
+                        this->pipeline().cancel();
+                }
+            }
+        });
+
+        on_key_cb_ = [](UIKeyEvent key, int scancode, UIAction action, int mods) {};
+    }
+
+    EventWindow window_;
+    EventWindow::KeyCallback on_key_cb_;
+    const timestamp frame_period_us_;
+    timestamp next_frame_ts_{0};
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_UI_EVENT_DISPLAY_STAGE_H
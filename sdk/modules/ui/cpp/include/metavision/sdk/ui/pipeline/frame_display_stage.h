@@ -25,7 +25,8 @@ namespace Metavision {
 
 /// @brief Stage that displays the input frame in a window
 ///
-/// The window is refreshed every time a new frame is received.
+/// The window is refreshed every time a new frame is received, unless only the latest frame is displayed (see
+/// @ref set_latest_frame_only).
 class FrameDisplayStage : public BaseStage {
 public:
     using FramePool = SharedObjectPool<cv::Mat>;
@@ -65,12 +66,36 @@ public:
         on_key_cb_ = cb;
     }
 
+    /// @brief Sets whether only the most recent frame is displayed
+    ///
+    /// When enabled, the frames received while the window is busy are not queued: only the most recent one is
+    /// displayed next and the older ones are dropped. This bounds the display latency when the window refreshes slower
+    /// than the frames are produced, at the cost of completeness. By default, every frame is displayed.
+    /// @param enable True to display the most recent frame only, false to display every frame
+    void set_latest_frame_only(bool enable) {
+        if (enable)
+            set_input_queue_limit(1, InputQueuePolicy::Coalesce);
+        else
+            set_input_queue_limit(0);
+    }
+
+    /// @brief Gets the number of frames dropped without being displayed, see @ref set_latest_frame_only
+    /// @return The number of dropped frames
+    size_t num_dropped_frames() const {
+        return num_dropped_inputs();
+    }
+
 private:
     void init(bool auto_exit) {
         static bool is_pre_step_cb_set = false;
         if (!is_pre_step_cb_set) {
-            set_setup_callback(
-                [this]() { pipeline().add_pre_step_callback([]() { EventLoop::poll_and_dispatch(); }); });
+            set_setup_callback([this]() {
+                pipeline().add_pre_step_callback([]() { EventLoop::poll_and_dispatch(); });
+                // the main thread sleeps until a window event or a task to run
+                pipeline().set_main_thread_wait_callbacks(
+                    [](std::chrono::milliseconds timeout) { EventLoop::wait_and_dispatch(timeout.count()); },
+                    []() { EventLoop::wake_up(); });
+            });
             is_pre_step_cb_set = true;
         }
 
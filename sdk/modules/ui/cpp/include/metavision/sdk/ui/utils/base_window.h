@@ -14,9 +14,11 @@
 
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
+#include <array>
 #include <functional>
 #include <queue>
 #include <mutex>
+#include <opencv2/core.hpp>
 
 #include "metavision/sdk/ui/utils/ui_event.h"
 
@@ -100,15 +102,29 @@ protected:
     /// @param height Height of the window at starting time (can be resized later on) and height of the images that will
     /// be displayed
     /// @param mode The color rendering mode (i.e. either GRAY or BGR). Cannot be modified.
+    /// @param shared_context If not null, the window's context shares its objects (e.g. textures, buffers) with this
+    /// one
     /// @warning Must only be called from the main thread
-    BaseWindow(const std::string &title, int width, int height, RenderMode mode);
+    BaseWindow(const std::string &title, int width, int height, RenderMode mode,
+               GLFWwindow *shared_context = nullptr);
 
     /// @brief No copy allowed
     BaseWindow(const BaseWindow &) = delete;
 
+    /// @brief Initializes GLFW and the GL extensions if not already done
+    /// @warning Must only be called from the main thread
+    static void initialize_glfw();
+
     /// @brief Displays the image as a textured quad
     void draw_background_texture();
 
+    /// @brief Uploads the image to display to the texture
+    ///
+    /// The image is uploaded through the next pixel buffer object of a ring, so that the GPU transfers it while the
+    /// next images are uploaded. The window's context must be current
+    /// @param image The image to upload
+    void upload_background_texture(const cv::Mat &image);
+
     GLFWwindow *glfwWindow_;
     int width_;
     int height_;
@@ -120,7 +136,15 @@ protected:
     GLuint program_id_;
     GLuint tex_id_;
 
+    /// @brief Number of pixel buffer objects used to upload the images
+    static constexpr int NumPixelBuffers = 3;
+
+    std::array<GLuint, NumPixelBuffers> pbo_ids_;
+    int next_pbo_;
+
 private:
+    friend class MTWindowGroup;
+
     struct SystemEvent {
         enum class EventType { MOUSE, KEYBOARD, CURSOR };
         EventType event_type_;
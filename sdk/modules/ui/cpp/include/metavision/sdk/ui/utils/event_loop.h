@@ -23,6 +23,18 @@ public:
     /// @param sleep_time_ms Amount of time in ms this call will wait after polling and dispatching the events
     /// @warning Must only be called from the main thread
     static void poll_and_dispatch(std::int64_t sleep_time_ms = 0);
+
+    /// @brief Waits for events from the system and pushes them into the corresponding windows' internal queue
+    ///
+    /// Contrary to @ref poll_and_dispatch, the thread sleeps until an event is received, @ref wake_up is called or the
+    /// timeout elapses.
+    /// @param timeout_ms Maximum amount of time in ms to wait for an event
+    /// @warning Must only be called from the main thread
+    static void wait_and_dispatch(std::int64_t timeout_ms);
+
+    /// @brief Interrupts the wait of @ref wait_and_dispatch, or the next one if none is in progress
+    /// @note Can be called from any thread, once a window has been created
+    static void wake_up();
 };
 } // namespace Metavision
 
@@ -0,0 +1,98 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_UI_EVENT_WINDOW_H
+#define METAVISION_SDK_UI_EVENT_WINDOW_H
+
+#include <array>
+#include <cstdint>
+#include <memory>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/base/utils/timestamp.h"
+#include "metavision/sdk/core/algorithms/base_frame_generation_algorithm.h"
+#include "metavision/sdk/ui/utils/base_window.h"
+
+namespace Metavision {
+namespace detail {
+class EventFrameRenderer;
+} // namespace detail
+
+/// @brief A window that displays CD events, the frames being generated on the GPU
+///
+/// The events are uploaded to the GPU, where they update a texture holding the timestamp and polarity of the last event
+/// of each pixel. The frames are then colored from this texture as done by @ref BaseFrameGenerationAlgorithm: a pixel
+/// is displayed with the color of the polarity of its last event if it occurred less than the accumulation time before
+/// the displayed timestamp, and with the background color otherwise. Neither the frames are generated nor uploaded by
+/// the CPU.
+///
+/// When the GPU supports persistent buffer mappings (GL_ARB_buffer_storage), the events are written in a buffer mapped
+/// once and for all, otherwise they are uploaded with each call to @ref process_events.
+/// @warning The constructor and destructor of this class must only be called from the main thread. The other methods
+/// must be called from the same thread, as they make the window's OpenGL context current
+class EventWindow : public BaseWindow {
+public:
+    /// @brief Constructs a new EventWindow
+    /// @param title The window's title
+    /// @param width Width of the window at starting time (can be resized later on) and width of the sensor
+    /// @param height Height of the window at starting time (can be resized later on) and height of the sensor
+    /// @param accumulation_time_us Time range of events displayed in a frame (in us)
+    /// @param palette The color palette to use. The window's rendering mode is @ref RenderMode::GRAY for the
+    /// @ref ColorPalette::Gray palette and @ref RenderMode::BGR otherwise
+    /// @throw std::runtime_error if the OpenGL objects can not be created
+    /// @warning Must only be called from the main thread
+    EventWindow(const std::string &title, int width, int height, uint32_t accumulation_time_us = 10000,
+                const ColorPalette &palette = BaseFrameGenerationAlgorithm::default_palette());
+
+    /// @brief Destructor
+    /// @warning Must only be called from the main thread
+    virtual ~EventWindow();
+
+    /// @brief Uploads events to the GPU and updates the timestamps texture with them
+    /// @param begin Pointer to the first event
+    /// @param end Pointer to the past-the-end event
+    /// @warning The events are expected to be ordered by timestamps
+    void process_events(const EventCD *begin, const EventCD *end);
+
+    /// @brief Displays the frame at a given timestamp, generated from the events processed so far
+    /// @param ts Timestamp of the frame, the events older than @p ts minus the accumulation time are not displayed
+    /// @param auto_poll If True, events in this window's queue are dequeued and processed. If false,
+    /// @ref BaseWindow::poll_events must explicitly be called.
+    void show(timestamp ts, bool auto_poll = true);
+
+    /// @brief Sets the accumulation time (in us) used to generate the frames
+    void set_accumulation_time_us(uint32_t accumulation_time_us);
+
+    /// @brief Returns the current accumulation time (in us)
+    uint32_t get_accumulation_time_us() const;
+
+    /// @brief Sets the colors used to generate the frames
+    /// @param bg_color Color used as background, when no events were received for a pixel
+    /// @param on_color Color used for on events
+    /// @param off_color Color used for off events
+    /// @note Only the first channel of the colors is used in @ref RenderMode::GRAY
+    void set_colors(const cv::Vec3b &bg_color, const cv::Vec3b &on_color, const cv::Vec3b &off_color);
+
+    /// @brief Forgets the events processed so far
+    void reset();
+
+private:
+    uint32_t accumulation_time_us_;
+    int sensor_width_, sensor_height_; ///< Size of the frames, the one of the window may change
+    std::array<cv::Vec3b, 3> colors_;  ///< Off, on and background colors
+
+    std::unique_ptr<detail::EventFrameRenderer> renderer_;
+    GLuint color_framebuffer_{0}; ///< Framebuffer rendering in the texture displayed by the window
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_UI_EVENT_WINDOW_H
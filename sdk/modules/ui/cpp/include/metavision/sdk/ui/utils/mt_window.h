@@ -12,6 +12,7 @@
 #ifndef METAVISION_SDK_UI_MT_WINDOW_H
 #define METAVISION_SDK_UI_MT_WINDOW_H
 
+#include <mutex>
 #include <thread>
 #include <opencv2/core.hpp>
 
@@ -19,9 +20,12 @@
 
 namespace Metavision {
 
+class MTWindowGroup;
+
 /// @brief Window using its own rendering thread to render images
 ///
-/// Images are displayed at a fixed frequency (i.e. the screen's refresh one) by the internal rendering thread.
+/// Images are displayed at a fixed frequency (i.e. the screen's refresh one) by the internal rendering thread. When
+/// many windows are displayed, they can instead be rendered by the single thread of a @ref MTWindowGroup.
 /// @warning The constructor and destructor of this class must only be called from the main thread
 class MTWindow : public BaseWindow {
 public:
@@ -35,6 +39,17 @@ public:
     /// @warning Must only be called from the main thread
     MTWindow(const std::string &title, int width, int height, RenderMode mode);
 
+    /// @brief Constructor of a window rendered by the rendering thread of a group of windows
+    /// @param title The window's title
+    /// @param width Width of the window at starting time (can be resized later on) and width of the images that will be
+    /// displayed
+    /// @param height Height of the window at starting time (can be resized later on) and height of the images that will
+    /// be displayed
+    /// @param mode The color rendering mode (i.e. either GRAY or BGR). Cannot be modified.
+    /// @param group The group rendering the window, which must outlive it
+    /// @warning Must only be called from the main thread
+    MTWindow(const std::string &title, int width, int height, RenderMode mode, MTWindowGroup &group);
+
     /// @brief Destructor
     /// @warning Must only be called from the main thread
     virtual ~MTWindow();
@@ -53,13 +68,26 @@ public:
     void show_async(cv::Mat &image, bool auto_poll = true);
 
 private:
+    friend class MTWindowGroup;
+
+    /// @brief Constructor holding the lock of the group's contexts while the window is created and added to the group
+    MTWindow(const std::string &title, int width, int height, RenderMode mode, MTWindowGroup &group,
+             std::unique_lock<std::mutex> &&group_lock);
+
     /// @brief The internal rendering thread
     void rendering_loop();
 
+    /// @brief If the front buffer has been updated, swaps the front and back buffers
+    /// @return True if the back buffer holds a new image to upload, false otherwise
+    bool swap_buffers_if_updated();
+
     /// @brief If the front buffer has been updated, swaps the front and back buffers and uploads the back buffer to the
     /// GPU.
     void upload_texture_if_updated();
 
+    MTWindowGroup *group_;
+    int swap_interval_;
+
     bool has_been_updated_;
     std::mutex swap_mtx_;
     cv::Mat front_;
@@ -0,0 +1,98 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_UI_MT_WINDOW_GROUP_H
+#define METAVISION_SDK_UI_MT_WINDOW_GROUP_H
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "metavision/sdk/ui/utils/mt_window.h"
+
+namespace Metavision {
+
+/// @brief Group of @ref MTWindow rendered by a single rendering thread
+///
+/// When many windows are displayed (e.g. one per camera), giving each of them its own rendering thread wastes CPU time
+/// in context switches and GPU time waiting for the V-Sync of every window. Instead, the windows of a group share their
+/// GL objects (i.e. textures and buffers) with a hidden context, from which the images of all the windows are uploaded
+/// at once through a shared ring of pixel buffer objects, before all the windows are drawn. Only the first window drawn
+/// waits for the V-Sync, so that all the windows are refreshed once per screen refresh.
+/// @code
+/// Metavision::MTWindowGroup group;
+/// std::vector<std::unique_ptr<Metavision::MTWindow>> windows;
+/// for (int i = 0; i < num_cameras; ++i)
+///     windows.emplace_back(std::make_unique<Metavision::MTWindow>("Camera " + std::to_string(i), width, height,
+///                                                                 Metavision::BaseWindow::RenderMode::BGR, group));
+/// @endcode
+/// @warning The constructor and destructor of this class must only be called from the main thread, and the windows of
+/// the group must be destroyed before it
+class MTWindowGroup {
+public:
+    /// @brief Constructor
+    /// @warning Must only be called from the main thread
+    MTWindowGroup();
+
+    /// @brief Destructor
+    /// @warning Must only be called from the main thread, once all the windows of the group have been destroyed
+    ~MTWindowGroup();
+
+    /// @brief No copy allowed
+    MTWindowGroup(const MTWindowGroup &) = delete;
+
+    /// @brief No copy allowed
+    MTWindowGroup &operator=(const MTWindowGroup &) = delete;
+
+    /// @brief Gets the number of windows rendered by the group
+    /// @return The number of windows in the group
+    size_t get_num_windows() const;
+
+private:
+    friend class MTWindow;
+
+    /// @brief Acquires the lock that the rendering thread holds while rendering a frame
+    ///
+    /// The rendering thread gives the lock to the callers waiting for it before rendering the next frame.
+    std::unique_lock<std::mutex> lock_contexts();
+
+    /// @brief Adds a window to render, must be called with the lock of the contexts held
+    void add_window(MTWindow *window);
+
+    /// @brief Removes a window from the ones to render, must be called with the lock of the contexts held
+    void remove_window(MTWindow *window);
+
+    /// @brief The internal rendering thread
+    void rendering_loop();
+
+    GLFWwindow *shared_context_;
+
+    /// @brief Number of pixel buffer objects used to upload the images of all the windows
+    static constexpr int NumPixelBuffers = 3;
+
+    std::array<GLuint, NumPixelBuffers> pbo_ids_;
+    int next_pbo_;
+
+    std::vector<MTWindow *> windows_;
+    mutable std::mutex contexts_mtx_;
+    std::condition_variable contexts_cond_;
+    std::atomic<int> num_waiting_callers_;
+    bool stop_;
+
+    std::thread rendering_loop_;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_UI_MT_WINDOW_GROUP_H
@@ -0,0 +1,137 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_UI_OFFSCREEN_EVENT_FRAME_GENERATOR_H
+#define METAVISION_SDK_UI_OFFSCREEN_EVENT_FRAME_GENERATOR_H
+
+#include <GL/glew.h>
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <vector>
+#include <opencv2/core.hpp>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/base/utils/timestamp.h"
+#include "metavision/sdk/core/algorithms/base_frame_generation_algorithm.h"
+
+namespace Metavision {
+namespace detail {
+class EventFrameRenderer;
+} // namespace detail
+
+/// @brief Generates frames from CD events on the GPU without any window or display, e.g. on headless servers
+///
+/// The frames are generated as by @ref EventWindow, in an offscreen OpenGL context created with EGL, so that neither
+/// X11 nor GLFW are needed. They are read back asynchronously through pixel buffer objects: a call to @ref generate
+/// only queues the rendering and the transfer of a frame, which is passed to the output callback once the GPU is done
+/// with it, while the next frames are rendered. Up to the number of readback buffers frames are hence in flight.
+///
+/// The EGL display is the first GPU enumerated by EGL_EXT_device_enumeration when available, and the default display
+/// otherwise.
+/// @note Only available when the SDK is built with EGL support
+/// @warning The methods of an instance must not be called concurrently. They make the context of the instance current
+/// on the calling thread and restore the previous one before returning
+class OffscreenEventFrameGenerator {
+public:
+    /// @brief Callback receiving the generated frames, only valid during the call
+    using OutputCallback = std::function<void(timestamp, cv::Mat &)>;
+
+    /// @brief Constructor
+    /// @param width Width of the sensor
+    /// @param height Height of the sensor
+    /// @param accumulation_time_us Time range of events displayed in a frame (in us)
+    /// @param palette The color palette to use. The frames are CV_8UC1 for the @ref ColorPalette::Gray palette and
+    /// CV_8UC3 (BGR) otherwise
+    /// @param num_readback_buffers Number of frames that can be read back concurrently
+    /// @throw std::runtime_error if the EGL context or the OpenGL objects can not be created
+    OffscreenEventFrameGenerator(int width, int height, uint32_t accumulation_time_us = 10000,
+                                 const ColorPalette &palette = BaseFrameGenerationAlgorithm::default_palette(),
+                                 int num_readback_buffers = 3);
+
+    /// @brief Destructor
+    ///
+    /// The frames still in flight are dropped, see @ref flush
+    ~OffscreenEventFrameGenerator();
+
+    /// @brief Sets the callback receiving the generated frames
+    void set_output_callback(const OutputCallback &output_cb);
+
+    /// @brief Uploads events to the GPU and updates the timestamps texture with them
+    /// @param begin Pointer to the first event
+    /// @param end Pointer to the past-the-end event
+    /// @warning The events are expected to be ordered by timestamps
+    void process_events(const EventCD *begin, const EventCD *end);
+
+    /// @brief Queues the generation of the frame at a given timestamp, from the events processed so far
+    ///
+    /// The frames whose readback is complete are passed to the output callback, in the order of the calls. If all the
+    /// readback buffers are in use, the call waits for the oldest frame.
+    /// @param ts Timestamp of the frame, the events older than @p ts minus the accumulation time are not displayed
+    void generate(timestamp ts);
+
+    /// @brief Waits for the frames in flight and passes them to the output callback
+    void flush();
+
+    /// @brief Sets the accumulation time (in us) used to generate the frames
+    void set_accumulation_time_us(uint32_t accumulation_time_us);
+
+    /// @brief Returns the current accumulation time (in us)
+    uint32_t get_accumulation_time_us() const;
+
+    /// @brief Sets the colors used to generate the frames
+    /// @param bg_color Color used as background, when no events were received for a pixel
+    /// @param on_color Color used for on events
+    /// @param off_color Color used for off events
+    /// @note Only the first channel of the colors is used with the @ref ColorPalette::Gray palette
+    void set_colors(const cv::Vec3b &bg_color, const cv::Vec3b &on_color, const cv::Vec3b &off_color);
+
+    /// @brief Forgets the events processed so far
+    void reset();
+
+private:
+    struct EGLState;
+    class ScopedContext;
+
+    /// @brief Buffer in which a frame is read back
+    struct Readback {
+        GLuint pbo{0};
+        GLsync fence{nullptr};
+        timestamp ts{0};
+    };
+
+    /// @brief Passes the oldest frame in flight to the output callback, waiting for it if @p wait is true
+    /// @return true if a frame has been output
+    bool output_oldest(bool wait);
+
+    void delete_gl_objects();
+
+    std::unique_ptr<EGLState> egl_;
+    int width_, height_;
+    bool is_gray_;
+    uint32_t accumulation_time_us_;
+    std::array<cv::Vec3b, 3> colors_; ///< Off, on and background colors
+    OutputCallback output_cb_;
+
+    std::unique_ptr<detail::EventFrameRenderer> renderer_;
+    GLuint color_texture_{0};
+    GLuint color_framebuffer_{0};
+    std::vector<Readback> readbacks_;
+    std::deque<size_t> in_flight_; ///< Indices of the readbacks in flight, oldest first
+    size_t next_readback_{0};
+    cv::Mat frame_;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_UI_OFFSCREEN_EVENT_FRAME_GENERATOR_H
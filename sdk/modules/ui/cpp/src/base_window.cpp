@@ -13,7 +13,9 @@
 #include <memory>
 
 #include "metavision/sdk/base/utils/sdk_log.h"
+#include "metavision/sdk/base/utils/trace.h"
 #include "metavision/sdk/ui/utils/base_window.h"
+#include "metavision/sdk/ui/detail/shader_utils.h"
 #include "metavision/sdk/ui/detail/texture_utils.h"
 
 static const std::map<char, int> name_to_key = {
@@ -24,86 +26,26 @@ static const std::map<char, int> name_to_key = {
     {'b', GLFW_KEY_B}, {'n', GLFW_KEY_N}, {',', GLFW_KEY_COMMA}};
 
 namespace Metavision {
-namespace detail {
-GLuint LoadShaders() {
-    const char *vertex_shader_str = "#version 330 core\n"
-                                    "layout(location = 0) in vec3 vertexPosition_modelspace;\n"
-                                    "layout(location = 1) in vec2 vertexUV;\n"
-                                    "out vec2 UV;\n"
-                                    "void main(){\n"
-                                    "    gl_Position.xyz = vertexPosition_modelspace;\n"
-                                    "    gl_Position.w = 1.0;\n"
-                                    "    UV = vertexUV;\n"
-                                    "}\n";
-
-    const char *fragment_shader_str = "#version 330 core\n"
-                                      "in vec2 UV;\n"
-                                      "out vec3 color;\n"
-                                      "uniform sampler2D Sampler;\n"
-                                      "void main(){\n"
-                                      "    color = texture( Sampler, UV ).rgb;\n"
-                                      "}\n";
-
-    // Create the shaders
-    GLuint vertex_shader_id   = glCreateShader(GL_VERTEX_SHADER);
-    GLuint fragment_shader_id = glCreateShader(GL_FRAGMENT_SHADER);
-
-    GLint result = GL_FALSE;
-    int info_log_length;
-
-    // Compile Vertex Shader
-    glShaderSource(vertex_shader_id, 1, &vertex_shader_str, NULL);
-    glCompileShader(vertex_shader_id);
-
-    // Check Vertex Shader
-    glGetShaderiv(vertex_shader_id, GL_COMPILE_STATUS, &result);
-    glGetShaderiv(vertex_shader_id, GL_INFO_LOG_LENGTH, &info_log_length);
-    if (info_log_length > 0) {
-        std::string VertexShaderErrorMessage;
-        VertexShaderErrorMessage.resize(info_log_length + 1);
-        glGetShaderInfoLog(vertex_shader_id, info_log_length, NULL, &VertexShaderErrorMessage[0]);
-        MV_SDK_LOG_ERROR() << VertexShaderErrorMessage;
-    }
-
-    // Compile Fragment Shader
-    glShaderSource(fragment_shader_id, 1, &fragment_shader_str, NULL);
-    glCompileShader(fragment_shader_id);
-
-    // Check Fragment Shader
-    glGetShaderiv(fragment_shader_id, GL_COMPILE_STATUS, &result);
-    glGetShaderiv(fragment_shader_id, GL_INFO_LOG_LENGTH, &info_log_length);
-    if (info_log_length > 0) {
-        std::string FragmentShaderErrorMessage;
-        FragmentShaderErrorMessage.resize(info_log_length + 1);
-        glGetShaderInfoLog(fragment_shader_id, info_log_length, NULL, &FragmentShaderErrorMessage[0]);
-        MV_SDK_LOG_ERROR() << FragmentShaderErrorMessage;
-    }
-
-    // Link the program
-    GLuint program_id = glCreateProgram();
-    glAttachShader(program_id, vertex_shader_id);
-    glAttachShader(program_id, fragment_shader_id);
-    glLinkProgram(program_id);
-
-    // Check the program
-    glGetProgramiv(program_id, GL_LINK_STATUS, &result);
-    glGetProgramiv(program_id, GL_INFO_LOG_LENGTH, &info_log_length);
-    if (info_log_length > 0) {
-        std::string ProgramErrorMessage;
-        ProgramErrorMessage.resize(info_log_length + 1);
-        glGetProgramInfoLog(program_id, info_log_length, NULL, &ProgramErrorMessage[0]);
-        MV_SDK_LOG_ERROR() << ProgramErrorMessage;
-    }
+namespace {
+const char *vertex_shader_str = "#version 330 core\n"
+                                "layout(location = 0) in vec3 vertexPosition_modelspace;\n"
+                                "layout(location = 1) in vec2 vertexUV;\n"
+                                "out vec2 UV;\n"
+                                "void main(){\n"
+                                "    gl_Position.xyz = vertexPosition_modelspace;\n"
+                                "    gl_Position.w = 1.0;\n"
+                                "    UV = vertexUV;\n"
+                                "}\n";
+
+const char *fragment_shader_str = "#version 330 core\n"
+                                  "in vec2 UV;\n"
+                                  "out vec3 color;\n"
+                                  "uniform sampler2D Sampler;\n"
+                                  "void main(){\n"
+                                  "    color = texture( Sampler, UV ).rgb;\n"
+                                  "}\n";
+} // namespace
 
-    glDetachShader(program_id, vertex_shader_id);
-    glDetachShader(program_id, fragment_shader_id);
-
-    glDeleteShader(vertex_shader_id);
-    glDeleteShader(fragment_shader_id);
-
-    return program_id;
-}
-} // namespace detail
 
 struct GLFWInitializer {
     GLFWInitializer() {
@@ -143,17 +85,24 @@ struct GLFWInitializer {
     }
 };
 
+constexpr int BaseWindow::NumPixelBuffers;
+
 static bool is_glfw_initialized_ = false;
 static std::unique_ptr<GLFWInitializer> glfw_initializer_;
 
-BaseWindow::BaseWindow(const std::string &title, int width, int height, RenderMode mode) :
-    width_(width), height_(height), render_mode_(mode) {
-    glfwWindow_ = nullptr;
-
+void BaseWindow::initialize_glfw() {
     if (!is_glfw_initialized_) {
         glfw_initializer_    = std::make_unique<GLFWInitializer>();
         is_glfw_initialized_ = true;
     }
+}
+
+BaseWindow::BaseWindow(const std::string &title, int width, int height, RenderMode mode,
+                       GLFWwindow *shared_context) :
+    width_(width), height_(height), render_mode_(mode) {
+    glfwWindow_ = nullptr;
+
+    initialize_glfw();
 
 #ifdef __APPLE__
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
@@ -162,7 +111,7 @@ BaseWindow::BaseWindow(const std::string &title, int width, int height, RenderMo
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
 #endif
 
-    glfwWindow_ = glfwCreateWindow(width, height, title.c_str(), nullptr, nullptr);
+    glfwWindow_ = glfwCreateWindow(width, height, title.c_str(), nullptr, shared_context);
     glfwDefaultWindowHints();
 
     if (!glfwWindow_)
@@ -170,9 +119,12 @@ BaseWindow::BaseWindow(const std::string &title, int width, int height, RenderMo
 
     glfwMakeContextCurrent(glfwWindow_);
 
-    program_id_ = detail::LoadShaders();
+    program_id_ = detail::load_program(vertex_shader_str, fragment_shader_str);
     tex_id_     = detail::initialize_texture(width, height, (render_mode_ == RenderMode::GRAY));
 
+    glGenBuffers(NumPixelBuffers, pbo_ids_.data());
+    next_pbo_ = 0;
+
     // clang-format off
     static const GLfloat g_vertex_buffer_data[] = {
         -1.0f, -1.0f, 0.0f, 0.0f, 1.0f,
@@ -214,6 +166,7 @@ BaseWindow::~BaseWindow() {
         glDeleteBuffers(1, &vertex_buffer_);
         glDeleteVertexArrays(1, &vertex_array_id_);
         glDeleteTextures(1, &tex_id_);
+        glDeleteBuffers(NumPixelBuffers, pbo_ids_.data());
         glDeleteProgram(program_id_);
 
         glfwDestroyWindow(glfwWindow_);
@@ -288,6 +241,7 @@ void BaseWindow::poll_events() {
 }
 
 void BaseWindow::draw_background_texture() {
+    MV_TRACE_SCOPE("BaseWindow::draw");
     int width, height;
     glfwGetFramebufferSize(glfwWindow_, &width, &height);
 
@@ -304,6 +258,12 @@ void BaseWindow::draw_background_texture() {
     glfwSwapBuffers(glfwWindow_);
 }
 
+void BaseWindow::upload_background_texture(const cv::Mat &image) {
+    MV_TRACE_SCOPE("BaseWindow::upload_texture");
+    detail::upload_texture(image, tex_id_, pbo_ids_[next_pbo_]);
+    next_pbo_ = (next_pbo_ + 1) % NumPixelBuffers;
+}
+
 void BaseWindow::native_key_callback(GLFWwindow *window, int key, int scancode, int action, int mods) {
     auto *instance = reinterpret_cast<BaseWindow *>(glfwGetWindowUserPointer(window));
 
@@ -0,0 +1,331 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+
+#include "metavision/sdk/ui/detail/event_frame_renderer.h"
+#include "metavision/sdk/ui/detail/shader_utils.h"
+#include "metavision/sdk/ui/detail/texture_utils.h"
+
+namespace Metavision {
+namespace detail {
+namespace {
+
+// Range of the timestamps relative to the offset stored in the texture, the lowest bit being used by the polarity
+constexpr int32_t MinRelativeTs = -(1 << 30) + 1;
+constexpr int32_t MaxRelativeTs = (1 << 30) - 1;
+
+// Value of the pixels of the timestamps texture without events, lower than any event
+constexpr int32_t NoEvent = std::numeric_limits<int32_t>::min();
+
+// Draws each event as a point on the pixel of the event. Points are rasterized in order, so that the last event of a
+// pixel is the one stored in the texture
+const char *splat_vertex_shader_str = "#version 330 core\n"
+                                      "layout(location = 0) in uvec2 position;\n"
+                                      "layout(location = 1) in int value;\n"
+                                      "uniform vec2 size;\n"
+                                      "flat out int event_value;\n"
+                                      "void main(){\n"
+                                      "    gl_Position = vec4((vec2(position) + 0.5) / size * 2.0 - 1.0, 0.0, 1.0);\n"
+                                      "    event_value = value;\n"
+                                      "}\n";
+
+const char *splat_fragment_shader_str = "#version 330 core\n"
+                                        "flat in int event_value;\n"
+                                        "layout(location = 0) out int ts_p;\n"
+                                        "void main(){\n"
+                                        "    ts_p = event_value;\n"
+                                        "}\n";
+
+// Full screen quad
+const char *quad_vertex_shader_str = "#version 330 core\n"
+                                     "layout(location = 0) in vec3 vertexPosition_modelspace;\n"
+                                     "void main(){\n"
+                                     "    gl_Position = vec4(vertexPosition_modelspace, 1.0);\n"
+                                     "}\n";
+
+// Colors the pixels from the timestamps texture, as BaseFrameGenerationAlgorithm does
+const char *color_fragment_shader_str = "#version 330 core\n"
+                                        "uniform isampler2D timestamps;\n"
+                                        "uniform int min_ts;\n"
+                                        "uniform vec3 colors[3];\n"
+                                        "out vec3 color;\n"
+                                        "void main(){\n"
+                                        "    int ts_p = texelFetch(timestamps, ivec2(gl_FragCoord.xy), 0).r;\n"
+                                        "    color = (ts_p >> 1) < min_ts ? colors[2] : colors[ts_p & 1];\n"
+                                        "}\n";
+
+// Subtracts an offset from the timestamps of the texture, the ones that become too old being discarded
+const char *rebase_fragment_shader_str = "#version 330 core\n"
+                                         "uniform isampler2D timestamps;\n"
+                                         "uniform int shift;\n"
+                                         "layout(location = 0) out int ts_p;\n"
+                                         "void main(){\n"
+                                         "    int value = texelFetch(timestamps, ivec2(gl_FragCoord.xy), 0).r;\n"
+                                         "    int ts = value >> 1;\n"
+                                         "    ts_p = ts < -1073741823 + shift ? (-2147483647 - 1) :\n"
+                                         "                                     ((ts - shift) << 1) | (value & 1);\n"
+                                         "}\n";
+
+GLuint create_timestamps_texture(int width, int height) {
+    GLuint tex_id;
+    glGenTextures(1, &tex_id);
+    glBindTexture(GL_TEXTURE_2D, tex_id);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R32I, width, height, 0, GL_RED_INTEGER, GL_INT, nullptr);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    return tex_id;
+}
+
+} // namespace
+
+constexpr int EventFrameRenderer::SegmentSize;
+constexpr int EventFrameRenderer::NumSegments;
+
+EventFrameRenderer::EventFrameRenderer(int width, int height) : width_(width), height_(height) {
+    try {
+        create_gl_objects();
+    } catch (...) {
+        delete_gl_objects();
+        throw;
+    }
+    clear_timestamps();
+}
+
+EventFrameRenderer::~EventFrameRenderer() {
+    delete_gl_objects();
+}
+
+void EventFrameRenderer::create_gl_objects() {
+    splat_program_  = detail::load_program(splat_vertex_shader_str, splat_fragment_shader_str);
+    color_program_  = detail::load_program(quad_vertex_shader_str, color_fragment_shader_str);
+    rebase_program_ = detail::load_program(quad_vertex_shader_str, rebase_fragment_shader_str);
+
+    for (size_t i = 0; i < ts_textures_.size(); ++i) {
+        ts_textures_[i]     = create_timestamps_texture(width_, height_);
+        ts_framebuffers_[i] = create_framebuffer(ts_textures_[i]);
+    }
+
+    // clang-format off
+    static const GLfloat quad_vertices[] = {
+        -1.0f, -1.0f, 0.0f,
+         1.0f, -1.0f, 0.0f,
+         1.0f,  1.0f, 0.0f,
+         1.0f,  1.0f, 0.0f,
+        -1.0f,  1.0f, 0.0f,
+        -1.0f, -1.0f, 0.0f
+    };
+    // clang-format on
+    glGenVertexArrays(1, &quad_vertex_array_);
+    glBindVertexArray(quad_vertex_array_);
+    glGenBuffers(1, &quad_buffer_);
+    glBindBuffer(GL_ARRAY_BUFFER, quad_buffer_);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(quad_vertices), quad_vertices, GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(GLfloat), (void *)0);
+    glEnableVertexAttribArray(0);
+
+    glGenVertexArrays(1, &events_vertex_array_);
+    glBindVertexArray(events_vertex_array_);
+    glGenBuffers(1, &events_buffer_);
+    glBindBuffer(GL_ARRAY_BUFFER, events_buffer_);
+
+    const GLsizeiptr buffer_size = static_cast<GLsizeiptr>(SegmentSize) * NumSegments * sizeof(GPUEvent);
+    if (GLEW_ARB_buffer_storage) {
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_ARRAY_BUFFER, buffer_size, nullptr, flags);
+        mapped_events_ = static_cast<GPUEvent *>(glMapBufferRange(GL_ARRAY_BUFFER, 0, buffer_size, flags));
+    }
+    if (!mapped_events_) {
+        if (GLEW_ARB_buffer_storage) {
+            // The storage of the buffer is immutable, a new buffer is needed to upload the events at each call
+            glDeleteBuffers(1, &events_buffer_);
+            glGenBuffers(1, &events_buffer_);
+            glBindBuffer(GL_ARRAY_BUFFER, events_buffer_);
+        }
+        glBufferData(GL_ARRAY_BUFFER, SegmentSize * sizeof(GPUEvent), nullptr, GL_STREAM_DRAW);
+        staging_events_.resize(SegmentSize);
+    }
+
+    glVertexAttribIPointer(0, 2, GL_UNSIGNED_SHORT, sizeof(GPUEvent), (void *)offsetof(GPUEvent, x));
+    glEnableVertexAttribArray(0);
+    glVertexAttribIPointer(1, 1, GL_INT, sizeof(GPUEvent), (void *)offsetof(GPUEvent, ts_p));
+    glEnableVertexAttribArray(1);
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+}
+
+void EventFrameRenderer::delete_gl_objects() {
+    for (auto &fence : segment_fences_) {
+        if (fence) {
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+    }
+    if (mapped_events_) {
+        glBindBuffer(GL_ARRAY_BUFFER, events_buffer_);
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        mapped_events_ = nullptr;
+    }
+
+    // Deleting the name 0 is silently ignored, so that the objects not created yet are skipped
+    glDeleteBuffers(1, &events_buffer_);
+    glDeleteVertexArrays(1, &events_vertex_array_);
+    glDeleteBuffers(1, &quad_buffer_);
+    glDeleteVertexArrays(1, &quad_vertex_array_);
+    glDeleteFramebuffers(static_cast<GLsizei>(ts_framebuffers_.size()), ts_framebuffers_.data());
+    glDeleteTextures(static_cast<GLsizei>(ts_textures_.size()), ts_textures_.data());
+    glDeleteProgram(rebase_program_);
+    glDeleteProgram(color_program_);
+    glDeleteProgram(splat_program_);
+}
+
+void EventFrameRenderer::process_events(const EventCD *begin, const EventCD *end) {
+    if (begin == end)
+        return;
+
+    if (!has_ts_offset_) {
+        ts_offset_     = begin->t;
+        has_ts_offset_ = true;
+    }
+
+    while (begin != end) {
+        const EventCD *segment_end = begin + std::min<std::ptrdiff_t>(end - begin, SegmentSize);
+        if (std::prev(segment_end)->t - ts_offset_ > MaxRelativeTs)
+            rebase_timestamps(std::prev(segment_end)->t);
+        upload_and_splat(begin, segment_end);
+        begin = segment_end;
+    }
+}
+
+void EventFrameRenderer::upload_and_splat(const EventCD *begin, const EventCD *end) {
+    const int n_events = static_cast<int>(end - begin);
+
+    // Waits for the GPU to have read the segment the last time it was used, before overwriting it
+    GPUEvent *events = staging_events_.data();
+    if (mapped_events_) {
+        GLsync &fence = segment_fences_[segment_];
+        if (fence) {
+            while (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000) == GL_TIMEOUT_EXPIRED) {}
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+        events = mapped_events_ + segment_ * SegmentSize;
+    }
+
+    for (auto it = begin; it != end; ++it, ++events) {
+        const int32_t ts = static_cast<int32_t>(std::max<timestamp>(it->t - ts_offset_, MinRelativeTs));
+        events->x        = it->x;
+        events->y        = it->y;
+        events->ts_p     = static_cast<int32_t>(static_cast<uint32_t>(ts) << 1) | (it->p != 0);
+    }
+
+    glBindVertexArray(events_vertex_array_);
+    GLint first = 0;
+    if (mapped_events_) {
+        first = segment_ * SegmentSize;
+    } else {
+        // Orphans the previous content of the buffer, so that the upload does not wait for the GPU to draw it
+        glBindBuffer(GL_ARRAY_BUFFER, events_buffer_);
+        glBufferData(GL_ARRAY_BUFFER, SegmentSize * sizeof(GPUEvent), nullptr, GL_STREAM_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, n_events * sizeof(GPUEvent), staging_events_.data());
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, ts_framebuffers_[0]);
+    glViewport(0, 0, width_, height_);
+    glUseProgram(splat_program_);
+    glUniform2f(glGetUniformLocation(splat_program_, "size"), static_cast<float>(width_),
+                static_cast<float>(height_));
+    glDrawArrays(GL_POINTS, first, n_events);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glBindVertexArray(0);
+
+    if (mapped_events_) {
+        segment_fences_[segment_] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        segment_                  = (segment_ + 1) % NumSegments;
+    }
+}
+
+void EventFrameRenderer::rebase_timestamps(timestamp ts) {
+    // Moves the offset so that the timestamp ts is in the middle of the range of the texture
+    const timestamp shift = ts - ts_offset_ - MaxRelativeTs / 2;
+    ts_offset_ += shift;
+    if (shift > static_cast<timestamp>(MaxRelativeTs) - MinRelativeTs) {
+        // All the timestamps of the texture would be discarded
+        clear_timestamps();
+        return;
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, ts_framebuffers_[1]);
+    glViewport(0, 0, width_, height_);
+    glUseProgram(rebase_program_);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, ts_textures_[0]);
+    glUniform1i(glGetUniformLocation(rebase_program_, "timestamps"), 0);
+    glUniform1i(glGetUniformLocation(rebase_program_, "shift"), static_cast<GLint>(shift));
+    draw_quad();
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    std::swap(ts_textures_[0], ts_textures_[1]);
+    std::swap(ts_framebuffers_[0], ts_framebuffers_[1]);
+}
+
+void EventFrameRenderer::render(timestamp ts, uint32_t accumulation_time_us, const std::array<cv::Vec3b, 3> &colors,
+                                bool is_gray, GLuint framebuffer) {
+    const timestamp min_ts = has_ts_offset_ ? ts - accumulation_time_us - ts_offset_ : MinRelativeTs;
+    std::array<GLfloat, 9> gl_colors;
+    for (size_t i = 0; i < colors.size(); ++i) {
+        // A gray framebuffer only has the red channel, the others are stored in RGB
+        for (int c = 0; c < 3; ++c)
+            gl_colors[3 * i + c] = colors[i][is_gray ? 0 : 2 - c] / 255.f;
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glViewport(0, 0, width_, height_);
+    glUseProgram(color_program_);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, ts_textures_[0]);
+    glUniform1i(glGetUniformLocation(color_program_, "timestamps"), 0);
+    glUniform1i(glGetUniformLocation(color_program_, "min_ts"),
+                static_cast<GLint>(std::min<timestamp>(std::max<timestamp>(min_ts, MinRelativeTs), MaxRelativeTs)));
+    glUniform3fv(glGetUniformLocation(color_program_, "colors"), 3, gl_colors.data());
+    draw_quad();
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+void EventFrameRenderer::reset() {
+    clear_timestamps();
+    has_ts_offset_ = false;
+}
+
+void EventFrameRenderer::clear_timestamps() {
+    const GLint no_event[4] = {NoEvent, 0, 0, 0};
+    glBindFramebuffer(GL_FRAMEBUFFER, ts_framebuffers_[0]);
+    glClearBufferiv(GL_COLOR, 0, no_event);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+void EventFrameRenderer::draw_quad() {
+    glBindVertexArray(quad_vertex_array_);
+    glDrawArrays(GL_TRIANGLES, 0, 6);
+    glBindVertexArray(0);
+}
+
+} // namespace detail
+} // namespace Metavision
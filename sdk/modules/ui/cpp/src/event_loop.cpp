@@ -20,4 +20,16 @@ void EventLoop::poll_and_dispatch(std::int64_t sleep_time_ms) {
 
     std::this_thread::sleep_for(std::chrono::milliseconds(sleep_time_ms));
 }
+
+void EventLoop::wait_and_dispatch(std::int64_t timeout_ms) {
+    if (timeout_ms > 0) {
+        glfwWaitEventsTimeout(timeout_ms / 1000.);
+    } else {
+        glfwPollEvents();
+    }
+}
+
+void EventLoop::wake_up() {
+    glfwPostEmptyEvent();
+}
 } // namespace Metavision
\ No newline at end of file
@@ -0,0 +1,102 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include "metavision/sdk/ui/utils/event_window.h"
+#include "metavision/sdk/ui/detail/event_frame_renderer.h"
+#include "metavision/sdk/ui/detail/texture_utils.h"
+
+namespace Metavision {
+namespace {
+
+// Makes a window's context current during the lifetime of the object, and restores the previous one afterwards
+class ScopedContext {
+public:
+    ScopedContext(GLFWwindow *window) : prev_context_(glfwGetCurrentContext()) {
+        glfwMakeContextCurrent(window);
+    }
+
+    ~ScopedContext() {
+        glfwMakeContextCurrent(prev_context_);
+    }
+
+private:
+    GLFWwindow *prev_context_;
+};
+
+} // namespace
+
+EventWindow::EventWindow(const std::string &title, int width, int height, uint32_t accumulation_time_us,
+                         const ColorPalette &palette) :
+    BaseWindow(title, width, height, palette == ColorPalette::Gray ? RenderMode::GRAY : RenderMode::BGR),
+    accumulation_time_us_(accumulation_time_us),
+    sensor_width_(width),
+    sensor_height_(height) {
+    colors_ = {BaseFrameGenerationAlgorithm::get_cv_color(palette, ColorType::Negative),
+               BaseFrameGenerationAlgorithm::get_cv_color(palette, ColorType::Positive),
+               BaseFrameGenerationAlgorithm::get_cv_color(palette, ColorType::Background)};
+
+    ScopedContext context(glfwWindow_);
+    renderer_ = std::make_unique<detail::EventFrameRenderer>(sensor_width_, sensor_height_);
+    try {
+        color_framebuffer_ = detail::create_framebuffer(tex_id_);
+    } catch (...) {
+        // The GL objects of the renderer must be deleted while the context is current
+        renderer_.reset();
+        throw;
+    }
+}
+
+EventWindow::~EventWindow() {
+    if (glfwWindow_) {
+        ScopedContext context(glfwWindow_);
+        glDeleteFramebuffers(1, &color_framebuffer_);
+        renderer_.reset();
+    }
+}
+
+void EventWindow::process_events(const EventCD *begin, const EventCD *end) {
+    if (begin == end)
+        return;
+
+    ScopedContext context(glfwWindow_);
+    renderer_->process_events(begin, end);
+}
+
+void EventWindow::show(timestamp ts, bool auto_poll) {
+    if (auto_poll)
+        poll_events();
+
+    ScopedContext context(glfwWindow_);
+
+    // Generates the frame in the texture displayed by the window
+    renderer_->render(ts, accumulation_time_us_, colors_, render_mode_ == RenderMode::GRAY, color_framebuffer_);
+
+    draw_background_texture();
+}
+
+void EventWindow::set_accumulation_time_us(uint32_t accumulation_time_us) {
+    accumulation_time_us_ = accumulation_time_us;
+}
+
+uint32_t EventWindow::get_accumulation_time_us() const {
+    return accumulation_time_us_;
+}
+
+void EventWindow::set_colors(const cv::Vec3b &bg_color, const cv::Vec3b &on_color, const cv::Vec3b &off_color) {
+    colors_ = {off_color, on_color, bg_color};
+}
+
+void EventWindow::reset() {
+    ScopedContext context(glfwWindow_);
+    renderer_->reset();
+}
+
+} // namespace Metavision
@@ -9,19 +9,33 @@
  * See the License for the specific language governing permissions and limitations under the License.                 *
  **********************************************************************************************************************/
 
+#include "metavision/sdk/base/utils/trace.h"
 #include "metavision/sdk/ui/utils/mt_window.h"
-#include "metavision/sdk/ui/detail/texture_utils.h"
+#include "metavision/sdk/ui/utils/mt_window_group.h"
 
 namespace Metavision {
 
 MTWindow::MTWindow(const std::string &title, int width, int height, RenderMode mode) :
-    BaseWindow(title, width, height, mode) {
+    BaseWindow(title, width, height, mode), group_(nullptr), swap_interval_(-1) {
     has_been_updated_ = false;
     rendering_loop_   = std::thread(&MTWindow::rendering_loop, this);
 }
 
+MTWindow::MTWindow(const std::string &title, int width, int height, RenderMode mode, MTWindowGroup &group) :
+    MTWindow(title, width, height, mode, group, group.lock_contexts()) {}
+
+MTWindow::MTWindow(const std::string &title, int width, int height, RenderMode mode, MTWindowGroup &group,
+                   std::unique_lock<std::mutex> &&group_lock) :
+    BaseWindow(title, width, height, mode, group.shared_context_), group_(&group), swap_interval_(-1) {
+    has_been_updated_ = false;
+    group.add_window(this);
+}
+
 MTWindow::~MTWindow() noexcept {
-    if (rendering_loop_.joinable()) {
+    if (group_) {
+        auto lock = group_->lock_contexts();
+        group_->remove_window(this);
+    } else if (rendering_loop_.joinable()) {
         glfwSetWindowShouldClose(glfwWindow_, GLFW_TRUE);
 
         rendering_loop_.join();
@@ -42,6 +56,7 @@ void MTWindow::show_async(cv::Mat &image, bool auto_poll) {
 }
 
 void MTWindow::rendering_loop() {
+    MV_TRACE_THREAD_NAME("mv_window");
     glfwMakeContextCurrent(glfwWindow_);
 
     // Enable the V-Sync
@@ -56,21 +71,21 @@ void MTWindow::rendering_loop() {
     glfwMakeContextCurrent(nullptr);
 }
 
-void MTWindow::upload_texture_if_updated() {
-    bool do_upload = false;
+bool MTWindow::swap_buffers_if_updated() {
+    std::lock_guard<std::mutex> lock(swap_mtx_);
 
-    {
-        std::lock_guard<std::mutex> lock(swap_mtx_);
+    if (!has_been_updated_)
+        return false;
 
-        if (has_been_updated_) {
-            cv::swap(front_, back_);
-            has_been_updated_ = false;
-            do_upload         = !back_.empty();
-        }
-    }
+    cv::swap(front_, back_);
+    has_been_updated_ = false;
 
-    if (do_upload)
-        detail::upload_texture(back_, tex_id_);
+    return !back_.empty();
+}
+
+void MTWindow::upload_texture_if_updated() {
+    if (swap_buffers_if_updated())
+        upload_background_texture(back_);
 }
 
 } // namespace Metavision
\ No newline at end of file
@@ -0,0 +1,136 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+
+#include "metavision/sdk/base/utils/sdk_log.h"
+#include "metavision/sdk/ui/utils/mt_window_group.h"
+#include "metavision/sdk/ui/detail/texture_utils.h"
+
+namespace Metavision {
+
+constexpr int MTWindowGroup::NumPixelBuffers;
+
+MTWindowGroup::MTWindowGroup() : next_pbo_(0), num_waiting_callers_(0), stop_(false) {
+    BaseWindow::initialize_glfw();
+
+#ifdef __APPLE__
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 2);
+    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+#endif
+
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    shared_context_ = glfwCreateWindow(1, 1, "shared", nullptr, nullptr);
+    glfwDefaultWindowHints();
+
+    if (!shared_context_)
+        throw std::runtime_error("Impossible to create a glfw window");
+
+    glfwMakeContextCurrent(shared_context_);
+    glGenBuffers(NumPixelBuffers, pbo_ids_.data());
+    glfwMakeContextCurrent(nullptr);
+
+    rendering_loop_ = std::thread(&MTWindowGroup::rendering_loop, this);
+}
+
+MTWindowGroup::~MTWindowGroup() {
+    {
+        auto lock = lock_contexts();
+        if (!windows_.empty())
+            MV_SDK_LOG_ERROR() << "A group of windows is destroyed before its" << windows_.size() << "windows";
+
+        stop_ = true;
+        contexts_cond_.notify_all();
+    }
+    rendering_loop_.join();
+
+    glfwMakeContextCurrent(shared_context_);
+    glDeleteBuffers(NumPixelBuffers, pbo_ids_.data());
+    glfwDestroyWindow(shared_context_);
+}
+
+size_t MTWindowGroup::get_num_windows() const {
+    std::lock_guard<std::mutex> lock(contexts_mtx_);
+    return windows_.size();
+}
+
+std::unique_lock<std::mutex> MTWindowGroup::lock_contexts() {
+    ++num_waiting_callers_;
+    std::unique_lock<std::mutex> lock(contexts_mtx_);
+    --num_waiting_callers_;
+    return lock;
+}
+
+void MTWindowGroup::add_window(MTWindow *window) {
+    windows_.push_back(window);
+    contexts_cond_.notify_all();
+}
+
+void MTWindowGroup::remove_window(MTWindow *window) {
+    windows_.erase(std::remove(windows_.begin(), windows_.end(), window), windows_.end());
+    contexts_cond_.notify_all();
+}
+
+void MTWindowGroup::rendering_loop() {
+    std::unique_lock<std::mutex> lock(contexts_mtx_);
+
+    while (!stop_) {
+        // Gives the lock to the callers adding or removing windows between two frames. The timeout prevents from
+        // waiting forever for a caller that failed to create its window, and thus to notify the rendering thread
+        contexts_cond_.wait_for(lock, std::chrono::milliseconds(10),
+                                [this] { return stop_ || (num_waiting_callers_ == 0 && !windows_.empty()); });
+        if (stop_ || num_waiting_callers_ != 0 || windows_.empty())
+            continue;
+
+        // The images of all the windows are uploaded at once from the shared context...
+        glfwMakeContextCurrent(shared_context_);
+        for (auto *window : windows_) {
+            if (window->swap_buffers_if_updated()) {
+                detail::upload_texture(window->back_, window->tex_id_, pbo_ids_[next_pbo_]);
+                next_pbo_ = (next_pbo_ + 1) % NumPixelBuffers;
+            }
+        }
+        GLsync uploaded = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        glFlush();
+
+        // ... before all the windows are drawn. Only the first one waits for the V-Sync, otherwise the refresh rate
+        // would be divided by the number of windows
+        int swap_interval = 1;
+        for (auto *window : windows_) {
+            if (window->should_close())
+                continue;
+
+            glfwMakeContextCurrent(window->glfwWindow_);
+            if (window->swap_interval_ != swap_interval) {
+                glfwSwapInterval(swap_interval);
+                window->swap_interval_ = swap_interval;
+            }
+
+            // The textures must not be sampled before the uploads, done in another context, are complete
+            glWaitSync(uploaded, 0, GL_TIMEOUT_IGNORED);
+            window->draw_background_texture();
+            swap_interval = 0;
+        }
+
+        glfwMakeContextCurrent(shared_context_);
+        glDeleteSync(uploaded);
+        glfwMakeContextCurrent(nullptr);
+
+        // No window waited for the V-Sync, avoids spinning until one of them is destroyed
+        if (swap_interval == 1)
+            contexts_cond_.wait_for(lock, std::chrono::milliseconds(10));
+    }
+}
+
+} // namespace Metavision
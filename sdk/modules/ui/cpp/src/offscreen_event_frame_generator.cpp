@@ -0,0 +1,274 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include "metavision/sdk/ui/utils/offscreen_event_frame_generator.h"
+#include "metavision/sdk/ui/detail/event_frame_renderer.h"
+#include "metavision/sdk/ui/detail/texture_utils.h"
+
+namespace Metavision {
+namespace {
+
+// Prefers the display of a GPU device, which does not need a running display server
+EGLDisplay get_device_display() {
+    auto query_devices = reinterpret_cast<PFNEGLQUERYDEVICESEXTPROC>(eglGetProcAddress("eglQueryDevicesEXT"));
+    auto get_platform_display =
+        reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+    if (!query_devices || !get_platform_display) {
+        return EGL_NO_DISPLAY;
+    }
+
+    EGLDeviceEXT device;
+    EGLint num_devices = 0;
+    if (!query_devices(1, &device, &num_devices) || num_devices == 0) {
+        return EGL_NO_DISPLAY;
+    }
+    return get_platform_display(EGL_PLATFORM_DEVICE_EXT, device, nullptr);
+}
+
+} // namespace
+
+struct OffscreenEventFrameGenerator::EGLState {
+    EGLState() {
+        EGLint major, minor;
+        display = get_device_display();
+        if (display == EGL_NO_DISPLAY || !eglInitialize(display, &major, &minor)) {
+            display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+            if (display == EGL_NO_DISPLAY || !eglInitialize(display, &major, &minor))
+                throw std::runtime_error("Impossible to initialize EGL");
+        }
+        if (!eglBindAPI(EGL_OPENGL_API))
+            throw std::runtime_error("Impossible to use OpenGL with EGL");
+
+        const EGLint config_attribs[] = {EGL_SURFACE_TYPE, EGL_PBUFFER_BIT, EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+                                         EGL_NONE};
+        EGLConfig config;
+        EGLint num_configs = 0;
+        if (!eglChooseConfig(display, config_attribs, &config, 1, &num_configs) || num_configs == 0)
+            throw std::runtime_error("No EGL configuration supports offscreen OpenGL rendering");
+
+        // The frames are rendered in framebuffer objects, the surface is only needed by the implementations that do
+        // not support surfaceless contexts
+        const EGLint surface_attribs[] = {EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE};
+        surface                        = eglCreatePbufferSurface(display, config, surface_attribs);
+        if (surface == EGL_NO_SURFACE)
+            throw std::runtime_error("Impossible to create an EGL surface");
+
+        // Same version and profile as the contexts of the windows
+        const EGLint context_attribs[] = {EGL_CONTEXT_MAJOR_VERSION_KHR,
+                                          3,
+                                          EGL_CONTEXT_MINOR_VERSION_KHR,
+                                          3,
+                                          EGL_CONTEXT_OPENGL_PROFILE_MASK_KHR,
+                                          EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT_KHR,
+                                          EGL_NONE};
+        context = eglCreateContext(display, config, EGL_NO_CONTEXT, context_attribs);
+        if (context == EGL_NO_CONTEXT) {
+            eglDestroySurface(display, surface);
+            throw std::runtime_error("Impossible to create an OpenGL 3.3 context with EGL");
+        }
+    }
+
+    // The display is not terminated, as it is shared by all the EGL users of the process
+    ~EGLState() {
+        eglDestroyContext(display, context);
+        eglDestroySurface(display, surface);
+    }
+
+    EGLDisplay display{EGL_NO_DISPLAY};
+    EGLSurface surface{EGL_NO_SURFACE};
+    EGLContext context{EGL_NO_CONTEXT};
+};
+
+// Makes the context of the generator current during the lifetime of the object, and restores the previous one
+// afterwards
+class OffscreenEventFrameGenerator::ScopedContext {
+public:
+    ScopedContext(const EGLState &egl) :
+        display_(egl.display),
+        prev_display_(eglGetCurrentDisplay()),
+        prev_draw_surface_(eglGetCurrentSurface(EGL_DRAW)),
+        prev_read_surface_(eglGetCurrentSurface(EGL_READ)),
+        prev_context_(eglGetCurrentContext()) {
+        eglMakeCurrent(egl.display, egl.surface, egl.surface, egl.context);
+    }
+
+    ~ScopedContext() {
+        if (prev_context_ != EGL_NO_CONTEXT)
+            eglMakeCurrent(prev_display_, prev_draw_surface_, prev_read_surface_, prev_context_);
+        else
+            eglMakeCurrent(display_, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    }
+
+private:
+    EGLDisplay display_;
+    EGLDisplay prev_display_;
+    EGLSurface prev_draw_surface_;
+    EGLSurface prev_read_surface_;
+    EGLContext prev_context_;
+};
+
+OffscreenEventFrameGenerator::OffscreenEventFrameGenerator(int width, int height, uint32_t accumulation_time_us,
+                                                           const ColorPalette &palette, int num_readback_buffers) :
+    egl_(std::make_unique<EGLState>()),
+    width_(width),
+    height_(height),
+    is_gray_(palette == ColorPalette::Gray),
+    accumulation_time_us_(accumulation_time_us),
+    readbacks_(std::max(1, num_readback_buffers)) {
+    colors_ = {BaseFrameGenerationAlgorithm::get_cv_color(palette, ColorType::Negative),
+               BaseFrameGenerationAlgorithm::get_cv_color(palette, ColorType::Positive),
+               BaseFrameGenerationAlgorithm::get_cv_color(palette, ColorType::Background)};
+    frame_.create(height_, width_, is_gray_ ? CV_8UC1 : CV_8UC3);
+
+    ScopedContext context(*egl_);
+    // glewInit looks for a GLX display when GLEW is built for GLX, whereas glewContextInit only loads the entry points
+    // of the current context
+    if (glewContextInit() != GLEW_OK)
+        throw std::runtime_error("Impossible to initialize GL extensions");
+
+    try {
+        renderer_          = std::make_unique<detail::EventFrameRenderer>(width_, height_);
+        color_texture_     = detail::initialize_texture(width_, height_, is_gray_);
+        color_framebuffer_ = detail::create_framebuffer(color_texture_);
+
+        const GLsizeiptr frame_size = static_cast<GLsizeiptr>(frame_.total() * frame_.elemSize());
+        for (auto &readback : readbacks_) {
+            glGenBuffers(1, &readback.pbo);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.pbo);
+            glBufferData(GL_PIXEL_PACK_BUFFER, frame_size, nullptr, GL_STREAM_READ);
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    } catch (...) {
+        delete_gl_objects();
+        throw;
+    }
+}
+
+OffscreenEventFrameGenerator::~OffscreenEventFrameGenerator() {
+    ScopedContext context(*egl_);
+    delete_gl_objects();
+}
+
+void OffscreenEventFrameGenerator::delete_gl_objects() {
+    for (auto &readback : readbacks_) {
+        if (readback.fence) {
+            glDeleteSync(readback.fence);
+            readback.fence = nullptr;
+        }
+        glDeleteBuffers(1, &readback.pbo);
+    }
+    in_flight_.clear();
+
+    // Deleting the name 0 is silently ignored, so that the objects not created yet are skipped
+    glDeleteFramebuffers(1, &color_framebuffer_);
+    glDeleteTextures(1, &color_texture_);
+    renderer_.reset();
+}
+
+void OffscreenEventFrameGenerator::set_output_callback(const OutputCallback &output_cb) {
+    output_cb_ = output_cb;
+}
+
+void OffscreenEventFrameGenerator::process_events(const EventCD *begin, const EventCD *end) {
+    if (begin == end)
+        return;
+
+    ScopedContext context(*egl_);
+    renderer_->process_events(begin, end);
+}
+
+void OffscreenEventFrameGenerator::generate(timestamp ts) {
+    ScopedContext context(*egl_);
+
+    // Outputs the frames already read back, and makes room for the new one
+    while (output_oldest(false)) {}
+    if (in_flight_.size() == readbacks_.size())
+        output_oldest(true);
+
+    renderer_->render(ts, accumulation_time_us_, colors_, is_gray_, color_framebuffer_);
+
+    // The pixels are copied in the buffer by the GPU, the call does not wait for the rendering to be done
+    Readback &readback = readbacks_[next_readback_];
+    readback.ts        = ts;
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, color_framebuffer_);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.pbo);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, width_, height_, is_gray_ ? GL_RED : GL_BGR, GL_UNSIGNED_BYTE, nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+    readback.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    glFlush();
+
+    in_flight_.push_back(next_readback_);
+    next_readback_ = (next_readback_ + 1) % readbacks_.size();
+}
+
+void OffscreenEventFrameGenerator::flush() {
+    ScopedContext context(*egl_);
+    while (output_oldest(true)) {}
+}
+
+bool OffscreenEventFrameGenerator::output_oldest(bool wait) {
+    if (in_flight_.empty())
+        return false;
+
+    Readback &readback = readbacks_[in_flight_.front()];
+    GLenum status;
+    do {
+        status = glClientWaitSync(readback.fence, GL_SYNC_FLUSH_COMMANDS_BIT, wait ? 1000000000 : 0);
+    } while (wait && status == GL_TIMEOUT_EXPIRED);
+    if (status == GL_TIMEOUT_EXPIRED)
+        return false;
+    glDeleteSync(readback.fence);
+    readback.fence = nullptr;
+    in_flight_.pop_front();
+
+    // The callback may have swapped the frame with its own
+    frame_.create(height_, width_, is_gray_ ? CV_8UC1 : CV_8UC3);
+    const size_t frame_size = frame_.total() * frame_.elemSize();
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.pbo);
+    const void *pixels = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, frame_size, GL_MAP_READ_BIT);
+    if (pixels) {
+        std::memcpy(frame_.data, pixels, frame_size);
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    if (pixels && output_cb_)
+        output_cb_(readback.ts, frame_);
+    return true;
+}
+
+void OffscreenEventFrameGenerator::set_accumulation_time_us(uint32_t accumulation_time_us) {
+    accumulation_time_us_ = accumulation_time_us;
+}
+
+uint32_t OffscreenEventFrameGenerator::get_accumulation_time_us() const {
+    return accumulation_time_us_;
+}
+
+void OffscreenEventFrameGenerator::set_colors(const cv::Vec3b &bg_color, const cv::Vec3b &on_color,
+                                              const cv::Vec3b &off_color) {
+    colors_ = {off_color, on_color, bg_color};
+}
+
+void OffscreenEventFrameGenerator::reset() {
+    ScopedContext context(*egl_);
+    renderer_->reset();
+}
+
+} // namespace Metavision
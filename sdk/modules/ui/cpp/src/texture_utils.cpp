@@ -11,11 +11,28 @@
 
 #include "metavision/sdk/ui/detail/texture_utils.h"
 
+#include <cstring>
+#include <stdexcept>
 #include <GL/glew.h>
 
 namespace Metavision {
 namespace detail {
 
+namespace {
+void set_unpack_parameters(const cv::Mat &img) {
+    if ((img.step) % 8 == 0)
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 8);
+    else if ((img.step) % 4 == 0)
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    else if ((img.step) % 2 == 0)
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 2);
+    else
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, img.step / img.elemSize());
+}
+} // namespace
+
 unsigned int initialize_texture(int width, int height, bool is_gray) {
     unsigned int tex_id;
 
@@ -45,16 +62,7 @@ unsigned int initialize_texture(int width, int height, bool is_gray) {
 void upload_texture(const cv::Mat &img, const unsigned int &tex_id) {
     glBindTexture(GL_TEXTURE_2D, tex_id);
 
-    if ((img.step) % 8 == 0)
-        glPixelStorei(GL_UNPACK_ALIGNMENT, 8);
-    else if ((img.step) % 4 == 0)
-        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
-    else if ((img.step) % 2 == 0)
-        glPixelStorei(GL_UNPACK_ALIGNMENT, 2);
-    else
-        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-
-    glPixelStorei(GL_UNPACK_ROW_LENGTH, img.step / img.elemSize());
+    set_unpack_parameters(img);
 
     const auto internal_format = (img.type() == CV_8UC3) ? GL_RGB8 : GL_R8;
     const auto format          = (img.type() == CV_8UC3) ? GL_BGR : GL_RED;
@@ -64,5 +72,57 @@ void upload_texture(const cv::Mat &img, const unsigned int &tex_id) {
     glBindTexture(GL_TEXTURE_2D, 0);
 }
 
+void upload_texture(const cv::Mat &img, const unsigned int &tex_id, const unsigned int &pbo_id) {
+    // The rows are copied with their padding, as the unpack parameters describe the layout of the image
+    const size_t size = img.step * (img.rows - 1) + img.cols * img.elemSize();
+
+    // Orphaning the buffer before mapping it avoids waiting for a pending transfer from its previous content
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo_id);
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW);
+    void *pbo_data = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size,
+                                      GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+    if (!pbo_data) {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        upload_texture(img, tex_id);
+        return;
+    }
+    std::memcpy(pbo_data, img.ptr(), size);
+    glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+
+    glBindTexture(GL_TEXTURE_2D, tex_id);
+
+    set_unpack_parameters(img);
+
+    const auto internal_format = (img.type() == CV_8UC3) ? GL_RGB8 : GL_R8;
+    const auto format          = (img.type() == CV_8UC3) ? GL_BGR : GL_RED;
+
+    // The data pointer is an offset in the pixel buffer object. The storage of the texture is only reallocated if the
+    // size of the image changed
+    GLint tex_width, tex_height;
+    glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &tex_width);
+    glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &tex_height);
+    if (tex_width == img.cols && tex_height == img.rows)
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, img.cols, img.rows, format, GL_UNSIGNED_BYTE, nullptr);
+    else
+        glTexImage2D(GL_TEXTURE_2D, 0, internal_format, img.cols, img.rows, 0, format, GL_UNSIGNED_BYTE, nullptr);
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
+
+unsigned int create_framebuffer(unsigned int tex_id) {
+    GLuint framebuffer;
+    glGenFramebuffers(1, &framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, tex_id, 0);
+    const GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+        glDeleteFramebuffers(1, &framebuffer);
+        throw std::runtime_error("Impossible to create a framebuffer to generate the frames on the GPU");
+    }
+    return framebuffer;
+}
+
 } // namespace detail
 } // namespace Metavision
\ No newline at end of file
@@ -10,7 +10,6 @@
  **********************************************************************************************************************/
 
 #include "metavision/sdk/ui/utils/window.h"
-#include "metavision/sdk/ui/detail/texture_utils.h"
 
 namespace Metavision {
 Window::Window(const std::string &title, int width, int height, RenderMode mode) :
@@ -29,7 +28,7 @@ void Window::show(const cv::Mat &image, bool auto_poll) {
 
     glfwMakeContextCurrent(glfwWindow_);
 
-    detail::upload_texture(image, tex_id_);
+    upload_background_texture(image);
 
     draw_background_texture();
 
@@ -0,0 +1,118 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include <gtest/gtest.h>
+#include <opencv2/core.hpp>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/core/algorithms/base_frame_generation_algorithm.h"
+#include "metavision/sdk/ui/utils/event_window.h"
+
+using namespace Metavision;
+
+namespace {
+
+// Window whose frames generated on the GPU can be read back
+class ReadableEventWindow : public EventWindow {
+public:
+    ReadableEventWindow(int width, int height, uint32_t accumulation_time_us, const ColorPalette &palette) :
+        EventWindow("EventWindow_GTest", width, height, accumulation_time_us, palette),
+        width_(width),
+        height_(height) {}
+
+    // Reads the texture in which the last frame shown has been generated
+    cv::Mat read_frame() {
+        const bool is_gray = get_rendering_mode() == RenderMode::GRAY;
+        cv::Mat frame(height_, width_, is_gray ? CV_8UC1 : CV_8UC3);
+
+        GLFWwindow *prev_context = glfwGetCurrentContext();
+        glfwMakeContextCurrent(glfwWindow_);
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glBindTexture(GL_TEXTURE_2D, tex_id_);
+        glGetTexImage(GL_TEXTURE_2D, 0, is_gray ? GL_RED : GL_BGR, GL_UNSIGNED_BYTE, frame.data);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glfwMakeContextCurrent(prev_context);
+        return frame;
+    }
+
+private:
+    const int width_, height_;
+};
+
+// Events of both polarities, some pixels being updated several times and some events being older than the
+// accumulation time at the end of the buffer
+std::vector<EventCD> make_events(int width, int height) {
+    std::vector<EventCD> events;
+    timestamp t = 1000;
+    for (int y = 0; y < height; y += 3) {
+        for (int x = 0; x < width; x += 2) {
+            events.emplace_back(x, y, (x + y) % 2, t);
+            t += 7;
+        }
+    }
+    for (int y = 0; y < height; y += 6) {
+        for (int x = 0; x < width; x += 4) {
+            events.emplace_back(x, y, 1 - (x + y) % 2, t);
+            t += 5;
+        }
+    }
+    return events;
+}
+
+// Creates a window, or returns nullptr if no OpenGL context can be created (e.g. without display)
+std::unique_ptr<ReadableEventWindow> create_window(int width, int height, uint32_t accumulation_time_us,
+                                                   const ColorPalette &palette) {
+    try {
+        return std::make_unique<ReadableEventWindow>(width, height, accumulation_time_us, palette);
+    } catch (const std::runtime_error &) {
+        return nullptr;
+    }
+}
+
+} // namespace
+
+TEST(EventWindow_GTest, frames_generated_on_gpu_match_the_cpu_ones) {
+    const int width                     = 64;
+    const int height                    = 48;
+    const uint32_t accumulation_time_us = 4000;
+    const auto events                   = make_events(width, height);
+
+    for (const auto palette : {ColorPalette::Dark, ColorPalette::Light, ColorPalette::Gray}) {
+        // GIVEN a window displaying events, with the frame generated on the GPU
+        auto window = create_window(width, height, accumulation_time_us, palette);
+        if (!window) {
+            GTEST_SKIP() << "No OpenGL context can be created";
+        }
+
+        // WHEN showing the frame at the timestamp of the last event
+        window->process_events(events.data(), events.data() + events.size());
+        window->show(events.back().t, false);
+
+        // THEN it is the same as the one generated on the CPU
+        cv::Mat expected(height, width, palette == ColorPalette::Gray ? CV_8UC1 : CV_8UC3);
+        BaseFrameGenerationAlgorithm::generate_frame_from_events(events.cbegin(), events.cend(), expected,
+                                                                 accumulation_time_us, palette);
+        const cv::Mat frame = window->read_frame();
+        ASSERT_EQ(0, cv::norm(frame, expected, cv::NORM_INF));
+
+        // WHEN resetting the window
+        window->reset();
+        window->show(events.back().t, false);
+
+        // THEN the frame is filled with the background color
+        const cv::Vec3b bg_color = BaseFrameGenerationAlgorithm::get_cv_color(palette, ColorType::Background);
+        expected.setTo(cv::Scalar(bg_color[0], bg_color[1], bg_color[2]));
+        ASSERT_EQ(0, cv::norm(window->read_frame(), expected, cv::NORM_INF));
+    }
+}
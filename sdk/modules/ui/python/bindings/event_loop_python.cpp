@@ -25,7 +25,11 @@ void export_event_loop(py::module &m) {
     py::class_<EventLoop>(m, "EventLoop", pybind_doc_ui["Metavision::EventLoop"])
         .def(py::init<>())
         .def_static("poll_and_dispatch", &EventLoop::poll_and_dispatch, "sleep_time_ms"_a = 0,
-                    pybind_doc_ui["Metavision::EventLoop::poll_and_dispatch"]);
+                    pybind_doc_ui["Metavision::EventLoop::poll_and_dispatch"])
+        .def_static("wait_and_dispatch", &EventLoop::wait_and_dispatch, "timeout_ms"_a,
+                    py::call_guard<py::gil_scoped_release>(),
+                    pybind_doc_ui["Metavision::EventLoop::wait_and_dispatch"])
+        .def_static("wake_up", &EventLoop::wake_up, pybind_doc_ui["Metavision::EventLoop::wake_up"]);
 }
 
 } // namespace Metavision
\ No newline at end of file
@@ -17,6 +17,8 @@
 namespace Metavision {
 
 static const char doc_process_events_array_async_str[] = "Processes a buffer of events for later frame generation\n"
+                                                         "\n"
+                                                         "   The GIL is released while the events are processed.\n"
                                                          "\n"
                                                          "   :events_np: numpy structured array of events";
 
@@ -29,6 +31,8 @@ void process_events_array_async(Algo &algo, const py::array_t<InputEvent> &in) {
     auto nelem   = static_cast<size_t>(info.shape[0]);
     auto *in_ptr = static_cast<InputEvent *>(info.ptr);
 
+    // The output callbacks calling Python code acquire the GIL
+    py::gil_scoped_release release;
     algo.process_events(in_ptr, in_ptr + nelem);
 }
 } // namespace Metavision
@@ -0,0 +1,211 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_UTILS_PYBIND_DLPACK_HELPER_H
+#define METAVISION_UTILS_PYBIND_DLPACK_HELPER_H
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+
+#include "metavision/sdk/base/utils/dlpack.h"
+
+namespace py = pybind11;
+
+namespace Metavision {
+
+/// @brief Wraps a DLPack tensor into a capsule named "dltensor", as expected by the consumers of the DLPack protocol
+///
+/// A consumer renames the capsule "used_dltensor" and becomes responsible for releasing the tensor, otherwise the
+/// tensor is released with the capsule.
+inline py::capsule to_dlpack_capsule(DLPack::ManagedTensor *tensor) {
+    PyObject *capsule = PyCapsule_New(tensor, "dltensor", [](PyObject *self) {
+        if (PyCapsule_IsValid(self, "dltensor")) {
+            auto *tensor = static_cast<DLPack::ManagedTensor *>(PyCapsule_GetPointer(self, "dltensor"));
+            tensor->deleter(tensor);
+        }
+    });
+    if (!capsule) {
+        tensor->deleter(tensor);
+        throw py::error_already_set();
+    }
+    return py::reinterpret_steal<py::capsule>(capsule);
+}
+
+/// @brief Gets the DLPack type of the values of a numpy type
+inline DLPack::DataType to_dlpack_dtype(const py::dtype &dtype) {
+    DLPack::DataType dl_dtype;
+    switch (dtype.kind()) {
+    case 'i':
+        dl_dtype.code = DLPack::Int;
+        break;
+    case 'u':
+        dl_dtype.code = DLPack::UInt;
+        break;
+    case 'f':
+        dl_dtype.code = DLPack::Float;
+        break;
+    case 'b':
+        dl_dtype.code = DLPack::Bool;
+        break;
+    default:
+        throw std::invalid_argument("Values of type " + py::str(dtype).cast<std::string>() +
+                                    " can not be exported with DLPack");
+    }
+    dl_dtype.bits  = static_cast<uint8_t>(8 * dtype.itemsize());
+    dl_dtype.lanes = 1;
+    return dl_dtype;
+}
+
+/// @brief View of the memory of a Python object, exported as a tensor through the DLPack protocol
+///
+/// The exported tensors keep a reference on the owner of the memory. For instance, a pooled buffer of events only
+/// goes back to its pool once all the tensors viewing it have been released by the frameworks consuming them.
+class DLPackTensor {
+public:
+    /// @brief Creates a view of CPU memory
+    /// @param owner Python object owning the memory
+    /// @param data Address of the first value
+    /// @param dtype Type of the values
+    /// @param shape Dimensions of the tensor
+    /// @param strides Strides of the dimensions, in number of values, or empty if the tensor is compact and row-major
+    DLPackTensor(py::object owner, void *data, DLPack::DataType dtype, std::vector<int64_t> shape,
+                 std::vector<int64_t> strides = {}) :
+        owner_(std::move(owner)),
+        data_(data),
+        dtype_(dtype),
+        shape_(std::move(shape)),
+        strides_(std::move(strides)) {
+        if (!strides_.empty() && strides_.size() != shape_.size()) {
+            throw std::invalid_argument("The tensor has " + std::to_string(strides_.size()) + " strides for " +
+                                        std::to_string(shape_.size()) + " dimensions");
+        }
+    }
+
+    /// @brief Exports the tensor, without copy, as a DLPack capsule
+    /// @note The GIL must be held
+    py::capsule capsule() const {
+        // Context of a tensor, released by its consumer possibly after the view has been collected
+        struct Context {
+            DLPack::ManagedTensor tensor;
+            std::vector<int64_t> shape;
+            std::vector<int64_t> strides;
+            PyObject *owner;
+        };
+
+        auto *ctx    = new Context{DLPack::ManagedTensor(), shape_, strides_, owner_.inc_ref().ptr()};
+        auto &tensor = ctx->tensor.dl_tensor;
+
+        tensor.data        = data_;
+        tensor.device      = {DLPack::CPU, 0};
+        tensor.ndim        = static_cast<int32_t>(ctx->shape.size());
+        tensor.dtype       = dtype_;
+        tensor.shape       = ctx->shape.data();
+        tensor.strides     = ctx->strides.empty() ? nullptr : ctx->strides.data();
+        tensor.byte_offset = 0;
+
+        ctx->tensor.manager_ctx = ctx;
+        ctx->tensor.deleter     = [](DLPack::ManagedTensor *self) {
+            auto *ctx = static_cast<Context *>(self->manager_ctx);
+            // The consumer may release the tensor from any thread, or after the interpreter has been finalized
+            if (Py_IsInitialized()) {
+                py::gil_scoped_acquire acquire;
+                Py_DECREF(ctx->owner);
+            }
+            delete ctx;
+        };
+        return to_dlpack_capsule(&ctx->tensor);
+    }
+
+    /// @brief Gets the dimensions of the tensor
+    const std::vector<int64_t> &shape() const {
+        return shape_;
+    }
+
+private:
+    py::object owner_;
+    void *data_;
+    DLPack::DataType dtype_;
+    std::vector<int64_t> shape_;
+    std::vector<int64_t> strides_;
+};
+
+/// @brief Gets the device of the tensors exported by @ref DLPackTensor, as returned by __dlpack_device__
+inline py::tuple dlpack_cpu_device() {
+    return py::make_tuple(static_cast<int>(DLPack::CPU), 0);
+}
+
+/// @brief Views an array of events as a tensor of bytes, of shape (n, sizeof(T))
+///
+/// The events are structures, which DLPack can not describe: the consumer has to reinterpret the bytes, or
+/// @ref make_dlpack_event_field can be used to view each field of the events as a tensor.
+template<typename T>
+DLPackTensor make_dlpack_events(py::object owner, T *events, size_t n) {
+    return DLPackTensor(std::move(owner), events, {DLPack::UInt, 8, 1},
+                        {static_cast<int64_t>(n), static_cast<int64_t>(sizeof(T))});
+}
+
+/// @brief Views a field of an array of events, e.g. the timestamps of CD events, as a 1D tensor strided over the events
+/// @param owner Python object owning the events
+/// @param events Address of the first event
+/// @param n Number of events
+/// @param field Name of the field, as in the numpy type of the events
+/// @throw std::invalid_argument if the events have no such field, or if it is not aligned on the size of its values
+template<typename T>
+DLPackTensor make_dlpack_event_field(py::object owner, T *events, size_t n, const std::string &field) {
+    const py::dict fields = py::dtype::of<T>().attr("fields");
+    if (!fields.contains(field)) {
+        throw std::invalid_argument("The events have no field '" + field + "'");
+    }
+    const auto description = fields[py::str(field)].template cast<py::tuple>();
+    const auto dtype       = description[0].template cast<py::dtype>();
+    const auto offset      = description[1].template cast<size_t>();
+    const auto value_size  = static_cast<size_t>(dtype.itemsize());
+    // DLPack strides are in number of values, so the field must be at a whole number of values of the event
+    if (offset % value_size != 0 || sizeof(T) % value_size != 0) {
+        throw std::invalid_argument("The field '" + field + "' is not aligned and can not be exported with DLPack");
+    }
+    return DLPackTensor(std::move(owner), reinterpret_cast<char *>(events) + offset, to_dlpack_dtype(dtype),
+                        {static_cast<int64_t>(n)}, {static_cast<int64_t>(sizeof(T) / value_size)});
+}
+
+/// @brief Exports the class of the tensors viewed through DLPack
+/// @note To be called once, by the base module
+inline void export_DLPackTensor(py::module &m) {
+    py::class_<DLPackTensor>(m, "DLPackTensor",
+                             "View of memory exported without copy through the DLPack protocol, to be consumed by "
+                             "torch.from_dlpack, jax.dlpack.from_dlpack or numpy.from_dlpack for instance")
+        .def(
+            "__dlpack__", [](const DLPackTensor &tensor, py::object stream) { return tensor.capsule(); },
+            py::arg("stream") = py::none(),
+            "Exports the tensor as a DLPack capsule\n"
+            "\n"
+            "   :stream: Not used, the memory being on the CPU")
+        .def("__dlpack_device__", [](const DLPackTensor &) { return dlpack_cpu_device(); })
+        .def_property_readonly(
+            "shape",
+            [](const DLPackTensor &tensor) {
+                py::tuple shape(tensor.shape().size());
+                for (size_t i = 0; i < tensor.shape().size(); ++i) {
+                    shape[i] = tensor.shape()[i];
+                }
+                return shape;
+            },
+            "Dimensions of the tensor");
+}
+
+} // namespace Metavision
+
+#endif // METAVISION_UTILS_PYBIND_DLPACK_HELPER_H
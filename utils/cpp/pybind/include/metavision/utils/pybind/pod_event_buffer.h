@@ -15,6 +15,8 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/numpy.h>
 
+#include "metavision/utils/pybind/dlpack_helper.h"
+
 namespace py = pybind11;
 
 namespace Metavision {
@@ -64,6 +66,27 @@ void export_PODEventBuffer(py::module &m, const std::string &event_buffer_name)
              "Converts to a numpy array\n"
              "\n",
              "   :copy: if True, allocates new memory and returns a copy of the events. If False, use the same memory")
+        .def(
+            "__dlpack__",
+            [](py::object self, py::object stream) {
+                auto &buffer = self.cast<EventBuffer &>().buffer_;
+                return make_dlpack_events(self, buffer.data(), buffer.size()).capsule();
+            },
+            py::arg("stream") = py::none(),
+            "Exports the events without copy as a DLPack tensor of bytes, of shape (size, event size)\n"
+            "\n"
+            "   :stream: Not used, the memory being on the CPU")
+        .def("__dlpack_device__", [](const EventBuffer &) { return dlpack_cpu_device(); })
+        .def(
+            "field",
+            [](py::object self, const std::string &name) {
+                auto &buffer = self.cast<EventBuffer &>().buffer_;
+                return make_dlpack_event_field(self, buffer.data(), buffer.size(), name);
+            },
+            py::arg("name"),
+            "Views a field of the events without copy, as a DLPack tensor strided over the events\n"
+            "\n"
+            "   :name: Name of the field, e.g. 't' for the timestamps")
         .def("_buffer_info", &EventBuffer::buffer_info);
 }
 
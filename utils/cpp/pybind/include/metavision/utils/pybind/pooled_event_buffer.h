@@ -0,0 +1,165 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_UTILS_PYBIND_POOLED_EVENT_BUFFER_H
+#define METAVISION_UTILS_PYBIND_POOLED_EVENT_BUFFER_H
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+
+#include "metavision/utils/pybind/dlpack_helper.h"
+
+namespace py = pybind11;
+
+namespace Metavision {
+
+/// @brief Pool of vectors of events, whose memory is reused once they are released
+///
+/// It can be used from any thread, without holding the GIL.
+template<typename T>
+class EventBufferPool {
+public:
+    /// @brief Creates a pool
+    /// @param max_free_buffers Maximum number of released buffers kept for reuse, the others being freed
+    static std::shared_ptr<EventBufferPool<T>> make(size_t max_free_buffers = 64) {
+        return std::shared_ptr<EventBufferPool<T>>(new EventBufferPool<T>(max_free_buffers));
+    }
+
+    /// @brief Gets an empty vector, reusing the memory of a released one if available
+    std::vector<T> acquire() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (free_buffers_.empty()) {
+            return std::vector<T>();
+        }
+        std::vector<T> buffer = std::move(free_buffers_.back());
+        free_buffers_.pop_back();
+        return buffer;
+    }
+
+    /// @brief Gives back a vector to the pool
+    void release(std::vector<T> &&buffer) {
+        buffer.clear();
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (free_buffers_.size() < max_free_buffers_) {
+            free_buffers_.emplace_back(std::move(buffer));
+        }
+    }
+
+    /// @brief Gets the number of buffers available for reuse
+    size_t num_free_buffers() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return free_buffers_.size();
+    }
+
+private:
+    EventBufferPool(size_t max_free_buffers) : max_free_buffers_(max_free_buffers) {}
+
+    const size_t max_free_buffers_;
+    std::vector<std::vector<T>> free_buffers_;
+    mutable std::mutex mutex_;
+};
+
+/// @brief Buffer of events exposed to Python without copy, whose memory goes back to a pool when it is collected
+///
+/// The numpy arrays created by @ref numpy and the DLPack tensors exported from it reference the Python object of the
+/// buffer, which hence lives as long as any of them.
+template<typename T>
+struct PooledEventBuffer {
+    PooledEventBuffer(std::vector<T> &&buffer, const std::shared_ptr<EventBufferPool<T>> &pool) :
+        buffer_(std::move(buffer)), pool_(pool) {}
+
+    PooledEventBuffer(const PooledEventBuffer &other) = delete;
+
+    ~PooledEventBuffer() {
+        // The pool may have been destroyed if the decoder is gone, the memory is then freed
+        if (auto pool = pool_.lock()) {
+            pool->release(std::move(buffer_));
+        }
+    }
+
+    /// @brief Converts a buffer to a numpy array
+    /// @param self Python object of the buffer
+    /// @param copy If true, returns a copy of the events, otherwise a view keeping the buffer alive
+    static py::array_t<T> numpy(py::object self, bool copy = false) {
+        auto &buffer = self.cast<PooledEventBuffer<T> &>().buffer_;
+        if (buffer.empty() || copy) {
+            return py::array_t<T>(buffer.size(), buffer.data());
+        }
+        return py::array_t<T>(buffer.size(), buffer.data(), self);
+    }
+
+    py::buffer_info buffer_info() {
+        return py::buffer_info(buffer_.data(),                     // pointer to buffer
+                               sizeof(T),                          // size of one element
+                               py::format_descriptor<T>::format(), // python struct-style format descriptor
+                               1,                                  // number of dimensions
+                               {buffer_.size()},                   // shape
+                               {sizeof(T)});                       // stride
+    }
+
+    std::vector<T> buffer_;
+    std::weak_ptr<EventBufferPool<T>> pool_;
+};
+
+/// @brief Wraps a vector of events into a numpy array without copy, the vector going back to the pool when the array
+/// (and all the views on it) are collected
+/// @note The GIL must be held
+template<typename T>
+py::array_t<T> make_pooled_numpy_array(std::vector<T> &&events, const std::shared_ptr<EventBufferPool<T>> &pool) {
+    auto buffer = std::make_shared<PooledEventBuffer<T>>(std::move(events), pool);
+    return PooledEventBuffer<T>::numpy(py::cast(buffer));
+}
+
+template<typename EventType>
+void export_PooledEventBuffer(py::module &m, const std::string &event_buffer_name) {
+    using EventBuffer = PooledEventBuffer<EventType>;
+
+    py::class_<EventBuffer, std::shared_ptr<EventBuffer>>(m, event_buffer_name.c_str(), py::buffer_protocol())
+        .def_buffer(&EventBuffer::buffer_info)
+        .def("__len__", [](const EventBuffer &buffer) { return buffer.buffer_.size(); })
+        .def("numpy", &EventBuffer::numpy, py::arg("copy") = false,
+             "Converts to a numpy array\n"
+             "\n",
+             "   :copy: if True, allocates new memory and returns a copy of the events. If False, use the same memory, "
+             "which goes back to the pool once the array is collected")
+        .def(
+            "__dlpack__",
+            [](py::object self, py::object stream) {
+                auto &buffer = self.cast<EventBuffer &>().buffer_;
+                return make_dlpack_events(self, buffer.data(), buffer.size()).capsule();
+            },
+            py::arg("stream") = py::none(),
+            "Exports the events without copy as a DLPack tensor of bytes, of shape (size, event size). The memory "
+            "goes back to the pool once the tensor is released by its consumer\n"
+            "\n"
+            "   :stream: Not used, the memory being on the CPU")
+        .def("__dlpack_device__", [](const EventBuffer &) { return dlpack_cpu_device(); })
+        .def(
+            "field",
+            [](py::object self, const std::string &name) {
+                auto &buffer = self.cast<EventBuffer &>().buffer_;
+                return make_dlpack_event_field(self, buffer.data(), buffer.size(), name);
+            },
+            py::arg("name"),
+            "Views a field of the events without copy, as a DLPack tensor strided over the events, e.g. "
+            "torch.from_dlpack(array.base.field('t')) for the timestamps of an array given by a decoder\n"
+            "\n"
+            "   :name: Name of the field, e.g. 't' for the timestamps")
+        .def("_buffer_info", &EventBuffer::buffer_info);
+}
+
+} // namespace Metavision
+
+#endif // METAVISION_UTILS_PYBIND_POOLED_EVENT_BUFFER_H
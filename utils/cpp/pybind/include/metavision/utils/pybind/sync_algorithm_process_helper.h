@@ -12,10 +12,31 @@
 #ifndef METAVISION_UTILS_PYBIND_SYNC_ALGORITHM_PROCESS_HELPER_H
 #define METAVISION_UTILS_PYBIND_SYNC_ALGORITHM_PROCESS_HELPER_H
 
+#include <iterator>
+#include <stdexcept>
+#include <string>
+
 #include "metavision/utils/pybind/pod_event_buffer.h"
 
 namespace Metavision {
 
+namespace detail {
+// Algorithms filtering the events return the end of their output
+template<typename Algo, typename InputEvent, typename OutputEvent>
+auto process_events_to_pointer(Algo &algo, const InputEvent *first, const InputEvent *last, OutputEvent *d_first, int)
+    -> decltype(static_cast<OutputEvent *>(algo.process_events(first, last, d_first))) {
+    return algo.process_events(first, last, d_first);
+}
+
+// The others output one event per input event
+template<typename Algo, typename InputEvent, typename OutputEvent>
+OutputEvent *process_events_to_pointer(Algo &algo, const InputEvent *first, const InputEvent *last,
+                                       OutputEvent *d_first, long) {
+    algo.process_events(first, last, d_first);
+    return d_first + std::distance(first, last);
+}
+} // namespace detail
+
 static const char doc_process_events_array_sync_str[] =
     "This method is used to apply the current algorithm on a chunk of events. It takes a numpy array as input and "
     "writes the results into the specified output event buffer\n"
@@ -32,6 +53,16 @@ static const char doc_process_events_array_sync_inplace_str[] =
     "This method should only be used when the number of output events is the same as the number of input events\n"
     "   :events_np: numpy structured array of events used as input/output. Its content will be overwritten";
 
+static const char doc_process_events_array_sync_into_str[] =
+    "This method is used to apply the current algorithm on a chunk of events. It takes a numpy array as input and "
+    "writes the results into a provided numpy array, without allocating memory. The GIL is released while the events "
+    "are processed.\n"
+    "This should only be used when the number of output events is equal or smaller than the number of input events\n"
+    "   :input_np: input chunk of events (numpy structured array)\n"
+    "   :output_np: numpy structured array receiving the output events, at least as large as input_np. It can be "
+    "input_np itself\n"
+    "   :return: the number of output events written at the beginning of output_np";
+
 static const char doc_process_events_buffer_sync_inplace_str[] =
     "This method is used to apply the current algorithm on a chunk of events. It takes an event buffer as "
     "input/output.\n"
@@ -56,6 +87,8 @@ void process_events_array_sync(Algo &algo, const py::array_t<InputEvent> &in, PO
 
     out.buffer_.clear();
 
+    // The buffers must not be used by another Python thread during the processing
+    py::gil_scoped_release release;
     algo.process_events(in_ptr, in_ptr + nelem, std::back_inserter(out.buffer_));
 }
 
@@ -68,6 +101,7 @@ void process_events_buffer_sync(Algo &algo, const PODEventBuffer<InputEvent> &in
     }
     out.buffer_.clear();
 
+    py::gil_scoped_release release;
     algo.process_events(in.buffer_.cbegin(), in.buffer_.cend(), std::back_inserter(out.buffer_));
 }
 
@@ -81,12 +115,40 @@ void process_events_array_sync_inplace(Algo &algo, py::array_t<InputEvent> &even
     auto nelem    = static_cast<size_t>(info.shape[0]);
     auto *buf_ptr = static_cast<InputEvent *>(info.ptr);
 
+    py::gil_scoped_release release;
     algo.process_events(buf_ptr, buf_ptr + nelem, buf_ptr);
 }
 
+// This should only be used when the number of output events is equal or smaller as the number of input events, the
+// output events being written before the input events not processed yet when the arrays are the same
+template<typename Algo, typename InputEvent, typename OutputEvent = InputEvent>
+size_t process_events_array_sync_into(Algo &algo, const py::array_t<InputEvent> &in, py::array &out) {
+    // The output array is written directly, it can not be converted
+    if (!py::isinstance<py::array_t<OutputEvent>>(out) || out.ndim() != 1 || !out.writeable() ||
+        (out.size() > 1 && out.strides(0) != static_cast<py::ssize_t>(sizeof(OutputEvent)))) {
+        throw std::invalid_argument("The output must be a writeable contiguous 1D numpy array of the output events");
+    }
+    auto in_info = in.request();
+    if (in_info.ndim != 1) {
+        throw std::runtime_error("Bad input numpy array");
+    }
+    auto nelem = static_cast<size_t>(in_info.shape[0]);
+    if (static_cast<size_t>(out.size()) < nelem) {
+        throw std::invalid_argument("The output array has " + std::to_string(out.size()) +
+                                    " elements, less than the " + std::to_string(nelem) + " input events");
+    }
+    auto *in_ptr  = static_cast<const InputEvent *>(in_info.ptr);
+    auto *out_ptr = static_cast<OutputEvent *>(out.mutable_data());
+
+    py::gil_scoped_release release;
+    auto out_end = detail::process_events_to_pointer(algo, in_ptr, in_ptr + nelem, out_ptr, 0);
+    return static_cast<size_t>(std::distance(out_ptr, out_end));
+}
+
 // This should only be used when the number of output events is equal or smaller as the number of input events
 template<typename Algo, typename InputEvent>
 void process_events_buffer_sync_inplace(Algo &algo, PODEventBuffer<InputEvent> &buf) {
+    py::gil_scoped_release release;
     auto it_end = algo.process_events(buf.buffer_.cbegin(), buf.buffer_.cend(), buf.buffer_.begin());
     buf.buffer_.resize(std::distance(buf.buffer_.begin(), it_end));
 }